@@ -91,13 +91,146 @@ DEFINE_int32(
 
 DEFINE_int32(split_preload_per_driver, 2, "Prefetch split metadata");
 
+DEFINE_string(
+    json_output,
+    "",
+    "Path of a JSON file to write the wall time, CPU time, peak memory, "
+    "spilled bytes and I/O of each query run to");
+DEFINE_string(
+    baseline,
+    "",
+    "Path of a JSON file written by an earlier run with --json_output. The "
+    "queries are compared against the runs of the same queries with the same "
+    "data_path, data_format, num_drivers and --test_flags_file flags in it. "
+    "The program exits with an error if there is a regression");
+DEFINE_double(
+    regression_threshold_pct,
+    10,
+    "Percentage by which the wall time, CPU time, peak memory or spilled bytes "
+    "of a query may exceed those in --baseline");
+DEFINE_int32(
+    regression_min_ms,
+    100,
+    "Wall and CPU times below this in both the run and --baseline are not "
+    "compared");
+
 using namespace facebook::velox::exec;
 using namespace facebook::velox::exec::test;
 using namespace facebook::velox::dwio::common;
 
 namespace facebook::velox {
 
-//  static
+// static
+QueryRunStats QueryRunStats::fromTask(
+    const std::string& name,
+    std::map<std::string, std::string> flags,
+    exec::Task& task) {
+  QueryRunStats stats;
+  stats.name = name;
+  stats.flags = std::move(flags);
+  const auto taskStats = task.taskStats();
+  stats.wallNanos =
+      (taskStats.executionEndTimeMs - taskStats.executionStartTimeMs) *
+      1'000'000;
+  stats.peakMemoryBytes = task.queryCtx()->pool()->peakBytes();
+  for (const auto& pipeline : taskStats.pipelineStats) {
+    for (const auto& op : pipeline.operatorStats) {
+      stats.cpuNanos += op.isBlockedTiming.cpuNanos +
+          op.addInputTiming.cpuNanos + op.getOutputTiming.cpuNanos +
+          op.finishTiming.cpuNanos + op.backgroundTiming.cpuNanos;
+      stats.spilledBytes += op.spilledBytes;
+      if (op.operatorType == "TableScan") {
+        stats.rawInputBytes += op.rawInputBytes;
+        auto it = op.runtimeStats.find("storageReadBytes");
+        if (it != op.runtimeStats.end()) {
+          stats.storageReadBytes += it->second.sum;
+        }
+      }
+    }
+  }
+  return stats;
+}
+
+std::string QueryRunStats::key() const {
+  std::stringstream out;
+  out << name;
+  for (const auto& [flag, value] : flags) {
+    out << " " << flag << "=" << value;
+  }
+  return out.str();
+}
+
+folly::dynamic QueryRunStats::toJson() const {
+  folly::dynamic flagsObj = folly::dynamic::object;
+  for (const auto& [flag, value] : flags) {
+    flagsObj[flag] = value;
+  }
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = name;
+  obj["flags"] = std::move(flagsObj);
+  obj["wallNanos"] = static_cast<int64_t>(wallNanos);
+  obj["cpuNanos"] = static_cast<int64_t>(cpuNanos);
+  obj["peakMemoryBytes"] = static_cast<int64_t>(peakMemoryBytes);
+  obj["spilledBytes"] = static_cast<int64_t>(spilledBytes);
+  obj["rawInputBytes"] = static_cast<int64_t>(rawInputBytes);
+  obj["storageReadBytes"] = static_cast<int64_t>(storageReadBytes);
+  return obj;
+}
+
+// static
+QueryRunStats QueryRunStats::fromJson(const folly::dynamic& obj) {
+  QueryRunStats stats;
+  stats.name = obj["name"].asString();
+  for (const auto& [flag, value] : obj["flags"].items()) {
+    stats.flags[flag.asString()] = value.asString();
+  }
+  stats.wallNanos = obj["wallNanos"].asInt();
+  stats.cpuNanos = obj["cpuNanos"].asInt();
+  stats.peakMemoryBytes = obj["peakMemoryBytes"].asInt();
+  stats.spilledBytes = obj["spilledBytes"].asInt();
+  stats.rawInputBytes = obj["rawInputBytes"].asInt();
+  stats.storageReadBytes = obj["storageReadBytes"].asInt();
+  return stats;
+}
+
+std::vector<std::string> findRegressions(
+    const QueryRunStats& baseline,
+    const QueryRunStats& current,
+    double thresholdPct,
+    uint64_t minNanos) {
+  std::vector<std::string> regressions;
+  const auto check = [&](const char* stat,
+                         uint64_t baselineValue,
+                         uint64_t currentValue,
+                         uint64_t minValue,
+                         const auto& format) {
+    if (baselineValue < minValue && currentValue < minValue) {
+      return;
+    }
+    if (currentValue > baselineValue * (1 + thresholdPct / 100)) {
+      regressions.push_back(fmt::format(
+          "{}: {} {} vs. {} in baseline",
+          current.key(),
+          stat,
+          format(currentValue),
+          format(baselineValue)));
+    }
+  };
+  const auto nanos = [](uint64_t value) { return succinctNanos(value); };
+  const auto bytes = [](uint64_t value) { return succinctBytes(value); };
+  check("wall time", baseline.wallNanos, current.wallNanos, minNanos, nanos);
+  check("CPU time", baseline.cpuNanos, current.cpuNanos, minNanos, nanos);
+  check(
+      "peak memory",
+      baseline.peakMemoryBytes,
+      current.peakMemoryBytes,
+      0,
+      bytes);
+  check("spilled", baseline.spilledBytes, current.spilledBytes, 1, bytes);
+  return regressions;
+}
+
+// static
 bool QueryBenchmarkBase::validateDataFormat(
     const char* flagname,
     const std::string& value) {
@@ -392,4 +525,75 @@ void QueryBenchmarkBase::runAllCombinations() {
   }
 }
 
+std::map<std::string, std::string> QueryBenchmarkBase::runFlags() const {
+  std::vector<std::string> names{"data_path", "data_format", "num_drivers"};
+  for (const auto& parameter : parameters_) {
+    names.push_back(parameter.flag);
+  }
+  std::map<std::string, std::string> flags;
+  for (const auto& name : names) {
+    std::string value;
+    if (gflags::GetCommandLineOption(name.c_str(), &value)) {
+      flags[name] = value;
+    }
+  }
+  return flags;
+}
+
+void QueryBenchmarkBase::recordQueryStats(
+    const std::string& name,
+    exec::Task& task) {
+  queryRunStats_.push_back(QueryRunStats::fromTask(name, runFlags(), task));
+}
+
+int32_t QueryBenchmarkBase::writeAndCompareQueryStats(std::ostream& out) {
+  if (!FLAGS_json_output.empty()) {
+    folly::dynamic queries = folly::dynamic::array;
+    for (const auto& stats : queryRunStats_) {
+      queries.push_back(stats.toJson());
+    }
+    folly::dynamic obj = folly::dynamic::object("queries", std::move(queries));
+    std::ofstream file(FLAGS_json_output);
+    file << folly::toPrettyJson(obj) << std::endl;
+    VELOX_CHECK(file.good(), "Failed to write {}", FLAGS_json_output);
+  }
+  if (FLAGS_baseline.empty()) {
+    return 0;
+  }
+
+  std::ifstream file(FLAGS_baseline);
+  VELOX_CHECK(file.good(), "Failed to read {}", FLAGS_baseline);
+  std::stringstream json;
+  json << file.rdbuf();
+  std::unordered_map<std::string, QueryRunStats> baseline;
+  for (const auto& query : folly::parseJson(json.str())["queries"]) {
+    auto stats = QueryRunStats::fromJson(query);
+    baseline.emplace(stats.key(), std::move(stats));
+  }
+
+  int32_t numRegressions = 0;
+  for (const auto& stats : queryRunStats_) {
+    auto it = baseline.find(stats.key());
+    if (it == baseline.end()) {
+      out << stats.key() << ": not in baseline" << std::endl;
+      continue;
+    }
+    for (const auto& regression : findRegressions(
+             it->second,
+             stats,
+             FLAGS_regression_threshold_pct,
+             FLAGS_regression_min_ms * 1'000'000ULL)) {
+      out << "Regression: " << regression << std::endl;
+      ++numRegressions;
+    }
+  }
+  out << fmt::format(
+             "{} queries compared against {}, {} regressions",
+             queryRunStats_.size(),
+             FLAGS_baseline,
+             numRegressions)
+      << std::endl;
+  return numRegressions;
+}
+
 } // namespace facebook::velox
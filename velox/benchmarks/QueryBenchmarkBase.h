@@ -22,6 +22,7 @@
 
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <gflags/gflags.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -76,6 +77,48 @@ struct RunStats {
   }
 };
 
+/// The stats of a run of a query, written by --json_output and compared
+/// against the stats stored by an earlier run with --baseline.
+struct QueryRunStats {
+  /// The name of the query, e.g. q1.
+  std::string name;
+  /// The values of the flags of the run that identify its configuration, e.g.
+  /// data_path, data_format and num_drivers.
+  std::map<std::string, std::string> flags;
+  uint64_t wallNanos{0};
+  /// The CPU time of the operators, on and off the driver threads.
+  uint64_t cpuNanos{0};
+  uint64_t peakMemoryBytes{0};
+  uint64_t spilledBytes{0};
+  /// The bytes read by the table scans from files.
+  uint64_t rawInputBytes{0};
+  /// The bytes read by the table scans from storage, not from cache.
+  uint64_t storageReadBytes{0};
+
+  /// Returns the stats of the completed 'task' that ran query 'name'.
+  static QueryRunStats fromTask(
+      const std::string& name,
+      std::map<std::string, std::string> flags,
+      exec::Task& task);
+
+  /// Identifies the query and the configuration of the run in a baseline.
+  std::string key() const;
+
+  folly::dynamic toJson() const;
+
+  static QueryRunStats fromJson(const folly::dynamic& obj);
+};
+
+/// Returns a description of each of the wall time, CPU time, peak memory and
+/// spilled bytes of 'current' that exceeds that of 'baseline' by more than
+/// 'thresholdPct' percent. Times below 'minNanos' in both runs are not
+/// compared, since they are mostly noise.
+std::vector<std::string> findRegressions(
+    const QueryRunStats& baseline,
+    const QueryRunStats& current,
+    double thresholdPct,
+    uint64_t minNanos);
+
 struct ParameterDim {
   std::string flag;
   std::vector<std::string> values;
@@ -115,7 +158,19 @@ class QueryBenchmarkBase {
 
   void runAllCombinations();
 
+  /// Adds the stats of the completed 'task' that ran query 'name' to the
+  /// stats written by writeAndCompareQueryStats().
+  void recordQueryStats(const std::string& name, exec::Task& task);
+
+  /// Writes the recorded query stats to --json_output, if set, and compares
+  /// them against the stats in --baseline, if set. Prints the regressions
+  /// and returns their number.
+  int32_t writeAndCompareQueryStats(std::ostream& out);
+
  protected:
+  // Returns the values of the flags that identify the configuration of a run.
+  std::map<std::string, std::string> runFlags() const;
+
   std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
   std::unique_ptr<folly::IOThreadPoolExecutor> cacheExecutor_;
   std::shared_ptr<memory::MemoryAllocator> allocator_;
@@ -125,5 +180,7 @@ class QueryBenchmarkBase {
   std::vector<ParameterDim> parameters_;
 
   std::vector<RunStats> runStats_;
+
+  std::vector<QueryRunStats> queryRunStats_;
 };
 } // namespace facebook::velox
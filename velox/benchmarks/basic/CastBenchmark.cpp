@@ -186,6 +186,9 @@ int main(int argc, char** argv) {
       .addExpression("try_cast_valid", "try_cast (valid as int)")
       .addExpression("tryexpr_cast_valid", "try (cast (valid as int))")
       .addExpression("cast_valid", "cast(valid as int)")
+      .addExpression("cast_valid_as_bigint", "cast(valid as bigint)")
+      .addExpression("cast_int_as_varchar", "cast(integer as varchar)")
+      .addExpression("cast_bigint_as_varchar", "cast(bigint as varchar)")
       .addExpression(
           "cast_decimal_to_inline_string", "cast (decimal as varchar)")
       .addExpression("cast_short_decimal", "cast (short_decimal as varchar)")
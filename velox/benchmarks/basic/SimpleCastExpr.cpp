@@ -134,6 +134,18 @@ BENCHMARK(castTimestampDateAdjustTimeZoneLarge) {
   benchmark->runLarge(TIMESTAMP(), DATE());
 }
 
+BENCHMARK(castBigintVarcharSmall) {
+  benchmark->runSmall(BIGINT(), VARCHAR());
+}
+
+BENCHMARK(castBigintVarcharMedium) {
+  benchmark->runMedium(BIGINT(), VARCHAR());
+}
+
+BENCHMARK(castBigintVarcharLarge) {
+  benchmark->runLarge(BIGINT(), VARCHAR());
+}
+
 BENCHMARK(castStructFewFieldsRenameSmall) {
   folly::BenchmarkSuspender suspender;
   auto oldType = buildStructType([](int) { return ""; }, INTEGER(), 3);
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <folly/String.h>
+
 #include "velox/benchmarks/QueryBenchmarkBase.h"
 
 using namespace facebook::velox;
@@ -50,6 +52,11 @@ DEFINE_int32(
     run_query_verbose,
     -1,
     "Run a given query and print execution statistics");
+DEFINE_string(
+    queries,
+    "",
+    "Comma separated numbers of the queries to run with --json_output or "
+    "--baseline. All the queries are run if empty");
 DEFINE_int32(
     io_meter_column_pct,
     0,
@@ -59,11 +66,36 @@ DEFINE_int32(
 
 std::shared_ptr<TpchQueryBuilder> queryBuilder;
 
+namespace {
+// Creates 'queryBuilder' for --data_path and --data_format, unless it was
+// created for the same values, e.g. by a previous run of --test_flags_file.
+void initializeQueryBuilder() {
+  static std::string dataPath;
+  static std::string dataFormat;
+  if (queryBuilder != nullptr && dataPath == FLAGS_data_path &&
+      dataFormat == FLAGS_data_format) {
+    return;
+  }
+  queryBuilder =
+      std::make_shared<TpchQueryBuilder>(toFileFormat(FLAGS_data_format));
+  queryBuilder->initialize(FLAGS_data_path);
+  dataPath = FLAGS_data_path;
+  dataFormat = FLAGS_data_format;
+}
+} // namespace
+
+DECLARE_string(json_output);
+DECLARE_string(baseline);
+
 class TpchBenchmark : public QueryBenchmarkBase {
  public:
   void runMain(std::ostream& out, RunStats& runStats) override {
     if (FLAGS_run_query_verbose == -1 && FLAGS_io_meter_column_pct == 0) {
-      folly::runBenchmarks();
+      if (!FLAGS_json_output.empty() || !FLAGS_baseline.empty()) {
+        runQueries(out);
+      } else {
+        folly::runBenchmarks();
+      }
     } else {
       const auto queryPlan = FLAGS_io_meter_column_pct > 0
           ? queryBuilder->getIoMeterPlan(FLAGS_io_meter_column_pct)
@@ -103,6 +135,37 @@ class TpchBenchmark : public QueryBenchmarkBase {
           << std::endl;
     }
   }
+
+ private:
+  // Runs the queries in --queries and records their stats.
+  void runQueries(std::ostream& out) {
+    initializeQueryBuilder();
+    std::vector<int32_t> queryIds;
+    if (FLAGS_queries.empty()) {
+      for (auto i = 1; i <= 22; ++i) {
+        queryIds.push_back(i);
+      }
+    } else {
+      std::vector<std::string> ids;
+      folly::split(',', FLAGS_queries, ids);
+      for (const auto& id : ids) {
+        queryIds.push_back(folly::to<int32_t>(id));
+      }
+    }
+    for (auto queryId : queryIds) {
+      const auto name = fmt::format("q{}", queryId);
+      auto [cursor, results] = run(queryBuilder->getQueryPlan(queryId));
+      if (!cursor) {
+        LOG(ERROR) << name << " terminated with error. Exiting";
+        exit(1);
+      }
+      auto task = cursor->task();
+      ensureTaskCompletion(task.get());
+      recordQueryStats(name, *task);
+      out << name << ": " << folly::toJson(queryRunStats_.back().toJson())
+          << std::endl;
+    }
+  }
 };
 
 TpchBenchmark benchmark;
@@ -219,16 +282,15 @@ BENCHMARK(q22) {
 
 int tpchBenchmarkMain() {
   benchmark.initialize();
-  queryBuilder =
-      std::make_shared<TpchQueryBuilder>(toFileFormat(FLAGS_data_format));
-  queryBuilder->initialize(FLAGS_data_path);
+  initializeQueryBuilder();
   if (FLAGS_test_flags_file.empty()) {
     RunStats ignore;
     benchmark.runMain(std::cout, ignore);
   } else {
     benchmark.runAllCombinations();
   }
+  const auto numRegressions = benchmark.writeAndCompareQueryStats(std::cout);
   benchmark.shutdown();
   queryBuilder.reset();
-  return 0;
+  return numRegressions > 0 ? 1 : 0;
 }
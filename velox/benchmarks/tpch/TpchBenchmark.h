@@ -15,4 +15,5 @@
  */
 #pragma once
 
-void tpchBenchmarkMain();
+/// Returns 1 if a query regressed against --baseline, 0 otherwise.
+int tpchBenchmarkMain();
@@ -217,6 +217,35 @@ class BigintIdMap {
     return xsimd::load_unaligned(reinterpret_cast<int64_t*>(&resultVector));
   }
 
+  /// Removes all values. Keeps the table allocated. Ids start again at 1.
+  void clear() {
+    memset(table_, 0, byteSize_);
+    lastId_ = 0;
+    emptyId_ = 0;
+    emptyBatch_ = xsimd::broadcast(kNotFound);
+    numEntries_ = 0;
+  }
+
+  /// Number of values that have an id.
+  int32_t size() const {
+    return lastId_;
+  }
+
+  /// Returns true if adding 'numNew' values may grow the table.
+  bool mayResize(int32_t numNew) const {
+    return numEntries_ + numNew > maxEntries_;
+  }
+
+  /// Returns the size in bytes of the table.
+  int64_t allocatedBytes() const {
+    return byteSize_;
+  }
+
+  /// Number of entries in the table.
+  int64_t capacity() const {
+    return capacity_;
+  }
+
  private:
   using A = xsimd::default_arch;
 
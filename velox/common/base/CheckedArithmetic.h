@@ -20,6 +20,7 @@
 #include <string>
 #include "folly/Likely.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/Status.h"
 
 namespace facebook::velox {
 
@@ -90,4 +91,87 @@ T checkedNegate(const T& a) {
   return std::negate<std::remove_cv_t<T>>()(a);
 }
 
+namespace detail {
+// Returns a user error Status. Skips formatting the message if the errors are
+// not going to be reported, e.g. under TRY.
+template <typename... Args>
+FOLLY_NOINLINE Status arithmeticError(fmt::string_view format, Args&&... args) {
+  if (threadSkipErrorDetails()) {
+    return Status::UserError();
+  }
+  return Status::UserError(format, std::forward<Args>(args)...);
+}
+} // namespace detail
+
+/// The tryChecked functions below are variants of the checked functions above
+/// that return an error Status instead of throwing. They set 'result' only on
+/// success. Rows that fail under TRY do not pay for an exception.
+template <typename T>
+Status tryCheckedPlus(
+    const T& a,
+    const T& b,
+    T& result,
+    const char* typeName = "integer") {
+  if (UNLIKELY(__builtin_add_overflow(a, b, &result))) {
+    return detail::arithmeticError("{} overflow: {} + {}", typeName, a, b);
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status tryCheckedMinus(
+    const T& a,
+    const T& b,
+    T& result,
+    const char* typeName = "integer") {
+  if (UNLIKELY(__builtin_sub_overflow(a, b, &result))) {
+    return detail::arithmeticError("{} overflow: {} - {}", typeName, a, b);
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status tryCheckedMultiply(
+    const T& a,
+    const T& b,
+    T& result,
+    const char* typeName = "integer") {
+  if (UNLIKELY(__builtin_mul_overflow(a, b, &result))) {
+    return detail::arithmeticError("{} overflow: {} * {}", typeName, a, b);
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status tryCheckedDivide(const T& a, const T& b, T& result) {
+  if (UNLIKELY(b == 0)) {
+    return detail::arithmeticError("division by zero");
+  }
+  if constexpr (std::is_integral_v<T>) {
+    if (UNLIKELY(a == std::numeric_limits<T>::min() && b == -1)) {
+      return detail::arithmeticError("integer overflow: {} / {}", a, b);
+    }
+  }
+  result = a / b;
+  return Status::OK();
+}
+
+template <typename T>
+Status tryCheckedModulus(const T& a, const T& b, T& result) {
+  if (UNLIKELY(b == 0)) {
+    return detail::arithmeticError("Cannot divide by 0");
+  }
+  result = b == -1 ? 0 : a % b;
+  return Status::OK();
+}
+
+template <typename T>
+Status tryCheckedNegate(const T& a, T& result) {
+  if (UNLIKELY(a == std::numeric_limits<T>::min())) {
+    return detail::arithmeticError("Cannot negate minimum value");
+  }
+  result = std::negate<std::remove_cv_t<T>>()(a);
+  return Status::OK();
+}
+
 } // namespace facebook::velox
@@ -30,6 +30,15 @@ void registerVeloxMetrics() {
   DEFINE_HISTOGRAM_METRIC(
       kMetricDriverQueueTimeMs, 500, 0, 10'000, 50, 90, 99, 100);
 
+  // Tracks driver queue latency of each driver priority class in range of
+  // [0, 10s] with 20 buckets and reports P50, P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricInteractiveDriverQueueTimeMs, 500, 0, 10'000, 50, 90, 99, 100);
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricDefaultDriverQueueTimeMs, 500, 0, 10'000, 50, 90, 99, 100);
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricBatchDriverQueueTimeMs, 500, 0, 10'000, 50, 90, 99, 100);
+
   // Tracks driver execution latency in range of [0, 30s] with 30 buckets and
   // reports P50, P90, P99, and P100.
   DEFINE_HISTOGRAM_METRIC(
@@ -81,6 +90,11 @@ void registerVeloxMetrics() {
   // NOTE: This applies only to MmapAllocator
   DEFINE_METRIC(kMetricMmapDelegatedAllocBytes, facebook::velox::StatType::AVG);
 
+  // Number of allocations made from the size classes of a NUMA node other than
+  // the one the allocating thread ran on, since the last report.
+  DEFINE_METRIC(
+      kMetricMmapRemoteNumaAllocations, facebook::velox::StatType::SUM);
+
   /// ================== AsyncDataCache Counters =================
 
   // Max possible age of AsyncDataCache and SsdCache entries since the raw file
@@ -134,6 +148,20 @@ void registerVeloxMetrics() {
   DEFINE_METRIC(
       kMetricMemoryCacheSumEvictScore, facebook::velox::StatType::SUM);
 
+  // The percentage of memory cache lookups that hit, out of the hits and new
+  // entries since last counter retrieval.
+  DEFINE_METRIC(kMetricMemoryCacheHitRatioPct, facebook::velox::StatType::AVG);
+
+  // Number of evicted entries that were not hit after being loaded, since last
+  // counter retrieval. A large share of the evictions means cache thrashing.
+  DEFINE_METRIC(
+      kMetricMemoryCacheNumUnusedEvicts, facebook::velox::StatType::SUM);
+
+  // The average time in milliseconds that the entries counted in
+  // kMetricMemoryCacheNumUnusedEvicts stayed in cache.
+  DEFINE_METRIC(
+      kMetricMemoryCacheUnusedEvictAgeMs, facebook::velox::StatType::AVG);
+
   // Number of hits (saved IO) since last counter retrieval. The first hit to a
   // prefetched entry does not count.
   DEFINE_METRIC(kMetricMemoryCacheNumHits, facebook::velox::StatType::SUM);
@@ -201,6 +229,16 @@ void registerVeloxMetrics() {
   // Total number of bytes written to SSD.
   DEFINE_METRIC(kMetricSsdCacheWrittenBytes, facebook::velox::StatType::SUM);
 
+  // The percentage of new memory cache entries that were loaded from SSD cache
+  // since last counter retrieval.
+  DEFINE_METRIC(kMetricSsdCacheHitRatioPct, facebook::velox::StatType::AVG);
+
+  // The bytes written to SSD cache per 100 bytes read from it since last
+  // counter retrieval. Values well above 100 mean that most of the data
+  // written to SSD is evicted before being read back.
+  DEFINE_METRIC(
+      kMetricSsdCacheWriteAmplificationPct, facebook::velox::StatType::AVG);
+
   // Total number of SsdCache entries that are aged out and evicted given
   // configured TTL.
   DEFINE_METRIC(kMetricSsdCacheAgedOutEntries, facebook::velox::StatType::SUM);
@@ -440,6 +478,14 @@ void registerVeloxMetrics() {
   DEFINE_HISTOGRAM_METRIC(
       kMetricArbitratorOpExecTimeMs, 30'000, 0, 600'000, 50, 90, 99, 100);
 
+  // The distribution of the amount of time it takes to complete a single
+  // arbitration operation in range of [0, 10s] with 100 buckets. This has a
+  // finer resolution than kMetricArbitratorOpExecTimeMs for the common short
+  // arbitrations. It is configured to report the latency at P50, P90, P99, and
+  // P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricArbitratorOpLatencyMs, 100, 0, 10'000, 50, 90, 99, 100);
+
   // Tracks the average of free memory capacity managed by the arbitrator in
   // bytes.
   DEFINE_METRIC(
@@ -553,6 +599,14 @@ void registerVeloxMetrics() {
   // The peak spilling memory usage in bytes.
   DEFINE_METRIC(kMetricSpillPeakMemoryBytes, facebook::velox::StatType::AVG);
 
+  // The spill write throughput in bytes per second of write time since last
+  // counter retrieval.
+  DEFINE_METRIC(kMetricSpillWriteBytesPerSec, facebook::velox::StatType::AVG);
+
+  // The spill read throughput in bytes per second of read time since last
+  // counter retrieval.
+  DEFINE_METRIC(kMetricSpillReadBytesPerSec, facebook::velox::StatType::AVG);
+
   /// ================== Exchange Counters =================
 
   // Tracks exchange http transaction create delay in range of [0, 30s] with
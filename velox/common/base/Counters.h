@@ -117,6 +117,9 @@ constexpr folly::StringPiece kMetricArbitratorFailuresCount{
 constexpr folly::StringPiece kMetricArbitratorOpExecTimeMs{
     "velox.arbitrator_op_exec_time_ms"};
 
+constexpr folly::StringPiece kMetricArbitratorOpLatencyMs{
+    "velox.arbitrator_op_latency_ms"};
+
 constexpr folly::StringPiece kMetricArbitratorFreeCapacityBytes{
     "velox.arbitrator_free_capacity_bytes"};
 
@@ -129,6 +132,15 @@ constexpr folly::StringPiece kMetricDriverYieldCount{
 constexpr folly::StringPiece kMetricDriverQueueTimeMs{
     "velox.driver_queue_time_ms"};
 
+constexpr folly::StringPiece kMetricInteractiveDriverQueueTimeMs{
+    "velox.interactive_driver_queue_time_ms"};
+
+constexpr folly::StringPiece kMetricDefaultDriverQueueTimeMs{
+    "velox.default_driver_queue_time_ms"};
+
+constexpr folly::StringPiece kMetricBatchDriverQueueTimeMs{
+    "velox.batch_driver_queue_time_ms"};
+
 constexpr folly::StringPiece kMetricDriverExecTimeMs{
     "velox.driver_exec_time_ms"};
 
@@ -167,6 +179,12 @@ constexpr folly::StringPiece kMetricSpillMemoryBytes{
 constexpr folly::StringPiece kMetricSpillPeakMemoryBytes{
     "velox.spill_peak_memory_bytes"};
 
+constexpr folly::StringPiece kMetricSpillWriteBytesPerSec{
+    "velox.spill_write_bytes_per_sec"};
+
+constexpr folly::StringPiece kMetricSpillReadBytesPerSec{
+    "velox.spill_read_bytes_per_sec"};
+
 constexpr folly::StringPiece kMetricFileWriterEarlyFlushedRawBytes{
     "velox.file_writer_early_flushed_raw_bytes"};
 
@@ -188,6 +206,9 @@ constexpr folly::StringPiece kMetricMmapExternalMappedBytes{
 constexpr folly::StringPiece kMetricMmapDelegatedAllocBytes{
     "velox.mmap_allocator_delegated_alloc_bytes"};
 
+constexpr folly::StringPiece kMetricMmapRemoteNumaAllocations{
+    "velox.mmap_allocator_remote_numa_allocations"};
+
 constexpr folly::StringPiece kMetricCacheMaxAgeSecs{"velox.cache_max_age_secs"};
 
 constexpr folly::StringPiece kMetricMemoryCacheNumEntries{
@@ -223,6 +244,15 @@ constexpr folly::StringPiece kMetricMemoryCacheTotalPrefetchBytes{
 constexpr folly::StringPiece kMetricMemoryCacheSumEvictScore{
     "velox.memory_cache_sum_evict_score"};
 
+constexpr folly::StringPiece kMetricMemoryCacheHitRatioPct{
+    "velox.memory_cache_hit_ratio_pct"};
+
+constexpr folly::StringPiece kMetricMemoryCacheNumUnusedEvicts{
+    "velox.memory_cache_num_unused_evicts"};
+
+constexpr folly::StringPiece kMetricMemoryCacheUnusedEvictAgeMs{
+    "velox.memory_cache_unused_evict_age_ms"};
+
 constexpr folly::StringPiece kMetricMemoryCacheNumHits{
     "velox.memory_cache_num_hits"};
 
@@ -274,6 +304,12 @@ constexpr folly::StringPiece kMetricSsdCacheWrittenEntries{
 constexpr folly::StringPiece kMetricSsdCacheWrittenBytes{
     "velox.ssd_cache_written_bytes"};
 
+constexpr folly::StringPiece kMetricSsdCacheHitRatioPct{
+    "velox.ssd_cache_hit_ratio_pct"};
+
+constexpr folly::StringPiece kMetricSsdCacheWriteAmplificationPct{
+    "velox.ssd_cache_write_amplification_pct"};
+
 constexpr folly::StringPiece kMetricSsdCacheAgedOutEntries{
     "velox.ssd_cache_aged_out_entries"};
 
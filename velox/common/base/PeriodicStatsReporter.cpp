@@ -124,6 +124,12 @@ void PeriodicStatsReporter::reportAllocatorStats() {
         kMetricMmapExternalMappedBytes,
         velox::memory::AllocationTraits::pageBytes(
             (mmapAllocator->numExternalMapped())));
+    const auto numRemoteNumaAllocations =
+        mmapAllocator->numRemoteNumaAllocations();
+    REPORT_IF_NOT_ZERO(
+        kMetricMmapRemoteNumaAllocations,
+        numRemoteNumaAllocations - lastRemoteNumaAllocations_);
+    lastRemoteNumaAllocations_ = numRemoteNumaAllocations;
   }
   // TODO(xiaoxmeng): add memory allocation size stats.
 }
@@ -171,6 +177,19 @@ void PeriodicStatsReporter::reportCacheStats() {
       kMetricMemoryCacheNumAgedOutEntries, deltaCacheStats.numAgedOut);
   REPORT_IF_NOT_ZERO(
       kMetricMemoryCacheSumEvictScore, deltaCacheStats.sumEvictScore);
+  REPORT_IF_NOT_ZERO(
+      kMetricMemoryCacheNumUnusedEvicts, deltaCacheStats.numEvictUnused);
+  if (deltaCacheStats.numEvictUnused > 0) {
+    RECORD_METRIC_VALUE(
+        kMetricMemoryCacheUnusedEvictAgeMs,
+        deltaCacheStats.sumEvictUnusedAgeMs / deltaCacheStats.numEvictUnused);
+  }
+  const auto numLookups = deltaCacheStats.numHit + deltaCacheStats.numNew;
+  if (numLookups > 0) {
+    RECORD_METRIC_VALUE(
+        kMetricMemoryCacheHitRatioPct,
+        deltaCacheStats.numHit * 100 / numLookups);
+  }
 
   // SSD cache snapshot stats.
   if (cacheStats.ssdStats != nullptr) {
@@ -231,6 +250,17 @@ void PeriodicStatsReporter::reportCacheStats() {
         deltaSsdStats.readWithoutChecksumChecks);
     REPORT_IF_NOT_ZERO(
         kMetricSsdCacheRecoveredEntries, deltaSsdStats.entriesRecovered);
+    if (deltaCacheStats.numNew > 0) {
+      RECORD_METRIC_VALUE(
+          kMetricSsdCacheHitRatioPct,
+          std::min<int64_t>(
+              100, deltaSsdStats.entriesRead * 100 / deltaCacheStats.numNew));
+    }
+    if (deltaSsdStats.bytesRead > 0) {
+      RECORD_METRIC_VALUE(
+          kMetricSsdCacheWriteAmplificationPct,
+          deltaSsdStats.bytesWritten * 100 / deltaSsdStats.bytesRead);
+    }
   }
 
   // TTL controler snapshot stats.
@@ -254,6 +284,23 @@ void PeriodicStatsReporter::reportSpillStats() {
             << velox::succinctBytes(spillMemoryStats.peakBytes) << "]";
   RECORD_METRIC_VALUE(kMetricSpillMemoryBytes, spillMemoryStats.usedBytes);
   RECORD_METRIC_VALUE(kMetricSpillPeakMemoryBytes, spillMemoryStats.peakBytes);
+
+  // Throughput is per second of write or read time, not of wall time.
+  const auto spillStats = common::globalSpillStats();
+  const auto delta = spillStats - lastSpillStats_;
+  if (delta.spillWriteTimeNanos > 0) {
+    RECORD_METRIC_VALUE(
+        kMetricSpillWriteBytesPerSec,
+        static_cast<uint64_t>(
+            delta.spilledBytes * 1e9 / delta.spillWriteTimeNanos));
+  }
+  if (delta.spillReadTimeNanos > 0) {
+    RECORD_METRIC_VALUE(
+        kMetricSpillReadBytesPerSec,
+        static_cast<uint64_t>(
+            delta.spillReadBytes * 1e9 / delta.spillReadTimeNanos));
+  }
+  lastSpillStats_ = spillStats;
 }
 
 } // namespace facebook::velox
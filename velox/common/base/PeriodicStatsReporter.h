@@ -17,6 +17,7 @@
 #pragma once
 
 #include <folly/executors/ThreadedRepeatingFunctionRunner.h>
+#include "velox/common/base/SpillStats.h"
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFile.h"
 #include "velox/common/memory/MemoryArbitrator.h"
@@ -103,6 +104,8 @@ class PeriodicStatsReporter {
   const Options options_;
 
   cache::CacheStats lastCacheStats_;
+  common::SpillStats lastSpillStats_;
+  uint64_t lastRemoteNumaAllocations_{0};
 
   folly::ThreadedRepeatingFunctionRunner scheduler_;
 };
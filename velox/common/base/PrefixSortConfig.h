@@ -27,10 +27,14 @@ struct PrefixSortConfig {
   PrefixSortConfig(
       uint32_t _maxNormalizedKeyBytes,
       uint32_t _minNumRows,
-      uint32_t _maxStringPrefixLength)
+      uint32_t _maxStringPrefixLength,
+      uint32_t _maxAdaptiveStringPrefixLength = 0,
+      uint32_t _minRadixSortRows = 64 << 10)
       : maxNormalizedKeyBytes(_maxNormalizedKeyBytes),
         minNumRows(_minNumRows),
-        maxStringPrefixLength(_maxStringPrefixLength) {}
+        maxStringPrefixLength(_maxStringPrefixLength),
+        maxAdaptiveStringPrefixLength(_maxAdaptiveStringPrefixLength),
+        minRadixSortRows(_minRadixSortRows) {}
 
   /// Maximum bytes that can be used to store normalized keys in prefix-sort
   /// buffer per entry. Same with QueryConfig kPrefixSortNormalizedKeyMaxBytes.
@@ -43,5 +47,18 @@ struct PrefixSortConfig {
   /// Maximum number of bytes to be stored in prefix-sort buffer for a string
   /// column.
   uint32_t maxStringPrefixLength{16};
+
+  /// Maximum number of bytes to be stored in prefix-sort buffer for a string
+  /// column whose sampled values often tie on the first
+  /// 'maxStringPrefixLength' bytes. A string column whose values are all at
+  /// most this long is stored whole so that the next sort keys can be stored
+  /// as well. Prefixes are not extended if this is not larger than
+  /// 'maxStringPrefixLength'.
+  uint32_t maxAdaptiveStringPrefixLength{0};
+
+  /// Minimum number of rows to sort with radix sort instead of quick-sort.
+  /// Radix sort is only used if all the sort keys are stored whole in the
+  /// prefix-sort buffer. 0 disables radix sort.
+  uint32_t minRadixSortRows{64 << 10};
 };
 } // namespace facebook::velox::common
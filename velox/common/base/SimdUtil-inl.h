@@ -185,6 +185,11 @@ int32_t indicesOfSetBits(
   if (end <= begin) {
     return 0;
   }
+#if XSIMD_WITH_AVX512F
+  constexpr bool kCompressStore = std::is_base_of_v<xsimd::avx512f, A>;
+#else
+  constexpr bool kCompressStore = false;
+#endif
   int32_t row = begin & ~63;
   auto originalResult = result;
   int32_t endWord = bits::roundUp(end, 64) / 64;
@@ -218,33 +223,54 @@ int32_t indicesOfSetBits(
       } while (word);
       row += 64;
     } else {
-      for (auto byteCnt = 0; byteCnt < 8; ++byteCnt) {
-        uint8_t byte = word;
-        word = word >> 8;
-        if (byte) {
-          using Batch = xsimd::batch<int32_t, A>;
-          auto indices = byteSetBits(byte);
-          if constexpr (Batch::size == 8) {
-            (Batch::load_aligned(indices) + row).store_unaligned(result);
-            result += __builtin_popcount(byte);
-          } else {
-            static_assert(Batch::size == 4);
-            auto lo = byte & ((1 << 4) - 1);
-            auto hi = byte >> 4;
-            int pop = 0;
-            if (lo) {
+      if constexpr (kCompressStore) {
+#if XSIMD_WITH_AVX512F
+        // Compress-stores the positions of the set bits 16 at a time. Writes
+        // only the selected lanes, so nothing is written past the result.
+        const auto lanes = _mm512_setr_epi32(
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        for (auto quarter = 0; quarter < 4; ++quarter) {
+          const __mmask16 mask = word >> (quarter * 16);
+          if (mask) {
+            _mm512_mask_compressstoreu_epi32(
+                result,
+                mask,
+                _mm512_add_epi32(
+                    lanes, _mm512_set1_epi32(row + quarter * 16)));
+            result += __builtin_popcount(mask);
+          }
+        }
+#endif
+        row += 64;
+      } else {
+        for (auto byteCnt = 0; byteCnt < 8; ++byteCnt) {
+          uint8_t byte = word;
+          word = word >> 8;
+          if (byte) {
+            using Batch = xsimd::batch<int32_t, A>;
+            auto indices = byteSetBits(byte);
+            if constexpr (Batch::size == 8) {
               (Batch::load_aligned(indices) + row).store_unaligned(result);
-              pop = __builtin_popcount(lo);
-              result += pop;
-            }
-            if (hi) {
-              (Batch::load_unaligned(indices + pop) + row)
-                  .store_unaligned(result);
-              result += __builtin_popcount(hi);
+              result += __builtin_popcount(byte);
+            } else {
+              static_assert(Batch::size == 4);
+              auto lo = byte & ((1 << 4) - 1);
+              auto hi = byte >> 4;
+              int pop = 0;
+              if (lo) {
+                (Batch::load_aligned(indices) + row).store_unaligned(result);
+                pop = __builtin_popcount(lo);
+                result += pop;
+              }
+              if (hi) {
+                (Batch::load_unaligned(indices + pop) + row)
+                    .store_unaligned(result);
+                result += __builtin_popcount(hi);
+              }
             }
           }
+          row += 8;
         }
-        row += 8;
       }
     }
   }
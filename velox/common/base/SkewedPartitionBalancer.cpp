@@ -25,7 +25,8 @@ SkewedPartitionRebalancer::SkewedPartitionRebalancer(
     uint32_t numPartitions,
     uint32_t numTasks,
     uint64_t minProcessedBytesRebalanceThresholdPerPartition,
-    uint64_t minProcessedBytesRebalanceThreshold)
+    uint64_t minProcessedBytesRebalanceThreshold,
+    const std::vector<uint32_t>& scalablePartitions)
     : numPartitions_(numPartitions),
       numTasks_(numTasks),
       minProcessedBytesRebalanceThresholdPerPartition_(
@@ -38,6 +39,14 @@ SkewedPartitionRebalancer::SkewedPartitionRebalancer(
   VELOX_CHECK_GT(numPartitions_, 0);
   VELOX_CHECK_GT(numTasks_, 0);
 
+  if (!scalablePartitions.empty()) {
+    scalablePartitions_.resize(numPartitions_, false);
+    for (const auto partition : scalablePartitions) {
+      VELOX_CHECK_LT(partition, numPartitions_);
+      scalablePartitions_[partition] = true;
+    }
+  }
+
   partitionBytes_.resize(numPartitions_, 0);
   partitionBytesAtLastRebalance_.resize(numPartitions_, 0);
   partitionBytesSinceLastRebalancePerTask_.resize(numPartitions_, 0);
@@ -171,6 +180,9 @@ void SkewedPartitionRebalancer::rebalanceBasedOnTaskSkewness(
       if (scaledPartitions.count(maxPartition) != 0) {
         continue;
       }
+      if (!scalablePartitions_.empty() && !scalablePartitions_[maxPartition]) {
+        continue;
+      }
 
       const uint32_t totalAssignedTasks =
           partitionAssignments_[maxPartition].size();
@@ -25,7 +25,8 @@ class SkewedPartitionRebalancerTestHelper;
 
 /// This class is used to auto-scale partition processing by assigning more
 /// tasks to busy partition measured by processed data size. This is used by
-/// local partition to scale table writers for now.
+/// local partition to scale table writers, and by partitioned output to spread
+/// skewed join partitions across more consumers.
 class SkewedPartitionRebalancer {
  public:
   /// 'numPartitions' is the number of partitions to process. 'numTasks' is
@@ -37,12 +38,15 @@ class SkewedPartitionRebalancer {
   /// tasks to busy partitions from the busy tasks. A partition load is measured
   /// as the number of processed data size in bytes. Similarly, a task load is
   /// measured in the total number of processed data size from all its serving
-  /// partitions.
+  /// partitions. If 'scalablePartitions' is not empty, only the listed
+  /// partitions are assigned more tasks. The load of the other partitions
+  /// still counts towards the load of their tasks.
   SkewedPartitionRebalancer(
       uint32_t numPartitions,
       uint32_t numTasks,
       uint64_t minProcessedBytesRebalanceThresholdPerPartition,
-      uint64_t minProcessedBytesRebalanceThreshold);
+      uint64_t minProcessedBytesRebalanceThreshold,
+      const std::vector<uint32_t>& scalablePartitions = {});
 
   ~SkewedPartitionRebalancer() {
     VELOX_CHECK(!rebalancing_);
@@ -148,6 +152,8 @@ class SkewedPartitionRebalancer {
   const uint32_t numTasks_;
   const uint64_t minProcessedBytesRebalanceThresholdPerPartition_;
   const uint64_t minProcessedBytesRebalanceThreshold_;
+  // Indexed by partition. Empty if all partitions are scalable.
+  std::vector<bool> scalablePartitions_;
 
   // The accumulated number of rows processed by each partition.
   std::vector<std::atomic_uint64_t> partitionRowCount_;
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
 #include "velox/common/base/Exceptions.h"
 
 namespace facebook::velox {
@@ -24,6 +27,20 @@ constexpr int kSortingNetworkMaxSize = 16;
 template <typename T, typename LessThan = std::less<T>>
 void sortingNetwork(T* data, int size, LessThan&& lt = {});
 
+/// Sorts 'size' values at 'data'.  Arithmetic values are sorted with a
+/// sorting network when there are at most kSortingNetworkMaxSize of them,
+/// which avoids the mispredicted branches of std::sort on short ranges.
+template <typename T, typename LessThan = std::less<T>>
+void sortSmallWithNetwork(T* data, int64_t size, LessThan&& lt = {}) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    if (size <= kSortingNetworkMaxSize) {
+      sortingNetwork(data, size, std::forward<LessThan>(lt));
+      return;
+    }
+  }
+  std::sort(data, data + size, std::forward<LessThan>(lt));
+}
+
 namespace detail {
 
 // Compile time generated Bose-Nelson sorting network.
@@ -63,7 +63,10 @@ struct SpillConfig {
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
       std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      bool _asyncWriteEnabled = false,
+      uint32_t _numReadAheadBuffers = 0,
+      uint32_t _compressionDictionarySize = 0);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -148,5 +151,20 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// If true and 'executor' is set, the spill writers write the serialized
+  /// data to disk on 'executor' while serializing the next write buffer.
+  bool asyncWriteEnabled{false};
+
+  /// The number of 'readBufferSize' buffers to read ahead for each spill file
+  /// when merging sorted spill runs. If the file system has no async read, the
+  /// reads ahead run on 'executor'. If zero, reads one buffer ahead only if the
+  /// file system supports async read.
+  uint32_t numReadAheadBuffers{0};
+
+  /// If not zero and 'compressionKind' is ZSTD, each spill writer trains a
+  /// ZSTD dictionary of up to this many bytes from its first write buffer and
+  /// compresses the later ones with it.
+  uint32_t compressionDictionarySize{0};
 };
 } // namespace facebook::velox::common
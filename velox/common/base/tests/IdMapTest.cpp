@@ -255,6 +255,27 @@ TEST_F(IdMapTest, zerosAndMasks) {
   expect4(kNotFound, 0, kNotFound, 0, findIds4(mapWithNoZero, mix, 5));
 }
 
+TEST_F(IdMapTest, clear) {
+  constexpr int64_t kNotFound = BigintIdMap::kNotFound;
+
+  BigintIdMap map(1024, *pool_);
+  int64_t values[4] = {10, 0, 20, 30};
+  expect4(2, 1, 3, 4, makeIds4(map, values));
+  EXPECT_EQ(4, map.size());
+
+  const auto allocatedBytes = map.allocatedBytes();
+  map.clear();
+  EXPECT_EQ(0, map.size());
+  EXPECT_EQ(allocatedBytes, map.allocatedBytes());
+  expect4(
+      kNotFound, kNotFound, kNotFound, kNotFound, findIds4(map, values));
+
+  // Ids start again at 1.
+  int64_t others[4] = {30, 40, 10, 50};
+  expect4(1, 2, 3, 4, makeIds4(map, others));
+  expect4(3, kNotFound, kNotFound, 1, findIds4(map, values));
+}
+
 TEST_F(IdMapTest, collisions) {
   constexpr int64_t kNotFound = BigintIdMap::kNotFound;
   // We check the found and not found stay the same as the table gets filled
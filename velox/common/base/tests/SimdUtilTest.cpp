@@ -143,6 +143,74 @@ TEST_F(SimdUtilTest, bitIndices) {
   testIndices(999);
 }
 
+TEST_F(SimdUtilTest, bitIndicesPaths) {
+  // Runs the SIMD instantiations of indicesOfSetBits against
+  // bits::forEachSetBit. AVX-512 stores the positions with compress-store,
+  // and AVX2 and SSE use the per-byte table. Sparse words take the scalar
+  // loop in each of them.
+  constexpr int32_t kWords = 8;
+  constexpr int32_t kBits = kWords * 64;
+  std::vector<uint64_t> bits(kWords);
+  std::vector<int32_t> reference(kBits);
+  // Leaves room for the full batch stores of the per-byte table path.
+  std::vector<int32_t> test(kBits + 16);
+  const std::vector<int32_t> bounds = {
+      0, 1, 15, 16, 17, 63, 64, 65, 127, 128, 129, 255, 256, 448, 511, 512};
+  auto testArch = [&](const auto& arch) {
+    for (auto begin : bounds) {
+      for (auto end : bounds) {
+        if (end < begin) {
+          continue;
+        }
+        SCOPED_TRACE(
+            "begin " + std::to_string(begin) + " end " + std::to_string(end));
+        const auto numReference =
+            simpleIndicesOfSetBits(bits.data(), begin, end, reference.data());
+        const auto numTest =
+            simd::indicesOfSetBits(bits.data(), begin, end, test.data(), arch);
+        ASSERT_EQ(numReference, numTest);
+        ASSERT_EQ(
+            0,
+            memcmp(
+                reference.data(),
+                test.data(),
+                numReference * sizeof(reference[0])));
+      }
+    }
+  };
+  auto testAllArchs = [&](const std::string& pattern) {
+    SCOPED_TRACE(pattern);
+    testArch(xsimd::default_arch{});
+#if XSIMD_WITH_AVX512F
+    testArch(xsimd::avx512f{});
+#endif
+#if XSIMD_WITH_AVX2
+    testArch(xsimd::avx2{});
+#endif
+#if XSIMD_WITH_SSE4_2
+    testArch(xsimd::sse4_2{});
+#endif
+  };
+
+  std::fill(bits.begin(), bits.end(), 0);
+  testAllArchs("all clear");
+  std::fill(bits.begin(), bits.end(), ~0ULL);
+  testAllArchs("all set");
+  std::fill(bits.begin(), bits.end(), 0x5555555555555555ULL);
+  testAllArchs("every other bit");
+  // Only the first and last bit of each 16 bit lane group and of each word.
+  std::fill(bits.begin(), bits.end(), 0x8001800180018001ULL);
+  testAllArchs("lane boundaries");
+  std::fill(bits.begin(), bits.end(), 0);
+  for (auto word = 0; word < kWords; word += 2) {
+    bits[word] = ~0ULL;
+  }
+  testAllArchs("alternate words");
+  std::fill(bits.begin(), bits.end(), 0);
+  randomBits(bits, 700);
+  testAllArchs("random");
+}
+
 TEST_F(SimdUtilTest, gather32) {
   int32_t indices8[8] = {7, 6, 5, 4, 3, 2, 1, 0};
   int32_t indices6[8] = {7, 6, 5, 4, 3, 2, 1 << 31, 1 << 31};
@@ -290,6 +290,27 @@ TEST_F(SkewedPartitionRebalancerTest, partitionScaleProcessBytesThreshold) {
   }
 }
 
+TEST_F(SkewedPartitionRebalancerTest, scalablePartitions) {
+  SkewedPartitionRebalancer balancer(32, 4, 128, 256, {1});
+  SkewedPartitionRebalancerTestHelper helper(&balancer);
+  balancer.addProcessedBytes(512);
+  balancer.addPartitionRowCount(0, 100);
+  balancer.addPartitionRowCount(1, 100);
+  balancer.rebalance();
+  ASSERT_EQ(balancer.stats().numBalanceTriggers, 1);
+  ASSERT_EQ(balancer.stats().numScaledPartitions, 1);
+
+  // Partition 0 is as busy as partition 1 but is not scalable.
+  helper.verifyPartitionAssignment(0, {0});
+  ASSERT_EQ(balancer.getTaskId(1, 0), 1);
+  ASSERT_NE(balancer.getTaskId(1, 1), 1);
+  for (int i = 2; i < helper.numPartitions(); ++i) {
+    helper.verifyPartitionAssignment(i, {i % helper.numTasks()});
+  }
+
+  VELOX_ASSERT_THROW(SkewedPartitionRebalancer(32, 4, 128, 256, {32}), "");
+}
+
 TEST_F(SkewedPartitionRebalancerTest, skewTasksCondition) {
   auto balancer = createBalancer(32, 4, 128, 256);
   SkewedPartitionRebalancerTestHelper helper(balancer.get());
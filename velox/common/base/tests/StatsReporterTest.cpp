@@ -502,6 +502,8 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutRegions.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheRecoveredEntries.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadWithoutChecksum.str()), 0);
+    ASSERT_EQ(counterMap.count(kMetricMemoryCacheHitRatioPct.str()), 0);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheHitRatioPct.str()), 0);
     ASSERT_EQ(counterMap.size(), 22);
   }
 
@@ -541,6 +543,8 @@ TEST_F(PeriodicStatsReporterTest, basic) {
        .numAgedOut = 10,
        .allocClocks = 10,
        .sumEvictScore = 10,
+       .numEvictUnused = 10,
+       .sumEvictUnusedAgeMs = 100,
        .ssdStats = newSsdStats});
   arbitrator.updateStats(memory::MemoryArbitrator::Stats(
       10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10));
@@ -585,7 +589,12 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutRegions.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheRecoveredEntries.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadWithoutChecksum.str()), 1);
-    ASSERT_EQ(counterMap.size(), 54);
+    ASSERT_EQ(counterMap.at(kMetricMemoryCacheNumUnusedEvicts.str()), 10);
+    ASSERT_EQ(counterMap.at(kMetricMemoryCacheUnusedEvictAgeMs.str()), 10);
+    ASSERT_EQ(counterMap.at(kMetricMemoryCacheHitRatioPct.str()), 50);
+    ASSERT_EQ(counterMap.at(kMetricSsdCacheHitRatioPct.str()), 100);
+    ASSERT_EQ(counterMap.at(kMetricSsdCacheWriteAmplificationPct.str()), 100);
+    ASSERT_EQ(counterMap.size(), 59);
   }
 }
 
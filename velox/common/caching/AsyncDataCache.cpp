@@ -24,6 +24,9 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/process/TraceEvents.h"
+
+#include <folly/io/Cursor.h>
 
 #define VELOX_CACHE_ERROR(errorMessage)                             \
   _VELOX_THROW(                                                     \
@@ -151,6 +154,21 @@ std::string AsyncDataCacheEntry::toString() const {
       numPins_);
 }
 
+CacheShard::CacheShard(
+    AsyncDataCache* cache,
+    double maxWriteRatio,
+    int32_t admissionSketchWidth)
+    : cache_(cache),
+      maxWriteRatio_(maxWriteRatio),
+      admissionSketch_(
+          admissionSketchWidth == 0
+              ? nullptr
+              : std::make_unique<FrequencySketch>(admissionSketchWidth)),
+      codec_(
+          cache->maxCompressedBytes() == 0
+              ? nullptr
+              : common::compressionKindToCodec(common::CompressionKind_LZ4)) {}
+
 std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
   std::unique_ptr<AsyncDataCacheEntry> newEntry;
   if (freeEntries_.empty()) {
@@ -168,9 +186,10 @@ CachePin CacheShard::findOrCreate(
     folly::SemiFuture<bool>* wait) {
   AsyncDataCacheEntry* entryToInit = nullptr;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::unique_lock<std::mutex> l(mutex_);
     ++eventCounter_;
     auto it = entryMap_.find(key);
+    const bool admitted = admit(key, it == entryMap_.end());
     if (it != entryMap_.end()) {
       auto* foundEntry = it->second;
       if (foundEntry->isExclusive()) {
@@ -191,6 +210,17 @@ CachePin CacheShard::findOrCreate(
           ++numHit_;
           hitBytes_ += foundEntry->size();
         }
+        if (foundEntry->isCompressed()) {
+          // Take the entry exclusively so that other readers wait for the
+          // decompression, which is done outside of 'mutex_'.
+          auto compressed = std::move(foundEntry->compressed_);
+          cache_->decrementCompressedBytes(
+              compressed->computeChainDataLength());
+          foundEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
+          ++numDecompressed_;
+          l.unlock();
+          return decompressEntry(foundEntry, std::move(compressed));
+        }
         ++foundEntry->numPins_;
         CachePin pin;
         pin.setEntry(foundEntry);
@@ -216,6 +246,16 @@ CachePin CacheShard::findOrCreate(
     // Initialize the members that must be set inside 'mutex_'.
     newEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
     newEntry->promise_ = nullptr;
+    if (admissionSketch_ != nullptr) {
+      // A recycled entry must not inherit the access history of its previous
+      // contents. A rejected entry is evicted first once unpinned, unless it
+      // gets a hit.
+      if (admitted) {
+        newEntry->accessStats_.reset();
+      } else {
+        newEntry->makeEvictable();
+      }
+    }
     entryToInit = newEntry.get();
     entryMap_[key] = newEntry.get();
     if (emptySlots_.empty()) {
@@ -231,9 +271,38 @@ CachePin CacheShard::findOrCreate(
     entryToInit->size_ = size;
     entryToInit->isFirstUse_ = true;
   }
+  VELOX_TRACE_PROBE(cache_miss, key.fileNum, key.offset, size);
+  process::addTraceEvent(
+      "cache", "miss", [&]() { return fmt::format("{} bytes", size); });
   return initEntry(key, entryToInit);
 }
 
+bool CacheShard::admit(RawFileCacheKey key, bool newEntry) {
+  if (admissionSketch_ == nullptr) {
+    return true;
+  }
+  const auto hash = std::hash<RawFileCacheKey>()(key);
+  admissionSketch_->increment(hash);
+  // Admit everything until the shard is full enough to evict.
+  if (!newEntry || numEvict_ == 0 || entries_.empty()) {
+    return true;
+  }
+  // The eviction loop starts at the entry after 'clockHand_'.
+  const auto* victim = entries_[(clockHand_ + 1) % entries_.size()].get();
+  if (victim == nullptr || !victim->key_.fileNum.hasValue()) {
+    return true;
+  }
+  ++numAdmissionChecks_;
+  const auto victimHash = std::hash<RawFileCacheKey>()(
+      RawFileCacheKey{victim->key_.fileNum.id(), victim->key_.offset});
+  if (admissionSketch_->estimate(hash) <
+      admissionSketch_->estimate(victimHash)) {
+    ++numAdmissionRejects_;
+    return false;
+  }
+  return true;
+}
+
 void CacheShard::makeEvictable(RawFileCacheKey key) {
   std::lock_guard<std::mutex> l(mutex_);
   auto it = entryMap_.find(key);
@@ -269,6 +338,81 @@ CachePin CacheShard::initEntry(
   return pin;
 }
 
+bool CacheShard::tryCompressLocked(AsyncDataCacheEntry* entry) {
+  // Entries that compress to more than this fraction of their size are
+  // dropped instead.
+  constexpr double kMaxCompressedRatio = 0.8;
+  if (codec_ == nullptr || entry->isCompressed() || entry->data_.empty() ||
+      !entry->key_.fileNum.hasValue() || entry->isPrefetch() ||
+      entry->ssdSaveable()) {
+    return false;
+  }
+  std::unique_ptr<folly::IOBuf> input;
+  uint64_t remaining = entry->size_;
+  for (auto i = 0; i < entry->data_.numRuns() && remaining > 0; ++i) {
+    const auto run = entry->data_.runAt(i);
+    const auto bytes = std::min<uint64_t>(run.numBytes(), remaining);
+    auto buffer = folly::IOBuf::wrapBuffer(run.data<char>(), bytes);
+    if (input == nullptr) {
+      input = std::move(buffer);
+    } else {
+      input->appendToChain(std::move(buffer));
+    }
+    remaining -= bytes;
+  }
+  auto compressed = codec_->compress(input.get());
+  const auto compressedSize = compressed->computeChainDataLength();
+  if (compressedSize > entry->size_ * kMaxCompressedRatio ||
+      !cache_->tryIncrementCompressedBytes(compressedSize)) {
+    return false;
+  }
+  entry->compressed_ = std::move(compressed);
+  ++numCompressed_;
+  return true;
+}
+
+CachePin CacheShard::decompressEntry(
+    AsyncDataCacheEntry* entry,
+    std::unique_ptr<folly::IOBuf> compressed) {
+  // 'entry' is exclusive and has no data. Allocating may evict from this shard.
+  const auto numPages = memory::AllocationTraits::numPages(entry->size_);
+  bool allocated;
+  {
+    ClockTimer t(allocClocks_);
+    allocated =
+        cache_->allocator()->allocateNonContiguous(numPages, entry->data_);
+  }
+  if (!allocated) {
+    entry->release();
+    VELOX_CACHE_ERROR(fmt::format(
+        "Failed to allocate {} pages for decompressing cache entry: {}",
+        numPages,
+        cache_->allocator()->getAndClearFailureMessage()));
+  }
+  cache_->incrementCachedPages(entry->data_.numPages());
+  try {
+    // A codec per call since 'codec_' is used inside 'mutex_'.
+    const auto uncompressed =
+        common::compressionKindToCodec(common::CompressionKind_LZ4)
+            ->uncompress(compressed.get(), entry->size_);
+    folly::io::Cursor cursor(uncompressed.get());
+    uint64_t remaining = entry->size_;
+    for (auto i = 0; i < entry->data_.numRuns() && remaining > 0; ++i) {
+      const auto run = entry->data_.runAt(i);
+      const auto bytes = std::min<uint64_t>(run.numBytes(), remaining);
+      cursor.pull(run.data<char>(), bytes);
+      remaining -= bytes;
+    }
+  } catch (const std::exception&) {
+    entry->release();
+    throw;
+  }
+  entry->setExclusiveToShared(/*ssdSavable=*/false);
+  CachePin pin;
+  pin.setEntry(entry);
+  return pin;
+}
+
 CoalescedLoad::~CoalescedLoad() {
   // Continue possibly waiting threads.
   setEndState(State::kCancelled);
@@ -362,6 +506,11 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
   }
   entry->tinyData_.clear();
   entry->tinyData_.shrink_to_fit();
+  if (entry->compressed_ != nullptr) {
+    cache_->decrementCompressedBytes(
+        entry->compressed_->computeChainDataLength());
+    entry->compressed_.reset();
+  }
   entry->size_ = 0;
 }
 
@@ -421,6 +570,8 @@ uint64_t CacheShard::evict(
           ++evictSaveableSkipped;
           continue;
         }
+        const bool compressed =
+            !evictAllUnpinned && tryCompressLocked(candidate);
         if (candidate->ssdSaveable()) {
           ++numSavableEvict_;
         }
@@ -435,11 +586,29 @@ uint64_t CacheShard::evict(
         } else {
           toFree.push_back(std::move(candidate->data()));
         }
+        if (compressed) {
+          // The entry stays in the cache with only the compressed copy of its
+          // data. It starts over as recently used so that it is dropped when
+          // it gets old again.
+          candidate->accessStats_.lastUse = now;
+          if (largeEvicted + tinyEvicted > bytesToFree) {
+            break;
+          }
+          continue;
+        }
         tinyEvicted += candidate->tinyData_.size();
         candidate->tinyData_.clear();
         candidate->tinyData_.shrink_to_fit();
         candidate->size_ = 0;
 
+        // 'lastUse' of an entry that was not hit is its load time. 0 is for
+        // explicitly evictable entries.
+        if (candidate->accessStats_.numUses == 0 &&
+            candidate->accessStats_.lastUse != 0) {
+          ++numEvictUnused_;
+          sumEvictUnusedAgeMs_ += std::max<int32_t>(
+              0, now - candidate->accessStats_.lastUse);
+        }
         removeEntryLocked(candidate);
         emptySlots_.push_back(entryIndex);
         tryAddFreeEntry(std::move(*iter));
@@ -536,6 +705,11 @@ void CacheShard::updateStats(CacheStats& stats) {
     }
 
     ++stats.numEntries;
+    if (entry->compressed_ != nullptr) {
+      ++stats.numCompressedEntries;
+      stats.compressedSize += entry->compressed_->computeChainDataLength();
+      continue;
+    }
     stats.tinySize += entry->tinyData_.size();
     stats.tinyPadding += entry->tinyData_.capacity() - entry->tinyData_.size();
     if (entry->tinyData_.empty()) {
@@ -553,6 +727,12 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numAgedOut += numAgedOut_;
   stats.numStales += numStales_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numEvictUnused += numEvictUnused_;
+  stats.sumEvictUnusedAgeMs += sumEvictUnusedAgeMs_;
+  stats.numAdmissionChecks += numAdmissionChecks_;
+  stats.numAdmissionRejects += numAdmissionRejects_;
+  stats.numCompressed += numCompressed_;
+  stats.numDecompressed += numDecompressed_;
   stats.allocClocks += allocClocks_;
 }
 
@@ -643,6 +823,12 @@ CacheStats CacheStats::operator-(const CacheStats& other) const {
   result.numStales = numStales - other.numStales;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
+  result.numEvictUnused = numEvictUnused - other.numEvictUnused;
+  result.sumEvictUnusedAgeMs = sumEvictUnusedAgeMs - other.sumEvictUnusedAgeMs;
+  result.numAdmissionChecks = numAdmissionChecks - other.numAdmissionChecks;
+  result.numAdmissionRejects = numAdmissionRejects - other.numAdmissionRejects;
+  result.numCompressed = numCompressed - other.numCompressed;
+  result.numDecompressed = numDecompressed - other.numDecompressed;
   if (ssdStats != nullptr) {
     if (other.ssdStats != nullptr) {
       result.ssdStats =
@@ -668,7 +854,8 @@ AsyncDataCache::AsyncDataCache(
       ssdCache_(std::move(ssdCache)),
       cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this, opts_.maxWriteRatio));
+    shards_.push_back(std::make_unique<CacheShard>(
+        this, opts_.maxWriteRatio, opts_.admissionSketchWidth));
   }
 }
 
@@ -1008,8 +1195,18 @@ std::string CacheStats::toString() const {
       << " hit bytes: " << succinctBytes(hitBytes) << " eviction: " << numEvict
       << " savable eviction: " << numSavableEvict
       << " eviction checks: " << numEvictChecks << " aged out: " << numAgedOut
-      << " stales: " << numStales
-      << "\n"
+      << " stales: " << numStales;
+  if (numAdmissionChecks > 0) {
+    out << " admission checks: " << numAdmissionChecks
+        << " admission rejects: " << numAdmissionRejects;
+  }
+  if (numCompressed > 0) {
+    out << " compressed: " << numCompressed
+        << " decompressed: " << numDecompressed
+        << " compressed entries: " << numCompressedEntries
+        << " compressed size: " << succinctBytes(compressedSize);
+  }
+  out << "\n"
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
@@ -23,14 +23,17 @@
 #include <folly/chrono/Hardware.h>
 #include <folly/container/F14Set.h>
 #include <folly/futures/SharedPromise.h>
+#include <folly/io/IOBuf.h>
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/MemoryAllocator.h"
@@ -181,6 +184,13 @@ class AsyncDataCacheEntry {
     return tinyData_.empty() ? nullptr : tinyData_.data();
   }
 
+  /// True if the data of 'this' is held LZ4 compressed instead of in 'data_'.
+  /// A compressed entry is decompressed when it is next hit. See
+  /// AsyncDataCache::Options::maxCompressedBytes.
+  bool isCompressed() const {
+    return compressed_ != nullptr;
+  }
+
   const FileCacheKey& key() const {
     return key_;
   }
@@ -297,6 +307,10 @@ class AsyncDataCacheEntry {
   // page (kTinyDataSize).
   std::string tinyData_;
 
+  // Contains the LZ4 compressed data if this has been compressed instead of
+  // being evicted. 'data_' is then empty.
+  std::unique_ptr<folly::IOBuf> compressed_;
+
   std::unique_ptr<folly::SharedPromise<bool>> promise_;
   int32_t size_{0};
 
@@ -510,6 +524,10 @@ struct CacheStats {
   /// Total size of shared/exclusive pinned entries.
   int64_t sharedPinnedBytes{0};
   int64_t exclusivePinnedBytes{0};
+  /// Number of entries held compressed.
+  int32_t numCompressedEntries{0};
+  /// Total compressed size of the entries held compressed.
+  int64_t compressedSize{0};
 
   /// ============= Cumulative stats =============
 
@@ -541,6 +559,24 @@ struct CacheStats {
   /// Sum of scores of evicted entries. This serves to infer an average
   /// lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  /// Number of evicted entries that were not hit after being loaded. A high
+  /// share of 'numEvict' means the cache is too small for the working set.
+  int64_t numEvictUnused{0};
+  /// Sum of the ages in milliseconds of the entries in 'numEvictUnused'.
+  /// Approximate, like AccessTime.
+  int64_t sumEvictUnusedAgeMs{0};
+  /// Number of new entries whose access frequency was compared with the next
+  /// eviction candidate by the admission filter.
+  int64_t numAdmissionChecks{0};
+  /// Number of new entries that were less frequently accessed than the next
+  /// eviction candidate and were admitted as immediately evictable. A high
+  /// ratio over 'numAdmissionChecks' indicates a scan of cold data.
+  int64_t numAdmissionRejects{0};
+  /// Number of times an eviction candidate was compressed and kept instead of
+  /// being dropped.
+  int64_t numCompressed{0};
+  /// Number of hits that decompressed a compressed entry.
+  int64_t numDecompressed{0};
 
   /// Ssd cache stats that include both snapshot and cumulative stats.
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
@@ -556,8 +592,12 @@ struct CacheStats {
 /// and other housekeeping.
 class CacheShard {
  public:
-  CacheShard(AsyncDataCache* cache, double maxWriteRatio)
-      : cache_(cache), maxWriteRatio_(maxWriteRatio) {}
+  /// If 'admissionSketchWidth' is not 0, new entries are filtered by a
+  /// FrequencySketch of this width. See AsyncDataCache::Options.
+  CacheShard(
+      AsyncDataCache* cache,
+      double maxWriteRatio,
+      int32_t admissionSketchWidth = 0);
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -642,10 +682,27 @@ class CacheShard {
 
   CachePin initEntry(RawFileCacheKey key, AsyncDataCacheEntry* entry);
 
+  // Records an access to 'key' in 'admissionSketch_'. If the shard is evicting
+  // and 'newEntry' is true, returns false if 'key' is less frequently accessed
+  // than the next eviction candidate.
+  bool admit(RawFileCacheKey key, bool newEntry);
+
   void freeAllocations(std::vector<memory::Allocation>& allocations);
 
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
 
+  // Compresses the data of the unpinned 'entry' into 'entry->compressed_' if
+  // the compressed tier is enabled, 'entry' is eligible, the data compresses
+  // well enough and the tier has space. Returns true if 'entry' was
+  // compressed. 'entry->data_' is not freed.
+  bool tryCompressLocked(AsyncDataCacheEntry* entry);
+
+  // Decompresses 'compressed' into newly allocated memory of the exclusively
+  // pinned 'entry' outside of 'mutex_' and returns a shared pin on 'entry'.
+  CachePin decompressEntry(
+      AsyncDataCacheEntry* entry,
+      std::unique_ptr<folly::IOBuf> compressed);
+
   AsyncDataCache* const cache_;
   const double maxWriteRatio_;
 
@@ -687,6 +744,24 @@ class CacheShard {
   // Cumulative sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
+  // Cumulative count and sum of ages of evicted entries that were not hit
+  // after being loaded.
+  uint64_t numEvictUnused_{0};
+  uint64_t sumEvictUnusedAgeMs_{0};
+  // Recent access frequencies of keys, including evicted ones. nullptr if the
+  // admission filter is disabled.
+  std::unique_ptr<FrequencySketch> admissionSketch_;
+  // LZ4 codec for compressing eviction candidates. nullptr if the compressed
+  // tier is disabled. Used inside 'mutex_'.
+  const std::unique_ptr<folly::compression::Codec> codec_;
+  // Cumulative count of new entries checked by the admission filter.
+  uint64_t numAdmissionChecks_{0};
+  // Cumulative count of new entries rejected by the admission filter.
+  uint64_t numAdmissionRejects_{0};
+  // Cumulative count of eviction candidates kept compressed.
+  uint64_t numCompressed_{0};
+  // Cumulative count of compressed entries decompressed on hit.
+  uint64_t numDecompressed_{0};
   // Tracker of cumulative time spent in allocating/freeing MemoryAllocator
   // space for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
@@ -722,6 +797,28 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// If not 0, enables a TinyLFU style admission filter: each shard keeps a
+    /// count-min sketch of this many counters per hash function that tracks
+    /// recent access frequencies of keys. Once the shard evicts, a new entry
+    /// that is less frequently accessed than the next eviction candidate is
+    /// admitted as immediately evictable, unless it is hit again before being
+    /// evicted. This keeps a one-time scan from evicting frequently used data.
+    int32_t admissionSketchWidth{0};
+
+    /// If not 0, a large entry that is selected for eviction is LZ4 compressed
+    /// and kept instead of being dropped, as long as the compressed entries
+    /// take at most this many bytes in total. A hit on a compressed entry
+    /// decompresses it back into cache memory. A compressed entry is dropped
+    /// when it is selected for eviction again, so that cold entries pass
+    /// through the compressed tier on their way out of the cache. Entries that
+    /// compress to more than 80% of their size, prefetched entries and entries
+    /// waiting for SSD save are not compressed.
+    ///
+    /// NOTE: the compressed bytes are allocated from the heap, outside of the
+    /// capacity of the cache's MemoryAllocator, so the allocator capacity
+    /// should be reduced by this size.
+    uint64_t maxCompressedBytes{0};
   };
 
   AsyncDataCache(
@@ -811,6 +908,24 @@ class AsyncDataCache : public memory::Cache {
     return prefetchPages_.fetch_add(pages) + pages;
   }
 
+  /// Adds 'bytes' to the size of the compressed entries if this stays within
+  /// Options::maxCompressedBytes. Returns true if the bytes were added.
+  bool tryIncrementCompressedBytes(uint64_t bytes) {
+    if (compressedBytes_.fetch_add(bytes) + bytes > opts_.maxCompressedBytes) {
+      compressedBytes_.fetch_sub(bytes);
+      return false;
+    }
+    return true;
+  }
+
+  void decrementCompressedBytes(uint64_t bytes) {
+    compressedBytes_.fetch_sub(bytes);
+  }
+
+  uint64_t maxCompressedBytes() const {
+    return opts_.maxCompressedBytes;
+  }
+
   SsdCache* ssdCache() const {
     return ssdCache_.get();
   }
@@ -899,6 +1014,8 @@ class AsyncDataCache : public memory::Cache {
   // Number of pages that are allocated and not yet loaded or loaded
   // but not yet hit for the first time.
   std::atomic<memory::MachinePageCount> prefetchPages_{0};
+  // Total size of the compressed entries in all shards.
+  std::atomic<uint64_t> compressedBytes_{0};
 
   // Approximate counter of bytes allocated to cover misses. When this
   // exceeds 'nextSsdScoreSize_' we update the SSD admission criteria.
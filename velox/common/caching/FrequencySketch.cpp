@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+
+FrequencySketch::FrequencySketch(int32_t width)
+    : mask_(bits::nextPowerOfTwo(std::max(width, 64)) - 1),
+      sampleSize_(10 * (mask_ + 1)),
+      counters_(kDepth * (mask_ + 1), 0) {
+  VELOX_CHECK_GT(width, 0);
+}
+
+int32_t FrequencySketch::index(uint64_t hash, int32_t row) const {
+  return row * (mask_ + 1) + (bits::hashMix(hash, row) & mask_);
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  // Conservative update: only the counters that are at the minimum are
+  // incremented, which reduces the over-estimate from collisions.
+  const auto minCount = estimate(hash);
+  if (minCount < kMaxCount) {
+    for (auto row = 0; row < kDepth; ++row) {
+      auto& counter = counters_[index(hash, row)];
+      if (counter == minCount) {
+        ++counter;
+      }
+    }
+  }
+  if (++numIncrements_ >= sampleSize_) {
+    age();
+  }
+}
+
+int32_t FrequencySketch::estimate(uint64_t hash) const {
+  int32_t minCount = kMaxCount;
+  for (auto row = 0; row < kDepth; ++row) {
+    minCount = std::min<int32_t>(minCount, counters_[index(hash, row)]);
+  }
+  return minCount;
+}
+
+void FrequencySketch::age() {
+  for (auto& counter : counters_) {
+    counter >>= 1;
+  }
+  numIncrements_ /= 2;
+  ++numAgings_;
+}
+
+} // namespace facebook::velox::cache
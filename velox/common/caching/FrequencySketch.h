@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Count-min sketch of access frequencies with 4 bit saturating counters. Used
+/// by CacheShard to estimate how often a key has been accessed recently,
+/// including keys that are no longer or not yet in the cache. Counters are
+/// halved after every 'sampleSize()' increments so that the estimates reflect
+/// recent popularity. Not thread-safe, the owner serializes access.
+class FrequencySketch {
+ public:
+  static constexpr int32_t kMaxCount = 15;
+
+  /// 'width' is the number of counters per hash function and is rounded up to
+  /// a power of 2.
+  explicit FrequencySketch(int32_t width);
+
+  /// Records one access to the key with 'hash'. Ages all counters once
+  /// 'sampleSize()' accesses have been recorded since the last aging.
+  void increment(uint64_t hash);
+
+  /// Returns the estimated number of recent accesses to the key with 'hash',
+  /// capped at kMaxCount.
+  int32_t estimate(uint64_t hash) const;
+
+  /// Halves all counters.
+  void age();
+
+  int64_t sampleSize() const {
+    return sampleSize_;
+  }
+
+  /// Returns the number of times the counters have been aged.
+  uint64_t numAgings() const {
+    return numAgings_;
+  }
+
+ private:
+  static constexpr int32_t kDepth = 4;
+
+  int32_t index(uint64_t hash, int32_t row) const;
+
+  const uint64_t mask_;
+  const int64_t sampleSize_;
+  // 'kDepth' rows of 'mask_ + 1' counters.
+  std::vector<uint8_t> counters_;
+  int64_t numIncrements_{0};
+  uint64_t numAgings_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/ScanHistory.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <glog/logging.h>
+
+namespace facebook::velox::cache {
+
+std::unique_ptr<ScanHistory> ScanHistory::instance_;
+
+ScanHistory::ScanHistory(std::string filePath)
+    : filePath_(std::move(filePath)) {
+  if (!filePath_.empty()) {
+    load();
+  }
+}
+
+// static
+ScanHistory* ScanHistory::create(const std::string& filePath) {
+  if (instance_ == nullptr) {
+    instance_ = std::unique_ptr<ScanHistory>(new ScanHistory(filePath));
+  }
+  return instance_.get();
+}
+
+ColumnAccessHistory ScanHistory::get(const std::string& key) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = history_.find(key);
+  if (it == history_.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+void ScanHistory::merge(
+    const std::string& key,
+    const ColumnAccessHistory& accesses) {
+  if (accesses.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = history_.find(key);
+    if (it == history_.end()) {
+      if (history_.size() >= kMaxKeys) {
+        return;
+      }
+      it = history_.emplace(key, ColumnAccessHistory{}).first;
+    }
+    auto& history = it->second;
+    for (auto& [id, data] : history) {
+      data.referencedBytes *= kDecay;
+      data.readBytes *= kDecay;
+    }
+    for (const auto& [id, data] : accesses) {
+      auto& entry = history[id];
+      entry.referencedBytes += data.referencedBytes;
+      entry.readBytes += data.readBytes;
+      entry.lastReferencedBytes = data.lastReferencedBytes;
+    }
+  }
+  save();
+}
+
+void ScanHistory::save() const {
+  if (filePath_.empty()) {
+    return;
+  }
+  // One line per column: <id> <referencedBytes> <readBytes> <key>. The key is
+  // last since it may contain spaces.
+  std::stringstream out;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (const auto& [key, history] : history_) {
+      for (const auto& [id, data] : history) {
+        out << id.id() << " " << data.referencedBytes << " " << data.readBytes
+            << " " << key << "\n";
+      }
+    }
+  }
+  std::lock_guard<std::mutex> l(saveMutex_);
+  // Write a new file and rename it over the old one so that a crash does not
+  // leave a partial history.
+  const auto tempPath = filePath_ + ".tmp";
+  {
+    std::ofstream file(tempPath, std::ios::trunc);
+    file << out.str();
+    if (!file.good()) {
+      LOG(WARNING) << "Failed to write scan history to " << tempPath;
+      return;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(tempPath, filePath_, error);
+  if (error) {
+    LOG(WARNING) << "Failed to rename scan history file " << tempPath
+                 << " to " << filePath_ << ": " << error.message();
+  }
+}
+
+void ScanHistory::load() {
+  std::ifstream file(filePath_);
+  if (!file.is_open()) {
+    return;
+  }
+  std::string line;
+  int32_t numBadLines = 0;
+  while (std::getline(file, line)) {
+    std::stringstream in(line);
+    int32_t id;
+    TrackingData data;
+    std::string key;
+    in >> id >> data.referencedBytes >> data.readBytes;
+    in.ignore(1);
+    std::getline(in, key);
+    if (in.fail() || key.empty()) {
+      ++numBadLines;
+      continue;
+    }
+    history_[key][TrackingId(id)] = data;
+  }
+  if (numBadLines > 0) {
+    LOG(WARNING) << "Skipped " << numBadLines
+                 << " malformed lines in scan history file " << filePath_;
+  }
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <mutex>
+
+#include "velox/common/caching/ScanTracker.h"
+
+namespace facebook::velox::cache {
+
+/// Per-column access statistics of past scans of a table.
+using ColumnAccessHistory = folly::F14FastMap<TrackingId, TrackingData>;
+
+/// Process-wide record of which columns past queries read of the columns they
+/// referenced, keyed by table. A ScanTracker for a table starts with the
+/// history of the table, so that a new query prefetches the columns that
+/// similar queries read instead of learning the access pattern again. The
+/// history is optionally kept in a small local file so that it survives
+/// restarts.
+class ScanHistory {
+ public:
+  /// Creates the process-wide instance. If 'filePath' is not empty, loads the
+  /// history from 'filePath' if the file exists and writes the history back
+  /// to it after each merge. Returns the existing instance if already created.
+  static ScanHistory* create(const std::string& filePath = "");
+
+  /// Returns the process-wide instance or nullptr if not created.
+  static ScanHistory* getInstance() {
+    return instance_.get();
+  }
+
+  static void testingClear() {
+    instance_ = nullptr;
+  }
+
+  /// Returns the history of 'key' or an empty map if there is none.
+  ColumnAccessHistory get(const std::string& key) const;
+
+  /// Adds the accesses of a finished scan of 'key'. The earlier history of
+  /// 'key' is decayed by 'kDecay' so that the history follows changes in the
+  /// workload.
+  void merge(const std::string& key, const ColumnAccessHistory& accesses);
+
+  /// Writes the history to the file given at creation. No-op without a file.
+  void save() const;
+
+  size_t numKeys() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return history_.size();
+  }
+
+  /// Weight of the earlier history of a key when merging a new scan.
+  static constexpr double kDecay = 0.5;
+
+  /// Maximum number of tables with history. Scans of further tables are not
+  /// recorded.
+  static constexpr int32_t kMaxKeys = 10'000;
+
+ private:
+  explicit ScanHistory(std::string filePath);
+
+  void load();
+
+  static std::unique_ptr<ScanHistory> instance_;
+
+  const std::string filePath_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, ColumnAccessHistory> history_;
+
+  // Serializes writers of 'filePath_'.
+  mutable std::mutex saveMutex_;
+};
+
+} // namespace facebook::velox::cache
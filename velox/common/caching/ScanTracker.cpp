@@ -16,11 +16,60 @@
 
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/ScanHistory.h"
 
 #include <sstream>
 
 namespace facebook::velox::cache {
 
+ScanTracker::ScanTracker(
+    std::string_view id,
+    std::function<void(ScanTracker*)> unregisterer,
+    int32_t loadQuantum,
+    FileGroupStats* fileGroupStats,
+    std::string_view historyKey)
+    : id_(id),
+      unregisterer_(std::move(unregisterer)),
+      fileGroupStats_(fileGroupStats),
+      historyKey_(historyKey) {
+  auto* scanHistory = ScanHistory::getInstance();
+  if (historyKey_.empty() || scanHistory == nullptr) {
+    return;
+  }
+  const double maxBytes = static_cast<double>(loadQuantum) * kHistoryQuanta;
+  for (auto& [trackingId, data] : scanHistory->get(historyKey_)) {
+    if (data.referencedBytes <= 0) {
+      continue;
+    }
+    const auto scale = std::min(1.0, maxBytes / data.referencedBytes);
+    auto& history = history_[trackingId];
+    history.referencedBytes = data.referencedBytes * scale;
+    history.readBytes = data.readBytes * scale;
+  }
+}
+
+ScanTracker::~ScanTracker() {
+  if (unregisterer_) {
+    unregisterer_(this);
+  }
+  if (historyKey_.empty()) {
+    return;
+  }
+  if (auto* scanHistory = ScanHistory::getInstance()) {
+    scanHistory->merge(historyKey_, data_);
+  }
+}
+
+TrackingData ScanTracker::withHistoryLocked(TrackingId id) {
+  auto data = data_[id];
+  auto it = history_.find(id);
+  if (it != history_.end()) {
+    data.referencedBytes += it->second.referencedBytes;
+    data.readBytes += it->second.readBytes;
+  }
+  return data;
+}
+
 // Marks that 'bytes' worth of data may be accessed in the future. See
 // TrackingData for meaning of quantum.
 void ScanTracker::recordReference(
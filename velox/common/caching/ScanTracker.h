@@ -92,21 +92,17 @@ class ScanTracker {
   /// and will be referenced from a map from id to weak_ptr to 'this'.
   /// 'unregisterer' is supplied so that the destructor can remove the weak_ptr
   /// from the map of pending trackers. 'loadQuantum' is the largest single IO
-  /// size for read.
+  /// size for read. If 'historyKey' is not empty and ScanHistory is created,
+  /// the tracker starts with the history of 'historyKey', e.g. the table, and
+  /// adds its accesses to the history when destroyed.
   ScanTracker(
       std::string_view id,
       std::function<void(ScanTracker*)> unregisterer,
       int32_t loadQuantum,
-      FileGroupStats* fileGroupStats = nullptr)
-      : id_(id),
-        unregisterer_(std::move(unregisterer)),
-        fileGroupStats_(fileGroupStats) {}
-
-  ~ScanTracker() {
-    if (unregisterer_) {
-      unregisterer_(this);
-    }
-  }
+      FileGroupStats* fileGroupStats = nullptr,
+      std::string_view historyKey = {});
+
+  ~ScanTracker();
 
   /// Records that a scan references 'bytes' bytes of the stream given by 'id'.
   /// This is called when preparing to read a stripe.
@@ -133,16 +129,18 @@ class ScanTracker {
   /// if no data.
   int32_t readPct(TrackingId id) {
     std::lock_guard<std::mutex> l(mutex_);
-    const auto& data = data_[id];
+    const auto data = withHistoryLocked(id);
     if (data.referencedBytes == 0) {
       return 100;
     }
     return data.readBytes / data.referencedBytes * 100;
   }
 
+  /// Returns the accesses of 'id' by this scan plus the history of 'id' from
+  /// earlier scans.
   TrackingData trackingData(TrackingId id) {
     std::lock_guard<std::mutex> l(mutex_);
-    return data_[id];
+    return withHistoryLocked(id);
   }
 
   std::string_view id() const {
@@ -155,14 +153,24 @@ class ScanTracker {
 
   std::string toString() const;
 
+  /// Weight of the history of earlier scans in bytes referenced per load
+  /// quantum. The history of a column is scaled down to at most this many
+  /// load quanta, so that the accesses of this scan soon outweigh it.
+  static constexpr int32_t kHistoryQuanta = 4;
+
  private:
+  TrackingData withHistoryLocked(TrackingId id);
+
   // Id of query + scan operator to track.
   const std::string id_;
   const std::function<void(ScanTracker*)> unregisterer_{nullptr};
   FileGroupStats* const fileGroupStats_;
+  const std::string historyKey_;
 
   std::mutex mutex_;
   folly::F14FastMap<TrackingId, TrackingData> data_;
+  // Accesses of earlier scans of 'historyKey_', scaled by kHistoryQuanta.
+  folly::F14FastMap<TrackingId, TrackingData> history_;
   TrackingData sum_;
 };
 
@@ -15,7 +15,9 @@
  */
 #include "velox/common/caching/SsdCache.h"
 #include <folly/Executor.h>
+#include <folly/ScopeGuard.h>
 #include <folly/portability/SysUio.h>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
@@ -49,6 +51,12 @@ SsdCache::SsdCache(const Config& config)
         << "Checksum read has been disabled as checksum is not enabled.";
     checksumReadVerificationEnabled = false;
   }
+  auto checkpointJournalEnabled = config.checkpointJournalEnabled;
+  if (config.checkpointJournalEnabled && !config.checksumEnabled) {
+    VELOX_SSD_CACHE_LOG(WARNING)
+        << "Checkpoint journal has been disabled as checksum is not enabled.";
+    checkpointJournalEnabled = false;
+  }
   filesystems::getFileSystem(filePrefix_, nullptr)
       ->mkdir(std::filesystem::path(filePrefix_).parent_path().string());
 
@@ -58,6 +66,10 @@ SsdCache::SsdCache(const Config& config)
   const uint64_t sizeQuantum = numShards_ * SsdFile::kRegionSize;
   const int32_t fileMaxRegions =
       bits::roundUp(config.maxBytes, sizeQuantum) / sizeQuantum;
+  // The shards recover from their checkpoints in parallel.
+  const auto startTimeUs = getCurrentTimeMicro();
+  std::vector<std::shared_ptr<AsyncSource<SsdFile>>> makeFiles;
+  makeFiles.reserve(numShards_);
   for (auto i = 0; i < numShards_; ++i) {
     const auto fileConfig = SsdFile::Config(
         fmt::format("{}{}", filePrefix_, i),
@@ -67,9 +79,31 @@ SsdCache::SsdCache(const Config& config)
         config.disableFileCow,
         config.checksumEnabled,
         checksumReadVerificationEnabled,
-        executor_);
-    files_.push_back(std::make_unique<SsdFile>(fileConfig));
+        executor_,
+        checkpointJournalEnabled);
+    makeFiles.push_back(std::make_shared<AsyncSource<SsdFile>>(
+        [fileConfig]() { return std::make_unique<SsdFile>(fileConfig); }));
+    if (i > 0) {
+      executor_->add([source = makeFiles.back()]() { source->prepare(); });
+    }
+  }
+  auto sync = folly::makeGuard([&]() {
+    // Waits for the pending shards on error. This must not throw. The first
+    // error is already captured before this runs.
+    for (auto& makeFile : makeFiles) {
+      try {
+        makeFile->move();
+      } catch (const std::exception&) {
+      }
+    }
+  });
+  for (auto& makeFile : makeFiles) {
+    files_.push_back(makeFile->move());
   }
+  VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
+      "Initialized {} shards in {}",
+      numShards_,
+      succinctMicros(getCurrentTimeMicro() - startTimeUs));
 }
 
 SsdFile& SsdCache::file(uint64_t fileId) {
@@ -41,7 +41,8 @@ class SsdCache {
         uint64_t _checkpointIntervalBytes = 0,
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
-        bool _checksumReadVerificationEnabled = false)
+        bool _checksumReadVerificationEnabled = false,
+        bool _checkpointJournalEnabled = false)
         : filePrefix(_filePrefix),
           maxBytes(_maxBytes),
           numShards(_numShards),
@@ -49,6 +50,7 @@ class SsdCache {
           disableFileCow(_disableFileCow),
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(_checksumReadVerificationEnabled),
+          checkpointJournalEnabled(_checkpointJournalEnabled),
           executor(_executor){};
 
     std::string filePrefix;
@@ -68,18 +70,25 @@ class SsdCache {
     /// If true, checksum read verification from SSD is enabled.
     bool checksumReadVerificationEnabled;
 
+    /// If true, each shard journals the entries written and the regions
+    /// evicted since its last checkpoint, so that a restart recovers them
+    /// without waiting for the next checkpoint. The journaled entries are
+    /// verified against their checksums on first read. Requires checksum.
+    bool checkpointJournalEnabled;
+
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
 
     std::string toString() const {
       return fmt::format(
-          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}",
+          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}, checkpoint journal {}",
           numShards,
           succinctBytes(maxBytes),
           succinctBytes(checkpointIntervalBytes),
           (disableFileCow ? "DISABLED" : "ENABLED"),
           (checksumEnabled ? "ENABLED" : "DISABLED"),
-          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"));
+          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"),
+          (checkpointJournalEnabled ? "ENABLED" : "DISABLED"));
     }
   };
 
@@ -24,6 +24,7 @@
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/process/TraceEvents.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -111,6 +112,8 @@ SsdFile::SsdFile(const Config& config)
       checksumEnabled_(config.checksumEnabled),
       checksumReadVerificationEnabled_(
           config.checksumEnabled && config.checksumReadVerificationEnabled),
+      checkpointJournalEnabled_(
+          config.checksumEnabled && config.checkpointJournalEnabled),
       shardId_(config.shardId),
       fs_(filesystems::getFileSystem(fileName_, nullptr)),
       checkpointIntervalBytes_(config.checkpointIntervalBytes),
@@ -212,6 +215,11 @@ CoalesceIoStats SsdFile::load(
     stats_.bytesRead += entry->size();
   }
 
+  // If the file reads asynchronously, e.g. with io_uring, the coalesced reads
+  // are collected and issued together, then waited for.
+  const bool batchReads = readFile_->hasPreadvAsync();
+  std::vector<ReadFile::AsyncRead> asyncReads;
+
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
@@ -228,8 +236,15 @@ CoalesceIoStats SsdFile::load(
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        if (batchReads) {
+          asyncReads.push_back({offset, buffers});
+        } else {
+          read(offset, buffers);
+        }
       });
+  if (!asyncReads.empty()) {
+    readBatch(asyncReads);
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -244,9 +259,34 @@ void SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
   process::TraceContext trace("SsdFile::read");
+  VELOX_TRACE_PROBE(ssd_read, offset, buffers.size());
+  process::TraceSpan span("cache", "ssd_read", [&]() {
+    uint64_t bytes{0};
+    for (const auto& buffer : buffers) {
+      bytes += buffer.size();
+    }
+    return fmt::format("{} bytes", bytes);
+  });
   readFile_->preadv(offset, buffers);
 }
 
+void SsdFile::readBatch(const std::vector<ReadFile::AsyncRead>& reads) {
+  process::TraceContext trace("SsdFile::readBatch");
+  VELOX_TRACE_PROBE(ssd_read_batch, reads.size());
+  process::TraceSpan span("cache", "ssd_read", [&]() {
+    return fmt::format("{} reads", reads.size());
+  });
+  auto futures = readFile_->preadvBatchAsync(reads);
+  for (auto& future : futures) {
+    // Waits for all the reads before throwing so that no read is in progress
+    // into the pins' memory.
+    future.wait();
+  }
+  for (auto& future : futures) {
+    std::move(future).get();
+  }
+}
+
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const std::vector<CachePin>& pins,
     int32_t begin) {
@@ -405,6 +445,7 @@ void SsdFile::write(std::vector<CachePin>& pins) {
 
     {
       std::lock_guard<std::shared_mutex> l(mutex_);
+      std::string journalRecords;
       for (auto i = writeIndex; i < writeIndex + numWrittenEntries; ++i) {
         auto* entry = pins[i].checkedEntry();
         VELOX_CHECK_NULL(entry->ssdFile());
@@ -416,15 +457,20 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         if (checksumEnabled_) {
           checksum = checksumEntry(*entry);
         }
-        entries_[std::move(key)] = SsdRun(offset, size, checksum);
+        const SsdRun run(offset, size, checksum);
+        if (journalEnabled()) {
+          addJournalEntryLocked(key, run, journalRecords);
+        }
+        entries_[std::move(key)] = run;
         if (FLAGS_velox_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size, checksum));
+          verifyWrite(*entry, run);
         }
         offset += size;
         ++stats_.entriesWritten;
         stats_.bytesWritten += size;
         bytesAfterCheckpoint_ += size;
       }
+      appendJournalLocked(journalRecords);
     }
     writeIndex += numWrittenEntries;
   }
@@ -621,11 +667,73 @@ void SsdFile::logEviction(std::vector<int32_t>& regions) {
   const auto length = regions.size() * sizeof(regions[0]);
   const std::vector<iovec> iovecs = {{regions.data(), length}};
   try {
-    evictLogWriteFile_->write(iovecs, 0, static_cast<int64_t>(length));
+    // Appends to the log so that all the evictions since the last checkpoint
+    // are kept.
+    evictLogWriteFile_->write(
+        iovecs,
+        static_cast<int64_t>(evictLogWriteFile_->size()),
+        static_cast<int64_t>(length));
   } catch (const std::exception& e) {
     ++stats_.writeSsdErrors;
     VELOX_SSD_CACHE_LOG(ERROR) << "Failed to log eviction: " << e.what();
   }
+
+  if (journalEnabled()) {
+    // The eviction is also journaled so that the journaled entries written
+    // before the eviction are dropped on replay.
+    std::string record;
+    record.append(
+        reinterpret_cast<const char*>(&kJournalEvictMarker),
+        sizeof(kJournalEvictMarker));
+    const int32_t numRegions = regions.size();
+    record.append(
+        reinterpret_cast<const char*>(&numRegions), sizeof(numRegions));
+    record.append(reinterpret_cast<const char*>(regions.data()), length);
+    appendJournalLocked(record);
+  }
+}
+
+void SsdFile::addJournalEntryLocked(
+    const FileCacheKey& key,
+    const SsdRun& run,
+    std::string& records) {
+  const uint64_t fileNum = key.fileNum.id();
+  const auto append = [&](const auto& value) {
+    records.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  if (journaledFileIds_.insert(fileNum).second) {
+    const auto name = fileIds().string(fileNum);
+    append(kJournalFileMarker);
+    append(fileNum);
+    append(static_cast<int32_t>(name.size()));
+    records.append(name);
+  }
+  append(fileNum);
+  append(key.offset);
+  append(run.fileBits());
+  append(run.checksum());
+}
+
+void SsdFile::appendJournalLocked(const std::string& records) {
+  if (records.empty() || !journalEnabled()) {
+    return;
+  }
+  try {
+    if (journalWriteFile_->size() == 0) {
+      journalWriteFile_->append(kJournalVersion);
+    }
+    // The journal is not synced. It survives a process restart, and the
+    // journaled entries are verified on first read after recovery.
+    journalWriteFile_->append(records);
+  } catch (const std::exception& e) {
+    ++stats_.writeCheckpointErrors;
+    VELOX_SSD_CACHE_LOG(ERROR)
+        << "Failed to append to checkpoint journal, disabling journal: "
+        << e.what();
+    // A journal with a gap cannot be replayed.
+    deleteFile(std::move(journalWriteFile_));
+    journaledFileIds_.clear();
+  }
 }
 
 void SsdFile::deleteCheckpoint(bool keepLog) {
@@ -644,6 +752,15 @@ void SsdFile::deleteCheckpoint(bool keepLog) {
   if (checkpointWriteFile_ != nullptr) {
     deleteFile(std::move(checkpointWriteFile_));
   }
+
+  if (journalWriteFile_ != nullptr) {
+    if (keepLog) {
+      truncateFile(journalWriteFile_.get());
+    } else {
+      deleteFile(std::move(journalWriteFile_));
+    }
+  }
+  journaledFileIds_.clear();
 }
 
 void SsdFile::truncateFile(WriteFile* file) {
@@ -818,6 +935,11 @@ void SsdFile::checkpoint(bool force) {
     VELOX_CHECK_NOT_NULL(evictLogWriteFile_);
     evictLogWriteFile_->truncate(0);
     evictLogWriteFile_->flush();
+    // The journaled entries are all in the new checkpoint.
+    if (journalWriteFile_ != nullptr) {
+      truncateFile(journalWriteFile_.get());
+      journaledFileIds_.clear();
+    }
 
     VELOX_SSD_CACHE_LOG(INFO)
         << "Checkpoint persisted with " << entries_.size() << " cache entries";
@@ -859,6 +981,34 @@ void SsdFile::initializeCheckpoint() {
     VELOX_FAIL("Could not open evict log {}: {}", logPath, e.what());
   }
 
+  const auto journalPath = journalFilePath();
+  if (checkpointJournalEnabled_) {
+    try {
+      journalWriteFile_ =
+          fs_->openFileForWrite(journalPath, writeFileOptions);
+    } catch (const std::exception& e) {
+      ++stats_.openLogErrors;
+      checkpointJournalEnabled_ = false;
+      VELOX_SSD_CACHE_LOG(ERROR) << fmt::format(
+          "Could not open checkpoint journal {}, continuing without journal: {}",
+          journalPath,
+          e.what());
+    }
+  }
+  if (!checkpointJournalEnabled_) {
+    // A journal left by a previous run does not match the checkpoints made
+    // without journal, so it must never be replayed.
+    try {
+      if (fs_->exists(journalPath)) {
+        fs_->remove(journalPath);
+      }
+    } catch (const std::exception& e) {
+      ++stats_.deleteMetaFileErrors;
+      VELOX_SSD_CACHE_LOG(ERROR) << fmt::format(
+          "Error in deleting file {}: {}", journalPath, e.what());
+    }
+  }
+
   try {
     readCheckpoint();
   } catch (const std::exception& e) {
@@ -894,10 +1044,12 @@ uint32_t SsdFile::checksumEntry(const AsyncDataCacheEntry& entry) const {
 void SsdFile::maybeVerifyChecksum(
     const AsyncDataCacheEntry& entry,
     const SsdRun& ssdRun) {
-  if (!checksumReadVerificationEnabled_) {
+  if (!checksumReadVerificationEnabled_ && !ssdRun.unverified()) {
     return;
   }
-  VELOX_DCHECK_EQ(ssdRun.size(), entry.size());
+  if (checksumReadVerificationEnabled_) {
+    VELOX_DCHECK_EQ(ssdRun.size(), entry.size());
+  }
   if (ssdRun.size() != entry.size()) {
     ++stats_.readWithoutChecksumChecks;
     VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
@@ -909,6 +1061,21 @@ void SsdFile::maybeVerifyChecksum(
 
   // Verifies that the checksum matches after we read from SSD.
   const auto checksum = checksumEntry(entry);
+  if (ssdRun.unverified()) {
+    // The first read of a recovered entry. Marks the entry verified, or drops
+    // it if its data is stale, e.g. it was not persisted before a crash, so
+    // that the next access goes to storage.
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    auto it = entries_.find(entry.key());
+    if (it != entries_.end() && it->second.fileBits() == ssdRun.fileBits()) {
+      if (checksum == ssdRun.checksum()) {
+        it->second.setUnverified(false);
+      } else {
+        erasedRegionSizes_[regionIndex(ssdRun.offset())] += ssdRun.size();
+        entries_.erase(it);
+      }
+    }
+  }
   if (checksum != ssdRun.checksum()) {
     ++stats_.readSsdCorruptions;
     VELOX_FAIL(
@@ -930,6 +1097,9 @@ void SsdFile::disableFileCow() {
   if (checkpointWriteFile_ != nullptr) {
     checkpointWriteFile_->setAttributes(attributes);
   }
+  if (journalWriteFile_ != nullptr) {
+    journalWriteFile_->setAttributes(attributes);
+  }
 #endif // linux
 }
 
@@ -1022,7 +1192,9 @@ void SsdFile::readCheckpoint() {
     evictedMap.insert(region);
   }
 
-  std::vector<uint32_t> regionCacheSizes(numRegions_, 0);
+  // Sized for all regions since the journal may reference regions added after
+  // the checkpoint.
+  std::vector<uint32_t> regionCacheSizes(maxRegions_, 0);
   for (;;) {
     const auto fileNum = readNumber<uint64_t>(stream.get());
     if (fileNum == kCheckpointEndMarker) {
@@ -1050,6 +1222,11 @@ void SsdFile::readCheckpoint() {
         regionSizes_[region], regionOffset(run.offset()) + run.size());
   }
 
+  const auto numCheckpointRegions = numRegions_;
+  if (checkpointJournalEnabled_) {
+    readJournal(regionCacheSizes, evictedMap);
+  }
+
   // NOTE: we might erase entries from a region for TTL eviction, so we need to
   // set the region size to the max offset of the recovered cache entry from the
   // region. Correspondingly, we substract the cached size from the region size
@@ -1072,6 +1249,13 @@ void SsdFile::readCheckpoint() {
   for (auto region : evictedMap) {
     writableRegions_.push_back(region);
   }
+  // The regions added after the checkpoint may have space left. Writing
+  // continues after their journaled entries.
+  for (auto region = numCheckpointRegions; region < numRegions_; ++region) {
+    if (evictedMap.count(region) == 0) {
+      writableRegions_.push_back(region);
+    }
+  }
   tracker_.setRegionScores(scores);
 
   uint64_t cachedBytes{0};
@@ -1079,7 +1263,7 @@ void SsdFile::readCheckpoint() {
     cachedBytes += regionSize;
   }
   VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
-      "Starting shard {} from checkpoint with {} entries, {} cached data, {} regions with {} free, with checksum write {}, read verification {}, checkpoint file {}",
+      "Starting shard {} from checkpoint with {} entries, {} cached data, {} regions with {} free, with checksum write {}, read verification {}, journal {}, checkpoint file {}",
       shardId_,
       entries_.size(),
       succinctBytes(cachedBytes),
@@ -1087,7 +1271,117 @@ void SsdFile::readCheckpoint() {
       writableRegions_.size(),
       checksumEnabled_ ? "enabled" : "disabled",
       checksumReadVerificationEnabled_ ? "enabled" : "disabled",
+      checkpointJournalEnabled_ ? "enabled" : "disabled",
       checkpointFilePath());
 }
 
+void SsdFile::readJournal(
+    std::vector<uint32_t>& regionCacheSizes,
+    std::unordered_set<uint32_t>& evictedRegions) {
+  const auto journalPath = journalFilePath();
+  std::unique_ptr<common::FileInputStream> stream;
+  try {
+    auto journalReadFile = fs_->openFileForRead(journalPath);
+    if (journalReadFile->size() == 0) {
+      return;
+    }
+    stream = std::make_unique<common::FileInputStream>(
+        std::move(journalReadFile),
+        1 << 20,
+        memory::memoryManager()->cachePool());
+  } catch (const std::exception& e) {
+    VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+        "Error opening checkpoint journal {}: Starting from checkpoint only: {}",
+        journalPath,
+        e.what());
+    return;
+  }
+
+  // The journal is appended without sync, so a crash can leave a partial
+  // record at the end. The records before it are valid. The partial record is
+  // truncated so that the records appended after restart can be replayed.
+  const int32_t numFileRegions = fileSize_ / kRegionSize;
+  std::unordered_map<uint64_t, StringIdLease> idMap;
+  uint64_t numJournaledEntries{0};
+  uint64_t validSize{0};
+  try {
+    if (readString(stream.get(), kJournalVersion.size()) != kJournalVersion) {
+      VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+          "Unknown checkpoint journal version in {}: Starting from checkpoint only",
+          journalPath);
+      journalWriteFile_->truncate(0);
+      return;
+    }
+    while (!stream->atEnd()) {
+      validSize = stream->tellp();
+      const auto word = readNumber<uint64_t>(stream.get());
+      if (word == kJournalFileMarker) {
+        const auto id = readNumber<uint64_t>(stream.get());
+        const auto length = readNumber<int32_t>(stream.get());
+        const auto name = readString(stream.get(), length);
+        idMap[id] = StringIdLease(fileIds(), id, name);
+        continue;
+      }
+      if (word == kJournalEvictMarker) {
+        const auto numRegions = readNumber<int32_t>(stream.get());
+        const auto regions = readVector<int32_t>(stream.get(), numRegions);
+        std::unordered_set<int32_t> regionSet{regions.begin(), regions.end()};
+        auto it = entries_.begin();
+        while (it != entries_.end()) {
+          if (regionSet.count(regionIndex(it->second.offset())) != 0) {
+            it = entries_.erase(it);
+          } else {
+            ++it;
+          }
+        }
+        for (const auto region : regions) {
+          VELOX_CHECK_LT(region, maxRegions_);
+          regionCacheSizes[region] = 0;
+          regionSizes_[region] = 0;
+          evictedRegions.insert(region);
+        }
+        continue;
+      }
+      const auto offset = readNumber<uint64_t>(stream.get());
+      const auto fileBits = readNumber<uint64_t>(stream.get());
+      const auto checksum = readNumber<uint32_t>(stream.get());
+      SsdRun run(fileBits, checksum);
+      // The data may not have been persisted before a crash.
+      run.setUnverified(true);
+      const auto region = regionIndex(run.offset());
+      if (region >= numFileRegions ||
+          regionOffset(run.offset()) + run.size() > kRegionSize) {
+        // The cache file was truncated.
+        continue;
+      }
+      const auto idIt = idMap.find(word);
+      VELOX_CHECK(idIt != idMap.end());
+      FileCacheKey key{idIt->second, offset};
+      auto it = entries_.find(key);
+      if (it != entries_.end()) {
+        regionCacheSizes[regionIndex(it->second.offset())] -=
+            it->second.size();
+        it->second = run;
+      } else {
+        entries_.emplace(std::move(key), run);
+      }
+      regionCacheSizes[region] += run.size();
+      regionSizes_[region] = std::max<uint32_t>(
+          regionSizes_[region], regionOffset(run.offset()) + run.size());
+      numRegions_ = std::max(numRegions_, region + 1);
+      ++numJournaledEntries;
+    }
+  } catch (const std::exception& e) {
+    VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+        "Stopped replaying checkpoint journal {} at a truncated record: {}",
+        journalPath,
+        e.what());
+    journalWriteFile_->truncate(validSize);
+  }
+  VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
+      "Replayed {} entries from checkpoint journal {}",
+      numJournaledEntries,
+      journalPath);
+}
+
 } // namespace facebook::velox::cache
@@ -18,6 +18,7 @@
 
 #include <gflags/gflags.h>
 #include <shared_mutex>
+#include <unordered_set>
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
@@ -56,11 +57,13 @@ class SsdRun {
   void operator=(const SsdRun& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    unverified_ = other.unverified_;
   }
 
   void operator=(SsdRun&& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    unverified_ = other.unverified_;
   }
 
   uint64_t offset() const {
@@ -81,10 +84,22 @@ class SsdRun {
     return fileBits_;
   }
 
+  /// True if the run was recovered after a restart and its data has not yet
+  /// been checked against 'checksum_'. The check is done on the first read.
+  bool unverified() const {
+    return unverified_;
+  }
+
+  void setUnverified(bool unverified) {
+    unverified_ = unverified;
+  }
+
  private:
   // Contains the file offset and size.
   uint64_t fileBits_;
   uint32_t checksum_;
+  // Fits in the padding after 'checksum_'.
+  bool unverified_{false};
 };
 
 /// Represents an SsdFile entry that is planned for load or being loaded. This
@@ -257,7 +272,8 @@ class SsdFile {
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
-        folly::Executor* _executor = nullptr)
+        folly::Executor* _executor = nullptr,
+        bool _checkpointJournalEnabled = false)
         : fileName(_fileName),
           shardId(_shardId),
           maxRegions(_maxRegions),
@@ -266,7 +282,9 @@ class SsdFile {
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(
               _checksumEnabled && _checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          checkpointJournalEnabled(
+              _checksumEnabled && _checkpointJournalEnabled){};
 
     /// Name of cache file, used as prefix for checkpoint files.
     const std::string fileName;
@@ -292,6 +310,11 @@ class SsdFile {
 
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
+
+    /// If true, the entries written between checkpoints are appended to a
+    /// journal that is replayed on top of the checkpoint on recovery. Requires
+    /// checksum so that the journaled entries can be verified on first read.
+    bool checkpointJournalEnabled;
   };
 
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
@@ -374,6 +397,11 @@ class SsdFile {
     return fileName_ + kCheckpointExtension;
   }
 
+  /// Returns the checkpoint journal file path.
+  std::string journalFilePath() const {
+    return fileName_ + kJournalExtension;
+  }
+
   /// Resets this' to a post-construction empty state. See SsdCache::clear().
   ///
   /// NOTE: this is only used by test and Prestissimo worker operation.
@@ -385,6 +413,12 @@ class SsdFile {
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
   // Magic number at end of completed checkpoint file.
   static constexpr int64_t kCheckpointEndMarker = 0xcbedf11e;
+  // Magic numbers starting a file name and an eviction record in the
+  // checkpoint journal. Any other leading word is the file id of an entry.
+  static constexpr uint64_t kJournalFileMarker = 0xfffffffffffffffd;
+  static constexpr uint64_t kJournalEvictMarker = 0xfffffffffffffffc;
+  // The first 4 bytes of a non-empty checkpoint journal.
+  static constexpr std::string_view kJournalVersion{"JNL1"};
 
   static constexpr int kMaxErasedSizePct = 50;
 
@@ -434,6 +468,9 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
+  // Issues 'reads' with one preadvBatchAsync() and waits for all of them.
+  void readBatch(const std::vector<ReadFile::AsyncRead>& reads);
+
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
@@ -441,6 +478,34 @@ class SsdFile {
   // failed read deletes the checkpoint and leaves the truncated log open.
   void readCheckpoint();
 
+  // Replays the checkpoint journal on top of the entries read from the
+  // checkpoint. Adds the cached bytes of the journaled entries to
+  // 'regionCacheSizes' and the regions evicted after the checkpoint to
+  // 'evictedRegions'. A partial record at the end of the journal is truncated.
+  // The journaled entries are verified on first read.
+  void readJournal(
+      std::vector<uint32_t>& regionCacheSizes,
+      std::unordered_set<uint32_t>& evictedRegions);
+
+  // Returns true if entry additions and evictions are journaled between
+  // checkpoints.
+  bool journalEnabled() const {
+    return checkpointJournalEnabled_ && checkpointEnabled() &&
+        journalWriteFile_ != nullptr;
+  }
+
+  // Appends the records in 'records' to the checkpoint journal. Caller must
+  // hold 'mutex_'.
+  void appendJournalLocked(const std::string& records);
+
+  // Appends the record of the entry of 'key' at 'run' to 'records'. Prefixes
+  // it with a file name record if the file has not been journaled since the
+  // last checkpoint. Caller must hold 'mutex_'.
+  void addJournalEntryLocked(
+      const FileCacheKey& key,
+      const SsdRun& run,
+      std::string& records);
+
   // Logs an error message, deletes the checkpoint and stop making new
   // checkpoints.
   void checkpointError(int32_t rc, const std::string& error);
@@ -476,6 +541,10 @@ class SsdFile {
     return force || (bytesAfterCheckpoint_ >= checkpointIntervalBytes_);
   }
 
+  // Verifies the checksum of 'entry' read from 'ssdRun' if read verification
+  // is enabled or 'ssdRun' is unverified. Marks the entry verified after the
+  // first successful check of an unverified run. Erases the entry and throws
+  // if the check fails.
   void maybeVerifyChecksum(
       const AsyncDataCacheEntry& entry,
       const SsdRun& ssdRun);
@@ -528,6 +597,7 @@ class SsdFile {
 
   static constexpr const char* kLogExtension = ".log";
   static constexpr const char* kCheckpointExtension = ".cpt";
+  static constexpr const char* kJournalExtension = ".jnl";
   static constexpr uint32_t kCheckpointBufferSize = 1 << 20; // 1MB
 
   // Name of cache file, used as prefix for checkpoint files.
@@ -545,6 +615,10 @@ class SsdFile {
   // If true, checksum read verification from SSD is enabled.
   const bool checksumReadVerificationEnabled_;
 
+  // If true, entries written between checkpoints are journaled. This is set
+  // to false if the journal cannot be opened.
+  bool checkpointJournalEnabled_;
+
   // Shard index within 'cache_'.
   const int32_t shardId_;
 
@@ -596,6 +670,13 @@ class SsdFile {
   // WriteFile for checkpoint file.
   std::unique_ptr<WriteFile> checkpointWriteFile_;
 
+  // WriteFile for the checkpoint journal.
+  std::unique_ptr<WriteFile> journalWriteFile_;
+
+  // Ids of the files whose names have been journaled since the last
+  // checkpoint.
+  folly::F14FastSet<uint64_t> journaledFileIds_;
+
   // Counters.
   SsdCacheStats stats_;
 
@@ -732,6 +732,7 @@ TEST_P(AsyncDataCacheTest, replace) {
   EXPECT_LT(0, stats.numHit);
   EXPECT_LT(0, stats.hitBytes);
   EXPECT_LT(0, stats.numEvict);
+  EXPECT_LE(stats.numEvictUnused, stats.numEvict);
   EXPECT_GE(
       kMaxBytes / memory::AllocationTraits::kPageSize,
       cache_->incrementCachedPages(0));
@@ -1019,6 +1020,8 @@ TEST_P(AsyncDataCacheTest, cacheStatsWithSsd) {
   CacheStats stats;
   stats.numHit = 234;
   stats.numEvict = 1024;
+  stats.numEvictUnused = 512;
+  stats.sumEvictUnusedAgeMs = 2048;
   stats.ssdStats = std::make_shared<SsdCacheStats>();
   stats.ssdStats->bytesWritten = 1;
   stats.ssdStats->bytesRead = 1;
@@ -1027,6 +1030,8 @@ TEST_P(AsyncDataCacheTest, cacheStatsWithSsd) {
   const CacheStats deltaStats = stats - otherStats;
   ASSERT_EQ(deltaStats.numHit, 234);
   ASSERT_EQ(deltaStats.numEvict, 1024);
+  ASSERT_EQ(deltaStats.numEvictUnused, 512);
+  ASSERT_EQ(deltaStats.sumEvictUnusedAgeMs, 2048);
   ASSERT_TRUE(deltaStats.ssdStats != nullptr);
   ASSERT_EQ(deltaStats.ssdStats->bytesWritten, 1);
   ASSERT_EQ(deltaStats.ssdStats->bytesRead, 1);
@@ -1076,6 +1081,122 @@ TEST_P(AsyncDataCacheTest, staleEntry) {
   ASSERT_EQ(stats.numHit, 1);
 }
 
+TEST_P(AsyncDataCacheTest, admissionFilter) {
+  constexpr uint64_t kRamBytes = 16UL << 20;
+  constexpr int32_t kEntryBytes = 64 << 10;
+  constexpr int32_t kNumHotEntries = kRamBytes / kEntryBytes / 2;
+  constexpr int32_t kNumScanEntries = 4 * kRamBytes / kEntryBytes;
+  AsyncDataCache::Options options;
+  options.admissionSketchWidth = 1 << 10;
+  initializeCache(kRamBytes, 0, 0, false, options);
+
+  const auto access = [&](uint64_t offset) {
+    folly::SemiFuture<bool> wait(false);
+    try {
+      auto pin = cache_->findOrCreate(
+          RawFileCacheKey{filenames_[0].id(), offset}, kEntryBytes, &wait);
+      if (!pin.empty() && pin.entry()->isExclusive()) {
+        pin.entry()->setExclusiveToShared();
+      }
+    } catch (const VeloxException&) {
+      // No space in cache.
+    }
+  };
+
+  // Access the hot entries a few times each.
+  for (auto round = 0; round < 4; ++round) {
+    for (auto i = 0; i < kNumHotEntries; ++i) {
+      access(i * kEntryBytes);
+    }
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numAdmissionChecks, 0);
+  ASSERT_EQ(stats.numAdmissionRejects, 0);
+
+  // Scan 4x the cache capacity once. Once the cache evicts, the scanned
+  // entries are less frequent than the hot entries they would replace.
+  const uint64_t scanStart = 1UL << 30;
+  for (auto i = 0; i < kNumScanEntries; ++i) {
+    access(scanStart + i * kEntryBytes);
+  }
+  stats = cache_->refreshStats();
+  ASSERT_GT(stats.numEvict, 0);
+  ASSERT_GT(stats.numAdmissionChecks, 0);
+  ASSERT_GT(stats.numAdmissionRejects, 0);
+  ASSERT_LE(stats.numAdmissionRejects, stats.numAdmissionChecks);
+  ASSERT_NE(stats.toString().find("admission rejects"), std::string::npos);
+
+  const auto delta = cache_->refreshStats() - stats;
+  ASSERT_EQ(delta.numAdmissionChecks, 0);
+  ASSERT_EQ(delta.numAdmissionRejects, 0);
+}
+
+TEST_P(AsyncDataCacheTest, compressedTier) {
+  constexpr uint64_t kRamBytes = 16UL << 20;
+  constexpr uint64_t kCompressedBytes = 4UL << 20;
+  constexpr int32_t kEntryBytes = 64 << 10;
+  constexpr int32_t kNumEntries = 2 * kRamBytes / kEntryBytes;
+  AsyncDataCache::Options options;
+  options.maxCompressedBytes = kCompressedBytes;
+  initializeCache(kRamBytes, 0, 0, false, options);
+
+  // Fills the entry at 'offset' with a compressible pattern that starts with
+  // 'offset'.
+  const auto fill = [](uint64_t offset, memory::Allocation& data) {
+    for (auto i = 0; i < data.numRuns(); ++i) {
+      const auto run = data.runAt(i);
+      ::memset(run.data<char>(), 'a' + offset % 26, run.numBytes());
+    }
+    ::memcpy(data.runAt(0).data<char>(), &offset, sizeof(offset));
+  };
+  const auto check = [](uint64_t offset, const memory::Allocation& data) {
+    uint64_t first;
+    ::memcpy(&first, data.runAt(0).data<char>(), sizeof(first));
+    ASSERT_EQ(first, offset);
+    const auto lastRun = data.runAt(data.numRuns() - 1);
+    ASSERT_EQ(
+        lastRun.data<char>()[lastRun.numBytes() - 1],
+        static_cast<char>('a' + offset % 26));
+  };
+
+  for (auto i = 0; i < kNumEntries; ++i) {
+    const uint64_t offset = i;
+    auto pin = cache_->findOrCreate(
+        RawFileCacheKey{filenames_[0].id(), offset}, kEntryBytes, nullptr);
+    ASSERT_TRUE(pin.entry()->isExclusive());
+    fill(offset, pin.entry()->data());
+    pin.entry()->setExclusiveToShared();
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_GT(stats.numEvict, 0);
+  ASSERT_GT(stats.numCompressed, 0);
+  ASSERT_GT(stats.numCompressedEntries, 0);
+  ASSERT_GT(stats.compressedSize, 0);
+  ASSERT_LE(stats.compressedSize, kCompressedBytes);
+  ASSERT_NE(stats.toString().find("compressed entries"), std::string::npos);
+
+  // Every entry that is still in the cache, compressed or not, is hit with its
+  // original contents.
+  int32_t numHits = 0;
+  for (auto i = 0; i < kNumEntries; ++i) {
+    const uint64_t offset = i;
+    auto pin = cache_->findOrCreate(
+        RawFileCacheKey{filenames_[0].id(), offset}, kEntryBytes, nullptr);
+    if (pin.entry()->isExclusive()) {
+      fill(offset, pin.entry()->data());
+      pin.entry()->setExclusiveToShared();
+      continue;
+    }
+    ASSERT_FALSE(pin.entry()->isCompressed());
+    check(offset, pin.entry()->data());
+    ++numHits;
+  }
+  const auto delta = cache_->refreshStats() - stats;
+  ASSERT_GT(delta.numDecompressed, 0);
+  ASSERT_LE(delta.numDecompressed, numHits);
+  ASSERT_LE(cache_->refreshStats().compressedSize, kCompressedBytes);
+}
+
 TEST_P(AsyncDataCacheTest, shrinkCache) {
   constexpr uint64_t kRamBytes = 128UL << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+TEST(FrequencySketchTest, estimate) {
+  FrequencySketch sketch(1 << 10);
+  ASSERT_EQ(sketch.estimate(1), 0);
+  for (auto i = 0; i < 5; ++i) {
+    sketch.increment(1);
+  }
+  sketch.increment(2);
+  ASSERT_EQ(sketch.estimate(1), 5);
+  ASSERT_EQ(sketch.estimate(2), 1);
+  ASSERT_EQ(sketch.estimate(3), 0);
+
+  // Counters saturate.
+  for (auto i = 0; i < 2 * FrequencySketch::kMaxCount; ++i) {
+    sketch.increment(1);
+  }
+  ASSERT_EQ(sketch.estimate(1), FrequencySketch::kMaxCount);
+  ASSERT_EQ(sketch.numAgings(), 0);
+}
+
+TEST(FrequencySketchTest, aging) {
+  FrequencySketch sketch(64);
+  ASSERT_EQ(sketch.sampleSize(), 640);
+  for (auto i = 0; i < 8; ++i) {
+    sketch.increment(1);
+  }
+  sketch.age();
+  ASSERT_EQ(sketch.estimate(1), 4);
+  ASSERT_EQ(sketch.numAgings(), 1);
+
+  // Aging keeps half of the increments. Distinct keys trigger the periodic
+  // aging at the last increment, after which all counters are at most half of
+  // the max.
+  for (auto i = 0; i < sketch.sampleSize() - 4; ++i) {
+    sketch.increment(1'000 + i);
+  }
+  ASSERT_EQ(sketch.numAgings(), 2);
+  ASSERT_LE(sketch.estimate(1), FrequencySketch::kMaxCount / 2);
+  ASSERT_LE(sketch.estimate(1'000), FrequencySketch::kMaxCount / 2);
+}
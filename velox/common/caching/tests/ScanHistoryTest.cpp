@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/caching/ScanHistory.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+
+class ScanHistoryTest : public testing::Test {
+ protected:
+  void TearDown() override {
+    ScanHistory::testingClear();
+  }
+
+  static constexpr int32_t kLoadQuantum = 1 << 20;
+
+  // Runs a scan of 'table' that references 'referenced' bytes and reads
+  // 'read' bytes of column 'id'.
+  static void scan(
+      const std::string& table,
+      TrackingId id,
+      uint64_t referenced,
+      uint64_t read) {
+    ScanTracker tracker("scan", nullptr, kLoadQuantum, nullptr, table);
+    tracker.recordReference(id, referenced, 0, 0);
+    tracker.recordRead(id, read, 0, 0);
+  }
+};
+
+TEST_F(ScanHistoryTest, warmStart) {
+  const TrackingId read(1);
+  const TrackingId skipped(2);
+  {
+    ScanTracker tracker("scan", nullptr, kLoadQuantum);
+    ASSERT_EQ(tracker.trackingData(read).referencedBytes, 0);
+  }
+  auto* history = ScanHistory::create();
+  ASSERT_EQ(ScanHistory::getInstance(), history);
+  scan("t", read, 64 * kLoadQuantum, 64 * kLoadQuantum);
+  scan("t", skipped, 128 * kLoadQuantum, 0);
+  ASSERT_EQ(history->numKeys(), 1);
+
+  // A new scan of 't' starts with the history, scaled to kHistoryQuanta load
+  // quanta.
+  ScanTracker tracker("scan2", nullptr, kLoadQuantum, nullptr, "t");
+  auto data = tracker.trackingData(read);
+  ASSERT_DOUBLE_EQ(
+      data.referencedBytes, ScanTracker::kHistoryQuanta * kLoadQuantum);
+  ASSERT_EQ(data.readBytes, data.referencedBytes);
+  ASSERT_EQ(tracker.readPct(read), 100);
+  ASSERT_EQ(tracker.readPct(skipped), 0);
+
+  // The accesses of the scan add to the history.
+  tracker.recordReference(skipped, 4 * kLoadQuantum, 0, 0);
+  tracker.recordRead(skipped, 4 * kLoadQuantum, 0, 0);
+  ASSERT_EQ(tracker.readPct(skipped), 50);
+
+  // Another table has no history.
+  ScanTracker other("scan3", nullptr, kLoadQuantum, nullptr, "u");
+  ASSERT_EQ(other.trackingData(read).referencedBytes, 0);
+}
+
+TEST_F(ScanHistoryTest, decay) {
+  auto* history = ScanHistory::create();
+  const TrackingId id(1);
+  scan("t", id, 1000, 0);
+  scan("t", id, 1000, 1000);
+  auto data = history->get("t")[id];
+  ASSERT_EQ(data.referencedBytes, 1000 * ScanHistory::kDecay + 1000);
+  ASSERT_EQ(data.readBytes, 1000);
+}
+
+TEST_F(ScanHistoryTest, persistence) {
+  auto directory = exec::test::TempDirectoryPath::create();
+  const auto path = directory->getPath() + "/history";
+  const TrackingId id(7);
+  ScanHistory::create(path);
+  scan("schema.table with space", id, 1000, 250);
+  ScanHistory::testingClear();
+
+  auto* history = ScanHistory::create(path);
+  auto data = history->get("schema.table with space")[id];
+  ASSERT_EQ(data.referencedBytes, 1000);
+  ASSERT_EQ(data.readBytes, 250);
+  ScanHistory::testingClear();
+
+  // A missing file starts with an empty history.
+  history = ScanHistory::create(directory->getPath() + "/missing");
+  ASSERT_EQ(history->numKeys(), 0);
+}
+
+} // namespace
@@ -29,6 +29,8 @@
 #include <gtest/gtest.h>
 #include <re2/re2.h>
 
+#include <filesystem>
+
 using namespace facebook::velox;
 using namespace facebook::velox::cache;
 using namespace facebook::velox::tests::utils;
@@ -74,7 +76,8 @@ class SsdFileTest : public testing::Test {
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
       bool disableFileCow = false,
-      bool enableFaultInjection = false) {
+      bool enableFaultInjection = false,
+      bool checkpointJournalEnabled = false) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_velox_ssd_odirect = false;
     cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
@@ -88,7 +91,8 @@ class SsdFileTest : public testing::Test {
         checkpointIntervalBytes,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        disableFileCow);
+        disableFileCow,
+        checkpointJournalEnabled);
   }
 
   void initializeSsdFile(
@@ -96,7 +100,8 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      bool checkpointJournalEnabled = false) {
     SsdFile::Config config(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
@@ -105,7 +110,8 @@ class SsdFileTest : public testing::Test {
         disableFileCow,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        ssdExecutor());
+        ssdExecutor(),
+        checkpointJournalEnabled);
     ssdFile_ = std::make_unique<SsdFile>(config);
     if (ssdFile_ != nullptr) {
       ssdFileHelper_ =
@@ -691,6 +697,98 @@ TEST_F(SsdFileTest, recoverFromCheckpointWithChecksum) {
   }
 }
 
+TEST_F(SsdFileTest, recoverFromCheckpointJournal) {
+  constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
+  // Only checkpoints explicitly.
+  const uint64_t checkpointIntervalBytes = 100 * SsdFile::kRegionSize;
+  FLAGS_velox_ssd_verify_write = true;
+
+  const auto writeEntries = [&](int32_t beginRegion,
+                                int32_t endRegion,
+                                std::vector<TestEntry>& entries) {
+    for (auto region = beginRegion; region < endRegion; ++region) {
+      auto pins = makePins(
+          fileName_.id(),
+          region * SsdFile::kRegionSize,
+          4096,
+          2048 * 1025,
+          62 * kMB);
+      ssdFile_->write(pins);
+      for (auto& pin : pins) {
+        EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+        entries.emplace_back(
+            pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+      };
+    }
+  };
+
+  initializeCache(
+      kSsdSize, checkpointIntervalBytes, true, false, false, false, true);
+  std::vector<TestEntry> checkpointedEntries;
+  writeEntries(0, 4, checkpointedEntries);
+  ssdFile_->checkpoint(true);
+  std::vector<TestEntry> journaledEntries;
+  writeEntries(4, 8, journaledEntries);
+  EXPECT_GT(std::filesystem::file_size(ssdFile_->journalFilePath()), 0);
+
+  // Restart without another checkpoint. The entries written after the
+  // checkpoint are recovered from the journal.
+  initializeSsdFile(
+      kSsdSize, checkpointIntervalBytes, true, false, false, true);
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(
+      stats.entriesRecovered,
+      checkpointedEntries.size() + journaledEntries.size());
+  EXPECT_EQ(
+      stats.entriesCached,
+      checkpointedEntries.size() + journaledEntries.size());
+  EXPECT_EQ(checkEntries(checkpointedEntries), checkpointedEntries.size());
+  EXPECT_EQ(checkEntries(journaledEntries), journaledEntries.size());
+
+  // Without the journal, only the checkpointed entries are recovered and the
+  // stale journal is removed.
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes, true, false);
+  EXPECT_EQ(checkEntries(checkpointedEntries), checkpointedEntries.size());
+  EXPECT_EQ(checkEntries(journaledEntries), 0);
+  EXPECT_FALSE(std::filesystem::exists(ssdFile_->journalFilePath()));
+
+  // A checkpoint truncates the journal.
+  initializeSsdFile(
+      kSsdSize, checkpointIntervalBytes, true, false, false, true);
+  journaledEntries.clear();
+  writeEntries(4, 8, journaledEntries);
+  EXPECT_GT(std::filesystem::file_size(ssdFile_->journalFilePath()), 0);
+  ssdFile_->checkpoint(true);
+  EXPECT_EQ(std::filesystem::file_size(ssdFile_->journalFilePath()), 0);
+
+  // Journaled entries are verified on first read even without read
+  // verification. The corrupted ones are removed.
+  checkpointedEntries.insert(
+      checkpointedEntries.end(),
+      journaledEntries.begin(),
+      journaledEntries.end());
+  journaledEntries.clear();
+  writeEntries(8, 10, journaledEntries);
+  corruptSsdFile(fmt::format("{}/ssdtest", tempDirectory_->getPath()));
+  initializeSsdFile(
+      kSsdSize, checkpointIntervalBytes, true, false, false, true);
+  EXPECT_EQ(checkEntries(checkpointedEntries), checkpointedEntries.size());
+  VELOX_ASSERT_THROW(
+      checkEntries({journaledEntries.end() - 1, journaledEntries.end()}),
+      "Corrupt SSD cache entry");
+  const auto& corruptedKey = journaledEntries.back().key;
+  EXPECT_TRUE(ssdFile_
+                  ->find(RawFileCacheKey{
+                      corruptedKey.fileNum.id(), corruptedKey.offset})
+                  .empty());
+  stats.clear();
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(stats.readSsdCorruptions, 1);
+  // New entries can be written.
+  writeEntries(8, 10, journaledEntries);
+}
+
 TEST_F(SsdFileTest, recoverWithEvictedEntries) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
@@ -768,6 +866,58 @@ TEST_F(SsdFileTest, recoverWithEvictedEntries) {
   ASSERT_EQ(statsAfterRecovery.entriesCached, stats.entriesCached);
 }
 
+TEST_F(SsdFileTest, recoverWithMultipleEvictions) {
+  constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
+  // Only checkpoints explicitly.
+  const uint64_t checkpointIntervalBytes = 100 * SsdFile::kRegionSize;
+  std::vector<StringIdLease> files;
+  for (const auto* name : {"Retained", "Evicted1", "Evicted2"}) {
+    files.emplace_back(
+        fileIds(), fmt::format("recoverWithMultipleEvictions.{}", name));
+  }
+  initializeCache(kSsdSize, checkpointIntervalBytes);
+
+  for (const auto& file : files) {
+    for (auto startOffset = 0; startOffset < 2 * SsdFile::kRegionSize;
+         startOffset += SsdFile::kRegionSize / 2) {
+      auto pins = makePins(
+          file.id(), startOffset, 4096, 2048 * 1025, SsdFile::kRegionSize / 2);
+      ssdFile_->write(pins);
+      readAndCheckPins(pins);
+    }
+  }
+  ssdFile_->checkpoint(true);
+
+  // Evict the regions of the last two files in two separate batches. The
+  // entries of each file that spill over into the next region are freed with
+  // the next file, so that no removed entry stays in a retained region.
+  folly::F14FastSet<uint64_t> retainedFileIds;
+  SsdCacheStats stats;
+  ssdFile_->removeFileEntries({files[1].id()}, retainedFileIds);
+  ssdFile_->updateStats(stats);
+  const auto firstEvictedRegions = stats.regionsEvicted;
+  ASSERT_GT(firstEvictedRegions, 0);
+  ssdFile_->removeFileEntries({files[2].id()}, retainedFileIds);
+  ASSERT_TRUE(retainedFileIds.empty());
+  stats.clear();
+  ssdFile_->updateStats(stats);
+  ASSERT_GT(stats.regionsEvicted, firstEvictedRegions);
+
+  // Both batches are in the eviction log.
+  ASSERT_EQ(
+      std::filesystem::file_size(ssdFile_->evictLogFilePath()),
+      stats.regionsEvicted * sizeof(int32_t));
+
+  // Re-initialize from the checkpoint taken before both evictions. The
+  // entries of the regions evicted by either batch are not recovered.
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes);
+  SsdCacheStats statsAfterRecovery;
+  ssdFile_->updateStats(statsAfterRecovery);
+  ASSERT_EQ(statsAfterRecovery.entriesCached, stats.entriesCached);
+  ASSERT_EQ(statsAfterRecovery.bytesCached, stats.bytesCached);
+  ASSERT_EQ(statsAfterRecovery.regionsCached, stats.regionsCached);
+}
+
 TEST_F(SsdFileTest, ssdReadWithoutChecksumCheck) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
 
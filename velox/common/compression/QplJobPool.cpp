@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/QplJobPool.h"
+
+#include <folly/ScopeGuard.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "velox/common/base/Exceptions.h"
+
+#ifdef VELOX_ENABLE_QPL
+#include <qpl/qpl.h>
+#endif
+
+DECLARE_int32(velox_qpl_job_pool_size);
+
+namespace facebook::velox::common {
+
+struct QplJobPool::Job {
+  std::atomic<bool> busy{false};
+  // The memory of the qpl_job, whose size depends on the QPL version.
+  std::unique_ptr<uint8_t[]> buffer;
+};
+
+// static
+QplJobPool* QplJobPool::instance() {
+  static QplJobPool* pool = []() -> QplJobPool* {
+#ifdef VELOX_ENABLE_QPL
+    if (FLAGS_velox_qpl_job_pool_size <= 0) {
+      return nullptr;
+    }
+    try {
+      return new QplJobPool(FLAGS_velox_qpl_job_pool_size);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "IAA is not available, deflate streams are "
+                   << "decompressed in software: " << e.what();
+    }
+#endif
+    return nullptr;
+  }();
+  return pool;
+}
+
+#ifdef VELOX_ENABLE_QPL
+
+namespace {
+qpl_job* toQplJob(uint8_t* buffer) {
+  return reinterpret_cast<qpl_job*>(buffer);
+}
+} // namespace
+
+QplJobPool::QplJobPool(int32_t numJobs) {
+  VELOX_CHECK_GT(numJobs, 0);
+  uint32_t jobSize = 0;
+  auto status = qpl_get_job_size(qpl_path_hardware, &jobSize);
+  VELOX_CHECK_EQ(status, QPL_STS_OK, "qpl_get_job_size failed");
+  jobs_.reserve(numJobs);
+  for (auto i = 0; i < numJobs; ++i) {
+    auto job = std::make_unique<Job>();
+    job->buffer = std::make_unique<uint8_t[]>(jobSize);
+    status = qpl_init_job(qpl_path_hardware, toQplJob(job->buffer.get()));
+    VELOX_CHECK_EQ(status, QPL_STS_OK, "qpl_init_job failed");
+    jobs_.push_back(std::move(job));
+  }
+}
+
+QplJobPool::~QplJobPool() {
+  for (auto& job : jobs_) {
+    qpl_fini_job(toQplJob(job->buffer.get()));
+  }
+}
+
+std::optional<uint64_t> QplJobPool::decompress(
+    Format format,
+    const char* src,
+    uint64_t srcLength,
+    char* dest,
+    uint64_t destLength) {
+  if (srcLength > std::numeric_limits<uint32_t>::max()) {
+    return std::nullopt;
+  }
+  auto* job = tryAcquire();
+  if (job == nullptr) {
+    ++numBusy_;
+    return std::nullopt;
+  }
+  SCOPE_EXIT {
+    job->busy.store(false, std::memory_order_release);
+  };
+  auto* qplJob = toQplJob(job->buffer.get());
+  qplJob->op = qpl_op_decompress;
+  qplJob->next_in_ptr = reinterpret_cast<uint8_t*>(const_cast<char*>(src));
+  qplJob->available_in = srcLength;
+  qplJob->next_out_ptr = reinterpret_cast<uint8_t*>(dest);
+  qplJob->available_out = std::min<uint64_t>(
+      destLength, std::numeric_limits<uint32_t>::max());
+  qplJob->flags = QPL_FLAG_FIRST | QPL_FLAG_LAST;
+  switch (format) {
+    case Format::kRawDeflate:
+      break;
+    case Format::kZlib:
+      qplJob->flags |= QPL_FLAG_ZLIB_MODE;
+      break;
+    case Format::kGzip:
+      qplJob->flags |= QPL_FLAG_GZIP_MODE;
+      break;
+  }
+  auto status = qpl_submit_job(qplJob);
+  if (status == QPL_STS_OK) {
+    status = qpl_wait_job(qplJob);
+  }
+  if (status != QPL_STS_OK) {
+    if (status == QPL_STS_QUEUES_ARE_BUSY_ERR) {
+      ++numBusy_;
+    } else {
+      VLOG(1) << "IAA decompression failed with status " << status;
+      ++numFailed_;
+    }
+    return std::nullopt;
+  }
+  ++numHardware_;
+  return qplJob->total_out;
+}
+
+QplJobPool::Job* QplJobPool::tryAcquire() {
+  const auto numJobs = jobs_.size();
+  const auto start = nextJob_.fetch_add(1, std::memory_order_relaxed);
+  for (size_t i = 0; i < numJobs; ++i) {
+    auto& job = jobs_[(start + i) % numJobs];
+    bool expected = false;
+    if (!job->busy.load(std::memory_order_relaxed) &&
+        job->busy.compare_exchange_strong(
+            expected, true, std::memory_order_acquire)) {
+      return job.get();
+    }
+  }
+  return nullptr;
+}
+
+#else
+
+QplJobPool::QplJobPool(int32_t /*numJobs*/) {
+  VELOX_UNSUPPORTED("Velox is built without QPL");
+}
+
+QplJobPool::~QplJobPool() = default;
+
+std::optional<uint64_t> QplJobPool::decompress(
+    Format /*format*/,
+    const char* /*src*/,
+    uint64_t /*srcLength*/,
+    char* /*dest*/,
+    uint64_t /*destLength*/) {
+  return std::nullopt;
+}
+
+QplJobPool::Job* QplJobPool::tryAcquire() {
+  return nullptr;
+}
+
+#endif
+
+} // namespace facebook::velox::common
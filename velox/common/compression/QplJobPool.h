@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace facebook::velox::common {
+
+/// Decompresses deflate streams on the Intel In-Memory Analytics Accelerator
+/// (IAA) through the Intel Query Processing Library (QPL). Holds a fixed
+/// number of hardware jobs that the threads share. A thread that finds no free
+/// job, or whose job the hardware rejects, gets no result and decompresses in
+/// software instead, so that a saturated accelerator never blocks a driver.
+/// Requires building with VELOX_ENABLE_QPL.
+class QplJobPool {
+ public:
+  enum class Format {
+    // Deflate without header, as in DWRF and ORC.
+    kRawDeflate,
+    // Deflate with a zlib header and trailer.
+    kZlib,
+    // Deflate with a gzip header and trailer, as in Parquet GZIP pages.
+    kGzip,
+  };
+
+  struct Stats {
+    // Number of streams decompressed by the accelerator.
+    uint64_t numHardware{0};
+    // Number of streams left to software because no job was free.
+    uint64_t numBusy{0};
+    // Number of streams left to software because the accelerator failed,
+    // e.g. on a history window it does not support.
+    uint64_t numFailed{0};
+  };
+
+  /// Returns the process-wide pool, or nullptr if Velox is built without QPL,
+  /// --velox_qpl_job_pool_size is 0 or no accelerator is available.
+  static QplJobPool* instance();
+
+  explicit QplJobPool(int32_t numJobs);
+
+  ~QplJobPool();
+
+  /// Decompresses 'srcLength' bytes of 'format' at 'src' into at most
+  /// 'destLength' bytes at 'dest'. Returns the decompressed size or
+  /// std::nullopt if the caller should decompress in software.
+  std::optional<uint64_t> decompress(
+      Format format,
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength);
+
+  Stats stats() const {
+    return {numHardware_, numBusy_, numFailed_};
+  }
+
+ private:
+  struct Job;
+
+  // Returns a free job or nullptr if all are in use.
+  Job* tryAcquire();
+
+  std::vector<std::unique_ptr<Job>> jobs_;
+  // Where the next tryAcquire() starts looking, so that the threads do not
+  // all contend for the first jobs.
+  std::atomic<uint32_t> nextJob_{0};
+
+  std::atomic<uint64_t> numHardware_{0};
+  std::atomic<uint64_t> numBusy_{0};
+  std::atomic<uint64_t> numFailed_{0};
+};
+
+} // namespace facebook::velox::common
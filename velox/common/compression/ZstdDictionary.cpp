@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/ZstdDictionary.h"
+
+#include <zdict.h>
+#include <zstd.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::common {
+
+class ZstdDictionaryCodec : public folly::compression::Codec {
+ public:
+  explicit ZstdDictionaryCodec(
+      std::shared_ptr<const ZstdDictionary> dictionary)
+      : Codec(folly::compression::CodecType::ZSTD),
+        dictionary_(std::move(dictionary)) {}
+
+  ~ZstdDictionaryCodec() override {
+    ZSTD_freeCCtx(compressContext_);
+    ZSTD_freeDCtx(decompressContext_);
+  }
+
+ private:
+  static void checkResult(size_t result) {
+    VELOX_CHECK(
+        !ZSTD_isError(result), "ZSTD error: {}", ZSTD_getErrorName(result));
+  }
+
+  uint64_t doMaxCompressedLength(uint64_t uncompressedLength) const override {
+    return ZSTD_compressBound(uncompressedLength);
+  }
+
+  std::unique_ptr<folly::IOBuf> doCompress(const folly::IOBuf* data) override {
+    std::unique_ptr<folly::IOBuf> coalesced;
+    if (data->isChained()) {
+      coalesced = data->cloneCoalesced();
+      data = coalesced.get();
+    }
+    if (compressContext_ == nullptr) {
+      compressContext_ = ZSTD_createCCtx();
+      VELOX_CHECK_NOT_NULL(compressContext_);
+    }
+    auto output = folly::IOBuf::create(ZSTD_compressBound(data->length()));
+    const auto size = ZSTD_compress_usingCDict(
+        compressContext_,
+        output->writableData(),
+        output->capacity(),
+        data->data(),
+        data->length(),
+        dictionary_->compressDictionary_);
+    checkResult(size);
+    output->append(size);
+    return output;
+  }
+
+  std::unique_ptr<folly::IOBuf> doUncompress(
+      const folly::IOBuf* data,
+      folly::Optional<uint64_t> uncompressedLength) override {
+    std::unique_ptr<folly::IOBuf> coalesced;
+    if (data->isChained()) {
+      coalesced = data->cloneCoalesced();
+      data = coalesced.get();
+    }
+    uint64_t length;
+    if (uncompressedLength.has_value()) {
+      length = uncompressedLength.value();
+    } else {
+      length = ZSTD_getFrameContentSize(data->data(), data->length());
+      VELOX_CHECK(
+          length != ZSTD_CONTENTSIZE_UNKNOWN &&
+              length != ZSTD_CONTENTSIZE_ERROR,
+          "ZSTD frame has no uncompressed length");
+    }
+    if (decompressContext_ == nullptr) {
+      decompressContext_ = ZSTD_createDCtx();
+      VELOX_CHECK_NOT_NULL(decompressContext_);
+    }
+    auto output = folly::IOBuf::create(length);
+    size_t size;
+    if (ZSTD_getDictID_fromFrame(data->data(), data->length()) ==
+        dictionary_->id()) {
+      size = ZSTD_decompress_usingDDict(
+          decompressContext_,
+          output->writableData(),
+          length,
+          data->data(),
+          data->length(),
+          dictionary_->decompressDictionary_);
+    } else {
+      size = ZSTD_decompressDCtx(
+          decompressContext_,
+          output->writableData(),
+          length,
+          data->data(),
+          data->length());
+    }
+    checkResult(size);
+    VELOX_CHECK_EQ(size, length, "ZSTD uncompressed length mismatch");
+    output->append(size);
+    return output;
+  }
+
+  const std::shared_ptr<const ZstdDictionary> dictionary_;
+  ZSTD_CCtx* compressContext_{nullptr};
+  ZSTD_DCtx* decompressContext_{nullptr};
+};
+
+// static
+std::shared_ptr<const ZstdDictionary> ZstdDictionary::train(
+    const std::vector<std::string_view>& samples,
+    size_t maxSize,
+    int32_t level) {
+  std::string buffer;
+  std::vector<size_t> sampleSizes;
+  sampleSizes.reserve(samples.size());
+  for (const auto& sample : samples) {
+    buffer.append(sample);
+    sampleSizes.push_back(sample.size());
+  }
+  std::string data(maxSize, '\0');
+  const auto size = ZDICT_trainFromBuffer(
+      data.data(),
+      data.size(),
+      buffer.data(),
+      sampleSizes.data(),
+      static_cast<unsigned>(sampleSizes.size()));
+  if (ZDICT_isError(size)) {
+    return nullptr;
+  }
+  data.resize(size);
+  return std::make_shared<ZstdDictionary>(std::move(data), level);
+}
+
+ZstdDictionary::ZstdDictionary(std::string data, int32_t level)
+    : data_(std::move(data)),
+      level_(level),
+      id_(ZDICT_getDictID(data_.data(), data_.size())) {
+  VELOX_CHECK_NE(id_, 0, "Not a ZSTD dictionary");
+  compressDictionary_ = ZSTD_createCDict(data_.data(), data_.size(), level_);
+  decompressDictionary_ = ZSTD_createDDict(data_.data(), data_.size());
+  VELOX_CHECK_NOT_NULL(compressDictionary_);
+  VELOX_CHECK_NOT_NULL(decompressDictionary_);
+}
+
+ZstdDictionary::~ZstdDictionary() {
+  ZSTD_freeCDict(compressDictionary_);
+  ZSTD_freeDDict(decompressDictionary_);
+}
+
+std::unique_ptr<folly::compression::Codec> ZstdDictionary::createCodec()
+    const {
+  return std::make_unique<ZstdDictionaryCodec>(shared_from_this());
+}
+
+std::unique_ptr<folly::compression::Codec> compressionKindToCodec(
+    CompressionKind kind,
+    const ZstdDictionary* dictionary) {
+  if (dictionary == nullptr) {
+    return compressionKindToCodec(kind);
+  }
+  VELOX_CHECK_EQ(
+      kind,
+      CompressionKind_ZSTD,
+      "A compression dictionary requires ZSTD compression");
+  return dictionary->createCodec();
+}
+
+} // namespace facebook::velox::common
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "velox/common/compression/Compression.h"
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace facebook::velox::common {
+
+/// A ZSTD dictionary trained from samples of the data to compress. Small
+/// buffers of similar content, like the pages of a spill run, compress much
+/// better with a dictionary than alone. A dictionary is immutable and is shared
+/// by the codecs made from it, which may run on different threads.
+class ZstdDictionary : public std::enable_shared_from_this<ZstdDictionary> {
+ public:
+  /// The level of the ZSTD codec from compressionKindToCodec(kind).
+  static constexpr int32_t kDefaultLevel = 1;
+
+  /// Trains a dictionary of up to 'maxSize' bytes from 'samples'. The data is
+  /// compressed at 'level'. Returns nullptr if the samples are too few or too
+  /// uniform to train a dictionary.
+  static std::shared_ptr<const ZstdDictionary> train(
+      const std::vector<std::string_view>& samples,
+      size_t maxSize,
+      int32_t level = kDefaultLevel);
+
+  /// Loads a dictionary returned by data() of a trained one. Must be owned by
+  /// a shared_ptr.
+  ZstdDictionary(std::string data, int32_t level);
+
+  ~ZstdDictionary();
+
+  /// The id of the dictionary, which ZSTD records in the frames compressed
+  /// with it.
+  uint32_t id() const {
+    return id_;
+  }
+
+  const std::string& data() const {
+    return data_;
+  }
+
+  /// Returns a ZSTD codec that compresses with 'this'. It decompresses the
+  /// frames compressed with 'this' and also those compressed without a
+  /// dictionary, so that data written before the dictionary was trained
+  /// reads with the same codec. The codec holds a reference to 'this'.
+  std::unique_ptr<folly::compression::Codec> createCodec() const;
+
+ private:
+  friend class ZstdDictionaryCodec;
+
+  const std::string data_;
+  const int32_t level_;
+  uint32_t id_;
+  ZSTD_CDict_s* compressDictionary_;
+  ZSTD_DDict_s* decompressDictionary_;
+};
+
+/// Returns the codec for 'kind' like compressionKindToCodec(kind), using
+/// 'dictionary' if not null. A dictionary requires CompressionKind_ZSTD.
+std::unique_ptr<folly::compression::Codec> compressionKindToCodec(
+    CompressionKind kind,
+    const ZstdDictionary* dictionary);
+
+} // namespace facebook::velox::common
@@ -19,6 +19,8 @@
 #include "velox/common/base/VeloxException.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/QplJobPool.h"
+#include "velox/common/compression/ZstdDictionary.h"
 
 namespace facebook::velox::common {
 
@@ -59,4 +61,96 @@ TEST_F(CompressionTest, stringToCompressionKind) {
   VELOX_ASSERT_THROW(
       stringToCompressionKind("bz2"), "Not support compression kind bz2");
 }
+
+TEST_F(CompressionTest, qplJobPool) {
+  auto* jobPool = QplJobPool::instance();
+#ifndef VELOX_ENABLE_QPL
+  ASSERT_EQ(jobPool, nullptr);
+  VELOX_ASSERT_THROW(QplJobPool(1), "Velox is built without QPL");
+#endif
+  if (jobPool == nullptr) {
+    return;
+  }
+  std::string data;
+  for (auto i = 0; i < 10'000; ++i) {
+    data += fmt::format("{} ", i % 97);
+  }
+  const std::vector<std::pair<CompressionKind, QplJobPool::Format>> formats =
+      {{CompressionKind_ZLIB, QplJobPool::Format::kZlib},
+       {CompressionKind_GZIP, QplJobPool::Format::kGzip}};
+  for (const auto& [kind, format] : formats) {
+    SCOPED_TRACE(compressionKindToString(kind));
+    auto compressed =
+        compressionKindToCodec(kind)->compress(folly::StringPiece(data));
+    std::string decompressed(data.size(), '\0');
+    const auto stats = jobPool->stats();
+    const auto size = jobPool->decompress(
+        format,
+        compressed.data(),
+        compressed.size(),
+        decompressed.data(),
+        decompressed.size());
+    if (!size.has_value()) {
+      // The accelerator was busy or failed and the caller decompresses in
+      // software.
+      ASSERT_EQ(jobPool->stats().numHardware, stats.numHardware);
+      continue;
+    }
+    ASSERT_EQ(*size, data.size());
+    ASSERT_EQ(decompressed, data);
+    ASSERT_EQ(jobPool->stats().numHardware, stats.numHardware + 1);
+  }
+}
+
+TEST_F(CompressionTest, zstdDictionary) {
+  // Many small pages of similar rows, like the buffers of a spill run.
+  std::vector<std::string> pages;
+  for (auto i = 0; i < 1'000; ++i) {
+    std::string page;
+    for (auto j = 0; j < 20; ++j) {
+      page += fmt::format(
+          "{{\"id\": {}, \"name\": \"customer#{}\", \"nation\": {}}}",
+          i * 20 + j,
+          (i * 7 + j) % 1'000,
+          j % 25);
+    }
+    pages.push_back(std::move(page));
+  }
+  const std::vector<std::string_view> samples(pages.begin(), pages.end());
+  auto dictionary = ZstdDictionary::train(samples, 16 << 10);
+  ASSERT_NE(dictionary, nullptr);
+  ASSERT_NE(dictionary->id(), 0);
+  ASSERT_LE(dictionary->data().size(), 16 << 10);
+
+  auto codec = dictionary->createCodec();
+  auto plainCodec = compressionKindToCodec(CompressionKind_ZSTD);
+  size_t compressedSize = 0;
+  size_t plainCompressedSize = 0;
+  for (const auto& page : pages) {
+    const auto compressed = codec->compress(folly::StringPiece(page));
+    compressedSize += compressed.size();
+    ASSERT_EQ(codec->uncompress(folly::StringPiece(compressed)), page);
+
+    // Frames compressed without the dictionary also decompress.
+    const auto plainCompressed =
+        plainCodec->compress(folly::StringPiece(page));
+    plainCompressedSize += plainCompressed.size();
+    ASSERT_EQ(codec->uncompress(folly::StringPiece(plainCompressed)), page);
+  }
+  ASSERT_LT(compressedSize * 2, plainCompressedSize);
+
+  // A dictionary loaded from the data of another decompresses its frames.
+  ZstdDictionary copy(dictionary->data(), ZstdDictionary::kDefaultLevel);
+  ASSERT_EQ(copy.id(), dictionary->id());
+  const auto compressed = codec->compress(folly::StringPiece(pages[0]));
+  ASSERT_EQ(
+      compressionKindToCodec(CompressionKind_ZSTD, dictionary.get())
+          ->uncompress(folly::StringPiece(compressed)),
+      pages[0]);
+
+  ASSERT_EQ(ZstdDictionary::train({"a", "b"}, 16 << 10), nullptr);
+  VELOX_ASSERT_THROW(
+      compressionKindToCodec(CompressionKind_LZ4, dictionary.get()),
+      "A compression dictionary requires ZSTD compression");
+}
 } // namespace facebook::velox::common
@@ -16,6 +16,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUringReader.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
@@ -27,6 +28,7 @@
 #include <linux/fs.h>
 #endif // linux
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 
 namespace facebook::velox {
 
@@ -89,6 +91,17 @@ uint64_t ReadFile::preadv(
   return numRead;
 }
 
+std::vector<folly::SemiFuture<uint64_t>> ReadFile::preadvBatchAsync(
+    const std::vector<AsyncRead>& reads,
+    filesystems::File::IoStats* stats) const {
+  std::vector<folly::SemiFuture<uint64_t>> futures;
+  futures.reserve(reads.size());
+  for (const auto& read : reads) {
+    futures.push_back(preadvAsync(read.offset, read.buffers, stats));
+  }
+  return futures;
+}
+
 uint64_t ReadFile::preadv(
     folly::Range<const common::Region*> regions,
     folly::Range<folly::IOBuf*> iobufs,
@@ -143,8 +156,9 @@ uint64_t InMemoryWriteFile::size() const {
 LocalReadFile::LocalReadFile(
     std::string_view path,
     folly::Executor* executor,
-    bool bufferIo)
-    : executor_(executor), path_(path) {
+    bool bufferIo,
+    bool useMmap)
+    : executor_(executor), ioUring_(IoUringReader::instance()), path_(path) {
   int32_t flags = O_RDONLY;
 #ifdef linux
   if (!bufferIo) {
@@ -172,12 +186,27 @@ LocalReadFile::LocalReadFile(
       path,
       folly::errnoStr(errno));
   size_ = ret;
+  if (useMmap && bufferIo && size_ > 0) {
+    void* mapped = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (mapped == MAP_FAILED) {
+      LOG(WARNING) << "mmap failure in LocalReadFile constructor, reading "
+                   << path_ << " with pread: " << folly::errnoStr(errno);
+    } else {
+      mapped_ = static_cast<char*>(mapped);
+      // Columnar reads are scattered. Readahead around page faults would
+      // mostly bring in unused pages. Reads ask for their ranges instead.
+      madvise(mapped_, size_, MADV_RANDOM);
+    }
+  }
 }
 
 LocalReadFile::LocalReadFile(int32_t fd, folly::Executor* executor)
-    : executor_(executor), fd_(fd) {}
+    : executor_(executor), ioUring_(IoUringReader::instance()), fd_(fd) {}
 
 LocalReadFile::~LocalReadFile() {
+  if (mapped_ != nullptr) {
+    munmap(mapped_, size_);
+  }
   const int ret = close(fd_);
   if (ret < 0) {
     LOG(WARNING) << "close failure in LocalReadFile destructor: " << ret << ", "
@@ -185,8 +214,35 @@ LocalReadFile::~LocalReadFile() {
   }
 }
 
+void LocalReadFile::willNeed(uint64_t offset, uint64_t length) const {
+  static const uint64_t kPageSize = sysconf(_SC_PAGESIZE);
+  const auto begin = offset & ~(kPageSize - 1);
+  madvise(mapped_ + begin, offset + length - begin, MADV_WILLNEED);
+}
+
+std::string_view LocalReadFile::mappedRange(uint64_t offset, uint64_t length)
+    const {
+  if (mapped_ == nullptr) {
+    return {};
+  }
+  VELOX_CHECK_LE(
+      offset + length,
+      static_cast<uint64_t>(size_),
+      "Range out of bounds in LocalReadFile::mappedRange: {}",
+      path_);
+  bytesRead_ += length;
+  if (length > 0) {
+    willNeed(offset, length);
+  }
+  return {mapped_ + offset, length};
+}
+
 void LocalReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
     const {
+  if (mapped_ != nullptr) {
+    ::memcpy(pos, mappedRange(offset, length).data(), length);
+    return;
+  }
   bytesRead_ += length;
   auto bytesRead = ::pread(fd_, pos, length, offset);
   VELOX_CHECK_EQ(
@@ -213,6 +269,16 @@ uint64_t LocalReadFile::preadv(
     filesystems::File::IoStats* stats) const {
   // Dropped bytes sized so that a typical dropped range of 50K is not
   // too many iovecs.
+  if (mapped_ != nullptr) {
+    uint64_t totalBytes = 0;
+    for (auto& range : buffers) {
+      if (range.data()) {
+        preadInternal(offset + totalBytes, range.size(), range.data());
+      }
+      totalBytes += range.size();
+    }
+    return totalBytes;
+  }
   static thread_local std::vector<char> droppedBytes(16 * 1024);
   uint64_t totalBytesRead = 0;
   std::vector<struct iovec> iovecs;
@@ -268,6 +334,12 @@ folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers,
     filesystems::File::IoStats* stats) const {
+  if (mapped_ != nullptr) {
+    return ReadFile::preadvAsync(offset, buffers, stats);
+  }
+  if (ioUring_ != nullptr) {
+    return std::move(preadvBatchAsync({{offset, buffers}}, stats)[0]);
+  }
   if (!executor_) {
     return ReadFile::preadvAsync(offset, buffers, stats);
   }
@@ -283,6 +355,20 @@ folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
   return std::move(future);
 }
 
+std::vector<folly::SemiFuture<uint64_t>> LocalReadFile::preadvBatchAsync(
+    const std::vector<AsyncRead>& reads,
+    filesystems::File::IoStats* stats) const {
+  if (ioUring_ == nullptr || mapped_ != nullptr) {
+    return ReadFile::preadvBatchAsync(reads, stats);
+  }
+  std::vector<IoUringReader::Read> ringReads;
+  ringReads.reserve(reads.size());
+  for (const auto& read : reads) {
+    ringReads.push_back({fd_, read.offset, read.buffers});
+  }
+  return ioUring_->submit(ringReads);
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
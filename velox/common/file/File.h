@@ -45,6 +45,8 @@
 
 namespace facebook::velox {
 
+class IoUringReader;
+
 // A read-only file.  All methods in this object should be thread safe.
 class ReadFile {
  public:
@@ -128,6 +130,33 @@ class ReadFile {
     return false;
   }
 
+  /// A read of consecutive 'buffers' starting at 'offset' for
+  /// preadvBatchAsync().
+  struct AsyncRead {
+    uint64_t offset;
+    std::vector<folly::Range<char*>> buffers;
+  };
+
+  /// Like preadvAsync() for each of 'reads'. An implementation may submit the
+  /// reads to the storage together. Returns a future per read. The default
+  /// implementation calls preadvAsync() for each read.
+  ///
+  /// This method should be thread safe.
+  virtual std::vector<folly::SemiFuture<uint64_t>> preadvBatchAsync(
+      const std::vector<AsyncRead>& reads,
+      filesystems::File::IoStats* stats = nullptr) const;
+
+  /// Returns the bytes at [offset, offset + length) if the file is mapped into
+  /// memory, otherwise an empty view. The view stays valid for the lifetime of
+  /// 'this' and lets callers use the bytes without copying them.
+  ///
+  /// This method should be thread safe.
+  virtual std::string_view mappedRange(
+      uint64_t /*offset*/,
+      uint64_t /*length*/) const {
+    return {};
+  }
+
   // Whether preads should be coalesced where possible. E.g. remote disk would
   // set to true, in-memory to false.
   virtual bool shouldCoalesce() const = 0;
@@ -296,10 +325,16 @@ class InMemoryWriteFile final : public WriteFile {
 /// files match against any filepath starting with '/'.
 class LocalReadFile final : public ReadFile {
  public:
+  /// If 'useMmap' is true and 'bufferIo' is true, the file is mapped into
+  /// memory. Reads then copy from the mapping and mappedRange() returns views
+  /// of it. Kernel readahead is disabled for the mapping and each read asks
+  /// for its own range with madvise(MADV_WILLNEED) instead. The file must not
+  /// be truncated while it is open.
   LocalReadFile(
       std::string_view path,
       folly::Executor* executor = nullptr,
-      bool bufferIo = true);
+      bool bufferIo = true,
+      bool useMmap = false);
 
   /// TODO: deprecate this after creating local file all through velox fs
   /// interface.
@@ -320,17 +355,25 @@ class LocalReadFile final : public ReadFile {
       const std::vector<folly::Range<char*>>& buffers,
       filesystems::File::IoStats* stats = nullptr) const final;
 
+  /// Uses io_uring if available, otherwise 'executor_' if set.
   folly::SemiFuture<uint64_t> preadvAsync(
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers,
       filesystems::File::IoStats* stats = nullptr) const override;
 
   bool hasPreadvAsync() const override {
-    return executor_ != nullptr;
+    return mapped_ == nullptr && (ioUring_ != nullptr || executor_ != nullptr);
   }
 
+  /// Submits all 'reads' with one system call if io_uring is available.
+  std::vector<folly::SemiFuture<uint64_t>> preadvBatchAsync(
+      const std::vector<AsyncRead>& reads,
+      filesystems::File::IoStats* stats = nullptr) const override;
+
   uint64_t memoryUsage() const final;
 
+  std::string_view mappedRange(uint64_t offset, uint64_t length) const final;
+
   bool shouldCoalesce() const final {
     return false;
   }
@@ -349,10 +392,18 @@ class LocalReadFile final : public ReadFile {
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
 
+  // Asks the kernel to read ahead the pages of the mapping that cover
+  // [offset, offset + length).
+  void willNeed(uint64_t offset, uint64_t length) const;
+
   folly::Executor* const executor_;
+  // The process wide io_uring reader, nullptr if io_uring is not available.
+  IoUringReader* const ioUring_;
   std::string path_;
   int32_t fd_;
   long size_;
+  // The mapping of the whole file if opened with 'useMmap', else nullptr.
+  char* mapped_{nullptr};
 };
 
 class LocalWriteFile final : public WriteFile {
@@ -16,37 +16,48 @@
 
 #include "velox/common/file/FileInputStream.h"
 
+#include "velox/common/base/BitUtil.h"
+
 namespace facebook::velox::common {
 
 FileInputStream::FileInputStream(
     std::unique_ptr<ReadFile>&& file,
     uint64_t bufferSize,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    uint32_t numReadAheadBuffers)
     : file_(std::move(file)),
       fileSize_(file_->size()),
       bufferSize_(std::min(fileSize_, bufferSize)),
       pool_(pool),
-      readAheadEnabled_((bufferSize_ < fileSize_) && file_->hasPreadvAsync()) {
+      readAheadEnabled_(
+          (numReadAheadBuffers > 0) && (bufferSize_ < fileSize_) &&
+          file_->hasPreadvAsync()) {
   VELOX_CHECK_NOT_NULL(pool_);
   VELOX_CHECK_GT(fileSize_, 0, "Empty FileInputStream");
 
-  buffers_.push_back(AlignedBuffer::allocate<char>(bufferSize_, pool_));
-  if (readAheadEnabled_) {
+  // No more buffers than needed to hold the rest of the file after the first
+  // read.
+  const uint32_t numBuffers = readAheadEnabled_
+      ? 1 +
+          std::min<uint64_t>(
+              numReadAheadBuffers,
+              bits::divRoundUp(fileSize_, bufferSize_) - 1)
+      : 1;
+  for (uint32_t i = 0; i < numBuffers; ++i) {
     buffers_.push_back(AlignedBuffer::allocate<char>(bufferSize_, pool_));
   }
   readNextRange();
 }
 
 FileInputStream::~FileInputStream() {
-  if (!readAheadWait_.valid()) {
-    return;
-  }
-  try {
-    readAheadWait_.wait();
-  } catch (const std::exception& ex) {
-    // ignore any prefetch error when query has failed.
-    LOG(WARNING) << "FileInputStream read-ahead failed on destruction "
-                 << ex.what();
+  for (auto& readAheadWait : readAheadWaits_) {
+    try {
+      readAheadWait.wait();
+    } catch (const std::exception& ex) {
+      // ignore any prefetch error when query has failed.
+      LOG(WARNING) << "FileInputStream read-ahead failed on destruction "
+                   << ex.what();
+    }
   }
 }
 
@@ -58,12 +69,13 @@ void FileInputStream::readNextRange() {
   uint64_t readTimeNs{0};
   {
     NanosecondTimer timer{&readTimeNs};
-    if (readAheadWait_.valid()) {
-      readBytes = std::move(readAheadWait_)
+    if (!readAheadWaits_.empty()) {
+      auto readAheadWait = std::move(readAheadWaits_.front());
+      readAheadWaits_.pop_front();
+      readBytes = std::move(readAheadWait)
                       .via(&folly::QueuedImmediateExecutor::instance())
                       .wait()
                       .value();
-      VELOX_CHECK(!readAheadWait_.valid());
       VELOX_CHECK_LT(
           0, readBytes, "Read past end of FileInputStream {}", fileSize_);
       advanceBuffer();
@@ -73,6 +85,7 @@ void FileInputStream::readNextRange() {
           0, readBytes, "Read past end of FileInputStream {}", fileSize_);
       NanosecondTimer timer_2{&readTimeNs};
       file_->pread(fileOffset_, readBytes, buffer()->asMutable<char>());
+      readAheadOffset_ = fileOffset_ + readBytes;
     }
   }
 
@@ -206,18 +219,21 @@ uint64_t FileInputStream::readSize() const {
 }
 
 void FileInputStream::maybeIssueReadahead() {
-  VELOX_CHECK(!readAheadWait_.valid());
   if (!readAheadEnabled_) {
     return;
   }
-  const auto size = readSize();
-  if (size == 0) {
-    return;
+  // The buffer being read from is not available for read-ahead.
+  while (readAheadWaits_.size() + 1 < buffers_.size()) {
+    const auto size = std::min(fileSize_ - readAheadOffset_, bufferSize_);
+    if (size == 0) {
+      return;
+    }
+    std::vector<folly::Range<char*>> ranges;
+    ranges.emplace_back(readAheadBuffer()->asMutable<char>(), size);
+    readAheadWaits_.push_back(file_->preadvAsync(readAheadOffset_, ranges));
+    VELOX_CHECK(readAheadWaits_.back().valid());
+    readAheadOffset_ += size;
   }
-  std::vector<folly::Range<char*>> ranges;
-  ranges.emplace_back(nextBuffer()->asMutable<char>(), size);
-  readAheadWait_ = file_->preadvAsync(fileOffset_, ranges);
-  VELOX_CHECK(readAheadWait_.valid());
 }
 
 void FileInputStream::updateStats(uint64_t readBytes, uint64_t readTimeNs) {
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
 
 #include "velox/buffer/Buffer.h"
 #include "velox/common/file/File.h"
@@ -24,13 +25,16 @@
 
 namespace facebook::velox::common {
 
-/// Readonly byte input stream backed by file.
+/// Readonly byte input stream backed by file. If the file supports async read,
+/// the stream reads ahead up to 'numReadAheadBuffers' buffers of 'bufferSize'
+/// bytes each.
 class FileInputStream : public ByteInputStream {
  public:
   FileInputStream(
       std::unique_ptr<ReadFile>&& file,
       uint64_t bufferSize,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      uint32_t numReadAheadBuffers = 1);
 
   ~FileInputStream() override;
 
@@ -77,10 +81,8 @@ class FileInputStream : public ByteInputStream {
   // Invoked to read the next byte range from the file in a buffer.
   void readNextRange();
 
-  // Issues readahead if underlying file system supports async mode read.
-  //
-  // TODO: we might consider to use AsyncSource to support read-ahead on
-  // filesystem which doesn't support async mode read.
+  // Issues readahead if underlying file system supports async mode read. Keeps
+  // up to 'numReadAheadBuffers' reads in flight.
   void maybeIssueReadahead();
 
   inline uint64_t readSize() const;
@@ -93,6 +95,14 @@ class FileInputStream : public ByteInputStream {
     return (bufferIndex_ + 1) % buffers_.size();
   }
 
+  // Returns the buffer for the next read-ahead which follows the buffers of
+  // the read-aheads in flight.
+  inline Buffer* readAheadBuffer() const {
+    return buffers_[(bufferIndex_ + 1 + readAheadWaits_.size()) %
+                    buffers_.size()]
+        .get();
+  }
+
   // Advances buffer index to point to the next buffer for read.
   inline void advanceBuffer() {
     bufferIndex_ = nextBufferIndex();
@@ -102,10 +112,6 @@ class FileInputStream : public ByteInputStream {
     return buffers_[bufferIndex()].get();
   }
 
-  inline Buffer* nextBuffer() const {
-    return buffers_[nextBufferIndex()].get();
-  }
-
   void updateStats(uint64_t readBytes, uint64_t readTimeNs);
 
   const std::unique_ptr<ReadFile> file_;
@@ -116,12 +122,13 @@ class FileInputStream : public ByteInputStream {
 
   // Offset of the next byte to read from file.
   uint64_t fileOffset_ = 0;
+  // Offset of the next byte to read ahead from file.
+  uint64_t readAheadOffset_ = 0;
 
   std::vector<BufferPtr> buffers_;
   uint32_t bufferIndex_{0};
-  // Sets to read-ahead future if valid.
-  folly::SemiFuture<uint64_t> readAheadWait_{
-      folly::SemiFuture<uint64_t>::makeEmpty()};
+  // The read-ahead futures in file offset order.
+  std::deque<folly::SemiFuture<uint64_t>> readAheadWaits_;
 
   ByteRange range_;
 
@@ -93,7 +93,8 @@ class LocalFileSystem : public FileSystem {
                               std::thread::hardware_concurrency() / 2)),
                       std::make_shared<folly::NamedThreadFactory>(
                           "LocalReadahead"))
-                : nullptr) {}
+                : nullptr),
+        mmapEnabled_(options.mmapEnabled) {}
 
   ~LocalFileSystem() override {
     if (executor_) {
@@ -117,7 +118,7 @@ class LocalFileSystem : public FileSystem {
       std::string_view path,
       const FileOptions& options) override {
     return std::make_unique<LocalReadFile>(
-        extractPath(path), executor_.get(), options.bufferIo);
+        extractPath(path), executor_.get(), options.bufferIo, mmapEnabled_);
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(
@@ -251,6 +252,7 @@ class LocalFileSystem : public FileSystem {
 
  private:
   const std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  const bool mmapEnabled_;
 };
 } // namespace
 
@@ -104,6 +104,11 @@ struct FileSystemOptions {
   /// async read by using a background cpu executor. Some filesystem might has
   /// native async read-ahead support.
   bool readAheadEnabled{false};
+
+  /// If true, the local file system maps files opened for buffered reads into
+  /// memory. Readers can then use the bytes of locally attached files without
+  /// copying them. See LocalReadFile.
+  bool mmapEnabled{false};
 };
 
 /// Free form statistics for a file system. The keys are arbitrary strings, and
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUringReader.h"
+
+#include <fmt/format.h>
+#include <folly/String.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <sys/uio.h>
+#include <climits>
+
+#include "velox/common/base/Exceptions.h"
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+DECLARE_int32(velox_io_uring_queue_depth);
+
+namespace facebook::velox {
+namespace {
+// The kernel limit for the size of one registered buffer.
+constexpr uint64_t kMaxRegisteredBufferBytes = 1UL << 30;
+} // namespace
+
+struct IoUringReader::PendingRead {
+  // A contiguous range of a Read that is submitted as one request.
+  struct Part {
+    PendingRead* read;
+    uint64_t offset;
+    uint64_t bytes;
+    int32_t firstIovec;
+    int32_t numIovecs;
+  };
+
+  int32_t fd;
+  folly::Promise<uint64_t> promise;
+  // Sum of the sizes of the buffers of the Read, including skipped ones.
+  uint64_t totalBytes{0};
+  // Bytes that short reads, e.g. at end of file, did not return.
+  uint64_t missingBytes{0};
+  std::vector<iovec> iovecs;
+  std::vector<Part> parts;
+  // Number of 'parts' that have not completed. Accessed by the poller only
+  // after submission.
+  int32_t numPending{0};
+  // The first error of a part, if any.
+  std::string error;
+};
+
+// static
+IoUringReader* IoUringReader::instance() {
+  static IoUringReader* reader = []() -> IoUringReader* {
+#ifdef VELOX_ENABLE_IO_URING
+    if (FLAGS_velox_io_uring_queue_depth <= 0) {
+      return nullptr;
+    }
+    try {
+      return new IoUringReader(FLAGS_velox_io_uring_queue_depth);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "io_uring is not available, local files are read "
+                   << "synchronously: " << e.what();
+    }
+#endif
+    return nullptr;
+  }();
+  return reader;
+}
+
+int32_t IoUringReader::registeredBufferIndex(folly::Range<char*> range) const {
+  for (auto i = 0; i < registeredBuffers_.size(); ++i) {
+    const auto& buffer = registeredBuffers_[i];
+    if (range.begin() >= buffer.begin() && range.end() <= buffer.end()) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+#ifdef VELOX_ENABLE_IO_URING
+
+struct IoUringReader::Ring {
+  io_uring ring;
+};
+
+namespace {
+void submitToKernel(io_uring* ring) {
+  int ret;
+  do {
+    ret = io_uring_submit(ring);
+  } while (ret == -EINTR || ret == -EAGAIN || ret == -EBUSY);
+  VELOX_CHECK_GE(ret, 0, "io_uring_submit failed: {}", folly::errnoStr(-ret));
+}
+
+io_uring_sqe* nextSqe(io_uring* ring) {
+  auto* sqe = io_uring_get_sqe(ring);
+  if (sqe == nullptr) {
+    // The submission queue is full. Hands the queued entries to the kernel.
+    submitToKernel(ring);
+    sqe = io_uring_get_sqe(ring);
+  }
+  VELOX_CHECK_NOT_NULL(sqe, "No io_uring submission queue entry");
+  return sqe;
+}
+} // namespace
+
+IoUringReader::IoUringReader(int32_t queueDepth)
+    : ring_(std::make_unique<Ring>()) {
+  VELOX_CHECK_GT(queueDepth, 0);
+  const int ret = io_uring_queue_init(queueDepth, &ring_->ring, 0);
+  VELOX_CHECK_GE(
+      ret, 0, "io_uring_queue_init failed: {}", folly::errnoStr(-ret));
+  poller_ = std::thread([this]() { pollCompletions(); });
+}
+
+IoUringReader::~IoUringReader() {
+  {
+    // A completion without a part stops the poller.
+    std::lock_guard<std::mutex> l(submitMutex_);
+    auto* sqe = nextSqe(&ring_->ring);
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    submitToKernel(&ring_->ring);
+  }
+  poller_.join();
+  io_uring_queue_exit(&ring_->ring);
+}
+
+std::vector<folly::SemiFuture<uint64_t>> IoUringReader::submit(
+    const std::vector<Read>& reads) {
+  std::vector<folly::SemiFuture<uint64_t>> futures;
+  futures.reserve(reads.size());
+  std::vector<PendingRead*> pendingReads;
+  for (const auto& read : reads) {
+    auto pending = std::make_unique<PendingRead>();
+    pending->fd = read.fd;
+    futures.push_back(pending->promise.getSemiFuture());
+    uint64_t offset = read.offset;
+    for (const auto& buffer : read.buffers) {
+      pending->totalBytes += buffer.size();
+      if (buffer.data() == nullptr) {
+        offset += buffer.size();
+        continue;
+      }
+      const auto* lastPart =
+          pending->parts.empty() ? nullptr : &pending->parts.back();
+      // Starts a new part after a gap or when the part has the max iovecs.
+      if (lastPart == nullptr || lastPart->offset + lastPart->bytes != offset ||
+          lastPart->numIovecs == IOV_MAX) {
+        pending->parts.push_back(
+            {pending.get(),
+             offset,
+             0,
+             static_cast<int32_t>(pending->iovecs.size()),
+             0});
+      }
+      pending->iovecs.push_back({buffer.data(), buffer.size()});
+      auto& part = pending->parts.back();
+      ++part.numIovecs;
+      part.bytes += buffer.size();
+      offset += buffer.size();
+    }
+    if (pending->parts.empty()) {
+      pending->promise.setValue(pending->totalBytes);
+      continue;
+    }
+    pending->numPending = pending->parts.size();
+    pendingReads.push_back(pending.release());
+  }
+  if (pendingReads.empty()) {
+    return futures;
+  }
+
+  std::lock_guard<std::mutex> l(submitMutex_);
+  for (auto* pending : pendingReads) {
+    for (auto& part : pending->parts) {
+      auto* sqe = nextSqe(&ring_->ring);
+      auto& iovec = pending->iovecs[part.firstIovec];
+      const auto bufferIndex = part.numIovecs == 1
+          ? registeredBufferIndex(folly::Range<char*>(
+                static_cast<char*>(iovec.iov_base), iovec.iov_len))
+          : -1;
+      if (bufferIndex >= 0) {
+        io_uring_prep_read_fixed(
+            sqe,
+            pending->fd,
+            iovec.iov_base,
+            iovec.iov_len,
+            part.offset,
+            bufferIndex);
+        ++numFixedBufferReads_;
+      } else {
+        io_uring_prep_readv(
+            sqe, pending->fd, &iovec, part.numIovecs, part.offset);
+      }
+      io_uring_sqe_set_data(sqe, &part);
+      ++numSubmitted_;
+    }
+  }
+  submitToKernel(&ring_->ring);
+  return futures;
+}
+
+bool IoUringReader::registerBuffers(
+    const std::vector<folly::Range<char*>>& ranges) {
+  std::lock_guard<std::mutex> l(submitMutex_);
+  VELOX_CHECK(registeredBuffers_.empty(), "Buffers are already registered");
+  std::vector<folly::Range<char*>> buffers;
+  std::vector<iovec> iovecs;
+  for (auto range : ranges) {
+    while (!range.empty()) {
+      const auto size =
+          std::min<uint64_t>(range.size(), kMaxRegisteredBufferBytes);
+      buffers.push_back(range.subpiece(0, size));
+      iovecs.push_back({range.data(), size});
+      range.advance(size);
+    }
+  }
+  const int ret =
+      io_uring_register_buffers(&ring_->ring, iovecs.data(), iovecs.size());
+  if (ret < 0) {
+    LOG(WARNING) << "io_uring_register_buffers failed: "
+                 << folly::errnoStr(-ret);
+    return false;
+  }
+  registeredBuffers_ = std::move(buffers);
+  return true;
+}
+
+void IoUringReader::pollCompletions() {
+  for (;;) {
+    io_uring_cqe* cqe = nullptr;
+    const int ret = io_uring_wait_cqe(&ring_->ring, &cqe);
+    if (ret < 0) {
+      if (ret != -EINTR) {
+        LOG(ERROR) << "io_uring_wait_cqe failed: " << folly::errnoStr(-ret);
+      }
+      continue;
+    }
+    auto* part = static_cast<PendingRead::Part*>(io_uring_cqe_get_data(cqe));
+    const int32_t result = cqe->res;
+    io_uring_cqe_seen(&ring_->ring, cqe);
+    if (part == nullptr) {
+      return;
+    }
+
+    auto* read = part->read;
+    if (result < 0) {
+      if (read->error.empty()) {
+        read->error = fmt::format(
+            "io_uring read of {} bytes at {} failed: {}",
+            part->bytes,
+            part->offset,
+            folly::errnoStr(-result));
+      }
+    } else {
+      read->missingBytes += part->bytes - result;
+    }
+    if (--read->numPending > 0) {
+      continue;
+    }
+    if (read->error.empty()) {
+      read->promise.setValue(read->totalBytes - read->missingBytes);
+    } else {
+      try {
+        VELOX_FAIL("{}", read->error);
+      } catch (const std::exception&) {
+        read->promise.setException(
+            folly::exception_wrapper(std::current_exception()));
+      }
+    }
+    delete read;
+  }
+}
+
+#else
+
+struct IoUringReader::Ring {};
+
+IoUringReader::IoUringReader(int32_t /*queueDepth*/) {
+  VELOX_UNSUPPORTED("Velox is built without io_uring support");
+}
+
+IoUringReader::~IoUringReader() = default;
+
+std::vector<folly::SemiFuture<uint64_t>> IoUringReader::submit(
+    const std::vector<Read>& /*reads*/) {
+  VELOX_UNSUPPORTED("Velox is built without io_uring support");
+}
+
+bool IoUringReader::registerBuffers(
+    const std::vector<folly::Range<char*>>& /*ranges*/) {
+  return false;
+}
+
+void IoUringReader::pollCompletions() {}
+
+#endif
+
+} // namespace facebook::velox
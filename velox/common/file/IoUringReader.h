@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace facebook::velox {
+
+/// Reads local files with io_uring. The reads passed to one submit() call are
+/// submitted to the kernel with one system call and are completed by a
+/// poller thread, so that outstanding reads do not each hold a thread. Memory
+/// ranges registered with registerBuffers() are read into without the kernel
+/// mapping the pages per read. Requires building with VELOX_ENABLE_IO_URING.
+class IoUringReader {
+ public:
+  /// A read of consecutive 'buffers' from 'fd' starting at 'offset'. A buffer
+  /// with nullptr data skips its size worth of bytes.
+  struct Read {
+    int32_t fd;
+    uint64_t offset;
+    std::vector<folly::Range<char*>> buffers;
+  };
+
+  /// Returns the process wide reader, or nullptr if Velox is built without
+  /// io_uring, if the kernel does not support it or if
+  /// 'velox_io_uring_queue_depth' is 0.
+  static IoUringReader* instance();
+
+  /// Creates a ring with 'queueDepth' submission entries. Throws if io_uring
+  /// is not available.
+  explicit IoUringReader(int32_t queueDepth);
+
+  ~IoUringReader();
+
+  /// Submits 'reads' and returns a future per read that is realized with the
+  /// number of bytes read, including the skipped ones, or with an error. Like
+  /// preadv(), a short read, e.g. at end of file, returns fewer bytes.
+  std::vector<folly::SemiFuture<uint64_t>> submit(
+      const std::vector<Read>& reads);
+
+  /// Registers 'ranges' as fixed buffers of the ring. Reads into a single
+  /// buffer within a registered range use the pre-mapped pages. Registration
+  /// pins the memory, so this is meant for a dedicated memory region like the
+  /// size classes of MmapAllocator. Can be called once. Returns false if the
+  /// kernel rejects the registration, in which case reads use regular
+  /// buffers.
+  bool registerBuffers(const std::vector<folly::Range<char*>>& ranges);
+
+  /// Returns the number of reads submitted to the kernel, counting each
+  /// contiguous part of a Read separately.
+  uint64_t numSubmitted() const {
+    return numSubmitted_;
+  }
+
+  /// Returns the number of submitted reads that used a registered buffer.
+  uint64_t numFixedBufferReads() const {
+    return numFixedBufferReads_;
+  }
+
+ private:
+  struct Ring;
+  struct PendingRead;
+
+  // Returns the index of the registered buffer that contains 'range' or -1.
+  int32_t registeredBufferIndex(folly::Range<char*> range) const;
+
+  void pollCompletions();
+
+  std::unique_ptr<Ring> ring_;
+  // Serializes the submissions to the ring's submission queue.
+  std::mutex submitMutex_;
+  // Registered buffers, in registration order.
+  std::vector<folly::Range<char*>> registeredBuffers_;
+  std::thread poller_;
+  std::atomic<uint64_t> numSubmitted_{0};
+  std::atomic<uint64_t> numFixedBufferReads_{0};
+};
+
+} // namespace facebook::velox
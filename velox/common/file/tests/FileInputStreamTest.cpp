@@ -18,9 +18,11 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/file/FileInputStream.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/tests/FaultyFile.h"
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
@@ -51,7 +53,9 @@ class FileInputStreamTest : public testing::Test {
 
   std::unique_ptr<common::FileInputStream> createStream(
       uint64_t streamSize,
-      uint32_t bufferSize = 1024) {
+      uint32_t bufferSize = 1024,
+      folly::Executor* readExecutor = nullptr,
+      uint32_t numReadAheadBuffers = 1) {
     const auto filePath =
         fmt::format("{}/{}", tempDirPath_->getPath(), fileId_++);
     auto writeFile = fs_->openFileForWrite(filePath);
@@ -62,8 +66,13 @@ class FileInputStreamTest : public testing::Test {
     writeFile->append(
         std::string_view(reinterpret_cast<char*>(buffer), streamSize));
     writeFile->close();
+    std::unique_ptr<ReadFile> readFile = fs_->openFileForRead(filePath);
+    if (readExecutor != nullptr) {
+      readFile = std::make_unique<tests::utils::FaultyReadFile>(
+          filePath, std::move(readFile), nullptr, readExecutor);
+    }
     return std::make_unique<common::FileInputStream>(
-        fs_->openFileForRead(filePath), bufferSize, pool_.get());
+        std::move(readFile), bufferSize, pool_.get(), numReadAheadBuffers);
   }
 
   folly::Random::DefaultGenerator rng_;
@@ -112,3 +121,31 @@ TEST_F(FileInputStreamTest, stats) {
     ASSERT_GT(byteStream->stats().readTimeNs, 0);
   }
 }
+
+TEST_F(FileInputStreamTest, readAhead) {
+  folly::CPUThreadPoolExecutor executor(4);
+  constexpr size_t kStreamSize = 4096;
+  constexpr size_t kBufferSize = 512;
+  for (const uint32_t numReadAheadBuffers : {0, 1, 3, 100}) {
+    SCOPED_TRACE(fmt::format("numReadAheadBuffers {}", numReadAheadBuffers));
+    const auto usedBytes = pool_->usedBytes();
+    auto byteStream =
+        createStream(kStreamSize, kBufferSize, &executor, numReadAheadBuffers);
+    // No more buffers than the file needs.
+    const auto numBuffers = 1 +
+        std::min<uint32_t>(numReadAheadBuffers, kStreamSize / kBufferSize - 1);
+    ASSERT_GE(pool_->usedBytes() - usedBytes, numBuffers * kBufferSize);
+    ASSERT_LT(pool_->usedBytes() - usedBytes, 2 * numBuffers * kBufferSize);
+
+    uint8_t buffer[kStreamSize / 16];
+    for (int offset = 0; offset < kStreamSize;) {
+      byteStream->readBytes(buffer, sizeof(buffer));
+      for (int i = 0; i < sizeof(buffer); ++i, ++offset) {
+        ASSERT_EQ(buffer[i], offset % 256);
+      }
+    }
+    ASSERT_TRUE(byteStream->atEnd());
+    ASSERT_EQ(byteStream->stats().numReads, kStreamSize / kBufferSize);
+    ASSERT_EQ(byteStream->stats().readBytes, kStreamSize);
+  }
+}
@@ -20,6 +20,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUringReader.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
@@ -233,6 +234,123 @@ TEST_P(LocalFileTest, writeAndRead) {
   }
 }
 
+TEST_P(LocalFileTest, preadvBatchAsync) {
+  auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
+  const auto& filename = tempFile->getPath();
+  auto fs = filesystems::getFileSystem(filename, {});
+  fs->remove(filename);
+  {
+    auto writeFile = fs->openFileForWrite(filename);
+    writeData(writeFile.get());
+    writeFile->close();
+  }
+  auto readFile = fs->openFileForRead(filename);
+  char head[12];
+  char middle[4];
+  char tail[7];
+  const uint64_t middleOffset = 500'000;
+  const uint64_t tailOffset = 15 + kOneMB - sizeof(tail);
+  std::vector<ReadFile::AsyncRead> reads = {
+      {0, {folly::Range<char*>(head, sizeof(head))}},
+      {middleOffset - 100,
+       {folly::Range<char*>(nullptr, reinterpret_cast<char*>(100)),
+        folly::Range<char*>(middle, sizeof(middle))}},
+      {tailOffset, {folly::Range<char*>(tail, sizeof(tail))}}};
+  auto futures = readFile->preadvBatchAsync(reads);
+  ASSERT_EQ(futures.size(), 3);
+  ASSERT_EQ(std::move(futures[0]).get(), sizeof(head));
+  ASSERT_EQ(std::move(futures[1]).get(), 100 + sizeof(middle));
+  ASSERT_EQ(std::move(futures[2]).get(), sizeof(tail));
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+}
+
+TEST_P(LocalFileTest, mmap) {
+  if (useFaultyFs_) {
+    return;
+  }
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  auto fs = filesystems::getFileSystem(filename, {});
+  fs->remove(filename);
+  {
+    auto writeFile = fs->openFileForWrite(filename);
+    writeData(writeFile.get());
+    writeFile->close();
+  }
+  LocalReadFile readFile(filename, nullptr, true, /*useMmap=*/true);
+  ASSERT_FALSE(readFile.hasPreadvAsync());
+  readData(&readFile, true, true);
+  ASSERT_EQ(readFile.mappedRange(0, 10), "aaaaabbbbb");
+  ASSERT_EQ(readFile.mappedRange(10 + kOneMB, 5), "ddddd");
+  // The view points into the mapping, not into a copy.
+  ASSERT_EQ(
+      readFile.mappedRange(5, 1).data() + 1, readFile.mappedRange(6, 1).data());
+  VELOX_ASSERT_THROW(
+      readFile.mappedRange(10 + kOneMB, 10), "Range out of bounds");
+
+  // Files opened without the option are not mapped.
+  LocalReadFile unmapped(filename);
+  ASSERT_TRUE(unmapped.mappedRange(0, 10).empty());
+}
+
+TEST(IoUringReaderTest, read) {
+  if (IoUringReader::instance() == nullptr) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  {
+    LocalWriteFile writeFile(filename, false, false);
+    writeData(&writeFile);
+    writeFile.close();
+  }
+  const int32_t fd = open(filename.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  IoUringReader reader(8);
+  std::vector<char> buffer(kOneMB);
+  ASSERT_TRUE(reader.registerBuffers(
+      {folly::Range<char*>(buffer.data(), buffer.size())}));
+
+  // The first read has 2 parts separated by a gap, the second reads into the
+  // registered buffer and the third is short at the end of the file. More
+  // reads than the queue depth are submitted in one call.
+  char head[5];
+  char tail[10];
+  std::vector<IoUringReader::Read> reads = {
+      {fd,
+       0,
+       {folly::Range<char*>(head, sizeof(head)),
+        folly::Range<char*>(nullptr, reinterpret_cast<char*>(5)),
+        folly::Range<char*>(buffer.data() + 100, 5)}},
+      {fd, 10, {folly::Range<char*>(buffer.data(), 100)}},
+      {fd, 10 + kOneMB, {folly::Range<char*>(tail, sizeof(tail))}}};
+  for (auto i = 0; i < 10; ++i) {
+    reads.push_back({fd, 0, {folly::Range<char*>(buffer.data() + 200, 10)}});
+  }
+  auto futures = reader.submit(reads);
+  ASSERT_EQ(futures.size(), reads.size());
+  ASSERT_EQ(std::move(futures[0]).get(), 15);
+  ASSERT_EQ(std::move(futures[1]).get(), 100);
+  ASSERT_EQ(std::move(futures[2]).get(), 5);
+  for (auto i = 3; i < futures.size(); ++i) {
+    ASSERT_EQ(std::move(futures[i]).get(), 10);
+  }
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaa");
+  ASSERT_EQ(std::string_view(buffer.data() + 100, 5), "ccccc");
+  ASSERT_EQ(std::string_view(buffer.data(), 10), "cccccccccc");
+  ASSERT_EQ(std::string_view(tail, 5), "ddddd");
+  ASSERT_EQ(std::string_view(buffer.data() + 200, 10), "aaaaabbbbb");
+  ASSERT_EQ(reader.numSubmitted(), 14);
+  ASSERT_EQ(reader.numFixedBufferReads(), 12);
+
+  reads = {{-1, 0, {folly::Range<char*>(head, sizeof(head))}}};
+  VELOX_ASSERT_THROW(
+      std::move(reader.submit(reads)[0]).get(), "io_uring read of 5 bytes");
+  close(fd);
+}
+
 TEST_P(LocalFileTest, viaRegistry) {
   auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
   const auto& filename = tempFile->getPath();
@@ -15,6 +15,7 @@
  */
 #include "velox/common/hyperloglog/DenseHll.h"
 
+#include <algorithm>
 #include <exception>
 #include <sstream>
 #include "velox/common/base/IOUtils.h"
@@ -143,6 +144,30 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(const uint64_t* hashes, int32_t numHashes) {
+  constexpr int32_t kBatchSize = 64;
+  int32_t indices[kBatchSize];
+  int8_t values[kBatchSize];
+  for (auto start = 0; start < numHashes; start += kBatchSize) {
+    const auto batchSize = std::min(kBatchSize, numHashes - start);
+    // No dependency between iterations, so these loops vectorize.
+    for (auto i = 0; i < batchSize; ++i) {
+      indices[i] = computeIndex(hashes[start + i], indexBitLength_);
+    }
+    for (auto i = 0; i < batchSize; ++i) {
+      values[i] = numberOfLeadingZeros(hashes[start + i], indexBitLength_) + 1;
+    }
+    for (auto i = 0; i < batchSize; ++i) {
+      // A value not above the baseline never changes a bucket. Most values
+      // are skipped this way once the cardinality is a few times the number
+      // of buckets. 'baseline_' may change inside the loop.
+      if (values[i] > baseline_) {
+        insert(indices[i], values[i]);
+      }
+    }
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
@@ -43,6 +43,10 @@ class DenseHllBenchmark {
       serializedHlls_[hashBits].push_back(makeSerializedHll(hashBits, 1));
       serializedHlls_[hashBits].push_back(makeSerializedHll(hashBits, 2));
     }
+    hashes_.resize(1'000'000);
+    for (int32_t i = 0; i < hashes_.size(); ++i) {
+      hashes_[i] = hashOne(i);
+    }
   }
 
   void run(int hashBits) {
@@ -58,6 +62,24 @@ class DenseHllBenchmark {
     }
   }
 
+  // Inserts 1M hashes one at a time or in batches.
+  void runInsert(int hashBits, bool batch) {
+    folly::BenchmarkSuspender suspender;
+
+    HashStringAllocator allocator(pool_);
+    common::hll::DenseHll hll(hashBits, &allocator);
+
+    suspender.dismiss();
+
+    if (batch) {
+      hll.insertHashes(hashes_.data(), hashes_.size());
+    } else {
+      for (auto hash : hashes_) {
+        hll.insertHash(hash);
+      }
+    }
+  }
+
  private:
   std::string makeSerializedHll(int hashBits, int32_t step) {
     HashStringAllocator allocator(pool_);
@@ -82,6 +104,8 @@ class DenseHllBenchmark {
   // List of serialized HLLs to use for merging, keyed by the number of hash
   // bits.
   std::unordered_map<int, std::vector<std::string>> serializedHlls_;
+
+  std::vector<uint64_t> hashes_;
 };
 
 } // namespace
@@ -100,6 +124,24 @@ BENCHMARK(mergeSerialized16) {
   benchmark->run(16);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(insertHash11) {
+  benchmark->runInsert(11, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes11) {
+  benchmark->runInsert(11, true);
+}
+
+BENCHMARK(insertHash16) {
+  benchmark->runInsert(16, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes16) {
+  benchmark->runInsert(16, true);
+}
+
 int main(int argc, char** argv) {
   folly::Init init(&argc, &argv);
 
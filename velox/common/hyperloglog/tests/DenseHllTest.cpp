@@ -225,6 +225,31 @@ TEST_P(DenseHllTest, mergeWith) {
   testMergeWith(indexBitLength, sequence(0, 2'000'000), sequence(0, 2'000'000));
 }
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  // Sizes that are not multiples of the batch size and a large one that
+  // raises the baseline.
+  for (auto numHashes : {0, 1, 63, 64, 65, 1'000, 1'000'000}) {
+    SCOPED_TRACE(numHashes);
+    std::vector<uint64_t> hashes(numHashes);
+    for (auto i = 0; i < numHashes; i++) {
+      hashes[i] = hashOne(i);
+    }
+
+    DenseHll expected{indexBitLength, &allocator_};
+    for (auto hash : hashes) {
+      expected.insertHash(hash);
+    }
+
+    DenseHll denseHll{indexBitLength, &allocator_};
+    denseHll.insertHashes(hashes.data(), hashes.size());
+
+    ASSERT_EQ(expected.cardinality(), denseHll.cardinality());
+    ASSERT_EQ(serialize(expected), serialize(denseHll));
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     DenseHllTest,
     DenseHllTest,
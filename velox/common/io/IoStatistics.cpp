@@ -22,6 +22,24 @@
 
 namespace facebook::velox::io {
 
+// static
+int32_t IoLatencyHistogram::bucket(uint64_t latencyUs) {
+  int32_t bucket = 0;
+  for (uint64_t bound = 100; bucket < kNumBuckets - 1 && latencyUs >= bound;
+       bound *= 10) {
+    ++bucket;
+  }
+  return bucket;
+}
+
+// static
+const std::string& IoLatencyHistogram::bucketName(int32_t bucket) {
+  static const std::array<std::string, kNumBuckets> kNames{
+      "100us", "1ms", "10ms", "100ms", "1s", ">1s"};
+  DCHECK_LT(bucket, kNumBuckets);
+  return kNames[bucket];
+}
+
 uint64_t IoStatistics::rawBytesRead() const {
   return rawBytesRead_.load(std::memory_order_relaxed);
 }
@@ -119,6 +137,10 @@ void IoStatistics::merge(const IoStatistics& other) {
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  prefetchHit_.merge(other.prefetchHit_);
+  prefetchMissWait_.merge(other.prefetchMissWait_);
+  storageReadLatency_.merge(other.storageReadLatency_);
+  ssdReadLatency_.merge(other.ssdReadLatency_);
   {
     const auto& otherOperationStats = other.operationStats();
     std::lock_guard<std::mutex> l(operationStatsMutex_);
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -89,6 +90,36 @@ class IoCounter {
   std::atomic<uint64_t> max_{0};
 };
 
+/// Counts IO latencies in power-of-ten buckets. Bucket 'i' holds the
+/// latencies of less than 100 * 10^i microseconds. The last bucket holds all
+/// the longer ones.
+class IoLatencyHistogram {
+ public:
+  static constexpr int32_t kNumBuckets = 6;
+
+  static int32_t bucket(uint64_t latencyUs);
+
+  /// Returns the upper bound of 'bucket', e.g. "100us", "10ms" or ">1s".
+  static const std::string& bucketName(int32_t bucket);
+
+  void record(uint64_t latencyUs) {
+    counts_[bucket(latencyUs)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint64_t count(int32_t bucket) const {
+    return counts_[bucket].load(std::memory_order_relaxed);
+  }
+
+  void merge(const IoLatencyHistogram& other) {
+    for (auto i = 0; i < kNumBuckets; ++i) {
+      counts_[i] += other.count(i);
+    }
+  }
+
+ private:
+  std::array<std::atomic<uint64_t>, kNumBuckets> counts_{};
+};
+
 class IoStatistics {
  public:
   uint64_t rawBytesRead() const;
@@ -127,6 +158,22 @@ class IoStatistics {
     return queryThreadIoLatency_;
   }
 
+  IoCounter& prefetchHit() {
+    return prefetchHit_;
+  }
+
+  IoCounter& prefetchMissWait() {
+    return prefetchMissWait_;
+  }
+
+  IoLatencyHistogram& storageReadLatency() {
+    return storageReadLatency_;
+  }
+
+  IoLatencyHistogram& ssdReadLatency() {
+    return ssdReadLatency_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -171,6 +218,20 @@ class IoStatistics {
   // or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // Planned loads that were complete when a query processing thread first
+  // needed their data. Sums the bytes of the loads.
+  IoCounter prefetchHit_;
+
+  // Planned loads that were still in progress or not started when a query
+  // processing thread first needed their data. Sums the microseconds the
+  // thread waited for them.
+  IoCounter prefetchMissWait_;
+
+  // Latencies of the individual reads from storage and from SSD cache,
+  // whether issued by a query processing thread or by read-ahead.
+  IoLatencyHistogram storageReadLatency_;
+  IoLatencyHistogram ssdReadLatency_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
@@ -62,6 +62,7 @@ class ReaderOptions {
   static constexpr int32_t kDefaultCoalesceDistance = 512 << 10; // 512K
   static constexpr int32_t kDefaultCoalesceBytes = 128 << 20; // 128M
   static constexpr int32_t kDefaultPrefetchRowGroups = 1;
+  static constexpr int64_t kDefaultMaxPrefetchBytes = 256 << 20; // 256M
 
   explicit ReaderOptions(velox::memory::MemoryPool* pool)
       : memoryPool_(pool),
@@ -104,12 +105,27 @@ class ReaderOptions {
     return *this;
   }
 
+  /// If true, the coalesce distance is tuned to the measured request latency
+  /// and throughput of the file system instead of using
+  /// maxCoalesceDistance().
+  ReaderOptions& setAdaptiveCoalescing(bool adaptive) {
+    adaptiveCoalescing_ = adaptive;
+    return *this;
+  }
+
   /// Modifies the number of row groups to prefetch.
   ReaderOptions& setPrefetchRowGroups(int32_t numPrefetch) {
     prefetchRowGroups_ = numPrefetch;
     return *this;
   }
 
+  /// Modifies the maximum bytes of prefetched stripes that may be loading or
+  /// loaded ahead of the stripe being read.
+  ReaderOptions& setMaxPrefetchBytes(int64_t bytes) {
+    maxPrefetchBytes_ = bytes;
+    return *this;
+  }
+
   /// Gets the memory allocator.
   velox::memory::MemoryPool& memoryPool() const {
     return *memoryPool_;
@@ -135,10 +151,18 @@ class ReaderOptions {
     return maxCoalesceBytes_;
   }
 
+  bool adaptiveCoalescing() const {
+    return adaptiveCoalescing_;
+  }
+
   int64_t prefetchRowGroups() const {
     return prefetchRowGroups_;
   }
 
+  int64_t maxPrefetchBytes() const {
+    return maxPrefetchBytes_;
+  }
+
   bool noCacheRetention() const {
     return noCacheRetention_;
   }
@@ -154,7 +178,9 @@ class ReaderOptions {
   int32_t loadQuantum_{kDefaultLoadQuantum};
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
+  bool adaptiveCoalescing_{false};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
+  int64_t maxPrefetchBytes_{kDefaultMaxPrefetchBytes};
   bool noCacheRetention_{false};
 };
 } // namespace facebook::velox::io
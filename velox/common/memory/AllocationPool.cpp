@@ -48,6 +48,17 @@ void AllocationPool::clear() {
   usedBytes_ = 0;
 }
 
+void AllocationPool::swap(AllocationPool& other) {
+  VELOX_CHECK_EQ(pool_, other.pool_);
+  std::swap(allocations_, other.allocations_);
+  std::swap(largeAllocations_, other.largeAllocations_);
+  std::swap(startOfRun_, other.startOfRun_);
+  std::swap(bytesInRun_, other.bytesInRun_);
+  std::swap(currentOffset_, other.currentOffset_);
+  std::swap(usedBytes_, other.usedBytes_);
+  std::swap(hugePageThreshold_, other.hugePageThreshold_);
+}
+
 char* AllocationPool::allocateFixed(uint64_t bytes, int32_t alignment) {
   VELOX_CHECK_GT(bytes, 0, "Cannot allocate zero bytes");
   if (freeAddressableBytes() >= bytes && alignment == 1) {
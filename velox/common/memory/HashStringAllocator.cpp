@@ -144,6 +144,59 @@ void HashStringAllocator::clear() {
   state_.sizeFromPool() = 0;
 }
 
+int64_t HashStringAllocator::compact(
+    const std::function<void(const RelocateFunc&)>& relocateAll) {
+  VELOX_CHECK_NULL(
+      state_.currentHeader(),
+      "Do not call compact() when a write is in progress");
+  const auto retainedSizeBefore = retainedSize();
+
+  // The old slabs stay mapped until the end of this function so that the
+  // owners can translate positions after relocating.
+  memory::AllocationPool oldSlabs(pool());
+  oldSlabs.swap(state_.pool());
+  state_.pool().setHugePageThreshold(oldSlabs.hugePageThreshold());
+
+  state_.numFree() = 0;
+  state_.freeBytes() = 0;
+  std::fill(
+      std::begin(state_.freeNonEmpty()), std::end(state_.freeNonEmpty()), 0);
+  for (auto i = 0; i < kNumFreeLists; ++i) {
+    new (&state_.freeLists()[i]) CompactDoubleList();
+  }
+  // Only the blocks from 'allocationsFromPool' survive the swap.
+  state_.currentBytes() = state_.sizeFromPool();
+
+  std::vector<Header*> oldBlocksFromPool;
+  const auto isFromPool = [&](Header* header) {
+    return state_.allocationsFromPool().find(header) !=
+        state_.allocationsFromPool().end();
+  };
+  relocateAll([&](Header* header) -> Header* {
+    VELOX_CHECK_NOT_NULL(header);
+    VELOX_CHECK(!header->isFree());
+    if (!header->isContinued() && isFromPool(header)) {
+      return header;
+    }
+    InputStream stream(header);
+    const int32_t size = stream.size();
+    auto* newHeader = allocate(std::max(size, kMinAlloc), true);
+    stream.readBytes(reinterpret_cast<uint8_t*>(newHeader->begin()), size);
+    for (auto* part = header; part != nullptr;
+         part = part->isContinued() ? part->nextContinued() : nullptr) {
+      if (isFromPool(part)) {
+        oldBlocksFromPool.push_back(part);
+      }
+    }
+    return newHeader;
+  });
+
+  for (auto* block : oldBlocksFromPool) {
+    freeToPool(block, blockBytes(block));
+  }
+  return retainedSizeBefore - retainedSize();
+}
+
 void* HashStringAllocator::allocateFromPool(size_t size) {
   auto* ptr = pool()->allocate(size);
   state_.currentBytes() += size;
@@ -24,6 +24,7 @@
 #include "velox/type/StringView.h"
 
 #include <folly/container/F14Map.h>
+#include <functional>
 
 namespace facebook::velox {
 
@@ -313,6 +314,24 @@ class HashStringAllocator : public StreamArena {
   /// Frees all memory associated with 'this' and leaves 'this' ready for reuse.
   void clear() override;
 
+  /// Moves the allocation of 'header' and its continuations to new memory and
+  /// returns the new header. Used with compact().
+  using RelocateFunc = std::function<Header*(Header*)>;
+
+  /// Copies the live allocations into new slabs and releases the old ones,
+  /// so that the space of freed blocks scattered between live ones goes back
+  /// to the memory pool. 'relocateAll' is called once with a function that
+  /// relocates a single allocation and must call it exactly once for each
+  /// live allocation made with allocate() or newWrite(), replacing the
+  /// pointers it holds with the returned Header. Positions inside an
+  /// allocation are translated with offset() on the old header followed by
+  /// seek() on the new one, since the old memory stays readable until
+  /// compact() returns. Multipart allocations become contiguous where
+  /// possible. Allocations that are not relocated are lost. Allocations made
+  /// by allocateFromPool() are not moved. Returns the number of bytes by
+  /// which retainedSize() shrank.
+  int64_t compact(const std::function<void(const RelocateFunc&)>& relocateAll);
+
   memory::MemoryPool* pool() const {
     return state_.pool().pool();
   }
@@ -84,6 +84,16 @@ struct MemoryManagerOptions {
   /// Disables the memory manager's tracking on memory pools.
   bool disableMemoryPoolTracking{false};
 
+  /// The size of the cache of freed small allocations kept by each leaf pool
+  /// of a root pool created by addRootPool(). 0 disables the cache. See
+  /// MemoryPool::Options::allocationCacheBytes.
+  uint64_t allocationCacheBytes{0};
+
+  /// If not zero, the leaf pools of a root pool created by addRootPool()
+  /// sample one in this many allocations for the allocation profile. See
+  /// MemoryPool::Options::allocationProfileSampleRate.
+  uint32_t allocationProfileSampleRate{0};
+
   /// ================== 'MemoryAllocator' settings ==================
 
   /// Specifies the max memory allocation capacity in bytes enforced by
@@ -112,6 +122,12 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// If true, MmapAllocator keeps separate size classes for each NUMA node of
+  /// the host and allocates from the node preferred by the calling thread.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  bool numaAwareAllocation{false};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
@@ -308,6 +324,8 @@ class MemoryManager {
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
   const bool disableMemoryPoolTracking_;
+  const uint64_t allocationCacheBytes_;
+  const uint32_t allocationProfileSampleRate_;
 
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
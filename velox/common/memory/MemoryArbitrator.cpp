@@ -162,6 +162,12 @@ void MemoryArbitrator::unregisterFactory(const std::string& kind) {
   arbitratorFactories().unregisterFactory(kind);
 }
 
+uint64_t MemoryArbitrator::reserveExpectedCapacity(
+    MemoryPool* pool,
+    uint64_t /*unused*/) {
+  return pool->capacity();
+}
+
 /*static*/ bool MemoryArbitrator::growPool(
     MemoryPool* pool,
     uint64_t growBytes,
@@ -176,6 +176,18 @@ class MemoryArbitrator {
   /// pool. The function returns the actual freed capacity from 'pool'.
   virtual uint64_t shrinkCapacity(MemoryPool* pool, uint64_t targetBytes) = 0;
 
+  /// Invoked to declare that the query of root memory 'pool' is expected to
+  /// use up to 'expectedPeakBytes' of memory, e.g. as observed by earlier runs
+  /// of the same plan. The arbitrator may reserve the capacity up front
+  /// instead of growing 'pool' on demand, and may block the caller to delay
+  /// the query until there is enough capacity for it. The function returns
+  /// the capacity of 'pool' after the reservation.
+  ///
+  /// NOTE: this is only a hint. The default implementation ignores it.
+  virtual uint64_t reserveExpectedCapacity(
+      MemoryPool* pool,
+      uint64_t expectedPeakBytes);
+
   /// Invoked by the memory manager to globally shrink memory from
   /// memory pools by reclaiming only used memory, to reduce system memory
   /// pressure. The freed memory capacity is given back to the arbitrator.  If
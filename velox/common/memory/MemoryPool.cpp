@@ -24,6 +24,7 @@
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 
 #include <re2/re2.h>
 
@@ -162,6 +163,14 @@ std::string capacityToString(int64_t capacity) {
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     recordFreeDbg(__VA_ARGS__);        \
   }
+#define PROFILE_ALLOC(...)                                 \
+  if (FOLLY_UNLIKELY(allocationProfileSampleRate_ != 0)) { \
+    profileAlloc(__VA_ARGS__);                             \
+  }
+#define PROFILE_FREE(...)                                  \
+  if (FOLLY_UNLIKELY(allocationProfileSampleRate_ != 0)) { \
+    profileFree(__VA_ARGS__);                              \
+  }
 #define DEBUG_LEAK_CHECK()             \
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     leakCheckDbg();                    \
@@ -214,6 +223,74 @@ std::ostream& operator<<(std::ostream& os, const MemoryPool::Stats& stats) {
   return os << stats.toString();
 }
 
+// static
+int32_t MemoryPool::AllocationProfile::sizeBucket(uint64_t bytes) {
+  if (bytes <= 64) {
+    return 0;
+  }
+  return std::min<int32_t>(
+      kNumSizeBuckets - 1, 64 - __builtin_clzll(bytes - 1) - 6);
+}
+
+// static
+std::string MemoryPool::AllocationProfile::sizeBucketName(int32_t bucket) {
+  VELOX_CHECK_LT(bucket, kNumSizeBuckets);
+  if (bucket == kNumSizeBuckets - 1) {
+    return ">" + sizeBucketName(bucket - 1);
+  }
+  const uint64_t bytes = 64UL << bucket;
+  if (bytes < 1024) {
+    return fmt::format("{}B", bytes);
+  }
+  if (bytes < (1 << 20)) {
+    return fmt::format("{}KB", bytes >> 10);
+  }
+  return fmt::format("{}MB", bytes >> 20);
+}
+
+// static
+int32_t MemoryPool::AllocationProfile::lifetimeBucket(uint64_t lifetimeUs) {
+  int32_t bucket = 0;
+  for (uint64_t bound = 10; bucket < kNumLifetimeBuckets - 1 &&
+       lifetimeUs >= bound;
+       bound *= 10) {
+    ++bucket;
+  }
+  return bucket;
+}
+
+// static
+std::string MemoryPool::AllocationProfile::lifetimeBucketName(int32_t bucket) {
+  static const std::array<std::string, kNumLifetimeBuckets> kNames{
+      "10us", "100us", "1ms", "10ms", "100ms", "1s", "10s", ">10s"};
+  VELOX_CHECK_LT(bucket, kNumLifetimeBuckets);
+  return kNames[bucket];
+}
+
+bool MemoryPool::AllocationProfile::empty() const {
+  return std::all_of(
+      numAllocs.begin(), numAllocs.end(), [](auto n) { return n == 0; });
+}
+
+std::string MemoryPool::AllocationProfile::toString() const {
+  std::stringstream out;
+  out << "sizes[";
+  for (auto i = 0; i < kNumSizeBuckets; ++i) {
+    if (numAllocs[i] != 0) {
+      out << " " << sizeBucketName(i) << ":" << numAllocs[i] << "/"
+          << succinctBytes(allocBytes[i]);
+    }
+  }
+  out << " ] lifetimes[";
+  for (auto i = 0; i < kNumLifetimeBuckets; ++i) {
+    if (numFrees[i] != 0) {
+      out << " " << lifetimeBucketName(i) << ":" << numFrees[i];
+    }
+  }
+  out << " ]";
+  return out.str();
+}
+
 MemoryPool::MemoryPool(
     const std::string& name,
     Kind kind,
@@ -227,7 +304,9 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       debugEnabled_(options.debugEnabled),
-      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled) {
+      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      allocationCacheBytes_(options.allocationCacheBytes),
+      allocationProfileSampleRate_(options.allocationProfileSampleRate) {
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
@@ -432,6 +511,9 @@ MemoryPoolImpl::MemoryPoolImpl(
 }
 
 MemoryPoolImpl::~MemoryPoolImpl() {
+  if (isLeaf()) {
+    clearAllocationCache();
+  }
   DEBUG_LEAK_CHECK();
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
@@ -503,6 +585,11 @@ void* MemoryPoolImpl::allocate(
 
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto alignedSize = sizeAlign(size);
+  if (void* buffer = allocateFromCache(alignedSize)) {
+    DEBUG_RECORD_ALLOC(buffer, size);
+    PROFILE_ALLOC(buffer, alignedSize);
+    return buffer;
+  }
   reserve(alignedSize);
   void* buffer = allocator_->allocateBytes(alignedSize, alignment_);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
@@ -515,6 +602,7 @@ void* MemoryPoolImpl::allocate(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  PROFILE_ALLOC(buffer, alignedSize);
   return buffer;
 }
 
@@ -535,6 +623,7 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  PROFILE_ALLOC(buffer, alignedSize);
   return buffer;
 }
 
@@ -555,6 +644,7 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(newP, newSize);
+  PROFILE_ALLOC(newP, alignedNewSize);
   if (p != nullptr) {
     ::memcpy(newP, p, std::min(size, newSize));
     free(p, size);
@@ -566,10 +656,76 @@ void MemoryPoolImpl::free(void* p, int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   const auto alignedSize = sizeAlign(size);
   DEBUG_RECORD_FREE(p, size);
+  PROFILE_FREE(p);
+  if (freeToCache(p, alignedSize)) {
+    return;
+  }
   allocator_->freeBytes(p, alignedSize);
   release(alignedSize);
 }
 
+void* MemoryPoolImpl::allocateFromCache(int64_t alignedSize) {
+  if (cachedBytes_ < alignedSize || alignedSize == 0 ||
+      alignedSize > kMaxCachedAllocationSize) {
+    return nullptr;
+  }
+  std::unique_lock<std::mutex> l(allocationCacheMutex_, std::defer_lock);
+  if (threadSafe_) {
+    l.lock();
+  }
+  auto& allocations = allocationCache_[alignedSize / alignment_ - 1];
+  if (allocations.empty()) {
+    return nullptr;
+  }
+  void* buffer = allocations.back();
+  allocations.pop_back();
+  cachedBytes_ -= alignedSize;
+  return buffer;
+}
+
+bool MemoryPoolImpl::freeToCache(void* p, int64_t alignedSize) {
+  if (cachedBytes_ + alignedSize > allocationCacheBytes_ || alignedSize == 0 ||
+      alignedSize > kMaxCachedAllocationSize || !isLeaf()) {
+    return false;
+  }
+  std::unique_lock<std::mutex> l(allocationCacheMutex_, std::defer_lock);
+  if (threadSafe_) {
+    l.lock();
+    if (cachedBytes_ + alignedSize > allocationCacheBytes_) {
+      return false;
+    }
+  }
+  if (allocationCache_.empty()) {
+    allocationCache_.resize(kMaxCachedAllocationSize / alignment_);
+  }
+  allocationCache_[alignedSize / alignment_ - 1].push_back(p);
+  cachedBytes_ += alignedSize;
+  return true;
+}
+
+void MemoryPoolImpl::clearAllocationCache() {
+  if (cachedBytes_ == 0) {
+    return;
+  }
+  int64_t freedBytes{0};
+  {
+    std::unique_lock<std::mutex> l(allocationCacheMutex_, std::defer_lock);
+    if (threadSafe_) {
+      l.lock();
+    }
+    for (auto i = 0; i < allocationCache_.size(); ++i) {
+      const int64_t size = (i + 1) * alignment_;
+      for (auto* buffer : allocationCache_[i]) {
+        allocator_->freeBytes(buffer, size);
+        freedBytes += size;
+      }
+      allocationCache_[i].clear();
+    }
+    cachedBytes_ -= freedBytes;
+  }
+  release(freedBytes);
+}
+
 void MemoryPoolImpl::allocateNonContiguous(
     MachinePageCount numPages,
     Allocation& out,
@@ -583,6 +739,7 @@ void MemoryPoolImpl::allocateNonContiguous(
       "facebook::velox::common::memory::MemoryPoolImpl::allocateNonContiguous",
       this);
   DEBUG_RECORD_FREE(out);
+  PROFILE_FREE(out);
   if (!allocator_->allocateNonContiguous(
           numPages,
           out,
@@ -603,6 +760,7 @@ void MemoryPoolImpl::allocateNonContiguous(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(out);
+  PROFILE_ALLOC(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -611,6 +769,7 @@ void MemoryPoolImpl::allocateNonContiguous(
 void MemoryPoolImpl::freeNonContiguous(Allocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   DEBUG_RECORD_FREE(allocation);
+  PROFILE_FREE(allocation);
   const int64_t freedBytes = allocator_->freeNonContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(freedBytes);
@@ -634,6 +793,7 @@ void MemoryPoolImpl::allocateContiguous(
   }
   VELOX_CHECK_GT(numPages, 0);
   DEBUG_RECORD_FREE(out);
+  PROFILE_FREE(out);
   if (!allocator_->allocateContiguous(
           numPages,
           nullptr,
@@ -655,6 +815,7 @@ void MemoryPoolImpl::allocateContiguous(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(out);
+  PROFILE_ALLOC(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -664,6 +825,7 @@ void MemoryPoolImpl::freeContiguous(ContiguousAllocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   const int64_t bytesToFree = allocation.size();
   DEBUG_RECORD_FREE(allocation);
+  PROFILE_FREE(allocation);
   allocator_->freeContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(bytesToFree);
@@ -749,7 +911,9 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
-          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_});
+          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .allocationCacheBytes = allocationCacheBytes_,
+          .allocationProfileSampleRate = allocationProfileSampleRate_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -905,6 +1069,7 @@ void MemoryPoolImpl::incrementReservationLocked(uint64_t bytes) {
 
 void MemoryPoolImpl::release() {
   CHECK_AND_INC_MEM_OP_STATS(Releases);
+  clearAllocationCache();
   release(0, true);
 }
 
@@ -1049,6 +1214,9 @@ uint64_t MemoryPoolImpl::reclaim(
     uint64_t targetBytes,
     uint64_t maxWaitMs,
     memory::MemoryReclaimer::Stats& stats) {
+  if (isLeaf()) {
+    clearAllocationCache();
+  }
   if (reclaimer() == nullptr) {
     return 0;
   }
@@ -1171,6 +1339,62 @@ bool MemoryPoolImpl::needRecordDbg(bool /* isAlloc */) {
   return true;
 }
 
+MemoryPool::AllocationProfile MemoryPoolImpl::allocationProfile() const {
+  std::lock_guard<std::mutex> l(profileMutex_);
+  return allocationProfile_;
+}
+
+void MemoryPoolImpl::profileAlloc(const void* addr, uint64_t bytes) {
+  if (numProfileCandidates_.fetch_add(1) % allocationProfileSampleRate_ != 0) {
+    return;
+  }
+  const auto bucket = AllocationProfile::sizeBucket(bytes);
+  std::lock_guard<std::mutex> l(profileMutex_);
+  ++allocationProfile_.numAllocs[bucket];
+  allocationProfile_.allocBytes[bucket] += bytes;
+  profiledAllocs_[reinterpret_cast<uint64_t>(addr)] = getCurrentTimeMicro();
+  numProfiledAllocs_ = profiledAllocs_.size();
+}
+
+void MemoryPoolImpl::profileAlloc(const Allocation& allocation) {
+  if (!allocation.empty()) {
+    profileAlloc(allocation.runAt(0).data(), allocation.byteSize());
+  }
+}
+
+void MemoryPoolImpl::profileAlloc(const ContiguousAllocation& allocation) {
+  if (!allocation.empty()) {
+    profileAlloc(allocation.data(), allocation.size());
+  }
+}
+
+void MemoryPoolImpl::profileFree(const void* addr) {
+  if (numProfiledAllocs_ == 0 || addr == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(profileMutex_);
+  auto it = profiledAllocs_.find(reinterpret_cast<uint64_t>(addr));
+  if (it == profiledAllocs_.end()) {
+    return;
+  }
+  const auto lifetimeUs = getCurrentTimeMicro() - it->second;
+  ++allocationProfile_.numFrees[AllocationProfile::lifetimeBucket(lifetimeUs)];
+  profiledAllocs_.erase(it);
+  numProfiledAllocs_ = profiledAllocs_.size();
+}
+
+void MemoryPoolImpl::profileFree(const Allocation& allocation) {
+  if (!allocation.empty()) {
+    profileFree(allocation.runAt(0).data());
+  }
+}
+
+void MemoryPoolImpl::profileFree(const ContiguousAllocation& allocation) {
+  if (!allocation.empty()) {
+    profileFree(allocation.data());
+  }
+}
+
 void MemoryPoolImpl::recordAllocDbg(const void* addr, uint64_t size) {
   VELOX_CHECK(debugEnabled_);
   if (!needRecordDbg(true)) {
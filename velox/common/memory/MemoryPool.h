@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <optional>
@@ -138,6 +139,18 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// Terminates the process and generates a core file on an allocation
     /// failure
     bool coreOnAllocationFailureEnabled{false};
+
+    /// If not zero, a leaf memory pool keeps up to this many bytes of freed
+    /// small allocations and hands them out again to allocations of the same
+    /// size without going through the memory reservation and the allocator.
+    /// The cached allocations are counted as used by the pool until release()
+    /// or a memory reclaim frees them. This applies to all the child pools.
+    uint64_t allocationCacheBytes{0};
+
+    /// If not zero, a leaf memory pool samples one in this many allocations
+    /// and records their sizes and lifetimes in allocationProfile(). This
+    /// applies to all the child pools.
+    uint32_t allocationProfileSampleRate{0};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -439,6 +452,45 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// Returns the stats of this memory pool.
   virtual Stats stats() const = 0;
 
+  /// The sampled allocations of a leaf memory pool, bucketed by size and by
+  /// lifetime. See Options::allocationProfileSampleRate.
+  struct AllocationProfile {
+    /// Size bucket 'i' holds the allocations of more than 32 << i and up to
+    /// 64 << i bytes. The last bucket holds all the larger ones.
+    static constexpr int32_t kNumSizeBuckets = 18;
+
+    /// Lifetime bucket 'i' holds the allocations freed in less than 10^(i+1)
+    /// microseconds. The last bucket holds all the longer lived ones.
+    static constexpr int32_t kNumLifetimeBuckets = 8;
+
+    /// The number of sampled allocations per size bucket.
+    std::array<uint64_t, kNumSizeBuckets> numAllocs{};
+    /// The bytes of the sampled allocations per size bucket.
+    std::array<uint64_t, kNumSizeBuckets> allocBytes{};
+    /// The number of freed sampled allocations per lifetime bucket.
+    std::array<uint64_t, kNumLifetimeBuckets> numFrees{};
+
+    static int32_t sizeBucket(uint64_t bytes);
+
+    /// Returns the upper bound of 'bucket', e.g. "64B", "2KB" or ">4MB".
+    static std::string sizeBucketName(int32_t bucket);
+
+    static int32_t lifetimeBucket(uint64_t lifetimeUs);
+
+    /// Returns the upper bound of 'bucket', e.g. "10us", "100ms" or ">10s".
+    static std::string lifetimeBucketName(int32_t bucket);
+
+    bool empty() const;
+
+    std::string toString() const;
+  };
+
+  /// Returns the allocation profile of this memory pool. Empty if the
+  /// profiling is not enabled or this is not a leaf memory pool.
+  virtual AllocationProfile allocationProfile() const {
+    return {};
+  }
+
   virtual std::string toString(bool detail = false) const = 0;
 
   /// Invoked to generate a descriptive memory usage summary of the entire tree.
@@ -523,6 +575,8 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const int64_t allocationCacheBytes_;
+  const uint32_t allocationProfileSampleRate_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -681,6 +735,8 @@ class MemoryPoolImpl : public MemoryPool {
 
   Stats stats() const override;
 
+  AllocationProfile allocationProfile() const override;
+
   void testingSetCapacity(int64_t bytes);
 
   void testingSetReservation(int64_t bytes);
@@ -755,6 +811,17 @@ class MemoryPoolImpl : public MemoryPool {
         : std::max<int64_t>(0, reservationBytes_ - usedReservationBytes_);
   }
 
+  // Returns a cached free allocation of 'alignedSize' bytes or nullptr if there
+  // is none.
+  void* allocateFromCache(int64_t alignedSize);
+
+  // Caches 'p' of 'alignedSize' bytes for reuse instead of freeing it. Returns
+  // false if 'p' is not cacheable or the cache is full.
+  bool freeToCache(void* p, int64_t alignedSize);
+
+  // Frees all the cached allocations.
+  void clearAllocationCache();
+
   FOLLY_ALWAYS_INLINE int64_t sizeAlign(int64_t size) {
     const auto remainder = size % alignment_;
     return (remainder == 0) ? size : (size + alignment_ - remainder);
@@ -946,6 +1013,21 @@ class MemoryPoolImpl : public MemoryPool {
   //  TODO(jtan6): Add support for dynamic condition change.
   bool needRecordDbg(bool isAlloc);
 
+  // Records a sampled allocation in 'allocationProfile_' if it is picked by
+  // 'allocationProfileSampleRate_'.
+  void profileAlloc(const void* addr, uint64_t bytes);
+
+  void profileAlloc(const Allocation& allocation);
+
+  void profileAlloc(const ContiguousAllocation& allocation);
+
+  // Records the lifetime of a sampled allocation on its free.
+  void profileFree(const void* addr);
+
+  void profileFree(const Allocation& allocation);
+
+  void profileFree(const ContiguousAllocation& allocation);
+
   // Invoked to record the call stack of a buffer allocation if debug mode of
   // this memory pool is enabled.
   void recordAllocDbg(const void* addr, uint64_t size);
@@ -1048,6 +1130,34 @@ class MemoryPoolImpl : public MemoryPool {
   // NOTE: this only applies for root memory pool.
   std::atomic_uint64_t numCapacityGrowths_{0};
 
+  // Allocations larger than this are not cached.
+  static constexpr int64_t kMaxCachedAllocationSize = 4 << 10;
+
+  // Serializes accesses to 'allocationCache_' for a thread-safe pool.
+  std::mutex allocationCacheMutex_;
+
+  // The cached free allocations of each size, indexed by size / 'alignment_' -
+  // 1. Empty if nothing has been cached yet.
+  std::vector<std::vector<void*>> allocationCache_;
+
+  // The total size of the allocations in 'allocationCache_'.
+  tsan_atomic<int64_t> cachedBytes_{0};
+
+  // The number of allocations considered for sampling.
+  std::atomic_uint64_t numProfileCandidates_{0};
+
+  // Mutex for 'allocationProfile_' and 'profiledAllocs_'.
+  mutable std::mutex profileMutex_;
+
+  AllocationProfile allocationProfile_;
+
+  // Map from the address of a live sampled allocation to its allocation time
+  // in microseconds.
+  std::unordered_map<uint64_t, uint64_t> profiledAllocs_;
+
+  // The size of 'profiledAllocs_', checked on free without the mutex.
+  tsan_atomic<size_t> numProfiledAllocs_{0};
+
   // Mutex for 'debugAllocRecords_'.
   std::mutex debugAllocMutex_;
 
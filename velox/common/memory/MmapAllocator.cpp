@@ -35,9 +35,13 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+          64 * sizeClassSizes_.back())),
+      numNumaNodes_(std::max(1, options.numNumaNodes)) {
+  for (int32_t node = 0; node < numNumaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size, size, numNumaNodes_ > 1 ? node : kNoNumaNode));
+    }
   }
 
   if (useMmapArena_) {
@@ -91,6 +95,7 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
 
   ++numAllocations_;
   numAllocatedPages_ += sizeMix.totalPages;
+  const auto firstClass = allocationNumaNode() * sizeClassSizes_.size();
   MachinePageCount newMapsNeeded = 0;
   for (int i = 0; i < sizeMix.numSizes; ++i) {
     bool success;
@@ -98,7 +103,7 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
         AllocationTraits::pageBytes(sizeClassSizes_[sizeMix.sizeIndices[i]]),
         sizeMix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[sizeMix.sizeIndices[i]]->allocate(
+          success = sizeClasses_[firstClass + sizeMix.sizeIndices[i]]->allocate(
               sizeMix.sizeCounts[i], newMapsNeeded, out);
         });
     if (success && ((i > 0) || (sizeMix.numSizes == 1)) &&
@@ -141,6 +146,22 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
   return false;
 }
 
+int32_t MmapAllocator::allocationNumaNode() {
+  if (numNumaNodes_ == 1) {
+    return 0;
+  }
+  const auto currentNode = currentNumaNode() % numNumaNodes_;
+  const auto preferredNode = preferredNumaNode();
+  if (preferredNode == kNoNumaNode) {
+    return currentNode;
+  }
+  const auto node = preferredNode % numNumaNodes_;
+  if (node != currentNode) {
+    ++numRemoteNumaAllocations_;
+  }
+  return node;
+}
+
 bool MmapAllocator::ensureEnoughMappedPages(int32_t newMappedNeeded) {
   if (testingHasInjectedFailure(InjectedFailure::kMadvise)) {
     return false;
@@ -195,8 +216,8 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       // Increment the free time only if the allocation contained
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
-      const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+      const auto sizeIndex = Stats::sizeIndex(
+          AllocationTraits::pageBytes(sizeClass->unitSize()));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
     numFreed += pages;
@@ -353,6 +374,11 @@ bool MmapAllocator::allocateContiguousImpl(
     rollbackAllocation(numToMap);
     return false;
   }
+  if (!useMmapArena_ && numNumaNodes_ > 1) {
+    // Arenas are shared by all nodes, so only a dedicated mmap can be bound.
+    bindToNumaNode(
+        data, AllocationTraits::pageBytes(maxPages), allocationNumaNode());
+  }
   allocation.set(
       data,
       AllocationTraits::pageBytes(numPages),
@@ -509,7 +535,10 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -538,6 +567,11 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode != kNoNumaNode && !bindToNumaNode(ptr, byteSize_, numaNode)) {
+    VELOX_MEM_LOG(WARNING) << "Could not bind sizeClass " << unitSize_
+                           << " to NUMA node " << numaNode << ": "
+                           << folly::errnoStr(errno);
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -955,6 +989,15 @@ bool MmapAllocator::useMalloc(uint64_t bytes) {
   return (maxMallocBytes_ != 0) && (bytes <= maxMallocBytes_);
 }
 
+std::vector<folly::Range<char*>> MmapAllocator::sizeClassRanges() const {
+  std::vector<folly::Range<char*>> ranges;
+  ranges.reserve(sizeClasses_.size());
+  for (const auto& sizeClass : sizeClasses_) {
+    ranges.push_back(sizeClass->addressRange());
+  }
+  return ranges;
+}
+
 std::string MmapAllocator::toString() const {
   std::stringstream out;
   out << "Memory Allocator[" << kindString(kind_) << " total capacity "
@@ -965,7 +1008,12 @@ std::string MmapAllocator::toString() const {
               : succinctBytes(
                     capacity() - AllocationTraits::pageBytes(numAllocated())))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
-      << " external mapped pages " << numExternalMapped_ << std::endl;
+      << " external mapped pages " << numExternalMapped_;
+  if (numNumaNodes_ > 1) {
+    out << " NUMA nodes " << numNumaNodes_ << " remote NUMA allocations "
+        << numRemoteNumaAllocations_;
+  }
+  out << std::endl;
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
@@ -24,12 +24,14 @@
 #include <mutex>
 #include <unordered_set>
 
+#include <folly/Range.h>
 #include <folly/ThreadCachedInt.h>
 
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MemoryPool.h"
 #include "velox/common/memory/MmapArena.h"
+#include "velox/common/memory/NumaUtil.h"
 
 namespace facebook::velox::memory {
 
@@ -49,6 +51,12 @@ using ClassPageCount = int32_t;
 /// mmap of the requested size (ContiguousAllocation). Small contiguous memory
 /// allocations less than 3/4 of smallest size class are still delegated to
 /// malloc.
+///
+/// With more than one NUMA node, each node has its own set of size classes
+/// whose address ranges are bound to the node. Non-contiguous allocations are
+/// made from the size classes of the preferred node of the calling thread (see
+/// ScopedPreferredNumaNode), or else of the node the thread runs on. The
+/// capacity is shared by all nodes.
 class MmapAllocator : public MemoryAllocator {
  public:
   struct Options {
@@ -80,6 +88,10 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// Number of NUMA nodes to keep separate size classes for. If 1, memory is
+    /// allocated without a NUMA policy.
+    int32_t numNumaNodes{1};
   };
 
   explicit MmapAllocator(const Options& options);
@@ -153,6 +165,16 @@ class MmapAllocator : public MemoryAllocator {
     return numMallocBytes_.readFull();
   }
 
+  int32_t numNumaNodes() const {
+    return numNumaNodes_;
+  }
+
+  /// Returns the number of allocations made from the size classes of a NUMA
+  /// node other than the one of the CPU the allocating thread ran on.
+  uint64_t numRemoteNumaAllocations() const {
+    return numRemoteNumaAllocations_;
+  }
+
   Stats stats() const override {
     auto stats = stats_;
     stats.numAdvise = numAdvisedPages_;
@@ -161,14 +183,24 @@ class MmapAllocator : public MemoryAllocator {
 
   std::string toString() const override;
 
+  /// Returns the virtual address ranges of the size classes. Allocations within
+  /// the size classes fall in these, so they can be registered as fixed
+  /// buffers with an IoUringReader. Registering pins the whole range, so this
+  /// only makes sense for a capacity that is dedicated to the allocator.
+  std::vector<folly::Range<char*>> sizeClassRanges() const;
+
  private:
   static constexpr uint64_t kAllSet = 0xffffffffffffffff;
 
   // Represents a range of virtual addresses used for allocating entries of
-  // 'unitSize_' machine pages.
+  // 'unitSize_' machine pages. If 'numaNode' is not kNoNumaNode, the range
+  // prefers physical memory from that node.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    SizeClass(
+        size_t capacity,
+        MachinePageCount unitSize,
+        int32_t numaNode = kNoNumaNode);
 
     ~SizeClass();
 
@@ -209,6 +241,10 @@ class MmapAllocator : public MemoryAllocator {
     // size class page boundary.
     bool isInRange(uint8_t* ptr) const;
 
+    folly::Range<char*> addressRange() const {
+      return {reinterpret_cast<char*>(address_), byteSize_};
+    }
+
     std::string toString() const;
 
    private:
@@ -372,6 +408,10 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Returns the NUMA node to allocate from for the calling thread and counts
+  // the allocation as remote if it is not the node the thread runs on.
+  int32_t allocationNumaNode();
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -408,10 +448,15 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  const int32_t numNumaNodes_;
+
+  // The size classes of all NUMA nodes. The size classes of node 'n' are at
+  // [n * sizeClassSizes_.size(), (n + 1) * sizeClassSizes_.size()).
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
   // Statistics.
   std::atomic<uint64_t> numAllocations_ = 0;
+  std::atomic<uint64_t> numRemoteNumaAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
   std::atomic<uint64_t> numAdvisedPages_ = 0;
   folly::ThreadCachedInt<int64_t, MmapAllocator> numMallocBytes_;
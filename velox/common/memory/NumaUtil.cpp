@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/NumaUtil.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::memory {
+namespace {
+// Same value as MPOL_PREFERRED in <numaif.h>, which we do not depend on.
+constexpr int kMpolPreferred = 1;
+
+thread_local int32_t threadPreferredNumaNode{kNoNumaNode};
+
+int32_t countNumaNodes() {
+  std::error_code ec;
+  const std::filesystem::path nodeDir{"/sys/devices/system/node"};
+  int32_t numNodes{0};
+  while (std::filesystem::exists(
+      nodeDir / ("node" + std::to_string(numNodes)), ec)) {
+    ++numNodes;
+  }
+  return numNodes == 0 ? 1 : numNodes;
+}
+
+// Returns the CPUs in the cpulist of 'node', e.g. "0-11,24-35", or an empty
+// vector if the list cannot be read.
+std::vector<int32_t> numaNodeCpus(int32_t node) {
+  std::ifstream in(
+      "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+  std::string list;
+  if (!std::getline(in, list)) {
+    return {};
+  }
+  std::vector<int32_t> cpus;
+  std::stringstream ranges(list);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    int32_t first;
+    int32_t last;
+    const auto dash = range.find('-');
+    try {
+      first = std::stoi(range.substr(0, dash));
+      last = dash == std::string::npos ? first
+                                       : std::stoi(range.substr(dash + 1));
+    } catch (const std::exception&) {
+      return {};
+    }
+    for (auto cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+} // namespace
+
+int32_t numNumaNodes() {
+  static const int32_t numNodes = countNumaNodes();
+  return numNodes;
+}
+
+int32_t currentNumaNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned cpu;
+  unsigned node;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return static_cast<int32_t>(node);
+  }
+#endif
+  return 0;
+}
+
+bool bindToNumaNode(void* address, size_t bytes, int32_t node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  if (node < 0 || node >= 64) {
+    return false;
+  }
+  const unsigned long nodeMask = 1UL << node;
+  return ::syscall(
+             SYS_mbind,
+             address,
+             bytes,
+             kMpolPreferred,
+             &nodeMask,
+             sizeof(nodeMask) * 8,
+             0) == 0;
+#else
+  return false;
+#endif
+}
+
+bool pinThreadToNumaNode(int32_t node) {
+#ifdef __linux__
+  if (node < 0) {
+    return false;
+  }
+  const auto cpus = numaNodeCpus(node);
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuSet);
+    }
+  }
+  return ::sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+#else
+  return false;
+#endif
+}
+
+int32_t preferredNumaNode() {
+  return threadPreferredNumaNode;
+}
+
+ScopedPreferredNumaNode::ScopedPreferredNumaNode(int32_t node)
+    : savedNode_(threadPreferredNumaNode) {
+  threadPreferredNumaNode = node;
+}
+
+ScopedPreferredNumaNode::~ScopedPreferredNumaNode() {
+  threadPreferredNumaNode = savedNode_;
+}
+
+} // namespace facebook::velox::memory
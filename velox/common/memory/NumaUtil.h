@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace facebook::velox::memory {
+
+/// Value of preferredNumaNode() when the calling thread has no preference.
+constexpr int32_t kNoNumaNode = -1;
+
+/// Returns the number of NUMA nodes of the host. Returns 1 if the host has no
+/// NUMA topology or it cannot be determined.
+int32_t numNumaNodes();
+
+/// Returns the NUMA node of the CPU the calling thread runs on, 0 if unknown.
+int32_t currentNumaNode();
+
+/// Sets the memory policy of the 'bytes' bytes at 'address' to prefer
+/// physical pages from 'node'. 'address' must be page aligned. Returns false
+/// and leaves the default policy if this is not supported.
+bool bindToNumaNode(void* address, size_t bytes, int32_t node);
+
+/// Restricts the calling thread to run on the CPUs of 'node'. Returns false
+/// and leaves the CPU affinity of the thread unchanged if the CPUs of 'node'
+/// are not known or this is not supported.
+bool pinThreadToNumaNode(int32_t node);
+
+/// Returns the NUMA node the calling thread prefers to allocate memory from or
+/// kNoNumaNode if it allocates from the node it runs on.
+int32_t preferredNumaNode();
+
+/// Sets the preferred NUMA node of the calling thread for the lifetime of
+/// 'this' and restores the previous value on destruction. A Driver installs
+/// this for the NUMA node of its Task so that memory allocated by its
+/// operators lands on the node its threads are pinned to.
+class ScopedPreferredNumaNode {
+ public:
+  explicit ScopedPreferredNumaNode(int32_t node);
+
+  ~ScopedPreferredNumaNode();
+
+ private:
+  const int32_t savedNode_;
+};
+
+} // namespace facebook::velox::memory
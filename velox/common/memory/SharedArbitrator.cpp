@@ -23,6 +23,7 @@
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/config/Config.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/TraceEvents.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 
@@ -193,6 +194,14 @@ bool SharedArbitrator::ExtraConfig::checkUsageLeak(
   return getConfig<bool>(configs, kCheckUsageLeak, kDefaultCheckUsageLeak);
 }
 
+bool SharedArbitrator::ExtraConfig::expectedCapacityAdmissionEnabled(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return getConfig<bool>(
+      configs,
+      kExpectedCapacityAdmissionEnabled,
+      kDefaultExpectedCapacityAdmissionEnabled);
+}
+
 uint64_t SharedArbitrator::ExtraConfig::fastExponentialGrowthCapacityLimitBytes(
     const std::unordered_map<std::string, std::string>& configs) {
   return config::toCapacity(
@@ -286,6 +295,11 @@ SharedArbitrator::SharedArbitrator(const Config& config)
       0.0,
       "memoryReclaimThreadsHwMultiplier_ needs to be positive");
 
+  if (ExtraConfig::expectedCapacityAdmissionEnabled(config.extraConfigs)) {
+    expectedCapacityAdmission_ = std::make_unique<common::AdmissionController>(
+        common::AdmissionController::Config{.maxLimit = capacity_});
+  }
+
   const uint64_t numReclaimThreads = std::max<size_t>(
       1,
       std::thread::hardware_concurrency() * memoryReclaimThreadsHwMultiplier_);
@@ -421,6 +435,8 @@ void SharedArbitrator::finishArbitration(ArbitrationOperation* op) {
   if (stats.executionTimeNs != 0) {
     RECORD_HISTOGRAM_METRIC_VALUE(
         kMetricArbitratorOpExecTimeMs, stats.executionTimeNs / 1'000'000);
+    RECORD_HISTOGRAM_METRIC_VALUE(
+        kMetricArbitratorOpLatencyMs, stats.executionTimeNs / 1'000'000);
     addThreadLocalRuntimeStat(
         kMemoryArbitrationWallNanos,
         RuntimeCounter(stats.executionTimeNs, RuntimeCounter::Unit::kNanos));
@@ -503,9 +519,78 @@ void SharedArbitrator::removePool(MemoryPool* pool) {
   VELOX_CHECK_EQ(pool->capacity(), 0);
   freeCapacity(freedBytes);
 
-  std::unique_lock guard{participantLock_};
-  const auto ret = participants_.erase(pool->name());
-  VELOX_CHECK_EQ(ret, 1);
+  {
+    std::unique_lock guard{participantLock_};
+    const auto ret = participants_.erase(pool->name());
+    VELOX_CHECK_EQ(ret, 1);
+  }
+
+  uint64_t admittedBytes{0};
+  {
+    std::lock_guard<std::mutex> l(stateMutex_);
+    auto it = admittedExpectedCapacity_.find(pool->name());
+    if (it != admittedExpectedCapacity_.end()) {
+      admittedBytes = it->second;
+      admittedExpectedCapacity_.erase(it);
+    }
+  }
+  if (admittedBytes > 0) {
+    expectedCapacityAdmission_->release(admittedBytes);
+  }
+}
+
+uint64_t SharedArbitrator::reserveExpectedCapacity(
+    MemoryPool* pool,
+    uint64_t expectedPeakBytes) {
+  checkRunning();
+
+  VELOX_CHECK(pool->isRoot());
+  auto participant = getParticipant(pool->name());
+  VELOX_CHECK(
+      participant.has_value(), "Memory pool {} not found", pool->name());
+  const uint64_t expectedBytes = std::min(
+      {expectedPeakBytes, participant.value()->maxCapacity(), capacity_});
+
+  if (expectedCapacityAdmission_ != nullptr && expectedBytes > 0) {
+    {
+      std::lock_guard<std::mutex> l(stateMutex_);
+      VELOX_CHECK_EQ(
+          admittedExpectedCapacity_.count(pool->name()),
+          0,
+          "Expected capacity of memory pool {} has already been reserved",
+          pool->name());
+    }
+    // Blocks until the admitted queries leave enough capacity.
+    expectedCapacityAdmission_->accept(expectedBytes);
+    std::lock_guard<std::mutex> l(stateMutex_);
+    admittedExpectedCapacity_.emplace(pool->name(), expectedBytes);
+  }
+
+  std::vector<ContinuePromise> arbitrationWaiters;
+  {
+    std::lock_guard<std::mutex> l(stateMutex_);
+    const uint64_t capacity = participant.value()->capacity();
+    if (expectedBytes > capacity) {
+      const uint64_t allocatedBytes = allocateCapacityLocked(
+          participant.value()->id(), 0, expectedBytes - capacity, 0);
+      if (allocatedBytes > 0) {
+        try {
+          checkedGrow(participant.value(), allocatedBytes, 0);
+        } catch (const VeloxRuntimeError& e) {
+          VELOX_MEM_LOG(ERROR)
+              << "Failed to reserve expected capacity "
+              << succinctBytes(allocatedBytes)
+              << " for memory pool: " << participant.value()->name() << "\n"
+              << e.what();
+          freeCapacityLocked(allocatedBytes, arbitrationWaiters);
+        }
+      }
+    }
+  }
+  for (auto& waiter : arbitrationWaiters) {
+    waiter.setValue();
+  }
+  return participant.value()->capacity();
 }
 
 std::vector<ArbitrationCandidate> SharedArbitrator::getCandidates(
@@ -726,6 +811,10 @@ ArbitrationOperation SharedArbitrator::createArbitrationOperation(
 }
 
 void SharedArbitrator::growCapacity(MemoryPool* pool, uint64_t requestBytes) {
+  VELOX_TRACE_PROBE(arbitration_request, pool, requestBytes);
+  process::TraceSpan span("memory", "arbitration", [&]() {
+    return fmt::format("{} {}", pool->name(), succinctBytes(requestBytes));
+  });
   checkRunning();
 
   VELOX_CHECK(pool->isRoot());
@@ -19,6 +19,7 @@
 #include <shared_mutex>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include "velox/common/base/AdmissionController.h"
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/base/StatsReporter.h"
@@ -225,6 +226,16 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     static bool globalArbitrationWithoutSpill(
         const std::unordered_map<std::string, std::string>& configs);
 
+    /// If true, reserveExpectedCapacity() blocks a query until the sum of the
+    /// expected peak capacity of all the admitted queries fits the arbitrator
+    /// capacity. This avoids starting many queries at once which then grow,
+    /// spill and abort each other.
+    static constexpr std::string_view kExpectedCapacityAdmissionEnabled{
+        "expected-capacity-admission-enabled"};
+    static constexpr bool kDefaultExpectedCapacityAdmissionEnabled{false};
+    static bool expectedCapacityAdmissionEnabled(
+        const std::unordered_map<std::string, std::string>& configs);
+
     /// If true, do sanity check on the arbitrator state on destruction.
     ///
     /// TODO: deprecate this flag after all the existing memory leak use cases
@@ -254,6 +265,14 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   /// NOTE: only support shrinking away all the unused free capacity for now.
   uint64_t shrinkCapacity(MemoryPool* pool, uint64_t requestBytes) final;
 
+  /// Grows the capacity of 'pool' to 'expectedPeakBytes' from the free
+  /// capacity of the arbitrator, without reclaiming memory from other pools.
+  /// If 'expected-capacity-admission-enabled' is set, first waits until the
+  /// expected capacity of all the admitted pools fits the arbitrator capacity.
+  uint64_t reserveExpectedCapacity(
+      MemoryPool* pool,
+      uint64_t expectedPeakBytes) final;
+
   uint64_t shrinkCapacity(
       uint64_t requestBytes,
       bool allowSpill = true,
@@ -620,6 +639,13 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   mutable std::mutex stateMutex_;
   State state_{State::kRunning};
 
+  // Admits the queries by their expected capacity if
+  // 'expected-capacity-admission-enabled' is set, otherwise null.
+  std::unique_ptr<common::AdmissionController> expectedCapacityAdmission_;
+  // The expected capacity admitted through 'expectedCapacityAdmission_' by
+  // pool name. Protected by 'stateMutex_'.
+  std::unordered_map<std::string, uint64_t> admittedExpectedCapacity_;
+
   tsan_atomic<uint64_t> freeReservedCapacity_{0};
   tsan_atomic<uint64_t> freeNonReservedCapacity_{0};
 
@@ -739,6 +739,74 @@ TEST_F(HashStringAllocatorTest, clear) {
   EXPECT_EQ(allocator_->retainedSize(), 0);
 }
 
+TEST_F(HashStringAllocatorTest, compact) {
+  constexpr int32_t kNumSamples = 5'000;
+  std::vector<Multipart> data(kNumSamples);
+  const auto append = [&](Multipart& item) {
+    auto chars = randomString();
+    ByteOutputStream stream(allocator_.get());
+    if (item.start.isSet()) {
+      allocator_->extendWrite(item.current, stream);
+    } else {
+      item.start = allocator_->newWrite(stream, chars.size());
+    }
+    stream.appendStringView(chars);
+    item.current = allocator_->finishWrite(stream, rand32() % 100).second;
+    item.reference.insert(item.reference.end(), chars.begin(), chars.end());
+  };
+  for (auto count = 0; count < 3; ++count) {
+    for (auto& item : data) {
+      append(item);
+    }
+  }
+  // Large blocks come from the memory pool and survive compaction in place.
+  auto* large = allocate(HashStringAllocator::kMaxAlloc + 1);
+
+  // Free most of the data to leave the slabs fragmented.
+  for (auto i = 0; i < kNumSamples; ++i) {
+    if (i % 4 != 0) {
+      checkAndFree(data[i]);
+    }
+  }
+  const auto retainedSize = allocator_->retainedSize();
+
+  const auto freedBytes =
+      allocator_->compact([&](const HSA::RelocateFunc& relocate) {
+        ASSERT_EQ(large, relocate(large));
+        for (auto& item : data) {
+          if (!item.start.isSet()) {
+            continue;
+          }
+          const auto offset = HSA::offset(item.start.header, item.current);
+          ASSERT_GE(offset, 0);
+          auto* header = relocate(item.start.header);
+          item.start = {header, header->begin()};
+          item.current = HSA::seek(header, offset);
+        }
+      });
+  ASSERT_GT(freedBytes, 0);
+  ASSERT_EQ(retainedSize - freedBytes, allocator_->retainedSize());
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+
+  for (auto& item : data) {
+    if (item.start.isSet()) {
+      ASSERT_FALSE(item.start.header->isContinued());
+      checkMultipart(item);
+      // The translated positions allow appending after compaction.
+      append(item);
+      checkMultipart(item);
+    }
+  }
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+  for (auto& item : data) {
+    if (item.start.isSet()) {
+      checkAndFree(item);
+    }
+  }
+  allocator_->free(large);
+  ASSERT_TRUE(allocator_->isEmpty());
+}
+
 TEST_F(HashStringAllocatorTest, freezeAndExecute) {
   std::string str = "abc";
   StringView view(str.data(), str.size());
@@ -478,6 +478,51 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, mmapAllocatorNumaNodes) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.numNumaNodes = 2;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  ASSERT_EQ(mmapAllocator->numNumaNodes(), 2);
+  EXPECT_EQ(
+      bits::roundUp(
+          AllocationTraits::numPages(kCapacityBytes),
+          64 * mmapAllocator->sizeClasses().back()),
+      AllocationTraits::numPages(mmapAllocator->capacity()));
+
+  ASSERT_EQ(preferredNumaNode(), kNoNumaNode);
+  std::vector<Allocation> allocations(3);
+  ASSERT_TRUE(mmapAllocator->allocateNonContiguous(100, allocations[0]));
+  // Without a preferred node, allocations are local to the running thread.
+  ASSERT_EQ(mmapAllocator->numRemoteNumaAllocations(), 0);
+  for (int32_t node = 0; node < 2; ++node) {
+    ScopedPreferredNumaNode numaNode(node);
+    ASSERT_EQ(preferredNumaNode(), node);
+    ASSERT_TRUE(
+        mmapAllocator->allocateNonContiguous(100, allocations[node + 1]));
+  }
+  ASSERT_EQ(preferredNumaNode(), kNoNumaNode);
+  // One of the nodes is not the one the test runs on. The thread may also
+  // migrate between nodes in between the allocations.
+  ASSERT_GE(mmapAllocator->numRemoteNumaAllocations(), 1);
+  ASSERT_LE(mmapAllocator->numRemoteNumaAllocations(), 2);
+  ASSERT_EQ(mmapAllocator->numAllocated(), 300);
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+
+  // An allocation can be freed on any node.
+  {
+    ScopedPreferredNumaNode numaNode(1);
+    for (auto& allocation : allocations) {
+      mmapAllocator->freeNonContiguous(allocation);
+    }
+  }
+  ASSERT_EQ(mmapAllocator->numAllocated(), 0);
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
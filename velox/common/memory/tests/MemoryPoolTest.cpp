@@ -17,6 +17,7 @@
 #include <fmt/format.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <numeric>
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/AsyncDataCache.h"
@@ -431,6 +432,127 @@ TEST_P(MemoryPoolTest, usedBytes) {
   ASSERT_EQ(root->usedBytes(), 0);
 }
 
+TEST_P(MemoryPoolTest, allocationCache) {
+  setupMemory(
+      {.debugEnabled = true,
+       .allocationCacheBytes = 1024,
+       .allocatorCapacity = kDefaultCapacity,
+       .arbitratorCapacity = kDefaultCapacity});
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool();
+  auto leaf = root->addLeafChild("allocationCache", isLeafThreadSafe_);
+
+  const int64_t kChunkSize{128};
+  void* buf1 = leaf->allocate(kChunkSize);
+  void* buf2 = leaf->allocate(kChunkSize);
+  ASSERT_EQ(leaf->usedBytes(), 2 * kChunkSize);
+  // A freed small allocation stays with the pool for reuse.
+  leaf->free(buf1, kChunkSize);
+  ASSERT_EQ(leaf->usedBytes(), 2 * kChunkSize);
+  ASSERT_EQ(leaf->allocate(kChunkSize), buf1);
+  ASSERT_EQ(leaf->usedBytes(), 2 * kChunkSize);
+  // An allocation of another size is not served from the cache.
+  leaf->free(buf1, kChunkSize);
+  void* buf3 = leaf->allocate(2 * kChunkSize);
+  ASSERT_NE(buf3, buf1);
+  ASSERT_EQ(leaf->usedBytes(), 4 * kChunkSize);
+  // Allocations beyond the cache capacity are freed.
+  void* large = leaf->allocate(8 * kChunkSize);
+  leaf->free(large, 8 * kChunkSize);
+  ASSERT_EQ(leaf->usedBytes(), 4 * kChunkSize);
+  ASSERT_EQ(leaf->stats().numAllocs, 5);
+  ASSERT_EQ(leaf->stats().numFrees, 3);
+
+  leaf->free(buf2, kChunkSize);
+  leaf->free(buf3, 2 * kChunkSize);
+  ASSERT_EQ(leaf->usedBytes(), 4 * kChunkSize);
+  // release() frees the cached allocations.
+  leaf->release();
+  ASSERT_EQ(leaf->usedBytes(), 0);
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+  ASSERT_EQ(root->usedBytes(), 0);
+
+  // The cached allocations are freed on pool destruction.
+  leaf->free(leaf->allocate(kChunkSize), kChunkSize);
+  ASSERT_EQ(leaf->usedBytes(), kChunkSize);
+  leaf.reset();
+  ASSERT_EQ(root->usedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+}
+
+TEST_P(MemoryPoolTest, allocationProfile) {
+  using AllocationProfile = MemoryPool::AllocationProfile;
+  ASSERT_EQ(AllocationProfile::sizeBucket(1), 0);
+  ASSERT_EQ(AllocationProfile::sizeBucket(64), 0);
+  ASSERT_EQ(AllocationProfile::sizeBucket(65), 1);
+  ASSERT_EQ(AllocationProfile::sizeBucket(4 << 10), 6);
+  ASSERT_EQ(
+      AllocationProfile::sizeBucket(1UL << 40),
+      AllocationProfile::kNumSizeBuckets - 1);
+  ASSERT_EQ(AllocationProfile::sizeBucketName(0), "64B");
+  ASSERT_EQ(AllocationProfile::sizeBucketName(6), "4KB");
+  ASSERT_EQ(AllocationProfile::sizeBucketName(16), "4MB");
+  ASSERT_EQ(AllocationProfile::sizeBucketName(17), ">4MB");
+  ASSERT_EQ(AllocationProfile::lifetimeBucket(0), 0);
+  ASSERT_EQ(AllocationProfile::lifetimeBucket(10), 1);
+  ASSERT_EQ(AllocationProfile::lifetimeBucket(1'000'000), 6);
+  ASSERT_EQ(
+      AllocationProfile::lifetimeBucket(1'000'000'000),
+      AllocationProfile::kNumLifetimeBuckets - 1);
+  ASSERT_EQ(AllocationProfile::lifetimeBucketName(2), "1ms");
+  ASSERT_EQ(AllocationProfile::lifetimeBucketName(7), ">10s");
+
+  {
+    auto root = getMemoryManager()->addRootPool();
+    auto leaf = root->addLeafChild("noProfile", isLeafThreadSafe_);
+    leaf->free(leaf->allocate(128), 128);
+    ASSERT_TRUE(leaf->allocationProfile().empty());
+  }
+
+  setupMemory(
+      {.allocationProfileSampleRate = 2,
+       .allocatorCapacity = kDefaultCapacity,
+       .arbitratorCapacity = kDefaultCapacity});
+  auto root = getMemoryManager()->addRootPool();
+  auto leaf = root->addLeafChild("allocationProfile", isLeafThreadSafe_);
+  std::vector<void*> buffers;
+  for (auto i = 0; i < 10; ++i) {
+    buffers.push_back(leaf->allocate(100));
+  }
+  Allocation allocation;
+  leaf->allocateNonContiguous(4, allocation);
+  ContiguousAllocation contiguous;
+  leaf->allocateContiguous(4, contiguous);
+
+  auto profile = leaf->allocationProfile();
+  ASSERT_FALSE(profile.empty());
+  // Every second allocation is sampled.
+  ASSERT_EQ(profile.numAllocs[AllocationProfile::sizeBucket(100)], 5);
+  ASSERT_EQ(
+      profile.allocBytes[AllocationProfile::sizeBucket(100)],
+      5 * bits::roundUp(100, leaf->alignment()));
+  ASSERT_EQ(
+      profile.numAllocs[AllocationProfile::sizeBucket(
+          4 * AllocationTraits::kPageSize)],
+      1);
+  ASSERT_EQ(
+      std::accumulate(profile.numFrees.begin(), profile.numFrees.end(), 0), 0);
+
+  for (auto* buffer : buffers) {
+    leaf->free(buffer, 100);
+  }
+  leaf->freeNonContiguous(allocation);
+  leaf->freeContiguous(contiguous);
+  profile = leaf->allocationProfile();
+  // The sampled allocations are all short lived.
+  ASSERT_EQ(
+      std::accumulate(profile.numFrees.begin(), profile.numFrees.end(), 0), 6);
+  ASSERT_EQ(profile.numFrees.back(), 0);
+  ASSERT_EQ(
+      std::accumulate(profile.numAllocs.begin(), profile.numAllocs.end(), 0),
+      6);
+}
+
 TEST_P(MemoryPoolTest, DISABLED_memoryLeakCheck) {
   gflags::FlagSaver flagSaver;
   testing::FLAGS_gtest_death_test_style = "fast";
@@ -451,7 +451,8 @@ class MockSharedArbitrationTest : public testing::Test {
       bool globalArbitrationWithoutSpill = false,
       // Set the globalArbitrationAbortTimeRatio to be very small so that the
       // query can be aborted sooner and the test would not timeout.
-      double globalArbitrationAbortTimeRatio = 0.005) {
+      double globalArbitrationAbortTimeRatio = 0.005,
+      bool expectedCapacityAdmissionEnabled = false) {
     MemoryManagerOptions options;
     options.allocatorCapacity = memoryCapacity;
     std::string arbitratorKind = "SHARED";
@@ -488,7 +489,9 @@ class MockSharedArbitrationTest : public testing::Test {
         {std::string(ExtraConfig::kGlobalArbitrationWithoutSpill),
          folly::to<std::string>(globalArbitrationWithoutSpill)},
         {std::string(ExtraConfig::kGlobalArbitrationAbortTimeRatio),
-         folly::to<std::string>(globalArbitrationAbortTimeRatio)}};
+         folly::to<std::string>(globalArbitrationAbortTimeRatio)},
+        {std::string(ExtraConfig::kExpectedCapacityAdmissionEnabled),
+         folly::to<std::string>(expectedCapacityAdmissionEnabled)}};
     options.arbitrationStateCheckCb = std::move(arbitrationStateCheckCb);
     options.checkUsageLeak = true;
     manager_ = std::make_unique<MemoryManager>(options);
@@ -2213,6 +2216,80 @@ TEST_F(MockSharedArbitrationTest, maxCapacityReserve) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, reserveExpectedCapacity) {
+  setupMemory(256 << 20, 0, 32 << 20);
+  auto task1 = addTask();
+  ASSERT_EQ(task1->pool()->capacity(), 32 << 20);
+  ASSERT_EQ(
+      arbitrator_->reserveExpectedCapacity(task1->pool(), 128 << 20),
+      128 << 20);
+  // A smaller expected capacity doesn't shrink the pool.
+  ASSERT_EQ(
+      arbitrator_->reserveExpectedCapacity(task1->pool(), 64 << 20),
+      128 << 20);
+
+  // The reservation is capped by the pool max capacity.
+  auto task2 = addTask(64 << 20);
+  ASSERT_EQ(
+      arbitrator_->reserveExpectedCapacity(task2->pool(), 128 << 20), 64 << 20);
+
+  // The reservation is capped by the free capacity without reclaiming memory
+  // from other pools.
+  auto task3 = addTask();
+  ASSERT_EQ(task3->pool()->capacity(), 32 << 20);
+  ASSERT_EQ(
+      arbitrator_->reserveExpectedCapacity(task3->pool(), 256 << 20),
+      64 << 20);
+  ASSERT_EQ(arbitrator_->stats().freeCapacityBytes, 0);
+  ASSERT_EQ(task1->pool()->capacity(), 128 << 20);
+  ASSERT_EQ(task2->pool()->capacity(), 64 << 20);
+}
+
+TEST_F(MockSharedArbitrationTest, expectedCapacityAdmission) {
+  setupMemory(
+      256 << 20,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      kMemoryReclaimThreadsHwMultiplier,
+      nullptr,
+      true,
+      5 * 60 * 1'000'000'000UL,
+      false,
+      0.005,
+      /*expectedCapacityAdmissionEnabled=*/true);
+  auto task1 = addTask();
+  ASSERT_EQ(
+      arbitrator_->reserveExpectedCapacity(task1->pool(), 192 << 20),
+      192 << 20);
+  VELOX_ASSERT_THROW(
+      arbitrator_->reserveExpectedCapacity(task1->pool(), 192 << 20),
+      "has already been reserved");
+
+  // The second query waits for the first one to finish as both don't fit.
+  auto task2 = addTask();
+  std::atomic_bool admitted{false};
+  std::thread queryThread([&]() {
+    ASSERT_EQ(
+        arbitrator_->reserveExpectedCapacity(task2->pool(), 128 << 20),
+        128 << 20);
+    admitted = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(200)); // NOLINT
+  ASSERT_FALSE(admitted);
+  task1.reset();
+  queryThread.join();
+  ASSERT_TRUE(admitted);
+  ASSERT_EQ(task2->pool()->capacity(), 128 << 20);
+}
+
 TEST_F(MockSharedArbitrationTest, ensureMemoryPoolMaxCapacity) {
   const int memCapacity = 256 * MB;
   const int poolInitCapacity = 8 * MB;
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <array>
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::process {
+
+std::string PerfCounters::toString() const {
+  return fmt::format(
+      "cycles: {}, instructions: {}, llcMisses: {}, branchMisses: {}, "
+      "stalledCyclesBackend: {}",
+      cycles,
+      instructions,
+      llcMisses,
+      branchMisses,
+      stalledCyclesBackend);
+}
+
+#ifdef __linux__
+namespace {
+
+// The events in the order of the members of PerfCounters.
+constexpr std::array<uint64_t, 5> kEvents{
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_STALLED_CYCLES_BACKEND};
+
+int openEvent(uint64_t event, int groupFd) {
+  struct perf_event_attr attr {};
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = event;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+  // Counts the calling thread on any CPU.
+  return syscall(
+      SYS_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, groupFd, /*flags=*/0);
+}
+
+// The perf events of a thread, read together as a group led by the cycles
+// event.
+class ThreadPerfEvents {
+ public:
+  ThreadPerfEvents() {
+    for (size_t i = 0; i < kEvents.size(); ++i) {
+      fds_[i] = openEvent(kEvents[i], fds_[0]);
+      if (fds_[i] < 0) {
+        if (i == 0) {
+          // Without the group leader there is nothing to read.
+          LOG_FIRST_N(WARNING, 1)
+              << "Hardware performance counters are not available: "
+              << "perf_event_open failed with errno " << errno;
+          return;
+        }
+        // The CPU has no such event, e.g. no backend stall counter.
+        continue;
+      }
+      if (ioctl(fds_[i], PERF_EVENT_IOC_ID, &ids_[i]) != 0) {
+        ids_[i] = 0;
+      }
+    }
+  }
+
+  ~ThreadPerfEvents() {
+    for (auto fd : fds_) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+
+  std::optional<PerfCounters> read() const {
+    if (fds_[0] < 0) {
+      return std::nullopt;
+    }
+    // Layout of PERF_FORMAT_GROUP | PERF_FORMAT_ID: the number of events,
+    // then a value and an id per event.
+    std::array<uint64_t, 1 + 2 * kEvents.size()> buffer;
+    const auto size = ::read(fds_[0], buffer.data(), sizeof(buffer));
+    if (size < static_cast<ssize_t>(sizeof(uint64_t))) {
+      return std::nullopt;
+    }
+    std::array<uint64_t, kEvents.size()> values{};
+    for (size_t i = 0; i < buffer[0] && i < kEvents.size(); ++i) {
+      const auto value = buffer[1 + 2 * i];
+      const auto id = buffer[2 + 2 * i];
+      for (size_t j = 0; j < kEvents.size(); ++j) {
+        if (fds_[j] >= 0 && ids_[j] == id) {
+          values[j] = value;
+          break;
+        }
+      }
+    }
+    return PerfCounters{
+        .cycles = values[0],
+        .instructions = values[1],
+        .llcMisses = values[2],
+        .branchMisses = values[3],
+        .stalledCyclesBackend = values[4]};
+  }
+
+ private:
+  std::array<int, kEvents.size()> fds_{-1, -1, -1, -1, -1};
+  std::array<uint64_t, kEvents.size()> ids_{};
+};
+
+} // namespace
+
+std::optional<PerfCounters> readThreadPerfCounters() {
+  thread_local ThreadPerfEvents events;
+  return events.read();
+}
+#else
+std::optional<PerfCounters> readThreadPerfCounters() {
+  return std::nullopt;
+}
+#endif
+
+} // namespace facebook::velox::process
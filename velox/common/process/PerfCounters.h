@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace facebook::velox::process {
+
+/// Hardware performance counters of a thread. A counter the CPU or kernel
+/// does not support stays 0.
+struct PerfCounters {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  /// Last level cache misses.
+  uint64_t llcMisses{0};
+  uint64_t branchMisses{0};
+  /// Cycles stalled in the back end of the CPU, mostly waiting for memory.
+  uint64_t stalledCyclesBackend{0};
+
+  void add(const PerfCounters& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    llcMisses += other.llcMisses;
+    branchMisses += other.branchMisses;
+    stalledCyclesBackend += other.stalledCyclesBackend;
+  }
+
+  /// Returns the counts since 'start', read earlier on the same thread.
+  PerfCounters delta(const PerfCounters& start) const {
+    return {
+        .cycles = cycles - start.cycles,
+        .instructions = instructions - start.instructions,
+        .llcMisses = llcMisses - start.llcMisses,
+        .branchMisses = branchMisses - start.branchMisses,
+        .stalledCyclesBackend =
+            stalledCyclesBackend - start.stalledCyclesBackend};
+  }
+
+  void clear() {
+    *this = PerfCounters();
+  }
+
+  bool empty() const {
+    return cycles == 0 && instructions == 0;
+  }
+
+  std::string toString() const;
+};
+
+/// Returns the counters of the calling thread, counted in user space since
+/// the first call on the thread, which opens the perf events of the thread
+/// with perf_event_open. Returns std::nullopt if the events cannot be opened,
+/// e.g. on other systems than Linux, if the kernel.perf_event_paranoid
+/// setting forbids it or in a container without access to the PMU. Costs a
+/// system call.
+std::optional<PerfCounters> readThreadPerfCounters();
+
+} // namespace facebook::velox::process
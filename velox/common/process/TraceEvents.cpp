@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/TraceEvents.h"
+
+#include <chrono>
+
+#include <folly/json.h>
+#include <folly/system/ThreadId.h>
+
+namespace facebook::velox::process {
+
+namespace {
+thread_local TraceEventRecorder* threadTraceEventRecorder{nullptr};
+}
+
+void TraceEventRecorder::add(TraceEvent event) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() >= maxEvents_) {
+    ++numDropped_;
+    return;
+  }
+  events_.push_back(std::move(event));
+}
+
+std::vector<TraceEvent> TraceEventRecorder::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return events_;
+}
+
+uint64_t TraceEventRecorder::numDropped() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numDropped_;
+}
+
+std::string TraceEventRecorder::toChromeTrace(
+    const std::string& processName) const {
+  folly::dynamic traceEvents = folly::dynamic::array;
+  folly::dynamic processNameEvent = folly::dynamic::object;
+  processNameEvent["name"] = "process_name";
+  processNameEvent["ph"] = "M";
+  processNameEvent["pid"] = 0;
+  processNameEvent["args"] = folly::dynamic::object("name", processName);
+  traceEvents.push_back(std::move(processNameEvent));
+
+  uint64_t numDropped;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    numDropped = numDropped_;
+    for (const auto& event : events_) {
+      folly::dynamic obj = folly::dynamic::object;
+      obj["cat"] = event.category;
+      obj["name"] = event.name;
+      obj["pid"] = 0;
+      obj["tid"] = static_cast<int64_t>(event.osThreadId);
+      obj["ts"] = static_cast<int64_t>(event.startUs);
+      if (event.durationUs.has_value()) {
+        obj["ph"] = "X";
+        obj["dur"] = static_cast<int64_t>(event.durationUs.value());
+      } else {
+        obj["ph"] = "i";
+        // Instant events are drawn on their thread.
+        obj["s"] = "t";
+      }
+      if (!event.detail.empty()) {
+        obj["args"] = folly::dynamic::object("detail", event.detail);
+      }
+      traceEvents.push_back(std::move(obj));
+    }
+  }
+
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(traceEvents);
+  trace["displayTimeUnit"] = "ms";
+  trace["otherData"] = folly::dynamic::object(
+      "droppedEvents", static_cast<int64_t>(numDropped));
+  return folly::toJson(trace);
+}
+
+TraceEventRecorder* currentTraceEventRecorder() {
+  return threadTraceEventRecorder;
+}
+
+ScopedTraceEventRecorder::ScopedTraceEventRecorder(
+    TraceEventRecorder* recorder)
+    : prevRecorder_(threadTraceEventRecorder) {
+  threadTraceEventRecorder = recorder;
+}
+
+ScopedTraceEventRecorder::~ScopedTraceEventRecorder() {
+  threadTraceEventRecorder = prevRecorder_;
+}
+
+uint64_t traceEventTimeUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void TraceSpan::record() {
+  const auto endUs = traceEventTimeUs();
+  recorder_->add(
+      {category_,
+       name_,
+       std::move(detail_),
+       startUs_,
+       endUs - startUs_,
+       folly::getOSThreadID()});
+}
+
+void addTraceEvent(
+    TraceEventRecorder* recorder,
+    const char* category,
+    const char* name,
+    std::string detail) {
+  recorder->add(
+      {category,
+       name,
+       std::move(detail),
+       traceEventTimeUs(),
+       std::nullopt,
+       folly::getOSThreadID()});
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifdef VELOX_ENABLE_TRACE_PROBES
+#include <folly/tracing/StaticTracepoint.h>
+
+/// Fires the USDT probe velox:'_name' with up to 8 integer or pointer
+/// arguments, e.g. for bpftrace or perf. Compiled out unless Velox is built
+/// with VELOX_ENABLE_TRACE_PROBES. A probe costs a nop when no tracer is
+/// attached.
+#define VELOX_TRACE_PROBE(_name, ...) FOLLY_SDT(velox, _name, ##__VA_ARGS__)
+#else
+#define VELOX_TRACE_PROBE(_name, ...) \
+  do {                                \
+  } while (false)
+#endif
+
+namespace facebook::velox::process {
+
+/// A timed event on a thread, in the Chrome trace event format.
+struct TraceEvent {
+  /// 'category' and 'name' are string literals.
+  const char* category;
+  const char* name;
+  std::string detail;
+  /// Microseconds since an arbitrary and fixed point in time.
+  uint64_t startUs;
+  /// The duration of a span or std::nullopt for an instant event.
+  std::optional<uint64_t> durationUs;
+  uint64_t osThreadId;
+};
+
+/// Collects the TraceEvents of a Task. Thread-safe. Keeps the first
+/// 'maxEvents' events and counts the dropped ones. Callbacks on threads that
+/// do not run the Task, e.g. of an exchange response, reference it with
+/// weak_from_this().
+class TraceEventRecorder
+    : public std::enable_shared_from_this<TraceEventRecorder> {
+ public:
+  explicit TraceEventRecorder(uint64_t maxEvents) : maxEvents_(maxEvents) {}
+
+  void add(TraceEvent event);
+
+  std::vector<TraceEvent> events() const;
+
+  uint64_t numDropped() const;
+
+  /// Returns the events in the JSON trace event format of Chrome, which the
+  /// Perfetto UI and chrome://tracing load. 'processName' names the events.
+  std::string toChromeTrace(const std::string& processName) const;
+
+ private:
+  const uint64_t maxEvents_;
+
+  mutable std::mutex mutex_;
+  std::vector<TraceEvent> events_;
+  uint64_t numDropped_{0};
+};
+
+/// Returns the recorder of the events on the calling thread or nullptr if
+/// the thread does not record them.
+TraceEventRecorder* currentTraceEventRecorder();
+
+/// Sets the recorder of the events on the calling thread for the lifetime of
+/// 'this'. 'recorder' may be nullptr.
+class ScopedTraceEventRecorder {
+ public:
+  explicit ScopedTraceEventRecorder(TraceEventRecorder* recorder);
+
+  ~ScopedTraceEventRecorder();
+
+  ScopedTraceEventRecorder(const ScopedTraceEventRecorder&) = delete;
+  ScopedTraceEventRecorder& operator=(const ScopedTraceEventRecorder&) =
+      delete;
+
+ private:
+  TraceEventRecorder* const prevRecorder_;
+};
+
+/// Returns the time of TraceEvent::startUs.
+uint64_t traceEventTimeUs();
+
+/// Records a span from the construction to the destruction of 'this' to the
+/// recorder of the thread, if any, and fires the velox:span_begin and
+/// velox:span_end probes with 'category' and 'name'. 'detail' returns the
+/// detail of the event and is only called when a recorder is set.
+class TraceSpan {
+ public:
+  template <typename DetailFunc>
+  TraceSpan(const char* category, const char* name, DetailFunc&& detail)
+      : recorder_(currentTraceEventRecorder()),
+        category_(category),
+        name_(name) {
+    VELOX_TRACE_PROBE(span_begin, category_, name_);
+    if (recorder_ != nullptr) {
+      detail_ = detail();
+      startUs_ = traceEventTimeUs();
+    }
+  }
+
+  TraceSpan(const char* category, const char* name)
+      : TraceSpan(category, name, []() { return std::string(); }) {}
+
+  ~TraceSpan() {
+    VELOX_TRACE_PROBE(span_end, category_, name_);
+    if (recorder_ != nullptr) {
+      record();
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+ private:
+  void record();
+
+  TraceEventRecorder* const recorder_;
+  const char* const category_;
+  const char* const name_;
+  std::string detail_;
+  uint64_t startUs_{0};
+};
+
+/// Adds an instant event to 'recorder'.
+void addTraceEvent(
+    TraceEventRecorder* recorder,
+    const char* category,
+    const char* name,
+    std::string detail);
+
+/// Records an instant event to the recorder of the thread, if any, and fires
+/// the velox:event probe with 'category' and 'name'. 'detail' is only called
+/// when a recorder is set.
+template <typename DetailFunc>
+void addTraceEvent(
+    const char* category,
+    const char* name,
+    DetailFunc&& detail) {
+  VELOX_TRACE_PROBE(event, category, name);
+  if (auto* recorder = currentTraceEventRecorder()) {
+    addTraceEvent(recorder, category, name, detail());
+  }
+}
+
+} // namespace facebook::velox::process
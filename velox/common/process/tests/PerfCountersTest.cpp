@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::process;
+
+namespace {
+
+TEST(PerfCountersTest, addAndDelta) {
+  PerfCounters start{
+      .cycles = 100,
+      .instructions = 200,
+      .llcMisses = 3,
+      .branchMisses = 4,
+      .stalledCyclesBackend = 50};
+  PerfCounters end{
+      .cycles = 300,
+      .instructions = 700,
+      .llcMisses = 5,
+      .branchMisses = 10,
+      .stalledCyclesBackend = 80};
+  auto delta = end.delta(start);
+  ASSERT_EQ(delta.cycles, 200);
+  ASSERT_EQ(delta.instructions, 500);
+  ASSERT_EQ(delta.llcMisses, 2);
+  ASSERT_EQ(delta.branchMisses, 6);
+  ASSERT_EQ(delta.stalledCyclesBackend, 30);
+
+  delta.add(start);
+  ASSERT_EQ(delta.cycles, 300);
+  ASSERT_EQ(delta.stalledCyclesBackend, 80);
+  ASSERT_EQ(
+      delta.toString(),
+      "cycles: 300, instructions: 700, llcMisses: 5, branchMisses: 10, "
+      "stalledCyclesBackend: 80");
+
+  ASSERT_FALSE(delta.empty());
+  delta.clear();
+  ASSERT_TRUE(delta.empty());
+}
+
+TEST(PerfCountersTest, readThread) {
+  const auto start = readThreadPerfCounters();
+  if (!start.has_value()) {
+    GTEST_SKIP() << "Hardware performance counters are not available";
+  }
+  volatile uint64_t sum = 0;
+  for (auto i = 0; i < 1'000'000; ++i) {
+    sum = sum + i;
+  }
+  const auto end = readThreadPerfCounters();
+  ASSERT_TRUE(end.has_value());
+  const auto delta = end->delta(start.value());
+  ASSERT_GT(delta.cycles, 0);
+  ASSERT_GT(delta.instructions, 1'000'000);
+
+  // Each thread has its own events.
+  std::thread([]() {
+    const auto counters = readThreadPerfCounters();
+    ASSERT_TRUE(counters.has_value());
+    ASSERT_LT(counters->instructions, 1'000'000);
+  }).join();
+}
+
+} // namespace
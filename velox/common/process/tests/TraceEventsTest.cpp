@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/TraceEvents.h"
+
+#include <folly/json.h>
+#include <folly/system/ThreadId.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(TraceEventsTest, noRecorder) {
+  ASSERT_EQ(currentTraceEventRecorder(), nullptr);
+  bool detailCalled{false};
+  {
+    TraceSpan span("test", "span", [&]() {
+      detailCalled = true;
+      return std::string("detail");
+    });
+    addTraceEvent("test", "event", [&]() {
+      detailCalled = true;
+      return std::string("detail");
+    });
+  }
+  ASSERT_FALSE(detailCalled);
+}
+
+TEST(TraceEventsTest, record) {
+  auto recorder = std::make_shared<TraceEventRecorder>(100);
+  {
+    ScopedTraceEventRecorder scopedRecorder(recorder.get());
+    ASSERT_EQ(currentTraceEventRecorder(), recorder.get());
+    {
+      ScopedTraceEventRecorder nestedRecorder(nullptr);
+      TraceSpan span("test", "ignored");
+    }
+    ASSERT_EQ(currentTraceEventRecorder(), recorder.get());
+    {
+      TraceSpan span("test", "span", []() { return std::string("outer"); });
+      std::this_thread::sleep_for(std::chrono::milliseconds(2)); // NOLINT
+      addTraceEvent("test", "event", []() { return std::string("inner"); });
+    }
+    // Events of other threads go to their own recorder.
+    std::thread([&]() {
+      ASSERT_EQ(currentTraceEventRecorder(), nullptr);
+      ScopedTraceEventRecorder threadRecorder(recorder.get());
+      addTraceEvent("test", "thread", []() { return std::string(); });
+    }).join();
+  }
+  ASSERT_EQ(currentTraceEventRecorder(), nullptr);
+
+  const auto events = recorder->events();
+  ASSERT_EQ(events.size(), 3);
+  ASSERT_STREQ(events[0].name, "event");
+  ASSERT_EQ(events[0].detail, "inner");
+  ASSERT_FALSE(events[0].durationUs.has_value());
+  ASSERT_EQ(events[0].osThreadId, folly::getOSThreadID());
+
+  ASSERT_STREQ(events[1].category, "test");
+  ASSERT_STREQ(events[1].name, "span");
+  ASSERT_EQ(events[1].detail, "outer");
+  ASSERT_GE(events[1].durationUs.value(), 2'000);
+  ASSERT_LE(events[1].startUs, events[0].startUs);
+  ASSERT_GE(
+      events[1].startUs + events[1].durationUs.value(), events[0].startUs);
+
+  ASSERT_STREQ(events[2].name, "thread");
+  ASSERT_NE(events[2].osThreadId, folly::getOSThreadID());
+  ASSERT_EQ(recorder->numDropped(), 0);
+}
+
+TEST(TraceEventsTest, maxEvents) {
+  TraceEventRecorder recorder(2);
+  for (int i = 0; i < 5; ++i) {
+    addTraceEvent(&recorder, "test", "event", std::to_string(i));
+  }
+  ASSERT_EQ(recorder.events().size(), 2);
+  ASSERT_EQ(recorder.events()[1].detail, "1");
+  ASSERT_EQ(recorder.numDropped(), 3);
+}
+
+TEST(TraceEventsTest, chromeTrace) {
+  TraceEventRecorder recorder(1);
+  {
+    ScopedTraceEventRecorder scopedRecorder(&recorder);
+    TraceSpan span("driver", "run", []() { return std::string("driver 0"); });
+  }
+  addTraceEvent(&recorder, "driver", "dropped", "");
+
+  const auto trace = folly::parseJson(recorder.toChromeTrace("task-1"));
+  ASSERT_EQ(trace["otherData"]["droppedEvents"].asInt(), 1);
+  const auto& events = trace["traceEvents"];
+  ASSERT_EQ(events.size(), 2);
+  ASSERT_EQ(events[0]["ph"].asString(), "M");
+  ASSERT_EQ(events[0]["args"]["name"].asString(), "task-1");
+  const auto& span = events[1];
+  ASSERT_EQ(span["ph"].asString(), "X");
+  ASSERT_EQ(span["cat"].asString(), "driver");
+  ASSERT_EQ(span["name"].asString(), "run");
+  ASSERT_EQ(span["args"]["detail"].asString(), "driver 0");
+  ASSERT_EQ(span["tid"].asInt(), folly::getOSThreadID());
+  ASSERT_GE(span["dur"].asInt(), 0);
+}
+
+} // namespace
+} // namespace facebook::velox::process
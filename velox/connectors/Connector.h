@@ -64,6 +64,10 @@ struct ConnectorSplit : public ISerializable {
 
   std::unique_ptr<AsyncSource<DataSource>> dataSource;
 
+  /// True if Connector::preopenSplit() has been scheduled for 'this'. Set
+  /// under the Task's lock.
+  bool preopenIssued{false};
+
   explicit ConnectorSplit(
       const std::string& _connectorId,
       int64_t _splitWeight = 0,
@@ -86,6 +90,14 @@ struct ConnectorSplit : public ISerializable {
         splitWeight,
         cacheable ? "true" : "false");
   }
+
+  /// Returns a key that identifies the data read by 'this' and changes when
+  /// the data changes, e.g. the file, byte range and file modification time.
+  /// Used for caching results computed from the split across queries. Returns
+  /// std::nullopt if the data of the split cannot be identified.
+  virtual std::optional<std::string> cacheKey() const {
+    return std::nullopt;
+  }
 };
 
 class ColumnHandle : public ISerializable {
@@ -263,6 +275,13 @@ class DataSource {
 
   virtual std::unordered_map<std::string, RuntimeCounter> runtimeStats() = 0;
 
+  /// Returns the total wall time in nanoseconds that the threads reading from
+  /// 'this' waited for IO so far. TableScan reports its growth over each
+  /// split. 0 if the source does not track it.
+  virtual uint64_t ioWaitNanos() {
+    return 0;
+  }
+
   /// Returns true if 'this' has initiated all the prefetch this will initiate.
   /// This means that the caller should schedule next splits to prefetch in the
   /// background. false if the source does not prefetch.
@@ -560,6 +579,13 @@ class Connector {
     return false;
   }
 
+  /// Opens the files 'split' reads ahead of its processing, e.g. to have the
+  /// file handles and sizes in a cache when the split is added to a
+  /// DataSource. Runs on executor() for queued splits that are not yet
+  /// preloaded. Must not throw. No-op by default.
+  virtual void preopenSplit(
+      const std::shared_ptr<ConnectorSplit>& /*split*/) {}
+
   /// Returns true if the connector supports index lookup, otherwise false.
   virtual bool supportsIndexLookup() const {
     return false;
@@ -625,10 +651,13 @@ class Connector {
   /// Returns a ScanTracker for 'id'. 'id' uniquely identifies the
   /// tracker and different threads will share the same
   /// instance. 'loadQuantum' is the largest single IO for the query
-  /// being tracked.
+  /// being tracked. 'historyKey' identifies the table for starting the
+  /// tracker with the access history of earlier scans, see
+  /// cache::ScanHistory.
   static std::shared_ptr<cache::ScanTracker> getTracker(
       const std::string& scanId,
-      int32_t loadQuantum);
+      int32_t loadQuantum,
+      const std::string& historyKey = "");
 
   virtual folly::Executor* executor() const {
     return nullptr;
@@ -39,10 +39,50 @@ std::string groupName(const std::string& filename) {
 }
 } // namespace
 
+void FileHandleGenerator::checkNotFound(const std::string& filename) {
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> l(notFoundMutex_);
+    auto it = notFound_.find(filename);
+    if (it == notFound_.end()) {
+      return;
+    }
+    if (it->second.expirationTimeMs <= getCurrentTimeMs()) {
+      notFound_.erase(it);
+      return;
+    }
+    error = it->second.error;
+  }
+  std::rethrow_exception(error);
+}
+
+void FileHandleGenerator::addNotFound(
+    const std::string& filename,
+    std::exception_ptr error) {
+  const auto nowMs = getCurrentTimeMs();
+  std::lock_guard<std::mutex> l(notFoundMutex_);
+  if (notFound_.size() >= kMaxNotFound) {
+    for (auto it = notFound_.begin(); it != notFound_.end();) {
+      if (it->second.expirationTimeMs <= nowMs) {
+        it = notFound_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (notFound_.size() >= kMaxNotFound) {
+      notFound_.clear();
+    }
+  }
+  notFound_[filename] = {nowMs + notFoundTtlMs_, std::move(error)};
+}
+
 std::unique_ptr<FileHandle> FileHandleGenerator::operator()(
     const std::string& filename,
     const FileProperties* properties,
     filesystems::File::IoStats* stats) {
+  if (notFoundTtlMs_ > 0) {
+    checkNotFound(filename);
+  }
   // We have seen cases where drivers are stuck when creating file handles.
   // Adding a trace here to spot this more easily in future.
   process::TraceContext trace("FileHandleGenerator::operator()");
@@ -58,8 +98,15 @@ std::unique_ptr<FileHandle> FileHandleGenerator::operator()(
       options.readRangeHint = properties->readRangeHint;
       options.extraFileInfo = properties->extraFileInfo;
     }
-    fileHandle->file = filesystems::getFileSystem(filename, properties_)
-                           ->openFileForRead(filename, options);
+    try {
+      fileHandle->file = filesystems::getFileSystem(filename, properties_)
+                             ->openFileForRead(filename, options);
+    } catch (const VeloxRuntimeError& e) {
+      if (notFoundTtlMs_ > 0 && e.errorCode() == error_code::kFileNotFound) {
+        addNotFound(filename, std::current_exception());
+      }
+      throw;
+    }
     fileHandle->uuid = StringIdLease(fileIds(), filename);
     fileHandle->groupId = StringIdLease(fileIds(), groupName(filename));
     VLOG(1) << "Generating file handle for: " << filename
@@ -25,6 +25,9 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+#include <mutex>
+
 #include "velox/common/caching/CachedFactory.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/config/Config.h"
@@ -62,18 +65,40 @@ struct FileHandleSizer {
 using FileHandleCache = SimpleLRUCache<std::string, FileHandle>;
 
 // Creates FileHandles via the Generator interface the CachedFactory requires.
+// If 'notFoundTtlMs' is > 0, a file that was not found is remembered for so
+// many ms and opening it again rethrows the error without accessing the file
+// system. This saves the round trips to object stores for missing files that
+// are opened for many splits or by split preopening and then by the scan.
 class FileHandleGenerator {
  public:
   FileHandleGenerator() {}
-  FileHandleGenerator(std::shared_ptr<const config::ConfigBase> properties)
-      : properties_(std::move(properties)) {}
+  FileHandleGenerator(
+      std::shared_ptr<const config::ConfigBase> properties,
+      uint64_t notFoundTtlMs = 0)
+      : properties_(std::move(properties)), notFoundTtlMs_(notFoundTtlMs) {}
   std::unique_ptr<FileHandle> operator()(
       const std::string& filename,
       const FileProperties* properties,
       filesystems::File::IoStats* stats);
 
  private:
+  // Maximum number of remembered missing files.
+  static constexpr int32_t kMaxNotFound = 10'000;
+
+  struct NotFound {
+    uint64_t expirationTimeMs;
+    std::exception_ptr error;
+  };
+
+  // Rethrows the error of a recent open of 'filename' that did not find it.
+  void checkNotFound(const std::string& filename);
+
+  void addNotFound(const std::string& filename, std::exception_ptr error);
+
   const std::shared_ptr<const config::ConfigBase> properties_;
+  const uint64_t notFoundTtlMs_{0};
+  std::mutex notFoundMutex_;
+  folly::F14FastMap<std::string, NotFound> notFound_;
 };
 
 using FileHandleFactory = CachedFactory<
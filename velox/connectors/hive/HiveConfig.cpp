@@ -93,6 +93,13 @@ bool HiveConfig::isOrcUseColumnNames(const config::ConfigBase* session) const {
       kOrcUseColumnNamesSession, config_->get<bool>(kOrcUseColumnNames, false));
 }
 
+bool HiveConfig::isOrcBloomFilterPruningEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kOrcBloomFilterPruningEnabledSession,
+      config_->get<bool>(kOrcBloomFilterPruningEnabled, false));
+}
+
 bool HiveConfig::isParquetUseColumnNames(
     const config::ConfigBase* session) const {
   return session->get<bool>(
@@ -100,6 +107,27 @@ bool HiveConfig::isParquetUseColumnNames(
       config_->get<bool>(kParquetUseColumnNames, false));
 }
 
+bool HiveConfig::isParquetBloomFilterPruningEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kParquetBloomFilterPruningEnabledSession,
+      config_->get<bool>(kParquetBloomFilterPruningEnabled, false));
+}
+
+bool HiveConfig::isParquetDictionaryFilterEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kParquetDictionaryFilterEnabledSession,
+      config_->get<bool>(kParquetDictionaryFilterEnabled, false));
+}
+
+bool HiveConfig::isAdaptiveCoalescingEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kAdaptiveCoalescingEnabledSession,
+      config_->get<bool>(kAdaptiveCoalescingEnabled, false));
+}
+
 bool HiveConfig::isFileColumnNamesReadAsLowerCase(
     const config::ConfigBase* session) const {
   return session->get<bool>(
@@ -162,10 +190,38 @@ uint64_t HiveConfig::fileHandleExpirationDurationMs() const {
   return config_->get<uint64_t>(kFileHandleExpirationDurationMs, 0);
 }
 
+uint64_t HiveConfig::fileHandleNotFoundTtlMs() const {
+  return config_->get<uint64_t>(kFileHandleNotFoundTtlMs, 0);
+}
+
 bool HiveConfig::isFileHandleCacheEnabled() const {
   return config_->get<bool>(kEnableFileHandleCache, true);
 }
 
+uint64_t HiveConfig::fileMetadataCacheBytes() const {
+  return config::toCapacity(
+      config_->get<std::string>(kFileMetadataCacheBytes, "0B"),
+      config::CapacityUnit::BYTE);
+}
+
+uint64_t HiveConfig::fileStatsCacheEntries() const {
+  return config_->get<uint64_t>(kFileStatsCacheEntries, 0);
+}
+
+uint64_t HiveConfig::decodedDictionaryCacheBytes() const {
+  return config::toCapacity(
+      config_->get<std::string>(kDecodedDictionaryCacheBytes, "0B"),
+      config::CapacityUnit::BYTE);
+}
+
+bool HiveConfig::isScanHistoryEnabled() const {
+  return config_->get<bool>(kScanHistoryEnabled, false);
+}
+
+std::string HiveConfig::scanHistoryFilePath() const {
+  return config_->get<std::string>(kScanHistoryFilePath, "");
+}
+
 std::string HiveConfig::writeFileCreateConfig() const {
   return config_->get<std::string>(kWriteFileCreateConfig, "");
 }
@@ -193,6 +249,22 @@ uint64_t HiveConfig::sortWriterFinishTimeSliceLimitMs(
       config_->get<uint64_t>(kSortWriterFinishTimeSliceLimitMs, 5'000));
 }
 
+uint32_t HiveConfig::maxParallelPartitionWriters(
+    const config::ConfigBase* session) const {
+  return session->get<uint32_t>(
+      kMaxParallelPartitionWritersSession,
+      config_->get<uint32_t>(kMaxParallelPartitionWriters, 1));
+}
+
+uint64_t HiveConfig::partitionWritersMemoryBudget(
+    const config::ConfigBase* session) const {
+  return config::toCapacity(
+      session->get<std::string>(
+          kPartitionWritersMemoryBudgetSession,
+          config_->get<std::string>(kPartitionWritersMemoryBudget, "0B")),
+      config::CapacityUnit::BYTE);
+}
+
 uint64_t HiveConfig::footerEstimatedSize() const {
   return config_->get<uint64_t>(kFooterEstimatedSize, 256UL << 10);
 }
@@ -225,6 +297,13 @@ bool HiveConfig::readStatsBasedFilterReorderDisabled(
       config_->get<bool>(kReadStatsBasedFilterReorderDisabled, false));
 }
 
+bool HiveConfig::readFunctionFilterPushdownEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kReadFunctionFilterPushdownEnabledSession,
+      config_->get<bool>(kReadFunctionFilterPushdownEnabled, false));
+}
+
 std::string HiveConfig::hiveLocalDataPath() const {
   return config_->get<std::string>(kLocalDataPath, "");
 }
@@ -74,12 +74,33 @@ class HiveConfig {
   static constexpr const char* kOrcUseColumnNamesSession =
       "hive_orc_use_column_names";
 
+  /// Eliminates row groups of ORC and DWRF stripes by checking equality and IN
+  /// filters against the Bloom filters of their columns.
+  static constexpr const char* kOrcBloomFilterPruningEnabled =
+      "hive.orc.reader.bloom-filter-pruning-enabled";
+  static constexpr const char* kOrcBloomFilterPruningEnabledSession =
+      "hive.orc.reader.bloom_filter_pruning_enabled";
+
   /// Maps table field names to file field names using names, not indices.
   static constexpr const char* kParquetUseColumnNames =
       "hive.parquet.use-column-names";
   static constexpr const char* kParquetUseColumnNamesSession =
       "parquet_use_column_names";
 
+  /// Eliminates Parquet row groups by checking equality and IN filters against
+  /// the Bloom filters of their column chunks.
+  static constexpr const char* kParquetBloomFilterPruningEnabled =
+      "hive.parquet.reader.bloom-filter-pruning-enabled";
+  static constexpr const char* kParquetBloomFilterPruningEnabledSession =
+      "hive.parquet.reader.bloom_filter_pruning_enabled";
+
+  /// Evaluates filters once per dictionary of dictionary encoded Parquet column
+  /// chunks and skips the chunks where no dictionary entry passes.
+  static constexpr const char* kParquetDictionaryFilterEnabled =
+      "hive.parquet.reader.dictionary-filter-enabled";
+  static constexpr const char* kParquetDictionaryFilterEnabledSession =
+      "hive.parquet.reader.dictionary_filter_enabled";
+
   /// Reads the source file column name as lower case.
   static constexpr const char* kFileColumnNamesReadAsLowerCase =
       "file-column-names-read-as-lower-case";
@@ -109,6 +130,13 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceSession =
       "orc_max_merge_distance";
 
+  /// Tunes the max coalesce distance to the request latency and throughput
+  /// measured for each file system instead of using max-coalesced-distance.
+  static constexpr const char* kAdaptiveCoalescingEnabled =
+      "adaptive-coalescing-enabled";
+  static constexpr const char* kAdaptiveCoalescingEnabledSession =
+      "adaptive_coalescing_enabled";
+
   /// The number of prefetch rowgroups
   static constexpr const char* kPrefetchRowGroups = "prefetch-rowgroups";
 
@@ -126,10 +154,42 @@ class HiveConfig {
   static constexpr const char* kFileHandleExpirationDurationMs =
       "file-handle-expiration-duration-ms";
 
+  /// Time in ms for which a file that was not found is remembered by the file
+  /// handle generator. Opening the file again within this time fails without
+  /// accessing the file system. 0 disables remembering missing files.
+  static constexpr const char* kFileHandleNotFoundTtlMs =
+      "file-handle-not-found-ttl-ms";
+
   /// Enable file handle cache.
   static constexpr const char* kEnableFileHandleCache =
       "file-handle-cache-enabled";
 
+  /// Maximum bytes of parsed file footers kept in the process-wide file
+  /// metadata cache shared by all splits of a file. 0 disables the cache.
+  static constexpr const char* kFileMetadataCacheBytes =
+      "file-metadata-cache-bytes";
+
+  /// Maximum number of files whose file-level column statistics are kept to
+  /// prune later splits of the files before opening them. 0 disables the
+  /// cache.
+  static constexpr const char* kFileStatsCacheEntries =
+      "file-stats-cache-entries";
+
+  /// Maximum bytes of decoded DWRF and ORC stripe string dictionaries kept in
+  /// the process-wide cache shared by all splits of a file. 0 disables the
+  /// cache.
+  static constexpr const char* kDecodedDictionaryCacheBytes =
+      "decoded-dictionary-cache-bytes";
+
+  /// Keeps the column access statistics of finished table scans, so that
+  /// later scans of the same table start with the prefetch decisions of
+  /// earlier ones.
+  static constexpr const char* kScanHistoryEnabled = "scan-history-enabled";
+
+  /// Local file the scan history is loaded from and saved to, so that it
+  /// survives restarts. The history is kept in memory only if empty.
+  static constexpr const char* kScanHistoryFilePath = "scan-history-file-path";
+
   /// The size in bytes to be fetched with Meta data together, used when the
   /// data after meta data will be used later. Optimization to decrease small IO
   /// request
@@ -164,6 +224,24 @@ class HiveConfig {
   static constexpr const char* kSortWriterFinishTimeSliceLimitMsSession =
       "sort_writer_finish_time_slice_limit_ms";
 
+  /// Maximum number of threads of the connector executor that write the
+  /// partitions of one input of a partitioned or bucketed HiveDataSink
+  /// concurrently. Sorted writers also finish concurrently. 1 writes all
+  /// partitions on the driver thread.
+  static constexpr const char* kMaxParallelPartitionWriters =
+      "max-parallel-partition-writers";
+  static constexpr const char* kMaxParallelPartitionWritersSession =
+      "max_parallel_partition_writers";
+
+  /// Memory budget shared by the open writers of a HiveDataSink. When the
+  /// writers hold more memory, the writers with the most memory flush their
+  /// buffered data, or spill it if they sort, until they are within the
+  /// budget. Zero means no budget.
+  static constexpr const char* kPartitionWritersMemoryBudget =
+      "partition-writers-memory-budget";
+  static constexpr const char* kPartitionWritersMemoryBudgetSession =
+      "partition_writers_memory_budget";
+
   // The unit for reading timestamps from files.
   static constexpr const char* kReadTimestampUnit =
       "hive.reader.timestamp-unit";
@@ -180,6 +258,13 @@ class HiveConfig {
   static constexpr const char* kReadStatsBasedFilterReorderDisabledSession =
       "stats_based_filter_reorder_disabled";
 
+  /// Whether to push single column function conjuncts of the remaining filter
+  /// into the readers as pre-filters.
+  static constexpr const char* kReadFunctionFilterPushdownEnabled =
+      "hive.reader.function-filter-pushdown-enabled";
+  static constexpr const char* kReadFunctionFilterPushdownEnabledSession =
+      "hive.reader.function_filter_pushdown_enabled";
+
   static constexpr const char* kLocalDataPath = "hive_local_data_path";
   static constexpr const char* kLocalFileFormat = "hive_local_file_format";
 
@@ -200,8 +285,16 @@ class HiveConfig {
 
   bool isOrcUseColumnNames(const config::ConfigBase* session) const;
 
+  bool isOrcBloomFilterPruningEnabled(const config::ConfigBase* session) const;
+
   bool isParquetUseColumnNames(const config::ConfigBase* session) const;
 
+  bool isParquetBloomFilterPruningEnabled(
+      const config::ConfigBase* session) const;
+
+  bool isParquetDictionaryFilterEnabled(
+      const config::ConfigBase* session) const;
+
   bool isFileColumnNamesReadAsLowerCase(
       const config::ConfigBase* session) const;
 
@@ -215,6 +308,8 @@ class HiveConfig {
 
   int32_t maxCoalescedDistanceBytes(const config::ConfigBase* session) const;
 
+  bool isAdaptiveCoalescingEnabled(const config::ConfigBase* session) const;
+
   int32_t prefetchRowGroups() const;
 
   int32_t loadQuantum(const config::ConfigBase* session) const;
@@ -223,8 +318,20 @@ class HiveConfig {
 
   uint64_t fileHandleExpirationDurationMs() const;
 
+  uint64_t fileHandleNotFoundTtlMs() const;
+
   bool isFileHandleCacheEnabled() const;
 
+  uint64_t fileMetadataCacheBytes() const;
+
+  uint64_t fileStatsCacheEntries() const;
+
+  uint64_t decodedDictionaryCacheBytes() const;
+
+  bool isScanHistoryEnabled() const;
+
+  std::string scanHistoryFilePath() const;
+
   uint64_t fileWriterFlushThresholdBytes() const;
 
   std::string writeFileCreateConfig() const;
@@ -236,6 +343,11 @@ class HiveConfig {
   uint64_t sortWriterFinishTimeSliceLimitMs(
       const config::ConfigBase* session) const;
 
+  uint32_t maxParallelPartitionWriters(const config::ConfigBase* session) const;
+
+  uint64_t partitionWritersMemoryBudget(
+      const config::ConfigBase* session) const;
+
   uint64_t footerEstimatedSize() const;
 
   uint64_t filePreloadThreshold() const;
@@ -252,6 +364,11 @@ class HiveConfig {
   bool readStatsBasedFilterReorderDisabled(
       const config::ConfigBase* session) const;
 
+  /// Returns true if single column function conjuncts of the remaining filter
+  /// are also evaluated by the readers.
+  bool readFunctionFilterPushdownEnabled(
+      const config::ConfigBase* session) const;
+
   /// Returns the file system path containing local data. If non-empty,
   /// initializes LocalHiveConnectorMetadata to provide metadata for the tables
   /// in the directory.
@@ -17,6 +17,9 @@
 #include "velox/connectors/hive/HiveConnector.h"
 
 #include "velox/common/base/Fs.h"
+#include "velox/common/caching/ScanHistory.h"
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/dwrf/reader/DecodedDictionaryCache.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveDataSink.h"
 #include "velox/connectors/hive/HiveDataSource.h"
@@ -50,7 +53,10 @@ HiveConnector::HiveConnector(
               ? std::make_unique<SimpleLRUCache<std::string, FileHandle>>(
                     hiveConfig_->numCacheFileHandles())
               : nullptr,
-          std::make_unique<FileHandleGenerator>(config)),
+          std::make_unique<FileHandleGenerator>(
+              config,
+              hiveConfig_->fileHandleNotFoundTtlMs())),
+      splitPruner_(hiveConfig_->fileStatsCacheEntries()),
       executor_(executor) {
   if (hiveConfig_->isFileHandleCacheEnabled()) {
     LOG(INFO) << "Hive connector " << connectorId()
@@ -62,6 +68,17 @@ HiveConnector::HiveConnector(
     LOG(INFO) << "Hive connector " << connectorId()
               << " created with file handle cache disabled";
   }
+  if (hiveConfig_->fileMetadataCacheBytes() > 0) {
+    dwio::common::FileMetadataCache::create(
+        hiveConfig_->fileMetadataCacheBytes());
+  }
+  if (hiveConfig_->decodedDictionaryCacheBytes() > 0) {
+    dwrf::DecodedDictionaryCache::create(
+        hiveConfig_->decodedDictionaryCacheBytes());
+  }
+  if (hiveConfig_->isScanHistoryEnabled()) {
+    cache::ScanHistory::create(hiveConfig_->scanHistoryFilePath());
+  }
   for (auto& factory : hiveConnectorMetadataFactories()) {
     metadata_ = factory->create(this);
     if (metadata_ != nullptr) {
@@ -84,7 +101,30 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       &fileHandleFactory_,
       executor_,
       connectorQueryCtx,
-      hiveConfig_);
+      hiveConfig_,
+      &splitPruner_);
+}
+
+void HiveConnector::preopenSplit(
+    const std::shared_ptr<ConnectorSplit>& split) {
+  // Without the cache the handle would not be kept for the scan.
+  if (!hiveConfig_->isFileHandleCacheEnabled()) {
+    return;
+  }
+  auto hiveSplit = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
+  if (hiveSplit == nullptr) {
+    return;
+  }
+  try {
+    fileHandleFactory_.generate(
+        hiveSplit->filePath,
+        hiveSplit->properties.has_value() ? &*hiveSplit->properties : nullptr,
+        nullptr);
+  } catch (const std::exception& e) {
+    // The scan opens the file again and reports the error.
+    VLOG(1) << "Failed to preopen " << hiveSplit->filePath << ": "
+            << e.what();
+  }
 }
 
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
@@ -101,7 +141,8 @@ std::unique_ptr<DataSink> HiveConnector::createDataSink(
       hiveInsertHandle,
       connectorQueryCtx,
       commitStrategy,
-      hiveConfig_);
+      hiveConfig_,
+      executor_);
 }
 
 std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
@@ -18,6 +18,7 @@
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveSplitPruner.h"
 #include "velox/core/PlanNode.h"
 
 namespace facebook::velox::dwio::common {
@@ -56,6 +57,10 @@ class HiveConnector : public Connector {
           std::shared_ptr<connector::ColumnHandle>>& columnHandles,
       ConnectorQueryCtx* connectorQueryCtx) override;
 
+  /// Opens the file of 'split' into the file handle cache. No-op if the file
+  /// handle cache is disabled.
+  void preopenSplit(const std::shared_ptr<ConnectorSplit>& split) override;
+
   bool supportsSplitPreload() override {
     return true;
   }
@@ -80,9 +85,14 @@ class HiveConnector : public Connector {
     return fileHandleFactory_.clearCache();
   }
 
+  SimpleLRUCacheStats fileStatsCacheStats() {
+    return splitPruner_.cacheStats();
+  }
+
  protected:
   const std::shared_ptr<HiveConfig> hiveConfig_;
   FileHandleFactory fileHandleFactory_;
+  HiveSplitPruner splitPruner_;
   folly::Executor* executor_;
   std::shared_ptr<ConnectorMetadata> metadata_;
 };
@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 
+#include <folly/json.h>
+
 namespace facebook::velox::connector::hive {
 
 std::string HiveConnectorSplit::toString() const {
@@ -35,6 +37,19 @@ std::string HiveConnectorSplit::getFileName() const {
   return i == std::string::npos ? filePath : filePath.substr(i + 1);
 }
 
+std::optional<std::string> HiveConnectorSplit::cacheKey() const {
+  if (!properties.has_value() || !properties->modificationTime.has_value()) {
+    return std::nullopt;
+  }
+  auto obj = serialize();
+  // The weight and cacheability of a split do not change its data.
+  obj.erase("splitWeight");
+  obj.erase("cacheable");
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  return folly::json::serialize(obj, opts);
+}
+
 folly::dynamic HiveConnectorSplit::serialize() const {
   folly::dynamic obj = folly::dynamic::object;
   obj["name"] = "HiveConnectorSplit";
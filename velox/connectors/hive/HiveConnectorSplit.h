@@ -115,6 +115,10 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
 
   std::string getFileName() const;
 
+  /// Returns the serialized split without its weight if the modification time
+  /// of the file is known, and otherwise std::nullopt.
+  std::optional<std::string> cacheKey() const override;
+
   folly::dynamic serialize() const override;
 
   static std::shared_ptr<HiveConnectorSplit> create(const folly::dynamic& obj);
@@ -552,6 +552,8 @@ void configureReaderOptions(
       hiveConfig->maxCoalescedBytes(sessionProperties));
   readerOptions.setMaxCoalesceDistance(
       hiveConfig->maxCoalescedDistanceBytes(sessionProperties));
+  readerOptions.setAdaptiveCoalescing(
+      hiveConfig->isAdaptiveCoalescingEnabled(sessionProperties));
   readerOptions.setFileColumnNamesReadAsLowerCase(
       hiveConfig->isFileColumnNamesReadAsLowerCase(sessionProperties));
   bool useColumnNamesForColumnMapping = false;
@@ -560,11 +562,17 @@ void configureReaderOptions(
     case dwio::common::FileFormat::ORC: {
       useColumnNamesForColumnMapping =
           hiveConfig->isOrcUseColumnNames(sessionProperties);
+      readerOptions.setBloomFilterPruningEnabled(
+          hiveConfig->isOrcBloomFilterPruningEnabled(sessionProperties));
       break;
     }
     case dwio::common::FileFormat::PARQUET: {
       useColumnNamesForColumnMapping =
           hiveConfig->isParquetUseColumnNames(sessionProperties);
+      readerOptions.setBloomFilterPruningEnabled(
+          hiveConfig->isParquetBloomFilterPruningEnabled(sessionProperties));
+      readerOptions.setDictionaryFilterEnabled(
+          hiveConfig->isParquetDictionaryFilterEnabled(sessionProperties));
       break;
     }
     default:
@@ -740,13 +748,55 @@ bool testFilters(
   return true;
 }
 
+bool testPartitionFilters(
+    const common::ScanSpec* scanSpec,
+    const std::string& filePath,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle) {
+  for (const auto& child : scanSpec->children()) {
+    if (!child->filter()) {
+      continue;
+    }
+    auto iter = partitionKeys.find(child->fieldName());
+    if (iter == partitionKeys.end()) {
+      continue;
+    }
+    if (!iter->second.has_value()) {
+      if (child->filter()->isDeterministic() &&
+          !child->filter()->testNull()) {
+        VLOG(1) << "Skipping " << filePath
+                << " because the filter testNull() failed for partition key "
+                << child->fieldName();
+        return false;
+      }
+      continue;
+    }
+    const auto handlesIter = partitionKeysHandle.find(child->fieldName());
+    VELOX_CHECK(handlesIter != partitionKeysHandle.end());
+    if (!applyPartitionFilter(
+            handlesIter->second->dataType(),
+            iter->second.value(),
+            handlesIter->second->isPartitionDateValueDaysSinceEpoch(),
+            child->filter())) {
+      VLOG(1) << "Skipping " << filePath
+              << " based on the value of partition key "
+              << child->fieldName();
+      return false;
+    }
+  }
+  return true;
+}
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
     const ConnectorQueryCtx* connectorQueryCtx,
     std::shared_ptr<io::IoStatistics> ioStats,
     std::shared_ptr<filesystems::File::IoStats> fsStats,
-    folly::Executor* executor) {
+    folly::Executor* executor,
+    const std::string& scanHistoryKey) {
   if (connectorQueryCtx->cache()) {
     return std::make_unique<dwio::common::CachedBufferedInput>(
         fileHandle.file,
@@ -754,7 +804,9 @@ std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
         fileHandle.uuid.id(),
         connectorQueryCtx->cache(),
         Connector::getTracker(
-            connectorQueryCtx->scanId(), readerOpts.loadQuantum()),
+            connectorQueryCtx->scanId(),
+            readerOpts.loadQuantum(),
+            scanHistoryKey),
         fileHandle.groupId.id(),
         ioStats,
         std::move(fsStats),
@@ -766,7 +818,9 @@ std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
       dwio::common::MetricsLog::voidLog(),
       fileHandle.uuid.id(),
       Connector::getTracker(
-          connectorQueryCtx->scanId(), readerOpts.loadQuantum()),
+          connectorQueryCtx->scanId(),
+          readerOpts.loadQuantum(),
+          scanHistoryKey),
       fileHandle.groupId.id(),
       std::move(ioStats),
       std::move(fsStats),
@@ -903,4 +957,35 @@ core::TypedExprPtr extractFiltersFromRemainingFilter(
   }
   return expr;
 }
+
+void extractFunctionFilters(
+    const core::TypedExprPtr& remainingFilter,
+    core::ExpressionEvaluator* evaluator,
+    common::SubfieldFilters& filters) {
+  if (remainingFilter == nullptr) {
+    return;
+  }
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(remainingFilter.get());
+  if (call != nullptr && call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      extractFunctionFilters(input, evaluator, filters);
+    }
+    return;
+  }
+  try {
+    common::Subfield subfield;
+    auto filter =
+        exec::makeFunctionFilter(remainingFilter, evaluator, subfield);
+    if (filter == nullptr) {
+      return;
+    }
+    if (auto it = filters.find(subfield); it != filters.end()) {
+      filter = filter->mergeWith(it->second.get());
+    }
+    filters.insert_or_assign(std::move(subfield), std::move(filter));
+  } catch (const VeloxException&) {
+    LOG(WARNING) << "Unexpected failure when making function filter for: "
+                 << remainingFilter->toString();
+  }
+}
 } // namespace facebook::velox::connector::hive
@@ -94,13 +94,25 @@ bool testFilters(
     const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         partitionKeysHandle);
 
+/// Returns false if the filters in 'scanSpec' on the partition keys reject the
+/// partition values in 'partitionKeys'. Does not test the other columns, so
+/// that a split can be tested before its file is opened.
+bool testPartitionFilters(
+    const common::ScanSpec* scanSpec,
+    const std::string& filePath,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle);
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
     const ConnectorQueryCtx* connectorQueryCtx,
     std::shared_ptr<io::IoStatistics> ioStats,
     std::shared_ptr<filesystems::File::IoStats> fsStats,
-    folly::Executor* executor);
+    folly::Executor* executor,
+    const std::string& scanHistoryKey = "");
 
 core::TypedExprPtr extractFiltersFromRemainingFilter(
     const core::TypedExprPtr& expr,
@@ -109,4 +121,15 @@ core::TypedExprPtr extractFiltersFromRemainingFilter(
     common::SubfieldFilters& filters,
     double& sampleRate);
 
+/// Adds a common::FunctionFilter to 'filters' for each top level conjunct of
+/// 'remainingFilter' that calls functions on a single column of a primitive
+/// type. A filter already present for the column becomes the base of the
+/// function filter. 'remainingFilter' is not changed and must still be
+/// evaluated on the rows produced by the readers: a function filter only
+/// drops rows that the conjunct rejects without error.
+void extractFunctionFilters(
+    const core::TypedExprPtr& remainingFilter,
+    core::ExpressionEvaluator* evaluator,
+    common::SubfieldFilters& filters);
+
 } // namespace facebook::velox::connector::hive
@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/HiveDataSink.h"
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/StatsReporter.h"
@@ -34,6 +35,8 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
+#include <numeric>
+
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::connector::hive {
@@ -365,7 +368,8 @@ HiveDataSink::HiveDataSink(
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
     const ConnectorQueryCtx* connectorQueryCtx,
     CommitStrategy commitStrategy,
-    const std::shared_ptr<const HiveConfig>& hiveConfig)
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    folly::Executor* writeExecutor)
     : inputType_(std::move(inputType)),
       insertTableHandle_(std::move(insertTableHandle)),
       connectorQueryCtx_(connectorQueryCtx),
@@ -401,6 +405,11 @@ HiveDataSink::HiveDataSink(
       spillConfig_(connectorQueryCtx->spillConfig()),
       sortWriterFinishTimeSliceLimitMs_(getFinishTimeSliceLimitMsFromHiveConfig(
           hiveConfig_,
+          connectorQueryCtx->sessionProperties())),
+      writeExecutor_(writeExecutor),
+      maxParallelWriters_(hiveConfig_->maxParallelPartitionWriters(
+          connectorQueryCtx->sessionProperties())),
+      writersMemoryBudget_(hiveConfig_->partitionWritersMemoryBudget(
           connectorQueryCtx->sessionProperties())) {
   if (isBucketed()) {
     VELOX_USER_CHECK_LT(
@@ -455,6 +464,7 @@ void HiveDataSink::appendData(RowVectorPtr input) {
   if (!isPartitioned() && !isBucketed()) {
     const auto index = ensureWriter(HiveWriterId::unpartitionedId());
     write(index, input);
+    enforceWritersMemoryBudget();
     return;
   }
 
@@ -471,22 +481,26 @@ void HiveDataSink::appendData(RowVectorPtr input) {
   if (!isBucketed() && partitionIdGenerator_->numPartitions() == 1) {
     const auto index = ensureWriter(HiveWriterId{0});
     write(index, input);
+    enforceWritersMemoryBudget();
     return;
   }
 
   splitInputRowsAndEnsureWriters();
 
-  for (auto index = 0; index < writers_.size(); ++index) {
-    const vector_size_t partitionSize = partitionSizes_[index];
-    if (partitionSize == 0) {
-      continue;
+  std::vector<uint32_t> writerIndices;
+  for (uint32_t index = 0; index < writers_.size(); ++index) {
+    if (partitionSizes_[index] != 0) {
+      writerIndices.push_back(index);
     }
-
+  }
+  forEachWriter(writerIndices, [&](uint32_t index) {
+    const vector_size_t partitionSize = partitionSizes_[index];
     RowVectorPtr writerInput = partitionSize == input->size()
         ? input
         : exec::wrap(partitionSize, partitionRows_[index], input);
     write(index, writerInput);
-  }
+  });
+  enforceWritersMemoryBudget();
 }
 
 void HiveDataSink::write(size_t index, RowVectorPtr input) {
@@ -498,6 +512,96 @@ void HiveDataSink::write(size_t index, RowVectorPtr input) {
   writerInfo_[index]->numWrittenRows += dataInput->size();
 }
 
+uint32_t HiveDataSink::numParallelWriters(size_t numWriters) const {
+  if (writeExecutor_ == nullptr) {
+    return 1;
+  }
+  return std::max<uint32_t>(
+      1, std::min<size_t>(maxParallelWriters_, numWriters));
+}
+
+void HiveDataSink::forEachWriter(
+    const std::vector<uint32_t>& writerIndices,
+    const std::function<void(uint32_t)>& func) {
+  const auto numGroups = numParallelWriters(writerIndices.size());
+  if (numGroups == 1) {
+    for (auto index : writerIndices) {
+      func(index);
+    }
+    return;
+  }
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> groups;
+  groups.reserve(numGroups);
+  for (auto group = 0; group < numGroups; ++group) {
+    groups.push_back(std::make_shared<AsyncSource<bool>>([&, group]() {
+      for (auto i = group; i < writerIndices.size(); i += numGroups) {
+        func(writerIndices[i]);
+      }
+      return std::make_unique<bool>(true);
+    }));
+    // The calling thread runs the first group.
+    if (group > 0) {
+      writeExecutor_->add([source = groups.back()]() { source->prepare(); });
+    }
+  }
+
+  // All the groups must complete before returning, also in case of error, as
+  // they reference the input.
+  std::exception_ptr error;
+  for (auto& group : groups) {
+    try {
+      group->move();
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+void HiveDataSink::enforceWritersMemoryBudget() {
+  if (writersMemoryBudget_ == 0) {
+    return;
+  }
+  std::vector<std::pair<uint64_t, uint32_t>> writerBytes;
+  writerBytes.reserve(writers_.size());
+  uint64_t totalBytes{0};
+  for (uint32_t i = 0; i < writers_.size(); ++i) {
+    const uint64_t bytes = writerInfo_[i]->writerPool->reservedBytes();
+    totalBytes += bytes;
+    writerBytes.emplace_back(bytes, i);
+  }
+  if (totalBytes <= writersMemoryBudget_) {
+    return;
+  }
+
+  std::sort(writerBytes.begin(), writerBytes.end(), std::greater<>());
+  uint64_t numFlushedWriters{0};
+  for (const auto& [bytes, index] : writerBytes) {
+    if (totalBytes <= writersMemoryBudget_) {
+      break;
+    }
+    {
+      WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+      // A sorting writer can only release its buffered input by spilling.
+      if (auto* sortingWriter = dynamic_cast<dwio::common::SortingWriter*>(
+              writers_[index].get())) {
+        sortingWriter->spill();
+      } else {
+        writers_[index]->flush();
+      }
+    }
+    const uint64_t remainingBytes =
+        writerInfo_[index]->writerPool->reservedBytes();
+    totalBytes -= bytes - std::min(bytes, remainingBytes);
+    ++numFlushedWriters;
+  }
+  addThreadLocalRuntimeStat(
+      kMemoryBudgetFlushedWriters, RuntimeCounter(numFlushedWriters));
+}
+
 std::string HiveDataSink::stateString(State state) {
   switch (state) {
     case State::kRunning:
@@ -632,6 +736,23 @@ bool HiveDataSink::finish() {
 
   // TODO: we might refactor to move the data sorting logic into hive data sink.
   const uint64_t startTimeMs = getCurrentTimeMs();
+  if (numParallelWriters(writers_.size()) > 1) {
+    std::vector<uint32_t> writerIndices(writers_.size());
+    std::iota(writerIndices.begin(), writerIndices.end(), 0);
+    std::atomic_bool finished{true};
+    forEachWriter(writerIndices, [&](uint32_t index) {
+      if (getCurrentTimeMs() - startTimeMs >
+          sortWriterFinishTimeSliceLimitMs_) {
+        finished = false;
+        return;
+      }
+      WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+      if (!writers_[index]->finish()) {
+        finished = false;
+      }
+    });
+    return finished;
+  }
   for (auto i = 0; i < writers_.size(); ++i) {
     WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
     if (!writers_[i]->finish()) {
@@ -452,6 +452,8 @@ class HiveDataSink : public DataSink {
  public:
   /// The list of runtime stats reported by hive data sink
   static constexpr const char* kEarlyFlushedRawBytes = "earlyFlushedRawBytes";
+  static constexpr const char* kMemoryBudgetFlushedWriters =
+      "memoryBudgetFlushedWriters";
 
   /// Defines the execution states of a hive data sink running internally.
   enum class State {
@@ -467,12 +469,15 @@ class HiveDataSink : public DataSink {
   };
   static std::string stateString(State state);
 
+  /// If 'writeExecutor' is set, the partitions of an input are written on up
+  /// to HiveConfig::maxParallelPartitionWriters() threads of it.
   HiveDataSink(
       RowTypePtr inputType,
       std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
       const ConnectorQueryCtx* connectorQueryCtx,
       CommitStrategy commitStrategy,
-      const std::shared_ptr<const HiveConfig>& hiveConfig);
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      folly::Executor* writeExecutor = nullptr);
 
   static uint32_t maxBucketCount() {
     static const uint32_t kMaxBucketCount = 100'000;
@@ -605,6 +610,21 @@ class HiveDataSink : public DataSink {
   // Invoked to write 'input' to the specified file writer.
   void write(size_t index, RowVectorPtr input);
 
+  // Returns the number of threads that write the partitions concurrently.
+  uint32_t numParallelWriters(size_t numWriters) const;
+
+  // Invokes 'func' with each of 'writerIndices'. The writers are split into
+  // numParallelWriters() groups that run on 'writeExecutor_', except for the
+  // groups that the executor has not started when the calling thread waits for
+  // them.
+  void forEachWriter(
+      const std::vector<uint32_t>& writerIndices,
+      const std::function<void(uint32_t)>& func);
+
+  // Flushes the writers with the most memory, or spills them if they sort,
+  // until all writers use at most 'writersMemoryBudget_'.
+  void enforceWritersMemoryBudget();
+
   void closeInternal();
 
   const RowTypePtr inputType_;
@@ -623,6 +643,9 @@ class HiveDataSink : public DataSink {
   const std::shared_ptr<dwio::common::WriterFactory> writerFactory_;
   const common::SpillConfig* const spillConfig_;
   const uint64_t sortWriterFinishTimeSliceLimitMs_{0};
+  folly::Executor* const writeExecutor_;
+  const uint32_t maxParallelWriters_;
+  const uint64_t writersMemoryBudget_;
 
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
@@ -22,6 +22,7 @@
 
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveSplitPruner.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/expression/FieldReference.h"
 
@@ -54,6 +55,21 @@ bool shouldEagerlyMaterialize(
   return false;
 }
 
+// Adds the non-empty buckets of 'histogram' to 'stats' as '<name>.<bucket>'.
+void addLatencyHistogram(
+    const std::string& name,
+    const io::IoLatencyHistogram& histogram,
+    std::unordered_map<std::string, RuntimeCounter>& stats) {
+  for (auto i = 0; i < io::IoLatencyHistogram::kNumBuckets; ++i) {
+    if (histogram.count(i) > 0) {
+      stats.insert(
+          {fmt::format(
+               "{}.{}", name, io::IoLatencyHistogram::bucketName(i)),
+           RuntimeCounter(histogram.count(i))});
+    }
+  }
+}
+
 } // namespace
 
 HiveDataSource::HiveDataSource(
@@ -65,11 +81,13 @@ HiveDataSource::HiveDataSource(
     FileHandleFactory* fileHandleFactory,
     folly::Executor* executor,
     const ConnectorQueryCtx* connectorQueryCtx,
-    const std::shared_ptr<HiveConfig>& hiveConfig)
+    const std::shared_ptr<HiveConfig>& hiveConfig,
+    HiveSplitPruner* splitPruner)
     : fileHandleFactory_(fileHandleFactory),
       executor_(executor),
       connectorQueryCtx_(connectorQueryCtx),
       hiveConfig_(hiveConfig),
+      splitPruner_(splitPruner),
       pool_(connectorQueryCtx->memoryPool()),
       outputType_(outputType),
       expressionEvaluator_(connectorQueryCtx->expressionEvaluator()) {
@@ -141,6 +159,10 @@ HiveDataSource::HiveDataSource(
   if (sampleRate != 1) {
     randomSkip_ = std::make_shared<random::RandomSkipTracker>(sampleRate);
   }
+  if (hiveConfig_->readFunctionFilterPushdownEnabled(
+          connectorQueryCtx_->sessionProperties())) {
+    extractFunctionFilters(remainingFilter, expressionEvaluator_, filters_);
+  }
 
   std::vector<common::Subfield> remainingFilterSubfields;
   if (remainingFilter) {
@@ -307,10 +329,20 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
 
   VLOG(1) << "Adding split " << split_->toString();
 
-  if (splitReader_) {
-    splitReader_.reset();
+  splitPruned_ = splitPruner_ != nullptr &&
+      !splitPruner_->test(*scanSpec_, *split_, partitionKeys_);
+  if (splitPruned_) {
+    ++runtimeStats_.skippedSplits;
+    runtimeStats_.skippedSplitBytes += split_->length;
+    ++runtimeStats_.prunedSplits;
+    return;
   }
 
+  // Keep the previous split reader until the next one is prepared so that
+  // the state it shares with the next split, e.g. Iceberg equality delete
+  // sets, is not rebuilt.
+  auto previousSplitReader = std::move(splitReader_);
+
   if (split_->bucketConversion.has_value()) {
     partitionFunction_ = setupBucketConversion();
   } else {
@@ -326,6 +358,10 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   splitReader_->configureReaderOptions(randomSkip_);
   splitReader_->prepareSplit(metadataFilter_, runtimeStats_);
   readerOutputType_ = splitReader_->readerOutputType();
+  if (splitPruner_ != nullptr && splitReader_->baseReader() != nullptr) {
+    splitPruner_->addFileStats(*split_, *splitReader_->baseReader());
+  }
+  previousSplitReader.reset();
 }
 
 vector_size_t HiveDataSource::applyBucketConversion(
@@ -371,6 +407,10 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     uint64_t size,
     velox::ContinueFuture& /*future*/) {
   VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
+  if (splitPruned_) {
+    split_.reset();
+    return nullptr;
+  }
   VELOX_CHECK_NOT_NULL(splitReader_, "No split reader present");
 
   TestValue::adjust(
@@ -473,6 +513,10 @@ void HiveDataSource::addDynamicFilter(
   }
 }
 
+uint64_t HiveDataSource::ioWaitNanos() {
+  return ioStats_->queryThreadIoLatency().sum() * 1'000;
+}
+
 std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
   auto res = runtimeStats_.toMap();
   res.insert(
@@ -518,6 +562,27 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
          RuntimeCounter(
              ioStats_->ramHit().sum(), RuntimeCounter::Unit::kBytes)});
   }
+  if (ioStats_->prefetchHit().count() > 0) {
+    res.insert(
+        {"numPrefetchHit", RuntimeCounter(ioStats_->prefetchHit().count())});
+    res.insert(
+        {"prefetchHitBytes",
+         RuntimeCounter(
+             ioStats_->prefetchHit().sum(), RuntimeCounter::Unit::kBytes)});
+  }
+  if (ioStats_->prefetchMissWait().count() > 0) {
+    res.insert(
+        {"numPrefetchMiss",
+         RuntimeCounter(ioStats_->prefetchMissWait().count())});
+    res.insert(
+        {"prefetchMissWaitWallNanos",
+         RuntimeCounter(
+             ioStats_->prefetchMissWait().sum() * 1'000,
+             RuntimeCounter::Unit::kNanos)});
+  }
+  addLatencyHistogram(
+      "storageReadLatency", ioStats_->storageReadLatency(), res);
+  addLatencyHistogram("ssdReadLatency", ioStats_->ssdReadLatency(), res);
   if (numBucketConversion_ > 0) {
     res.insert({"numBucketConversion", RuntimeCounter(numBucketConversion_)});
   }
@@ -537,13 +602,17 @@ void HiveDataSource::setFromDataSource(
   VELOX_CHECK_NOT_NULL(source, "Bad DataSource type");
 
   split_ = std::move(source->split_);
+  splitPruned_ = source->splitPruned_;
   runtimeStats_.skippedSplits += source->runtimeStats_.skippedSplits;
   runtimeStats_.skippedSplitBytes += source->runtimeStats_.skippedSplitBytes;
+  runtimeStats_.prunedSplits += source->runtimeStats_.prunedSplits;
   readerOutputType_ = std::move(source->readerOutputType_);
   source->scanSpec_->moveAdaptationFrom(*scanSpec_);
   scanSpec_ = std::move(source->scanSpec_);
   splitReader_ = std::move(source->splitReader_);
-  splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+  if (splitReader_ != nullptr) {
+    splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+  }
   // New io will be accounted on the stats of 'source'. Add the existing
   // balance to that.
   source->ioStats_->merge(*ioStats_);
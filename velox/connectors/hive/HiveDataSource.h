@@ -32,6 +32,7 @@
 namespace facebook::velox::connector::hive {
 
 class HiveConfig;
+class HiveSplitPruner;
 
 class HiveDataSource : public DataSource {
  public:
@@ -44,7 +45,8 @@ class HiveDataSource : public DataSource {
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
       const ConnectorQueryCtx* connectorQueryCtx,
-      const std::shared_ptr<HiveConfig>& hiveConfig);
+      const std::shared_ptr<HiveConfig>& hiveConfig,
+      HiveSplitPruner* splitPruner = nullptr);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -65,6 +67,8 @@ class HiveDataSource : public DataSource {
 
   std::unordered_map<std::string, RuntimeCounter> runtimeStats() override;
 
+  uint64_t ioWaitNanos() override;
+
   bool allPrefetchIssued() const override {
     return splitReader_ && splitReader_->allPrefetchIssued();
   }
@@ -105,9 +109,13 @@ class HiveDataSource : public DataSource {
   folly::Executor* const executor_;
   const ConnectorQueryCtx* const connectorQueryCtx_;
   const std::shared_ptr<HiveConfig> hiveConfig_;
+  // Skips splits before opening their files. nullptr if not set.
+  HiveSplitPruner* const splitPruner_;
   memory::MemoryPool* const pool_;
 
   std::shared_ptr<HiveConnectorSplit> split_;
+  // True if 'split_' was skipped by 'splitPruner_' and has no split reader.
+  bool splitPruned_{false};
   std::shared_ptr<HiveTableHandle> hiveTableHandle_;
   std::shared_ptr<common::ScanSpec> scanSpec_;
   VectorPtr output_;
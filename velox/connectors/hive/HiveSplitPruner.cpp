@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/HiveSplitPruner.h"
+
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+
+namespace facebook::velox::connector::hive {
+
+HiveSplitPruner::HiveSplitPruner(uint64_t maxCachedFiles)
+    : cache_(
+          maxCachedFiles > 0 ? std::make_unique<FileStatsCache>(maxCachedFiles)
+                             : nullptr) {}
+
+bool HiveSplitPruner::test(
+    const common::ScanSpec& scanSpec,
+    const HiveConnectorSplit& split,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle) {
+  if (!scanSpec.hasFilter()) {
+    return true;
+  }
+  if (!testPartitionFilters(
+          &scanSpec,
+          split.filePath,
+          split.partitionKeys,
+          partitionKeysHandle)) {
+    return false;
+  }
+  if (cache_ == nullptr) {
+    return true;
+  }
+  const auto key = makeKey(split);
+  if (!key.has_value()) {
+    return true;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto* fileStats = cache_->get(*key);
+  if (fileStats == nullptr) {
+    return true;
+  }
+  const bool result = testFileStats(scanSpec, split, *fileStats);
+  cache_->release(*key);
+  return result;
+}
+
+void HiveSplitPruner::addFileStats(
+    const HiveConnectorSplit& split,
+    const dwio::common::Reader& reader) {
+  if (cache_ == nullptr) {
+    return;
+  }
+  const auto key = makeKey(split);
+  const auto numRows = reader.numberOfRows();
+  if (!key.has_value() || !numRows.has_value()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (cache_->get(*key) != nullptr) {
+      cache_->release(*key);
+      return;
+    }
+  }
+
+  // The statistics are copied out of the footer outside of the lock.
+  auto fileStats = std::make_unique<FileStats>();
+  fileStats->numRows = numRows.value();
+  const auto& rowType = reader.rowType();
+  const auto& fileTypeWithId = reader.typeWithId();
+  for (auto i = 0; i < rowType->size(); ++i) {
+    const auto& typeWithId = fileTypeWithId->childAt(i);
+    fileStats->columns.emplace(
+        rowType->nameOf(i),
+        ColumnStats{
+            typeWithId->type(), reader.columnStatistics(typeWithId->id())});
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  // Fails if another split of the file added the statistics meanwhile.
+  if (cache_->add(*key, fileStats.get(), 1)) {
+    fileStats.release();
+  }
+}
+
+SimpleLRUCacheStats HiveSplitPruner::cacheStats() {
+  if (cache_ == nullptr) {
+    return {};
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_->stats();
+}
+
+// static
+std::optional<dwio::common::FileMetadataCacheKey> HiveSplitPruner::makeKey(
+    const HiveConnectorSplit& split) {
+  if (!split.properties.has_value() ||
+      !split.properties->fileSize.has_value() ||
+      !split.properties->modificationTime.has_value()) {
+    return std::nullopt;
+  }
+  return dwio::common::FileMetadataCacheKey{
+      split.filePath,
+      static_cast<uint64_t>(split.properties->fileSize.value()),
+      split.properties->modificationTime.value(),
+      split.fileFormat};
+}
+
+// static
+bool HiveSplitPruner::testFileStats(
+    const common::ScanSpec& scanSpec,
+    const HiveConnectorSplit& split,
+    const FileStats& fileStats) {
+  for (const auto& child : scanSpec.children()) {
+    auto* filter = child->filter();
+    // Partition keys are tested on the partition values. Missing columns are
+    // left to the split reader, which knows how the file is mapped to the
+    // table.
+    if (filter == nullptr ||
+        split.partitionKeys.count(child->fieldName()) > 0) {
+      continue;
+    }
+    auto it = fileStats.columns.find(child->fieldName());
+    if (it == fileStats.columns.end() || it->second.stats == nullptr) {
+      continue;
+    }
+    if (!testFilter(
+            filter,
+            it->second.stats.get(),
+            fileStats.numRows,
+            it->second.type)) {
+      VLOG(1) << "Skipping " << split.filePath
+              << " based on cached stats and filter for column "
+              << child->fieldName();
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace facebook::velox::connector::hive
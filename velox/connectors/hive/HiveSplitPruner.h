@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <memory>
+#include <mutex>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/TableHandle.h"
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ScanSpec.h"
+
+namespace facebook::velox::connector::hive {
+
+/// Drops the splits of a scan that cannot produce rows before their files are
+/// opened. A split is tested on its partition values and on the file-level
+/// column statistics of its file, if a split of the file was read before.
+/// Owned by the connector and shared by all its data sources.
+class HiveSplitPruner {
+ public:
+  /// Keeps the statistics of up to 'maxCachedFiles' files. 0 disables the
+  /// statistics, so that splits are only tested on their partition values.
+  explicit HiveSplitPruner(uint64_t maxCachedFiles);
+
+  /// Returns false if no row of 'split' can pass the filters in 'scanSpec'.
+  /// 'partitionKeysHandle' has the partition key columns of the table.
+  bool test(
+      const common::ScanSpec& scanSpec,
+      const HiveConnectorSplit& split,
+      const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+          partitionKeysHandle);
+
+  /// Remembers the file-level statistics of the top level columns of the file
+  /// of 'split', read by 'reader'. No-op if the statistics are disabled or
+  /// already cached, or if the split does not identify the version of its
+  /// file.
+  void addFileStats(
+      const HiveConnectorSplit& split,
+      const dwio::common::Reader& reader);
+
+  SimpleLRUCacheStats cacheStats();
+
+ private:
+  struct ColumnStats {
+    TypePtr type;
+    // nullptr if the file has no statistics for the column.
+    std::unique_ptr<dwio::common::ColumnStatistics> stats;
+  };
+
+  struct FileStats {
+    uint64_t numRows;
+    // Keyed on the column name in the file.
+    folly::F14FastMap<std::string, ColumnStats> columns;
+  };
+
+  using FileStatsCache = SimpleLRUCache<
+      dwio::common::FileMetadataCacheKey,
+      FileStats,
+      std::equal_to<dwio::common::FileMetadataCacheKey>,
+      dwio::common::FileMetadataCacheKeyHasher>;
+
+  // Returns the key of the file of 'split' or std::nullopt if the split has no
+  // file size or modification time.
+  static std::optional<dwio::common::FileMetadataCacheKey> makeKey(
+      const HiveConnectorSplit& split);
+
+  // Returns false if no row in the file with 'fileStats' can pass the filters
+  // in 'scanSpec' on columns other than partition keys.
+  static bool testFileStats(
+      const common::ScanSpec& scanSpec,
+      const HiveConnectorSplit& split,
+      const FileStats& fileStats);
+
+  std::mutex mutex_;
+  // nullptr if the statistics are disabled.
+  const std::unique_ptr<FileStatsCache> cache_;
+};
+
+} // namespace facebook::velox::connector::hive
@@ -175,9 +175,28 @@ void SplitReader::prepareSplit(
   }
 
   createRowReader(std::move(metadataFilter), std::move(rowType));
+
+  // A count over the split, e.g. count(*), reads no columns. If no filters
+  // drop rows, the rows in the stripes or row groups of the split are counted
+  // from the file metadata.
+  if (readerOutputType_->size() == 0 && !scanSpec_->hasFilter() &&
+      !baseReaderOpts_.randomSkip()) {
+    numRowsFromMetadata_ = baseRowReader_->numRowsInRange();
+  }
 }
 
 uint64_t SplitReader::next(uint64_t size, VectorPtr& output) {
+  if (numRowsFromMetadata_.has_value()) {
+    const auto numRows = std::min(size, *numRowsFromMetadata_);
+    *numRowsFromMetadata_ -= numRows;
+    output = std::make_shared<RowVector>(
+        pool_,
+        readerOutputType_,
+        nullptr,
+        numRows,
+        std::vector<VectorPtr>{});
+    return numRows;
+  }
   if (!baseReaderOpts_.randomSkip()) {
     return baseRowReader_->next(size, output);
   }
@@ -269,13 +288,18 @@ void SplitReader::createReader() {
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandleCachePtr->uuid.id());
   }
+  baseReaderOpts_.setFileModificationTime(
+      hiveSplit_->properties.has_value()
+          ? hiveSplit_->properties->modificationTime
+          : std::nullopt);
   auto baseFileInput = createBufferedInput(
       *fileHandleCachePtr,
       baseReaderOpts_,
       connectorQueryCtx_,
       ioStats_,
       fsStats_,
-      executor_);
+      executor_,
+      hiveTableHandle_->tableName());
 
   baseReader_ = dwio::common::getReaderFactory(baseReaderOpts_.fileFormat())
                     ->createReader(std::move(baseFileInput), baseReaderOpts_);
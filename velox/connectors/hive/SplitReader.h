@@ -101,6 +101,11 @@ class SplitReader {
     return readerOutputType_;
   }
 
+  /// Returns the reader of the data file or nullptr if the file is not open.
+  const dwio::common::Reader* baseReader() const {
+    return baseReader_.get();
+  }
+
   std::string toString() const;
 
  protected:
@@ -179,6 +184,10 @@ class SplitReader {
   dwio::common::ReaderOptions baseReaderOpts_;
   dwio::common::RowReaderOptions baseRowReaderOpts_;
   bool emptySplit_;
+
+  // Number of rows left to return without reading when the rows of the split
+  // are counted from the file metadata.
+  std::optional<uint64_t> numRowsFromMetadata_;
 };
 
 } // namespace facebook::velox::connector::hive
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// Shares the decoded contents of Iceberg delete files between the readers
+/// that hold them. 'T' is built once per key and is immutable afterwards.
+/// The cache holds no reference of its own, so a value is released with the
+/// last reader that uses it.
+template <typename T>
+class DeleteFileCache {
+ public:
+  /// Returns the value for 'key' if another reader holds it. Otherwise builds
+  /// it with 'load'. Concurrent callers with the same 'key' wait for the
+  /// first one to build the value.
+  std::shared_ptr<const T> getOrLoad(
+      const std::string& key,
+      const std::function<std::shared_ptr<T>()>& load) {
+    std::shared_ptr<Entry> entry;
+    entries_.withWLock([&](auto& entries) {
+      for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.expired() && it->first != key) {
+          it = entries.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      auto& weakEntry = entries[key];
+      entry = weakEntry.lock();
+      if (entry == nullptr) {
+        entry = std::make_shared<Entry>();
+        weakEntry = entry;
+      }
+    });
+
+    std::lock_guard<std::mutex> l(entry->mutex);
+    if (entry->value == nullptr) {
+      entry->value = load();
+    }
+    // The returned pointer holds the entry so that other readers find the
+    // value while it is in use.
+    return std::shared_ptr<const T>(entry, entry->value.get());
+  }
+
+ private:
+  struct Entry {
+    std::mutex mutex;
+    std::shared_ptr<const T> value;
+  };
+
+  folly::Synchronized<folly::F14FastMap<std::string, std::weak_ptr<Entry>>>
+      entries_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
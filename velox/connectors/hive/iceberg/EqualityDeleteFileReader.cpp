@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteSet.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+constexpr uint64_t kBatchSize = 10'000;
+} // namespace
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::shared_ptr<filesystems::File::IoStats>& fsStats,
+    const std::string& connectorId)
+    : deleteFile_(deleteFile),
+      pool_(connectorQueryCtx->memoryPool()) {
+  VELOX_CHECK(deleteFile_.content == FileContent::kEqualityDeletes);
+  VELOX_CHECK(!deleteFile_.equalityFieldIds.empty());
+
+  deleteSplit_ = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile_.filePath,
+      deleteFile_.fileFormat,
+      0,
+      deleteFile_.fileSizeInBytes);
+
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      hiveConfig,
+      connectorQueryCtx,
+      /*fileSchema=*/nullptr,
+      deleteSplit_,
+      /*tableParameters=*/{},
+      deleteReaderOpts);
+
+  auto deleteFileHandleCachePtr =
+      fileHandleFactory->generate(deleteFile_.filePath);
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandleCachePtr,
+      deleteReaderOpts,
+      connectorQueryCtx,
+      ioStats,
+      fsStats,
+      executor);
+
+  deleteReader_ =
+      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  // The field ids are not mapped to the columns of the table, so the keys are
+  // the columns of the file, matched by name.
+  VELOX_CHECK_EQ(
+      fileType()->size(),
+      deleteFile_.equalityFieldIds.size(),
+      "Iceberg equality delete file {} must only have the equality columns",
+      deleteFile_.filePath);
+}
+
+void EqualityDeleteFileReader::readDeletedKeys(EqualityDeleteSet& deleteSet) {
+  const auto& keyType = deleteSet.keyType();
+  VELOX_CHECK_EQ(
+      keyType->names(),
+      fileType()->names(),
+      "Iceberg equality delete files with the same equality columns must "
+      "have the same columns: {}",
+      deleteFile_.filePath);
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  for (auto i = 0; i < keyType->size(); ++i) {
+    scanSpec->addField(keyType->nameOf(i), i);
+  }
+
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      {},
+      scanSpec,
+      nullptr,
+      keyType,
+      deleteSplit_,
+      nullptr,
+      nullptr,
+      deleteRowReaderOpts);
+  auto deleteRowReader = deleteReader_->createRowReader(deleteRowReaderOpts);
+
+  VectorPtr output = BaseVector::create(keyType, 0, pool_);
+  while (deleteRowReader->next(kBatchSize, output) > 0) {
+    deleteSet.add(std::static_pointer_cast<RowVector>(output));
+  }
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <memory>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/dwio/common/Reader.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+class EqualityDeleteSet;
+
+/// Reads the deleted keys of an Iceberg equality delete file. The columns of
+/// the file are the equality columns of the deletes.
+class EqualityDeleteFileReader {
+ public:
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::shared_ptr<filesystems::File::IoStats>& fsStats,
+      const std::string& connectorId);
+
+  /// Returns the columns of the delete file.
+  const RowTypePtr& fileType() const {
+    return deleteReader_->rowType();
+  }
+
+  /// Adds all the keys in the file to 'deleteSet'. The key columns of
+  /// 'deleteSet' must be the columns of the file.
+  void readDeletedKeys(EqualityDeleteSet& deleteSet);
+
+ private:
+  const IcebergDeleteFile& deleteFile_;
+  memory::MemoryPool* const pool_;
+
+  std::shared_ptr<HiveConnectorSplit> deleteSplit_;
+  std::unique_ptr<dwio::common::Reader> deleteReader_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
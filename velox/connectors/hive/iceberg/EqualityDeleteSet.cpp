@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteSet.h"
+
+#include <folly/hash/Hash.h>
+
+#include "velox/connectors/hive/iceberg/DeleteFileCache.h"
+
+using facebook::velox::exec::VectorHasher;
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+// The smallest bitmap for kArray mode. Larger key ranges use kArray mode if
+// the bitmap takes at most 8 bytes per deleted row.
+constexpr uint64_t kMinArrayBits = 1 << 16;
+
+// Multiplies a * b and produces VectorHasher::kRangeTooLarge to denote
+// overflow.
+inline uint64_t safeMul(uint64_t a, uint64_t b) {
+  uint64_t result;
+  if (a == VectorHasher::kRangeTooLarge || b == VectorHasher::kRangeTooLarge ||
+      __builtin_mul_overflow(a, b, &result)) {
+    return VectorHasher::kRangeTooLarge;
+  }
+  return result;
+}
+
+DeleteFileCache<EqualityDeleteSet>& deleteSetCache() {
+  static DeleteFileCache<EqualityDeleteSet> cache;
+  return cache;
+}
+} // namespace
+
+EqualityDeleteSet::EqualityDeleteSet(
+    RowTypePtr keyType,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : pool_(std::move(pool)), keyType_(std::move(keyType)) {
+  VELOX_CHECK_NOT_NULL(pool_);
+  VELOX_CHECK_GT(keyType_->size(), 0, "Equality deletes need key columns");
+  for (const auto& type : keyType_->children()) {
+    VELOX_USER_CHECK(
+        type->isPrimitiveType(),
+        "Iceberg equality delete column must be primitive: {}",
+        keyType_->toString());
+  }
+}
+
+void EqualityDeleteSet::add(const RowVectorPtr& deletedKeys) {
+  VELOX_CHECK(!finished_, "Cannot add keys to a finished EqualityDeleteSet");
+  VELOX_CHECK(
+      deletedKeys->type()->equivalent(*keyType_),
+      "Unexpected equality delete keys {}, expected {}",
+      deletedKeys->type()->toString(),
+      keyType_->toString());
+  if (deletedKeys->size() == 0) {
+    return;
+  }
+  VELOX_CHECK_LT(batches_.size(), std::numeric_limits<uint32_t>::max());
+  deletedKeys->loadedVector();
+  batches_.push_back(std::static_pointer_cast<RowVector>(
+      BaseVector::copy(*deletedKeys, pool_.get())));
+}
+
+void EqualityDeleteSet::finish() {
+  VELOX_CHECK(!finished_, "EqualityDeleteSet is already finished");
+  finished_ = true;
+  if (mayUseValueIds() && enableValueIds()) {
+    buildNormalizedKeys();
+  } else {
+    hashers_.clear();
+    mode_ = Mode::kHash;
+    buildHashTable();
+  }
+}
+
+bool EqualityDeleteSet::mayUseValueIds() const {
+  for (const auto& type : keyType_->children()) {
+    if (!VectorHasher::typeKindSupportsValueIds(type->kind()) ||
+        type->providesCustomComparison()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool EqualityDeleteSet::enableValueIds() {
+  for (auto i = 0; i < keyType_->size(); ++i) {
+    hashers_.push_back(VectorHasher::create(keyType_->childAt(i), i));
+  }
+
+  uint64_t numRows{0};
+  SelectivityVector rows;
+  raw_vector<uint64_t> ids;
+  for (const auto& batch : batches_) {
+    numRows += batch->size();
+    rows.resizeFill(batch->size());
+    ids.resize(batch->size());
+    for (auto i = 0; i < hashers_.size(); ++i) {
+      hashers_[i]->decode(*batch->childAt(i), rows);
+      hashers_[i]->computeValueIds(rows, ids);
+      if (!hashers_[i]->mayUseValueIds()) {
+        return false;
+      }
+    }
+  }
+
+  // Picks range or distinct values per key the way HashTable does.
+  std::vector<bool> useRange(hashers_.size());
+  uint64_t bestSize = 1;
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    uint64_t rangeSize;
+    uint64_t distinctSize;
+    hashers_[i]->cardinality(0, rangeSize, distinctSize);
+    useRange[i] = distinctSize == VectorHasher::kRangeTooLarge ||
+        (rangeSize != VectorHasher::kRangeTooLarge &&
+         rangeSize <= distinctSize * 20);
+    bestSize = safeMul(bestSize, useRange[i] ? rangeSize : distinctSize);
+  }
+  if (bestSize == VectorHasher::kRangeTooLarge) {
+    return false;
+  }
+
+  uint64_t multiplier = 1;
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    multiplier = useRange[i] ? hashers_[i]->enableValueRange(multiplier, 0)
+                             : hashers_[i]->enableValueIds(multiplier, 0);
+    if (multiplier == VectorHasher::kRangeTooLarge) {
+      return false;
+    }
+  }
+  numIds_ = multiplier;
+  mode_ = numIds_ <= std::max(kMinArrayBits, 64 * numRows)
+      ? Mode::kArray
+      : Mode::kNormalizedKey;
+  return true;
+}
+
+void EqualityDeleteSet::allocateTable(uint64_t numEntries) {
+  const auto capacity =
+      bits::nextPowerOfTwo(std::max<uint64_t>(16, numEntries * 2));
+  table_ = AlignedBuffer::allocate<uint64_t>(capacity, pool_.get(), kEmpty);
+  if (mode_ == Mode::kHash) {
+    tableHashes_ = AlignedBuffer::allocate<uint64_t>(capacity, pool_.get());
+  }
+  tableMask_ = capacity - 1;
+}
+
+void EqualityDeleteSet::buildNormalizedKeys() {
+  uint64_t numRows{0};
+  for (const auto& batch : batches_) {
+    numRows += batch->size();
+  }
+  uint64_t* bitmap{nullptr};
+  uint64_t* table{nullptr};
+  if (mode_ == Mode::kArray) {
+    bitmap_ = AlignedBuffer::allocate<bool>(numIds_, pool_.get(), false);
+    bitmap = bitmap_->asMutable<uint64_t>();
+  } else {
+    allocateTable(numRows);
+    table = table_->asMutable<uint64_t>();
+  }
+
+  SelectivityVector rows;
+  raw_vector<uint64_t> ids;
+  for (const auto& batch : batches_) {
+    rows.resizeFill(batch->size());
+    ids.resize(batch->size());
+    for (auto i = 0; i < hashers_.size(); ++i) {
+      hashers_[i]->decode(*batch->childAt(i), rows);
+      VELOX_CHECK(hashers_[i]->computeValueIds(rows, ids));
+    }
+    for (auto row = 0; row < batch->size(); ++row) {
+      const auto id = ids[row];
+      if (bitmap != nullptr) {
+        if (!bits::isBitSet(bitmap, id)) {
+          bits::setBit(bitmap, id);
+          ++numKeys_;
+        }
+        continue;
+      }
+      auto slot = folly::hash::twang_mix64(id) & tableMask_;
+      while (table[slot] != kEmpty && table[slot] != id) {
+        slot = (slot + 1) & tableMask_;
+      }
+      if (table[slot] == kEmpty) {
+        table[slot] = id;
+        ++numKeys_;
+      }
+    }
+  }
+  // The hashers keep copies of the distinct values, the keys are no longer
+  // needed.
+  batches_.clear();
+}
+
+void EqualityDeleteSet::buildHashTable() {
+  uint64_t numRows{0};
+  for (const auto& batch : batches_) {
+    numRows += batch->size();
+  }
+  allocateTable(numRows);
+  auto* table = table_->asMutable<uint64_t>();
+  auto* tableHashes = tableHashes_->asMutable<uint64_t>();
+
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  for (auto i = 0; i < keyType_->size(); ++i) {
+    hashers.push_back(VectorHasher::create(keyType_->childAt(i), i));
+  }
+  SelectivityVector rows;
+  raw_vector<uint64_t> hashes;
+  for (uint32_t batchIndex = 0; batchIndex < batches_.size(); ++batchIndex) {
+    const auto& batch = batches_[batchIndex];
+    rows.resizeFill(batch->size());
+    hashes.resize(batch->size());
+    for (auto i = 0; i < hashers.size(); ++i) {
+      hashers[i]->decode(*batch->childAt(i), rows);
+      hashers[i]->hash(rows, i > 0, hashes);
+    }
+    for (auto row = 0; row < batch->size(); ++row) {
+      if (containsRow(batch->children(), row, hashes[row])) {
+        continue;
+      }
+      auto slot = hashes[row] & tableMask_;
+      while (table[slot] != kEmpty) {
+        slot = (slot + 1) & tableMask_;
+      }
+      table[slot] = rowRef(batchIndex, row);
+      tableHashes[slot] = hashes[row];
+      ++numKeys_;
+    }
+  }
+}
+
+bool EqualityDeleteSet::containsNormalizedKey(uint64_t key) const {
+  const auto* table = table_->as<uint64_t>();
+  auto slot = folly::hash::twang_mix64(key) & tableMask_;
+  for (;;) {
+    if (table[slot] == key) {
+      return true;
+    }
+    if (table[slot] == kEmpty) {
+      return false;
+    }
+    slot = (slot + 1) & tableMask_;
+  }
+}
+
+bool EqualityDeleteSet::containsRow(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t row,
+    uint64_t hash) const {
+  const auto* table = table_->as<uint64_t>();
+  const auto* tableHashes = tableHashes_->as<uint64_t>();
+  auto slot = hash & tableMask_;
+  for (; table[slot] != kEmpty; slot = (slot + 1) & tableMask_) {
+    if (tableHashes[slot] != hash) {
+      continue;
+    }
+    const auto& batch = batches_[table[slot] >> 32];
+    const vector_size_t deletedRow = table[slot] & 0xffffffff;
+    bool equal = true;
+    for (auto i = 0; i < keys.size() && equal; ++i) {
+      equal = batch->childAt(i)->equalValueAt(keys[i].get(), deletedRow, row);
+    }
+    if (equal) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void EqualityDeleteSet::probe(
+    const std::vector<VectorPtr>& keys,
+    const SelectivityVector& rows,
+    ProbeState& state,
+    uint64_t* deletedRows) const {
+  VELOX_CHECK(finished_, "EqualityDeleteSet is not finished");
+  VELOX_CHECK_EQ(keys.size(), keyType_->size());
+  if (numKeys_ == 0 || !rows.hasSelections()) {
+    return;
+  }
+  state.rows = rows;
+  state.hashes.resize(rows.end());
+  if (mode_ == Mode::kHash) {
+    probeHashes(keys, state, deletedRows);
+  } else {
+    probeNormalizedKeys(keys, state, deletedRows);
+  }
+}
+
+void EqualityDeleteSet::probeNormalizedKeys(
+    const std::vector<VectorPtr>& keys,
+    ProbeState& state,
+    uint64_t* deletedRows) const {
+  auto& rows = state.rows;
+  auto& ids = state.hashes;
+  std::fill(ids.begin(), ids.end(), 0);
+  std::vector<uint64_t> nullRowIds;
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    auto& decoded = state.decoded;
+    decoded.decode(*keys[i], rows);
+    if (!decoded.mayHaveNulls()) {
+      // Removes the rows whose key is not in the set from 'rows'.
+      hashers_[i]->lookupValueIds(*keys[i], rows, state.scratch, ids);
+    } else {
+      // Null keys have value id 0. lookupValueIds() expects no nulls and may
+      // overwrite the ids of the rows it does not look up, so the ids of the
+      // null rows are restored after the lookup.
+      auto& nonNullRows = state.nonNullRows;
+      nonNullRows = rows;
+      nonNullRows.deselectNulls(decoded.nulls(&rows), rows.begin(), rows.end());
+      nullRowIds.clear();
+      rows.applyToSelected([&](auto row) {
+        if (decoded.isNullAt(row)) {
+          nullRowIds.push_back(ids[row]);
+        }
+      });
+      if (nonNullRows.hasSelections()) {
+        hashers_[i]->lookupValueIds(*keys[i], nonNullRows, state.scratch, ids);
+      }
+      auto nextNullRow = nullRowIds.begin();
+      rows.applyToSelected([&](auto row) {
+        if (decoded.isNullAt(row)) {
+          ids[row] = *nextNullRow++;
+        } else if (!nonNullRows.isValid(row)) {
+          rows.setValid(row, false);
+        }
+      });
+      rows.updateBounds();
+    }
+    if (!rows.hasSelections()) {
+      return;
+    }
+  }
+
+  if (mode_ == Mode::kArray) {
+    const auto* bitmap = bitmap_->as<uint64_t>();
+    rows.applyToSelected([&](auto row) {
+      if (bits::isBitSet(bitmap, ids[row])) {
+        bits::setBit(deletedRows, row);
+      }
+    });
+  } else {
+    rows.applyToSelected([&](auto row) {
+      if (containsNormalizedKey(ids[row])) {
+        bits::setBit(deletedRows, row);
+      }
+    });
+  }
+}
+
+void EqualityDeleteSet::probeHashes(
+    const std::vector<VectorPtr>& keys,
+    ProbeState& state,
+    uint64_t* deletedRows) const {
+  auto& rows = state.rows;
+  if (state.hashers.empty()) {
+    for (auto i = 0; i < keyType_->size(); ++i) {
+      state.hashers.push_back(VectorHasher::create(keyType_->childAt(i), i));
+    }
+  }
+  for (auto i = 0; i < state.hashers.size(); ++i) {
+    state.hashers[i]->decode(*keys[i], rows);
+    state.hashers[i]->hash(rows, i > 0, state.hashes);
+  }
+  rows.applyToSelected([&](auto row) {
+    if (containsRow(keys, row, state.hashes[row])) {
+      bits::setBit(deletedRows, row);
+    }
+  });
+}
+
+// static
+std::shared_ptr<const EqualityDeleteSet> EqualityDeleteSet::getOrLoad(
+    const std::string& key,
+    const std::function<std::shared_ptr<EqualityDeleteSet>()>& load) {
+  return deleteSetCache().getOrLoad(key, [&]() {
+    auto deleteSet = load();
+    VELOX_CHECK(deleteSet->finished_);
+    return deleteSet;
+  });
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
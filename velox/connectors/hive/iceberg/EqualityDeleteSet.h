@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "velox/common/memory/MemoryPool.h"
+#include "velox/exec/VectorHasher.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// The keys of the rows deleted by the Iceberg equality delete files that
+/// have the same equality columns. Null keys match null values. The set is
+/// built once and is immutable afterwards, so that the splits of a Task
+/// probe it concurrently. Like HashTable, it maps integer and string keys to
+/// normalized keys with VectorHasher value ids when the keys have small ranges
+/// or few distinct values, and hashes and compares the deleted rows
+/// otherwise. All memory is allocated from 'pool'.
+class EqualityDeleteSet {
+ public:
+  enum class Mode {
+    // A bitmap indexed by the normalized key.
+    kArray,
+    // A hash table of normalized keys.
+    kNormalizedKey,
+    // A hash table of the deleted rows.
+    kHash,
+  };
+
+  /// The state of a thread that probes the set.
+  struct ProbeState {
+    SelectivityVector rows;
+    SelectivityVector nonNullRows;
+    DecodedVector decoded;
+    exec::VectorHasher::ScratchMemory scratch;
+    raw_vector<uint64_t> hashes;
+    std::vector<std::unique_ptr<exec::VectorHasher>> hashers;
+  };
+
+  EqualityDeleteSet(
+      RowTypePtr keyType,
+      std::shared_ptr<memory::MemoryPool> pool);
+
+  /// Adds the keys of some deleted rows. The children of 'deletedKeys' are
+  /// the key columns in the order of the key type. May only be called before
+  /// finish().
+  void add(const RowVectorPtr& deletedKeys);
+
+  /// Decides the mode and builds the lookup structures.
+  void finish();
+
+  /// Sets the bits in 'deletedRows' for the 'rows' whose keys are deleted.
+  /// 'keys' has a vector for each key column.
+  void probe(
+      const std::vector<VectorPtr>& keys,
+      const SelectivityVector& rows,
+      ProbeState& state,
+      uint64_t* deletedRows) const;
+
+  const RowTypePtr& keyType() const {
+    return keyType_;
+  }
+
+  Mode mode() const {
+    return mode_;
+  }
+
+  /// Returns the number of distinct deleted keys.
+  uint64_t numKeys() const {
+    return numKeys_;
+  }
+
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  /// Returns the set for 'key' if another reader holds it. Otherwise builds
+  /// it with 'load'. Concurrent callers with the same 'key' wait for the
+  /// first one to build the set. The set is released with the last reference
+  /// to it.
+  static std::shared_ptr<const EqualityDeleteSet> getOrLoad(
+      const std::string& key,
+      const std::function<std::shared_ptr<EqualityDeleteSet>()>& load);
+
+ private:
+  // The packed reference of a deleted row in kHash mode.
+  static uint64_t rowRef(uint32_t batch, vector_size_t row) {
+    return (static_cast<uint64_t>(batch) << 32) | row;
+  }
+
+  bool mayUseValueIds() const;
+
+  // Sets up the hashers for value ids. Returns false if the keys do not fit
+  // in a normalized key.
+  bool enableValueIds();
+
+  void buildNormalizedKeys();
+
+  void buildHashTable();
+
+  void allocateTable(uint64_t numEntries);
+
+  bool containsNormalizedKey(uint64_t key) const;
+
+  bool containsRow(
+      const std::vector<VectorPtr>& keys,
+      vector_size_t row,
+      uint64_t hash) const;
+
+  void probeNormalizedKeys(
+      const std::vector<VectorPtr>& keys,
+      ProbeState& state,
+      uint64_t* deletedRows) const;
+
+  void probeHashes(
+      const std::vector<VectorPtr>& keys,
+      ProbeState& state,
+      uint64_t* deletedRows) const;
+
+  static constexpr uint64_t kEmpty = ~0UL;
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  const RowTypePtr keyType_;
+
+  // The copies of the deleted keys.
+  std::vector<RowVectorPtr> batches_;
+  // The hashers that map the keys to value ids in kArray and kNormalizedKey
+  // modes.
+  std::vector<std::unique_ptr<exec::VectorHasher>> hashers_;
+  Mode mode_{Mode::kHash};
+  bool finished_{false};
+  uint64_t numKeys_{0};
+
+  // The number of distinct normalized keys in kArray and kNormalizedKey
+  // modes.
+  uint64_t numIds_{0};
+  // The bits of the deleted normalized keys in kArray mode.
+  BufferPtr bitmap_;
+  // Open addressing table of normalized keys in kNormalizedKey mode or of
+  // row references in kHash mode. Empty slots are kEmpty.
+  BufferPtr table_;
+  // The hashes of the rows in 'table_' in kHash mode.
+  BufferPtr tableHashes_;
+  uint64_t tableMask_{0};
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
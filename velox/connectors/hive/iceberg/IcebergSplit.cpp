@@ -90,4 +90,12 @@ HiveIcebergSplit::HiveIcebergSplit(
           std::nullopt,
           std::nullopt),
       deleteFiles(std::move(deletes)) {}
+
+std::optional<std::string> HiveIcebergSplit::cacheKey() const {
+  if (!deleteFiles.empty()) {
+    return std::nullopt;
+  }
+  return HiveConnectorSplit::cacheKey();
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
@@ -57,6 +57,10 @@ struct HiveIcebergSplit : public connector::hive::HiveConnectorSplit {
       std::vector<IcebergDeleteFile> deletes = {},
       const std::unordered_map<std::string, std::string>& infoColumns = {},
       std::optional<FileProperties> fileProperties = std::nullopt);
+
+  /// Returns std::nullopt if the split has delete files, since the key of the
+  /// base class does not identify them.
+  std::optional<std::string> cacheKey() const override;
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
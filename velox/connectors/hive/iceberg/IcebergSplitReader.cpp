@@ -16,13 +16,21 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/OperatorUtils.h"
 
 using namespace facebook::velox::dwio::common;
 
 namespace facebook::velox::connector::hive::iceberg {
+namespace {
+// The most deleted rows to skip in one batch.
+constexpr uint64_t kMaxSkippedRows = 1 << 20;
+} // namespace
 
 IcebergSplitReader::IcebergSplitReader(
     const std::shared_ptr<const hive::HiveConnectorSplit>& hiveSplit,
@@ -49,10 +57,7 @@ IcebergSplitReader::IcebergSplitReader(
           fileHandleFactory,
           executor,
           scanSpec),
-      baseReadOffset_(0),
-      splitOffset_(0),
-      deleteBitmap_(nullptr),
-      deleteBitmapBitOffset_(0) {}
+      deleteBitmap_(nullptr) {}
 
 void IcebergSplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
@@ -61,6 +66,11 @@ void IcebergSplitReader::prepareSplit(
   if (emptySplit_) {
     return;
   }
+  std::shared_ptr<const HiveIcebergSplit> icebergSplit =
+      std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
+  // The key columns of the equality deletes must be read before the row type
+  // is adapted to the file.
+  prepareEqualityDeletes(icebergSplit->deleteFiles);
   auto rowType = getAdaptedRowType();
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
@@ -70,92 +80,272 @@ void IcebergSplitReader::prepareSplit(
 
   createRowReader(std::move(metadataFilter), std::move(rowType));
 
-  std::shared_ptr<const HiveIcebergSplit> icebergSplit =
-      std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
-  baseReadOffset_ = 0;
-  splitOffset_ = baseRowReader_->nextRowNumber();
-  positionalDeleteFileReaders_.clear();
+  preparePositionalDeletes(icebergSplit->deleteFiles, runtimeStats);
+}
+
+std::shared_ptr<memory::MemoryPool> IcebergSplitReader::createDeletePool(
+    const std::string& kind) const {
+  static std::atomic_uint64_t poolId{0};
+  if (auto* connectorPool = connectorQueryCtx_->connectorMemoryPool()) {
+    return connectorPool->addLeafChild(
+        fmt::format("{}.{}.{}", connectorPool->name(), kind, poolId++),
+        true,
+        connectorPool->reclaimer() != nullptr ? exec::MemoryReclaimer::create()
+                                              : nullptr);
+  }
+  return connectorQueryCtx_->memoryPool()->shared_from_this();
+}
 
-  const auto& deleteFiles = icebergSplit->deleteFiles;
+void IcebergSplitReader::preparePositionalDeletes(
+    const std::vector<IcebergDeleteFile>& deleteFiles,
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  positionalDeletes_.reset();
+  std::vector<const IcebergDeleteFile*> files;
   for (const auto& deleteFile : deleteFiles) {
     if (deleteFile.content == FileContent::kPositionalDeletes) {
       if (deleteFile.recordCount > 0) {
-        positionalDeleteFileReaders_.push_back(
-            std::make_unique<PositionalDeleteFileReader>(
-                deleteFile,
-                hiveSplit_->filePath,
-                fileHandleFactory_,
-                connectorQueryCtx_,
-                executor_,
-                hiveConfig_,
-                ioStats_,
-                fsStats_,
-                runtimeStats,
-                splitOffset_,
-                hiveSplit_->connectorId));
+        files.push_back(&deleteFile);
       }
-    } else {
+    } else if (deleteFile.content != FileContent::kEqualityDeletes) {
       VELOX_NYI();
     }
   }
+  if (files.empty()) {
+    return;
+  }
+
+  // The splits of the data file in the Task share the deleted positions, so
+  // that each delete file is read once.
+  std::string key = connectorQueryCtx_->taskId();
+  key.append("\n").append(hiveSplit_->filePath);
+  for (const auto* file : files) {
+    key.append("\n").append(file->filePath);
+  }
+  auto positionalDeletes = PositionalDeleteBitmap::getOrLoad(
+      key, [&]() { return loadPositionalDeletes(files, runtimeStats); });
+  if (positionalDeletes->numDeleted() > 0) {
+    positionalDeletes_ = std::move(positionalDeletes);
+  }
+}
+
+std::shared_ptr<PositionalDeleteBitmap>
+IcebergSplitReader::loadPositionalDeletes(
+    const std::vector<const IcebergDeleteFile*>& deleteFiles,
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  auto bitmap = std::make_shared<PositionalDeleteBitmap>(
+      createDeletePool("positionalDeletes"));
+  for (const auto* deleteFile : deleteFiles) {
+    PositionalDeleteFileReader reader(
+        *deleteFile,
+        hiveSplit_->filePath,
+        fileHandleFactory_,
+        connectorQueryCtx_,
+        executor_,
+        hiveConfig_,
+        ioStats_,
+        fsStats_,
+        runtimeStats,
+        hiveSplit_->connectorId);
+    reader.readDeletePositions(*bitmap);
+  }
+  bitmap->finish();
+  return bitmap;
+}
+
+void IcebergSplitReader::prepareEqualityDeletes(
+    const std::vector<IcebergDeleteFile>& deleteFiles) {
+  equalityDeletes_.clear();
+  std::map<std::vector<int32_t>, std::vector<const IcebergDeleteFile*>>
+      filesByFieldIds;
+  for (const auto& deleteFile : deleteFiles) {
+    if (deleteFile.content == FileContent::kEqualityDeletes &&
+        deleteFile.recordCount > 0) {
+      filesByFieldIds[deleteFile.equalityFieldIds].push_back(&deleteFile);
+    }
+  }
+
+  for (const auto& entry : filesByFieldIds) {
+    const auto& files = entry.second;
+    // The splits of the Task with the same delete files share the set.
+    std::string key = connectorQueryCtx_->taskId();
+    for (const auto* file : files) {
+      key.append("\n").append(file->filePath);
+    }
+    auto deleteSet = EqualityDeleteSet::getOrLoad(
+        key, [&]() { return loadEqualityDeleteSet(files); });
+    if (deleteSet->numKeys() == 0) {
+      continue;
+    }
+    EqualityDeletes deletes;
+    const auto& keyType = deleteSet->keyType();
+    for (auto i = 0; i < keyType->size(); ++i) {
+      deletes.keyChannels.push_back(
+          addEqualityKeyColumn(keyType->nameOf(i), keyType->childAt(i)));
+    }
+    deletes.deleteSet = std::move(deleteSet);
+    equalityDeletes_.push_back(std::move(deletes));
+  }
+}
+
+std::shared_ptr<EqualityDeleteSet> IcebergSplitReader::loadEqualityDeleteSet(
+    const std::vector<const IcebergDeleteFile*>& deleteFiles) {
+  auto pool = createDeletePool("equalityDeletes");
+  std::shared_ptr<EqualityDeleteSet> deleteSet;
+  for (const auto* deleteFile : deleteFiles) {
+    EqualityDeleteFileReader reader(
+        *deleteFile,
+        fileHandleFactory_,
+        connectorQueryCtx_,
+        executor_,
+        hiveConfig_,
+        ioStats_,
+        fsStats_,
+        hiveSplit_->connectorId);
+    if (deleteSet == nullptr) {
+      const auto& fileType = reader.fileType();
+      std::vector<TypePtr> keyTypes;
+      for (auto i = 0; i < fileType->size(); ++i) {
+        keyTypes.push_back(
+            equalityKeyType(fileType->nameOf(i), fileType->childAt(i)));
+      }
+      deleteSet = std::make_shared<EqualityDeleteSet>(
+          ROW(fileType->names(), std::move(keyTypes)), pool);
+    }
+    reader.readDeletedKeys(*deleteSet);
+  }
+  deleteSet->finish();
+  return deleteSet;
+}
+
+TypePtr IcebergSplitReader::equalityKeyType(
+    const std::string& name,
+    const TypePtr& type) const {
+  if (auto channel = readerOutputType_->getChildIdxIfExists(name)) {
+    return readerOutputType_->childAt(*channel);
+  }
+  if (auto it = partitionKeys_->find(name); it != partitionKeys_->end()) {
+    return it->second->dataType();
+  }
+  if (const auto& dataColumns = hiveTableHandle_->dataColumns()) {
+    if (auto channel = dataColumns->getChildIdxIfExists(name)) {
+      return dataColumns->childAt(*channel);
+    }
+  }
+  return type;
+}
+
+column_index_t IcebergSplitReader::addEqualityKeyColumn(
+    const std::string& name,
+    const TypePtr& type) {
+  if (auto channel = readerOutputType_->getChildIdxIfExists(name)) {
+    VELOX_CHECK(
+        readerOutputType_->childAt(*channel)->equivalent(*type),
+        "Iceberg equality delete column {} has type {}, expected {}",
+        name,
+        type->toString(),
+        readerOutputType_->childAt(*channel)->toString());
+    return *channel;
+  }
+  // HiveDataSource drops the columns after its output columns.
+  const column_index_t channel = readerOutputType_->size();
+  auto names = readerOutputType_->names();
+  auto types = readerOutputType_->children();
+  names.push_back(name);
+  types.push_back(type);
+  readerOutputType_ = ROW(std::move(names), std::move(types));
+  scanSpec_->addField(name, channel);
+  return channel;
 }
 
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   Mutation mutation;
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
   mutation.deletedRows = nullptr;
+  const auto readSize =
+      positionalDeletes_ ? preparePositionalDeleteRows(size, mutation) : size;
 
-  if (deleteBitmap_ && deleteBitmapBitOffset_ > 0) {
-    // There are unconsumed bits from last batch
-    if (deleteBitmapBitOffset_ < deleteBitmap_->size() * 8) {
-      bits::copyBits(
-          deleteBitmap_->as<uint64_t>(),
-          deleteBitmapBitOffset_,
-          deleteBitmap_->asMutable<uint64_t>(),
-          0,
-          deleteBitmap_->size() * 8 - deleteBitmapBitOffset_);
-
-      uint64_t newBitMapSizeInBytes =
-          deleteBitmap_->size() - deleteBitmapBitOffset_ / 8;
-      if (deleteBitmapBitOffset_ % 8 != 0) {
-        newBitMapSizeInBytes--;
-      }
-      deleteBitmap_->setSize(newBitMapSizeInBytes);
-    } else {
-      // All bits were consumed, reset to 0 for all bits
-      std::memset(
-          (void*)(deleteBitmap_->asMutable<int8_t>()),
-          0L,
-          deleteBitmap_->size());
-    }
+  if (equalityDeletes_.empty()) {
+    return baseRowReader_->next(readSize, output, &mutation);
   }
 
-  if (!positionalDeleteFileReaders_.empty()) {
-    auto numBytes = bits::nbytes(size);
-    dwio::common::ensureCapacity<int8_t>(
-        deleteBitmap_, numBytes, connectorQueryCtx_->memoryPool(), true, true);
+  // Drops the reference to the previous batch so that the reader can reuse
+  // its vectors.
+  output.reset();
+  if (!baseOutput_) {
+    baseOutput_ = BaseVector::create(
+        readerOutputType_, 0, connectorQueryCtx_->memoryPool());
+  }
+  auto rowsScanned = baseRowReader_->next(readSize, baseOutput_, &mutation);
+  applyEqualityDeletes(output);
+  return rowsScanned;
+}
 
-    for (auto iter = positionalDeleteFileReaders_.begin();
-         iter != positionalDeleteFileReaders_.end();) {
-      (*iter)->readDeletePositions(baseReadOffset_, size, deleteBitmap_);
+uint64_t IcebergSplitReader::preparePositionalDeleteRows(
+    uint64_t size,
+    Mutation& mutation) {
+  const auto position = baseRowReader_->nextRowNumber();
+  if (position == RowReader::kAtEnd) {
+    return size;
+  }
+  auto readSize = size;
+  const auto numDeleted = positionalDeletes_->deletedRunLength(position);
+  if (numDeleted >= size) {
+    readSize = std::min(numDeleted, std::max(size, kMaxSkippedRows));
+  }
+  const auto numRows = baseRowReader_->nextReadSize(readSize);
+  if (numRows == RowReader::kAtEnd) {
+    return size;
+  }
 
-      if ((*iter)->noMoreData()) {
-        iter = positionalDeleteFileReaders_.erase(iter);
-      } else {
-        ++iter;
-      }
-    }
+  const auto numWords = bits::nwords(numRows);
+  dwio::common::ensureCapacity<uint64_t>(
+      deleteBitmap_, numWords, connectorQueryCtx_->memoryPool());
+  auto* deletedRows = deleteBitmap_->asMutable<uint64_t>();
+  std::memset(deletedRows, 0, numWords * sizeof(uint64_t));
+  if (positionalDeletes_->fillDeletedRows(position, numRows, deletedRows)) {
+    mutation.deletedRows = deletedRows;
   }
+  return numRows;
+}
 
-  mutation.deletedRows = deleteBitmap_ && deleteBitmap_->size() > 0
-      ? deleteBitmap_->as<uint64_t>()
-      : nullptr;
+void IcebergSplitReader::applyEqualityDeletes(VectorPtr& output) {
+  auto input = std::static_pointer_cast<RowVector>(baseOutput_);
+  output = input;
+  const auto numRows = input->size();
+  if (numRows == 0) {
+    return;
+  }
 
-  auto rowsScanned = baseRowReader_->next(size, output, &mutation);
-  baseReadOffset_ += rowsScanned;
-  deleteBitmapBitOffset_ = rowsScanned;
+  equalityDeleteRows_.resizeFill(numRows);
+  equalityDeletedRows_.assign(bits::nwords(numRows), 0);
+  std::vector<VectorPtr> keys;
+  for (auto& deletes : equalityDeletes_) {
+    keys.clear();
+    for (auto channel : deletes.keyChannels) {
+      keys.push_back(BaseVector::loadedVectorShared(input->childAt(channel)));
+    }
+    deletes.deleteSet->probe(
+        keys,
+        equalityDeleteRows_,
+        deletes.probeState,
+        equalityDeletedRows_.data());
+  }
 
-  return rowsScanned;
+  const auto numDeleted =
+      bits::countBits(equalityDeletedRows_.data(), 0, numRows);
+  if (numDeleted == 0) {
+    return;
+  }
+  const vector_size_t numRemaining = numRows - numDeleted;
+  auto indices =
+      allocateIndices(numRemaining, connectorQueryCtx_->memoryPool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numIndices = 0;
+  bits::forEachUnsetBit(
+      equalityDeletedRows_.data(), 0, numRows, [&](vector_size_t row) {
+        rawIndices[numIndices++] = row;
+      });
+  output = exec::wrap(numRemaining, std::move(indices), input);
 }
 
 } // namespace facebook::velox::connector::hive::iceberg
@@ -18,7 +18,8 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
-#include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteSet.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteBitmap.h"
 
 namespace facebook::velox::connector::hive::iceberg {
 
@@ -49,16 +50,68 @@ class IcebergSplitReader : public SplitReader {
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
  private:
-  // The read offset to the beginning of the split in number of rows for the
-  // current batch for the base data file
-  uint64_t baseReadOffset_;
-  // The file position for the first row in the split
-  uint64_t splitOffset_;
-  std::list<std::unique_ptr<PositionalDeleteFileReader>>
-      positionalDeleteFileReaders_;
+  // The equality deletes of the split that have the same equality columns.
+  struct EqualityDeletes {
+    std::shared_ptr<const EqualityDeleteSet> deleteSet;
+    // The channels of the key columns in the reader output.
+    std::vector<column_index_t> keyChannels;
+    EqualityDeleteSet::ProbeState probeState;
+  };
+
+  // Creates the memory pool of the delete files shared by the splits of the
+  // Task.
+  std::shared_ptr<memory::MemoryPool> createDeletePool(
+      const std::string& kind) const;
+
+  // Gets the decoded positional deletes of the data file.
+  void preparePositionalDeletes(
+      const std::vector<IcebergDeleteFile>& deleteFiles,
+      dwio::common::RuntimeStatistics& runtimeStats);
+
+  // Reads the deleted positions of the data file from 'deleteFiles'.
+  std::shared_ptr<PositionalDeleteBitmap> loadPositionalDeletes(
+      const std::vector<const IcebergDeleteFile*>& deleteFiles,
+      dwio::common::RuntimeStatistics& runtimeStats);
+
+  // Sets the deleted rows of 'mutation' for the next batch of at most 'size'
+  // rows and returns the number of rows to read. A batch that starts with at
+  // least 'size' deleted rows covers the whole run of deleted rows, so that
+  // the reader skips them without materializing any column.
+  uint64_t preparePositionalDeleteRows(
+      uint64_t size,
+      dwio::common::Mutation& mutation);
+
+  // Gets the delete sets of the equality delete files in 'deleteFiles' and
+  // adds their key columns to the reader output.
+  void prepareEqualityDeletes(
+      const std::vector<IcebergDeleteFile>& deleteFiles);
+
+  // Reads the keys of 'deleteFiles', which have the same equality columns.
+  std::shared_ptr<EqualityDeleteSet> loadEqualityDeleteSet(
+      const std::vector<const IcebergDeleteFile*>& deleteFiles);
+
+  // Returns the type of the equality key column 'name' in the table. 'type'
+  // is its type in the delete file.
+  TypePtr equalityKeyType(const std::string& name, const TypePtr& type) const;
+
+  // Returns the channel of the column 'name' in the reader output. Adds the
+  // column after the output columns if it is not read yet.
+  column_index_t addEqualityKeyColumn(
+      const std::string& name,
+      const TypePtr& type);
+
+  // Sets 'output' to the rows of 'baseOutput_' that are not deleted by
+  // 'equalityDeletes_'.
+  void applyEqualityDeletes(VectorPtr& output);
+
+  // The deleted positions of the data file, shared by its splits.
+  std::shared_ptr<const PositionalDeleteBitmap> positionalDeletes_;
   BufferPtr deleteBitmap_;
-  // The offset in bits of the deleteBitmap_ starting from where the bits shall
-  // be consumed
-  uint64_t deleteBitmapBitOffset_;
+
+  std::vector<EqualityDeletes> equalityDeletes_;
+  // The output of the base row reader if there are equality deletes.
+  VectorPtr baseOutput_;
+  SelectivityVector equalityDeleteRows_;
+  std::vector<uint64_t> equalityDeletedRows_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
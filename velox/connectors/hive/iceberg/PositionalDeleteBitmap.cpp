@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/PositionalDeleteBitmap.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/connectors/hive/iceberg/DeleteFileCache.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+constexpr int32_t kChunkWords = PositionalDeleteBitmap::kChunkSize / 64;
+
+// Returns the first unset bit at or after 'begin' in the 'words' of a chunk, or
+// kChunkSize if all are set.
+uint64_t findFirstUnsetBit(const uint64_t* words, uint64_t begin) {
+  for (auto i = begin / 64; i < kChunkWords; ++i) {
+    uint64_t word = ~words[i];
+    if (i == begin / 64) {
+      word &= ~bits::lowMask(begin % 64);
+    }
+    if (word != 0) {
+      return i * 64 + __builtin_ctzll(word);
+    }
+  }
+  return PositionalDeleteBitmap::kChunkSize;
+}
+
+DeleteFileCache<PositionalDeleteBitmap>& bitmapCache() {
+  static DeleteFileCache<PositionalDeleteBitmap> cache;
+  return cache;
+}
+} // namespace
+
+PositionalDeleteBitmap::PositionalDeleteBitmap(
+    std::shared_ptr<memory::MemoryPool> pool)
+    : pool_(std::move(pool)) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+void PositionalDeleteBitmap::add(
+    const int64_t* positions,
+    int32_t numPositions) {
+  VELOX_CHECK(
+      !finished_, "Cannot add positions to a finished PositionalDeleteBitmap");
+  for (auto i = 0; i < numPositions; ++i) {
+    VELOX_CHECK_GE(
+        positions[i], 0, "Iceberg delete file pos column must not be negative");
+    const uint64_t key = positions[i] >> kChunkBits;
+    const uint16_t offset = positions[i] & (kChunkSize - 1);
+    auto it = chunkIndex_.find(key);
+    if (it == chunkIndex_.end()) {
+      it = chunkIndex_.emplace(key, chunks_.size()).first;
+      chunks_.emplace_back(*pool_);
+      chunks_.back().key = key;
+    }
+    auto& chunk = chunks_[it->second];
+    if (chunk.kind == ChunkKind::kBitmap) {
+      bits::setBit(chunk.bits.data(), offset);
+      continue;
+    }
+    chunk.array.push_back(offset);
+    // Removes the duplicates before deciding that the chunk is dense.
+    if (chunk.array.size() > 2 * kMaxArraySize) {
+      sortArray(chunk);
+      if (chunk.array.size() > kMaxArraySize) {
+        toBitmap(chunk);
+      }
+    }
+  }
+}
+
+void PositionalDeleteBitmap::finish() {
+  VELOX_CHECK(!finished_);
+  finished_ = true;
+  chunkIndex_.clear();
+  for (auto& chunk : chunks_) {
+    if (chunk.kind == ChunkKind::kArray) {
+      sortArray(chunk);
+      if (chunk.array.size() > kMaxArraySize) {
+        toBitmap(chunk);
+      }
+    }
+    if (chunk.kind == ChunkKind::kBitmap) {
+      chunk.numDeleted = bits::countBits(chunk.bits.data(), 0, kChunkSize);
+      if (chunk.numDeleted == static_cast<int32_t>(kChunkSize)) {
+        chunk.kind = ChunkKind::kFull;
+        chunk.bits.clear();
+        chunk.bits.shrink_to_fit();
+      }
+    } else {
+      chunk.numDeleted = chunk.array.size();
+      chunk.array.shrink_to_fit();
+    }
+    numDeleted_ += chunk.numDeleted;
+  }
+  std::sort(
+      chunks_.begin(), chunks_.end(), [](const auto& left, const auto& right) {
+        return left.key < right.key;
+      });
+}
+
+// static
+void PositionalDeleteBitmap::sortArray(Chunk& chunk) {
+  std::sort(chunk.array.begin(), chunk.array.end());
+  chunk.array.erase(
+      std::unique(chunk.array.begin(), chunk.array.end()), chunk.array.end());
+}
+
+// static
+void PositionalDeleteBitmap::toBitmap(Chunk& chunk) {
+  chunk.bits.resize(kChunkWords);
+  for (auto offset : chunk.array) {
+    bits::setBit(chunk.bits.data(), offset);
+  }
+  chunk.array.clear();
+  chunk.array.shrink_to_fit();
+  chunk.kind = ChunkKind::kBitmap;
+}
+
+const PositionalDeleteBitmap::Chunk* PositionalDeleteBitmap::findChunk(
+    uint64_t key) const {
+  auto it = std::lower_bound(
+      chunks_.begin(), chunks_.end(), key, [](const auto& chunk, auto value) {
+        return chunk.key < value;
+      });
+  return it != chunks_.end() && it->key == key ? &*it : nullptr;
+}
+
+bool PositionalDeleteBitmap::fillDeletedRows(
+    uint64_t begin,
+    int32_t numRows,
+    uint64_t* deletedRows) const {
+  VELOX_DCHECK(finished_);
+  const uint64_t end = begin + numRows;
+  auto it = std::lower_bound(
+      chunks_.begin(),
+      chunks_.end(),
+      begin >> kChunkBits,
+      [](const auto& chunk, auto key) { return chunk.key < key; });
+  bool anyDeleted = false;
+  for (; it != chunks_.end() && (it->key << kChunkBits) < end; ++it) {
+    const uint64_t chunkBegin = it->key << kChunkBits;
+    // The range of the chunk in the rows and its offset in 'deletedRows'.
+    const int32_t low = std::max(begin, chunkBegin) - chunkBegin;
+    const int32_t high = std::min(end, chunkBegin + kChunkSize) - chunkBegin;
+    const int32_t offset = chunkBegin + low - begin;
+    switch (it->kind) {
+      case ChunkKind::kFull:
+        bits::fillBits(deletedRows, offset, offset + high - low, true);
+        anyDeleted = true;
+        break;
+      case ChunkKind::kBitmap:
+        if (bits::findFirstBit(it->bits.data(), low, high) >= 0) {
+          bits::copyBits(
+              it->bits.data(), low, deletedRows, offset, high - low);
+          anyDeleted = true;
+        }
+        break;
+      case ChunkKind::kArray:
+        for (auto row = std::lower_bound(
+                 it->array.begin(), it->array.end(), low);
+             row != it->array.end() && *row < high;
+             ++row) {
+          bits::setBit(deletedRows, offset + *row - low);
+          anyDeleted = true;
+        }
+        break;
+    }
+  }
+  return anyDeleted;
+}
+
+uint64_t PositionalDeleteBitmap::deletedRunLength(uint64_t position) const {
+  VELOX_DCHECK(finished_);
+  uint64_t key = position >> kChunkBits;
+  uint64_t offset = position & (kChunkSize - 1);
+  uint64_t length = 0;
+  // A run continues into the next chunk if it reaches the end of the chunk.
+  for (const auto* chunk = findChunk(key); chunk != nullptr;) {
+    uint64_t end = offset;
+    switch (chunk->kind) {
+      case ChunkKind::kFull:
+        end = kChunkSize;
+        break;
+      case ChunkKind::kBitmap:
+        end = findFirstUnsetBit(chunk->bits.data(), offset);
+        break;
+      case ChunkKind::kArray: {
+        auto row =
+            std::lower_bound(chunk->array.begin(), chunk->array.end(), offset);
+        for (; row != chunk->array.end() && *row == end; ++row) {
+          ++end;
+        }
+        break;
+      }
+    }
+    length += end - offset;
+    if (end < kChunkSize) {
+      break;
+    }
+    offset = 0;
+    ++chunk;
+    if (chunk == chunks_.data() + chunks_.size() || chunk->key != ++key) {
+      break;
+    }
+  }
+  return length;
+}
+
+bool PositionalDeleteBitmap::isDeleted(uint64_t position) const {
+  VELOX_DCHECK(finished_);
+  const auto* chunk = findChunk(position >> kChunkBits);
+  if (chunk == nullptr) {
+    return false;
+  }
+  const uint16_t offset = position & (kChunkSize - 1);
+  switch (chunk->kind) {
+    case ChunkKind::kFull:
+      return true;
+    case ChunkKind::kBitmap:
+      return bits::isBitSet(chunk->bits.data(), offset);
+    case ChunkKind::kArray:
+      return std::binary_search(
+          chunk->array.begin(), chunk->array.end(), offset);
+  }
+  VELOX_UNREACHABLE();
+}
+
+std::optional<PositionalDeleteBitmap::ChunkKind>
+PositionalDeleteBitmap::chunkKind(uint64_t position) const {
+  if (const auto* chunk = findChunk(position >> kChunkBits)) {
+    return chunk->kind;
+  }
+  return std::nullopt;
+}
+
+// static
+std::shared_ptr<const PositionalDeleteBitmap>
+PositionalDeleteBitmap::getOrLoad(
+    const std::string& key,
+    const std::function<std::shared_ptr<PositionalDeleteBitmap>()>& load) {
+  return bitmapCache().getOrLoad(key, [&]() {
+    auto bitmap = load();
+    VELOX_CHECK(bitmap->finished_);
+    return bitmap;
+  });
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
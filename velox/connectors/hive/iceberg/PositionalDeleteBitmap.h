@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "velox/common/memory/MemoryPool.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// The deleted row positions of a data file, decoded from its Iceberg
+/// positional delete files. Like a roaring bitmap, the positions are split
+/// into chunks of 64K rows. A chunk with few deleted rows is a sorted array
+/// of 16 bit offsets, a chunk with many is a bitmap and a chunk with all rows
+/// deleted takes no memory. The bitmap is built once and is immutable
+/// afterwards, so that the splits of the data file read it concurrently. All
+/// memory is allocated from 'pool'.
+class PositionalDeleteBitmap {
+ public:
+  static constexpr int32_t kChunkBits = 16;
+  static constexpr uint64_t kChunkSize = 1UL << kChunkBits;
+  // The largest array chunk. A bitmap chunk takes as much memory.
+  static constexpr int32_t kMaxArraySize = 4096;
+
+  enum class ChunkKind {
+    kArray,
+    kBitmap,
+    kFull,
+  };
+
+  explicit PositionalDeleteBitmap(std::shared_ptr<memory::MemoryPool> pool);
+
+  /// Adds 'numPositions' deleted row positions in any order. May only be
+  /// called before finish().
+  void add(const int64_t* positions, int32_t numPositions);
+
+  /// Sorts and compresses the chunks.
+  void finish();
+
+  /// Sets bit 'i' of 'deletedRows' if row 'begin + i' is deleted, for 'i' in
+  /// [0, numRows). The first 'numRows' bits of 'deletedRows' must be clear.
+  /// Returns true if any row in the range is deleted.
+  bool fillDeletedRows(
+      uint64_t begin,
+      int32_t numRows,
+      uint64_t* deletedRows) const;
+
+  /// Returns the number of consecutive deleted rows starting at 'position'.
+  uint64_t deletedRunLength(uint64_t position) const;
+
+  bool isDeleted(uint64_t position) const;
+
+  /// Returns the number of distinct deleted rows.
+  uint64_t numDeleted() const {
+    return numDeleted_;
+  }
+
+  int32_t numChunks() const {
+    return chunks_.size();
+  }
+
+  /// Returns the kind of the chunk of 'position', or std::nullopt if no row
+  /// in the chunk is deleted.
+  std::optional<ChunkKind> chunkKind(uint64_t position) const;
+
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  /// Returns the bitmap for 'key' if another reader holds it. Otherwise
+  /// builds it with 'load'. Concurrent callers with the same 'key' wait for
+  /// the first one to build the bitmap. The bitmap is released with the last
+  /// reference to it.
+  static std::shared_ptr<const PositionalDeleteBitmap> getOrLoad(
+      const std::string& key,
+      const std::function<std::shared_ptr<PositionalDeleteBitmap>()>& load);
+
+ private:
+  struct Chunk {
+    explicit Chunk(memory::MemoryPool& pool) : array(pool), bits(pool) {}
+
+    // The high bits of the positions in the chunk.
+    uint64_t key{0};
+    ChunkKind kind{ChunkKind::kArray};
+    // The number of deleted rows after finish().
+    int32_t numDeleted{0};
+    // The low bits of the positions in kArray mode. Unsorted and possibly
+    // with duplicates before finish().
+    std::vector<uint16_t, memory::StlAllocator<uint16_t>> array;
+    // The bits of the positions in kBitmap mode.
+    std::vector<uint64_t, memory::StlAllocator<uint64_t>> bits;
+  };
+
+  static void sortArray(Chunk& chunk);
+
+  static void toBitmap(Chunk& chunk);
+
+  // Returns the chunk with 'key' or nullptr if none.
+  const Chunk* findChunk(uint64_t key) const;
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  // The chunks in ascending order of key after finish().
+  std::vector<Chunk> chunks_;
+  // The index of the chunk for each key while adding positions.
+  folly::F14FastMap<uint64_t, int32_t> chunkIndex_;
+  bool finished_{false};
+  uint64_t numDeleted_{0};
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -29,7 +29,10 @@ namespace facebook::velox::connector::hive::iceberg {
 
 struct IcebergDeleteFile;
 struct IcebergMetadataColumn;
+class PositionalDeleteBitmap;
 
+/// Reads the positions of the rows of a data file that are deleted by an
+/// Iceberg positional delete file.
 class PositionalDeleteFileReader {
  public:
   PositionalDeleteFileReader(
@@ -42,25 +45,12 @@ class PositionalDeleteFileReader {
       const std::shared_ptr<io::IoStatistics>& ioStats,
       const std::shared_ptr<filesystems::File::IoStats>& fsStats,
       dwio::common::RuntimeStatistics& runtimeStats,
-      uint64_t splitOffset,
       const std::string& connectorId);
 
-  void readDeletePositions(
-      uint64_t baseReadOffset,
-      uint64_t size,
-      BufferPtr deleteBitmap);
-
-  bool noMoreData();
+  /// Adds the positions of the deleted rows of the base file to 'bitmap'.
+  void readDeletePositions(PositionalDeleteBitmap& bitmap);
 
  private:
-  void updateDeleteBitmap(
-      VectorPtr deletePositionsVector,
-      uint64_t baseReadOffset,
-      int64_t rowNumberUpperBound,
-      BufferPtr deleteBitmapBuffer);
-
-  bool readFinishedForBatch(int64_t rowNumberUpperBound);
-
   const IcebergDeleteFile& deleteFile_;
   const std::string& baseFilePath_;
   FileHandleFactory* const fileHandleFactory_;
@@ -68,26 +58,13 @@ class PositionalDeleteFileReader {
   const std::shared_ptr<const HiveConfig> hiveConfig_;
   const std::shared_ptr<io::IoStatistics> ioStats_;
   const std::shared_ptr<filesystems::File::IoStats> fsStats_;
-  const std::shared_ptr<filesystems::File::IoStats> fsStats;
   memory::MemoryPool* const pool_;
 
   std::shared_ptr<IcebergMetadataColumn> filePathColumn_;
   std::shared_ptr<IcebergMetadataColumn> posColumn_;
-  uint64_t splitOffset_;
 
   std::shared_ptr<HiveConnectorSplit> deleteSplit_;
   std::unique_ptr<dwio::common::RowReader> deleteRowReader_;
-  // The vector to hold the delete positions read from the positional delete
-  // file. These positions are relative to the start of the whole base data
-  // file.
-  VectorPtr deletePositionsOutput_;
-  // The index of deletePositionsOutput_ that indicates up to where the delete
-  // positions have been converted into the bitmap
-  uint64_t deletePositionsOffset_;
-  // Total number of rows read from this positional delete file reader,
-  // including the rows filtered out from filters on both filePathColumn_ and
-  // posColumn_.
-  uint64_t totalNumRowsScanned_;
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
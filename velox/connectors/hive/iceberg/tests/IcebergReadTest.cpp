@@ -17,9 +17,11 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteSet.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteBitmap.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -695,6 +697,107 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
   assertMultipleSplits({1000, 9000, 20000}, 1, 0, 20000, 3);
 }
 
+TEST_F(HiveIcebergTest, positionalDeletesDeletedRanges) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  // Runs of deleted rows longer than a batch are skipped in one read.
+  auto deletePositions = makeContinuousIncreasingValues(5'000, 150'000);
+  auto tail = makeRandomIncreasingValues(150'000, 200'000);
+  deletePositions.insert(deletePositions.end(), tail.begin(), tail.end());
+  assertMultipleSplits(deletePositions, 2, 0, 200'000, 3);
+  assertMultipleSplits(
+      makeContinuousIncreasingValues(0, 200'000), 1, 0, 200'000, 4);
+}
+
+TEST_F(HiveIcebergTest, positionalDeleteBitmap) {
+  constexpr auto kChunkSize = PositionalDeleteBitmap::kChunkSize;
+  auto bitmap = std::make_shared<PositionalDeleteBitmap>(pool_);
+  // A sparse chunk with duplicates.
+  std::vector<int64_t> positions{7, 3, 5, 3, 4};
+  // A dense chunk.
+  for (uint64_t i = 0; i < kChunkSize; i += 3) {
+    positions.push_back(kChunkSize + i);
+  }
+  // A chunk with all rows deleted, followed by a run into the next chunk.
+  for (uint64_t i = 0; i < kChunkSize + 10; ++i) {
+    positions.push_back(3 * kChunkSize - 5 + i);
+  }
+  bitmap->add(positions.data(), positions.size());
+  bitmap->finish();
+  VELOX_ASSERT_THROW(
+      bitmap->add(positions.data(), 1),
+      "Cannot add positions to a finished PositionalDeleteBitmap");
+
+  using ChunkKind = PositionalDeleteBitmap::ChunkKind;
+  ASSERT_EQ(bitmap->numChunks(), 5);
+  ASSERT_EQ(bitmap->chunkKind(0), ChunkKind::kArray);
+  ASSERT_EQ(bitmap->chunkKind(kChunkSize), ChunkKind::kBitmap);
+  ASSERT_EQ(bitmap->chunkKind(2 * kChunkSize), ChunkKind::kArray);
+  ASSERT_EQ(bitmap->chunkKind(3 * kChunkSize), ChunkKind::kFull);
+  ASSERT_EQ(bitmap->chunkKind(4 * kChunkSize), ChunkKind::kArray);
+  ASSERT_FALSE(bitmap->chunkKind(5 * kChunkSize).has_value());
+  ASSERT_EQ(bitmap->numDeleted(), 4 + (kChunkSize + 2) / 3 + kChunkSize + 10);
+
+  ASSERT_TRUE(bitmap->isDeleted(4));
+  ASSERT_FALSE(bitmap->isDeleted(6));
+  ASSERT_TRUE(bitmap->isDeleted(kChunkSize + 3));
+  ASSERT_FALSE(bitmap->isDeleted(kChunkSize + 4));
+  ASSERT_TRUE(bitmap->isDeleted(3 * kChunkSize + 100));
+  ASSERT_FALSE(bitmap->isDeleted(4 * kChunkSize + 5));
+
+  ASSERT_EQ(bitmap->deletedRunLength(3), 3);
+  ASSERT_EQ(bitmap->deletedRunLength(6), 0);
+  ASSERT_EQ(bitmap->deletedRunLength(kChunkSize + 3), 1);
+  ASSERT_EQ(bitmap->deletedRunLength(3 * kChunkSize - 5), kChunkSize + 10);
+  ASSERT_EQ(bitmap->deletedRunLength(3 * kChunkSize + 7), kChunkSize - 2);
+  ASSERT_EQ(bitmap->deletedRunLength(10 * kChunkSize), 0);
+
+  // Ranges that cross the chunks.
+  auto deletedRows = [&](uint64_t begin, int32_t numRows) {
+    std::vector<uint64_t> deletedBits(bits::nwords(numRows));
+    const bool anyDeleted =
+        bitmap->fillDeletedRows(begin, numRows, deletedBits.data());
+    std::vector<uint64_t> rows;
+    bits::forEachSetBit(deletedBits.data(), 0, numRows, [&](auto row) {
+      rows.push_back(begin + row);
+    });
+    EXPECT_EQ(anyDeleted, !rows.empty());
+    return rows;
+  };
+  ASSERT_EQ(deletedRows(1, 10), (std::vector<uint64_t>{3, 4, 5, 7}));
+  ASSERT_EQ(deletedRows(8, 100), std::vector<uint64_t>{});
+  ASSERT_EQ(
+      deletedRows(kChunkSize - 2, 8),
+      (std::vector<uint64_t>{kChunkSize, kChunkSize + 3}));
+  ASSERT_EQ(
+      deletedRows(3 * kChunkSize - 7, 4),
+      (std::vector<uint64_t>{3 * kChunkSize - 5, 3 * kChunkSize - 4}));
+  auto rows = deletedRows(2 * kChunkSize, 3 * kChunkSize);
+  ASSERT_EQ(rows.size(), kChunkSize + 10);
+  ASSERT_EQ(rows.front(), 3 * kChunkSize - 5);
+  ASSERT_EQ(rows.back(), 4 * kChunkSize + 4);
+  for (auto row : rows) {
+    ASSERT_TRUE(bitmap->isDeleted(row));
+  }
+
+  // A bitmap is shared while it is referenced.
+  int32_t numLoads{0};
+  auto load = [&]() {
+    ++numLoads;
+    auto emptyBitmap = std::make_shared<PositionalDeleteBitmap>(pool_);
+    emptyBitmap->finish();
+    return emptyBitmap;
+  };
+  auto first = PositionalDeleteBitmap::getOrLoad("positionalDeletes", load);
+  auto second = PositionalDeleteBitmap::getOrLoad("positionalDeletes", load);
+  ASSERT_EQ(first.get(), second.get());
+  ASSERT_EQ(numLoads, 1);
+  first.reset();
+  second.reset();
+  PositionalDeleteBitmap::getOrLoad("positionalDeletes", load);
+  ASSERT_EQ(numLoads, 2);
+}
+
 TEST_F(HiveIcebergTest, testPartitionedRead) {
   RowTypePtr rowType{ROW({"c0", "ds"}, {BIGINT(), DateType::get()})};
   std::unordered_map<std::string, std::optional<std::string>> partitionKeys;
@@ -775,4 +878,183 @@ TEST_F(HiveIcebergTest, testPartitionedRead) {
 
   HiveConnectorTestBase::assertQuery(plan, splits, "SELECT 0, '2018-04-06'");
 }
+
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  std::vector<RowVectorPtr> dataVectors;
+  std::vector<std::shared_ptr<TempFilePath>> dataFilePaths;
+  for (int i = 0; i < 2; ++i) {
+    dataVectors.push_back(makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<int64_t>(
+             1'000, [&](auto row) { return i * 1'000 + row; }),
+         makeFlatVector<std::string>(1'000, [&](auto row) {
+           return fmt::format("s{}", row % 100);
+         })}));
+    dataFilePaths.push_back(TempFilePath::create());
+    writeToFile(
+        dataFilePaths.back()->getPath(),
+        {dataVectors.back()},
+        config_,
+        flushPolicyFactory_);
+  }
+  createDuckDbTable(dataVectors);
+
+  std::vector<std::shared_ptr<TempFilePath>> deleteFilePaths;
+  auto writeDeleteFile = [&](const RowVectorPtr& deletedKeys,
+                             std::vector<int32_t> equalityFieldIds) {
+    deleteFilePaths.push_back(TempFilePath::create());
+    const auto path = deleteFilePaths.back()->getPath();
+    writeToFile(path, {deletedKeys}, config_, flushPolicyFactory_);
+    return IcebergDeleteFile(
+        FileContent::kEqualityDeletes,
+        path,
+        fileFomat_,
+        deletedKeys->size(),
+        filesystems::getFileSystem(path, nullptr)
+            ->openFileForRead(path)
+            ->size(),
+        std::move(equalityFieldIds));
+  };
+  // Some splits of both data files share the delete files.
+  auto makeSplits = [&](const std::vector<IcebergDeleteFile>& deleteFiles) {
+    std::vector<std::shared_ptr<ConnectorSplit>> splits;
+    for (const auto& dataFilePath : dataFilePaths) {
+      auto icebergSplits =
+          makeIcebergSplits(dataFilePath->getPath(), deleteFiles, {}, 2);
+      splits.insert(splits.end(), icebergSplits.begin(), icebergSplits.end());
+    }
+    return splits;
+  };
+
+  const auto c0Deletes = writeDeleteFile(
+      makeRowVector(
+          {"c0"}, {makeFlatVector<int64_t>({0, 1, 999, 1'000, 1'500, 5'000})}),
+      {1});
+  auto splits = makeSplits({c0Deletes});
+  const std::string c0NotDeleted = "c0 NOT IN (0, 1, 999, 1000, 1500)";
+
+  auto plan = PlanBuilder(pool_.get()).tableScan(rowType).planNode();
+  assertQuery(plan, splits, "SELECT * FROM tmp WHERE " + c0NotDeleted);
+
+  // The key column is read but not returned.
+  plan = PlanBuilder(pool_.get())
+             .tableScan(ROW({"c1"}, {VARCHAR()}), {}, "", rowType)
+             .planNode();
+  assertQuery(plan, splits, "SELECT c1 FROM tmp WHERE " + c0NotDeleted);
+
+  // The key column only has a filter.
+  plan = PlanBuilder(pool_.get())
+             .tableScan(ROW({"c1"}, {VARCHAR()}), {"c0 < 1200"}, "", rowType)
+             .planNode();
+  assertQuery(
+      plan, splits, "SELECT c1 FROM tmp WHERE c0 < 1200 AND " + c0NotDeleted);
+
+  // Delete files with different equality columns.
+  const auto c1Deletes = writeDeleteFile(
+      makeRowVector({"c1"}, {makeFlatVector<std::string>({"s7", "s70"})}),
+      {2});
+  const auto c0c1Deletes = writeDeleteFile(
+      makeRowVector(
+          {"c0", "c1"},
+          {makeFlatVector<int64_t>({10, 11, 12}),
+           makeFlatVector<std::string>({"s10", "s10", "s12"})}),
+      {1, 2});
+  splits = makeSplits({c0Deletes, c1Deletes, c0c1Deletes});
+  plan = PlanBuilder(pool_.get()).tableScan(rowType).planNode();
+  assertQuery(
+      plan,
+      splits,
+      "SELECT * FROM tmp WHERE " + c0NotDeleted +
+          " AND c1 NOT IN ('s7', 's70') AND c0 NOT IN (10, 12)");
+}
+
+TEST_F(HiveIcebergTest, equalityDeleteSet) {
+  auto probe = [&](const EqualityDeleteSet& deleteSet,
+                   const std::vector<VectorPtr>& keys) {
+    const auto numRows = keys[0]->size();
+    SelectivityVector rows(numRows);
+    std::vector<uint64_t> deletedBits(bits::nwords(numRows));
+    EqualityDeleteSet::ProbeState state;
+    deleteSet.probe(keys, rows, state, deletedBits.data());
+    std::vector<vector_size_t> deletedRows;
+    bits::forEachSetBit(deletedBits.data(), 0, numRows, [&](auto row) {
+      deletedRows.push_back(row);
+    });
+    return deletedRows;
+  };
+
+  // Integer keys in a small range are looked up in a bitmap. Null keys match
+  // null values.
+  auto deleteSet =
+      std::make_shared<EqualityDeleteSet>(ROW({"c0"}, {BIGINT()}), pool_);
+  deleteSet->add(makeRowVector(
+      {makeNullableFlatVector<int64_t>({1, 5, 100, 5, std::nullopt})}));
+  deleteSet->finish();
+  ASSERT_EQ(deleteSet->mode(), EqualityDeleteSet::Mode::kArray);
+  ASSERT_EQ(deleteSet->numKeys(), 4);
+  ASSERT_EQ(
+      probe(
+          *deleteSet,
+          {makeNullableFlatVector<int64_t>(
+              {0, 1, 5, 7, 100, std::nullopt, 101})}),
+      (std::vector<vector_size_t>{1, 2, 4, 5}));
+
+  // Many combinations of few distinct values are normalized keys.
+  deleteSet = std::make_shared<EqualityDeleteSet>(
+      ROW({"c0", "c1"}, {BIGINT(), VARCHAR()}), pool_);
+  deleteSet->add(makeRowVector(
+      {makeFlatVector<int64_t>(300, [](auto row) { return row * 1'000'003; }),
+       makeFlatVector<std::string>(
+           300, [](auto row) { return fmt::format("key{}", row); })}));
+  deleteSet->finish();
+  ASSERT_EQ(deleteSet->mode(), EqualityDeleteSet::Mode::kNormalizedKey);
+  ASSERT_EQ(deleteSet->numKeys(), 300);
+  ASSERT_EQ(
+      probe(
+          *deleteSet,
+          {makeFlatVector<int64_t>(
+               {0, 1'000'003, 5'000'015, 7, 299'000'897, 2'000'006}),
+           makeFlatVector<std::string>(
+               {"key0", "key2", "key5", "key7", "key299", "other"})}),
+      (std::vector<vector_size_t>{0, 2, 4}));
+
+  // Floating point keys are hashed.
+  deleteSet =
+      std::make_shared<EqualityDeleteSet>(ROW({"c0"}, {DOUBLE()}), pool_);
+  deleteSet->add(makeRowVector(
+      {makeNullableFlatVector<double>({0.5, 1.5, std::nullopt})}));
+  deleteSet->add(makeRowVector({makeFlatVector<double>({1.5})}));
+  deleteSet->finish();
+  ASSERT_EQ(deleteSet->mode(), EqualityDeleteSet::Mode::kHash);
+  ASSERT_EQ(deleteSet->numKeys(), 3);
+  ASSERT_EQ(
+      probe(
+          *deleteSet,
+          {makeNullableFlatVector<double>({0.5, 2.5, std::nullopt, 1.5})}),
+      (std::vector<vector_size_t>{0, 2, 3}));
+  VELOX_ASSERT_THROW(
+      deleteSet->add(makeRowVector({makeFlatVector<double>({1.0})})),
+      "Cannot add keys to a finished EqualityDeleteSet");
+
+  // A set is shared while it is referenced.
+  int32_t numLoads{0};
+  auto load = [&]() {
+    ++numLoads;
+    auto emptySet =
+        std::make_shared<EqualityDeleteSet>(ROW({"c0"}, {BIGINT()}), pool_);
+    emptySet->finish();
+    return emptySet;
+  };
+  auto first = EqualityDeleteSet::getOrLoad("equalityDeleteSet", load);
+  auto second = EqualityDeleteSet::getOrLoad("equalityDeleteSet", load);
+  ASSERT_EQ(first.get(), second.get());
+  ASSERT_EQ(numLoads, 1);
+  first.reset();
+  second.reset();
+  EqualityDeleteSet::getOrLoad("equalityDeleteSet", load);
+  ASSERT_EQ(numLoads, 2);
+}
 } // namespace facebook::velox::connector::hive::iceberg
@@ -26,7 +26,6 @@ std::string_view HdfsFileSystem::kViewfsScheme("viewfs://");
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(
       const config::ConfigBase* config,
       const HdfsServiceEndpoint& endpoint) {
@@ -47,6 +46,7 @@ class HdfsFileSystem::Impl {
       driver_->BuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
     }
     driver_->BuilderSetForceNewInstance(builder);
+    setReadOptions(builder, config);
     hdfsClient_ = driver_->BuilderConnect(builder);
     VELOX_CHECK_NOT_NULL(
         hdfsClient_,
@@ -73,6 +73,53 @@ class HdfsFileSystem::Impl {
   }
 
  private:
+  // Passes the short-circuit and hedged read settings in 'config' to the
+  // client. Settings not given keep the values of the client configuration
+  // files.
+  void setReadOptions(hdfsBuilder* builder, const config::ConfigBase* config) {
+    if (config == nullptr) {
+      return;
+    }
+    if (config->get<bool>(kShortCircuitRead, false)) {
+      const auto socketPath = config->get<std::string>(kDomainSocketPath);
+      VELOX_USER_CHECK(
+          socketPath.hasValue() && !socketPath->empty(),
+          "{} requires {}",
+          kShortCircuitRead,
+          kDomainSocketPath);
+      setOption(builder, "dfs.client.read.shortcircuit", "true");
+      setOption(builder, "dfs.domain.socket.path", *socketPath);
+    }
+    if (const auto poolSize = config->get<int32_t>(kHedgedReadThreadPoolSize);
+        poolSize.hasValue()) {
+      VELOX_USER_CHECK_GE(*poolSize, 0, "{}", kHedgedReadThreadPoolSize);
+      setOption(
+          builder,
+          "dfs.client.hedged.read.threadpool.size",
+          std::to_string(*poolSize));
+    }
+    if (const auto thresholdMs = config->get<int64_t>(kHedgedReadThresholdMs);
+        thresholdMs.hasValue()) {
+      VELOX_USER_CHECK_GT(*thresholdMs, 0, "{}", kHedgedReadThresholdMs);
+      setOption(
+          builder,
+          "dfs.client.hedged.read.threshold.millis",
+          std::to_string(*thresholdMs));
+    }
+  }
+
+  void setOption(
+      hdfsBuilder* builder,
+      const char* key,
+      const std::string& value) {
+    VELOX_CHECK_EQ(
+        driver_->BuilderConfSetStr(builder, key, value.c_str()),
+        0,
+        "Unable to set HDFS client option {}={}",
+        key,
+        value);
+  }
+
   hdfsFS hdfsClient_;
   filesystems::arrow::io::internal::LibHdfsShim* driver_;
 };
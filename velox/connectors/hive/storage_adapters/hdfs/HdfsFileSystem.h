@@ -96,6 +96,26 @@ class HdfsFileSystem : public FileSystem {
       const std::string_view filePath,
       const config::ConfigBase* config);
 
+  /// Enables short-circuit reads. Blocks stored on the local datanode
+  /// are read directly from its disks through the domain socket given by
+  /// kDomainSocketPath instead of being streamed over TCP.
+  static constexpr const char* kShortCircuitRead =
+      "hive.hdfs.read.short-circuit";
+
+  /// Path of the UNIX domain socket shared with the local datanode. Must
+  /// match dfs.domain.socket.path of the datanode.
+  static constexpr const char* kDomainSocketPath =
+      "hive.hdfs.domain-socket-path";
+
+  /// Number of threads used for hedged reads. 0 disables hedged reads.
+  static constexpr const char* kHedgedReadThreadPoolSize =
+      "hive.hdfs.hedged-read.threadpool-size";
+
+  /// Time to wait for a datanode to answer a read before issuing the same
+  /// read to another replica. The first response wins.
+  static constexpr const char* kHedgedReadThresholdMs =
+      "hive.hdfs.hedged-read.threshold-ms";
+
   static std::string_view kScheme;
 
   static std::string_view kViewfsScheme;
@@ -15,6 +15,10 @@
  */
 
 #include "HdfsReadFile.h"
+
+#include <mutex>
+
+#include "velox/common/time/Timer.h"
 #include "velox/external/hdfs/ArrowHdfsInternal.h"
 
 namespace facebook::velox {
@@ -103,15 +107,22 @@ class HdfsReadFile::Impl {
     }
   }
 
-  std::string_view pread(uint64_t offset, uint64_t length, void* buf) const {
-    preadInternal(offset, length, static_cast<char*>(buf));
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      filesystems::File::IoStats* stats) const {
+    timedPread(offset, length, static_cast<char*>(buf), stats);
     return {static_cast<char*>(buf), length};
   }
 
-  std::string pread(uint64_t offset, uint64_t length) const {
+  std::string pread(
+      uint64_t offset,
+      uint64_t length,
+      filesystems::File::IoStats* stats) const {
     std::string result(length, 0);
     char* pos = result.data();
-    preadInternal(offset, length, pos);
+    timedPread(offset, length, pos, stats);
     return result;
   }
 
@@ -144,11 +155,69 @@ class HdfsReadFile::Impl {
   }
 
  private:
+  // Reads like preadInternal() and, if 'stats' is given, adds the wall time
+  // to 'kReadWallNanos' and to the counter of the datanode holding the first
+  // replica of the block that contains 'offset'. The client reads from that
+  // replica unless it is slow or down, so a datanode with a high average
+  // points at the source of long tails.
+  void timedPread(
+      uint64_t offset,
+      uint64_t length,
+      char* pos,
+      filesystems::File::IoStats* stats) const {
+    if (stats == nullptr) {
+      preadInternal(offset, length, pos);
+      return;
+    }
+    uint64_t readNanos{0};
+    {
+      NanosecondTimer timer(&readNanos);
+      preadInternal(offset, length, pos);
+    }
+    stats->addCounter(
+        kReadWallNanos,
+        RuntimeCounter(readNanos, RuntimeCounter::Unit::kNanos));
+    const auto& host = blockHost(offset);
+    if (!host.empty()) {
+      stats->addCounter(
+          fmt::format("{}.{}", kReadWallNanos, host),
+          RuntimeCounter(readNanos, RuntimeCounter::Unit::kNanos));
+    }
+  }
+
+  // Returns the first replica host of the block containing 'offset' or an
+  // empty string if the block locations are not known. The locations are
+  // fetched from the namenode on first use.
+  const std::string& blockHost(uint64_t offset) const {
+    std::call_once(blockHostsOnce_, [&]() {
+      char*** hosts =
+          driver_->GetHosts(hdfsClient_, filePath_.data(), 0, size());
+      if (hosts == nullptr) {
+        return;
+      }
+      for (auto block = hosts; *block != nullptr; ++block) {
+        blockHosts_.emplace_back((*block)[0] != nullptr ? (*block)[0] : "");
+      }
+      driver_->FreeHosts(hosts);
+    });
+    static const std::string kNoHost;
+    const auto blockSize = fileInfo_->mBlockSize;
+    if (blockSize <= 0) {
+      return kNoHost;
+    }
+    const auto block = offset / static_cast<uint64_t>(blockSize);
+    return block < blockHosts_.size() ? blockHosts_[block] : kNoHost;
+  }
+
+  static constexpr const char* kReadWallNanos = "hdfsReadWallNanos";
+
   filesystems::arrow::io::internal::LibHdfsShim* driver_;
   hdfsFS hdfsClient_;
   std::string filePath_;
   hdfsFileInfo* fileInfo_;
   folly::ThreadLocal<HdfsFile> file_;
+  mutable std::once_flag blockHostsOnce_;
+  mutable std::vector<std::string> blockHosts_;
 };
 
 HdfsReadFile::HdfsReadFile(
@@ -164,14 +233,14 @@ std::string_view HdfsReadFile::pread(
     uint64_t length,
     void* buf,
     filesystems::File::IoStats* stats) const {
-  return pImpl->pread(offset, length, buf);
+  return pImpl->pread(offset, length, buf, stats);
 }
 
 std::string HdfsReadFile::pread(
     uint64_t offset,
     uint64_t length,
     filesystems::File::IoStats* stats) const {
-  return pImpl->pread(offset, length);
+  return pImpl->pread(offset, length, stats);
 }
 
 uint64_t HdfsReadFile::size() const {
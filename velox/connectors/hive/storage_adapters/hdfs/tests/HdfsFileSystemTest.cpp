@@ -212,6 +212,43 @@ TEST_F(HdfsFileSystemTest, read) {
   readData(&readFile);
 }
 
+TEST_F(HdfsFileSystemTest, readStats) {
+  filesystems::arrow::io::internal::LibHdfsShim* driver;
+  auto hdfs = connectHdfsDriver(
+      &driver,
+      std::string(miniCluster->host()),
+      std::string(miniCluster->nameNodePort()));
+  HdfsReadFile readFile(driver, hdfs, kDestinationPath);
+  filesystems::File::IoStats stats;
+  char buffer[10];
+  ASSERT_EQ(readFile.pread(0, 10, &buffer, &stats), "aaaaabbbbb");
+  ASSERT_EQ(readFile.pread(kOneMB, 15, &stats), "ccccccccccddddd");
+
+  const auto counters = stats.stats();
+  const auto it = counters.find("hdfsReadWallNanos");
+  ASSERT_NE(it, counters.end());
+  ASSERT_EQ(it->second.count, 2);
+  ASSERT_GT(it->second.sum, 0);
+  // The file has a single block, so both reads go to its datanode.
+  ASSERT_EQ(counters.size(), 2);
+  for (const auto& [name, metric] : counters) {
+    ASSERT_EQ(metric.count, 2);
+    ASSERT_EQ(metric.unit, RuntimeCounter::Unit::kNanos);
+  }
+}
+
+TEST_F(HdfsFileSystemTest, shortCircuitReadWithoutSocketPath) {
+  auto config = std::make_shared<const config::ConfigBase>(
+      std::unordered_map<std::string, std::string>{
+          {filesystems::HdfsFileSystem::kShortCircuitRead, "true"}});
+  filesystems::HdfsServiceEndpoint endpoint(
+      std::string(miniCluster->host()),
+      std::string(miniCluster->nameNodePort()));
+  VELOX_ASSERT_THROW(
+      std::make_shared<filesystems::HdfsFileSystem>(config, endpoint),
+      "hive.hdfs.read.short-circuit requires hive.hdfs.domain-socket-path");
+}
+
 TEST_F(HdfsFileSystemTest, viaFileSystem) {
   auto config = std::make_shared<const config::ConfigBase>(
       std::unordered_map<std::string, std::string>(configurationValues));
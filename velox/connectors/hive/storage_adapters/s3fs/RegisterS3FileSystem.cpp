@@ -145,6 +145,8 @@ void registerS3Metrics() {
   DEFINE_METRIC(kMetricS3GetMetadataErrors, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3GetObjectRetries, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3GetMetadataRetries, velox::StatType::COUNT);
+  DEFINE_METRIC(kMetricS3HedgedGetObjectCalls, velox::StatType::COUNT);
+  DEFINE_METRIC(kMetricS3ParallelReads, velox::StatType::COUNT);
 #endif
 }
 
@@ -73,6 +73,30 @@ S3Config::S3Config(
       properties->get<std::string>(kS3PayloadSigningPolicy, "Never");
 }
 
+std::optional<uint64_t> S3Config::readChunkSize() const {
+  auto value = config_.find(Keys::kReadChunkSize)->second;
+  if (!value.has_value()) {
+    return std::nullopt;
+  }
+  const auto chunkSize =
+      config::toCapacity(value.value(), config::CapacityUnit::BYTE);
+  VELOX_USER_CHECK_GT(
+      chunkSize, 0, "Invalid configuration: 'read-chunk-size' must be > 0.");
+  return chunkSize;
+}
+
+std::optional<double> S3Config::readHedgePercentile() const {
+  auto value = config_.find(Keys::kReadHedgePercentile)->second;
+  if (!value.has_value()) {
+    return std::nullopt;
+  }
+  const auto percentile = folly::to<double>(value.value());
+  VELOX_USER_CHECK(
+      percentile > 0 && percentile < 100,
+      "Invalid configuration: 'read-hedge-percentile' must be in (0, 100).");
+  return percentile;
+}
+
 std::optional<std::string> S3Config::endpointRegion() const {
   auto region = config_.find(Keys::kEndpointRegion)->second;
   if (!region.has_value()) {
@@ -72,6 +72,11 @@ class S3Config {
     kMaxAttempts,
     kRetryMode,
     kUseProxyFromEnv,
+    kReadChunkSize,
+    kReadParallelism,
+    kReadHedgePercentile,
+    kUploadConcurrency,
+    kUploadParallelism,
     kEnd
   };
 
@@ -107,7 +112,17 @@ class S3Config {
             {Keys::kMaxAttempts, std::make_pair("max-attempts", std::nullopt)},
             {Keys::kRetryMode, std::make_pair("retry-mode", std::nullopt)},
             {Keys::kUseProxyFromEnv,
-             std::make_pair("use-proxy-from-env", "false")}};
+             std::make_pair("use-proxy-from-env", "false")},
+            {Keys::kReadChunkSize,
+             std::make_pair("read-chunk-size", std::nullopt)},
+            {Keys::kReadParallelism,
+             std::make_pair("read-parallelism", "16")},
+            {Keys::kReadHedgePercentile,
+             std::make_pair("read-hedge-percentile", std::nullopt)},
+            {Keys::kUploadConcurrency,
+             std::make_pair("upload-concurrency", "1")},
+            {Keys::kUploadParallelism,
+             std::make_pair("upload-parallelism", "16")}};
     return config;
   }
 
@@ -224,6 +239,36 @@ class S3Config {
     return folly::to<bool>(value);
   }
 
+  /// Reads larger than this are split into ranged GETs of this size that are
+  /// issued in parallel. Not set disables splitting.
+  std::optional<uint64_t> readChunkSize() const;
+
+  /// Number of threads for issuing parallel and hedged GETs.
+  uint32_t readParallelism() const {
+    auto value = config_.find(Keys::kReadParallelism)->second.value();
+    return folly::to<uint32_t>(value);
+  }
+
+  /// If set, a GET that has not completed within this percentile (0-100) of
+  /// the latencies of recent GETs is issued again and the first response to
+  /// complete is used. Not set disables hedging.
+  std::optional<double> readHedgePercentile() const;
+
+  /// Maximum number of parts of a file being uploaded concurrently. Appends
+  /// block when this many parts are in flight. 1 uploads the parts
+  /// synchronously on the writing thread.
+  uint32_t uploadConcurrency() const {
+    auto value = config_.find(Keys::kUploadConcurrency)->second.value();
+    return folly::to<uint32_t>(value);
+  }
+
+  /// Number of threads for uploading parts, shared by all files of the file
+  /// system. Used only if uploadConcurrency() > 1.
+  uint32_t uploadParallelism() const {
+    auto value = config_.find(Keys::kUploadParallelism)->second.value();
+    return folly::to<uint32_t>(value);
+  }
+
   std::string payloadSigningPolicy() const {
     return payloadSigningPolicy_;
   }
@@ -53,4 +53,12 @@ constexpr std::string_view kMetricS3GetObjectErrors{
 constexpr std::string_view kMetricS3GetObjectRetries{
     "velox.s3.get_object_retries"};
 
+// The number of S3 getObject calls issued again because the first call was
+// slower than the hedge percentile.
+constexpr std::string_view kMetricS3HedgedGetObjectCalls{
+    "velox.s3.hedged_get_object_calls"};
+
+// The number of S3 reads split into parallel ranged getObject calls.
+constexpr std::string_view kMetricS3ParallelReads{"velox.s3.parallel_reads"};
+
 } // namespace facebook::velox::filesystems
@@ -25,7 +25,11 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 
@@ -66,17 +70,77 @@ class StringViewStream : Aws::Utils::Stream::PreallocatedStreamBuf,
 };
 
 // By default, the AWS SDK reads object data into an auto-growing StringStream.
-// To avoid copies, read directly into a pre-allocated buffer instead.
+// To avoid copies, read directly into the destination buffers instead.
 // See https://github.com/aws/aws-sdk-cpp/issues/64 for an alternative but
 // functionally similar recipe.
-Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
-  return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
+class ScatterStream : ScatterStreamBuf, public std::iostream {
+ public:
+  ScatterStream(
+      std::vector<folly::Range<char*>> ranges,
+      std::shared_ptr<ScatterStreamBuf::Gate> gate)
+      : ScatterStreamBuf(std::move(ranges), std::move(gate)),
+        std::iostream(this) {}
+};
+
+// Reads the bytes of 'bucket'/'key' starting at 'offset' into 'ranges'.
+// Records the latency of a successful read in 'latencies' if not nullptr.
+void getObjectRange(
+    Aws::S3::S3Client* client,
+    const std::string& bucket,
+    const std::string& key,
+    uint64_t offset,
+    std::vector<folly::Range<char*>> ranges,
+    std::shared_ptr<ScatterStreamBuf::Gate> gate,
+    LatencyTracker* latencies) {
+  const auto length = totalSize(ranges);
+  Aws::S3::Model::GetObjectRequest request;
+  request.SetBucket(awsString(bucket));
+  request.SetKey(awsString(key));
+  std::stringstream ss;
+  ss << "bytes=" << offset << "-" << offset + length - 1;
+  request.SetRange(awsString(ss.str()));
+  // The factory is called again for each retry, which then writes from the
+  // start of 'ranges'.
+  request.SetResponseStreamFactory(
+      [ranges = std::move(ranges), gate = std::move(gate)]() {
+        return Aws::New<ScatterStream>("", ranges, gate);
+      });
+  RECORD_METRIC_VALUE(kMetricS3ActiveConnections);
+  RECORD_METRIC_VALUE(kMetricS3GetObjectCalls);
+  const auto start = std::chrono::steady_clock::now();
+  auto outcome = client->GetObject(request);
+  if (!outcome.IsSuccess()) {
+    RECORD_METRIC_VALUE(kMetricS3GetObjectErrors);
+  }
+  RECORD_METRIC_VALUE(kMetricS3GetObjectRetries, outcome.GetRetryCount());
+  RECORD_METRIC_VALUE(kMetricS3ActiveConnections, -1);
+  VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket, key);
+  if (latencies != nullptr) {
+    latencies->record(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+  }
 }
 
+// Options for splitting and hedging the GetObject calls of a S3ReadFile.
+struct S3ReadOptions {
+  // Reads larger than this are split into parallel GETs of this size.
+  std::optional<uint64_t> chunkSize;
+  // Percentile of recent GET latencies after which a GET is issued again.
+  std::optional<double> hedgePercentile;
+  // Runs the GETs if splitting or hedging is on, nullptr otherwise.
+  folly::Executor* executor{nullptr};
+  std::shared_ptr<LatencyTracker> latencies;
+};
+
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(std::string_view path, Aws::S3::S3Client* client)
-      : client_(client) {
+  S3ReadFile(
+      std::string_view path,
+      Aws::S3::S3Client* client,
+      S3ReadOptions readOptions = {})
+      : client_(client), readOptions_(std::move(readOptions)) {
     getBucketAndKeyFromPath(path, bucket_, key_);
   }
 
@@ -135,21 +199,11 @@ class S3ReadFile final : public ReadFile {
     // between. This call must populate the ranges (except gap ranges)
     // sequentially starting from 'offset'. AWS S3 GetObject does not support
     // multi-range. AWS S3 also charges by number of read requests and not size.
-    // The idea here is to use a single read spanning all the ranges and then
-    // populate individual ranges. We pre-allocate a buffer to support this.
-    size_t length = 0;
-    for (const auto range : buffers) {
-      length += range.size();
-    }
-    // TODO: allocate from a memory pool
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
+    // The idea here is to use a single read spanning all the ranges and to
+    // write the response directly into the ranges, dropping the gaps.
+    const auto length = totalSize(buffers);
+    if (length > 0) {
+      readRanges(offset, buffers);
     }
     return length;
   }
@@ -177,32 +231,142 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
+  // A part of a read issued as a separate GET.
+  struct Chunk {
+    // Range of the chunk within the read.
+    uint64_t begin;
+    uint64_t end;
+    folly::SemiFuture<folly::Unit> primary;
+    // Closed to stop 'primary' from writing into the destination.
+    std::shared_ptr<ScatterStreamBuf::Gate> gate;
+  };
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
-    // Read the desired range of bytes.
-    Aws::S3::Model::GetObjectRequest request;
-    Aws::S3::Model::GetObjectResult result;
+    readRanges(offset, {folly::Range<char*>(position, length)});
+  }
 
-    request.SetBucket(awsString(bucket_));
-    request.SetKey(awsString(key_));
-    std::stringstream ss;
-    ss << "bytes=" << offset << "-" << offset + length - 1;
-    request.SetRange(awsString(ss.str()));
-    request.SetResponseStreamFactory(
-        AwsWriteableStreamFactory(position, length));
-    RECORD_METRIC_VALUE(kMetricS3ActiveConnections);
-    RECORD_METRIC_VALUE(kMetricS3GetObjectCalls);
-    auto outcome = client_->GetObject(request);
-    if (!outcome.IsSuccess()) {
-      RECORD_METRIC_VALUE(kMetricS3GetObjectErrors);
+  // Reads the bytes starting at 'offset' into 'ranges'. Without an executor,
+  // issues one GET on the calling thread. Otherwise splits the read into
+  // chunks that are read in parallel and hedges the GETs of the chunks that
+  // are slower than the hedge percentile.
+  void readRanges(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& ranges) const {
+    if (readOptions_.executor == nullptr) {
+      getObjectRange(
+          client_,
+          bucket_,
+          key_,
+          offset,
+          ranges,
+          nullptr,
+          readOptions_.latencies.get());
+      return;
+    }
+    const auto length = totalSize(ranges);
+    const auto chunkSize = readOptions_.chunkSize.value_or(length);
+    std::vector<Chunk> chunks;
+    for (uint64_t begin = 0; begin < length; begin += chunkSize) {
+      const auto end = std::min(length, begin + chunkSize);
+      auto gate = std::make_shared<ScatterStreamBuf::Gate>();
+      auto primary =
+          startGet(offset + begin, sliceRanges(ranges, begin, end), gate);
+      chunks.push_back({begin, end, std::move(primary), std::move(gate)});
+    }
+    if (chunks.size() > 1) {
+      RECORD_METRIC_VALUE(kMetricS3ParallelReads);
+    }
+    try {
+      for (auto& chunk : chunks) {
+        waitForChunk(offset, ranges, chunk);
+      }
+    } catch (const std::exception&) {
+      // GETs still running must not write into 'ranges' after the error is
+      // returned to the caller.
+      for (auto& chunk : chunks) {
+        chunk.gate->close();
+      }
+      throw;
+    }
+  }
+
+  // Starts a GET of 'ranges' from 'offset' on the executor. 'keepAlive' is
+  // held until the GET completes.
+  folly::SemiFuture<folly::Unit> startGet(
+      uint64_t offset,
+      std::vector<folly::Range<char*>> ranges,
+      std::shared_ptr<ScatterStreamBuf::Gate> gate,
+      std::shared_ptr<void> keepAlive = nullptr) const {
+    // Captures copies since the GET may outlive 'this' if it is abandoned.
+    return folly::via(
+               readOptions_.executor,
+               [client = client_,
+                bucket = bucket_,
+                key = key_,
+                offset,
+                ranges = std::move(ranges),
+                gate = std::move(gate),
+                latencies = readOptions_.latencies,
+                keepAlive = std::move(keepAlive)]() mutable {
+                 getObjectRange(
+                     client,
+                     bucket,
+                     key,
+                     offset,
+                     std::move(ranges),
+                     std::move(gate),
+                     latencies.get());
+               })
+        .semi();
+  }
+
+  // Waits for the GET of 'chunk'. If it has not completed in the hedge
+  // percentile of recent GET latencies, issues the GET again into a separate
+  // buffer and uses the first GET to complete.
+  void waitForChunk(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& ranges,
+      Chunk& chunk) const {
+    std::optional<uint64_t> hedgeDelayUs;
+    if (readOptions_.hedgePercentile.has_value()) {
+      hedgeDelayUs = readOptions_.latencies->percentile(
+          readOptions_.hedgePercentile.value());
     }
-    RECORD_METRIC_VALUE(kMetricS3GetObjectRetries, outcome.GetRetryCount());
-    RECORD_METRIC_VALUE(kMetricS3ActiveConnections, -1);
-    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
+    if (!hedgeDelayUs.has_value()) {
+      std::move(chunk.primary).get();
+      return;
+    }
+    chunk.primary.wait(std::chrono::microseconds(hedgeDelayUs.value()));
+    if (chunk.primary.isReady()) {
+      std::move(chunk.primary).get();
+      return;
+    }
+    RECORD_METRIC_VALUE(kMetricS3HedgedGetObjectCalls);
+    auto buffer = std::make_shared<std::string>(chunk.end - chunk.begin, '\0');
+    auto hedge = startGet(
+        offset + chunk.begin,
+        {folly::Range<char*>(buffer->data(), buffer->size())},
+        nullptr,
+        buffer);
+    std::vector<folly::SemiFuture<folly::Unit>> attempts;
+    attempts.push_back(std::move(chunk.primary));
+    attempts.push_back(std::move(hedge));
+    // Throws if both fail.
+    const auto first =
+        folly::collectAnyWithoutException(std::move(attempts)).get();
+    if (first.first == 0) {
+      // The hedged GET writes only into 'buffer', which it keeps alive.
+      return;
+    }
+    chunk.gate->close();
+    ScatterStreamBuf destination(sliceRanges(ranges, chunk.begin, chunk.end));
+    destination.sputn(buffer->data(), buffer->size());
   }
 
   Aws::S3::S3Client* client_;
+  const S3ReadOptions readOptions_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -254,10 +418,16 @@ class S3WriteFile::Impl {
   explicit Impl(
       std::string_view path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool)
-      : client_(client), pool_(pool) {
+      memory::MemoryPool* pool,
+      const S3WriteOptions& options)
+      : client_(client),
+        pool_(pool),
+        maxConcurrentUploads_(
+            options.executor == nullptr ? 1 : options.maxConcurrentUploads),
+        executor_(options.executor) {
     VELOX_CHECK_NOT_NULL(client);
     VELOX_CHECK_NOT_NULL(pool);
+    VELOX_CHECK_GT(maxConcurrentUploads_, 0);
     getBucketAndKeyFromPath(path, bucket_, key_);
     currentPart_ = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
     currentPart_->reserve(kPartUploadSize);
@@ -315,6 +485,13 @@ class S3WriteFile::Impl {
     fileSize_ = 0;
   }
 
+  ~Impl() {
+    // The uploads in flight use 'client_' and the buffers of 'pendingParts_'.
+    for (auto& pending : pendingParts_) {
+      pending.result.wait();
+    }
+  }
+
   // Appends data to the end of the file.
   void append(std::string_view data) {
     VELOX_CHECK(!closed(), "File is closed");
@@ -341,6 +518,7 @@ class S3WriteFile::Impl {
       return;
     }
     RECORD_METRIC_VALUE(kMetricS3StartedUploads);
+    waitForUploads(0);
     uploadPart({currentPart_->data(), currentPart_->size()}, true);
     VELOX_CHECK_EQ(uploadState_.partNumber, uploadState_.completedParts.size());
     // Complete the multipart upload.
@@ -374,6 +552,10 @@ class S3WriteFile::Impl {
     return uploadState_.partNumber;
   }
 
+  int numPendingUploads() const {
+    return pendingParts_.size();
+  }
+
  private:
   static constexpr int64_t kPartUploadSize = 10 * 1024 * 1024;
   static constexpr const char* kApplicationOctetStream =
@@ -391,6 +573,13 @@ class S3WriteFile::Impl {
   };
   UploadState uploadState_;
 
+  // A part being uploaded on 'executor_'. Owns the data of the part until the
+  // upload finishes.
+  struct PendingPart {
+    std::unique_ptr<dwio::common::DataBuffer<char>> buffer;
+    folly::SemiFuture<Aws::S3::Model::CompletedPart> result;
+  };
+
   // Data can be smaller or larger than the kPartUploadSize.
   // Complete the currentPart_ and upload kPartUploadSize chunks of data.
   // Save the remaining into currentPart_.
@@ -400,28 +589,82 @@ class S3WriteFile::Impl {
     // Fill-up the remaining currentPart_.
     auto remainingBufferSize = currentPart_->capacity() - currentPart_->size();
     currentPart_->unsafeAppend(dataPtr, remainingBufferSize);
-    uploadPart({currentPart_->data(), currentPart_->size()});
     dataPtr += remainingBufferSize;
     dataSize -= remainingBufferSize;
-    while (dataSize > kPartUploadSize) {
-      uploadPart({dataPtr, kPartUploadSize});
-      dataPtr += kPartUploadSize;
-      dataSize -= kPartUploadSize;
+    if (executor_ == nullptr) {
+      uploadPart({currentPart_->data(), currentPart_->size()});
+      while (dataSize > kPartUploadSize) {
+        uploadPart({dataPtr, kPartUploadSize});
+        dataPtr += kPartUploadSize;
+        dataSize -= kPartUploadSize;
+      }
+    } else {
+      // The caller may free 'data' on return, so full parts are copied to a
+      // buffer owned by the upload.
+      startUpload(std::move(currentPart_));
+      while (dataSize > kPartUploadSize) {
+        auto part = newPart();
+        part->unsafeAppend(dataPtr, kPartUploadSize);
+        startUpload(std::move(part));
+        dataPtr += kPartUploadSize;
+        dataSize -= kPartUploadSize;
+      }
+      currentPart_ = newPart();
     }
     // Stash the remaining at the beginning of currentPart.
     currentPart_->unsafeAppend(0, dataPtr, dataSize);
   }
 
+  std::unique_ptr<dwio::common::DataBuffer<char>> newPart() {
+    auto part = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
+    part->reserve(kPartUploadSize);
+    return part;
+  }
+
+  // Uploads 'part' on 'executor_'. Waits for the oldest uploads to finish
+  // first if 'maxConcurrentUploads_' are in flight.
+  void startUpload(std::unique_ptr<dwio::common::DataBuffer<char>> part) {
+    VELOX_CHECK_EQ(part->size(), kPartUploadSize);
+    waitForUploads(maxConcurrentUploads_ - 1);
+    const std::string_view data(part->data(), part->size());
+    const auto partNumber = ++uploadState_.partNumber;
+    auto result = folly::via(executor_, [this, data, partNumber]() {
+                    return uploadPartRequest(data, partNumber);
+                  }).semi();
+    pendingParts_.push_back({std::move(part), std::move(result)});
+  }
+
+  // Waits until at most 'maxPending' uploads are in flight. The parts finish
+  // in order of part number so that 'completedParts' stays sorted. Rethrows
+  // the error of a failed upload.
+  void waitForUploads(size_t maxPending) {
+    while (pendingParts_.size() > maxPending) {
+      auto pending = std::move(pendingParts_.front());
+      pendingParts_.pop_front();
+      uploadState_.completedParts.push_back(std::move(pending.result).get());
+    }
+  }
+
   void uploadPart(const std::string_view part, bool isLast = false) {
     // Only the last part can be less than kPartUploadSize.
     VELOX_CHECK(isLast || (!isLast && (part.size() == kPartUploadSize)));
-    // Upload the part.
+    uploadState_.completedParts.push_back(
+        uploadPartRequest(part, ++uploadState_.partNumber));
+  }
+
+  // Uploads 'part' as part number 'partNumber' and returns its ETag and
+  // checksum for completing the upload. Does not modify 'this' and may run
+  // on any thread.
+  Aws::S3::Model::CompletedPart uploadPartRequest(
+      const std::string_view part,
+      int64_t partNumber) const {
+    Aws::S3::Model::CompletedPart completedPart;
     {
       Aws::S3::Model::UploadPartRequest request;
       request.SetBucket(bucket_);
       request.SetKey(key_);
       request.SetUploadId(uploadState_.id);
-      request.SetPartNumber(++uploadState_.partNumber);
+      request.SetPartNumber(partNumber);
       request.SetContentLength(part.size());
       request.SetBody(
           std::make_shared<StringViewStream>(part.data(), part.size()));
@@ -434,21 +677,23 @@ class S3WriteFile::Impl {
       // Append ETag and part number for this uploaded part.
       // This will be needed for upload completion in Close().
       auto result = outcome.GetResult();
-      Aws::S3::Model::CompletedPart part;
 
-      part.SetPartNumber(uploadState_.partNumber);
-      part.SetETag(result.GetETag());
+      completedPart.SetPartNumber(partNumber);
+      completedPart.SetETag(result.GetETag());
       // Don't add the checksum to the part if the checksum is empty.
       // Some filesystems such as IBM COS require this to be not set.
       if (!result.GetChecksumCRC32().empty()) {
-        part.SetChecksumCRC32(result.GetChecksumCRC32());
+        completedPart.SetChecksumCRC32(result.GetChecksumCRC32());
       }
-      uploadState_.completedParts.push_back(std::move(part));
     }
+    return completedPart;
   }
 
   Aws::S3::S3Client* client_;
   memory::MemoryPool* pool_;
+  const uint32_t maxConcurrentUploads_;
+  folly::Executor* const executor_;
+  std::deque<PendingPart> pendingParts_;
   std::unique_ptr<dwio::common::DataBuffer<char>> currentPart_;
   std::string bucket_;
   std::string key_;
@@ -458,8 +703,9 @@ class S3WriteFile::Impl {
 S3WriteFile::S3WriteFile(
     std::string_view path,
     Aws::S3::S3Client* client,
-    memory::MemoryPool* pool) {
-  impl_ = std::make_shared<Impl>(path, client, pool);
+    memory::MemoryPool* pool,
+    const S3WriteOptions& options) {
+  impl_ = std::make_shared<Impl>(path, client, pool, options);
 }
 
 void S3WriteFile::append(std::string_view data) {
@@ -482,6 +728,10 @@ int S3WriteFile::numPartsUploaded() const {
   return impl_->numPartsUploaded();
 }
 
+int S3WriteFile::numPendingUploads() const {
+  return impl_->numPendingUploads();
+}
+
 // Initialize and Finalize the AWS SDK C++ library.
 // Initialization must be done before creating a S3FileSystem.
 // Finalization must be done after all S3FileSystem instances have been deleted.
@@ -635,10 +885,43 @@ class S3FileSystem::Impl {
 
     client_ = std::make_shared<Aws::S3::S3Client>(
         credentialsProvider, nullptr /* endpointProvider */, clientConfig);
+
+    readOptions_.chunkSize = s3Config.readChunkSize();
+    readOptions_.hedgePercentile = s3Config.readHedgePercentile();
+    readOptions_.latencies = std::make_shared<LatencyTracker>();
+    if (readOptions_.chunkSize.has_value() ||
+        readOptions_.hedgePercentile.has_value()) {
+      VELOX_USER_CHECK_GT(
+          s3Config.readParallelism(),
+          0,
+          "Invalid configuration: 'read-parallelism' must be > 0.");
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          s3Config.readParallelism(),
+          std::make_shared<folly::NamedThreadFactory>("S3Read"));
+      readOptions_.executor = readExecutor_.get();
+    }
+    writeOptions_.maxConcurrentUploads = s3Config.uploadConcurrency();
+    VELOX_USER_CHECK_GT(
+        writeOptions_.maxConcurrentUploads,
+        0,
+        "Invalid configuration: 'upload-concurrency' must be > 0.");
+    if (writeOptions_.maxConcurrentUploads > 1) {
+      VELOX_USER_CHECK_GT(
+          s3Config.uploadParallelism(),
+          0,
+          "Invalid configuration: 'upload-parallelism' must be > 0.");
+      uploadExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          s3Config.uploadParallelism(),
+          std::make_shared<folly::NamedThreadFactory>("S3Upload"));
+      writeOptions_.executor = uploadExecutor_.get();
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    // Joins abandoned hedged GETs, which use the client.
+    readExecutor_.reset();
+    uploadExecutor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -769,8 +1052,20 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  const S3ReadOptions& readOptions() const {
+    return readOptions_;
+  }
+
+  const S3WriteOptions& writeOptions() const {
+    return writeOptions_;
+  }
+
  private:
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
+  S3ReadOptions readOptions_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> uploadExecutor_;
+  S3WriteOptions writeOptions_;
 };
 
 S3FileSystem::S3FileSystem(
@@ -789,7 +1084,8 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view s3Path,
     const FileOptions& options) {
   const auto path = getPath(s3Path);
-  auto s3file = std::make_unique<S3ReadFile>(path, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      path, impl_->s3Client(), impl_->readOptions());
   s3file->initialize(options);
   return s3file;
 }
@@ -798,8 +1094,8 @@ std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view s3Path,
     const FileOptions& options) {
   const auto path = getPath(s3Path);
-  auto s3file =
-      std::make_unique<S3WriteFile>(path, impl_->s3Client(), options.pool);
+  auto s3file = std::make_unique<S3WriteFile>(
+      path, impl_->s3Client(), options.pool, impl_->writeOptions());
   return s3file;
 }
 
@@ -182,4 +182,120 @@ std::optional<std::string> parseAWSStandardRegionName(
   return std::nullopt;
 }
 
+std::vector<folly::Range<char*>> sliceRanges(
+    const std::vector<folly::Range<char*>>& ranges,
+    uint64_t begin,
+    uint64_t end) {
+  VELOX_CHECK_LE(begin, end);
+  std::vector<folly::Range<char*>> result;
+  uint64_t rangeBegin = 0;
+  for (const auto& range : ranges) {
+    const uint64_t rangeEnd = rangeBegin + range.size();
+    const auto sliceBegin = std::max(begin, rangeBegin);
+    const auto sliceEnd = std::min(end, rangeEnd);
+    if (sliceBegin < sliceEnd) {
+      if (range.data() == nullptr) {
+        result.emplace_back(
+            nullptr,
+            reinterpret_cast<char*>(
+                static_cast<uint64_t>(sliceEnd - sliceBegin)));
+      } else {
+        result.emplace_back(
+            range.data() + (sliceBegin - rangeBegin), sliceEnd - sliceBegin);
+      }
+    }
+    if (rangeEnd >= end) {
+      break;
+    }
+    rangeBegin = rangeEnd;
+  }
+  VELOX_CHECK_EQ(totalSize(result), end - begin);
+  return result;
+}
+
+uint64_t totalSize(const std::vector<folly::Range<char*>>& ranges) {
+  uint64_t size = 0;
+  for (const auto& range : ranges) {
+    size += range.size();
+  }
+  return size;
+}
+
+std::streamsize ScatterStreamBuf::xsputn(
+    const char* data,
+    std::streamsize size) {
+  if (gate_ == nullptr) {
+    return writeLocked(data, size);
+  }
+  std::lock_guard<std::mutex> l(gate_->mutex);
+  if (gate_->closed) {
+    return 0;
+  }
+  return writeLocked(data, size);
+}
+
+std::streamsize ScatterStreamBuf::writeLocked(
+    const char* data,
+    std::streamsize size) {
+  std::streamsize written = 0;
+  while (written < size && rangeIndex_ < ranges_.size()) {
+    const auto& range = ranges_[rangeIndex_];
+    const auto bytes = std::min<uint64_t>(
+        size - written, range.size() - offsetInRange_);
+    if (range.data() != nullptr) {
+      memcpy(range.data() + offsetInRange_, data + written, bytes);
+    }
+    written += bytes;
+    offsetInRange_ += bytes;
+    if (offsetInRange_ == range.size()) {
+      ++rangeIndex_;
+      offsetInRange_ = 0;
+    }
+  }
+  position_ += written;
+  return written;
+}
+
+ScatterStreamBuf::int_type ScatterStreamBuf::overflow(int_type c) {
+  if (traits_type::eq_int_type(c, traits_type::eof())) {
+    return traits_type::not_eof(c);
+  }
+  const char byte = traits_type::to_char_type(c);
+  return xsputn(&byte, 1) == 1 ? c : traits_type::eof();
+}
+
+ScatterStreamBuf::pos_type ScatterStreamBuf::seekoff(
+    off_type offset,
+    std::ios_base::seekdir dir,
+    std::ios_base::openmode /*which*/) {
+  if (offset == 0 && dir == std::ios_base::cur) {
+    return pos_type(position_);
+  }
+  return pos_type(off_type(-1));
+}
+
+void LatencyTracker::record(uint64_t micros) {
+  std::lock_guard<std::mutex> l(mutex_);
+  latencies_[numRecorded_ % latencies_.size()] = micros;
+  ++numRecorded_;
+}
+
+std::optional<uint64_t> LatencyTracker::percentile(double percentile) const {
+  VELOX_CHECK(percentile >= 0 && percentile <= 100);
+  std::vector<uint64_t> latencies;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (numRecorded_ < kMinSamples) {
+      return std::nullopt;
+    }
+    const auto numValid = std::min(numRecorded_, latencies_.size());
+    latencies.assign(latencies_.begin(), latencies_.begin() + numValid);
+  }
+  const auto index = std::min<size_t>(
+      latencies.size() - 1, latencies.size() * percentile / 100);
+  std::nth_element(
+      latencies.begin(), latencies.begin() + index, latencies.end());
+  return latencies[index];
+}
+
 } // namespace facebook::velox::filesystems
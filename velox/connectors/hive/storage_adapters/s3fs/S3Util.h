@@ -24,8 +24,12 @@
 #include <aws/s3/S3Errors.h>
 #include <aws/s3/model/HeadObjectResult.h>
 #include <fmt/format.h>
+#include <folly/Range.h>
 #include <folly/Uri.h>
 
+#include <mutex>
+#include <streambuf>
+
 #include "velox/common/base/Exceptions.h"
 
 namespace facebook::velox::filesystems {
@@ -216,6 +220,87 @@ class S3ProxyConfigurationBuilder {
   bool useSsl_;
 };
 
+/// Returns the parts of 'ranges' that cover bytes [begin, end) of the
+/// concatenation of 'ranges'. Gap ranges, i.e. ranges with nullptr data that
+/// only give a size, stay gaps.
+std::vector<folly::Range<char*>> sliceRanges(
+    const std::vector<folly::Range<char*>>& ranges,
+    uint64_t begin,
+    uint64_t end);
+
+/// Returns the total size of 'ranges' including gaps.
+uint64_t totalSize(const std::vector<folly::Range<char*>>& ranges);
+
+/// A streambuf that writes into 'ranges' in order and drops the bytes that
+/// fall in gap ranges. Used as the response stream of GetObject to read into
+/// the destination buffers without an intermediate copy. Writes past the end
+/// of 'ranges' fail. Writes also fail after the Gate given at construction is
+/// closed, after which 'ranges' are not accessed.
+class ScatterStreamBuf : public std::streambuf {
+ public:
+  /// Shared by a read and the code that may abandon it.
+  struct Gate {
+    /// Stops all later writes. Waits for a write in progress to finish.
+    void close() {
+      std::lock_guard<std::mutex> l(mutex);
+      closed = true;
+    }
+
+    std::mutex mutex;
+    bool closed{false};
+  };
+
+  ScatterStreamBuf(
+      std::vector<folly::Range<char*>> ranges,
+      std::shared_ptr<Gate> gate = nullptr)
+      : ranges_(std::move(ranges)), gate_(std::move(gate)) {}
+
+  /// Number of bytes written, including dropped gap bytes.
+  uint64_t position() const {
+    return position_;
+  }
+
+ protected:
+  std::streamsize xsputn(const char* data, std::streamsize size) override;
+
+  int_type overflow(int_type c) override;
+
+  // Supports only querying the write position.
+  pos_type seekoff(
+      off_type offset,
+      std::ios_base::seekdir dir,
+      std::ios_base::openmode which) override;
+
+ private:
+  std::streamsize writeLocked(const char* data, std::streamsize size);
+
+  const std::vector<folly::Range<char*>> ranges_;
+  const std::shared_ptr<Gate> gate_;
+  size_t rangeIndex_{0};
+  uint64_t offsetInRange_{0};
+  uint64_t position_{0};
+};
+
+/// Keeps the latencies of recent requests to compute percentiles, e.g. for
+/// deciding when to hedge a request that is slower than most.
+class LatencyTracker {
+ public:
+  explicit LatencyTracker(int32_t capacity = 256) : latencies_(capacity) {}
+
+  void record(uint64_t micros);
+
+  /// Returns the 'percentile' (0-100) latency in microseconds of the recent
+  /// requests or std::nullopt if fewer than kMinSamples are recorded.
+  std::optional<uint64_t> percentile(double percentile) const;
+
+  static constexpr int32_t kMinSamples = 32;
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<uint64_t> latencies_;
+  size_t numRecorded_{0};
+};
+
 } // namespace facebook::velox::filesystems
 
 template <>
@@ -23,8 +23,24 @@ namespace Aws::S3 {
 class S3Client;
 }
 
+namespace folly {
+class Executor;
+}
+
 namespace facebook::velox::filesystems {
 
+/// Options for uploading the parts of a S3WriteFile concurrently.
+struct S3WriteOptions {
+  /// Maximum number of parts being uploaded at a time. Each part in flight
+  /// holds a copy of its data allocated from the pool of the file. 'append'
+  /// waits for the oldest upload to finish when this many are in flight.
+  uint32_t maxConcurrentUploads{1};
+
+  /// Runs the part uploads if 'maxConcurrentUploads' > 1. Parts are uploaded
+  /// synchronously by the appending thread if nullptr.
+  folly::Executor* executor{nullptr};
+};
+
 /// S3WriteFile uses the Apache Arrow implementation as a reference.
 /// AWS C++ SDK allows streaming writes via the MultiPart upload API.
 /// Multipart upload allows you to upload a single object as a set of parts.
@@ -42,15 +58,17 @@ namespace facebook::velox::filesystems {
 /// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
 /// https://github.com/apache/arrow/blob/main/cpp/src/arrow/filesystem/s3fs.cc
 /// S3WriteFile is not thread-safe.
-/// UploadPart is currently synchronous during append and flush.
-/// TODO: Evaluate and add option for asynchronous part uploads.
+/// By default UploadPart is synchronous during append and close. With
+/// S3WriteOptions, parts are uploaded concurrently on an executor while the
+/// writer fills the next part.
 /// TODO: Implement retry on failure.
 class S3WriteFile : public WriteFile {
  public:
   S3WriteFile(
       std::string_view path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      const S3WriteOptions& options = {});
 
   /// Appends data to the end of the file.
   /// Uploads a part on reaching part size limit.
@@ -68,6 +86,10 @@ class S3WriteFile : public WriteFile {
   /// Return the number of parts uploaded so far.
   int numPartsUploaded() const;
 
+  /// Returns the number of parts whose upload has started but is not known to
+  /// have finished.
+  int numPendingUploads() const;
+
  protected:
   class Impl;
   std::shared_ptr<Impl> impl_;
@@ -36,6 +36,11 @@ TEST(S3ConfigTest, defaultConfig) {
   ASSERT_EQ(s3Config.iamRoleSessionName(), "velox-session");
   ASSERT_EQ(s3Config.payloadSigningPolicy(), "Never");
   ASSERT_EQ(s3Config.cacheKey("foo", config), "foo");
+  ASSERT_EQ(s3Config.readChunkSize(), std::nullopt);
+  ASSERT_EQ(s3Config.readParallelism(), 16);
+  ASSERT_EQ(s3Config.readHedgePercentile(), std::nullopt);
+  ASSERT_EQ(s3Config.uploadConcurrency(), 1);
+  ASSERT_EQ(s3Config.uploadParallelism(), 16);
 }
 
 TEST(S3ConfigTest, overrideConfig) {
@@ -50,10 +55,20 @@ TEST(S3ConfigTest, overrideConfig) {
       {S3Config::baseConfigKey(S3Config::Keys::kAccessKey), "access"},
       {S3Config::baseConfigKey(S3Config::Keys::kSecretKey), "secret"},
       {S3Config::baseConfigKey(S3Config::Keys::kIamRole), "iam"},
-      {S3Config::baseConfigKey(S3Config::Keys::kIamRoleSessionName), "velox"}};
+      {S3Config::baseConfigKey(S3Config::Keys::kIamRoleSessionName), "velox"},
+      {S3Config::baseConfigKey(S3Config::Keys::kReadChunkSize), "8MB"},
+      {S3Config::baseConfigKey(S3Config::Keys::kReadParallelism), "4"},
+      {S3Config::baseConfigKey(S3Config::Keys::kReadHedgePercentile), "95"},
+      {S3Config::baseConfigKey(S3Config::Keys::kUploadConcurrency), "4"},
+      {S3Config::baseConfigKey(S3Config::Keys::kUploadParallelism), "8"}};
   auto configBase =
       std::make_shared<config::ConfigBase>(std::move(configFromFile));
   auto s3Config = S3Config("", configBase);
+  ASSERT_EQ(s3Config.readChunkSize(), 8 << 20);
+  ASSERT_EQ(s3Config.readParallelism(), 4);
+  ASSERT_EQ(s3Config.readHedgePercentile(), 95);
+  ASSERT_EQ(s3Config.uploadConcurrency(), 4);
+  ASSERT_EQ(s3Config.uploadParallelism(), 8);
   ASSERT_EQ(s3Config.useVirtualAddressing(), false);
   ASSERT_EQ(s3Config.useSSL(), false);
   ASSERT_EQ(s3Config.useInstanceCredentials(), true);
@@ -60,6 +60,29 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, parallelRead) {
+  const char* bucketName = "parallel";
+  const char* file = "test.txt";
+  const auto filename = localPath(bucketName) + "/" + file;
+  const auto s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Small chunks split each read into several ranged GETs, hedged once the
+  // first reads give a latency profile.
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-chunk-size", "1kB"},
+       {"hive.s3.read-parallelism", "4"},
+       {"hive.s3.read-hedge-percentile", "50"}});
+  filesystems::S3FileSystem s3fs(bucketName, hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  for (auto i = 0; i < 4; ++i) {
+    readData(readFile.get());
+  }
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     std::unordered_map<std::string, std::string> config(
@@ -255,6 +278,42 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
 
+TEST_F(S3FileSystemTest, concurrentUploads) {
+  const auto bucketName = "concurrentupload";
+  const auto file = "test.txt";
+  const auto s3File = s3URI(bucketName, file);
+
+  auto hiveConfig =
+      minioServer_->hiveConfig({{"hive.s3.upload-concurrency", "2"}});
+  filesystems::S3FileSystem s3fs(bucketName, hiveConfig);
+  auto pool = memory::memoryManager()->addLeafPool("S3FileSystemTest");
+  auto writeFile =
+      s3fs.openFileForWrite(s3File, {{}, pool.get(), std::nullopt});
+  auto s3WriteFile = dynamic_cast<filesystems::S3WriteFile*>(writeFile.get());
+
+  // Append 4 parts and a half with distinct content per part.
+  constexpr int64_t kPartSize = 10 << 20;
+  std::string data(kPartSize / 2, ' ');
+  for (int i = 0; i < 9; ++i) {
+    std::fill(data.begin(), data.end(), 'a' + i);
+    writeFile->append(data);
+    // At most 2 parts are in flight, each holding a copy of its data, in
+    // addition to the part being filled.
+    EXPECT_LE(s3WriteFile->numPendingUploads(), 2);
+    EXPECT_LE(pool->usedBytes(), 3 * kPartSize + (1 << 20));
+  }
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 4);
+  writeFile->close();
+  EXPECT_EQ(s3WriteFile->numPendingUploads(), 0);
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 5);
+
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_EQ(readFile->size(), 9 * data.size());
+  for (int i = 0; i < 9; ++i) {
+    ASSERT_EQ(readFile->pread(i * data.size(), 10), std::string(10, 'a' + i));
+  }
+}
+
 TEST_F(S3FileSystemTest, invalidConnectionSettings) {
   auto hiveConfig =
       minioServer_->hiveConfig({{"hive.s3.connect-timeout", "400"}});
@@ -261,6 +261,86 @@ TEST_P(S3UtilProxyTest, proxyBuilderMixProxyLowerCase) {
       proxyConfig.value().password(), (useSsl ? "lctestpw2" : "lctestpw1"));
 }
 
+TEST(S3UtilTest, sliceRanges) {
+  char first[10];
+  char second[20];
+  const std::vector<folly::Range<char*>> ranges = {
+      folly::Range<char*>(first, sizeof(first)),
+      folly::Range<char*>(nullptr, reinterpret_cast<char*>(100)),
+      folly::Range<char*>(second, sizeof(second))};
+  ASSERT_EQ(totalSize(ranges), 130);
+
+  auto slice = sliceRanges(ranges, 5, 120);
+  ASSERT_EQ(slice.size(), 3);
+  EXPECT_EQ(slice[0].data(), first + 5);
+  EXPECT_EQ(slice[0].size(), 5);
+  EXPECT_EQ(slice[1].data(), nullptr);
+  EXPECT_EQ(slice[1].size(), 100);
+  EXPECT_EQ(slice[2].data(), second);
+  EXPECT_EQ(slice[2].size(), 10);
+
+  slice = sliceRanges(ranges, 20, 50);
+  ASSERT_EQ(slice.size(), 1);
+  EXPECT_EQ(slice[0].data(), nullptr);
+  EXPECT_EQ(slice[0].size(), 30);
+
+  slice = sliceRanges(ranges, 125, 130);
+  ASSERT_EQ(slice.size(), 1);
+  EXPECT_EQ(slice[0].data(), second + 15);
+  EXPECT_EQ(slice[0].size(), 5);
+}
+
+TEST(S3UtilTest, scatterStreamBuf) {
+  char first[4];
+  char second[6];
+  {
+    ScatterStreamBuf buffer(
+        {folly::Range<char*>(first, sizeof(first)),
+         folly::Range<char*>(nullptr, reinterpret_cast<char*>(3)),
+         folly::Range<char*>(second, sizeof(second))});
+    std::ostream out(&buffer);
+    out << "abc" << 'd' << "XYZ" << "efghij";
+    out.flush();
+    ASSERT_TRUE(out.good());
+    EXPECT_EQ(std::string_view(first, sizeof(first)), "abcd");
+    EXPECT_EQ(std::string_view(second, sizeof(second)), "efghij");
+    EXPECT_EQ(buffer.position(), 13);
+    EXPECT_EQ(out.tellp(), 13);
+    // Writes past the end fail.
+    out << "k";
+    EXPECT_FALSE(out.good());
+  }
+  {
+    auto gate = std::make_shared<ScatterStreamBuf::Gate>();
+    ScatterStreamBuf buffer({folly::Range<char*>(first, sizeof(first))}, gate);
+    std::ostream out(&buffer);
+    out << "12";
+    gate->close();
+    out << "34";
+    EXPECT_FALSE(out.good());
+    EXPECT_EQ(std::string_view(first, sizeof(first)), "12cd");
+  }
+}
+
+TEST(S3UtilTest, latencyTracker) {
+  LatencyTracker tracker(100);
+  for (auto i = 1; i < LatencyTracker::kMinSamples; ++i) {
+    tracker.record(i);
+  }
+  EXPECT_EQ(tracker.percentile(50), std::nullopt);
+  for (auto i = LatencyTracker::kMinSamples; i <= 100; ++i) {
+    tracker.record(i);
+  }
+  EXPECT_EQ(tracker.percentile(50), 51);
+  EXPECT_EQ(tracker.percentile(95), 96);
+  EXPECT_EQ(tracker.percentile(100), 100);
+  // Old latencies are replaced by new ones.
+  for (auto i = 0; i < 100; ++i) {
+    tracker.record(1'000);
+  }
+  EXPECT_EQ(tracker.percentile(0), 1'000);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     S3UtilTest,
     S3UtilProxyTest,
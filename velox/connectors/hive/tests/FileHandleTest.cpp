@@ -17,6 +17,7 @@
 #include "velox/connectors/hive/FileHandle.h"
 
 #include "gtest/gtest.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
@@ -74,3 +75,35 @@ TEST(FileHandleTest, localFileWithProperties) {
   // Clean up
   remove(filename.c_str());
 }
+
+TEST(FileHandleTest, notFoundTtl) {
+  filesystems::registerLocalFileSystem();
+
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  remove(filename.c_str());
+
+  FileHandleFactory factory(
+      std::make_unique<SimpleLRUCache<std::string, FileHandle>>(1000),
+      std::make_unique<FileHandleGenerator>(nullptr, 60'000));
+  FileHandleFactory uncachedFactory(
+      std::make_unique<SimpleLRUCache<std::string, FileHandle>>(1000),
+      std::make_unique<FileHandleGenerator>());
+  VELOX_ASSERT_THROW(factory.generate(filename), "No such file or directory");
+
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append("foo");
+  }
+  // The missing file is remembered.
+  try {
+    factory.generate(filename);
+    FAIL() << "Expected the remembered error";
+  } catch (const VeloxRuntimeError& e) {
+    ASSERT_EQ(e.errorCode(), error_code::kFileNotFound);
+  }
+  ASSERT_EQ(uncachedFactory.generate(filename)->file->size(), 3);
+
+  // Clean up
+  remove(filename.c_str());
+}
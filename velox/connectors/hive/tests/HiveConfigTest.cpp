@@ -45,6 +45,7 @@ TEST(HiveConfigTest, defaultConfig) {
       hiveConfig.readStatsBasedFilterReorderDisabled(emptySession.get()));
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 20'000);
   ASSERT_TRUE(hiveConfig.isFileHandleCacheEnabled());
+  ASSERT_EQ(hiveConfig.fileHandleNotFoundTtlMs(), 0);
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputRows(emptySession.get()), 1024);
   ASSERT_EQ(
       hiveConfig.sortWriterMaxOutputBytes(emptySession.get()), 10UL << 20);
@@ -53,6 +54,7 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_TRUE(hiveConfig.isPartitionPathAsLowerCase(emptySession.get()));
   ASSERT_TRUE(hiveConfig.allowNullPartitionKeys(emptySession.get()));
   ASSERT_EQ(hiveConfig.loadQuantum(emptySession.get()), 8 << 20);
+  ASSERT_FALSE(hiveConfig.isParquetDictionaryFilterEnabled(emptySession.get()));
 }
 
 TEST(HiveConfigTest, overrideConfig) {
@@ -74,7 +76,8 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kSortWriterMaxOutputBytes, "100MB"},
       {HiveConfig::kSortWriterFinishTimeSliceLimitMs, "400"},
       {HiveConfig::kReadStatsBasedFilterReorderDisabled, "true"},
-      {HiveConfig::kLoadQuantum, std::to_string(4 << 20)}};
+      {HiveConfig::kLoadQuantum, std::to_string(4 << 20)},
+      {HiveConfig::kParquetDictionaryFilterEnabled, "true"}};
   HiveConfig hiveConfig(
       std::make_shared<config::ConfigBase>(std::move(configFromFile)));
   auto emptySession = std::make_shared<config::ConfigBase>(
@@ -104,6 +107,7 @@ TEST(HiveConfigTest, overrideConfig) {
   ASSERT_TRUE(
       hiveConfig.readStatsBasedFilterReorderDisabled(emptySession.get()));
   ASSERT_EQ(hiveConfig.loadQuantum(emptySession.get()), 4 << 20);
+  ASSERT_TRUE(hiveConfig.isParquetDictionaryFilterEnabled(emptySession.get()));
 }
 
 TEST(HiveConfigTest, overrideSession) {
@@ -121,7 +125,8 @@ TEST(HiveConfigTest, overrideSession) {
       {HiveConfig::kAllowNullPartitionKeysSession, "false"},
       {HiveConfig::kIgnoreMissingFilesSession, "true"},
       {HiveConfig::kReadStatsBasedFilterReorderDisabledSession, "true"},
-      {HiveConfig::kLoadQuantumSession, std::to_string(4 << 20)}};
+      {HiveConfig::kLoadQuantumSession, std::to_string(4 << 20)},
+      {HiveConfig::kParquetDictionaryFilterEnabledSession, "true"}};
   const auto session =
       std::make_unique<config::ConfigBase>(std::move(sessionOverride));
   ASSERT_EQ(
@@ -147,4 +152,5 @@ TEST(HiveConfigTest, overrideSession) {
   ASSERT_TRUE(hiveConfig.ignoreMissingFiles(session.get()));
   ASSERT_TRUE(hiveConfig.readStatsBasedFilterReorderDisabled(session.get()));
   ASSERT_EQ(hiveConfig.loadQuantum(session.get()), 4 << 20);
+  ASSERT_TRUE(hiveConfig.isParquetDictionaryFilterEnabled(session.get()));
 }
@@ -516,6 +516,49 @@ TEST_F(HiveConnectorTest, makeScanSpecDuplicateSubfields) {
   ASSERT_EQ(c1->children().size(), 2);
 }
 
+TEST_F(HiveConnectorTest, makeScanSpecMapSubscriptFilters) {
+  auto c0Type = MAP(VARCHAR(), BIGINT());
+  auto c1Type = MAP(BIGINT(), BIGINT());
+  SubfieldFilters filters;
+  filters.emplace(Subfield("c0[\"country\"]"), exec::equal("US"));
+  filters.emplace(Subfield("c1[5]"), exec::equal(42));
+  auto scanSpec = makeScanSpec(
+      ROW({{"c0", c0Type}}),
+      {},
+      filters,
+      ROW({{"c0", c0Type}, {"c1", c1Type}}),
+      {},
+      {},
+      {},
+      false,
+      pool_.get());
+
+  // The whole map is projected out, so no key is pruned.
+  auto* c0 = scanSpec->childByName("c0");
+  ASSERT_TRUE(c0->projectOut());
+  ASSERT_FALSE(c0->filter());
+  ASSERT_TRUE(c0->hasFilter());
+  ASSERT_FALSE(c0->childByName(ScanSpec::kMapKeysFieldName)->filter());
+  ASSERT_EQ(c0->mapSubscripts().size(), 1);
+  auto* country = c0->mapSubscripts()[0].get();
+  ASSERT_EQ(country->fieldName(), "country");
+  ASSERT_TRUE(country->filter()->testBytes("US", 2));
+  ASSERT_FALSE(country->filter()->testBytes("CA", 2));
+  ASSERT_FALSE(c0->testNull());
+
+  // Filter only, only the filtered key is read.
+  auto* c1 = scanSpec->childByName("c1");
+  ASSERT_FALSE(c1->projectOut());
+  ASSERT_TRUE(c1->hasFilter());
+  auto* keysFilter = c1->childByName(ScanSpec::kMapKeysFieldName)->filter();
+  ASSERT_TRUE(keysFilter);
+  ASSERT_TRUE(keysFilter->testInt64(5));
+  ASSERT_FALSE(keysFilter->testInt64(6));
+  ASSERT_EQ(c1->mapSubscripts().size(), 1);
+  ASSERT_EQ(c1->mapSubscripts()[0]->fieldName(), "5");
+  ASSERT_TRUE(c1->mapSubscripts()[0]->filter()->testInt64(42));
+}
+
 // For TEXTFILE, partition key is not included in data columns.
 TEST_F(HiveConnectorTest, makeScanSpecFilterPartitionKey) {
   auto rowType = ROW({{"c0", BIGINT()}});
@@ -612,6 +655,47 @@ TEST_F(HiveConnectorTest, extractFiltersFromRemainingFilter) {
       remaining->toString(), "not(lt(ROW[\"c2\"],cast 0 as DECIMAL(20, 0)))");
 }
 
+TEST_F(HiveConnectorTest, extractFunctionFilters) {
+  auto queryCtx = core::QueryCtx::create();
+  exec::SimpleExpressionEvaluator evaluator(queryCtx.get(), pool_.get());
+  auto rowType = ROW({"c0", "c1", "c2"}, {BIGINT(), BIGINT(), VARCHAR()});
+
+  auto expr = parseExpr(
+      "c0 % 3 = 1 and c1 > c0 and (length(c2) = 2 or c2 is null) and c0 > 1",
+      rowType);
+  SubfieldFilters filters;
+  double sampleRate = 1;
+  auto remaining = extractFiltersFromRemainingFilter(
+      expr, &evaluator, false, filters, sampleRate);
+  ASSERT_TRUE(remaining);
+  auto remainingString = remaining->toString();
+  extractFunctionFilters(remaining, &evaluator, filters);
+  // The remaining filter is not changed.
+  ASSERT_EQ(remaining->toString(), remainingString);
+  ASSERT_EQ(filters.size(), 2);
+
+  // The range filter on c0 is the base of the function filter.
+  auto& c0 = filters.at(Subfield("c0"));
+  ASSERT_EQ(c0->kind(), FilterKind::kFunction);
+  ASSERT_TRUE(c0->testInt64(4));
+  ASSERT_FALSE(c0->testInt64(1));
+  ASSERT_FALSE(c0->testInt64(5));
+  ASSERT_FALSE(c0->testNull());
+  ASSERT_FALSE(c0->testInt64Range(-10, 0, false));
+
+  auto& c2 = filters.at(Subfield("c2"));
+  ASSERT_EQ(c2->kind(), FilterKind::kFunction);
+  ASSERT_TRUE(c2->testBytes("ab", 2));
+  ASSERT_FALSE(c2->testBytes("abc", 3));
+  ASSERT_TRUE(c2->testNull());
+
+  // Disjunctions over more than one column are not extracted.
+  filters.clear();
+  extractFunctionFilters(
+      parseExpr("c0 % 3 = 1 or c1 % 3 = 1", rowType), &evaluator, filters);
+  ASSERT_TRUE(filters.empty());
+}
+
 TEST_F(HiveConnectorTest, prestoTableSampling) {
   auto queryCtx = core::QueryCtx::create();
   exec::SimpleExpressionEvaluator evaluator(queryCtx.get(), pool_.get());
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include <re2/re2.h>
 #include "velox/common/base/Fs.h"
@@ -177,7 +178,8 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
           bucketProperty = nullptr,
       const std::shared_ptr<dwio::common::WriterOptions>& writerOptions =
           nullptr,
-      const bool ensureFiles = false) {
+      const bool ensureFiles = false,
+      folly::Executor* writeExecutor = nullptr) {
     return std::make_shared<HiveDataSink>(
         rowType,
         createHiveInsertTableHandle(
@@ -190,7 +192,8 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
             ensureFiles),
         connectorQueryCtx_.get(),
         CommitStrategy::kNoCommit,
-        connectorConfig_);
+        connectorConfig_,
+        writeExecutor);
   }
 
   std::vector<std::string> listFiles(const std::string& dirPath) {
@@ -596,6 +599,111 @@ TEST_F(HiveDataSinkTest, basicBucket) {
   verifyWrittenData(outputDirectory->getPath(), numBuckets);
 }
 
+TEST_F(HiveDataSinkTest, parallelPartitionWriters) {
+  const int32_t numBuckets = 8;
+  folly::CPUThreadPoolExecutor writeExecutor(4);
+  connectorSessionProperties_->set(
+      HiveConfig::kMaxParallelPartitionWritersSession, "4");
+  const auto vectors = createVectors(500, 10);
+  createDuckDbTable(vectors);
+  for (bool sortWriter : {false, true}) {
+    SCOPED_TRACE(fmt::format("sortWriter: {}", sortWriter));
+    const auto outputDirectory = TempDirectoryPath::create();
+    std::vector<std::shared_ptr<const HiveSortingColumn>> sortedBy;
+    if (sortWriter) {
+      sortedBy.push_back(std::make_shared<HiveSortingColumn>(
+          "c1", core::SortOrder{false, false}));
+    }
+    auto bucketProperty = std::make_shared<HiveBucketProperty>(
+        HiveBucketProperty::Kind::kHiveCompatible,
+        numBuckets,
+        std::vector<std::string>{"c0"},
+        std::vector<TypePtr>{BIGINT()},
+        sortedBy);
+    auto dataSink = createDataSink(
+        rowType_,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {},
+        bucketProperty,
+        nullptr,
+        false,
+        &writeExecutor);
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    while (!dataSink->finish()) {
+    }
+    const auto partitions = dataSink->close();
+    ASSERT_EQ(partitions.size(), numBuckets);
+    verifyWrittenData(outputDirectory->getPath(), numBuckets);
+  }
+}
+
+TEST_F(HiveDataSinkTest, writersMemoryBudget) {
+  const int32_t numBuckets = 4;
+  const auto vectors = createVectors(500, 10);
+  createDuckDbTable(vectors);
+  const auto spillDirectory = exec::test::TempDirectoryPath::create();
+  const auto spillConfig = getSpillConfig(spillDirectory->getPath(), 0);
+  struct {
+    bool sortWriter;
+    std::string budget;
+    bool expectSpill;
+  } testSettings[] = {
+      {true, "0B", false},
+      {true, "1B", true},
+      {false, "1B", false},
+  };
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(fmt::format(
+        "sortWriter: {}, budget: {}", testData.sortWriter, testData.budget));
+    setupMemoryPools();
+    setConnectorQueryContext(std::make_unique<connector::ConnectorQueryCtx>(
+        opPool_.get(),
+        connectorPool_.get(),
+        connectorSessionProperties_.get(),
+        spillConfig.get(),
+        common::PrefixSortConfig(),
+        nullptr,
+        nullptr,
+        "query.HiveDataSinkTest",
+        "task.HiveDataSinkTest",
+        "planNodeId.HiveDataSinkTest",
+        0,
+        ""));
+    connectorSessionProperties_->set(
+        HiveConfig::kPartitionWritersMemoryBudgetSession, testData.budget);
+    std::vector<std::shared_ptr<const HiveSortingColumn>> sortedBy;
+    if (testData.sortWriter) {
+      sortedBy.push_back(std::make_shared<HiveSortingColumn>(
+          "c1", core::SortOrder{false, false}));
+    }
+    auto bucketProperty = std::make_shared<HiveBucketProperty>(
+        HiveBucketProperty::Kind::kHiveCompatible,
+        numBuckets,
+        std::vector<std::string>{"c0"},
+        std::vector<TypePtr>{BIGINT()},
+        sortedBy);
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType_,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {},
+        bucketProperty);
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    ASSERT_EQ(
+        dataSink->stats().spillStats.spilledRows > 0, testData.expectSpill);
+    while (!dataSink->finish()) {
+    }
+    ASSERT_EQ(dataSink->close().size(), numBuckets);
+    verifyWrittenData(outputDirectory->getPath(), numBuckets);
+  }
+}
+
 TEST_F(HiveDataSinkTest, close) {
   for (bool empty : {true, false}) {
     SCOPED_TRACE(fmt::format("Data sink is empty: {}", empty));
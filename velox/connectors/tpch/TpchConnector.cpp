@@ -63,8 +63,13 @@ TpchDataSource::TpchDataSource(
     const std::unordered_map<
         std::string,
         std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-    velox::memory::MemoryPool* pool)
-    : pool_(pool) {
+    velox::memory::MemoryPool* pool,
+    folly::Executor* executor,
+    int32_t maxParallelBatches)
+    : pool_(pool),
+      executor_(executor),
+      maxParallelBatches_(maxParallelBatches) {
+  VELOX_CHECK_GE(maxParallelBatches_, 0);
   auto tpchTableHandle =
       std::dynamic_pointer_cast<TpchTableHandle>(tableHandle);
   VELOX_CHECK_NOT_NULL(
@@ -105,6 +110,10 @@ TpchDataSource::TpchDataSource(
   outputType_ = outputType;
 }
 
+TpchDataSource::~TpchDataSource() {
+  closePendingBatches();
+}
+
 RowVectorPtr TpchDataSource::projectOutputColumns(RowVectorPtr inputVector) {
   std::vector<VectorPtr> children;
   children.reserve(outputColumnMappings_.size());
@@ -158,20 +167,25 @@ std::optional<RowVectorPtr> TpchDataSource::next(
     size /= 4;
   }
 
-  size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
-  auto outputVector =
-      getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  std::shared_ptr<AsyncSource<Batch>> batch;
+  if (pendingBatches_.empty()) {
+    batch = makeBatch(size);
+  } else {
+    batch = std::move(pendingBatches_.front());
+    pendingBatches_.pop_front();
+  }
+  // The next batches are generated while this thread waits for or makes
+  // 'batch'.
+  prefetch(size);
+  auto outputVector = batch->move()->vector;
 
   // If the split is exhausted.
   if (!outputVector || outputVector->size() == 0) {
+    closePendingBatches();
     currentSplit_ = nullptr;
     return nullptr;
   }
 
-  // splitOffset needs to advance based on maxRows passed to getTpchData(), and
-  // not the actual number of returned rows in the output vector, as they are
-  // not the same for lineitem.
-  splitOffset_ += maxRows;
   completedRows_ += outputVector->size();
   completedBytes_ += outputVector->retainedSize();
 
@@ -182,4 +196,42 @@ bool TpchDataSource::isLineItem() const {
   return tpchTable_ == Table::TBL_LINEITEM;
 }
 
+std::shared_ptr<AsyncSource<TpchDataSource::Batch>> TpchDataSource::makeBatch(
+    size_t maxRows) {
+  const size_t numRows = std::min(maxRows, splitEnd_ - splitOffset_);
+  const size_t offset = splitOffset_;
+  // splitOffset needs to advance based on the rows passed to getTpchData(),
+  // and not the actual number of returned rows in the output vector, as they
+  // are not the same for lineitem.
+  splitOffset_ += numRows;
+  return std::make_shared<AsyncSource<Batch>>(
+      [table = tpchTable_,
+       numRows,
+       offset,
+       scaleFactor = scaleFactor_,
+       pool = pool_]() {
+        return std::make_unique<Batch>(
+            Batch{getTpchData(table, numRows, offset, scaleFactor, pool)});
+      });
+}
+
+void TpchDataSource::prefetch(size_t maxRows) {
+  if (executor_ == nullptr) {
+    return;
+  }
+  while (pendingBatches_.size() < static_cast<size_t>(maxParallelBatches_) &&
+         splitOffset_ < splitEnd_) {
+    auto batch = makeBatch(maxRows);
+    executor_->add([batch]() { batch->prepare(); });
+    pendingBatches_.push_back(std::move(batch));
+  }
+}
+
+void TpchDataSource::closePendingBatches() {
+  for (auto& batch : pendingBatches_) {
+    batch->close();
+  }
+  pendingBatches_.clear();
+}
+
 } // namespace facebook::velox::connector::tpch
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <deque>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/config/Config.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/tpch/TpchConnectorSplit.h"
@@ -76,7 +79,11 @@ class TpchDataSource : public DataSource {
       const std::unordered_map<
           std::string,
           std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-      velox::memory::MemoryPool* pool);
+      velox::memory::MemoryPool* pool,
+      folly::Executor* executor = nullptr,
+      int32_t maxParallelBatches = 0);
+
+  ~TpchDataSource() override;
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -103,8 +110,22 @@ class TpchDataSource : public DataSource {
   }
 
  private:
+  struct Batch {
+    RowVectorPtr vector;
+  };
+
   bool isLineItem() const;
 
+  // Returns the next batch of the split with up to 'maxRows' rows, lineitem
+  // in orders, and advances 'splitOffset_'.
+  std::shared_ptr<AsyncSource<Batch>> makeBatch(size_t maxRows);
+
+  // Starts generating the next batches of the split on 'executor_', up to
+  // 'maxParallelBatches_' batches ahead of the consumer.
+  void prefetch(size_t maxRows);
+
+  void closePendingBatches();
+
   RowVectorPtr projectOutputColumns(RowVectorPtr vector);
 
   velox::tpch::Table tpchTable_;
@@ -127,15 +148,32 @@ class TpchDataSource : public DataSource {
   size_t completedBytes_{0};
 
   memory::MemoryPool* pool_;
+
+  // Generates the batches in 'pendingBatches_'. nullptr if batches are
+  // generated on the calling thread.
+  folly::Executor* const executor_;
+  const int32_t maxParallelBatches_;
+
+  // The next batches of the split, in order. Each covers a disjoint range of
+  // rows, so they are generated concurrently.
+  std::deque<std::shared_ptr<AsyncSource<Batch>>> pendingBatches_;
 };
 
 class TpchConnector final : public Connector {
  public:
+  /// The number of batches of a split generated concurrently on the
+  /// connector's executor, ahead of the scan. 0 generates each batch on the
+  /// Driver thread when the scan needs it.
+  static constexpr const char* kMaxParallelBatches = "max-parallel-batches";
+
   TpchConnector(
       const std::string& id,
       std::shared_ptr<const config::ConfigBase> config,
-      folly::Executor* /*executor*/)
-      : Connector(id) {}
+      folly::Executor* executor)
+      : Connector(id),
+        executor_(executor),
+        maxParallelBatches_(
+            config ? config->get<int32_t>(kMaxParallelBatches, 0) : 0) {}
 
   std::unique_ptr<DataSource> createDataSource(
       const std::shared_ptr<const RowType>& outputType,
@@ -148,7 +186,9 @@ class TpchConnector final : public Connector {
         outputType,
         tableHandle,
         columnHandles,
-        connectorQueryCtx->memoryPool());
+        connectorQueryCtx->memoryPool(),
+        executor_,
+        maxParallelBatches_);
   }
 
   std::unique_ptr<DataSink> createDataSink(
@@ -159,6 +199,10 @@ class TpchConnector final : public Connector {
       CommitStrategy /*commitStrategy*/) override final {
     VELOX_NYI("TpchConnector does not support data sink.");
   }
+
+ private:
+  folly::Executor* const executor_;
+  const int32_t maxParallelBatches_;
 };
 
 class TpchConnectorFactory : public ConnectorFactory {
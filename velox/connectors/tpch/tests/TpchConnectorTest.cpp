@@ -15,6 +15,8 @@
  */
 
 #include "velox/connectors/tpch/TpchConnector.h"
+#include <folly/ScopeGuard.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -299,6 +301,68 @@ TEST_F(TpchConnectorTest, orderDateCount) {
   EXPECT_EQ(9, orderDate->size());
 }
 
+// Batches generated ahead of the scan on the connector's executor must match
+// the ones generated inline.
+TEST_F(TpchConnectorTest, parallelBatches) {
+  const std::string kParallelConnectorId = "test-tpch-parallel";
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  auto parallelConnector =
+      connector::getConnectorFactory(
+          connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+          ->newConnector(
+              kParallelConnectorId,
+              std::make_shared<config::ConfigBase>(
+                  std::unordered_map<std::string, std::string>{
+                      {TpchConnector::kMaxParallelBatches, "4"}}),
+              executor.get());
+  connector::registerConnector(parallelConnector);
+  SCOPE_EXIT {
+    connector::unregisterConnector(kParallelConnectorId);
+  };
+
+  for (const auto& [table, columns] :
+       std::vector<std::pair<Table, std::vector<std::string>>>{
+           {Table::TBL_ORDERS,
+            {"o_orderkey", "o_orderdate", "o_totalprice", "o_comment"}},
+           {Table::TBL_LINEITEM,
+            {"l_orderkey", "l_linenumber", "l_shipdate", "l_comment"}},
+           // p_name is built by agg_str(), which permutes a shared
+           // distribution.
+           {Table::TBL_PART,
+            {"p_partkey", "p_name", "p_retailprice", "p_comment"}},
+           {Table::TBL_PARTSUPP,
+            {"ps_partkey", "ps_suppkey", "ps_supplycost", "ps_comment"}},
+           {Table::TBL_SUPPLIER,
+            {"s_suppkey", "s_name", "s_acctbal", "s_comment"}}}) {
+    SCOPED_TRACE(toTableName(table));
+    auto plan = PlanBuilder().tpchTableScan(table, columns, 0.01).planNode();
+    auto parallelPlan =
+        PlanBuilder()
+            .tpchTableScan(table, columns, 0.01, kParallelConnectorId)
+            .planNode();
+
+    for (const size_t numSplits : {1, 3}) {
+      std::vector<exec::Split> splits;
+      std::vector<exec::Split> parallelSplits;
+      for (size_t i = 0; i < numSplits; ++i) {
+        splits.push_back(makeTpchSplit(numSplits, i));
+        parallelSplits.push_back(exec::Split(
+            std::make_shared<TpchConnectorSplit>(
+                kParallelConnectorId, /*cacheable=*/true, numSplits, i)));
+      }
+      auto expected = getResults(plan, std::move(splits));
+      // Small batches so that several are generated at the same time.
+      auto output = exec::test::AssertQueryBuilder(parallelPlan)
+                        .splits(std::move(parallelSplits))
+                        .config(
+                            core::QueryConfig::kPreferredOutputBatchRows,
+                            "100")
+                        .copyResults(pool());
+      test::assertEqualVectors(expected, output);
+    }
+  }
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -258,11 +258,43 @@ void addVectorSerdeKind(VectorSerde::Kind kind, std::stringstream& stream) {
 }
 } // namespace
 
+bool AggregationNode::supportsTwoLevelDistinct() const {
+  if (!isSingle() || groupingKeys_.empty() || !preGroupedKeys_.empty() ||
+      !globalGroupingSets_.empty() || groupId_.has_value() ||
+      ignoreNullKeys_ || aggregates_.empty()) {
+    return false;
+  }
+  std::vector<std::string> distinctInputs;
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    const auto& aggregate = aggregates_[i];
+    if (!aggregate.distinct || aggregate.mask != nullptr ||
+        !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    std::vector<std::string> inputs;
+    for (const auto& input : aggregate.call->inputs()) {
+      if (auto field = TypedExprs::asFieldAccess(input)) {
+        inputs.push_back(field->name());
+      } else if (!TypedExprs::isConstant(input)) {
+        return false;
+      }
+    }
+    if (inputs.empty() || (i > 0 && inputs != distinctInputs)) {
+      return false;
+    }
+    distinctInputs = std::move(inputs);
+  }
+  return true;
+}
+
 bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
   // TODO: Add spilling for aggregations over distinct inputs.
   // https://github.com/facebookincubator/velox/issues/7454
+  const bool twoLevelDistinct =
+      queryConfig.twoLevelDistinctAggregationEnabled() &&
+      supportsTwoLevelDistinct();
   for (const auto& aggregate : aggregates_) {
-    if (aggregate.distinct) {
+    if (aggregate.distinct && !twoLevelDistinct) {
       return false;
     }
   }
@@ -1054,7 +1086,9 @@ const std::vector<PlanNodePtr>& ArrowStreamNode::sources() const {
 }
 
 void ArrowStreamNode::addDetails(std::stringstream& stream) const {
-  // Nothing to add.
+  if (arrowStreams_.size() > 1) {
+    stream << arrowStreams_.size() << " streams";
+  }
 }
 
 const std::vector<PlanNodePtr>& ExchangeNode::sources() const {
@@ -2068,8 +2102,40 @@ PlanNodePtr RowNumberNode::create(const folly::dynamic& obj, void* context) {
       source);
 }
 
+namespace {
+std::unordered_map<TopNRowNumberNode::RankFunction, std::string>
+rankFunctionNames() {
+  return {
+      {TopNRowNumberNode::RankFunction::kRowNumber, "row_number"},
+      {TopNRowNumberNode::RankFunction::kRank, "rank"},
+      {TopNRowNumberNode::RankFunction::kDenseRank, "dense_rank"},
+  };
+}
+} // namespace
+
+// static
+const char* TopNRowNumberNode::rankFunctionName(RankFunction function) {
+  static const auto kFunctions = rankFunctionNames();
+  auto it = kFunctions.find(function);
+  VELOX_CHECK(
+      it != kFunctions.end(),
+      "Invalid rank function {}",
+      static_cast<int>(function));
+  return it->second.c_str();
+}
+
+// static
+TopNRowNumberNode::RankFunction TopNRowNumberNode::rankFunctionFromName(
+    const std::string& name) {
+  static const auto kFunctions = invertMap(rankFunctionNames());
+  auto it = kFunctions.find(name);
+  VELOX_CHECK(it != kFunctions.end(), "Invalid rank function " + name);
+  return it->second;
+}
+
 TopNRowNumberNode::TopNRowNumberNode(
     PlanNodeId id,
+    RankFunction function,
     std::vector<FieldAccessTypedExprPtr> partitionKeys,
     std::vector<FieldAccessTypedExprPtr> sortingKeys,
     std::vector<SortOrder> sortingOrders,
@@ -2077,6 +2143,7 @@ TopNRowNumberNode::TopNRowNumberNode(
     int32_t limit,
     PlanNodePtr source)
     : PlanNode(std::move(id)),
+      function_{function},
       partitionKeys_{std::move(partitionKeys)},
       sortingKeys_{std::move(sortingKeys)},
       sortingOrders_{std::move(sortingOrders)},
@@ -2114,6 +2181,10 @@ TopNRowNumberNode::TopNRowNumberNode(
 }
 
 void TopNRowNumberNode::addDetails(std::stringstream& stream) const {
+  if (function_ != RankFunction::kRowNumber) {
+    stream << rankFunctionName(function_) << " ";
+  }
+
   if (!partitionKeys_.empty()) {
     stream << "partition by (";
     addFields(stream, partitionKeys_);
@@ -2129,6 +2200,7 @@ void TopNRowNumberNode::addDetails(std::stringstream& stream) const {
 
 folly::dynamic TopNRowNumberNode::serialize() const {
   auto obj = PlanNode::serialize();
+  obj["function"] = rankFunctionName(function_);
   obj["partitionKeys"] = ISerializable::serialize(partitionKeys_);
   obj["sortingKeys"] = ISerializable::serialize(sortingKeys_);
   obj["sortingOrders"] = serializeSortingOrders(sortingOrders_);
@@ -2154,8 +2226,15 @@ PlanNodePtr TopNRowNumberNode::create(
     rowNumberColumnName = obj["rowNumberColumnName"].asString();
   }
 
+  // Plans serialized before rank() and dense_rank() support have no function.
+  auto function = RankFunction::kRowNumber;
+  if (obj.count("function")) {
+    function = rankFunctionFromName(obj["function"].asString());
+  }
+
   return std::make_shared<TopNRowNumberNode>(
       deserializePlanNodeId(obj),
+      function,
       partitionKeys,
       sortingKeys,
       sortingOrders,
@@ -2381,6 +2460,8 @@ PartitionedOutputNode::PartitionedOutputNode(
     PartitionFunctionSpecPtr partitionFunctionSpec,
     RowTypePtr outputType,
     VectorSerde::Kind serdeKind,
+    SkewedPartitionMode skewedPartitionMode,
+    std::vector<uint32_t> skewedPartitions,
     PlanNodePtr source)
     : PlanNode(id),
       kind_(kind),
@@ -2390,6 +2471,8 @@ PartitionedOutputNode::PartitionedOutputNode(
       replicateNullsAndAny_(replicateNullsAndAny),
       partitionFunctionSpec_(std::move(partitionFunctionSpec)),
       serdeKind_(serdeKind),
+      skewedPartitionMode_(skewedPartitionMode),
+      skewedPartitions_(std::move(skewedPartitions)),
       outputType_(std::move(outputType)) {
   VELOX_USER_CHECK_GT(numPartitions_, 0);
   if (numPartitions_ == 1) {
@@ -2403,6 +2486,23 @@ PartitionedOutputNode::PartitionedOutputNode(
         "{} partitioning doesn't allow for partitioning keys",
         kindString(kind_));
   }
+  if (skewedPartitionMode_ == SkewedPartitionMode::kNone) {
+    VELOX_USER_CHECK(
+        skewedPartitions_.empty(),
+        "Skewed partitions require a skewed partition mode");
+  } else {
+    VELOX_USER_CHECK(
+        isPartitioned() && numPartitions_ > 1,
+        "Skewed partitions require hash partitioning");
+    VELOX_USER_CHECK(
+        !skewedPartitions_.empty(),
+        "Skewed partition mode {} requires skewed partitions",
+        skewedPartitionModeString(skewedPartitionMode_));
+    for (const auto partition : skewedPartitions_) {
+      VELOX_USER_CHECK_LT(
+          partition, numPartitions_, "Skewed partition is out of range");
+    }
+  }
 }
 
 // static
@@ -2422,6 +2522,8 @@ std::shared_ptr<PartitionedOutputNode> PartitionedOutputNode::broadcast(
       std::make_shared<GatherPartitionFunctionSpec>(),
       std::move(outputType),
       serdeKind,
+      SkewedPartitionMode::kNone,
+      std::vector<uint32_t>{},
       std::move(source));
 }
 
@@ -2441,6 +2543,8 @@ std::shared_ptr<PartitionedOutputNode> PartitionedOutputNode::arbitrary(
       std::make_shared<GatherPartitionFunctionSpec>(),
       std::move(outputType),
       serdeKind,
+      SkewedPartitionMode::kNone,
+      std::vector<uint32_t>{},
       std::move(source));
 }
 
@@ -2460,6 +2564,8 @@ std::shared_ptr<PartitionedOutputNode> PartitionedOutputNode::single(
       std::make_shared<GatherPartitionFunctionSpec>(),
       std::move(outputType),
       serdeKind,
+      SkewedPartitionMode::kNone,
+      std::vector<uint32_t>{},
       std::move(source));
 }
 
@@ -2511,6 +2617,38 @@ PartitionedOutputNode::Kind PartitionedOutputNode::stringToKind(
   return it->second;
 }
 
+namespace {
+std::unordered_map<PartitionedOutputNode::SkewedPartitionMode, std::string>
+skewedPartitionModeNames() {
+  return {
+      {PartitionedOutputNode::SkewedPartitionMode::kNone, "NONE"},
+      {PartitionedOutputNode::SkewedPartitionMode::kSpread, "SPREAD"},
+      {PartitionedOutputNode::SkewedPartitionMode::kReplicate, "REPLICATE"},
+  };
+}
+} // namespace
+
+// static
+std::string PartitionedOutputNode::skewedPartitionModeString(
+    SkewedPartitionMode mode) {
+  static const auto kModeNames = skewedPartitionModeNames();
+  auto it = kModeNames.find(mode);
+  VELOX_CHECK(
+      it != kModeNames.end(),
+      "Invalid skewed partition mode {}",
+      static_cast<int>(mode));
+  return it->second;
+}
+
+// static
+PartitionedOutputNode::SkewedPartitionMode
+PartitionedOutputNode::stringToSkewedPartitionMode(const std::string& name) {
+  static const auto kModes = invertMap(skewedPartitionModeNames());
+  auto it = kModes.find(name);
+  VELOX_CHECK(it != kModes.end(), "Invalid skewed partition mode " + name);
+  return it->second;
+}
+
 void PartitionedOutputNode::addDetails(std::stringstream& stream) const {
   if (kind_ == Kind::kBroadcast) {
     stream << "BROADCAST";
@@ -2531,6 +2669,13 @@ void PartitionedOutputNode::addDetails(std::stringstream& stream) const {
     stream << " replicate nulls and any";
   }
 
+  if (skewedPartitionMode_ != SkewedPartitionMode::kNone) {
+    stream << fmt::format(
+        " {} skewed partitions [{}]",
+        skewedPartitionModeString(skewedPartitionMode_),
+        folly::join(", ", skewedPartitions_));
+  }
+
   stream << " ";
   addVectorSerdeKind(serdeKind_, stream);
 }
@@ -2543,6 +2688,15 @@ folly::dynamic PartitionedOutputNode::serialize() const {
   obj["replicateNullsAndAny"] = replicateNullsAndAny_;
   obj["partitionFunctionSpec"] = partitionFunctionSpec_->serialize();
   obj["serdeKind"] = VectorSerde::kindName(serdeKind_);
+  if (skewedPartitionMode_ != SkewedPartitionMode::kNone) {
+    obj["skewedPartitionMode"] =
+        skewedPartitionModeString(skewedPartitionMode_);
+    folly::dynamic partitions = folly::dynamic::array;
+    for (const auto partition : skewedPartitions_) {
+      partitions.push_back(partition);
+    }
+    obj["skewedPartitions"] = std::move(partitions);
+  }
   obj["outputType"] = outputType_->serialize();
   return obj;
 }
@@ -2551,6 +2705,15 @@ folly::dynamic PartitionedOutputNode::serialize() const {
 PlanNodePtr PartitionedOutputNode::create(
     const folly::dynamic& obj,
     void* context) {
+  auto skewedPartitionMode = SkewedPartitionMode::kNone;
+  std::vector<uint32_t> skewedPartitions;
+  if (obj.count("skewedPartitionMode")) {
+    skewedPartitionMode =
+        stringToSkewedPartitionMode(obj["skewedPartitionMode"].asString());
+    for (const auto& partition : obj["skewedPartitions"]) {
+      skewedPartitions.push_back(partition.asInt());
+    }
+  }
   return std::make_shared<PartitionedOutputNode>(
       deserializePlanNodeId(obj),
       stringToKind(obj["kind"].asString()),
@@ -2561,6 +2724,8 @@ PlanNodePtr PartitionedOutputNode::create(
           obj["partitionFunctionSpec"], context),
       deserializeRowType(obj["outputType"]),
       VectorSerde::kindByName(obj["serdeKind"].asString()),
+      skewedPartitionMode,
+      std::move(skewedPartitions),
       deserializeSingleSource(obj, context));
 }
 
@@ -326,16 +326,34 @@ class ValuesNode : public PlanNode {
 
 using ValuesNodePtr = std::shared_ptr<const ValuesNode>;
 
+/// Reads the record batches of one or more Arrow C streams, e.g. the
+/// partitions of a result produced by an Arrow engine. The streams are read
+/// by up to as many Drivers as there are streams, each Driver reading the
+/// streams whose index modulo the number of Drivers is its driver id. All the
+/// streams must have the schema of 'outputType'.
 class ArrowStreamNode : public PlanNode {
  public:
   ArrowStreamNode(
       const PlanNodeId& id,
       RowTypePtr outputType,
       std::shared_ptr<ArrowArrayStream> arrowStream)
+      : ArrowStreamNode(
+            id,
+            std::move(outputType),
+            std::vector<std::shared_ptr<ArrowArrayStream>>{
+                std::move(arrowStream)}) {}
+
+  ArrowStreamNode(
+      const PlanNodeId& id,
+      RowTypePtr outputType,
+      std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams)
       : PlanNode(id),
         outputType_(std::move(outputType)),
-        arrowStream_(std::move(arrowStream)) {
-    VELOX_USER_CHECK_NOT_NULL(arrowStream_);
+        arrowStreams_(std::move(arrowStreams)) {
+    VELOX_USER_CHECK(!arrowStreams_.empty());
+    for (const auto& arrowStream : arrowStreams_) {
+      VELOX_USER_CHECK_NOT_NULL(arrowStream);
+    }
   }
 
   const RowTypePtr& outputType() const override {
@@ -344,8 +362,8 @@ class ArrowStreamNode : public PlanNode {
 
   const std::vector<PlanNodePtr>& sources() const override;
 
-  const std::shared_ptr<ArrowArrayStream>& arrowStream() const {
-    return arrowStream_;
+  const std::vector<std::shared_ptr<ArrowArrayStream>>& arrowStreams() const {
+    return arrowStreams_;
   }
 
   std::string_view name() const override {
@@ -360,7 +378,7 @@ class ArrowStreamNode : public PlanNode {
   void addDetails(std::stringstream& stream) const override;
 
   const RowTypePtr outputType_;
-  std::shared_ptr<ArrowArrayStream> arrowStream_;
+  const std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams_;
 };
 
 class TraceScanNode final : public PlanNode {
@@ -728,6 +746,13 @@ class AggregationNode : public PlanNode {
 
   bool canSpill(const QueryConfig& queryConfig) const override;
 
+  /// Returns true if this is a single step aggregation with grouping keys
+  /// whose aggregates are all distinct, without masks or sorting keys, over
+  /// the same column inputs. Such an aggregation can de-duplicate the grouping
+  /// keys and the inputs first and then aggregate the unique rows. See
+  /// QueryConfig::kTwoLevelDistinctAggregationEnabled.
+  bool supportsTwoLevelDistinct() const;
+
   bool isFinal() const {
     return step_ == Step::kFinal;
   }
@@ -1337,6 +1362,25 @@ class PartitionedOutputNode : public PlanNode {
   static std::string kindString(Kind kind);
   static Kind stringToKind(const std::string& str);
 
+  /// Specifies how the rows of the partitions listed in 'skewedPartitions' are
+  /// sent. The two sides of a shuffle join use matching modes to spread a hot
+  /// join key over more consumers than its hash partition.
+  enum class SkewedPartitionMode {
+    /// Rows of all partitions go to their hash partition.
+    kNone,
+    /// Used for the probe side. A skewed partition that turns out to be
+    /// overloaded at runtime is spread over more destinations.
+    kSpread,
+    /// Used for the build side. Rows of skewed partitions are sent to all
+    /// destinations, so that every destination can join the spread probe rows
+    /// of these partitions. Must not be used for joins that produce unmatched
+    /// build rows, i.e. right, full and right semi project joins.
+    kReplicate,
+  };
+  static std::string skewedPartitionModeString(SkewedPartitionMode mode);
+  static SkewedPartitionMode stringToSkewedPartitionMode(
+      const std::string& str);
+
   PartitionedOutputNode(
       const PlanNodeId& id,
       Kind kind,
@@ -1346,6 +1390,8 @@ class PartitionedOutputNode : public PlanNode {
       PartitionFunctionSpecPtr partitionFunctionSpec,
       RowTypePtr outputType,
       VectorSerde::Kind serdeKind,
+      SkewedPartitionMode skewedPartitionMode,
+      std::vector<uint32_t> skewedPartitions,
       PlanNodePtr source);
 
   static std::shared_ptr<PartitionedOutputNode> broadcast(
@@ -1423,6 +1469,16 @@ class PartitionedOutputNode : public PlanNode {
     return *partitionFunctionSpec_;
   }
 
+  SkewedPartitionMode skewedPartitionMode() const {
+    return skewedPartitionMode_;
+  }
+
+  /// The partitions that may be skewed. Empty if 'skewedPartitionMode' is
+  /// kNone.
+  const std::vector<uint32_t>& skewedPartitions() const {
+    return skewedPartitions_;
+  }
+
   std::string_view name() const override {
     return "PartitionedOutput";
   }
@@ -1441,6 +1497,8 @@ class PartitionedOutputNode : public PlanNode {
   const bool replicateNullsAndAny_;
   const PartitionFunctionSpecPtr partitionFunctionSpec_;
   const VectorSerde::Kind serdeKind_;
+  const SkewedPartitionMode skewedPartitionMode_;
+  const std::vector<uint32_t> skewedPartitions_;
   const RowTypePtr outputType_;
 };
 
@@ -2417,8 +2475,7 @@ class WindowNode : public PlanNode {
     // No partitioning keys means the whole input is one big partition. In
     // this case, spilling is not helpful because we need to have a full
     // partition in memory to produce results.
-    return !partitionKeys_.empty() && !inputsSorted_ &&
-        queryConfig.windowSpillEnabled();
+    return !partitionKeys_.empty() && queryConfig.windowSpillEnabled();
   }
 
   const RowTypePtr& inputType() const {
@@ -2557,6 +2614,10 @@ class MarkDistinctNode : public PlanNode {
     return outputType_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.markDistinctSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "MarkDistinct";
   }
@@ -2591,18 +2652,37 @@ class MarkDistinctNode : public PlanNode {
 /// 'rowNumberColumnName' BIGINT column.
 class TopNRowNumberNode : public PlanNode {
  public:
+  /// The ranking window function computed for each row. Rows whose rank
+  /// exceeds the limit are dropped.
+  enum class RankFunction {
+    /// row_number(): 1, 2, 3... Peers get distinct numbers.
+    kRowNumber,
+    /// rank(): 1 + the number of rows that sort before the row. Peers get the
+    /// same rank and leave gaps, e.g. 1, 1, 3.
+    kRank,
+    /// dense_rank(): like rank() but without gaps, e.g. 1, 1, 2.
+    kDenseRank,
+  };
+
+  static const char* rankFunctionName(RankFunction function);
+
+  static RankFunction rankFunctionFromName(const std::string& name);
+
+  /// @param function The ranking function to apply the limit to.
   /// @param partitionKeys Partitioning keys. May be empty.
   /// @param sortingKeys Sorting keys. May not be empty and may not intersect
   /// with 'partitionKeys'.
   /// @param sortingOrders Sorting orders, one per sorting key.
   /// @param rowNumberColumnName Optional name of the column containing row
-  /// numbers. If not specified, the output doesn't include 'row number'
+  /// numbers or ranks. If not specified, the output doesn't include this
   /// column. This is used when computing partial results.
-  /// @param limit Per-partition limit. The number of
-  /// rows produced by this node will not exceed this value for any given
-  /// partition. Extra rows will be dropped.
+  /// @param limit Per-partition limit on the rank. For row_number() the
+  /// number of rows produced by this node will not exceed this value for any
+  /// given partition. For rank() and dense_rank() all peers of the last row
+  /// within the limit are produced as well. Extra rows will be dropped.
   TopNRowNumberNode(
       PlanNodeId id,
+      RankFunction function,
       std::vector<FieldAccessTypedExprPtr> partitionKeys,
       std::vector<FieldAccessTypedExprPtr> sortingKeys,
       std::vector<SortOrder> sortingOrders,
@@ -2610,6 +2690,25 @@ class TopNRowNumberNode : public PlanNode {
       int32_t limit,
       PlanNodePtr source);
 
+  /// Same as above with RankFunction::kRowNumber.
+  TopNRowNumberNode(
+      PlanNodeId id,
+      std::vector<FieldAccessTypedExprPtr> partitionKeys,
+      std::vector<FieldAccessTypedExprPtr> sortingKeys,
+      std::vector<SortOrder> sortingOrders,
+      const std::optional<std::string>& rowNumberColumnName,
+      int32_t limit,
+      PlanNodePtr source)
+      : TopNRowNumberNode(
+            std::move(id),
+            RankFunction::kRowNumber,
+            std::move(partitionKeys),
+            std::move(sortingKeys),
+            std::move(sortingOrders),
+            rowNumberColumnName,
+            limit,
+            std::move(source)) {}
+
   const std::vector<PlanNodePtr>& sources() const override {
     return sources_;
   }
@@ -2638,6 +2737,10 @@ class TopNRowNumberNode : public PlanNode {
     return sortingOrders_;
   }
 
+  RankFunction rankFunction() const {
+    return function_;
+  }
+
   int32_t limit() const {
     return limit_;
   }
@@ -2657,6 +2760,8 @@ class TopNRowNumberNode : public PlanNode {
  private:
   void addDetails(std::stringstream& stream) const override;
 
+  const RankFunction function_;
+
   const std::vector<FieldAccessTypedExprPtr> partitionKeys_;
 
   const std::vector<FieldAccessTypedExprPtr> sortingKeys_;
@@ -36,6 +36,13 @@ class QueryConfig {
   static constexpr const char* kQueryMaxMemoryPerNode =
       "query_max_memory_per_node";
 
+  /// The peak memory a query is expected to use on a single host, e.g. as
+  /// observed by earlier runs of the same plan. If set, the memory arbitrator
+  /// reserves this capacity for the query up front, see
+  /// MemoryArbitrator::reserveExpectedCapacity().
+  static constexpr const char* kQueryExpectedPeakMemory =
+      "query_expected_peak_memory";
+
   /// User provided session timezone. Stores a string with the actual timezone
   /// name, e.g: "America/Los_Angeles".
   static constexpr const char* kSessionTimezone = "session_timezone";
@@ -64,11 +71,51 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// Whether FilterProject reports the stats of each node of its expressions
+  /// as operator runtime stats while it runs, e.g. the CPU time, rows, input
+  /// encodings, peels, dictionary memo hits and default-null skips. Implies
+  /// kExprTrackCpuUsage. False by default.
+  static constexpr const char* kExprProfilingEnabled =
+      "expression.profiling_enabled";
+
+  /// Whether to evaluate trees of arithmetic, comparison and logical
+  /// operations over fixed-width columns as fused loops over tiles of rows,
+  /// without materializing the intermediate results as vectors. False by
+  /// default.
+  static constexpr const char* kExprFusedEvaluationEnabled =
+      "expression.fused_evaluation_enabled";
+
+  /// Whether expression compilation looks up and stores the results of
+  /// constant folding in a process-wide cache shared by all queries. The
+  /// cache is keyed on the typed expression and the query config. False by
+  /// default.
+  static constexpr const char* kExprConstantFoldingCacheEnabled =
+      "expression.constant_folding_cache_enabled";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to collect hardware performance counters, e.g. cycles and cache
+  /// misses, for the calls of individual operators. False by default. Reads
+  /// the perf events of the thread with a system call before and after each
+  /// call, so it is only meant for diagnosing slow queries. Has no effect if
+  /// the perf events are not available.
+  static constexpr const char* kOperatorTrackPerfCounters =
+      "track_operator_perf_counters";
+
+  /// Whether to record the timeline of each task: timed events of its drivers
+  /// and operator calls, spills, memory arbitration requests, cache misses,
+  /// SSD reads and exchange requests. Exported by Task::timeline() in the
+  /// Chrome trace event format. False by default.
+  static constexpr const char* kTaskTimelineEnabled = "task_timeline_enabled";
+
+  /// The max number of events recorded by the timeline of a task. Later
+  /// events are dropped and counted.
+  static constexpr const char* kTaskTimelineMaxEvents =
+      "task_timeline_max_events";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -134,6 +181,70 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Number of leading input rows whose grouping keys the partial aggregation
+  /// sketches with HyperLogLog before adding them to the hash table. If the
+  /// estimated number of groups reaches 'abandon_partial_aggregation_min_pct'
+  /// of the sampled rows, partial aggregation is abandoned right away. Else
+  /// the hash table is sized for the estimated number of groups. 0 disables
+  /// the estimate.
+  static constexpr const char* kPartialAggregationCardinalitySampleRows =
+      "partial_aggregation_cardinality_sample_rows";
+
+  /// Number of leading input batches the partial aggregation checks for being
+  /// clustered on the grouping keys. If all of them are, the partial
+  /// aggregation switches to streaming and flushes each group as soon as the
+  /// next one starts instead of holding all groups in the hash table. 0
+  /// disables the check.
+  static constexpr const char* kPartialAggregationClusteredInputCheckBatches =
+      "partial_aggregation_clustered_input_check_batches";
+
+  /// Min number of slots of an aggregation hash table in generic hash mode
+  /// that grows incrementally. The groups are moved to the larger table a few
+  /// at a time by the following input batches instead of all at once, so
+  /// that growing a large table does not stall a batch. 0 disables
+  /// incremental growth.
+  static constexpr const char* kAggregationIncrementalRehashMinEntries =
+      "aggregation_incremental_rehash_min_entries";
+
+  /// If true, an aggregation hash table whose grouping key value ids do not
+  /// fit in 64 bits may concatenate them into a 128 bit normalized key of two
+  /// words instead of hashing the keys. Each row then reserves 16 bytes for
+  /// its normalized key instead of 8.
+  static constexpr const char* kAggregationWideNormalizedKeysEnabled =
+      "aggregation_wide_normalized_keys_enabled";
+
+  /// If true, an aggregation or mark distinct hash table with a single BIGINT
+  /// grouping key whose values do not fit an array indexed by value maps the
+  /// keys to dense group ids with a BigintIdMap instead of probing a hash
+  /// table.
+  static constexpr const char* kAggregationBigintIdMapEnabled =
+      "aggregation_bigint_id_map_enabled";
+
+  /// Maximum number of bytes of input vectors that a single step hash
+  /// aggregation can retain per aggregate function so that array_agg and
+  /// map_agg accumulators reference input rows instead of copying the values.
+  /// Values are copied once, when results are produced or groups are
+  /// spilled. Input is copied as usual once the limit is reached. 0 disables
+  /// the retention.
+  static constexpr const char* kAggregationInputRetentionMaxBytes =
+      "aggregation_input_retention_max_bytes";
+
+  /// If true, a single step hash aggregation whose aggregates are all distinct
+  /// over the same inputs first de-duplicates the grouping keys and the
+  /// distinct inputs in a hash table, then aggregates the unique rows without
+  /// per-group distinct sets. Both stages can spill.
+  static constexpr const char* kTwoLevelDistinctAggregationEnabled =
+      "two_level_distinct_aggregation_enabled";
+
+  /// If true, caches the partial aggregation results of each split of a
+  /// pipeline made of a TableScan, Filter and Project nodes with deterministic
+  /// expressions and a partial aggregation with grouping keys in the
+  /// AsyncDataCache. A later query running the same fragment over an unchanged
+  /// split gets the results without reading the split. See
+  /// FragmentResultCache.
+  static constexpr const char* kFragmentResultCacheEnabled =
+      "fragment_result_cache_enabled";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -156,6 +267,15 @@ class QueryConfig {
   /// OutputBufferManager::kContinuePct % of this.
   static constexpr const char* kMaxOutputBufferSize = "max_output_buffer_size";
 
+  /// The maximum size in bytes of the task's buffered output that is spilled
+  /// to the task's spill directory. Once the buffered size in memory exceeds
+  /// kMaxOutputBufferSize, the oldest pages are written to disk and read back
+  /// when the consumers fetch them, so that slow consumers do not block the
+  /// producers until this much is also spilled. 0 disables spilling of the
+  /// output buffer.
+  static constexpr const char* kMaxOutputBufferSpillSize =
+      "max_output_buffer_spill_size";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -175,6 +295,14 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// The query memory usage ratio above which HashProbe, MergeJoin and Unnest
+  /// shrink their output batches. The batch size is scaled down linearly with
+  /// the remaining headroom of the query memory pool, down to 1/16 of the
+  /// normal size, and it grows back once the usage drops below the ratio. The
+  /// value is in the range of [0, 1]; 0 disables the adjustment.
+  static constexpr const char* kMemoryPressureBatchSizingThreshold =
+      "memory_pressure_batch_sizing_threshold";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
@@ -216,6 +344,10 @@ class QueryConfig {
   static constexpr const char* kRowNumberSpillEnabled =
       "row_number_spill_enabled";
 
+  /// MarkDistinct spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMarkDistinctSpillEnabled =
+      "mark_distinct_spill_enabled";
+
   /// TopNRowNumber spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
@@ -248,6 +380,12 @@ class QueryConfig {
   static constexpr const char* kSpillCompressionKind =
       "spill_compression_codec";
 
+  /// If not zero and the spill compression codec is zstd, each spill writer
+  /// trains a zstd dictionary of up to this many bytes from the first write
+  /// buffer it spills, and compresses the later ones with it.
+  static constexpr const char* kSpillCompressionDictionarySize =
+      "spill_compression_dictionary_size";
+
   /// Enable the prefix sort or fallback to timsort in spill. The prefix sort is
   /// faster than std::sort but requires the memory to build normalized prefix
   /// keys, which might have potential risk of running out of server memory.
@@ -266,12 +404,35 @@ class QueryConfig {
   /// buffering, which doubles the buffer used to read from each spill file.
   static constexpr const char* kSpillReadBufferSize = "spill_read_buffer_size";
 
+  /// The number of read buffers to read ahead for each spill file when
+  /// restoring sorted spill runs with a merge. If zero, a spill file reads one
+  /// buffer ahead only if the file system supports async read. Otherwise, if
+  /// the file system has no async read, the reads ahead run on the spill
+  /// executor.
+  static constexpr const char* kSpillReadAheadBuffers =
+      "spill_read_ahead_buffers";
+
+  /// If true, the spill writer serializes and compresses the next write buffer
+  /// while the previous one is written to disk on the spill executor. This
+  /// doubles the write buffer memory used by each spill partition. It has no
+  /// effect if the query has no spill executor.
+  static constexpr const char* kSpillAsyncWriteEnabled =
+      "spill_async_write_enabled";
+
   /// Config used to create spill files. This config is provided to underlying
   /// file system and the config is free form. The form should be defined by the
   /// underlying file system.
   static constexpr const char* kSpillFileCreateConfig =
       "spill_file_create_config";
 
+  /// The minimum free bytes of a local disk for it to take new spill files if
+  /// the task has spill directories on multiple disks. If all the disks are
+  /// below it, the spill files go to the overflow spill directory of the task
+  /// if it has one. The default of zero places the spill files round-robin
+  /// across the disks regardless of their free space.
+  static constexpr const char* kSpillDirectoryMinFreeBytes =
+      "spill_directory_min_free_bytes";
+
   /// Default offset spill start partition bit. It is used with
   /// 'kJoinSpillPartitionBits' or 'kAggregationSpillPartitionBits' together to
   /// calculate the spilling partition number for join spill or aggregation
@@ -351,6 +512,59 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The target size in bytes of a radix partition of a hash join table. If
+  /// the join table is larger, its buckets are split into cache sized
+  /// partitions and both build inserts and probe lookups are reordered by
+  /// partition. 0 disables radix partitioning.
+  static constexpr const char* kHashJoinRadixPartitionTargetBytes =
+      "hash_join_radix_partition_target_bytes";
+
+  /// The max size in bytes of a Bloom filter made over the integral join keys
+  /// of a hash join build side. The Bloom filter is pushed down as a dynamic
+  /// filter into the probe side table scan when the build keys are too many
+  /// for an exact value list filter. 0 disables the Bloom filters.
+  static constexpr const char* kHashJoinBloomFilterMaxBytes =
+      "hash_join_bloom_filter_max_bytes";
+
+  /// The max number of probe side rows an inner hash join without a filter
+  /// buffers while waiting for the build side. If the whole probe side fits
+  /// and the build side has received at least
+  /// 'hash_join_adaptive_swap_min_build_ratio' times more rows before it
+  /// finishes, the join swaps the sides: the probe side rows are built into
+  /// the table and the build side rows stream through it. 0 disables the
+  /// swap. Not used if spilling is enabled for the join.
+  static constexpr const char* kHashJoinAdaptiveSwapMaxProbeRows =
+      "hash_join_adaptive_swap_max_probe_rows";
+
+  /// The min ratio of the build side to the probe side rows for the adaptive
+  /// hash join side swap.
+  static constexpr const char* kHashJoinAdaptiveSwapMinBuildRatio =
+      "hash_join_adaptive_swap_min_build_ratio";
+
+  /// Identifies the inputs of the hash join build sides of a query, e.g. a
+  /// snapshot of the dimension tables they read. If set and the process wide
+  /// exec::HashTableCache exists, the join tables built by the query are
+  /// shared with other queries that set the same value and have the same build
+  /// side plan. The application must change the value when the build inputs
+  /// change. Joins that update the table while probing, i.e. right, full and
+  /// right semi joins, and null-aware joins are not shared. Joins with a shared
+  /// table do not spill.
+  static constexpr const char* kHashTableCacheKey = "hash_table_cache_key";
+
+  /// The maximum number of input batches an index lookup join buffers to look
+  /// up with one request to the index source. The keys of the buffered batches
+  /// are deduplicated before the lookup and the results are mapped back to the
+  /// input rows. 0 looks up each input batch on its own.
+  static constexpr const char* kIndexLookupJoinMaxBatchedInputs =
+      "index_lookup_join_max_batched_inputs";
+
+  /// The maximum number of distinct lookup keys whose results an index lookup
+  /// join keeps to serve repeated keys of later input batches without a
+  /// lookup. Only used if 'index_lookup_join_max_batched_inputs' is set. 0
+  /// disables the cache.
+  static constexpr const char* kIndexLookupJoinCacheMaxKeys =
+      "index_lookup_join_cache_max_keys";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -374,16 +588,53 @@ class QueryConfig {
   static constexpr const char* kMaxSharedSubexprResultsCached =
       "max_shared_subexpr_results_cached";
 
+  /// Maximum number of dictionary bases per expression set to keep memoized
+  /// results for after the input moves on to another base. Lets expressions
+  /// over dictionary encoded inputs reuse results when a base comes back in a
+  /// later batch or split. 0 disables this and keeps results only for the
+  /// current base. Requires dictionary memoization, i.e.
+  /// kEnableExpressionEvaluationCache.
+  static constexpr const char* kMaxMemoizedDictionaries =
+      "max_memoized_dictionaries";
+
+  /// If true, a map that is subscripted by more than one expression in one
+  /// evaluation of an expression set gets a hash index over the keys of all
+  /// its rows. The index is built once and shared by the subscript and
+  /// element_at expressions that read the map, replacing a linear scan of the
+  /// keys per row and expression.
+  static constexpr const char* kMapSubscriptKeyIndexEnabled =
+      "map_subscript_key_index_enabled";
+
   /// Maximum number of splits to preload. Set to 0 to disable preloading.
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// Maximum number of queued splits per driver, after the preloaded ones,
+  /// whose files are opened in the background on the connector's executor.
+  /// Opening a file is much cheaper than preloading a split, so this can look
+  /// further ahead in the split queue. Set to 0 to disable.
+  static constexpr const char* kMaxSplitPreopenPerDriver =
+      "max_split_preopen_per_driver";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// The priority class of the drivers of the query: 'interactive', 'default'
+  /// or 'batch'. A DriverExecutor shares its threads between the classes in
+  /// proportion to their weights, and preempts the drivers of a lower class
+  /// while drivers of a higher class are queued.
+  static constexpr const char* kDriverPriorityClass = "driver_priority_class";
+
+  /// If true, the drivers of each pipeline of a task are created in parallel
+  /// on the query executor instead of one after the other on the thread that
+  /// starts the task. Operators made by custom plan node translators must
+  /// then be safe to construct concurrently.
+  static constexpr const char* kParallelDriverCreationEnabled =
+      "parallel_driver_creation_enabled";
+
   /// Maximum number of bytes to use for the normalized key in prefix-sort. Use
   /// 0 to disable prefix-sort.
   static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
@@ -398,6 +649,33 @@ class QueryConfig {
   static constexpr const char* kPrefixSortMaxStringPrefixLength =
       "prefixsort_max_string_prefix_length";
 
+  /// Maximum number of bytes to be stored in prefix-sort buffer for a string
+  /// key whose sampled values often tie on the first
+  /// 'prefixsort_max_string_prefix_length' bytes. String keys no longer than
+  /// this are stored whole, so the following keys are stored as well. Not
+  /// larger than 'prefixsort_max_string_prefix_length' disables the longer
+  /// prefixes.
+  static constexpr const char* kPrefixSortMaxAdaptiveStringPrefixLength =
+      "prefixsort_max_adaptive_string_prefix_length";
+
+  /// Minimum number of rows to sort with radix sort instead of quick-sort in
+  /// prefix-sort. Radix sort is only used if all the sort keys are stored
+  /// whole in the prefix-sort buffer. 0 disables radix sort.
+  static constexpr const char* kPrefixSortMinRadixSortRows =
+      "prefixsort_min_radix_sort_rows";
+
+  /// Maximum number of runs an OrderBy splits its in-memory rows into. The
+  /// runs are sorted in parallel on the query executor and then merged. Each
+  /// run has at least 16K rows. 1 sorts all rows on the driver thread.
+  static constexpr const char* kOrderByParallelSortRuns =
+      "order_by_parallel_sort_runs";
+
+  /// If true, TopN pushes down a range filter on its first sorting key to the
+  /// table scan once it holds 'count' rows. The filter only passes the rows
+  /// that can still enter the top rows and is tightened as they improve.
+  static constexpr const char* kTopNDynamicFilterEnabled =
+      "topn_dynamic_filter_enabled";
+
   /// Enable query tracing flag.
   static constexpr const char* kQueryTraceEnabled = "query_trace_enabled";
 
@@ -482,6 +760,14 @@ class QueryConfig {
   static constexpr const char* kScaleWriterMinProcessedBytesRebalanceThreshold =
       "scaled_writer_min_processed_bytes_rebalance_threshold";
 
+  /// Minimum amount of data of a logical table partition that scale writer
+  /// exchange sends to one of the writers assigned to the partition before it
+  /// moves on to the next one. This bounds from below the size of the files
+  /// that a partition scaled to multiple writers leaves on each writer. 0
+  /// spreads each input across all the assigned writers.
+  static constexpr const char* kScaleWriterMinPartitionWriterBytes =
+      "scaled_writer_min_partition_writer_bytes";
+
   /// If true, enables the scaled table scan processing. For each table scan
   /// plan node, a scan controller is used to control the number of running scan
   /// threads based on the query memory usage. It keeps increasing the number of
@@ -500,11 +786,52 @@ class QueryConfig {
   static constexpr const char* kTableScanScaleUpMemoryUsageRatio =
       "table_scan_scale_up_memory_usage_ratio";
 
+  /// If true, enables the scaled processing of the pipelines that receive data
+  /// from a remote exchange. Such a pipeline starts with one running driver. A
+  /// pipeline controller starts more drivers while the running ones are CPU
+  /// bound and parks drivers while the downstream consumers of the pipeline
+  /// are not keeping up.
+  static constexpr const char* kPipelineScaledProcessingEnabled =
+      "pipeline_scaled_processing_enabled";
+
   /// Specifies the shuffle compression kind which is defined by
   /// CompressionKind. If it is CompressionKind_NONE, then no compression.
   static constexpr const char* kShuffleCompressionKind =
       "shuffle_compression_codec";
 
+  /// Network bandwidth in bytes per second available to the shuffle. If not
+  /// 0, PartitionedOutput stops compressing pages, with a back-off, when the
+  /// time spent compressing a page is more than the transfer time it saves.
+  /// 0 means the bandwidth is unknown and only the compression ratio is
+  /// considered.
+  static constexpr const char* kShuffleCompressionNetworkBandwidth =
+      "shuffle_compression_network_bandwidth";
+
+  /// If true, PartitionedOutput hands the output vectors to the consumers
+  /// instead of serializing them. This only works when all the consumers run
+  /// in the same process as the producer and fetch the output through an
+  /// in-process exchange source.
+  static constexpr const char* kInProcessShuffleEnabled =
+      "in_process_shuffle_enabled";
+
+  /// If true, PartitionedOutput serializes the rows of each input batch with
+  /// the Presto batch serializer, which keeps dictionary and constant
+  /// encodings, instead of flattening them. Only applies to the Presto serde.
+  static constexpr const char* kShufflePreserveEncodings =
+      "shuffle_preserve_encodings";
+
+  /// Minimum amount of data sent to a skewed partition to spread it over more
+  /// destinations if PartitionedOutput detects it as overloaded. Only applies
+  /// to a PartitionedOutput in the skewed partition mode SPREAD.
+  static constexpr const char*
+      kShuffleSkewedPartitionMinProcessedBytesRebalanceThreshold =
+          "shuffle_skewed_partition_min_processed_bytes_rebalance_threshold";
+
+  /// Minimum amount of data sent to all destinations between two checks
+  /// whether to spread a skewed partition over more destinations.
+  static constexpr const char* kShuffleMinProcessedBytesRebalanceThreshold =
+      "shuffle_min_processed_bytes_rebalance_threshold";
+
   /// If a key is found in multiple given maps, by default that key's value in
   /// the resulting map comes from the last one of those maps. When true, throw
   /// exception on duplicate map key.
@@ -542,6 +869,12 @@ class QueryConfig {
         config::CapacityUnit::BYTE);
   }
 
+  uint64_t queryExpectedPeakMemory() const {
+    return config::toCapacity(
+        get<std::string>(kQueryExpectedPeakMemory, "0B"),
+        config::CapacityUnit::BYTE);
+  }
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
@@ -560,6 +893,38 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t partialAggregationCardinalitySampleRows() const {
+    return get<int32_t>(kPartialAggregationCardinalitySampleRows, 0);
+  }
+
+  uint64_t aggregationIncrementalRehashMinEntries() const {
+    return get<uint64_t>(kAggregationIncrementalRehashMinEntries, 0);
+  }
+
+  bool aggregationWideNormalizedKeysEnabled() const {
+    return get<bool>(kAggregationWideNormalizedKeysEnabled, false);
+  }
+
+  bool aggregationBigintIdMapEnabled() const {
+    return get<bool>(kAggregationBigintIdMapEnabled, false);
+  }
+
+  uint64_t aggregationInputRetentionMaxBytes() const {
+    return get<uint64_t>(kAggregationInputRetentionMaxBytes, 0);
+  }
+
+  bool twoLevelDistinctAggregationEnabled() const {
+    return get<bool>(kTwoLevelDistinctAggregationEnabled, false);
+  }
+
+  int32_t partialAggregationClusteredInputCheckBatches() const {
+    return get<int32_t>(kPartialAggregationClusteredInputCheckBatches, 0);
+  }
+
+  bool fragmentResultCacheEnabled() const {
+    return get<bool>(kFragmentResultCacheEnabled, false);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -588,6 +953,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxOutputBufferSize, kDefault);
   }
 
+  uint64_t maxOutputBufferSpillSize() const {
+    return get<uint64_t>(kMaxOutputBufferSpillSize, 0);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
@@ -632,6 +1001,17 @@ class QueryConfig {
     return maxBatchRows;
   }
 
+  double memoryPressureBatchSizingThreshold() const {
+    const auto threshold =
+        get<double>(kMemoryPressureBatchSizingThreshold, 0.0);
+    VELOX_USER_CHECK(
+        threshold >= 0 && threshold <= 1,
+        "{} must be in the range of [0, 1]: {}",
+        kMemoryPressureBatchSizingThreshold,
+        threshold);
+    return threshold;
+  }
+
   uint32_t tableScanGetOutputTimeLimitMs() const {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
@@ -710,6 +1090,10 @@ class QueryConfig {
     return get<bool>(kRowNumberSpillEnabled, true);
   }
 
+  bool markDistinctSpillEnabled() const {
+    return get<bool>(kMarkDistinctSpillEnabled, true);
+  }
+
   bool topNRowNumberSpillEnabled() const {
     return get<bool>(kTopNRowNumberSpillEnabled, true);
   }
@@ -743,6 +1127,10 @@ class QueryConfig {
     return get<std::string>(kSpillCompressionKind, "none");
   }
 
+  uint32_t spillCompressionDictionarySize() const {
+    return get<uint32_t>(kSpillCompressionDictionarySize, 0);
+  }
+
   bool spillPrefixSortEnabled() const {
     return get<bool>(kSpillPrefixSortEnabled, false);
   }
@@ -757,10 +1145,22 @@ class QueryConfig {
     return get<uint64_t>(kSpillReadBufferSize, 1L << 20);
   }
 
+  uint32_t spillReadAheadBuffers() const {
+    return get<uint32_t>(kSpillReadAheadBuffers, 0);
+  }
+
+  bool spillAsyncWriteEnabled() const {
+    return get<bool>(kSpillAsyncWriteEnabled, false);
+  }
+
   std::string spillFileCreateConfig() const {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
 
+  uint64_t spillDirectoryMinFreeBytes() const {
+    return get<uint64_t>(kSpillDirectoryMinFreeBytes, 0);
+  }
+
   int32_t minSpillableReservationPct() const {
     constexpr int32_t kDefaultPct = 5;
     return get<int32_t>(kMinSpillableReservationPct, kDefaultPct);
@@ -841,10 +1241,34 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  bool exprProfilingEnabled() const {
+    return get<bool>(kExprProfilingEnabled, false);
+  }
+
+  bool exprFusedEvaluationEnabled() const {
+    return get<bool>(kExprFusedEvaluationEnabled, false);
+  }
+
+  bool exprConstantFoldingCacheEnabled() const {
+    return get<bool>(kExprConstantFoldingCacheEnabled, false);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackPerfCounters() const {
+    return get<bool>(kOperatorTrackPerfCounters, false);
+  }
+
+  bool taskTimelineEnabled() const {
+    return get<bool>(kTaskTimelineEnabled, false);
+  }
+
+  uint64_t taskTimelineMaxEvents() const {
+    return get<uint64_t>(kTaskTimelineMaxEvents, 1'000'000);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -862,6 +1286,34 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint64_t hashJoinRadixPartitionTargetBytes() const {
+    return get<uint64_t>(kHashJoinRadixPartitionTargetBytes, 0);
+  }
+
+  uint64_t hashJoinBloomFilterMaxBytes() const {
+    return get<uint64_t>(kHashJoinBloomFilterMaxBytes, 0);
+  }
+
+  uint64_t hashJoinAdaptiveSwapMaxProbeRows() const {
+    return get<uint64_t>(kHashJoinAdaptiveSwapMaxProbeRows, 0);
+  }
+
+  double hashJoinAdaptiveSwapMinBuildRatio() const {
+    return get<double>(kHashJoinAdaptiveSwapMinBuildRatio, 10.0);
+  }
+
+  std::string hashTableCacheKey() const {
+    return get<std::string>(kHashTableCacheKey, "");
+  }
+
+  uint32_t indexLookupJoinMaxBatchedInputs() const {
+    return get<uint32_t>(kIndexLookupJoinMaxBatchedInputs, 0);
+  }
+
+  uint32_t indexLookupJoinCacheMaxKeys() const {
+    return get<uint32_t>(kIndexLookupJoinCacheMaxKeys, 0);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -886,14 +1338,34 @@ class QueryConfig {
     return get<uint32_t>(kMaxSharedSubexprResultsCached, 10);
   }
 
+  uint32_t maxMemoizedDictionaries() const {
+    return get<uint32_t>(kMaxMemoizedDictionaries, 0);
+  }
+
+  bool mapSubscriptKeyIndexEnabled() const {
+    return get<bool>(kMapSubscriptKeyIndexEnabled, true);
+  }
+
   int32_t maxSplitPreloadPerDriver() const {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  int32_t maxSplitPreopenPerDriver() const {
+    return get<int32_t>(kMaxSplitPreopenPerDriver, 0);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  std::string driverPriorityClass() const {
+    return get<std::string>(kDriverPriorityClass, "default");
+  }
+
+  bool parallelDriverCreationEnabled() const {
+    return get<bool>(kParallelDriverCreationEnabled, false);
+  }
+
   uint32_t prefixSortNormalizedKeyMaxBytes() const {
     return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
   }
@@ -906,6 +1378,22 @@ class QueryConfig {
     return get<uint32_t>(kPrefixSortMaxStringPrefixLength, 16);
   }
 
+  uint32_t prefixSortMaxAdaptiveStringPrefixLength() const {
+    return get<uint32_t>(kPrefixSortMaxAdaptiveStringPrefixLength, 0);
+  }
+
+  uint32_t prefixSortMinRadixSortRows() const {
+    return get<uint32_t>(kPrefixSortMinRadixSortRows, 64 << 10);
+  }
+
+  uint32_t orderByParallelSortRuns() const {
+    return get<uint32_t>(kOrderByParallelSortRuns, 1);
+  }
+
+  bool topNDynamicFilterEnabled() const {
+    return get<bool>(kTopNDynamicFilterEnabled, true);
+  }
+
   double scaleWriterRebalanceMaxMemoryUsageRatio() const {
     return get<double>(kScaleWriterRebalanceMaxMemoryUsageRatio, 0.7);
   }
@@ -924,6 +1412,10 @@ class QueryConfig {
         kScaleWriterMinProcessedBytesRebalanceThreshold, 256 << 20);
   }
 
+  uint64_t scaleWriterMinPartitionWriterBytes() const {
+    return get<uint64_t>(kScaleWriterMinPartitionWriterBytes, 0);
+  }
+
   bool tableScanScaledProcessingEnabled() const {
     return get<bool>(kTableScanScaledProcessingEnabled, false);
   }
@@ -932,10 +1424,35 @@ class QueryConfig {
     return get<double>(kTableScanScaleUpMemoryUsageRatio, 0.7);
   }
 
+  bool pipelineScaledProcessingEnabled() const {
+    return get<bool>(kPipelineScaledProcessingEnabled, false);
+  }
+
   std::string shuffleCompressionKind() const {
     return get<std::string>(kShuffleCompressionKind, "none");
   }
 
+  uint64_t shuffleCompressionNetworkBandwidth() const {
+    return get<uint64_t>(kShuffleCompressionNetworkBandwidth, 0);
+  }
+
+  bool inProcessShuffleEnabled() const {
+    return get<bool>(kInProcessShuffleEnabled, false);
+  }
+
+  bool shufflePreserveEncodings() const {
+    return get<bool>(kShufflePreserveEncodings, false);
+  }
+
+  uint64_t shuffleSkewedPartitionMinProcessedBytesRebalanceThreshold() const {
+    return get<uint64_t>(
+        kShuffleSkewedPartitionMinProcessedBytesRebalanceThreshold, 32 << 20);
+  }
+
+  uint64_t shuffleMinProcessedBytesRebalanceThreshold() const {
+    return get<uint64_t>(kShuffleMinProcessedBytesRebalanceThreshold, 64 << 20);
+  }
+
   bool throwExceptionOnDuplicateMapKeys() const {
     return get<bool>(kThrowExceptionOnDuplicateMapKeys, false);
   }
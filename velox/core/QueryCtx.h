@@ -20,6 +20,7 @@
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/memory/Scratch.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorPool.h"
@@ -199,6 +200,11 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
     if (pool_ == nullptr) {
       pool_ = memory::memoryManager()->addRootPool(
           QueryCtx::generatePoolName(queryId), memory::kMaxMemory);
+      const auto expectedPeakBytes = queryConfig_.queryExpectedPeakMemory();
+      if (expectedPeakBytes > 0) {
+        memory::memoryManager()->arbitrator()->reserveExpectedCapacity(
+            pool_.get(), expectedPeakBytes);
+      }
     }
   }
 
@@ -259,6 +265,10 @@ class ExecCtx {
           !queryConfig.debugDisableExpressionsWithLazyInputs();
       maxSharedSubexprResultsCached =
           queryConfig.maxSharedSubexprResultsCached();
+      maxMemoizedDictionaries = dictionaryMemoizationEnabled
+          ? queryConfig.maxMemoizedDictionaries()
+          : 0;
+      mapSubscriptKeyIndexEnabled = queryConfig.mapSubscriptKeyIndexEnabled();
     }
 
     /// True if caches in expression evaluation used for performance are
@@ -281,6 +291,12 @@ class ExecCtx {
     /// The maximum number of distinct inputs to cache results in a
     /// given shared subexpression during experssion evaluation.
     uint32_t maxSharedSubexprResultsCached;
+    /// The maximum number of dictionary bases per expression set to keep
+    /// memoized results for after the input moves on to another base.
+    uint32_t maxMemoizedDictionaries;
+    /// True if maps subscripted by multiple expressions get a shared hash
+    /// index over their keys during expression evaluation.
+    bool mapSubscriptKeyIndexEnabled;
   };
 
   velox::memory::MemoryPool* pool() const {
@@ -386,6 +402,22 @@ class ExecCtx {
     return 0;
   }
 
+  /// Returns the reusable scratch areas for transient buffers of expression
+  /// evaluation, e.g. row number mappings that do not outlive a function call.
+  /// Lease them with ScratchPtr, which returns the area on scope exit, so that
+  /// the same few areas serve all the batches evaluated by this thread.
+  Scratch& scratch() {
+    return scratch_;
+  }
+
+  /// Frees the scratch areas if they retain more than 'maxBytes'. Called at
+  /// the end of a batch to drop areas grown by an outlier batch.
+  void maybeTrimScratch(int64_t maxBytes) {
+    if (scratch_.retainedSize() > maxBytes) {
+      scratch_.trim();
+    }
+  }
+
   const OptimizationParams& optimizationParams() const {
     return optimizationParams_;
   }
@@ -403,6 +435,8 @@ class ExecCtx {
   // and operators.
   std::vector<std::unique_ptr<SelectivityVector>> selectivityVectorPool_;
   std::unique_ptr<VectorPool> vectorPool_;
+  // Scratch areas for transient state of expression evaluation.
+  Scratch scratch_;
 };
 
 } // namespace facebook::velox::core
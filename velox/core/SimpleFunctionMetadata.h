@@ -17,6 +17,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <folly/Likely.h>
+#include <folly/Range.h>
 #include <optional>
 
 #include "velox/common/base/Exceptions.h"
@@ -694,6 +695,7 @@ class UDFHolder {
   DECLARE_METHOD_RESOLVER(callNullable_method_resolver, callNullable);
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
+  DECLARE_METHOD_RESOLVER(callBatch_method_resolver, callBatch);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
 
   // Check which flavor of the call()/callNullable()/callNullFree() method is
@@ -713,6 +715,7 @@ class UDFHolder {
   // Optionally, UDFs can also provide the following methods:
   //
   // - bool|void callAscii(...)
+  // - void callBatch(folly::Range<out*>, folly::Range<const in*>...)
   // - void initialize(...)
 
   // call():
@@ -819,6 +822,17 @@ class UDFHolder {
       const exec_arg_type<TArgs>&...>::value;
   static constexpr bool udf_has_callAscii =
       udf_has_callAscii_return_bool | udf_has_callAscii_return_void;
+
+  // callBatch(): computes results for consecutive rows of flat, null-free
+  // fixed-width inputs in one call so that the loop can be vectorized. Must
+  // give the same results as call() on each row and cannot fail or return
+  // null. 'out' may alias an input of the same type.
+  static constexpr bool udf_has_callBatch = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      void,
+      folly::Range<exec_return_type*>,
+      folly::Range<const exec_arg_type<TArgs>*>...>::value;
   static_assert(
       !(udf_has_callAscii_return_bool && udf_has_callAscii_return_void),
       "Provided callAscii() methods need to return either void OR bool.");
@@ -978,6 +992,17 @@ class UDFHolder {
     }
   }
 
+  FOLLY_ALWAYS_INLINE void callBatch(
+      folly::Range<exec_return_type*> out,
+      folly::Range<const exec_arg_type<TArgs>*>... args) {
+    if constexpr (udf_has_callBatch) {
+      instance_.callBatch(out, args...);
+    } else {
+      VELOX_UNREACHABLE(
+          "callBatch should never be called if the UDF does not implement callBatch.");
+    }
+  }
+
   FOLLY_ALWAYS_INLINE Status callNullFree(
       exec_return_type& out,
       bool& notNull,
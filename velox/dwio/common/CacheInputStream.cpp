@@ -252,6 +252,7 @@ void CacheInputStream::loadSync(const Region& region) {
       input_->read(ranges, region.offset, LogType::FILE);
     }
     ioStats_->read().increment(region.length);
+    ioStats_->storageReadLatency().record(storageReadUs);
     ioStats_->queryThreadIoLatency().increment(storageReadUs);
     ioStats_->incTotalScanTime(storageReadUs * 1'000);
     entry->setExclusiveToShared(!noCacheRetention_);
@@ -318,6 +319,7 @@ bool CacheInputStream::loadFromSsd(
   VELOX_CHECK(pin_.empty());
   pin_ = std::move(pins[0]);
   ioStats_->ssdRead().increment(region.length);
+  ioStats_->ssdReadLatency().record(ssdLoadUs);
   ioStats_->queryThreadIoLatency().increment(ssdLoadUs);
   // Skip no-cache retention setting as data is loaded from ssd.
   entry.setExclusiveToShared();
@@ -338,6 +340,8 @@ void CacheInputStream::loadPosition() {
     auto load = bufferedInput_->coalescedLoad(this);
     if (load != nullptr) {
       folly::SemiFuture<bool> waitFuture(false);
+      const bool prefetched =
+          load->state() == cache::CoalescedLoad::State::kLoaded;
       uint64_t loadUs{0};
       {
         MicrosecondTimer timer(&loadUs);
@@ -352,6 +356,11 @@ void CacheInputStream::loadPosition() {
         }
       }
       ioStats_->queryThreadIoLatency().increment(loadUs);
+      if (prefetched) {
+        ioStats_->prefetchHit().increment(load->size());
+      } else {
+        ioStats_->prefetchMissWait().increment(loadUs);
+      }
     }
 
     const auto nextLoadRegion = nextQuantizedLoadRegion(position_);
@@ -17,6 +17,7 @@
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DECLARE_int32(cache_prefetch_min_pct);
@@ -47,6 +48,16 @@ std::unique_ptr<SeekableInputStream> CachedBufferedInput::enqueue(
     id = TrackingId(sid->getId());
   }
   VELOX_CHECK_LE(region.offset + region.length, fileSize_);
+  // A memory mapped file is read in place. The bytes are held by the page
+  // cache and take no space in 'cache_'.
+  const auto mapped =
+      input_->getReadFile()->mappedRange(region.offset, region.length);
+  if (!mapped.empty()) {
+    ioStats_->incRawBytesRead(mapped.size());
+    ioStats_->read().increment(mapped.size());
+    return std::make_unique<SeekableArrayInputStream>(
+        mapped.data(), mapped.size());
+  }
   requests_.emplace_back(
       RawFileCacheKey{fileNum_, region.offset}, region.length, id);
   if (tracker_ != nullptr) {
@@ -238,7 +249,7 @@ std::vector<int32_t> CachedBufferedInput::groupRequests(
   if (requests.empty() || (requests.size() < 2 && !prefetch)) {
     return {};
   }
-  const int32_t maxDistance = kSsd ? 20000 : options_.maxCoalesceDistance();
+  const int32_t maxDistance = kSsd ? 20000 : maxCoalesceDistance();
 
   // Combine adjacent short reads.
   int64_t coalescedBytes = 0;
@@ -369,10 +380,12 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
       std::vector<CacheRequest*> requests,
-      int32_t maxCoalesceDistance)
+      int32_t maxCoalesceDistance,
+      IoLatencyModel* latencyModel)
       : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)),
         input_(std::move(input)),
-        maxCoalesceDistance_(maxCoalesceDistance) {}
+        maxCoalesceDistance_(maxCoalesceDistance),
+        latencyModel_(latencyModel) {}
 
   std::vector<CachePin> loadData(bool prefetch) override {
     std::vector<CachePin> pins;
@@ -399,7 +412,22 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          uint64_t usecs = 0;
+          {
+            MicrosecondTimer timer(&usecs);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          if (ioStats_ != nullptr) {
+            ioStats_->storageReadLatency().record(usecs);
+          }
+          if (latencyModel_ == nullptr) {
+            return;
+          }
+          uint64_t bytes = 0;
+          for (const auto& buffer : buffers) {
+            bytes += buffer.size();
+          }
+          latencyModel_->recordRead(bytes, usecs);
         });
     updateStats(stats, prefetch, false);
     return pins;
@@ -407,6 +435,7 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
 
   std::shared_ptr<ReadFileInputStream> input_;
   const int32_t maxCoalesceDistance_;
+  IoLatencyModel* const latencyModel_;
 };
 
 // Represents a CoalescedLoad from local SSD cache.
@@ -436,7 +465,15 @@ class SsdLoad : public DwioCoalescedLoadBase {
       return pins;
     }
     assert(!ssdPins.empty()); // for lint.
-    const auto stats = ssdPins[0].file()->load(ssdPins, pins);
+    uint64_t usecs = 0;
+    CoalesceIoStats stats;
+    {
+      MicrosecondTimer timer(&usecs);
+      stats = ssdPins[0].file()->load(ssdPins, pins);
+    }
+    if (ioStats_ != nullptr) {
+      ioStats_->ssdReadLatency().record(usecs);
+    }
     updateStats(stats, prefetch, true);
     return pins;
   }
@@ -461,7 +498,8 @@ void CachedBufferedInput::readRegion(
         ioStats_,
         groupId_,
         requests,
-        options_.maxCoalesceDistance());
+        maxCoalesceDistance(),
+        latencyModel_);
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
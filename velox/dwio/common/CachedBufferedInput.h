@@ -26,6 +26,7 @@
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/CacheInputStream.h"
 #include "velox/dwio/common/InputStream.h"
+#include "velox/dwio/common/IoLatencyModel.h"
 
 DECLARE_int32(cache_load_quantum);
 
@@ -79,7 +80,11 @@ class CachedBufferedInput : public BufferedInput {
         fsStats_(std::move(fsStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {
+        options_(readerOptions),
+        latencyModel_(
+            readerOptions.adaptiveCoalescing()
+                ? IoLatencyModel::forPath(input_->getName())
+                : nullptr) {
     checkLoadQuantum();
   }
 
@@ -102,7 +107,11 @@ class CachedBufferedInput : public BufferedInput {
         fsStats_(std::move(fsStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {
+        options_(readerOptions),
+        latencyModel_(
+            readerOptions.adaptiveCoalescing()
+                ? IoLatencyModel::forPath(input_->getName())
+                : nullptr) {
     checkLoadQuantum();
   }
 
@@ -198,6 +207,15 @@ class CachedBufferedInput : public BufferedInput {
   template <bool kSsd>
   void makeLoads(std::vector<CacheRequest*> requests[2]);
 
+  // Returns the max distance between storage reads to coalesce. Tuned to the
+  // file system if adaptive coalescing is on.
+  int32_t maxCoalesceDistance() const {
+    return latencyModel_ == nullptr
+        ? options_.maxCoalesceDistance()
+        : latencyModel_->coalesceDistance(
+              options_.maxCoalesceDistance(), options_.loadQuantum());
+  }
+
   // We only support up to 8MB load quantum size on SSD and there is no need for
   // larger SSD read size performance wise.
   void checkLoadQuantum() {
@@ -218,6 +236,8 @@ class CachedBufferedInput : public BufferedInput {
   folly::Executor* const executor_;
   const uint64_t fileSize_;
   const io::ReaderOptions options_;
+  // Model of the file system for adaptive coalescing, nullptr if off.
+  IoLatencyModel* const latencyModel_;
 
   // Regions that are candidates for loading.
   std::vector<CacheRequest> requests_;
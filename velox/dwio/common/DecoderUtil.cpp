@@ -29,6 +29,32 @@ int32_t nonNullRowsFromDense(
   nonNullRows.resize(size);
   return size;
 }
+void fillRowNumbers(int64_t offset, RowSet rows, int64_t* values) {
+  constexpr int32_t kWidth = xsimd::batch<int64_t>::size;
+  const int32_t numRows = rows.size();
+  int32_t i = 0;
+  if (numRows > 0 && rows.back() - rows[0] == numRows - 1) {
+    auto numbers = simd::iota<int64_t>() + (offset + rows[0]);
+    const auto increment = simd::setAll<int64_t>(kWidth);
+    for (; i + kWidth <= numRows; i += kWidth) {
+      numbers.store_unaligned(values + i);
+      numbers += increment;
+    }
+  } else {
+    constexpr int32_t kStep = xsimd::batch<int32_t>::size;
+    const auto offsets = simd::setAll<int64_t>(offset);
+    for (; i + kStep <= numRows; i += kStep) {
+      const auto batch = xsimd::load_unaligned(rows.data() + i);
+      (simd::getHalf<int64_t, 0>(batch) + offsets).store_unaligned(values + i);
+      (simd::getHalf<int64_t, 1>(batch) + offsets)
+          .store_unaligned(values + i + kWidth);
+    }
+  }
+  for (; i < numRows; ++i) {
+    values[i] = offset + rows[i];
+  }
+}
+
 // Returns 8 bits starting at bit 'index'.
 uint8_t load8Bits(const uint64_t* bits, int32_t index) {
   uint8_t shift = index & 7;
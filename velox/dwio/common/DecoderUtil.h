@@ -362,6 +362,11 @@ void fixedWidthScan(
       });
 }
 
+// Sets 'values[i]' to 'offset + rows[i]' for all 'rows', e.g. to produce the
+// row numbers of the rows read from a file. Consecutive rows are filled without
+// reading 'rows'.
+void fillRowNumbers(int64_t offset, RowSet rows, int64_t* values);
+
 int32_t nonNullRowsFromDense(
     const uint64_t* nulls,
     int32_t numRows,
@@ -26,6 +26,7 @@
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/CacheInputStream.h"
 #include "velox/dwio/common/InputStream.h"
+#include "velox/dwio/common/IoLatencyModel.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -55,12 +56,14 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
       uint64_t groupId,
       const std::vector<LoadRequest*>& requests,
       memory::MemoryPool& pool,
-      int32_t loadQuantum)
+      int32_t loadQuantum,
+      IoLatencyModel* latencyModel = nullptr)
       : CoalescedLoad({}, {}),
         ioStats_(ioStats),
         groupId_(groupId),
         input_(std::move(input)),
         loadQuantum_(loadQuantum),
+        latencyModel_(latencyModel),
         pool_(pool) {
     VELOX_DCHECK(
         std::is_sorted(requests.begin(), requests.end(), [](auto* x, auto* y) {
@@ -98,6 +101,8 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
   const uint64_t groupId_;
   const std::shared_ptr<ReadFileInputStream> input_;
   const int32_t loadQuantum_;
+  // Records the latency of the read if not nullptr.
+  IoLatencyModel* const latencyModel_;
   memory::MemoryPool& pool_;
   std::vector<LoadRequest> requests_;
 };
@@ -129,7 +134,11 @@ class DirectBufferedInput : public BufferedInput {
         fsStats_(std::move(fsStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions),
+        latencyModel_(
+            readerOptions.adaptiveCoalescing()
+                ? IoLatencyModel::forPath(input_->getName())
+                : nullptr) {}
 
   ~DirectBufferedInput() override {
     for (auto& load : coalescedLoads_) {
@@ -215,7 +224,11 @@ class DirectBufferedInput : public BufferedInput {
         fsStats_(std::move(fsStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions),
+        latencyModel_(
+            readerOptions.adaptiveCoalescing()
+                ? IoLatencyModel::forPath(input_->getName())
+                : nullptr) {}
 
   std::vector<int32_t> groupRequests(
       const std::vector<LoadRequest*>& requests,
@@ -235,6 +248,15 @@ class DirectBufferedInput : public BufferedInput {
       bool prefetch,
       const std::vector<int32_t>& groupEnds);
 
+  // Returns the max distance between reads to coalesce. Tuned to the file
+  // system if adaptive coalescing is on.
+  int32_t maxCoalesceDistance() const {
+    return latencyModel_ == nullptr
+        ? options_.maxCoalesceDistance()
+        : latencyModel_->coalesceDistance(
+              options_.maxCoalesceDistance(), options_.loadQuantum());
+  }
+
   const uint64_t fileNum_;
   const std::shared_ptr<cache::ScanTracker> tracker_;
   const uint64_t groupId_;
@@ -256,6 +278,8 @@ class DirectBufferedInput : public BufferedInput {
   std::vector<std::shared_ptr<cache::CoalescedLoad>> coalescedLoads_;
 
   io::ReaderOptions options_;
+  // Model of the file system for adaptive coalescing, nullptr if off.
+  IoLatencyModel* const latencyModel_;
 };
 
 } // namespace facebook::velox::dwio::common
@@ -153,6 +153,7 @@ void DirectInputStream::loadSync() {
     input_->read(ranges, loadedRegion_.offset, LogType::FILE);
   }
   ioStats_->read().increment(loadedRegion_.length);
+  ioStats_->storageReadLatency().record(usecs);
   ioStats_->queryThreadIoLatency().increment(usecs);
   ioStats_->incTotalScanTime(usecs * 1'000);
 }
@@ -164,6 +165,8 @@ void DirectInputStream::loadPosition() {
     auto load = bufferedInput_->coalescedLoad(this);
     if (load != nullptr) {
       folly::SemiFuture<bool> waitFuture(false);
+      const bool prefetched =
+          load->state() == cache::CoalescedLoad::State::kLoaded;
       uint64_t loadUs = 0;
       {
         MicrosecondTimer timer(&loadUs);
@@ -174,6 +177,11 @@ void DirectInputStream::loadPosition() {
         loadedRegion_.length = load->getData(region_.offset, data_, tinyData_);
       }
       ioStats_->queryThreadIoLatency().increment(loadUs);
+      if (prefetched) {
+        ioStats_->prefetchHit().increment(load->size());
+      } else {
+        ioStats_->prefetchMissWait().increment(loadUs);
+      }
     } else {
       // Standalone stream, not part of coalesced load.
       loadedRegion_.offset = 0;
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+namespace facebook::velox::dwio::common {
+
+std::unique_ptr<FileMetadataCache> FileMetadataCache::instance_;
+
+FileMetadataCache::FileMetadataCache(uint64_t maxBytes)
+    : factory_(
+          std::make_unique<SimpleLRUCache<
+              FileMetadataCacheKey,
+              std::shared_ptr<FileMetadata>,
+              std::equal_to<FileMetadataCacheKey>,
+              FileMetadataCacheKeyHasher>>(maxBytes),
+          std::make_unique<Generator>()) {}
+
+// static
+FileMetadataCache* FileMetadataCache::create(uint64_t maxBytes) {
+  if (instance_ == nullptr) {
+    instance_ =
+        std::unique_ptr<FileMetadataCache>(new FileMetadataCache(maxBytes));
+  }
+  return instance_.get();
+}
+
+std::unique_ptr<std::shared_ptr<FileMetadata>>
+FileMetadataCache::Generator::operator()(
+    const FileMetadataCacheKey& /*key*/,
+    const Loader* load,
+    void* /*stats*/) {
+  auto metadata = (*load)();
+  VELOX_CHECK_NOT_NULL(metadata);
+  return std::make_unique<std::shared_ptr<FileMetadata>>(std::move(metadata));
+}
+
+std::shared_ptr<FileMetadata> FileMetadataCache::getOrLoad(
+    const FileMetadataCacheKey& key,
+    const Loader& load) {
+  // Copy the shared_ptr out of the cache so that the entry is unpinned and
+  // stays evictable while readers use the metadata.
+  auto cached = factory_.generate(key, &load);
+  return *cached;
+}
+
+// static
+std::optional<FileMetadataCacheKey> FileMetadataCache::makeKey(
+    const ReadFile& file,
+    const ReaderOptions& options) {
+  if (!options.fileModificationTime().has_value()) {
+    return std::nullopt;
+  }
+  return FileMetadataCacheKey{
+      file.getName(),
+      file.size(),
+      options.fileModificationTime().value(),
+      options.fileFormat()};
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/caching/CachedFactory.h"
+#include "velox/dwio/common/Options.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Identifies a version of a file in FileMetadataCache. A file that is
+/// rewritten under the same path gets a new modification time and does not
+/// hit the metadata of its previous version.
+struct FileMetadataCacheKey {
+  std::string path;
+  uint64_t fileSize;
+  int64_t modificationTime;
+  FileFormat format;
+
+  bool operator==(const FileMetadataCacheKey& other) const {
+    return path == other.path && fileSize == other.fileSize &&
+        modificationTime == other.modificationTime && format == other.format;
+  }
+};
+
+struct FileMetadataCacheKeyHasher {
+  size_t operator()(const FileMetadataCacheKey& key) const {
+    return bits::hashMix(
+        bits::hashMix(std::hash<std::string>()(key.path), key.fileSize),
+        key.modificationTime);
+  }
+};
+
+/// Parsed footer of a file. Subclassed by each file format. The contents must
+/// not change after the metadata is added to the cache since it is shared by
+/// readers on different threads.
+class FileMetadata {
+ public:
+  virtual ~FileMetadata() = default;
+
+  /// Returns the number of bytes charged to the cache for 'this'.
+  virtual uint64_t size() const = 0;
+};
+
+/// A process-wide, size bounded cache of parsed file footers, shared by all
+/// readers. Saves reading and parsing the footer again for each split of a
+/// file. The readers keep a shared_ptr to the metadata, so evicting an entry
+/// does not invalidate it for readers using it.
+class FileMetadataCache {
+ public:
+  using Loader = std::function<std::shared_ptr<FileMetadata>()>;
+
+  /// Creates the process-wide instance holding up to 'maxBytes' of metadata
+  /// as measured by FileMetadata::size(). Returns the existing instance if
+  /// already created.
+  static FileMetadataCache* create(uint64_t maxBytes);
+
+  /// Returns the process-wide instance or nullptr if not created.
+  static FileMetadataCache* getInstance() {
+    return instance_.get();
+  }
+
+  static void testingClear() {
+    instance_ = nullptr;
+  }
+
+  /// Returns the metadata for 'key'. If it is not cached, calls 'load' to read
+  /// and parse it and caches the result. Concurrent calls for the same key
+  /// call 'load' only once.
+  std::shared_ptr<FileMetadata> getOrLoad(
+      const FileMetadataCacheKey& key,
+      const Loader& load);
+
+  /// Returns the cache key for reading 'file' with 'options' or std::nullopt
+  /// if the version of 'file' is not known, i.e. the modification time is not
+  /// set in 'options'.
+  static std::optional<FileMetadataCacheKey> makeKey(
+      const ReadFile& file,
+      const ReaderOptions& options);
+
+  SimpleLRUCacheStats stats() {
+    return factory_.cacheStats();
+  }
+
+  /// Drops all metadata not being loaded.
+  void clear() {
+    factory_.clearCache();
+  }
+
+ private:
+  struct Generator {
+    std::unique_ptr<std::shared_ptr<FileMetadata>> operator()(
+        const FileMetadataCacheKey& key,
+        const Loader* load,
+        void* stats);
+  };
+
+  struct Sizer {
+    uint64_t operator()(const std::shared_ptr<FileMetadata>& metadata) const {
+      return metadata->size();
+    }
+  };
+
+  explicit FileMetadataCache(uint64_t maxBytes);
+
+  static std::unique_ptr<FileMetadataCache> instance_;
+
+  CachedFactory<
+      FileMetadataCacheKey,
+      std::shared_ptr<FileMetadata>,
+      Generator,
+      Loader,
+      void,
+      Sizer,
+      std::equal_to<FileMetadataCacheKey>,
+      FileMetadataCacheKeyHasher>
+      factory_;
+};
+
+} // namespace facebook::velox::dwio::common
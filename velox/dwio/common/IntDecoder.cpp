@@ -226,6 +226,33 @@ void unpack4x1(int32_t bytes, T*& output) {
 
 #endif
 
+// Decodes runs of single byte varints a SIMD batch at a time. The high bits
+// of a batch of input are read with a movemask. If none is set, every byte is
+// a complete varint and the batch is copied to T by a fixed-length scalar
+// loop, which the compiler is free to unroll or vectorize. Stops before the
+// first batch that is not all single byte varints, or when fewer than a batch
+// of input or output is left.
+template <typename T>
+FOLLY_ALWAYS_INLINE void decodeSingleByteVarints(
+    const char*& pos,
+    const char* bufferEnd,
+    T*& output,
+    const T* end) {
+  using Bytes = xsimd::batch<int8_t>;
+  while (end - output >= Bytes::size && bufferEnd - pos >= Bytes::size) {
+    const auto bytes =
+        Bytes::load_unaligned(reinterpret_cast<const int8_t*>(pos));
+    if (simd::toBitMask(bytes < Bytes(0)) != 0) {
+      return;
+    }
+    for (auto i = 0; i < Bytes::size; ++i) {
+      output[i] = static_cast<uint8_t>(pos[i]);
+    }
+    pos += Bytes::size;
+    output += Bytes::size;
+  }
+}
+
 // Returns true if the next extract is part of 'rows'.
 inline bool isEnabled(
     int32_t& row,
@@ -933,6 +960,9 @@ void IntDecoder<isSigned>::bulkRead(uint64_t size, T* result) {
   auto output = result;
   const char* pos = bufferStart_;
   auto end = result + size;
+  // Control bits of the last word. Single byte varints are tried a SIMD batch
+  // at a time only after a word of single byte varints.
+  uint64_t controlBits = 0;
   if (pos) {
     // Decrement only if non-null to avoid asan error.
     pos -= maskSize;
@@ -940,8 +970,15 @@ void IntDecoder<isSigned>::bulkRead(uint64_t size, T* result) {
   while (output < end) {
     while (end >= output + 8 && bufferEnd_ - pos >= 8 + maskSize) {
       pos += maskSize;
+      if (carryoverBits == 0 && (controlBits & 0x3f) == 0) {
+        decodeSingleByteVarints(pos, bufferEnd_, output, end);
+        if (end < output + 8 || bufferEnd_ - pos < 8) {
+          pos -= maskSize;
+          continue;
+        }
+      }
       const auto word = folly::loadUnaligned<uint64_t>(pos);
-      const uint64_t controlBits = bits::extractBits<uint64_t>(word, mask);
+      controlBits = bits::extractBits<uint64_t>(word, mask);
       varintSwitch(word, controlBits, pos, output, carryover, carryoverBits);
     }
     if (pos) {
@@ -989,6 +1026,8 @@ void IntDecoder<isSigned>::bulkReadRows(
   int32_t row = initialRow;
   int32_t endRow = rows.back() + 1;
   int32_t endRowIndex = rows.size();
+  // See bulkRead().
+  uint64_t lastControlBits = 0;
   if (pos) {
     // Decrement only if non-null to avoid asan error.
     pos -= maskSize;
@@ -996,6 +1035,29 @@ void IntDecoder<isSigned>::bulkReadRows(
   while (nextRowIndex < rows.size()) {
     while (row + 8 <= endRow && bufferEnd_ - pos >= 8 + maskSize) {
       pos += maskSize;
+      if (carryoverBits == 0 && (lastControlBits & 0x3f) == 0) {
+        // Runs of a SIMD batch worth of contiguous rows of single byte
+        // varints are widened in one step.
+        constexpr int32_t kBatch = xsimd::batch<int8_t>::size;
+        while (row == nextRow && nextRowIndex + kBatch <= endRowIndex &&
+               rows[nextRowIndex + kBatch - 1] == row + kBatch - 1) {
+          auto* batchEnd = output + kBatch;
+          decodeSingleByteVarints(pos, bufferEnd_, output, batchEnd);
+          if (output != batchEnd) {
+            break;
+          }
+          row += kBatch;
+          nextRowIndex += kBatch;
+          if (nextRowIndex == endRowIndex) {
+            break;
+          }
+          nextRow = rows[nextRowIndex];
+        }
+        if (row + 8 > endRow || bufferEnd_ - pos < 8) {
+          pos -= maskSize;
+          continue;
+        }
+      }
       const auto word = folly::loadUnaligned<uint64_t>(pos);
       if (nextRow >= row + 8) {
         row += __builtin_popcountll(~word & mask);
@@ -1003,6 +1065,7 @@ void IntDecoder<isSigned>::bulkReadRows(
         continue;
       }
       const uint64_t controlBits = bits::extractBits<uint64_t>(word, mask);
+      lastControlBits = controlBits;
       int32_t numEnds = __builtin_popcount(controlBits ^ 0xff);
       if (row != nextRow) {
         if (nextRow > row + numEnds) {
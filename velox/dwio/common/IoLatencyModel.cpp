@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/IoLatencyModel.h"
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+folly::Synchronized<
+    folly::F14FastMap<std::string, std::unique_ptr<IoLatencyModel>>>&
+models() {
+  static folly::Synchronized<
+      folly::F14FastMap<std::string, std::unique_ptr<IoLatencyModel>>>
+      instance;
+  return instance;
+}
+
+} // namespace
+
+// static
+IoLatencyModel* IoLatencyModel::forPath(std::string_view path) {
+  const auto schemeEnd = path.find("://");
+  const std::string scheme(
+      schemeEnd == std::string_view::npos ? std::string_view()
+                                          : path.substr(0, schemeEnd));
+  {
+    auto rlock = models().rlock();
+    auto it = rlock->find(scheme);
+    if (it != rlock->end()) {
+      return it->second.get();
+    }
+  }
+  auto wlock = models().wlock();
+  auto& model = (*wlock)[scheme];
+  if (model == nullptr) {
+    model = std::make_unique<IoLatencyModel>();
+  }
+  return model.get();
+}
+
+// static
+void IoLatencyModel::testingClear() {
+  models().wlock()->clear();
+}
+
+void IoLatencyModel::recordRead(uint64_t bytes, uint64_t micros) {
+  const double x = bytes;
+  const double y = micros;
+  std::lock_guard<std::mutex> l(mutex_);
+  weight_ = weight_ * kDecay + 1;
+  sumBytes_ = sumBytes_ * kDecay + x;
+  sumUs_ = sumUs_ * kDecay + y;
+  sumBytesSquared_ = sumBytesSquared_ * kDecay + x * x;
+  sumBytesUs_ = sumBytesUs_ * kDecay + x * y;
+  ++numSamples_;
+}
+
+std::optional<IoLatencyModel::Estimate> IoLatencyModel::estimate() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numSamples_ < kMinSamples) {
+    return std::nullopt;
+  }
+  const double meanBytes = sumBytes_ / weight_;
+  const double meanUs = sumUs_ / weight_;
+  const double bytesVariance =
+      sumBytesSquared_ / weight_ - meanBytes * meanBytes;
+  // Require the sizes to vary by at least 10% to tell latency from transfer
+  // time.
+  if (bytesVariance <= 0.01 * meanBytes * meanBytes) {
+    return std::nullopt;
+  }
+  const double covariance = sumBytesUs_ / weight_ - meanBytes * meanUs;
+  const double usPerByte = std::max(0.0, covariance / bytesVariance);
+  const double requestLatencyUs =
+      std::max(0.0, meanUs - usPerByte * meanBytes);
+  return Estimate{requestLatencyUs, usPerByte};
+}
+
+int32_t IoLatencyModel::coalesceDistance(
+    int32_t configured,
+    int32_t maxDistance) const {
+  const auto fit = estimate();
+  if (!fit.has_value()) {
+    return configured;
+  }
+  const int32_t upper = std::max(kMinCoalesceDistance, maxDistance);
+  if (fit->usPerByte <= 0) {
+    // Transfer time is not measurable next to the request latency.
+    return upper;
+  }
+  const double distance = fit->requestLatencyUs / fit->usPerByte;
+  return static_cast<int32_t>(
+      std::clamp<double>(distance, kMinCoalesceDistance, upper));
+}
+
+} // namespace facebook::velox::dwio::common
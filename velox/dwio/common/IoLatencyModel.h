@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string_view>
+
+namespace facebook::velox::dwio::common {
+
+/// Models the time of a read from a file system as a fixed per-request
+/// latency plus a transfer time per byte, fitted over recent reads. Used to
+/// choose how far apart two reads may be and still be coalesced into one: a
+/// gap is worth reading over if transferring it takes less time than making
+/// a separate request. The optimum differs by orders of magnitude between
+/// local SSD, HDFS and object stores, which a static coalesce distance does
+/// not capture. There is one process-wide model per file system.
+class IoLatencyModel {
+ public:
+  /// Returns the process-wide model for the file system of 'path', given by
+  /// the scheme prefix of 'path', e.g. 's3://'. Paths without a scheme share
+  /// the model of the local file system.
+  static IoLatencyModel* forPath(std::string_view path);
+
+  static void testingClear();
+
+  struct Estimate {
+    /// Fixed time of a request in microseconds.
+    double requestLatencyUs;
+    /// Transfer time per byte in microseconds.
+    double usPerByte;
+  };
+
+  /// Records that reading 'bytes' took 'micros', including gaps read over.
+  void recordRead(uint64_t bytes, uint64_t micros);
+
+  /// Returns the fitted model or std::nullopt if there are too few reads or
+  /// the reads are too similar in size to separate latency from transfer
+  /// time.
+  std::optional<Estimate> estimate() const;
+
+  /// Returns the max distance in bytes between reads to coalesce:
+  /// 'configured' until there is an estimate, then the bytes transferred in
+  /// the time of one request, clamped to [kMinCoalesceDistance,
+  /// 'maxDistance'].
+  int32_t coalesceDistance(int32_t configured, int32_t maxDistance) const;
+
+  /// Number of reads needed before the model is used.
+  static constexpr int32_t kMinSamples = 16;
+
+  /// Weight of the earlier reads when adding a new one. About the last 50
+  /// reads determine the model.
+  static constexpr double kDecay = 0.98;
+
+  static constexpr int32_t kMinCoalesceDistance = 4 << 10;
+
+ private:
+  mutable std::mutex mutex_;
+  // Decayed sums for the least squares fit of time on bytes.
+  double weight_{0};
+  double sumBytes_{0};
+  double sumUs_{0};
+  double sumBytesSquared_{0};
+  double sumBytesUs_{0};
+  int64_t numSamples_{0};
+};
+
+} // namespace facebook::velox::dwio::common
@@ -396,7 +396,10 @@ class RowReaderOptions {
   // Node id for map column to a list of keys to be projected as a struct.
   std::unordered_map<uint32_t, std::vector<std::string>> flatmapNodeIdAsStruct_;
   // Optional executors to enable internal reader parallelism.
-  // 'decodingExecutor' allow parallelising the vector decoding process.
+  // 'decodingExecutor' allow parallelising the vector decoding process. The
+  // Parquet reader uses it to load and decompress the row groups prefetched
+  // ahead of the current one. The DWRF and ORC readers use it to decompress
+  // the compressed blocks of the loaded stream ranges in parallel.
   // 'ioExecutor' enables parallelism when performing file system read
   // operations.
   std::shared_ptr<folly::Executor> decodingExecutor_;
@@ -512,6 +515,31 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Enables eliminating row groups by checking equality and IN filters
+  /// against the Bloom filters stored in the file. Used by Parquet, ORC and
+  /// DWRF.
+  ReaderOptions& setBloomFilterPruningEnabled(bool enabled) {
+    bloomFilterPruningEnabled_ = enabled;
+    return *this;
+  }
+
+  /// Enables evaluating filters once over the dictionary of dictionary encoded
+  /// column chunks and skipping the chunks where no entry passes. Only used by
+  /// Parquet. Off by default.
+  ReaderOptions& setDictionaryFilterEnabled(bool enabled) {
+    dictionaryFilterEnabled_ = enabled;
+    return *this;
+  }
+
+  /// Sets the modification time of the file. If set and a FileMetadataCache
+  /// exists, the parsed footer of the file is shared with other readers of the
+  /// same version of the file.
+  ReaderOptions& setFileModificationTime(
+      std::optional<int64_t> modificationTime) {
+    fileModificationTime_ = modificationTime;
+    return *this;
+  }
+
   /// Gets the desired tail location.
   uint64_t tailLocation() const {
     return tailLocation_;
@@ -559,6 +587,18 @@ class ReaderOptions : public io::ReaderOptions {
     return adjustTimestampToTimezone_;
   }
 
+  bool bloomFilterPruningEnabled() const {
+    return bloomFilterPruningEnabled_;
+  }
+
+  bool dictionaryFilterEnabled() const {
+    return dictionaryFilterEnabled_;
+  }
+
+  const std::optional<int64_t>& fileModificationTime() const {
+    return fileModificationTime_;
+  }
+
   bool fileColumnNamesReadAsLowerCase() const {
     return fileColumnNamesReadAsLowerCase_;
   }
@@ -614,7 +654,10 @@ class ReaderOptions : public io::ReaderOptions {
   std::shared_ptr<velox::common::ScanSpec> scanSpec_;
   const tz::TimeZone* sessionTimezone_{nullptr};
   bool adjustTimestampToTimezone_{false};
+  bool bloomFilterPruningEnabled_{false};
+  bool dictionaryFilterEnabled_{false};
   bool selectiveNimbleReaderEnabled_{false};
+  std::optional<int64_t> fileModificationTime_;
 };
 
 struct WriterOptions {
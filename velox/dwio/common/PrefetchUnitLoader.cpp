@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/PrefetchUnitLoader.h"
+
+#include <atomic>
+#include <map>
+#include <numeric>
+#include <optional>
+
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/MeasureTime.h"
+
+using facebook::velox::dwio::common::measureTimeIfCallback;
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+class PrefetchUnitLoader : public UnitLoader {
+ public:
+  PrefetchUnitLoader(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback,
+      std::shared_ptr<folly::Executor> executor,
+      uint32_t maxUnitsAhead,
+      uint64_t maxBytesAhead)
+      : loadUnits_{std::move(loadUnits)},
+        blockedOnIoCallback_{std::move(blockedOnIoCallback)},
+        executor_{std::move(executor)},
+        maxUnitsAhead_{maxUnitsAhead},
+        maxBytesAhead_{maxBytesAhead} {
+    VELOX_CHECK_NOT_NULL(executor_);
+  }
+
+  ~PrefetchUnitLoader() override {
+    while (!prefetches_.empty()) {
+      cancel(prefetches_.begin());
+    }
+  }
+
+  LoadUnit& getLoadedUnit(uint32_t unit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+
+    if (loadedUnit_.has_value()) {
+      if (loadedUnit_.value() == unit) {
+        return *loadUnits_[unit];
+      }
+
+      loadUnits_[*loadedUnit_]->unload();
+      loadedUnit_.reset();
+    }
+    // Units before 'unit' will not be read without a seek.
+    while (!prefetches_.empty() && prefetches_.begin()->first < unit) {
+      cancel(prefetches_.begin());
+    }
+
+    auto it = prefetches_.find(unit);
+    if (it != prefetches_.end()) {
+      auto source = std::move(it->second.source);
+      prefetches_.erase(it);
+      // Waits for the background load or makes it here if not started.
+      auto measure = measureTimeIfCallback(blockedOnIoCallback_);
+      source->move();
+    } else {
+      auto measure = measureTimeIfCallback(blockedOnIoCallback_);
+      loadUnits_[unit]->load();
+    }
+    loadedUnit_ = unit;
+
+    schedulePrefetches(unit);
+    return *loadUnits_[unit];
+  }
+
+  void onRead(uint32_t unit, uint64_t rowOffsetInUnit, uint64_t /* rowCount */)
+      override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LT(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+  void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LE(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+    // Keeps the prefetches that the reader gets to from 'unit'.
+    for (auto it = prefetches_.begin(); it != prefetches_.end();) {
+      auto next = std::next(it);
+      if (it->first < unit || it->first > unit + maxUnitsAhead_) {
+        cancel(it);
+      }
+      it = next;
+    }
+  }
+
+ private:
+  struct Prefetch {
+    std::shared_ptr<AsyncSource<bool>> source;
+    // Set by the background load once the unit is loaded.
+    std::shared_ptr<std::atomic_bool> loaded;
+    uint64_t ioSize;
+  };
+
+  using PrefetchMap = std::map<uint32_t, Prefetch>;
+
+  // Starts background loads of the units after 'unit' that are not loading
+  // yet, up to 'maxUnitsAhead_' units and 'maxBytesAhead_' bytes ahead.
+  void schedulePrefetches(uint32_t unit) {
+    uint64_t bytesAhead = std::accumulate(
+        prefetches_.begin(),
+        prefetches_.end(),
+        0UL,
+        [](uint64_t sum, const auto& pair) {
+          return sum + pair.second.ioSize;
+        });
+    const auto end = std::min<uint64_t>(
+        loadUnits_.size(), static_cast<uint64_t>(unit) + maxUnitsAhead_ + 1);
+    for (auto next = unit + 1; next < end; ++next) {
+      if (prefetches_.count(next) > 0) {
+        continue;
+      }
+      auto* loadUnit = loadUnits_[next].get();
+      const auto ioSize = loadUnit->getIoSize();
+      if (bytesAhead + ioSize > maxBytesAhead_) {
+        break;
+      }
+      bytesAhead += ioSize;
+      auto loaded = std::make_shared<std::atomic_bool>(false);
+      auto source = std::make_shared<AsyncSource<bool>>([loadUnit, loaded]() {
+        loadUnit->load();
+        *loaded = true;
+        return std::make_unique<bool>(true);
+      });
+      executor_->add([source]() { source->prepare(); });
+      prefetches_.emplace(next, Prefetch{source, loaded, ioSize});
+    }
+  }
+
+  // Cancels the background load at 'it' if not started or waits for it to
+  // finish, and unloads the unit if it got loaded.
+  void cancel(PrefetchMap::iterator it) {
+    it->second.source->close();
+    if (*it->second.loaded) {
+      loadUnits_[it->first]->unload();
+    }
+    prefetches_.erase(it);
+  }
+
+  const std::vector<std::unique_ptr<LoadUnit>> loadUnits_;
+  const std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+  const std::shared_ptr<folly::Executor> executor_;
+  const uint32_t maxUnitsAhead_;
+  const uint64_t maxBytesAhead_;
+  std::optional<uint32_t> loadedUnit_;
+  // Units loading or loaded in the background, keyed on unit index.
+  PrefetchMap prefetches_;
+};
+
+} // namespace
+
+PrefetchUnitLoaderFactory::PrefetchUnitLoaderFactory(
+    std::function<void(std::chrono::high_resolution_clock::duration)>
+        blockedOnIoCallback,
+    std::shared_ptr<folly::Executor> executor,
+    uint32_t maxUnitsAhead,
+    uint64_t maxBytesAhead)
+    : blockedOnIoCallback_{std::move(blockedOnIoCallback)},
+      executor_{std::move(executor)},
+      maxUnitsAhead_{maxUnitsAhead},
+      maxBytesAhead_{maxBytesAhead} {
+  VELOX_CHECK_NOT_NULL(executor_);
+}
+
+std::unique_ptr<UnitLoader> PrefetchUnitLoaderFactory::create(
+    std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+    uint64_t rowsToSkip) {
+  const auto totalRows = std::accumulate(
+      loadUnits.cbegin(), loadUnits.cend(), 0UL, [](uint64_t sum, auto& unit) {
+        return sum + unit->getNumRows();
+      });
+  VELOX_CHECK_LE(
+      rowsToSkip,
+      totalRows,
+      "Can only skip up to the past-the-end row of the file.");
+  return std::make_unique<PrefetchUnitLoader>(
+      std::move(loadUnits),
+      blockedOnIoCallback_,
+      executor_,
+      maxUnitsAhead_,
+      maxBytesAhead_);
+}
+
+} // namespace facebook::velox::dwio::common
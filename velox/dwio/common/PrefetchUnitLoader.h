@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include <folly/Executor.h>
+
+#include "velox/dwio/common/UnitLoader.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Makes UnitLoaders that load up to 'maxUnitsAhead' units past the one being
+/// read on 'executor', so that the I/O of the next stripes overlaps with the
+/// decoding of the current one. A unit is prefetched only if the I/O sizes of
+/// the units prefetched ahead of the current one stay within
+/// 'maxBytesAhead'. A unit requested before its background load has started
+/// is loaded on the calling thread. Prefetches that are not needed anymore
+/// after a seek, or when the loader is destroyed, are cancelled if they have
+/// not started, waited for if running and unloaded if done.
+class PrefetchUnitLoaderFactory
+    : public velox::dwio::common::UnitLoaderFactory {
+ public:
+  PrefetchUnitLoaderFactory(
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback,
+      std::shared_ptr<folly::Executor> executor,
+      uint32_t maxUnitsAhead,
+      uint64_t maxBytesAhead);
+
+  ~PrefetchUnitLoaderFactory() override = default;
+
+  std::unique_ptr<velox::dwio::common::UnitLoader> create(
+      std::vector<std::unique_ptr<velox::dwio::common::LoadUnit>> loadUnits,
+      uint64_t rowsToSkip) override;
+
+ private:
+  const std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+  const std::shared_ptr<folly::Executor> executor_;
+  const uint32_t maxUnitsAhead_;
+  const uint64_t maxBytesAhead_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -16,6 +16,8 @@
 
 #include "velox/dwio/common/Reader.h"
 
+#include "velox/dwio/common/DecoderUtil.h"
+
 namespace facebook::velox::dwio::common {
 
 using namespace velox::common;
@@ -112,12 +114,9 @@ void fillRowNumberVector(
         std::vector<BufferPtr>());
     flatRowNum = rowNumVector->asUnchecked<FlatVector<int64_t>>();
   }
-  auto* rawRowNum = flatRowNum->mutableRawValues();
   const auto rowOffsets = columnReader->outputRows();
   VELOX_DCHECK_EQ(rowOffsets.size(), result->size());
-  for (int i = 0; i < rowOffsets.size(); ++i) {
-    rawRowNum[i] = previousRow + rowOffsets[i];
-  }
+  fillRowNumbers(previousRow, rowOffsets, flatRowNum->mutableRawValues());
 }
 } // namespace
 
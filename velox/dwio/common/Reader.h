@@ -100,6 +100,16 @@ class RowReader {
    */
   virtual std::optional<size_t> estimatedRowSize() const = 0;
 
+  /**
+   * Get the number of rows in the stripes or row groups read by this reader,
+   * including rows that filters may drop, if known from the file metadata.
+   * This allows counting the rows of a split without reading any column.
+   * @return Number of rows or std::nullopt if not known without reading.
+   */
+  virtual std::optional<uint64_t> numRowsInRange() const {
+    return std::nullopt;
+  }
+
   // Returns true if the expected IO for 'this' is scheduled. If this
   // is true it makes sense to prefetch the next split.
   virtual bool allPrefetchIssued() const {
@@ -16,8 +16,11 @@
 
 #include "velox/dwio/common/ScanSpec.h"
 
+#include <folly/Conv.h>
+
 #include "velox/core/Expressions.h"
 #include "velox/dwio/common/Statistics.h"
+#include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::common {
 
@@ -37,6 +40,16 @@ ScanSpec* ScanSpec::getOrCreateChild(const Subfield& subfield) {
   const auto& path = subfield.path();
   for (size_t depth = 0; depth < path.size(); ++depth) {
     const auto element = path[depth].get();
+    if (depth > 0 && depth + 1 == path.size()) {
+      if (element->kind() == kStringSubscript) {
+        return container->getOrCreateMapSubscript(
+            static_cast<const Subfield::StringSubscript*>(element)->index());
+      }
+      if (element->kind() == kLongSubscript) {
+        return container->getOrCreateMapSubscript(std::to_string(
+            static_cast<const Subfield::LongSubscript*>(element)->index()));
+      }
+    }
     VELOX_CHECK_EQ(element->kind(), kNestedField);
     auto* nestedField = static_cast<const Subfield::NestedField*>(element);
     container = container->getOrCreateChild(nestedField->name());
@@ -44,6 +57,19 @@ ScanSpec* ScanSpec::getOrCreateChild(const Subfield& subfield) {
   return container;
 }
 
+ScanSpec* ScanSpec::getOrCreateMapSubscript(const std::string& key) {
+  for (auto& subscript : mapSubscripts_) {
+    if (subscript->fieldName_ == key) {
+      return subscript.get();
+    }
+  }
+  mapSubscripts_.push_back(std::make_shared<ScanSpec>(key));
+  auto* subscript = mapSubscripts_.back().get();
+  subscript->setProjectOut(true);
+  subscript->filterDisabled_ = filterDisabled_;
+  return subscript;
+}
+
 bool ScanSpec::compareTimeToDropValue(
     const std::shared_ptr<ScanSpec>& left,
     const std::shared_ptr<ScanSpec>& right) {
@@ -122,6 +148,9 @@ void ScanSpec::enableFilterInSubTree(bool value) {
   for (auto& child : children_) {
     child->enableFilterInSubTree(value);
   }
+  for (auto& subscript : mapSubscripts_) {
+    subscript->enableFilterInSubTree(value);
+  }
 }
 
 const std::vector<ScanSpec*>& ScanSpec::stableChildren() {
@@ -152,6 +181,12 @@ bool ScanSpec::hasFilter() const {
       return true;
     }
   }
+  for (auto& subscript : mapSubscripts_) {
+    if (subscript->hasFilter()) {
+      hasFilter_ = true;
+      return true;
+    }
+  }
   hasFilter_ = false;
   return false;
 }
@@ -166,6 +201,11 @@ bool ScanSpec::hasFilterApplicableToConstant() const {
       return true;
     }
   }
+  for (auto& subscript : mapSubscripts_) {
+    if (subscript->hasFilterApplicableToConstant()) {
+      return true;
+    }
+  }
   return false;
 }
 
@@ -179,6 +219,11 @@ bool ScanSpec::testNull() const {
       return false;
     }
   }
+  for (auto& subscript : mapSubscripts_) {
+    if (!subscript->testNull()) {
+      return false;
+    }
+  }
   return true;
 }
 
@@ -425,6 +470,13 @@ std::string ScanSpec::toString() const {
     }
     out << ")";
   }
+  if (!mapSubscripts_.empty()) {
+    out << " [";
+    for (auto& subscript : mapSubscripts_) {
+      out << subscript->toString() << ", ";
+    }
+    out << "]";
+  }
   return out.str();
 }
 
@@ -560,12 +612,87 @@ void filterRows(
   }
 }
 
+// Clears the bits of 'result' for the maps in 'decodedMaps' where the value of
+// 'key' does not pass 'filter'. The value is null where the map or the key is
+// missing.
+template <typename T>
+void filterMapSubscript(
+    const DecodedVector& decodedMaps,
+    T key,
+    Filter& filter,
+    uint64_t* result) {
+  const auto size = decodedMaps.size();
+  auto* maps = decodedMaps.base()->asUnchecked<MapVector>();
+  DecodedVector decodedKeys(*maps->mapKeys());
+  auto values =
+      BaseVector::create(maps->mapValues()->type(), size, maps->pool());
+  bits::forEachSetBit(result, 0, size, [&](auto i) {
+    if (!decodedMaps.isNullAt(i)) {
+      const auto map = decodedMaps.index(i);
+      const auto begin = maps->offsetAt(map);
+      const auto end = begin + maps->sizeAt(map);
+      for (auto j = begin; j < end; ++j) {
+        if (!decodedKeys.isNullAt(j) && decodedKeys.valueAt<T>(j) == key) {
+          values->copy(maps->mapValues().get(), i, j, 1);
+          return;
+        }
+      }
+    }
+    values->setNull(i, true);
+  });
+  filterRows(*values, filter, size, result);
+}
+
+void filterMapSubscripts(
+    const BaseVector& vector,
+    const std::vector<std::shared_ptr<ScanSpec>>& subscripts,
+    uint64_t* result) {
+  DecodedVector decodedMaps(vector);
+  const auto& keyType = vector.type()->asMap().keyType();
+  for (const auto& subscript : subscripts) {
+    auto* filter = subscript->filter();
+    if (filter == nullptr) {
+      continue;
+    }
+    const auto& key = subscript->fieldName();
+    switch (keyType->kind()) {
+      case TypeKind::TINYINT:
+        filterMapSubscript(
+            decodedMaps, folly::to<int8_t>(key), *filter, result);
+        break;
+      case TypeKind::SMALLINT:
+        filterMapSubscript(
+            decodedMaps, folly::to<int16_t>(key), *filter, result);
+        break;
+      case TypeKind::INTEGER:
+        filterMapSubscript(
+            decodedMaps, folly::to<int32_t>(key), *filter, result);
+        break;
+      case TypeKind::BIGINT:
+        filterMapSubscript(
+            decodedMaps, folly::to<int64_t>(key), *filter, result);
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        filterMapSubscript(decodedMaps, StringView(key), *filter, result);
+        break;
+      default:
+        VELOX_UNSUPPORTED(
+            "Filter on a subscript of a map with {} keys",
+            keyType->toString());
+    }
+  }
+}
+
 } // namespace
 
 void ScanSpec::applyFilter(const BaseVector& vector, uint64_t* result) const {
   if (filter_) {
     filterRows(vector, *filter_, vector.size(), result);
   }
+  if (!mapSubscripts_.empty() && vector.type()->isMap()) {
+    filterMapSubscripts(vector, mapSubscripts_, result);
+  }
   if (!vector.type()->isRow()) {
     // Filter on MAP or ARRAY children are pruning, and won't affect correctness
     // of the result.
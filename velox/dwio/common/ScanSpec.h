@@ -203,9 +203,22 @@ class ScanSpec {
   // Returns the ScanSpec corresponding to 'subfield'. Creates it if
   // needed, including any intermediate levels. This is used at
   // TableScan initialization to create the ScanSpec tree that
-  // corresponds to the ColumnReader tree.
+  // corresponds to the ColumnReader tree. A subscript at the end of the path
+  // refers to getOrCreateMapSubscript() of the map before it.
   ScanSpec* getOrCreateChild(const Subfield& subfield);
 
+  /// Returns the spec of the values of 'key' in a map, creating it if needed.
+  /// Its filter applies to m['key']: a row passes if the map has the key and
+  /// its value passes the filter, or if the map or the key is missing and the
+  /// filter passes nulls. Unlike a filter on map keys, this changes the number
+  /// of rows. Only the flat map readers and applyFilter() support these. Long
+  /// keys are given as their decimal string.
+  ScanSpec* getOrCreateMapSubscript(const std::string& key);
+
+  const std::vector<std::shared_ptr<ScanSpec>>& mapSubscripts() const {
+    return mapSubscripts_;
+  }
+
   ScanSpec* childByName(const std::string& name) const {
     auto it = childByFieldName_.find(name);
     if (it == childByFieldName_.end()) {
@@ -277,6 +290,9 @@ class ScanSpec {
     for (auto& child : children_) {
       child->resetCachedValues(doReorder);
     }
+    for (auto& subscript : mapSubscripts_) {
+      subscript->resetCachedValues(doReorder);
+    }
     if (doReorder) {
       reorder();
     }
@@ -458,6 +474,9 @@ class ScanSpec {
   // Used only for bulk reader to project flat map features.
   std::vector<std::string> flatMapFeatureSelection_;
 
+  // The specs of single map keys with filters on their values.
+  std::vector<std::shared_ptr<ScanSpec>> mapSubscripts_;
+
   // This node represents a flat map column that need to be read as struct,
   // i.e. in table schema it is a MAP, but in result vector it is ROW.
   bool isFlatMapAsStruct_ = false;
@@ -43,11 +43,16 @@ struct DictionaryValues {
   /// True if values are in ascending order.
   bool sorted{false};
 
+  /// True if all values are known to be ASCII. Set when loading the
+  /// dictionary, while the strings are in cache.
+  bool isAscii{false};
+
   void clear() {
     values = nullptr;
     strings = nullptr;
     numValues = 0;
     sorted = false;
+    isAscii = false;
   }
 
   /// Whether the dictionary values have filter on it.
@@ -179,6 +179,11 @@ SelectiveListColumnReader::SelectiveListColumnReader(
     FormatParams& params,
     velox::common::ScanSpec& scanSpec)
     : SelectiveRepeatedColumnReader(requestedType, params, scanSpec, fileType) {
+  if (!scanSpec.mapSubscripts().empty()) {
+    VELOX_UNSUPPORTED(
+        "Filters on map subscripts are only supported on flat maps: {}",
+        scanSpec.fieldName());
+  }
 }
 
 uint64_t SelectiveListColumnReader::skip(uint64_t numValues) {
@@ -241,6 +246,11 @@ SelectiveMapColumnReader::SelectiveMapColumnReader(
     FormatParams& params,
     velox::common::ScanSpec& scanSpec)
     : SelectiveRepeatedColumnReader(requestedType, params, scanSpec, fileType) {
+  if (!scanSpec.mapSubscripts().empty()) {
+    VELOX_UNSUPPORTED(
+        "Filters on map subscripts are only supported on flat maps: {}",
+        scanSpec.fieldName());
+  }
 }
 
 uint64_t SelectiveMapColumnReader::skip(uint64_t numValues) {
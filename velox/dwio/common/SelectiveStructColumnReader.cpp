@@ -18,6 +18,7 @@
 
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/ColumnLoader.h"
+#include "velox/dwio/common/DecoderUtil.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -142,10 +143,10 @@ void setRowNumberField(
         AlignedBuffer::allocate<int64_t>(rows.size(), pool),
         std::vector<BufferPtr>());
   }
-  auto* values = field->asChecked<FlatVector<int64_t>>()->mutableRawValues();
-  for (int i = 0; i < rows.size(); ++i) {
-    values[i] = offset + rows[i];
-  }
+  fillRowNumbers(
+      offset,
+      rows,
+      field->asChecked<FlatVector<int64_t>>()->mutableRawValues());
 }
 
 void setCompositeField(
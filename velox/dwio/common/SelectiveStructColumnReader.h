@@ -224,6 +224,16 @@ class SelectiveFlatMapColumnReaderHelper {
     if (auto type = reader_.requestedType_->childAt(1); type->isRow()) {
       childValues_ = BaseVector::create(type, 0, reader_.memoryPool_);
     }
+    // A key that is not in the file has only nulls.
+    for (auto& subscript : reader_.scanSpec_->mapSubscripts()) {
+      if (!subscript->hasFilter() || subscript->testNull()) {
+        continue;
+      }
+      missingFilteredKey_ |= std::none_of(
+          keyNodes_.begin(), keyNodes_.end(), [&](const auto& keyNode) {
+            return keyNode.reader->scanSpec() == subscript.get();
+          });
+    }
   }
 
   void read(int64_t offset, RowSet rows, const uint64_t* incomingNulls);
@@ -276,6 +286,9 @@ class SelectiveFlatMapColumnReaderHelper {
   std::vector<uint64_t> columnRowBits_;
   int columnBitsWords_;
   std::vector<BaseVector::CopyRange> copyRanges_;
+  // True if a key with a filter on its values is not in the file and the
+  // filter does not pass nulls, so that no row passes.
+  bool missingFilteredKey_{false};
 };
 
 template <typename T, typename KeyNode, typename FormatData>
@@ -305,14 +318,33 @@ void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::read(
     }
     activeRows = reader_.outputRows_;
   }
+  if (missingFilteredKey_) {
+    activeRows = {};
+  }
   // Separate the loop to be cache friendly.
   for (auto* child : reader_.children_) {
     reader_.advanceFieldReader(child, offset);
   }
+  // The keys with filters on their values are read first, so that the other
+  // keys are only read for the rows that pass.
   for (auto* child : reader_.children_) {
-    child->read(offset, activeRows, mapNulls);
+    if (activeRows.empty()) {
+      break;
+    }
+    if (child->scanSpec()->hasFilter()) {
+      child->read(offset, activeRows, mapNulls);
+      activeRows = child->outputRows();
+    }
+  }
+  for (auto* child : reader_.children_) {
+    if (!activeRows.empty() && !child->scanSpec()->hasFilter()) {
+      child->read(offset, activeRows, mapNulls);
+    }
     child->addParentNulls(offset, mapNulls, rows);
   }
+  if (reader_.scanSpec_->hasFilter()) {
+    reader_.setOutputRows(activeRows);
+  }
   reader_.lazyVectorReadOffset_ = offset;
   reader_.readOffset_ = offset + rows.back() + 1;
 }
@@ -101,6 +101,14 @@ void SortingWriter::abort() {
   outputWriter_->abort();
 }
 
+void SortingWriter::spill() {
+  if (!canReclaim_ || !isRunning()) {
+    return;
+  }
+  sortBuffer_->spill();
+  sortPool_->release();
+}
+
 bool SortingWriter::canReclaim() const {
   return canReclaim_;
 }
@@ -46,6 +46,10 @@ class SortingWriter : public Writer {
 
   void abort() override;
 
+  /// Spills the buffered input if the sort buffer can spill. Lets the owner
+  /// bound the memory of its writers outside of memory arbitration.
+  void spill();
+
  private:
   class MemoryReclaimer : public exec::MemoryReclaimer {
    public:
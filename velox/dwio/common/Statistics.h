@@ -545,9 +545,16 @@ struct RuntimeStatistics {
   // Total bytes in splits skipped based on statistics.
   int64_t skippedSplitBytes{0};
 
+  // Number of the skipped splits that were skipped before opening their files.
+  int64_t prunedSplits{0};
+
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of rows inside read strides (row groups) skipped based on page
+  // level statistics.
+  int64_t skippedPageRows{0};
+
   int64_t footerBufferOverread{0};
 
   int64_t numStripes{0};
@@ -564,9 +571,15 @@ struct RuntimeStatistics {
           "skippedSplitBytes",
           RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes));
     }
+    if (prunedSplits > 0) {
+      result.emplace("prunedSplits", RuntimeCounter(prunedSplits));
+    }
     if (skippedStrides > 0) {
       result.emplace("skippedStrides", RuntimeCounter(skippedStrides));
     }
+    if (skippedPageRows > 0) {
+      result.emplace("skippedPageRows", RuntimeCounter(skippedPageRows));
+    }
     if (footerBufferOverread > 0) {
       result.emplace(
           "footerBufferOverread",
@@ -16,8 +16,10 @@
 
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/common/compression/LzoDecompressor.h"
+#include "velox/common/compression/QplJobPool.h"
 #include "velox/dwio/common/IntCodecCommon.h"
 #include "velox/dwio/common/compression/PagedInputStream.h"
+#include "velox/dwio/common/compression/ParallelPagedInputStream.h"
 
 #include <folly/logging/xlog.h>
 #include <lz4.h>
@@ -193,6 +195,54 @@ uint64_t ZlibDecompressor::decompress(
   return destLength - zstream_.avail_out;
 }
 
+// Decompresses on IAA and falls back to zlib when the accelerator is busy or
+// cannot decompress the block.
+class QplZlibDecompressor : public ZlibDecompressor {
+ public:
+  QplZlibDecompressor(
+      velox::common::QplJobPool& jobPool,
+      uint64_t blockSize,
+      int windowBits,
+      const std::string& streamDebugInfo,
+      bool isGzip)
+      : ZlibDecompressor{blockSize, windowBits, streamDebugInfo, isGzip},
+        jobPool_{jobPool},
+        windowBits_{windowBits},
+        isGzip_{isGzip} {}
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override {
+    if (const auto size = jobPool_.decompress(
+            format(src, srcLength), src, srcLength, dest, destLength)) {
+      return *size;
+    }
+    return ZlibDecompressor::decompress(src, srcLength, dest, destLength);
+  }
+
+ private:
+  velox::common::QplJobPool::Format format(
+      const char* src,
+      uint64_t srcLength) const {
+    using Format = velox::common::QplJobPool::Format;
+    if (windowBits_ < 0) {
+      return Format::kRawDeflate;
+    }
+    // Like zlib, detects a gzip header if 'isGzip_' is set.
+    if (isGzip_ && srcLength >= 2 && static_cast<uint8_t>(src[0]) == 0x1f &&
+        static_cast<uint8_t>(src[1]) == 0x8b) {
+      return Format::kGzip;
+    }
+    return Format::kZlib;
+  }
+
+  velox::common::QplJobPool& jobPool_;
+  const int windowBits_;
+  const bool isGzip_;
+};
+
 class LzoAndLz4DecompressorCommon : public Decompressor {
  public:
   explicit LzoAndLz4DecompressorCommon(
@@ -610,6 +660,47 @@ bool ZlibDecompressionStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+std::unique_ptr<Decompressor> createBlockDecompressor(
+    CompressionKind kind,
+    uint64_t blockSize,
+    const CompressionOptions& options,
+    const std::string& streamDebugInfo) {
+  switch (static_cast<int64_t>(kind)) {
+    case CompressionKind::CompressionKind_NONE:
+      return nullptr;
+    case CompressionKind::CompressionKind_ZLIB:
+    case CompressionKind::CompressionKind_GZIP: {
+      const bool isGzip = kind == CompressionKind::CompressionKind_GZIP;
+      if (auto* jobPool = velox::common::QplJobPool::instance()) {
+        return std::make_unique<QplZlibDecompressor>(
+            *jobPool,
+            blockSize,
+            options.format.zlib.windowBits,
+            streamDebugInfo,
+            isGzip);
+      }
+      return std::make_unique<ZlibDecompressor>(
+          blockSize, options.format.zlib.windowBits, streamDebugInfo, isGzip);
+    }
+    case CompressionKind::CompressionKind_SNAPPY:
+      return std::make_unique<SnappyDecompressor>(blockSize, streamDebugInfo);
+    case CompressionKind::CompressionKind_LZO:
+      return std::make_unique<LzoDecompressor>(
+          blockSize,
+          options.format.lz4_lzo.isHadoopFrameFormat,
+          streamDebugInfo);
+    case CompressionKind::CompressionKind_LZ4:
+      return std::make_unique<Lz4Decompressor>(
+          blockSize,
+          options.format.lz4_lzo.isHadoopFrameFormat,
+          streamDebugInfo);
+    case CompressionKind::CompressionKind_ZSTD:
+      return std::make_unique<ZstdDecompressor>(blockSize, streamDebugInfo);
+    default:
+      DWIO_RAISE("Unknown compression codec ", kind);
+  }
+}
+
 } // namespace
 
 std::unique_ptr<Compressor> createCompressor(
@@ -651,8 +742,11 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     const std::string& streamDebugInfo,
     const Decrypter* decrypter,
     bool useRawDecompression,
-    size_t compressedLength) {
-  std::unique_ptr<Decompressor> decompressor;
+    size_t compressedLength,
+    folly::Executor* decompressionExecutor,
+    size_t decompressionParallelismFactor) {
+  const bool parallel = decompressionExecutor != nullptr &&
+      decompressionParallelismFactor > 1 && !decrypter && !useRawDecompression;
   switch (static_cast<int64_t>(kind)) {
     case CompressionKind::CompressionKind_NONE:
       if (!decrypter) {
@@ -661,66 +755,42 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
       // decompressor remain as nullptr
       break;
     case CompressionKind::CompressionKind_ZLIB:
-      if (!decrypter) {
-        // When file is not encrypted, we can use zlib streaming codec to avoid
-        // copying data
-        return std::make_unique<ZlibDecompressionStream>(
-            std::move(input),
-            blockSize,
-            pool,
-            options.format.zlib.windowBits,
-            streamDebugInfo,
-            false,
-            useRawDecompression,
-            compressedLength);
-      }
-      decompressor = std::make_unique<ZlibDecompressor>(
-          blockSize, options.format.zlib.windowBits, streamDebugInfo, false);
-      break;
     case CompressionKind::CompressionKind_GZIP:
-      if (!decrypter) {
-        // When file is not encrypted, we can use zlib streaming codec to avoid
-        // copying data
+      // When file is not encrypted, we can use zlib streaming codec to avoid
+      // copying data. IAA and parallel decompression work on whole blocks,
+      // so the blocks are assembled by PagedInputStream instead.
+      if (!decrypter && !parallel &&
+          velox::common::QplJobPool::instance() == nullptr) {
         return std::make_unique<ZlibDecompressionStream>(
             std::move(input),
             blockSize,
             pool,
             options.format.zlib.windowBits,
             streamDebugInfo,
-            true,
+            kind == CompressionKind::CompressionKind_GZIP,
             useRawDecompression,
             compressedLength);
       }
-      decompressor = std::make_unique<ZlibDecompressor>(
-          blockSize, options.format.zlib.windowBits, streamDebugInfo, true);
-      break;
-    case CompressionKind::CompressionKind_SNAPPY:
-      decompressor =
-          std::make_unique<SnappyDecompressor>(blockSize, streamDebugInfo);
-      break;
-    case CompressionKind::CompressionKind_LZO:
-      decompressor = std::make_unique<LzoDecompressor>(
-          blockSize,
-          options.format.lz4_lzo.isHadoopFrameFormat,
-          streamDebugInfo);
-      break;
-    case CompressionKind::CompressionKind_LZ4:
-      decompressor = std::make_unique<Lz4Decompressor>(
-          blockSize,
-          options.format.lz4_lzo.isHadoopFrameFormat,
-          streamDebugInfo);
-      break;
-    case CompressionKind::CompressionKind_ZSTD:
-      decompressor =
-          std::make_unique<ZstdDecompressor>(blockSize, streamDebugInfo);
       break;
     default:
-      DWIO_RAISE("Unknown compression codec ", kind);
+      break;
+  }
+  if (parallel && kind != CompressionKind::CompressionKind_NONE) {
+    return std::make_unique<ParallelPagedInputStream>(
+        std::move(input),
+        pool,
+        [kind, blockSize, options, streamDebugInfo]() {
+          return createBlockDecompressor(
+              kind, blockSize, options, streamDebugInfo);
+        },
+        decompressionExecutor,
+        decompressionParallelismFactor,
+        streamDebugInfo);
   }
   return std::make_unique<PagedInputStream>(
       std::move(input),
       pool,
-      std::move(decompressor),
+      createBlockDecompressor(kind, blockSize, options, streamDebugInfo),
       decrypter,
       streamDebugInfo,
       useRawDecompression,
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/encryption/Encryption.h"
@@ -98,6 +100,11 @@ struct CompressionOptions {
  * @param options The compression options to use
  * @param useRawDecompression Specify whether to perform raw decompression
  * @param compressedLength The compressed block length for raw decompression
+ * @param decompressionExecutor If set, the compressed blocks loaded together
+ * are decompressed in parallel on this executor ahead of the reader
+ * @param decompressionParallelismFactor The number of threads, including the
+ * calling one, that decompress the blocks in parallel. Parallel decompression
+ * is off if this is less than 2
  */
 std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     facebook::velox::common::CompressionKind kind,
@@ -108,7 +115,9 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     const std::string& streamDebugInfo,
     const dwio::common::encryption::Decrypter* decryptr = nullptr,
     bool useRawDecompression = false,
-    size_t compressedLength = 0);
+    size_t compressedLength = 0,
+    folly::Executor* decompressionExecutor = nullptr,
+    size_t decompressionParallelismFactor = 0);
 
 /**
  * Create a compressor for the given compression kind.
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/compression/ParallelPagedInputStream.h"
+
+#include "velox/dwio/common/ParallelFor.h"
+
+namespace facebook::velox::dwio::common::compression {
+namespace {
+constexpr int32_t kHeaderSize = 3;
+} // namespace
+
+ParallelPagedInputStream::ParallelPagedInputStream(
+    std::unique_ptr<SeekableInputStream> inStream,
+    memory::MemoryPool& memPool,
+    std::function<std::unique_ptr<Decompressor>()> decompressorFactory,
+    folly::Executor* executor,
+    size_t parallelismFactor,
+    const std::string& streamDebugInfo)
+    : PagedInputStream(
+          std::move(inStream),
+          memPool,
+          decompressorFactory(),
+          nullptr,
+          streamDebugInfo),
+      decompressorFactory_(std::move(decompressorFactory)),
+      executor_(executor),
+      parallelismFactor_(parallelismFactor),
+      // Two blocks per thread leave room for uneven blocks without holding
+      // much more decompressed data than is read.
+      maxBatchBlocks_(std::min<size_t>(kMaxBatchBlocks, 2 * parallelismFactor)),
+      batchBuffer_(memPool) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GT(parallelismFactor_, 1);
+}
+
+bool ParallelPagedInputStream::readOrSkip(const void** data, int32_t* size) {
+  if (outputBufferLength_ == 0 && atBlockStart()) {
+    // Skips do not start a batch so that PagedInputStream can skip the blocks
+    // of known size without decompressing them.
+    if (nextBlock_ < batch_.size() || (data != nullptr && loadBatch())) {
+      nextFromBatch(data, size);
+      return true;
+    }
+    // The input is read past the batch from here on.
+    clearBatch();
+  }
+  return PagedInputStream::readOrSkip(data, size);
+}
+
+bool ParallelPagedInputStream::loadBatch() {
+  if (state_ == State::END) {
+    return false;
+  }
+  if (inputBufferPtr_ == inputBufferPtrEnd_) {
+    readBuffer(false);
+    if (state_ == State::END) {
+      return false;
+    }
+  }
+  clearBatch();
+  const char* position = inputBufferPtr_;
+  size_t totalCapacity = 0;
+  while (batch_.size() < maxBatchBlocks_ &&
+         inputBufferPtrEnd_ - position >= kHeaderSize) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(position);
+    const uint32_t header = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16);
+    const size_t length = header >> 1;
+    if ((header & 1) != 0 ||
+        static_cast<size_t>(inputBufferPtrEnd_ - position - kHeaderSize) <
+            length) {
+      break;
+    }
+    const char* input = position + kHeaderSize;
+    const auto capacity =
+        decompressor_->getDecompressedLength(input, length).first;
+    batch_.push_back(
+        {static_cast<uint64_t>(
+             input_->ByteCount() - (inputBufferPtrEnd_ - position)),
+         input,
+         length,
+         totalCapacity,
+         static_cast<size_t>(capacity),
+         0});
+    totalCapacity += capacity;
+    position = input + length;
+  }
+  if (batch_.size() < 2) {
+    clearBatch();
+    return false;
+  }
+
+  while (decompressors_.size() < batch_.size() - 1) {
+    decompressors_.push_back(decompressorFactory_());
+  }
+  if (batchBuffer_.capacity() < totalCapacity) {
+    batchBuffer_.reserve(totalCapacity);
+  }
+  ParallelFor(executor_, 0, batch_.size(), parallelismFactor_)
+      .execute([&](size_t i) {
+        auto& block = batch_[i];
+        auto* decompressor =
+            i == 0 ? decompressor_.get() : decompressors_[i - 1].get();
+        block.length = decompressor->decompress(
+            block.input,
+            block.inputLength,
+            batchBuffer_.data() + block.offset,
+            block.capacity);
+      });
+  inputBufferPtr_ = position;
+  return true;
+}
+
+void ParallelPagedInputStream::nextFromBatch(
+    const void** data,
+    int32_t* size) {
+  const auto& block = batch_[nextBlock_++];
+  lastHeaderOffset_ = block.headerOffset;
+  bytesReturnedAtLastHeaderOffset_ = bytesReturned_;
+  state_ = State::HEADER;
+  remainingLength_ = 0;
+  const char* output = batchBuffer_.data() + block.offset;
+  if (data) {
+    *data = output;
+  }
+  *size = static_cast<int32_t>(block.length);
+  outputBufferPtr_ = output + block.length;
+  outputBufferLength_ = 0;
+  bytesReturned_ += *size;
+  lastWindowSize_ = *size;
+}
+
+void ParallelPagedInputStream::seekToPosition(
+    dwio::common::PositionProvider& positionProvider) {
+  const auto compressedOffset = positionProvider.next();
+  const auto uncompressedOffset = positionProvider.next();
+  for (size_t i = 0; i < batch_.size(); ++i) {
+    if (batch_[i].headerOffset == compressedOffset) {
+      // The block is decompressed and the input is still positioned after the
+      // batch.
+      nextBlock_ = i;
+      state_ = State::HEADER;
+      remainingLength_ = 0;
+      outputBufferLength_ = 0;
+      pendingSkip_ = uncompressedOffset;
+      return;
+    }
+  }
+  clearBatch();
+  std::vector<uint64_t> positions = {compressedOffset, uncompressedOffset};
+  dwio::common::PositionProvider provider(positions);
+  PagedInputStream::seekToPosition(provider);
+}
+
+} // namespace facebook::velox::dwio::common::compression
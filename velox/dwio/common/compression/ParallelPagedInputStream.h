@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+
+#include <folly/Executor.h>
+
+#include "velox/dwio/common/compression/PagedInputStream.h"
+
+namespace facebook::velox::dwio::common::compression {
+
+/// A PagedInputStream that decompresses the compressed blocks that are
+/// entirely within the range returned by the input stream ahead of the reader,
+/// in parallel on 'executor'. The range is the coalesced load of the stream or
+/// of a large part of it and has many blocks. The decompressed blocks are then
+/// returned one at a time as with PagedInputStream. An uncompressed block or a
+/// block that spans ranges ends the batch and is read like in
+/// PagedInputStream. Decryption and raw decompression are not supported.
+class ParallelPagedInputStream : public PagedInputStream {
+ public:
+  /// 'decompressorFactory' makes a decompressor for each block that is
+  /// decompressed concurrently with the others of its batch. Up to
+  /// 'parallelismFactor' threads, including the calling one, decompress a
+  /// batch.
+  ParallelPagedInputStream(
+      std::unique_ptr<SeekableInputStream> inStream,
+      memory::MemoryPool& memPool,
+      std::function<std::unique_ptr<Decompressor>()> decompressorFactory,
+      folly::Executor* executor,
+      size_t parallelismFactor,
+      const std::string& streamDebugInfo);
+
+  void seekToPosition(dwio::common::PositionProvider& position) override;
+
+  /// The most blocks decompressed in a batch.
+  static constexpr int32_t kMaxBatchBlocks = 16;
+
+ protected:
+  bool readOrSkip(const void** data, int32_t* size) override;
+
+ private:
+  struct Block {
+    // Offset of the block header in 'input_'.
+    uint64_t headerOffset;
+    const char* input;
+    size_t inputLength;
+    // Offset of the decompressed block in 'batchBuffer_'.
+    size_t offset;
+    size_t capacity;
+    size_t length;
+  };
+
+  // True if the next read starts a new block.
+  bool atBlockStart() const {
+    return state_ == State::HEADER ||
+        (state_ == State::ORIGINAL && remainingLength_ == 0);
+  }
+
+  // Decompresses the compressed blocks from 'inputBufferPtr_' that are
+  // complete in the current input range. Returns false and leaves the stream
+  // unchanged if there are less than 2 such blocks.
+  bool loadBatch();
+
+  // Returns the next block of 'batch_'.
+  void nextFromBatch(const void** data, int32_t* size);
+
+  void clearBatch() {
+    batch_.clear();
+    nextBlock_ = 0;
+  }
+
+  const std::function<std::unique_ptr<Decompressor>()> decompressorFactory_;
+  folly::Executor* const executor_;
+  const size_t parallelismFactor_;
+  const size_t maxBatchBlocks_;
+
+  // The decompressors for the blocks of a batch after the first one, which
+  // uses 'decompressor_'.
+  std::vector<std::unique_ptr<Decompressor>> decompressors_;
+
+  // The blocks of the current batch. The input is positioned after the last
+  // one.
+  std::vector<Block> batch_;
+  // The index in 'batch_' of the next block to return.
+  size_t nextBlock_{0};
+  dwio::common::DataBuffer<char> batchBuffer_;
+};
+
+} // namespace facebook::velox::dwio::common::compression
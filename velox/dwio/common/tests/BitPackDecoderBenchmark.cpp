@@ -323,6 +323,32 @@ void duckdbBitUnpack(uint8_t bitWidth, T* result) {
       duckInputBuffer, bitpack_pos, result, kNumValues, bitWidth);
 }
 
+// Unpacks 16 bit levels through BitReader, which selects the BMI2 kernels of
+// BitPackDecoder.h for narrow types.
+void bitReaderLevels(uint8_t bitWidth, int16_t* result) {
+  facebook::velox::parquet::BitReader bitReader(
+      reinterpret_cast<const uint8_t*>(bitPackedData[bitWidth].data()),
+      BYTES(kNumValues, bitWidth));
+  bitReader.GetBatch<int16_t>(bitWidth, result, kNumValues);
+}
+
+// Unpacks 16 bit levels into a 32 bit buffer with Arrow's unpack32 and narrows
+// them, which is what BitReader did for narrow types before.
+void arrowUnpack32Levels(uint8_t bitWidth, int16_t* result) {
+  constexpr int32_t kBufferSize = 1024;
+  uint32_t buffer[kBufferSize];
+  auto input =
+      reinterpret_cast<const uint32_t*>(bitPackedData[bitWidth].data());
+  for (uint64_t i = 0; i < kNumValues; i += kBufferSize) {
+    auto numUnpacked =
+        ::arrow::internal::unpack32(input, buffer, kBufferSize, bitWidth);
+    for (auto k = 0; k < numUnpacked; ++k) {
+      result[i + k] = static_cast<int16_t>(buffer[k]);
+    }
+    input += numUnpacked * bitWidth / 32;
+  }
+}
+
 #define BENCHMARK_UNPACK_FULLROWS_CASE_8(width)                  \
   BENCHMARK(velox_unpack_fullrows_##width##_8) {                 \
     veloxBitUnpack<uint8_t>(width, result8.data());              \
@@ -389,6 +415,15 @@ void duckdbBitUnpack(uint8_t bitWidth, T* result) {
   }                                                               \
   BENCHMARK_DRAW_LINE();
 
+#define BENCHMARK_UNPACK_LEVELS_CASE(width)                                 \
+  BENCHMARK(bitreader_unpack_levels_##width) {                              \
+    bitReaderLevels(width, reinterpret_cast<int16_t*>(result16.data()));    \
+  }                                                                         \
+  BENCHMARK_RELATIVE(arrow_unpack32_levels_##width) {                       \
+    arrowUnpack32Levels(width, reinterpret_cast<int16_t*>(result16.data())); \
+  }                                                                         \
+  BENCHMARK_DRAW_LINE();
+
 #define BENCHMARK_UNPACK_ODDROWS_CASE_8(width)                  \
   BENCHMARK_RELATIVE(legacy_unpack_naive_oddrows_##width##_8) { \
     legacyUnpackNaive<uint8_t>(oddRows, width, result8.data()); \
@@ -469,6 +504,25 @@ BENCHMARK_UNPACK_FULLROWS_CASE_32(32)
 
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_UNPACK_LEVELS_CASE(1)
+BENCHMARK_UNPACK_LEVELS_CASE(2)
+BENCHMARK_UNPACK_LEVELS_CASE(3)
+BENCHMARK_UNPACK_LEVELS_CASE(4)
+BENCHMARK_UNPACK_LEVELS_CASE(5)
+BENCHMARK_UNPACK_LEVELS_CASE(6)
+BENCHMARK_UNPACK_LEVELS_CASE(7)
+BENCHMARK_UNPACK_LEVELS_CASE(8)
+BENCHMARK_UNPACK_LEVELS_CASE(9)
+BENCHMARK_UNPACK_LEVELS_CASE(10)
+BENCHMARK_UNPACK_LEVELS_CASE(11)
+BENCHMARK_UNPACK_LEVELS_CASE(12)
+BENCHMARK_UNPACK_LEVELS_CASE(13)
+BENCHMARK_UNPACK_LEVELS_CASE(14)
+BENCHMARK_UNPACK_LEVELS_CASE(15)
+BENCHMARK_UNPACK_LEVELS_CASE(16)
+
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK_UNPACK_ODDROWS_CASE_8(1)
 BENCHMARK_UNPACK_ODDROWS_CASE_8(2)
 BENCHMARK_UNPACK_ODDROWS_CASE_8(4)
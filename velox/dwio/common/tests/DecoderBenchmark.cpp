@@ -0,0 +1,796 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures the Parquet and DWRF value decoders on generated data for a range
+// of value widths, null densities and selectivities. Each benchmark decodes
+// kNumRows rows, so that folly reports the time per row. A table with the
+// rows/s and the encoded bytes/s of each benchmark is printed at the end.
+//
+// The selectivities are:
+//  - dense: all rows are read.
+//  - sparse: every kSparseStride-th row is read and the others are skipped.
+//  - filter: all rows are read and a filter passing about 10% of the values is
+//    applied, as the column readers do for a filter pushed into the scan.
+//
+// Parquet nulls are decoded from RLE definition levels, which count in the
+// encoded bytes. DWRF nulls come from a separate stream and are passed to the
+// decoders as a bitmap. The decoders without a batch API are driven by
+// readWithVisitor() with a minimal visitor, which runs their value by value
+// path. The bulk paths that need a SelectiveColumnReader are covered by
+// ParquetReaderBenchmark.
+
+#include <chrono>
+#include <numeric>
+
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/base/Nulls.h"
+#include "velox/common/base/SimdUtil.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/DataBufferHolder.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/IntDecoder.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/dwrf/common/DecoderUtil.h"
+#include "velox/dwio/dwrf/common/EncoderUtil.h"
+#include "velox/dwio/dwrf/common/IntEncoder.h"
+#include "velox/dwio/parquet/common/RleEncodingInternal.h"
+#include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/RleBpDecoder.h"
+#include "velox/dwio/parquet/reader/StringDecoder.h"
+#include "velox/dwio/parquet/writer/arrow/Encoding.h"
+#include "velox/type/Filter.h"
+
+using namespace facebook::velox;
+
+namespace {
+
+constexpr int32_t kNumRows = 100 * 1'024;
+constexpr int32_t kBatchSize = 1'024;
+constexpr int32_t kSparseStride = 10;
+
+const std::vector<int32_t> kNullPcts = {0, 10, 50, 90};
+
+enum class Selectivity { kDense, kSparse, kFilter };
+
+// Encoded bytes followed by simd::kPadding bytes, which the decoders may load
+// past the end of the data.
+class EncodedBuffer {
+ public:
+  EncodedBuffer() = default;
+
+  explicit EncodedBuffer(std::string_view data)
+      : data_(data), size_(data.size()) {
+    data_.resize(size_ + simd::kPadding);
+  }
+
+  const char* begin() const {
+    return data_.data();
+  }
+
+  const char* end() const {
+    return data_.data() + size_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+ private:
+  std::string data_;
+  size_t size_{0};
+};
+
+// A decoder benchmark and the totals of its runs.
+struct DecoderCase {
+  std::string name;
+  // The encoded size of the values and nulls decoded by a run.
+  uint64_t encodedBytes;
+  // Decodes the kNumRows rows and returns a checksum of the read values.
+  std::function<int64_t()> decode;
+  uint64_t numRuns{0};
+  uint64_t nanos{0};
+};
+
+std::vector<std::unique_ptr<DecoderCase>> decoderCases;
+
+void addCase(
+    std::string name,
+    uint64_t encodedBytes,
+    std::function<int64_t()> decode) {
+  decoderCases.push_back(std::make_unique<DecoderCase>(
+      DecoderCase{std::move(name), encodedBytes, std::move(decode)}));
+  auto* decoderCase = decoderCases.back().get();
+  folly::addBenchmark(__FILE__, decoderCase->name, [decoderCase](unsigned n) {
+    int64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < n; ++i) {
+      checksum += decoderCase->decode();
+    }
+    decoderCase->nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+    decoderCase->numRuns += n;
+    folly::doNotOptimizeAway(checksum);
+    return n * kNumRows;
+  });
+}
+
+// Adds a case per Selectivity. 'read' is called with the selectivity and the
+// filter to apply, which is common::AlwaysTrue unless the selectivity is
+// kFilter.
+template <typename TFilter, typename Read>
+void addCases(
+    const std::string& name,
+    uint64_t encodedBytes,
+    std::shared_ptr<TFilter> filter,
+    Read read) {
+  auto alwaysTrue = std::make_shared<common::AlwaysTrue>();
+  addCase(name + "_dense", encodedBytes, [read, alwaysTrue]() {
+    return read(Selectivity::kDense, *alwaysTrue);
+  });
+  addCase(name + "_sparse", encodedBytes, [read, alwaysTrue]() {
+    return read(Selectivity::kSparse, *alwaysTrue);
+  });
+  addCase(name + "_filter", encodedBytes, [read, filter]() {
+    return read(Selectivity::kFilter, *filter);
+  });
+}
+
+std::string caseName(
+    const std::string& decoder,
+    int32_t width,
+    int32_t nullPct) {
+  return fmt::format("{}_w{}_nulls{}", decoder, width, nullPct);
+}
+
+const std::vector<int32_t>& denseRows() {
+  static const auto rows = [] {
+    std::vector<int32_t> rows(kNumRows);
+    std::iota(rows.begin(), rows.end(), 0);
+    return rows;
+  }();
+  return rows;
+}
+
+const std::vector<int32_t>& sparseRows() {
+  static const auto rows = [] {
+    std::vector<int32_t> rows;
+    for (auto row = 0; row < kNumRows; row += kSparseStride) {
+      rows.push_back(row);
+    }
+    return rows;
+  }();
+  return rows;
+}
+
+int32_t numNonNulls(const uint64_t* nulls, int32_t begin, int32_t end) {
+  return nulls ? bits::countNonNulls(nulls, begin, end) : end - begin;
+}
+
+// Returns a null bitmap with 'nullPct' percent of random nulls.
+std::vector<uint64_t> makeNulls(
+    int32_t nullPct,
+    folly::Random::DefaultGenerator& rng) {
+  std::vector<uint64_t> nulls(bits::nwords(kNumRows), bits::kNotNull64);
+  for (auto row = 0; row < kNumRows; ++row) {
+    if (folly::Random::rand32(100, rng) < static_cast<uint32_t>(nullPct)) {
+      bits::setNull(nulls.data(), row);
+    }
+  }
+  return nulls;
+}
+
+// Returns the value such that about 10% of 'values' are less or equal.
+template <typename T>
+T tenthPercentile(std::vector<T> values) {
+  auto nth = values.begin() + values.size() / 10;
+  std::nth_element(values.begin(), nth, values.end());
+  return *nth;
+}
+
+// Returns the checksum of the values among 'values' that pass 'filter'. Skips
+// the null rows if 'nulls' is set.
+template <typename TFilter, typename T>
+int64_t sumPassing(
+    TFilter& filter,
+    const T* values,
+    int32_t numValues,
+    const uint64_t* nulls) {
+  int64_t sum = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    if (nulls && bits::isBitNull(nulls, i)) {
+      continue;
+    }
+    const auto value = static_cast<int64_t>(values[i]);
+    if (common::applyFilter(filter, value)) {
+      sum += value;
+    }
+  }
+  return sum;
+}
+
+// A visitor for readWithVisitor() of the Parquet decoders. Like
+// dwio::common::ColumnVisitor, it applies 'filter' to the values of 'rows'
+// and returns the number of rows to skip to the next row to read. The
+// checksum of the passing values is added to 'sum'.
+template <typename TFilter, bool isDense>
+class BenchmarkVisitor {
+ public:
+  static constexpr bool dense = isDense;
+  static constexpr bool kHasFilter =
+      !std::is_same_v<TFilter, common::AlwaysTrue>;
+  static constexpr bool kHasHook = false;
+
+  BenchmarkVisitor(
+      TFilter& filter,
+      const std::vector<int32_t>& rows,
+      int64_t& sum)
+      : filter_(filter),
+        rows_(rows.data()),
+        numRows_(rows.size()),
+        sum_(sum) {}
+
+  // Nulls do not pass the filters of the benchmark.
+  bool allowNulls() const {
+    return !kHasFilter;
+  }
+
+  int32_t start() const {
+    return rows_[0];
+  }
+
+  int32_t numRows() const {
+    return numRows_;
+  }
+
+  void setNumValues(int32_t /*numValues*/) {}
+
+  int32_t processNull(bool& atEnd) {
+    return advance(atEnd);
+  }
+
+  // Moves to the next non-null row to read if 'current' is null. Returns the
+  // number of non-null rows that are not read before it.
+  int32_t
+  checkAndSkipNulls(const uint64_t* nulls, int32_t& current, bool& atEnd) {
+    if (!bits::isBitNull(nulls, current)) {
+      return 0;
+    }
+    for (;;) {
+      if (++rowIndex_ >= numRows_) {
+        atEnd = true;
+        return bits::countNonNulls(nulls, current, rows_[numRows_ - 1] + 1);
+      }
+      const auto next = rows_[rowIndex_];
+      if (!bits::isBitNull(nulls, next)) {
+        const auto toSkip = bits::countNonNulls(nulls, current, next);
+        current = next;
+        return toSkip;
+      }
+    }
+  }
+
+  template <typename V>
+  int32_t process(V value, bool& atEnd) {
+    if constexpr (std::is_same_v<V, std::string_view>) {
+      return process(folly::StringPiece(value.data(), value.size()), atEnd);
+    } else {
+      if (common::applyFilter(filter_, value)) {
+        if constexpr (std::is_same_v<V, folly::StringPiece>) {
+          sum_ += value.size();
+        } else {
+          sum_ += value;
+        }
+      }
+      return advance(atEnd);
+    }
+  }
+
+ private:
+  int32_t advance(bool& atEnd) {
+    const auto row = rows_[rowIndex_];
+    if (++rowIndex_ >= numRows_) {
+      atEnd = true;
+      return 0;
+    }
+    return rows_[rowIndex_] - row - 1;
+  }
+
+  TFilter& filter_;
+  const int32_t* const rows_;
+  const int32_t numRows_;
+  int32_t rowIndex_{0};
+  int64_t& sum_;
+};
+
+template <typename TDecoder, typename TFilter>
+int64_t readWithVisitor(
+    TDecoder& decoder,
+    const uint64_t* nulls,
+    Selectivity selectivity,
+    TFilter& filter) {
+  int64_t sum = 0;
+  auto read = [&](auto visitor) {
+    if (nulls) {
+      decoder.template readWithVisitor<true>(nulls, visitor);
+    } else {
+      decoder.template readWithVisitor<false>(nullptr, visitor);
+    }
+  };
+  if (selectivity == Selectivity::kSparse) {
+    read(BenchmarkVisitor<TFilter, false>(filter, sparseRows(), sum));
+  } else {
+    read(BenchmarkVisitor<TFilter, true>(filter, denseRows(), sum));
+  }
+  return sum;
+}
+
+// The encoded values and definition levels of a Parquet page.
+struct ParquetPage {
+  EncodedBuffer values;
+  // Empty if there are no nulls.
+  EncodedBuffer defLevels;
+
+  uint64_t encodedBytes() const {
+    return values.size() + defLevels.size();
+  }
+};
+
+struct Scratch {
+  std::vector<uint64_t> nulls = std::vector<uint64_t>(bits::nwords(kNumRows));
+  std::vector<uint32_t> ids = std::vector<uint32_t>(kBatchSize);
+  std::vector<int64_t> values = std::vector<int64_t>(kBatchSize);
+};
+
+EncodedBuffer encodeRleBp(const std::vector<uint32_t>& values, int bitWidth) {
+  std::string buffer(
+      parquet::RleEncoder::MaxBufferSize(bitWidth, values.size()), 0);
+  parquet::RleEncoder encoder(
+      reinterpret_cast<uint8_t*>(buffer.data()),
+      static_cast<int>(buffer.size()),
+      bitWidth);
+  for (auto value : values) {
+    VELOX_CHECK(encoder.Put(value));
+  }
+  buffer.resize(encoder.Flush());
+  return EncodedBuffer(buffer);
+}
+
+EncodedBuffer encodeDefLevels(const std::vector<uint64_t>& nulls) {
+  std::vector<uint32_t> levels(kNumRows);
+  for (auto row = 0; row < kNumRows; ++row) {
+    levels[row] = !bits::isBitNull(nulls.data(), row);
+  }
+  return encodeRleBp(levels, 1);
+}
+
+EncodedBuffer toEncodedBuffer(
+    const std::shared_ptr<::arrow::Buffer>& buffer) {
+  return EncodedBuffer(std::string_view(
+      reinterpret_cast<const char*>(buffer->data()), buffer->size()));
+}
+
+// Makes a page of 'nullPct' percent nulls and non-null values encoded by
+// 'encode' from the values made by 'makeValues'.
+template <typename MakeValues, typename Encode>
+std::shared_ptr<ParquetPage> makeParquetPage(
+    int32_t nullPct,
+    folly::Random::DefaultGenerator& rng,
+    MakeValues makeValues,
+    Encode encode) {
+  auto page = std::make_shared<ParquetPage>();
+  const auto nulls = makeNulls(nullPct, rng);
+  const auto numValues = bits::countNonNulls(nulls.data(), 0, kNumRows);
+  page->values = encode(makeValues(numValues));
+  if (nullPct > 0) {
+    page->defLevels = encodeDefLevels(nulls);
+  }
+  return page;
+}
+
+// Decodes the definition levels of 'page' into 'nulls'. Returns nullptr if
+// 'page' has no nulls.
+const uint64_t* decodeNulls(
+    const ParquetPage& page,
+    std::vector<uint64_t>& nulls) {
+  if (page.defLevels.empty()) {
+    return nullptr;
+  }
+  parquet::RleBpDecoder decoder(
+      page.defLevels.begin(), page.defLevels.end(), 1);
+  decoder.readBits(kNumRows, nulls.data());
+  return nulls.data();
+}
+
+template <typename TFilter>
+int64_t readRleBp(
+    parquet::RleBpDecoder& decoder,
+    const uint64_t* nulls,
+    Selectivity selectivity,
+    TFilter& filter,
+    std::vector<uint32_t>& ids) {
+  int64_t sum = 0;
+  if (selectivity == Selectivity::kSparse) {
+    int32_t nextRow = 0;
+    for (auto row = 0; row < kNumRows; row += kSparseStride) {
+      decoder.skip(numNonNulls(nulls, nextRow, row));
+      nextRow = row + 1;
+      if (nulls && bits::isBitNull(nulls, row)) {
+        continue;
+      }
+      auto* id = ids.data();
+      decoder.next(id, 1);
+      sum += ids[0];
+    }
+    return sum;
+  }
+  for (auto row = 0; row < kNumRows; row += kBatchSize) {
+    const auto numValues = numNonNulls(nulls, row, row + kBatchSize);
+    auto* values = ids.data();
+    decoder.next(values, numValues);
+    sum += sumPassing(filter, ids.data(), numValues, nullptr);
+  }
+  return sum;
+}
+
+// Adds the RLE/bit packed dictionary indices of 'bitWidth' bits.
+void addRleBpCases(int32_t bitWidth, folly::Random::DefaultGenerator& rng) {
+  for (auto nullPct : kNullPcts) {
+    auto page = makeParquetPage(
+        nullPct,
+        rng,
+        [&](int32_t numValues) {
+          std::vector<uint32_t> values(numValues);
+          for (auto& value : values) {
+            value = folly::Random::rand64(rng) & bits::lowMask(bitWidth);
+          }
+          return values;
+        },
+        [&](const std::vector<uint32_t>& values) {
+          return encodeRleBp(values, bitWidth);
+        });
+    auto scratch = std::make_shared<Scratch>();
+    addCases(
+        caseName("ParquetRleBp", bitWidth, nullPct),
+        page->encodedBytes(),
+        std::make_shared<common::BigintRange>(
+            0, bits::lowMask(bitWidth) / 10, false),
+        [page, scratch, bitWidth](Selectivity selectivity, auto& filter) {
+          const auto* nulls = decodeNulls(*page, scratch->nulls);
+          parquet::RleBpDecoder decoder(
+              page->values.begin(), page->values.end(), bitWidth);
+          return readRleBp(decoder, nulls, selectivity, filter, scratch->ids);
+        });
+  }
+}
+
+// Adds the DELTA_BINARY_PACKED increasing values with deltas of 'bitWidth'
+// bits.
+void addDeltaBpCases(int32_t bitWidth, folly::Random::DefaultGenerator& rng) {
+  for (auto nullPct : kNullPcts) {
+    int64_t upper;
+    auto page = makeParquetPage(
+        nullPct,
+        rng,
+        [&](int32_t numValues) {
+          std::vector<int64_t> values(numValues);
+          int64_t value = 0;
+          for (auto& v : values) {
+            value += folly::Random::rand64(rng) & bits::lowMask(bitWidth);
+            v = value;
+          }
+          upper = tenthPercentile(values);
+          return values;
+        },
+        [](const std::vector<int64_t>& values) {
+          auto encoder =
+              parquet::arrow::MakeTypedEncoder<parquet::arrow::Int64Type>(
+                  parquet::arrow::Encoding::DELTA_BINARY_PACKED);
+          encoder->Put(values.data(), values.size());
+          return toEncodedBuffer(encoder->FlushValues());
+        });
+    auto scratch = std::make_shared<Scratch>();
+    addCases(
+        caseName("ParquetDeltaBp", bitWidth, nullPct),
+        page->encodedBytes(),
+        std::make_shared<common::BigintRange>(0, upper, false),
+        [page, scratch](Selectivity selectivity, auto& filter) {
+          const auto* nulls = decodeNulls(*page, scratch->nulls);
+          parquet::DeltaBpDecoder decoder(page->values.begin());
+          return readWithVisitor(decoder, nulls, selectivity, filter);
+        });
+  }
+}
+
+// Adds the PLAIN booleans.
+void addBooleanCases(folly::Random::DefaultGenerator& rng) {
+  for (auto nullPct : kNullPcts) {
+    auto page = makeParquetPage(
+        nullPct,
+        rng,
+        [&](int32_t numValues) {
+          // About 10% of the values are true.
+          std::vector<bool> values(numValues);
+          for (auto i = 0; i < numValues; ++i) {
+            values[i] = folly::Random::oneIn(10, rng);
+          }
+          return values;
+        },
+        [](const std::vector<bool>& values) {
+          std::string buffer(bits::nbytes(values.size()), 0);
+          for (size_t i = 0; i < values.size(); ++i) {
+            bits::setBit(
+                reinterpret_cast<uint8_t*>(buffer.data()), i, values[i]);
+          }
+          return EncodedBuffer(buffer);
+        });
+    auto scratch = std::make_shared<Scratch>();
+    addCases(
+        caseName("ParquetBoolean", 1, nullPct),
+        page->encodedBytes(),
+        std::make_shared<common::BoolValue>(true, false),
+        [page, scratch](Selectivity selectivity, auto& filter) {
+          const auto* nulls = decodeNulls(*page, scratch->nulls);
+          parquet::BooleanDecoder decoder(
+              page->values.begin(), page->values.end());
+          return readWithVisitor(decoder, nulls, selectivity, filter);
+        });
+  }
+}
+
+// Returns 'numValues' strings of 'length' random lower case letters. Sorted
+// if 'sorted' is true, so that consecutive strings share a prefix.
+std::vector<std::string> makeStrings(
+    int32_t numValues,
+    int32_t length,
+    bool sorted,
+    folly::Random::DefaultGenerator& rng) {
+  std::vector<std::string> values(numValues);
+  for (auto& value : values) {
+    value.resize(length);
+    for (auto& c : value) {
+      c = 'a' + folly::Random::rand32(26, rng);
+    }
+  }
+  if (sorted) {
+    std::sort(values.begin(), values.end());
+  }
+  return values;
+}
+
+EncodedBuffer encodeStrings(
+    const std::vector<std::string>& values,
+    parquet::arrow::Encoding::type encoding) {
+  std::vector<parquet::arrow::ByteArray> byteArrays;
+  byteArrays.reserve(values.size());
+  for (const auto& value : values) {
+    byteArrays.emplace_back(std::string_view(value));
+  }
+  auto encoder =
+      parquet::arrow::MakeTypedEncoder<parquet::arrow::ByteArrayType>(
+          encoding);
+  encoder->Put(byteArrays.data(), byteArrays.size());
+  return toEncodedBuffer(encoder->FlushValues());
+}
+
+// Adds the PLAIN and DELTA_BYTE_ARRAY strings of 'length' bytes.
+void addStringCases(int32_t length, folly::Random::DefaultGenerator& rng) {
+  for (auto encoding :
+       {parquet::arrow::Encoding::PLAIN,
+        parquet::arrow::Encoding::DELTA_BYTE_ARRAY}) {
+    const bool isDelta = encoding == parquet::arrow::Encoding::DELTA_BYTE_ARRAY;
+    for (auto nullPct : kNullPcts) {
+      std::string upper;
+      auto page = makeParquetPage(
+          nullPct,
+          rng,
+          [&](int32_t numValues) {
+            auto values = makeStrings(numValues, length, isDelta, rng);
+            upper = tenthPercentile(values);
+            return values;
+          },
+          [&](const std::vector<std::string>& values) {
+            return encodeStrings(values, encoding);
+          });
+      auto bytesRange = std::make_shared<common::BytesRange>(
+          "", true, false, upper, false, false, false);
+      auto scratch = std::make_shared<Scratch>();
+      auto name = caseName(
+          isDelta ? "ParquetDeltaByteArray" : "ParquetPlainString",
+          length,
+          nullPct);
+      auto read = [page, scratch, isDelta](
+                      Selectivity selectivity, auto& filter) {
+        const auto* nulls = decodeNulls(*page, scratch->nulls);
+        if (isDelta) {
+          parquet::DeltaByteArrayDecoder decoder(page->values.begin());
+          return readWithVisitor(decoder, nulls, selectivity, filter);
+        }
+        parquet::StringDecoder decoder(
+            page->values.begin(), page->values.end());
+        return readWithVisitor(decoder, nulls, selectivity, filter);
+      };
+      addCases(name, page->encodedBytes(), bytesRange, read);
+    }
+  }
+}
+
+// The DWRF integer encodings.
+enum class DwrfEncoding { kDirect, kDirectVarint, kRleV1 };
+
+EncodedBuffer encodeDwrf(
+    const std::vector<int64_t>& values,
+    DwrfEncoding encoding,
+    memory::MemoryPool& pool) {
+  const auto capacity = values.size() * folly::kMaxVarintLength64;
+  dwio::common::MemorySink sink{capacity, {.pool = &pool}};
+  dwio::common::DataBufferHolder holder{
+      pool, capacity, 0, dwio::common::DEFAULT_PAGE_GROW_RATIO, &sink};
+  auto output = std::make_unique<dwio::common::BufferedOutputStream>(holder);
+  std::unique_ptr<dwrf::IntEncoder<true>> encoder;
+  if (encoding == DwrfEncoding::kRleV1) {
+    encoder = dwrf::createRleEncoder<true>(
+        dwrf::RleVersion_1, std::move(output), true, sizeof(int64_t));
+  } else {
+    encoder = dwrf::createDirectEncoder<true>(
+        std::move(output),
+        encoding == DwrfEncoding::kDirectVarint,
+        sizeof(int64_t));
+  }
+  encoder->add(values.data(), common::Ranges::of(0, values.size()), nullptr);
+  encoder->flush();
+  return EncodedBuffer(std::string_view(sink.data(), sink.size()));
+}
+
+template <typename TFilter>
+int64_t readDwrf(
+    dwio::common::IntDecoder<true>& decoder,
+    const uint64_t* nulls,
+    Selectivity selectivity,
+    TFilter& filter,
+    std::vector<int64_t>& values) {
+  int64_t sum = 0;
+  if (selectivity == Selectivity::kSparse) {
+    int32_t nextRow = 0;
+    for (auto row = 0; row < kNumRows; row += kSparseStride) {
+      decoder.skip(numNonNulls(nulls, nextRow, row));
+      nextRow = row + 1;
+      if (nulls && bits::isBitNull(nulls, row)) {
+        continue;
+      }
+      decoder.next(values.data(), 1, nullptr);
+      sum += values[0];
+    }
+    return sum;
+  }
+  for (auto row = 0; row < kNumRows; row += kBatchSize) {
+    const auto* batchNulls = nulls ? nulls + row / 64 : nullptr;
+    decoder.next(values.data(), kBatchSize, batchNulls);
+    sum += sumPassing(filter, values.data(), kBatchSize, batchNulls);
+  }
+  return sum;
+}
+
+// Adds the DWRF integers of 'bitWidth' bits in 'encoding'.
+void addDwrfCases(
+    DwrfEncoding encoding,
+    int32_t bitWidth,
+    memory::MemoryPool& pool,
+    folly::Random::DefaultGenerator& rng) {
+  static const std::unordered_map<DwrfEncoding, std::string> kNames = {
+      {DwrfEncoding::kDirect, "DwrfDirect"},
+      {DwrfEncoding::kDirectVarint, "DwrfDirectVarint"},
+      {DwrfEncoding::kRleV1, "DwrfRleV1"},
+  };
+  for (auto nullPct : kNullPcts) {
+    auto nulls =
+        std::make_shared<std::vector<uint64_t>>(makeNulls(nullPct, rng));
+    std::vector<int64_t> values(
+        bits::countNonNulls(nulls->data(), 0, kNumRows));
+    for (auto& value : values) {
+      value = folly::Random::rand64(rng) & bits::lowMask(bitWidth);
+    }
+    auto data =
+        std::make_shared<EncodedBuffer>(encodeDwrf(values, encoding, pool));
+    auto scratch = std::make_shared<Scratch>();
+    addCases(
+        caseName(kNames.at(encoding), bitWidth, nullPct),
+        data->size(),
+        std::make_shared<common::BigintRange>(
+            0, tenthPercentile(values), false),
+        [data, nulls, scratch, encoding, &pool, nullPct](
+            Selectivity selectivity, auto& filter) {
+          auto input = std::make_unique<dwio::common::SeekableArrayInputStream>(
+              data->begin(), data->size());
+          auto decoder = encoding == DwrfEncoding::kRleV1
+              ? dwrf::createRleDecoder<true>(
+                    std::move(input),
+                    dwrf::RleVersion_1,
+                    pool,
+                    true,
+                    sizeof(int64_t))
+              : dwrf::createDirectDecoder<true>(
+                    std::move(input),
+                    encoding == DwrfEncoding::kDirectVarint,
+                    sizeof(int64_t));
+          return readDwrf(
+              *decoder,
+              nullPct > 0 ? nulls->data() : nullptr,
+              selectivity,
+              filter,
+              scratch->values);
+        });
+  }
+}
+
+void printThroughput() {
+  std::cout << fmt::format(
+      "{:<48}{:>16}{:>16}\n", "Decoder", "Rows/s", "Encoded MB/s");
+  for (const auto& decoderCase : decoderCases) {
+    if (decoderCase->nanos == 0) {
+      continue;
+    }
+    const double seconds = decoderCase->nanos / 1e9;
+    std::cout << fmt::format(
+        "{:<48}{:>16.4g}{:>16.1f}\n",
+        decoderCase->name,
+        decoderCase->numRuns * kNumRows / seconds,
+        decoderCase->numRuns * decoderCase->encodedBytes / seconds /
+            (1 << 20));
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  auto pool = memory::memoryManager()->addLeafPool();
+  folly::Random::DefaultGenerator rng(1);
+
+  for (auto bitWidth : {1, 8, 12, 20}) {
+    addRleBpCases(bitWidth, rng);
+  }
+  for (auto bitWidth : {1, 8, 20, 40}) {
+    addDeltaBpCases(bitWidth, rng);
+  }
+  addBooleanCases(rng);
+  for (auto length : {8, 32}) {
+    addStringCases(length, rng);
+  }
+  for (auto encoding :
+       {DwrfEncoding::kDirect,
+        DwrfEncoding::kDirectVarint,
+        DwrfEncoding::kRleV1}) {
+    for (auto bitWidth : {8, 20, 40}) {
+      addDwrfCases(encoding, bitWidth, *pool, rng);
+    }
+  }
+
+  folly::runBenchmarks();
+  printThroughput();
+  return 0;
+}
@@ -233,3 +233,29 @@ TEST_F(DecoderUtilTest, processFixedWithRun) {
     }
   }
 }
+
+TEST_F(DecoderUtilTest, fillRowNumbers) {
+  for (auto rowsPer1000 : {1000, 900, 10}) {
+    for (auto numRows : {0, 1, 7, 33, 1000}) {
+      raw_vector<int32_t> rows;
+      randomRows(numRows, rowsPer1000, rows);
+      const int64_t offset = (1LL << 33) + numRows;
+      std::vector<int64_t> values(rows.size());
+      fillRowNumbers(offset, rows, values.data());
+      for (auto i = 0; i < rows.size(); ++i) {
+        ASSERT_EQ(values[i], offset + rows[i]);
+      }
+    }
+  }
+
+  // Consecutive rows not starting at 0.
+  raw_vector<int32_t> rows;
+  for (auto i = 0; i < 100; ++i) {
+    rows.push_back(i + 10);
+  }
+  std::vector<int64_t> values(rows.size());
+  fillRowNumbers(5, rows, values.data());
+  for (auto i = 0; i < rows.size(); ++i) {
+    ASSERT_EQ(values[i], i + 15);
+  }
+}
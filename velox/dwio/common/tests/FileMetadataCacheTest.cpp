@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/file/File.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+struct TestMetadata : public FileMetadata {
+  explicit TestMetadata(uint64_t _bytes) : bytes(_bytes) {}
+
+  uint64_t size() const override {
+    return bytes;
+  }
+
+  const uint64_t bytes;
+};
+
+class FileMetadataCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void TearDown() override {
+    FileMetadataCache::testingClear();
+  }
+
+  std::shared_ptr<FileMetadata> getOrLoad(
+      const FileMetadataCacheKey& key,
+      uint64_t bytes = 10) {
+    return cache_->getOrLoad(key, [&]() {
+      ++numLoads_;
+      return std::make_shared<TestMetadata>(bytes);
+    });
+  }
+
+  FileMetadataCache* cache_{FileMetadataCache::create(100)};
+  int32_t numLoads_{0};
+};
+
+TEST_F(FileMetadataCacheTest, basic) {
+  ASSERT_EQ(FileMetadataCache::getInstance(), cache_);
+  ASSERT_EQ(FileMetadataCache::create(200), cache_);
+
+  const FileMetadataCacheKey key{"a", 1000, 1, FileFormat::PARQUET};
+  auto first = getOrLoad(key);
+  auto second = getOrLoad(key);
+  ASSERT_EQ(numLoads_, 1);
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(cache_->stats().numHits, 1);
+
+  // A new version of the file or another format does not hit.
+  auto rewritten = getOrLoad({"a", 1000, 2, FileFormat::PARQUET});
+  ASSERT_EQ(numLoads_, 2);
+  ASSERT_NE(rewritten, first);
+  getOrLoad({"a", 1000, 1, FileFormat::DWRF});
+  ASSERT_EQ(numLoads_, 3);
+  ASSERT_EQ(cache_->stats().curSize, 30);
+}
+
+TEST_F(FileMetadataCacheTest, eviction) {
+  const FileMetadataCacheKey key{"a", 1000, 1, FileFormat::PARQUET};
+  auto metadata = getOrLoad(key, 60);
+  // Evicting does not invalidate metadata held by readers.
+  getOrLoad({"b", 1000, 1, FileFormat::PARQUET}, 60);
+  ASSERT_EQ(cache_->stats().curSize, 60);
+  ASSERT_EQ(metadata->size(), 60);
+  getOrLoad(key, 60);
+  ASSERT_EQ(numLoads_, 3);
+
+  cache_->clear();
+  ASSERT_EQ(cache_->stats().curSize, 0);
+}
+
+TEST_F(FileMetadataCacheTest, makeKey) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  InMemoryReadFile file(std::string(100, 'x'));
+  ReaderOptions options(pool.get());
+  ASSERT_FALSE(FileMetadataCache::makeKey(file, options).has_value());
+  options.setFileFormat(FileFormat::DWRF).setFileModificationTime(5);
+  const auto key = FileMetadataCache::makeKey(file, options);
+  ASSERT_TRUE(key.has_value());
+  ASSERT_EQ(key->fileSize, 100);
+  ASSERT_EQ(key->modificationTime, 5);
+  ASSERT_EQ(key->format, FileFormat::DWRF);
+}
+
+} // namespace
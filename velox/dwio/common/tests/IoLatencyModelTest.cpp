@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/dwio/common/IoLatencyModel.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+class IoLatencyModelTest : public testing::Test {
+ protected:
+  void TearDown() override {
+    IoLatencyModel::testingClear();
+  }
+
+  // Records reads of alternating sizes from a file system with
+  // 'latencyUs' request latency and 'bytesPerUs' throughput.
+  static void recordReads(
+      IoLatencyModel& model,
+      double latencyUs,
+      double bytesPerUs,
+      int32_t numReads) {
+    for (auto i = 0; i < numReads; ++i) {
+      const uint64_t bytes = (i % 2 == 0 ? 64 : 1024) << 10;
+      model.recordRead(bytes, latencyUs + bytes / bytesPerUs);
+    }
+  }
+};
+
+TEST_F(IoLatencyModelTest, forPath) {
+  auto* local = IoLatencyModel::forPath("/data/file");
+  ASSERT_EQ(IoLatencyModel::forPath("/other/file"), local);
+  auto* s3 = IoLatencyModel::forPath("s3://bucket/file");
+  ASSERT_NE(s3, local);
+  ASSERT_EQ(IoLatencyModel::forPath("s3://other/file"), s3);
+  ASSERT_NE(IoLatencyModel::forPath("hdfs://host/file"), s3);
+}
+
+TEST_F(IoLatencyModelTest, estimate) {
+  IoLatencyModel model;
+  ASSERT_FALSE(model.estimate().has_value());
+  ASSERT_EQ(model.coalesceDistance(512 << 10, 8 << 20), 512 << 10);
+
+  // Object store: 20ms per request, 100MB/s.
+  recordReads(model, 20'000, 100, IoLatencyModel::kMinSamples);
+  auto estimate = model.estimate();
+  ASSERT_TRUE(estimate.has_value());
+  ASSERT_NEAR(estimate->requestLatencyUs, 20'000, 1);
+  ASSERT_NEAR(estimate->usPerByte, 0.01, 1e-6);
+  // Reading 2MB takes as long as a request.
+  ASSERT_NEAR(model.coalesceDistance(512 << 10, 8 << 20), 2'000'000, 10);
+  // Capped by the max distance.
+  ASSERT_EQ(model.coalesceDistance(512 << 10, 1 << 20), 1 << 20);
+}
+
+TEST_F(IoLatencyModelTest, lowLatency) {
+  IoLatencyModel model;
+  // Local SSD: 50us per request, 2GB/s.
+  recordReads(model, 50, 2'000, 2 * IoLatencyModel::kMinSamples);
+  ASSERT_NEAR(model.coalesceDistance(512 << 10, 8 << 20), 100'000, 10);
+
+  // Reads that do not vary in size give no estimate.
+  IoLatencyModel uniform;
+  for (auto i = 0; i < 2 * IoLatencyModel::kMinSamples; ++i) {
+    uniform.recordRead(1 << 20, 1'000);
+  }
+  ASSERT_FALSE(uniform.estimate().has_value());
+  ASSERT_EQ(uniform.coalesceDistance(512 << 10, 8 << 20), 512 << 10);
+}
+
+TEST_F(IoLatencyModelTest, adapts) {
+  IoLatencyModel model;
+  recordReads(model, 50, 2'000, 2 * IoLatencyModel::kMinSamples);
+  const auto localDistance = model.coalesceDistance(512 << 10, 8 << 20);
+  // The latency goes up. The decay lets the new reads dominate.
+  recordReads(model, 5'000, 2'000, 500);
+  ASSERT_GT(model.coalesceDistance(512 << 10, 8 << 20), 10 * localDistance);
+}
+
+} // namespace
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/executors/ManualExecutor.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/common/PrefetchUnitLoader.h"
+#include "velox/dwio/common/tests/utils/UnitLoaderTestTools.h"
+
+using facebook::velox::dwio::common::LoadUnit;
+using facebook::velox::dwio::common::PrefetchUnitLoaderFactory;
+using facebook::velox::dwio::common::test::getUnitsLoadedWithFalse;
+using facebook::velox::dwio::common::test::LoadUnitMock;
+using facebook::velox::dwio::common::test::ReaderMock;
+
+TEST(PrefetchUnitLoaderTests, LoadsAheadWithReader) {
+  size_t blockedOnIoCount = 0;
+  auto executor = std::make_shared<folly::ManualExecutor>();
+  PrefetchUnitLoaderFactory factory(
+      [&](auto) { ++blockedOnIoCount; }, executor, 1, 100);
+  ReaderMock readerMock{{10, 20, 30}, {1, 1, 1}, factory, 0};
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, false}));
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, rows: 0-2, load(0), prefetch(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  executor->drain(); // load(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(7)); // Unit: 0, rows: 3-9
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  // Unit: 1, rows: 0-19, unload(0), prefetch(2)
+  EXPECT_TRUE(readerMock.read(20));
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, false}));
+  EXPECT_EQ(blockedOnIoCount, 2);
+
+  executor->drain(); // load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_TRUE(readerMock.read(30)); // Unit: 2, rows: 0-29, unload(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+  EXPECT_EQ(blockedOnIoCount, 3);
+
+  EXPECT_FALSE(readerMock.read(30)); // No more data
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+}
+
+TEST(PrefetchUnitLoaderTests, LoadsOnCallerIfNotStarted) {
+  auto executor = std::make_shared<folly::ManualExecutor>();
+  PrefetchUnitLoaderFactory factory(nullptr, executor, 2, 100);
+  ReaderMock readerMock{{10, 20, 30}, {1, 1, 1}, factory, 0};
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, prefetch(1), prefetch(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, load(1) on caller, unload(0)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, false}));
+
+  executor->drain(); // load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+}
+
+TEST(PrefetchUnitLoaderTests, RespectsMaxBytesAhead) {
+  auto executor = std::make_shared<folly::ManualExecutor>();
+  PrefetchUnitLoaderFactory factory(nullptr, executor, 3, 25);
+  ReaderMock readerMock{{10, 10, 10, 10}, {10, 10, 10, 10}, factory, 0};
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, prefetch(1), prefetch(2)
+  executor->drain();
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({true, true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 1, unload(0), prefetch(3)
+  executor->drain();
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({false, true, true, true}));
+}
+
+TEST(PrefetchUnitLoaderTests, CancelsOnSeek) {
+  auto executor = std::make_shared<folly::ManualExecutor>();
+  PrefetchUnitLoaderFactory factory(nullptr, executor, 1, 100);
+  ReaderMock readerMock{{10, 20, 30}, {1, 1, 1}, factory, 0};
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, prefetch(1)
+  executor->drain(); // load(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  readerMock.seek(40); // Unit: 2, unload(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 2, unload(0), load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  readerMock.seek(0); // Unit: 0
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, unload(2), load(0), prefetch(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+}
+
+TEST(PrefetchUnitLoaderTests, CancelsOnDestruction) {
+  auto executor = std::make_shared<folly::ManualExecutor>();
+  PrefetchUnitLoaderFactory factory(nullptr, executor, 2, 100);
+  {
+    ReaderMock readerMock{{10, 20, 30}, {1, 1, 1}, factory, 0};
+    EXPECT_TRUE(readerMock.read(3)); // Unit: 0, prefetch(1), prefetch(2)
+  }
+  // The prefetches were cancelled with the reader and do not run.
+  executor->drain();
+}
+
+TEST(PrefetchUnitLoaderTests, UnitOutOfRange) {
+  auto executor = std::make_shared<folly::ManualExecutor>();
+  PrefetchUnitLoaderFactory factory(nullptr, executor, 1, 100);
+  std::vector<std::atomic_bool> unitsLoaded(getUnitsLoadedWithFalse(1));
+  std::vector<std::unique_ptr<LoadUnit>> units;
+  units.push_back(std::make_unique<LoadUnitMock>(10, 0, unitsLoaded, 0));
+
+  auto unitLoader = factory.create(std::move(units), 0);
+  EXPECT_EQ(unitLoader->getLoadedUnit(0).getNumRows(), 10);
+  VELOX_ASSERT_THROW(unitLoader->getLoadedUnit(1), "Unit out of range");
+}
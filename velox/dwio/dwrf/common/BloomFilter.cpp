@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <folly/lang/Bits.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::dwrf {
+namespace {
+constexpr uint64_t kMurmurSeed = 104729;
+constexpr uint64_t kMurmurC1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t kMurmurC2 = 0x4cf5ad432745937fULL;
+constexpr uint64_t kMurmurN1 = 0x52dce729;
+
+uint64_t rotateLeft(uint64_t value, int32_t bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t mixBlock(uint64_t block) {
+  block *= kMurmurC1;
+  block = rotateLeft(block, 31);
+  return block * kMurmurC2;
+}
+
+uint64_t finalMix(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  return hash ^ (hash >> 33);
+}
+
+// Java '>>' on a long.
+uint64_t shiftRightSigned(uint64_t value, int32_t bits) {
+  return static_cast<uint64_t>(static_cast<int64_t>(value) >> bits);
+}
+} // namespace
+
+BloomFilter::BloomFilter(const proto::BloomFilter& proto)
+    : numHashFunctions_(proto.numhashfunctions()) {
+  if (proto.bitset_size() > 0) {
+    bits_.assign(proto.bitset().begin(), proto.bitset().end());
+  } else {
+    const auto& bytes = proto.utf8bitset();
+    VELOX_CHECK_EQ(
+        bytes.size() % sizeof(uint64_t),
+        0,
+        "Bloom filter bitset is not a whole number of words");
+    bits_.resize(bytes.size() / sizeof(uint64_t));
+    for (auto i = 0; i < bits_.size(); ++i) {
+      bits_[i] = folly::Endian::little(
+          folly::loadUnaligned<uint64_t>(bytes.data() + i * sizeof(uint64_t)));
+    }
+  }
+  VELOX_CHECK(!bits_.empty(), "Bloom filter has no bits");
+  VELOX_CHECK_GT(numHashFunctions_, 0, "Bloom filter has no hash functions");
+}
+
+// static
+uint64_t BloomFilter::hashLong(int64_t value) {
+  auto key = static_cast<uint64_t>(value);
+  key = ~key + (key << 21);
+  key ^= shiftRightSigned(key, 24);
+  key = key + (key << 3) + (key << 8);
+  key ^= shiftRightSigned(key, 14);
+  key = key + (key << 2) + (key << 4);
+  key ^= shiftRightSigned(key, 28);
+  return key + (key << 31);
+}
+
+// static
+uint64_t BloomFilter::hashBytes(const char* data, size_t size) {
+  uint64_t hash = kMurmurSeed;
+  const auto numBlocks = size / sizeof(uint64_t);
+  for (auto i = 0; i < numBlocks; ++i) {
+    hash ^= mixBlock(folly::Endian::little(
+        folly::loadUnaligned<uint64_t>(data + i * sizeof(uint64_t))));
+    hash = rotateLeft(hash, 27) * 5 + kMurmurN1;
+  }
+  const auto tailStart = numBlocks * sizeof(uint64_t);
+  if (tailStart < size) {
+    uint64_t tail = 0;
+    for (auto i = size; i > tailStart; --i) {
+      tail = (tail << 8) | static_cast<uint8_t>(data[i - 1]);
+    }
+    hash ^= mixBlock(tail);
+  }
+  hash ^= size;
+  return finalMix(hash);
+}
+
+bool BloomFilter::testHash(uint64_t hash) const {
+  // The positions are computed in 32 bit signed arithmetic like in Java.
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  const int64_t numBits = bits_.size() * 64;
+  for (uint32_t i = 1; i <= numHashFunctions_; ++i) {
+    auto combined = static_cast<int32_t>(hash1 + i * hash2);
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    const auto position = combined % numBits;
+    if ((bits_[position / 64] & (1ULL << (position % 64))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace facebook::velox::dwrf
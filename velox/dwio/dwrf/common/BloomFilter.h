@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+
+namespace facebook::velox::dwrf {
+
+/// Reader side of the Bloom filters in the BLOOM_FILTER_UTF8 streams of ORC
+/// and DWRF files. There is one filter per row group and column. The hashing
+/// follows the ORC Java writer: integers are hashed with Thomas Wang's 64 bit
+/// integer hash and strings with the 64 bit variant of Murmur3 over their
+/// UTF-8 bytes.
+class BloomFilter {
+ public:
+  /// Takes the bits from either the 'bitset' or the 'utf8bitset' of 'proto'.
+  explicit BloomFilter(const proto::BloomFilter& proto);
+
+  /// False if 'value' is definitely not in the set.
+  bool mayContain(int64_t value) const {
+    return testHash(hashLong(value));
+  }
+
+  bool mayContain(std::string_view value) const {
+    return testHash(hashBytes(value.data(), value.size()));
+  }
+
+  static uint64_t hashLong(int64_t value);
+
+  static uint64_t hashBytes(const char* data, size_t size);
+
+ private:
+  bool testHash(uint64_t hash) const;
+
+  uint32_t numHashFunctions_;
+  std::vector<uint64_t> bits_;
+};
+
+} // namespace facebook::velox::dwrf
@@ -105,6 +105,10 @@ inline CompressionOptions getDwrfOrcDecompressionOptions(
  * @param input The input stream that is the underlying source
  * @param bufferSize The maximum size of the buffer
  * @param pool The memory pool
+ * @param decompressionExecutor If set, decompresses the loaded blocks in
+ * parallel on this executor
+ * @param decompressionParallelismFactor The number of threads that decompress
+ * the loaded blocks in parallel
  */
 inline std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     facebook::velox::common::CompressionKind kind,
@@ -112,7 +116,9 @@ inline std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     uint64_t bufferSize,
     memory::MemoryPool& pool,
     const std::string& streamDebugInfo,
-    const dwio::common::encryption::Decrypter* decryptr = nullptr) {
+    const dwio::common::encryption::Decrypter* decryptr = nullptr,
+    folly::Executor* decompressionExecutor = nullptr,
+    size_t decompressionParallelismFactor = 0) {
   const CompressionOptions& options = getDwrfOrcDecompressionOptions(kind);
   return createDecompressor(
       kind,
@@ -121,7 +127,11 @@ inline std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
       pool,
       options,
       streamDebugInfo,
-      decryptr);
+      decryptr,
+      /*useRawDecompression=*/false,
+      /*compressedLength=*/0,
+      decompressionExecutor,
+      decompressionParallelismFactor);
 }
 
 } // namespace facebook::velox::dwrf
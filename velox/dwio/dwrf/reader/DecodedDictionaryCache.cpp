@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/reader/DecodedDictionaryCache.h"
+
+namespace facebook::velox::dwrf {
+
+std::unique_ptr<DecodedDictionaryCache> DecodedDictionaryCache::instance_;
+
+DecodedDictionaryCache::DecodedDictionaryCache(uint64_t maxBytes)
+    : pool_(memory::memoryManager()->addLeafPool("decodedDictionaryCache")),
+      factory_(
+          std::make_unique<SimpleLRUCache<
+              DecodedDictionaryKey,
+              std::shared_ptr<DecodedDictionary>,
+              std::equal_to<DecodedDictionaryKey>,
+              DecodedDictionaryKeyHasher>>(maxBytes),
+          std::make_unique<Generator>(pool_.get())) {}
+
+// static
+DecodedDictionaryCache* DecodedDictionaryCache::create(uint64_t maxBytes) {
+  if (instance_ == nullptr) {
+    instance_ = std::unique_ptr<DecodedDictionaryCache>(
+        new DecodedDictionaryCache(maxBytes));
+  }
+  return instance_.get();
+}
+
+std::unique_ptr<std::shared_ptr<DecodedDictionary>>
+DecodedDictionaryCache::Generator::operator()(
+    const DecodedDictionaryKey& /*key*/,
+    const Loader* load,
+    void* /*stats*/) {
+  auto dictionary = (*load)(pool);
+  VELOX_CHECK_NOT_NULL(dictionary);
+  VELOX_CHECK_NOT_NULL(dictionary->values);
+  VELOX_CHECK_NOT_NULL(dictionary->strings);
+  return std::make_unique<std::shared_ptr<DecodedDictionary>>(
+      std::move(dictionary));
+}
+
+std::shared_ptr<const DecodedDictionary> DecodedDictionaryCache::getOrLoad(
+    const DecodedDictionaryKey& key,
+    const Loader& load) {
+  // Copy the shared_ptr out of the cache so that the entry is unpinned and
+  // stays evictable while readers use the dictionary.
+  auto cached = factory_.generate(key, &load);
+  return *cached;
+}
+
+} // namespace facebook::velox::dwrf
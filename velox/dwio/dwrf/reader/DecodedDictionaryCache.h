@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/buffer/Buffer.h"
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/dwrf/common/Common.h"
+
+namespace facebook::velox::dwrf {
+
+/// Identifies the stripe dictionary of a column in a version of a file.
+struct DecodedDictionaryKey {
+  dwio::common::FileMetadataCacheKey file;
+  uint64_t stripeOffset;
+  EncodingKey encodingKey;
+
+  bool operator==(const DecodedDictionaryKey& other) const {
+    return file == other.file && stripeOffset == other.stripeOffset &&
+        encodingKey == other.encodingKey;
+  }
+};
+
+struct DecodedDictionaryKeyHasher {
+  size_t operator()(const DecodedDictionaryKey& key) const {
+    return bits::hashMix(
+        bits::hashMix(
+            dwio::common::FileMetadataCacheKeyHasher()(key.file),
+            key.stripeOffset),
+        key.encodingKey.hash());
+  }
+};
+
+/// A decoded string dictionary. 'values' holds 'numValues' StringViews that
+/// point into 'strings'. Shared by readers on different threads, so the
+/// buffers must not be modified.
+struct DecodedDictionary {
+  BufferPtr values;
+  BufferPtr strings;
+  int32_t numValues{0};
+  bool isAscii{false};
+
+  /// Returns the bytes charged to the cache for 'this'.
+  uint64_t size() const {
+    return values->capacity() + strings->capacity();
+  }
+};
+
+/// A process-wide, size bounded cache of decoded DWRF and ORC stripe string
+/// dictionaries. Allows concurrent scans of the same files to decode each
+/// dictionary once. The dictionaries are allocated from a leaf pool of the
+/// process memory manager, i.e. from the same memory that backs the
+/// AsyncDataCache, and are dropped in LRU order when the cache is full.
+/// Readers keep a shared_ptr to the dictionary they use, so eviction does not
+/// invalidate it. Only files whose version is known are cached, see
+/// dwio::common::FileMetadataCache::makeKey().
+class DecodedDictionaryCache {
+ public:
+  using Loader =
+      std::function<std::shared_ptr<DecodedDictionary>(memory::MemoryPool*)>;
+
+  /// Creates the process-wide instance holding up to 'maxBytes' of decoded
+  /// dictionaries. Returns the existing instance if already created.
+  static DecodedDictionaryCache* create(uint64_t maxBytes);
+
+  /// Returns the process-wide instance or nullptr if not created.
+  static DecodedDictionaryCache* getInstance() {
+    return instance_.get();
+  }
+
+  static void testingClear() {
+    instance_ = nullptr;
+  }
+
+  /// Returns the dictionary for 'key'. If it is not cached, calls 'load' with
+  /// the pool to allocate the dictionary from and caches the result.
+  /// Concurrent calls for the same key call 'load' only once.
+  std::shared_ptr<const DecodedDictionary> getOrLoad(
+      const DecodedDictionaryKey& key,
+      const Loader& load);
+
+  SimpleLRUCacheStats stats() {
+    return factory_.cacheStats();
+  }
+
+  /// Drops all dictionaries not being loaded. Dictionaries still referenced
+  /// by readers are freed when the last reader drops them.
+  void clear() {
+    factory_.clearCache();
+  }
+
+ private:
+  struct Generator {
+    explicit Generator(memory::MemoryPool* _pool) : pool(_pool) {}
+
+    std::unique_ptr<std::shared_ptr<DecodedDictionary>> operator()(
+        const DecodedDictionaryKey& key,
+        const Loader* load,
+        void* stats);
+
+    memory::MemoryPool* const pool;
+  };
+
+  struct Sizer {
+    uint64_t operator()(
+        const std::shared_ptr<DecodedDictionary>& dictionary) const {
+      return dictionary->size();
+    }
+  };
+
+  explicit DecodedDictionaryCache(uint64_t maxBytes);
+
+  static std::unique_ptr<DecodedDictionaryCache> instance_;
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  CachedFactory<
+      DecodedDictionaryKey,
+      std::shared_ptr<DecodedDictionary>,
+      Generator,
+      Loader,
+      void,
+      Sizer,
+      std::equal_to<DecodedDictionaryKey>,
+      DecodedDictionaryKeyHasher>
+      factory_;
+};
+
+} // namespace facebook::velox::dwrf
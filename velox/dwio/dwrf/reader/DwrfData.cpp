@@ -16,15 +16,97 @@
 
 #include "velox/dwio/dwrf/reader/DwrfData.h"
 
+#include <algorithm>
+
 #include "velox/dwio/common/BufferUtil.h"
 
 namespace facebook::velox::dwrf {
+namespace {
+bool isBloomFilterIntegerType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      // Writers hash decimals as strings.
+      return !type.isDecimal();
+    default:
+      return false;
+  }
+}
+
+// True if the Bloom filters can show that no value of a column of 'type'
+// passes 'filter'. This is the case for equality and IN filters that do not
+// pass nulls.
+bool canUseBloomFilter(const common::Filter& filter, const Type& type) {
+  if (filter.testNull()) {
+    return false;
+  }
+  const bool isString =
+      type.kind() == TypeKind::VARCHAR || type.kind() == TypeKind::VARBINARY;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return static_cast<const common::BigintRange&>(filter).isSingleValue() &&
+          isBloomFilterIntegerType(type);
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      return isBloomFilterIntegerType(type);
+    case common::FilterKind::kBytesRange:
+      return static_cast<const common::BytesRange&>(filter).isSingleValue() &&
+          isString;
+    case common::FilterKind::kBytesValues:
+      return isString;
+    default:
+      return false;
+  }
+}
+
+// False if no value passing 'filter' is in 'bloomFilter'.
+// canUseBloomFilter() must be true for 'filter'.
+bool bloomFilterMatches(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter) {
+  const auto mayContainBigint = [&](int64_t value) {
+    return bloomFilter.mayContain(value);
+  };
+  const auto mayContainBytes = [&](std::string_view value) {
+    return bloomFilter.mayContain(value);
+  };
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return mayContainBigint(
+          static_cast<const common::BigintRange&>(filter).lower());
+    case common::FilterKind::kBigintValuesUsingHashTable: {
+      const auto& values =
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values();
+      return std::any_of(values.begin(), values.end(), mayContainBigint);
+    }
+    case common::FilterKind::kBigintValuesUsingBitmask: {
+      const auto values =
+          static_cast<const common::BigintValuesUsingBitmask&>(filter).values();
+      return std::any_of(values.begin(), values.end(), mayContainBigint);
+    }
+    case common::FilterKind::kBytesRange:
+      return mayContainBytes(
+          static_cast<const common::BytesRange&>(filter).lower());
+    case common::FilterKind::kBytesValues: {
+      const auto& values =
+          static_cast<const common::BytesValues&>(filter).values();
+      return std::any_of(values.begin(), values.end(), mayContainBytes);
+    }
+    default:
+      return true;
+  }
+}
+} // namespace
 
 DwrfData::DwrfData(
     std::shared_ptr<const dwio::common::TypeWithId> fileType,
     StripeStreams& stripe,
     const StreamLabels& streamLabels,
-    FlatMapContext flatMapContext)
+    FlatMapContext flatMapContext,
+    const common::ScanSpec& scanSpec)
     : memoryPool_(stripe.getMemoryPool()),
       fileType_(std::move(fileType)),
       flatMapContext_(std::move(flatMapContext)),
@@ -47,6 +129,20 @@ DwrfData::DwrfData(
       encodingKey.forKind(proto::Stream_Kind_ROW_INDEX),
       streamLabels.label(),
       false);
+
+  // Unlike the index, the Bloom filters are only read for the filters known
+  // at construct time, so that columns without a point filter do not pay for
+  // reading them.
+  if (stripe.bloomFilterPruningEnabled() && scanSpec.filter() &&
+      canUseBloomFilter(*scanSpec.filter(), *fileType_->type())) {
+    // ORC stripe footers are decoded with the DWRF protos, where the ORC
+    // BLOOM_FILTER_UTF8 kind has the number of STRIDE_DICTIONARY.
+    const auto kind = stripe.format() == DwrfFormat::kOrc
+        ? proto::Stream_Kind_STRIDE_DICTIONARY
+        : proto::Stream_Kind_BLOOM_FILTER_UTF8;
+    bloomFilterStream_ = stripe.getStream(
+        encodingKey.forKind(kind), streamLabels.label(), false);
+  }
 }
 
 uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
@@ -91,6 +187,18 @@ void DwrfData::ensureRowGroupIndex() {
   }
 }
 
+bool DwrfData::ensureBloomFilters() {
+  if (bloomFilterStream_) {
+    auto bloomFilterIndex = ProtoUtils::readProto<proto::BloomFilterIndex>(
+        std::move(bloomFilterStream_));
+    bloomFilters_.reserve(bloomFilterIndex->bloomfilter_size());
+    for (const auto& bloomFilter : bloomFilterIndex->bloomfilter()) {
+      bloomFilters_.emplace_back(bloomFilter);
+    }
+  }
+  return !bloomFilters_.empty();
+}
+
 dwio::common::PositionProvider DwrfData::seekToRowGroup(int64_t index) {
   ensureRowGroupIndex();
 
@@ -165,6 +273,11 @@ void DwrfData::filterRowGroups(
         scanSpec.metadataFilterNodeAt(i), std::vector<uint64_t>(nwords));
   }
 
+  // The filter may have changed since construction, e.g. by a dynamic filter
+  // pushed down from a join.
+  const bool useBloomFilters = filter && ensureBloomFilters() &&
+      bloomFilters_.size() == static_cast<size_t>(index_->entry_size()) &&
+      canUseBloomFilter(*filter, *fileType_->type());
   for (auto i = 0; i < index_->entry_size(); ++i) {
     const auto& entry = index_->entry(i);
     const auto columnStats = buildColumnStatisticsFromProto(
@@ -176,6 +289,12 @@ void DwrfData::filterRowGroups(
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
+    if (useBloomFilters && !bloomFilterMatches(*filter, bloomFilters_[i])) {
+      VLOG(1) << "Drop stride " << i << " on Bloom filter of "
+              << scanSpec.toString();
+      bits::setBit(result.filterResult.data(), i);
+      continue;
+    }
 
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
@@ -20,6 +20,7 @@
 #include "velox/dwio/common/FormatData.h"
 #include "velox/dwio/common/TypeWithId.h"
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 #include "velox/dwio/dwrf/common/ByteRLE.h"
 #include "velox/dwio/dwrf/common/RLEv1.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
@@ -36,7 +37,8 @@ class DwrfData : public dwio::common::FormatData {
       std::shared_ptr<const dwio::common::TypeWithId> fileType,
       StripeStreams& stripe,
       const StreamLabels& streamLabels,
-      FlatMapContext flatMapContext);
+      FlatMapContext flatMapContext,
+      const common::ScanSpec& scanSpec);
 
   void readNulls(
       vector_size_t numValues,
@@ -50,6 +52,9 @@ class DwrfData : public dwio::common::FormatData {
     return skipNulls(numValues);
   }
 
+  /// Sets the bits of the row groups that the row index statistics or the
+  /// Bloom filters of 'this' show to have no rows passing the filter of
+  /// 'scanSpec'.
   void filterRowGroups(
       const common::ScanSpec& scanSpec,
       uint64_t rowsPerRowGroup,
@@ -99,12 +104,22 @@ class DwrfData : public dwio::common::FormatData {
         entry.positions().begin(), entry.positions().end());
   }
 
+  // Decodes the Bloom filters of the row groups from 'bloomFilterStream_', if
+  // not already decoded. Returns false if there are none.
+  bool ensureBloomFilters();
+
   memory::MemoryPool& memoryPool_;
   const std::shared_ptr<const dwio::common::TypeWithId> fileType_;
   FlatMapContext flatMapContext_;
   std::unique_ptr<BooleanRleDecoder> notNullDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> indexStream_;
   std::unique_ptr<proto::RowIndex> index_;
+  // The BLOOM_FILTER_UTF8 stream. Only read when Bloom filter pruning is
+  // enabled and the filter of the column is a point filter that the Bloom
+  // filters can decide.
+  std::unique_ptr<dwio::common::SeekableInputStream> bloomFilterStream_;
+  // One Bloom filter per row group after ensureBloomFilters().
+  std::vector<BloomFilter> bloomFilters_;
   int64_t stripeRows_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
@@ -132,9 +147,9 @@ class DwrfParams : public dwio::common::FormatParams {
 
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
-      const common::ScanSpec& /*scanSpec*/) override {
+      const common::ScanSpec& scanSpec) override {
     return std::make_unique<DwrfData>(
-        type, stripeStreams_, streamLabels_, flatMapContext_);
+        type, stripeStreams_, streamLabels_, flatMapContext_, scanSpec);
   }
 
   StripeStreams& stripeStreams() {
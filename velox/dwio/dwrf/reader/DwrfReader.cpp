@@ -19,6 +19,7 @@
 #include <chrono>
 
 #include "velox/dwio/common/OnDemandUnitLoader.h"
+#include "velox/dwio/common/PrefetchUnitLoader.h"
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/reader/ColumnReader.h"
@@ -333,9 +334,21 @@ std::unique_ptr<dwio::common::UnitLoader> DwrfRowReader::getUnitLoader() {
   std::shared_ptr<UnitLoaderFactory> unitLoaderFactory =
       options_.unitLoaderFactory();
   if (!unitLoaderFactory) {
-    unitLoaderFactory =
-        std::make_shared<dwio::common::OnDemandUnitLoaderFactory>(
-            options_.blockedOnIoCallback());
+    // Like the Parquet reader with row groups, loads the next stripes on the
+    // decoding executor while the current one is read.
+    const auto& readerOptions = getReader().readerOptions();
+    if (options_.decodingExecutor() && readerOptions.prefetchRowGroups() > 0) {
+      unitLoaderFactory =
+          std::make_shared<dwio::common::PrefetchUnitLoaderFactory>(
+              options_.blockedOnIoCallback(),
+              options_.decodingExecutor(),
+              readerOptions.prefetchRowGroups(),
+              readerOptions.maxPrefetchBytes());
+    } else {
+      unitLoaderFactory =
+          std::make_shared<dwio::common::OnDemandUnitLoaderFactory>(
+              options_.blockedOnIoCallback());
+    }
   }
   return unitLoaderFactory->create(std::move(loadUnits), 0);
 }
@@ -787,6 +800,15 @@ std::optional<size_t> DwrfRowReader::estimatedRowSize() const {
   return std::nullopt;
 }
 
+std::optional<uint64_t> DwrfRowReader::numRowsInRange() const {
+  const auto& fileFooter = getReader().footer();
+  uint64_t numRows{0};
+  for (auto i = firstStripe_; i < stripeCeiling_; ++i) {
+    numRows += fileFooter.stripes(i).numberOfRows();
+  }
+  return numRows;
+}
+
 DwrfReader::DwrfReader(
     const ReaderOptions& options,
     std::unique_ptr<dwio::common::BufferedInput> input)
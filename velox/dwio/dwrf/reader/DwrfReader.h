@@ -99,6 +99,8 @@ class DwrfRowReader : public StrideIndexProvider,
   /// Estimates the row size for projected columns
   std::optional<size_t> estimatedRowSize() const override;
 
+  std::optional<uint64_t> numRowsInRange() const override;
+
   /// Returns number of rows read. Guaranteed to be less then or equal to size.
   uint64_t next(
       uint64_t size,
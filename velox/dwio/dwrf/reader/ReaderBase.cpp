@@ -19,6 +19,7 @@
 #include <fmt/format.h>
 
 #include "velox/common/process/TraceContext.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/Mutation.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -100,6 +101,30 @@ std::unique_ptr<FooterWrapper> parseFooter(
   return std::make_unique<FooterWrapper>(impl);
 }
 
+// Parsed post script and footer of a DWRF or ORC file in
+// dwio::common::FileMetadataCache. Charged by the serialized size of the tail.
+struct DwrfFileMetadata : public dwio::common::FileMetadata {
+  DwrfFileMetadata(
+      std::shared_ptr<google::protobuf::Arena> _arena,
+      std::shared_ptr<PostScript> _postScript,
+      std::shared_ptr<FooterWrapper> _footer,
+      uint64_t _psLength)
+      : arena(std::move(_arena)),
+        postScript(std::move(_postScript)),
+        footer(std::move(_footer)),
+        psLength(_psLength) {}
+
+  uint64_t size() const override {
+    return 1 + psLength + postScript->footerLength();
+  }
+
+  // Owns the memory of 'footer'.
+  const std::shared_ptr<google::protobuf::Arena> arena;
+  const std::shared_ptr<PostScript> postScript;
+  const std::shared_ptr<FooterWrapper> footer;
+  const uint64_t psLength;
+};
+
 } // namespace
 
 ReaderBase::ReaderBase(
@@ -108,12 +133,51 @@ ReaderBase::ReaderBase(
     : options_{options},
       input_(std::move(input)),
       fileLength_(input_->getReadFile()->size()),
-      arena_(std::make_unique<google::protobuf::Arena>()) {
+      arena_(std::make_shared<google::protobuf::Arena>()) {
   process::TraceContext trace("ReaderBase::ReaderBase");
   // TODO: make a config
   DWIO_ENSURE(fileLength_ > 0, "ORC file is empty");
   VELOX_CHECK_GE(fileLength_, 4, "File size too small");
 
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  const auto key = metadataCache == nullptr
+      ? std::nullopt
+      : dwio::common::FileMetadataCache::makeKey(
+            *input_->getReadFile(), options_);
+  if (key.has_value()) {
+    const auto metadata =
+        std::dynamic_pointer_cast<DwrfFileMetadata>(metadataCache->getOrLoad(
+            key.value(), [&]() -> std::shared_ptr<dwio::common::FileMetadata> {
+              readTail();
+              return std::make_shared<DwrfFileMetadata>(
+                  arena_, postScript_, footer_, psLength_);
+            }));
+    VELOX_CHECK_NOT_NULL(metadata, "Cached file metadata is not DWRF");
+    if (metadata->footer != footer_) {
+      // Cache hit. loadCache() reads the stripe metadata cache from 'input_'.
+      arena_ = metadata->arena;
+      postScript_ = metadata->postScript;
+      footer_ = metadata->footer;
+      psLength_ = metadata->psLength;
+      footerBufferOverread_ = 0;
+      stripeMetadataCacheBuffer_ =
+          AlignedBuffer::allocate<char>(0, &options_.memoryPool());
+      stripeMetadataCacheBufferSize_ = 0;
+    }
+  } else {
+    readTail();
+  }
+
+  schema_ = std::dynamic_pointer_cast<const RowType>(
+      convertType(*footer_, 0, options_.fileColumnNamesReadAsLowerCase()));
+  VELOX_CHECK_NOT_NULL(schema_, "invalid schema");
+
+  // initialize file decrypter
+  handler_ =
+      DecryptionHandler::create(*footer_, options_.decrypterFactory().get());
+}
+
+void ReaderBase::readTail() {
   const auto preloadFile = fileLength_ <= options_.filePreloadThreshold();
   const int64_t footerBufSize =
       std::min(fileLength_, options_.footerEstimatedSize());
@@ -205,14 +269,6 @@ ReaderBase::ReaderBase(
 
   stripeMetadataCacheBuffer_ = footerBuffer;
   stripeMetadataCacheBufferSize_ = footerOffset;
-
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, options_.fileColumnNamesReadAsLowerCase()));
-  VELOX_CHECK_NOT_NULL(schema_, "invalid schema");
-
-  // initialize file decrypter
-  handler_ =
-      DecryptionHandler::create(*footer_, options_.decrypterFactory().get());
 }
 
 void ReaderBase::loadCache() {
@@ -216,14 +216,18 @@ class ReaderBase {
   std::unique_ptr<dwio::common::SeekableInputStream> createDecompressedStream(
       std::unique_ptr<dwio::common::SeekableInputStream> compressed,
       const std::string& streamDebugInfo,
-      const dwio::common::encryption::Decrypter* decrypter = nullptr) const {
+      const dwio::common::encryption::Decrypter* decrypter = nullptr,
+      folly::Executor* decompressionExecutor = nullptr,
+      size_t decompressionParallelismFactor = 0) const {
     return createDecompressor(
         compressionKind(),
         std::move(compressed),
         compressionBlockSize(),
         options_.memoryPool(),
         streamDebugInfo,
-        decrypter);
+        decrypter,
+        decompressionExecutor,
+        decompressionParallelismFactor);
   }
 
   template <typename T>
@@ -258,6 +262,9 @@ class ReaderBase {
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
+  // Reads and parses the post script and footer from 'input_'.
+  void readTail();
+
   static dwio::common::ReaderOptions createReaderOptions(
       memory::MemoryPool& pool,
       dwio::common::FileFormat fileFormat) {
@@ -273,9 +280,11 @@ class ReaderBase {
   BufferPtr stripeMetadataCacheBuffer_;
   int32_t stripeMetadataCacheBufferSize_;
   int32_t footerBufferOverread_;
-  std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
-  std::unique_ptr<FooterWrapper> footer_;
+  // 'arena_', 'postScript_' and 'footer_' may be shared with readers of the
+  // same file through dwio::common::FileMetadataCache.
+  std::shared_ptr<google::protobuf::Arena> arena_;
+  std::shared_ptr<PostScript> postScript_;
+  std::shared_ptr<FooterWrapper> footer_;
   std::unique_ptr<encryption::DecryptionHandler> handler_;
   std::unique_ptr<StripeMetadataCache> cache_;
 
@@ -85,6 +85,15 @@ std::vector<KeyNode<T>> getKeyNodes(
   common::ScanSpec* valuesSpec = nullptr;
   std::unordered_map<KeyValue<T>, common::ScanSpec*, KeyValueHash<T>>
       childSpecs;
+  auto addChildSpec = [&](common::ScanSpec* childSpec) {
+    T key;
+    if constexpr (std::is_same_v<T, StringView>) {
+      key = StringView(childSpec->fieldName());
+    } else {
+      key = folly::to<T>(childSpec->fieldName());
+    }
+    childSpecs[KeyValue<T>(key)] = childSpec;
+  };
   if (!asStruct) {
     keysSpec = scanSpec.getOrCreateChild(common::ScanSpec::kMapKeysFieldName);
     valuesSpec =
@@ -92,15 +101,22 @@ std::vector<KeyNode<T>> getKeyNodes(
     VELOX_CHECK(!valuesSpec->hasFilter());
     keysSpec->setProjectOut(true);
     valuesSpec->setProjectOut(true);
+    // The keys with filters on their values get their own specs, so that
+    // their readers filter the rows before the other keys are read.
+    for (auto& subscript : scanSpec.mapSubscripts()) {
+      VELOX_CHECK(
+          requestedValueType->isPrimitiveType(),
+          "Filters on map subscripts require primitive values: {}",
+          requestedValueType->toString());
+      addChildSpec(subscript.get());
+    }
   } else {
+    VELOX_CHECK(
+        scanSpec.mapSubscripts().empty(),
+        "Filters on map subscripts are not supported on flat maps read as "
+        "structs");
     for (auto& c : scanSpec.children()) {
-      T key;
-      if constexpr (std::is_same_v<T, StringView>) {
-        key = StringView(c->fieldName());
-      } else {
-        key = folly::to<T>(c->fieldName());
-      }
-      childSpecs[KeyValue<T>(key)] = c.get();
+      addChildSpec(c.get());
     }
   }
 
@@ -17,6 +17,7 @@
 #include "velox/dwio/dwrf/reader/SelectiveStringDictionaryColumnReader.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::dwrf {
 
@@ -35,6 +36,7 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
   version_ = convertRleVersion(stripe.getEncoding(encodingKey).kind());
   scanState_.dictionary.numValues =
       stripe.getEncoding(encodingKey).dictionarysize();
+  sharedDictionaryKey_ = stripe.decodedDictionaryKey(encodingKey);
 
   const auto dataId = encodingKey.forKind(proto::Stream_Kind_DATA);
   bool dictVInts = stripe.getUseVInts(dataId);
@@ -100,10 +102,11 @@ uint64_t SelectiveStringDictionaryColumnReader::skip(uint64_t numValues) {
 void SelectiveStringDictionaryColumnReader::loadDictionary(
     SeekableInputStream& data,
     IntDecoder</*isSigned*/ false>& lengthDecoder,
-    DictionaryValues& values) {
+    DictionaryValues& values,
+    memory::MemoryPool* pool) {
   // read lengths from length reader
   dwio::common::ensureCapacity<StringView>(
-      values.values, values.numValues, memoryPool_);
+      values.values, values.numValues, pool);
   // The lengths are read in the low addresses of the string views array.
   auto* lengths = values.values->asMutable<int32_t>();
   lengthDecoder.nextLengths(lengths, values.numValues);
@@ -112,8 +115,12 @@ void SelectiveStringDictionaryColumnReader::loadDictionary(
     stringsBytes += lengths[i];
   }
   // read bytes from underlying string
-  values.strings = AlignedBuffer::allocate<char>(stringsBytes, memoryPool_);
+  values.strings = AlignedBuffer::allocate<char>(stringsBytes, pool);
   data.readFully(values.strings->asMutable<char>(), stringsBytes);
+  // The strings are contiguous without separators, so one pass over the
+  // blob tells whether the whole dictionary is ASCII.
+  values.isAscii = functions::stringCore::isAscii(
+      values.strings->as<char>(), stringsBytes);
   // fill the values with StringViews over the strings. 'strings' will
   // exist even if 'stringsBytes' is 0, which can happen if the only
   // content of the dictionary is the empty string.
@@ -147,7 +154,10 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
     strideDictLengthDecoder_->seekToRowGroup(pp);
 
     loadDictionary(
-        *strideDictStream_, *strideDictLengthDecoder_, scanState_.dictionary2);
+        *strideDictStream_,
+        *strideDictLengthDecoder_,
+        scanState_.dictionary2,
+        memoryPool_);
   }
   lastStrideIndex_ = nextStride;
   dictionaryValues_ = nullptr;
@@ -196,6 +206,11 @@ void SelectiveStringDictionaryColumnReader::makeDictionaryBaseVector() {
         scanState_.dictionary.values,
         std::vector<BufferPtr>{scanState_.dictionary.strings});
   }
+  // Functions see the dictionary values after peeling the indices, so they
+  // skip checking the strings for ASCII again.
+  if (isDictionaryAscii()) {
+    dictionaryValues_->setAllIsAscii(true);
+  }
 }
 
 void SelectiveStringDictionaryColumnReader::read(
@@ -262,13 +277,17 @@ void SelectiveStringDictionaryColumnReader::makeFlat(VectorPtr* result) {
       stringViews[i] = strideDict[j - scanState_.dictionary.numValues];
     }
   }
-  *result = std::make_shared<FlatVector<StringView>>(
+  auto flat = std::make_shared<FlatVector<StringView>>(
       memoryPool_,
       requestedType(),
       std::move(nulls),
       numValues_,
       std::move(values),
       std::move(stringBuffers));
+  if (isDictionaryAscii()) {
+    flat->setAllIsAscii(true);
+  }
+  *result = std::move(flat);
   statistics_.flattenStringDictionaryValues += numValues_;
 }
 
@@ -296,6 +315,33 @@ void SelectiveStringDictionaryColumnReader::getValues(
       memoryPool_, resultNulls(), numValues_, dictionaryValues_, values_);
 }
 
+void SelectiveStringDictionaryColumnReader::loadStripeDictionary() {
+  if (!sharedDictionaryKey_.has_value()) {
+    loadDictionary(
+        *blobStream_, *lengthDecoder_, scanState_.dictionary, memoryPool_);
+    return;
+  }
+  const auto numValues = scanState_.dictionary.numValues;
+  auto dictionary = DecodedDictionaryCache::getInstance()->getOrLoad(
+      sharedDictionaryKey_.value(), [&](memory::MemoryPool* pool) {
+        DictionaryValues values;
+        values.numValues = numValues;
+        loadDictionary(*blobStream_, *lengthDecoder_, values, pool);
+        auto decoded = std::make_shared<DecodedDictionary>();
+        decoded->values = std::move(values.values);
+        decoded->strings = std::move(values.strings);
+        decoded->numValues = numValues;
+        decoded->isAscii = values.isAscii;
+        return decoded;
+      });
+  VELOX_CHECK_EQ(dictionary->numValues, numValues);
+  // The buffers are shared with the cache and other readers and are not
+  // modified after this.
+  scanState_.dictionary.values = dictionary->values;
+  scanState_.dictionary.strings = dictionary->strings;
+  scanState_.dictionary.isAscii = dictionary->isAscii;
+}
+
 void SelectiveStringDictionaryColumnReader::ensureInitialized() {
   if (LIKELY(initialized_)) {
     return;
@@ -303,7 +349,7 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
 
   ClockTimer timer{initTimeClocks_};
 
-  loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
+  loadStripeDictionary();
 
   if (DictionaryValues::hasFilter(scanSpec_->filter())) {
     scanState_.filterCache.resize(scanState_.dictionary.numValues);
@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
+#include "velox/dwio/dwrf/reader/DecodedDictionaryCache.h"
 #include "velox/dwio/dwrf/reader/DwrfData.h"
 
 namespace facebook::velox::dwrf {
@@ -73,15 +74,27 @@ class SelectiveStringDictionaryColumnReader
   void readWithVisitor(TVisitor visitor);
 
   // Fills 'values' from 'data' and 'lengthDecoder'. The count of
-  // values is in 'values.numValues'.
+  // values is in 'values.numValues'. The buffers are allocated from 'pool'.
   void loadDictionary(
       dwio::common::SeekableInputStream& data,
       dwio::common::IntDecoder</*isSigned*/ false>& lengthDecoder,
-      dwio::common::DictionaryValues& values);
+      dwio::common::DictionaryValues& values,
+      memory::MemoryPool* pool);
+
+  // Loads the stripe dictionary into 'scanState_.dictionary', from the
+  // DecodedDictionaryCache if the dictionary is shared with other readers.
+  void loadStripeDictionary();
   void ensureInitialized();
 
   void makeFlat(VectorPtr* result);
 
+  // True if the stripe and stride dictionaries are all ASCII.
+  bool isDictionaryAscii() const {
+    return scanState_.dictionary.isAscii &&
+        (scanState_.dictionary2.numValues == 0 ||
+         scanState_.dictionary2.isAscii);
+  }
+
   std::unique_ptr<dwio::common::IntDecoder</*isSigned*/ false>> dictIndex_;
   std::unique_ptr<ByteRleDecoder> inDictionaryReader_;
   std::unique_ptr<dwio::common::SeekableInputStream> strideDictStream_;
@@ -101,6 +114,8 @@ class SelectiveStringDictionaryColumnReader
   // lazy load the dictionary
   std::unique_ptr<dwio::common::IntDecoder</*isSigned*/ false>> lengthDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> blobStream_;
+  // Key of the stripe dictionary in the DecodedDictionaryCache if shared.
+  std::optional<DecodedDictionaryKey> sharedDictionaryKey_;
   bool initialized_{false};
   int64_t numRowsScanned_;
 };
@@ -309,10 +309,16 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
 
   const auto streamDebugInfo =
       fmt::format("Stripe {} Stream {}", stripeIndex_, si.toString());
+  // The data streams of a stripe are loaded in large coalesced ranges, so
+  // their blocks can be decompressed in parallel ahead of the reader. The
+  // index streams are small and read once.
+  const bool parallel = !isIndexStream(si.kind());
   return readState_->readerBase->createDecompressedStream(
       std::move(streamInput),
       streamDebugInfo,
-      getDecrypter(si.encodingKey().node()));
+      getDecrypter(si.encodingKey().node()),
+      parallel ? opts_.decodingExecutor().get() : nullptr,
+      parallel ? opts_.decodingParallelismFactor() : 0);
 }
 
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
@@ -337,6 +343,24 @@ bool StripeStreamsImpl::getUseVInts(const DwrfStreamIdentifier& si) const {
   return info.getUseVInts();
 }
 
+std::optional<DecodedDictionaryKey> StripeStreamsImpl::decodedDictionaryKey(
+    const EncodingKey& encodingKey) const {
+  const auto& readerBase = *readState_->readerBase;
+  // Decrypted dictionaries are not shared with readers that may not have the
+  // keys.
+  if (DecodedDictionaryCache::getInstance() == nullptr ||
+      readerBase.decryptionHandler().isEncrypted(encodingKey.node())) {
+    return std::nullopt;
+  }
+  auto file = dwio::common::FileMetadataCache::makeKey(
+      *readerBase.bufferedInput().getReadFile(), readerBase.readerOptions());
+  if (!file.has_value()) {
+    return std::nullopt;
+  }
+  return DecodedDictionaryKey{
+      std::move(file.value()), stripeStart_, encodingKey};
+}
+
 std::unique_ptr<dwio::common::SeekableInputStream>
 StripeStreamsImpl::getIndexStreamFromCache(
     const StreamInformation& info) const {
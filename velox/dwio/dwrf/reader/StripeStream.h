@@ -21,6 +21,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
+#include "velox/dwio/dwrf/reader/DecodedDictionaryCache.h"
 #include "velox/dwio/dwrf/reader/StreamLabels.h"
 #include "velox/dwio/dwrf/reader/StripeDictionaryCache.h"
 #include "velox/dwio/dwrf/reader/StripeReaderBase.h"
@@ -110,6 +111,10 @@ class StripeStreams {
   /// Get row reader options
   virtual const dwio::common::RowReaderOptions& rowReaderOptions() const = 0;
 
+  /// Whether row groups may be skipped based on the Bloom filters of the
+  /// columns with equality or IN filters.
+  virtual bool bloomFilterPruningEnabled() const = 0;
+
   /// Get the encoding for the given column for this stripe.
   virtual const proto::ColumnEncoding& getEncoding(
       const EncodingKey&) const = 0;
@@ -138,6 +143,14 @@ class StripeStreams {
 
   virtual std::shared_ptr<StripeDictionaryCache> getStripeDictionaryCache() = 0;
 
+  /// Returns the key of the stripe dictionary of 'encodingKey' in the
+  /// process-wide DecodedDictionaryCache or std::nullopt if the dictionary is
+  /// not shared with other readers.
+  virtual std::optional<DecodedDictionaryKey> decodedDictionaryKey(
+      const EncodingKey& /*encodingKey*/) const {
+    return std::nullopt;
+  }
+
   /// visit all streams of given node and execute visitor logic
   /// return number of streams visited
   virtual uint32_t visitStreamsOfNode(
@@ -179,6 +192,10 @@ class StripeStreamsBase : public StripeStreams {
     return DwrfFormat::kDwrf;
   }
 
+  bool bloomFilterPruningEnabled() const override {
+    return false;
+  }
+
   std::function<BufferPtr()> getIntDictionaryInitializerForNode(
       const EncodingKey& ek,
       uint64_t elementWidth,
@@ -237,6 +254,10 @@ class StripeStreamsImpl : public StripeStreamsBase {
     return readState_->readerBase->format();
   }
 
+  bool bloomFilterPruningEnabled() const override {
+    return readState_->readerBase->readerOptions().bloomFilterPruningEnabled();
+  }
+
   const dwio::common::ColumnSelector& getColumnSelector() const override {
     return *selector_;
   }
@@ -298,6 +319,9 @@ class StripeStreamsImpl : public StripeStreamsBase {
 
   bool getUseVInts(const DwrfStreamIdentifier& si) const override;
 
+  std::optional<DecodedDictionaryKey> decodedDictionaryKey(
+      const EncodingKey& encodingKey) const override;
+
   const StrideIndexProvider& getStrideIndexProvider() const override {
     return provider_;
   }
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/Exceptions.h"
+
+using namespace facebook::velox::dwrf;
+
+namespace {
+// Sets the bits of 'hash' in 'bits' the way the ORC Java writer does.
+void addHash(
+    uint64_t hash,
+    uint32_t numHashFunctions,
+    std::vector<uint64_t>& bits) {
+  const auto hash1 = static_cast<int32_t>(hash);
+  const auto hash2 = static_cast<int32_t>(hash >> 32);
+  const int64_t numBits = bits.size() * 64;
+  for (uint32_t i = 1; i <= numHashFunctions; ++i) {
+    auto combined = static_cast<int32_t>(
+        static_cast<uint32_t>(hash1) + i * static_cast<uint32_t>(hash2));
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    const auto position = combined % numBits;
+    bits[position / 64] |= 1ULL << (position % 64);
+  }
+}
+
+proto::BloomFilter makeProto(
+    const std::vector<uint64_t>& bits,
+    uint32_t numHashFunctions,
+    bool utf8) {
+  proto::BloomFilter proto;
+  proto.set_numhashfunctions(numHashFunctions);
+  if (utf8) {
+    proto.set_utf8bitset(std::string(
+        reinterpret_cast<const char*>(bits.data()),
+        bits.size() * sizeof(uint64_t)));
+  } else {
+    for (auto word : bits) {
+      proto.add_bitset(word);
+    }
+  }
+  return proto;
+}
+} // namespace
+
+TEST(BloomFilterTest, hash) {
+  // Values of the ORC Java implementation.
+  EXPECT_EQ(BloomFilter::hashLong(0), 0ULL);
+  EXPECT_EQ(BloomFilter::hashLong(1), 6614235796240398542ULL);
+  EXPECT_EQ(BloomFilter::hashLong(-1), 6614246905173314819ULL);
+  EXPECT_EQ(BloomFilter::hashLong(123456789), 16581954974024456952ULL);
+  EXPECT_EQ(BloomFilter::hashBytes("", 0), 8404154273843829576ULL);
+  EXPECT_EQ(BloomFilter::hashBytes("a", 1), 15986002618429608327ULL);
+  EXPECT_EQ(BloomFilter::hashBytes("abcdefg", 7), 1028602747570965258ULL);
+  EXPECT_EQ(BloomFilter::hashBytes("abcdefgh", 8), 729624805048849005ULL);
+  EXPECT_EQ(
+      BloomFilter::hashBytes("abcdefghijklmnopq", 17), 14876738310967886804ULL);
+  EXPECT_EQ(
+      BloomFilter::hashBytes("hello world", 11), 13288150786092020396ULL);
+}
+
+TEST(BloomFilterTest, mayContain) {
+  constexpr uint32_t kNumHashFunctions = 4;
+  std::vector<uint64_t> bits(64);
+  for (int64_t i = 0; i < 100; ++i) {
+    addHash(BloomFilter::hashLong(i * 7), kNumHashFunctions, bits);
+    const auto value = fmt::format("value{}", i);
+    addHash(
+        BloomFilter::hashBytes(value.data(), value.size()),
+        kNumHashFunctions,
+        bits);
+  }
+
+  for (auto utf8 : {false, true}) {
+    SCOPED_TRACE(fmt::format("utf8 {}", utf8));
+    BloomFilter bloomFilter(makeProto(bits, kNumHashFunctions, utf8));
+    int32_t numFalsePositives = 0;
+    for (int64_t i = 0; i < 100; ++i) {
+      EXPECT_TRUE(bloomFilter.mayContain(i * 7));
+      EXPECT_TRUE(bloomFilter.mayContain(fmt::format("value{}", i)));
+      numFalsePositives += bloomFilter.mayContain(i * 7 + 1);
+      numFalsePositives += bloomFilter.mayContain(fmt::format("other{}", i));
+    }
+    EXPECT_LT(numFalsePositives, 20);
+  }
+}
+
+TEST(BloomFilterTest, invalid) {
+  proto::BloomFilter proto;
+  proto.set_numhashfunctions(3);
+  proto.set_utf8bitset(std::string(12, 'a'));
+  EXPECT_THROW(BloomFilter{proto}, facebook::velox::VeloxRuntimeError);
+  proto.set_utf8bitset("");
+  EXPECT_THROW(BloomFilter{proto}, facebook::velox::VeloxRuntimeError);
+}
@@ -42,6 +42,16 @@ using memory::MemoryAllocator;
 using IoStatisticsPtr = std::shared_ptr<IoStatistics>;
 DECLARE_bool(velox_ssd_odirect);
 
+namespace {
+uint64_t totalCount(const io::IoLatencyHistogram& histogram) {
+  uint64_t count = 0;
+  for (auto i = 0; i < io::IoLatencyHistogram::kNumBuckets; ++i) {
+    count += histogram.count(i);
+  }
+  return count;
+}
+} // namespace
+
 class CacheTest : public ::testing::Test {
  protected:
   static constexpr int32_t kMaxStreams = 50;
@@ -560,6 +570,30 @@ TEST_F(CacheTest, bufferedInput) {
       fsStats_);
 }
 
+TEST_F(CacheTest, ioLatencyHistogram) {
+  using io::IoLatencyHistogram;
+  ASSERT_EQ(IoLatencyHistogram::bucket(0), 0);
+  ASSERT_EQ(IoLatencyHistogram::bucket(99), 0);
+  ASSERT_EQ(IoLatencyHistogram::bucket(100), 1);
+  ASSERT_EQ(IoLatencyHistogram::bucket(999'999), 4);
+  ASSERT_EQ(
+      IoLatencyHistogram::bucket(60'000'000),
+      IoLatencyHistogram::kNumBuckets - 1);
+  ASSERT_EQ(IoLatencyHistogram::bucketName(1), "1ms");
+  ASSERT_EQ(IoLatencyHistogram::bucketName(5), ">1s");
+
+  IoLatencyHistogram histogram;
+  histogram.record(50);
+  histogram.record(5'000);
+  histogram.record(7'000);
+  IoLatencyHistogram other;
+  other.record(10);
+  histogram.merge(other);
+  ASSERT_EQ(histogram.count(0), 2);
+  ASSERT_EQ(histogram.count(1), 0);
+  ASSERT_EQ(histogram.count(2), 2);
+}
+
 // Calibrates the data read for a densely and sparsely read stripe of test data.
 // Fills the SSD cache with test data. Reads 2x cache size worth of data and
 // checks that the cache population settles to a stable state.  Shifts the
@@ -587,6 +621,11 @@ TEST_F(CacheTest, ssd) {
   EXPECT_EQ(0, ioStats_->ramHit().sum());
   // Expect some extra reading from coalescing.
   EXPECT_LT(0, ioStats_->rawOverreadBytes());
+  // Each coalesced load is either found complete or waited for.
+  EXPECT_LT(
+      0,
+      ioStats_->prefetchHit().count() + ioStats_->prefetchMissWait().count());
+  EXPECT_LT(0, totalCount(ioStats_->storageReadLatency()));
   auto fullStripeBytes = ioStats_->rawBytesRead();
   auto bytes = ioStats_->rawBytesRead();
   cache_->clear();
@@ -626,6 +665,7 @@ TEST_F(CacheTest, ssd) {
       4);
   // Expect some hits from SSD.
   EXPECT_LE(kSsdBytes / 8, ioStats_->ssdRead().sum());
+  EXPECT_LT(0, totalCount(ioStats_->ssdReadLatency()));
   // We expec some prefetch but the quantity is nondeterminstic
   // because cases where the main thread reads the data ahead of
   // background reader does not count as prefetch even if prefetch was
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/reader/DecodedDictionaryCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+namespace {
+
+class DecodedDictionaryCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void TearDown() override {
+    DecodedDictionaryCache::testingClear();
+  }
+
+  static DecodedDictionaryKey makeKey(
+      uint64_t stripeOffset,
+      uint32_t node,
+      int64_t modificationTime = 1) {
+    return {
+        {"file", 1000, modificationTime, dwio::common::FileFormat::DWRF},
+        stripeOffset,
+        EncodingKey{node}};
+  }
+
+  // Loads a dictionary of 'numValues' one byte strings.
+  std::shared_ptr<const DecodedDictionary> getOrLoad(
+      const DecodedDictionaryKey& key,
+      int32_t numValues = 10) {
+    return cache_->getOrLoad(key, [&](memory::MemoryPool* pool) {
+      ++numLoads_;
+      auto dictionary = std::make_shared<DecodedDictionary>();
+      dictionary->numValues = numValues;
+      dictionary->strings = AlignedBuffer::allocate<char>(numValues, pool);
+      dictionary->values = AlignedBuffer::allocate<StringView>(numValues, pool);
+      auto* strings = dictionary->strings->asMutable<char>();
+      auto* views = dictionary->values->asMutable<StringView>();
+      for (auto i = 0; i < numValues; ++i) {
+        strings[i] = 'a' + i % 26;
+        views[i] = StringView(strings + i, 1);
+      }
+      return dictionary;
+    });
+  }
+
+  DecodedDictionaryCache* cache_{DecodedDictionaryCache::create(1 << 20)};
+  int32_t numLoads_{0};
+};
+
+TEST_F(DecodedDictionaryCacheTest, basic) {
+  ASSERT_EQ(DecodedDictionaryCache::getInstance(), cache_);
+  ASSERT_EQ(DecodedDictionaryCache::create(100), cache_);
+
+  auto first = getOrLoad(makeKey(3, 1));
+  auto second = getOrLoad(makeKey(3, 1));
+  ASSERT_EQ(numLoads_, 1);
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(cache_->stats().numHits, 1);
+  ASSERT_EQ(first->values->as<StringView>()[2], StringView("c"));
+
+  // Another stripe, column or file version does not hit.
+  getOrLoad(makeKey(4, 1));
+  getOrLoad(makeKey(3, 2));
+  getOrLoad(makeKey(3, 1, 2));
+  ASSERT_EQ(numLoads_, 4);
+  ASSERT_EQ(cache_->stats().numElements, 4);
+  ASSERT_EQ(cache_->stats().curSize, 4 * first->size());
+}
+
+TEST_F(DecodedDictionaryCacheTest, eviction) {
+  const int32_t numValues = 10'000;
+  auto first = getOrLoad(makeKey(0, 1), numValues);
+  const auto dictionarySize = first->size();
+  const auto numFit = (1 << 20) / dictionarySize;
+  for (auto i = 1; i <= numFit; ++i) {
+    getOrLoad(makeKey(i, 1), numValues);
+  }
+  ASSERT_LE(cache_->stats().curSize, 1 << 20);
+  ASSERT_LT(cache_->stats().numElements, numFit + 1);
+
+  // The evicted dictionary stays valid for its reader.
+  ASSERT_EQ(first->values->as<StringView>()[1], StringView("b"));
+  getOrLoad(makeKey(0, 1), numValues);
+  ASSERT_EQ(numLoads_, numFit + 2);
+
+  cache_->clear();
+  ASSERT_EQ(cache_->stats().numElements, 0);
+}
+
+} // namespace
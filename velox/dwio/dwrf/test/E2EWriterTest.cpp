@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -1634,6 +1635,70 @@ TEST_F(E2EWriterTest, fuzzFlatmap) {
   }
 }
 
+TEST_F(E2EWriterTest, parallelEncoding) {
+  const auto type = ROW({
+      {"int_val", BIGINT()},
+      {"string_val", VARCHAR()},
+      {"double_val", DOUBLE()},
+      {"flatmap", MAP(INTEGER(), VARCHAR())},
+      {"map", MAP(VARCHAR(), BIGINT())},
+      {"array", ARRAY(INTEGER())},
+      {"row", ROW({{"a", INTEGER()}, {"b", VARCHAR()}})},
+  });
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set(dwrf::Config::MAP_FLAT_COLS, {3});
+  config->set(dwrf::Config::MAP_STATISTICS, true);
+
+  const size_t numBatches = 10;
+  const size_t batchSize = 1'000;
+  std::vector<VectorPtr> batches;
+  for (size_t i = 0; i < numBatches; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, batchSize, *leafPool_, nullptr, i));
+  }
+
+  const auto writeFile = [&](std::shared_ptr<folly::Executor> executor) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = std::move(executor);
+    options.encodingParallelismFactor = 4;
+    // Flush a stripe every three batches.
+    options.flushPolicyFactory = []() {
+      return std::make_unique<dwrf::LambdaFlushPolicy>(
+          [count = 0]() mutable { return ++count % 3 == 0; });
+    };
+    dwrf::Writer writer{std::move(sink), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto serialFile = writeFile(nullptr);
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  for (auto i = 0; i < 3; ++i) {
+    ASSERT_EQ(writeFile(executor), serialFile);
+  }
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = std::make_unique<dwrf::DwrfReader>(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(serialFile),
+          readerOpts.memoryPool()));
+  ASSERT_EQ(reader->getNumberOfStripes(), 4u);
+  ASSERT_EQ(reader->numberOfRows().value(), numBatches * batchSize);
+}
+
 TEST_F(E2EWriterTest, memoryConfigError) {
   const auto type = ROW(
       {{"int_val", INTEGER()},
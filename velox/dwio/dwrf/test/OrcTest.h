@@ -116,6 +116,10 @@ class MockStripeStreams : public StripeStreams {
     return false;
   }
 
+  bool bloomFilterPruningEnabled() const override {
+    return false;
+  }
+
   const dwio::common::RowReaderOptions& rowReaderOptions() const override {
     auto ptr = getRowReaderOptionsProxy();
     return ptr ? *ptr : options_;
@@ -2412,6 +2412,67 @@ TEST_F(TestReader, readFlatMapsWithNullMaps) {
   }
 }
 
+TEST_F(TestReader, readFlatMapsWithSubscriptFilters) {
+  // Key 1 is in all maps, key 2 in the even maps and key 7 in none.
+  constexpr int32_t kSize = 100;
+  std::vector<vector_size_t> offsets;
+  std::vector<int64_t> keys;
+  std::vector<int64_t> values;
+  for (auto i = 0; i < kSize; ++i) {
+    offsets.push_back(keys.size());
+    keys.push_back(1);
+    values.push_back(i);
+    if (i % 2 == 0) {
+      keys.push_back(2);
+      values.push_back(i * 10);
+    }
+  }
+  offsets.push_back(keys.size());
+  auto maps =
+      makeMapVector(offsets, makeFlatVector(keys), makeFlatVector(values));
+  auto row = makeRowVector({"a"}, {maps});
+
+  std::shared_ptr<dwrf::Config> config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set(dwrf::Config::MAP_FLAT_COLS, {0});
+  auto [writer, reader] = createWriterReader({row}, pool(), config);
+  auto schema = asRowType(row->type());
+
+  auto read = [&](const std::string& key,
+                  std::unique_ptr<common::Filter> filter) {
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*schema);
+    spec->childByName("a")->getOrCreateMapSubscript(key)->setFilter(
+        std::move(filter));
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    VectorPtr batch = BaseVector::create(schema, 0, pool());
+    EXPECT_EQ(rowReader->next(kSize, batch), kSize);
+    auto* rowVector = batch->as<RowVector>();
+    return BaseVector::loadedVectorShared(rowVector->childAt(0));
+  };
+
+  // a[2] between 0 and 400 passes in the even maps up to 40.
+  auto result = read("2", std::make_unique<common::BigintRange>(0, 400, false));
+  std::vector<vector_size_t> indices;
+  for (auto i = 0; i <= 40; i += 2) {
+    indices.push_back(i);
+  }
+  assertEqualVectors(
+      BaseVector::wrapInDictionary(
+          nullptr, makeIndices(indices), indices.size(), maps),
+      result);
+
+  // A missing key is null.
+  result = read("7", std::make_unique<common::BigintRange>(0, 400, false));
+  ASSERT_EQ(result->size(), 0);
+  result = read("7", std::make_unique<common::IsNull>());
+  assertEqualVectors(maps, result);
+  result = read("2", std::make_unique<common::IsNull>());
+  ASSERT_EQ(result->size(), kSize / 2);
+}
+
 TEST_F(TestReader, readStructWithWholeBatchFiltered) {
   // Test reading a struct with a pushdown filter that filters out all rows
   // for a certain batch.
@@ -2508,6 +2569,11 @@ TEST_F(TestReader, readStringDictionaryAsFlat) {
   ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::DICTIONARY);
   ASSERT_TRUE(c0->valueVector()->isFlatEncoding());
   ASSERT_EQ(c0->valueVector()->size(), dictionary.size());
+  // The dictionary is all ASCII, which is found when loading it.
+  ASSERT_TRUE(c0->valueVector()
+                  ->as<SimpleVector<StringView>>()
+                  ->isKnownAllAscii());
+  ASSERT_TRUE(c0->as<SimpleVector<StringView>>()->isKnownAllAscii());
   dwio::common::RuntimeStatistics stats;
   rowReader->updateRuntimeStats(stats);
   ASSERT_EQ(stats.columnReaderStatistics.flattenStringDictionaryValues, 0);
@@ -2518,11 +2584,50 @@ TEST_F(TestReader, readStringDictionaryAsFlat) {
   ASSERT_EQ(rowReader->next(20, actual), 20);
   ASSERT_EQ(actual->size(), 1);
   ASSERT_TRUE(actual->as<RowVector>()->childAt(0)->isFlatEncoding());
+  ASSERT_TRUE(actual->as<RowVector>()
+                  ->childAt(0)
+                  ->as<SimpleVector<StringView>>()
+                  ->isKnownAllAscii());
   stats = {};
   rowReader->updateRuntimeStats(stats);
   ASSERT_EQ(stats.columnReaderStatistics.flattenStringDictionaryValues, 1);
 }
 
+TEST_F(TestReader, readStringDictionaryNonAscii) {
+  std::vector<std::string> dictionary = {"abc", "\u00e9t\u00e9", "xyz"};
+  auto indices = allocateIndices(200, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  for (int i = 0; i < 200; ++i) {
+    rawIndices[i] = i % dictionary.size();
+  }
+  auto batch = makeRowVector({
+      BaseVector::wrapInDictionary(
+          nullptr, indices, 200, makeFlatVector(dictionary)),
+  });
+  auto [writer, reader] = createWriterReader(
+      {batch},
+      pool(),
+      std::make_shared<dwrf::Config>(),
+      E2EWriterTestUtil::simpleFlushPolicyFactory(false));
+  auto rowType = reader->rowType();
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto actual = BaseVector::create(rowType, 0, pool());
+  ASSERT_EQ(rowReader->next(20, actual), 20);
+  auto* c0 = actual->as<RowVector>()->childAt(0)->loadedVector();
+  ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_FALSE(c0->valueVector()
+                   ->as<SimpleVector<StringView>>()
+                   ->isKnownAllAscii());
+  ASSERT_FALSE(c0->as<SimpleVector<StringView>>()->isKnownAllAscii());
+  assertEqualVectors(
+      batch->childAt(0)->slice(0, 20),
+      actual->as<RowVector>()->childAt(0));
+}
+
 // A primitive subfield is missing in file, and result is not reused.
 TEST_F(TestReader, missingSubfieldsNoResultReusing) {
   constexpr int kSize = 10;
@@ -18,11 +18,13 @@
 #include <folly/String.h>
 #include <folly/compression/Compression.h>
 #include <folly/compression/Zlib.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/dwio/common/compression/ParallelPagedInputStream.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <cstdio>
@@ -1175,3 +1177,90 @@ TEST_F(TestSeek, uncompressedLarge) {
     } while (readSize < targetSize);
   }
 }
+
+TEST_F(TestSeek, parallel) {
+  constexpr int32_t kNumBlocks = 40;
+  constexpr int32_t kBlockSize = 1024;
+  constexpr int32_t kSkipped = 100;
+  // Every tenth block is stored uncompressed and ends a batch.
+  auto isOriginal = [](int32_t block) { return block % 10 == 5; };
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  std::vector<std::pair<std::unique_ptr<Codec>, CompressionKind>> codecs;
+  codecs.emplace_back(
+      zlib::getCodec(
+          zlib::Options(zlib::Options::Format::RAW), COMPRESSION_LEVEL_DEFAULT),
+      CompressionKind_ZLIB);
+  codecs.emplace_back(getCodec(CodecType::ZSTD), CompressionKind_ZSTD);
+  codecs.emplace_back(getCodec(CodecType::SNAPPY), CompressionKind_SNAPPY);
+
+  for (auto& [codec, kind] : codecs) {
+    SCOPED_TRACE(compressionKindToString(kind));
+    std::vector<std::vector<char>> blocks(
+        kNumBlocks, std::vector<char>(kBlockSize));
+    std::vector<char> output(kNumBlocks * (2 * kBlockSize + 3));
+    std::vector<uint64_t> headerOffsets;
+    std::string expected;
+    size_t offset = 0;
+    for (auto i = 0; i < kNumBlocks; ++i) {
+      fillInput(blocks[i].data(), kBlockSize);
+      expected.append(blocks[i].data(), kBlockSize);
+      headerOffsets.push_back(offset);
+      if (isOriginal(i)) {
+        writeHeader(output.data() + offset, kBlockSize, true);
+        ::memcpy(output.data() + offset + 3, blocks[i].data(), kBlockSize);
+        offset += kBlockSize + 3;
+      } else {
+        offset = compress(
+            blocks[i].data(), kBlockSize, output.data(), offset, *codec);
+      }
+    }
+    // The stream is read in 3 ranges that end inside blocks.
+    auto stream = createDecompressor(
+        kind,
+        std::make_unique<SeekableArrayInputStream>(
+            output.data(), offset, offset / 3 + 1),
+        kBlockSize,
+        *pool_,
+        "TestSeek Decompressor",
+        nullptr,
+        executor.get(),
+        4);
+    ASSERT_NE(
+        dynamic_cast<dwio::common::compression::ParallelPagedInputStream*>(
+            stream.get()),
+        nullptr);
+
+    std::string actual;
+    const void* data;
+    int32_t size;
+    while (stream->Next(&data, &size)) {
+      actual.append(reinterpret_cast<const char*>(data), size);
+    }
+    ASSERT_EQ(expected, actual);
+
+    for (auto block : {7, 0, 25, 26, 3, kNumBlocks - 1, 8}) {
+      SCOPED_TRACE(fmt::format("block {}", block));
+      std::vector<uint64_t> positions{headerOffsets[block], kSkipped};
+      PositionProvider provider(positions);
+      stream->seekToPosition(provider);
+      ASSERT_TRUE(stream->Next(&data, &size));
+      if (isOriginal(block)) {
+        // An uncompressed block may be returned in pieces.
+        ASSERT_GT(size, 0);
+        ASSERT_LE(size, kBlockSize - kSkipped);
+      } else {
+        ASSERT_EQ(size, kBlockSize - kSkipped);
+      }
+      ASSERT_EQ(0, ::memcmp(data, blocks[block].data() + kSkipped, size));
+    }
+
+    // Skips over whole blocks and into the next one.
+    std::vector<uint64_t> positions{0, 0};
+    PositionProvider provider(positions);
+    stream->seekToPosition(provider);
+    stream->SkipInt64(3 * kBlockSize + kSkipped);
+    ASSERT_TRUE(stream->Next(&data, &size));
+    ASSERT_EQ(size, kBlockSize - kSkipped);
+    ASSERT_EQ(0, ::memcmp(data, blocks[3].data() + kSkipped, size));
+  }
+}
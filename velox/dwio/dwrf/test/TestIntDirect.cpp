@@ -25,6 +25,8 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 using namespace facebook::velox::dwio::common;
 using namespace facebook::velox;
 using namespace facebook::velox::dwrf;
@@ -234,6 +236,94 @@ TEST_F(DirectTest, vIntUnsignedLong) {
   });
 }
 
+// Encodes 'values' as unsigned varints.
+std::string encodeVarints(const std::vector<uint64_t>& values) {
+  std::string data;
+  for (auto value : values) {
+    while (value >= 0x80) {
+      data.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    data.push_back(static_cast<char>(value));
+  }
+  return data;
+}
+
+TEST_F(DirectTest, vIntSingleByteRuns) {
+  // Runs of single byte varints, long enough for the SIMD batch step, with
+  // runs of multibyte varints in between. The data ends with a single byte
+  // run.
+  std::vector<uint64_t> values;
+  for (auto run = 0; run < 20; ++run) {
+    for (auto i = 0; i < 150; ++i) {
+      values.push_back((run * 150 + i) % 128);
+    }
+    if (run < 19) {
+      for (auto i = 0; i < 1 + run % 10; ++i) {
+        values.push_back(128 + run * 1000 + i * 12345);
+      }
+    }
+  }
+  const auto data = encodeVarints(values);
+  const int32_t numValues = values.size();
+
+  // With 37 byte blocks, some multibyte varints start in one buffer and end
+  // in the next.
+  constexpr uint64_t kSmallBlock = 37;
+  int32_t numSplitVarints = 0;
+  uint64_t offset = 0;
+  for (auto value : values) {
+    const auto size = encodeVarints({value}).size();
+    if (size > 1 &&
+        offset / kSmallBlock != (offset + size - 1) / kSmallBlock) {
+      ++numSplitVarints;
+    }
+    offset += size;
+  }
+  ASSERT_GT(numSplitVarints, 0);
+
+  std::vector<int32_t> allRows(numValues);
+  std::iota(allRows.begin(), allRows.end(), 0);
+  // Contiguous runs of 70 rows with gaps of 1 to 40 rows in between. The last
+  // row is always included.
+  std::vector<int32_t> gappedRows;
+  for (int32_t row = 0, gap = 0; row < numValues; ++gap) {
+    const auto runEnd = std::min(row + 70, numValues);
+    for (; row < runEnd; ++row) {
+      gappedRows.push_back(row);
+    }
+    row += 1 + (gap * 7) % 40;
+  }
+  if (gappedRows.back() != numValues - 1) {
+    gappedRows.push_back(numValues - 1);
+  }
+
+  // A block size of the whole data makes the last varint end exactly at the
+  // end of the only buffer.
+  for (const auto blockSize :
+       std::vector<uint64_t>{data.size(), 1000, kSmallBlock}) {
+    SCOPED_TRACE(fmt::format("blockSize {}", blockSize));
+    auto makeDecoder = [&]() {
+      return createDirectDecoder<false>(
+          std::make_unique<SeekableArrayInputStream>(
+              data.data(), data.size(), blockSize),
+          true,
+          sizeof(int64_t));
+    };
+    std::vector<uint64_t> result(numValues);
+    makeDecoder()->bulkRead(numValues, result.data());
+    ASSERT_EQ(values, result);
+
+    for (const auto* rows : {&allRows, &gappedRows}) {
+      std::fill(result.begin(), result.end(), 0);
+      makeDecoder()->bulkReadRows(*rows, result.data());
+      for (auto i = 0; i < rows->size(); ++i) {
+        ASSERT_EQ(values[(*rows)[i]], result[i]) << "row " << (*rows)[i];
+      }
+    }
+  }
+}
+
 template <bool isSigned>
 void testCorruptedVarInts() {
   std::vector<uint8_t> invalidInt{
@@ -17,6 +17,7 @@
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -35,7 +36,12 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  // Columns encoded concurrently on the encoding executor cannot share the
+  // context's selectivity vector.
+  std::optional<SelectivityVector> localSelected;
+  auto& selected = context_.encodingExecutor() == nullptr
+      ? context_.getSharedSelectivityVector(slice->size())
+      : localSelected.emplace(slice->size());
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -1727,11 +1733,21 @@ class StructColumnWriter : public BaseColumnWriter {
 
   void flush(
       std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
-      std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
-    BaseColumnWriter::flush(encodingFactory, encodingOverride);
-    for (auto& c : children_) {
-      c->flush(encodingFactory);
+      std::function<void(proto::ColumnEncoding&)> encodingOverride) override;
+
+  /// Sets up the root writer to write and flush its top level columns in
+  /// parallel on the context's encoding executor. Must be called after the
+  /// children are created.
+  void initParallelForOnChildren() {
+    VELOX_CHECK(isRoot());
+    if (context_.encodingExecutor() == nullptr || children_.size() < 2) {
+      return;
     }
+    parallelForOnChildren_ = std::make_unique<dwio::common::ParallelFor>(
+        context_.encodingExecutor(),
+        0,
+        children_.size(),
+        context_.encodingParallelismFactor());
   }
 
  private:
@@ -1739,16 +1755,60 @@ class StructColumnWriter : public BaseColumnWriter {
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
+
+  std::unique_ptr<dwio::common::ParallelFor> parallelForOnChildren_;
 };
 
+void StructColumnWriter::flush(
+    std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
+    std::function<void(proto::ColumnEncoding&)> encodingOverride) {
+  BaseColumnWriter::flush(encodingFactory, encodingOverride);
+  if (parallelForOnChildren_ == nullptr) {
+    for (auto& c : children_) {
+      c->flush(encodingFactory);
+    }
+    return;
+  }
+
+  // Each column records its encodings while flushing concurrently. They are
+  // added to the footer afterwards in column order so that the output is
+  // identical to a serial flush.
+  std::vector<std::vector<
+      std::pair<uint32_t, std::unique_ptr<proto::ColumnEncoding>>>>
+      encodings(children_.size());
+  parallelForOnChildren_->execute([&](size_t i) {
+    auto& childEncodings = encodings[i];
+    children_[i]->flush([&](uint32_t nodeId) -> proto::ColumnEncoding& {
+      childEncodings.emplace_back(
+          nodeId, std::make_unique<proto::ColumnEncoding>());
+      return *childEncodings.back().second;
+    });
+  });
+  for (auto& childEncodings : encodings) {
+    for (auto& [nodeId, encoding] : childEncodings) {
+      encodingFactory(nodeId).Swap(encoding.get());
+    }
+  }
+}
+
 uint64_t StructColumnWriter::writeChildrenAndStats(
     const RowVector* rowSlice,
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
   if (ranges.size() > 0) {
-    for (size_t i = 0; i < children_.size(); ++i) {
-      rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+    if (parallelForOnChildren_ != nullptr) {
+      std::vector<uint64_t> childRawSizes(children_.size());
+      parallelForOnChildren_->execute([&](size_t i) {
+        childRawSizes[i] = children_[i]->write(rowSlice->childAt(i), ranges);
+      });
+      for (auto childRawSize : childRawSizes) {
+        rawSize += childRawSize;
+      }
+    } else {
+      for (size_t i = 0; i < children_.size(); ++i) {
+        rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+      }
     }
   }
   if (nullCount) {
@@ -2185,6 +2245,9 @@ std::unique_ptr<BaseColumnWriter> BaseColumnWriter::create(
       for (int32_t i = 0; i < type.size(); ++i) {
         ret->children_.push_back(create(context, *type.childAt(i), sequence));
       }
+      if (ret->isRoot()) {
+        ret->initParallelForOnChildren();
+      }
       return ret;
     }
     case TypeKind::MAP: {
@@ -185,6 +185,14 @@ Writer::Writer(
   writerBase_->initBuffers();
 
   context.buildPhysicalSizeAggregators(*schema_);
+  // Encrypters can be shared by the columns of an encryption group, so
+  // encrypted files are always encoded serially.
+  if (options.encodingExecutor != nullptr &&
+      options.encodingParallelismFactor > 1 &&
+      !context.getEncryptionHandler().isEncrypted()) {
+    context.setEncodingExecutor(
+        options.encodingExecutor, options.encodingParallelismFactor);
+  }
   if (options.flushPolicyFactory == nullptr) {
     flushPolicy_ = std::make_unique<DefaultFlushPolicy>(
         context.stripeSizeFlushThreshold(),
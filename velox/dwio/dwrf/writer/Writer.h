@@ -45,6 +45,12 @@ struct WriterOptions : public dwio::common::WriterOptions {
   const tz::TimeZone* sessionTimezone{nullptr};
   bool adjustTimestampToTimezone{false};
   DwrfFormat format{DwrfFormat::kDwrf};
+  /// If set, the top level columns are encoded, compressed and flushed in
+  /// parallel on this executor. At most 'encodingParallelismFactor' columns
+  /// are processed concurrently, including the calling thread. The output is
+  /// identical to serial encoding. Ignored for encrypted files.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
 
   void processConfigs(
       const config::ConfigBase& connectorConfig,
@@ -102,6 +102,40 @@ void WriterContext::initBuffer() {
   }
 }
 
+std::unique_ptr<dwio::common::DataBuffer<char>> WriterContext::getBuffer(
+    uint64_t size) {
+  std::lock_guard<std::mutex> l(compressionBufferMutex_);
+  if (compressionBuffer_ == nullptr && encodingExecutor_ != nullptr &&
+      compression_ != common::CompressionKind_NONE) {
+    if (!extraCompressionBuffers_.empty()) {
+      auto buffer = std::move(extraCompressionBuffers_.back());
+      extraCompressionBuffers_.pop_back();
+      VELOX_CHECK_GE(buffer->size(), size);
+      return buffer;
+    }
+    auto buffer = std::make_unique<dwio::common::DataBuffer<char>>(
+        *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+    VELOX_CHECK_GE(buffer->size(), size);
+    return buffer;
+  }
+  VELOX_CHECK_NOT_NULL(compressionBuffer_);
+  VELOX_CHECK_GE(compressionBuffer_->size(), size);
+  return std::move(compressionBuffer_);
+}
+
+void WriterContext::returnBuffer(
+    std::unique_ptr<dwio::common::DataBuffer<char>> buffer) {
+  VELOX_CHECK_NOT_NULL(buffer);
+  std::lock_guard<std::mutex> l(compressionBufferMutex_);
+  if (compressionBuffer_ == nullptr) {
+    compressionBuffer_ = std::move(buffer);
+    return;
+  }
+  VELOX_CHECK_NOT_NULL(
+      encodingExecutor_, "Compression buffer returned more than once");
+  extraCompressionBuffers_.push_back(std::move(buffer));
+}
+
 memory::MemoryPool& WriterContext::getMemoryPool(
     const MemoryUsageCategory& category) {
   switch (category) {
@@ -159,6 +193,8 @@ int64_t WriterContext::releaseMemoryReservation() {
 
 void WriterContext::abort() {
   compressionBuffer_.reset();
+  extraCompressionBuffers_.clear();
+  extraCompressionBuffers_.shrink_to_fit();
   physicalSizeAggregators_.clear();
   streams_.clear();
   dictEncoders_.clear();
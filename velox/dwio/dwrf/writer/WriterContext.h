@@ -17,6 +17,8 @@
 #pragma once
 
 #include <limits>
+#include <mutex>
+#include <folly/Executor.h>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -49,18 +51,24 @@ class WriterContext : public CompressionBufferPool {
 
   ~WriterContext() override;
 
+  // Stream lookups and registrations are guarded by 'streamsMutex_' since
+  // column writers may create and suppress their streams concurrently on the
+  // encoding executor. The map has referential stability, so the returned
+  // references stay valid after the lock is released.
   bool hasStream(const DwrfStreamIdentifier& stream) const {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     return streams_.find(stream) != streams_.end();
   }
 
   const DataBufferHolder& getStream(const DwrfStreamIdentifier& stream) const {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     return streams_.at(stream);
   }
 
   void addBuffer(
       const DwrfStreamIdentifier& stream,
       folly::StringPiece buffer) {
-    streams_.at(stream).take(buffer);
+    getStreamHolder(stream).take(buffer);
   }
 
   size_t getStreamCount() const {
@@ -73,23 +81,24 @@ class WriterContext : public CompressionBufferPool {
   // flush policy evaluation and would be more accurate after flush.
   std::unique_ptr<BufferedOutputStream> newStream(
       const DwrfStreamIdentifier& stream) {
-    VELOX_CHECK(
-        !hasStream(stream), "Stream already exists: {}", stream.toString());
-
-    streams_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(stream),
-        std::forward_as_tuple(
-            getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
-            compressionBlockSize(),
-            getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
-            getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)));
-    auto& holder = streams_.at(stream);
+    DataBufferHolder* holder;
+    {
+      std::lock_guard<std::mutex> l(streamsMutex_);
+      auto result = streams_.try_emplace(
+          stream,
+          getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
+          compressionBlockSize(),
+          getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
+          getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO));
+      VELOX_CHECK(
+          result.second, "Stream already exists: {}", stream.toString());
+      holder = std::addressof(result.first->second);
+    }
     auto encrypter = handler_->isEncrypted(stream.encodingKey().node())
         ? std::addressof(
               handler_->getEncryptionProvider(stream.encodingKey().node()))
         : nullptr;
-    return newStream(compression_, holder, encrypter);
+    return newStream(compression_, *holder, encrypter);
   }
 
   std::unique_ptr<DataBufferHolder> newDataBufferHolder(
@@ -114,6 +123,7 @@ class WriterContext : public CompressionBufferPool {
       const EncodingKey& encodingKey,
       velox::memory::MemoryPool& dictionaryPool,
       velox::memory::MemoryPool& generalPool) {
+    std::lock_guard<std::mutex> l(dictEncodersMutex_);
     auto result = dictEncoders_.find(encodingKey);
     if (result == dictEncoders_.end()) {
       auto emplaceResult = dictEncoders_.emplace(
@@ -145,9 +155,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void suppressStream(const DwrfStreamIdentifier& stream) {
-    VELOX_CHECK(hasStream(stream));
-    auto& collector = streams_.at(stream);
-    collector.suppress();
+    getStreamHolder(stream).suppress();
   }
 
   bool isStreamPaged(uint32_t nodeId) const {
@@ -232,6 +240,7 @@ class WriterContext : public CompressionBufferPool {
   // cleans up its value writer streams upon reset().
   void removeAllIntDictionaryEncodersOnNode(
       std::function<bool(uint32_t)> predicate) {
+    std::lock_guard<std::mutex> l(dictEncodersMutex_);
     auto iter = dictEncoders_.begin();
     while (iter != dictEncoders_.end()) {
       if (predicate(iter->first.node())) {
@@ -244,6 +253,7 @@ class WriterContext : public CompressionBufferPool {
 
   virtual void removeStreams(
       std::function<bool(const DwrfStreamIdentifier&)> predicate) {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     auto it = streams_.begin();
     while (it != streams_.end()) {
       if (predicate(it->first)) {
@@ -256,18 +266,31 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  /// Hands out the compression buffer. When column writers run on the
+  /// encoding executor, each concurrent compressor gets its own buffer and
+  /// the extra buffers are kept for reuse until the writer is aborted.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
-      uint64_t size) override {
-    VELOX_CHECK_NOT_NULL(compressionBuffer_);
-    VELOX_CHECK_GE(compressionBuffer_->size(), size);
-    return std::move(compressionBuffer_);
-  }
+      uint64_t size) override;
 
   void returnBuffer(
-      std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
-    VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
+      std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override;
+
+  /// Sets the executor on which the root column writer encodes and flushes
+  /// its top level columns. 'parallelismFactor' bounds the number of columns
+  /// processed concurrently, including the calling thread.
+  void setEncodingExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      size_t parallelismFactor) {
+    encodingExecutor_ = std::move(executor);
+    encodingParallelismFactor_ = parallelismFactor;
+  }
+
+  const std::shared_ptr<folly::Executor>& encodingExecutor() const {
+    return encodingExecutor_;
+  }
+
+  size_t encodingParallelismFactor() const {
+    return encodingParallelismFactor_;
   }
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
@@ -608,7 +631,16 @@ class WriterContext : public CompressionBufferPool {
  private:
   void validateConfigs() const;
 
+  DataBufferHolder& getStreamHolder(const DwrfStreamIdentifier& stream) {
+    std::lock_guard<std::mutex> l(streamsMutex_);
+    auto it = streams_.find(stream);
+    VELOX_CHECK(
+        it != streams_.end(), "Stream not found: {}", stream.toString());
+    return it->second;
+  }
+
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(decodedVectorPoolMutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -618,6 +650,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(decodedVectorPoolMutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
@@ -648,6 +681,7 @@ class WriterContext : public CompressionBufferPool {
       DataBufferHolder,
       dwio::common::StreamIdentifierHash>
       streams_;
+  mutable std::mutex streamsMutex_;
   folly::F14NodeMap<uint32_t, std::unique_ptr<PhysicalSizeAggregator>>
       physicalSizeAggregators_;
   folly::F14FastMap<
@@ -655,16 +689,24 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<AbstractIntegerDictionaryEncoder>,
       EncodingKeyHash>
       dictEncoders_;
+  std::mutex dictEncodersMutex_;
   std::function<std::unique_ptr<IndexBuilder>(
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Additional compression buffers allocated for concurrent column writers.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      extraCompressionBuffers_;
+  std::mutex compressionBufferMutex_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
+  std::mutex decodedVectorPoolMutex_;
   // Reusable SelectivityVector
   std::unique_ptr<velox::SelectivityVector> selectivityVector_;
 
   std::unique_ptr<encryption::EncryptionHandler> handler_;
+  std::shared_ptr<folly::Executor> encodingExecutor_;
+  size_t encodingParallelismFactor_{0};
   folly::F14FastMap<uint32_t, uint64_t> nodeSize_;
   CompressionRatioTracker compressionRatioTracker_;
   FlushOverheadRatioTracker flushOverheadRatioTracker_;
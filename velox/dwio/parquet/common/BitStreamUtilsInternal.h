@@ -23,8 +23,10 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <type_traits>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/BitPackDecoder.h"
 
 #include "arrow/util/bit_util.h"
 #include "arrow/util/bpacking.h"
@@ -358,6 +360,28 @@ inline int BitReader::GetBatch(int numBits, T* v, int batchSize) {
         numBits);
     i += numUnpacked;
     byteOffset += numUnpacked * numBits / 8;
+  } else if (
+      (sizeof(T) == 1 || sizeof(T) == 2) && numBits >= 1 &&
+      numBits <= static_cast<int>(sizeof(T) * 8)) {
+    // Repetition/definition levels and other narrow values are unpacked
+    // straight to their width by the BMI2 kernels of BitPackDecoder.h instead
+    // of going through a 32 bit buffer. These kernels load 64 bits at a time,
+    // so a tail of the buffer is left to the scalar loop below.
+    using TUnsigned = std::conditional_t<sizeof(T) == 1, uint8_t, uint16_t>;
+    constexpr int64_t kSafeTailBytes = 16;
+    const int64_t availableBytes = maxBytes - byteOffset;
+    if (availableBytes > kSafeTailBytes) {
+      int64_t numToUnpack = (availableBytes - kSafeTailBytes) * 8 / numBits;
+      numToUnpack = std::min<int64_t>(numToUnpack, batchSize - i) & ~7;
+      if (numToUnpack > 0) {
+        const uint8_t* input = buffer + byteOffset;
+        auto* output = reinterpret_cast<TUnsigned*>(v + i);
+        dwio::common::unpack<TUnsigned>(
+            input, availableBytes, numToUnpack, numBits, output);
+        i += numToUnpack;
+        byteOffset += numToUnpack * numBits / 8;
+      }
+    }
   } else if (sizeof(T) == 8 && numBits > 32) {
     // Use unpack64 only if numBits is larger than 32
     // TODO (ARROW-13677): improve the performance of internal::unpack64
@@ -30,6 +30,11 @@
 namespace facebook::velox::parquet {
 namespace {
 
+// Processes up to 64 levels at a time. The levels are compared against the
+// level info in vectorized loops that produce one bitmap per condition: the
+// levels that start a list, the levels that are elements of a list and the
+// levels of lists that are not null. The offsets are then written for each
+// list start and the validity bits are extracted at the list starts.
 template <typename OffsetType>
 void DefRepLevelsToListInfo(
     const int16_t* defLevels,
@@ -46,64 +51,69 @@ void DefRepLevelsToListInfo(
         output->validBitsOffset,
         output->valuesReadUpperBound);
   }
-  for (int x = 0; x < numDefLevels; x++) {
-    // Skip items that belong to empty or null ancestor lists and further nested
-    // lists.
-    if (defLevels[x] < levelInfo.repeatedAncestorDefLevel ||
-        repLevels[x] > levelInfo.repLevel) {
-      continue;
+  // Cumulative number of list elements. The offsets are cumulative because
+  // variable size lists are more common than fixed size lists so it is cheaper
+  // to subtract when validating fixed size lists.
+  int64_t numElements = offsets != nullptr ? *offsets : 0;
+  int64_t numLists = 0;
+  for (int64_t begin = 0; begin < numDefLevels; begin += kExtractBitsSize) {
+    const auto* defs = defLevels + begin;
+    const auto* reps = repLevels + begin;
+    const auto batchSize = std::min(numDefLevels - begin, kExtractBitsSize);
+    // Items that belong to empty or null ancestor lists and further nested
+    // lists are skipped.
+    const uint64_t selected = GreaterThanBitmap(
+                                  defs,
+                                  batchSize,
+                                  levelInfo.repeatedAncestorDefLevel - 1) &
+        ~GreaterThanBitmap(reps, batchSize, levelInfo.repLevel);
+    // A repLevel equal to the list repLevel continues the current list. A
+    // lower one starts a list, since ancestor empty lists are skipped above.
+    const uint64_t continued =
+        selected & GreaterThanBitmap(reps, batchSize, levelInfo.repLevel - 1);
+    const uint64_t starts = selected & ~continued;
+    const auto numStarts = ::arrow::bit_util::PopCount(starts);
+    if (FOLLY_UNLIKELY(
+            (offsets != nullptr || validBitsWriter.has_value()) &&
+            numLists + numStarts > output->valuesReadUpperBound)) {
+      VELOX_FAIL(
+          "Definition levels exceeded upper bound: {}",
+          output->valuesReadUpperBound);
     }
-
-    if (repLevels[x] == levelInfo.repLevel) {
-      // A continuation of an existing list.
-      // offsets can be null for structs with repeated children (we don't need
-      // to know offsets until we get to the children).
-      if (offsets != nullptr) {
-        if (FOLLY_UNLIKELY(
-                *offsets == std::numeric_limits<OffsetType>::max())) {
-          VELOX_FAIL("List index overflow.");
-        }
-        *offsets += 1;
-      }
-    } else {
+    numLists += numStarts;
+
+    // offsets can be null for structs with repeated children (we don't need
+    // to know offsets until we get to the children).
+    if (offsets != nullptr) {
+      // The levelInfo def level for lists reflects element present level.
+      const uint64_t elements = continued |
+          (starts &
+           GreaterThanBitmap(defs, batchSize, levelInfo.defLevel - 1));
+      const auto batchElements = ::arrow::bit_util::PopCount(elements);
       if (FOLLY_UNLIKELY(
-              (validBitsWriter.has_value() &&
-               validBitsWriter->position() >= output->valuesReadUpperBound) ||
-              (offsets - origPos) >= output->valuesReadUpperBound)) {
-        VELOX_FAIL(
-            "Definition levels exceeded upper bound: {}",
-            output->valuesReadUpperBound);
+              numElements + batchElements >
+              std::numeric_limits<OffsetType>::max())) {
+        VELOX_FAIL("List index overflow.");
       }
-
-      // current_rep < list repLevel i.e. start of a list (ancestor empty lists
-      // are filtered out above). offsets can be null for structs with repeated
-      // children (we don't need to know offsets until we get to the children).
-      if (offsets != nullptr) {
+      // Each list start closes the list before it with the elements seen so
+      // far and opens a new one.
+      for (auto bits = starts; bits != 0; bits &= bits - 1) {
+        const auto position = __builtin_ctzll(bits);
+        *offsets = numElements +
+            ::arrow::bit_util::PopCount(
+                       elements & ((uint64_t{1} << position) - 1));
         ++offsets;
-        // Use cumulative offsets because variable size lists are more common
-        // than fixed size lists so it should be cheaper to make these
-        // cumulative and subtract when validating fixed size lists.
-        *offsets = *(offsets - 1);
-        if (defLevels[x] >= levelInfo.defLevel) {
-          if (FOLLY_UNLIKELY(
-                  *offsets == std::numeric_limits<OffsetType>::max())) {
-            VELOX_FAIL("List index overflow.");
-          }
-          *offsets += 1;
-        }
       }
+      numElements += batchElements;
+      *offsets = numElements;
+    }
 
-      if (validBitsWriter.has_value()) {
-        // the levelInfo def level for lists reflects element present level.
-        // the prior level distinguishes between empty lists.
-        if (defLevels[x] >= levelInfo.defLevel - 1) {
-          validBitsWriter->Set();
-        } else {
-          output->nullCount++;
-          validBitsWriter->Clear();
-        }
-        validBitsWriter->Next();
-      }
+    if (validBitsWriter.has_value() && numStarts > 0) {
+      // The prior level distinguishes between empty and null lists.
+      const auto validBits = ExtractBits(
+          GreaterThanBitmap(defs, batchSize, levelInfo.defLevel - 2), starts);
+      output->nullCount += numStarts - ::arrow::bit_util::PopCount(validBits);
+      validBitsWriter->AppendWord(validBits, numStarts);
     }
   }
   if (validBitsWriter.has_value()) {
@@ -22,6 +22,10 @@
 #include <cstdint>
 #include <limits>
 
+#ifdef __BMI2__
+#include <x86intrin.h>
+#endif
+
 #include "arrow/util/bit_util.h"
 #include "arrow/util/bitmap_writer.h"
 
@@ -257,7 +261,11 @@ using extractBitmapT = uint64_t;
 inline extractBitmapT ExtractBits(
     extractBitmapT bitmap,
     extractBitmapT selectBitmap) {
+#ifdef __BMI2__
+  return _pext_u64(bitmap, selectBitmap);
+#else
   return ExtractBitsSoftware(bitmap, selectBitmap);
+#endif
 }
 
 static constexpr int64_t kExtractBitsSize = 8 * sizeof(extractBitmapT);
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/ByteStreamSplit.h"
+
+#include <folly/CPortability.h>
+#include <xsimd/xsimd.hpp>
+
+namespace facebook::velox::parquet {
+namespace {
+
+using Batch = xsimd::batch<uint8_t>;
+constexpr int32_t kBatchSize = Batch::size;
+
+// Interleaves the elements of type T in 'a' and 'b'. 'lo' gets the
+// interleaved first halves and 'hi' the interleaved second halves.
+template <typename T>
+FOLLY_ALWAYS_INLINE void zip(Batch a, Batch b, Batch& lo, Batch& hi) {
+  auto x = xsimd::bitwise_cast<T>(a);
+  auto y = xsimd::bitwise_cast<T>(b);
+  lo = xsimd::bitwise_cast<uint8_t>(xsimd::zip_lo(x, y));
+  hi = xsimd::bitwise_cast<uint8_t>(xsimd::zip_hi(x, y));
+}
+
+// Transposes kBatchSize values of 4 bytes starting at value 'row'.
+FOLLY_ALWAYS_INLINE void
+transpose4(const uint8_t* data, int32_t numValues, int32_t row, uint8_t* out) {
+  Batch streams[4];
+  for (auto i = 0; i < 4; ++i) {
+    streams[i] = Batch::load_unaligned(data + i * numValues + row);
+  }
+  // After the first round each batch has pairs of bytes of consecutive values
+  // and after the second round four full values.
+  Batch pairs[4];
+  zip<uint8_t>(streams[0], streams[1], pairs[0], pairs[1]);
+  zip<uint8_t>(streams[2], streams[3], pairs[2], pairs[3]);
+  Batch values[4];
+  zip<uint16_t>(pairs[0], pairs[2], values[0], values[1]);
+  zip<uint16_t>(pairs[1], pairs[3], values[2], values[3]);
+  for (auto i = 0; i < 4; ++i) {
+    values[i].store_unaligned(out + (row * 4) + i * kBatchSize);
+  }
+}
+
+// Transposes kBatchSize values of 8 bytes starting at value 'row'.
+FOLLY_ALWAYS_INLINE void
+transpose8(const uint8_t* data, int32_t numValues, int32_t row, uint8_t* out) {
+  Batch streams[8];
+  for (auto i = 0; i < 8; ++i) {
+    streams[i] = Batch::load_unaligned(data + i * numValues + row);
+  }
+  Batch pairs[8];
+  for (auto i = 0; i < 8; i += 2) {
+    zip<uint8_t>(streams[i], streams[i + 1], pairs[i], pairs[i + 1]);
+  }
+  Batch quads[8];
+  for (auto i = 0; i < 8; i += 4) {
+    zip<uint16_t>(pairs[i], pairs[i + 2], quads[i], quads[i + 1]);
+    zip<uint16_t>(pairs[i + 1], pairs[i + 3], quads[i + 2], quads[i + 3]);
+  }
+  Batch values[8];
+  for (auto i = 0; i < 4; ++i) {
+    zip<uint32_t>(quads[i], quads[i + 4], values[2 * i], values[2 * i + 1]);
+  }
+  for (auto i = 0; i < 8; ++i) {
+    values[i].store_unaligned(out + (row * 8) + i * kBatchSize);
+  }
+}
+
+} // namespace
+
+void decodeByteStreamSplit(
+    const char* data,
+    int32_t numValues,
+    int32_t width,
+    char* output) {
+  auto* input = reinterpret_cast<const uint8_t*>(data);
+  auto* out = reinterpret_cast<uint8_t*>(output);
+  int32_t row = 0;
+  if (width == 4) {
+    for (; row + kBatchSize <= numValues; row += kBatchSize) {
+      transpose4(input, numValues, row, out);
+    }
+  } else if (width == 8) {
+    for (; row + kBatchSize <= numValues; row += kBatchSize) {
+      transpose8(input, numValues, row, out);
+    }
+  }
+  for (; row < numValues; ++row) {
+    for (auto i = 0; i < width; ++i) {
+      out[row * width + i] = input[i * numValues + row];
+    }
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace facebook::velox::parquet {
+
+/// Decodes 'numValues' values of 'width' bytes from BYTE_STREAM_SPLIT
+/// encoded 'data' into 'output' as PLAIN encoded values. 'data' holds 'width'
+/// streams of 'numValues' bytes each, where stream k contains byte k of every
+/// value. Widths 4 and 8 are transposed a SIMD batch at a time.
+void decodeByteStreamSplit(
+    const char* data,
+    int32_t numValues,
+    int32_t width,
+    char* output);
+
+} // namespace facebook::velox::parquet
@@ -18,6 +18,8 @@
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/BitPackDecoder.h"
+#include "velox/dwio/common/DecoderUtil.h"
 
 namespace facebook::velox::parquet {
 
@@ -38,13 +40,30 @@ class DeltaBpDecoder {
     if (hasNulls) {
       numValues = bits::countNonNulls(nulls, current, current + numValues);
     }
-    for (int32_t i = 0; i < numValues; ++i) {
-      readLong();
+    while (numValues > 0) {
+      if (miniBlockOffset_ == numMiniBlockValues_) {
+        readLong();
+        --numValues;
+        continue;
+      }
+      const auto count = std::min<uint64_t>(
+          numValues, numMiniBlockValues_ - miniBlockOffset_);
+      miniBlockOffset_ += count;
+      totalValuesRemaining_ -= count;
+      numValues -= count;
     }
   }
 
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    using T = typename Visitor::DataType;
+    if constexpr (
+        !hasNulls && std::is_integral_v<T> && !std::is_same_v<T, int128_t>) {
+      if (dwio::common::useFastPath<Visitor, false>(visitor)) {
+        fastPath(visitor);
+        return;
+      }
+    }
     int32_t current = visitor.start();
     skip<hasNulls>(current, 0, nulls);
     int32_t toSkip;
@@ -89,12 +108,67 @@ class DeltaBpDecoder {
   template <typename T>
   void readValues(T* values, int32_t numValues) {
     VELOX_DCHECK_LE(numValues, totalValuesRemaining_);
-    for (auto i = 0; i < numValues; i++) {
-      values[i] = T(readLong());
+    int32_t i = 0;
+    while (i < numValues) {
+      if (miniBlockOffset_ == numMiniBlockValues_) {
+        values[i++] = T(readLong());
+        continue;
+      }
+      const auto count = std::min<uint64_t>(
+          numValues - i, numMiniBlockValues_ - miniBlockOffset_);
+      const auto* source = miniBlockValues_.data() + miniBlockOffset_;
+      for (uint64_t j = 0; j < count; ++j) {
+        values[i + j] = T(source[j]);
+      }
+      i += count;
+      miniBlockOffset_ += count;
+      totalValuesRemaining_ -= count;
     }
   }
 
  private:
+  // Decodes the values of all rows of 'visitor' into its values and then
+  // applies the filter and hook of 'visitor' a SIMD batch at a time.
+  template <typename Visitor>
+  void fastPath(Visitor& visitor) {
+    using T = typename Visitor::DataType;
+    constexpr bool hasFilter =
+        !std::is_same_v<typename Visitor::FilterType, common::AlwaysTrue>;
+    constexpr bool filterOnly =
+        std::is_same_v<typename Visitor::Extract, dwio::common::DropValues>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+    const auto* rows = visitor.rows();
+    const auto numRows = visitor.numRows();
+    auto* values = visitor.rawValues(numRows);
+    if (Visitor::dense) {
+      readValues(values, numRows);
+    } else {
+      int32_t position = 0;
+      for (auto i = 0; i < numRows; ++i) {
+        skip(rows[i] - position);
+        readValues(values + i, 1);
+        position = rows[i] + 1;
+      }
+    }
+    int32_t numValues = 0;
+    dwio::common::processFixedWidthRun<T, filterOnly, false, Visitor::dense>(
+        folly::Range<const int32_t*>(rows, numRows),
+        0,
+        numRows,
+        hasHook ? velox::iota(
+                      numRows,
+                      visitor.innerNonNullRows(),
+                      visitor.numValuesBias())
+                : nullptr,
+        values,
+        hasFilter ? visitor.outputRows(numRows) : nullptr,
+        numValues,
+        visitor.filter(),
+        visitor.hook());
+    visitor.setNumValues(hasFilter ? numValues : numRows);
+  }
+
   bool getVlqInt(uint64_t& v) {
     uint64_t tmp = 0;
     for (int i = 0; i < folly::kMaxVarintLength64; i++) {
@@ -142,8 +216,10 @@ class DeltaBpDecoder {
 
     totalValuesRemaining_ = totalValueCount_;
     deltaBitWidths_.resize(miniBlocksPerBlock_);
+    miniBlockValues_.resize(valuesPerMiniBlock_);
     firstBlockInitialized_ = false;
-    valuesRemainingCurrentMiniBlock_ = 0;
+    miniBlockOffset_ = 0;
+    numMiniBlockValues_ = 0;
   }
 
   void initBlock() {
@@ -166,62 +242,85 @@ class DeltaBpDecoder {
     initMiniBlock(deltaBitWidths_[0]);
   }
 
+  // Decodes the values of the miniblock at 'bufferStart_' into
+  // 'miniBlockValues_'. Bit widths of up to 32 are unpacked a SIMD batch at a
+  // time.
   void initMiniBlock(int32_t bitWidth) {
-    VELOX_DCHECK_LE(
+    VELOX_CHECK_LE(
         bitWidth,
         kMaxDeltaBitWidth,
         "delta bit width larger than integer bit width");
     deltaBitWidth_ = bitWidth;
-    valuesRemainingCurrentMiniBlock_ = valuesPerMiniBlock_;
-  }
-
-  int64_t readLong() {
-    int64_t value = 0;
-    if (valuesRemainingCurrentMiniBlock_ == 0) {
-      if (!firstBlockInitialized_) {
-        value = lastValue_;
-        // When block is uninitialized we have two different possibilities:
-        // 1. totalValueCount_ == 1, which means that the page may have only
-        // one value (encoded in the header), and we should not initialize
-        // any block.
-        // 2. totalValueCount_ != 1, which means we should initialize the
-        // incoming block for subsequent reads.
-        if (totalValueCount_ != 1) {
-          initBlock();
-        }
-        totalValuesRemaining_--;
-        return value;
-      } else {
-        ++miniBlockIdx_;
-        if (miniBlockIdx_ < miniBlocksPerBlock_) {
-          initMiniBlock(deltaBitWidths_[miniBlockIdx_]);
-        } else {
-          initBlock();
-        }
+    numMiniBlockValues_ =
+        std::min<uint64_t>(valuesPerMiniBlock_, totalValuesRemaining_);
+    miniBlockOffset_ = 0;
+    auto* values = miniBlockValues_.data();
+    if (bitWidth == 0) {
+      std::fill(values, values + numMiniBlockValues_, 0);
+    } else if (bitWidth <= 32) {
+      // The miniblock is padded to 'valuesPerMiniBlock_', a multiple of 32,
+      // so unpacking a multiple of 8 values stays inside it.
+      deltas_.resize(valuesPerMiniBlock_);
+      auto* input = reinterpret_cast<const uint8_t*>(bufferStart_);
+      auto* deltas = deltas_.data();
+      dwio::common::unpack<uint32_t>(
+          input,
+          bits::nbytes(bitWidth * valuesPerMiniBlock_),
+          bits::roundUp(numMiniBlockValues_, 8),
+          bitWidth,
+          deltas);
+      for (uint64_t i = 0; i < numMiniBlockValues_; ++i) {
+        values[i] = deltas_[i];
+      }
+    } else {
+      for (uint64_t i = 0; i < numMiniBlockValues_; ++i) {
+        uint64_t delta = 0;
+        bits::copyBits(
+            reinterpret_cast<const uint64_t*>(bufferStart_),
+            i * bitWidth,
+            &delta,
+            0,
+            bitWidth);
+        values[i] = delta;
       }
     }
-
-    uint64_t consumedBits =
-        (valuesPerMiniBlock_ - valuesRemainingCurrentMiniBlock_) *
-        deltaBitWidth_;
-    bits::copyBits(
-        reinterpret_cast<const uint64_t*>(bufferStart_),
-        consumedBits,
-        reinterpret_cast<uint64_t*>(&value),
-        0,
-        deltaBitWidth_);
     // Addition between minDelta_, packed int and lastValue_ should be treated
     // as unsigned addition. Overflow is as expected.
-    value = static_cast<uint64_t>(minDelta_) + static_cast<uint64_t>(value) +
-        static_cast<uint64_t>(lastValue_);
+    auto value = static_cast<uint64_t>(lastValue_);
+    const auto minDelta = static_cast<uint64_t>(minDelta_);
+    for (uint64_t i = 0; i < numMiniBlockValues_; ++i) {
+      value += minDelta + values[i];
+      values[i] = value;
+    }
     lastValue_ = value;
-    valuesRemainingCurrentMiniBlock_--;
-    totalValuesRemaining_--;
+    bufferStart_ += bits::nbytes(bitWidth * valuesPerMiniBlock_);
+  }
 
-    if (valuesRemainingCurrentMiniBlock_ == 0 || totalValuesRemaining_ == 0) {
-      bufferStart_ += bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
+  int64_t readLong() {
+    if (!firstBlockInitialized_) {
+      const auto value = lastValue_;
+      totalValuesRemaining_--;
+      // When block is uninitialized we have two different possibilities:
+      // 1. totalValueCount_ == 1, which means that the page may have only
+      // one value (encoded in the header), and we should not initialize
+      // any block.
+      // 2. totalValueCount_ != 1, which means we should initialize the
+      // incoming block for subsequent reads.
+      if (totalValueCount_ != 1) {
+        initBlock();
+      }
+      return value;
     }
-    return value;
+    if (miniBlockOffset_ == numMiniBlockValues_) {
+      ++miniBlockIdx_;
+      if (miniBlockIdx_ < miniBlocksPerBlock_) {
+        initMiniBlock(deltaBitWidths_[miniBlockIdx_]);
+      } else {
+        initBlock();
+      }
+    }
+    totalValuesRemaining_--;
+    return miniBlockValues_[miniBlockOffset_++];
   }
 
   static constexpr int kMaxDeltaBitWidth =
@@ -235,10 +334,6 @@ class DeltaBpDecoder {
   uint64_t totalValueCount_;
 
   uint64_t totalValuesRemaining_;
-  // Remaining values in current mini block. If the current block is the last
-  // mini block, valuesRemainingCurrentMiniBlock_ may greater than
-  // totalValuesRemaining_.
-  uint64_t valuesRemainingCurrentMiniBlock_;
 
   // If the page doesn't contain any block, `firstBlockInitialized_` will
   // always be false. Otherwise, it will be true when first block initialized.
@@ -248,6 +343,14 @@ class DeltaBpDecoder {
   std::vector<uint8_t> deltaBitWidths_;
   uint64_t deltaBitWidth_;
 
+  // Decoded values of the current miniblock and the position of the next
+  // value to return.
+  std::vector<uint64_t> miniBlockValues_;
+  uint64_t numMiniBlockValues_;
+  uint64_t miniBlockOffset_;
+  // Temporary for the unpacked deltas of a miniblock.
+  std::vector<uint32_t> deltas_;
+
   int64_t lastValue_;
 };
 
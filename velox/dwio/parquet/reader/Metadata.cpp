@@ -241,6 +241,77 @@ int64_t ColumnChunkMetaDataPtr::totalUncompressedSize() const {
   return thriftColumnChunkPtr(ptr_)->meta_data.total_uncompressed_size;
 }
 
+bool ColumnChunkMetaDataPtr::hasPageIndex() const {
+  const auto& isset = thriftColumnChunkPtr(ptr_)->__isset;
+  return isset.column_index_offset && isset.column_index_length &&
+      isset.offset_index_offset && isset.offset_index_length;
+}
+
+int64_t ColumnChunkMetaDataPtr::columnIndexOffset() const {
+  return thriftColumnChunkPtr(ptr_)->column_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::columnIndexLength() const {
+  return thriftColumnChunkPtr(ptr_)->column_index_length;
+}
+
+int64_t ColumnChunkMetaDataPtr::offsetIndexOffset() const {
+  return thriftColumnChunkPtr(ptr_)->offset_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::offsetIndexLength() const {
+  return thriftColumnChunkPtr(ptr_)->offset_index_length;
+}
+
+bool ColumnChunkMetaDataPtr::hasBloomFilterOffset() const {
+  return hasMetadata() &&
+      thriftColumnChunkPtr(ptr_)->meta_data.__isset.bloom_filter_offset;
+}
+
+int64_t ColumnChunkMetaDataPtr::bloomFilterOffset() const {
+  return thriftColumnChunkPtr(ptr_)->meta_data.bloom_filter_offset;
+}
+
+bool ColumnChunkMetaDataPtr::isOnlyDictionaryEncoded() const {
+  if (!hasMetadata()) {
+    return false;
+  }
+  const auto& metadata = thriftColumnChunkPtr(ptr_)->meta_data;
+  auto isDictionary = [](thrift::Encoding::type encoding) {
+    return encoding == thrift::Encoding::PLAIN_DICTIONARY ||
+        encoding == thrift::Encoding::RLE_DICTIONARY;
+  };
+  if (metadata.__isset.encoding_stats) {
+    bool hasDataPage = false;
+    for (const auto& stats : metadata.encoding_stats) {
+      if (stats.page_type != thrift::PageType::DATA_PAGE &&
+          stats.page_type != thrift::PageType::DATA_PAGE_V2) {
+        continue;
+      }
+      if (stats.count > 0 && !isDictionary(stats.encoding)) {
+        return false;
+      }
+      hasDataPage = true;
+    }
+    return hasDataPage;
+  }
+  // Without page encoding stats, only a chunk that uses PLAIN_DICTIONARY for
+  // both dictionary and data pages and RLE/BIT_PACKED for the levels is known
+  // to be fully dictionary encoded. With RLE_DICTIONARY the dictionary page is
+  // PLAIN and a fallback to PLAIN data pages cannot be told apart.
+  bool hasPlainDictionary = false;
+  for (auto encoding : metadata.encodings) {
+    if (encoding == thrift::Encoding::PLAIN_DICTIONARY) {
+      hasPlainDictionary = true;
+    } else if (
+        encoding != thrift::Encoding::RLE &&
+        encoding != thrift::Encoding::BIT_PACKED) {
+      return false;
+    }
+  }
+  return hasPlainDictionary;
+}
+
 FOLLY_ALWAYS_INLINE const thrift::RowGroup* thriftRowGroupPtr(
     const void* metadata) {
   return reinterpret_cast<const thrift::RowGroup*>(metadata);
@@ -21,6 +21,17 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class Statistics;
+} // namespace thrift
+
+/// Builds ColumnStatistics of 'type' from thrift 'columnChunkStats' covering
+/// 'numRowsInRowGroup' rows.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& columnChunkStats,
+    const velox::Type& type,
+    uint64_t numRowsInRowGroup);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -65,6 +76,35 @@ class ColumnChunkMetaDataPtr {
   /// This information is optional and may be 0 if omitted.
   int64_t totalUncompressedSize() const;
 
+  /// Check the presence of both the ColumnIndex and the OffsetIndex of the
+  /// page index in the ColumnChunk.
+  bool hasPageIndex() const;
+
+  /// File offset of the ColumnIndex.
+  /// Must check for its presence using hasPageIndex().
+  int64_t columnIndexOffset() const;
+
+  /// Size of the ColumnIndex in bytes.
+  int32_t columnIndexLength() const;
+
+  /// File offset of the OffsetIndex.
+  /// Must check for its presence using hasPageIndex().
+  int64_t offsetIndexOffset() const;
+
+  /// Size of the OffsetIndex in bytes.
+  int32_t offsetIndexLength() const;
+
+  /// Check the presence of the Bloom filter offset in ColumnChunk metadata.
+  bool hasBloomFilterOffset() const;
+
+  /// File offset of the Bloom filter header.
+  /// Must check for its presence using hasBloomFilterOffset().
+  int64_t bloomFilterOffset() const;
+
+  /// True if all data pages of the column chunk are known to be dictionary
+  /// encoded, i.e. no page falls back to another encoding.
+  bool isOnlyDictionaryEncoded() const;
+
  private:
   const void* ptr_;
 };
@@ -20,11 +20,14 @@
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
 #include "velox/dwio/parquet/common/LevelConversion.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplit.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 #include "velox/vector/FlatVector.h"
 
 #include <thrift/protocol/TCompactProtocol.h> // @manual
+#include <thrift/transport/TBufferTransports.h> // @manual
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -433,12 +436,16 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
             numBytes, inputStream_.get(), strings, bufferStart_, bufferEnd_);
       }
       auto header = strings;
+      bool isAscii = true;
       for (auto i = 0; i < dictionary_.numValues; ++i) {
         auto length = *reinterpret_cast<const int32_t*>(header);
         values[i] = StringView(header + sizeof(int32_t), length);
+        isAscii = isAscii &&
+            functions::stringCore::isAscii(header + sizeof(int32_t), length);
         header += length + sizeof(int32_t);
       }
       VELOX_CHECK_EQ(header, strings + numBytes);
+      dictionary_.isAscii = isAscii;
       break;
     }
     case thrift::Type::FIXED_LEN_BYTE_ARRAY: {
@@ -526,6 +533,180 @@ void PageReader::makeFilterCache(dwio::common::ScanState& state) {
   state.rawState.filterCache = state.filterCache.data();
 }
 
+bool PageReader::preloadDictionary() {
+  if (dictionary_.values) {
+    return true;
+  }
+  if (!isTopLevel_ || pageStart_ != 0 || rowOfPage_ != 0 ||
+      numRowsInPage_ != 0 || chunkSize_ <= 0) {
+    return false;
+  }
+  auto pageHeader = readPageHeader();
+  pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
+  switch (pageHeader.type) {
+    case thrift::PageType::DICTIONARY_PAGE:
+      prepareDictionary(pageHeader);
+      return true;
+    // The header is consumed, so prepare the page like seekToPage(0) would.
+    case thrift::PageType::DATA_PAGE:
+      prepareDataPageV1(pageHeader, 0);
+      return false;
+    case thrift::PageType::DATA_PAGE_V2:
+      prepareDataPageV2(pageHeader, 0);
+      return false;
+    default:
+      skipBytes(
+          pageHeader.compressed_page_size,
+          inputStream_.get(),
+          bufferStart_,
+          bufferEnd_);
+      return false;
+  }
+}
+
+namespace {
+template <typename T>
+int32_t fillFilterCache(
+    const common::Filter& filter,
+    const T* values,
+    int32_t numValues,
+    uint8_t* filterCache) {
+  int32_t numPassed = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    const bool passed = common::applyFilter(filter, values[i]);
+    filterCache[i] = passed ? dwio::common::FilterResult::kSuccess
+                            : dwio::common::FilterResult::kFailure;
+    numPassed += passed;
+  }
+  return numPassed;
+}
+} // namespace
+
+std::optional<int32_t> PageReader::filterDictionary(
+    const common::Filter& filter,
+    dwio::common::ScanState& state) {
+  VELOX_CHECK_NOT_NULL(dictionary_.values);
+  const auto& type = type_->type();
+  // The layout of the values is the one produced by prepareDictionary().
+  auto evaluate = [&](auto* values) {
+    state.dictionary = dictionary_;
+    makeFilterCache(state);
+    state.updateRawState();
+    return fillFilterCache(
+        filter, values, dictionary_.numValues, state.filterCache.data());
+  };
+  switch (type_->parquetType_.value()) {
+    case thrift::Type::INT32:
+      if (type->isShortDecimal()) {
+        return evaluate(dictionary_.values->as<int64_t>());
+      }
+      if (type->kind() == TypeKind::TINYINT ||
+          type->kind() == TypeKind::SMALLINT ||
+          type->kind() == TypeKind::INTEGER) {
+        return evaluate(dictionary_.values->as<int32_t>());
+      }
+      return std::nullopt;
+    case thrift::Type::INT64:
+      if (type->kind() == TypeKind::BIGINT) {
+        return evaluate(dictionary_.values->as<int64_t>());
+      }
+      return std::nullopt;
+    case thrift::Type::FLOAT:
+      return evaluate(dictionary_.values->as<float>());
+    case thrift::Type::DOUBLE:
+      return evaluate(dictionary_.values->as<double>());
+    case thrift::Type::BYTE_ARRAY:
+      if (type->kind() == TypeKind::VARCHAR ||
+          type->kind() == TypeKind::VARBINARY) {
+        return evaluate(dictionary_.values->as<StringView>());
+      }
+      return std::nullopt;
+    default:
+      return std::nullopt;
+  }
+}
+
+BufferPtr PageReader::decompressChunk(int64_t sizeHint) {
+  VELOX_CHECK_EQ(pageStart_, 0, "Column chunk is already being read");
+  BufferPtr chunk;
+  dwio::common::ensureCapacity<char>(
+      chunk, std::max<int64_t>(sizeHint, 1), &pool_);
+  chunk->setSize(0);
+  auto append = [&](const void* data, size_t size) {
+    const auto offset = chunk->size();
+    if (chunk->capacity() < offset + size) {
+      dwio::common::ensureCapacity<char>(
+          chunk, std::max(offset + size, 2 * offset), &pool_, true);
+    }
+    memcpy(chunk->asMutable<char>() + offset, data, size);
+    chunk->setSize(offset + size);
+  };
+
+  auto headerBuffer =
+      std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocolT<
+      apache::thrift::transport::TMemoryBuffer>
+      protocol(headerBuffer);
+  auto appendHeader = [&](const PageHeader& pageHeader) {
+    headerBuffer->resetBuffer();
+    pageHeader.write(&protocol);
+    uint8_t* header;
+    uint32_t headerSize;
+    headerBuffer->getBuffer(&header, &headerSize);
+    append(header, headerSize);
+  };
+
+  while (pageStart_ < chunkSize_) {
+    auto pageHeader = readPageHeader();
+    pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
+    const char* data = readBytes(pageHeader.compressed_page_size, pageBuffer_);
+    // The checksum is over the compressed page.
+    pageHeader.__isset.crc = false;
+    switch (pageHeader.type) {
+      case thrift::PageType::DATA_PAGE:
+      case thrift::PageType::DICTIONARY_PAGE: {
+        data = decompressData(
+            data,
+            pageHeader.compressed_page_size,
+            pageHeader.uncompressed_page_size);
+        pageHeader.compressed_page_size = pageHeader.uncompressed_page_size;
+        appendHeader(pageHeader);
+        append(data, pageHeader.uncompressed_page_size);
+        break;
+      }
+      case thrift::PageType::DATA_PAGE_V2: {
+        auto& v2Header = pageHeader.data_page_header_v2;
+        const int32_t levelsSize = v2Header.repetition_levels_byte_length +
+            v2Header.definition_levels_byte_length;
+        const int32_t compressedSize =
+            pageHeader.compressed_page_size - levelsSize;
+        if (!v2Header.__isset.is_compressed || !v2Header.is_compressed ||
+            compressedSize <= 0) {
+          appendHeader(pageHeader);
+          append(data, pageHeader.compressed_page_size);
+          break;
+        }
+        // The levels are stored uncompressed ahead of the values.
+        const char* values = decompressData(
+            data + levelsSize,
+            compressedSize,
+            pageHeader.uncompressed_page_size - levelsSize);
+        pageHeader.compressed_page_size = pageHeader.uncompressed_page_size;
+        v2Header.__set_is_compressed(false);
+        appendHeader(pageHeader);
+        append(data, levelsSize);
+        append(values, pageHeader.uncompressed_page_size - levelsSize);
+        break;
+      }
+      default:
+        appendHeader(pageHeader);
+        append(data, pageHeader.compressed_page_size);
+        break;
+    }
+  }
+  return chunk;
+}
+
 namespace {
 int32_t parquetTypeBytes(thrift::Type::type type) {
   switch (type) {
@@ -628,6 +809,7 @@ int32_t PageReader::getLengthsAndNulls(
           definitionLevels_.data() + begin, end - begin, info, &bits);
       break;
     case LevelMode::kList: {
+      lengths[0] = 0;
       DefRepLevelsToList(
           definitionLevels_.data() + begin,
           repetitionLevels_.data() + begin,
@@ -717,6 +899,40 @@ void PageReader::makeDecoder() {
               "DELTA_BINARY_PACKED decoder only supports INT32 and INT64");
       }
       break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      switch (parquetType) {
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+        case thrift::Type::INT32:
+        case thrift::Type::INT64: {
+          // The streams are transposed into PLAIN values once per page so
+          // that reads go through the DirectDecoder fast paths.
+          const auto width = parquetTypeBytes(parquetType);
+          VELOX_CHECK_EQ(
+              encodedDataSize_ % width,
+              0,
+              "Invalid BYTE_STREAM_SPLIT data size: {} (corrupt data page?)",
+              encodedDataSize_);
+          dwio::common::ensureCapacity<char>(
+              byteStreamSplitValues_, encodedDataSize_, &pool_);
+          decodeByteStreamSplit(
+              pageData_,
+              encodedDataSize_ / width,
+              width,
+              byteStreamSplitValues_->asMutable<char>());
+          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+              std::make_unique<dwio::common::SeekableArrayInputStream>(
+                  byteStreamSplitValues_->as<char>(), encodedDataSize_),
+              false,
+              width);
+          break;
+        }
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT decoder only supports FLOAT, DOUBLE, INT32 "
+              "and INT64");
+      }
+      break;
     case Encoding::RLE:
       switch (parquetType) {
         case thrift::Type::BOOLEAN:
@@ -997,6 +1213,10 @@ const VectorPtr& PageReader::dictionaryValues(const TypePtr& type) {
         dictionary_.numValues,
         dictionary_.values,
         std::vector<BufferPtr>{dictionary_.strings});
+    if (dictionary_.isAscii) {
+      dictionaryValues_->asUnchecked<FlatVector<StringView>>()->setAllIsAscii(
+          true);
+    }
   }
   return dictionaryValues_;
 }
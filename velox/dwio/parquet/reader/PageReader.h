@@ -127,6 +127,29 @@ class PageReader {
     dictionaryValues_.reset();
   }
 
+  /// Reads the dictionary page of a top level column chunk ahead of the first
+  /// data page. Must be called before any row is read or skipped. Returns true
+  /// if the chunk starts with a dictionary page.
+  bool preloadDictionary();
+
+  /// Evaluates 'filter' once on every entry of the dictionary read by
+  /// preloadDictionary() and installs the dictionary with these results as the
+  /// filter cache of 'state'. Rows are then filtered by looking up their
+  /// dictionary id. Returns the number of entries that pass or std::nullopt if
+  /// the dictionary values are of a type not handled here, in which case
+  /// 'state' is not changed.
+  std::optional<int32_t> filterDictionary(
+      const common::Filter& filter,
+      dwio::common::ScanState& state);
+
+  /// Reads all pages of the column chunk and returns a copy of the chunk where
+  /// the page payloads are decompressed and the page headers describe them as
+  /// uncompressed. A PageReader over the result with CompressionKind_NONE
+  /// reads the same values. 'sizeHint' is the expected size of the result.
+  /// Must be called before any row is read or skipped. Used for decompressing
+  /// row groups ahead of their use on a background executor.
+  BufferPtr decompressChunk(int64_t sizeHint);
+
   bool isDeltaBinaryPacked() const {
     return encoding_ == thrift::Encoding::DELTA_BINARY_PACKED;
   }
@@ -513,6 +536,9 @@ class PageReader {
   std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrDecoder_;
   std::unique_ptr<RleBpDataDecoder> rleBooleanDecoder_;
   // Add decoders for other encodings here.
+
+  // PLAIN values of a BYTE_STREAM_SPLIT page. Read by 'directDecoder_'.
+  BufferPtr byteStreamSplitValues_;
 };
 
 FOLLY_ALWAYS_INLINE dwio::common::compression::CompressionOptions
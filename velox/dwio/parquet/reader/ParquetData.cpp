@@ -16,11 +16,63 @@
 
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/reader/ParquetStatsContext.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
 namespace facebook::velox::parquet {
 
+namespace {
+
+// Reads and deserializes the thrift structure 'T' of 'length' bytes starting
+// at 'offset' of the file behind 'input'.
+template <typename T>
+T readThrift(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    int32_t length) {
+  auto stream =
+      input.read(offset, length, dwio::common::LogType::STRIPE_INDEX);
+  const void* buffer;
+  int32_t size;
+  VELOX_CHECK(stream->Next(&buffer, &size), "Empty page index stream");
+  const char* bufferStart = reinterpret_cast<const char*>(buffer);
+  const char* bufferEnd = bufferStart + size;
+  auto transport = std::make_shared<thrift::ThriftStreamingTransport>(
+      stream.get(), bufferStart, bufferEnd);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+
+// Returns the statistics of 'page' recorded in 'columnIndex'. A page that only
+// has nulls has no min and max values.
+thrift::Statistics pageStatistics(
+    const thrift::ColumnIndex& columnIndex,
+    int32_t page,
+    int64_t numRowsInPage) {
+  thrift::Statistics stats;
+  if (columnIndex.null_pages[page]) {
+    stats.__set_null_count(numRowsInPage);
+    return stats;
+  }
+  stats.__set_min_value(columnIndex.min_values[page]);
+  stats.__set_max_value(columnIndex.max_values[page]);
+  if (columnIndex.__isset.null_counts &&
+      page < columnIndex.null_counts.size()) {
+    stats.__set_null_count(columnIndex.null_counts[page]);
+  }
+  return stats;
+}
+
+} // namespace
+
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
@@ -89,11 +141,199 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   return true;
 }
 
+void ParquetData::filterPages(
+    uint32_t index,
+    const common::ScanSpec& scanSpec,
+    const dwio::common::StatsContext& writerContext,
+    dwio::common::BufferedInput& input,
+    std::vector<RowRange>& skippedRanges) {
+  auto* filter = scanSpec.filter();
+  if (!filter || maxRepeat_ > 0) {
+    return;
+  }
+  auto parquetStatsContext =
+      reinterpret_cast<const ParquetStatsContext*>(&writerContext);
+  if (type_->parquetType_.has_value() &&
+      parquetStatsContext->shouldIgnoreStatistics(
+          type_->parquetType_.value())) {
+    return;
+  }
+  auto rowGroup = fileMetaDataPtr_.rowGroup(index);
+  auto columnChunk = rowGroup.columnChunk(type_->column());
+  if (!columnChunk.hasPageIndex()) {
+    return;
+  }
+
+  const auto offsetIndex = readThrift<thrift::OffsetIndex>(
+      input, columnChunk.offsetIndexOffset(), columnChunk.offsetIndexLength());
+  const auto columnIndex = readThrift<thrift::ColumnIndex>(
+      input, columnChunk.columnIndexOffset(), columnChunk.columnIndexLength());
+  const auto& pages = offsetIndex.page_locations;
+  const auto numPages = pages.size();
+  if (numPages == 0 || columnIndex.null_pages.size() != numPages ||
+      columnIndex.min_values.size() != numPages ||
+      columnIndex.max_values.size() != numPages) {
+    return;
+  }
+
+  const auto& type = type_->type();
+  for (auto i = 0; i < numPages; ++i) {
+    const int64_t begin = pages[i].first_row_index;
+    const int64_t end =
+        i + 1 < numPages ? pages[i + 1].first_row_index : rowGroup.numRows();
+    if (end <= begin) {
+      continue;
+    }
+    auto stats = buildColumnStatisticsFromThrift(
+        pageStatistics(columnIndex, i, end - begin), *type, end - begin);
+    if (!testFilter(filter, stats.get(), end - begin, type)) {
+      skippedRanges.push_back({begin, end});
+    }
+  }
+}
+
+void ParquetData::filterDictionary(
+    uint32_t index,
+    const common::ScanSpec& scanSpec,
+    dwio::common::ScanState& state,
+    std::vector<RowRange>& skippedRanges) {
+  auto* filter = scanSpec.filter();
+  if (!filter || maxRepeat_ > 0 || !reader_) {
+    return;
+  }
+  auto rowGroup = fileMetaDataPtr_.rowGroup(index);
+  auto columnChunk = rowGroup.columnChunk(type_->column());
+  if (!columnChunk.hasDictionaryPageOffset() || !reader_->preloadDictionary()) {
+    return;
+  }
+  auto numPassed = reader_->filterDictionary(*filter, state);
+  if (numPassed.has_value() && numPassed.value() == 0 && !filter->testNull() &&
+      columnChunk.isOnlyDictionaryEncoded()) {
+    skippedRanges.push_back({0, rowGroup.numRows()});
+  }
+}
+
+bool ParquetData::canUseBloomFilter(const common::Filter& filter) const {
+  if (filter.testNull() || maxRepeat_ > 0 || !type_->parquetType_.has_value()) {
+    return false;
+  }
+  const auto& type = type_->type();
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      if (!static_cast<const common::BigintRange&>(filter).isSingleValue()) {
+        return false;
+      }
+      break;
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      break;
+    case common::FilterKind::kBytesRange:
+      if (!static_cast<const common::BytesRange&>(filter).isSingleValue()) {
+        return false;
+      }
+      return type_->parquetType_ == thrift::Type::BYTE_ARRAY &&
+          (type->kind() == TypeKind::VARCHAR ||
+           type->kind() == TypeKind::VARBINARY);
+    case common::FilterKind::kBytesValues:
+      return type_->parquetType_ == thrift::Type::BYTE_ARRAY &&
+          (type->kind() == TypeKind::VARCHAR ||
+           type->kind() == TypeKind::VARBINARY);
+    default:
+      return false;
+  }
+
+  // Integer filters. The Bloom filter hashes the physical value, so only signed
+  // integers without other logical types compare equal to the filter values.
+  switch (type->kind()) {
+    case TypeKind::BIGINT:
+    case TypeKind::INTEGER:
+    case TypeKind::SMALLINT:
+    case TypeKind::TINYINT:
+      break;
+    default:
+      return false;
+  }
+  if (type->isDecimal()) {
+    return false;
+  }
+  if (type_->parquetType_ != thrift::Type::INT32 &&
+      type_->parquetType_ != thrift::Type::INT64) {
+    return false;
+  }
+  if (type_->convertedType_.has_value()) {
+    switch (type_->convertedType_.value()) {
+      case thrift::ConvertedType::INT_8:
+      case thrift::ConvertedType::INT_16:
+      case thrift::ConvertedType::INT_32:
+      case thrift::ConvertedType::INT_64:
+        break;
+      default:
+        return false;
+    }
+  }
+  if (type_->logicalType_.has_value()) {
+    const auto& logicalType = type_->logicalType_.value();
+    if (!logicalType.__isset.INTEGER || !logicalType.INTEGER.isSigned) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParquetData::bloomFilterMatches(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter) const {
+  const bool isInt32 = type_->parquetType_ == thrift::Type::INT32;
+  auto mayContainBigint = [&](int64_t value) {
+    if (isInt32) {
+      if (value < std::numeric_limits<int32_t>::min() ||
+          value > std::numeric_limits<int32_t>::max()) {
+        return false;
+      }
+      return bloomFilter.findHash(
+          bloomFilter.hash(static_cast<int32_t>(value)));
+    }
+    return bloomFilter.findHash(bloomFilter.hash(value));
+  };
+  auto mayContainBytes = [&](std::string_view value) {
+    const ByteArray byteArray(value);
+    return bloomFilter.findHash(bloomFilter.hash(&byteArray));
+  };
+
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return mayContainBigint(
+          static_cast<const common::BigintRange&>(filter).lower());
+    case common::FilterKind::kBigintValuesUsingHashTable: {
+      const auto& values =
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values();
+      return std::any_of(values.begin(), values.end(), mayContainBigint);
+    }
+    case common::FilterKind::kBigintValuesUsingBitmask: {
+      const auto values =
+          static_cast<const common::BigintValuesUsingBitmask&>(filter).values();
+      return std::any_of(values.begin(), values.end(), mayContainBigint);
+    }
+    case common::FilterKind::kBytesRange:
+      return mayContainBytes(
+          static_cast<const common::BytesRange&>(filter).lower());
+    case common::FilterKind::kBytesValues: {
+      const auto& values =
+          static_cast<const common::BytesValues&>(filter).values();
+      return std::any_of(values.begin(), values.end(), mayContainBytes);
+    }
+    default:
+      return true;
+  }
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
   auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
   streams_.resize(fileMetaDataPtr_.numRowGroups());
+  decompressedChunks_.resize(fileMetaDataPtr_.numRowGroups());
   VELOX_CHECK(
       chunk.hasMetadata(),
       "ColumnMetaData does not exist for schema Id ",
@@ -115,17 +355,43 @@ void ParquetData::enqueueRowGroup(
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
 }
 
+void ParquetData::decompressRowGroup(uint32_t index) {
+  VELOX_CHECK_LT(index, streams_.size());
+  VELOX_CHECK(streams_[index], "Stream not enqueued for column");
+  auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  if (chunk.compression() == common::CompressionKind::CompressionKind_NONE) {
+    return;
+  }
+  PageReader reader(
+      std::move(streams_[index]),
+      pool_,
+      type_,
+      chunk.compression(),
+      chunk.totalCompressedSize(),
+      sessionTimezone_);
+  auto decompressed = reader.decompressChunk(chunk.totalUncompressedSize());
+  streams_[index] = std::make_unique<dwio::common::SeekableArrayInputStream>(
+      decompressed->as<char>(), decompressed->size());
+  decompressedChunks_[index] = std::move(decompressed);
+}
+
 dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
   static std::vector<uint64_t> empty;
   VELOX_CHECK_LT(index, streams_.size());
   VELOX_CHECK(streams_[index], "Stream not enqueued for column");
   auto metadata = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  // Frees the chunk of the previous row group, if it was decompressed ahead.
+  decompressedChunk_ = index < decompressedChunks_.size()
+      ? std::move(decompressedChunks_[index])
+      : nullptr;
   reader_ = std::make_unique<PageReader>(
       std::move(streams_[index]),
       pool_,
       type_,
-      metadata.compression(),
-      metadata.totalCompressedSize(),
+      decompressedChunk_ ? common::CompressionKind::CompressionKind_NONE
+                         : metadata.compression(),
+      decompressedChunk_ ? decompressedChunk_->size()
+                         : metadata.totalCompressedSize(),
       sessionTimezone_);
   return dwio::common::PositionProvider(empty);
 }
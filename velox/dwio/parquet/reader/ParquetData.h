@@ -30,6 +30,8 @@ class BufferedInput;
 
 namespace facebook::velox::parquet {
 
+class BloomFilter;
+
 class ParquetParams : public dwio::common::FormatParams {
  public:
   ParquetParams(
@@ -56,6 +58,12 @@ class ParquetParams : public dwio::common::FormatParams {
   const TimestampPrecision timestampPrecision_;
 };
 
+/// A range of rows [begin, end) relative to the start of a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+};
+
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
 class ParquetData : public dwio::common::FormatData {
  public:
@@ -75,6 +83,13 @@ class ParquetData : public dwio::common::FormatData {
   /// Prepares to read data for 'index'th row group.
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
 
+  /// Replaces the stream enqueued for 'index'th row group with a decompressed
+  /// copy of the column chunk allocated from the memory pool of 'this'. The
+  /// stream must have been loaded. May be called on a thread other than the
+  /// one reading 'this' as long as seekToRowGroup() is not called for 'index'
+  /// before this returns.
+  void decompressRowGroup(uint32_t index);
+
   /// Positions 'this' at 'index'th row group. loadRowGroup must be called
   /// first. The returned PositionProvider is empty and should not be used.
   /// Other formats may use it.
@@ -86,6 +101,39 @@ class ParquetData : public dwio::common::FormatData {
       const dwio::common::StatsContext& writerContext,
       FilterRowGroupsResult&) override;
 
+  /// Appends to 'skippedRanges' the row ranges of the pages in 'index'th row
+  /// group where no value can pass the filter in 'scanSpec' according to the
+  /// page index of the column chunk. The page index is read from 'input'.
+  /// Does nothing if the column is repeated or the chunk has no page index.
+  void filterPages(
+      uint32_t index,
+      const common::ScanSpec& scanSpec,
+      const dwio::common::StatsContext& writerContext,
+      dwio::common::BufferedInput& input,
+      std::vector<RowRange>& skippedRanges);
+
+  /// Evaluates the filter in 'scanSpec' once over the dictionary of the column
+  /// chunk in row group 'index' and installs the results as the filter cache
+  /// of 'state', the scan state of the reader of 'this'. Appends the whole row
+  /// group to 'skippedRanges' if no dictionary entry passes and all data pages
+  /// are dictionary encoded. Must be called after seekToRowGroup() and before
+  /// reading.
+  void filterDictionary(
+      uint32_t index,
+      const common::ScanSpec& scanSpec,
+      dwio::common::ScanState& state,
+      std::vector<RowRange>& skippedRanges);
+
+  /// True if 'filter' passes only a finite set of non-null values that can be
+  /// looked up in the Bloom filters of the chunks of the column of 'this'.
+  bool canUseBloomFilter(const common::Filter& filter) const;
+
+  /// False if no value passing 'filter' is in 'bloomFilter' of a chunk of the
+  /// column of 'this'. canUseBloomFilter() must be true for 'filter'.
+  bool bloomFilterMatches(
+      const common::Filter& filter,
+      const BloomFilter& bloomFilter) const;
+
   PageReader* reader() const {
     return reader_.get();
   }
@@ -215,6 +263,11 @@ class ParquetData : public dwio::common::FormatData {
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
+  // Decompressed column chunks backing the streams of the row groups for which
+  // decompressRowGroup() was called.
+  std::vector<BufferPtr> decompressedChunks_;
+  // Decompressed column chunk read by 'reader_', if any.
+  BufferPtr decompressedChunk_;
 
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
@@ -18,6 +18,9 @@
 
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/common/base/AsyncSource.h"
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -36,6 +39,22 @@ bool isParquetReservedKeyword(
       ? true
       : false;
 }
+
+// Parsed footer of a Parquet file in dwio::common::FileMetadataCache. Charged
+// by the serialized size of the footer.
+struct ParquetFileMetadata : public dwio::common::FileMetadata {
+  ParquetFileMetadata(
+      std::shared_ptr<thrift::FileMetaData> _fileMetaData,
+      uint32_t _footerLength)
+      : fileMetaData(std::move(_fileMetaData)), footerLength(_footerLength) {}
+
+  uint64_t size() const override {
+    return footerLength;
+  }
+
+  const std::shared_ptr<thrift::FileMetaData> fileMetaData;
+  const uint32_t footerLength;
+};
 } // namespace
 
 /// Metadata and options for reading Parquet.
@@ -88,11 +107,17 @@ class ReaderBase {
   }
 
   /// Ensures that streams are enqueued and loading for the row group at
-  /// 'currentGroup'. May start loading one or more subsequent groups.
+  /// 'currentGroup'. May start loading one or more subsequent groups. If
+  /// 'executor' is set, the subsequent groups are loaded and their column
+  /// chunks are decompressed on 'executor'. Each of these gets an entry in
+  /// 'pendingRowGroups' that must be moved before seeking to the row group.
   void scheduleRowGroups(
       const std::vector<uint32_t>& groups,
       int32_t currentGroup,
-      StructColumnReader& reader);
+      StructColumnReader& reader,
+      folly::Executor* executor,
+      std::unordered_map<uint32_t, std::shared_ptr<AsyncSource<bool>>>&
+          pendingRowGroups);
 
   /// Returns the uncompressed size for columns in 'type' and its children in
   /// row group.
@@ -104,10 +129,28 @@ class ReaderBase {
   /// the data still exists in the buffered inputs.
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
+  bool bloomFilterPruningEnabled() const {
+    return options_.bloomFilterPruningEnabled();
+  }
+
+  bool dictionaryFilterEnabled() const {
+    return options_.dictionaryFilterEnabled();
+  }
+
+  /// Reads the Bloom filters whose headers start at 'offsets'. Filters inside
+  /// the bytes read with the footer are not read again. The others are
+  /// fetched together in one coalesced load.
+  std::vector<std::unique_ptr<BlockSplitBloomFilter>> loadBloomFilters(
+      const std::vector<int64_t>& offsets) const;
+
  private:
-  // Reads and parses file footer.
+  // Sets the parsed file footer, from the process-wide FileMetadataCache if
+  // the file is cacheable.
   void loadFileMetaData();
 
+  // Reads and parses file footer.
+  void readFileMetaData();
+
   void initializeSchema();
 
   void initializeVersion();
@@ -139,7 +182,15 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // May be shared with readers of the same file through FileMetadataCache.
+  // Must not be modified after loading.
+  std::shared_ptr<thrift::FileMetaData> fileMetaData_;
+  uint32_t footerLength_{0};
+  // Bytes before the footer that were read together with it, starting at file
+  // offset 'tailOffset_'. Kept only if Bloom filter pruning is enabled since
+  // Bloom filters are usually written right before the footer.
+  std::vector<char> tail_;
+  int64_t tailOffset_{0};
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -168,6 +219,28 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
+  auto* cache = dwio::common::FileMetadataCache::getInstance();
+  const auto key = cache == nullptr
+      ? std::nullopt
+      : dwio::common::FileMetadataCache::makeKey(
+            *input_->getReadFile(), options_);
+  if (!key.has_value()) {
+    readFileMetaData();
+    return;
+  }
+  const auto metadata =
+      std::dynamic_pointer_cast<ParquetFileMetadata>(cache->getOrLoad(
+          key.value(), [&]() -> std::shared_ptr<dwio::common::FileMetadata> {
+            readFileMetaData();
+            return std::make_shared<ParquetFileMetadata>(
+                fileMetaData_, footerLength_);
+          }));
+  VELOX_CHECK_NOT_NULL(metadata, "Cached file metadata is not Parquet");
+  fileMetaData_ = metadata->fileMetaData;
+  footerLength_ = metadata->footerLength;
+}
+
+void ReaderBase::readFileMetaData() {
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
@@ -214,8 +287,17 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
+  fileMetaData_ = std::make_shared<thrift::FileMetaData>();
   fileMetaData_->read(thriftProtocol.get());
+  footerLength_ = footerLength;
+
+  // A preloaded file is served from 'input_'.
+  if (options_.bloomFilterPruningEnabled() && !preloadFile &&
+      footerOffsetInBuffer > 0) {
+    copy.resize(footerOffsetInBuffer);
+    tail_ = std::move(copy);
+    tailOffset_ = fileLength_ - readSize;
+  }
 }
 
 void ReaderBase::initializeSchema() {
@@ -879,15 +961,36 @@ std::shared_ptr<const RowType> ReaderBase::createRowType(
 void ReaderBase::scheduleRowGroups(
     const std::vector<uint32_t>& rowGroupIds,
     int32_t currentGroup,
-    StructColumnReader& reader) {
+    StructColumnReader& reader,
+    folly::Executor* executor,
+    std::unordered_map<uint32_t, std::shared_ptr<AsyncSource<bool>>>&
+        pendingRowGroups) {
   auto numRowGroupsToLoad = std::min(
       options_.prefetchRowGroups() + 1,
       static_cast<int64_t>(rowGroupIds.size() - currentGroup));
   for (auto i = 0; i < numRowGroupsToLoad; i++) {
     auto thisGroup = rowGroupIds[currentGroup + i];
-    if (!inputs_[thisGroup]) {
+    if (inputs_[thisGroup]) {
+      continue;
+    }
+    // The current group is needed right away, so it is loaded here.
+    if (executor == nullptr || i == 0) {
       inputs_[thisGroup] = reader.loadRowGroup(thisGroup, input_);
+      continue;
     }
+    bool needsLoad;
+    auto input = reader.enqueueRowGroup(thisGroup, input_, needsLoad);
+    inputs_[thisGroup] = input;
+    auto source = std::make_shared<AsyncSource<bool>>(
+        [&reader, input, needsLoad, thisGroup]() {
+          if (needsLoad) {
+            input->load(dwio::common::LogType::STRIPE);
+          }
+          reader.decompressRowGroup(thisGroup);
+          return std::make_unique<bool>(true);
+        });
+    pendingRowGroups[thisGroup] = source;
+    executor->add([source]() { source->prepare(); });
   }
 
   if (currentGroup >= 1) {
@@ -917,6 +1020,71 @@ bool ReaderBase::isRowGroupBuffered(int32_t rowGroupIndex) const {
   return inputs_.count(rowGroupIndex) != 0;
 }
 
+std::vector<std::unique_ptr<BlockSplitBloomFilter>>
+ReaderBase::loadBloomFilters(const std::vector<int64_t>& offsets) const {
+  // The column metadata has no Bloom filter length. A Bloom filter ends at the
+  // latest where the next structure in the file starts.
+  std::vector<int64_t> boundaries{
+      static_cast<int64_t>(fileLength_ - footerLength_ - 8)};
+  for (const auto& rowGroup : fileMetaData_->row_groups) {
+    for (const auto& column : rowGroup.columns) {
+      const auto& metadata = column.meta_data;
+      boundaries.push_back(metadata.data_page_offset);
+      if (metadata.__isset.dictionary_page_offset) {
+        boundaries.push_back(metadata.dictionary_page_offset);
+      }
+      if (metadata.__isset.bloom_filter_offset) {
+        boundaries.push_back(metadata.bloom_filter_offset);
+      }
+      if (column.__isset.column_index_offset) {
+        boundaries.push_back(column.column_index_offset);
+      }
+      if (column.__isset.offset_index_offset) {
+        boundaries.push_back(column.offset_index_offset);
+      }
+    }
+  }
+  std::sort(boundaries.begin(), boundaries.end());
+
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams;
+  streams.reserve(offsets.size());
+  std::unique_ptr<dwio::common::BufferedInput> bloomFilterInput;
+  for (const auto offset : offsets) {
+    auto next = std::upper_bound(boundaries.begin(), boundaries.end(), offset);
+    VELOX_CHECK(
+        next != boundaries.end(), "Invalid Bloom filter offset: {}", offset);
+    const int64_t length = std::min<int64_t>(
+        *next - offset, BloomFilter::kMaximumBloomFilterBytes);
+    if (input_->isBuffered(offset, length)) {
+      streams.push_back(
+          input_->read(offset, length, dwio::common::LogType::STRIPE_INDEX));
+    } else if (
+        offset >= tailOffset_ &&
+        offset + length <= tailOffset_ + static_cast<int64_t>(tail_.size())) {
+      streams.push_back(std::make_unique<dwio::common::SeekableArrayInputStream>(
+          tail_.data() + offset - tailOffset_, length));
+    } else {
+      if (!bloomFilterInput) {
+        bloomFilterInput = input_->clone();
+      }
+      streams.push_back(
+          bloomFilterInput->enqueue({static_cast<uint64_t>(offset),
+                                     static_cast<uint64_t>(length)}));
+    }
+  }
+  if (bloomFilterInput) {
+    bloomFilterInput->load(dwio::common::LogType::STRIPE_INDEX);
+  }
+
+  std::vector<std::unique_ptr<BlockSplitBloomFilter>> bloomFilters;
+  bloomFilters.reserve(streams.size());
+  for (auto& stream : streams) {
+    bloomFilters.push_back(std::make_unique<BlockSplitBloomFilter>(
+        BlockSplitBloomFilter::deserialize(stream.get(), pool_)));
+  }
+  return bloomFilters;
+}
+
 class ParquetRowReader::Impl {
  public:
   Impl(
@@ -971,6 +1139,13 @@ class ParquetRowReader::Impl {
     }
   }
 
+  ~Impl() {
+    // The pending loads refer to 'columnReader_'.
+    for (auto& [_, source] : pendingRowGroups_) {
+      source->close();
+    }
+  }
+
   void filterRowGroups() {
     rowGroupIds_.reserve(rowGroups_.size());
     firstRowOfRowGroup_.reserve(rowGroups_.size());
@@ -980,18 +1155,13 @@ class ParquetRowReader::Impl {
     if (auto& metadataFilter = options_.metadataFilter()) {
       metadataFilter->eval(res.metadataFilterResults, res.filterResult);
     }
+    if (readerBase_->bloomFilterPruningEnabled()) {
+      filterRowGroupsByBloomFilters(res);
+    }
 
     uint64_t rowNumber = 0;
     for (auto i = 0; i < rowGroups_.size(); i++) {
-      VELOX_CHECK_GT(rowGroups_[i].columns.size(), 0);
-      auto fileOffset = rowGroups_[i].__isset.file_offset
-          ? rowGroups_[i].file_offset
-          : rowGroups_[i].columns[0].meta_data.__isset.dictionary_page_offset
-          ? rowGroups_[i].columns[0].meta_data.dictionary_page_offset
-          : rowGroups_[i].columns[0].meta_data.data_page_offset;
-      VELOX_CHECK_GT(fileOffset, 0);
-      auto rowGroupInRange =
-          (fileOffset >= options_.offset() && fileOffset < options_.limit());
+      auto rowGroupInRange = isRowGroupInRange(i);
 
       auto isExcluded =
           (i < res.totalCount && bits::isBitSet(res.filterResult.data(), i));
@@ -1013,6 +1183,72 @@ class ParquetRowReader::Impl {
     }
   }
 
+  // True if the first byte of 'i'th row group is in the range of the split.
+  bool isRowGroupInRange(int32_t i) const {
+    VELOX_CHECK_GT(rowGroups_[i].columns.size(), 0);
+    auto fileOffset = rowGroups_[i].__isset.file_offset
+        ? rowGroups_[i].file_offset
+        : rowGroups_[i].columns[0].meta_data.__isset.dictionary_page_offset
+        ? rowGroups_[i].columns[0].meta_data.dictionary_page_offset
+        : rowGroups_[i].columns[0].meta_data.data_page_offset;
+    VELOX_CHECK_GT(fileOffset, 0);
+    return fileOffset >= options_.offset() && fileOffset < options_.limit();
+  }
+
+  // Sets the bits in 'res.filterResult' for the row groups where the Bloom
+  // filter of some top level column shows that no value passes its equality
+  // or IN filter. Only row groups that are read and not excluded yet are
+  // checked, so that no Bloom filter is fetched for them.
+  void filterRowGroupsByBloomFilters(
+      ParquetData::FilterRowGroupsResult& res) {
+    struct BloomFilterCheck {
+      uint32_t rowGroup;
+      const ParquetData* column;
+      const common::Filter* filter;
+    };
+    std::vector<BloomFilterCheck> checks;
+    std::vector<int64_t> offsets;
+    const auto fileMetaData = readerBase_->fileMetaData();
+    for (auto* child : columnReader_->children()) {
+      const auto* filter = child->scanSpec()->filter();
+      if (!filter || !child->fileType().type()->isPrimitiveType()) {
+        continue;
+      }
+      const auto& column = child->formatData().as<ParquetData>();
+      if (!column.canUseBloomFilter(*filter)) {
+        continue;
+      }
+      for (auto i = 0; i < rowGroups_.size(); ++i) {
+        if ((i < res.totalCount && bits::isBitSet(res.filterResult.data(), i)) ||
+            rowGroups_[i].num_rows == 0 || !isRowGroupInRange(i)) {
+          continue;
+        }
+        auto columnChunk =
+            fileMetaData.rowGroup(i).columnChunk(child->fileType().column());
+        if (columnChunk.hasBloomFilterOffset()) {
+          checks.push_back({static_cast<uint32_t>(i), &column, filter});
+          offsets.push_back(columnChunk.bloomFilterOffset());
+        }
+      }
+    }
+    if (checks.empty()) {
+      return;
+    }
+
+    auto bloomFilters = readerBase_->loadBloomFilters(offsets);
+    res.totalCount = std::max<int>(res.totalCount, rowGroups_.size());
+    const auto nwords = bits::nwords(res.totalCount);
+    if (res.filterResult.size() < nwords) {
+      res.filterResult.resize(nwords);
+    }
+    for (auto i = 0; i < checks.size(); ++i) {
+      const auto& check = checks[i];
+      if (!check.column->bloomFilterMatches(*check.filter, *bloomFilters[i])) {
+        bits::setBit(res.filterResult.data(), check.rowGroup);
+      }
+    }
+  }
+
   int64_t nextRowNumber() {
     if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
         !advanceToNextRowGroup()) {
@@ -1026,7 +1262,12 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    // A batch does not cross the boundary of a range skipped based on the page
+    // index so that it is either read or skipped as a whole.
+    return std::min(
+        {size,
+         rowsInCurrentRowGroup_ - currentRowInGroup_,
+         rowsToSkippedRangeBoundary()});
   }
 
   uint64_t next(
@@ -1038,6 +1279,10 @@ class ParquetRowReader::Impl {
       return 0;
     }
     VELOX_DCHECK_GT(rowsToRead, 0);
+    if (inSkippedRange()) {
+      skipRows(rowsToRead, result);
+      return rowsToRead;
+    }
     columnReader_->setCurrentRowNumber(nextRowNumber());
     if (!options_.rowNumberColumnInfo().has_value()) {
       columnReader_->next(rowsToRead, result, mutation);
@@ -1063,8 +1308,17 @@ class ParquetRowReader::Impl {
         rowGroups_[index].num_rows;
   }
 
+  uint64_t numRowsInRange() const {
+    uint64_t numRows = 0;
+    for (auto rowGroupId : rowGroupIds_) {
+      numRows += rowGroups_[rowGroupId].num_rows;
+    }
+    return numRows;
+  }
+
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += rowGroups_.size() - rowGroupIds_.size();
+    stats.skippedPageRows += skippedPageRows_;
   }
 
   void resetFilterCaches() {
@@ -1085,19 +1339,85 @@ class ParquetRowReader::Impl {
     readerBase_->scheduleRowGroups(
         rowGroupIds_,
         nextRowGroupIdsIdx_,
-        static_cast<StructColumnReader&>(*columnReader_));
+        static_cast<StructColumnReader&>(*columnReader_),
+        options_.decodingExecutor().get(),
+        pendingRowGroups_);
+    auto it = pendingRowGroups_.find(nextRowGroupIndex);
+    if (it != pendingRowGroups_.end()) {
+      // Waits for the background load or makes it here if not started.
+      auto source = std::move(it->second);
+      pendingRowGroups_.erase(it);
+      source->move();
+    }
     currentRowGroupPtr_ = &rowGroups_[rowGroupIds_[nextRowGroupIdsIdx_]];
     rowsInCurrentRowGroup_ = currentRowGroupPtr_->num_rows;
     currentRowInGroup_ = 0;
     nextRowGroupIdsIdx_++;
     columnReader_->seekToRowGroup(nextRowGroupIndex);
+    filterPages(nextRowGroupIndex);
     return true;
   }
 
+  // Finds the row ranges of the current row group where the page indexes or
+  // the dictionaries of the filtered columns show that no row can pass the
+  // filters.
+  void filterPages(uint32_t rowGroupIndex) {
+    skippedRanges_.clear();
+    nextSkippedRange_ = 0;
+    if (!options_.scanSpec()->hasFilter()) {
+      return;
+    }
+    static_cast<StructColumnReader&>(*columnReader_)
+        .filterPages(
+            rowGroupIndex,
+            parquetStatsContext_,
+            readerBase_->bufferedInput(),
+            readerBase_->dictionaryFilterEnabled(),
+            skippedRanges_);
+  }
+
+  // Returns the number of rows from the current row to the start or the end of
+  // the next skipped range, whichever comes first.
+  uint64_t rowsToSkippedRangeBoundary() {
+    const int64_t row = currentRowInGroup_;
+    while (nextSkippedRange_ < skippedRanges_.size() &&
+           skippedRanges_[nextSkippedRange_].end <= row) {
+      ++nextSkippedRange_;
+    }
+    if (nextSkippedRange_ == skippedRanges_.size()) {
+      return rowsInCurrentRowGroup_ - currentRowInGroup_;
+    }
+    const auto& range = skippedRanges_[nextSkippedRange_];
+    return range.begin <= row ? range.end - row : range.begin - row;
+  }
+
+  bool inSkippedRange() const {
+    return nextSkippedRange_ < skippedRanges_.size() &&
+        skippedRanges_[nextSkippedRange_].begin <=
+        static_cast<int64_t>(currentRowInGroup_);
+  }
+
+  // Skips 'numRows' rows in a range that cannot pass the filters and returns an
+  // empty 'result'. Only the top level reader is advanced here. The children
+  // catch up on their next read, which skips whole pages without decompressing
+  // or decoding them.
+  void skipRows(uint64_t numRows, velox::VectorPtr& result) {
+    columnReader_->setReadOffset(columnReader_->readOffset() + numRows);
+    currentRowInGroup_ += numRows;
+    skippedPageRows_ += numRows;
+    result = BaseVector::create(
+        result ? result->type() : requestedType_, 0, &pool_);
+  }
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions options_;
 
+  // Loads of the row groups ahead of the current one running on the decoding
+  // executor of 'options_', keyed on row group index.
+  std::unordered_map<uint32_t, std::shared_ptr<AsyncSource<bool>>>
+      pendingRowGroups_;
+
   // All row groups from file metadata.
   std::vector<thrift::RowGroup>& rowGroups_;
   // Indices of row groups where stats match filters.
@@ -1108,6 +1428,14 @@ class ParquetRowReader::Impl {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
 
+  // Sorted ranges of rows in the current row group that are skipped based on
+  // the page index.
+  std::vector<RowRange> skippedRanges_;
+  // Index of the first range in 'skippedRanges_' that ends after
+  // 'currentRowInGroup_'.
+  size_t nextSkippedRange_{0};
+  int64_t skippedPageRows_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
   TypePtr requestedType_;
@@ -1158,6 +1486,10 @@ std::optional<size_t> ParquetRowReader::estimatedRowSize() const {
   return impl_->estimatedRowSize();
 }
 
+std::optional<uint64_t> ParquetRowReader::numRowsInRange() const {
+  return impl_->numRowsInRange();
+}
+
 ParquetReader::ParquetReader(
     std::unique_ptr<dwio::common::BufferedInput> input,
     const dwio::common::ReaderOptions& options)
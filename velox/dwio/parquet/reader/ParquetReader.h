@@ -60,6 +60,8 @@ class ParquetRowReader : public dwio::common::RowReader {
 
   std::optional<size_t> estimatedRowSize() const override;
 
+  std::optional<uint64_t> numRowsInRange() const override;
+
   bool allPrefetchIssued() const override {
     //  Allow opening the next split while this is reading.
     return true;
@@ -21,6 +21,14 @@
 namespace facebook::velox::parquet {
 
 void RleBpDecoder::skip(uint64_t numValues) {
+  // Skips the values unpacked by a previous next() first.
+  if (numRemainingUnpackedValues_ > 0) {
+    const auto count =
+        std::min<uint64_t>(numValues, numRemainingUnpackedValues_);
+    numRemainingUnpackedValues_ -= count;
+    remainingUnpackedValuesOffset_ += count;
+    numValues -= count;
+  }
   while (numValues > 0) {
     if (!remainingValues_) {
       readHeader();
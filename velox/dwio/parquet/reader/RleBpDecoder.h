@@ -111,7 +111,7 @@ class RleBpDecoder {
         outputBuffer,
         reinterpret_cast<T*>(remainingUnpackedValues_) +
             remainingUnpackedValuesOffset_,
-        numValues);
+        numValues * sizeof(T));
 
     outputBuffer += numValues;
     numRemainingUnpackedValues_ -= numValues;
@@ -111,16 +111,47 @@ void StructColumnReader::read(
 std::shared_ptr<dwio::common::BufferedInput> StructColumnReader::loadRowGroup(
     uint32_t index,
     const std::shared_ptr<dwio::common::BufferedInput>& input) {
-  if (isRowGroupBuffered(index, *input)) {
+  bool needsLoad;
+  auto result = enqueueRowGroup(index, input, needsLoad);
+  if (needsLoad) {
+    result->load(dwio::common::LogType::STRIPE);
+  }
+  return result;
+}
+
+std::shared_ptr<dwio::common::BufferedInput>
+StructColumnReader::enqueueRowGroup(
+    uint32_t index,
+    const std::shared_ptr<dwio::common::BufferedInput>& input,
+    bool& needsLoad) {
+  needsLoad = !isRowGroupBuffered(index, *input);
+  if (!needsLoad) {
     enqueueRowGroup(index, *input);
     return input;
   }
   auto newInput = input->clone();
   enqueueRowGroup(index, *newInput);
-  newInput->load(dwio::common::LogType::STRIPE);
   return newInput;
 }
 
+namespace {
+void decompressLeaves(
+    dwio::common::SelectiveColumnReader& reader,
+    uint32_t index) {
+  if (reader.fileType().column() != ParquetTypeWithId::kNonLeaf) {
+    reader.formatData().as<ParquetData>().decompressRowGroup(index);
+    return;
+  }
+  for (auto* child : reader.children()) {
+    decompressLeaves(*child, index);
+  }
+}
+} // namespace
+
+void StructColumnReader::decompressRowGroup(uint32_t index) {
+  decompressLeaves(*this, index);
+}
+
 bool StructColumnReader::isRowGroupBuffered(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -202,4 +233,47 @@ void StructColumnReader::filterRowGroups(
   }
 }
 
+void StructColumnReader::filterPages(
+    uint32_t index,
+    const dwio::common::StatsContext& context,
+    dwio::common::BufferedInput& input,
+    bool filterDictionaries,
+    std::vector<RowRange>& skippedRanges) {
+  skippedRanges.clear();
+  for (auto* child : children_) {
+    if (!child->scanSpec()->filter() ||
+        !child->fileType().type()->isPrimitiveType()) {
+      continue;
+    }
+    auto& formatData = child->formatData().as<ParquetData>();
+    if (filterDictionaries) {
+      formatData.filterDictionary(
+          index, *child->scanSpec(), child->scanState(), skippedRanges);
+    }
+    formatData.filterPages(
+        index, *child->scanSpec(), context, input, skippedRanges);
+  }
+  if (skippedRanges.empty()) {
+    return;
+  }
+  // A row is skipped if any filter fails on it, so the result is the union of
+  // the ranges of all children.
+  std::sort(
+      skippedRanges.begin(),
+      skippedRanges.end(),
+      [](const RowRange& left, const RowRange& right) {
+        return left.begin < right.begin;
+      });
+  int32_t numMerged = 0;
+  for (auto i = 1; i < skippedRanges.size(); ++i) {
+    auto& last = skippedRanges[numMerged];
+    if (skippedRanges[i].begin <= last.end) {
+      last.end = std::max(last.end, skippedRanges[i].end);
+    } else {
+      skippedRanges[++numMerged] = skippedRanges[i];
+    }
+  }
+  skippedRanges.resize(numMerged + 1);
+}
+
 } // namespace facebook::velox::parquet
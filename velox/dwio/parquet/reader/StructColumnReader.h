@@ -28,6 +28,7 @@ namespace facebook::velox::parquet {
 enum class LevelMode;
 class PageReader;
 class ParquetParams;
+struct RowRange;
 
 class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
  public:
@@ -49,6 +50,19 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
       uint32_t index,
       const std::shared_ptr<dwio::common::BufferedInput>& input);
 
+  /// Creates the streams for 'rowGroup' like loadRowGroup() without loading
+  /// them. Returns the input holding the streams and sets 'needsLoad' if it
+  /// must be loaded before the streams are read.
+  std::shared_ptr<dwio::common::BufferedInput> enqueueRowGroup(
+      uint32_t index,
+      const std::shared_ptr<dwio::common::BufferedInput>& input,
+      bool& needsLoad);
+
+  /// Replaces the loaded streams of the leaf columns for 'index'th row group
+  /// with decompressed copies of their column chunks. See
+  /// ParquetData::decompressRowGroup().
+  void decompressRowGroup(uint32_t index);
+
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
   void advanceFieldReader(
@@ -75,6 +89,20 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
       const dwio::common::StatsContext&,
       dwio::common::FormatData::FilterRowGroupsResult&) const override;
 
+  /// Returns in 'skippedRanges' the sorted, disjoint row ranges of 'index'th
+  /// row group where some direct child has a filter that no value can pass
+  /// according to the page index of the child's column chunk. The page
+  /// indexes are read from 'input'. If 'filterDictionaries' is true, the
+  /// filters are also evaluated once over the dictionaries of dictionary
+  /// encoded children and the whole row group is skipped if no dictionary
+  /// entry of some child passes.
+  void filterPages(
+      uint32_t index,
+      const dwio::common::StatsContext& context,
+      dwio::common::BufferedInput& input,
+      bool filterDictionaries,
+      std::vector<RowRange>& skippedRanges);
+
  private:
   dwio::common::SelectiveColumnReader* findBestLeaf();
 
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/common/BitStreamUtilsInternal.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace facebook::velox::parquet {
+namespace {
+
+template <typename T>
+void testGetBatch(int bitWidth) {
+  SCOPED_TRACE(fmt::format("{} bits into {} bytes", bitWidth, sizeof(T)));
+  constexpr int32_t kNumValues = 10'000;
+  std::mt19937 rng(bitWidth);
+  std::vector<uint64_t> values(kNumValues);
+  for (auto& value : values) {
+    value = rng() & bits::lowMask(bitWidth);
+  }
+  std::vector<uint8_t> buffer(kNumValues * bitWidth / 8 + 8);
+  BitWriter writer(buffer.data(), buffer.size());
+  for (auto value : values) {
+    ASSERT_TRUE(writer.PutValue(value, bitWidth));
+  }
+  writer.Flush();
+
+  // Reads an unaligned first value and then batches of varying sizes so that
+  // both the vectorized and the scalar paths are used.
+  BitReader reader(buffer.data(), writer.bytesWritten());
+  std::vector<T> result(kNumValues);
+  ASSERT_TRUE(reader.GetValue(bitWidth, result.data()));
+  int32_t numRead = 1;
+  int32_t batchSize = 1;
+  while (numRead < kNumValues) {
+    const auto toRead = std::min(batchSize, kNumValues - numRead);
+    ASSERT_EQ(
+        reader.GetBatch(bitWidth, result.data() + numRead, toRead), toRead);
+    numRead += toRead;
+    batchSize = batchSize * 3 + 1;
+  }
+  for (auto i = 0; i < kNumValues; ++i) {
+    ASSERT_EQ(static_cast<std::make_unsigned_t<T>>(result[i]), values[i])
+        << "at " << i;
+  }
+}
+
+TEST(BitStreamUtilsTest, getBatchNarrowTypes) {
+  for (auto bitWidth = 1; bitWidth <= 8; ++bitWidth) {
+    testGetBatch<uint8_t>(bitWidth);
+  }
+  for (auto bitWidth = 1; bitWidth <= 16; ++bitWidth) {
+    testGetBatch<int16_t>(bitWidth);
+    testGetBatch<uint16_t>(bitWidth);
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::parquet
@@ -362,6 +362,56 @@ TYPED_TEST(NestedListTest, SimpleLongList) {
       "1");
 }
 
+TYPED_TEST(NestedListTest, MixedLongList) {
+  LevelInfo levelInfo;
+  levelInfo.repLevel = 1;
+  levelInfo.defLevel = 2;
+  levelInfo.repeatedAncestorDefLevel = 0;
+
+  // Cycles through null, empty and two element lists so that the levels span
+  // several 64 level blocks and lists cross block boundaries.
+  constexpr int kNumLists = 100;
+  MultiLevelTestData testData;
+  std::vector<typename TypeParam::OffsetsType> expectedOffsets(1, 0);
+  std::vector<bool> expectedValid;
+  for (int i = 0; i < kNumLists; ++i) {
+    auto numElements = expectedOffsets.back();
+    switch (i % 3) {
+      case 0:
+        testData.defLevels.push_back(0);
+        testData.repLevels.push_back(0);
+        break;
+      case 1:
+        testData.defLevels.push_back(1);
+        testData.repLevels.push_back(0);
+        break;
+      default:
+        testData.defLevels.insert(testData.defLevels.end(), {2, 2});
+        testData.repLevels.insert(testData.repLevels.end(), {0, 1});
+        numElements += 2;
+        break;
+    }
+    expectedOffsets.push_back(numElements);
+    expectedValid.push_back(i % 3 != 0);
+  }
+
+  this->InitForLength(kNumLists);
+  typename TypeParam::OffsetsType* next_position =
+      this->Run(testData, levelInfo);
+
+  EXPECT_EQ(next_position, this->offsets_.data() + kNumLists);
+  EXPECT_THAT(this->offsets_, testing::ElementsAreArray(expectedOffsets));
+
+  EXPECT_EQ(this->validityIo_.valuesRead, kNumLists);
+  EXPECT_EQ(this->validityIo_.nullCount, (kNumLists + 2) / 3);
+  for (int i = 0; i < kNumLists; ++i) {
+    EXPECT_EQ(
+        ::arrow::bit_util::GetBit(this->validityIo_.validBits, i),
+        expectedValid[i])
+        << i;
+  }
+}
+
 TYPED_TEST(NestedListTest, TestOverflow) {
   LevelInfo levelInfo;
   levelInfo.repLevel = 1;
@@ -24,18 +24,164 @@
 #include <vector>
 
 #include <gtest/gtest.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
 
+#include "velox/common/file/File.h"
 #include "velox/dwio/common/OutputStream.h"
 #include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/common/XxHasher.h"
 #include "velox/dwio/parquet/reader/ParquetData.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+#include "velox/type/Filter.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::parquet;
 
-class BloomFilterTest : public ParquetTestBase {};
+class BloomFilterTest : public ParquetTestBase {
+ protected:
+  static constexpr int32_t kNumRowGroups = 4;
+  static constexpr int32_t kRowsPerRowGroup = 1'000;
+
+  // Id of the 'row'-th row of row group 'rowGroup'. The ids of all row groups
+  // interleave so that min/max statistics can not prune any of them.
+  static int64_t idAt(int32_t rowGroup, int32_t row) {
+    return row * kNumRowGroups + rowGroup;
+  }
+
+  static std::string nameOf(int64_t id) {
+    return fmt::format("name{}", id);
+  }
+
+  std::string serialize(const BlockSplitBloomFilter& bloomFilter) {
+    dwio::common::DataBufferHolder bufferHolder{*leafPool_, 1024};
+    dwio::common::AppendOnlyBufferedStream sink(
+        std::make_unique<dwio::common::BufferedOutputStream>(bufferHolder));
+    bloomFilter.writeTo(&sink);
+    sink.flush();
+    std::string buffer;
+    for (auto& tmpBuffer : bufferHolder.getBuffers()) {
+      buffer.append(tmpBuffer.data(), tmpBuffer.size());
+    }
+    return buffer;
+  }
+
+  // Writes kNumRowGroups row groups of ROW(id BIGINT, name VARCHAR) and, since
+  // the Velox writer does not produce Bloom filters, appends a split block
+  // Bloom filter for every column chunk and rewrites the footer to point at
+  // them. Returns the path of the resulting file.
+  std::string writeFileWithBloomFilters() {
+    auto rowType = ROW({"id", "name"}, {BIGINT(), VARCHAR()});
+    auto path = tempPath_->getPath() + "/written.parquet";
+    auto writer = createWriter(
+        createSink(path),
+        [] {
+          return std::make_unique<DefaultFlushPolicy>(
+              kRowsPerRowGroup, 128 * 1'024 * 1'024);
+        },
+        rowType);
+    for (auto rowGroup = 0; rowGroup < kNumRowGroups; ++rowGroup) {
+      std::vector<int64_t> ids;
+      std::vector<std::string> names;
+      for (auto row = 0; row < kRowsPerRowGroup; ++row) {
+        ids.push_back(idAt(rowGroup, row));
+        names.push_back(nameOf(ids.back()));
+      }
+      writer->write(makeRowVector(
+          {"id", "name"},
+          {makeFlatVector<int64_t>(ids), makeFlatVector<std::string>(names)}));
+    }
+    writer->close();
+
+    auto readFile = std::make_shared<LocalReadFile>(path);
+    auto content = readFile->pread(0, readFile->size());
+    uint32_t footerLength;
+    memcpy(&footerLength, content.data() + content.size() - 8, 4);
+    const auto footerStart = content.size() - 8 - footerLength;
+
+    thrift::FileMetaData fileMetaData;
+    auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+        content.data() + footerStart, footerLength);
+    apache::thrift::protocol::TCompactProtocolT<thrift::ThriftBufferedTransport>
+        readProtocol(transport);
+    fileMetaData.read(&readProtocol);
+    EXPECT_EQ(fileMetaData.row_groups.size(), kNumRowGroups);
+
+    std::string rewritten = content.substr(0, footerStart);
+    for (auto rowGroup = 0; rowGroup < kNumRowGroups; ++rowGroup) {
+      BlockSplitBloomFilter idFilter(leafPool_.get());
+      BlockSplitBloomFilter nameFilter(leafPool_.get());
+      const auto numBytes =
+          BlockSplitBloomFilter::optimalNumOfBytes(kRowsPerRowGroup, 0.0001);
+      idFilter.init(numBytes);
+      nameFilter.init(numBytes);
+      for (auto row = 0; row < kRowsPerRowGroup; ++row) {
+        const auto id = idAt(rowGroup, row);
+        idFilter.insertHash(idFilter.hash(id));
+        const auto name = nameOf(id);
+        const ByteArray byteArray(name);
+        nameFilter.insertHash(nameFilter.hash(&byteArray));
+      }
+      auto& columns = fileMetaData.row_groups[rowGroup].columns;
+      columns[0].meta_data.__set_bloom_filter_offset(rewritten.size());
+      rewritten += serialize(idFilter);
+      columns[1].meta_data.__set_bloom_filter_offset(rewritten.size());
+      rewritten += serialize(nameFilter);
+    }
+
+    auto memoryBuffer =
+        std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+    apache::thrift::protocol::TCompactProtocolT<
+        apache::thrift::transport::TMemoryBuffer>
+        writeProtocol(memoryBuffer);
+    fileMetaData.write(&writeProtocol);
+    const auto footer = memoryBuffer->getBufferAsString();
+    footerLength = footer.size();
+    rewritten += footer;
+    rewritten.append(reinterpret_cast<const char*>(&footerLength), 4);
+    rewritten += "PAR1";
+
+    auto bloomPath = tempPath_->getPath() + "/bloom.parquet";
+    LocalWriteFile writeFile(bloomPath);
+    writeFile.append(rewritten);
+    writeFile.close();
+    return bloomPath;
+  }
+
+  // Reads 'path' with 'filter' on 'column' and returns the ids of the rows
+  // read together with the number of row groups skipped.
+  std::pair<std::vector<int64_t>, int64_t> readWithFilter(
+      const std::string& path,
+      const std::string& column,
+      std::unique_ptr<common::Filter> filter,
+      dwio::common::ReaderOptions readerOptions) {
+    auto reader = createReader(path, readerOptions);
+    auto rowType = reader->rowType();
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName(column)->setFilter(std::move(filter));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    std::vector<int64_t> ids;
+    VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+    while (rowReader->next(1'000, result) > 0) {
+      auto* idVector = result->as<RowVector>()
+                           ->childAt(0)
+                           ->loadedVector()
+                           ->as<SimpleVector<int64_t>>();
+      for (auto i = 0; i < result->size(); ++i) {
+        ids.push_back(idVector->valueAt(i));
+      }
+    }
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return {ids, stats.skippedStrides};
+  }
+};
 
 TEST_F(BloomFilterTest, ConstructorTest) {
   BlockSplitBloomFilter bloomFilter(leafPool_.get());
@@ -395,3 +541,64 @@ TEST_F(BloomFilterTest, TestBloomFilterHashes) {
         << "Hash with seed 0 Error: " << i;
   }
 }
+
+TEST_F(BloomFilterTest, rowGroupPruning) {
+  const auto path = writeFileWithBloomFilters();
+  const auto fileSize = std::make_shared<LocalReadFile>(path)->size();
+
+  // Preloaded file, footer tail covering the Bloom filters, and a short tail
+  // that makes the reader fetch the Bloom filters separately.
+  std::vector<std::pair<uint64_t, uint64_t>> footerAndPreloadSizes = {
+      {1'024 * 1'024, 8 * 1'024 * 1'024}, {fileSize - 100, 0}, {1'024, 0}};
+  for (const auto& [footerSize, preloadThreshold] : footerAndPreloadSizes) {
+    SCOPED_TRACE(fmt::format("footer estimated size {}", footerSize));
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setFooterEstimatedSize(footerSize);
+    readerOptions.setFilePreloadThreshold(preloadThreshold);
+
+    // Without Bloom filters the interleaved ids defeat min/max pruning.
+    auto [ids, skipped] = readWithFilter(
+        path,
+        "id",
+        common::createBigintValues({idAt(2, 0), idAt(2, 1)}, false),
+        readerOptions);
+    EXPECT_EQ(ids, std::vector<int64_t>({idAt(2, 0), idAt(2, 1)}));
+    EXPECT_EQ(skipped, 0);
+
+    readerOptions.setBloomFilterPruningEnabled(true);
+    std::tie(ids, skipped) = readWithFilter(
+        path,
+        "id",
+        common::createBigintValues({idAt(2, 0), idAt(2, 1)}, false),
+        readerOptions);
+    EXPECT_EQ(ids, std::vector<int64_t>({idAt(2, 0), idAt(2, 1)}));
+    EXPECT_EQ(skipped, kNumRowGroups - 1);
+
+    std::tie(ids, skipped) = readWithFilter(
+        path,
+        "id",
+        std::make_unique<common::BigintRange>(idAt(1, 7), idAt(1, 7), false),
+        readerOptions);
+    EXPECT_EQ(ids, std::vector<int64_t>({idAt(1, 7)}));
+    EXPECT_EQ(skipped, kNumRowGroups - 1);
+
+    std::tie(ids, skipped) = readWithFilter(
+        path,
+        "name",
+        std::make_unique<common::BytesValues>(
+            std::vector<std::string>{nameOf(idAt(0, 3)), nameOf(idAt(3, 5))},
+            false),
+        readerOptions);
+    EXPECT_EQ(ids, std::vector<int64_t>({idAt(0, 3), idAt(3, 5)}));
+    EXPECT_EQ(skipped, kNumRowGroups - 2);
+
+    // Nulls can not be looked up in a Bloom filter.
+    std::tie(ids, skipped) = readWithFilter(
+        path,
+        "id",
+        common::createBigintValues({idAt(2, 0), idAt(2, 1)}, true),
+        readerOptions);
+    EXPECT_EQ(ids, std::vector<int64_t>({idAt(2, 0), idAt(2, 1)}));
+    EXPECT_EQ(skipped, 0);
+  }
+}
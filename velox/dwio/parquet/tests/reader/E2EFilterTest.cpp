@@ -20,6 +20,7 @@
 #include "velox/dwio/parquet/writer/Writer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 
 using namespace facebook;
@@ -331,6 +332,27 @@ TEST_F(E2EFilterTest, floatAndDoubleDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, floatAndDoubleByteStreamSplit) {
+  options_.enableByteStreamSplit = true;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "float_val:float,"
+      "double_val:double,"
+      "float_val2:float,"
+      "double_val2:double,"
+      "long_val:bigint,"
+      "float_null:float",
+      [&]() {
+        makeAllNulls("float_null");
+        makeQuantizedFloat<float>("float_val2", 200, true);
+        makeQuantizedFloat<double>("double_val2", 522, true);
+      },
+      true,
+      {"float_val", "double_val", "float_val2", "double_val2", "float_null"},
+      20);
+}
+
 TEST_F(E2EFilterTest, floatAndDouble) {
   // float_val and double_val may be direct since the
   // values are random.float_val2 and double_val2 are expected to be
@@ -789,6 +811,242 @@ TEST_F(E2EFilterTest, booleanRle) {
       20);
 }
 
+TEST_F(E2EFilterTest, pageIndex) {
+  options_.enableDictionary = false;
+  options_.enablePageIndex = true;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "long_val:bigint,"
+      "double_val:double,"
+      "string_val:string",
+      [&]() { makeStringUnique("string_val"); },
+      false,
+      {"short_val", "long_val", "double_val", "string_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, pageIndexSkipsPages) {
+  options_.enableDictionary = false;
+  options_.enablePageIndex = true;
+  options_.dataPageSize = 1024;
+  constexpr int32_t kSize = 10'000;
+  rowType_ = ROW({"c0", "c1"}, {BIGINT(), DOUBLE()});
+  auto batch = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+       makeFlatVector<double>(kSize, [](auto row) { return row * 0.5; })});
+  writeToMemory(rowType_, {batch}, false);
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto input = std::make_unique<BufferedInput>(
+      std::make_shared<InMemoryReadFile>(sinkData_), readerOpts.memoryPool());
+  auto reader = makeReader(readerOpts, std::move(input));
+  auto spec = std::make_shared<ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType_);
+  spec->childByName("c0")->setFilter(
+      std::make_unique<BigintRange>(5'000, 5'099, false));
+  RowReaderOptions rowReaderOpts;
+  setUpRowReaderOptions(rowReaderOpts, spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  std::vector<int64_t> values;
+  auto result = BaseVector::create(rowType_, 0, leafPool_.get());
+  while (rowReader->next(1'000, result) > 0) {
+    auto* rowVector = result->as<RowVector>();
+    auto* c0 =
+        rowVector->childAt(0)->loadedVector()->as<SimpleVector<int64_t>>();
+    auto* c1 =
+        rowVector->childAt(1)->loadedVector()->as<SimpleVector<double>>();
+    for (auto i = 0; i < result->size(); ++i) {
+      values.push_back(c0->valueAt(i));
+      EXPECT_EQ(c1->valueAt(i), c0->valueAt(i) * 0.5);
+    }
+  }
+  ASSERT_EQ(values.size(), 100);
+  for (auto i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], 5'000 + i);
+  }
+
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_EQ(stats.skippedStrides, 0);
+  EXPECT_GT(stats.skippedPageRows, kSize / 2);
+  EXPECT_LT(stats.skippedPageRows, kSize);
+}
+
+TEST_F(E2EFilterTest, dictionaryFilterSkipsRowGroups) {
+  options_.enableDictionary = true;
+  rowsInRowGroup_ = 1'000;
+  constexpr int32_t kNumRowGroups = 4;
+  rowType_ = ROW({"c0", "c1"}, {VARCHAR(), BIGINT()});
+  // Each row group has two distinct values per column. The min/max ranges of
+  // all row groups overlap, so only the dictionaries can tell them apart.
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < kNumRowGroups; ++i) {
+    std::vector<std::string> strings;
+    std::vector<int64_t> numbers;
+    for (auto row = 0; row < rowsInRowGroup_; ++row) {
+      strings.push_back(fmt::format("{}{}", row % 2 ? "z" : "a", i));
+      numbers.push_back(row % 2 ? 1'000 + i : i);
+    }
+    batches.push_back(makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<std::string>(strings),
+         makeFlatVector<int64_t>(numbers)}));
+  }
+  writeToMemory(rowType_, batches, false);
+
+  auto read = [&](bool dictionaryFilterEnabled,
+                  const std::string& column,
+                  std::unique_ptr<Filter> filter,
+                  int64_t expectedRows) {
+    SCOPED_TRACE(fmt::format(
+        "{} {} {}", dictionaryFilterEnabled, column, filter->toString()));
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    // Dictionary filtering is off by default.
+    ASSERT_FALSE(readerOpts.dictionaryFilterEnabled());
+    if (dictionaryFilterEnabled) {
+      readerOpts.setDictionaryFilterEnabled(true);
+    }
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(sinkData_),
+        readerOpts.memoryPool());
+    auto reader = makeReader(readerOpts, std::move(input));
+    ASSERT_EQ(
+        static_cast<ParquetReader&>(*reader).fileMetaData().numRowGroups(),
+        kNumRowGroups);
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    auto* filterPtr = filter.get();
+    spec->childByName(column)->setFilter(std::move(filter));
+    RowReaderOptions rowReaderOpts;
+    setUpRowReaderOptions(rowReaderOpts, spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    int64_t numRows = 0;
+    auto result = BaseVector::create(rowType_, 0, leafPool_.get());
+    while (rowReader->next(1'000, result) > 0) {
+      auto* rowVector = result->as<RowVector>();
+      auto* c0 =
+          rowVector->childAt(0)->loadedVector()->as<SimpleVector<StringView>>();
+      auto* c1 =
+          rowVector->childAt(1)->loadedVector()->as<SimpleVector<int64_t>>();
+      for (auto i = 0; i < result->size(); ++i) {
+        if (column == "c0") {
+          EXPECT_TRUE(filterPtr->testBytes(
+              c0->valueAt(i).data(), c0->valueAt(i).size()));
+        } else {
+          EXPECT_TRUE(filterPtr->testInt64(c1->valueAt(i)));
+        }
+      }
+      numRows += result->size();
+    }
+    EXPECT_EQ(numRows, expectedRows);
+
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    EXPECT_EQ(stats.skippedStrides, 0);
+    EXPECT_EQ(
+        stats.skippedPageRows,
+        dictionaryFilterEnabled
+            ? static_cast<int64_t>(rowsInRowGroup_) * kNumRowGroups -
+                expectedRows
+            : 0);
+  };
+
+  for (auto enabled : {false, true}) {
+    read(
+        enabled,
+        "c0",
+        std::make_unique<BytesValues>(std::vector<std::string>{"m"}, false),
+        0);
+    read(
+        enabled,
+        "c0",
+        std::make_unique<BytesValues>(
+            std::vector<std::string>{"a1", "z1"}, false),
+        rowsInRowGroup_);
+    read(enabled, "c1", createBigintValues({2, 1'002}, false), rowsInRowGroup_);
+    read(enabled, "c1", std::make_unique<BigintRange>(500, 600, false), 0);
+  }
+}
+
+TEST_F(E2EFilterTest, decompressRowGroupsAhead) {
+  if (!facebook::velox::parquet::Writer::isCodecAvailable(
+          common::CompressionKind_SNAPPY)) {
+    GTEST_SKIP() << "Snappy is not available";
+  }
+  options_.compressionKind = common::CompressionKind_SNAPPY;
+  options_.dataPageSize = 4 * 1024;
+  rowsInRowGroup_ = 1'000;
+  constexpr int32_t kNumRowGroups = 6;
+  rowType_ =
+      ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), ARRAY(INTEGER())});
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < kNumRowGroups; ++i) {
+    const auto start = i * rowsInRowGroup_;
+    batches.push_back(makeRowVector(
+        {"c0", "c1", "c2"},
+        {makeFlatVector<int64_t>(
+             rowsInRowGroup_, [&](auto row) { return start + row; }),
+         makeFlatVector<std::string>(
+             rowsInRowGroup_,
+             [&](auto row) { return fmt::format("s{}", (start + row) % 97); },
+             [](auto row) { return row % 11 == 0; }),
+         makeArrayVector<int32_t>(
+             rowsInRowGroup_,
+             [](auto row) { return row % 5; },
+             [&](auto row, auto index) { return start + row + index; })}));
+  }
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+
+  for (auto dataPageV2 : {false, true}) {
+    options_.useParquetDataPageV2 = dataPageV2;
+    writeToMemory(rowType_, batches, false);
+    for (auto parallel : {false, true}) {
+      SCOPED_TRACE(fmt::format("V2: {} parallel: {}", dataPageV2, parallel));
+      dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+      readerOpts.setPrefetchRowGroups(3);
+      auto reader = makeReader(
+          readerOpts,
+          std::make_unique<BufferedInput>(
+              std::make_shared<InMemoryReadFile>(sinkData_),
+              readerOpts.memoryPool()));
+      ASSERT_EQ(
+          static_cast<ParquetReader&>(*reader).fileMetaData().numRowGroups(),
+          kNumRowGroups);
+      auto spec = std::make_shared<ScanSpec>("<root>");
+      spec->addAllChildFields(*rowType_);
+      RowReaderOptions rowReaderOpts;
+      setUpRowReaderOptions(rowReaderOpts, spec);
+      if (parallel) {
+        rowReaderOpts.setDecodingExecutor(executor);
+      }
+      auto rowReader = reader->createRowReader(rowReaderOpts);
+      auto result = BaseVector::create(rowType_, 0, leafPool_.get());
+      for (auto i = 0; i < kNumRowGroups; ++i) {
+        ASSERT_EQ(rowReader->next(rowsInRowGroup_, result), rowsInRowGroup_);
+        auto* rowVector = result->as<RowVector>();
+        std::vector<VectorPtr> children;
+        for (auto& child : rowVector->children()) {
+          children.push_back(BaseVector::loadedVectorShared(child));
+        }
+        test::assertEqualVectors(
+            batches[i], makeRowVector({"c0", "c1", "c2"}, children));
+      }
+      ASSERT_EQ(rowReader->next(rowsInRowGroup_, result), 0u);
+
+      // Destroying a reader with row groups still loading in the background
+      // must be safe.
+      rowReader = reader->createRowReader(rowReaderOpts);
+      ASSERT_EQ(rowReader->next(10, result), 10u);
+      rowReader.reset();
+    }
+  }
+}
+
 // Define main so that gflags get processed.
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <folly/ScopeGuard.h>
+
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
@@ -97,6 +100,42 @@ TEST_F(ParquetReaderTest, parseSample) {
       sampleSchema(), *rowReader, expected, *leafPool_);
 }
 
+TEST_F(ParquetReaderTest, fileMetadataCache) {
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  auto* cache = FileMetadataCache::create(1 << 20);
+  SCOPE_EXIT {
+    FileMetadataCache::testingClear();
+  };
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return row + 1; }),
+      makeFlatVector<double>(20, [](auto row) { return row + 1; }),
+  });
+  const auto read = [&](std::optional<int64_t> modificationTime) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setFileFormat(FileFormat::PARQUET)
+        .setFileModificationTime(modificationTime);
+    auto reader = createReader(sample, readerOptions);
+    EXPECT_EQ(reader->numberOfRows(), 20ULL);
+    auto rowReaderOpts = getReaderOpts(sampleSchema());
+    rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(
+        sampleSchema(), *rowReader, expected, *leafPool_);
+  };
+
+  // Without a file version the footer is not cached.
+  read(std::nullopt);
+  ASSERT_EQ(cache->stats().numElements, 0);
+
+  read(1);
+  ASSERT_EQ(cache->stats().numElements, 1);
+  ASSERT_EQ(cache->stats().numHits, 0);
+  read(1);
+  read(1);
+  ASSERT_EQ(cache->stats().numElements, 1);
+  ASSERT_EQ(cache->stats().numHits, 2);
+}
+
 TEST_F(ParquetReaderTest, parseUnannotatedList) {
   // unannotated_list.parquet has the following the schema
   // the list is defined without the middle layer
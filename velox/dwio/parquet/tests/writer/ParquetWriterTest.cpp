@@ -15,9 +15,11 @@
  */
 
 #include <arrow/type.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConnector.h" // @manual
 #include "velox/core/QueryCtx.h"
@@ -147,6 +149,152 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, arrowMemoryAccounting) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  const int64_t kRows = 30'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("value {}", row % 1'000); }),
+  });
+
+  auto writerPool = rootPool_->addAggregateChild("arrowMemoryAccounting");
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.compressionKind = CompressionKind::CompressionKind_SNAPPY;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, writerPool, schema);
+  // The Arrow schema is made from the first batch and reused for the others.
+  for (auto offset = 0; offset < kRows; offset += kRows / 3) {
+    writer->write(data->slice(offset, kRows / 3));
+  }
+  writer->flush();
+
+  // The encoding buffers and dictionaries of the Arrow writer are allocated
+  // from a child of the writer pool.
+  memory::MemoryPool* arrowPool = nullptr;
+  writerPool->visitChildren([&](memory::MemoryPool* child) {
+    if (child->name().find(".arrow") != std::string::npos) {
+      arrowPool = child;
+    }
+    return true;
+  });
+  ASSERT_NE(arrowPool, nullptr);
+  EXPECT_GT(arrowPool->peakBytes(), 0);
+  writer->close();
+  writer.reset();
+  EXPECT_EQ(writerPool->usedBytes(), 0);
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), kRows);
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+}
+
+TEST_F(ParquetWriterTest, parallelColumnEncoding) {
+  auto schema =
+      ROW({"c0", "c1", "c2", "c3"},
+          {BIGINT(), VARCHAR(), DOUBLE(), ARRAY(INTEGER())});
+  const int64_t kRows = 30'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row * 3; }),
+      makeFlatVector<std::string>(
+          kRows,
+          [](auto row) { return fmt::format("string {}", row % 777); },
+          nullEvery(7)),
+      makeFlatVector<double>(kRows, [](auto row) { return row / 7.0; }),
+      makeArrayVector<int32_t>(
+          kRows,
+          [](auto row) { return row % 4; },
+          [](auto row, auto index) { return row + index; }),
+  });
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+
+  auto write = [&](const std::shared_ptr<folly::Executor>& encodingExecutor) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    facebook::velox::parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = leafPool_.get();
+    writerOptions.compressionKind = CompressionKind::CompressionKind_SNAPPY;
+    writerOptions.encodingExecutor = encodingExecutor;
+    writerOptions.flushPolicyFactory = []() {
+      return std::make_unique<DefaultFlushPolicy>(10'000, 128 * 1024 * 1024);
+    };
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        std::move(sink), writerOptions, rootPool_, schema);
+    for (auto offset = 0; offset < kRows; offset += 10'000) {
+      writer->write(data->slice(offset, 10'000));
+    }
+    writer->close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto serial = write(nullptr);
+  const auto parallel = write(executor);
+  for (const auto& file : {serial, parallel}) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = std::make_unique<facebook::velox::parquet::ParquetReader>(
+        std::make_unique<dwio::common::BufferedInput>(
+            std::make_shared<InMemoryReadFile>(file),
+            readerOptions.memoryPool()),
+        readerOptions);
+    ASSERT_EQ(reader->numberOfRows(), kRows);
+    ASSERT_EQ(reader->fileMetaData().numRowGroups(), 3);
+    auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+    assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+  }
+}
+
+DEBUG_ONLY_TEST_F(ParquetWriterTest, parallelColumnEncodingError) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  const int64_t kRows = 20'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("value {}", row % 1'000); }),
+  });
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+
+  // Fails the allocations of the column writers running on the executor.
+  const auto testThreadId = std::this_thread::get_id();
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::parquet::ArrowMemoryPool::Allocate",
+      std::function<void(memory::MemoryPool*)>([&](memory::MemoryPool*) {
+        if (std::this_thread::get_id() != testThreadId) {
+          VELOX_MEM_POOL_CAP_EXCEEDED("Injected encoding allocation failure");
+        }
+      }));
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.encodingExecutor = executor;
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<DefaultFlushPolicy>(10'000, 128 * 1024 * 1024);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  const auto writeAndClose = [&]() {
+    for (auto offset = 0; offset < kRows; offset += 10'000) {
+      writer->write(data->slice(offset, 10'000));
+    }
+    writer->close();
+  };
+  // The error of the column writers is rethrown on the writing thread instead
+  // of leaving the writer waiting for the encoding tasks.
+  VELOX_ASSERT_THROW(writeAndClose(), "Injected encoding allocation failure");
+  writer->abort();
+}
+
 TEST_F(ParquetWriterTest, toggleDataPageVersion) {
   auto schema = ROW({"c0"}, {INTEGER()});
   const int64_t kRows = 1;
@@ -17,7 +17,10 @@
 #include "velox/dwio/parquet/writer/Writer.h"
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
+#include <arrow/memory_pool.h>
 #include <arrow/table.h>
+#include <arrow/util/thread_pool.h>
+#include <folly/executors/ThreadPoolExecutor.h>
 #include "velox/common/base/Pointers.h"
 #include "velox/common/config/Config.h"
 #include "velox/common/testutil/TestValue.h"
@@ -97,7 +100,139 @@ class ArrowDataBufferSink : public ::arrow::io::OutputStream {
   int64_t bytesFlushed_ = 0;
 };
 
+// Arrow memory pool allocating from a Velox memory pool. Accounts the memory
+// of the Arrow Parquet writer, e.g. page buffers, dictionaries and compression
+// scratch, to the memory pool of the Velox writer. Allocation failures, e.g.
+// exceeding the memory capacity, are thrown as Velox exceptions.
+class ArrowMemoryPool : public ::arrow::MemoryPool {
+ public:
+  explicit ArrowMemoryPool(memory::MemoryPool& pool) : pool_(pool) {}
+
+  using ::arrow::MemoryPool::Allocate;
+  using ::arrow::MemoryPool::Free;
+  using ::arrow::MemoryPool::Reallocate;
+
+  ::arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t** out)
+      override {
+    if (size == 0) {
+      *out = zeroSizeArea();
+      return ::arrow::Status::OK();
+    }
+    common::testutil::TestValue::adjust(
+        "facebook::velox::parquet::ArrowMemoryPool::Allocate", &pool_);
+    *out = reinterpret_cast<uint8_t*>(pool_.allocate(size, alignment));
+    bytesAllocated_ += size;
+    totalBytesAllocated_ += size;
+    ++numAllocations_;
+    return ::arrow::Status::OK();
+  }
+
+  ::arrow::Status Reallocate(
+      int64_t oldSize,
+      int64_t newSize,
+      int64_t alignment,
+      uint8_t** ptr) override {
+    if (oldSize == 0 || newSize == 0) {
+      uint8_t* newPtr;
+      ARROW_RETURN_NOT_OK(Allocate(newSize, alignment, &newPtr));
+      Free(*ptr, oldSize, alignment);
+      *ptr = newPtr;
+      return ::arrow::Status::OK();
+    }
+    VELOX_CHECK_EQ(pool_.alignment() % alignment, 0);
+    *ptr = reinterpret_cast<uint8_t*>(pool_.reallocate(*ptr, oldSize, newSize));
+    bytesAllocated_ += newSize - oldSize;
+    totalBytesAllocated_ += std::max<int64_t>(newSize - oldSize, 0);
+    ++numAllocations_;
+    return ::arrow::Status::OK();
+  }
+
+  void Free(uint8_t* buffer, int64_t size, int64_t /*alignment*/) override {
+    if (size == 0) {
+      VELOX_CHECK_EQ(buffer, zeroSizeArea());
+      return;
+    }
+    pool_.free(buffer, size);
+    bytesAllocated_ -= size;
+  }
+
+  int64_t bytes_allocated() const override {
+    return bytesAllocated_;
+  }
+
+  int64_t max_memory() const override {
+    return pool_.peakBytes();
+  }
+
+  int64_t total_bytes_allocated() const override {
+    return totalBytesAllocated_;
+  }
+
+  int64_t num_allocations() const override {
+    return numAllocations_;
+  }
+
+  std::string backend_name() const override {
+    return "velox";
+  }
+
+ private:
+  // Shared non-null address of empty allocations, as in Arrow's own pools.
+  static uint8_t* zeroSizeArea() {
+    alignas(64) static uint8_t area[1];
+    return area;
+  }
+
+  memory::MemoryPool& pool_;
+  std::atomic<int64_t> bytesAllocated_{0};
+  std::atomic<int64_t> totalBytesAllocated_{0};
+  std::atomic<int64_t> numAllocations_{0};
+};
+
+// Arrow executor running the tasks of the Arrow Parquet writer on a folly
+// executor. The tasks must not throw: an exception would leave the future of
+// the task unfinished. The writer catches the exceptions of its column writes
+// and rethrows them on the calling thread.
+class ArrowExecutor : public ::arrow::internal::Executor {
+ public:
+  explicit ArrowExecutor(std::shared_ptr<folly::Executor> executor)
+      : executor_(std::move(executor)) {}
+
+  int GetCapacity() override {
+    if (auto* pool =
+            dynamic_cast<folly::ThreadPoolExecutor*>(executor_.get())) {
+      return static_cast<int>(pool->numThreads());
+    }
+    return 1;
+  }
+
+ protected:
+  ::arrow::Status SpawnReal(
+      ::arrow::internal::TaskHints /*hints*/,
+      ::arrow::internal::FnOnce<void()> task,
+      ::arrow::StopToken stopToken,
+      StopCallback&& stopCallback) override {
+    executor_->add([task = std::move(task),
+                    stopToken = std::move(stopToken),
+                    stopCallback = std::move(stopCallback)]() mutable {
+      if (!stopToken.IsStopRequested()) {
+        std::move(task)();
+      } else if (stopCallback) {
+        std::move(stopCallback)(stopToken.Poll());
+      }
+    });
+    return ::arrow::Status::OK();
+  }
+
+ private:
+  const std::shared_ptr<folly::Executor> executor_;
+};
+
 struct ArrowContext {
+  // Must outlive the other members which may hold memory from it.
+  std::unique_ptr<ArrowMemoryPool> pool;
+  // Set if the columns of a row group are written in parallel.
+  std::unique_ptr<ArrowExecutor> executor;
   std::unique_ptr<FileWriter> writer;
   std::shared_ptr<::arrow::Schema> schema;
   std::shared_ptr<WriterProperties> properties;
@@ -128,12 +263,17 @@ namespace {
 
 std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
     const parquet::WriterOptions& options,
-    const std::unique_ptr<DefaultFlushPolicy>& flushPolicy) {
+    const std::unique_ptr<DefaultFlushPolicy>& flushPolicy,
+    const RowTypePtr& schema,
+    ::arrow::MemoryPool* pool) {
   auto builder = WriterProperties::Builder();
-  WriterProperties::Builder* properties = &builder;
+  WriterProperties::Builder* properties = builder.memory_pool(pool);
   if (!options.enableDictionary) {
     properties = properties->disable_dictionary();
   }
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties = properties->compression(getArrowParquetCompression(
       options.compressionKind.value_or(common::CompressionKind_NONE)));
   for (const auto& columnCompressionValues : options.columnCompressionsMap) {
@@ -142,6 +282,17 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
         getArrowParquetCompression(columnCompressionValues.second));
   }
   properties = properties->encoding(options.encoding);
+  if (options.enableByteStreamSplit) {
+    for (uint32_t i = 0; i < schema->size(); ++i) {
+      const auto& type = schema->childAt(i);
+      if (type->isReal() || type->isDouble()) {
+        const auto& name = schema->nameOf(i);
+        properties = properties->disable_dictionary(name);
+        properties =
+            properties->encoding(name, arrow::Encoding::BYTE_STREAM_SPLIT);
+      }
+    }
+  }
   properties = properties->data_pagesize(options.dataPageSize);
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
@@ -269,6 +420,7 @@ Writer::Writer(
     RowTypePtr schema)
     : pool_(std::move(pool)),
       generalPool_{pool_->addLeafChild(".general")},
+      arrowPool_{pool_->addLeafChild(".arrow")},
       stream_(std::make_shared<ArrowDataBufferSink>(
           std::move(sink),
           *generalPool_,
@@ -288,8 +440,13 @@ Writer::Writer(
   options_.timestampTimeZone = options.parquetWriteTimestampTimeZone;
   common::testutil::TestValue::adjust(
       "facebook::velox::parquet::Writer::Writer", &options_);
-  arrowContext_->properties =
-      getArrowParquetWriterOptions(options, flushPolicy_);
+  arrowContext_->pool = std::make_unique<ArrowMemoryPool>(*arrowPool_);
+  if (options.encodingExecutor) {
+    arrowContext_->executor =
+        std::make_unique<ArrowExecutor>(options.encodingExecutor);
+  }
+  arrowContext_->properties = getArrowParquetWriterOptions(
+      options, flushPolicy_, schema_, arrowContext_->pool.get());
   setMemoryReclaimers();
   writeInt96AsTimestamp_ = options.writeInt96AsTimestamp;
 }
@@ -313,12 +470,16 @@ void Writer::flush() {
       if (writeInt96AsTimestamp_) {
         builder.enable_deprecated_int96_timestamps();
       }
+      if (arrowContext_->executor) {
+        builder.set_use_threads(true);
+        builder.set_executor(arrowContext_->executor.get());
+      }
       auto arrowProperties = builder.build();
       PARQUET_ASSIGN_OR_THROW(
           arrowContext_->writer,
           FileWriter::Open(
               *arrowContext_->schema.get(),
-              ::arrow::default_memory_pool(),
+              arrowContext_->pool.get(),
               stream_,
               arrowContext_->properties,
               arrowProperties));
@@ -370,27 +531,26 @@ void Writer::write(const VectorPtr& data) {
       "The file schema type should be equal with the input rowvector type.");
 
   ArrowArray array;
-  ArrowSchema schema;
   exportToArrow(data, array, generalPool_.get(), options_);
-  exportToArrow(data, schema, options_);
 
-  // Convert the arrow schema to Schema and then update the column names based
-  // on schema_.
-  auto arrowSchema = ::arrow::ImportSchema(&schema).ValueOrDie();
-  common::testutil::TestValue::adjust(
-      "facebook::velox::parquet::Writer::write", arrowSchema.get());
-  std::vector<std::shared_ptr<::arrow::Field>> newFields;
-  auto childSize = schema_->size();
-  for (auto i = 0; i < childSize; i++) {
-    newFields.push_back(updateFieldNameRecursive(
-        arrowSchema->fields()[i], *schema_->childAt(i), schema_->nameOf(i)));
-  }
-
-  PARQUET_ASSIGN_OR_THROW(
-      auto recordBatch,
-      ::arrow::ImportRecordBatch(&array, ::arrow::schema(newFields)));
+  // All batches have the type of 'schema_' and are flattened on export, so
+  // the Arrow schema is made once, from the first batch.
   if (!arrowContext_->schema) {
-    arrowContext_->schema = recordBatch->schema();
+    ArrowSchema schema;
+    exportToArrow(data, schema, options_);
+
+    // Convert the arrow schema to Schema and then update the column names
+    // based on schema_.
+    auto arrowSchema = ::arrow::ImportSchema(&schema).ValueOrDie();
+    common::testutil::TestValue::adjust(
+        "facebook::velox::parquet::Writer::write", arrowSchema.get());
+    std::vector<std::shared_ptr<::arrow::Field>> newFields;
+    auto childSize = schema_->size();
+    for (auto i = 0; i < childSize; i++) {
+      newFields.push_back(updateFieldNameRecursive(
+          arrowSchema->fields()[i], *schema_->childAt(i), schema_->nameOf(i)));
+    }
+    arrowContext_->schema = ::arrow::schema(newFields);
     for (int colIdx = 0; colIdx < arrowContext_->schema->num_fields();
          colIdx++) {
       arrowContext_->stagingChunks.push_back(
@@ -398,6 +558,10 @@ void Writer::write(const VectorPtr& data) {
     }
   }
 
+  PARQUET_ASSIGN_OR_THROW(
+      auto recordBatch,
+      ::arrow::ImportRecordBatch(&array, arrowContext_->schema));
+
   auto bytes = data->estimateFlatSize();
   auto numRows = data->size();
   if (flushPolicy_->shouldFlush(getStripeProgress(
@@ -454,6 +618,7 @@ void Writer::setMemoryReclaimers() {
   // TODO https://github.com/facebookincubator/velox/issues/8190
   pool_->setReclaimer(exec::MemoryReclaimer::create());
   generalPool_->setReclaimer(exec::MemoryReclaimer::create());
+  arrowPool_->setReclaimer(exec::MemoryReclaimer::create());
 }
 
 std::unique_ptr<dwio::common::Writer> ParquetWriterFactory::createWriter(
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/common/compression/Compression.h"
 #include "velox/common/config/Config.h"
 #include "velox/dwio/common/DataBuffer.h"
@@ -89,6 +91,9 @@ class LambdaFlushPolicy : public DefaultFlushPolicy {
 
 struct WriterOptions : public dwio::common::WriterOptions {
   bool enableDictionary = true;
+  /// Writes the ColumnIndex and OffsetIndex of each column chunk so that
+  /// readers can skip pages based on their statistics.
+  bool enablePageIndex = false;
   int64_t dataPageSize = 1'024 * 1'024;
   int64_t dictionaryPageSizeLimit = 1'024 * 1'024;
   // Growth ratio passed to ArrowDataBufferSink. The default value is a
@@ -97,11 +102,21 @@ struct WriterOptions : public dwio::common::WriterOptions {
   double bufferGrowRatio = 1.5;
 
   arrow::Encoding::type encoding = arrow::Encoding::PLAIN;
+  /// Writes top level REAL and DOUBLE columns with BYTE_STREAM_SPLIT encoding
+  /// and without a dictionary. The split byte streams of floating point values
+  /// compress better than their PLAIN encoding.
+  bool enableByteStreamSplit = false;
 
   std::shared_ptr<CodecOptions> codecOptions;
   std::unordered_map<std::string, common::CompressionKind>
       columnCompressionsMap;
 
+  /// If set, the column chunks of each row group are encoded and compressed in
+  /// parallel on this executor. The encoded chunks of one row group are kept
+  /// in memory until all of them are done and are then written to the sink in
+  /// column order.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+
   /// Timestamp unit for Parquet write through Arrow bridge.
   /// Default if not specified: TimestampPrecision::kNanoseconds (9).
   std::optional<TimestampPrecision> parquetWriteTimestampUnit;
@@ -178,6 +193,8 @@ class Writer : public dwio::common::Writer {
   // Pool for 'stream_'.
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> generalPool_;
+  // Pool for the memory allocated by the Arrow Parquet writer.
+  std::shared_ptr<memory::MemoryPool> arrowPool_;
 
   // Temporary Arrow stream for capturing the output.
   std::shared_ptr<ArrowDataBufferSink> stream_;
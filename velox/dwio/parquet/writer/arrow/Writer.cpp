@@ -20,7 +20,9 @@
 
 #include <algorithm>
 #include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -410,6 +412,9 @@ class FileWriterImpl : public FileWriter {
     }
 
     auto WriteRowGroup = [&](int64_t offset, int64_t size) {
+      if (arrow_properties_->use_threads()) {
+        return WriteBufferedRowGroup(table, offset, size);
+      }
       RETURN_NOT_OK(NewRowGroup(size));
       for (int i = 0; i < table.num_columns(); i++) {
         RETURN_NOT_OK(WriteColumnChunk(table.column(i), offset, size));
@@ -433,6 +438,58 @@ class FileWriterImpl : public FileWriter {
     return Status::OK();
   }
 
+  // Writes rows [offset, offset + size) of 'table' as one row group. The
+  // columns are encoded and compressed in parallel into a buffered row group,
+  // which writes its column chunks to the sink in column order on close.
+  Status
+  WriteBufferedRowGroup(const Table& table, int64_t offset, int64_t size) {
+    RETURN_NOT_OK(NewBufferedRowGroup());
+    std::vector<std::unique_ptr<ArrowColumnWriterV2>> writers;
+    int column_index_start = 0;
+    for (int i = 0; i < table.num_columns(); i++) {
+      ARROW_ASSIGN_OR_RAISE(
+          std::unique_ptr<ArrowColumnWriterV2> writer,
+          ArrowColumnWriterV2::Make(
+              *table.column(i),
+              offset,
+              size,
+              schema_manifest_,
+              row_group_writer_,
+              column_index_start));
+      column_index_start += writer->leaf_count();
+      writers.emplace_back(std::move(writer));
+    }
+    DCHECK_EQ(parallel_column_write_contexts_.size(), writers.size());
+    // An exception escaping a task would leave its future unfinished and
+    // ParallelFor waiting forever. The first exception, e.g. a memory
+    // allocation failure from the Velox memory pool, is kept and rethrown
+    // here after all tasks are done.
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    const auto status = ::arrow::internal::ParallelFor(
+        static_cast<int>(writers.size()),
+        [&](int i) {
+          try {
+            return writers[i]->Write(&parallel_column_write_contexts_[i]);
+          } catch (...) {
+            std::lock_guard<std::mutex> l(error_mutex);
+            if (error == nullptr) {
+              error = std::current_exception();
+            }
+            return Status::UnknownError("Exception in column writer");
+          }
+        },
+        arrow_properties_->executor());
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+    RETURN_NOT_OK(status);
+    // Flushes the row group now, so that at most one is held in memory.
+    PARQUET_CATCH_NOT_OK(row_group_writer_->Close());
+    row_group_writer_ = nullptr;
+    return Status::OK();
+  }
+
   Status NewBufferedRowGroup() override {
     if (row_group_writer_ != nullptr) {
       PARQUET_CATCH_NOT_OK(row_group_writer_->Close());
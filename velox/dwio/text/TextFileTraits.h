@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace facebook::velox::text {
+
+/// The delimiters of the TextFile format shared by the text reader and
+/// writer.
+class TextFileTraits {
+ public:
+  //// The following constants define the delimiters used by TextFile format.
+  /// Each row is separated by 'kNewLine'.
+  /// Each column is separated by 'kSOH' within each row.
+
+  /// String for null data.
+  static inline const std::string kNullData = "\\N";
+
+  /// Delimiter between columns.
+  static const char kSOH = '\x01';
+
+  /// Delimiter between rows.
+  static const char kNewLine = '\n';
+};
+
+} // namespace facebook::velox::text
@@ -0,0 +1,734 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include <folly/Conv.h>
+#include <strings.h>
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/common/encode/Base64.h"
+#include "velox/dwio/text/TextFileTraits.h"
+#include "velox/type/TimestampConversion.h"
+#include "velox/type/tz/TimeZoneMap.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::text {
+namespace {
+
+// The number of bytes whose structural characters are found at a time.
+constexpr int32_t kBlockSize = 64;
+
+// The structural characters in a block of up to 'kBlockSize' bytes, one bit
+// per byte.
+struct BlockMasks {
+  uint64_t delimiters{0};
+  uint64_t newLines{0};
+  uint64_t escapes{0};
+};
+
+template <typename A>
+inline uint64_t toMask(xsimd::batch_bool<uint8_t, A> mask) {
+  return static_cast<uint32_t>(simd::toBitMask(mask));
+}
+
+template <typename A = xsimd::default_arch>
+BlockMasks findStructuralChars(
+    const char* data,
+    int32_t size,
+    char delimiter,
+    bool findEscapes,
+    char escape,
+    const A& = {}) {
+  BlockMasks masks;
+  if (size < kBlockSize) {
+    for (auto i = 0; i < size; ++i) {
+      const uint64_t bit = 1UL << i;
+      masks.delimiters |= data[i] == delimiter ? bit : 0;
+      masks.newLines |= data[i] == TextFileTraits::kNewLine ? bit : 0;
+      masks.escapes |= findEscapes && data[i] == escape ? bit : 0;
+    }
+    return masks;
+  }
+  using Batch = xsimd::batch<uint8_t, A>;
+  constexpr int32_t kWidth = Batch::size;
+  static_assert(kBlockSize % kWidth == 0);
+  const auto delimiters = Batch::broadcast(delimiter);
+  const auto newLines = Batch::broadcast(TextFileTraits::kNewLine);
+  const auto escapes = Batch::broadcast(escape);
+  const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+  for (auto i = 0; i < kBlockSize; i += kWidth) {
+    const auto batch = Batch::load_unaligned(bytes + i);
+    masks.delimiters |= toMask(batch == delimiters) << i;
+    masks.newLines |= toMask(batch == newLines) << i;
+    if (findEscapes) {
+      masks.escapes |= toMask(batch == escapes) << i;
+    }
+  }
+  return masks;
+}
+
+// Returns the bits of the bytes escaped by the 'escapes' of a block. An escape
+// character that is escaped itself escapes nothing. 'carry' is true if the
+// first byte of the block is escaped and is set to whether the first byte of
+// the next block is.
+uint64_t escapedChars(uint64_t escapes, bool& carry) {
+  uint64_t escaped = carry ? 1 : 0;
+  carry = false;
+  while (escapes != 0) {
+    const uint64_t bit = escapes & -escapes;
+    escapes ^= bit;
+    if (escaped & bit) {
+      continue;
+    }
+    if (bit == 1UL << (kBlockSize - 1)) {
+      carry = true;
+    } else {
+      escaped |= bit << 1;
+    }
+  }
+  return escaped;
+}
+
+// Parses a decimal integer without leading or trailing spaces.
+template <typename T>
+bool parseInteger(const char* data, int32_t size, T& value) {
+  if (size == 0) {
+    return false;
+  }
+  int32_t i = 0;
+  const bool negative = data[0] == '-';
+  if (negative || data[0] == '+') {
+    if (size == 1) {
+      return false;
+    }
+    i = 1;
+  }
+  // Accumulates the negated value so that the min value does not overflow.
+  int64_t result = 0;
+  for (; i < size; ++i) {
+    const uint8_t digit = data[i] - '0';
+    if (digit > 9 || __builtin_mul_overflow(result, 10, &result) ||
+        __builtin_sub_overflow(result, digit, &result)) {
+      return false;
+    }
+  }
+  if (!negative) {
+    if (result == std::numeric_limits<int64_t>::min()) {
+      return false;
+    }
+    result = -result;
+  }
+  if (result < std::numeric_limits<T>::min() ||
+      result > std::numeric_limits<T>::max()) {
+    return false;
+  }
+  value = result;
+  return true;
+}
+
+bool parseBoolean(const char* data, int32_t size, bool& value) {
+  if (size == 4 && strncasecmp(data, "true", 4) == 0) {
+    value = true;
+    return true;
+  }
+  if (size == 5 && strncasecmp(data, "false", 5) == 0) {
+    value = false;
+    return true;
+  }
+  return false;
+}
+
+template <typename T>
+bool parseFloatingPoint(const char* data, int32_t size, T& value) {
+  const auto result = folly::tryTo<T>(folly::StringPiece(data, size));
+  if (result.hasError()) {
+    return false;
+  }
+  value = result.value();
+  return true;
+}
+
+bool parseDate(const char* data, int32_t size, int32_t& value) {
+  const auto result =
+      util::fromDateString(data, size, util::ParseMode::kPrestoCast);
+  if (result.hasError()) {
+    return false;
+  }
+  value = result.value();
+  return true;
+}
+
+bool parseTimestamp(
+    const char* data,
+    int32_t size,
+    const tz::TimeZone* zone,
+    Timestamp& value) {
+  const auto result = util::fromTimestampString(
+      data, size, util::TimestampParseMode::kPrestoCast);
+  if (result.hasError()) {
+    return false;
+  }
+  value = result.value();
+  if (zone != nullptr) {
+    value.toGMT(*zone);
+  }
+  return true;
+}
+
+void checkSupportedType(const std::string& name, const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      if (type->isDate() || *type == *createScalarType(type->kind())) {
+        return;
+      }
+      break;
+    default:
+      break;
+  }
+  VELOX_NYI(
+      "Column {} of type {} is not supported yet in TextReader",
+      name,
+      type->toString());
+}
+
+RowTypePtr checkFileSchema(const RowTypePtr& fileSchema) {
+  VELOX_USER_CHECK_NOT_NULL(
+      fileSchema, "TextReader requires the file schema in the ReaderOptions");
+  return fileSchema;
+}
+
+} // namespace
+
+TextReader::TextReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& options)
+    : input_(std::move(input)),
+      options_(options),
+      rowType_(checkFileSchema(options.fileSchema())),
+      typeWithId_(dwio::common::TypeWithId::create(rowType_)) {}
+
+std::unique_ptr<dwio::common::RowReader> TextReader::createRowReader(
+    const dwio::common::RowReaderOptions& options) const {
+  return std::make_unique<TextRowReader>(input_, options_, rowType_, options);
+}
+
+TextRowReader::TextRowReader(
+    std::shared_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& readerOptions,
+    const RowTypePtr& fileType,
+    const dwio::common::RowReaderOptions& options)
+    : input_(std::move(input)),
+      pool_(readerOptions.memoryPool()),
+      fileType_(fileType),
+      serDeOptions_(readerOptions.serDeOptions()),
+      scanSpec_(options.scanSpec()),
+      timestampZone_(
+          readerOptions.adjustTimestampToTimezone()
+              ? readerOptions.sessionTimezone()
+              : nullptr),
+      fileSize_(input_->getInputStream()->getLength()),
+      rangeStart_(std::min(options.offset(), fileSize_)),
+      rangeEnd_(std::min(options.limit(), fileSize_)),
+      skipRows_(options.skipRows()),
+      loadQuantum_(std::max(readerOptions.loadQuantum(), 1)) {
+  VELOX_CHECK_NOT_NULL(scanSpec_, "TextReader requires a ScanSpec");
+  VELOX_CHECK(
+      !options.rowNumberColumnInfo().has_value(),
+      "TextReader does not support the row number column");
+
+  const auto& requestedType = options.requestedType();
+  column_index_t numChannels = 0;
+  for (const auto& child : scanSpec_->children()) {
+    if (child->projectOut()) {
+      numChannels = std::max(numChannels, child->channel() + 1);
+    }
+  }
+  std::vector<std::string> names(numChannels);
+  std::vector<TypePtr> types(numChannels);
+  std::vector<Column> otherColumns;
+  for (const auto& child : scanSpec_->children()) {
+    VELOX_CHECK_NULL(child->deltaUpdate());
+    const auto& name = child->fieldName();
+    TypePtr type;
+    if (child->isConstant()) {
+      type = child->constantValue()->type();
+    } else if (child->projectOut() || child->filter() != nullptr) {
+      const auto index = fileType_->getChildIdxIfExists(name);
+      VELOX_CHECK(
+          index.has_value(),
+          "Column {} is not in the text file schema {}",
+          name,
+          fileType_->toString());
+      type = requestedType != nullptr && requestedType->containsChild(name)
+          ? requestedType->findChild(name)
+          : fileType_->childAt(*index);
+      checkSupportedType(name, type);
+      const Column column{child.get(), *index, type};
+      if (child->filter() != nullptr) {
+        columns_.push_back(column);
+      } else {
+        otherColumns.push_back(column);
+      }
+      numIndexedFields_ = std::max<column_index_t>(
+          numIndexedFields_, *index + 1);
+    }
+    if (child->projectOut()) {
+      names[child->channel()] = name;
+      types[child->channel()] = std::move(type);
+    }
+  }
+  columns_.insert(columns_.end(), otherColumns.begin(), otherColumns.end());
+  outputType_ = ROW(std::move(names), std::move(types));
+}
+
+void TextRowReader::seekToFirstRow() {
+  VELOX_CHECK(!initialized_);
+  initialized_ = true;
+  if (rangeStart_ >= rangeEnd_) {
+    atEnd_ = true;
+    return;
+  }
+  if (rangeStart_ == 0) {
+    for (uint64_t i = 0; i < skipRows_; ++i) {
+      if (!skipRow()) {
+        atEnd_ = true;
+        return;
+      }
+    }
+  } else {
+    // The row that contains the byte before the range is read by the previous
+    // range.
+    bufferOffset_ = rangeStart_ - 1;
+    loadOffset_ = bufferOffset_;
+    if (!skipRow()) {
+      atEnd_ = true;
+      return;
+    }
+  }
+  atEnd_ = bufferOffset_ + rowStart_ >= rangeEnd_;
+}
+
+bool TextRowReader::loadMore() {
+  if (loadOffset_ >= fileSize_) {
+    return false;
+  }
+  const auto numBytes =
+      std::min<uint64_t>(loadQuantum_, fileSize_ - loadOffset_);
+  const auto oldSize = buffer_.size();
+  VELOX_CHECK_LE(
+      oldSize + numBytes,
+      kMissingField,
+      "A batch of a text file must be less than 4GB");
+  buffer_.resize(oldSize + numBytes);
+  input_->getInputStream()->read(
+      buffer_.data() + oldSize,
+      numBytes,
+      loadOffset_,
+      dwio::common::LogType::FILE);
+  loadOffset_ += numBytes;
+  return true;
+}
+
+bool TextRowReader::skipRow() {
+  for (;;) {
+    if (rowStart_ < buffer_.size()) {
+      const auto* newLine = static_cast<const char*>(memchr(
+          buffer_.data() + rowStart_,
+          TextFileTraits::kNewLine,
+          buffer_.size() - rowStart_));
+      if (newLine != nullptr) {
+        rowStart_ = newLine - buffer_.data() + 1;
+        return true;
+      }
+    }
+    // All the bytes before the next load are skipped.
+    bufferOffset_ += buffer_.size();
+    buffer_.clear();
+    rowStart_ = 0;
+    if (!loadMore()) {
+      return false;
+    }
+  }
+}
+
+vector_size_t TextRowReader::indexRows(vector_size_t maxRows) {
+  if (!initialized_) {
+    seekToFirstRow();
+  }
+  if (numBatchRows_ >= 0 && batchMaxRows_ == maxRows) {
+    return numBatchRows_;
+  }
+  numBatchRows_ = 0;
+  batchMaxRows_ = maxRows;
+  batchEnd_ = rowStart_;
+  if (atEnd_ || maxRows == 0) {
+    return 0;
+  }
+
+  // Drops the bytes of the rows already read once they are the larger part of
+  // the buffer, so that each byte is moved a few times at most.
+  if (rowStart_ > 0 && rowStart_ >= buffer_.size() / 2) {
+    buffer_.erase(buffer_.begin(), buffer_.begin() + rowStart_);
+    bufferOffset_ += rowStart_;
+    rowStart_ = 0;
+  }
+
+  rowStarts_.resize(maxRows);
+  fieldEnds_.resize(static_cast<size_t>(maxRows) * numIndexedFields_);
+  // The fields that end at a delimiter. The rest of the row is the last field
+  // of the file if 'lastColumnTakesRest'.
+  const column_index_t numDelimitedFields =
+      serDeOptions_.lastColumnTakesRest
+      ? std::min<column_index_t>(numIndexedFields_, fileType_->size() - 1)
+      : numIndexedFields_;
+  const char delimiter = serDeOptions_.separators[0];
+  const bool findEscapes = serDeOptions_.isEscaped && numDelimitedFields > 0;
+
+  vector_size_t numRows = 0;
+  size_t rowBegin = rowStart_;
+  column_index_t field = 0;
+  auto finishRow = [&](size_t rowEnd) {
+    if (rowEnd > rowBegin && buffer_[rowEnd - 1] == '\r') {
+      --rowEnd;
+    }
+    auto* ends = fieldEnds_.data() + numRows * numIndexedFields_;
+    if (field < numIndexedFields_) {
+      ends[field++] = rowEnd;
+    }
+    for (; field < numIndexedFields_; ++field) {
+      ends[field] = kMissingField;
+    }
+    rowStarts_[numRows++] = rowBegin;
+    field = 0;
+  };
+
+  bool escapeCarry = false;
+  size_t blockStart = rowStart_;
+  for (;;) {
+    if (buffer_.size() - blockStart < kBlockSize && loadMore()) {
+      continue;
+    }
+    if (blockStart >= buffer_.size()) {
+      // The last row of the file may have no new line.
+      if (rowBegin < buffer_.size()) {
+        finishRow(buffer_.size());
+        rowBegin = buffer_.size();
+      }
+      break;
+    }
+    const int32_t blockSize =
+        std::min<size_t>(kBlockSize, buffer_.size() - blockStart);
+    const auto masks = findStructuralChars(
+        buffer_.data() + blockStart,
+        blockSize,
+        delimiter,
+        findEscapes,
+        serDeOptions_.escapeChar);
+    uint64_t structural = masks.newLines;
+    if (numDelimitedFields > 0) {
+      uint64_t delimiters = masks.delimiters;
+      if (masks.escapes != 0 || escapeCarry) {
+        delimiters &= ~escapedChars(masks.escapes, escapeCarry);
+      }
+      structural |= delimiters;
+    }
+    bool batchFull = false;
+    while (structural != 0) {
+      const size_t position = blockStart + __builtin_ctzll(structural);
+      structural &= structural - 1;
+      if (buffer_[position] == TextFileTraits::kNewLine) {
+        finishRow(position);
+        rowBegin = position + 1;
+        if (numRows == maxRows || bufferOffset_ + rowBegin >= rangeEnd_) {
+          batchFull = true;
+          break;
+        }
+      } else if (field < numDelimitedFields) {
+        fieldEnds_[numRows * numIndexedFields_ + field++] = position;
+      }
+    }
+    if (batchFull) {
+      break;
+    }
+    blockStart += blockSize;
+  }
+  numBatchRows_ = numRows;
+  batchEnd_ = rowBegin;
+  return numRows;
+}
+
+bool TextRowReader::fieldRange(
+    vector_size_t row,
+    column_index_t field,
+    const char*& data,
+    int32_t& size) const {
+  const auto* ends = fieldEnds_.data() + row * numIndexedFields_;
+  if (ends[field] == kMissingField) {
+    return false;
+  }
+  const uint32_t begin = field == 0 ? rowStarts_[row] : ends[field - 1] + 1;
+  data = buffer_.data() + begin;
+  size = ends[field] - begin;
+  return true;
+}
+
+bool TextRowReader::isNullString(const char* data, int32_t size) const {
+  const auto& nullString = serDeOptions_.nullString;
+  return size == static_cast<int32_t>(nullString.size()) &&
+      memcmp(data, nullString.data(), size) == 0;
+}
+
+template <TypeKind kKind>
+void TextRowReader::parseValues(
+    const Column& column,
+    const std::vector<vector_size_t>& rows,
+    bool compact,
+    BaseVector& result) {
+  using T = typename TypeTraits<kKind>::NativeType;
+  auto* values = result.asUnchecked<FlatVector<T>>();
+  const bool isDate = column.type->isDate();
+  const char escape = serDeOptions_.escapeChar;
+  const vector_size_t numRows = rows.size();
+  for (vector_size_t i = 0; i < numRows; ++i) {
+    const auto row = rows[i];
+    const auto index = compact ? i : row;
+    const char* data;
+    int32_t size;
+    if (!fieldRange(row, column.fileIndex, data, size) ||
+        isNullString(data, size)) {
+      values->setNull(index, true);
+      continue;
+    }
+    T value;
+    bool parsed;
+    if constexpr (kKind == TypeKind::VARCHAR) {
+      if (serDeOptions_.isEscaped && memchr(data, escape, size) != nullptr) {
+        scratch_.clear();
+        for (auto j = 0; j < size; ++j) {
+          if (data[j] == escape && j + 1 < size) {
+            ++j;
+          }
+          scratch_.push_back(data[j]);
+        }
+        data = scratch_.data();
+        size = scratch_.size();
+      }
+      value = StringView(data, size);
+      parsed = true;
+    } else if constexpr (kKind == TypeKind::VARBINARY) {
+      // The values are Base64 encoded like TextWriter writes them. A value
+      // that is not is read as is.
+      try {
+        scratch_.clear();
+        encoding::Base64::decode(std::make_pair(data, size), scratch_);
+        value = StringView(scratch_);
+      } catch (const std::exception&) {
+        value = StringView(data, size);
+      }
+      parsed = true;
+    } else if constexpr (kKind == TypeKind::BOOLEAN) {
+      parsed = parseBoolean(data, size, value);
+    } else if constexpr (kKind == TypeKind::INTEGER) {
+      parsed = isDate ? parseDate(data, size, value)
+                      : parseInteger(data, size, value);
+    } else if constexpr (std::is_integral_v<T>) {
+      parsed = parseInteger(data, size, value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+      parsed = parseFloatingPoint(data, size, value);
+    } else {
+      static_assert(std::is_same_v<T, Timestamp>);
+      parsed = parseTimestamp(data, size, timestampZone_, value);
+    }
+    if (parsed) {
+      values->set(index, value);
+    } else {
+      // Malformed values are null like in Hive.
+      values->setNull(index, true);
+    }
+  }
+}
+
+VectorPtr TextRowReader::parseColumn(
+    const Column& column,
+    const std::vector<vector_size_t>& rows,
+    bool compact,
+    vector_size_t size) {
+  auto result = BaseVector::create(column.type, size, &pool_);
+  if (!compact && static_cast<vector_size_t>(rows.size()) < size) {
+    bits::fillBits(result->mutableRawNulls(), 0, size, bits::kNull);
+  }
+  switch (column.type->kind()) {
+    case TypeKind::BOOLEAN:
+      parseValues<TypeKind::BOOLEAN>(column, rows, compact, *result);
+      break;
+    case TypeKind::TINYINT:
+      parseValues<TypeKind::TINYINT>(column, rows, compact, *result);
+      break;
+    case TypeKind::SMALLINT:
+      parseValues<TypeKind::SMALLINT>(column, rows, compact, *result);
+      break;
+    case TypeKind::INTEGER:
+      parseValues<TypeKind::INTEGER>(column, rows, compact, *result);
+      break;
+    case TypeKind::BIGINT:
+      parseValues<TypeKind::BIGINT>(column, rows, compact, *result);
+      break;
+    case TypeKind::REAL:
+      parseValues<TypeKind::REAL>(column, rows, compact, *result);
+      break;
+    case TypeKind::DOUBLE:
+      parseValues<TypeKind::DOUBLE>(column, rows, compact, *result);
+      break;
+    case TypeKind::VARCHAR:
+      parseValues<TypeKind::VARCHAR>(column, rows, compact, *result);
+      break;
+    case TypeKind::VARBINARY:
+      parseValues<TypeKind::VARBINARY>(column, rows, compact, *result);
+      break;
+    case TypeKind::TIMESTAMP:
+      parseValues<TypeKind::TIMESTAMP>(column, rows, compact, *result);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  return result;
+}
+
+uint64_t TextRowReader::next(
+    uint64_t size,
+    VectorPtr& result,
+    const dwio::common::Mutation* mutation) {
+  const auto numRows = indexRows(
+      std::min<uint64_t>(size, std::numeric_limits<vector_size_t>::max()));
+  if (numRows == 0) {
+    atEnd_ = true;
+    return 0;
+  }
+
+  std::vector<uint64_t> passed(bits::nwords(numRows), -1);
+  if (mutation != nullptr) {
+    if (mutation->deletedRows != nullptr) {
+      bits::andWithNegatedBits(
+          passed.data(), mutation->deletedRows, 0, numRows);
+    }
+    if (mutation->randomSkip != nullptr) {
+      bits::forEachSetBit(passed.data(), 0, numRows, [&](auto row) {
+        if (!mutation->randomSkip->testOne()) {
+          bits::clearBit(passed.data(), row);
+        }
+      });
+    }
+  }
+  std::vector<vector_size_t> rows;
+  auto setPassedRows = [&]() {
+    rows.clear();
+    bits::forEachSetBit(
+        passed.data(), 0, numRows, [&](auto row) { rows.push_back(row); });
+  };
+  setPassedRows();
+
+  // The filtered columns are parsed for the rows that passed the previous
+  // filters, the others only for the rows that passed all of them.
+  std::vector<VectorPtr> children(outputType_->size());
+  size_t columnIndex = 0;
+  for (; columnIndex < columns_.size() && !rows.empty(); ++columnIndex) {
+    const auto& column = columns_[columnIndex];
+    if (column.spec->filter() == nullptr) {
+      break;
+    }
+    auto values = parseColumn(column, rows, /*compact=*/false, numRows);
+    column.spec->applyFilter(*values, passed.data());
+    setPassedRows();
+    if (column.spec->projectOut()) {
+      children[column.spec->channel()] = std::move(values);
+    }
+  }
+
+  const vector_size_t numPassed = rows.size();
+  if (numPassed > 0) {
+    if (numPassed < numRows) {
+      auto indices = allocateIndices(numPassed, &pool_);
+      std::copy(
+          rows.begin(), rows.end(), indices->asMutable<vector_size_t>());
+      for (auto& child : children) {
+        if (child != nullptr) {
+          child = BaseVector::wrapInDictionary(
+              nullptr, indices, numPassed, std::move(child));
+        }
+      }
+    }
+    for (; columnIndex < columns_.size(); ++columnIndex) {
+      const auto& column = columns_[columnIndex];
+      if (column.spec->projectOut()) {
+        children[column.spec->channel()] =
+            parseColumn(column, rows, /*compact=*/true, numPassed);
+      }
+    }
+    for (const auto& child : scanSpec_->children()) {
+      if (child->isConstant() && child->projectOut()) {
+        children[child->channel()] = BaseVector::wrapInConstant(
+            numPassed, 0, child->constantValue());
+      }
+    }
+  }
+
+  numRowsRead_ += numRows;
+  numBytesRead_ += batchEnd_ - rowStart_;
+  rowStart_ = batchEnd_;
+  numBatchRows_ = -1;
+  atEnd_ = bufferOffset_ + rowStart_ >= rangeEnd_ ||
+      (rowStart_ == buffer_.size() && loadOffset_ >= fileSize_);
+
+  if (numPassed == 0) {
+    result = RowVector::createEmpty(outputType_, &pool_);
+  } else {
+    result = std::make_shared<RowVector>(
+        &pool_, outputType_, nullptr, numPassed, std::move(children));
+  }
+  return numRows;
+}
+
+int64_t TextRowReader::nextRowNumber() {
+  if (!initialized_) {
+    seekToFirstRow();
+  }
+  return atEnd_ ? kAtEnd : numRowsRead_;
+}
+
+int64_t TextRowReader::nextReadSize(uint64_t size) {
+  const auto numRows = indexRows(
+      std::min<uint64_t>(size, std::numeric_limits<vector_size_t>::max()));
+  return numRows == 0 ? kAtEnd : numRows;
+}
+
+std::optional<size_t> TextRowReader::estimatedRowSize() const {
+  if (numRowsRead_ == 0) {
+    return std::nullopt;
+  }
+  return numBytesRead_ / numRowsRead_;
+}
+
+} // namespace facebook::velox::text
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::text {
+
+/// Reads files in the Hive TextFile format, as written by LazySimpleSerDe and
+/// TextWriter. Rows are separated by new lines and the fields of a row by the
+/// field delimiter of the SerDeOptions. The file has no schema of its own, so
+/// its columns are the columns of the file schema in the ReaderOptions, in
+/// order.
+class TextReader : public dwio::common::Reader {
+ public:
+  TextReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options);
+
+  /// The rows are only known after reading the whole file.
+  std::optional<uint64_t> numberOfRows() const override {
+    return std::nullopt;
+  }
+
+  /// Text files have no statistics.
+  std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
+      uint32_t /*index*/) const override {
+    return nullptr;
+  }
+
+  const RowTypePtr& rowType() const override {
+    return rowType_;
+  }
+
+  const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
+      const override {
+    return typeWithId_;
+  }
+
+  std::unique_ptr<dwio::common::RowReader> createRowReader(
+      const dwio::common::RowReaderOptions& options = {}) const override;
+
+ private:
+  const std::shared_ptr<dwio::common::BufferedInput> input_;
+  const dwio::common::ReaderOptions options_;
+  const RowTypePtr rowType_;
+  const std::shared_ptr<const dwio::common::TypeWithId> typeWithId_;
+};
+
+/// Reads the rows of a TextReader that start in the byte range of the
+/// RowReaderOptions. A row that starts in the range is read to its end even
+/// if the end is past the range, so that the splits of a file at arbitrary
+/// offsets read each row exactly once.
+///
+/// Each batch is parsed in two passes. The first finds the row and field
+/// boundaries of the batch with SIMD compares of 64 bytes at a time,
+/// producing bitmaps of the delimiters, new lines and escape characters like
+/// simdcsv. The second parses the values of each column directly into flat
+/// vectors. The columns with filters are parsed first and the other columns
+/// are only parsed for the rows that pass the filters.
+class TextRowReader : public dwio::common::RowReader {
+ public:
+  TextRowReader(
+      std::shared_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& readerOptions,
+      const RowTypePtr& fileType,
+      const dwio::common::RowReaderOptions& options);
+
+  uint64_t next(
+      uint64_t size,
+      VectorPtr& result,
+      const dwio::common::Mutation* mutation = nullptr) override;
+
+  /// Returns the row number relative to the first row of the range. The rows
+  /// of the file before the range are not counted.
+  int64_t nextRowNumber() override;
+
+  int64_t nextReadSize(uint64_t size) override;
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& /*stats*/) const override {}
+
+  void resetFilterCaches() override {}
+
+  std::optional<size_t> estimatedRowSize() const override;
+
+ private:
+  // A column of the file that is read.
+  struct Column {
+    const common::ScanSpec* spec;
+    // The index of the column in the file.
+    column_index_t fileIndex;
+    TypePtr type;
+  };
+
+  // Marks a field that is missing from its row.
+  static constexpr uint32_t kMissingField = ~0U;
+
+  // Positions the reader at the first row that starts in the range.
+  void seekToFirstRow();
+
+  // Appends the next bytes of the file to 'buffer_'. Returns false at the end
+  // of the file.
+  bool loadMore();
+
+  // Skips to the start of the next row. Returns false if there is none.
+  bool skipRow();
+
+  // Finds the boundaries of up to 'maxRows' rows starting at 'rowStart_' and
+  // returns the number of rows found. Returns the same batch until next()
+  // consumes it.
+  vector_size_t indexRows(vector_size_t maxRows);
+
+  // Returns true and the bytes of field 'field' of 'row' of the batch, or
+  // false if the row has no such field.
+  bool fieldRange(
+      vector_size_t row,
+      column_index_t field,
+      const char*& data,
+      int32_t& size) const;
+
+  bool isNullString(const char* data, int32_t size) const;
+
+  // Parses the values of 'column' of the batch 'rows'. The value of rows[i]
+  // is at i if 'compact' or else at rows[i] of a vector of 'size' with the
+  // other rows null.
+  VectorPtr parseColumn(
+      const Column& column,
+      const std::vector<vector_size_t>& rows,
+      bool compact,
+      vector_size_t size);
+
+  template <TypeKind kKind>
+  void parseValues(
+      const Column& column,
+      const std::vector<vector_size_t>& rows,
+      bool compact,
+      BaseVector& result);
+
+  const std::shared_ptr<dwio::common::BufferedInput> input_;
+  memory::MemoryPool& pool_;
+  const RowTypePtr fileType_;
+  const dwio::common::SerDeOptions serDeOptions_;
+  const std::shared_ptr<common::ScanSpec> scanSpec_;
+  // The time zone of the timestamps in the file if they are adjusted to UTC.
+  const tz::TimeZone* const timestampZone_;
+  const uint64_t fileSize_;
+  const uint64_t rangeStart_;
+  // The rows starting at or after this offset are not in the range.
+  const uint64_t rangeEnd_;
+  const uint64_t skipRows_;
+  const uint64_t loadQuantum_;
+
+  // The projected columns in the order of their channels.
+  RowTypePtr outputType_;
+  // The columns to read. The columns with filters are first.
+  std::vector<Column> columns_;
+  // The number of leading fields in each row whose boundaries are needed.
+  column_index_t numIndexedFields_{0};
+
+  // The bytes of the file from 'bufferOffset_'.
+  std::vector<char> buffer_;
+  uint64_t bufferOffset_{0};
+  // The offset in the file of the next bytes to load.
+  uint64_t loadOffset_{0};
+  // The position in 'buffer_' of the next row to read.
+  size_t rowStart_{0};
+  bool initialized_{false};
+  bool atEnd_{false};
+
+  // The indexed batch. -1 if no batch is indexed.
+  vector_size_t numBatchRows_{-1};
+  vector_size_t batchMaxRows_{0};
+  // The position after the last row of the batch.
+  size_t batchEnd_{0};
+  // The start of each row of the batch in 'buffer_'.
+  std::vector<uint32_t> rowStarts_;
+  // The end of each of the first 'numIndexedFields_' fields of each row of
+  // the batch, or kMissingField.
+  std::vector<uint32_t> fieldEnds_;
+
+  uint64_t numRowsRead_{0};
+  uint64_t numBytesRead_{0};
+  // Scratch for unescaped strings.
+  std::string scratch_;
+};
+
+class TextReaderFactory : public dwio::common::ReaderFactory {
+ public:
+  TextReaderFactory() : ReaderFactory(dwio::common::FileFormat::TEXT) {}
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options) override {
+    return std::make_unique<TextReader>(std::move(input), options);
+  }
+};
+
+} // namespace facebook::velox::text
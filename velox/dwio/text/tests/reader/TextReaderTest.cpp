@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "velox/common/base/Fs.h"
+#include "velox/common/file/File.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/dwio/text/writer/TextWriter.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/type/Filter.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::text {
+namespace {
+
+class TextReaderTest : public testing::Test,
+                       public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    velox::filesystems::registerLocalFileSystem();
+    dwio::common::LocalFileSink::registerFactory();
+    rootPool_ = memory::memoryManager()->addRootPool("TextReaderTests");
+    leafPool_ = rootPool_->addLeafChild("TextReaderTests");
+    tempPath_ = exec::test::TempDirectoryPath::create();
+  }
+
+  std::string writeData(const RowVectorPtr& data, const std::string& name) {
+    const auto filePath = fmt::format("{}/{}", tempPath_->getPath(), name);
+    WriterOptions writerOptions;
+    writerOptions.memoryPool = rootPool_.get();
+    auto sink = std::make_unique<dwio::common::LocalFileSink>(
+        filePath, dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto writer = std::make_unique<TextWriter>(
+        asRowType(data->type()),
+        std::move(sink),
+        std::make_shared<text::WriterOptions>(writerOptions));
+    writer->write(data);
+    writer->close();
+    return filePath;
+  }
+
+  std::string writeText(const std::string& text, const std::string& name) {
+    const auto filePath = fmt::format("{}/{}", tempPath_->getPath(), name);
+    std::ofstream file(filePath, std::ios::binary);
+    file << text;
+    return filePath;
+  }
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      const std::string& filePath,
+      const RowTypePtr& fileSchema,
+      const dwio::common::SerDeOptions& serDeOptions = {},
+      int32_t loadQuantum = dwio::common::ReaderOptions::kDefaultLoadQuantum) {
+    dwio::common::ReaderOptions readerOptions(pool());
+    readerOptions.setFileFormat(dwio::common::FileFormat::TEXT);
+    readerOptions.setFileSchema(fileSchema);
+    readerOptions.setSerDeOptions(serDeOptions);
+    readerOptions.setLoadQuantum(loadQuantum);
+    auto input = std::make_unique<dwio::common::BufferedInput>(
+        std::make_shared<LocalReadFile>(filePath), *pool());
+    return TextReaderFactory().createReader(std::move(input), readerOptions);
+  }
+
+  // Reads the rows of 'reader' in [offset, offset + length) in batches of
+  // 'batchSize' rows.
+  std::vector<RowVectorPtr> read(
+      const dwio::common::Reader& reader,
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      uint64_t batchSize,
+      uint64_t offset = 0,
+      uint64_t length = std::numeric_limits<uint64_t>::max(),
+      uint64_t skipRows = 0) {
+    dwio::common::RowReaderOptions rowReaderOptions;
+    rowReaderOptions.setScanSpec(scanSpec);
+    rowReaderOptions.range(offset, length);
+    rowReaderOptions.setSkipRows(skipRows);
+    auto rowReader = reader.createRowReader(rowReaderOptions);
+    std::vector<RowVectorPtr> batches;
+    VectorPtr batch;
+    while (rowReader->next(batchSize, batch) > 0) {
+      if (batch->size() > 0) {
+        batches.push_back(std::dynamic_pointer_cast<RowVector>(
+            BaseVector::copy(*batch)));
+      }
+    }
+    return batches;
+  }
+
+  RowVectorPtr readAll(
+      const dwio::common::Reader& reader,
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      uint64_t batchSize = 1'000,
+      uint64_t skipRows = 0) {
+    auto batches = read(
+        reader,
+        scanSpec,
+        batchSize,
+        0,
+        std::numeric_limits<uint64_t>::max(),
+        skipRows);
+    return concat(batches);
+  }
+
+  static std::shared_ptr<common::ScanSpec> makeScanSpec(
+      const RowTypePtr& type) {
+    auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+    scanSpec->addAllChildFields(*type);
+    return scanSpec;
+  }
+
+  RowVectorPtr concat(const std::vector<RowVectorPtr>& batches) {
+    VELOX_CHECK(!batches.empty());
+    auto result = std::dynamic_pointer_cast<RowVector>(
+        BaseVector::create(batches[0]->type(), 0, pool()));
+    for (const auto& batch : batches) {
+      result->append(batch.get());
+    }
+    return result;
+  }
+
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<memory::MemoryPool> leafPool_;
+  std::shared_ptr<exec::test::TempDirectoryPath> tempPath_;
+};
+
+TEST_F(TextReaderTest, roundTrip) {
+  constexpr int32_t kSize = 10'000;
+  auto data = makeRowVector(
+      {"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7"},
+      {
+          makeFlatVector<bool>(kSize, [](auto row) { return row % 3 == 0; }),
+          makeFlatVector<int8_t>(kSize, [](auto row) { return row % 101; }),
+          makeFlatVector<int16_t>(kSize, [](auto row) { return -row; }),
+          makeFlatVector<int32_t>(
+              kSize, [](auto row) { return row * 1'000; }, nullEvery(7)),
+          makeFlatVector<int64_t>(
+              kSize, [](auto row) { return (row - kSize / 2) * 1'000'003L; }),
+          makeFlatVector<double>(kSize, [](auto row) { return row * 0.5; }),
+          makeFlatVector<Timestamp>(
+              kSize,
+              [](auto row) { return Timestamp(row * 3'600, 1'000'000); }),
+          makeFlatVector<std::string>(
+              kSize,
+              [](auto row) { return std::string(row % 40, 'a' + row % 26); },
+              nullEvery(11)),
+      });
+  const auto filePath = writeData(data, "roundTrip.txt");
+  const auto fileType = asRowType(data->type());
+  // A small load quantum makes the rows cross the loaded ranges.
+  auto reader = createReader(filePath, fileType, {}, 1'000);
+  for (auto batchSize : {1, 7, 1'000, 100'000}) {
+    SCOPED_TRACE(fmt::format("batchSize {}", batchSize));
+    auto result = readAll(*reader, makeScanSpec(fileType), batchSize);
+    test::assertEqualVectors(data, result);
+  }
+}
+
+TEST_F(TextReaderTest, splits) {
+  constexpr int32_t kSize = 5'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kSize, [](auto row) { return std::string(row % 100, 'x'); }),
+  });
+  const auto filePath = writeData(data, "splits.txt");
+  const auto fileType = asRowType(data->type());
+  auto reader = createReader(filePath, fileType, {}, 4'096);
+  const auto fileSize = fs::file_size(filePath);
+  for (uint64_t splitSize : {13UL, 50UL, 1'000UL, 77'777UL}) {
+    SCOPED_TRACE(fmt::format("splitSize {}", splitSize));
+    std::vector<RowVectorPtr> batches;
+    for (uint64_t offset = 0; offset < fileSize; offset += splitSize) {
+      auto splitBatches =
+          read(*reader, makeScanSpec(fileType), 333, offset, splitSize);
+      batches.insert(batches.end(), splitBatches.begin(), splitBatches.end());
+    }
+    test::assertEqualVectors(data, concat(batches));
+  }
+}
+
+TEST_F(TextReaderTest, filter) {
+  constexpr int32_t kSize = 3'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(kSize, [](auto row) { return row % 10; }),
+      makeFlatVector<std::string>(
+          kSize, [](auto row) { return fmt::format("s{}", row); }),
+  });
+  const auto filePath = writeData(data, "filter.txt");
+  const auto fileType = asRowType(data->type());
+  auto reader = createReader(filePath, fileType);
+
+  auto scanSpec = makeScanSpec(fileType);
+  scanSpec->childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(100, 1'999, false));
+  scanSpec->childByName("c1")->setFilter(
+      std::make_unique<common::BigintRange>(3, 3, false));
+  auto result = readAll(*reader, scanSpec, 256);
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(190, [](auto row) { return 103 + row * 10; }),
+      makeFlatVector<int32_t>(190, [](auto /*row*/) { return 3; }),
+      makeFlatVector<std::string>(
+          190, [](auto row) { return fmt::format("s{}", 103 + row * 10); }),
+  });
+  test::assertEqualVectors(expected, result);
+
+  // A filter on a column that is not projected out.
+  scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addField("c2", 0);
+  auto* c1 = scanSpec->getOrCreateChild(common::Subfield("c1"));
+  c1->setProjectOut(false);
+  c1->setFilter(std::make_unique<common::BigintRange>(7, 7, false));
+  result = readAll(*reader, scanSpec, 1'000);
+  expected = makeRowVector({makeFlatVector<std::string>(
+      300, [](auto row) { return fmt::format("s{}", 7 + row * 10); })});
+  test::assertEqualVectors(expected, result);
+
+  // No rows pass.
+  scanSpec = makeScanSpec(fileType);
+  scanSpec->childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(kSize, kSize * 2, false));
+  EXPECT_TRUE(read(*reader, scanSpec, 1'000).empty());
+}
+
+TEST_F(TextReaderTest, format) {
+  // Escaped delimiters, a missing field, extra fields, the null string,
+  // malformed numbers, CR LF line ends and no new line at the end of the
+  // file.
+  const std::string text =
+      "1,a\\,b,true\r\n"
+      "2\n"
+      "3,\\N,false,extra\n"
+      "x,c\\\\d,maybe\n"
+      "5,,TRUE";
+  const auto filePath = writeText(text, "format.txt");
+  const auto fileType =
+      ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), BOOLEAN()});
+  dwio::common::SerDeOptions serDeOptions(',', '\2', '\3', '\\', true);
+  auto reader = createReader(filePath, fileType, serDeOptions);
+  auto result = readAll(*reader, makeScanSpec(fileType));
+  auto expected = makeRowVector({
+      makeNullableFlatVector<int64_t>({1, 2, 3, std::nullopt, 5}),
+      makeNullableFlatVector<std::string>(
+          {"a,b", std::nullopt, std::nullopt, "c\\d", ""}),
+      makeNullableFlatVector<bool>(
+          {true, std::nullopt, false, std::nullopt, true}),
+  });
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(TextReaderTest, skipHeaderRows) {
+  const auto filePath =
+      writeText("c0\1c1\nheader\n1\1a\n2\1b\n", "skipHeaderRows.txt");
+  const auto fileType = ROW({"c0", "c1"}, {INTEGER(), VARCHAR()});
+  auto reader = createReader(filePath, fileType);
+  auto result = readAll(*reader, makeScanSpec(fileType), 1'000, 2);
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>({1, 2}),
+      makeFlatVector<std::string>({"a", "b"}),
+  });
+  test::assertEqualVectors(expected, result);
+}
+
+} // namespace
+} // namespace facebook::velox::text
@@ -89,6 +89,56 @@ class Aggregate {
     return false;
   }
 
+  /// Returns true if enableInputRetention() is supported.
+  virtual bool supportsInputRetention() const {
+    return false;
+  }
+
+  /// Allows the function to keep references to rows of the raw input vectors
+  /// passed to addRawInput() and addSingleGroupRawInput() instead of copying
+  /// the values into accumulators, as long as the retained vectors take at
+  /// most 'maxBytes'. The values are then copied once, when results or
+  /// accumulators are extracted. The caller must not modify the input
+  /// vectors after passing them in. Called before any input is added.
+  virtual void enableInputRetention(uint64_t /*maxBytes*/) {
+    VELOX_UNSUPPORTED("enableInputRetention not supported");
+  }
+
+  /// Returns true if addRawInputColumnar() is supported.
+  virtual bool supportsColumnarAccumulators() const {
+    return false;
+  }
+
+  /// Same as addRawInput() with 'mayPushdown' false, for groups that have
+  /// dense slot numbers, e.g. the array index of a group in a kArray hash
+  /// table. The accumulators of the groups are gathered into a dense array
+  /// indexed by slot, the rows are added to that array in row order and the
+  /// array is scattered back to the groups. The results are the same as
+  /// addRawInput().
+  /// @param groups Pointers to the start of the group rows, as in
+  /// addRawInput().
+  /// @param slots Slot of the group of each row, aligned with 'groups'. Rows
+  /// with the same slot have the same group. All slots are below 'numSlots'.
+  /// @param firstRows One row of 'rows' for each distinct slot of 'rows'.
+  virtual void addRawInputColumnar(
+      char** /*groups*/,
+      const uint64_t* /*slots*/,
+      int32_t /*numSlots*/,
+      folly::Range<const vector_size_t*> /*firstRows*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/) {
+    VELOX_UNSUPPORTED("addRawInputColumnar not supported");
+  }
+
+  /// Returns true if the result does not depend on how the input is split
+  /// into intermediate results and on the order the intermediate results are
+  /// merged in, e.g. min and count. Floating point sums may differ in
+  /// rounding. Window aggregates use this to compute sliding frames from a
+  /// segment tree of intermediate results over ranges of rows.
+  virtual bool supportsSegmentTree() const {
+    return false;
+  }
+
   void setAllocator(HashStringAllocator* allocator) {
     setAllocatorInternal(allocator);
   }
@@ -467,6 +517,10 @@ class Aggregate {
   // sequential.
   std::vector<vector_size_t> pushdownCustomIndices_;
 
+  // The single group repeated for each row when pushing down a global
+  // aggregation, as the hooks look up the group by row number.
+  std::vector<char*> pushdownGroups_;
+
   bool validateIntermediateInputs_ = false;
 };
 
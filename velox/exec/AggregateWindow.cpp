@@ -28,7 +28,9 @@ namespace {
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
-// to frameEnd boundaries at that row using singleGroup.
+// to frameEnd boundaries at that row using singleGroup. Sliding frames of
+// aggregates that support it are computed with a segment tree of intermediate
+// results, see Aggregate::supportsSegmentTree().
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -101,6 +103,10 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
 
     computeDefaultAggregateValue(resultType);
+
+    if (aggregate_->supportsSegmentTree()) {
+      intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
+    }
   }
 
   ~AggregateWindowFunction() {
@@ -165,19 +171,38 @@ class AggregateWindowFunction : public exec::WindowFunction {
           result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
-      simpleAggregation(
-          validRows,
-          frameMetadata.firstRow,
-          frameMetadata.lastRow,
-          rawFrameStarts,
-          rawFrameEnds,
-          resultOffset,
-          result);
+      if (useSegmentTree(validRows, rawFrameStarts, rawFrameEnds)) {
+        segmentTreeAggregation(
+            validRows,
+            frameMetadata.firstRow,
+            frameMetadata.lastRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+      } else {
+        simpleAggregation(
+            validRows,
+            frameMetadata.firstRow,
+            frameMetadata.lastRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+      }
     }
     previousFrameMetadata_ = frameMetadata;
   }
 
  private:
+  // Number of child nodes of a segment tree node. The nodes of the first level
+  // aggregate this many input rows each.
+  static constexpr vector_size_t kSegmentTreeFanout = 16;
+
+  // The segment tree is used if the frames have on average at least this many
+  // rows. Smaller frames are cheaper to aggregate row by row.
+  static constexpr vector_size_t kMinSegmentTreeFrameRows = 32;
+
   struct FrameMetadata {
     // Min frame start row required for aggregation.
     vector_size_t firstRow;
@@ -345,6 +370,163 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if the frames of 'validRows' are aggregated with a segment
+  // tree. Incremental aggregation is checked before this.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    if (intermediateType_ == nullptr) {
+      return false;
+    }
+    int64_t numFrameRows = 0;
+    validRows.applyToSelected([&](auto i) {
+      numFrameRows += rawFrameEnds[i] - rawFrameStarts[i] + 1;
+    });
+    return numFrameRows >=
+        static_cast<int64_t>(kMinSegmentTreeFrameRows) *
+        validRows.countSelected();
+  }
+
+  // Computes the aggregate for every frame from a segment tree built over the
+  // rows [minFrame, maxFrame]. Each frame adds the intermediate results of at
+  // most 2 * (kSegmentTreeFanout - 1) nodes or rows per tree level, instead
+  // of all the rows in the frame.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      vector_size_t maxFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    buildSegmentTree(maxFrame + 1 - minFrame);
+
+    validRows.applyToSelected([&](auto i) {
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(
+          &rawSingleGroupRow_, std::vector<vector_size_t>{0});
+      aggregateInitialized_ = true;
+
+      // The frame in units of the current level: rows, then tree nodes.
+      auto frameStart = frameStartsVector[i] - minFrame;
+      auto frameEnd = frameEndsVector[i] - minFrame + 1;
+      for (auto level = 0;; ++level) {
+        // The nodes of the next level that are fully covered by the frame.
+        const vector_size_t nextStart =
+            bits::divRoundUp(frameStart, kSegmentTreeFanout);
+        const auto nextEnd = frameEnd / kSegmentTreeFanout;
+        if (level == segmentTree_.size() || nextStart >= nextEnd) {
+          addSegmentTreeRanges(level, frameStart, frameEnd, 0, 0);
+          break;
+        }
+        addSegmentTreeRanges(
+            level,
+            frameStart,
+            nextStart * kSegmentTreeFanout,
+            nextEnd * kSegmentTreeFanout,
+            frameEnd);
+        frameStart = nextStart;
+        frameEnd = nextEnd;
+      }
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    segmentTree_.clear();
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
+  // Builds 'segmentTree_' over the first 'numRows' rows of 'argVectors_'. The
+  // nodes of level 0 hold the intermediate results of kSegmentTreeFanout
+  // rows each, and the nodes of level i + 1 merge kSegmentTreeFanout nodes of
+  // level i each.
+  void buildSegmentTree(vector_size_t numRows) {
+    segmentTree_.clear();
+    numSegmentTreeRows_ = numRows;
+    std::vector<char*> rowGroups(numRows);
+    auto numInputs = numRows;
+    while (numInputs > kSegmentTreeFanout) {
+      const vector_size_t numNodes =
+          bits::divRoundUp(numInputs, kSegmentTreeFanout);
+      const auto groups = initializeSegmentTreeGroups(numNodes);
+      for (auto j = 0; j < numInputs; ++j) {
+        rowGroups[j] = groups[j / kSegmentTreeFanout];
+      }
+      const SelectivityVector inputs(numInputs);
+      if (segmentTree_.empty()) {
+        aggregate_->addRawInput(rowGroups.data(), inputs, argVectors_, false);
+      } else {
+        aggregate_->addIntermediateResults(
+            rowGroups.data(), inputs, {segmentTree_.back()}, false);
+      }
+      auto nodes = BaseVector::create(intermediateType_, numNodes, pool_);
+      aggregate_->extractAccumulators(groups.data(), numNodes, &nodes);
+      aggregate_->destroy(folly::Range(groups.data(), numNodes));
+      segmentTree_.push_back(std::move(nodes));
+      numInputs = numNodes;
+    }
+  }
+
+  // Returns 'numGroups' initialized accumulator rows for building a segment
+  // tree level.
+  std::vector<char*> initializeSegmentTreeGroups(vector_size_t numGroups) {
+    const auto groupSize = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    const auto numBytes = numGroups * groupSize;
+    if (segmentTreeGroups_ == nullptr ||
+        segmentTreeGroups_->capacity() < numBytes) {
+      segmentTreeGroups_ = AlignedBuffer::allocate<char>(numBytes, pool_);
+    }
+    auto* rawGroups = segmentTreeGroups_->asMutable<char>();
+    std::memset(rawGroups, 0, numBytes);
+
+    std::vector<char*> groups(numGroups);
+    std::vector<vector_size_t> indices(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      groups[i] = rawGroups + i * groupSize;
+      indices[i] = i;
+    }
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(groups.data(), indices);
+    return groups;
+  }
+
+  // Adds the units [begin1, end1) and [begin2, end2) of segment tree 'level'
+  // to the single group. Level 0 units are the input rows in 'argVectors_'
+  // and level i > 0 units are the nodes in 'segmentTree_[i - 1]'.
+  void addSegmentTreeRanges(
+      int32_t level,
+      vector_size_t begin1,
+      vector_size_t end1,
+      vector_size_t begin2,
+      vector_size_t end2) {
+    if (begin1 == end1 && begin2 == end2) {
+      return;
+    }
+    segmentTreeRows_.resize(
+        level == 0 ? numSegmentTreeRows_ : segmentTree_[level - 1]->size());
+    segmentTreeRows_.clearAll();
+    segmentTreeRows_.setValidRange(begin1, end1, true);
+    segmentTreeRows_.setValidRange(begin2, end2, true);
+    segmentTreeRows_.updateBounds();
+    if (level == 0) {
+      aggregate_->addSingleGroupRawInput(
+          rawSingleGroupRow_, segmentTreeRows_, argVectors_, false);
+    } else {
+      aggregate_->addSingleGroupIntermediateResults(
+          rawSingleGroupRow_,
+          segmentTreeRows_,
+          {segmentTree_[level - 1]},
+          false);
+    }
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -393,6 +575,23 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
   VectorPtr emptyResult_;
+
+  // The intermediate type of the aggregate if it supports segment trees, null
+  // otherwise.
+  TypePtr intermediateType_;
+
+  // The levels of the segment tree over the rows of the current output block.
+  // Each level is a vector of intermediate results, see buildSegmentTree().
+  std::vector<VectorPtr> segmentTree_;
+
+  // The number of input rows of 'segmentTree_'.
+  vector_size_t numSegmentTreeRows_{0};
+
+  // Accumulator rows used to build a segment tree level.
+  BufferPtr segmentTreeGroups_;
+
+  // Used to select the rows or nodes of a segment tree level to aggregate.
+  SelectivityVector segmentTreeRows_;
 };
 
 } // namespace
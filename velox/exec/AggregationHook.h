@@ -248,4 +248,42 @@ class MinMaxHook final : public AggregationHook {
   }
 };
 
+/// Counts the non-null values of a column for count(x). The values
+/// themselves are not used. The count of a group is never null.
+class CountHook final : public AggregationHook {
+ public:
+  CountHook(
+      int32_t offset,
+      int32_t nullByte,
+      uint8_t nullMask,
+      char** groups,
+      uint64_t* numNulls)
+      : AggregationHook(offset, nullByte, nullMask, groups, numNulls) {}
+
+  void addValue(vector_size_t row, int64_t /*value*/) final {
+    addValueImpl(row);
+  }
+
+  void addValue(vector_size_t row, int128_t /*value*/) final {
+    addValueImpl(row);
+  }
+
+  void addValue(vector_size_t row, float /*value*/) final {
+    addValueImpl(row);
+  }
+
+  void addValue(vector_size_t row, double /*value*/) final {
+    addValueImpl(row);
+  }
+
+  void addValue(vector_size_t row, folly::StringPiece /*value*/) final {
+    addValueImpl(row);
+  }
+
+ private:
+  void addValueImpl(vector_size_t row) {
+    ++*reinterpret_cast<int64_t*>(findGroup(row) + offset_);
+  }
+};
+
 } // namespace facebook::velox::aggregate
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/ArrowStream.h"
+#include "velox/exec/Task.h"
 #include "velox/vector/arrow/Bridge.h"
 
 namespace facebook::velox::exec {
@@ -27,8 +28,20 @@ ArrowStream::ArrowStream(
           arrowStreamNode->outputType(),
           operatorId,
           arrowStreamNode->id(),
-          "ArrowStream") {
-  arrowStream_ = arrowStreamNode->arrowStream();
+          "ArrowStream"),
+      arrowStreamNode_(arrowStreamNode),
+      executor_(driverCtx->task->queryCtx()->executor()) {}
+
+void ArrowStream::initialize() {
+  SourceOperator::initialize();
+  // Keeps the streams read by this Driver.
+  auto* driverCtx = operatorCtx_->driverCtx();
+  const auto numDrivers = driverCtx->task->numDrivers(driverCtx->driver);
+  const auto& arrowStreams = arrowStreamNode_->arrowStreams();
+  for (size_t i = driverCtx->driverId; i < arrowStreams.size();
+       i += numDrivers) {
+    arrowStreams_.push_back(arrowStreams[i]);
+  }
 }
 
 ArrowStream::~ArrowStream() {
@@ -36,54 +49,109 @@ ArrowStream::~ArrowStream() {
 }
 
 RowVectorPtr ArrowStream::getOutput() {
-  // Get Arrow array.
-  struct ArrowArray arrowArray;
-  if (arrowStream_->get_next(arrowStream_.get(), &arrowArray)) {
-    if (arrowArray.release) {
-      arrowArray.release(&arrowArray);
-    }
-    VELOX_FAIL(
-        "Failed to call get_next on ArrowStream: {}", std::string(getError()));
+  if (finished_) {
+    return nullptr;
+  }
+  std::unique_ptr<Batch> batch;
+  if (nextBatch_ != nullptr) {
+    batch = nextBatch_->move();
+    nextBatch_ = nullptr;
+  } else {
+    batch = fetchNext();
   }
-  if (arrowArray.release == nullptr) {
-    // End of Stream.
+  if (batch->vector == nullptr) {
     finished_ = true;
     return nullptr;
   }
+  prefetch();
+  return std::move(batch->vector);
+}
+
+void ArrowStream::prefetch() {
+  VELOX_CHECK_NULL(nextBatch_);
+  if (executor_ == nullptr) {
+    return;
+  }
+  nextBatch_ = std::make_shared<AsyncSource<Batch>>(
+      [this]() { return fetchNext(); });
+  executor_->add([driverCtx = operatorCtx_->driverCtx(),
+                  source = nextBatch_]() {
+    ScopedDriverThreadContext scopedDriverThreadContext(driverCtx);
+    source->prepare();
+  });
+}
 
-  // Get Arrow schema.
-  struct ArrowSchema arrowSchema;
-  if (arrowStream_->get_schema(arrowStream_.get(), &arrowSchema)) {
-    if (arrowSchema.release) {
-      arrowSchema.release(&arrowSchema);
+std::unique_ptr<ArrowStream::Batch> ArrowStream::fetchNext() {
+  auto batch = std::make_unique<Batch>();
+  for (; streamIndex_ < arrowStreams_.size(); ++streamIndex_) {
+    auto* arrowStream = arrowStreams_[streamIndex_].get();
+
+    // Get Arrow array.
+    struct ArrowArray arrowArray;
+    if (arrowStream->get_next(arrowStream, &arrowArray)) {
+      if (arrowArray.release) {
+        arrowArray.release(&arrowArray);
+      }
+      VELOX_FAIL(
+          "Failed to call get_next on ArrowStream: {}",
+          std::string(getError(arrowStream)));
     }
-    if (arrowArray.release) {
-      arrowArray.release(&arrowArray);
+    if (arrowArray.release == nullptr) {
+      // End of stream.
+      if (arrowStream->release) {
+        arrowStream->release(arrowStream);
+      }
+      continue;
     }
-    VELOX_FAIL(
-        "Failed to call get_schema on ArrowStream: {}",
-        std::string(getError()));
-  }
 
-  // Convert Arrow Array into RowVector and return.
-  return std::dynamic_pointer_cast<RowVector>(
-      importFromArrowAsOwner(arrowSchema, arrowArray, pool()));
+    // Get Arrow schema.
+    struct ArrowSchema arrowSchema;
+    if (arrowStream->get_schema(arrowStream, &arrowSchema)) {
+      if (arrowSchema.release) {
+        arrowSchema.release(&arrowSchema);
+      }
+      if (arrowArray.release) {
+        arrowArray.release(&arrowArray);
+      }
+      VELOX_FAIL(
+          "Failed to call get_schema on ArrowStream: {}",
+          std::string(getError(arrowStream)));
+    }
+
+    // Convert Arrow Array into RowVector. The buffers of the array are
+    // wrapped, not copied, and released with the vector.
+    batch->vector = std::dynamic_pointer_cast<RowVector>(
+        importFromArrowAsOwner(arrowSchema, arrowArray, pool()));
+    break;
+  }
+  return batch;
 }
 
 bool ArrowStream::isFinished() {
   return finished_;
 }
 
-const char* ArrowStream::getError() const {
-  const char* lastError = arrowStream_->get_last_error(arrowStream_.get());
+// static
+const char* ArrowStream::getError(ArrowArrayStream* arrowStream) {
+  const char* lastError = arrowStream->get_last_error(arrowStream);
   VELOX_CHECK_NOT_NULL(lastError);
   return lastError;
 }
 
+void ArrowStream::releaseStreams() {
+  for (auto& arrowStream : arrowStreams_) {
+    if (arrowStream->release) {
+      arrowStream->release(arrowStream.get());
+    }
+  }
+}
+
 void ArrowStream::close() {
-  if (arrowStream_->release) {
-    arrowStream_->release(arrowStream_.get());
+  if (nextBatch_ != nullptr) {
+    nextBatch_->close();
+    nextBatch_ = nullptr;
   }
+  releaseStreams();
   SourceOperator::close();
 }
 
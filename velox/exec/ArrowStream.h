@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/AsyncSource.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
 
@@ -20,6 +21,10 @@
 
 namespace facebook::velox::exec {
 
+/// Reads the Arrow streams of an ArrowStreamNode assigned to its Driver, one
+/// after the other. The batches are imported without copying the buffers.
+/// While a batch is processed by the rest of the pipeline, the next batch is
+/// fetched and imported on the executor of the query, if any.
 class ArrowStream : public SourceOperator {
  public:
   ArrowStream(
@@ -29,6 +34,8 @@ class ArrowStream : public SourceOperator {
 
   virtual ~ArrowStream();
 
+  void initialize() override;
+
   RowVectorPtr getOutput() override;
 
   BlockingReason isBlocked(ContinueFuture* /* unused */) override {
@@ -40,11 +47,38 @@ class ArrowStream : public SourceOperator {
   void close() override;
 
  private:
+  // An imported batch. 'vector' is nullptr at the end of the last stream.
+  struct Batch {
+    RowVectorPtr vector;
+  };
+
+  // Returns the next batch of the streams of 'this', releasing the streams
+  // that are at end.
+  std::unique_ptr<Batch> fetchNext();
+
+  // Starts fetching the next batch on 'executor_', if set.
+  void prefetch();
+
+  // Releases the streams that have not been released.
+  void releaseStreams();
+
   /// Return last error in Arrow array stream.
-  const char* getError() const;
+  static const char* getError(ArrowArrayStream* arrowStream);
+
+  const std::shared_ptr<const core::ArrowStreamNode> arrowStreamNode_;
+  folly::Executor* const executor_;
 
   bool finished_ = false;
-  std::shared_ptr<ArrowArrayStream> arrowStream_;
+
+  // The streams of 'arrowStreamNode_' read by this Driver, set by
+  // initialize(), and the index of the stream being read.
+  std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams_;
+  size_t streamIndex_{0};
+
+  // The next batch, made by fetchNext() on 'executor_' or on the Driver
+  // thread if the executor has not started making it by the time it is
+  // needed.
+  std::shared_ptr<AsyncSource<Batch>> nextBatch_;
 };
 
 } // namespace facebook::velox::exec
@@ -78,41 +78,46 @@ exec::BlockingReason TaskQueue::enqueue(
 
 RowVectorPtr TaskQueue::dequeue() {
   for (;;) {
-    RowVectorPtr vector;
-    std::vector<ContinuePromise> mayContinue;
-    {
-      std::lock_guard<std::mutex> l(mutex_);
-      if (closed_) {
-        return nullptr;
-      }
-
-      if (!queue_.empty()) {
-        auto result = std::move(queue_.front());
-        queue_.pop_front();
-        totalBytes_ -= result.bytes;
-        vector = std::move(result.vector);
-        if (totalBytes_ < maxBytes_ / 2) {
-          mayContinue = std::move(producerUnblockPromises_);
-        }
-      } else if (
-          numProducers_.has_value() && producersFinished_ == numProducers_) {
-        return nullptr;
-      }
-      if (!vector) {
-        consumerBlocked_ = true;
-        consumerPromise_ = ContinuePromise();
-        consumerFuture_ = consumerPromise_.getFuture();
-      }
+    ContinueFuture future = ContinueFuture::makeEmpty();
+    auto vector = dequeue(&future);
+    if (vector != nullptr || !future.valid()) {
+      return vector;
     }
-    // outside of 'mutex_'
-    for (auto& promise : mayContinue) {
-      promise.setValue();
+    future.wait();
+  }
+}
+
+RowVectorPtr TaskQueue::dequeue(ContinueFuture* future) {
+  RowVectorPtr vector;
+  std::vector<ContinuePromise> mayContinue;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (closed_) {
+      return nullptr;
     }
-    if (vector) {
-      return vector;
+
+    if (!queue_.empty()) {
+      auto result = std::move(queue_.front());
+      queue_.pop_front();
+      totalBytes_ -= result.bytes;
+      vector = std::move(result.vector);
+      if (totalBytes_ < maxBytes_ / 2) {
+        mayContinue = std::move(producerUnblockPromises_);
+      }
+    } else if (
+        numProducers_.has_value() && producersFinished_ == numProducers_) {
+      return nullptr;
+    } else {
+      consumerBlocked_ = true;
+      consumerPromise_ = ContinuePromise();
+      *future = consumerPromise_.getSemiFuture();
     }
-    consumerFuture_.wait();
   }
+  // outside of 'mutex_'
+  for (auto& promise : mayContinue) {
+    promise.setValue();
+  }
+  return vector;
 }
 
 void TaskQueue::close() {
@@ -233,13 +238,16 @@ class MultiThreadedTaskCursor : public TaskCursorBase {
         // consumer
         [queue, copyResult = params.copyResult](
             const RowVectorPtr& vector, velox::ContinueFuture* future) {
-          if (!vector || !copyResult) {
+          if (!vector) {
             return queue->enqueue(vector, future);
           }
           // Make sure to load lazy vector if not loaded already.
           for (auto& child : vector->children()) {
             child->loadedVector();
           }
+          if (!copyResult) {
+            return queue->enqueue(vector, future);
+          }
           auto copy = BaseVector::create<RowVector>(
               vector->type(), vector->size(), queue->pool());
           copy->copy(vector.get(), 0, 0, vector->size());
@@ -277,12 +285,23 @@ class MultiThreadedTaskCursor : public TaskCursorBase {
   /// Fetches another batch from the task queue.
   /// Starts the task if not started yet.
   bool moveNext() override {
+    for (;;) {
+      ContinueFuture future = ContinueFuture::makeEmpty();
+      next(&future);
+      if (current_ != nullptr || !future.valid()) {
+        return current_ != nullptr;
+      }
+      future.wait();
+    }
+  }
+
+  RowVectorPtr next(ContinueFuture* future) override {
     start();
     if (error_) {
       std::rethrow_exception(error_);
     }
 
-    current_ = queue_->dequeue();
+    current_ = queue_->dequeue(future);
     if (task_->error()) {
       // Wait for the task to finish (there's' a small period of time between
       // when the error is set on the Task and terminate is called).
@@ -295,10 +314,10 @@ class MultiThreadedTaskCursor : public TaskCursorBase {
       waitForTaskDriversToFinish(task_.get());
       std::rethrow_exception(task_->error());
     }
-    if (!current_) {
+    if (current_ == nullptr && !future->valid()) {
       atEnd_ = true;
     }
-    return current_ != nullptr;
+    return current_;
   }
 
   bool hasNext() override {
@@ -377,6 +396,17 @@ class SingleThreadedTaskCursor : public TaskCursorBase {
     return true;
   };
 
+  RowVectorPtr next(ContinueFuture* future) override {
+    current_ = nullptr;
+    if (next_) {
+      current_ = std::move(next_);
+      next_ = nullptr;
+    } else if (task_->isRunning()) {
+      current_ = task_->next(future);
+    }
+    return current_;
+  }
+
   bool hasNext() override {
     if (next_) {
       return true;
@@ -47,6 +47,9 @@ struct CursorParameters {
   /// Optional, created if not present.
   std::shared_ptr<core::QueryCtx> queryCtx;
 
+  /// The max bytes of output buffered in the cursor. The output Drivers block
+  /// with BlockingReason::kWaitForConsumer above this and continue when the
+  /// consumer has taken half of it.
   uint64_t bufferedBytes{512 * 1024};
 
   /// An optional memory pool to be used to allocate vectors returned by
@@ -70,6 +73,10 @@ struct CursorParameters {
   /// would be built from it.
   std::string spillDirectory;
 
+  /// If false, the output vectors of the Task are handed to the consumer
+  /// without a copy, after loading their lazy children. They are allocated
+  /// from the pools of the Task, so they must be released before the cursor
+  /// is destroyed.
   bool copyResult = true;
 
   /// If true, use serial execution mode. Use parallel execution mode
@@ -111,6 +118,12 @@ class TaskQueue {
   // Returns nullptr when all producers are at end. Otherwise blocks.
   RowVectorPtr dequeue();
 
+  // Returns the next vector without blocking. If there is none, returns
+  // nullptr and sets '*future' to a future that is realized when there may be
+  // one, unless all producers are at end or the queue is closed. There must be
+  // a single consumer.
+  RowVectorPtr dequeue(ContinueFuture* future);
+
   void close();
 
   bool hasNext();
@@ -133,7 +146,6 @@ class TaskQueue {
   std::vector<ContinuePromise> producerUnblockPromises_;
   bool consumerBlocked_ = false;
   ContinuePromise consumerPromise_;
-  ContinueFuture consumerFuture_;
   bool closed_ = false;
 };
 
@@ -150,6 +162,13 @@ class TaskCursor {
   /// Starts the task if not started yet.
   virtual bool moveNext() = 0;
 
+  /// Returns the next batch without blocking the calling thread and sets it as
+  /// current(). If there is no batch yet, returns nullptr and sets '*future'
+  /// to a future that is realized when the caller should call next() again.
+  /// Returns nullptr without setting '*future' at end. Throws the errors of
+  /// the task. Starts the task if not started yet.
+  virtual RowVectorPtr next(ContinueFuture* future) = 0;
+
   virtual bool hasNext() = 0;
 
   virtual RowVectorPtr& current() = 0;
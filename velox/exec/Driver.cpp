@@ -16,7 +16,11 @@
 
 #include "velox/exec/Driver.h"
 
+#include <folly/ScopeGuard.h>
+
+#include "velox/common/memory/NumaUtil.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/process/TraceEvents.h"
 #include "velox/exec/Task.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -24,6 +28,10 @@ using facebook::velox::common::testutil::TestValue;
 namespace facebook::velox::exec {
 namespace {
 
+// The min time a Driver of a lower priority class runs before it yields to
+// the queued Drivers of a higher class.
+constexpr uint64_t kMinRunMsBeforePreemption = 1;
+
 // Checks if output channel is produced using identity projection and returns
 // input channel if so.
 std::optional<column_index_t> getIdentityProjection(
@@ -39,6 +47,11 @@ std::optional<column_index_t> getIdentityProjection(
 
 thread_local DriverThreadContext* driverThreadCtx{nullptr};
 
+// Returns the detail of the timeline events of the Driver of 'ctx'.
+std::string timelineDetail(const DriverCtx& ctx) {
+  return fmt::format("pipeline {} driver {}", ctx.pipelineId, ctx.driverId);
+}
+
 void recordSilentThrows(Operator& op) {
   auto numThrow = threadNumVeloxThrow();
   if (numThrow > 0) {
@@ -117,7 +130,7 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
   }
   common::GetSpillDirectoryPathCB getSpillDirPathCb =
       [this]() -> std::string_view {
-    return task->getOrCreateSpillDirectory();
+    return task->nextSpillDirectory();
   };
   const auto& spillFilePrefix =
       fmt::format("{}_{}_{}", pipelineId, driverId, operatorId);
@@ -144,7 +157,10 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.spillPrefixSortEnabled()
           ? std::optional<common::PrefixSortConfig>(prefixSortConfig())
           : std::nullopt,
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      queryConfig.spillAsyncWriteEnabled(),
+      queryConfig.spillReadAheadBuffers(),
+      queryConfig.spillCompressionDictionarySize());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -189,7 +205,7 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
           // The thread will be enqueued at resume.
           return;
         }
-        Driver::enqueue(state->driver_);
+        Driver::enqueue(state->driver_, /*resumed=*/true);
       })
       .thenError(
           folly::tag_t<std::exception>{}, [state](std::exception const& e) {
@@ -232,16 +248,46 @@ std::ostream& operator<<(std::ostream& out, const StopReason& reason) {
 }
 
 // static
-void Driver::enqueue(std::shared_ptr<Driver> driver) {
+void Driver::enqueue(std::shared_ptr<Driver> driver, bool resumed) {
   process::ScopedThreadDebugInfo scopedInfo(
       driver->driverCtx()->threadDebugInfo);
+  process::ScopedTraceEventRecorder scopedRecorder(driver->task()->timeline());
+  VELOX_TRACE_PROBE(driver_enqueue, driver.get(), resumed);
+  process::addTraceEvent("driver", "enqueue", [&]() {
+    return timelineDetail(*driver->driverCtx());
+  });
   // This is expected to be called inside the Driver's Tasks's mutex.
   driver->enqueueInternal();
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  if (auto* executor = driver->driverExecutor_) {
+    // A resumed Driver runs next on the worker resuming it, which likely
+    // produced its input. Otherwise, it goes back to the worker that last ran
+    // it.
+    const auto worker = driver->lastWorker_;
+    const auto priorityClass = driver->priorityClass_;
+    const auto numaNode = driver->numaNode_;
+    executor->add(
+        [driver = std::move(driver)]() { Driver::run(driver); },
+        worker,
+        /*lifo=*/resumed,
+        priorityClass,
+        numaNode);
+    return;
+  }
+  auto* executor = driver->task()->queryCtx()->executor();
+  if (driver->priorityClass_ != DriverPriorityClass::kDefault &&
+      executor->getNumPriorities() > 1) {
+    const auto priority =
+        driver->priorityClass_ == DriverPriorityClass::kInteractive
+        ? folly::Executor::HI_PRI
+        : folly::Executor::LO_PRI;
+    executor->addWithPriority(
+        [driver = std::move(driver)]() { Driver::run(driver); }, priority);
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -250,10 +296,25 @@ void Driver::init(
   VELOX_CHECK_NULL(ctx_);
   ctx_ = std::move(ctx);
   cpuSliceMs_ = task()->driverCpuTimeSliceLimitMs();
+  driverExecutor_ =
+      dynamic_cast<DriverExecutor*>(task()->queryCtx()->executor());
+  priorityClass_ = task()->driverPriorityClass();
+  numaNode_ = task()->preferredNumaNode();
+  if (driverExecutor_ != nullptr && numaNode_ != memory::kNoNumaNode &&
+      (numaNode_ >= driverExecutor_->numNumaNodes() ||
+       task()->maxPipelineDrivers() >
+           driverExecutor_->numWorkers(numaNode_))) {
+    // The task needs more parallelism than the node provides. Runs on all the
+    // workers and allocates memory local to the worker.
+    numaNode_ = memory::kNoNumaNode;
+  }
   VELOX_CHECK(operators_.empty());
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackOperatorPerfCounters_ =
+      ctx_->queryConfig().operatorTrackPerfCounters() &&
+      process::readThreadPerfCounters().has_value();
 }
 
 void Driver::initializeOperators() {
@@ -321,9 +382,13 @@ RowVectorPtr Driver::next(ContinueFuture* future) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(self->driverCtx());
+  process::ScopedTraceEventRecorder scopedRecorder(task()->timeline());
+  if (self->driverExecutor_ != nullptr) {
+    self->lastWorker_ = self->driverExecutor_->currentWorker();
+  }
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr result;
-  const auto stop = runInternal(self, blockingState, result);
+  const auto stop = runTimed(self, blockingState, result);
 
   if (blockingState != nullptr) {
     VELOX_CHECK_NULL(result);
@@ -363,6 +428,12 @@ void Driver::enqueueInternal() {
     RuntimeStatWriterScopeGuard statsWriterGuard(operatorPtr);             \
     threadNumVeloxThrow() = 0;                                             \
     opCallStatus_.start(operatorId, operatorMethod);                       \
+    process::TraceSpan traceSpan("operator", operatorMethod, [&]() {       \
+      return fmt::format(                                                  \
+          "{} {}",                                                         \
+          operatorPtr->operatorType(),                                     \
+          operatorPtr->planNodeId());                                      \
+    });                                                                    \
     ExceptionContextSetter exceptionContext(                               \
         {addContextOnException, operatorPtr, true});                       \
     auto stopGuard = folly::makeGuard([&]() { opCallStatus_.stop(); });    \
@@ -468,6 +539,14 @@ CpuWallTiming Driver::processLazyIoStats(
 }
 
 bool Driver::shouldYield() const {
+  // Yields to the queued drivers of a higher priority class after running for
+  // a minimum time, also when the CPU time slice is not limited.
+  if (driverExecutor_ != nullptr &&
+      priorityClass_ != DriverPriorityClass::kInteractive &&
+      execTimeMs() >= kMinRunMsBeforePreemption &&
+      driverExecutor_->hasQueuedHigherPriority(priorityClass_)) {
+    return true;
+  }
   if (cpuSliceMs_ == 0) {
     return false;
   }
@@ -498,6 +577,8 @@ StopReason Driver::runInternal(
     return stop;
   }
 
+  memory::ScopedPreferredNumaNode numaNodeGuard(numaNode_);
+
   // Update the queued time after entering the Task to ensure the stats have not
   // been deleted.
   if (curOperatorId_ < operators_.size()) {
@@ -506,6 +587,20 @@ StopReason Driver::runInternal(
         RuntimeCounter(queuedTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
     RECORD_HISTOGRAM_METRIC_VALUE(
         kMetricDriverQueueTimeMs, queuedTimeUs / 1'000);
+    switch (priorityClass_) {
+      case DriverPriorityClass::kInteractive:
+        RECORD_HISTOGRAM_METRIC_VALUE(
+            kMetricInteractiveDriverQueueTimeMs, queuedTimeUs / 1'000);
+        break;
+      case DriverPriorityClass::kDefault:
+        RECORD_HISTOGRAM_METRIC_VALUE(
+            kMetricDefaultDriverQueueTimeMs, queuedTimeUs / 1'000);
+        break;
+      case DriverPriorityClass::kBatch:
+        RECORD_HISTOGRAM_METRIC_VALUE(
+            kMetricBatchDriverQueueTimeMs, queuedTimeUs / 1'000);
+        break;
+    }
   }
 
   CancelGuard guard(self, task().get(), &state_, [&](StopReason reason) {
@@ -525,6 +620,7 @@ StopReason Driver::runInternal(
 
     const int32_t numOperators = operators_.size();
     ContinueFuture future = ContinueFuture::makeEmpty();
+    int32_t numOnThreadResumes = 0;
 
     for (;;) {
       for (int32_t i = numOperators - 1; i >= 0; --i) {
@@ -570,6 +666,11 @@ StopReason Driver::runInternal(
         });
 
         if (blockingReason_ != BlockingReason::kNotBlocked) {
+          if (tryResumeOnThread(op, future, numOnThreadResumes)) {
+            // Runs 'op' again.
+            ++i;
+            continue;
+          }
           return blockDriver(self, i, std::move(future), blockingState, guard);
         }
 
@@ -584,6 +685,10 @@ StopReason Driver::runInternal(
                 kOpMethodIsBlocked);
           });
           if (blockingReason_ != BlockingReason::kNotBlocked) {
+            if (tryResumeOnThread(nextOp, future, numOnThreadResumes)) {
+              ++i;
+              continue;
+            }
             return blockDriver(
                 self, i + 1, std::move(future), blockingState, guard);
           }
@@ -659,6 +764,10 @@ StopReason Driver::runInternal(
                     kOpMethodIsBlocked);
               });
               if (blockingReason_ != BlockingReason::kNotBlocked) {
+                if (tryResumeOnThread(op, future, numOnThreadResumes)) {
+                  ++i;
+                  continue;
+                }
                 return blockDriver(
                     self, i, std::move(future), blockingState, guard);
               }
@@ -747,6 +856,35 @@ StopReason Driver::runInternal(
 
 #undef CALL_OPERATOR
 
+StopReason Driver::runTimed(
+    std::shared_ptr<Driver>& self,
+    std::shared_ptr<BlockingState>& blockingState,
+    RowVectorPtr& result) {
+  VELOX_TRACE_PROBE(driver_run_begin, this);
+  StopReason stop;
+  {
+    process::TraceSpan span(
+        "driver", "run", [&]() { return timelineDetail(*ctx_); });
+    stop = runInternal(self, blockingState, result);
+  }
+  VELOX_TRACE_PROBE(driver_run_end, this, static_cast<int32_t>(stop));
+  if (stop == StopReason::kBlock && blockingState != nullptr) {
+    VELOX_TRACE_PROBE(
+        driver_block, this, static_cast<int32_t>(blockingReason_));
+    process::addTraceEvent("driver", "block", [&]() {
+      return fmt::format(
+          "{} {}",
+          timelineDetail(*ctx_),
+          blockingReasonToString(blockingReason_));
+    });
+  } else if (stop == StopReason::kYield) {
+    VELOX_TRACE_PROBE(driver_yield, this);
+    process::addTraceEvent(
+        "driver", "yield", [&]() { return timelineDetail(*ctx_); });
+  }
+  return stop;
+}
+
 // static
 std::atomic_uint64_t& Driver::yieldCount() {
   static std::atomic_uint64_t count{0};
@@ -765,9 +903,10 @@ void Driver::run(std::shared_ptr<Driver> self) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(self->driverCtx());
+  process::ScopedTraceEventRecorder scopedRecorder(self->task()->timeline());
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
-  auto reason = self->runInternal(self, blockingState, nullResult);
+  auto reason = self->runTimed(self, blockingState, nullResult);
 
   // When Driver runs on an executor, the last operator (sink) must not produce
   // any results.
@@ -886,6 +1025,19 @@ bool Driver::mayPushdownAggregation(Operator* aggregation) const {
       aggregation->toString());
 }
 
+void Driver::pushdownLimit(const Operator* limit, int64_t numRows) const {
+  for (auto i = 1; i < operators_.size(); ++i) {
+    auto op = operators_[i].get();
+    if (limit == op) {
+      operators_[0]->addLimitHint(numRows);
+      return;
+    }
+    if (!op->isFilter() || !op->preservesOrder()) {
+      return;
+    }
+  }
+}
+
 std::unordered_set<column_index_t> Driver::canPushdownFilters(
     const Operator* filterSource,
     const std::vector<column_index_t>& channels) const {
@@ -1039,6 +1191,16 @@ void Driver::withDeltaCpuWallTimer(
     Operator* op,
     TimingMemberPtr opTimingMember,
     Func&& opFunction) {
+  std::optional<process::PerfCounters> perfCountersStart;
+  if (FOLLY_UNLIKELY(trackOperatorPerfCounters_)) {
+    perfCountersStart = process::readThreadPerfCounters();
+  }
+  SCOPE_EXIT {
+    if (perfCountersStart.has_value()) {
+      recordPerfCounters(op, perfCountersStart.value());
+    }
+  };
+
   // If 'trackOperatorCpuUsage_' is true, create and initialize the timer object
   // to track cpu and wall time of the opFunction.
   if (!trackOperatorCpuUsage_) {
@@ -1059,6 +1221,18 @@ void Driver::withDeltaCpuWallTimer(
   opFunction();
 }
 
+void Driver::recordPerfCounters(
+    Operator* op,
+    const process::PerfCounters& start) {
+  const auto end = process::readThreadPerfCounters();
+  if (!end.has_value()) {
+    return;
+  }
+  op->stats().withWLock([&](auto& lockedStats) {
+    lockedStats.perfCounters.add(end->delta(start));
+  });
+}
+
 void Driver::validateOperatorOutputResult(
     const RowVectorPtr& result,
     const Operator& op) {
@@ -1103,6 +1277,22 @@ StopReason Driver::blockDriver(
   return StopReason::kBlock;
 }
 
+bool Driver::tryResumeOnThread(
+    Operator* op,
+    ContinueFuture& future,
+    int32_t& numResumes) {
+  if (blockingReason_ == BlockingReason::kYield ||
+      numResumes >= kMaxOnThreadResumes || !future.valid() ||
+      !future.isReady() || future.hasException()) {
+    return false;
+  }
+  ++numResumes;
+  blockingReason_ = BlockingReason::kNotBlocked;
+  future = ContinueFuture::makeEmpty();
+  op->addRuntimeStat(kOnThreadResumes, RuntimeCounter(1));
+  return true;
+}
+
 std::string Driver::label() const {
   return fmt::format("<Driver {}:{}>", task()->taskId(), ctx_->driverId);
 }
@@ -1135,6 +1325,8 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kWaitForScanScaleUp";
     case BlockingReason::kWaitForIndexLookup:
       return "kWaitForIndexLookup";
+    case BlockingReason::kWaitForPipelineScaleUp:
+      return "kWaitForPipelineScaleUp";
     default:
       VELOX_UNREACHABLE(
           fmt::format("Unknown blocking reason {}", static_cast<int>(reason)));
@@ -25,9 +25,12 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/TraceConfig.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
+#include "velox/exec/DriverExecutor.h"
+#include "velox/exec/FragmentResultCache.h"
 
 namespace facebook::velox::exec {
 
@@ -217,6 +220,10 @@ enum class BlockingReason {
   /// Used by IndexLookupJoin operator, indicating that it was blocked by the
   /// async index lookup.
   kWaitForIndexLookup,
+  /// For a source operator of a pipeline, it is blocked waiting for the
+  /// pipeline controller to increase the number of running drivers of the
+  /// pipeline.
+  kWaitForPipelineScaleUp,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -285,6 +292,9 @@ struct DriverCtx {
   /// auxiliary operator such as the aggregation operator used by the table
   /// writer to generate the columns stats.
   std::unordered_map<int32_t, std::string> tracedOperatorMap;
+  /// Shared by the TableScan and the partial aggregation of a cacheable
+  /// fragment if fragment_result_cache_enabled is set.
+  std::shared_ptr<FragmentResultCache> fragmentResultCache;
 
   DriverCtx(
       std::shared_ptr<Task> _task,
@@ -308,7 +318,9 @@ struct DriverCtx {
     return common::PrefixSortConfig{
         queryConfig().prefixSortNormalizedKeyMaxBytes(),
         queryConfig().prefixSortMinRows(),
-        queryConfig().prefixSortMaxStringPrefixLength()};
+        queryConfig().prefixSortMaxStringPrefixLength(),
+        queryConfig().prefixSortMaxAdaptiveStringPrefixLength(),
+        queryConfig().prefixSortMinRadixSortRows()};
   }
 };
 
@@ -365,7 +377,21 @@ struct OpCallStatus {
 
 class Driver : public std::enable_shared_from_this<Driver> {
  public:
-  static void enqueue(std::shared_ptr<Driver> instance);
+  /// The max number of times per run a Driver continues on thread after an
+  /// operator returned a blocking future that is already realized, instead of
+  /// going off thread and being enqueued again. Keeps an operator that keeps
+  /// returning realized futures from holding the thread.
+  static constexpr int32_t kMaxOnThreadResumes = 16;
+
+  /// The runtime stat of an operator counting the times the Driver continued
+  /// on thread after the operator returned a realized blocking future.
+  static constexpr const char* kOnThreadResumes = "numOnThreadResumes";
+
+  /// Adds 'instance' to the executor of its query with the priority of its
+  /// DriverPriorityClass. 'resumed' is set if 'instance' is enqueued after its
+  /// blocking future is realized, in which case a DriverExecutor runs it next
+  /// on the calling worker.
+  static void enqueue(std::shared_ptr<Driver> instance, bool resumed = false);
 
   /// Run the pipeline until it produces a batch of data or gets blocked.
   /// Return the data produced or nullptr if pipeline finished processing and
@@ -404,7 +430,8 @@ class Driver : public std::enable_shared_from_this<Driver> {
   }
 
   /// Returns true if this driver is running on thread and has exceeded the cpu
-  /// time slice limit if set.
+  /// time slice limit if set, or if a driver of a higher DriverPriorityClass
+  /// is queued on its DriverExecutor.
   bool shouldYield() const;
 
   /// Checks if the associated query is under memory arbitration or not. The
@@ -421,6 +448,11 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// order-preserving and do not increase cardinality.
   bool mayPushdownAggregation(Operator* aggregation) const;
 
+  /// Passes a hint that 'limit' needs only 'numRows' rows to the source of
+  /// the pipeline if all operators in between are order-preserving and do not
+  /// increase cardinality.
+  void pushdownLimit(const Operator* limit, int64_t numRows) const;
+
   /// Returns a subset of channels for which there are operators upstream from
   /// filterSource that accept dynamically generated filters.
   std::unordered_set<column_index_t> canPushdownFilters(
@@ -521,6 +553,14 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   static void run(std::shared_ptr<Driver> self);
 
+  // Calls runInternal() and records its span and, if the Driver stops for
+  // blocking or yielding, the block or yield event to the timeline of the
+  // Task.
+  StopReason runTimed(
+      std::shared_ptr<Driver>& self,
+      std::shared_ptr<BlockingState>& blockingState,
+      RowVectorPtr& result);
+
   StopReason runInternal(
       std::shared_ptr<Driver>& self,
       std::shared_ptr<BlockingState>& blockingState,
@@ -548,6 +588,10 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // operator triggered the load but these do not bias the op's timing.
   CpuWallTiming processLazyIoStats(Operator& op, const CpuWallTiming& timing);
 
+  // Adds the hardware performance counts of the calling thread since 'start'
+  // to the stats of 'op'.
+  void recordPerfCounters(Operator* op, const process::PerfCounters& start);
+
   inline void validateOperatorOutputResult(
       const RowVectorPtr& result,
       const Operator& op);
@@ -559,6 +603,16 @@ class Driver : public std::enable_shared_from_this<Driver> {
       std::shared_ptr<BlockingState>& blockingState,
       CancelGuard& guard);
 
+  // Returns true if 'future', returned by 'op' blocked on 'blockingReason_',
+  // is already realized and the Driver continues on thread instead of going
+  // off thread. Resets 'blockingReason_' and 'future' if so. Yields are not
+  // continued. 'numResumes' counts the resumes of this run, up to
+  // kMaxOnThreadResumes.
+  bool tryResumeOnThread(
+      Operator* op,
+      ContinueFuture& future,
+      int32_t& numResumes);
+
   std::unique_ptr<DriverCtx> ctx_;
 
   // If not zero, specifies the driver cpu time slice.
@@ -575,6 +629,18 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   // Timer used to track down the time we are sitting in the driver queue.
   size_t queueTimeStartUs_{0};
+
+  // Set if the executor of the query is a DriverExecutor.
+  DriverExecutor* driverExecutor_{nullptr};
+
+  // The worker of 'driverExecutor_' that last ran 'this'.
+  int32_t lastWorker_{DriverExecutor::kNoWorker};
+
+  DriverPriorityClass priorityClass_{DriverPriorityClass::kDefault};
+
+  // The NUMA node 'this' runs on and allocates memory from, or
+  // memory::kNoNumaNode if not placed on a node.
+  int32_t numaNode_{memory::kNoNumaNode};
   // Id (index in the vector) of the current operator to run (or the 1st one if
   // we haven't started yet). Used to determine which operator's queueTime we
   // should update.
@@ -587,6 +653,10 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  // Set if track_operator_perf_counters is set and the perf events of the
+  // thread can be read.
+  bool trackOperatorPerfCounters_{false};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
@@ -642,6 +712,9 @@ struct DriverFactory {
   folly::F14FastSet<core::PlanNodeId> mixedExecutionModeHashJoinNodeIds;
   /// Same as 'mixedExecutionModeHashJoinNodeIds' but for Nested Loop Joins.
   folly::F14FastSet<core::PlanNodeId> mixedExecutionModeNestedLoopJoinNodeIds;
+  /// The cacheable fragment at the start of the pipeline, if any. Set if
+  /// fragment_result_cache_enabled is set.
+  std::optional<FragmentResultCache::Fragment> cacheableFragment;
 
   std::shared_ptr<Driver> createDriver(
       std::unique_ptr<DriverCtx> ctx,
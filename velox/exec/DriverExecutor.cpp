@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverExecutor.h"
+
+#include <folly/system/ThreadName.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+namespace {
+// The executor and the id of the worker running on this thread.
+thread_local const DriverExecutor* currentExecutor{nullptr};
+thread_local int32_t currentWorkerId{DriverExecutor::kNoWorker};
+
+int32_t classIndex(DriverPriorityClass priorityClass) {
+  return static_cast<int32_t>(priorityClass);
+}
+} // namespace
+
+DriverPriorityClass driverPriorityClassFromName(const std::string& name) {
+  if (name == "interactive") {
+    return DriverPriorityClass::kInteractive;
+  }
+  if (name == "default") {
+    return DriverPriorityClass::kDefault;
+  }
+  if (name == "batch") {
+    return DriverPriorityClass::kBatch;
+  }
+  VELOX_USER_FAIL("Unknown driver priority class: {}", name);
+}
+
+std::string_view driverPriorityClassName(DriverPriorityClass priorityClass) {
+  switch (priorityClass) {
+    case DriverPriorityClass::kInteractive:
+      return "interactive";
+    case DriverPriorityClass::kDefault:
+      return "default";
+    case DriverPriorityClass::kBatch:
+      return "batch";
+  }
+  VELOX_UNREACHABLE();
+}
+
+DriverExecutor::DriverExecutor(
+    int32_t numThreads,
+    const std::string& threadNamePrefix,
+    int32_t numNumaNodes) {
+  VELOX_CHECK_GT(numThreads, 0);
+  VELOX_CHECK_GT(numNumaNodes, 0);
+  VELOX_CHECK_LE(numNumaNodes, numThreads);
+  nodeWorkers_.resize(numNumaNodes);
+  workers_.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    // Consecutive workers are on the same node.
+    workers_[i]->numaNode = i * numNumaNodes / numThreads;
+    nodeWorkers_[workers_[i]->numaNode].push_back(i);
+  }
+  for (auto i = 0; i < numThreads; ++i) {
+    workers_[i]->thread =
+        std::thread([this, i, threadNamePrefix, numNumaNodes]() {
+          folly::setThreadName(fmt::format("{}{}", threadNamePrefix, i));
+          if (numNumaNodes > 1 &&
+              !memory::pinThreadToNumaNode(workers_[i]->numaNode)) {
+            LOG(WARNING) << "Failed to pin DriverExecutor worker " << i
+                         << " to NUMA node " << workers_[i]->numaNode;
+          }
+          run(i);
+        });
+  }
+}
+
+DriverExecutor::~DriverExecutor() {
+  {
+    std::lock_guard<std::mutex> l(idleMutex_);
+    stopped_ = true;
+  }
+  idleCv_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void DriverExecutor::addWithPriority(folly::Func func, int8_t priority) {
+  auto priorityClass = DriverPriorityClass::kDefault;
+  if (priority > folly::Executor::MID_PRI) {
+    priorityClass = DriverPriorityClass::kInteractive;
+  } else if (priority < folly::Executor::MID_PRI) {
+    priorityClass = DriverPriorityClass::kBatch;
+  }
+  add(std::move(func), kNoWorker, /*lifo=*/false, priorityClass);
+}
+
+void DriverExecutor::add(
+    folly::Func func,
+    int32_t worker,
+    bool lifo,
+    DriverPriorityClass priorityClass,
+    int32_t numaNode) {
+  VELOX_CHECK(func);
+  if (numaNode != memory::kNoNumaNode) {
+    VELOX_CHECK_GE(numaNode, 0);
+    VELOX_CHECK_LT(numaNode, nodeWorkers_.size());
+  }
+  auto onNode = [&](int32_t worker) {
+    return numaNode == memory::kNoNumaNode ||
+        workers_[worker]->numaNode == numaNode;
+  };
+  const auto current = currentWorker();
+  if (lifo && current != kNoWorker && onNode(current)) {
+    // The func in the LIFO slot is run only by its worker, which is the
+    // caller, so no other worker needs to be woken up unless a func is
+    // displaced to the queue.
+    auto& target = *workers_[current];
+    std::lock_guard<std::mutex> l(target.mutex);
+    if (!target.lifo.func) {
+      target.lifo = {std::move(func), numaNode};
+      target.lifoClass = priorityClass;
+      return;
+    }
+    target.queues[classIndex(target.lifoClass)].push_back(
+        std::move(target.lifo));
+    ++numPendingByClass_[classIndex(target.lifoClass)];
+    target.lifo = {std::move(func), numaNode};
+    target.lifoClass = priorityClass;
+  } else {
+    if (worker != kNoWorker) {
+      VELOX_CHECK_GE(worker, 0);
+      VELOX_CHECK_LT(worker, workers_.size());
+    }
+    if (worker == kNoWorker || !onNode(worker)) {
+      if (numaNode == memory::kNoNumaNode) {
+        worker = nextWorker_++ % workers_.size();
+      } else {
+        const auto& nodeWorkers = nodeWorkers_[numaNode];
+        worker = nodeWorkers[nextWorker_++ % nodeWorkers.size()];
+      }
+    }
+    auto& target = *workers_[worker];
+    std::lock_guard<std::mutex> l(target.mutex);
+    target.queues[classIndex(priorityClass)].push_back(
+        {std::move(func), numaNode});
+    ++numPendingByClass_[classIndex(priorityClass)];
+  }
+  ++numPending_;
+  notify();
+}
+
+bool DriverExecutor::hasQueuedHigherPriority(
+    DriverPriorityClass priorityClass) const {
+  for (auto i = classIndex(priorityClass) + 1; i < kNumDriverPriorityClasses;
+       ++i) {
+    if (numPendingByClass_[i] > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int32_t DriverExecutor::currentWorker() const {
+  return currentExecutor == this ? currentWorkerId : kNoWorker;
+}
+
+DriverExecutor::Stats DriverExecutor::stats() const {
+  Stats stats;
+  for (const auto& worker : workers_) {
+    stats.numLifoRuns += worker->numLifoRuns;
+    stats.numLocalRuns += worker->numLocalRuns;
+    stats.numStolenRuns += worker->numStolenRuns;
+  }
+  return stats;
+}
+
+void DriverExecutor::notify() {
+  if (numIdle_ > 0) {
+    std::lock_guard<std::mutex> l(idleMutex_);
+    idleCv_.notify_one();
+  }
+}
+
+void DriverExecutor::run(int32_t worker) {
+  currentExecutor = this;
+  currentWorkerId = worker;
+  auto& self = *workers_[worker];
+  int32_t numLifoRuns = 0;
+  auto priorityClass = DriverPriorityClass::kDefault;
+  for (;;) {
+    if (auto func = next(worker, numLifoRuns, priorityClass)) {
+      const auto start = std::chrono::steady_clock::now();
+      try {
+        func();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "DriverExecutor func threw: " << e.what();
+      }
+      const auto elapsedNanos =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count();
+      self.virtualNanos[classIndex(priorityClass)] += elapsedNanos *
+          kPriorityClassWeights.back() /
+          kPriorityClassWeights[classIndex(priorityClass)];
+      continue;
+    }
+    std::unique_lock<std::mutex> l(idleMutex_);
+    // 'numIdle_' is incremented before checking 'numPending_' so that a
+    // concurrent add() either sees the worker as idle or is seen by it.
+    ++numIdle_;
+    idleCv_.wait(l, [&]() { return numPending_ > 0 || stopped_; });
+    --numIdle_;
+    if (stopped_ && numPending_ == 0) {
+      return;
+    }
+  }
+}
+
+folly::Func DriverExecutor::next(
+    int32_t worker,
+    int32_t& numLifoRuns,
+    DriverPriorityClass& priorityClass) {
+  auto& self = *workers_[worker];
+  {
+    std::lock_guard<std::mutex> l(self.mutex);
+    const auto queueClass = nextClass(self);
+    if (self.lifo.func &&
+        (numLifoRuns < kMaxLifoRuns || !queueClass.has_value())) {
+      ++numLifoRuns;
+      ++self.numLifoRuns;
+      auto func = std::move(self.lifo.func);
+      self.lifo = {};
+      priorityClass = self.lifoClass;
+      return func;
+    }
+    numLifoRuns = 0;
+    if (queueClass.has_value()) {
+      ++self.numLocalRuns;
+      priorityClass = queueClass.value();
+      return popFront(self.queues[classIndex(priorityClass)], priorityClass);
+    }
+  }
+  return steal(worker, priorityClass);
+}
+
+std::optional<DriverPriorityClass> DriverExecutor::nextClass(
+    Worker& worker) const {
+  // Picks the class with queued funcs that has run for the least time
+  // relative to its weight, the higher class on ties.
+  std::optional<int32_t> next;
+  for (auto i = kNumDriverPriorityClasses - 1; i >= 0; --i) {
+    if (!worker.queues[i].empty() &&
+        (!next.has_value() ||
+         worker.virtualNanos[i] < worker.virtualNanos[next.value()])) {
+      next = i;
+    }
+  }
+  if (!next.has_value()) {
+    return std::nullopt;
+  }
+  // The classes without queued funcs catch up with the class to run next, so
+  // that they do not take over the worker once they have queued funcs.
+  for (auto i = 0; i < kNumDriverPriorityClasses; ++i) {
+    if (worker.queues[i].empty()) {
+      worker.virtualNanos[i] = std::max(
+          worker.virtualNanos[i], worker.virtualNanos[next.value()]);
+    }
+  }
+  return static_cast<DriverPriorityClass>(next.value());
+}
+
+folly::Func DriverExecutor::popFront(
+    std::deque<Entry>& queue,
+    DriverPriorityClass priorityClass) {
+  auto func = std::move(queue.front().func);
+  queue.pop_front();
+  --numPending_;
+  --numPendingByClass_[classIndex(priorityClass)];
+  return func;
+}
+
+folly::Func DriverExecutor::steal(
+    int32_t worker,
+    DriverPriorityClass& priorityClass) {
+  auto& self = *workers_[worker];
+  const auto numWorkers = workers_.size();
+  std::vector<Entry> stolen;
+  // Tries the workers on the node of 'worker' first, then the others.
+  for (auto pass = 0; pass < 2 && stolen.empty(); ++pass) {
+    for (auto i = 1; i < numWorkers && stolen.empty(); ++i) {
+      auto& victim = *workers_[(worker + i) % numWorkers];
+      if ((victim.numaNode == self.numaNode) != (pass == 0)) {
+        continue;
+      }
+      std::lock_guard<std::mutex> l(victim.mutex);
+      for (auto j = kNumDriverPriorityClasses - 1;
+           j >= 0 && stolen.empty();
+           --j) {
+        priorityClass = static_cast<DriverPriorityClass>(j);
+        stealFrom(self, victim.queues[j], priorityClass, stolen);
+      }
+    }
+  }
+  if (stolen.empty()) {
+    return nullptr;
+  }
+
+  ++self.numStolenRuns;
+  if (stolen.size() > 1) {
+    std::lock_guard<std::mutex> l(self.mutex);
+    auto& queue = self.queues[classIndex(priorityClass)];
+    for (auto i = 1; i < stolen.size(); ++i) {
+      queue.push_back(std::move(stolen[i]));
+    }
+  }
+  return std::move(stolen[0].func);
+}
+
+void DriverExecutor::stealFrom(
+    const Worker& worker,
+    std::deque<Entry>& queue,
+    DriverPriorityClass priorityClass,
+    std::vector<Entry>& stolen) {
+  auto mayRun = [&](const Entry& entry) {
+    return entry.numaNode == memory::kNoNumaNode ||
+        entry.numaNode == worker.numaNode;
+  };
+  const auto numEligible = std::count_if(queue.begin(), queue.end(), mayRun);
+  if (numEligible == 0) {
+    return;
+  }
+  const auto numStolen = (numEligible + 1) / 2;
+  stolen.reserve(numStolen);
+  auto it = queue.begin();
+  while (it != queue.end() && stolen.size() < numStolen) {
+    if (!mayRun(*it)) {
+      ++it;
+      continue;
+    }
+    stolen.push_back(std::move(*it));
+    it = queue.erase(it);
+  }
+  // The funcs moved to the queue of 'worker' stay pending.
+  --numPending_;
+  --numPendingByClass_[classIndex(priorityClass)];
+}
+
+} // namespace facebook::velox::exec
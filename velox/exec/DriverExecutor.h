@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Executor.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "velox/common/memory/NumaUtil.h"
+
+namespace facebook::velox::exec {
+
+/// The priority class of the Drivers of a query, set by the
+/// driver_priority_class query config.
+enum class DriverPriorityClass : int8_t {
+  kBatch = 0,
+  kDefault = 1,
+  kInteractive = 2,
+};
+
+constexpr int32_t kNumDriverPriorityClasses = 3;
+
+/// Returns the class named 'name' in the driver_priority_class query config.
+/// Throws if 'name' is not a class.
+DriverPriorityClass driverPriorityClassFromName(const std::string& name);
+
+std::string_view driverPriorityClassName(DriverPriorityClass priorityClass);
+
+/// An executor for running Drivers with a run queue per worker thread instead
+/// of one queue shared by all threads. Meant to be passed to QueryCtx in place
+/// of a folly::CPUThreadPoolExecutor.
+///
+/// Drivers are added to the queue of the worker that last ran them, so that a
+/// Driver keeps running on the same thread and its working set stays in the
+/// caches of that core. A Driver resumed by another Driver on a worker, e.g.
+/// by a producer filling its input, goes to the LIFO slot of that worker and
+/// runs next, while the data it was waiting for is still in the cache. A
+/// worker with an empty queue steals half of the queue of another worker.
+///
+/// Each worker has a queue per DriverPriorityClass and shares its time between
+/// the classes with queued Drivers in proportion to kPriorityClassWeights,
+/// like a weighted fair queue. A class with an empty queue does not accumulate
+/// credit for later. Drivers of a lower class yield while a Driver of a higher
+/// class is queued, see hasQueuedHigherPriority().
+///
+/// The workers are spread evenly over 'numNumaNodes' NUMA nodes. With more
+/// than one node, each worker thread is pinned to the CPUs of its node. A func
+/// added for a node runs only on the workers of that node: it is added to the
+/// queue of a worker of the node, and is stolen only by workers of the node.
+/// Funcs added without a node may be stolen by any worker, after a worker has
+/// tried to steal from the workers of its own node.
+class DriverExecutor : public folly::Executor {
+ public:
+  static constexpr int32_t kNoWorker = -1;
+
+  /// The max number of funcs a worker runs from its LIFO slot in a row before
+  /// it runs the func at the head of its queue. Keeps two Drivers resuming
+  /// each other from starving the rest of the queue.
+  static constexpr int32_t kMaxLifoRuns = 3;
+
+  /// The share of the time of a worker given to each DriverPriorityClass, in
+  /// the order of the enum values, relative to the other classes with queued
+  /// Drivers.
+  static constexpr std::array<int64_t, kNumDriverPriorityClasses>
+      kPriorityClassWeights{1, 4, 16};
+
+  /// 'numNumaNodes' is the number of NUMA nodes to spread the workers over,
+  /// e.g. memory::numNumaNodes(). Must not be more than 'numThreads'.
+  DriverExecutor(
+      int32_t numThreads,
+      const std::string& threadNamePrefix = "DriverExecutor",
+      int32_t numNumaNodes = 1);
+
+  /// Runs the queued funcs and joins the worker threads.
+  ~DriverExecutor() override;
+
+  /// Adds 'func' to the queue of the next worker in round robin order.
+  void add(folly::Func func) override {
+    add(std::move(func), kNoWorker, /*lifo=*/false);
+  }
+
+  /// Adds 'func' with the DriverPriorityClass of the folly::Executor
+  /// 'priority': kInteractive if above MID_PRI, kBatch if below.
+  void addWithPriority(folly::Func func, int8_t priority) override;
+
+  uint8_t getNumPriorities() const override {
+    return kNumDriverPriorityClasses;
+  }
+
+  /// Adds 'func' to the LIFO slot of the calling worker if 'lifo' is set and
+  /// the caller is a worker. The func previously in the LIFO slot goes to the
+  /// back of the queue of the worker. Adds 'func' to the queue of 'worker'
+  /// otherwise, or of the next worker in round robin order if 'worker' is
+  /// kNoWorker. 'priorityClass' selects the queue of the worker. If 'numaNode'
+  /// is not memory::kNoNumaNode, 'func' runs only on the workers of that node
+  /// and 'worker' and 'lifo' apply only if the worker is on that node.
+  void add(
+      folly::Func func,
+      int32_t worker,
+      bool lifo,
+      DriverPriorityClass priorityClass = DriverPriorityClass::kDefault,
+      int32_t numaNode = memory::kNoNumaNode);
+
+  /// Returns true if a func of a higher class than 'priorityClass' is queued
+  /// on any worker.
+  bool hasQueuedHigherPriority(DriverPriorityClass priorityClass) const;
+
+  /// Returns the id of the worker running on the calling thread or kNoWorker
+  /// if the calling thread is not a worker of 'this'.
+  int32_t currentWorker() const;
+
+  int32_t numThreads() const {
+    return workers_.size();
+  }
+
+  int32_t numNumaNodes() const {
+    return nodeWorkers_.size();
+  }
+
+  /// Returns the NUMA node of 'worker'.
+  int32_t numaNode(int32_t worker) const {
+    return workers_[worker]->numaNode;
+  }
+
+  /// Returns the number of workers on 'numaNode'.
+  int32_t numWorkers(int32_t numaNode) const {
+    return nodeWorkers_[numaNode].size();
+  }
+
+  struct Stats {
+    /// The number of funcs run from the LIFO slot of a worker.
+    uint64_t numLifoRuns{0};
+    /// The number of funcs run from the queue of a worker.
+    uint64_t numLocalRuns{0};
+    /// The number of times a worker took funcs from the queue of another
+    /// worker.
+    uint64_t numStolenRuns{0};
+  };
+
+  Stats stats() const;
+
+ private:
+  // A queued func and the NUMA node it must run on.
+  struct Entry {
+    folly::Func func;
+    int32_t numaNode{memory::kNoNumaNode};
+  };
+
+  struct Worker {
+    int32_t numaNode{0};
+    std::mutex mutex;
+    // A queue per DriverPriorityClass.
+    std::array<std::deque<Entry>, kNumDriverPriorityClasses> queues;
+    Entry lifo;
+    DriverPriorityClass lifoClass{DriverPriorityClass::kDefault};
+    std::thread thread;
+
+    // The time the worker ran the funcs of each class, divided by the
+    // weight of the class. Accessed only by the worker thread.
+    std::array<int64_t, kNumDriverPriorityClasses> virtualNanos{};
+
+    std::atomic_uint64_t numLifoRuns{0};
+    std::atomic_uint64_t numLocalRuns{0};
+    std::atomic_uint64_t numStolenRuns{0};
+  };
+
+  void run(int32_t worker);
+
+  // Returns the next func for 'worker' to run or an empty func if there is
+  // none and sets 'priorityClass' to its class. 'numLifoRuns' is the number of
+  // funcs run from the LIFO slot in a row.
+  folly::Func next(
+      int32_t worker,
+      int32_t& numLifoRuns,
+      DriverPriorityClass& priorityClass);
+
+  // Returns the class of the queue of 'worker' to run next, or std::nullopt if
+  // all its queues are empty. Must be called under the mutex of 'worker'.
+  std::optional<DriverPriorityClass> nextClass(Worker& worker) const;
+
+  // Moves half of the funcs 'worker' may run from the highest class queue of
+  // another worker to 'worker' and returns the first of the moved funcs. Tries
+  // the workers on the NUMA node of 'worker' first. Returns an empty func if
+  // there is none.
+  folly::Func steal(int32_t worker, DriverPriorityClass& priorityClass);
+
+  // Moves up to half of the funcs in 'queue' of another worker that 'worker'
+  // may run to 'stolen'. The first moved func is no longer pending. Must be
+  // called under the mutex of the other worker.
+  void stealFrom(
+      const Worker& worker,
+      std::deque<Entry>& queue,
+      DriverPriorityClass priorityClass,
+      std::vector<Entry>& stolen);
+
+  // Removes and returns the func at the head of 'queue' of class
+  // 'priorityClass'.
+  folly::Func popFront(
+      std::deque<Entry>& queue,
+      DriverPriorityClass priorityClass);
+
+  // Wakes up a worker waiting for funcs, if any.
+  void notify();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // The workers on each NUMA node.
+  std::vector<std::vector<int32_t>> nodeWorkers_;
+
+  // The worker to add the next func without a worker hint to.
+  std::atomic_uint32_t nextWorker_{0};
+
+  // The number of added funcs that have not been taken by a worker, in total
+  // and per DriverPriorityClass. Funcs in a LIFO slot are not counted.
+  std::atomic_int64_t numPending_{0};
+  std::array<std::atomic_int64_t, kNumDriverPriorityClasses>
+      numPendingByClass_{};
+
+  // The number of workers waiting on 'idleCv_'.
+  std::atomic_int32_t numIdle_{0};
+
+  std::mutex idleMutex_;
+  std::condition_variable idleCv_;
+  bool stopped_{false};
+};
+
+} // namespace facebook::velox::exec
@@ -15,11 +15,22 @@
  */
 #include "velox/exec/Exchange.h"
 
+#include "velox/common/time/Timer.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 
 namespace {
+// The min wall time between two reports of a driver to the pipeline
+// controller.
+constexpr uint64_t kScaleReportIntervalNanos = 100'000'000;
+
+uint64_t blockedWallNanos(const OperatorStats& stats, BlockingReason reason) {
+  const auto it = stats.runtimeStats.find(fmt::format(
+      "blocked{}WallNanos", blockingReasonToString(reason).substr(1)));
+  return it == stats.runtimeStats.end() ? 0 : it->second.sum;
+}
+
 std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
     const core::QueryConfig& queryConfig,
     VectorSerde::Kind kind) {
@@ -53,7 +64,10 @@ Exchange::Exchange(
           serdeKind_)},
       processSplits_{operatorCtx_->driverCtx()->driverId == 0},
       driverId_{driverCtx->driverId},
-      exchangeClient_{std::move(exchangeClient)} {}
+      exchangeClient_{std::move(exchangeClient)},
+      scaledController_{driverCtx->task->getScaledPipelineControllerLocked(
+          driverCtx->splitGroupId,
+          exchangeNode->id())} {}
 
 void Exchange::addRemoteTaskIds(std::vector<std::string>& remoteTaskIds) {
   std::shuffle(std::begin(remoteTaskIds), std::end(remoteTaskIds), rng_);
@@ -110,6 +124,10 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
     getSplits(&splitFuture_);
   }
 
+  if (shouldWaitForScaleUp(future)) {
+    return BlockingReason::kWaitForPipelineScaleUp;
+  }
+
   ContinueFuture dataFuture;
   currentPages_ = exchangeClient_->next(
       driverId_, preferredOutputBatchBytes_, &atEnd_, &dataFuture);
@@ -118,6 +136,10 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
       const auto numSplits = stats_.rlock()->numSplits;
       operatorCtx_->task()->multipleSplitsFinished(false, numSplits, 0);
     }
+    if (atEnd_) {
+      // The parked drivers start to see the end of the input and finish.
+      closeScaledController();
+    }
     recordExchangeClientStats();
     return BlockingReason::kNotBlocked;
   }
@@ -149,7 +171,23 @@ RowVectorPtr Exchange::getOutput() {
 
   uint64_t rawInputBytes{0};
   vector_size_t resultOffset = 0;
-  if (getSerde()->supportsAppendInDeserialize()) {
+  if (currentPages_.front()->vector() != nullptr) {
+    // In-process pages. Copy the vectors into this operator's pool so that the
+    // producer's memory is released with the pages.
+    vector_size_t numRows = 0;
+    for (const auto& page : currentPages_) {
+      numRows += page->vector()->size();
+    }
+    result_ = BaseVector::create<RowVector>(outputType_, numRows, pool());
+    for (const auto& page : currentPages_) {
+      const auto& vector = page->vector();
+      VELOX_CHECK_NOT_NULL(
+          vector, "Cannot mix in-process and serialized pages");
+      rawInputBytes += page->size();
+      result_->copy(vector.get(), resultOffset, 0, vector->size());
+      resultOffset += vector->size();
+    }
+  } else if (getSerde()->supportsAppendInDeserialize()) {
     for (const auto& page : currentPages_) {
       rawInputBytes += page->size();
 
@@ -202,12 +240,86 @@ RowVectorPtr Exchange::getOutput() {
     lockedStats->rawInputPositions += result_->size();
     lockedStats->addInputVector(result_->estimateFlatSize(), result_->size());
   }
+  numOutputRows_ += result_->size();
+  tryScale();
 
   return result_;
 }
 
+bool Exchange::shouldWaitForScaleUp(ContinueFuture* future) {
+  if (scaledController_ == nullptr) {
+    return false;
+  }
+  if (!scaledController_->shouldStop(driverId_, future)) {
+    return false;
+  }
+  // Measures the time of the driver from when it is started again.
+  lastScaleTotals_.wallNanos = 0;
+  return true;
+}
+
+void Exchange::tryScale() {
+  if (scaledController_ == nullptr) {
+    return;
+  }
+  const auto now = getCurrentTimeNano();
+  if (lastScaleTotals_.wallNanos == 0) {
+    lastScaleTotals_.wallNanos = now;
+    return;
+  }
+  if (now - lastScaleTotals_.wallNanos < kScaleReportIntervalNanos) {
+    return;
+  }
+
+  // The source waits for input in this operator and for downstream consumers
+  // in the sink of the pipeline.
+  ScaledPipelineController::DriverSignals totals;
+  for (auto* op : operatorCtx_->driver()->operators()) {
+    op->stats().withRLock([&](const auto& stats) {
+      totals.cpuNanos += stats.addInputTiming.cpuNanos +
+          stats.getOutputTiming.cpuNanos + stats.finishTiming.cpuNanos +
+          stats.isBlockedTiming.cpuNanos;
+      if (op == this) {
+        totals.inputBlockedNanos +=
+            blockedWallNanos(stats, BlockingReason::kWaitForProducer) +
+            blockedWallNanos(stats, BlockingReason::kWaitForSplit);
+      } else {
+        totals.outputBlockedNanos +=
+            blockedWallNanos(stats, BlockingReason::kWaitForConsumer);
+      }
+    });
+  }
+  totals.outputRows = numOutputRows_;
+  totals.wallNanos = now;
+
+  scaledController_->updateAndTryScale(
+      driverId_,
+      {.cpuNanos = totals.cpuNanos - lastScaleTotals_.cpuNanos,
+       .inputBlockedNanos =
+           totals.inputBlockedNanos - lastScaleTotals_.inputBlockedNanos,
+       .outputBlockedNanos =
+           totals.outputBlockedNanos - lastScaleTotals_.outputBlockedNanos,
+       .outputRows = totals.outputRows - lastScaleTotals_.outputRows,
+       .wallNanos = totals.wallNanos - lastScaleTotals_.wallNanos});
+  lastScaleTotals_ = totals;
+}
+
+void Exchange::closeScaledController() {
+  if (scaledController_ == nullptr || !scaledController_->close()) {
+    return;
+  }
+  const auto scaledStats = scaledController_->stats();
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat(
+      kPeakRunningScaleThreads,
+      RuntimeCounter(scaledStats.peakRunningDrivers));
+  lockedStats->addRuntimeStat(
+      kNumScaleDownThreads, RuntimeCounter(scaledStats.numScaleDowns));
+}
+
 void Exchange::close() {
   SourceOperator::close();
+  closeScaledController();
   currentPages_.clear();
   result_ = nullptr;
   if (exchangeClient_) {
@@ -20,6 +20,7 @@
 #include "velox/exec/ExchangeClient.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/ScaledPipelineController.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec {
@@ -56,6 +57,13 @@ class Exchange : public SourceOperator {
 
   bool isFinished() override;
 
+  /// The name of runtime stats reported by the first finished exchange of a
+  /// scaled pipeline. The max number of running drivers of the pipeline.
+  static inline const std::string kPeakRunningScaleThreads{
+      "peakRunningScaleThreads"};
+  /// The number of times the pipeline parked a driver.
+  static inline const std::string kNumScaleDownThreads{"numScaleDownThreads"};
+
  protected:
   virtual VectorSerde* getSerde();
 
@@ -78,6 +86,18 @@ class Exchange : public SourceOperator {
   // operator's stats.
   void recordExchangeClientStats();
 
+  // Returns true if the pipeline controller parked this driver and sets
+  // 'future' to the future to wait for.
+  bool shouldWaitForScaleUp(ContinueFuture* future);
+
+  // Reports the time spent by the driver to the pipeline controller, at most
+  // once per kScaleReportIntervalNanos of wall time.
+  void tryScale();
+
+  // Starts the parked drivers of the pipeline and records the controller
+  // stats if this is the first exchange to close the controller.
+  void closeScaledController();
+
   const uint64_t preferredOutputBatchBytes_;
 
   const VectorSerde::Kind serdeKind_;
@@ -94,6 +114,14 @@ class Exchange : public SourceOperator {
 
   std::shared_ptr<ExchangeClient> exchangeClient_;
 
+  // Controls the number of running drivers of the pipeline if the query
+  // enables scaled pipeline processing.
+  const std::shared_ptr<ScaledPipelineController> scaledController_;
+
+  // The totals of the driver at the last report to 'scaledController_'.
+  ScaledPipelineController::DriverSignals lastScaleTotals_;
+  uint64_t numOutputRows_{0};
+
   // A future received from Task::getSplitOrFuture(). It will be complete when
   // there are more splits available or no-more-splits signal has arrived.
   ContinueFuture splitFuture_{ContinueFuture::makeEmpty()};
@@ -15,8 +15,11 @@
  */
 #include "velox/exec/ExchangeClient.h"
 
+#include <numeric>
+
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/process/TraceEvents.h"
 
 namespace facebook::velox::exec {
 
@@ -71,7 +74,7 @@ void ExchangeClient::noMoreRemoteTasks() {
 
 void ExchangeClient::close() {
   std::vector<std::shared_ptr<ExchangeSource>> sources;
-  std::queue<ProducingSource> producingSources;
+  std::deque<ProducingSource> producingSources;
   std::queue<std::shared_ptr<ExchangeSource>> emptySources;
   {
     std::lock_guard<std::mutex> l(queue_->mutex());
@@ -110,6 +113,16 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
     }
   }
 
+  // Recent response time of each source that returned data. A large max
+  // relative to the average points to slow producers.
+  RuntimeMetric responseTime(RuntimeCounter::Unit::kNanos);
+  for (const auto& [_, estimate] : estimates_) {
+    responseTime.addValue(estimate.latencyMs * 1'000'000);
+  }
+  if (responseTime.count > 0) {
+    stats["sourceResponseWallNanos"] = responseTime;
+  }
+
   stats["peakBytes"] =
       RuntimeMetric(queue_->peakBytes(), RuntimeCounter::Unit::kBytes);
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
@@ -158,7 +171,17 @@ std::vector<std::unique_ptr<SerializedPage>> ExchangeClient::next(
 
 void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
   auto self = shared_from_this();
+  // The responses are processed on 'executor_'. They are recorded to the
+  // timeline of the requesting Task while it exists.
+  std::weak_ptr<process::TraceEventRecorder> timeline;
+  if (auto* recorder = process::currentTraceEventRecorder()) {
+    timeline = recorder->weak_from_this();
+  }
   for (auto& spec : requestSpecs) {
+    VELOX_TRACE_PROBE(exchange_request, spec.source.get(), spec.maxBytes);
+    process::addTraceEvent("exchange", "request", [&]() {
+      return fmt::format("{} bytes", spec.maxBytes);
+    });
     auto future = folly::SemiFuture<ExchangeSource::Response>::makeEmpty();
     if (spec.maxBytes == 0) {
       future = spec.source->requestDataSizes(kRequestDataSizesMaxWait);
@@ -169,9 +192,21 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
     std::move(future)
         .via(executor_)
         .thenValue(
-            [self, spec = std::move(spec), sendTimeMs = getCurrentTimeMs()](
-                ExchangeSource::Response&& response) {
+            [self,
+             spec = std::move(spec),
+             sendTimeMs = getCurrentTimeMs(),
+             timeline](ExchangeSource::Response&& response) {
               const auto requestTimeMs = getCurrentTimeMs() - sendTimeMs;
+              const auto recorder = timeline.lock();
+              process::ScopedTraceEventRecorder scopedRecorder(recorder.get());
+              VELOX_TRACE_PROBE(
+                  exchange_response, spec.source.get(), response.bytes);
+              process::addTraceEvent("exchange", "response", [&]() {
+                return fmt::format(
+                    "{} bytes{}",
+                    response.bytes,
+                    response.atEnd ? " at end" : "");
+              });
               if (spec.maxBytes == 0) {
                 RECORD_HISTOGRAM_METRIC_VALUE(
                     kMetricExchangeDataSizeTimeMs, requestTimeMs);
@@ -193,12 +228,16 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
                 if (self->closed_) {
                   return;
                 }
+                if (spec.maxBytes > 0 && response.bytes > 0) {
+                  self->updateEstimateLocked(
+                      currentSource.get(), response.bytes, requestTimeMs);
+                }
                 if (!response.atEnd) {
                   if (!response.remainingBytes.empty()) {
                     for (auto bytes : response.remainingBytes) {
                       VELOX_CHECK_GT(bytes, 0);
                     }
-                    self->producingSources_.push(
+                    self->producingSources_.push_back(
                         {std::move(spec.source),
                          std::move(response.remainingBytes)});
                   } else {
@@ -241,24 +280,43 @@ ExchangeClient::pickSourcesToRequestLocked() {
   }
   int64_t availableSpace =
       maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
-  while (availableSpace > 0 && !producingSources_.empty()) {
-    auto& source = producingSources_.front().source;
-    int64_t requestBytes = 0;
-    for (auto bytes : producingSources_.front().remainingBytes) {
-      availableSpace -= bytes;
-      if (availableSpace < 0) {
+  if (availableSpace > 0 && !producingSources_.empty()) {
+    // Give the space to the sources in proportion to their throughput, so
+    // that fast sources get large requests and slow ones do not hold the
+    // space. Every source gets at least its next page while there is space.
+    sortProducingSourcesLocked();
+    std::vector<double> throughputs;
+    throughputs.reserve(producingSources_.size());
+    for (const auto& producing : producingSources_) {
+      throughputs.push_back(producing.throughput);
+    }
+    const auto shares = requestShares(availableSpace, throughputs);
+    std::deque<ProducingSource> notRequested;
+    for (size_t i = 0; i < producingSources_.size(); ++i) {
+      auto& producing = producingSources_[i];
+      int64_t requestBytes = 0;
+      for (auto bytes : producing.remainingBytes) {
+        if (bytes > availableSpace ||
+            (requestBytes > 0 && requestBytes + bytes > shares[i])) {
+          break;
+        }
+        requestBytes += bytes;
+        availableSpace -= bytes;
+      }
+      if (requestBytes == 0) {
+        // The next page does not fit. Keep this and the slower sources for
+        // the next round instead of letting smaller pages overtake it.
+        for (size_t j = i; j < producingSources_.size(); ++j) {
+          ++producingSources_[j].numSkipped;
+          notRequested.push_back(std::move(producingSources_[j]));
+        }
         break;
       }
-      requestBytes += bytes;
-    }
-    if (requestBytes == 0) {
-      VELOX_CHECK_LT(availableSpace, 0);
-      break;
+      VELOX_CHECK(producing.source->shouldRequestLocked());
+      requestSpecs.push_back({std::move(producing.source), requestBytes});
+      totalPendingBytes_ += requestBytes;
     }
-    VELOX_CHECK(source->shouldRequestLocked());
-    requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
-    totalPendingBytes_ += requestBytes;
+    producingSources_ = std::move(notRequested);
   }
   if (queue_->totalBytes() == 0 && totalPendingBytes_ == 0 &&
       !producingSources_.empty()) {
@@ -270,12 +328,105 @@ ExchangeClient::pickSourcesToRequestLocked() {
               << " bytes, exceeding capacity " << maxQueuedBytes_;
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
+    producingSources_.pop_front();
     totalPendingBytes_ += requestBytes;
   }
   return requestSpecs;
 }
 
+// static
+std::vector<int64_t> ExchangeClient::requestShares(
+    int64_t availableBytes,
+    const std::vector<double>& throughputs) {
+  double totalThroughput = 0;
+  for (auto throughput : throughputs) {
+    VELOX_CHECK_GT(throughput, 0);
+    totalThroughput += throughput;
+  }
+  std::vector<int64_t> shares;
+  shares.reserve(throughputs.size());
+  for (auto throughput : throughputs) {
+    shares.push_back(availableBytes * (throughput / totalThroughput));
+  }
+  return shares;
+}
+
+void ExchangeClient::updateEstimateLocked(
+    const ExchangeSource* source,
+    int64_t bytes,
+    uint64_t requestTimeMs) {
+  const double throughput =
+      static_cast<double>(bytes) / std::max<uint64_t>(1, requestTimeMs);
+  auto& estimate = estimates_[source];
+  if (estimate.numResponses == 0) {
+    estimate.throughput = throughput;
+    estimate.latencyMs = requestTimeMs;
+  } else {
+    estimate.throughput += kEstimateWeight * (throughput - estimate.throughput);
+    estimate.latencyMs +=
+        kEstimateWeight * (requestTimeMs - estimate.latencyMs);
+  }
+  ++estimate.numResponses;
+}
+
+void ExchangeClient::sortProducingSourcesLocked() {
+  double knownThroughput = 0;
+  int32_t numKnown = 0;
+  for (auto& producing : producingSources_) {
+    auto it = estimates_.find(producing.source.get());
+    if (it == estimates_.end()) {
+      producing.throughput = 0;
+      continue;
+    }
+    producing.throughput = it->second.throughput;
+    knownThroughput += producing.throughput;
+    ++numKnown;
+  }
+  const double defaultThroughput =
+      numKnown == 0 ? 1 : knownThroughput / numKnown;
+  for (auto& producing : producingSources_) {
+    if (producing.throughput == 0) {
+      producing.throughput = defaultThroughput;
+    }
+  }
+  std::vector<double> throughputs;
+  std::vector<int32_t> numSkipped;
+  throughputs.reserve(producingSources_.size());
+  numSkipped.reserve(producingSources_.size());
+  for (const auto& producing : producingSources_) {
+    throughputs.push_back(producing.throughput);
+    numSkipped.push_back(producing.numSkipped);
+  }
+  std::deque<ProducingSource> sorted;
+  for (auto i : requestOrder(throughputs, numSkipped)) {
+    sorted.push_back(std::move(producingSources_[i]));
+  }
+  producingSources_ = std::move(sorted);
+}
+
+// static
+std::vector<int32_t> ExchangeClient::requestOrder(
+    const std::vector<double>& throughputs,
+    const std::vector<int32_t>& numSkipped) {
+  VELOX_CHECK_EQ(throughputs.size(), numSkipped.size());
+  std::vector<int32_t> order(throughputs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(
+      order.begin(), order.end(), [&](int32_t left, int32_t right) {
+        return throughputs[left] > throughputs[right];
+      });
+  // The source passed over the most times goes first, so that a slow source
+  // is not starved by faster ones while the space stays short.
+  auto longestWaiting = order.begin();
+  for (auto it = order.begin(); it != order.end(); ++it) {
+    if (numSkipped[*it] > numSkipped[*longestWaiting]) {
+      longestWaiting = it;
+    }
+  }
+  std::rotate(order.begin(), longestWaiting, longestWaiting + 1);
+  return order;
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
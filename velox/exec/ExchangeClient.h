@@ -101,6 +101,21 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   folly::dynamic toJson() const;
 
+  /// Splits 'availableBytes' of request budget across sources in proportion
+  /// to their estimated 'throughputs'. Returns the share of each source, in
+  /// the order of 'throughputs'.
+  static std::vector<int64_t> requestShares(
+      int64_t availableBytes,
+      const std::vector<double>& throughputs);
+
+  /// Returns the order in which to request sources with estimated
+  /// 'throughputs', as indices into 'throughputs'. Sources go fastest first,
+  /// except that the source skipped the most times, per 'numSkipped', goes
+  /// first.
+  static std::vector<int32_t> requestOrder(
+      const std::vector<double>& throughputs,
+      const std::vector<int32_t>& numSkipped);
+
  private:
   struct RequestSpec {
     std::shared_ptr<ExchangeSource> source;
@@ -113,8 +128,37 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   struct ProducingSource {
     std::shared_ptr<ExchangeSource> source;
     std::vector<int64_t> remainingBytes;
+    // Estimated throughput of 'source' in bytes per ms. Set when picking
+    // sources to request.
+    double throughput{0};
+    // Number of times 'source' was passed over for lack of space since its
+    // last request.
+    int32_t numSkipped{0};
+  };
+
+  // Recent transfer rate and response time of a source, as exponential
+  // moving averages over its data responses.
+  struct SourceEstimate {
+    double throughput{0};
+    double latencyMs{0};
+    int64_t numResponses{0};
   };
 
+  // Weight of the latest response in a SourceEstimate.
+  static constexpr double kEstimateWeight = 0.3;
+
+  // Updates the estimate of 'source' with a data response of 'bytes'
+  // received 'requestTimeMs' after the request.
+  void updateEstimateLocked(
+      const ExchangeSource* source,
+      int64_t bytes,
+      uint64_t requestTimeMs);
+
+  // Sets the throughput of 'producingSources_' from 'estimates_' and sorts
+  // them in requestOrder(). Sources with no estimate yet get the average of
+  // the known ones.
+  void sortProducingSourcesLocked();
+
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
   void request(std::vector<RequestSpec>&& requestSpecs);
@@ -134,11 +178,14 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   // Total number of bytes in flight.
   int64_t totalPendingBytes_{0};
 
-  // A queue of sources that have returned non-empty response from the latest
-  // request.
-  std::queue<ProducingSource> producingSources_;
+  // Sources that have returned non-empty response from the latest request.
+  // Requested in order of estimated throughput.
+  std::deque<ProducingSource> producingSources_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
+
+  // Estimates of the sources in 'sources_' that returned data.
+  folly::F14FastMap<const ExchangeSource*, SourceEstimate> estimates_;
 };
 
 } // namespace facebook::velox::exec
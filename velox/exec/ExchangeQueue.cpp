@@ -36,12 +36,45 @@ SerializedPage::SerializedPage(
   }
 }
 
+SerializedPage::SerializedPage(
+    RowVectorPtr vector,
+    uint64_t size,
+    std::function<void()> releaseFn)
+    : iobuf_(folly::IOBuf::create(0)),
+      iobufBytes_(size),
+      numRows_(vector->size()),
+      onDestructionCb_([releaseFn = std::move(releaseFn)](folly::IOBuf&) {}),
+      vector_(std::move(vector)) {
+  VELOX_CHECK_NOT_NULL(vector_);
+}
+
 SerializedPage::~SerializedPage() {
   if (onDestructionCb_) {
     onDestructionCb_(*iobuf_.get());
   }
 }
 
+void SerializedPage::spill(
+    WriteFile& file,
+    std::shared_ptr<ReadFile> readFile) {
+  VELOX_CHECK(canSpill());
+  spillOffset_ = file.size();
+  for (auto& range : *iobuf_) {
+    file.append(std::string_view(
+        reinterpret_cast<const char*>(range.data()), range.size()));
+  }
+  spillFile_ = std::move(readFile);
+  ranges_.clear();
+  iobuf_ = folly::IOBuf::create(0);
+}
+
+std::unique_ptr<folly::IOBuf> SerializedPage::readSpilled() const {
+  auto iobuf = folly::IOBuf::create(iobufBytes_);
+  spillFile_->pread(spillOffset_, iobufBytes_, iobuf->writableData());
+  iobuf->append(iobufBytes_);
+  return iobuf;
+}
+
 std::unique_ptr<ByteInputStream> SerializedPage::prepareStreamForDeserialize() {
   return std::make_unique<BufferInputStream>(std::move(ranges_));
 }
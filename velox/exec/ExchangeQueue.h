@@ -15,7 +15,9 @@
  */
 #pragma once
 
+#include "velox/common/file/File.h"
 #include "velox/common/memory/ByteStream.h"
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::exec {
 
@@ -29,6 +31,15 @@ class SerializedPage {
       std::function<void(folly::IOBuf&)> onDestructionCb = nullptr,
       std::optional<int64_t> numRows = std::nullopt);
 
+  /// Construct an in-process page that carries 'vector' instead of serialized
+  /// data. 'size' is the estimated serialized size of 'vector' used for flow
+  /// control. 'releaseFn' is destroyed together with the page and is used to
+  /// keep the memory backing 'vector' alive.
+  SerializedPage(
+      RowVectorPtr vector,
+      uint64_t size,
+      std::function<void()> releaseFn);
+
   ~SerializedPage();
 
   /// Returns the size of the serialized data in bytes.
@@ -44,10 +55,38 @@ class SerializedPage {
   /// VectorStreamGroup::read().
   std::unique_ptr<ByteInputStream> prepareStreamForDeserialize();
 
+  /// Returns the serialized data. An in-process page returns an empty IOBuf
+  /// as its data is in vector(). A spilled page reads its data back.
   std::unique_ptr<folly::IOBuf> getIOBuf() const {
+    if (spillFile_ != nullptr) {
+      return readSpilled();
+    }
     return iobuf_->clone();
   }
 
+  /// True if the data can be moved to disk with spill(). In-process pages and
+  /// pages whose memory is released by a destruction callback stay in memory.
+  bool canSpill() const {
+    return vector_ == nullptr && onDestructionCb_ == nullptr &&
+        spillFile_ == nullptr;
+  }
+
+  /// Appends the serialized data to 'file' and frees the memory holding it.
+  /// getIOBuf() then reads the data back from 'readFile', which must read the
+  /// data written to 'file'. Must not be called after
+  /// prepareStreamForDeserialize().
+  void spill(WriteFile& file, std::shared_ptr<ReadFile> readFile);
+
+  /// True if the data has been moved to disk with spill().
+  bool isSpilled() const {
+    return spillFile_ != nullptr;
+  }
+
+  /// Returns the vector of an in-process page, nullptr otherwise.
+  const RowVectorPtr& vector() const {
+    return vector_;
+  }
+
  private:
   static int64_t chainBytes(folly::IOBuf& iobuf) {
     int64_t size = 0;
@@ -57,13 +96,17 @@ class SerializedPage {
     return size;
   }
 
+  // Reads the data of a spilled page.
+  std::unique_ptr<folly::IOBuf> readSpilled() const;
+
   // Buffers containing the serialized data. The memory is owned by 'iobuf_'.
   std::vector<ByteRange> ranges_;
 
   // IOBuf holding the data in 'ranges_.
   std::unique_ptr<folly::IOBuf> iobuf_;
 
-  // Number of payload bytes in 'iobuf_'.
+  // Number of payload bytes in 'iobuf_', or the estimated serialized size of
+  // 'vector_' for an in-process page.
   const int64_t iobufBytes_;
 
   // Number of payload rows, if provided.
@@ -74,6 +117,14 @@ class SerializedPage {
   // from caller. Caller is responsible to pass in proper cleanup logic to
   // prevent any memory leak.
   std::function<void(folly::IOBuf&)> onDestructionCb_;
+
+  // The file holding the data at 'spillOffset_' after spill().
+  std::shared_ptr<ReadFile> spillFile_;
+  uint64_t spillOffset_{0};
+
+  // Set for an in-process page. Declared last so that it is destroyed before
+  // 'onDestructionCb_' releases the memory backing it.
+  const RowVectorPtr vector_;
 };
 
 /// Queue of results retrieved from source. Owned by shared_ptr by
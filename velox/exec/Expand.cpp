@@ -56,6 +56,7 @@ Expand::Expand(
     fieldProjections_.emplace_back(std::move(rowProjection));
     constantProjections_.emplace_back(std::move(constantProjection));
   }
+  constantColumns_.resize(numRows, std::vector<VectorPtr>(numColumns));
 }
 
 bool Expand::needsInput() const {
@@ -86,16 +87,20 @@ RowVectorPtr Expand::getOutput() {
 
   for (auto i = 0; i < numColumns; ++i) {
     if (rowProjection[i] == kConstantChannel) {
-      const auto& constantExpr = constantProjection[i];
-      if (constantExpr->value().isNull()) {
-        // Add null column.
-        outputColumns[i] = BaseVector::createNullConstant(
-            outputType_->childAt(i), numInput, pool());
-      } else {
-        // Add constant column.
-        outputColumns[i] = BaseVector::createConstant(
-            constantExpr->type(), constantExpr->value(), numInput, pool());
+      auto& constantColumn = constantColumns_[rowIndex_][i];
+      if (constantColumn == nullptr || constantColumn->size() != numInput) {
+        const auto& constantExpr = constantProjection[i];
+        if (constantExpr->value().isNull()) {
+          // Add null column.
+          constantColumn = BaseVector::createNullConstant(
+              outputType_->childAt(i), numInput, pool());
+        } else {
+          // Add constant column.
+          constantColumn = BaseVector::createConstant(
+              constantExpr->type(), constantExpr->value(), numInput, pool());
+        }
       }
+      outputColumns[i] = constantColumn;
     } else {
       outputColumns[i] = input_->childAt(rowProjection[i]);
     }
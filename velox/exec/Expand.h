@@ -41,6 +41,11 @@ class Expand : public Operator {
     return noMoreInput_ && input_ == nullptr;
   }
 
+  void close() override {
+    constantColumns_.clear();
+    Operator::close();
+  }
+
  private:
   std::vector<std::vector<column_index_t>> fieldProjections_;
 
@@ -49,5 +54,11 @@ class Expand : public Operator {
 
   // Used to indicate the index of fieldProjections_.
   int32_t rowIndex_{0};
+
+  // The constant columns of each projection, indexed by the output channel.
+  // Reused for the next input of the same size, so that the output of all
+  // projections shares the input columns and the constant columns of the
+  // previous input.
+  std::vector<std::vector<VectorPtr>> constantColumns_;
 };
 } // namespace facebook::velox::exec
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/FilterProject.h"
+#include <folly/ScopeGuard.h>
+
 #include "velox/core/Expressions.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
@@ -52,6 +54,7 @@ FilterProject::FilterProject(
           project ? project->id() : filter->id(),
           "FilterProject"),
       hasFilter_(filter != nullptr),
+      exprProfilingEnabled_(driverCtx->queryConfig().exprProfilingEnabled()),
       project_(project),
       filter_(filter) {}
 
@@ -97,6 +100,15 @@ void FilterProject::initialize() {
       }
     }
   }
+  if (exprProfilingEnabled_) {
+    profiledExprs_ = exprs_->distinctExprs();
+    profiledExprPrefixes_.reserve(profiledExprs_.size());
+    for (auto i = 0; i < profiledExprs_.size(); ++i) {
+      profiledExprPrefixes_.push_back(
+          fmt::format("expr.{}.{}.", i + 1, profiledExprs_[i]->name()));
+    }
+    reportedExprStats_.resize(profiledExprs_.size());
+  }
   filter_.reset();
   project_.reset();
 }
@@ -126,6 +138,12 @@ RowVectorPtr FilterProject::getOutput() {
     return nullptr;
   }
 
+  SCOPE_EXIT {
+    if (exprProfilingEnabled_) {
+      recordExprProfile();
+    }
+  };
+
   vector_size_t size = input_->size();
   LocalSelectivityVector localRows(*operatorCtx_->execCtx(), size);
   auto* rows = localRows.get();
@@ -181,6 +199,58 @@ std::vector<VectorPtr> FilterProject::project(
   return results;
 }
 
+void FilterProject::recordExprProfile() {
+  auto lockedStats = stats_.wlock();
+  for (auto i = 0; i < profiledExprs_.size(); ++i) {
+    const auto& stats = profiledExprs_[i]->stats();
+    auto& reported = reportedExprStats_[i];
+    const auto& prefix = profiledExprPrefixes_[i];
+    const auto report = [&](const char* name,
+                            uint64_t value,
+                            uint64_t& reportedValue,
+                            RuntimeCounter::Unit unit =
+                                RuntimeCounter::Unit::kNone) {
+      if (value > reportedValue) {
+        lockedStats->addRuntimeStat(
+            prefix + name, RuntimeCounter(value - reportedValue, unit));
+        reportedValue = value;
+      }
+    };
+    report(
+        "cpuNanos",
+        stats.timing.cpuNanos,
+        reported.timing.cpuNanos,
+        RuntimeCounter::Unit::kNanos);
+    report(
+        "wallNanos",
+        stats.timing.wallNanos,
+        reported.timing.wallNanos,
+        RuntimeCounter::Unit::kNanos);
+    report("rows", stats.numProcessedRows, reported.numProcessedRows);
+    report("batches", stats.numProcessedVectors, reported.numProcessedVectors);
+    report("flatInputs", stats.numFlatInputs, reported.numFlatInputs);
+    report(
+        "dictionaryInputs",
+        stats.numDictionaryInputs,
+        reported.numDictionaryInputs);
+    report(
+        "constantInputs", stats.numConstantInputs, reported.numConstantInputs);
+    report("peels", stats.numPeels, reported.numPeels);
+    report(
+        "memoHits",
+        stats.numDictionaryMemoHits,
+        reported.numDictionaryMemoHits);
+    report(
+        "memoMisses",
+        stats.numDictionaryMemoMisses,
+        reported.numDictionaryMemoMisses);
+    report(
+        "defaultNullSkips",
+        stats.numDefaultNullSkips,
+        reported.numDefaultNullSkips);
+  }
+}
+
 vector_size_t FilterProject::filter(
     EvalCtx& evalCtx,
     const SelectivityVector& allRows) {
@@ -53,6 +53,7 @@ class FilterProject : public Operator {
 
   void close() override {
     Operator::close();
+    profiledExprs_.clear();
     if (exprs_ != nullptr) {
       exprs_->clear();
     } else {
@@ -92,9 +93,16 @@ class FilterProject : public Operator {
       const SelectivityVector& rows,
       EvalCtx& evalCtx);
 
+  // Adds the stats of 'profiledExprs_' since the last call to the runtime
+  // stats.
+  void recordExprProfile();
+
   // If true exprs_[0] is a filter and the other expressions are projections
   const bool hasFilter_{false};
 
+  // QueryConfig::exprProfilingEnabled().
+  const bool exprProfilingEnabled_;
+
   // Cached filter and project node for lazy initialization. After
   // initialization, they will be reset, and initialized_ will be set to true.
   std::shared_ptr<const core::ProjectNode> project_;
@@ -104,6 +112,12 @@ class FilterProject : public Operator {
   std::unique_ptr<ExprSet> exprs_;
   int32_t numExprs_;
 
+  // The distinct nodes of 'exprs_', the prefixes of their runtime stats and
+  // their stats reported so far. Only set if 'exprProfilingEnabled_'.
+  std::vector<const Expr*> profiledExprs_;
+  std::vector<std::string> profiledExprPrefixes_;
+  std::vector<ExprStats> reportedExprStats_;
+
   FilterEvalCtx filterEvalCtx_;
 
   vector_size_t numProcessedInputRows_{0};
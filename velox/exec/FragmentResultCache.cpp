@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/FragmentResultCache.h"
+
+#include <folly/hash/SpookyHashV2.h>
+#include <folly/json.h>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/SsdCache.h"
+#include "velox/common/memory/ByteStream.h"
+#include "velox/expression/SimpleFunctionRegistry.h"
+#include "velox/expression/SpecialFormRegistry.h"
+#include "velox/expression/VectorFunction.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+// Returns true if 'expr' returns the same result for the same input. Calls of
+// unknown functions are not deterministic.
+bool isDeterministic(const core::TypedExprPtr& expr) {
+  if (auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr)) {
+    const auto& name = call->name();
+    if (!isFunctionCallToSpecialFormRegistered(name)) {
+      const auto simpleEntries =
+          simpleFunctions().getFunctionSignaturesAndMetadata(name);
+      const auto metadata = getVectorFunctionMetadata(name);
+      if (simpleEntries.empty() && !metadata.has_value()) {
+        return false;
+      }
+      for (const auto& [simpleMetadata, _] : simpleEntries) {
+        if (!simpleMetadata.deterministic) {
+          return false;
+        }
+      }
+      if (metadata.has_value() && !metadata->deterministic) {
+        return false;
+      }
+    }
+  } else if (
+      auto lambda =
+          std::dynamic_pointer_cast<const core::LambdaTypedExpr>(expr)) {
+    return isDeterministic(lambda->body());
+  }
+  for (const auto& input : expr->inputs()) {
+    if (!isDeterministic(input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Removes the plan node ids from serialized plan node 'obj' and its sources so
+// that equal plans made by different queries have the same fingerprint.
+void removePlanNodeIds(folly::dynamic& obj) {
+  if (obj.isObject()) {
+    obj.erase("id");
+    for (auto& item : obj.items()) {
+      removePlanNodeIds(item.second);
+    }
+  } else if (obj.isArray()) {
+    for (auto& item : obj) {
+      removePlanNodeIds(item);
+    }
+  }
+}
+
+std::string hashToString(std::string_view data) {
+  uint64_t hash1{0};
+  uint64_t hash2{0};
+  folly::hash::SpookyHashV2::Hash128(data.data(), data.size(), &hash1, &hash2);
+  return fmt::format("{:016x}{:016x}", hash1, hash2);
+}
+
+// Returns the first 'entry->size()' bytes of the memory of 'entry'.
+std::vector<folly::Range<char*>> entryRanges(
+    cache::AsyncDataCacheEntry* entry) {
+  const uint64_t size = entry->size();
+  if (entry->tinyData() != nullptr) {
+    return {folly::Range<char*>(entry->tinyData(), size)};
+  }
+  std::vector<folly::Range<char*>> ranges;
+  const auto& allocation = entry->data();
+  ranges.reserve(allocation.numRuns());
+  uint64_t offset{0};
+  for (auto i = 0; i < allocation.numRuns() && offset < size; ++i) {
+    const auto run = allocation.runAt(i);
+    const uint64_t bytes = std::min<uint64_t>(
+        run.numPages() * memory::AllocationTraits::kPageSize, size - offset);
+    ranges.emplace_back(run.data<char>(), bytes);
+    offset += bytes;
+  }
+  return ranges;
+}
+
+// Returns a pin on a new entry of 'size' bytes for 'key', or on the existing
+// entry, or an empty pin if the entry is being written or the cache has no
+// space.
+cache::CachePin findOrCreateEntry(
+    cache::AsyncDataCache& cache,
+    cache::RawFileCacheKey key,
+    uint64_t size) {
+  try {
+    return cache.findOrCreate(key, size);
+  } catch (const VeloxException& e) {
+    if (e.errorCode() != error_code::kNoCacheSpace.c_str()) {
+      throw;
+    }
+    return {};
+  }
+}
+
+// Returns a shared pin on the entry for 'key', loading it from SSD if it is
+// there and not in memory. Returns an empty pin if there is no entry or the
+// entry is being written.
+cache::CachePin findEntry(
+    cache::AsyncDataCache& cache,
+    cache::RawFileCacheKey key) {
+  uint64_t size{1};
+  cache::SsdPin ssdPin;
+  auto* ssdCache = cache.ssdCache();
+  if (!cache.exists(key)) {
+    if (ssdCache == nullptr) {
+      return {};
+    }
+    ssdPin = ssdCache->file(key.fileNum).find(key);
+    if (ssdPin.empty()) {
+      return {};
+    }
+    size = ssdPin.run().size();
+  }
+
+  auto pin = findOrCreateEntry(cache, key, size);
+  if (pin.empty() || !pin.entry()->isExclusive()) {
+    return pin;
+  }
+  if (ssdPin.empty()) {
+    // The entry was evicted since exists(). Releasing the new exclusive entry
+    // removes it.
+    return {};
+  }
+  auto& file = ssdCache->file(key.fileNum);
+  std::vector<cache::SsdPin> ssdPins;
+  ssdPins.push_back(std::move(ssdPin));
+  std::vector<cache::CachePin> pins;
+  pins.push_back(std::move(pin));
+  try {
+    file.load(ssdPins, pins);
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "IOERR: Failed to load fragment result from SSD: "
+               << e.what();
+    file.erase(key);
+    return {};
+  }
+  pin = std::move(pins[0]);
+  pin.entry()->setExclusiveToShared();
+  return pin;
+}
+} // namespace
+
+// static
+std::optional<FragmentResultCache::Fragment> FragmentResultCache::makeFragment(
+    const std::vector<core::PlanNodePtr>& planNodes) {
+  if (planNodes.size() < 2) {
+    return std::nullopt;
+  }
+  auto scanNode =
+      std::dynamic_pointer_cast<const core::TableScanNode>(planNodes[0]);
+  if (scanNode == nullptr) {
+    return std::nullopt;
+  }
+
+  size_t i = 1;
+  for (; i < planNodes.size(); ++i) {
+    if (auto filterNode =
+            std::dynamic_pointer_cast<const core::FilterNode>(planNodes[i])) {
+      if (!isDeterministic(filterNode->filter())) {
+        return std::nullopt;
+      }
+    } else if (
+        auto projectNode =
+            std::dynamic_pointer_cast<const core::ProjectNode>(planNodes[i])) {
+      for (const auto& projection : projectNode->projections()) {
+        if (!isDeterministic(projection)) {
+          return std::nullopt;
+        }
+      }
+    } else {
+      break;
+    }
+  }
+  if (i == planNodes.size()) {
+    return std::nullopt;
+  }
+
+  // The results of a split are the groups flushed at the end of the split,
+  // which requires grouping keys and non-distinct aggregates.
+  auto aggregationNode =
+      std::dynamic_pointer_cast<const core::AggregationNode>(planNodes[i]);
+  if (aggregationNode == nullptr ||
+      aggregationNode->step() != core::AggregationNode::Step::kPartial ||
+      aggregationNode->groupingKeys().empty() ||
+      aggregationNode->aggregates().empty() ||
+      aggregationNode->isPreGrouped() ||
+      !aggregationNode->globalGroupingSets().empty()) {
+    return std::nullopt;
+  }
+
+  folly::dynamic obj;
+  try {
+    obj = aggregationNode->serialize();
+  } catch (const VeloxException&) {
+    // The connector does not support serializing its table handle.
+    return std::nullopt;
+  }
+  removePlanNodeIds(obj);
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  return Fragment{
+      hashToString(folly::json::serialize(obj, opts)),
+      scanNode->id(),
+      aggregationNode->id(),
+      aggregationNode->outputType()};
+}
+
+FragmentResultCache::Lookup FragmentResultCache::startSplit(
+    const connector::ConnectorSplit& split,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK(!hasPending());
+  splitKey_.reset();
+  clearResults();
+
+  auto* cache = cache::AsyncDataCache::getInstance();
+  if (disabled_ || cache == nullptr) {
+    return Lookup::kNotCacheable;
+  }
+  const auto splitKey = split.cacheKey();
+  if (!splitKey.has_value()) {
+    // The aggregation may hold groups of this split until it flushes at the
+    // end of a later split that misses the cache, so the results of no later
+    // split are known to come from that split alone.
+    disabled_ = true;
+    return Lookup::kNotCacheable;
+  }
+
+  auto key = fmt::format(
+      "fragment result {}",
+      hashToString(fmt::format("{}/{}", fragment_.fingerprint, *splitKey)));
+  StringIdLease fileNum(fileIds(), key);
+  auto pin = findEntry(*cache, {fileNum.id(), 0});
+  if (pin.empty()) {
+    splitKey_ = std::move(key);
+    return Lookup::kMiss;
+  }
+
+  std::vector<ByteRange> ranges;
+  for (const auto& range : entryRanges(pin.checkedEntry())) {
+    ranges.push_back(ByteRange{
+        reinterpret_cast<uint8_t*>(range.data()),
+        static_cast<int32_t>(range.size()),
+        0});
+  }
+  BufferInputStream input(std::move(ranges));
+  const auto numRows = input.read<int64_t>();
+  auto* serde = getNamedVectorSerde(VectorSerde::Kind::kPresto);
+  int64_t numReadRows{0};
+  while (!input.atEnd()) {
+    RowVectorPtr result;
+    VectorStreamGroup::read(
+        &input, pool, fragment_.outputType, serde, &result, nullptr);
+    numReadRows += result->size();
+    cachedResults_.push_back(std::move(result));
+  }
+  VELOX_CHECK_EQ(numReadRows, numRows, "Corrupt fragment result {}", key);
+  return Lookup::kHit;
+}
+
+void FragmentResultCache::finishSplit() {
+  VELOX_CHECK(!flushRequested_);
+  if (splitKey_.has_value()) {
+    flushRequested_ = true;
+  }
+}
+
+void FragmentResultCache::disable() {
+  disabled_ = true;
+  splitKey_.reset();
+  clearResults();
+}
+
+RowVectorPtr FragmentResultCache::nextCachedResult() {
+  if (cachedResults_.empty()) {
+    return nullptr;
+  }
+  auto result = std::move(cachedResults_.front());
+  cachedResults_.pop_front();
+  return result;
+}
+
+void FragmentResultCache::addResult(
+    const RowVectorPtr& result,
+    memory::MemoryPool* pool) {
+  if (!splitKey_.has_value() || result->size() == 0) {
+    return;
+  }
+  VectorStreamGroup group(
+      pool, getNamedVectorSerde(VectorSerde::Kind::kPresto));
+  group.createStreamTree(asRowType(result->type()), result->size());
+  group.append(result);
+  IOBufOutputStream out(
+      *pool, nullptr, std::max<int64_t>(1 << 16, group.size()));
+  group.flush(&out);
+  auto iobuf = out.getIOBuf();
+  if (results_ == nullptr) {
+    results_ = std::move(iobuf);
+  } else {
+    results_->prependChain(std::move(iobuf));
+  }
+  numResultRows_ += result->size();
+  if (results_->computeChainDataLength() > kMaxResultBytes) {
+    splitKey_.reset();
+    clearResults();
+  }
+}
+
+void FragmentResultCache::finishFlush() {
+  VELOX_CHECK(flushRequested_);
+  flushRequested_ = false;
+  if (!splitKey_.has_value()) {
+    return;
+  }
+  const auto key = std::move(splitKey_.value());
+  splitKey_.reset();
+  auto* cache = cache::AsyncDataCache::getInstance();
+  if (cache == nullptr) {
+    clearResults();
+    return;
+  }
+
+  // The value is the number of rows followed by the serialized results.
+  auto value = folly::IOBuf::copyBuffer(&numResultRows_, sizeof(int64_t));
+  if (results_ != nullptr) {
+    value->prependChain(std::move(results_));
+  }
+  clearResults();
+
+  StringIdLease fileNum(fileIds(), key);
+  auto pin = findOrCreateEntry(
+      *cache, {fileNum.id(), 0}, value->computeChainDataLength());
+  if (pin.empty() || !pin.entry()->isExclusive()) {
+    // Another Driver is storing or has stored the same results.
+    return;
+  }
+
+  auto* entry = pin.checkedEntry();
+  auto ranges = entryRanges(entry);
+  size_t rangeIndex{0};
+  size_t offset{0};
+  for (const auto buffer : *value) {
+    auto* source = reinterpret_cast<const char*>(buffer.data());
+    size_t remaining = buffer.size();
+    while (remaining > 0) {
+      auto& range = ranges[rangeIndex];
+      const auto bytes = std::min(remaining, range.size() - offset);
+      std::memcpy(range.data() + offset, source, bytes);
+      source += bytes;
+      remaining -= bytes;
+      offset += bytes;
+      if (offset == range.size()) {
+        ++rangeIndex;
+        offset = 0;
+      }
+    }
+  }
+  entry->setExclusiveToShared(/*ssdSavable=*/true);
+}
+
+void FragmentResultCache::clearResults() {
+  results_.reset();
+  numResultRows_ = 0;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <deque>
+#include <optional>
+
+#include <folly/io/IOBuf.h>
+
+#include "velox/connectors/Connector.h"
+#include "velox/core/PlanNode.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Caches the partial aggregation results of each split of a pipeline fragment
+/// made of a TableScan, Filter and Project nodes with deterministic
+/// expressions and a partial aggregation with grouping keys. The results are
+/// stored serialized in the AsyncDataCache, from which they may be saved to
+/// and loaded from its SsdCache. They are keyed on a fingerprint of the plan
+/// nodes of the fragment and on ConnectorSplit::cacheKey(), which includes the
+/// file modification time, so that a repeated query over unchanged splits gets
+/// the partial aggregation results without reading the splits.
+///
+/// An instance is shared by the TableScan and the HashAggregation of one
+/// Driver. The TableScan looks up each split with startSplit(). On a hit, it
+/// skips the split and the HashAggregation outputs the cached results. On a
+/// miss, the TableScan reads the split and calls finishSplit() at its end. The
+/// HashAggregation then flushes its groups, which all come from the split, and
+/// stores everything it produced since the start of the split. The TableScan
+/// does not start the next split while hasPending() is true. A split that
+/// cannot be cached stops caching for the rest of the Driver, since the
+/// aggregation does not flush its groups at the end of such a split.
+class FragmentResultCache {
+ public:
+  /// The max size of the serialized results of a split. Larger results are
+  /// not cached.
+  static constexpr uint64_t kMaxResultBytes = 16 << 20;
+
+  /// The plan nodes of a cacheable fragment.
+  struct Fragment {
+    /// Hash of the serialized partial aggregation node and its sources,
+    /// without the plan node ids.
+    std::string fingerprint;
+    core::PlanNodeId scanNodeId;
+    core::PlanNodeId aggregationNodeId;
+    RowTypePtr outputType;
+  };
+
+  /// Returns the fragment at the start of 'planNodes', the plan nodes of a
+  /// pipeline, or std::nullopt if the pipeline does not start with a
+  /// cacheable fragment.
+  static std::optional<Fragment> makeFragment(
+      const std::vector<core::PlanNodePtr>& planNodes);
+
+  explicit FragmentResultCache(Fragment fragment)
+      : fragment_(std::move(fragment)) {}
+
+  const core::PlanNodeId& scanNodeId() const {
+    return fragment_.scanNodeId;
+  }
+
+  const core::PlanNodeId& aggregationNodeId() const {
+    return fragment_.aggregationNodeId;
+  }
+
+  enum class Lookup {
+    /// The results of the split are not cached, e.g. the split has no cache
+    /// key, an earlier split had none or there is no AsyncDataCache.
+    kNotCacheable,
+    /// The results of the split are cached and queued for the aggregation.
+    kHit,
+    /// The results of the split are stored after finishSplit().
+    kMiss,
+  };
+
+  /// Invoked by the TableScan before reading 'split'. On a hit, deserializes
+  /// the cached results to 'pool' and the TableScan skips the split.
+  Lookup startSplit(
+      const connector::ConnectorSplit& split,
+      memory::MemoryPool* pool);
+
+  /// Invoked by the TableScan when it has produced all the rows of a split
+  /// that missed the cache.
+  void finishSplit();
+
+  /// Invoked by the TableScan when its output starts to depend on more than
+  /// its splits, e.g. on a dynamic filter. Stops caching.
+  void disable();
+
+  /// Returns true if the aggregation has cached results to output or has to
+  /// flush the results of a split before it gets more input.
+  bool hasPending() const {
+    return flushRequested_ || !cachedResults_.empty();
+  }
+
+  /// Returns the next cached result to output by the aggregation, or nullptr
+  /// if there is none.
+  RowVectorPtr nextCachedResult();
+
+  /// True if the aggregation must flush its groups to complete the results
+  /// of a split.
+  bool flushRequested() const {
+    return flushRequested_;
+  }
+
+  /// Invoked by the aggregation for each of its outputs. Adds 'result' to the
+  /// results of the split being read, if any. 'pool' is used for serializing.
+  void addResult(const RowVectorPtr& result, memory::MemoryPool* pool);
+
+  /// Invoked by the aggregation once it has flushed its groups after
+  /// flushRequested(). Stores the results of the split.
+  void finishFlush();
+
+ private:
+  // Drops the results of the split being read.
+  void clearResults();
+
+  const Fragment fragment_;
+
+  bool disabled_{false};
+
+  // The key of the split being read whose results are stored, if any.
+  std::optional<std::string> splitKey_;
+
+  // The serialized results of the split being read and their number of rows.
+  std::unique_ptr<folly::IOBuf> results_;
+  int64_t numResultRows_{0};
+
+  bool flushRequested_{false};
+
+  // The cached results of the last looked up split.
+  std::deque<RowVectorPtr> cachedResults_;
+};
+
+} // namespace facebook::velox::exec
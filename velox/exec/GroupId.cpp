@@ -62,6 +62,9 @@ GroupId::GroupId(
     const auto& input = aggregationInputs[i];
     aggregationInputs_.push_back(inputType->getChildIdx(input->name()));
   }
+
+  constantColumns_.resize(
+      groupingKeyMappings_.size(), std::vector<VectorPtr>(outputType_->size()));
 }
 
 bool GroupId::needsInput() const {
@@ -90,12 +93,17 @@ RowVectorPtr GroupId::getOutput() {
   const auto& mapping = groupingKeyMappings_[groupingSetIndex_];
   auto numGroupingKeys = mapping.size();
 
+  auto& constantColumns = constantColumns_[groupingSetIndex_];
   // Fill in grouping keys.
   for (auto i = 0; i < numGroupingKeys; ++i) {
     if (mapping[i] == kMissingGroupingKey) {
       // Add null column.
-      outputColumns[i] = BaseVector::createNullConstant(
-          outputType_->childAt(i), numInput, pool());
+      auto& nullColumn = constantColumns[i];
+      if (nullColumn == nullptr || nullColumn->size() != numInput) {
+        nullColumn = BaseVector::createNullConstant(
+            outputType_->childAt(i), numInput, pool());
+      }
+      outputColumns[i] = nullColumn;
     } else {
       outputColumns[i] = input_->childAt(mapping[i]);
     }
@@ -107,9 +115,12 @@ RowVectorPtr GroupId::getOutput() {
   }
 
   // Add groupId column.
-  outputColumns[outputType_->size() - 1] =
-      std::make_shared<ConstantVector<int64_t>>(
-          pool(), numInput, false, BIGINT(), groupingSetIndex_);
+  auto& groupIdColumn = constantColumns.back();
+  if (groupIdColumn == nullptr || groupIdColumn->size() != numInput) {
+    groupIdColumn = std::make_shared<ConstantVector<int64_t>>(
+        pool(), numInput, false, BIGINT(), groupingSetIndex_);
+  }
+  outputColumns[outputType_->size() - 1] = groupIdColumn;
 
   ++groupingSetIndex_;
   if (groupingSetIndex_ == groupingKeyMappings_.size()) {
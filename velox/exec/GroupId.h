@@ -40,6 +40,11 @@ class GroupId : public Operator {
     return finished_ || (noMoreInput_ && input_ == nullptr);
   }
 
+  void close() override {
+    constantColumns_.clear();
+    Operator::close();
+  }
+
  private:
   static constexpr column_index_t kMissingGroupingKey =
       std::numeric_limits<column_index_t>::max();
@@ -64,5 +69,11 @@ class GroupId : public Operator {
   /// and lookup the input-to-output column mappings in the
   /// groupingKeyMappings_.
   int32_t groupingSetIndex_{0};
+
+  /// The null grouping key and groupId columns of each grouping set, indexed by
+  /// the output channel. Reused for the next input of the same size, so that
+  /// the output of all grouping sets shares the input columns and the constant
+  /// columns of the previous input.
+  std::vector<std::vector<VectorPtr>> constantColumns_;
 };
 } // namespace facebook::velox::exec
@@ -68,6 +68,7 @@ GroupingSet::GroupingSet(
       globalGroupingSets_(globalGroupingSets),
       groupIdChannel_(groupIdChannel),
       spillConfig_(spillConfig),
+      driverCtx_(operatorCtx->driverCtx()),
       nonReclaimableSection_(nonReclaimableSection),
       stringAllocator_(operatorCtx->pool()),
       rows_(operatorCtx->pool()),
@@ -111,6 +112,20 @@ GroupingSet::GroupingSet(
         "Partial aggregations over sorted inputs are not supported");
   }
 
+  // Single step aggregations over raw input may let functions reference the
+  // input rather than copy it. Sorted and distinct aggregations pass their own
+  // vectors to the functions and are excluded.
+  const auto retentionMaxBytes =
+      queryConfig_.aggregationInputRetentionMaxBytes();
+  if (retentionMaxBytes > 0 && isRawInput_ && !isPartial_) {
+    for (auto& aggregate : aggregates_) {
+      if (aggregate.sortingKeys.empty() && !aggregate.distinct &&
+          aggregate.function->supportsInputRetention()) {
+        aggregate.function->enableInputRetention(retentionMaxBytes);
+      }
+    }
+  }
+
   for (auto& aggregate : aggregates_) {
     if (aggregate.distinct) {
       VELOX_USER_CHECK(
@@ -125,33 +140,14 @@ GroupingSet::GroupingSet(
 }
 
 GroupingSet::~GroupingSet() {
+  if (nextMerge_ != nullptr) {
+    nextMerge_->close();
+  }
   if (isGlobal_) {
     destroyGlobalAggregations();
   }
 }
 
-std::unique_ptr<GroupingSet> GroupingSet::createForMarkDistinct(
-    const RowTypePtr& inputType,
-    std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-    OperatorCtx* operatorCtx,
-    tsan_atomic<bool>* nonReclaimableSection) {
-  return std::make_unique<GroupingSet>(
-      inputType,
-      std::move(hashers),
-      /*preGroupedKeys=*/std::vector<column_index_t>{},
-      /*groupingKeyOutputProjections=*/std::vector<column_index_t>{},
-      /*aggregates=*/std::vector<AggregateInfo>{},
-      /*ignoreNullKeys=*/false,
-      /*isPartial=*/false,
-      /*isRawInput=*/false,
-      /*globalGroupingSets=*/std::vector<vector_size_t>{},
-      /*groupIdColumn=*/std::nullopt,
-      /*spillConfig=*/nullptr,
-      nonReclaimableSection,
-      operatorCtx,
-      /*spillStats=*/nullptr);
-};
-
 namespace {
 bool equalKeys(
     const std::vector<column_index_t>& keys,
@@ -260,6 +256,7 @@ void GroupingSet::addInputForActiveRows(
 
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
+  const bool columnar = prepareColumnarInput();
 
   for (auto i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
@@ -296,7 +293,18 @@ void GroupingSet::addInputForActiveRows(
     const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
         mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
     if (isRawInput_) {
-      function->addRawInput(groups, rows, tempVectors_, canPushdown);
+      if (columnar && !canPushdown && &rows == &activeRows_ &&
+          function->supportsColumnarAccumulators()) {
+        function->addRawInputColumnar(
+            groups,
+            lookup_->hashes.data(),
+            table_->capacity(),
+            columnarFirstRows_,
+            rows,
+            tempVectors_);
+      } else {
+        function->addRawInput(groups, rows, tempVectors_, canPushdown);
+      }
     } else {
       function->addIntermediateResults(groups, rows, tempVectors_, canPushdown);
     }
@@ -311,6 +319,31 @@ void GroupingSet::addInputForActiveRows(
   }
 }
 
+bool GroupingSet::prepareColumnarInput() {
+  if (!isRawInput_ || table_->hashMode() != BaseHashTable::HashMode::kArray ||
+      table_->capacity() > kMaxColumnarSlots) {
+    return false;
+  }
+  // In kArray mode the hash of a row is the index of its group in the table.
+  const auto* slots = lookup_->hashes.data();
+  columnarSlotSeen_.resize(table_->capacity());
+  columnarFirstRows_.clear();
+  for (auto row : lookup_->rows) {
+    const auto slot = slots[row];
+    if (!columnarSlotSeen_[slot]) {
+      columnarSlotSeen_[slot] = true;
+      columnarFirstRows_.push_back(row);
+    }
+  }
+  for (auto row : columnarFirstRows_) {
+    columnarSlotSeen_[slots[row]] = false;
+  }
+  // Each group is gathered and scattered once per aggregate, which pays off
+  // only if the groups repeat within the batch.
+  return static_cast<int32_t>(columnarFirstRows_.size()) * 2 <=
+      lookup_->rows.size();
+}
+
 void GroupingSet::addRemainingInput() {
   activeRows_.resize(remainingInput_->size());
   activeRows_.clearAll();
@@ -380,6 +413,18 @@ void GroupingSet::createHashTable() {
         std::move(hashers_), accumulators(false), &pool_);
   }
 
+  if (expectedNumGroups_ > 0) {
+    table_->setExpectedNumDistinct(expectedNumGroups_);
+  }
+  table_->setIncrementalRehashMinEntries(
+      queryConfig_.aggregationIncrementalRehashMinEntries());
+  if (queryConfig_.aggregationWideNormalizedKeysEnabled()) {
+    table_->enableWideNormalizedKeys();
+  }
+  if (queryConfig_.aggregationBigintIdMapEnabled()) {
+    table_->enableBigintIdMap();
+  }
+
   RowContainer& rows = *table_->rows();
   initializeAggregates(aggregates_, rows, false);
 
@@ -1126,16 +1171,48 @@ bool GroupingSet::getOutputWithSpill(
 bool GroupingSet::prepareNextSpillPartitionOutput() {
   VELOX_CHECK_EQ(merge_ == nullptr, outputSpillPartition_ == -1);
   merge_ = nullptr;
-  if (spillPartitionSet_.empty()) {
-    return false;
+  if (nextMerge_ == nullptr) {
+    if (spillPartitionSet_.empty()) {
+      return false;
+    }
+    scheduleNextSpillPartitionMerge();
+  }
+  VELOX_CHECK_NE(outputSpillPartition_, nextMergeSpillPartition_);
+  outputSpillPartition_ = nextMergeSpillPartition_;
+  merge_ = nextMerge_->move();
+  nextMerge_ = nullptr;
+  VELOX_CHECK_NOT_NULL(merge_);
+
+  if (spillConfig_->executor != nullptr && !spillPartitionSet_.empty()) {
+    scheduleNextSpillPartitionMerge();
+    spillConfig_->executor->add(
+        [driverCtx = driverCtx_, source = nextMerge_]() {
+          ScopedDriverThreadContext scopedDriverThreadContext(driverCtx);
+          source->prepare();
+        });
   }
+  return true;
+}
+
+void GroupingSet::scheduleNextSpillPartitionMerge() {
+  VELOX_CHECK_NULL(nextMerge_);
+  VELOX_CHECK(!spillPartitionSet_.empty());
   auto it = spillPartitionSet_.begin();
-  VELOX_CHECK_NE(outputSpillPartition_, it->first.partitionNumber());
-  outputSpillPartition_ = it->first.partitionNumber();
-  merge_ = it->second->createOrderedReader(
-      spillConfig_->readBufferSize, &pool_, spillStats_);
+  nextMergeSpillPartition_ = it->first.partitionNumber();
+  std::shared_ptr<SpillPartition> partition = std::move(it->second);
   spillPartitionSet_.erase(it);
-  return true;
+  nextMerge_ = std::make_shared<AsyncSource<TreeOfLosers<SpillMergeStream>>>(
+      [partition = std::move(partition),
+       spillConfig = spillConfig_,
+       pool = &pool_,
+       spillStats = spillStats_]() {
+        return partition->createOrderedReader(
+            spillConfig->readBufferSize,
+            pool,
+            spillStats,
+            spillConfig->executor,
+            spillConfig->numReadAheadBuffers);
+      });
 }
 
 bool GroupingSet::mergeNext(
@@ -1348,7 +1425,26 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   }
 }
 
+void GroupingSet::setExpectedNumGroups(uint64_t numGroups) {
+  expectedNumGroups_ = numGroups;
+  if (table_ != nullptr) {
+    table_->setExpectedNumDistinct(numGroups);
+  }
+}
+
+void GroupingSet::enableStreamingOnGroupingKeys() {
+  VELOX_CHECK(isPartial_);
+  VELOX_CHECK(!isGlobal_);
+  VELOX_CHECK(preGroupedKeyChannels_.empty());
+  VELOX_CHECK_NULL(remainingInput_);
+  preGroupedKeyChannels_ = keyChannels_;
+}
+
 void GroupingSet::abandonPartialAggregation() {
+  // The partial aggregation can be abandoned before any input is added.
+  if (table_ == nullptr) {
+    createHashTable();
+  }
   abandonedPartialAggregation_ = true;
   allSupportToIntermediate_ = true;
   for (auto& aggregate : aggregates_) {
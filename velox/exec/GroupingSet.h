@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/AggregateInfo.h"
 #include "velox/exec/AggregationMasks.h"
 #include "velox/exec/DistinctAggregations.h"
@@ -48,13 +49,6 @@ class GroupingSet {
 
   ~GroupingSet();
 
-  /// Used by MarkDistinct operator to identify rows with unique values.
-  static std::unique_ptr<GroupingSet> createForMarkDistinct(
-      const RowTypePtr& inputType,
-      std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-      OperatorCtx* operatorCtx,
-      tsan_atomic<bool>* nonReclaimableSection);
-
   void addInput(const RowVectorPtr& input, bool mayPushdown);
 
   void noMoreInput();
@@ -132,6 +126,18 @@ class GroupingSet {
     return table_ ? table_->rows()->numRows() : 0;
   }
 
+  /// Sets the number of groups the hash table is expected to hold so that it
+  /// is allocated at that size up front instead of growing by rehashing.
+  void setExpectedNumGroups(uint64_t numGroups);
+
+  /// Treats the input as clustered on all the grouping keys from now on: the
+  /// groups in the hash table are produced as output as soon as a new group
+  /// starts. Used by partial aggregation that has found its input clustered
+  /// at runtime. Since the input is not guaranteed to stay clustered, this is
+  /// only allowed for partial aggregation which may output the same group
+  /// more than once.
+  void enableStreamingOnGroupingKeys();
+
   /// Frees hash tables and other state when giving up partial aggregation as
   /// non-productive. Must be called before toIntermediate() is used.
   void abandonPartialAggregation();
@@ -163,6 +169,13 @@ class GroupingSet {
 
   void addRemainingInput();
 
+  // Sets 'columnarFirstRows_' to one row of 'lookup_' for each group hit by
+  // the input. Returns true if the aggregates that support it should add raw
+  // input with Aggregate::addRawInputColumnar(). This is the case if 'table_'
+  // is in kArray mode with at most kMaxColumnarSlots slots and the input has
+  // at least two rows per group.
+  bool prepareColumnarInput();
+
   void initializeGlobalAggregation();
 
   void destroyGlobalAggregations();
@@ -228,9 +241,15 @@ class GroupingSet {
   // Prepares for the next spill partition for output. It sets
   // 'outputSpillPartition_' to the number of the next spill partition, and
   // creates 'merge_' to read from it. The function returns false if all the
-  // spilled partitions have been processed.
+  // spilled partitions have been processed. If the spill executor is set,
+  // the ordered reader of the partition after the returned one is opened in
+  // the background while the current partition is being merged.
   bool prepareNextSpillPartitionOutput();
 
+  // Removes the first partition from 'spillPartitionSet_' and sets
+  // 'nextMerge_' to a source that creates the ordered reader for it.
+  void scheduleNextSpillPartitionMerge();
+
   // Reads from spilled rows until producing a batch of final results in
   // 'result'. Returns false and leaves 'result' empty when the spilled data is
   // fully read. 'maxOutputRows' and 'maxOutputBytes' specify the max number of
@@ -284,7 +303,7 @@ class GroupingSet {
   std::vector<column_index_t> keyChannels_;
 
   // A subset of grouping keys on which the input is clustered.
-  const std::vector<column_index_t> preGroupedKeyChannels_;
+  std::vector<column_index_t> preGroupedKeyChannels_;
 
   // Provides the column projections for extracting the grouping keys from
   // 'table_' for output. The vector index is the output channel and the value
@@ -313,6 +332,8 @@ class GroupingSet {
 
   const common::SpillConfig* const spillConfig_;
 
+  const DriverCtx* const driverCtx_;
+
   // Indicates if this grouping set and the associated hash aggregation operator
   // is under non-reclaimable execution section or not.
   tsan_atomic<bool>* const nonReclaimableSection_;
@@ -326,9 +347,22 @@ class GroupingSet {
   // Place for the arguments of the aggregate being updated.
   std::vector<VectorPtr> tempVectors_;
   std::unique_ptr<BaseHashTable> table_;
+  // Expected number of groups passed to 'table_' when it is created.
+  uint64_t expectedNumGroups_{0};
   std::unique_ptr<HashLookup> lookup_;
   SelectivityVector activeRows_;
 
+  // Largest kArray table for which aggregates keep their accumulators in
+  // dense arrays indexed by slot while adding input.
+  static constexpr uint64_t kMaxColumnarSlots = 16 << 10;
+
+  // One row of 'lookup_' for each slot of 'table_' hit by the input, see
+  // prepareColumnarInput().
+  std::vector<vector_size_t> columnarFirstRows_;
+  // Marks the slots found while filling 'columnarFirstRows_'. All false
+  // between batches.
+  std::vector<bool> columnarSlotSeen_;
+
   // Used to allocate memory for a single row accumulating results of global
   // aggregation
   HashStringAllocator stringAllocator_;
@@ -371,6 +405,14 @@ class GroupingSet {
   std::vector<size_t> numDistinctSpillFilesPerPartition_;
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 
+  // The spill partition whose ordered reader is produced by 'nextMerge_'.
+  int32_t nextMergeSpillPartition_{-1};
+
+  // Opens the spill files of the next spill partition to merge. Prepared on
+  // the spill executor, if any, while 'merge_' is being consumed so that the
+  // reads of the first batches of the next partition overlap with merging.
+  std::shared_ptr<AsyncSource<TreeOfLosers<SpillMergeStream>>> nextMerge_;
+
   // Container for materializing batches of output from spilling.
   std::unique_ptr<RowContainer> mergeRows_;
 
@@ -15,12 +15,18 @@
  */
 #include "velox/exec/HashAggregation.h"
 
+#include <folly/hash/Hash.h>
 #include <optional>
 #include "velox/exec/PrefixSort.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
 namespace facebook::velox::exec {
+namespace {
+// Index bits of the sketch used to estimate the number of groups. The standard
+// error of the estimate is 1.04 / sqrt(2^11), i.e. about 2.3%.
+constexpr int8_t kCardinalitySketchIndexBits = 11;
+} // namespace
 
 HashAggregation::HashAggregation(
     int32_t operatorId,
@@ -47,8 +53,25 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      cardinalitySampleRows_(
+          isPartialOutput_ && !isGlobal_
+              ? driverCtx->queryConfig()
+                    .partialAggregationCardinalitySampleRows()
+              : 0),
+      clusteredInputCheckBatches_(
+          isPartialOutput_ && !isGlobal_ && !isDistinct_ &&
+                  aggregationNode->preGroupedKeys().empty()
+              ? driverCtx->queryConfig()
+                    .partialAggregationClusteredInputCheckBatches()
+              : 0),
       maxPartialAggregationMemoryUsage_(
-          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
+          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()),
+      fragmentResultCache_(
+          driverCtx->fragmentResultCache != nullptr &&
+                  driverCtx->fragmentResultCache->aggregationNodeId() ==
+                      aggregationNode->id()
+              ? driverCtx->fragmentResultCache
+              : nullptr) {}
 
 void HashAggregation::initialize() {
   Operator::initialize();
@@ -64,6 +87,13 @@ void HashAggregation::initialize() {
   auto hashers = createVectorHashers(inputType, groupingKeyInputChannels);
   const auto numHashers = hashers.size();
 
+  if (cardinalitySampleRows_ > 0) {
+    sampleHashers_ = createVectorHashers(inputType, groupingKeyInputChannels);
+    sampleAllocator_ = std::make_unique<HashStringAllocator>(pool());
+    sampleHll_ = std::make_unique<common::hll::DenseHll>(
+        kCardinalitySketchIndexBits, sampleAllocator_.get());
+  }
+
   std::vector<column_index_t> preGroupedChannels;
   preGroupedChannels.reserve(aggregationNode_->preGroupedKeys().size());
   for (const auto& key : aggregationNode_->preGroupedKeys()) {
@@ -75,6 +105,59 @@ void HashAggregation::initialize() {
   std::vector<AggregateInfo> aggregateInfos = toAggregateInfo(
       *aggregationNode_, *operatorCtx_, numHashers, expressionEvaluator);
 
+  const bool twoLevelDistinct =
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .twoLevelDistinctAggregationEnabled() &&
+      aggregationNode_->supportsTwoLevelDistinct();
+  if (twoLevelDistinct) {
+    // De-duplicate on the grouping keys and the distinct inputs first. The
+    // aggregates then see each distinct input once per group and run as
+    // non-distinct over 'distinctType_'.
+    distinctChannels_ = groupingKeyInputChannels;
+    for (const auto& arg : aggregationNode_->aggregates()[0].call->inputs()) {
+      if (auto field = core::TypedExprs::asFieldAccess(arg)) {
+        distinctChannels_.push_back(inputType->getChildIdx(field->name()));
+      }
+    }
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (auto i = 0; i < distinctChannels_.size(); ++i) {
+      names.push_back(fmt::format("c{}", i));
+      types.push_back(inputType->childAt(distinctChannels_[i]));
+    }
+    distinctType_ = ROW(std::move(names), std::move(types));
+
+    distinctGroupingSet_ = std::make_unique<GroupingSet>(
+        inputType,
+        createVectorHashers(inputType, distinctChannels_),
+        /*preGroupedKeys=*/std::vector<column_index_t>{},
+        /*groupingKeyOutputProjections=*/std::vector<column_index_t>{},
+        /*aggregates=*/std::vector<AggregateInfo>{},
+        /*ignoreNullKeys=*/false,
+        /*isPartial=*/false,
+        /*isRawInput=*/false,
+        /*globalGroupingSets=*/std::vector<vector_size_t>{},
+        /*groupIdColumn=*/std::nullopt,
+        spillConfig_.has_value() ? &spillConfig_.value() : nullptr,
+        &nonReclaimableSection_,
+        operatorCtx_.get(),
+        &spillStats_);
+
+    std::vector<column_index_t> keyChannels(numHashers);
+    std::iota(keyChannels.begin(), keyChannels.end(), 0);
+    hashers = createVectorHashers(distinctType_, keyChannels);
+    for (auto& info : aggregateInfos) {
+      auto channel = numHashers;
+      for (auto& input : info.inputs) {
+        if (input != kConstantChannel) {
+          input = channel++;
+        }
+      }
+      info.distinct = false;
+    }
+  }
+
   // Check that aggregate result type match the output type.
   for (auto i = 0; i < aggregateInfos.size(); i++) {
     const auto& aggResultType = aggregateInfos[i].function->resultType();
@@ -100,7 +183,7 @@ void HashAggregation::initialize() {
   }
 
   groupingSet_ = std::make_unique<GroupingSet>(
-      inputType,
+      twoLevelDistinct ? distinctType_ : inputType,
       std::move(hashers),
       std::move(preGroupedChannels),
       std::move(groupingKeyOutputChannels),
@@ -172,18 +255,82 @@ bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
       100 * numOutput / numInputRows_ >= abandonPartialAggregationMinPct_;
 }
 
+void HashAggregation::abandonPartialAggregation() {
+  groupingSet_->abandonPartialAggregation();
+  pool()->release();
+  addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
+  abandonedPartialAggregation_ = true;
+}
+
+bool HashAggregation::sampleGroupCardinality(const RowVectorPtr& input) {
+  VELOX_CHECK_NOT_NULL(sampleHll_);
+  const auto numRows = std::min<int64_t>(
+      input->size(), cardinalitySampleRows_ - numSampledRows_);
+  sampleRows_.resize(numRows);
+  sampleRows_.setAll();
+  sampleHashes_.resize(numRows);
+  for (auto i = 0; i < sampleHashers_.size(); ++i) {
+    auto& hasher = sampleHashers_[i];
+    hasher->decode(
+        *input->childAt(hasher->channel())->loadedVector(), sampleRows_);
+    hasher->hash(sampleRows_, i > 0, sampleHashes_);
+  }
+  for (auto i = 0; i < numRows; ++i) {
+    // The sketch takes its bucket index from the high bits, which are not
+    // well mixed in the hashes of small integers.
+    sampleHll_->insertHash(folly::hash::twang_mix64(sampleHashes_[i]));
+  }
+  numSampledRows_ += numRows;
+  if (numSampledRows_ < cardinalitySampleRows_) {
+    return false;
+  }
+
+  const auto numGroups =
+      std::min<int64_t>(sampleHll_->cardinality(), numSampledRows_);
+  sampleHll_.reset();
+  sampleAllocator_.reset();
+  sampleHashers_.clear();
+  addRuntimeStat("estimatedNumGroups", RuntimeCounter(numGroups));
+
+  if (100 * numGroups < abandonPartialAggregationMinPct_ * numSampledRows_) {
+    // Size the table for the estimate up front unless it would not fit in
+    // the partial aggregation memory limit anyway.
+    if (2 * numGroups * sizeof(char*) < maxPartialAggregationMemoryUsage_) {
+      groupingSet_->setExpectedNumGroups(numGroups);
+    }
+    return false;
+  }
+  if (numInputRows_ > 0) {
+    // Some input is already in the hash table. Flush it first.
+    highCardinalityEstimate_ = true;
+    return false;
+  }
+  abandonPartialAggregation();
+  return true;
+}
+
 void HashAggregation::addInput(RowVectorPtr input) {
   if (!pushdownChecked_) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
     pushdownChecked_ = true;
   }
-  if (abandonedPartialAggregation_) {
+  if (distinctGroupingSet_ != nullptr) {
+    addTwoLevelDistinctInput(input);
+    numInputRows_ += input->size();
+    updateRuntimeStats();
+    return;
+  }
+  if (abandonedPartialAggregation_ ||
+      (sampleHll_ != nullptr && sampleGroupCardinality(input))) {
     input_ = input;
     numInputRows_ += input->size();
     return;
   }
   groupingSet_->addInput(input, mayPushdown_);
   numInputRows_ += input->size();
+  if (clusteredInputCheckBatches_ > 0) {
+    checkClusteredInput();
+  }
 
   updateRuntimeStats();
 
@@ -191,7 +338,8 @@ void HashAggregation::addInput(RowVectorPtr input) {
   // aggregation as the final aggregator will handle it the same way as the
   // partial aggregator. Hence, we have to use more memory anyway.
   const bool abandonPartialEarly = isPartialOutput_ && !isGlobal_ &&
-      abandonPartialAggregationEarly(groupingSet_->numDistinct());
+      (highCardinalityEstimate_ ||
+       abandonPartialAggregationEarly(groupingSet_->numDistinct()));
   if (isPartialOutput_ && !isGlobal_ &&
       (abandonPartialEarly ||
        groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_))) {
@@ -214,6 +362,99 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+void HashAggregation::addTwoLevelDistinctInput(const RowVectorPtr& input) {
+  distinctGroupingSet_->addInput(input, /*mayPushdown=*/false);
+  if (distinctGroupingSet_->hasSpilled()) {
+    return;
+  }
+  const auto& newGroups = distinctGroupingSet_->hashLookup().newGroups;
+  if (newGroups.empty()) {
+    return;
+  }
+  const auto size = newGroups.size();
+  BufferPtr indices = allocateIndices(size, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  std::copy(newGroups.begin(), newGroups.end(), rawIndices);
+  std::vector<VectorPtr> children;
+  children.reserve(distinctChannels_.size());
+  for (auto channel : distinctChannels_) {
+    children.push_back(BaseVector::wrapInDictionary(
+        nullptr,
+        indices,
+        size,
+        BaseVector::loadedVectorShared(input->childAt(channel))));
+  }
+  groupingSet_->addInput(
+      std::make_shared<RowVector>(
+          pool(), distinctType_, nullptr, size, std::move(children)),
+      /*mayPushdown=*/false);
+  if (distinctGroupingSet_->hasSpilled()) {
+    // 'distinctGroupingSet_' was spilled while 'groupingSet_' reserved memory
+    // for the rows above. They come back with the rest of the spilled unique
+    // rows after all the input is seen.
+    groupingSet_->resetTable(/*freeTable=*/true);
+  }
+}
+
+void HashAggregation::finishTwoLevelDistinctInput() {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK(distinctGroupingSet_->hasSpilled());
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  const auto maxOutputRows = outputBatchRows();
+  RowContainerIterator iterator;
+  for (;;) {
+    // The aggregates may retain the input, so each batch gets new vectors.
+    auto rows = std::static_pointer_cast<RowVector>(
+        BaseVector::create(distinctType_, maxOutputRows, pool()));
+    if (!distinctGroupingSet_->getOutput(
+            maxOutputRows,
+            queryConfig.preferredOutputBatchBytes(),
+            iterator,
+            rows)) {
+      break;
+    }
+    groupingSet_->addInput(rows, /*mayPushdown=*/false);
+  }
+  distinctGroupingSet_.reset();
+  updateEstimatedOutputRowSize();
+  groupingSet_->noMoreInput();
+  pool()->release();
+}
+
+void HashAggregation::checkClusteredInput() {
+  const auto& lookup = groupingSet_->hashLookup();
+  size_t numRuns{0};
+  char* lastGroup{nullptr};
+  for (auto row : lookup.rows) {
+    if (lookup.hits[row] != lastGroup) {
+      lastGroup = lookup.hits[row];
+      ++numRuns;
+    }
+  }
+  // In clustered input, every run of rows starts a new group, except for the
+  // first run which may continue the last group of the previous input.
+  size_t expectedRuns = lookup.newGroups.size();
+  if (!lookup.rows.empty()) {
+    const auto firstRow = lookup.rows[0];
+    if (lookup.hits[firstRow] == lastClusteredGroup_ &&
+        std::find(
+            lookup.newGroups.begin(), lookup.newGroups.end(), firstRow) ==
+            lookup.newGroups.end()) {
+      ++expectedRuns;
+    }
+  }
+  lastClusteredGroup_ = lastGroup;
+  if (numRuns != expectedRuns) {
+    clusteredInputCheckBatches_ = 0;
+    return;
+  }
+  if (--clusteredInputCheckBatches_ > 0) {
+    return;
+  }
+  groupingSet_->enableStreamingOnGroupingKeys();
+  addRuntimeStat("streamingOnGroupingKeys", RuntimeCounter(1));
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
@@ -286,14 +527,12 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
   VELOX_DCHECK(isPartialOutput_);
   // If size is at max and there still is not enough reduction, abandon partial
   // aggregation.
-  if (abandonPartialAggregationEarly(numOutputRows_) ||
+  if (highCardinalityEstimate_ ||
+      abandonPartialAggregationEarly(numOutputRows_) ||
       (aggregationPct > kPartialMinFinalPct &&
        maxPartialAggregationMemoryUsage_ >=
            maxExtendedPartialAggregationMemoryUsage_)) {
-    groupingSet_->abandonPartialAggregation();
-    pool()->release();
-    addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
-    abandonedPartialAggregation_ = true;
+    abandonPartialAggregation();
     return;
   }
   const int64_t extendedPartialAggregationMemoryUsage = std::min(
@@ -318,6 +557,25 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
 }
 
 RowVectorPtr HashAggregation::getOutput() {
+  if (fragmentResultCache_ == nullptr) {
+    return getAggregationOutput();
+  }
+  if (auto cachedResult = fragmentResultCache_->nextCachedResult()) {
+    return cachedResult;
+  }
+  if (fragmentResultCache_->flushRequested()) {
+    flushSplit_ = true;
+  }
+  auto output = getAggregationOutput();
+  if (output != nullptr) {
+    fragmentResultCache_->addResult(output, pool());
+  } else if (fragmentResultCache_->flushRequested() && !flushSplit_) {
+    fragmentResultCache_->finishFlush();
+  }
+  return output;
+}
+
+RowVectorPtr HashAggregation::getAggregationOutput() {
   if (finished_) {
     input_ = nullptr;
     return nullptr;
@@ -327,6 +585,8 @@ RowVectorPtr HashAggregation::getOutput() {
       finished_ = true;
     }
     if (!input_) {
+      // The input is passed through, so the results of a split are complete.
+      flushSplit_ = false;
       return nullptr;
     }
     prepareOutput(input_->size());
@@ -341,7 +601,7 @@ RowVectorPtr HashAggregation::getOutput() {
   // - partial aggregation reached memory limit;
   // - distinct aggregation has new keys;
   // - running in partial streaming mode and have some output ready.
-  if (!noMoreInput_ && !partialFull_ && !newDistincts_ &&
+  if (!noMoreInput_ && !partialFull_ && !flushSplit_ && !newDistincts_ &&
       !groupingSet_->hasOutput()) {
     input_ = nullptr;
     return nullptr;
@@ -351,6 +611,10 @@ RowVectorPtr HashAggregation::getOutput() {
     return getDistinctOutput();
   }
 
+  if (distinctGroupingSet_ != nullptr) {
+    finishTwoLevelDistinctInput();
+  }
+
   const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
   const auto maxOutputRows =
       isGlobal_ ? 1 : outputBatchRows(estimatedOutputRowSize_);
@@ -368,6 +632,12 @@ RowVectorPtr HashAggregation::getOutput() {
       finished_ = true;
     }
     resetPartialOutputIfNeed();
+    if (flushSplit_) {
+      groupingSet_->resetTable(/*freeTable=*/false);
+      flushSplit_ = false;
+      numOutputRows_ = 0;
+      numInputRows_ = 0;
+    }
     return nullptr;
   }
   numOutputRows_ += output_->size();
@@ -435,7 +705,17 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
 
 void HashAggregation::noMoreInput() {
   updateEstimatedOutputRowSize();
-  groupingSet_->noMoreInput();
+  if (distinctGroupingSet_ == nullptr) {
+    groupingSet_->noMoreInput();
+  } else if (distinctGroupingSet_->hasSpilled()) {
+    // 'groupingSet_' gets the rest of the unique rows from the spilled data
+    // when the output is first requested.
+    distinctGroupingSet_->noMoreInput();
+  } else {
+    // All the unique rows have been added to 'groupingSet_'.
+    distinctGroupingSet_.reset();
+    groupingSet_->noMoreInput();
+  }
   Operator::noMoreInput();
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
@@ -457,6 +737,28 @@ void HashAggregation::reclaim(
 
   updateEstimatedOutputRowSize();
 
+  if (distinctGroupingSet_ != nullptr) {
+    // Both grouping sets take input until 'distinctGroupingSet_' has seen all
+    // the input. From then on, only 'groupingSet_' does.
+    if (!noMoreInput_) {
+      distinctGroupingSet_->spill();
+      VELOX_CHECK_EQ(distinctGroupingSet_->numRows(), 0);
+    }
+    if (!noMoreInput_ && distinctGroupingSet_->hasSpilled()) {
+      // All the unique rows are read back from the spilled
+      // 'distinctGroupingSet_' after all the input is seen, including the
+      // ones already added to 'groupingSet_'. Drop these instead of spilling
+      // them so that each unique row is aggregated once.
+      groupingSet_->resetTable(/*freeTable=*/true);
+    } else {
+      groupingSet_->spill();
+    }
+    VELOX_CHECK_EQ(groupingSet_->numRows(), 0);
+    VELOX_CHECK_EQ(groupingSet_->numDistinct(), 0);
+    pool()->release();
+    return;
+  }
+
   if (noMoreInput_) {
     if (groupingSet_->hasSpilled()) {
       LOG(WARNING)
@@ -492,6 +794,9 @@ void HashAggregation::close() {
   Operator::close();
 
   output_ = nullptr;
+  sampleHll_.reset();
+  sampleAllocator_.reset();
+  distinctGroupingSet_.reset();
   groupingSet_.reset();
 }
 
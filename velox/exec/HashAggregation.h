@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/hyperloglog/DenseHll.h"
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
 
@@ -34,7 +35,9 @@ class HashAggregation : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_ && !partialFull_;
+    return !noMoreInput_ && !partialFull_ &&
+        (fragmentResultCache_ == nullptr ||
+         !fragmentResultCache_->hasPending());
   }
 
   void noMoreInput() override;
@@ -70,8 +73,38 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Gives up on partial aggregation and passes the input through as
+  // intermediate results from now on.
+  void abandonPartialAggregation();
+
+  // Adds the grouping keys of the leading rows of 'input' to the cardinality
+  // sketch until 'cardinalitySampleRows_' rows have been sampled, then acts
+  // on the estimated number of groups. Returns true if partial aggregation
+  // has been abandoned before 'input' was added to the hash table.
+  bool sampleGroupCardinality(const RowVectorPtr& input);
+
+  // Checks if the last input added to 'groupingSet_' is clustered on the
+  // grouping keys, i.e. each of its groups forms a single run of rows. Once
+  // 'clusteredInputCheckBatches_' consecutive inputs are, switches the
+  // grouping set to streaming on the grouping keys.
+  void checkClusteredInput();
+
+  // Returns the next output of the aggregation, ignoring
+  // 'fragmentResultCache_'.
+  RowVectorPtr getAggregationOutput();
+
   RowVectorPtr getDistinctOutput();
 
+  // Adds 'input' to 'distinctGroupingSet_' and the rows that are new there to
+  // 'groupingSet_'. Once 'distinctGroupingSet_' has spilled, the unique rows
+  // are only known after all the input is seen, and 'groupingSet_' is kept
+  // empty until then.
+  void addTwoLevelDistinctInput(const RowVectorPtr& input);
+
+  // Adds all the unique rows of the spilled 'distinctGroupingSet_' to
+  // 'groupingSet_' and ends the input of 'groupingSet_'.
+  void finishTwoLevelDistinctInput();
+
   // Setups the projections for accessing grouping keys stored in grouping
   // set.
   // For 'groupingKeyInputChannels', the index is the key column index from
@@ -96,20 +129,59 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // Number of leading input rows sketched to estimate the number of groups.
+  // 0 if the estimate is disabled.
+  const int32_t cardinalitySampleRows_;
+  // Number of remaining input batches to check for being clustered on the
+  // grouping keys. 0 if the check is disabled or has completed.
+  int32_t clusteredInputCheckBatches_;
+  // Group of the last row of the previous input checked for being clustered.
+  char* lastClusteredGroup_{nullptr};
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
 
+  // Set if the distinct aggregates are computed in two levels. Holds the
+  // unique combinations of the grouping keys and the distinct inputs. The
+  // rows new here are aggregated by 'groupingSet_' as non-distinct input.
+  // Reset once all its unique rows are added to 'groupingSet_'.
+  std::unique_ptr<GroupingSet> distinctGroupingSet_;
+  // Input channels of the columns of 'distinctType_'.
+  std::vector<column_index_t> distinctChannels_;
+  // The grouping keys in the order of 'groupingSet_' followed by the distinct
+  // inputs. The input type of 'groupingSet_' with two level distinct.
+  RowTypePtr distinctType_;
+
   // Size of a single output row estimated using
   // 'groupingSet_->estimateRowSize()'. If spilling, this value is set to max
   // 'groupingSet_->estimateRowSize()' across all accumulated data set.
   std::optional<int64_t> estimatedOutputRowSize_;
 
+  // If set, caches the results of each split of the TableScan of the driver.
+  // Shared with the TableScan.
+  const std::shared_ptr<FragmentResultCache> fragmentResultCache_;
+
   bool partialFull_ = false;
+  // True if the groups of the last split are being flushed to complete its
+  // results in 'fragmentResultCache_'.
+  bool flushSplit_ = false;
   bool newDistincts_ = false;
   bool finished_ = false;
   // True if partial aggregation has been found to be non-reducing.
   bool abandonedPartialAggregation_{false};
+  // True if the cardinality estimate found the input nearly unique after
+  // some of it had already been added to the hash table. Partial aggregation
+  // is then abandoned on the next flush.
+  bool highCardinalityEstimate_{false};
+
+  // Hashers for the grouping keys, allocator and sketch used to estimate the
+  // number of groups. Released once the estimate is made.
+  std::vector<std::unique_ptr<VectorHasher>> sampleHashers_;
+  std::unique_ptr<HashStringAllocator> sampleAllocator_;
+  std::unique_ptr<common::hll::DenseHll> sampleHll_;
+  SelectivityVector sampleRows_;
+  raw_vector<uint64_t> sampleHashes_;
+  int64_t numSampledRows_{0};
 
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
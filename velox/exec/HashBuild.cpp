@@ -26,6 +26,10 @@ using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
 namespace {
+// The number of rows of 'table_' handed over at a time after the join sides
+// are swapped.
+constexpr int32_t kSwapBatchRows = 1'024;
+
 // Map HashBuild 'state' to the corresponding driver blocking reason.
 BlockingReason fromStateToBlockingReason(HashBuild::State state) {
   switch (state) {
@@ -55,7 +59,9 @@ HashBuild::HashBuild(
           operatorId,
           joinNode->id(),
           "HashBuild",
-          joinNode->canSpill(driverCtx->queryConfig())
+          joinNode->canSpill(driverCtx->queryConfig()) &&
+                  hashTableCacheKey(*joinNode, driverCtx->queryConfig())
+                      .empty()
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       joinNode_(std::move(joinNode)),
@@ -65,7 +71,9 @@ HashBuild::HashBuild(
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
-      keyChannelMap_(joinNode_->rightKeys().size()) {
+      cacheKey_(hashTableCacheKey(*joinNode_, driverCtx->queryConfig())),
+      keyChannelMap_(joinNode_->rightKeys().size()),
+      canSwap_(canSwapJoinSides(joinNode_, driverCtx->queryConfig())) {
   VELOX_CHECK(pool()->trackUsage());
   VELOX_CHECK_NOT_NULL(joinBridge_);
 
@@ -101,6 +109,13 @@ HashBuild::HashBuild(
     }
   }
 
+  if (!cacheKey_.empty()) {
+    cachedTable_ = joinBridge_->cachedHashTable(cacheKey_);
+    if (!cachedTable_.has_value()) {
+      cachePool_ = joinBridge_->cachedHashTablePool(cacheKey_);
+    }
+  }
+
   tableType_ = hashJoinTableType(joinNode_);
   setupTable();
   setupSpiller();
@@ -126,6 +141,9 @@ void HashBuild::setupTable() {
         VectorHasher::create(tableType_->childAt(i), keyChannels_[i]));
   }
 
+  // A table to cache is built in the pool of the cache.
+  auto* tablePool = cachePool_ != nullptr ? cachePool_.get() : pool();
+
   const auto numDependents = tableType_->size() - numKeys;
   std::vector<TypePtr> dependentTypes;
   dependentTypes.reserve(numDependents);
@@ -143,7 +161,7 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        tablePool);
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -163,7 +181,7 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool);
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -174,9 +192,13 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool);
     }
   }
+  table_->setRadixPartitionTargetBytes(
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .hashJoinRadixPartitionTargetBytes());
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
@@ -302,6 +324,11 @@ void HashBuild::removeInputRowsForAntiJoinFilter() {
 
 void HashBuild::addInput(RowVectorPtr input) {
   checkRunning();
+  if (canSwap_ &&
+      (swapped_ || joinBridge_->addSwapBuildRows(input->size()))) {
+    addSwapInput(input);
+    return;
+  }
   ensureInputFits(input);
 
   TestValue::adjust("facebook::velox::exec::HashBuild::addInput", this);
@@ -414,6 +441,48 @@ void HashBuild::addInput(RowVectorPtr input) {
   });
 }
 
+void HashBuild::addSwapInput(const RowVectorPtr& input) {
+  swapped_ = true;
+  std::vector<VectorPtr> columns;
+  columns.reserve(tableType_->size());
+  for (const auto channel : keyChannels_) {
+    columns.push_back(BaseVector::loadedVectorShared(input->childAt(channel)));
+  }
+  for (const auto channel : dependentChannels_) {
+    columns.push_back(BaseVector::loadedVectorShared(input->childAt(channel)));
+  }
+  joinBridge_->addSwapBuildInput(
+      std::make_shared<RowVector>(
+          pool(), tableType_, nullptr, input->size(), std::move(columns)),
+      &swapFuture_);
+  handOverSwapRows();
+}
+
+void HashBuild::handOverSwapRows() {
+  VELOX_CHECK(swapped_);
+  auto* rows = table_->rows();
+  std::vector<char*> batch(kSwapBatchRows);
+  while (!swapRowsHandedOver_ && !swapFuture_.valid()) {
+    const auto numRows =
+        rows->listRows(&swapRowsIter_, kSwapBatchRows, batch.data());
+    if (numRows == 0) {
+      swapRowsHandedOver_ = true;
+      table_->clear(true);
+      break;
+    }
+    auto input = BaseVector::create<RowVector>(tableType_, numRows, pool());
+    for (auto i = 0; i < tableType_->size(); ++i) {
+      rows->extractColumn(batch.data(), numRows, i, input->childAt(i));
+    }
+    joinBridge_->addSwapBuildInput(std::move(input), &swapFuture_);
+  }
+  if (swapRowsHandedOver_ && noMoreInput_) {
+    joinBridge_->swapBuildInputFinished();
+    swapFuture_ = ContinueFuture::makeEmpty();
+    setState(State::kFinish);
+  }
+}
+
 void HashBuild::ensureInputFits(RowVectorPtr& input) {
   // NOTE: we don't need memory reservation if all the partitions are spilling
   // as we spill all the input rows to disk directly.
@@ -623,6 +692,11 @@ void HashBuild::noMoreInput() {
   }
   Operator::noMoreInput();
 
+  if (canSwap_ && (swapped_ || joinBridge_->swapBuildFinishing())) {
+    swapped_ = true;
+    handOverSwapRows();
+    return;
+  }
   noMoreInputInternal();
 }
 
@@ -665,6 +739,14 @@ bool HashBuild::finishHashBuild() {
     }
   };
 
+  if (cachedTable_.has_value()) {
+    stats_.wlock()->addRuntimeStat(
+        HashTableCache::kCacheHits, RuntimeCounter(1));
+    joinBridge_->setHashTable(
+        cachedTable_->table, {}, cachedTable_->hasNullKeys, nullptr);
+    return true;
+  }
+
   if (joinHasNullKeys_ && isAntiJoin(joinType_) && nullAware_ &&
       !joinNode_->filter()) {
     joinBridge_->setAntiJoinHasNullKeys();
@@ -756,6 +838,16 @@ bool HashBuild::finishHashBuild() {
       BaseHashTable::kBuildWallNanos,
       RuntimeCounter(timing.wallNanos, RuntimeCounter::Unit::kNanos));
 
+  // Bloom filters are only used for dynamic filtering of probe input, which is
+  // not done with spilling.
+  const auto bloomFilterMaxBytes = operatorCtx_->driverCtx()
+                                       ->queryConfig()
+                                       .hashJoinBloomFilterMaxBytes();
+  if (bloomFilterMaxBytes > 0 && canPushdownJoinKeyFilters(joinNode_) &&
+      spillPartitions.empty() && !isInputFromSpill()) {
+    table_->buildJoinKeyBloomFilters(bloomFilterMaxBytes);
+  }
+
   addRuntimeStats();
 
   // Setup spill function for spilling hash table directly from hash join
@@ -772,6 +864,14 @@ bool HashBuild::finishHashBuild() {
           table, hashBitRange, joinNode, spillConfig, spillStats);
     };
   }
+  if (!cacheKey_.empty()) {
+    VELOX_CHECK(spillPartitions.empty());
+    auto entry = HashTableCache::getInstance()->put(
+        cacheKey_, cachePool_, std::move(table_), joinHasNullKeys_);
+    joinBridge_->setHashTable(
+        std::move(entry.table), {}, entry.hasNullKeys, nullptr);
+    return true;
+  }
   joinBridge_->setHashTable(
       std::move(table_),
       std::move(spillPartitions),
@@ -915,6 +1015,9 @@ void HashBuild::addRuntimeStats() {
       RuntimeMetric(hashTableStats.numRehashes);
   lockedStats->runtimeStats[BaseHashTable::kNumDistinct] =
       RuntimeMetric(hashTableStats.numDistinct);
+  if (table_->usesJoinBitmap()) {
+    lockedStats->runtimeStats[BaseHashTable::kJoinBitmap] = RuntimeMetric(1);
+  }
   if (hashTableStats.numTombstones != 0) {
     lockedStats->runtimeStats[BaseHashTable::kNumTombstones] =
         RuntimeMetric(hashTableStats.numTombstones);
@@ -930,9 +1033,23 @@ void HashBuild::addRuntimeStats() {
 }
 
 BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
+  if (swapped_ && isRunning()) {
+    if (!swapFuture_.valid()) {
+      handOverSwapRows();
+    }
+    if (swapFuture_.valid()) {
+      *future = std::move(swapFuture_);
+      return BlockingReason::kWaitForConsumer;
+    }
+    return BlockingReason::kNotBlocked;
+  }
+
   switch (state_) {
     case State::kRunning:
-      if (isInputFromSpill()) {
+      if (cachedTable_.has_value() && !noMoreInput_) {
+        // The table is cached. Finishes without reading the build side.
+        noMoreInput();
+      } else if (isInputFromSpill()) {
         processSpillInput();
       }
       break;
@@ -196,6 +196,15 @@ class HashBuild final : public Operator {
 
   void addRuntimeStats();
 
+  // Invoked after the join sides are swapped to hand over 'input' to the
+  // HashProbe operators instead of adding it to the table.
+  void addSwapInput(const RowVectorPtr& input);
+
+  // Hands over the rows added to 'table_' before the join sides are swapped
+  // to the HashProbe operators until enough input is queued for them. Finishes
+  // the operator when all the rows and input are handed over.
+  void handOverSwapRows();
+
   // Indicates if this hash build operator is under non-reclaimable state or
   // not.
   bool nonReclaimableState() const;
@@ -215,6 +224,15 @@ class HashBuild final : public Operator {
 
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
+  // The key of the table in HashTableCache. Empty if the table is not shared.
+  const std::string cacheKey_;
+
+  // The cached table if 'cacheKey_' hits. The build side input is not read.
+  std::optional<HashTableCache::Entry> cachedTable_;
+
+  // The pool to build the table to cache in if 'cacheKey_' misses.
+  std::shared_ptr<memory::MemoryPool> cachePool_;
+
   tsan_atomic<bool> exceededMaxSpillLevelLimit_{false};
 
   State state_{State::kRunning};
@@ -303,6 +321,21 @@ class HashBuild final : public Operator {
 
   // Maps key channel in 'input_' to channel in key.
   folly::F14FastMap<column_index_t, column_index_t> keyChannelMap_;
+
+  // True if the build and probe sides of the join can be swapped at runtime.
+  const bool canSwap_;
+
+  // Set if the join sides are swapped. The operator then hands over its input
+  // to the HashProbe operators through 'joinBridge_'.
+  bool swapped_{false};
+
+  // Iterates over the rows of 'table_' to hand over after the swap.
+  RowContainerIterator swapRowsIter_;
+  bool swapRowsHandedOver_{false};
+
+  // Set if enough input is queued for the HashProbe operators of the swapped
+  // join.
+  ContinueFuture swapFuture_{ContinueFuture::makeEmpty()};
 };
 
 inline std::ostream& operator<<(std::ostream& os, HashBuild::State state) {
@@ -208,7 +208,7 @@ SpillPartitionSet spillHashJoinTable(
 }
 
 void HashJoinBridge::setHashTable(
-    std::unique_ptr<BaseHashTable> table,
+    std::shared_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
     bool hasNullKeys,
     HashJoinTableSpillFunc&& tableSpillFunc) {
@@ -236,6 +236,29 @@ void HashJoinBridge::setHashTable(
   notify(std::move(promises));
 }
 
+std::optional<HashTableCache::Entry> HashJoinBridge::cachedHashTable(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!cacheLookedUp_) {
+    cacheLookedUp_ = true;
+    auto* cache = HashTableCache::getInstance();
+    VELOX_CHECK_NOT_NULL(cache);
+    cachedTable_ = cache->get(key);
+  }
+  return cachedTable_;
+}
+
+std::shared_ptr<memory::MemoryPool> HashJoinBridge::cachedHashTablePool(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cachedTablePool_ == nullptr) {
+    auto* cache = HashTableCache::getInstance();
+    VELOX_CHECK_NOT_NULL(cache);
+    cachedTablePool_ = cache->makePool(key);
+  }
+  return cachedTablePool_;
+}
+
 void HashJoinBridge::appendSpilledHashTablePartitions(
     SpillPartitionSet spillPartitionSet) {
   VELOX_CHECK(
@@ -370,6 +393,176 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
   return SpillInput(std::move(spillShard));
 }
 
+void HashJoinBridge::addSwapProber(double minBuildRatio) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!started_);
+  swapState_ = SwapState::kUndecided;
+  swapMinBuildRatio_ = minBuildRatio;
+  ++numSwapProbers_;
+}
+
+bool HashJoinBridge::addSwapBuildRows(uint64_t numRows) {
+  std::vector<ContinuePromise> promises;
+  bool swapped;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    numSwapBuildRows_ += numRows;
+    promises = maybeDecideSwapLocked();
+    swapped = swapState_ == SwapState::kSwapped;
+  }
+  notify(std::move(promises));
+  return swapped;
+}
+
+bool HashJoinBridge::swapBuildFinishing() {
+  std::vector<ContinuePromise> promises;
+  bool swapped;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (swapState_ == SwapState::kUndecided) {
+      promises = setSwapStateLocked(SwapState::kRejected);
+    }
+    swapped = swapState_ == SwapState::kSwapped;
+  }
+  notify(std::move(promises));
+  return swapped;
+}
+
+void HashJoinBridge::addSwapProbeInput(
+    std::vector<RowVectorPtr> input,
+    uint64_t numRows,
+    bool complete) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    VELOX_CHECK_LT(numSwapProbeInputs_, numSwapProbers_);
+    ++numSwapProbeInputs_;
+    if (swapState_ == SwapState::kUndecided) {
+      if (!complete) {
+        promises = setSwapStateLocked(SwapState::kRejected);
+      } else {
+        numSwapProbeRows_ += numRows;
+        for (auto& vector : input) {
+          swapProbeInput_.push_back(std::move(vector));
+        }
+        promises = maybeDecideSwapLocked();
+      }
+    }
+  }
+  notify(std::move(promises));
+}
+
+std::vector<ContinuePromise> HashJoinBridge::maybeDecideSwapLocked() {
+  if (swapState_ != SwapState::kUndecided ||
+      numSwapProbeInputs_ < numSwapProbers_ ||
+      numSwapBuildRows_ <
+          swapMinBuildRatio_ * std::max<uint64_t>(numSwapProbeRows_, 1)) {
+    return {};
+  }
+  return setSwapStateLocked(SwapState::kSwapped);
+}
+
+std::vector<ContinuePromise> HashJoinBridge::setSwapStateLocked(
+    SwapState state) {
+  VELOX_CHECK(swapState_ == SwapState::kUndecided);
+  swapState_ = state;
+  if (state == SwapState::kRejected) {
+    swapProbeInput_.clear();
+  }
+  return std::move(promises_);
+}
+
+std::optional<bool> HashJoinBridge::swapDecisionOrFuture(
+    ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(started_);
+  VELOX_CHECK(!cancelled_, "Getting swap decision after join is aborted");
+  VELOX_CHECK(swapState_ != SwapState::kDisabled);
+  if (swapState_ != SwapState::kUndecided) {
+    return swapState_ == SwapState::kSwapped;
+  }
+  promises_.emplace_back("HashJoinBridge::swapDecisionOrFuture");
+  *future = promises_.back().getSemiFuture();
+  return std::nullopt;
+}
+
+bool HashJoinBridge::swapRejected() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return swapState_ == SwapState::kRejected;
+}
+
+std::vector<RowVectorPtr> HashJoinBridge::swapProbeInput() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(swapState_ == SwapState::kSwapped);
+  return swapProbeInput_;
+}
+
+void HashJoinBridge::addSwapBuildInput(
+    RowVectorPtr input,
+    ContinueFuture* future) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!cancelled_, "Adding swap input after join is aborted");
+    VELOX_CHECK(swapState_ == SwapState::kSwapped);
+    swapBuildInput_.push_back(std::move(input));
+    // Keeps a couple of inputs queued for each HashProbe operator.
+    if (swapBuildInput_.size() > 2 * numSwapProbers_) {
+      promises_.emplace_back("HashJoinBridge::addSwapBuildInput");
+      *future = promises_.back().getSemiFuture();
+    } else {
+      promises = std::move(promises_);
+    }
+  }
+  notify(std::move(promises));
+}
+
+void HashJoinBridge::swapBuildInputFinished() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(swapState_ == SwapState::kSwapped);
+    VELOX_CHECK_LT(numSwapBuildersFinished_, numBuilders_);
+    ++numSwapBuildersFinished_;
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+std::optional<RowVectorPtr> HashJoinBridge::swapBuildInputOrFuture(
+    ContinueFuture* future) {
+  std::vector<ContinuePromise> promises;
+  std::optional<RowVectorPtr> input;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!cancelled_, "Getting swap input after join is aborted");
+    VELOX_CHECK(swapState_ == SwapState::kSwapped);
+    if (!swapBuildInput_.empty()) {
+      input = std::move(swapBuildInput_.front());
+      swapBuildInput_.pop_front();
+      // Wakes up the HashBuild operators waiting for the queue to drain.
+      promises = std::move(promises_);
+    } else if (numSwapBuildersFinished_ == numBuilders_) {
+      input = nullptr;
+    } else {
+      promises_.emplace_back("HashJoinBridge::swapBuildInputOrFuture");
+      *future = promises_.back().getSemiFuture();
+    }
+  }
+  notify(std::move(promises));
+  return input;
+}
+
+bool canSwapJoinSides(
+    const std::shared_ptr<const core::HashJoinNode>& joinNode,
+    const core::QueryConfig& queryConfig) {
+  return queryConfig.hashJoinAdaptiveSwapMaxProbeRows() > 0 &&
+      joinNode->isInnerJoin() && joinNode->filter() == nullptr &&
+      !joinNode->canSpill(queryConfig) &&
+      hashTableCacheKey(*joinNode, queryConfig).empty();
+}
+
 bool isLeftNullAwareJoinWithFilter(
     const std::shared_ptr<const core::HashJoinNode>& joinNode) {
   return (joinNode->isAntiJoin() || joinNode->isLeftSemiProjectJoin() ||
@@ -438,6 +631,15 @@ bool needRightSideJoin(core::JoinType joinType) {
       isRightSemiFilterJoin(joinType) || isRightSemiProjectJoin(joinType);
 }
 
+bool canPushdownJoinKeyFilters(
+    const std::shared_ptr<const core::HashJoinNode>& joinNode) {
+  const auto joinType = joinNode->joinType();
+  return isInnerJoin(joinType) || isLeftSemiFilterJoin(joinType) ||
+      isRightSemiFilterJoin(joinType) ||
+      (isRightSemiProjectJoin(joinType) && !joinNode->isNullAware()) ||
+      isRightJoin(joinType);
+}
+
 RowTypePtr hashJoinTableSpillType(
     const RowTypePtr& tableType,
     core::JoinType joinType) {
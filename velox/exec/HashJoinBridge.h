@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashBitRange.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/Spill.h"
@@ -50,7 +51,7 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table' which only applies if the disk spilling is enabled.
   void setHashTable(
-      std::unique_ptr<BaseHashTable> table,
+      std::shared_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
       bool hasNullKeys,
       HashJoinTableSpillFunc&& tableSpillFunc);
@@ -63,6 +64,15 @@ class HashJoinBridge : public JoinBridge {
 
   void setAntiJoinHasNullKeys();
 
+  /// Returns the table cached for 'key' in HashTableCache. Looks it up on the
+  /// first call so that all the builders of the join see the same result.
+  std::optional<HashTableCache::Entry> cachedHashTable(const std::string& key);
+
+  /// Returns the memory pool the builders build the table to add to
+  /// HashTableCache in. Makes the pool on the first call.
+  std::shared_ptr<memory::MemoryPool> cachedHashTablePool(
+      const std::string& key);
+
   /// Represents the result of HashBuild operators. In case of an anti join, a
   /// build side entry with a null in a join key makes the join return nothing.
   /// In this case, HashBuild operators finishes early without processing all
@@ -125,7 +135,69 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartition' will be set to null in the returned SpillInput.
   std::optional<SpillInput> spillInputOrFuture(ContinueFuture* future);
 
+  /// The adaptive swap of the join sides. The HashProbe operators buffer the
+  /// probe input while the build side is running. If the whole probe side is
+  /// buffered and the build side has received 'minBuildRatio' times more rows
+  /// before it finishes, the join is swapped: each HashProbe builds a table
+  /// over the buffered probe input and probes it with the build side rows
+  /// which the HashBuild operators hand over through this bridge instead of
+  /// building the table. The swap is decided once for all the operators.
+
+  /// Invoked by HashProbe operator ctor to add to this bridge if the join can
+  /// be swapped. Enables the swap with 'minBuildRatio'.
+  void addSwapProber(double minBuildRatio);
+
+  /// Invoked by HashBuild operator to count 'numRows' more build input rows.
+  /// Returns true if the join is swapped.
+  bool addSwapBuildRows(uint64_t numRows);
+
+  /// Invoked by HashBuild operator when it has no more input. Returns true if
+  /// the join is swapped, otherwise the join is no longer swapped.
+  bool swapBuildFinishing();
+
+  /// Invoked by HashProbe operator when it stops buffering the probe input.
+  /// 'complete' is true if 'input' with 'numRows' is the whole probe input of
+  /// the operator. The join is not swapped if any operator can't buffer its
+  /// whole input.
+  void addSwapProbeInput(
+      std::vector<RowVectorPtr> input,
+      uint64_t numRows,
+      bool complete);
+
+  /// Returns true if the join is swapped, false if not, or std::nullopt and
+  /// sets 'future' if not decided yet.
+  std::optional<bool> swapDecisionOrFuture(ContinueFuture* future);
+
+  /// Returns true if it is decided not to swap the join.
+  bool swapRejected();
+
+  /// Returns the probe input buffered by all the HashProbe operators of a
+  /// swapped join.
+  std::vector<RowVectorPtr> swapProbeInput();
+
+  /// Invoked by HashBuild operator of a swapped join to hand over 'input' in
+  /// the layout of the table to the HashProbe operators. Sets 'future' if
+  /// enough input is queued for the HashProbe operators.
+  void addSwapBuildInput(RowVectorPtr input, ContinueFuture* future);
+
+  /// Invoked by HashBuild operator of a swapped join after it has handed over
+  /// all its input.
+  void swapBuildInputFinished();
+
+  /// Invoked by HashProbe operator of a swapped join to get the next build side
+  /// input. Returns nullptr if all the build side input has been handed over,
+  /// or std::nullopt and sets 'future' if waiting for more.
+  std::optional<RowVectorPtr> swapBuildInputOrFuture(ContinueFuture* future);
+
  private:
+  enum class SwapState { kDisabled, kUndecided, kSwapped, kRejected };
+
+  // Decides to swap or not if all the HashProbe operators have buffered their
+  // whole input. Returns the promises to notify if decided.
+  std::vector<ContinuePromise> maybeDecideSwapLocked();
+
+  std::vector<ContinuePromise> setSwapStateLocked(SwapState state);
+
   void appendSpilledHashTablePartitionsLocked(
       SpillPartitionSet&& spillPartitionSet);
 
@@ -160,14 +232,41 @@ class HashJoinBridge : public JoinBridge {
   // memory and engages in recursive spilling.
   SpillPartitionSet spillPartitionSets_;
 
+  // Set by the first call to cachedHashTable().
+  bool cacheLookedUp_{false};
+  std::optional<HashTableCache::Entry> cachedTable_;
+
+  // Set by the first call to cachedHashTablePool().
+  std::shared_ptr<memory::MemoryPool> cachedTablePool_;
+
   // A flag indicating if any probe operator has poked 'this' join bridge to
   // attempt to get table. It is reset after probe side finish the (sub) table
   // processing.
   bool probeStarted_;
 
+  // State of the adaptive swap of the join sides.
+  SwapState swapState_{SwapState::kDisabled};
+  double swapMinBuildRatio_{0};
+  uint32_t numSwapProbers_{0};
+  uint32_t numSwapProbeInputs_{0};
+  uint64_t numSwapProbeRows_{0};
+  uint64_t numSwapBuildRows_{0};
+  std::vector<RowVectorPtr> swapProbeInput_;
+  // The build side input handed over to the HashProbe operators of a swapped
+  // join.
+  std::deque<RowVectorPtr> swapBuildInput_;
+  uint32_t numSwapBuildersFinished_{0};
+
   friend test::HashJoinBridgeTestHelper;
 };
 
+/// Returns true if the build and probe sides of 'joinNode' can be swapped at
+/// runtime, i.e. it is an inner join without a filter that doesn't spill or
+/// share its table, and the adaptive swap is enabled in 'queryConfig'.
+bool canSwapJoinSides(
+    const std::shared_ptr<const core::HashJoinNode>& joinNode,
+    const core::QueryConfig& queryConfig);
+
 // Indicates if 'joinNode' is null-aware anti or left semi project join type and
 // has filter set.
 bool isLeftNullAwareJoinWithFilter(
@@ -206,6 +305,12 @@ bool isHashProbeMemoryPool(const memory::MemoryPool& pool);
 
 bool needRightSideJoin(core::JoinType joinType);
 
+/// Returns true if the probe side input of 'joinNode' can be pre-filtered by
+/// dynamic filters made from the build side join keys, i.e. probe rows without
+/// a matching build key never produce output.
+bool canPushdownJoinKeyFilters(
+    const std::shared_ptr<const core::HashJoinNode>& joinNode);
+
 /// Returns the type of the hash table associated with this join.
 RowTypePtr hashJoinTableType(
     const std::shared_ptr<const core::HashJoinNode>& joinNode);
@@ -95,6 +95,14 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
       const folly::dynamic& obj,
       void* context);
 
+  const std::vector<column_index_t>& keyChannels() const {
+    return keyChannels_;
+  }
+
+  const std::vector<VectorPtr>& constValues() const {
+    return constValues_;
+  }
+
  private:
   const RowTypePtr inputType_;
   const std::vector<column_index_t> keyChannels_;
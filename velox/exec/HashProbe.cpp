@@ -129,7 +129,11 @@ HashProbe::HashProbe(
           operatorId,
           joinNode->id(),
           "HashProbe",
-          joinNode->canSpill(driverCtx->queryConfig())
+          // A cached table is shared with other queries and must not be
+          // spilled.
+          joinNode->canSpill(driverCtx->queryConfig()) &&
+                  hashTableCacheKey(*joinNode, driverCtx->queryConfig())
+                      .empty()
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       outputBatchSize_{outputBatchRows()},
@@ -140,9 +144,18 @@ HashProbe::HashProbe(
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
+      swapMaxProbeRows_(
+          canSwapJoinSides(joinNode_, driverCtx->queryConfig())
+              ? driverCtx->queryConfig().hashJoinAdaptiveSwapMaxProbeRows()
+              : 0),
       filterResult_(1),
       outputTableRowsCapacity_(outputBatchSize_) {
   VELOX_CHECK_NOT_NULL(joinBridge_);
+  if (swapMaxProbeRows_ > 0) {
+    swapState_ = SwapState::kBuffering;
+    joinBridge_->addSwapProber(
+        driverCtx->queryConfig().hashJoinAdaptiveSwapMinBuildRatio());
+  }
 }
 
 void HashProbe::initialize() {
@@ -414,6 +427,8 @@ void HashProbe::asyncWaitForHashTable() {
 
   if (table_->numDistinct() == 0) {
     if (skipProbeOnEmptyBuild()) {
+      // The buffered swap input has no matches.
+      swapInput_.clear();
       if (!needToSpillInput()) {
         if (isSpillInput() ||
             operatorCtx_->driverCtx()
@@ -426,12 +441,10 @@ void HashProbe::asyncWaitForHashTable() {
       }
     }
   } else if (
-      (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
-       isRightSemiFilterJoin(joinType_) ||
-       (isRightSemiProjectJoin(joinType_) && !nullAware_) ||
-       isRightJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      canPushdownJoinKeyFilters(joinNode_) &&
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       table_->hasJoinKeyBloomFilters()) &&
+      !isSpillInput() && !hasMoreSpillData() && swapInput_.empty()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
     // push down.
@@ -445,11 +458,28 @@ void HashProbe::asyncWaitForHashTable() {
         this, keyChannels_);
 
     for (auto i = 0; i < keyChannels_.size(); ++i) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(/*nullAllowed=*/false)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      std::unique_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[i]->getFilter(/*nullAllowed=*/false);
+      }
+      if (filter == nullptr) {
+        // A single range key has an exact filter from the join bitmap even if
+        // there are too many distinct keys to keep.
+        filter = table_->joinBitmapFilter();
+      }
+      if (filter == nullptr) {
+        // Falls back to a Bloom filter if there are too many distinct keys
+        // for an exact filter. The clone shares the Bloom filter bits.
+        if (const auto* bloomFilter = table_->joinKeyBloomFilter(i)) {
+          filter = bloomFilter->clone();
         }
       }
+      if (filter != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+      }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
   }
@@ -595,16 +625,50 @@ void HashProbe::prepareInputIndicesBuffers(
 BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
   switch (state_) {
     case ProbeOperatorState::kWaitForBuild:
+      if (swapState_ == SwapState::kSwapped) {
+        if (!future_.valid()) {
+          setRunning();
+          addSwappedInput();
+        }
+        break;
+      }
       VELOX_CHECK_NULL(table_);
+      if (swapState_ == SwapState::kBuffering) {
+        if (!joinBridge_->swapRejected()) {
+          // Keeps buffering the probe input.
+          return BlockingReason::kNotBlocked;
+        }
+        swapState_ = SwapState::kRejected;
+      }
       if (!future_.valid()) {
+        if (swapState_ == SwapState::kWaiting) {
+          const auto swapped = joinBridge_->swapDecisionOrFuture(&future_);
+          if (!swapped.has_value()) {
+            VELOX_CHECK(future_.valid());
+            break;
+          }
+          if (swapped.value()) {
+            setRunning();
+            setupSwappedJoin();
+            addSwappedInput();
+            break;
+          }
+          swapState_ = SwapState::kRejected;
+        }
         setRunning();
         asyncWaitForHashTable();
       }
       break;
     case ProbeOperatorState::kRunning:
+      if (swapState_ == SwapState::kSwapped) {
+        addSwappedInput();
+        break;
+      }
       VELOX_CHECK_NOT_NULL(table_);
       if (spillInputReader_ != nullptr) {
         addSpillInput();
+      } else {
+        addBufferedInput();
       }
       break;
     case ProbeOperatorState::kWaitForPeers:
@@ -658,6 +722,10 @@ void HashProbe::decodeAndDetectNonNullKeys() {
 }
 
 void HashProbe::addInput(RowVectorPtr input) {
+  if (swapState_ == SwapState::kBuffering) {
+    addSwapProbeInput(std::move(input));
+    return;
+  }
   if (skipInput_) {
     VELOX_CHECK_NULL(input_);
     return;
@@ -985,6 +1053,16 @@ RowVectorPtr HashProbe::getOutput() {
   SCOPE_EXIT {
     pool()->release();
   };
+  if (state_ == ProbeOperatorState::kWaitForBuild) {
+    // Buffers the probe input while the join sides may be swapped.
+    VELOX_CHECK(
+        swapState_ == SwapState::kBuffering ||
+        swapState_ == SwapState::kWaiting);
+    return nullptr;
+  }
+  if (swapState_ == SwapState::kRejected && isRunning()) {
+    addBufferedInput();
+  }
   return getOutputInternal(/*toSpillOutput=*/false);
 }
 
@@ -1063,7 +1141,7 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
   // there is no extra filter we can process each batch of input in one go.
   auto maxOutputBatchRows = (isLeftSemiOrAntiJoinNoFilter || emptyBuildSide)
       ? inputSize
-      : outputBatchSize_;
+      : memoryPressureAdjustedBatchRows(outputBatchSize_);
   outputTableRowsCapacity_ = maxOutputBatchRows;
   if (filter_) {
     if (isLeftJoin(joinType_) || isFullJoin(joinType_) ||
@@ -1688,15 +1766,185 @@ void HashProbe::ensureLoaded(column_index_t channel) {
 
 void HashProbe::noMoreInput() {
   Operator::noMoreInput();
+  if (swapState_ == SwapState::kBuffering) {
+    // Defers finishing the input to after the swap decision.
+    swapState_ = SwapState::kWaiting;
+    deferredNoMoreInput_ = true;
+    joinBridge_->addSwapProbeInput(
+        {swapInput_.begin(), swapInput_.end()},
+        numSwapInputRows_,
+        /*complete=*/true);
+    return;
+  }
   noMoreInputInternal();
 }
 
 bool HashProbe::hasMoreInput() const {
-  return !noMoreInput_ || (spillInputReader_ != nullptr && !noMoreSpillInput_);
+  return !noMoreInput_ ||
+      (spillInputReader_ != nullptr && !noMoreSpillInput_) ||
+      !swapInput_.empty() || deferredNoMoreInput_ ||
+      (swapState_ == SwapState::kSwapped && !noMoreSwappedInput_);
+}
+
+void HashProbe::addSwapProbeInput(RowVectorPtr input) {
+  // The input is held past the next upstream batch, so loads all the lazy
+  // columns.
+  for (auto i = 0; i < input->childrenSize(); ++i) {
+    input->childAt(i) = BaseVector::loadedVectorShared(input->childAt(i));
+  }
+  numSwapInputRows_ += input->size();
+  swapInput_.push_back(std::move(input));
+  if (numSwapInputRows_ > swapMaxProbeRows_) {
+    swapState_ = SwapState::kRejected;
+    joinBridge_->addSwapProbeInput({}, numSwapInputRows_, /*complete=*/false);
+  }
+}
+
+void HashProbe::setupSwappedJoin() {
+  VELOX_CHECK_NULL(table_);
+  VELOX_CHECK(deferredNoMoreInput_);
+  swapState_ = SwapState::kSwapped;
+  swapInput_.clear();
+  const auto probeInput = joinBridge_->swapProbeInput();
+
+  // The table over the probe input has the probe keys first, followed by the
+  // other probe columns, as makeTableType() lays out the build side table.
+  const auto numKeys = keyChannels_.size();
+  std::vector<column_index_t> probeToTableChannels(
+      probeType_->size(), kConstantChannel);
+  for (auto i = 0; i < numKeys; ++i) {
+    if (probeToTableChannels[keyChannels_[i]] == kConstantChannel) {
+      probeToTableChannels[keyChannels_[i]] = i;
+    }
+  }
+  std::vector<column_index_t> dependentChannels;
+  std::vector<TypePtr> dependentTypes;
+  for (auto i = 0; i < probeType_->size(); ++i) {
+    if (probeToTableChannels[i] == kConstantChannel) {
+      probeToTableChannels[i] = numKeys + dependentChannels.size();
+      dependentChannels.push_back(i);
+      dependentTypes.push_back(probeType_->childAt(i));
+    }
+  }
+
+  auto table = HashTable<true>::createForJoin(
+      createVectorHashers(probeType_, keyChannels_),
+      dependentTypes,
+      /*allowDuplicates=*/true,
+      /*hasProbedFlag=*/false,
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .minTableRowsForParallelJoinBuild(),
+      pool());
+  auto* rows = table->rows();
+  auto& tableHashers = table->hashers();
+  bool analyzeKeys = table->hashMode() != BaseHashTable::HashMode::kHash;
+  SelectivityVector activeRows;
+  raw_vector<uint64_t> hashes;
+  std::vector<DecodedVector> decodedDependents(dependentChannels.size());
+  for (const auto& input : probeInput) {
+    activeRows.resize(input->size());
+    activeRows.setAll();
+    for (auto& hasher : tableHashers) {
+      hasher->decode(*input->childAt(hasher->channel()), activeRows);
+    }
+    deselectRowsWithNulls(tableHashers, activeRows);
+    if (!activeRows.hasSelections()) {
+      continue;
+    }
+    if (analyzeKeys) {
+      hashes.resize(activeRows.end());
+      for (auto& hasher : tableHashers) {
+        if (analyzeKeys) {
+          hasher->computeValueIds(activeRows, hashes);
+          analyzeKeys = hasher->mayUseValueIds();
+        }
+      }
+    }
+    for (auto i = 0; i < dependentChannels.size(); ++i) {
+      decodedDependents[i].decode(
+          *input->childAt(dependentChannels[i]), activeRows);
+    }
+    activeRows.applyToSelected([&](auto row) {
+      char* newRow = rows->newRow();
+      for (auto i = 0; i < numKeys; ++i) {
+        rows->store(tableHashers[i]->decodedVector(), row, newRow, i);
+      }
+      for (auto i = 0; i < dependentChannels.size(); ++i) {
+        rows->store(decodedDependents[i], row, newRow, numKeys + i);
+      }
+    });
+  }
+  table->prepareJoinTable({}, BaseHashTable::kNoSpillInputStartPartitionBit);
+
+  // The build side input comes in the layout of the build side table. Its
+  // columns are projected to the output the way the build side table columns
+  // are, and the probe input columns are extracted from the new table.
+  folly::F14FastMap<column_index_t, column_index_t> swappedInputColumns;
+  identityProjections_.clear();
+  for (const auto& projection : tableOutputProjections_) {
+    swappedInputColumns[projection.inputChannel] = projection.outputChannel;
+    identityProjections_.emplace_back(
+        projection.inputChannel, projection.outputChannel);
+  }
+  std::vector<IdentityProjection> swappedTableProjections;
+  for (const auto& [inputChannel, outputChannel] : projectedInputColumns_) {
+    swappedTableProjections.emplace_back(
+        probeToTableChannels[inputChannel], outputChannel);
+  }
+  projectedInputColumns_ = std::move(swappedInputColumns);
+  tableOutputProjections_ = std::move(swappedTableProjections);
+  isIdentityProjection_ = false;
+
+  const auto buildTableType = makeTableType(
+      joinNode_->sources()[1]->outputType().get(), joinNode_->rightKeys());
+  keyChannels_.resize(numKeys);
+  std::iota(keyChannels_.begin(), keyChannels_.end(), 0);
+  hashers_ = createVectorHashers(buildTableType, keyChannels_);
+  lookup_ = std::make_unique<HashLookup>(hashers_, pool());
+
+  table_ = std::move(table);
+  initializeResultIter();
+  if (table_->numDistinct() == 0) {
+    // Consumes the build side input so that the hash build operators finish.
+    skipInput_ = true;
+  }
+  addRuntimeStat("swappedJoinSides", RuntimeCounter(1));
+}
+
+void HashProbe::addSwappedInput() {
+  VELOX_CHECK(swapState_ == SwapState::kSwapped);
+  if (input_ != nullptr || noMoreSwappedInput_) {
+    return;
+  }
+  auto input = joinBridge_->swapBuildInputOrFuture(&future_);
+  if (!input.has_value()) {
+    VELOX_CHECK(future_.valid());
+    setState(ProbeOperatorState::kWaitForBuild);
+    return;
+  }
+  if (input.value() == nullptr) {
+    noMoreSwappedInput_ = true;
+    noMoreInputInternal();
+    return;
+  }
+  addInput(std::move(input.value()));
+}
+
+void HashProbe::addBufferedInput() {
+  while (input_ == nullptr && !swapInput_.empty()) {
+    auto input = std::move(swapInput_.front());
+    swapInput_.pop_front();
+    addInput(std::move(input));
+  }
+  if (swapInput_.empty() && deferredNoMoreInput_) {
+    noMoreInputInternal();
+  }
 }
 
 void HashProbe::noMoreInputInternal() {
   checkRunning();
+  deferredNoMoreInput_ = false;
 
   noMoreSpillInput_ = true;
   if (!spillInputPartitionIds_.empty()) {
@@ -39,6 +39,13 @@ class HashProbe : public Operator {
         noMoreSpillInput_ || input_ != nullptr) {
       return false;
     }
+    if (swapState_ == SwapState::kBuffering) {
+      return true;
+    }
+    if (!swapInput_.empty()) {
+      // Replays the buffered swap input first.
+      return false;
+    }
     if (table_) {
       return true;
     }
@@ -291,6 +298,23 @@ class HashProbe : public Operator {
   // next hash table from the spilled data.
   void noMoreInputInternal();
 
+  // Buffers 'input' while the join sides may still be swapped. Stops
+  // buffering if the buffered input exceeds 'swapMaxProbeRows_'.
+  void addSwapProbeInput(RowVectorPtr input);
+
+  // Invoked when the join sides are swapped. Builds 'table_' over the buffered
+  // probe input of all the probe operators and swaps the projections and the
+  // key channels, so that the build side input is probed the way the probe
+  // input would have been.
+  void setupSwappedJoin();
+
+  // Gets the next build side input to probe if the join sides are swapped.
+  void addSwappedInput();
+
+  // Probes the buffered swap input after the join sides are not swapped.
+  // Finishes the input deferred by noMoreInput() after the buffered input.
+  void addBufferedInput();
+
   // Indicates if this hash probe operator is under non-reclaimable state or
   // not.
   bool nonReclaimableState() const;
@@ -353,6 +377,39 @@ class HashProbe : public Operator {
 
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
+  // The max number of probe input rows to buffer for swapping the join
+  // sides. 0 if the join sides can't be swapped. See
+  // HashJoinBridge::addSwapProber().
+  const uint64_t swapMaxProbeRows_;
+
+  enum class SwapState {
+    // The join sides can't be swapped.
+    kDisabled,
+    // Buffers the probe input while the build side input is read.
+    kBuffering,
+    // Has buffered all the probe input and waits for the swap decision.
+    kWaiting,
+    // The join sides are not swapped. Probes the buffered input first.
+    kRejected,
+    // Probes the build side input with a table built over the probe input.
+    kSwapped,
+  };
+
+  SwapState swapState_{SwapState::kDisabled};
+
+  // The buffered probe input while the join sides may still be swapped.
+  std::deque<RowVectorPtr> swapInput_;
+  uint64_t numSwapInputRows_{0};
+
+  // Set if noMoreInput() is received while buffering the probe input, in which
+  // case noMoreInputInternal() is invoked after the buffered input is
+  // processed.
+  bool deferredNoMoreInput_{false};
+
+  // Set after all the build side input is probed if the join sides are
+  // swapped.
+  bool noMoreSwappedInput_{false};
+
   ProbeOperatorState state_{ProbeOperatorState::kWaitForBuild};
 
   // Used for synchronization with the hash probe operators of the same pipeline
@@ -15,6 +15,11 @@
  */
 
 #include "velox/exec/HashTable.h"
+
+#include <array>
+
+#include <folly/hash/Hash.h>
+
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
@@ -57,6 +62,9 @@ HashTable<ignoreNullKeys>::HashTable(
       pool_(pool),
       minTableSizeForParallelJoinBuild_(minTableSizeForParallelJoinBuild),
       isJoinBuild_(isJoinBuild),
+      mayUseJoinBitmap_(
+          isJoinBuild && !allowDuplicates && !hasProbedFlag &&
+          accumulators.empty() && dependentTypes.empty()),
       buildPartitionBounds_(raw_vector<PartitionBoundIndexType>(pool)) {
   std::vector<TypePtr> keys;
   for (auto& hasher : hashers_) {
@@ -341,6 +349,10 @@ char* HashTable<ignoreNullKeys>::insertEntry(
     // the word below the row. Space was reserved in the allocation
     // unless we have given up on normalized keys.
     RowContainer::normalizedKey(group) = lookup.normalizedKeys[row]; // NOLINT
+    if (wideNormalizedKeys()) {
+      RowContainer::normalizedKeyHigh(group) =
+          lookup.normalizedKeysHigh[row]; // NOLINT
+    }
   }
   ++numDistinct_;
   lookup.newGroups.push_back(row);
@@ -395,7 +407,10 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
         -static_cast<int32_t>(sizeof(normalized_key_t)),
         [&](char* group, int32_t row) INLINE_LAMBDA {
           return RowContainer::normalizedKey(group) ==
-              lookup.normalizedKeys[row];
+              lookup.normalizedKeys[row] &&
+              (!wideNormalizedKeys() ||
+               RowContainer::normalizedKeyHigh(group) ==
+                   lookup.normalizedKeysHigh[row]);
         },
         [&](int32_t row, uint64_t index) {
           return isJoin ? nullptr : insertEntry(lookup, index, row);
@@ -427,11 +442,26 @@ inline uint64_t mixNormalizedKey(uint64_t k, uint8_t bits) {
   return folly::hasher<uint64_t>()(k);
 }
 
-void populateNormalizedKeys(HashLookup& lookup, int8_t sizeBits) {
+// Mixes both words of a 128 bit normalized key.
+inline uint64_t mixWideNormalizedKey(uint64_t low, uint64_t high) {
+  return folly::hash::hash_128_to_64(low, high);
+}
+
+void populateNormalizedKeys(HashLookup& lookup, int8_t sizeBits, bool wide) {
   lookup.normalizedKeys.resize(lookup.rows.back() + 1);
   uint64_t* __restrict hashes = lookup.hashes.data();
   uint64_t* __restrict keys = lookup.normalizedKeys.data();
   int32_t end = lookup.rows.back() + 1;
+  if (wide) {
+    // The high words were computed into 'normalizedKeysHigh' by the hashers.
+    const uint64_t* __restrict high = lookup.normalizedKeysHigh.data();
+    for (auto row : lookup.rows) {
+      auto hash = hashes[row];
+      keys[row] = hash; // NOLINT
+      hashes[row] = mixWideNormalizedKey(hash, high[row]);
+    }
+    return;
+  }
   if (end / 4 < lookup.rows.size()) {
     // For more than 1/4 of the positions in use, run the loop on all
     // elements, since the loop will do 4 at a time.
@@ -460,21 +490,44 @@ void HashTable<ignoreNullKeys>::groupProbe(
     arrayGroupProbe(lookup);
     return;
   }
+  if (usesBigintIdMap_) {
+    bigintIdMapGroupProbe(lookup);
+    return;
+  }
   // Do size-based rehash before mixing hashes from normalized keys
   // because the size of the table affects the mixing.
   checkSize(lookup.rows.size(), false, spillInputStartPartitionBit);
   if (hashMode_ == HashMode::kNormalizedKey) {
-    populateNormalizedKeys(lookup, sizeBits_);
+    populateNormalizedKeys(lookup, sizeBits_, wideNormalizedKeys());
     groupNormalizedKeyProbe(lookup);
     return;
   }
+  if (incrementalRehashInProgress()) {
+    // Each probe adds at most lookup.rows.size() groups. Moving at least twice
+    // that finishes the move before the new table needs to grow.
+    continueIncrementalRehash(std::max<int64_t>(
+        kMinIncrementalRehashRows, 2 * lookup.rows.size()));
+  }
+  if (incrementalRehashInProgress()) {
+    // Groups that existed before the rehash are all in the retired table.
+    // Rows not found there are looked up or inserted in the new table.
+    const auto& misses = probeRetiredTable(lookup);
+    hashGroupProbe(lookup, misses.data(), misses.size());
+    return;
+  }
+  hashGroupProbe(lookup, lookup.rows.data(), lookup.rows.size());
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::hashGroupProbe(
+    HashLookup& lookup,
+    const vector_size_t* rows,
+    int32_t numProbes) {
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
   ProbeState state4;
   int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  auto rows = lookup.rows.data();
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
@@ -503,6 +556,32 @@ void HashTable<ignoreNullKeys>::groupProbe(
   }
 }
 
+template <bool ignoreNullKeys>
+const raw_vector<vector_size_t>& HashTable<ignoreNullKeys>::probeRetiredTable(
+    HashLookup& lookup) {
+  retiredTableMisses_.clear();
+  ProbeState state;
+  for (auto row : lookup.rows) {
+    state.preProbe(retiredTable_, lookup.hashes[row], row);
+    state.firstProbe(retiredTable_, 0);
+    auto* hit = state.fullProbe<ProbeState::Operation::kProbe>(
+        retiredTable_,
+        0,
+        [&](char* group, int32_t probeRow) {
+          return compareKeys(group, lookup, probeRow);
+        },
+        [&](int32_t /*row*/, uint64_t /*index*/) { return nullptr; },
+        numTombstones_,
+        false);
+    if (hit) {
+      lookup.hits[row] = hit;
+    } else {
+      retiredTableMisses_.push_back(row);
+    }
+  }
+  return retiredTableMisses_;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
   ProbeState state1;
@@ -590,21 +669,142 @@ void HashTable<ignoreNullKeys>::arrayGroupProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::bigintIdMapGroupProbe(HashLookup& lookup) {
+  constexpr int32_t kWidth = xsimd::batch<int64_t>::size;
+  if (bigintIdMap_ == nullptr) {
+    bigintIdMap_ =
+        std::make_unique<BigintIdMap>(lookup.rows.size(), *rows_->pool());
+  }
+  const auto& decoded = hashers_[0]->decodedVector();
+  const int32_t numProbes = lookup.rows.size();
+  const vector_size_t* rows = lookup.rows.data();
+  auto* groups = lookup.hits.data();
+  int64_t values[kWidth];
+  int64_t ids[kWidth];
+  for (int32_t i = 0; i < numProbes; i += kWidth) {
+    const auto numLanes = std::min(kWidth, numProbes - i);
+    uint8_t mask = 0;
+    for (auto lane = 0; lane < kWidth; ++lane) {
+      values[lane] = 0;
+      if (lane >= numLanes) {
+        continue;
+      }
+      const auto row = rows[i + lane];
+      if constexpr (!ignoreNullKeys) {
+        if (decoded.isNullAt(row)) {
+          continue;
+        }
+      }
+      values[lane] = decoded.valueAt<int64_t>(row);
+      mask |= 1 << lane;
+    }
+    bigintIdMap_->makeIds(xsimd::load_unaligned(values), mask)
+        .store_unaligned(ids);
+    for (auto lane = 0; lane < numLanes; ++lane) {
+      const auto row = rows[i + lane];
+      char*& group =
+          (mask & (1 << lane)) ? bigintIdGroup(ids[lane]) : nullKeyGroup_;
+      if (group == nullptr) {
+        group = rows_->newRow();
+        lookup.hits[row] = group;
+        storeKeys(lookup, row);
+        ++numDistinct_;
+        lookup.newGroups.push_back(row);
+      }
+      groups[row] = group;
+    }
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::setupBigintIdMap(int32_t numNew) {
+  VELOX_CHECK(mayUseBigintIdMap_);
+  VELOX_CHECK(!usesBigintIdMap_);
+  hashMode_ = HashMode::kHash;
+  usesBigintIdMap_ = true;
+  highWordHasher_ = 0;
+  hashers_[0]->resetStats();
+  rows_->disableNormalizedKeys();
+  if (table_ != nullptr) {
+    rows_->pool()->freeContiguous(tableAllocation_);
+    table_ = nullptr;
+  }
+  capacity_ = 0;
+  radixPartitionBits_ = HashBitRange();
+
+  const auto numGroups = std::max<int64_t>(
+      numDistinct_ + numNew, expectedNumDistinct_);
+  bigintIdMap_ = std::make_unique<BigintIdMap>(
+      std::min<int64_t>(2 * numGroups, BigintIdMap::kMaxCapacity),
+      *rows_->pool());
+  idGroups_ = raw_vector<char*>(rows_->pool());
+  nullKeyGroup_ = nullptr;
+
+  constexpr int32_t kBatchSize = 1024;
+  std::vector<char*> groups(kBatchSize);
+  RowContainerIterator iterator;
+  int32_t numGroupsListed;
+  while ((numGroupsListed =
+              rows_->listRows(&iterator, kBatchSize, groups.data())) > 0) {
+    addBigintIdMapGroups(groups.data(), numGroupsListed);
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::addBigintIdMapGroups(
+    char** groups,
+    int32_t numGroups) {
+  constexpr int32_t kWidth = xsimd::batch<int64_t>::size;
+  const auto column = rows_->columnAt(0);
+  int64_t values[kWidth];
+  int64_t ids[kWidth];
+  for (int32_t i = 0; i < numGroups; i += kWidth) {
+    const auto numLanes = std::min(kWidth, numGroups - i);
+    uint8_t mask = 0;
+    for (auto lane = 0; lane < kWidth; ++lane) {
+      values[lane] = 0;
+      if (lane >= numLanes) {
+        continue;
+      }
+      char* group = groups[i + lane];
+      if (!ignoreNullKeys && RowContainer::isNullAt(group, column)) {
+        nullKeyGroup_ = group;
+        continue;
+      }
+      values[lane] = RowContainer::valueAt<int64_t>(group, column.offset());
+      mask |= 1 << lane;
+    }
+    bigintIdMap_->makeIds(xsimd::load_unaligned(values), mask)
+        .store_unaligned(ids);
+    for (auto lane = 0; lane < numLanes; ++lane) {
+      if (mask & (1 << lane)) {
+        bigintIdGroup(ids[lane]) = groups[i + lane];
+      }
+    }
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   incrementProbes(lookup.rows.size());
   if (hashMode_ == HashMode::kArray) {
-    arrayJoinProbe(lookup);
+    if (joinBitmap_ != nullptr) {
+      bitmapJoinProbe(lookup);
+    } else {
+      arrayJoinProbe(lookup);
+    }
     return;
   }
   if (hashMode_ == HashMode::kNormalizedKey) {
-    populateNormalizedKeys(lookup, sizeBits_);
-    joinNormalizedKeyProbe(lookup);
+    populateNormalizedKeys(lookup, sizeBits_, false);
+    joinNormalizedKeyProbe(
+        lookup, radixPartitionProbeRows(lookup), lookup.rows.size());
     return;
   }
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const vector_size_t* rows = radixPartitionProbeRows(lookup);
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
@@ -678,10 +878,52 @@ void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
 }
 
 template <bool ignoreNullKeys>
-void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
+void HashTable<ignoreNullKeys>::bitmapJoinProbe(HashLookup& lookup) {
+  const auto* bits = joinBitmap_->as<uint64_t>();
+  const auto* hashes = lookup.hashes.data();
+  auto* hits = lookup.hits.data();
+  for (auto row : lookup.rows) {
+    const auto index = hashes[row];
+    VELOX_DCHECK_LT(index, capacity_);
+    hits[row] = bits::isBitSet(bits, index) ? joinBitmapHit_ : nullptr;
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::maybeUseJoinBitmap() {
+  if (!mayUseJoinBitmap_ || hashMode_ != HashMode::kArray ||
+      table_ == nullptr) {
+    return;
+  }
+  joinBitmap_ =
+      AlignedBuffer::allocate<bool>(capacity_, rows_->pool(), false);
+  auto* bits = joinBitmap_->asMutable<uint64_t>();
+  for (int64_t i = 0; i < capacity_; ++i) {
+    if (table_[i] != nullptr) {
+      bits::setBit(bits, i);
+      joinBitmapHit_ = table_[i];
+    }
+  }
+  rows_->pool()->freeContiguous(tableAllocation_);
+  table_ = nullptr;
+}
+
+template <bool ignoreNullKeys>
+std::unique_ptr<common::Filter> HashTable<ignoreNullKeys>::joinBitmapFilter()
+    const {
+  if (joinBitmap_ == nullptr || hashers_.size() != 1) {
+    return nullptr;
+  }
+  return hashers_[0]->getFilter(
+      joinBitmap_->as<uint64_t>(), capacity_, /*nullAllowed=*/false);
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(
+    HashLookup& lookup,
+    const vector_size_t* rows,
+    int32_t numProbes) {
   int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
   ProbeState states[kPrefetchSize];
   const uint64_t* keys = lookup.normalizedKeys.data();
   const uint64_t* hashes = lookup.hashes.data();
@@ -708,6 +950,88 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+const vector_size_t* HashTable<ignoreNullKeys>::radixPartitionProbeRows(
+    HashLookup& lookup) {
+  const int32_t numProbes = lookup.rows.size();
+  const int32_t numPartitions = radixPartitionBits_.numPartitions();
+  if (radixPartitionBits_.numBits() == 0 ||
+      numProbes < kMinRowsPerRadixPartition * numPartitions) {
+    return lookup.rows.data();
+  }
+  // Stable counting sort of the probe rows by the radix partition of their
+  // bucket.
+  std::array<int32_t, (1 << kMaxRadixPartitionBits) + 1> offsets;
+  std::fill(offsets.begin(), offsets.begin() + numPartitions + 1, 0);
+  const auto* hashes = lookup.hashes.data();
+  for (auto row : lookup.rows) {
+    ++offsets[radixPartition(hashes[row]) + 1];
+  }
+  for (auto i = 1; i <= numPartitions; ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  lookup.partitionedRows.resize(numProbes);
+  auto* partitionedRows = lookup.partitionedRows.data();
+  for (auto row : lookup.rows) {
+    partitionedRows[offsets[radixPartition(hashes[row])]++] = row;
+  }
+  return partitionedRows;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::setupRadixPartitions() {
+  radixPartitionBits_ = HashBitRange();
+  if (!isJoinBuild_ || radixPartitionTargetBytes_ == 0 ||
+      hashMode_ == HashMode::kArray) {
+    return;
+  }
+  const uint64_t byteSize = sizeMask_ + 1;
+  if (byteSize <= radixPartitionTargetBytes_) {
+    return;
+  }
+  // Both sizes are rounded to powers of two so that each partition is an
+  // aligned range of whole buckets.
+  const auto numBits = std::min<int32_t>(
+      kMaxRadixPartitionBits,
+      sizeBits_ -
+          std::max<int32_t>(
+              __builtin_ctzll(kBucketSize),
+              63 - __builtin_clzll(radixPartitionTargetBytes_)));
+  if (numBits <= 0) {
+    return;
+  }
+  radixPartitionBits_ = HashBitRange(sizeBits_ - numBits, sizeBits_);
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::radixPartitionInsertBatch(
+    char** groups,
+    uint64_t* hashes,
+    int32_t numGroups) {
+  const int32_t numPartitions = radixPartitionBits_.numPartitions();
+  if (radixPartitionBits_.numBits() == 0 ||
+      numGroups < kMinRowsPerRadixPartition * numPartitions) {
+    return;
+  }
+  std::array<int32_t, (1 << kMaxRadixPartitionBits) + 1> offsets;
+  std::fill(offsets.begin(), offsets.begin() + numPartitions + 1, 0);
+  for (auto i = 0; i < numGroups; ++i) {
+    ++offsets[radixPartition(hashes[i]) + 1];
+  }
+  for (auto i = 1; i <= numPartitions; ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  raw_vector<char*> partitionedGroups(numGroups, pool_);
+  raw_vector<uint64_t> partitionedHashes(numGroups, pool_);
+  for (auto i = 0; i < numGroups; ++i) {
+    const auto index = offsets[radixPartition(hashes[i])]++;
+    partitionedGroups[index] = groups[i];
+    partitionedHashes[index] = hashes[i];
+  }
+  std::copy(partitionedGroups.begin(), partitionedGroups.end(), groups);
+  std::copy(partitionedHashes.begin(), partitionedHashes.end(), hashes);
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::allocateTables(
     uint64_t size,
@@ -723,6 +1047,7 @@ void HashTable<ignoreNullKeys>::allocateTables(
   sizeBits_ = __builtin_popcountll(sizeMask_);
   checkHashBitsOverlap(spillInputStartPartitionBit);
   bucketOffsetMask_ = sizeMask_ & ~(kBucketSize - 1);
+  setupRadixPartitions();
   // The total size is 8 bytes per slot, in groups of 16 slots with 16 bytes of
   // tags and 16 * 6 bytes of pointers and a padding of 16 bytes to round up the
   // cache line.
@@ -735,9 +1060,20 @@ void HashTable<ignoreNullKeys>::allocateTables(
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::clear(bool freeTable) {
+  abandonIncrementalRehash();
   for (auto* rowContainer : allRows()) {
     rowContainer->clear();
   }
+  if (bigintIdMap_ != nullptr) {
+    if (freeTable) {
+      bigintIdMap_.reset();
+      idGroups_ = raw_vector<char*>(rows_->pool());
+    } else {
+      bigintIdMap_->clear();
+      idGroups_.clear();
+    }
+  }
+  nullKeyGroup_ = nullptr;
   if (table_) {
     if (!freeTable) {
       // All modes have 8 bytes per slot.
@@ -748,6 +1084,21 @@ void HashTable<ignoreNullKeys>::clear(bool freeTable) {
       capacity_ = 0;
     }
   }
+  if (joinBitmap_ != nullptr) {
+    // The rows are cleared, so 'joinBitmapHit_' is no longer valid.
+    joinBitmap_.reset();
+    joinBitmapHit_ = nullptr;
+    if (freeTable) {
+      capacity_ = 0;
+    } else {
+      // Restores the array of row pointers for inserting again.
+      const auto bytes = capacity_ * tableSlotSize();
+      rows_->pool()->allocateContiguous(
+          memory::AllocationTraits::numPages(bytes), tableAllocation_);
+      table_ = tableAllocation_.data<char*>();
+      ::memset(table_, 0, bytes);
+    }
+  }
   numDistinct_ = 0;
   numTombstones_ = 0;
 }
@@ -769,7 +1120,10 @@ void HashTable<ignoreNullKeys>::checkSize(
 
   const int64_t newNumDistincts = numNew + numDistinct_;
   if (table_ == nullptr || capacity_ == 0) {
-    const auto newSize = newHashTableEntries(numDistinct_, numNew);
+    abandonIncrementalRehash();
+    const auto newSize = newHashTableEntries(
+        numDistinct_,
+        std::max<int64_t>(numNew, expectedNumDistinct_ - numDistinct_));
     allocateTables(newSize, spillInputStartPartitionBit);
     if (numDistinct_ > 0) {
       rehash(initNormalizedKeys, spillInputStartPartitionBit);
@@ -781,14 +1135,69 @@ void HashTable<ignoreNullKeys>::checkSize(
     // then the table lookup will become slow. Given that, we treat tombstone
     // slot as non-empty slot here to decide whether to trigger rehash or not.
   } else if (newNumDistincts > rehashSize()) {
+    // A table grows again only after the previous groups are all moved.
+    finishIncrementalRehash();
     // NOTE: we need to plus one here as number itself could be power of two.
     const auto newCapacity = bits::nextPowerOfTwo(
         std::max(newNumDistincts, capacity_ - numTombstones_) + 1);
+    if (canRehashIncrementally()) {
+      startIncrementalRehash(newCapacity, spillInputStartPartitionBit);
+      return;
+    }
     allocateTables(newCapacity, spillInputStartPartitionBit);
     rehash(initNormalizedKeys, spillInputStartPartitionBit);
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::startIncrementalRehash(
+    uint64_t newCapacity,
+    int8_t spillInputStartPartitionBit) {
+  VELOX_CHECK(!incrementalRehashInProgress());
+  ++numRehashes_;
+  retiredTable_ =
+      RetiredTable{table_, sizeMask_, bucketOffsetMask_, numBuckets_};
+  retiredTableAllocation_ = std::move(tableAllocation_);
+  allocateTables(newCapacity, spillInputStartPartitionBit);
+  rehashIterator_.reset();
+  numRowsToRehash_ = rows_->numRows();
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::continueIncrementalRehash(int64_t maxRows) {
+  if (!incrementalRehashInProgress()) {
+    return;
+  }
+  constexpr int32_t kHashBatchSize = 1024;
+  raw_vector<uint64_t> hashes;
+  hashes.resize(kHashBatchSize);
+  char* groups[kHashBatchSize];
+  while (numRowsToRehash_ > 0 && maxRows > 0) {
+    const auto numGroups = rows_->listRows(
+        &rehashIterator_,
+        std::min<int64_t>({kHashBatchSize, numRowsToRehash_, maxRows}),
+        groups);
+    VELOX_CHECK_GT(numGroups, 0);
+    VELOX_CHECK(insertBatch(groups, numGroups, hashes, false));
+    numRowsToRehash_ -= numGroups;
+    maxRows -= numGroups;
+  }
+  if (numRowsToRehash_ == 0) {
+    abandonIncrementalRehash();
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::abandonIncrementalRehash() {
+  if (!incrementalRehashInProgress()) {
+    return;
+  }
+  rows_->pool()->freeContiguous(retiredTableAllocation_);
+  retiredTable_ = RetiredTable{};
+  rehashIterator_.reset();
+  numRowsToRehash_ = 0;
+}
+
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::hashRows(
     folly::Range<char**> rows,
@@ -798,6 +1207,14 @@ bool HashTable<ignoreNullKeys>::hashRows(
     return true;
   }
   if (!initNormalizedKeys && hashMode_ == HashMode::kNormalizedKey) {
+    if (wideNormalizedKeys()) {
+      for (auto i = 0; i < rows.size(); ++i) {
+        hashes[i] = mixWideNormalizedKey(
+            RowContainer::normalizedKey(rows[i]),
+            RowContainer::normalizedKeyHigh(rows[i]));
+      }
+      return true;
+    }
     for (auto i = 0; i < rows.size(); ++i) {
       hashes[i] =
           mixNormalizedKey(RowContainer::normalizedKey(rows[i]), sizeBits_);
@@ -805,6 +1222,10 @@ bool HashTable<ignoreNullKeys>::hashRows(
     return true;
   }
 
+  raw_vector<uint64_t> highHashes;
+  if (wideNormalizedKeys()) {
+    highHashes.resize(rows.size());
+  }
   for (int32_t i = 0; i < hashers_.size(); ++i) {
     auto& hasher = hashers_[i];
     if (hashMode_ == HashMode::kHash) {
@@ -818,12 +1239,20 @@ bool HashTable<ignoreNullKeys>::hashRows(
               column.offset(),
               column.nullByte(),
               ignoreNullKeys ? 0 : column.nullMask(),
-              hashes)) {
+              isHighWordHasher(i) ? highHashes : hashes)) {
         // Must reconsider 'hashMode_' and start over.
         return false;
       }
     }
   }
+  if (wideNormalizedKeys() && initNormalizedKeys) {
+    for (auto i = 0; i < rows.size(); ++i) {
+      RowContainer::normalizedKey(rows[i]) = hashes[i];
+      RowContainer::normalizedKeyHigh(rows[i]) = highHashes[i];
+      hashes[i] = mixWideNormalizedKey(hashes[i], highHashes[i]);
+    }
+    return true;
+  }
   if (hashMode_ == HashMode::kNormalizedKey && initNormalizedKeys) {
     for (auto i = 0; i < rows.size(); ++i) {
       RowContainer::normalizedKey(rows[i]) = hashes[i];
@@ -1315,6 +1744,7 @@ void HashTable<ignoreNullKeys>::insertForJoin(
     }
     return;
   }
+  radixPartitionInsertBatch(groups, hashes, numGroups);
   if (hashMode_ == HashMode::kNormalizedKey) {
     insertForJoinWithPrefetch<true>(
         rows, groups, hashes, numGroups, partitionInfo, allocator);
@@ -1329,14 +1759,21 @@ void HashTable<ignoreNullKeys>::rehash(
     bool initNormalizedKeys,
     int8_t spillInputStartPartitionBit) {
   ++numRehashes_;
-  constexpr int32_t kHashBatchSize = 1024;
   if (canApplyParallelJoinBuild()) {
     parallelJoinBuild();
     return;
   }
+  // A radix partitioned build inserts larger batches so that each batch has
+  // enough rows per partition to make the reordering by partition pay off.
+  const int32_t hashBatchSize = radixPartitionBits_.numBits() == 0
+      ? 1024
+      : std::max<int32_t>(
+            1024,
+            kMinRowsPerRadixPartition * radixPartitionBits_.numPartitions());
   raw_vector<uint64_t> hashes;
-  hashes.resize(kHashBatchSize);
-  char* groups[kHashBatchSize];
+  hashes.resize(hashBatchSize);
+  std::vector<char*> groupsHolder(hashBatchSize);
+  char** groups = groupsHolder.data();
   // A join build can have multiple payload tables. Loop over 'this'
   // and the possible other tables and put all the data in the table
   // of 'this'.
@@ -1346,7 +1783,7 @@ void HashTable<ignoreNullKeys>::rehash(
     do {
       numGroups = (i == 0 ? this : otherTables_[i - 1].get())
                       ->rows()
-                      ->listRows(&iterator, kHashBatchSize, groups);
+                      ->listRows(&iterator, hashBatchSize, groups);
       if (!insertBatch(
               groups, numGroups, hashes, initNormalizedKeys || i != 0)) {
         VELOX_CHECK_NE(hashMode_, HashMode::kHash);
@@ -1364,6 +1801,10 @@ void HashTable<ignoreNullKeys>::setHashMode(
     int8_t spillInputStartPartitionBit) {
   VELOX_CHECK_NE(hashMode_, HashMode::kHash);
   TestValue::adjust("facebook::velox::exec::HashTable::setHashMode", &mode);
+  if (mayUseBigintIdMap_ && mode != HashMode::kArray) {
+    setupBigintIdMap(numNew);
+    return;
+  }
   if (mode == HashMode::kArray) {
     const auto bytes = capacity_ * tableSlotSize();
     const auto numPages = memory::AllocationTraits::numPages(bytes);
@@ -1371,9 +1812,11 @@ void HashTable<ignoreNullKeys>::setHashMode(
     table_ = tableAllocation_.data<char*>();
     memset(table_, 0, bytes);
     hashMode_ = HashMode::kArray;
+    radixPartitionBits_ = HashBitRange();
     rehash(true, spillInputStartPartitionBit);
   } else if (mode == HashMode::kHash) {
     hashMode_ = HashMode::kHash;
+    highWordHasher_ = 0;
     for (auto& hasher : hashers_) {
       hasher->resetStats();
     }
@@ -1495,6 +1938,10 @@ uint64_t HashTable<ignoreNullKeys>::setHasherMode(
   uint64_t multiplier = 1;
   // A group by leaves 50% space for values not yet seen.
   for (int i = 0; i < hashers.size(); ++i) {
+    if (i > 0 && i == highWordHasher_) {
+      // The high word of a wide normalized key starts a new product.
+      multiplier = 1;
+    }
     multiplier = useRange.size() > i && useRange[i]
         ? hashers[i]->enableValueRange(multiplier, reservePct())
         : hashers[i]->enableValueIds(multiplier, reservePct());
@@ -1510,6 +1957,36 @@ void HashTable<ignoreNullKeys>::clearUseRange(std::vector<bool>& useRange) {
   }
 }
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::decideWideNormalizedKey(
+    const std::vector<bool>& useRange,
+    const std::vector<uint64_t>& rangeSizes,
+    const std::vector<uint64_t>& distinctSizes) {
+  if (isJoinBuild_ || hashers_.size() < 2 || !rows_->hasWideNormalizedKeys()) {
+    return false;
+  }
+  // Takes as many leading keys as fit into the low word. The remaining keys
+  // must fit in the high word.
+  uint64_t product = 1;
+  int32_t highWordHasher = 0;
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    const auto size = useRange[i] ? rangeSizes[i] : distinctSizes[i];
+    if (size == VectorHasher::kRangeTooLarge) {
+      return false;
+    }
+    product = safeMul(product, size);
+    if (product == VectorHasher::kRangeTooLarge) {
+      if (highWordHasher > 0 || i == 0) {
+        return false;
+      }
+      highWordHasher = i;
+      product = size;
+    }
+  }
+  highWordHasher_ = highWordHasher;
+  return highWordHasher_ > 0;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::decideHashMode(
     int32_t numNew,
@@ -1528,6 +2005,7 @@ void HashTable<ignoreNullKeys>::decideHashMode(
     return;
   }
   disableRangeArrayHash_ |= disableRangeArrayHash;
+  highWordHasher_ = 0;
   if (numDistinct_ && !isJoinBuild_) {
     if (!analyze()) {
       setHashMode(HashMode::kHash, numNew, spillInputStartPartitionBit);
@@ -1586,6 +2064,12 @@ void HashTable<ignoreNullKeys>::decideHashMode(
   }
   if (distinctsWithReserve == VectorHasher::kRangeTooLarge &&
       rangesWithReserve == VectorHasher::kRangeTooLarge) {
+    if (decideWideNormalizedKey(useRange, rangeSizes, distinctSizes)) {
+      setHasherMode(hashers_, useRange, rangeSizes, distinctSizes);
+      setHashMode(
+          HashMode::kNormalizedKey, numNew, spillInputStartPartitionBit);
+      return;
+    }
     setHashMode(HashMode::kHash, numNew, spillInputStartPartitionBit);
     return;
   }
@@ -1803,6 +2287,7 @@ void HashTable<ignoreNullKeys>::prepareJoinTable(
     }
   } else {
     decideHashMode(0, spillInputStartPartitionBit);
+    maybeUseJoinBitmap();
   }
 }
 
@@ -2091,10 +2576,21 @@ int32_t HashTable<true>::listNullKeyRows(
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::erase(folly::Range<char**> rows) {
+  VELOX_CHECK(
+      !usesBigintIdMap_, "Groups found by a BigintIdMap cannot be erased");
+  // The erased rows must be removed from the table they are in and their space
+  // may be reused by new rows, so the move must be complete.
+  finishIncrementalRehash();
   auto numRows = rows.size();
   raw_vector<uint64_t> hashes;
   hashes.resize(numRows);
 
+  if (wideNormalizedKeys()) {
+    // The hashes are made from the normalized keys stored with the rows.
+    hashRows(rows, false, hashes);
+    eraseWithHashes(rows, hashes.data());
+    return;
+  }
   for (int32_t i = 0; i < hashers_.size(); ++i) {
     auto& hasher = hashers_[i];
     if (hashMode_ == HashMode::kHash) {
@@ -2126,7 +2622,7 @@ void HashTable<ignoreNullKeys>::eraseWithHashes(
       table_[hashes[i]] = nullptr;
     }
   } else {
-    if (hashMode_ == HashMode::kNormalizedKey) {
+    if (hashMode_ == HashMode::kNormalizedKey && !wideNormalizedKeys()) {
       for (auto i = 0; i < numRows; ++i) {
         hashes[i] = mixNormalizedKey(hashes[i], sizeBits_);
       }
@@ -2165,6 +2661,15 @@ void HashTable<ignoreNullKeys>::eraseWithHashes(
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::checkConsistency() const {
+  if (usesBigintIdMap_) {
+    const auto numGroups =
+        std::count_if(idGroups_.begin(), idGroups_.end(), [](char* group) {
+          return group != nullptr;
+        });
+    VELOX_CHECK_EQ(
+        numGroups + (nullKeyGroup_ != nullptr ? 1 : 0), numDistinct_);
+    return;
+  }
   VELOX_CHECK_GE(capacity_, numDistinct_);
   if (hashMode_ == BaseHashTable::HashMode::kArray) {
     return;
@@ -2197,6 +2702,82 @@ void HashTable<ignoreNullKeys>::checkConsistency() const {
 template class HashTable<true>;
 template class HashTable<false>;
 
+namespace {
+// Returns a Bloom filter over the non-null values of 'column' in 'containers'
+// or nullptr if all values are null.
+template <typename T>
+std::unique_ptr<common::Filter> makeJoinKeyBloomFilter(
+    const std::vector<RowContainer*>& containers,
+    const RowColumn& column,
+    int32_t numRows) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(numRows);
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  constexpr int32_t kBatchSize = 1024;
+  std::array<char*, kBatchSize> rows;
+  for (auto* container : containers) {
+    RowContainerIterator iter;
+    while (const auto numListed =
+               container->listRows(&iter, kBatchSize, rows.data())) {
+      for (auto i = 0; i < numListed; ++i) {
+        if (RowContainer::isNullAt(rows[i], column)) {
+          continue;
+        }
+        const int64_t value =
+            RowContainer::valueAt<T>(rows[i], column.offset());
+        min = std::min(min, value);
+        max = std::max(max, value);
+        bloomFilter->insert(common::BigintValuesUsingBloomFilter::hash(value));
+      }
+    }
+  }
+  if (min > max) {
+    return nullptr;
+  }
+  return std::make_unique<common::BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), false);
+}
+} // namespace
+
+void BaseHashTable::buildJoinKeyBloomFilters(uint64_t maxBytes) {
+  joinKeyBloomFilters_.clear();
+  joinKeyBloomFilters_.resize(hashers_.size());
+  const auto containers = allRows();
+  uint64_t numRows{0};
+  for (const auto* container : containers) {
+    numRows += container->numRows();
+  }
+  // BloomFilter takes 2 bytes per value rounded up to a power of 2.
+  if (numRows == 0 || numRows > std::numeric_limits<int32_t>::max() ||
+      2 * bits::nextPowerOfTwo(numRows) > maxBytes) {
+    return;
+  }
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    const auto& column = rows_->columnAt(i);
+    switch (hashers_[i]->typeKind()) {
+      case TypeKind::TINYINT:
+        joinKeyBloomFilters_[i] =
+            makeJoinKeyBloomFilter<int8_t>(containers, column, numRows);
+        break;
+      case TypeKind::SMALLINT:
+        joinKeyBloomFilters_[i] =
+            makeJoinKeyBloomFilter<int16_t>(containers, column, numRows);
+        break;
+      case TypeKind::INTEGER:
+        joinKeyBloomFilters_[i] =
+            makeJoinKeyBloomFilter<int32_t>(containers, column, numRows);
+        break;
+      case TypeKind::BIGINT:
+        joinKeyBloomFilters_[i] =
+            makeJoinKeyBloomFilter<int64_t>(containers, column, numRows);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
 namespace {
 void populateLookupRows(
     const SelectivityVector& rows,
@@ -2240,10 +2821,20 @@ void HashTable<ignoreNullKeys>::prepareForGroupProbe(
 
   bool rehash = false;
   const auto mode = hashMode();
+  if (wideNormalizedKeys()) {
+    lookup.normalizedKeysHigh.resize(rows.end());
+  }
   for (auto i = 0; i < hashers.size(); ++i) {
     auto& hasher = hashers[i];
+    if (usesBigintIdMap_) {
+      // The id map probes with the decoded keys.
+      break;
+    }
     if (mode != BaseHashTable::HashMode::kHash) {
-      if (!hasher->computeValueIds(rows, lookup.hashes)) {
+      if (!hasher->computeValueIds(
+              rows,
+              isHighWordHasher(i) ? lookup.normalizedKeysHigh
+                                  : lookup.hashes)) {
         rehash = true;
       }
     } else {
@@ -15,8 +15,10 @@
  */
 #pragma once
 
+#include "velox/common/base/BigintIdMap.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/MemoryAllocator.h"
+#include "velox/exec/HashBitRange.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/VectorHasher.h"
@@ -62,7 +64,9 @@ struct HashLookup {
         rows(raw_vector<vector_size_t>(pool)),
         hashes(raw_vector<uint64_t>(pool)),
         hits(raw_vector<char*>(pool)),
-        normalizedKeys(raw_vector<uint64_t>(pool)) {}
+        normalizedKeys(raw_vector<uint64_t>(pool)),
+        normalizedKeysHigh(raw_vector<uint64_t>(pool)),
+        partitionedRows(raw_vector<vector_size_t>(pool)) {}
 
   void reset(vector_size_t size) {
     rows.resize(size);
@@ -101,6 +105,14 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// High words of 128 bit normalized keys. 1:1 with 'hashes'. Populated by
+  /// groupProbe if the table uses wide normalized keys.
+  raw_vector<uint64_t> normalizedKeysHigh;
+
+  /// Scratch memory used by joinProbe to hold 'rows' reordered by radix
+  /// partition of the join table if the table is radix partitioned.
+  raw_vector<vector_size_t> partitionedRows;
 };
 
 struct HashTableStats {
@@ -138,6 +150,7 @@ class BaseHashTable {
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
+  static inline const std::string kJoinBitmap{"hashtable.joinBitmap"};
 
   /// Returns the string of the given 'mode'.
   static std::string modeString(HashMode mode);
@@ -300,6 +313,56 @@ class BaseHashTable {
       int8_t spillInputStartPartitionBit,
       folly::Executor* executor = nullptr) = 0;
 
+  /// Makes a Bloom filter over the non-null values of each integral join key
+  /// for use as a dynamic filter on the probe side. Skips all keys if a Bloom
+  /// filter would take more than 'maxBytes'. Must be called after the join
+  /// table is prepared and before it is shared with the probe side.
+  void buildJoinKeyBloomFilters(uint64_t maxBytes);
+
+  /// Returns the Bloom filter made for join key 'keyIndex' by
+  /// buildJoinKeyBloomFilters() or nullptr if there is none.
+  const common::Filter* joinKeyBloomFilter(int32_t keyIndex) const {
+    return keyIndex < joinKeyBloomFilters_.size()
+        ? joinKeyBloomFilters_[keyIndex].get()
+        : nullptr;
+  }
+
+  bool hasJoinKeyBloomFilters() const {
+    for (const auto& filter : joinKeyBloomFilters_) {
+      if (filter != nullptr) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Enables radix partitioned join build and probe. The join table is
+  /// logically split into contiguous sub-tables of at most 'targetBytes' each,
+  /// keyed on the high bits of the bucket offset. Build inserts and probe
+  /// lookups are then reordered so that consecutive accesses hit the same
+  /// sub-table, which stays cache resident. 0 disables the radix partitioning.
+  /// Must be called before the table is built.
+  virtual void setRadixPartitionTargetBytes(uint64_t targetBytes) = 0;
+
+  /// Enables incremental growth of a group by table in kHash mode. When a
+  /// table of at least 'minEntries' slots grows, the new table is allocated
+  /// but the existing groups are moved over a few at a time by subsequent
+  /// groupProbe() calls instead of all at once. The old table is kept for
+  /// lookups until all groups are moved. 0 disables incremental growth.
+  virtual void setIncrementalRehashMinEntries(uint64_t minEntries) = 0;
+
+  /// Allows a group by table to use normalized keys of two 64 bit words when
+  /// the value ids of the keys do not fit in one. Must be called before any
+  /// rows are added. No-op if the keys do not support value ids.
+  virtual void enableWideNormalizedKeys() = 0;
+
+  /// Allows a group by table with a single BIGINT key to map the keys to dense
+  /// ids with a BigintIdMap when they do not fit kArray mode, instead of
+  /// probing a hash table. The groups are then found by id and the table
+  /// reports kHash mode. Must be called before any rows are added. No-op for
+  /// other keys.
+  virtual void enableBigintIdMap() = 0;
+
   /// Returns the memory footprint in bytes for any data structures
   /// owned by 'this'.
   virtual int64_t allocatedBytes() const = 0;
@@ -336,6 +399,25 @@ class BaseHashTable {
   /// VectorHashers of 'this'.
   virtual HashMode hashMode() const = 0;
 
+  /// Returns true if the join table keeps a bit per slot of an array mode
+  /// table instead of a row pointer. See HashTable::joinBitmap_.
+  virtual bool usesJoinBitmap() const {
+    return false;
+  }
+
+  /// Returns a filter over the single join key that passes exactly the key
+  /// values set in the join bitmap or nullptr if the table does not use a
+  /// join bitmap.
+  virtual std::unique_ptr<common::Filter> joinBitmapFilter() const {
+    return nullptr;
+  }
+
+  /// Sets the number of distinct keys 'this' is expected to hold, e.g. from a
+  /// cardinality estimate of the input. The first allocation of a kHash or
+  /// kNormalizedKey table is sized to hold that many entries without
+  /// rehashing. kArray tables are sized by the key value ranges instead.
+  virtual void setExpectedNumDistinct(uint64_t numDistinct) = 0;
+
   /// Disables use of array or normalized key hash modes.
   void forceGenericHashMode(int8_t spillInputStartPartitionBit) {
     setHashMode(HashMode::kHash, 0, spillInputStartPartitionBit);
@@ -439,6 +521,10 @@ class BaseHashTable {
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
   std::unique_ptr<RowContainer> rows_;
 
+  // Bloom filters over the values of the join keys, 1:1 with 'hashers_'. Set by
+  // buildJoinKeyBloomFilters(). nullptr for keys without a Bloom filter.
+  std::vector<std::unique_ptr<common::Filter>> joinKeyBloomFilters_;
+
   // Time spent in build outside of the calling thread.
   CpuWallTiming offThreadBuildTiming_;
 };
@@ -552,7 +638,14 @@ class HashTable : public BaseHashTable {
   int64_t allocatedBytes() const override {
     // For each row: sizeof(char*) per table entry + memory
     // allocated with MemoryAllocator for fixed-width rows and strings.
-    return sizeof(char*) * capacity_ + rows_->allocatedBytes();
+    const int64_t tableBytes = joinBitmap_ != nullptr
+        ? joinBitmap_->capacity()
+        : sizeof(char*) * capacity_;
+    const int64_t idMapBytes = bigintIdMap_ != nullptr
+        ? bigintIdMap_->allocatedBytes() + sizeof(char*) * idGroups_.capacity()
+        : 0;
+    return tableBytes + idMapBytes + retiredTableAllocation_.size() +
+        rows_->allocatedBytes();
   }
 
   HashStringAllocator* stringAllocator() override {
@@ -568,18 +661,30 @@ class HashTable : public BaseHashTable {
   }
 
   HashTableStats stats() const override {
+    const int64_t capacity =
+        bigintIdMap_ != nullptr ? bigintIdMap_->capacity() : capacity_;
     return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
+        capacity, numRehashes_, numDistinct_, numTombstones_};
   }
 
   bool hasDuplicateKeys() const override {
     return hasDuplicates_;
   }
 
+  bool usesJoinBitmap() const override {
+    return joinBitmap_ != nullptr;
+  }
+
+  std::unique_ptr<common::Filter> joinBitmapFilter() const override;
+
   HashMode hashMode() const override {
     return hashMode_;
   }
 
+  void setExpectedNumDistinct(uint64_t numDistinct) override {
+    expectedNumDistinct_ = numDistinct;
+  }
+
   void decideHashMode(
       int32_t numNew,
       int8_t spillInputStartPartitionBit,
@@ -602,6 +707,47 @@ class HashTable : public BaseHashTable {
       int8_t spillInputStartPartitionBit,
       folly::Executor* executor = nullptr) override;
 
+  void setRadixPartitionTargetBytes(uint64_t targetBytes) override {
+    radixPartitionTargetBytes_ = targetBytes;
+  }
+
+  void setIncrementalRehashMinEntries(uint64_t minEntries) override {
+    incrementalRehashMinEntries_ = minEntries;
+  }
+
+  void enableWideNormalizedKeys() override {
+    VELOX_CHECK(!isJoinBuild_);
+    // Keys without value ids never have normalized keys.
+    if (hashMode_ != HashMode::kHash) {
+      rows_->enableWideNormalizedKeys();
+    }
+  }
+
+  void enableBigintIdMap() override {
+    VELOX_CHECK(!isJoinBuild_);
+    VELOX_CHECK_EQ(numDistinct_, 0);
+    mayUseBigintIdMap_ =
+        hashers_.size() == 1 && hashers_[0]->typeKind() == TypeKind::BIGINT;
+  }
+
+  /// True if the groups are found by their ids in 'bigintIdMap_'.
+  bool usesBigintIdMap() const {
+    return usesBigintIdMap_;
+  }
+
+  /// True if the table is in kNormalizedKey mode with normalized keys of two
+  /// words.
+  bool wideNormalizedKeys() const {
+    return highWordHasher_ > 0;
+  }
+
+  /// Returns the bit range of the bucket offset which selects the radix
+  /// partition of the table. Has zero bits if the table is not radix
+  /// partitioned.
+  const HashBitRange& radixPartitionBits() const {
+    return radixPartitionBits_;
+  }
+
   void prepareForJoinProbe(
       HashLookup& lookup,
       const RowVectorPtr& input,
@@ -615,11 +761,22 @@ class HashTable : public BaseHashTable {
       int8_t spillInputStartPartitionBit) override;
 
   uint64_t hashTableSizeIncrease(int32_t numNewDistinct) const override {
+    if (usesBigintIdMap_) {
+      // The id map doubles when full and each new group adds one pointer.
+      const int64_t idMapBytes = bigintIdMap_ != nullptr &&
+              bigintIdMap_->mayResize(numNewDistinct)
+          ? 2 * bigintIdMap_->allocatedBytes()
+          : 0;
+      return idMapBytes + sizeof(char*) * numNewDistinct;
+    }
     if (numDistinct_ + numNewDistinct > rehashSize()) {
       // If rehashed, the table adds size_ entries (i.e. doubles),
       // adding one pointer worth for each new position.  (16 tags, 16 6 byte
       // pointers, 16 bytes padding).
-      return capacity_ * tableSlotSize();
+      // An incremental rehash keeps the old table while the new one fills,
+      // so the whole new table is added.
+      return capacity_ * tableSlotSize() *
+          (canRehashIncrementally() ? 2 : 1);
     }
     return 0;
   }
@@ -677,6 +834,10 @@ class HashTable : public BaseHashTable {
     return table_;
   }
 
+  bool testingIncrementalRehashInProgress() const {
+    return incrementalRehashInProgress();
+  }
+
  private:
   // Enables debug stats for collisions for debug build.
 #ifdef NDEBUG
@@ -685,6 +846,13 @@ class HashTable : public BaseHashTable {
   static constexpr bool kTrackLoads = true;
 #endif
 
+  // Max number of bucket offset bits used for radix partitioning a join table.
+  static constexpr int32_t kMaxRadixPartitionBits = 10;
+
+  // Min average number of rows per radix partition in a batch for reordering
+  // the batch by partition.
+  static constexpr int32_t kMinRowsPerRadixPartition = 2;
+
   // The table in non-kArray mode has a power of two number of buckets each with
   // 16 slots. Each slot has a 1 byte tag (a field of hash number) and a 48 bit
   // pointer. All the tags are in a 16 byte SIMD word followed by the 6 byte
@@ -726,6 +894,52 @@ class HashTable : public BaseHashTable {
   static_assert(sizeof(Bucket) == 128);
   static constexpr uint64_t kBucketSize = sizeof(Bucket);
 
+  // The table a group by table grows out of during an incremental rehash.
+  // Exposes the subset of the HashTable interface ProbeState uses for
+  // lookups.
+  struct RetiredTable {
+    char** table_{nullptr};
+    int64_t sizeMask_{0};
+    int64_t bucketOffsetMask_{0};
+    int64_t numBuckets_{0};
+
+    int64_t bucketOffset(uint64_t hash) const {
+      return hash & bucketOffsetMask_;
+    }
+
+    int64_t nextBucketOffset(int64_t bucketOffset) const {
+      return sizeMask_ & (bucketOffset + kBucketSize);
+    }
+
+    int64_t numBuckets() const {
+      return numBuckets_;
+    }
+
+    Bucket* bucketAt(int64_t offset) const {
+      return reinterpret_cast<Bucket*>(
+          reinterpret_cast<char*>(table_) + offset);
+    }
+
+    char* row(int64_t bucketOffset, int32_t slotIndex) const {
+      return bucketAt(bucketOffset)->pointerAt(slotIndex);
+    }
+
+    TagVector loadTags(int64_t bucketOffset) const {
+      return BaseHashTable::loadTags(
+          reinterpret_cast<uint8_t*>(table_), bucketOffset);
+    }
+
+    void incrementTagLoads() const {}
+
+    void incrementRowLoads() const {}
+
+    void incrementHits() const {}
+  };
+
+  // Min number of groups moved by each groupProbe() during an incremental
+  // rehash.
+  static constexpr int32_t kMinIncrementalRehashRows = 4096;
+
   // Returns the bucket at byte offset 'offset' from 'table_'.
   Bucket* bucketAt(int64_t offset) const {
     VELOX_DCHECK_EQ(0, offset & (kBucketSize - 1));
@@ -758,6 +972,27 @@ class HashTable : public BaseHashTable {
 
   void arrayGroupProbe(HashLookup& lookup);
 
+  // Finds or makes the groups of the single BIGINT key of 'lookup' by their
+  // ids in 'bigintIdMap_'.
+  void bigintIdMapGroupProbe(HashLookup& lookup);
+
+  // Switches a group by table to finding the groups in 'bigintIdMap_' and
+  // gives the existing groups their ids. 'numNew' is the number of groups
+  // about to be added.
+  void setupBigintIdMap(int32_t numNew);
+
+  // Assigns ids to the keys of 'groups' and records the groups by id.
+  void addBigintIdMapGroups(char** groups, int32_t numGroups);
+
+  // Returns the group of 'id' from 'bigintIdMap_'. Null if the group does not
+  // exist yet.
+  char*& bigintIdGroup(int64_t id) {
+    while (id > idGroups_.size()) {
+      idGroups_.push_back(nullptr);
+    }
+    return idGroups_[id - 1];
+  }
+
   void setHashMode(
       HashMode mode,
       int32_t numNew,
@@ -792,6 +1027,61 @@ class HashTable : public BaseHashTable {
 
   void rehash(bool initNormalizedKeys, int8_t spillInputStartPartitionBit);
 
+  // Returns true if the value ids of 'hashers_' with 'useRange' fit in two
+  // words and sets 'highWordHasher_' to the first hasher of the second word.
+  bool decideWideNormalizedKey(
+      const std::vector<bool>& useRange,
+      const std::vector<uint64_t>& rangeSizes,
+      const std::vector<uint64_t>& distinctSizes);
+
+  // True if the value ids of the hasher at 'index' go into the high word of
+  // a wide normalized key.
+  bool isHighWordHasher(int32_t index) const {
+    return highWordHasher_ > 0 && index >= highWordHasher_;
+  }
+
+  // True if growing the table from its current size would be incremental.
+  bool canRehashIncrementally() const {
+    return incrementalRehashMinEntries_ > 0 && !isJoinBuild_ &&
+        hashMode_ == HashMode::kHash && otherTables_.empty() &&
+        capacity_ >= incrementalRehashMinEntries_ &&
+        rows_->numFreeRows() == 0;
+  }
+
+  bool incrementalRehashInProgress() const {
+    return retiredTable_.table_ != nullptr;
+  }
+
+  // Retires the current table, allocates one of 'newCapacity' slots and sets
+  // up moving the existing groups into it.
+  void startIncrementalRehash(
+      uint64_t newCapacity,
+      int8_t spillInputStartPartitionBit);
+
+  // Moves up to 'maxRows' groups from the retired table into 'table_'. Frees
+  // the retired table after the last one.
+  void continueIncrementalRehash(int64_t maxRows);
+
+  // Moves all remaining groups of an incremental rehash.
+  void finishIncrementalRehash() {
+    continueIncrementalRehash(numRowsToRehash_);
+  }
+
+  // Frees the retired table without moving its groups. Used when 'table_' is
+  // about to be rebuilt from the rows anyway.
+  void abandonIncrementalRehash();
+
+  // Looks up the rows of 'lookup' in the retired table and sets their hits.
+  // Returns the rows that were not found, which can only be in 'table_'.
+  const raw_vector<vector_size_t>& probeRetiredTable(HashLookup& lookup);
+
+  // Inserts or finds the groups for 'numProbes' rows in 'rows' in a kHash
+  // mode table.
+  void hashGroupProbe(
+      HashLookup& lookup,
+      const vector_size_t* rows,
+      int32_t numProbes);
+
   uint64_t rehashSize() const {
     return rehashSize(capacity_ - numTombstones_);
   }
@@ -905,8 +1195,42 @@ class HashTable : public BaseHashTable {
   // Array probe with SIMD.
   void arrayJoinProbe(HashLookup& lookup);
 
-  // Shortcut for probe with normalized keys.
-  void joinNormalizedKeyProbe(HashLookup& lookup);
+  // Sets the hits of an array mode probe from 'joinBitmap_'.
+  void bitmapJoinProbe(HashLookup& lookup);
+
+  // Replaces the row pointers of an array mode join table with
+  // 'joinBitmap_' if the join only needs to know whether a key has a match.
+  void maybeUseJoinBitmap();
+
+  // Shortcut for probe with normalized keys. 'rows' are the rows to probe in
+  // probe order.
+  void joinNormalizedKeyProbe(
+      HashLookup& lookup,
+      const vector_size_t* rows,
+      int32_t numProbes);
+
+  // Returns the rows of 'lookup' in the order to probe. If 'this' is radix
+  // partitioned and there are enough rows for partitioning to pay off, the
+  // rows are stably reordered by radix partition into
+  // 'lookup.partitionedRows'. Otherwise returns 'lookup.rows'. 'lookup.hashes'
+  // must be final, i.e. mixed for normalized keys.
+  const vector_size_t* radixPartitionProbeRows(HashLookup& lookup);
+
+  // Sets 'radixPartitionBits_' from the current table size and
+  // 'radixPartitionTargetBytes_'.
+  void setupRadixPartitions();
+
+  // Reorders 'groups' and 'hashes' in place by radix partition for a join
+  // build insert if 'this' is radix partitioned.
+  void radixPartitionInsertBatch(
+      char** groups,
+      uint64_t* hashes,
+      int32_t numGroups);
+
+  // Returns the radix partition of the bucket of 'hash'.
+  int32_t radixPartition(uint64_t hash) const {
+    return radixPartitionBits_.partition(bucketOffset(hash));
+  }
 
   // Returns the total size of the variable size 'columns' in 'row'.
   // NOTE: No checks are done in the method for performance considerations.
@@ -971,7 +1295,8 @@ class HashTable : public BaseHashTable {
   bool analyze();
 
   // Erases the entries of rows from the hash table and its RowContainer.
-  // 'hashes' must be computed according to 'hashMode_'.
+  // 'hashes' must be computed according to 'hashMode_'. With wide normalized
+  // keys, 'hashes' are the mixed hashes made by hashRows().
   void eraseWithHashes(folly::Range<char**> rows, uint64_t* hashes);
 
   // Returns the percentage of values to reserve for new keys in range
@@ -1049,6 +1374,12 @@ class HashTable : public BaseHashTable {
   int8_t sizeBits_;
   bool isJoinBuild_ = false;
 
+  // True if a join table may replace its array of row pointers with
+  // 'joinBitmap_', i.e. the join has no duplicate keys, no dependent columns
+  // and does not track probed rows. This is the case for semi and anti joins
+  // without extra filter.
+  const bool mayUseJoinBitmap_;
+
   // Set at join build time if the table has duplicates, meaning that
   // the join can be cardinality increasing. Atomic for tsan because
   // many threads can set this.
@@ -1059,6 +1390,15 @@ class HashTable : public BaseHashTable {
   char** table_ = nullptr;
   memory::ContiguousAllocation tableAllocation_;
 
+  // A bit per slot of an array mode join table that is set if the slot has a
+  // row. Used instead of 'table_' if 'mayUseJoinBitmap_' is true, which takes
+  // 1/64 of the memory and keeps larger ranges of keys in cache. The probe
+  // returns 'joinBitmapHit_' for a set bit. This is a row of the table, so
+  // that a hit is a valid row but its contents do not correspond to the probe
+  // key. This is fine since semi and anti joins only need the existence.
+  BufferPtr joinBitmap_;
+  char* joinBitmapHit_{nullptr};
+
   // Number of slots across all buckets.
   int64_t capacity_{0};
 
@@ -1075,6 +1415,8 @@ class HashTable : public BaseHashTable {
   int64_t numTombstones_{0};
   // Counts the number of rehash() calls.
   int64_t numRehashes_{0};
+  // Expected number of distinct keys used to size the first table allocation.
+  int64_t expectedNumDistinct_{0};
   HashMode hashMode_ = HashMode::kArray;
   // Owns the memory of multiple build side hash join tables that are
   // combined into a single probe hash table.
@@ -1118,6 +1460,56 @@ class HashTable : public BaseHashTable {
   // If true, avoids using VectorHasher value ranges with kArray hash mode.
   bool disableRangeArrayHash_{false};
 
+  // Target size in bytes of a radix partition of the join table. 0 if radix
+  // partitioning is disabled.
+  uint64_t radixPartitionTargetBytes_{0};
+
+  // Bits of the bucket offset giving the radix partition of a bucket. Set
+  // when the table is allocated. Empty if the table is not radix partitioned.
+  HashBitRange radixPartitionBits_;
+
+  // Min capacity of a group by table in kHash mode that grows incrementally.
+  // 0 if incremental growth is disabled.
+  uint64_t incrementalRehashMinEntries_{0};
+
+  // Index of the first hasher whose value id goes into the high word of a 128
+  // bit normalized key. The hashers before it make the low word. 0 if
+  // normalized keys are one word.
+  int32_t highWordHasher_{0};
+
+  // The table being grown out of during an incremental rehash. Empty
+  // otherwise.
+  RetiredTable retiredTable_;
+  memory::ContiguousAllocation retiredTableAllocation_;
+
+  // Position in 'rows_' of the next group to move into 'table_' and the number
+  // of groups left to move. Groups created after the start of the rehash are
+  // appended to 'rows_' past the ones being moved and are only in 'table_'.
+  RowContainerIterator rehashIterator_;
+  int64_t numRowsToRehash_{0};
+
+  // Rows of a probe that missed the retired table.
+  raw_vector<vector_size_t> retiredTableMisses_;
+
+  // True if enableBigintIdMap() was called on a table with a single BIGINT
+  // key. The table then uses 'bigintIdMap_' instead of kNormalizedKey or
+  // kHash mode.
+  bool mayUseBigintIdMap_{false};
+
+  // True once the groups are found by 'bigintIdMap_'. 'table_' is then not
+  // allocated. 'bigintIdMap_' is made on the first probe after the table is
+  // freed.
+  bool usesBigintIdMap_{false};
+
+  // Assigns dense ids starting at 1 to the keys of the groups.
+  std::unique_ptr<BigintIdMap> bigintIdMap_;
+
+  // The group of each id of 'bigintIdMap_' at index id - 1.
+  raw_vector<char*> idGroups_;
+
+  // The group of the null key if 'ignoreNullKeys' is false.
+  char* nullKeyGroup_{nullptr};
+
   friend class ProbeState;
   friend test::HashTableTestHelper<ignoreNullKeys>;
 };
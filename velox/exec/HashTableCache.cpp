@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/HashTableCache.h"
+#include "velox/exec/HashJoinBridge.h"
+
+namespace facebook::velox::exec {
+
+std::unique_ptr<HashTableCache> HashTableCache::instance_;
+
+namespace {
+// Owns a cached table and the pool it is built in. The table is destroyed
+// before the pool.
+struct TableHolder {
+  std::shared_ptr<memory::MemoryPool> pool;
+  std::unique_ptr<BaseHashTable> table;
+};
+
+// Lets the memory arbitrator reclaim from the cache by evicting unused
+// tables.
+class HashTableCacheReclaimer : public memory::MemoryReclaimer {
+ public:
+  static std::unique_ptr<memory::MemoryReclaimer> create(
+      HashTableCache* cache) {
+    return std::unique_ptr<memory::MemoryReclaimer>(
+        new HashTableCacheReclaimer(cache));
+  }
+
+  bool reclaimableBytes(
+      const memory::MemoryPool& /*pool*/,
+      uint64_t& reclaimableBytes) const override {
+    reclaimableBytes = cache_->unusedBytes();
+    return true;
+  }
+
+  uint64_t reclaim(
+      memory::MemoryPool* /*pool*/,
+      uint64_t targetBytes,
+      uint64_t /*maxWaitMs*/,
+      Stats& /*stats*/) override {
+    return cache_->evict(targetBytes);
+  }
+
+  void abort(memory::MemoryPool* /*pool*/, const std::exception_ptr& /*error*/)
+      override {
+    // The tables in use belong to running queries, which the arbitrator aborts
+    // on their own.
+    cache_->evict(0);
+  }
+
+ private:
+  explicit HashTableCacheReclaimer(HashTableCache* cache)
+      : MemoryReclaimer(0), cache_(cache) {}
+
+  HashTableCache* const cache_;
+};
+
+void appendPlan(const core::PlanNode& node, std::string& out) {
+  auto text = node.toString(true, false);
+  // Drops the plan node id that follows the node name.
+  const auto idPos = text.find("[" + node.id() + "]");
+  if (idPos != std::string::npos) {
+    text.erase(idPos, node.id().size() + 2);
+  }
+  out += text;
+  for (const auto& source : node.sources()) {
+    appendPlan(*source, out);
+  }
+}
+} // namespace
+
+// static
+HashTableCache* HashTableCache::create(uint64_t maxBytes) {
+  if (instance_ == nullptr) {
+    instance_.reset(new HashTableCache(maxBytes));
+  }
+  return instance_.get();
+}
+
+HashTableCache::HashTableCache(uint64_t maxBytes)
+    : maxBytes_(maxBytes),
+      pool_(memory::memoryManager()->addRootPool(
+          "hash_table_cache",
+          memory::kMaxMemory,
+          HashTableCacheReclaimer::create(this))) {}
+
+HashTableCache::~HashTableCache() {
+  std::lock_guard<std::mutex> l(mutex_);
+  tables_.clear();
+}
+
+std::optional<HashTableCache::Entry> HashTableCache::get(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = tables_.find(key);
+  if (it == tables_.end()) {
+    ++stats_.numMisses;
+    return std::nullopt;
+  }
+  ++stats_.numHits;
+  lru_.splice(lru_.end(), lru_, it->second.lruPosition);
+  return it->second.entry;
+}
+
+std::shared_ptr<memory::MemoryPool> HashTableCache::makePool(
+    const std::string& /*key*/) {
+  std::lock_guard<std::mutex> l(mutex_);
+  return pool_->addLeafChild(fmt::format("hash_table_cache.{}", numPools_++));
+}
+
+HashTableCache::Entry HashTableCache::put(
+    const std::string& key,
+    std::shared_ptr<memory::MemoryPool> pool,
+    std::unique_ptr<BaseHashTable> table,
+    bool hasNullKeys) {
+  VELOX_CHECK_NOT_NULL(table);
+  VELOX_CHECK_EQ(pool->parent(), pool_.get());
+  const uint64_t bytes = pool->usedBytes();
+  auto holder = std::make_shared<TableHolder>();
+  holder->pool = std::move(pool);
+  holder->table = std::move(table);
+  Entry entry{
+      std::shared_ptr<BaseHashTable>(holder, holder->table.get()),
+      hasNullKeys};
+  holder.reset();
+
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = tables_.find(key);
+  if (it != tables_.end()) {
+    // Another query has built the same table first. 'entry' is freed on
+    // return.
+    lru_.splice(lru_.end(), lru_, it->second.lruPosition);
+    return it->second.entry;
+  }
+  if (cachedBytes_ + bytes > maxBytes_) {
+    evictLocked(cachedBytes_ + bytes - maxBytes_);
+  }
+  lru_.push_back(key);
+  tables_.emplace(key, CachedTable{entry, std::prev(lru_.end()), bytes});
+  cachedBytes_ += bytes;
+  return entry;
+}
+
+uint64_t HashTableCache::evict(uint64_t targetBytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  return evictLocked(targetBytes);
+}
+
+uint64_t HashTableCache::evictLocked(uint64_t targetBytes) {
+  uint64_t freedBytes = 0;
+  for (auto it = lru_.begin(); it != lru_.end();) {
+    if (targetBytes > 0 && freedBytes >= targetBytes) {
+      break;
+    }
+    auto tableIt = tables_.find(*it);
+    VELOX_CHECK(tableIt != tables_.end());
+    if (tableIt->second.entry.table.use_count() > 1) {
+      // A query is probing the table.
+      ++it;
+      continue;
+    }
+    freedBytes += tableIt->second.bytes;
+    cachedBytes_ -= tableIt->second.bytes;
+    tables_.erase(tableIt);
+    it = lru_.erase(it);
+    ++stats_.numEvictions;
+  }
+  return freedBytes;
+}
+
+uint64_t HashTableCache::unusedBytes() {
+  std::lock_guard<std::mutex> l(mutex_);
+  uint64_t bytes = 0;
+  for (const auto& [key, cached] : tables_) {
+    if (cached.entry.table.use_count() == 1) {
+      bytes += cached.bytes;
+    }
+  }
+  return bytes;
+}
+
+HashTableCache::Stats HashTableCache::stats() {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = stats_;
+  stats.numEntries = tables_.size();
+  stats.usedBytes = cachedBytes_;
+  return stats;
+}
+
+std::string hashTableCacheKey(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& queryConfig) {
+  if (HashTableCache::getInstance() == nullptr) {
+    return "";
+  }
+  const auto inputsKey = queryConfig.hashTableCacheKey();
+  if (inputsKey.empty() || joinNode.isNullAware() ||
+      needRightSideJoin(joinNode.joinType())) {
+    return "";
+  }
+  std::string key = inputsKey;
+  key += '\n';
+  key += core::joinTypeName(joinNode.joinType());
+  for (const auto& rightKey : joinNode.rightKeys()) {
+    key += ' ';
+    key += rightKey->name();
+  }
+  key += '\n';
+  if (joinNode.filter() != nullptr) {
+    key += joinNode.filter()->toString();
+  }
+  key += '\n';
+  appendPlan(*joinNode.sources()[1], key);
+  return key;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <list>
+
+#include <folly/container/F14Map.h>
+#include "velox/core/PlanNode.h"
+#include "velox/exec/HashTable.h"
+
+namespace facebook::velox::exec {
+
+/// A process-wide cache of built hash join tables, for sharing the table of a
+/// small build side between the many queries that join with it. Queries opt
+/// in by setting core::QueryConfig::kHashTableCacheKey. The tables are built
+/// in memory pools under a dedicated root pool and are read only once cached.
+/// Tables that no query uses are evicted least recently used first when the
+/// cache exceeds its size or when the memory arbitrator reclaims from the
+/// root pool.
+class HashTableCache {
+ public:
+  struct Entry {
+    std::shared_ptr<BaseHashTable> table;
+    bool hasNullKeys{false};
+  };
+
+  /// Runtime stat of a HashBuild that probes a cached table instead of
+  /// building one.
+  static inline const std::string kCacheHits{"hashtable.cacheHits"};
+
+  struct Stats {
+    uint64_t numEntries{0};
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEvictions{0};
+    uint64_t usedBytes{0};
+  };
+
+  /// Creates the process-wide instance. Unused tables are evicted when adding
+  /// a table makes the cached tables exceed 'maxBytes'. Returns the existing
+  /// instance if already created.
+  static HashTableCache* create(uint64_t maxBytes);
+
+  /// Returns the process-wide instance or nullptr if not created.
+  static HashTableCache* getInstance() {
+    return instance_.get();
+  }
+
+  /// Destroys the process-wide instance. No query may use a cached table.
+  static void testingClear() {
+    instance_ = nullptr;
+  }
+
+  ~HashTableCache();
+
+  /// Returns the table cached for 'key' or std::nullopt.
+  std::optional<Entry> get(const std::string& key);
+
+  /// Returns a new memory pool to build the table for 'key' in. The pool is
+  /// passed to put() together with the table.
+  std::shared_ptr<memory::MemoryPool> makePool(const std::string& key);
+
+  /// Adds 'table' built in 'pool' for 'key' and returns the entry to probe. If
+  /// another query has added a table for 'key' in the meantime, returns that
+  /// one and frees 'table'.
+  Entry put(
+      const std::string& key,
+      std::shared_ptr<memory::MemoryPool> pool,
+      std::unique_ptr<BaseHashTable> table,
+      bool hasNullKeys);
+
+  /// Evicts tables no query uses, least recently used first, until at least
+  /// 'targetBytes' are freed. Evicts all unused tables if 'targetBytes' is 0.
+  /// Returns the number of bytes freed.
+  uint64_t evict(uint64_t targetBytes);
+
+  /// Returns the number of bytes held by tables no query uses.
+  uint64_t unusedBytes();
+
+  Stats stats();
+
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+ private:
+  struct CachedTable {
+    Entry entry;
+    std::list<std::string>::iterator lruPosition;
+    uint64_t bytes;
+  };
+
+  explicit HashTableCache(uint64_t maxBytes);
+
+  uint64_t evictLocked(uint64_t targetBytes);
+
+  static std::unique_ptr<HashTableCache> instance_;
+
+  const uint64_t maxBytes_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  std::mutex mutex_;
+  // Keys from least to most recently used.
+  std::list<std::string> lru_;
+  folly::F14FastMap<std::string, CachedTable> tables_;
+  uint64_t cachedBytes_{0};
+  uint64_t numPools_{0};
+  Stats stats_;
+};
+
+/// Returns the key of the table built for 'joinNode' in HashTableCache or an
+/// empty string if the table is not shared. The key combines the inputs key
+/// of 'queryConfig' with the join type, the build keys, the filter and the
+/// build side plan. Plan node ids do not go in the key.
+std::string hashTableCacheKey(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& queryConfig);
+
+} // namespace facebook::velox::exec
@@ -125,6 +125,47 @@ void addBetweenCondition(
       "At least one of the between condition bounds needs to be not constant: {}",
       betweenCondition->toString());
 }
+
+// Returns the matches of a batched input which are known before the input is
+// processed.
+class BatchedLookupResultIterator
+    : public connector::IndexSource::LookupResultIterator {
+ public:
+  explicit BatchedLookupResultIterator(
+      std::unique_ptr<connector::IndexSource::LookupResult> result)
+      : result_(std::move(result)) {
+    if (result_ != nullptr && result_->size() == 0) {
+      result_ = nullptr;
+    }
+  }
+
+  std::optional<std::unique_ptr<connector::IndexSource::LookupResult>> next(
+      vector_size_t /*size*/,
+      velox::ContinueFuture& /*future*/) override {
+    return std::move(result_);
+  }
+
+ private:
+  std::unique_ptr<connector::IndexSource::LookupResult> result_;
+};
+
+// Appends the copy of 'sourceRow' to 'targetRow' to 'ranges', extending the
+// last range if the rows are adjacent to it.
+void addCopyRange(
+    vector_size_t sourceRow,
+    vector_size_t targetRow,
+    vector_size_t count,
+    std::vector<BaseVector::CopyRange>& ranges) {
+  if (!ranges.empty()) {
+    auto& last = ranges.back();
+    if (last.sourceIndex + last.count == sourceRow &&
+        last.targetIndex + last.count == targetRow) {
+      last.count += count;
+      return;
+    }
+  }
+  ranges.push_back({sourceRow, targetRow, count});
+}
 } // namespace
 
 IndexLookupJoin::IndexLookupJoin(
@@ -140,6 +181,9 @@ IndexLookupJoin::IndexLookupJoin(
       // TODO: support to update output batch size with output size stats during
       // the lookup processing.
       outputBatchSize_{outputBatchRows()},
+      maxBatchedInputs_{
+          driverCtx->queryConfig().indexLookupJoinMaxBatchedInputs()},
+      cacheMaxKeys_{driverCtx->queryConfig().indexLookupJoinCacheMaxKeys()},
       joinType_{joinNode->joinType()},
       numKeys_{joinNode->leftKeys().size()},
       probeType_{joinNode->sources()[0]->outputType()},
@@ -343,11 +387,26 @@ BlockingReason IndexLookupJoin::isBlocked(ContinueFuture* future) {
 void IndexLookupJoin::addInput(RowVectorPtr input) {
   VELOX_CHECK_GT(input->size(), 0);
   VELOX_CHECK_NULL(input_);
-  input_ = std::move(input);
+  if (maxBatchedInputs_ == 0) {
+    input_ = std::move(input);
+    return;
+  }
+
+  std::vector<VectorPtr> keyColumns;
+  keyColumns.reserve(lookupInputChannels_.size());
+  for (const auto channel : lookupInputChannels_) {
+    keyColumns.push_back(
+        BaseVector::loadedVectorShared(input->childAt(channel)));
+  }
+  BatchedInput batchedInput;
+  batchedInput.keys = std::make_shared<RowVector>(
+      pool(), lookupInputType_, nullptr, input->size(), std::move(keyColumns));
+  batchedInput.input = std::move(input);
+  batchedInputs_.push_back(std::move(batchedInput));
 }
 
 RowVectorPtr IndexLookupJoin::getOutput() {
-  if (input_ == nullptr) {
+  if (input_ == nullptr && (maxBatchedInputs_ == 0 || !nextBatchedInput())) {
     return nullptr;
   }
 
@@ -396,6 +455,250 @@ void IndexLookupJoin::lookup() {
       indexSource_->lookup(connector::IndexSource::LookupRequest{lookupInput_});
 }
 
+bool IndexLookupJoin::nextBatchedInput() {
+  VELOX_CHECK_NULL(input_);
+  if (batchedInputs_.empty()) {
+    return false;
+  }
+  if (batchedInputs_.front().result == nullptr) {
+    if (batchLookupIter_ == nullptr) {
+      if (!noMoreInput_ && batchedInputs_.size() < maxBatchedInputs_) {
+        return false;
+      }
+      startBatchedLookup();
+    }
+    if (batchLookupIter_ != nullptr && !fetchBatchedLookupResults()) {
+      return false;
+    }
+    finishBatchedLookup();
+  }
+
+  auto& batchedInput = batchedInputs_.front();
+  VELOX_CHECK_NOT_NULL(batchedInput.result);
+  VELOX_CHECK_NULL(lookupResultIter_);
+  input_ = std::move(batchedInput.input);
+  lookupResultIter_ = std::make_shared<BatchedLookupResultIterator>(
+      std::move(batchedInput.result));
+  batchedInputs_.pop_front();
+  return true;
+}
+
+void IndexLookupJoin::startBatchedLookup() {
+  VELOX_CHECK_NULL(pendingGeneration_);
+  VELOX_CHECK_NULL(batchLookupIter_);
+  VELOX_CHECK(!batchedInputs_.empty());
+
+  pendingGeneration_ = std::make_shared<LookupGeneration>();
+  KeyRowMap newKeys;
+  std::vector<std::vector<BaseVector::CopyRange>> copyRanges(
+      batchedInputs_.size());
+  vector_size_t numNewKeys{0};
+  uint64_t numCacheHits{0};
+  uint64_t numDuplicateKeys{0};
+  for (auto i = 0; i < batchedInputs_.size(); ++i) {
+    auto& batchedInput = batchedInputs_[i];
+    const auto* keys = batchedInput.keys.get();
+    batchedInput.keyRefs.resize(keys->size());
+    for (vector_size_t row = 0; row < keys->size(); ++row) {
+      const KeyRow key{keys, row, keys->hashValueAt(row)};
+      if (!lookupCache_.empty()) {
+        const auto it = lookupCache_.find(key);
+        if (it != lookupCache_.end()) {
+          batchedInput.keyRefs[row] = it->second;
+          ++numCacheHits;
+          continue;
+        }
+      }
+      const auto [it, inserted] =
+          newKeys.emplace(key, KeyRef{pendingGeneration_.get(), numNewKeys});
+      if (inserted) {
+        addCopyRange(row, numNewKeys, 1, copyRanges[i]);
+        ++numNewKeys;
+      } else {
+        ++numDuplicateKeys;
+      }
+      batchedInput.keyRefs[row] = it->second;
+    }
+  }
+
+  auto lookupKeys =
+      BaseVector::create<RowVector>(lookupInputType_, numNewKeys, pool());
+  for (auto i = 0; i < batchedInputs_.size(); ++i) {
+    if (!copyRanges[i].empty()) {
+      lookupKeys->copyRanges(batchedInputs_[i].keys.get(), copyRanges[i]);
+    }
+  }
+  pendingGeneration_->keys = lookupKeys;
+
+  addRuntimeStat(kLookupKeys, RuntimeCounter(numNewKeys));
+  if (numCacheHits > 0) {
+    addRuntimeStat(kLookupCacheHits, RuntimeCounter(numCacheHits));
+  }
+  if (numDuplicateKeys > 0) {
+    addRuntimeStat(kLookupDuplicateKeys, RuntimeCounter(numDuplicateKeys));
+  }
+
+  if (numNewKeys > 0) {
+    batchLookupIter_ = indexSource_->lookup(
+        connector::IndexSource::LookupRequest{std::move(lookupKeys)});
+  }
+}
+
+bool IndexLookupJoin::fetchBatchedLookupResults() {
+  VELOX_CHECK_NOT_NULL(batchLookupIter_);
+  for (;;) {
+    auto resultOptional =
+        batchLookupIter_->next(outputBatchSize_, lookupFuture_);
+    if (!resultOptional.has_value()) {
+      VELOX_CHECK(lookupFuture_.valid());
+      return false;
+    }
+    VELOX_CHECK(!lookupFuture_.valid());
+    auto result = std::move(resultOptional).value();
+    if (result == nullptr) {
+      break;
+    }
+    batchLookupResults_.push_back(std::move(result));
+  }
+  batchLookupIter_ = nullptr;
+  return true;
+}
+
+void IndexLookupJoin::finishBatchedLookup() {
+  VELOX_CHECK_NOT_NULL(pendingGeneration_);
+  VELOX_CHECK_NULL(batchLookupIter_);
+
+  auto& generation = *pendingGeneration_;
+  const auto numKeys = generation.keys->size();
+  generation.offsets.assign(numKeys + 1, 0);
+  if (batchLookupResults_.size() == 1) {
+    generation.results = batchLookupResults_[0]->output;
+  } else {
+    vector_size_t numResults{0};
+    for (const auto& result : batchLookupResults_) {
+      numResults += result->size();
+    }
+    generation.results =
+        BaseVector::create<RowVector>(lookupOutputType_, numResults, pool());
+  }
+  vector_size_t numResults{0};
+  for (const auto& result : batchLookupResults_) {
+    if (batchLookupResults_.size() > 1) {
+      generation.results->copy(
+          result->output.get(), numResults, 0, result->size());
+    }
+    const auto* inputHits = result->inputHits->as<vector_size_t>();
+    for (auto i = 0; i < result->size(); ++i) {
+      VELOX_CHECK_LT(inputHits[i], numKeys);
+      ++generation.offsets[inputHits[i] + 1];
+    }
+    numResults += result->size();
+  }
+  batchLookupResults_.clear();
+  for (auto i = 0; i < numKeys; ++i) {
+    generation.offsets[i + 1] += generation.offsets[i];
+  }
+
+  for (auto& batchedInput : batchedInputs_) {
+    batchedInput.result = makeBatchedLookupResult(batchedInput);
+    batchedInput.keyRefs.clear();
+    batchedInput.keys = nullptr;
+  }
+  updateLookupCache(std::move(pendingGeneration_));
+}
+
+std::unique_ptr<connector::IndexSource::LookupResult>
+IndexLookupJoin::makeBatchedLookupResult(const BatchedInput& batchedInput) {
+  const auto& keyRefs = batchedInput.keyRefs;
+  vector_size_t numHits{0};
+  bool singleGeneration{true};
+  for (const auto& keyRef : keyRefs) {
+    const auto& offsets = keyRef.generation->offsets;
+    numHits += offsets[keyRef.index + 1] - offsets[keyRef.index];
+    singleGeneration &= keyRef.generation == keyRefs[0].generation;
+  }
+
+  auto inputHits = allocateIndices(numHits, pool());
+  if (numHits == 0) {
+    return std::make_unique<connector::IndexSource::LookupResult>(
+        std::move(inputHits),
+        BaseVector::create<RowVector>(lookupOutputType_, 0, pool()));
+  }
+
+  auto* rawInputHits = inputHits->asMutable<vector_size_t>();
+  if (singleGeneration) {
+    // Wraps the matches of the distinct keys in a dictionary in the order of
+    // the input rows.
+    const auto& results = keyRefs[0].generation->results;
+    auto resultRows = allocateIndices(numHits, pool());
+    auto* rawResultRows = resultRows->asMutable<vector_size_t>();
+    vector_size_t numOutputRows{0};
+    for (vector_size_t row = 0; row < keyRefs.size(); ++row) {
+      const auto& offsets = keyRefs[row].generation->offsets;
+      for (auto i = offsets[keyRefs[row].index];
+           i < offsets[keyRefs[row].index + 1];
+           ++i) {
+        rawInputHits[numOutputRows] = row;
+        rawResultRows[numOutputRows++] = i;
+      }
+    }
+    std::vector<VectorPtr> columns;
+    columns.reserve(results->childrenSize());
+    for (const auto& column : results->children()) {
+      columns.push_back(
+          BaseVector::wrapInDictionary(nullptr, resultRows, numHits, column));
+    }
+    return std::make_unique<connector::IndexSource::LookupResult>(
+        std::move(inputHits),
+        std::make_shared<RowVector>(
+            pool(), lookupOutputType_, nullptr, numHits, std::move(columns)));
+  }
+
+  // The matches come from the current and the cached lookups, so they are
+  // copied into one vector.
+  folly::F14FastMap<const LookupGeneration*, std::vector<BaseVector::CopyRange>>
+      copyRanges;
+  vector_size_t numOutputRows{0};
+  for (vector_size_t row = 0; row < keyRefs.size(); ++row) {
+    const auto& offsets = keyRefs[row].generation->offsets;
+    const auto begin = offsets[keyRefs[row].index];
+    const auto count = offsets[keyRefs[row].index + 1] - begin;
+    if (count == 0) {
+      continue;
+    }
+    addCopyRange(
+        begin, numOutputRows, count, copyRanges[keyRefs[row].generation]);
+    std::fill_n(rawInputHits + numOutputRows, count, row);
+    numOutputRows += count;
+  }
+  auto output =
+      BaseVector::create<RowVector>(lookupOutputType_, numHits, pool());
+  for (const auto& [generation, ranges] : copyRanges) {
+    output->copyRanges(generation->results.get(), ranges);
+  }
+  return std::make_unique<connector::IndexSource::LookupResult>(
+      std::move(inputHits), std::move(output));
+}
+
+void IndexLookupJoin::updateLookupCache(
+    std::shared_ptr<LookupGeneration> generation) {
+  const auto numKeys = generation->keys->size();
+  if (numKeys == 0 || numKeys > cacheMaxKeys_) {
+    return;
+  }
+  if (lookupCache_.size() + numKeys > cacheMaxKeys_) {
+    lookupCache_.clear();
+    cacheGenerations_.clear();
+  }
+  const auto* keys = generation->keys.get();
+  for (vector_size_t row = 0; row < numKeys; ++row) {
+    lookupCache_.emplace(
+        KeyRow{keys, row, keys->hashValueAt(row)},
+        KeyRef{generation.get(), row});
+  }
+  cacheGenerations_.push_back(std::move(generation));
+}
+
 RowVectorPtr IndexLookupJoin::getOutputFromLookupResult() {
   VELOX_CHECK_NOT_NULL(input_);
   VELOX_CHECK_NOT_NULL(lookupResultIter_);
@@ -680,6 +983,12 @@ void IndexLookupJoin::close() {
   probeOutputRowMapping_ = nullptr;
   lookupOutputRowMapping_ = nullptr;
   lookupOutputNulls_ = nullptr;
+  batchedInputs_.clear();
+  pendingGeneration_ = nullptr;
+  batchLookupIter_ = nullptr;
+  batchLookupResults_.clear();
+  lookupCache_.clear();
+  cacheGenerations_.clear();
 
   Operator::close();
 }
@@ -14,12 +14,30 @@
  * limitations under the License.
  */
 #pragma once
+#include <folly/container/F14Map.h>
+
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
 
+/// Joins the probe input with the rows of an index source looked up by the
+/// join keys. By default each input batch is looked up on its own. If
+/// 'index_lookup_join_max_batched_inputs' is set, the operator buffers up to
+/// that many input batches, deduplicates their keys and looks up the distinct
+/// keys with one request. The matches are then mapped back to the rows of
+/// each buffered batch in input order. The results of the distinct keys can be
+/// kept in a cache bounded by 'index_lookup_join_cache_max_keys' to serve the
+/// repeated keys of later batches without a lookup.
 class IndexLookupJoin : public Operator {
  public:
+  /// Runtime stats of the batched lookups. 'lookupKeys' is the number of
+  /// distinct keys looked up in the index source, 'lookupCacheHits' is the
+  /// number of input rows served from the cache and 'lookupDuplicateKeys' is
+  /// the number of input rows whose key is looked up for an earlier row.
+  static inline const std::string kLookupKeys{"lookupKeys"};
+  static inline const std::string kLookupCacheHits{"lookupCacheHits"};
+  static inline const std::string kLookupDuplicateKeys{"lookupDuplicateKeys"};
+
   IndexLookupJoin(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -33,7 +51,13 @@ class IndexLookupJoin : public Operator {
     if (noMoreInput_ || input_ != nullptr) {
       return false;
     }
-    return true;
+    if (maxBatchedInputs_ == 0) {
+      return true;
+    }
+    // Stops buffering inputs once the batched lookup is started.
+    return batchLookupIter_ == nullptr &&
+        batchedInputs_.size() < maxBatchedInputs_ &&
+        (batchedInputs_.empty() || batchedInputs_.front().result == nullptr);
   }
 
   void addInput(RowVectorPtr input) override;
@@ -41,7 +65,7 @@ class IndexLookupJoin : public Operator {
   RowVectorPtr getOutput() override;
 
   bool isFinished() override {
-    return noMoreInput_ && input_ == nullptr;
+    return noMoreInput_ && input_ == nullptr && batchedInputs_.empty();
   }
 
   void close() override;
@@ -56,6 +80,77 @@ class IndexLookupJoin : public Operator {
 
   void lookup();
 
+  // The results of one batched lookup. 'keys' are the distinct keys looked up
+  // and 'results' their matches, with the matches of key i in rows
+  // [offsets[i], offsets[i + 1]).
+  struct LookupGeneration {
+    RowVectorPtr keys;
+    RowVectorPtr results;
+    std::vector<vector_size_t> offsets;
+  };
+
+  // Refers to the matches of key 'index' in 'generation'.
+  struct KeyRef {
+    const LookupGeneration* generation;
+    vector_size_t index;
+  };
+
+  // Refers to the lookup key in 'row' of 'keys'.
+  struct KeyRow {
+    const RowVector* keys;
+    vector_size_t row;
+    uint64_t hash;
+  };
+
+  struct KeyRowHasher {
+    size_t operator()(const KeyRow& key) const {
+      return key.hash;
+    }
+  };
+
+  struct KeyRowComparer {
+    bool operator()(const KeyRow& left, const KeyRow& right) const {
+      return left.keys->equalValueAt(right.keys, left.row, right.row);
+    }
+  };
+
+  using KeyRowMap =
+      folly::F14FastMap<KeyRow, KeyRef, KeyRowHasher, KeyRowComparer>;
+
+  // An input batch buffered for a batched lookup.
+  struct BatchedInput {
+    RowVectorPtr input;
+    // The lookup input columns of 'input'.
+    RowVectorPtr keys;
+    // The key of each row of 'input'.
+    std::vector<KeyRef> keyRefs;
+    // The matches of 'input' in input row order. Set once the batched lookup
+    // is done.
+    std::unique_ptr<connector::IndexSource::LookupResult> result;
+  };
+
+  // Sets 'input_' to the next buffered input with its matches. Starts the
+  // batched lookup of the buffered inputs if enough inputs are buffered.
+  // Returns false if there is no input ready for output processing.
+  bool nextBatchedInput();
+
+  // Deduplicates the keys of 'batchedInputs_', serves the keys found in
+  // 'lookupCache_' and starts the lookup of the remaining distinct keys.
+  void startBatchedLookup();
+
+  // Fetches all the results of 'batchLookupIter_'. Returns false if blocked
+  // waiting for 'lookupFuture_'.
+  bool fetchBatchedLookupResults();
+
+  // Builds the matches of each buffered input after the batched lookup is
+  // done and adds the looked up keys to 'lookupCache_'.
+  void finishBatchedLookup();
+
+  std::unique_ptr<connector::IndexSource::LookupResult> makeBatchedLookupResult(
+      const BatchedInput& batchedInput);
+
+  void updateLookupCache(std::shared_ptr<LookupGeneration> generation);
+
   RowVectorPtr getOutputFromLookupResult();
   RowVectorPtr produceOutputForInnerJoin();
   RowVectorPtr produceOutputForLeftJoin();
@@ -86,6 +181,11 @@ class IndexLookupJoin : public Operator {
 
   // Maximum number of rows in the output batch.
   const vector_size_t outputBatchSize_;
+  // The maximum number of input batches looked up with one request, 0 if each
+  // input batch is looked up on its own.
+  const uint32_t maxBatchedInputs_;
+  // The maximum number of distinct keys in 'lookupCache_'.
+  const uint32_t cacheMaxKeys_;
   // Type of join.
   const core::JoinType joinType_;
   const size_t numKeys_;
@@ -156,5 +256,20 @@ class IndexLookupJoin : public Operator {
 
   // The reusable output vector for the join output.
   RowVectorPtr output_;
+
+  // The input batches buffered for the next batched lookup, or waiting for
+  // output processing after the lookup is done.
+  std::deque<BatchedInput> batchedInputs_;
+  // The distinct keys and the matches of the batched lookup in progress.
+  std::shared_ptr<LookupGeneration> pendingGeneration_;
+  // Set while fetching the results of the batched lookup.
+  std::shared_ptr<connector::IndexSource::LookupResultIterator>
+      batchLookupIter_;
+  std::vector<std::unique_ptr<connector::IndexSource::LookupResult>>
+      batchLookupResults_;
+
+  // Maps the cached keys to their matches in 'cacheGenerations_'.
+  KeyRowMap lookupCache_;
+  std::vector<std::shared_ptr<LookupGeneration>> cacheGenerations_;
 };
 } // namespace facebook::velox::exec
@@ -37,6 +37,14 @@ Limit::Limit(
   }
 }
 
+void Limit::initialize() {
+  Operator::initialize();
+  if (remainingLimit_ <=
+      std::numeric_limits<int64_t>::max() - remainingOffset_) {
+    driverCtx_->driver->pushdownLimit(this, remainingOffset_ + remainingLimit_);
+  }
+}
+
 bool Limit::needsInput() const {
   return !finished_ && input_ == nullptr;
 }
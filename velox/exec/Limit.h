@@ -24,6 +24,8 @@ class Limit : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::LimitNode>& limitNode);
 
+  void initialize() override;
+
   bool needsInput() const override;
 
   void addInput(RowVectorPtr input) override;
@@ -29,26 +29,36 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
+  }
 
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  std::lock_guard<std::mutex> l(mutex_);
+  // Publish the intent to wait before re-checking. A consumer that has freed
+  // memory in the meantime either sees 'hasPromises_' and takes the mutex to
+  // fulfill the promise below, or its decrease is visible here.
+  hasPromises_ = true;
+  if (bufferedBytes_ < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
+  if (bufferedBytes_.fetch_sub(removed) - removed >= maxBufferSize_ ||
+      !hasPromises_) {
+    return {};
+  }
+
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
-
     if (bufferedBytes_ < maxBufferSize_) {
+      hasPromises_ = false;
       promises = std::move(promises_);
     }
   }
@@ -81,22 +91,23 @@ RowVectorPtr LocalExchangeVectorPool::pop() {
 }
 
 void LocalExchangeQueue::addProducer() {
-  queue_.withWLock([&](auto& /*queue*/) {
-    VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
-    ++pendingProducers_;
-  });
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
+  ++pendingProducers_;
 }
 
 void LocalExchangeQueue::noMoreProducers() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!noMoreProducers_, "noMoreProducers can be called only once");
     noMoreProducers_ = true;
     if (pendingProducers_ == 0) {
       // No more data will be produced.
+      consumersWaiting_ = false;
       consumerPromises = std::move(consumerPromises_);
     }
-  });
+  }
   notify(consumerPromises);
 }
 
@@ -104,27 +115,25 @@ BlockingReason LocalExchangeQueue::enqueue(
     RowVectorPtr input,
     int64_t inputBytes,
     ContinueFuture* future) {
-  std::vector<ContinuePromise> consumerPromises;
-  bool blockedOnConsumer = false;
-  bool isClosed = queue_.withWLock([&](auto& queue) {
-    if (closed_) {
-      return true;
-    }
-    queue.emplace(std::move(input), inputBytes);
-    consumerPromises = std::move(consumerPromises_);
-
-    if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
-      blockedOnConsumer = true;
-    }
-
-    return false;
-  });
-
-  if (isClosed) {
+  if (closed_) {
     return BlockingReason::kNotBlocked;
   }
 
-  notify(consumerPromises);
+  // Account the memory before the data becomes visible so that a consumer
+  // never releases bytes which have not been added yet.
+  const bool blockedOnConsumer =
+      memoryManager_->increaseMemoryUsage(future, inputBytes);
+  queue_.enqueue({std::move(input), inputBytes});
+
+  // Pairs with the fences in next() and close(): either the data is seen
+  // there, or 'consumersWaiting_' and 'closed_' are seen here.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (closed_) {
+    // close() may have drained the queue before the data above was added.
+    drain();
+  } else {
+    notifyConsumers();
+  }
 
   if (blockedOnConsumer) {
     return BlockingReason::kWaitForConsumer;
@@ -135,13 +144,15 @@ BlockingReason LocalExchangeQueue::enqueue(
 
 void LocalExchangeQueue::noMoreData() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK_GT(pendingProducers_, 0);
     --pendingProducers_;
     if (noMoreProducers_ && pendingProducers_ == 0) {
+      consumersWaiting_ = false;
       consumerPromises = std::move(consumerPromises_);
     }
-  });
+  }
   notify(consumerPromises);
 }
 
@@ -149,12 +160,17 @@ BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
-  int64_t size;
-  std::vector<ContinuePromise> memoryPromises;
-  auto blockingReason = queue_.withWLock([&](auto& queue) {
-    *data = nullptr;
-    if (queue.empty()) {
-      if (isFinishedLocked(queue)) {
+  *data = nullptr;
+  std::pair<RowVectorPtr, int64_t> item;
+  if (!queue_.try_dequeue(item)) {
+    std::lock_guard<std::mutex> l(mutex_);
+    consumersWaiting_ = true;
+    // Pairs with the fence in enqueue(). Re-check the queue after announcing
+    // the wait so that a producer that did not see 'consumersWaiting_' has its
+    // data seen here.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!queue_.try_dequeue(item)) {
+      if (isFinishedLocked()) {
         return BlockingReason::kNotBlocked;
       }
 
@@ -163,27 +179,50 @@ BlockingReason LocalExchangeQueue::next(
 
       return BlockingReason::kWaitForProducer;
     }
+  }
 
-    std::tie(*data, size) = std::move(queue.front());
-    queue.pop();
+  int64_t size;
+  std::tie(*data, size) = std::move(item);
+  auto memoryPromises = memoryManager_->decreaseMemoryUsage(size);
+  notify(memoryPromises);
+  vectorPool_->push(*data, size);
+  return BlockingReason::kNotBlocked;
+}
 
-    memoryPromises = memoryManager_->decreaseMemoryUsage(size);
+void LocalExchangeQueue::notifyConsumers() {
+  if (!consumersWaiting_) {
+    return;
+  }
 
-    return BlockingReason::kNotBlocked;
-  });
-  notify(memoryPromises);
-  if (*data != nullptr) {
-    vectorPool_->push(*data, size);
+  std::vector<ContinuePromise> consumerPromises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    consumersWaiting_ = false;
+    consumerPromises = std::move(consumerPromises_);
+  }
+  notify(consumerPromises);
+}
+
+void LocalExchangeQueue::drain() {
+  int64_t freedBytes = 0;
+  std::pair<RowVectorPtr, int64_t> item;
+  while (queue_.try_dequeue(item)) {
+    freedBytes += item.second;
+  }
+
+  if (freedBytes) {
+    auto memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
+    notify(memoryPromises);
   }
-  return blockingReason;
 }
 
-bool LocalExchangeQueue::isFinishedLocked(const Queue& queue) const {
+bool LocalExchangeQueue::isFinishedLocked() const {
   if (closed_) {
     return true;
   }
 
-  if (noMoreProducers_ && pendingProducers_ == 0 && queue.empty()) {
+  // No producer can add data at this point, so the emptiness check is exact.
+  if (noMoreProducers_ && pendingProducers_ == 0 && queue_.empty()) {
     return true;
   }
 
@@ -191,33 +230,32 @@ bool LocalExchangeQueue::isFinishedLocked(const Queue& queue) const {
 }
 
 bool LocalExchangeQueue::isFinished() {
-  return queue_.withWLock([&](auto& queue) { return isFinishedLocked(queue); });
+  std::lock_guard<std::mutex> l(mutex_);
+  return isFinishedLocked();
+}
+
+bool LocalExchangeQueue::isClosed() const {
+  return closed_;
 }
 
 bool LocalExchangeQueue::testingProducersDone() const {
-  return queue_.withRLock(
-      [&](auto& queue) { return noMoreProducers_ && pendingProducers_ == 0; });
+  std::lock_guard<std::mutex> l(mutex_);
+  return noMoreProducers_ && pendingProducers_ == 0;
 }
 
 void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> consumerPromises;
-  std::vector<ContinuePromise> memoryPromises;
-  queue_.withWLock([&](auto& queue) {
-    uint64_t freedBytes = 0;
-    while (!queue.empty()) {
-      freedBytes += queue.front().second;
-      queue.pop();
-    }
-
-    if (freedBytes) {
-      memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
-    }
-
-    consumerPromises = std::move(consumerPromises_);
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     closed_ = true;
-  });
+    consumersWaiting_ = false;
+    consumerPromises = std::move(consumerPromises_);
+  }
+  // Pairs with the fence in enqueue(): a producer racing with close() either
+  // sees 'closed_' and drains its own data, or its data is drained here.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  drain();
   notify(consumerPromises);
-  notify(memoryPromises);
 }
 
 LocalExchange::LocalExchange(
@@ -435,10 +473,18 @@ void LocalPartition::noMoreInput() {
 }
 
 bool LocalPartition::isFinished() {
-  if (!futures_.empty() || !noMoreInput_) {
+  if (!futures_.empty()) {
     return false;
   }
 
-  return true;
+  return noMoreInput_ || allQueuesClosed();
+}
+
+bool LocalPartition::allQueuesClosed() {
+  while (numClosedQueues_ < queues_.size() &&
+         queues_[numClosedQueues_]->isClosed()) {
+    ++numClosedQueues_;
+  }
+  return numClosedQueues_ == queues_.size();
 }
 } // namespace facebook::velox::exec
@@ -15,13 +15,16 @@
  */
 #pragma once
 
+#include <folly/concurrency/UnboundedQueue.h>
+
 #include "velox/exec/Operator.h"
 #include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The size is updated without locking while under the
+/// limit. The mutex is only taken to block a producer or to unblock producers.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -49,7 +52,11 @@ class LocalExchangeMemoryManager {
  private:
   const int64_t maxBufferSize_;
   std::mutex mutex_;
-  tsan_atomic<int64_t> bufferedBytes_{0};
+  std::atomic<int64_t> bufferedBytes_{0};
+  // True if 'promises_' may be non-empty. Set under 'mutex_' before a producer
+  // re-checks 'bufferedBytes_', so that a concurrent decrease either sees this
+  // or is seen by the producer.
+  std::atomic<bool> hasPromises_{false};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -77,6 +84,11 @@ class LocalExchangeVectorPool {
 /// must be called after all producers have been registered. A producer calls
 /// 'enqueue' multiple time to put the data and calls 'noMoreData' when done.
 /// Consumers call 'next' repeatedly to fetch the data.
+///
+/// The data is kept in a lock-free queue, so that producers and consumers
+/// exchanging data do not serialize on a mutex. The mutex protects the
+/// producer counts and the promises of blocked consumers. A producer takes it
+/// only if a consumer is waiting and wakes up all waiting consumers at once.
 class LocalExchangeQueue {
  public:
   LocalExchangeQueue(
@@ -120,6 +132,10 @@ class LocalExchangeQueue {
   /// called before all the data has been processed. No-op otherwise.
   void close();
 
+  /// Returns true if the consumer has closed the queue, so that the producers
+  /// no longer need to produce data for it.
+  bool isClosed() const;
+
   /// Get a reusable vector from the vector pool.  Return nullptr if none is
   /// available.
   RowVectorPtr getVector() {
@@ -130,22 +146,36 @@ class LocalExchangeQueue {
   bool testingProducersDone() const;
 
  private:
-  using Queue = std::queue<std::pair<RowVectorPtr, int64_t>>;
+  using Queue = folly::UMPMCQueue<
+      std::pair<RowVectorPtr, int64_t>,
+      /*MayBlock=*/false>;
+
+  bool isFinishedLocked() const;
+
+  // Wakes up the consumers blocked in next() if there are any.
+  void notifyConsumers();
 
-  bool isFinishedLocked(const Queue& queue) const;
+  // Removes all the data from 'queue_' and releases its memory.
+  void drain();
 
   const std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const std::shared_ptr<LocalExchangeVectorPool> vectorPool_;
   const int partition_;
 
-  folly::Synchronized<Queue> queue_;
+  Queue queue_;
+
+  mutable std::mutex mutex_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
   std::vector<ContinuePromise> consumerPromises_;
+  // True if 'consumerPromises_' may be non-empty. Set under 'mutex_' before a
+  // consumer re-checks 'queue_', so that a concurrent enqueue either sees this
+  // or its data is seen by the consumer.
+  std::atomic<bool> consumersWaiting_{false};
   int pendingProducers_{0};
   bool noMoreProducers_{false};
-  bool closed_{false};
+  std::atomic<bool> closed_{false};
 };
 
 /// Fetches data for a single partition produced by local exchange from
@@ -214,9 +244,15 @@ class LocalPartition : public Operator {
 
   void noMoreInput() override;
 
+  /// True after noMoreInput() or once the consumers have closed all the
+  /// queues, e.g. after a downstream Limit is satisfied. The Driver then
+  /// finishes without producing the rest of the input.
   bool isFinished() override;
 
  protected:
+  // Returns true if all the queues are closed by their consumers.
+  bool allQueuesClosed();
+
   void prepareForInput(RowVectorPtr& input);
 
   void allocateIndexBuffers(const std::vector<vector_size_t>& sizes);
@@ -234,6 +270,10 @@ class LocalPartition : public Operator {
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
 
+  // The queues before this index are closed. A closed queue is never
+  // reopened.
+  size_t numClosedQueues_{0};
+
   /// Reusable memory for hash calculation.
   std::vector<uint32_t> partitions_;
   /// Reusable buffers for input partitioning.
@@ -25,6 +25,7 @@
 #include "velox/exec/GroupId.h"
 #include "velox/exec/HashAggregation.h"
 #include "velox/exec/HashBuild.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/HashProbe.h"
 #include "velox/exec/IndexLookupJoin.h"
 #include "velox/exec/Limit.h"
@@ -152,8 +153,8 @@ OperatorSupplier makeConsumerSupplier(
           std::dynamic_pointer_cast<const core::MergeJoinNode>(planNode)) {
     auto planNodeId = planNode->id();
     return [planNodeId](int32_t operatorId, DriverCtx* ctx) {
-      auto source =
-          ctx->task->getMergeJoinSource(ctx->splitGroupId, planNodeId);
+      auto source = ctx->task->getMergeJoinSource(
+          ctx->splitGroupId, planNodeId, ctx->partitionId);
       auto consumer = [source](RowVectorPtr input, ContinueFuture* future) {
         return source->enqueue(std::move(input), future);
       };
@@ -196,11 +197,93 @@ void plan(
   currentPlanNodes->push_back(planNode);
 }
 
+// Returns true if 'source' repartitions its input by hash of 'keys'.
+bool isHashPartitionedOn(
+    const core::PlanNodePtr& source,
+    const std::vector<core::FieldAccessTypedExprPtr>& keys) {
+  auto localPartition =
+      std::dynamic_pointer_cast<const core::LocalPartitionNode>(source);
+  if (localPartition == nullptr ||
+      localPartition->type() != core::LocalPartitionNode::Type::kRepartition ||
+      localPartition->sources().size() != 1) {
+    return false;
+  }
+  const auto* spec = dynamic_cast<const HashPartitionFunctionSpec*>(
+      &localPartition->partitionFunctionSpec());
+  if (spec == nullptr || spec->keyChannels().size() != keys.size()) {
+    return false;
+  }
+  const auto& inputType = localPartition->sources()[0]->outputType();
+  for (auto i = 0; i < keys.size(); ++i) {
+    const auto channel = spec->keyChannels()[i];
+    if (channel >= inputType->size() ||
+        inputType->nameOf(channel) != keys[i]->name()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if 'node' is a merge join whose inputs are both hash
+// partitioned on the join keys. Such a join runs a driver per partition, each
+// joining the matching partitions of the two sides. Rows with equal keys are
+// in the same partition on both sides, so the joins of the partitions do not
+// overlap.
+bool isPartitionedMergeJoin(const core::PlanNodePtr& node) {
+  auto mergeJoin = std::dynamic_pointer_cast<const core::MergeJoinNode>(node);
+  if (mergeJoin == nullptr) {
+    return false;
+  }
+  const auto& leftKeys = mergeJoin->leftKeys();
+  const auto& rightKeys = mergeJoin->rightKeys();
+  for (auto i = 0; i < leftKeys.size(); ++i) {
+    // Values of different types may hash to different partitions.
+    if (!leftKeys[i]->type()->equivalent(*rightKeys[i]->type())) {
+      return false;
+    }
+  }
+  return isHashPartitionedOn(mergeJoin->sources()[0], leftKeys) &&
+      isHashPartitionedOn(mergeJoin->sources()[1], rightKeys);
+}
+
+// Sets the number of drivers of the pipelines around partitioned merge joins.
+// Each partition of a sorted input stays sorted only if it has a single
+// producer, so the pipelines that produce the partitions run single-threaded.
+// The two sides of the join must have the same number of partitions, which is
+// the number of drivers of the pipelines that consume them.
+void setPartitionedMergeJoinMaxDrivers(
+    std::vector<std::unique_ptr<DriverFactory>>& driverFactories) {
+  for (auto& factory : driverFactories) {
+    for (const auto& node : factory->planNodes) {
+      if (!isPartitionedMergeJoin(node)) {
+        continue;
+      }
+      std::vector<DriverFactory*> consumers;
+      for (const auto& source : node->sources()) {
+        for (auto& other : driverFactories) {
+          if (other->consumerNode == source) {
+            other->maxDrivers = 1;
+          } else if (other->planNodes.front() == source) {
+            consumers.push_back(other.get());
+          }
+        }
+      }
+      VELOX_CHECK_EQ(consumers.size(), 2);
+      const auto numDrivers =
+          std::min(consumers[0]->maxDrivers, consumers[1]->maxDrivers);
+      consumers[0]->maxDrivers = numDrivers;
+      consumers[1]->maxDrivers = numDrivers;
+    }
+  }
+}
+
 // Sometimes consumer limits the number of drivers its producer can run.
 uint32_t maxDriversForConsumer(
     const std::shared_ptr<const core::PlanNode>& node) {
-  if (std::dynamic_pointer_cast<const core::MergeJoinNode>(node)) {
-    // MergeJoinNode must run single-threaded.
+  if (std::dynamic_pointer_cast<const core::MergeJoinNode>(node) &&
+      !isPartitionedMergeJoin(node)) {
+    // MergeJoinNode must run single-threaded unless its inputs are
+    // partitioned.
     return 1;
   }
   return std::numeric_limits<uint32_t>::max();
@@ -225,9 +308,15 @@ uint32_t maxDrivers(
       if (!values->isParallelizable()) {
         return 1;
       }
-    } else if (std::dynamic_pointer_cast<const core::ArrowStreamNode>(node)) {
-      // ArrowStream node must run single-threaded.
-      return 1;
+    } else if (
+        auto arrowStream =
+            std::dynamic_pointer_cast<const core::ArrowStreamNode>(node)) {
+      // A stream is read by a single driver.
+      const auto numStreams = arrowStream->arrowStreams().size();
+      if (numStreams == 1) {
+        return 1;
+      }
+      count = std::min<uint32_t>(numStreams, count);
     } else if (
         auto limit = std::dynamic_pointer_cast<const core::LimitNode>(node)) {
       // final limit must run single-threaded
@@ -261,8 +350,10 @@ uint32_t maxDrivers(
       // Merge exchange must run single-threaded.
       return 1;
     } else if (std::dynamic_pointer_cast<const core::MergeJoinNode>(node)) {
-      // Merge join must run single-threaded.
-      return 1;
+      // Merge join must run single-threaded unless its inputs are partitioned.
+      if (!isPartitionedMergeJoin(node)) {
+        return 1;
+      }
     } else if (
         auto join = std::dynamic_pointer_cast<const core::HashJoinNode>(node)) {
       // Right semi project doesn't support multi-threaded execution.
@@ -331,6 +422,15 @@ void LocalPlanner::plan(
   // Determine number of drivers for each pipeline.
   for (auto& factory : *driverFactories) {
     factory->maxDrivers = detail::maxDrivers(*factory, queryConfig);
+  }
+  detail::setPartitionedMergeJoinMaxDrivers(*driverFactories);
+  if (queryConfig.fragmentResultCacheEnabled()) {
+    for (auto& factory : *driverFactories) {
+      factory->cacheableFragment =
+          FragmentResultCache::makeFragment(factory->planNodes);
+    }
+  }
+  for (auto& factory : *driverFactories) {
     factory->numDrivers = std::min(factory->maxDrivers, maxDrivers);
 
     // Pipelines running grouped/bucketed execution would have separate groups
@@ -451,6 +551,10 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     std::function<int(int pipelineId)> numDrivers) {
   auto driver = std::shared_ptr<Driver>(new Driver());
   ctx->driver = driver.get();
+  if (cacheableFragment.has_value()) {
+    ctx->fragmentResultCache =
+        std::make_shared<FragmentResultCache>(cacheableFragment.value());
+  }
   std::vector<std::unique_ptr<Operator>> operators;
   operators.reserve(planNodes.size());
 
@@ -600,7 +704,8 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
         auto mergeJoin =
             std::dynamic_pointer_cast<const core::MergeJoinNode>(planNode)) {
       auto mergeJoinOp = std::make_unique<MergeJoin>(id, ctx.get(), mergeJoin);
-      ctx->task->createMergeJoinSource(ctx->splitGroupId, mergeJoin->id());
+      ctx->task->createMergeJoinSource(
+          ctx->splitGroupId, mergeJoin->id(), ctx->partitionId);
       operators.push_back(std::move(mergeJoinOp));
     } else if (
         auto localPartitionNode =
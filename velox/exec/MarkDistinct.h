@@ -16,11 +16,19 @@
 
 #pragma once
 
-#include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
+/// Marks the first row of each combination of the distinct keys. Under memory
+/// pressure, spills the keys seen so far partitioned by hash bits and then
+/// spills all further input to the same partitions. After all the input is
+/// seen, restores the partitions one at a time: loads the spilled keys of the
+/// partition into the hash table and then marks the spilled input of the
+/// partition. The output order of the spilled input is then not preserved.
 class MarkDistinct : public Operator {
  public:
   MarkDistinct(
@@ -29,7 +37,7 @@ class MarkDistinct : public Operator {
       const std::shared_ptr<const core::MarkDistinctNode>& planNode);
 
   bool preservesOrder() const override {
-    return true;
+    return !canSpill();
   }
 
   bool needsInput() const override {
@@ -38,6 +46,8 @@ class MarkDistinct : public Operator {
 
   void addInput(RowVectorPtr input) override;
 
+  void noMoreInput() override;
+
   RowVectorPtr getOutput() override;
 
   BlockingReason isBlocked(ContinueFuture* /*future*/) override {
@@ -46,8 +56,95 @@ class MarkDistinct : public Operator {
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
-  // TODO: Document spilling configuration in spilling.rst.
-  std::unique_ptr<GroupingSet> groupingSet_;
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  // Adds the keys of 'input' to 'table_' and sets the distinct marks of its
+  // rows in 'results_'. Spills 'input' instead if spilling has been
+  // triggered.
+  void markDistinct(RowVectorPtr input);
+
+  void ensureInputFits(const RowVectorPtr& input);
+
+  void spill();
+
+  // Spills the keys in 'table_' and clears it. Returns the spilled partitions.
+  SpillPartitionNumSet spillHashTable();
+
+  void setupInputSpiller(const SpillPartitionNumSet& spillPartitionSet);
+
+  void spillInput(const RowVectorPtr& input, memory::MemoryPool* pool);
+
+  // Finishes the current input spilling and restores the next partition.
+  void finishSpillInputAndRestoreNext();
+
+  // Loads the spilled keys of the next spilled input partition into 'table_'
+  // and adds the first batch of its spilled input.
+  void restoreNextSpillPartition();
+
+  // Reads the rest of the spilled input of the partition being restored and
+  // spills it again into sub-partitions after a spill during the restore.
+  // Then restores the next partition.
+  void recursiveSpillInput();
+
+  // Sets 'spillPartitionBits_' for the first spill if 'restoredPartitionId'
+  // is null, or for the spill of a restored partition otherwise. Sets
+  // 'exceededMaxSpillLevelLimit_' if the bits exceed the max spill level.
+  void setSpillPartitionBits(
+      const SpillPartitionId* restoredPartitionId = nullptr);
+
+  const RowTypePtr inputType_;
+
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+
+  // The spill partition bits used by both the hash table and input spills.
+  HashBitRange spillPartitionBits_;
+
+  SpillPartitionSet spillHashTablePartitionSet_;
+
+  // Spiller for the input received after spilling has been triggered.
+  std::unique_ptr<NoRowContainerSpiller> inputSpiller_;
+
+  // Used to restore the spilled input of a partition.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
+
+  SpillPartitionSet spillInputPartitionSet_;
+
+  // Used to calculate the spill partition numbers of the inputs.
+  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
+
+  // True if the driver should yield while spilling restored input again.
+  bool yield_{false};
+
+  bool exceededMaxSpillLevelLimit_{false};
+};
+
+class MarkDistinctHashTableSpiller : public SpillerBase {
+ public:
+  static constexpr std::string_view kType = "MarkDistinctHashTableSpiller";
+
+  MarkDistinctHashTableSpiller(
+      RowContainer* container,
+      RowTypePtr rowType,
+      HashBitRange bits,
+      const common::SpillConfig* spillConfig,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
+  void spill();
+
+ private:
+  bool needSort() const override {
+    return false;
+  }
+
+  std::string type() const override {
+    return std::string(kType);
+  }
 };
 } // namespace facebook::velox::exec
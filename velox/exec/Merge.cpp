@@ -18,6 +18,8 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Task.h"
 
+#include <algorithm>
+
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
@@ -167,16 +169,26 @@ RowVectorPtr Merge::getOutput() {
       return std::move(output_);
     }
 
-    if (stream->setOutputRow(outputSize_)) {
+    vector_size_t numRows = 1;
+    if (stream != lastStream_) {
+      lastStream_ = stream;
+      numSameStream_ = 0;
+    } else if (++numSameStream_ >= kMinGallop) {
+      // Take all the rows of 'stream' that come before the next-best stream.
+      numRows = stream->runLength(
+          treeOfLosers_->runnerUp(), outputBatchSize_ - outputSize_);
+    }
+
+    if (stream->setOutputRows(outputSize_, numRows)) {
       // The stream is at end of input batch. Need to copy out the rows before
       // fetching next batch in 'pop'.
       stream->copyToOutput(output_);
     }
 
-    ++outputSize_;
+    outputSize_ += numRows;
 
     // Advance the stream.
-    stream->pop(sourceBlockingFutures_);
+    stream->pop(sourceBlockingFutures_, numRows);
 
     if (outputSize_ == outputBatchSize_) {
       // Copy out data from all sources.
@@ -200,30 +212,72 @@ void Merge::close() {
   }
 }
 
-bool SourceStream::operator<(const MergeStream& other) const {
-  const auto& otherCursor = static_cast<const SourceStream&>(other);
+int32_t SourceStream::compareRow(
+    vector_size_t row,
+    const SourceStream& other) const {
   for (auto i = 0; i < sortingKeys_.size(); ++i) {
     const auto& [_, compareFlags] = sortingKeys_[i];
     VELOX_DCHECK(
         compareFlags.nullAsValue(), "not supported null handling mode");
     if (auto result = keyColumns_[i]
                           ->compare(
-                              otherCursor.keyColumns_[i],
-                              currentSourceRow_,
-                              otherCursor.currentSourceRow_,
+                              other.keyColumns_[i],
+                              row,
+                              other.currentSourceRow_,
                               compareFlags)
                           .value()) {
-      return result < 0;
+      return result;
     }
   }
-  return false;
+  return 0;
 }
 
-bool SourceStream::pop(std::vector<ContinueFuture>& futures) {
-  ++currentSourceRow_;
+bool SourceStream::operator<(const MergeStream& other) const {
+  return compareRow(
+             currentSourceRow_, static_cast<const SourceStream&>(other)) < 0;
+}
+
+vector_size_t SourceStream::runLength(
+    const SourceStream* other,
+    vector_size_t maxRows) const {
+  const vector_size_t end =
+      std::min<int64_t>(data_->size(), currentSourceRow_ + maxRows);
+  if (other == nullptr) {
+    return end - currentSourceRow_;
+  }
+
+  // 'low' is the last row known to be not greater than 'other' and 'high' is
+  // the first row known to be greater or 'end'.
+  vector_size_t low = currentSourceRow_;
+  vector_size_t high = end;
+  vector_size_t step = 1;
+  while (low + step < end) {
+    if (compareRow(low + step, *other) > 0) {
+      high = low + step;
+      break;
+    }
+    low += step;
+    step *= 2;
+  }
+  while (high - low > 1) {
+    const auto middle = low + (high - low) / 2;
+    if (compareRow(middle, *other) > 0) {
+      high = middle;
+    } else {
+      low = middle;
+    }
+  }
+  return low + 1 - currentSourceRow_;
+}
+
+bool SourceStream::pop(
+    std::vector<ContinueFuture>& futures,
+    vector_size_t numRows) {
+  currentSourceRow_ += numRows;
+  VELOX_DCHECK_LE(currentSourceRow_, data_->size());
   if (currentSourceRow_ == data_->size()) {
     // Make sure all current data has been copied out.
-    VELOX_CHECK(!outputRows_.hasSelections());
+    VELOX_CHECK(outputRanges_.empty());
     return fetchMoreData(futures);
   }
 
@@ -231,28 +285,17 @@ bool SourceStream::pop(std::vector<ContinueFuture>& futures) {
 }
 
 void SourceStream::copyToOutput(RowVectorPtr& output) {
-  outputRows_.updateBounds();
-
-  if (!outputRows_.hasSelections()) {
+  if (outputRanges_.empty()) {
     return;
   }
 
-  vector_size_t sourceRow = firstSourceRow_;
-  outputRows_.applyToSelected(
-      [&](auto row) { sourceRows_[row] = sourceRow++; });
-
+  const folly::Range<const BaseVector::CopyRange*> ranges(
+      outputRanges_.data(), outputRanges_.size());
   for (auto i = 0; i < output->type()->size(); ++i) {
-    output->childAt(i)->copy(
-        data_->childAt(i).get(), outputRows_, sourceRows_.data());
+    output->childAt(i)->copyRanges(data_->childAt(i).get(), ranges);
   }
 
-  outputRows_.clearAll();
-
-  if (sourceRow == data_->size()) {
-    firstSourceRow_ = 0;
-  } else {
-    firstSourceRow_ = sourceRow;
-  }
+  outputRanges_.clear();
 }
 
 bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
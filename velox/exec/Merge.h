@@ -58,6 +58,11 @@ class Merge : public SourceOperator {
  private:
   void initializeTreeOfLosers();
 
+  /// Number of consecutive rows from a stream after which the merge starts
+  /// galloping for a run. Avoids the extra comparisons on interleaved inputs
+  /// where runs are short.
+  static constexpr int32_t kMinGallop = 7;
+
   /// Maximum number of rows in the output batch.
   const vector_size_t outputBatchSize_;
 
@@ -75,6 +80,13 @@ class Merge : public SourceOperator {
   /// Number of rows accumulated in 'output_' so far.
   vector_size_t outputSize_{0};
 
+  /// The stream that produced the last output row and the number of
+  /// consecutive output rows it produced before that. Once a stream wins
+  /// 'kMinGallop' times in a row, the merge looks for a run of rows in it that
+  /// come before the next-best stream and outputs the run at once.
+  SourceStream* lastStream_{nullptr};
+  int32_t numSameStream_{0};
+
   bool finished_{false};
 
   /// A list of blocking futures for sources. These are populates when a given
@@ -88,11 +100,9 @@ class SourceStream final : public MergeStream {
       MergeSource* source,
       const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
       uint32_t outputBatchSize)
-      : source_{source},
-        sortingKeys_{sortingKeys},
-        outputRows_(outputBatchSize, false),
-        sourceRows_(outputBatchSize) {
+      : source_{source}, sortingKeys_{sortingKeys} {
     keyColumns_.reserve(sortingKeys.size());
+    outputRanges_.reserve(outputBatchSize);
   }
 
   /// Returns true and appends a future to 'futures' if needs to wait for the
@@ -112,20 +122,39 @@ class SourceStream final : public MergeStream {
   /// 'other'.
   bool operator<(const MergeStream& other) const override;
 
-  /// Advances to the next row. Returns true and appends a future to 'futures'
-  /// if runs out of rows in the current batch and needs to wait for the
-  /// source to produce the next batch. The return flag has the meaning of
+  /// Returns the number of rows starting at the current row that are not
+  /// greater than the current row of 'other', up to 'maxRows' and the end of
+  /// the current batch. Returns the number of remaining rows up to 'maxRows'
+  /// if 'other' is nullptr. The current row must not be greater than the
+  /// current row of 'other'. Gallops forward with doubling steps and then
+  /// binary searches the last step, so a run of n rows takes O(log(n))
+  /// comparisons.
+  vector_size_t runLength(const SourceStream* other, vector_size_t maxRows)
+      const;
+
+  /// Advances by 'numRows' rows. Returns true and appends a future to
+  /// 'futures' if runs out of rows in the current batch and needs to wait for
+  /// the source to produce the next batch. The return flag has the meaning of
   /// 'is-blocked'.
-  bool pop(std::vector<ContinueFuture>& futures);
-
-  /// Records the output row number for the current row. Returns true if
-  /// current row is the last row in the current batch, in which case the
-  /// caller must call 'copyToOutput' before calling pop(). The caller must
-  /// call 'setOutputRow' before calling 'pop'. The output rows must
-  /// monotonically increase in between calls to 'copyToOutput'.
-  bool setOutputRow(vector_size_t row) {
-    outputRows_.setValid(row, true);
-    return currentSourceRow_ == data_->size() - 1;
+  bool pop(std::vector<ContinueFuture>& futures, vector_size_t numRows = 1);
+
+  /// Records the output row numbers starting at 'row' for 'numRows' rows
+  /// starting at the current row. Returns true if the last of these rows is
+  /// the last row in the current batch, in which case the caller must call
+  /// 'copyToOutput' before calling pop(). The caller must call
+  /// 'setOutputRows' before calling 'pop'. The output rows must monotonically
+  /// increase in between calls to 'copyToOutput'.
+  bool setOutputRows(vector_size_t row, vector_size_t numRows = 1) {
+    if (!outputRanges_.empty()) {
+      auto& last = outputRanges_.back();
+      if (last.sourceIndex + last.count == currentSourceRow_ &&
+          last.targetIndex + last.count == row) {
+        last.count += numRows;
+        return currentSourceRow_ + numRows == data_->size();
+      }
+    }
+    outputRanges_.push_back({currentSourceRow_, row, numRows});
+    return currentSourceRow_ + numRows == data_->size();
   }
 
   /// Called if either current row is the last row in the current batch or the
@@ -136,6 +165,9 @@ class SourceStream final : public MergeStream {
  private:
   bool fetchMoreData(std::vector<ContinueFuture>& futures);
 
+  // Compares 'row' in 'this' with the current row in 'other'.
+  int32_t compareRow(vector_size_t row, const SourceStream& other) const;
+
   MergeSource* source_;
 
   const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys_;
@@ -157,14 +189,10 @@ class SourceStream final : public MergeStream {
   /// returned by 'source_->next()'.
   bool needData_{true};
 
-  /// First source row that hasn't been copied out yet.
-  vector_size_t firstSourceRow_{0};
-
-  /// Output row numbers for source rows that haven't been copied out yet.
-  SelectivityVector outputRows_;
-
-  /// Reusable memory.
-  std::vector<vector_size_t> sourceRows_;
+  /// Source and output row ranges for source rows that haven't been copied
+  /// out yet. Consecutive rows that go to consecutive output rows share a
+  /// range.
+  std::vector<BaseVector::CopyRange> outputRanges_;
 };
 
 // LocalMerge merges its source's output into a single stream of
@@ -31,6 +31,7 @@ MergeJoin::MergeJoin(
           joinNode->id(),
           "MergeJoin"),
       outputBatchSize_{outputBatchRows()},
+      outputBatchLimit_{outputBatchSize_},
       joinType_{joinNode->joinType()},
       numKeys_{joinNode->leftKeys().size()},
       joinNode_(joinNode) {
@@ -327,7 +328,7 @@ void MergeJoin::flattenRightProjections() {
   for (const auto& projection : rightProjections_) {
     auto& currentVector = children[projection.outputChannel];
     auto newFlat = BaseVector::create(
-        currentVector->type(), outputBatchSize_, operatorCtx_->pool());
+        currentVector->type(), outputBatchLimit_, operatorCtx_->pool());
     newFlat->copy(currentVector.get(), 0, 0, outputSize_);
     children[projection.outputChannel] = std::move(newFlat);
   }
@@ -401,12 +402,15 @@ bool MergeJoin::prepareOutput(
     return false;
   }
 
+  // Size the new output batch by the current memory pressure of the query.
+  outputBatchLimit_ = memoryPressureAdjustedBatchRows(outputBatchSize_);
+
   // If output is nullptr, first allocate dictionary indices for the left and
   // right side projections.
-  leftIndices_ = allocateIndices(outputBatchSize_, pool());
+  leftIndices_ = allocateIndices(outputBatchLimit_, pool());
   rawLeftIndices_ = leftIndices_->asMutable<vector_size_t>();
 
-  rightIndices_ = allocateIndices(outputBatchSize_, pool());
+  rightIndices_ = allocateIndices(outputBatchLimit_, pool());
   rawRightIndices_ = rightIndices_->asMutable<vector_size_t>();
 
   // Create left side projection outputs.
@@ -415,7 +419,7 @@ bool MergeJoin::prepareOutput(
     for (const auto& projection : leftProjections_) {
       localColumns[projection.outputChannel] = BaseVector::create(
           outputType_->childAt(projection.outputChannel),
-          outputBatchSize_,
+          outputBatchLimit_,
           operatorCtx_->pool());
     }
   } else {
@@ -423,7 +427,7 @@ bool MergeJoin::prepareOutput(
       localColumns[projection.outputChannel] = BaseVector::wrapInDictionary(
           {},
           leftIndices_,
-          outputBatchSize_,
+          outputBatchLimit_,
           newLeft->childAt(projection.inputChannel));
     }
   }
@@ -434,7 +438,7 @@ bool MergeJoin::prepareOutput(
     for (const auto& projection : rightProjections_) {
       localColumns[projection.outputChannel] = BaseVector::create(
           outputType_->childAt(projection.outputChannel),
-          outputBatchSize_,
+          outputBatchLimit_,
           operatorCtx_->pool());
     }
     isRightFlattened_ = true;
@@ -443,7 +447,7 @@ bool MergeJoin::prepareOutput(
       localColumns[projection.outputChannel] = BaseVector::wrapInDictionary(
           {},
           rightIndices_,
-          outputBatchSize_,
+          outputBatchLimit_,
           right->childAt(projection.inputChannel));
     }
     isRightFlattened_ = false;
@@ -454,7 +458,7 @@ bool MergeJoin::prepareOutput(
       operatorCtx_->pool(),
       outputType_,
       nullptr,
-      outputBatchSize_,
+      outputBatchLimit_,
       std::move(localColumns));
   outputSize_ = 0;
 
@@ -566,7 +570,7 @@ bool MergeJoin::addToOutputForLeftJoin() {
         }
 
         for (auto j = rightStart; j < rightEnd; ++j) {
-          if (outputSize_ == outputBatchSize_) {
+          if (outputSize_ == outputBatchLimit_) {
             // If we run out of space in the current output_, we will need to
             // produce a buffer and continue processing left later. In this
             // case, we cannot leave left as a lazy vector, since we cannot have
@@ -590,7 +594,7 @@ bool MergeJoin::addToOutputForLeftJoin() {
   if (input_ && index_ != input_->size()) {
     loadColumns(currentLeft_, *operatorCtx_->execCtx());
   }
-  return outputSize_ == outputBatchSize_;
+  return outputSize_ == outputBatchLimit_;
 }
 
 bool MergeJoin::addToOutputForRightJoin() {
@@ -649,7 +653,7 @@ bool MergeJoin::addToOutputForRightJoin() {
         }
 
         for (auto j = leftStart; j < leftEnd; ++j) {
-          if (outputSize_ == outputBatchSize_) {
+          if (outputSize_ == outputBatchLimit_) {
             // If we run out of space in the current output_, we will need to
             // produce a buffer and continue processing left later. In this
             // case, we cannot leave left as a lazy vector, since we cannot have
@@ -673,7 +677,7 @@ bool MergeJoin::addToOutputForRightJoin() {
   if (rightInput_ && rightIndex_ != rightInput_->size()) {
     loadColumns(currentLeft_, *operatorCtx_->execCtx());
   }
-  return outputSize_ == outputBatchSize_;
+  return outputSize_ == outputBatchLimit_;
 }
 
 namespace {
@@ -765,7 +769,9 @@ RowVectorPtr MergeJoin::getOutput() {
     if (!noMoreRightInput_ && !futureRightSideInput_.valid() && !rightInput_) {
       if (!rightSource_) {
         rightSource_ = operatorCtx_->task()->getMergeJoinSource(
-            operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+            operatorCtx_->driverCtx()->splitGroupId,
+            planNodeId(),
+            operatorCtx_->driverCtx()->partitionId);
       }
 
       while (!noMoreRightInput_ && !rightInput_) {
@@ -885,7 +891,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
           return std::move(output_);
         }
         while (true) {
-          if (outputSize_ == outputBatchSize_) {
+          if (outputSize_ == outputBatchLimit_) {
             return std::move(output_);
           }
           addOutputRowForLeftJoin(input_, index_);
@@ -912,7 +918,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
         }
 
         while (true) {
-          if (outputSize_ == outputBatchSize_) {
+          if (outputSize_ == outputBatchLimit_) {
             return std::move(output_);
           }
           addOutputRowForRightJoin(rightInput_, rightIndex_);
@@ -939,7 +945,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
           return std::move(output_);
         }
         while (true) {
-          if (outputSize_ == outputBatchSize_) {
+          if (outputSize_ == outputBatchLimit_) {
             return std::move(output_);
           }
           addOutputRowForLeftJoin(input_, index_);
@@ -966,7 +972,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
         }
 
         while (true) {
-          if (outputSize_ == outputBatchSize_) {
+          if (outputSize_ == outputBatchLimit_) {
             return std::move(output_);
           }
 
@@ -1014,7 +1020,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
           return std::move(output_);
         }
 
-        if (outputSize_ == outputBatchSize_) {
+        if (outputSize_ == outputBatchLimit_) {
           return std::move(output_);
         }
         addOutputRowForLeftJoin(input_, index_);
@@ -1040,7 +1046,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
           return std::move(output_);
         }
 
-        if (outputSize_ == outputBatchSize_) {
+        if (outputSize_ == outputBatchLimit_) {
           return std::move(output_);
         }
         addOutputRowForRightJoin(rightInput_, rightIndex_);
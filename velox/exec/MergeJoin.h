@@ -451,6 +451,10 @@ class MergeJoin : public Operator {
   // Maximum number of rows in the output batch.
   const vector_size_t outputBatchSize_;
 
+  // Number of rows in the current output batch, which is 'outputBatchSize_'
+  // scaled down by the memory pressure when the batch was allocated.
+  vector_size_t outputBatchLimit_;
+
   // Type of join.
   const core::JoinType joinType_;
 
@@ -160,6 +160,19 @@ class MergeExchangeSource : public MergeSource {
         return BlockingReason::kWaitForProducer;
       }
     }
+    if (const auto& vector = currentPage_->vector()) {
+      // In-process page. Copy the vector into the operator's pool so that the
+      // producer's memory is released with the page.
+      data = std::static_pointer_cast<RowVector>(
+          BaseVector::copy(*vector, mergeExchange_->pool()));
+      auto lockedStats = mergeExchange_->stats().wlock();
+      lockedStats->rawInputBytes += currentPage_->size();
+      lockedStats->addInputVector(data->estimateFlatSize(), data->size());
+      lockedStats->rawInputPositions += data->size();
+      currentPage_ = nullptr;
+      return BlockingReason::kNotBlocked;
+    }
+
     if (inputStream_ == nullptr) {
       mergeExchange_->stats().wlock()->rawInputBytes += currentPage_->size();
       inputStream_ = currentPage_->prepareStreamForDeserialize();
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/NestedLoopJoinProbe.h"
+#include <folly/container/F14Map.h>
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -43,6 +45,94 @@ std::vector<IdentityProjection> extractProjections(
   return projections;
 }
 
+// Appends the top level conjuncts of 'expr' to 'conjuncts'.
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& conjuncts) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call != nullptr && call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(expr);
+}
+
+// Returns true if values of 'type' compare as their physical integer values.
+bool isComparableInteger(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return type->name() == mapTypeKindToName(type->kind()) ||
+          type->isDate();
+    default:
+      return false;
+  }
+}
+
+// Clears the bits of the 'numRows' 'values' for which 'compare(probe,
+// value)' is false. Compares 64 values at a time with SIMD.
+template <typename T, typename Compare>
+void andComparison(
+    T probe,
+    const T* values,
+    vector_size_t numRows,
+    Compare compare,
+    uint64_t* bits) {
+  using Batch = xsimd::batch<T>;
+  static_assert(64 % Batch::size == 0);
+  const auto probeBatch = xsimd::broadcast(probe);
+  vector_size_t row = 0;
+  for (; row + 64 <= numRows; row += 64) {
+    uint64_t word = 0;
+    for (auto i = 0; i < 64; i += Batch::size) {
+      const auto mask = simd::toBitMask(
+          compare(probeBatch, Batch::load_unaligned(values + row + i)));
+      word |= static_cast<uint64_t>(
+                  static_cast<std::make_unsigned_t<decltype(mask)>>(mask))
+          << i;
+    }
+    bits[row / 64] &= word;
+  }
+  for (; row < numRows; ++row) {
+    if (!compare(probe, values[row])) {
+      bits::clearBit(bits, row);
+    }
+  }
+}
+
+template <typename T, typename Op>
+void andComparison(
+    Op op,
+    T probe,
+    const T* values,
+    vector_size_t numRows,
+    uint64_t* bits) {
+  switch (op) {
+    case Op::kEq:
+      return andComparison(
+          probe, values, numRows, [](auto a, auto b) { return a == b; }, bits);
+    case Op::kNeq:
+      return andComparison(
+          probe, values, numRows, [](auto a, auto b) { return a != b; }, bits);
+    case Op::kLt:
+      return andComparison(
+          probe, values, numRows, [](auto a, auto b) { return a < b; }, bits);
+    case Op::kLte:
+      return andComparison(
+          probe, values, numRows, [](auto a, auto b) { return a <= b; }, bits);
+    case Op::kGt:
+      return andComparison(
+          probe, values, numRows, [](auto a, auto b) { return a > b; }, bits);
+    case Op::kGte:
+      return andComparison(
+          probe, values, numRows, [](auto a, auto b) { return a >= b; }, bits);
+  }
+}
+
 } // namespace
 
 NestedLoopJoinProbe::NestedLoopJoinProbe(
@@ -120,6 +210,102 @@ void NestedLoopJoinProbe::initializeFilter(
   }
 
   filterInputType_ = ROW(std::move(names), std::move(types));
+  initializeComparisons(filter, probeType, buildType);
+}
+
+void NestedLoopJoinProbe::initializeComparisons(
+    const core::TypedExprPtr& filter,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  std::vector<core::TypedExprPtr> conjuncts;
+  flattenConjuncts(filter, conjuncts);
+  bool allComparisons = true;
+  for (const auto& conjunct : conjuncts) {
+    auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(conjunct);
+    if (call == nullptr) {
+      allComparisons = false;
+      continue;
+    }
+    const auto& inputs = call->inputs();
+    if (call->name() == "between" && inputs.size() == 3) {
+      // Both sides are evaluated so that each one is used as a prefilter even
+      // if the other one is not a comparison of a probe and build column.
+      const bool lower = addComparison(
+          "gte", inputs[0], inputs[1], probeType, buildType);
+      const bool upper = addComparison(
+          "lte", inputs[0], inputs[2], probeType, buildType);
+      allComparisons &= lower && upper;
+    } else if (inputs.size() == 2) {
+      allComparisons &= addComparison(
+          call->name(), inputs[0], inputs[1], probeType, buildType);
+    } else {
+      allComparisons = false;
+    }
+  }
+  comparisonsOnly_ = allComparisons && !comparisons_.empty();
+}
+
+bool NestedLoopJoinProbe::addComparison(
+    const std::string& name,
+    const core::TypedExprPtr& left,
+    const core::TypedExprPtr& right,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  using Op = Comparison::Op;
+  static const folly::F14FastMap<std::string, Op> kOps = {
+      {"eq", Op::kEq},
+      {"neq", Op::kNeq},
+      {"lt", Op::kLt},
+      {"lte", Op::kLte},
+      {"gt", Op::kGt},
+      {"gte", Op::kGte},
+  };
+  auto it = kOps.find(name);
+  if (it == kOps.end()) {
+    return false;
+  }
+  auto leftField = core::TypedExprs::asFieldAccess(left);
+  auto rightField = core::TypedExprs::asFieldAccess(right);
+  if (leftField == nullptr || rightField == nullptr ||
+      !leftField->isInputColumn() || !rightField->isInputColumn()) {
+    return false;
+  }
+
+  Op op = it->second;
+  auto probeChannel = probeType->getChildIdxIfExists(leftField->name());
+  auto buildChannel = buildType->getChildIdxIfExists(rightField->name());
+  if (!probeChannel.has_value() || !buildChannel.has_value()) {
+    // Tries 'build op probe', which is 'probe op build' for the mirrored op.
+    probeChannel = probeType->getChildIdxIfExists(rightField->name());
+    buildChannel = buildType->getChildIdxIfExists(leftField->name());
+    if (!probeChannel.has_value() || !buildChannel.has_value()) {
+      return false;
+    }
+    switch (op) {
+      case Op::kLt:
+        op = Op::kGt;
+        break;
+      case Op::kLte:
+        op = Op::kGte;
+        break;
+      case Op::kGt:
+        op = Op::kLt;
+        break;
+      case Op::kGte:
+        op = Op::kLte;
+        break;
+      default:
+        break;
+    }
+  }
+
+  const auto& type = probeType->childAt(probeChannel.value());
+  if (!isComparableInteger(type) ||
+      !type->equivalent(*buildType->childAt(buildChannel.value()))) {
+    return false;
+  }
+  comparisons_.push_back({op, probeChannel.value(), buildChannel.value()});
+  return true;
 }
 
 BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
@@ -151,6 +337,7 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
           buildMatched_[i].resizeFill(buildVectors_.value()[i]->size(), false);
         }
       }
+      prepareComparisons();
 
       setState(ProbeOperatorState::kRunning);
       return BlockingReason::kNotBlocked;
@@ -176,6 +363,11 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
     child->loadedVector();
   }
   input_ = std::move(input);
+  comparisonProbeColumns_.resize(comparisons_.size());
+  for (auto i = 0; i < comparisons_.size(); ++i) {
+    comparisonProbeColumns_[i].decode(
+        *input_->childAt(comparisons_[i].probeChannel));
+  }
   if (input_->size() > 0) {
     probeSideEmpty_ = false;
   }
@@ -210,6 +402,72 @@ bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   return true;
 }
 
+void NestedLoopJoinProbe::prepareComparisons() {
+  if (comparisons_.empty()) {
+    return;
+  }
+  comparisonBuildColumns_.resize(buildVectors_->size());
+  for (auto i = 0; i < buildVectors_->size(); ++i) {
+    const auto& buildVector = buildVectors_.value()[i];
+    for (const auto& comparison : comparisons_) {
+      auto column = buildVector->childAt(comparison.buildChannel);
+      if (!column->isFlatEncoding()) {
+        // The build vectors are shared with the peers, so they are not
+        // flattened in place.
+        auto flat = BaseVector::create(column->type(), column->size(), pool());
+        flat->copy(column.get(), 0, 0, column->size());
+        column = std::move(flat);
+      }
+      comparisonBuildColumns_[i].push_back(std::move(column));
+    }
+  }
+}
+
+void NestedLoopJoinProbe::evaluateComparisons(vector_size_t numBuildRows) {
+  comparisonBits_.resize(bits::nwords(numBuildRows));
+  auto* rawBits = comparisonBits_.data();
+  bits::fillBits(rawBits, 0, numBuildRows, true);
+  const auto& buildColumns = comparisonBuildColumns_[buildIndex_];
+  for (auto i = 0; i < comparisons_.size(); ++i) {
+    const auto& probe = comparisonProbeColumns_[i];
+    if (probe.isNullAt(probeRow_)) {
+      // A comparison with null is not true for any build row.
+      bits::fillBits(rawBits, 0, numBuildRows, false);
+      return;
+    }
+    const auto& build = buildColumns[i];
+    const auto op = comparisons_[i].op;
+    auto compare = [&](auto probeValue) {
+      using T = decltype(probeValue);
+      andComparison(
+          op,
+          probeValue,
+          build->asFlatVector<T>()->rawValues(),
+          numBuildRows,
+          rawBits);
+    };
+    switch (build->typeKind()) {
+      case TypeKind::TINYINT:
+        compare(probe.valueAt<int8_t>(probeRow_));
+        break;
+      case TypeKind::SMALLINT:
+        compare(probe.valueAt<int16_t>(probeRow_));
+        break;
+      case TypeKind::INTEGER:
+        compare(probe.valueAt<int32_t>(probeRow_));
+        break;
+      case TypeKind::BIGINT:
+        compare(probe.valueAt<int64_t>(probeRow_));
+        break;
+      default:
+        VELOX_UNREACHABLE("{}", build->type()->toString());
+    }
+    if (build->mayHaveNulls()) {
+      bits::andBits(rawBits, build->rawNulls(), 0, numBuildRows);
+    }
+  }
+}
+
 RowVectorPtr NestedLoopJoinProbe::getOutput() {
   if (state_ == ProbeOperatorState::kFinish ||
       state_ == ProbeOperatorState::kWaitForPeers) {
@@ -326,7 +584,7 @@ bool NestedLoopJoinProbe::addToOutput() {
     }
 
     // Iterate over the filter results. For each match, add an output record.
-    for (size_t i = buildRow_; i < decodedFilterResult_.size(); ++i) {
+    for (size_t i = buildRow_; i < currentBuild->size(); ++i) {
       if (isJoinConditionMatch(i)) {
         addOutputRow(i);
         ++numOutputRows_;
@@ -396,6 +654,18 @@ void NestedLoopJoinProbe::prepareOutput() {
 }
 
 void NestedLoopJoinProbe::evaluateJoinFilter(const RowVectorPtr& buildVector) {
+  if (!comparisons_.empty()) {
+    evaluateComparisons(buildVector->size());
+    if (comparisonsOnly_ ||
+        bits::isAllSet(
+            comparisonBits_.data(), 0, buildVector->size(), false)) {
+      // The join condition is decided by 'comparisons_' alone or no build
+      // row passes them.
+      probeRowCount_ = 1;
+      return;
+    }
+  }
+
   // First step to process is to get a batch so we can evaluate the join
   // filter.
   auto filterInput = getNextCrossProductBatch(
@@ -404,10 +674,16 @@ void NestedLoopJoinProbe::evaluateJoinFilter(const RowVectorPtr& buildVector) {
       filterProbeProjections_,
       filterBuildProjections_);
 
-  if (filterInputRows_.size() != filterInput->size()) {
-    filterInputRows_.resizeFill(filterInput->size(), true);
+  if (!comparisons_.empty()) {
+    // Evaluates the rest of the join condition only on the rows that pass
+    // 'comparisons_'.
+    filterInputRows_.setFromBits(comparisonBits_.data(), filterInput->size());
+  } else {
+    if (filterInputRows_.size() != filterInput->size()) {
+      filterInputRows_.resizeFill(filterInput->size(), true);
+    }
+    VELOX_CHECK(filterInputRows_.isAllSelected());
   }
-  VELOX_CHECK(filterInputRows_.isAllSelected());
 
   std::vector<VectorPtr> filterResult;
   EvalCtx evalCtx(
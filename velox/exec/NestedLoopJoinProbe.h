@@ -61,6 +61,13 @@ namespace facebook::velox::exec {
 /// c) If build side has multiple vectors, take one probe row are at a time,
 /// wrapping it as a constant, and produce it along with build batches.
 ///
+/// For the join condition in c), the top level conjuncts that compare a probe
+/// and a build column of the same integer type are evaluated first with SIMD,
+/// comparing the probe value as a constant against whole build columns. The
+/// rest of the condition is only evaluated for the build rows that pass these
+/// comparisons, and not at all if the condition has no other conjuncts. This
+/// makes range joins like "p.ts BETWEEN b.start AND b.end" cheap.
+///
 /// If needed, buid-side copies are done lazily; it first accumulates the ranges
 /// to be copied, then performs the copies in batch, column-by-column. It
 /// produces at most `outputBatchSize_` records, but it may produce fewer since
@@ -101,6 +108,21 @@ class NestedLoopJoinProbe : public Operator {
       const RowTypePtr& leftType,
       const RowTypePtr& rightType);
 
+  // Sets 'comparisons_' from the top level conjuncts of 'filter'.
+  void initializeComparisons(
+      const core::TypedExprPtr& filter,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
+  // Adds the comparison 'name(left, right)' to 'comparisons_' if it compares
+  // a probe and a build column. Returns true if added.
+  bool addComparison(
+      const std::string& name,
+      const core::TypedExprPtr& left,
+      const core::TypedExprPtr& right,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
   // Materializes build data from nested loop join bridge into `buildVectors_`.
   // Returns whether the data has been materialized and is ready for use. Nested
   // loop join requires all build data to be materialized and available in
@@ -139,8 +161,24 @@ class NestedLoopJoinProbe : public Operator {
   // by `isJoinConditionMatch(buildRow)` below.
   void evaluateJoinFilter(const RowVectorPtr& buildVector);
 
+  // Sets 'comparisonBits_' to the rows of the current build vector that pass
+  // all 'comparisons_' for the current probe row.
+  void evaluateComparisons(vector_size_t numBuildRows);
+
+  // Flattens the build columns of 'comparisons_' for use by
+  // evaluateComparisons().
+  void prepareComparisons();
+
   // Checks if the join condition matched for a particular row.
   bool isJoinConditionMatch(vector_size_t i) const {
+    if (!comparisons_.empty()) {
+      if (!bits::isBitSet(comparisonBits_.data(), i)) {
+        return false;
+      }
+      if (comparisonsOnly_) {
+        return true;
+      }
+    }
     return (
         !decodedFilterResult_.isNullAt(i) &&
         decodedFilterResult_.valueAt<bool>(i));
@@ -305,6 +343,32 @@ class NestedLoopJoinProbe : public Operator {
   VectorPtr filterOutput_;
   DecodedVector decodedFilterResult_;
 
+  // A top level conjunct of the join condition of the form 'probe op build'
+  // over integer columns of the same type.
+  struct Comparison {
+    enum class Op { kEq, kNeq, kLt, kLte, kGt, kGte };
+
+    Op op;
+    column_index_t probeChannel;
+    column_index_t buildChannel;
+  };
+
+  std::vector<Comparison> comparisons_;
+
+  // True if the join condition consists of 'comparisons_' only.
+  bool comparisonsOnly_{false};
+
+  // The probe columns of 'comparisons_' decoded for the current input.
+  std::vector<DecodedVector> comparisonProbeColumns_;
+
+  // The build columns of 'comparisons_' as flat vectors. Indexed by build
+  // vector, then by comparison.
+  std::vector<std::vector<VectorPtr>> comparisonBuildColumns_;
+
+  // A bit per row of the current build vector that is set if the row passes
+  // 'comparisons_' for the current probe row.
+  std::vector<uint64_t> comparisonBits_;
+
   // Join metadata and state.
   std::shared_ptr<const core::NestedLoopJoinNode> joinNode_;
   const core::JoinType joinType_;
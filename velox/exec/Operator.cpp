@@ -339,6 +339,7 @@ void Operator::close() {
   input_ = nullptr;
   results_.clear();
   recordSpillStats();
+  recordAllocationProfile();
   finishTrace();
 
   // Release the unused memory reservation on close.
@@ -364,6 +365,31 @@ vector_size_t Operator::outputBatchRows(
   return std::max<vector_size_t>(batchSize, 1);
 }
 
+vector_size_t Operator::memoryPressureAdjustedBatchRows(
+    vector_size_t maxRows) const {
+  const double threshold = operatorCtx_->task()
+                               ->queryCtx()
+                               ->queryConfig()
+                               .memoryPressureBatchSizingThreshold();
+  if (threshold == 0 || maxRows <= 1) {
+    return maxRows;
+  }
+  const auto* queryPool = pool()->root();
+  const auto capacity = queryPool->maxCapacity();
+  if (capacity == 0 || capacity == memory::kMaxMemory) {
+    return maxRows;
+  }
+  const double usage =
+      static_cast<double>(queryPool->reservedBytes()) / capacity;
+  if (usage <= threshold || threshold >= 1) {
+    return maxRows;
+  }
+  constexpr double kMinScale = 1.0 / 16;
+  const double scale =
+      std::max(kMinScale, (1 - std::min(usage, 1.0)) / (1 - threshold));
+  return std::max<vector_size_t>(1, maxRows * scale);
+}
+
 void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
   uint64_t now =
       std::chrono::duration_cast<std::chrono::microseconds>(
@@ -381,6 +407,38 @@ void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
       fmt::format("blocked{}Times", blockReason), RuntimeCounter(1));
 }
 
+void Operator::recordAllocationProfile() {
+  const auto profile = pool()->allocationProfile();
+  if (profile.empty()) {
+    return;
+  }
+  using AllocationProfile = memory::MemoryPool::AllocationProfile;
+  auto lockedStats = stats_.wlock();
+  for (auto i = 0; i < AllocationProfile::kNumSizeBuckets; ++i) {
+    if (profile.numAllocs[i] == 0) {
+      continue;
+    }
+    const auto bucketName = AllocationProfile::sizeBucketName(i);
+    lockedStats->addRuntimeStat(
+        fmt::format("{}.{}", kSampledAllocs, bucketName),
+        RuntimeCounter(profile.numAllocs[i]));
+    lockedStats->addRuntimeStat(
+        fmt::format("{}.{}", kSampledAllocBytes, bucketName),
+        RuntimeCounter(profile.allocBytes[i], RuntimeCounter::Unit::kBytes));
+  }
+  for (auto i = 0; i < AllocationProfile::kNumLifetimeBuckets; ++i) {
+    if (profile.numFrees[i] == 0) {
+      continue;
+    }
+    lockedStats->addRuntimeStat(
+        fmt::format(
+            "{}.{}",
+            kSampledAllocLifetime,
+            AllocationProfile::lifetimeBucketName(i)),
+        RuntimeCounter(profile.numFrees[i]));
+  }
+}
+
 void Operator::recordSpillStats() {
   const auto lockedSpillStats = spillStats_.wlock();
   auto lockedStats = stats_.wlock();
@@ -574,6 +632,8 @@ void OperatorStats::add(const OperatorStats& other) {
 
   backgroundTiming.add(other.backgroundTiming);
 
+  perfCounters.add(other.perfCounters);
+
   memoryStats.add(other.memoryStats);
 
   for (const auto& [name, stats] : other.runtimeStats) {
@@ -617,6 +677,8 @@ void OperatorStats::clear() {
 
   backgroundTiming.clear();
 
+  perfCounters.clear();
+
   memoryStats.clear();
 
   runtimeStats.clear();
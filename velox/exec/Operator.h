@@ -179,6 +179,14 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillDeserializationTime{
       "spillDeserializationWallNanos"};
 
+  /// The prefixes of the runtime stats of the sampled allocations of the
+  /// operator memory pool. See MemoryPool::AllocationProfile. The stat names
+  /// end with the size or lifetime bucket, e.g. 'sampledAllocBytes.4KB'.
+  static inline const std::string kSampledAllocs{"sampledAllocs"};
+  static inline const std::string kSampledAllocBytes{"sampledAllocBytes"};
+  static inline const std::string kSampledAllocLifetime{
+      "sampledAllocLifetime"};
+
   /// The vector serde kind used by an operator for shuffle. The recorded
   /// runtime stats value is the corresponding enum value.
   static inline const std::string kShuffleSerdeKind{"shuffleSerdeKind"};
@@ -299,6 +307,12 @@ class Operator : public BaseRuntimeStatWriter {
         toString());
   }
 
+  /// Tells 'this' that a downstream operator needs only the first 'numRows'
+  /// output rows. This is a hint and 'this' may produce more rows. Used by
+  /// Limit to let TableScan read no more rows than needed in its first
+  /// batches.
+  virtual void addLimitHint(int64_t /*numRows*/) {}
+
   /// Returns a list of identity projections, e.g. columns that are projected
   /// as-is possibly after applying a filter. Used to allow pushdown of dynamic
   /// filters generated by HashProbe into the TableScan. Examples of identity
@@ -589,9 +603,20 @@ class Operator : public BaseRuntimeStatWriter {
   vector_size_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
+  /// Returns 'maxRows' scaled down by the memory pressure of the query if the
+  /// query memory usage ratio is above
+  /// 'memory_pressure_batch_sizing_threshold'. The result is re-evaluated on
+  /// every call so that the batch size grows back once memory frees up.
+  /// Returns at least one row.
+  vector_size_t memoryPressureAdjustedBatchRows(vector_size_t maxRows) const;
+
   /// Invoked to record spill stats in operator stats.
   virtual void recordSpillStats();
 
+  /// Invoked on close to record the allocation profile of the operator memory
+  /// pool in operator stats if the profiling is enabled.
+  void recordAllocationProfile();
+
   const std::unique_ptr<OperatorCtx> operatorCtx_;
   const RowTypePtr outputType_;
   /// Contains the disk spilling related configs if spilling is enabled (e.g.
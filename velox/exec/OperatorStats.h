@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/common/memory/MemoryPool.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/time/CpuWallTimer.h"
 
 namespace facebook::velox::exec {
@@ -139,6 +140,11 @@ struct OperatorStats {
   // CPU time at a reasonable time granularity.
   CpuWallTiming backgroundTiming;
 
+  // Hardware performance counters of the isBlocked, addInput, getOutput and
+  // noMoreInput calls, including the lazy loads they trigger. Collected if
+  // track_operator_perf_counters is set.
+  process::PerfCounters perfCounters;
+
   MemoryStats memoryStats;
 
   // Total bytes in memory for spilling
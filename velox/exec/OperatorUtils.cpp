@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/OperatorUtils.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/VectorHasher.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/vector/ConstantVector.h"
@@ -204,13 +205,8 @@ vector_size_t processFlatFilterResults(
     bits::andBits(selectedBits, rows.allBits(), 0, size);
   }
 
-  vector_size_t passed = 0;
   auto* rawSelected = filterEvalCtx.getRawSelectedIndices(size, pool);
-  bits::forEachSetBit(
-      selectedBits, 0, size, [&rawSelected, &passed](vector_size_t row) {
-        rawSelected[passed++] = row;
-      });
-  return passed;
+  return simd::indicesOfSetBits(selectedBits, 0, size, rawSelected);
 }
 
 vector_size_t processEncodedFilterResults(
@@ -230,17 +226,13 @@ vector_size_t processEncodedFilterResults(
   auto* rawSelected = filterEvalCtx.getRawSelectedIndices(size, pool);
   auto* rawSelectedBits = filterEvalCtx.getRawSelectedBits(size, pool);
   memset(rawSelectedBits, 0, bits::nbytes(size));
-  for (int32_t i = 0; i < size; ++i) {
-    if (!rows.isValid(i)) {
-      continue;
-    }
-    auto index = indices[i];
+  rows.applyToSelected([&](vector_size_t i) {
     if ((!nulls || !bits::isBitNull(nulls, i)) &&
-        bits::isBitSet(values, index)) {
+        bits::isBitSet(values, indices[i])) {
       rawSelected[passed++] = i;
       bits::setBit(rawSelectedBits, i);
     }
-  }
+  });
   return passed;
 }
 } // namespace
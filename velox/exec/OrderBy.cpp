@@ -67,7 +67,11 @@ OrderBy::OrderBy(
       &nonReclaimableSection_,
       driverCtx->prefixSortConfig(),
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
-      &spillStats_);
+      &spillStats_,
+      driverCtx->queryConfig().orderByParallelSortRuns() > 1
+          ? driverCtx->task->queryCtx()->executor()
+          : nullptr,
+      driverCtx->queryConfig().orderByParallelSortRuns());
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/OutputBuffer.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/exec/Task.h"
@@ -30,10 +31,10 @@ void ArbitraryBuffer::noMoreData() {
   pages_.push_back(nullptr);
 }
 
-void ArbitraryBuffer::enqueue(std::unique_ptr<SerializedPage> page) {
+void ArbitraryBuffer::enqueue(std::shared_ptr<SerializedPage> page) {
   VELOX_CHECK_NOT_NULL(page, "Unexpected null page");
   VELOX_CHECK(!hasNoMoreData(), "Arbitrary buffer has set no more data marker");
-  pages_.push_back(std::shared_ptr<SerializedPage>(page.release()));
+  pages_.push_back(std::move(page));
 }
 
 void ArbitraryBuffer::getAvailablePageSizes(std::vector<int64_t>& out) const {
@@ -185,6 +186,20 @@ DestinationBuffer::Data DestinationBuffer::getData(
   return {std::move(data), std::move(remainingBytes), true};
 }
 
+std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::getPages(
+    int64_t sequence,
+    int32_t numPages) const {
+  VELOX_CHECK_GE(
+      sequence, sequence_, "Get received for an already acknowledged item");
+  std::vector<std::shared_ptr<SerializedPage>> pages;
+  for (auto i = sequence - sequence_;
+       i < data_.size() && pages.size() < numPages && data_[i] != nullptr;
+       ++i) {
+    pages.push_back(data_[i]);
+  }
+  return pages;
+}
+
 void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
   // Drop duplicate end markers.
   if (data == nullptr && !data_.empty() && data_.back() == nullptr) {
@@ -335,6 +350,11 @@ OutputBuffer::OutputBuffer(
       continueSize_((maxSize_ * kContinuePct) / 100),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
+      maxSpillSize_(
+          task_->spillDirectory().empty() &&
+                  !task_->hasCreateSpillDirectoryCb()
+              ? 0
+              : task_->queryCtx()->queryConfig().maxOutputBufferSpillSize()),
       numDrivers_(numDrivers) {
   buffers_.reserve(numDestinations);
   for (int i = 0; i < numDestinations; i++) {
@@ -343,6 +363,19 @@ OutputBuffer::OutputBuffer(
   finishedBufferStats_.resize(numDestinations);
 }
 
+OutputBuffer::~OutputBuffer() {
+  if (spillWriteFile_ == nullptr) {
+    return;
+  }
+  try {
+    spillWriteFile_->close();
+    filesystems::getFileSystem(spillPath_, nullptr)->remove(spillPath_);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to remove output buffer spill file " << spillPath_
+                 << ": " << e.what();
+  }
+}
+
 void OutputBuffer::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
   if (isPartitioned()) {
     VELOX_CHECK_EQ(buffers_.size(), numBuffers);
@@ -458,23 +491,33 @@ bool OutputBuffer::enqueue(
 
     updateStatsWithEnqueuedPageLocked(data->size(), data->numRows().value());
 
+    std::shared_ptr<SerializedPage> page(data.release());
+    if (maxSpillSize_ > 0) {
+      addSpillCandidateLocked(page);
+    }
     switch (kind_) {
       case PartitionedOutputNode::Kind::kBroadcast:
         VELOX_CHECK_EQ(destination, 0, "Bad destination {}", destination);
-        enqueueBroadcastOutputLocked(std::move(data), dataAvailableCallbacks);
+        enqueueBroadcastOutputLocked(std::move(page), dataAvailableCallbacks);
         break;
       case PartitionedOutputNode::Kind::kArbitrary:
         VELOX_CHECK_EQ(destination, 0, "Bad destination {}", destination);
-        enqueueArbitraryOutputLocked(std::move(data), dataAvailableCallbacks);
+        enqueueArbitraryOutputLocked(std::move(page), dataAvailableCallbacks);
         break;
       case PartitionedOutputNode::Kind::kPartitioned:
         enqueuePartitionedOutputLocked(
-            destination, std::move(data), dataAvailableCallbacks);
+            destination, std::move(page), dataAvailableCallbacks);
         break;
       default:
         VELOX_UNREACHABLE(PartitionedOutputNode::kindString(kind_));
     }
 
+    // A page dropped for a deleted destination is freed by now and is not
+    // spilled.
+    if (maxSpillSize_ > 0 && bufferedBytes_ >= maxSize_) {
+      spillLocked();
+    }
+
     if (bufferedBytes_ >= maxSize_ && future) {
       common::testutil::TestValue::adjust(
           "facebook::velox::exec::OutputBuffer::enqueue", this);
@@ -493,14 +536,51 @@ bool OutputBuffer::enqueue(
   return blocked;
 }
 
+void OutputBuffer::addSpillCandidateLocked(
+    const std::shared_ptr<SerializedPage>& page) {
+  if (page->canSpill()) {
+    spillCandidates_.push_back(page);
+  }
+  if (spillCandidates_.size() > 2 * static_cast<uint64_t>(bufferedPages_)) {
+    spillCandidates_.erase(
+        std::remove_if(
+            spillCandidates_.begin(),
+            spillCandidates_.end(),
+            [](const auto& candidate) { return candidate.expired(); }),
+        spillCandidates_.end());
+  }
+}
+
+void OutputBuffer::spillLocked() {
+  while (bufferedBytes_ >= continueSize_ && spilledBytes_ < maxSpillSize_ &&
+         !spillCandidates_.empty()) {
+    auto page = spillCandidates_.front().lock();
+    spillCandidates_.pop_front();
+    if (page == nullptr || !page->canSpill()) {
+      continue;
+    }
+    if (spillWriteFile_ == nullptr) {
+      static std::atomic_uint64_t fileId{0};
+      spillPath_ = fmt::format(
+          "{}/outputBuffer-{}", task_->nextSpillDirectory(), fileId++);
+      auto fileSystem = filesystems::getFileSystem(spillPath_, nullptr);
+      spillWriteFile_ = fileSystem->openFileForWrite(spillPath_);
+      spillReadFile_ = fileSystem->openFileForRead(spillPath_);
+    }
+    page->spill(*spillWriteFile_, spillReadFile_);
+    updateTotalBufferedBytesMsLocked();
+    bufferedBytes_ -= page->size();
+    spilledBytes_ += page->size();
+  }
+}
+
 void OutputBuffer::enqueueBroadcastOutputLocked(
-    std::unique_ptr<SerializedPage> data,
+    std::shared_ptr<SerializedPage> sharedData,
     std::vector<DataAvailable>& dataAvailableCbs) {
   VELOX_DCHECK(isBroadcast());
   VELOX_CHECK_NULL(arbitraryBuffer_);
   VELOX_DCHECK(dataAvailableCbs.empty());
 
-  std::shared_ptr<SerializedPage> sharedData(data.release());
   for (auto& buffer : buffers_) {
     if (buffer != nullptr) {
       buffer->enqueue(sharedData);
@@ -516,7 +596,7 @@ void OutputBuffer::enqueueBroadcastOutputLocked(
 }
 
 void OutputBuffer::enqueueArbitraryOutputLocked(
-    std::unique_ptr<SerializedPage> data,
+    std::shared_ptr<SerializedPage> data,
     std::vector<DataAvailable>& dataAvailableCbs) {
   VELOX_DCHECK(isArbitrary());
   VELOX_DCHECK_NOT_NULL(arbitraryBuffer_);
@@ -543,7 +623,7 @@ void OutputBuffer::enqueueArbitraryOutputLocked(
 
 void OutputBuffer::enqueuePartitionedOutputLocked(
     int destination,
-    std::unique_ptr<SerializedPage> data,
+    std::shared_ptr<SerializedPage> data,
     std::vector<DataAvailable>& dataAvailableCbs) {
   VELOX_DCHECK(isPartitioned());
   VELOX_CHECK_NULL(arbitraryBuffer_);
@@ -654,19 +734,26 @@ void OutputBuffer::updateAfterAcknowledgeLocked(
     const std::vector<std::shared_ptr<SerializedPage>>& freed,
     std::vector<ContinuePromise>& promises) {
   uint64_t freedBytes{0};
+  uint64_t freedSpilledBytes{0};
   int freedPages{0};
   for (const auto& free : freed) {
     if (free.use_count() == 1) {
       ++freedPages;
-      freedBytes += free->size();
+      if (free->isSpilled()) {
+        freedSpilledBytes += free->size();
+      } else {
+        freedBytes += free->size();
+      }
     }
   }
   if (freedPages == 0) {
     VELOX_CHECK_EQ(freedBytes, 0);
     return;
   }
-  VELOX_CHECK_GT(freedBytes, 0);
+  VELOX_CHECK_GT(freedBytes + freedSpilledBytes, 0);
 
+  spilledBytes_ -= freedSpilledBytes;
+  VELOX_CHECK_GE(spilledBytes_, 0);
   updateStatsWithFreedPagesLocked(freedPages, freedBytes);
 
   if (bufferedBytes_ < continueSize_) {
@@ -678,6 +765,7 @@ bool OutputBuffer::deleteResults(int destination) {
   std::vector<std::shared_ptr<SerializedPage>> freed;
   std::vector<ContinuePromise> promises;
   bool isFinished;
+  bool atEnd;
   DataAvailable dataAvailable;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -687,6 +775,7 @@ bool OutputBuffer::deleteResults(int destination) {
       VLOG(1) << "Extra delete received for destination " << destination;
       return false;
     }
+    atEnd = atEnd_;
     freed = buffer->deleteResults();
     dataAvailable = buffer->getAndClearNotify();
     buffer->finish();
@@ -707,7 +796,14 @@ bool OutputBuffer::deleteResults(int destination) {
   }
   releaseAfterAcknowledge(freed, promises);
   if (isFinished) {
-    task_->setAllOutputConsumed();
+    if (atEnd) {
+      task_->setAllOutputConsumed();
+    } else {
+      // All the consumers went away before the producers finished, e.g. after
+      // a downstream Limit got all its rows. The rest of the output is not
+      // needed.
+      task_->setOutputNotNeeded();
+    }
   }
   return isFinished;
 }
@@ -748,6 +844,15 @@ void OutputBuffer::getData(
   }
 }
 
+std::vector<std::shared_ptr<SerializedPage>>
+OutputBuffer::getPages(int destination, int64_t sequence, int32_t numPages) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (destination >= buffers_.size() || buffers_[destination] == nullptr) {
+    return {};
+  }
+  return buffers_[destination]->getPages(sequence, numPages);
+}
+
 void OutputBuffer::terminate() {
   VELOX_CHECK(!task_->isRunning());
 
@@ -769,6 +874,7 @@ std::string OutputBuffer::toString() {
 std::string OutputBuffer::toStringLocked() const {
   std::stringstream out;
   out << "[OutputBuffer[" << kind_ << "] bufferedBytes_=" << bufferedBytes_
+      << "b, spilledBytes_=" << spilledBytes_
       << "b, num producers blocked=" << promises_.size()
       << ", completed=" << numFinished_ << "/" << numDrivers_ << ", "
       << (atEnd_ ? "at end, " : "") << "destinations: " << std::endl;
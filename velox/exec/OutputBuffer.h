@@ -75,7 +75,7 @@ class ArbitraryBuffer {
   /// appends a null page at the end of 'pages_' as end marker.
   void noMoreData();
 
-  void enqueue(std::unique_ptr<SerializedPage> page);
+  void enqueue(std::shared_ptr<SerializedPage> page);
 
   /// Returns a number of pages with total bytes no less than 'maxBytes' if
   /// there are sufficient buffered pages.
@@ -161,6 +161,12 @@ class DestinationBuffer {
       DataConsumerActiveCheckCallback activeCheck,
       ArbitraryBuffer* arbitraryBuffer = nullptr);
 
+  /// Returns up to 'numPages' pages starting at 'sequence'. End markers are
+  /// not returned.
+  std::vector<std::shared_ptr<SerializedPage>> getPages(
+      int64_t sequence,
+      int32_t numPages) const;
+
   /// Removes data from the queue and returns removed data. If 'fromGetData' we
   /// do not give a warning for the case where no data is removed, otherwise we
   /// expect that data does get freed. We cannot assert that data gets deleted
@@ -263,6 +269,8 @@ class OutputBuffer {
       int numDestinations,
       uint32_t numDrivers);
 
+  ~OutputBuffer();
+
   core::PartitionedOutputNode::Kind kind() const {
     return kind_;
   }
@@ -306,6 +314,11 @@ class OutputBuffer {
       DataAvailableCallback notify,
       DataConsumerActiveCheckCallback activeCheck);
 
+  /// Returns up to 'numPages' unacknowledged pages starting at 'sequence' for
+  /// 'destination'. See OutputBufferManager::getPages().
+  std::vector<std::shared_ptr<SerializedPage>>
+  getPages(int destination, int64_t sequence, int32_t numPages);
+
   /// Continues any possibly waiting producers. Called when the producer task
   /// has an error or cancellation.
   void terminate();
@@ -353,18 +366,26 @@ class OutputBuffer {
   void addOutputBuffersLocked(int numBuffers);
 
   void enqueueBroadcastOutputLocked(
-      std::unique_ptr<SerializedPage> data,
+      std::shared_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
 
   void enqueueArbitraryOutputLocked(
-      std::unique_ptr<SerializedPage> data,
+      std::shared_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
 
   void enqueuePartitionedOutputLocked(
       int destination,
-      std::unique_ptr<SerializedPage> data,
+      std::shared_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
 
+  // Records 'page' as a candidate for spilling and drops the candidates that
+  // have been freed once they outnumber the buffered pages.
+  void addSpillCandidateLocked(const std::shared_ptr<SerializedPage>& page);
+
+  // Moves the oldest buffered pages to disk until 'bufferedBytes_' is below
+  // 'continueSize_' or 'spilledBytes_' reaches 'maxSpillSize_'.
+  void spillLocked();
+
   std::string toStringLocked() const;
 
   FOLLY_ALWAYS_INLINE bool isBroadcast() const {
@@ -388,6 +409,10 @@ class OutputBuffer {
   // resumed.
   const uint64_t continueSize_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
+  // The maximum bytes of pages that are spilled instead of blocking the
+  // producers. 0 if spilling is disabled. See
+  // QueryConfig::kMaxOutputBufferSpillSize.
+  const uint64_t maxSpillSize_;
 
   // Total number of drivers expected to produce results. This number will
   // decrease in the end of grouped execution, when we understand the real
@@ -404,9 +429,18 @@ class OutputBuffer {
   std::vector<std::shared_ptr<SerializedPage>> dataToBroadcast_;
 
   std::mutex mutex_;
-  // Actual data size in 'buffers_'.
+  // Actual data size in 'buffers_' which is held in memory.
   int64_t bufferedBytes_{0};
-  // The number of buffered pages which corresponds to 'bufferedBytes_'.
+  // Size of the data in 'buffers_' which is spilled to 'spillPath_'.
+  int64_t spilledBytes_{0};
+  // The pages that may be spilled in enqueue order. Freed pages are skipped.
+  std::deque<std::weak_ptr<SerializedPage>> spillCandidates_;
+  // The file that the spilled pages are appended to. Created on first spill
+  // and removed together with 'this'.
+  std::string spillPath_;
+  std::unique_ptr<WriteFile> spillWriteFile_;
+  std::shared_ptr<ReadFile> spillReadFile_;
+  // The number of buffered pages, including the spilled ones.
   int64_t bufferedPages_{0};
   // The total number of output bytes, rows and pages.
   uint64_t numOutputBytes_{0};
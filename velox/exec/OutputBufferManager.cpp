@@ -111,6 +111,17 @@ bool OutputBufferManager::getData(
   return false;
 }
 
+std::vector<std::shared_ptr<SerializedPage>> OutputBufferManager::getPages(
+    const std::string& taskId,
+    int destination,
+    int64_t sequence,
+    int32_t numPages) {
+  if (auto buffer = getBufferIfExists(taskId)) {
+    return buffer->getPages(destination, sequence, numPages);
+  }
+  return {};
+}
+
 void OutputBufferManager::initializeTask(
     std::shared_ptr<Task> task,
     core::PartitionedOutputNode::Kind kind,
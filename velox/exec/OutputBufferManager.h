@@ -92,6 +92,18 @@ class OutputBufferManager {
       DataAvailableCallback notify,
       DataConsumerActiveCheckCallback activeCheck = nullptr);
 
+  /// Returns the pages with sequence numbers in ['sequence', 'sequence' +
+  /// 'numPages') for 'destination' from 'taskId'. These must have been
+  /// returned by getData() and not yet acknowledged. This is used by
+  /// in-process consumers to access the vectors of in-process pages, which
+  /// getData() returns as empty IOBufs. Returns fewer pages if the results
+  /// have been deleted.
+  std::vector<std::shared_ptr<SerializedPage>> getPages(
+      const std::string& taskId,
+      int destination,
+      int64_t sequence,
+      int32_t numPages);
+
   void removeTask(const std::string& taskId);
 
 #ifdef VELOX_ENABLE_BACKWARD_COMPATIBILITY
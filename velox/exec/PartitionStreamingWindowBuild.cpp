@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/PartitionStreamingWindowBuild.h"
+#include "velox/exec/MemoryReclaimer.h"
 
 namespace facebook::velox::exec {
 
@@ -22,10 +23,22 @@ PartitionStreamingWindowBuild::PartitionStreamingWindowBuild(
     const std::shared_ptr<const core::WindowNode>& windowNode,
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
-    tsan_atomic<bool>* nonReclaimableSection)
-    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection) {}
+    tsan_atomic<bool>* nonReclaimableSection,
+    folly::Synchronized<common::SpillStats>* spillStats)
+    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection),
+      spillStats_(spillStats) {}
 
 void PartitionStreamingWindowBuild::buildNextPartition() {
+  if (spiller_ != nullptr) {
+    SpillPartitionSet spillPartitionSet;
+    spiller_->finishSpill(spillPartitionSet);
+    VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
+    spilledPartitions_.emplace(
+        partitionStartRows_.size(),
+        std::move(spillPartitionSet.begin()->second));
+    spiller_.reset();
+  }
+
   partitionStartRows_.push_back(sortedRows_.size());
   sortedRows_.insert(sortedRows_.end(), inputRows_.begin(), inputRows_.end());
   inputRows_.clear();
@@ -36,6 +49,8 @@ void PartitionStreamingWindowBuild::addInput(RowVectorPtr input) {
     decodedInputVectors_[i].decode(*input->childAt(inputChannels_[i]));
   }
 
+  ensureInputFits(input);
+
   for (auto row = 0; row < input->size(); ++row) {
     char* newRow = data_->newRow();
 
@@ -53,6 +68,120 @@ void PartitionStreamingWindowBuild::addInput(RowVectorPtr input) {
   }
 }
 
+void PartitionStreamingWindowBuild::ensureInputFits(const RowVectorPtr& input) {
+  if (spillConfig_ == nullptr) {
+    // Spilling is disabled.
+    return;
+  }
+
+  if (inputRows_.size() <= 1) {
+    // Nothing to spill.
+    return;
+  }
+
+  // Test-only spill path.
+  if (testingTriggerSpill(data_->pool()->name())) {
+    spill();
+    return;
+  }
+
+  const auto currentUsage = data_->pool()->usedBytes();
+  const auto minReservationBytes =
+      currentUsage * spillConfig_->minSpillableReservationPct / 100;
+  if (data_->pool()->availableReservation() >= minReservationBytes) {
+    return;
+  }
+
+  const auto outOfLineBytesPerRow =
+      data_->stringAllocator().retainedSize() / data_->numRows();
+  const auto incrementBytes =
+      data_->sizeIncrement(input->size(), outOfLineBytesPerRow * input->size());
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
+  {
+    memory::ReclaimableSectionGuard guard(nonReclaimableSection_);
+    if (data_->pool()->maybeReserve(targetIncrementBytes)) {
+      return;
+    }
+  }
+
+  LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
+               << " for memory pool " << data_->pool()->name()
+               << ", usage: " << succinctBytes(data_->pool()->usedBytes())
+               << ", reservation: "
+               << succinctBytes(data_->pool()->reservedBytes());
+}
+
+void PartitionStreamingWindowBuild::spill() {
+  // The rows of the partitions in 'sortedRows_' are referenced by the
+  // partition being output, so only the partition being received is spilled.
+  // Its last row is kept in memory as 'previousRow_' to detect the start of
+  // the next partition.
+  if (inputRows_.size() <= 1) {
+    return;
+  }
+
+  if (spiller_ == nullptr) {
+    spiller_ = std::make_unique<SortOutputSpiller>(
+        data_.get(), inputType_, spillConfig_, spillStats_);
+  }
+
+  const auto numSpillRows = inputRows_.size() - 1;
+  SpillerBase::SpillRows spillRows(
+      inputRows_.begin(),
+      inputRows_.begin() + numSpillRows,
+      memory::StlAllocator<char*>(*data_->pool()));
+  spiller_->spill(spillRows);
+  spilled_ = true;
+
+  data_->eraseRows(folly::Range<char**>(inputRows_.data(), numSpillRows));
+  inputRows_.erase(inputRows_.begin(), inputRows_.begin() + numSpillRows);
+  inputRows_.shrink_to_fit();
+  data_->pool()->release();
+}
+
+std::optional<common::SpillStats> PartitionStreamingWindowBuild::spilledStats()
+    const {
+  if (!spilled_) {
+    return std::nullopt;
+  }
+  return spillStats_->copy();
+}
+
+void PartitionStreamingWindowBuild::loadSpilledRows() {
+  auto it = spilledPartitions_.find(currentPartition_);
+  if (it == spilledPartitions_.end()) {
+    return;
+  }
+
+  auto reader = it->second->createUnorderedReader(
+      spillConfig_->readBufferSize, data_->pool(), spillStats_);
+  std::vector<char*> spilledRows;
+  RowVectorPtr batch;
+  while (reader->nextBatch(batch)) {
+    for (auto col = 0; col < batch->childrenSize(); ++col) {
+      decodedInputVectors_[col].decode(*batch->childAt(col));
+    }
+    for (auto row = 0; row < batch->size(); ++row) {
+      char* newRow = data_->newRow();
+      for (auto col = 0; col < batch->childrenSize(); ++col) {
+        data_->store(decodedInputVectors_[col], row, newRow, col);
+      }
+      spilledRows.push_back(newRow);
+    }
+  }
+  spilledPartitions_.erase(it);
+
+  sortedRows_.insert(
+      sortedRows_.begin() + partitionStartRows_[currentPartition_],
+      spilledRows.begin(),
+      spilledRows.end());
+  for (auto i = currentPartition_ + 1; i < partitionStartRows_.size(); ++i) {
+    partitionStartRows_[i] += spilledRows.size();
+  }
+}
+
 void PartitionStreamingWindowBuild::noMoreInput() {
   buildNextPartition();
 
@@ -86,6 +215,8 @@ PartitionStreamingWindowBuild::nextPartition() {
     }
   }
 
+  loadSpilledRows();
+
   const auto partitionSize = partitionStartRows_[currentPartition_ + 1] -
       partitionStartRows_[currentPartition_];
   const auto partition = folly::Range(
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/exec/Spiller.h"
 #include "velox/exec/WindowBuild.h"
 
 namespace facebook::velox::exec {
@@ -24,23 +25,25 @@ namespace facebook::velox::exec {
 /// sorted by {partition keys + order by keys}. The logic identifies partition
 /// changes when receiving input rows and splits out WindowPartitions for the
 /// Window operator to process.
+///
+/// Under memory pressure the rows of the partition still being received are
+/// spilled to disk. They are read back into memory when that partition is
+/// output, so the peak memory is bounded by roughly one partition instead of
+/// the partition being output plus the one being received.
 class PartitionStreamingWindowBuild : public WindowBuild {
  public:
   PartitionStreamingWindowBuild(
       const std::shared_ptr<const core::WindowNode>& windowNode,
       velox::memory::MemoryPool* pool,
       const common::SpillConfig* spillConfig,
-      tsan_atomic<bool>* nonReclaimableSection);
+      tsan_atomic<bool>* nonReclaimableSection,
+      folly::Synchronized<common::SpillStats>* spillStats);
 
   void addInput(RowVectorPtr input) override;
 
-  void spill() override {
-    VELOX_UNREACHABLE();
-  }
+  void spill() override;
 
-  std::optional<common::SpillStats> spilledStats() const override {
-    return std::nullopt;
-  }
+  std::optional<common::SpillStats> spilledStats() const override;
 
   void noMoreInput() override;
 
@@ -58,6 +61,16 @@ class PartitionStreamingWindowBuild : public WindowBuild {
  private:
   void buildNextPartition();
 
+  // Spills the input rows of the partition being received if spilling is
+  // enabled and there is not enough memory reserved for 'input'.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Reads the spilled rows of 'currentPartition_' back into 'data_' and places
+  // them in front of its in-memory rows in 'sortedRows_'.
+  void loadSpilledRows();
+
+  folly::Synchronized<common::SpillStats>* const spillStats_;
+
   // Vector of pointers to each input row in the data_ RowContainer.
   // Rows are erased from data_ when they are output from the
   // Window operator.
@@ -77,6 +90,18 @@ class PartitionStreamingWindowBuild : public WindowBuild {
   // Current partition being output. Used to construct WindowPartitions
   // during resetPartition.
   vector_size_t currentPartition_ = -1;
+
+  // Spills the leading rows of 'inputRows_'. Created on the first spill of the
+  // partition being received and reset once that partition is complete.
+  std::unique_ptr<SortOutputSpiller> spiller_;
+
+  // The spilled leading rows of the complete partitions keyed by partition
+  // index. The spilled rows precede the in-memory rows of the partition.
+  folly::F14FastMap<vector_size_t, std::unique_ptr<SpillPartition>>
+      spilledPartitions_;
+
+  // True if any input row has been spilled.
+  bool spilled_{false};
 };
 
 } // namespace facebook::velox::exec
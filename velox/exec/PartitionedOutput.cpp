@@ -30,6 +30,8 @@ std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
   options->compressionKind =
       common::stringToCompressionKind(queryConfig.shuffleCompressionKind());
   options->minCompressionRatio = PartitionedOutput::minCompressionRatio();
+  options->compressionBandwidthBytesPerSec =
+      queryConfig.shuffleCompressionNetworkBandwidth();
   return options;
 }
 } // namespace
@@ -42,7 +44,9 @@ Destination::Destination(
     VectorSerde::Options* serdeOptions,
     memory::MemoryPool* pool,
     bool eagerFlush,
-    std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
+    std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+    bool inProcess,
+    bool preserveEncodings)
     : taskId_(taskId),
       destination_(destination),
       serde_(serde),
@@ -50,7 +54,13 @@ Destination::Destination(
       pool_(pool),
       eagerFlush_(eagerFlush),
       recordEnqueued_(std::move(recordEnqueued)),
+      inProcess_(inProcess),
       rows_(raw_vector<vector_size_t>(pool)) {
+  if (preserveEncodings) {
+    VELOX_CHECK(!inProcess_);
+    VELOX_CHECK_EQ(serde_->kind(), VectorSerde::Kind::kPresto);
+    batchSerializer_ = serde_->createBatchSerializer(pool_, serdeOptions_);
+  }
   setTargetSizePct();
 }
 
@@ -87,14 +97,101 @@ BlockingReason Destination::advance(
         bytesInCurrent_ >= adjustedMaxBytes || rowsInCurrent_ >= targetNumRows_;
   }
 
-  // Serialize
+  const auto rows = folly::Range(&rows_[firstRow], rowIdx_ - firstRow);
+  if (inProcess_) {
+    appendToVector(output, rows);
+  } else if (batchSerializer_ != nullptr) {
+    serializeBatch(output, rows, bufferManager, scratch);
+  } else {
+    serialize(
+        output, rows, sizes, outputCompactRow, outputUnsafeRow, scratch);
+  }
+
+  // Update output state variable.
+  if (rowIdx_ == rows_.size()) {
+    *atEnd = true;
+  }
+  if (shouldFlush || (eagerFlush_ && rowsInCurrent_ > 0)) {
+    return flush(bufferManager, bufferReleaseFn, future);
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+void Destination::appendToVector(
+    const RowVectorPtr& output,
+    folly::Range<const vector_size_t*> rows) {
+  vector_size_t targetIndex = 0;
+  if (currentVector_ == nullptr) {
+    currentVector_ = std::static_pointer_cast<RowVector>(
+        BaseVector::create(output->type(), rows.size(), pool_));
+  } else {
+    targetIndex = currentVector_->size();
+    currentVector_->resize(targetIndex + rows.size());
+  }
+
+  // Coalesce consecutive rows into one range, e.g. when all the rows go to a
+  // single destination.
+  std::vector<BaseVector::CopyRange> ranges;
+  for (auto row : rows) {
+    if (!ranges.empty() &&
+        ranges.back().sourceIndex + ranges.back().count == row) {
+      ++ranges.back().count;
+    } else {
+      ranges.push_back({row, targetIndex, 1});
+    }
+    ++targetIndex;
+  }
+  currentVector_->copyRanges(output.get(), ranges);
+}
+
+VectorStreamGroup* Destination::prepareScatter(
+    uint64_t maxBytes,
+    const std::vector<vector_size_t>& sizes,
+    const RowTypePtr& rowType) {
+  VELOX_CHECK(!inProcess_);
+  VELOX_CHECK_NULL(batchSerializer_);
+  if (rowIdx_ > 0 || rows_.empty()) {
+    return nullptr;
+  }
+
+  // advance() flushes when reaching either limit, so the rows fit if both stay
+  // below after adding all of them.
+  if (rowsInCurrent_ + static_cast<vector_size_t>(rows_.size()) >=
+      targetNumRows_) {
+    return nullptr;
+  }
+  const uint32_t adjustedMaxBytes = (maxBytes * targetSizePct_) / 100;
+  uint64_t bytes = bytesInCurrent_;
+  for (auto row : rows_) {
+    bytes += sizes[row];
+  }
+  if (bytes >= adjustedMaxBytes) {
+    return nullptr;
+  }
+
+  bytesInCurrent_ = bytes;
+  rowsInCurrent_ += rows_.size();
+  rowIdx_ = rows_.size();
+  ensureCurrent(rowType);
+  return current_.get();
+}
+
+void Destination::ensureCurrent(const RowTypePtr& rowType) {
   if (current_ == nullptr) {
     current_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
-    const auto rowType = asRowType(output->type());
     current_->createStreamTree(rowType, rowsInCurrent_, serdeOptions_);
   }
+}
+
+void Destination::serialize(
+    const RowVectorPtr& output,
+    folly::Range<const vector_size_t*> rows,
+    const std::vector<vector_size_t>& sizes,
+    const row::CompactRow* outputCompactRow,
+    const row::UnsafeRowFast* outputUnsafeRow,
+    Scratch& scratch) {
+  ensureCurrent(asRowType(output->type()));
 
-  const auto rows = folly::Range(&rows_[firstRow], rowIdx_ - firstRow);
   if (serde_->kind() == VectorSerde::Kind::kCompactRow) {
     VELOX_CHECK_NOT_NULL(outputCompactRow);
     current_->append(*outputCompactRow, rows, sizes);
@@ -102,24 +199,46 @@ BlockingReason Destination::advance(
     VELOX_CHECK_NOT_NULL(outputUnsafeRow);
     current_->append(*outputUnsafeRow, rows, sizes);
   } else {
-    VELOX_CHECK_EQ(serde_->kind(), VectorSerde::Kind::kPresto);
+    VELOX_CHECK(
+        serde_->kind() == VectorSerde::Kind::kPresto ||
+        serde_->kind() == VectorSerde::Kind::kArrow);
     current_->append(output, rows, scratch);
   }
+}
 
-  // Update output state variable.
-  if (rowIdx_ == rows_.size()) {
-    *atEnd = true;
+void Destination::serializeBatch(
+    const RowVectorPtr& output,
+    folly::Range<const vector_size_t*> rows,
+    OutputBufferManager& bufferManager,
+    Scratch& scratch) {
+  if (batchStream_ == nullptr) {
+    batchListener_ = bufferManager.newListener();
+    batchStream_ =
+        std::make_unique<IOBufOutputStream>(*pool_, batchListener_.get());
   }
-  if (shouldFlush || (eagerFlush_ && rowsInCurrent_ > 0)) {
-    return flush(bufferManager, bufferReleaseFn, future);
+
+  std::vector<IndexRange> ranges;
+  for (auto row : rows) {
+    if (!ranges.empty() && ranges.back().begin + ranges.back().size == row) {
+      ++ranges.back().size;
+    } else {
+      ranges.push_back({row, 1});
+    }
   }
-  return BlockingReason::kNotBlocked;
+  batchSerializer_->serialize(output, ranges, scratch, batchStream_.get());
 }
 
 BlockingReason Destination::flush(
     OutputBufferManager& bufferManager,
     const std::function<void()>& bufferReleaseFn,
     ContinueFuture* future) {
+  if (inProcess_) {
+    return flushVector(bufferManager, bufferReleaseFn, future);
+  }
+  if (batchSerializer_ != nullptr) {
+    return flushBatch(bufferManager, bufferReleaseFn, future);
+  }
+
   if (!current_ || rowsInCurrent_ == 0) {
     return BlockingReason::kNotBlocked;
   }
@@ -155,6 +274,65 @@ BlockingReason Destination::flush(
                  : BlockingReason::kNotBlocked;
 }
 
+BlockingReason Destination::flushBatch(
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future) {
+  if (!batchStream_ || rowsInCurrent_ == 0) {
+    return BlockingReason::kNotBlocked;
+  }
+
+  const int64_t flushedBytes = batchStream_->tellp();
+  const int64_t flushedRows = rowsInCurrent_;
+  auto iobuf = batchStream_->getIOBuf(bufferReleaseFn);
+  batchStream_.reset();
+  batchListener_.reset();
+
+  bytesInCurrent_ = 0;
+  rowsInCurrent_ = 0;
+  setTargetSizePct();
+
+  bool blocked = bufferManager.enqueue(
+      taskId_,
+      destination_,
+      std::make_unique<SerializedPage>(std::move(iobuf), nullptr, flushedRows),
+      future);
+
+  recordEnqueued_(flushedBytes, flushedRows);
+
+  return blocked ? BlockingReason::kWaitForConsumer
+                 : BlockingReason::kNotBlocked;
+}
+
+BlockingReason Destination::flushVector(
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future) {
+  if (!currentVector_ || rowsInCurrent_ == 0) {
+    return BlockingReason::kNotBlocked;
+  }
+
+  const int64_t flushedBytes = bytesInCurrent_;
+  const int64_t flushedRows = rowsInCurrent_;
+  bytesInCurrent_ = 0;
+  rowsInCurrent_ = 0;
+  setTargetSizePct();
+
+  // The page holds 'bufferReleaseFn' which references the task, so that the
+  // memory pool of 'currentVector_' outlives the page.
+  bool blocked = bufferManager.enqueue(
+      taskId_,
+      destination_,
+      std::make_unique<SerializedPage>(
+          std::move(currentVector_), flushedBytes, bufferReleaseFn),
+      future);
+
+  recordEnqueued_(flushedBytes, flushedRows);
+
+  return blocked ? BlockingReason::kWaitForConsumer
+                 : BlockingReason::kNotBlocked;
+}
+
 void Destination::updateStats(Operator* op) {
   VELOX_CHECK(finished_);
   if (current_) {
@@ -182,6 +360,7 @@ PartitionedOutput::PartitionedOutput(
       keyChannels_(toChannels(planNode->inputType(), planNode->keys())),
       numDestinations_(planNode->numPartitions()),
       replicateNullsAndAny_(planNode->isReplicateNullsAndAny()),
+      skewedPartitionMode_(planNode->skewedPartitionMode()),
       partitionFunction_(
           numDestinations_ == 1 ? nullptr
                                 : planNode->partitionFunctionSpec().create(
@@ -204,7 +383,17 @@ PartitionedOutput::PartitionedOutput(
       serde_(getNamedVectorSerde(planNode->serdeKind())),
       serdeOptions_(getVectorSerdeOptions(
           operatorCtx_->driverCtx()->queryConfig(),
-          planNode->serdeKind())) {
+          planNode->serdeKind())),
+      inProcess_(ctx->queryConfig().inProcessShuffleEnabled()),
+      preserveEncodings_(
+          !inProcess_ && planNode->serdeKind() == VectorSerde::Kind::kPresto &&
+          ctx->queryConfig().shufflePreserveEncodings()),
+      scatter_(
+          numDestinations_ >= kMinScatterDestinations &&
+          planNode->serdeKind() == VectorSerde::Kind::kPresto && !inProcess_ &&
+          !preserveEncodings_ && !eagerFlush_ && !replicateNullsAndAny_ &&
+          skewedPartitionMode_ ==
+              core::PartitionedOutputNode::SkewedPartitionMode::kNone) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -212,6 +401,26 @@ PartitionedOutput::PartitionedOutput(
     VELOX_USER_CHECK(keyChannels_.empty());
     VELOX_USER_CHECK_NULL(partitionFunction_);
   }
+  if (skewedPartitionMode_ !=
+      core::PartitionedOutputNode::SkewedPartitionMode::kNone) {
+    skewedPartitions_.resize(numDestinations_, false);
+    for (const auto partition : planNode->skewedPartitions()) {
+      skewedPartitions_[partition] = true;
+    }
+  }
+  if (skewedPartitionMode_ ==
+      core::PartitionedOutputNode::SkewedPartitionMode::kSpread) {
+    const auto& queryConfig = ctx->queryConfig();
+    skewedPartitionRebalancer_ =
+        std::make_unique<common::SkewedPartitionRebalancer>(
+            numDestinations_,
+            numDestinations_,
+            queryConfig
+                .shuffleSkewedPartitionMinProcessedBytesRebalanceThreshold(),
+            queryConfig.shuffleMinProcessedBytesRebalanceThreshold(),
+            planNode->skewedPartitions());
+    skewedPartitionRowIndices_.resize(numDestinations_, 0);
+  }
 }
 
 void PartitionedOutput::initializeInput(RowVectorPtr input) {
@@ -266,7 +475,9 @@ void PartitionedOutput::initializeDestinations() {
           [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
-          }));
+          },
+          inProcess_,
+          preserveEncodings_));
     }
   }
 }
@@ -298,7 +509,9 @@ void PartitionedOutput::estimateRowSizes() {
     serde_->estimateSerializedSize(
         outputUnsafeRow_.get(), rows, sizePointers_.data());
   } else {
-    VELOX_CHECK_EQ(serde_->kind(), VectorSerde::Kind::kPresto);
+    VELOX_CHECK(
+        serde_->kind() == VectorSerde::Kind::kPresto ||
+        serde_->kind() == VectorSerde::Kind::kArrow);
     serde_->estimateSerializedSize(
         output_.get(), rows, sizePointers_.data(), scratch_);
   }
@@ -318,7 +531,22 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
   if (numDestinations_ == 1) {
     destinations_[0]->addRows(IndexRange{0, numInput});
   } else {
+    if (skewedPartitionRebalancer_ != nullptr) {
+      skewedPartitionRebalancer_->rebalance();
+    }
     auto singlePartition = partitionFunction_->partition(*input_, partitions_);
+    if (singlePartition.has_value() &&
+        isSkewedPartition(singlePartition.value())) {
+      // The rows of a skewed partition may go to different destinations.
+      partitions_.resize(numInput);
+      std::fill(
+          partitions_.begin(), partitions_.end(), singlePartition.value());
+      singlePartition.reset();
+    }
+    if (skewedPartitionRebalancer_ != nullptr) {
+      updateSkewedPartitionRebalancer(singlePartition);
+    }
+
     if (replicateNullsAndAny_) {
       collectNullRows();
 
@@ -340,7 +568,7 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
           if (singlePartition.has_value()) {
             destinations_[singlePartition.value()]->addRow(i);
           } else {
-            destinations_[partitions_[i]]->addRow(i);
+            addRow(partitions_[i], i);
           }
         }
       }
@@ -350,13 +578,95 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
             IndexRange{0, numInput});
       } else {
         for (vector_size_t i = 0; i < numInput; ++i) {
-          destinations_[partitions_[i]]->addRow(i);
+          addRow(partitions_[i], i);
+        }
+        if (scatter_) {
+          scatterRows();
         }
       }
     }
   }
 }
 
+uint64_t PartitionedOutput::maxPageSize() const {
+  // Limit serialized pages to 1MB.
+  static const uint64_t kMaxPageSize = 1 << 20;
+  return std::max<uint64_t>(
+      kMinDestinationSize,
+      std::min<uint64_t>(kMaxPageSize, maxBufferedBytes_ / numDestinations_));
+}
+
+void PartitionedOutput::scatterRows() {
+  const auto pageSize = maxPageSize();
+  const auto rowType = asRowType(output_->type());
+  scatterGroups_.resize(numDestinations_);
+  scatterRows_.resize(numDestinations_);
+  bool hasRows = false;
+  for (auto i = 0; i < numDestinations_; ++i) {
+    auto& destination = destinations_[i];
+    scatterGroups_[i] =
+        destination->prepareScatter(pageSize, rowSize_, rowType);
+    if (scatterGroups_[i] != nullptr) {
+      scatterRows_[i] = destination->batchRows();
+      hasRows = true;
+    } else {
+      scatterRows_[i] = {};
+    }
+  }
+  if (hasRows) {
+    // Each row goes to exactly one destination, so its partition is the index
+    // of its destination.
+    VectorStreamGroup::scatter(
+        output_, partitions_.data(), scatterRows_, scatterGroups_, scratch_);
+  }
+}
+
+void PartitionedOutput::addRow(uint32_t partition, vector_size_t row) {
+  if (!isSkewedPartition(partition)) {
+    destinations_[partition]->addRow(row);
+    return;
+  }
+  if (skewedPartitionMode_ ==
+      core::PartitionedOutputNode::SkewedPartitionMode::kReplicate) {
+    for (auto& destination : destinations_) {
+      destination->addRow(row);
+    }
+    return;
+  }
+  const auto destination = skewedPartitionRebalancer_->getTaskId(
+      partition, skewedPartitionRowIndices_[partition]++);
+  destinations_[destination]->addRow(row);
+}
+
+void PartitionedOutput::updateSkewedPartitionRebalancer(
+    const std::optional<uint32_t>& singlePartition) {
+  const auto numInput = input_->size();
+  if (singlePartition.has_value()) {
+    skewedPartitionRebalancer_->addPartitionRowCount(
+        singlePartition.value(), numInput);
+  } else {
+    partitionRowCounts_.resize(numDestinations_);
+    std::fill(partitionRowCounts_.begin(), partitionRowCounts_.end(), 0);
+    for (vector_size_t i = 0; i < numInput; ++i) {
+      ++partitionRowCounts_[partitions_[i]];
+    }
+    for (auto partition = 0; partition < numDestinations_; ++partition) {
+      if (partitionRowCounts_[partition] > 0) {
+        skewedPartitionRebalancer_->addPartitionRowCount(
+            partition, partitionRowCounts_[partition]);
+      }
+    }
+  }
+
+  int64_t inputBytes = 0;
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    inputBytes += rowSize_[i];
+  }
+  if (inputBytes > 0) {
+    skewedPartitionRebalancer_->addProcessedBytes(inputBytes);
+  }
+}
+
 void PartitionedOutput::collectNullRows() {
   auto size = input_->size();
   rows_.resize(size);
@@ -398,11 +708,7 @@ RowVectorPtr PartitionedOutput::getOutput() {
   VELOX_CHECK_NOT_NULL(
       bufferManager, "OutputBufferManager was already destructed");
 
-  // Limit serialized pages to 1MB.
-  static const uint64_t kMaxPageSize = 1 << 20;
-  const uint64_t maxPageSize = std::max<uint64_t>(
-      kMinDestinationSize,
-      std::min<uint64_t>(kMaxPageSize, maxBufferedBytes_ / numDestinations_));
+  const uint64_t maxPageSize = this->maxPageSize();
 
   bool workLeft;
   do {
@@ -485,6 +791,13 @@ void PartitionedOutput::close() {
     lockedStats->addRuntimeStat(
         Operator::kShuffleCompressionKind,
         RuntimeCounter(static_cast<int64_t>(serdeOptions_->compressionKind)));
+    if (skewedPartitionRebalancer_ != nullptr &&
+        skewedPartitionRebalancer_->stats().numScaledPartitions != 0) {
+      lockedStats->addRuntimeStat(
+          kScaledSkewedPartitions,
+          RuntimeCounter(
+              skewedPartitionRebalancer_->stats().numScaledPartitions));
+    }
   }
   destinations_.clear();
 }
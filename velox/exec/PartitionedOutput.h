@@ -16,6 +16,7 @@
 #pragma once
 
 #include <folly/Random.h>
+#include "velox/common/base/SkewedPartitionBalancer.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/row/CompactRow.h"
@@ -29,6 +30,12 @@ class Destination {
  public:
   /// @param recordEnqueued Should be called to record each call to
   /// OutputBufferManager::enqueue. Takes number of bytes and rows.
+  /// @param inProcess If true, the rows are copied into a vector which is
+  /// enqueued as an in-process page instead of being serialized.
+  /// @param preserveEncodings If true, the rows of each input batch are
+  /// serialized with a BatchVectorSerializer, which keeps dictionary and
+  /// constant encodings, instead of being appended to a flattening
+  /// VectorStreamGroup.
   Destination(
       const std::string& taskId,
       int destination,
@@ -36,7 +43,9 @@ class Destination {
       VectorSerde::Options* options,
       memory::MemoryPool* pool,
       bool eagerFlush,
-      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued);
+      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+      bool inProcess = false,
+      bool preserveEncodings = false);
 
   /// Resets the destination before starting a new batch.
   void beginBatch() {
@@ -54,6 +63,20 @@ class Destination {
     }
   }
 
+  /// Returns the group to append all the rows of the current batch to with
+  /// VectorStreamGroup::scatter() and accounts them as serialized. Returns
+  /// nullptr if there are no rows or if they do not all fit into the page
+  /// being built, in which case the rows are left to advance().
+  VectorStreamGroup* prepareScatter(
+      uint64_t maxBytes,
+      const std::vector<vector_size_t>& sizes,
+      const RowTypePtr& rowType);
+
+  /// The rows of the current batch.
+  folly::Range<const vector_size_t*> batchRows() const {
+    return folly::Range(rows_.data(), rows_.size());
+  }
+
   /// Serializes row from 'output' till either 'maxBytes' have been serialized
   /// or
   BlockingReason advance(
@@ -96,6 +119,43 @@ class Destination {
   // traffic pattern where all consumers contend for the network at
   // the same time. This is done for each batch so that the average
   // batch size for each converges.
+  // Creates 'current_' if not yet created.
+  void ensureCurrent(const RowTypePtr& rowType);
+
+  // Serializes 'rows' of 'output' into 'current_'.
+  void serialize(
+      const RowVectorPtr& output,
+      folly::Range<const vector_size_t*> rows,
+      const std::vector<vector_size_t>& sizes,
+      const row::CompactRow* outputCompactRow,
+      const row::UnsafeRowFast* outputUnsafeRow,
+      Scratch& scratch);
+
+  // Copies 'rows' of 'output' to the end of 'currentVector_'.
+  void appendToVector(
+      const RowVectorPtr& output,
+      folly::Range<const vector_size_t*> rows);
+
+  // Serializes 'rows' of 'output' as a separate Presto page at the end of
+  // 'batchStream_'.
+  void serializeBatch(
+      const RowVectorPtr& output,
+      folly::Range<const vector_size_t*> rows,
+      OutputBufferManager& bufferManager,
+      Scratch& scratch);
+
+  // Enqueues the pages in 'batchStream_'.
+  BlockingReason flushBatch(
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future);
+
+  // Enqueues 'currentVector_' as an in-process page.
+  BlockingReason flushVector(
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future);
+
   void setTargetSizePct() {
     // Flush at 70 to 120% of target row or byte count.
     targetSizePct_ = 70 + (folly::Random::rand32(rng_) % 50);
@@ -109,6 +169,7 @@ class Destination {
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
+  const bool inProcess_;
 
   // Bytes serialized in 'current_'
   uint64_t bytesInCurrent_{0};
@@ -122,6 +183,17 @@ class Destination {
   // The current stream where the input is serialized to. This is cleared on
   // every flush() call.
   std::unique_ptr<VectorStreamGroup> current_;
+
+  // The rows to enqueue as an in-process page if 'inProcess_' is true. This is
+  // cleared on every flush() call.
+  RowVectorPtr currentVector_;
+
+  // Set if the rows are serialized with encodings preserved. Each call to
+  // advance() appends one Presto page to 'batchStream_', which is cleared on
+  // every flush() call.
+  std::unique_ptr<BatchVectorSerializer> batchSerializer_;
+  std::unique_ptr<OutputStreamListener> batchListener_;
+  std::unique_ptr<IOBufOutputStream> batchStream_;
   bool finished_{false};
 
   // Flush accumulated data to buffer manager after reaching this
@@ -153,6 +225,11 @@ class PartitionedOutput : public Operator {
   /// network MTU of 64K.
   static constexpr uint64_t kMinDestinationSize = 60 * 1024;
 
+  /// Minimum number of destinations for writing the rows of each input to all
+  /// the destinations in one pass per column. With fewer destinations, each
+  /// destination gets long enough runs of rows to serialize them separately.
+  static constexpr int32_t kMinScatterDestinations = 64;
+
   PartitionedOutput(
       int32_t operatorId,
       DriverCtx* ctx,
@@ -193,6 +270,11 @@ class PartitionedOutput : public Operator {
     return minCompressionRatio_;
   }
 
+  /// The number of times that a skewed partition was spread over one more
+  /// destination.
+  static inline const std::string kScaledSkewedPartitions{
+      "scaledSkewedPartitions"};
+
  private:
   void initializeInput(RowVectorPtr input);
 
@@ -202,9 +284,30 @@ class PartitionedOutput : public Operator {
 
   void estimateRowSizes();
 
+  // Returns the size at which the pages of a destination are flushed.
+  uint64_t maxPageSize() const;
+
+  // Appends the rows of each destination whose rows all fit into its current
+  // page with a single VectorStreamGroup::scatter() call. The remaining rows
+  // are serialized destination by destination in getOutput().
+  void scatterRows();
+
   // Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  bool isSkewedPartition(uint32_t partition) const {
+    return !skewedPartitions_.empty() && skewedPartitions_[partition];
+  }
+
+  // Adds 'row' of hash partition 'partition' to its destinations. These are
+  // different from 'partition' only for skewed partitions.
+  void addRow(uint32_t partition, vector_size_t row);
+
+  // Reports the rows sent to each partition and the size of the input to
+  // 'skewedPartitionRebalancer_'.
+  void updateSkewedPartitionRebalancer(
+      const std::optional<uint32_t>& singlePartition);
+
   // If compression in serde is enabled, this is the minimum compression that
   // must be achieved before starting to skip compression. Used for testing.
   inline static float minCompressionRatio_ = 0.8;
@@ -212,6 +315,7 @@ class PartitionedOutput : public Operator {
   const std::vector<column_index_t> keyChannels_;
   const int numDestinations_;
   const bool replicateNullsAndAny_;
+  const core::PartitionedOutputNode::SkewedPartitionMode skewedPartitionMode_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
   // Empty if column order in the output is exactly the same as in input.
   const std::vector<column_index_t> outputChannels_;
@@ -221,6 +325,15 @@ class PartitionedOutput : public Operator {
   const bool eagerFlush_;
   VectorSerde* const serde_;
   const std::unique_ptr<VectorSerde::Options> serdeOptions_;
+  // If true, the output is passed to the consumers as in-process pages. See
+  // QueryConfig::kInProcessShuffleEnabled.
+  const bool inProcess_;
+  // If true, the encodings of the output are kept when serializing. See
+  // QueryConfig::kShufflePreserveEncodings.
+  const bool preserveEncodings_;
+  // If true, each row goes to exactly one destination and the rows of each
+  // input are scattered to the destinations. See scatterRows().
+  const bool scatter_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -249,7 +362,22 @@ class PartitionedOutput : public Operator {
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
   std::vector<DecodedVector> decodedVectors_;
+  std::vector<VectorStreamGroup*> scatterGroups_;
+  std::vector<folly::Range<const vector_size_t*>> scatterRows_;
   Scratch scratch_;
+
+  // Indexed by partition. True for the skewed partitions of the plan node.
+  // Empty if there are none.
+  std::vector<bool> skewedPartitions_;
+  // Decides over how many destinations each skewed partition is spread. Only
+  // set in the skewed partition mode kSpread.
+  std::unique_ptr<common::SkewedPartitionRebalancer>
+      skewedPartitionRebalancer_;
+  // The number of rows of each skewed partition sent so far. Used to pick the
+  // destinations of a spread partition round-robin.
+  std::vector<uint64_t> skewedPartitionRowIndices_;
+  // The number of rows of each partition in the current input.
+  std::vector<uint32_t> partitionRowCounts_;
 };
 
 } // namespace facebook::velox::exec
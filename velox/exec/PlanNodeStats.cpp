@@ -47,6 +47,8 @@ PlanNodeStats& PlanNodeStats::operator+=(const PlanNodeStats& another) {
 
   blockedWallNanos += another.blockedWallNanos;
 
+  perfCounters.add(another.perfCounters);
+
   peakMemoryBytes += another.peakMemoryBytes;
   numMemoryAllocations += another.numMemoryAllocations;
 
@@ -119,6 +121,8 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
 
   blockedWallNanos += stats.blockedWallNanos;
 
+  perfCounters.add(stats.perfCounters);
+
   peakMemoryBytes += stats.memoryStats.peakTotalMemoryReservation;
   numMemoryAllocations += stats.memoryStats.numMemoryAllocations;
 
@@ -184,6 +188,23 @@ std::string PlanNodeStats::toString(bool includeInputStats) const {
         << succinctBytes(spilledBytes) << ", " << spilledFiles << " files)";
   }
 
+  if (!perfCounters.empty()) {
+    out << ", Hardware counters: "
+        << fmt::format(
+               "IPC {:.2f}, LLC misses {}, Branch misses {}, "
+               "Backend stalls {:.1f}%",
+               perfCounters.cycles == 0
+                   ? 0
+                   : static_cast<double>(perfCounters.instructions) /
+                       perfCounters.cycles,
+               perfCounters.llcMisses,
+               perfCounters.branchMisses,
+               perfCounters.cycles == 0
+                   ? 0
+                   : 100.0 * perfCounters.stalledCyclesBackend /
+                       perfCounters.cycles);
+  }
+
   if (!dynamicFilterStats.empty()) {
     out << ", DynamicFilter producer plan nodes: "
         << folly::join(',', dynamicFilterStats.producerNodeIds);
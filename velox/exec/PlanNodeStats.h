@@ -107,6 +107,10 @@ struct PlanNodeStats {
   /// Sum of blocked wall time for all corresponding operators.
   uint64_t blockedWallNanos{0};
 
+  /// Sum of hardware performance counters for all corresponding operators.
+  /// Empty unless track_operator_perf_counters is set.
+  process::PerfCounters perfCounters;
+
   /// Max of peak memory usage for all corresponding operators. Assumes that all
   /// operator instances were running concurrently.
   uint64_t peakMemoryBytes{0};
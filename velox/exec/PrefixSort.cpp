@@ -136,6 +136,27 @@ compareByWord(uint64_t* left, uint64_t* right, int32_t bytes) {
   return 0;
 }
 
+// The number of rows sampled to pick the prefix length of a string key.
+constexpr int32_t kNumStringPrefixSampleRows = 1'024;
+
+// The percentage of adjacent distinct sampled string keys which may tie on
+// the picked prefix length.
+constexpr int32_t kMaxStringPrefixTiePct = 10;
+
+// Returns the first 'maxLength' bytes of 'value' that is stored in a row
+// container.
+std::string readStringPrefix(StringView value, uint32_t maxLength) {
+  std::string prefix(std::min<uint32_t>(value.size(), maxLength), '\0');
+  if (value.isInline() ||
+      HashStringAllocator::headerOf(value.data())->size() >= value.size()) {
+    std::memcpy(prefix.data(), value.data(), prefix.size());
+  } else {
+    HashStringAllocator::InputStream stream(
+        HashStringAllocator::headerOf(value.data()));
+    stream.ByteInputStream::readBytes(prefix.data(), prefix.size());
+  }
+  return prefix;
+}
 } // namespace
 
 // static.
@@ -145,7 +166,8 @@ PrefixSortLayout PrefixSortLayout::generate(
     const std::vector<CompareFlags>& compareFlags,
     uint32_t maxNormalizedKeySize,
     uint32_t maxStringPrefixLength,
-    const std::vector<std::optional<uint32_t>>& maxStringLengths) {
+    const std::vector<std::optional<uint32_t>>& maxStringLengths,
+    const std::vector<std::optional<uint32_t>>& stringPrefixLengths) {
   const uint32_t numKeys = types.size();
   std::vector<bool> normalizedKeyHasNullByte;
   normalizedKeyHasNullByte.reserve(numKeys);
@@ -164,11 +186,20 @@ PrefixSortLayout PrefixSortLayout::generate(
 
   bool lastPrefixKeyPartial{false};
   for (auto i = 0; i < numKeys; ++i) {
+    uint32_t stringPrefixLength = maxStringPrefixLength;
+    if (!stringPrefixLengths.empty() && stringPrefixLengths[i].has_value()) {
+      // Takes as much of the longer prefix as fits into the remaining space.
+      const int64_t availableSize = static_cast<int64_t>(maxNormalizedKeySize) -
+          normalizedKeySize - (columnHasNulls[i] ? 1 : 0);
+      stringPrefixLength = std::max<int64_t>(
+          maxStringPrefixLength,
+          std::min<int64_t>(stringPrefixLengths[i].value(), availableSize));
+    }
     const std::optional<uint32_t> encodedSize = PrefixSortEncoder::encodedSize(
         types[i]->kind(),
         maxStringLengths[i].has_value()
-            ? std::min(maxStringLengths[i].value(), maxStringPrefixLength)
-            : maxStringPrefixLength,
+            ? std::min(maxStringLengths[i].value(), stringPrefixLength)
+            : stringPrefixLength,
         columnHasNulls[i]);
     if (!encodedSize.has_value() ||
         normalizedKeySize + encodedSize.value() > maxNormalizedKeySize) {
@@ -183,7 +214,7 @@ PrefixSortLayout PrefixSortLayout::generate(
     if ((types[i]->kind() == TypeKind::VARCHAR ||
          types[i]->kind() == TypeKind::VARBINARY) &&
         (!maxStringLengths[i].has_value() ||
-         maxStringPrefixLength < maxStringLengths[i].value())) {
+         stringPrefixLength < maxStringLengths[i].value())) {
       lastPrefixKeyPartial = true;
       break;
     }
@@ -328,6 +359,75 @@ uint32_t PrefixSort::maxRequiredBytes(
   return prefixSort.maxRequiredBytes();
 }
 
+// static
+std::optional<uint32_t> PrefixSort::adaptiveStringPrefixLength(
+    const RowContainer* rowContainer,
+    column_index_t column,
+    std::optional<uint32_t> maxStringLength,
+    const velox::common::PrefixSortConfig& config) {
+  const auto minLength = config.maxStringPrefixLength;
+  const auto maxLength = config.maxAdaptiveStringPrefixLength;
+  if (maxLength <= minLength) {
+    return std::nullopt;
+  }
+  if (maxStringLength.has_value()) {
+    if (maxStringLength.value() <= minLength) {
+      return std::nullopt;
+    }
+    if (maxStringLength.value() <= maxLength) {
+      return maxStringLength;
+    }
+  }
+
+  std::vector<char*> rows(std::min<int64_t>(
+      kNumStringPrefixSampleRows, rowContainer->numRows()));
+  RowContainerIterator iter;
+  rows.resize(rowContainer->listRows(&iter, rows.size(), rows.data()));
+  const auto& rowColumn = rowContainer->columnAt(column);
+  std::vector<std::string> prefixes;
+  prefixes.reserve(rows.size());
+  for (auto* row : rows) {
+    if (RowContainer::isNullAt(
+            row, rowColumn.nullByte(), rowColumn.nullMask())) {
+      continue;
+    }
+    prefixes.push_back(readStringPrefix(
+        *reinterpret_cast<const StringView*>(row + rowColumn.offset()),
+        maxLength));
+  }
+  std::sort(prefixes.begin(), prefixes.end());
+
+  // The prefix length that each pair of adjacent distinct sampled keys needs
+  // to not tie. Keys equal in all their first 'maxLength' bytes need the
+  // longest prefix. Duplicate keys tie on any prefix and are not counted.
+  std::vector<uint32_t> lengths;
+  lengths.reserve(prefixes.size());
+  for (auto i = 1; i < prefixes.size(); ++i) {
+    const auto& left = prefixes[i - 1];
+    const auto& right = prefixes[i];
+    if (left == right) {
+      if (left.size() == maxLength) {
+        lengths.push_back(maxLength);
+      }
+      continue;
+    }
+    const auto mismatch =
+        std::mismatch(left.begin(), left.end(), right.begin(), right.end());
+    lengths.push_back(mismatch.first - left.begin() + 1);
+  }
+  if (lengths.empty()) {
+    return std::nullopt;
+  }
+
+  const auto nth =
+      lengths.begin() + lengths.size() * (100 - kMaxStringPrefixTiePct) / 100;
+  std::nth_element(lengths.begin(), nth, lengths.end());
+  if (*nth <= minLength) {
+    return std::nullopt;
+  }
+  return std::min(*nth, maxLength);
+}
+
 // static
 void PrefixSort::stdSort(
     std::vector<char*, memory::StlAllocator<char*>>& rows,
@@ -357,7 +457,8 @@ uint32_t PrefixSort::maxRequiredBytes() const {
 }
 
 void PrefixSort::sortInternal(
-    std::vector<char*, memory::StlAllocator<char*>>& rows) {
+    std::vector<char*, memory::StlAllocator<char*>>& rows,
+    uint32_t minRadixSortRows) {
   const auto numRows = rows.size();
   const auto entrySize = sortLayout_.entrySize;
   memory::ContiguousAllocation prefixBufferAlloc;
@@ -393,6 +494,17 @@ void PrefixSort::sortInternal(
           prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
             return comparePartNormalizedKeys(lhs, rhs);
           });
+    } else if (minRadixSortRows > 0 && numRows >= minRadixSortRows) {
+      addThreadLocalRuntimeStat(
+          PrefixSort::kNumRadixSortRows,
+          RuntimeCounter(numRows, RuntimeCounter::Unit::kNone));
+      sortRunner.radixSort(
+          prefixBufferStart,
+          prefixBufferEnd,
+          sortLayout_.normalizedBufferSize,
+          [&](char* lhs, char* rhs) {
+            return compareAllNormalizedKeys(lhs, rhs);
+          });
     } else {
       sortRunner.quickSort(
           prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
@@ -77,13 +77,17 @@ struct PrefixSortLayout {
   /// for fast long compare.
   const int32_t numPaddingBytes;
 
+  /// 'stringPrefixLengths' optionally sets a longer prefix length than
+  /// 'maxStringPrefixLength' for string keys. The longer prefix is cut to what
+  /// fits into 'maxNormalizedKeySize'.
   static PrefixSortLayout generate(
       const std::vector<TypePtr>& types,
       const std::vector<bool>& columnHasNulls,
       const std::vector<CompareFlags>& compareFlags,
       uint32_t maxNormalizedKeySize,
       uint32_t maxStringPrefixLength,
-      const std::vector<std::optional<uint32_t>>& maxStringLengths);
+      const std::vector<std::optional<uint32_t>>& maxStringLengths,
+      const std::vector<std::optional<uint32_t>>& stringPrefixLengths = {});
 
   /// Optimizes the order of sort key columns to maximize the number of prefix
   /// sort keys for acceleration. This only applies for use case which doesn't
@@ -147,7 +151,7 @@ class PrefixSort {
     }
 
     PrefixSort prefixSort(rowContainer, sortLayout, pool);
-    prefixSort.sortInternal(rows);
+    prefixSort.sortInternal(rows, config.minRadixSortRows);
   }
 
   /// The std::sort won't require bytes while prefix sort may require buffers
@@ -162,6 +166,8 @@ class PrefixSort {
   /// The runtime stats name collected for prefix sort.
   /// The number of prefix sort keys.
   static inline const std::string kNumPrefixSortKeys{"numPrefixSortKeys"};
+  /// The number of rows sorted with radix sort.
+  static inline const std::string kNumRadixSortRows{"numRadixSortRows"};
 
  private:
   /// Fallback to stdSort when prefix sort conditions such as config and memory
@@ -180,18 +186,24 @@ class PrefixSort {
     VELOX_CHECK_EQ(keyTypes.size(), compareFlags.size());
     std::vector<std::optional<uint32_t>> maxStringLengths;
     maxStringLengths.reserve(keyTypes.size());
+    std::vector<std::optional<uint32_t>> stringPrefixLengths;
+    stringPrefixLengths.reserve(keyTypes.size());
     std::vector<bool> columnHasNulls;
     columnHasNulls.reserve(keyTypes.size());
     for (int i = 0; i < keyTypes.size(); ++i) {
       std::optional<uint32_t> maxStringLength = std::nullopt;
+      std::optional<uint32_t> stringPrefixLength = std::nullopt;
       if (keyTypes[i]->kind() == TypeKind::VARBINARY ||
           keyTypes[i]->kind() == TypeKind::VARCHAR) {
         const auto stats = rowContainer->columnStats(i);
         if (stats.has_value()) {
           maxStringLength = stats.value().maxBytes();
         }
+        stringPrefixLength = adaptiveStringPrefixLength(
+            rowContainer, i, maxStringLength, config);
       }
       maxStringLengths.emplace_back(maxStringLength);
+      stringPrefixLengths.emplace_back(stringPrefixLength);
       columnHasNulls.emplace_back(rowContainer->columnHasNulls(i));
     }
     return PrefixSortLayout::generate(
@@ -200,14 +212,30 @@ class PrefixSort {
         compareFlags,
         config.maxNormalizedKeyBytes,
         config.maxStringPrefixLength,
-        maxStringLengths);
+        maxStringLengths,
+        stringPrefixLengths);
   }
 
+  // Returns the prefix length for string key 'column' if it should be longer
+  // than 'config.maxStringPrefixLength', or std::nullopt otherwise. Keys with
+  // 'maxStringLength' up to 'config.maxAdaptiveStringPrefixLength' are stored
+  // whole. Otherwise, the length is picked from a sample of the rows so that
+  // few distinct keys tie on the prefix.
+  static std::optional<uint32_t> adaptiveStringPrefixLength(
+      const RowContainer* rowContainer,
+      column_index_t column,
+      std::optional<uint32_t> maxStringLength,
+      const velox::common::PrefixSortConfig& config);
+
   // Estimates the memory required for prefix sort such as prefix buffer and
   // swap buffer.
   uint32_t maxRequiredBytes() const;
 
-  void sortInternal(std::vector<char*, memory::StlAllocator<char*>>& rows);
+  // Sorts 'rows' with radix sort if all the keys are normalized whole and
+  // there are at least 'minRadixSortRows' rows, or with quick-sort otherwise.
+  void sortInternal(
+      std::vector<char*, memory::StlAllocator<char*>>& rows,
+      uint32_t minRadixSortRows = 0);
 
   int compareAllNormalizedKeys(char* left, char* right);
 
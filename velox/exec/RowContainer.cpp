@@ -288,6 +288,15 @@ RowContainer::~RowContainer() {
   clear();
 }
 
+void RowContainer::enableWideNormalizedKeys() {
+  VELOX_CHECK(hasNormalizedKeys_);
+  VELOX_CHECK_EQ(numRows_, 0);
+  VELOX_CHECK_EQ(numRowsWithNormalizedKey_, 0);
+  originalNormalizedKeySize_ =
+      bits::roundUp(2 * sizeof(normalized_key_t), alignment_);
+  normalizedKeySize_ = originalNormalizedKeySize_;
+}
+
 char* RowContainer::newRow() {
   VELOX_DCHECK(mutable_, "Can't add row into an immutable row container");
   ++numRows_;
@@ -1327,8 +1336,19 @@ RowComparator::RowComparator(
 }
 
 bool RowComparator::operator()(const char* lhs, const char* rhs) {
+  return compare(lhs, rhs) < 0;
+}
+
+bool RowComparator::operator()(
+    const std::vector<DecodedVector>& decodedVectors,
+    vector_size_t index,
+    const char* rhs) {
+  return compare(decodedVectors, index, rhs) < 0;
+}
+
+int32_t RowComparator::compare(const char* lhs, const char* rhs) {
   if (lhs == rhs) {
-    return false;
+    return 0;
   }
   for (auto& key : keyInfo_) {
     if (auto result = rowContainer_->compare(
@@ -1336,13 +1356,13 @@ bool RowComparator::operator()(const char* lhs, const char* rhs) {
             rhs,
             key.first,
             {key.second.isNullsFirst(), key.second.isAscending(), false})) {
-      return result < 0;
+      return result;
     }
   }
-  return false;
+  return 0;
 }
 
-bool RowComparator::operator()(
+int32_t RowComparator::compare(
     const std::vector<DecodedVector>& decodedVectors,
     vector_size_t index,
     const char* rhs) {
@@ -1353,9 +1373,9 @@ bool RowComparator::operator()(
             decodedVectors[key.first],
             index,
             {key.second.isNullsFirst(), key.second.isAscending(), false})) {
-      return result > 0;
+      return -result;
     }
   }
-  return false;
+  return 0;
 }
 } // namespace facebook::velox::exec
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/core/PlanNode.h"
@@ -395,6 +396,12 @@ class RowContainer {
     return numRows_;
   }
 
+  /// Returns the number of erased rows whose space is kept for reuse by
+  /// newRow().
+  uint64_t numFreeRows() const {
+    return numFreeRows_;
+  }
+
   /// Copy key and dependent columns into a flat VARBINARY vector. All columns
   /// of a row are copied into a single buffer. The format of that buffer is an
   /// implementation detail. The data can be loaded back into the RowContainer
@@ -722,10 +729,26 @@ class RowContainer {
     return reinterpret_cast<normalized_key_t*>(group)[-1];
   }
 
+  /// Returns the high word of a 128 bit normalized key. The word is stored
+  /// below the low word returned by normalizedKey(). Only valid if
+  /// enableWideNormalizedKeys() was called.
+  static inline normalized_key_t& normalizedKeyHigh(char* group) {
+    return reinterpret_cast<normalized_key_t*>(group)[-2];
+  }
+
   void disableNormalizedKeys() {
     normalizedKeySize_ = 0;
   }
 
+  /// Reserves space for a 128 bit normalized key below each row instead of a
+  /// 64 bit one. Must be called before any row is added.
+  void enableWideNormalizedKeys();
+
+  /// True if rows have space for a 128 bit normalized key.
+  bool hasWideNormalizedKeys() const {
+    return originalNormalizedKeySize_ >= 2 * sizeof(normalized_key_t);
+  }
+
   RowColumn columnAt(int32_t index) const {
     return rowColumns_[index];
   }
@@ -1095,6 +1118,78 @@ class RowContainer {
     }
   }
 
+  // Distance in rows of the row prefetched ahead of the one being extracted.
+  static constexpr int32_t kExtractPrefetchDistance = 16;
+
+  // True if values of type T are extracted with SIMD gathers over the row
+  // pointers.
+  template <typename T>
+  static constexpr bool kGatherExtract = sizeof(T) == sizeof(int64_t) &&
+      std::is_trivially_copyable_v<T> && !std::is_same_v<T, StringView>;
+
+  template <bool useRowNumbers>
+  static const char* extractRowAt(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t index) {
+    if constexpr (useRowNumbers) {
+      const auto rowNumber = rowNumbers[index];
+      return rowNumber >= 0 ? rows[rowNumber] : nullptr;
+    } else {
+      return rows[index];
+    }
+  }
+
+  template <bool useRowNumbers>
+  static void prefetchExtractRow(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t index,
+      int32_t offset) {
+    const auto ahead = index + kExtractPrefetchDistance;
+    if (ahead < numRows) {
+      // A null row is fine to prefetch, it does not fault.
+      __builtin_prefetch(
+          extractRowAt<useRowNumbers>(rows, rowNumbers, ahead) + offset);
+    }
+  }
+
+  // Copies the 8 byte values at 'offset' of 'numRows' 'rows' to 'values'.
+  // Null rows give a zero value. Uses vector gathers where the instruction
+  // set has them.
+  template <typename T>
+  static void gatherValues(
+      const char* const* rows,
+      int32_t numRows,
+      int32_t offset,
+      T* values) {
+    static_assert(kGatherExtract<T>);
+    int32_t i = 0;
+#if XSIMD_WITH_AVX2
+    using Batch = xsimd::batch<int64_t>;
+    const auto* addresses = reinterpret_cast<const int64_t*>(rows);
+    auto* result = reinterpret_cast<int64_t*>(values);
+    const Batch zero(static_cast<int64_t>(0));
+    const Batch valueOffset(static_cast<int64_t>(offset));
+    for (; i + Batch::size <= numRows; i += Batch::size) {
+      const auto rowAddresses = Batch::load_unaligned(addresses + i);
+      const auto present = rowAddresses != zero;
+      // The addresses are absolute, so the gather base is 0.
+      simd::maskGather<int64_t, int64_t, 1>(
+          zero,
+          present,
+          static_cast<const int64_t*>(nullptr),
+          rowAddresses + valueOffset)
+          .store_unaligned(result + i);
+    }
+#endif
+    for (; i < numRows; ++i) {
+      prefetchExtractRow<false>(rows, {}, numRows, i, offset);
+      values[i] = rows[i] ? valueAt<T>(rows[i], offset) : T();
+    }
+  }
+
   template <bool useRowNumbers, typename T>
   static void extractValuesWithNulls(
       const char* const* rows,
@@ -1112,14 +1207,22 @@ class RowContainer {
     auto nulls = nullBuffer->asMutable<uint64_t>();
     BufferPtr valuesBuffer = result->mutableValues(maxRows);
     [[maybe_unused]] auto values = valuesBuffer->asMutableRange<T>();
-    for (int32_t i = 0; i < numRows; ++i) {
-      const char* row;
-      if constexpr (useRowNumbers) {
-        auto rowNumber = rowNumbers[i];
-        row = rowNumber >= 0 ? rows[rowNumber] : nullptr;
-      } else {
-        row = rows[i];
+    if constexpr (!useRowNumbers && kGatherExtract<T>) {
+      // Values are gathered regardless of the null flags, which are then
+      // read from the rows just loaded.
+      gatherValues(rows, numRows, offset, values.data() + resultOffset);
+      for (int32_t i = 0; i < numRows; ++i) {
+        const char* row = rows[i];
+        bits::setNull(
+            nulls,
+            resultOffset + i,
+            row == nullptr || isNullAt(row, nullByte, nullMask));
       }
+      return;
+    }
+    for (int32_t i = 0; i < numRows; ++i) {
+      prefetchExtractRow<useRowNumbers>(rows, rowNumbers, numRows, i, offset);
+      const char* row = extractRowAt<useRowNumbers>(rows, rowNumbers, i);
       auto resultIndex = resultOffset + i;
       if (row == nullptr || isNullAt(row, nullByte, nullMask)) {
         bits::setNull(nulls, resultIndex, true);
@@ -1146,14 +1249,16 @@ class RowContainer {
     VELOX_DCHECK_LE(maxRows, result->size());
     BufferPtr valuesBuffer = result->mutableValues(maxRows);
     [[maybe_unused]] auto values = valuesBuffer->asMutableRange<T>();
-    for (int32_t i = 0; i < numRows; ++i) {
-      const char* row;
-      if constexpr (useRowNumbers) {
-        auto rowNumber = rowNumbers[i];
-        row = rowNumber >= 0 ? rows[rowNumber] : nullptr;
-      } else {
-        row = rows[i];
+    if constexpr (!useRowNumbers && kGatherExtract<T>) {
+      gatherValues(rows, numRows, offset, values.data() + resultOffset);
+      for (int32_t i = 0; i < numRows; ++i) {
+        result->setNull(resultOffset + i, rows[i] == nullptr);
       }
+      return;
+    }
+    for (int32_t i = 0; i < numRows; ++i) {
+      prefetchExtractRow<useRowNumbers>(rows, rowNumbers, numRows, i, offset);
+      const char* row = extractRowAt<useRowNumbers>(rows, rowNumbers, i);
       auto resultIndex = resultOffset + i;
       if (row == nullptr) {
         result->setNull(resultIndex, true);
@@ -1890,6 +1995,17 @@ class RowComparator {
       vector_size_t index,
       const char* rhs);
 
+  /// Returns 0 if lhs and rhs have equal keys, a negative number if lhs < rhs
+  /// and a positive number otherwise.
+  int32_t compare(const char* lhs, const char* rhs);
+
+  /// Returns 0 if decodeVectors[index] and rhs have equal keys, a negative
+  /// number if decodeVectors[index] < rhs and a positive number otherwise.
+  int32_t compare(
+      const std::vector<DecodedVector>& decodedVectors,
+      vector_size_t index,
+      const char* rhs);
+
  private:
   std::vector<std::pair<column_index_t, core::SortOrder>> keyInfo_;
   RowContainer* rowContainer_;
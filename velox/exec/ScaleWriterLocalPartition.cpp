@@ -31,6 +31,8 @@ ScaleWriterPartitioningLocalPartition::ScaleWriterPartitioningLocalPartition(
       maxTablePartitionsPerWriter_(
           ctx->queryConfig().scaleWriterMaxPartitionsPerWriter()),
       numTablePartitions_(maxTablePartitionsPerWriter_ * numPartitions_),
+      minPartitionWriterBytes_(
+          ctx->queryConfig().scaleWriterMinPartitionWriterBytes()),
       queryPool_(pool()->root()),
       tablePartitionRebalancer_(ctx->task->getScaleWriterPartitionBalancer(
           ctx->splitGroupId,
@@ -46,6 +48,9 @@ ScaleWriterPartitioningLocalPartition::ScaleWriterPartitioningLocalPartition(
   tablePartitionRowCounts_.resize(numTablePartitions_, 0);
   tablePartitionWriterIds_.resize(numTablePartitions_, -1);
   tablePartitionWriterIndexes_.resize(numTablePartitions_, 0);
+  if (minPartitionWriterBytes_ > 0) {
+    tablePartitionWriterBytes_.resize(numTablePartitions_, 0);
+  }
   writerAssignmmentIndicesBuffers_.resize(numPartitions_);
   rawWriterAssignmmentIndicesBuffers_.resize(numPartitions_);
 
@@ -194,6 +199,7 @@ void ScaleWriterPartitioningLocalPartition::addInput(RowVectorPtr input) {
       }
     }
   }
+  advancePartitionWriters(numInput, totalInputBytes);
 
   // Only update the scaling state if the memory used is below the
   // 'maxQueryMemoryUsageRatio_' limit. Otherwise, if we keep updating the
@@ -213,10 +219,38 @@ void ScaleWriterPartitioningLocalPartition::addInput(RowVectorPtr input) {
 
 uint32_t ScaleWriterPartitioningLocalPartition::getNextWriterId(
     uint32_t partitionId) {
+  if (minPartitionWriterBytes_ > 0) {
+    // Stays on the current writer until advancePartitionWriters() moves on.
+    return tablePartitionRebalancer_->getTaskId(
+        partitionId, tablePartitionWriterIndexes_[partitionId]);
+  }
   return tablePartitionRebalancer_->getTaskId(
       partitionId, tablePartitionWriterIndexes_[partitionId]++);
 }
 
+void ScaleWriterPartitioningLocalPartition::advancePartitionWriters(
+    vector_size_t numInput,
+    int64_t inputBytes) {
+  if (minPartitionWriterBytes_ == 0) {
+    return;
+  }
+  // A partition scaled to more writers keeps filling the file of its current
+  // writer, instead of adding a little to the files of all of them.
+  for (auto tablePartition = 0; tablePartition < numTablePartitions_;
+       ++tablePartition) {
+    const auto numRows = tablePartitionRowCounts_[tablePartition];
+    if (numRows == 0) {
+      continue;
+    }
+    auto& writerBytes = tablePartitionWriterBytes_[tablePartition];
+    writerBytes += inputBytes * numRows / numInput;
+    if (writerBytes >= minPartitionWriterBytes_) {
+      ++tablePartitionWriterIndexes_[tablePartition];
+      writerBytes = 0;
+    }
+  }
+}
+
 void ScaleWriterPartitioningLocalPartition::close() {
   LocalPartition::close();
 
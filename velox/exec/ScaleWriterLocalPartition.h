@@ -53,6 +53,10 @@ class ScaleWriterPartitioningLocalPartition : public LocalPartition {
 
   uint32_t getNextWriterId(uint32_t partitionId);
 
+  // Moves a logical table partition to its next assigned writer once the
+  // current writer has received 'minPartitionWriterBytes_' of its data.
+  void advancePartitionWriters(vector_size_t numInput, int64_t inputBytes);
+
   // The max query memory usage ratio before we stop writer scaling.
   const double maxQueryMemoryUsageRatio_;
   // The max number of logical table partitions that can be assigned to a single
@@ -62,6 +66,10 @@ class ScaleWriterPartitioningLocalPartition : public LocalPartition {
   // The total number of logical table partitions that can be served by all the
   // table writer threads.
   const uint32_t numTablePartitions_;
+  // The min amount of data of a logical table partition sent to one writer
+  // before the next assigned writer. 0 if the rows of each input are spread
+  // across all the assigned writers.
+  const uint64_t minPartitionWriterBytes_;
 
   memory::MemoryPool* const queryPool_;
 
@@ -74,6 +82,9 @@ class ScaleWriterPartitioningLocalPartition : public LocalPartition {
   std::vector<uint32_t> tablePartitionRowCounts_;
   std::vector<int32_t> tablePartitionWriterIds_;
   std::vector<uint32_t> tablePartitionWriterIndexes_;
+  // The bytes of each logical table partition sent to its current writer if
+  // 'minPartitionWriterBytes_' is set.
+  std::vector<uint64_t> tablePartitionWriterBytes_;
 
   // Reusable memory for writer assignment processing.
   std::vector<vector_size_t> writerAssignmentCounts_;
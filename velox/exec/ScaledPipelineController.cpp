@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/ScaledPipelineController.h"
+
+#include <folly/ScopeGuard.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+
+ScaledPipelineController::ScaledPipelineController(uint32_t numDrivers)
+    : numDrivers_(numDrivers),
+      maxRunningDrivers_(numDrivers),
+      reported_(numDrivers, false),
+      driverRates_(numDrivers, 0),
+      driverPromises_(numDrivers) {
+  VELOX_CHECK_GT(numDrivers_, 0);
+}
+
+ScaledPipelineController::~ScaledPipelineController() {
+  close();
+}
+
+bool ScaledPipelineController::shouldStop(
+    uint32_t driverIdx,
+    ContinueFuture* future) {
+  VELOX_CHECK_LT(driverIdx, numDrivers_);
+
+  std::lock_guard<std::mutex> l(lock_);
+  if (closed_ || driverIdx < numRunningDrivers_) {
+    return false;
+  }
+
+  VELOX_CHECK(!driverPromises_[driverIdx].has_value());
+  auto [driverPromise, driverFuture] = makeVeloxContinuePromiseContract(
+      fmt::format("Pipeline driver {} scale promise", driverIdx));
+  driverPromises_[driverIdx] = std::move(driverPromise);
+  *future = std::move(driverFuture);
+  return true;
+}
+
+void ScaledPipelineController::updateAndTryScale(
+    uint32_t driverIdx,
+    const DriverSignals& signals) {
+  VELOX_CHECK_LT(driverIdx, numDrivers_);
+
+  std::optional<ContinuePromise> driverPromise;
+  SCOPE_EXIT {
+    if (driverPromise.has_value()) {
+      driverPromise->setValue();
+    }
+  };
+  std::lock_guard<std::mutex> l(lock_);
+  // A driver parked by a scale down may report once more before it parks.
+  if (closed_ || driverIdx >= numRunningDrivers_) {
+    return;
+  }
+
+  windowSignals_.cpuNanos += signals.cpuNanos;
+  windowSignals_.inputBlockedNanos += signals.inputBlockedNanos;
+  windowSignals_.outputBlockedNanos += signals.outputBlockedNanos;
+  windowSignals_.outputRows += signals.outputRows;
+  if (signals.wallNanos > 0) {
+    driverRates_[driverIdx] = signals.outputRows * 1e9 / signals.wallNanos;
+  }
+  if (!reported_[driverIdx]) {
+    reported_[driverIdx] = true;
+    ++numReported_;
+  }
+  tryScaleLocked(driverPromise);
+}
+
+void ScaledPipelineController::tryScaleLocked(
+    std::optional<ContinuePromise>& driverPromise) {
+  // Decides only once all the running drivers have reported, so that a
+  // decision sees the effect of the previous one on all drivers.
+  if (numReported_ < numRunningDrivers_) {
+    return;
+  }
+  const uint64_t totalNanos = windowSignals_.cpuNanos +
+      windowSignals_.inputBlockedNanos + windowSignals_.outputBlockedNanos;
+  if (totalNanos == 0) {
+    return;
+  }
+
+  double rate{0};
+  for (auto i = 0; i < numRunningDrivers_; ++i) {
+    rate += driverRates_[i];
+  }
+  if (rateBeforeScaleUp_.has_value()) {
+    if (rate < rateBeforeScaleUp_.value() * (1 + kMinScaleUpGain)) {
+      // The last started driver did not add throughput, e.g. because of
+      // contention on a shared resource. Stops scaling up.
+      maxRunningDrivers_ = numRunningDrivers_;
+    }
+    rateBeforeScaleUp_.reset();
+  }
+
+  if (windowSignals_.outputBlockedNanos >=
+      totalNanos * kScaleDownBlockedRatio) {
+    if (numRunningDrivers_ > 1) {
+      --numRunningDrivers_;
+      ++numScaleDowns_;
+      driverRates_[numRunningDrivers_] = 0;
+    }
+  } else if (
+      windowSignals_.cpuNanos >= totalNanos * kScaleUpBusyRatio &&
+      numRunningDrivers_ < maxRunningDrivers_) {
+    rateBeforeScaleUp_ = rate;
+    ++numRunningDrivers_;
+    peakRunningDrivers_ = std::max(peakRunningDrivers_, numRunningDrivers_);
+    auto& promise = driverPromises_[numRunningDrivers_ - 1];
+    if (promise.has_value()) {
+      driverPromise = std::move(promise);
+      promise.reset();
+    }
+  }
+  resetWindowLocked();
+}
+
+void ScaledPipelineController::resetWindowLocked() {
+  windowSignals_ = {};
+  std::fill(reported_.begin(), reported_.end(), false);
+  numReported_ = 0;
+}
+
+bool ScaledPipelineController::close() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    if (closed_) {
+      return false;
+    }
+
+    promises.reserve(driverPromises_.size());
+    for (auto& promise : driverPromises_) {
+      if (promise.has_value()) {
+        promises.emplace_back(std::move(promise.value()));
+        promise.reset();
+      }
+    }
+    closed_ = true;
+  }
+
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  return true;
+}
+
+std::string ScaledPipelineController::Stats::toString() const {
+  return fmt::format(
+      "numRunningDrivers: {}, peakRunningDrivers: {}, numScaleDowns: {}",
+      numRunningDrivers,
+      peakRunningDrivers,
+      numScaleDowns);
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "velox/common/future/VeloxPromise.h"
+
+namespace facebook::velox::exec {
+
+/// Controller used to scale the number of running drivers of a pipeline based
+/// on where its drivers spend their time. Used by pipelines whose drivers pull
+/// input from a source shared by all drivers, e.g. a remote exchange, so that
+/// a parked driver does not hold back the input of the other drivers.
+///
+/// The pipeline starts with one running driver. Each running driver
+/// periodically reports the CPU time of its operators, the time its source
+/// waited for input, the time its operators waited for a downstream consumer
+/// and the rows it produced. Once all the running drivers have reported, the
+/// controller:
+///  - parks the last running driver if the drivers spend more than
+///    kScaleDownBlockedRatio of their time waiting for a consumer, since more
+///    drivers only queue more data for the downstream;
+///  - starts one more driver if the drivers spend more than kScaleUpBusyRatio
+///    of their time on CPU, unless the last scale up did not raise the output
+///    rate of the pipeline by kMinScaleUpGain, in which case the pipeline does
+///    not scale up further.
+/// A driver is parked when it asks shouldStop() for more input, so that it does
+/// not hold any input while parked.
+class ScaledPipelineController {
+ public:
+  /// The min fraction of the time of the running drivers spent on CPU to start
+  /// one more driver.
+  static constexpr double kScaleUpBusyRatio = 0.8;
+
+  /// The min fraction of the time of the running drivers spent waiting for a
+  /// downstream consumer to park one driver.
+  static constexpr double kScaleDownBlockedRatio = 0.5;
+
+  /// The min increase in the output rate of the pipeline from the last scale
+  /// up for scaling up further.
+  static constexpr double kMinScaleUpGain = 0.1;
+
+  /// The time spent by a driver since its previous report.
+  struct DriverSignals {
+    /// The CPU time of the operators of the driver.
+    uint64_t cpuNanos{0};
+    /// The time the source operator waited for input.
+    uint64_t inputBlockedNanos{0};
+    /// The time the operators waited for a downstream consumer.
+    uint64_t outputBlockedNanos{0};
+    /// The rows produced by the source operator.
+    uint64_t outputRows{0};
+    /// The wall time since the previous report.
+    uint64_t wallNanos{0};
+  };
+
+  /// 'numDrivers' is the number of drivers of the pipeline.
+  explicit ScaledPipelineController(uint32_t numDrivers);
+
+  ~ScaledPipelineController();
+
+  ScaledPipelineController(const ScaledPipelineController&) = delete;
+  ScaledPipelineController(ScaledPipelineController&&) = delete;
+  ScaledPipelineController& operator=(const ScaledPipelineController&) =
+      delete;
+  ScaledPipelineController& operator=(ScaledPipelineController&&) = delete;
+
+  /// Invoked by the source operator of driver 'driverIdx' before it gets more
+  /// input. Returns true if the driver is parked and sets 'future' to a future
+  /// that is ready when the controller starts the driver again or is closed.
+  bool shouldStop(uint32_t driverIdx, ContinueFuture* future);
+
+  /// Invoked by the source operator of driver 'driverIdx' to report the time
+  /// spent by the driver since its previous report. Scales the pipeline up or
+  /// down once all the running drivers have reported.
+  void updateAndTryScale(uint32_t driverIdx, const DriverSignals& signals);
+
+  struct Stats {
+    uint32_t numRunningDrivers{0};
+    uint32_t peakRunningDrivers{0};
+    uint32_t numScaleDowns{0};
+
+    std::string toString() const;
+  };
+
+  Stats stats() const {
+    std::lock_guard<std::mutex> l(lock_);
+    return {
+        .numRunningDrivers = numRunningDrivers_,
+        .peakRunningDrivers = peakRunningDrivers_,
+        .numScaleDowns = numScaleDowns_};
+  }
+
+  /// Invoked when the input of the pipeline is exhausted or by the closed
+  /// source operator to start all the parked drivers. Returns true on the
+  /// first invocation, and otherwise false.
+  bool close();
+
+ private:
+  // Scales up or down if all the running drivers have reported. Sets
+  // 'driverPromise' to the promise of a parked driver to start.
+  void tryScaleLocked(std::optional<ContinuePromise>& driverPromise);
+
+  // Clears the reports of the current decision window.
+  void resetWindowLocked();
+
+  const uint32_t numDrivers_;
+
+  mutable std::mutex lock_;
+  uint32_t numRunningDrivers_{1};
+  uint32_t peakRunningDrivers_{1};
+  uint32_t numScaleDowns_{0};
+
+  // The max number of running drivers. Lowered when a scale up does not raise
+  // the output rate.
+  uint32_t maxRunningDrivers_;
+
+  // The output rate in rows per second before the last scale up, if the
+  // pipeline scaled up since the last decision.
+  std::optional<double> rateBeforeScaleUp_;
+
+  // The reports of the running drivers since the last decision.
+  DriverSignals windowSignals_;
+  std::vector<bool> reported_;
+  uint32_t numReported_{0};
+
+  // The output rate in rows per second of each driver in its last report.
+  std::vector<double> driverRates_;
+
+  // The driver resume promises with one per each driver index.
+  std::vector<std::optional<ContinuePromise>> driverPromises_;
+
+  bool closed_{false};
+};
+} // namespace facebook::velox::exec
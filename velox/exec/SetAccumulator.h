@@ -15,9 +15,9 @@
  */
 #pragma once
 
-#include <folly/container/F14Set.h>
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/AddressableNonNullValueList.h"
+#include "velox/exec/SmallHashMap.h"
 #include "velox/exec/Strings.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DecodedVector.h"
@@ -27,8 +27,9 @@ namespace facebook::velox::aggregate::prestosql {
 
 namespace detail {
 
-/// Maintains a set of unique values. Non-null values are stored in F14FastSet.
-/// A separate flag tracks presence of the null value.
+/// Maintains a set of unique values. Non-null values are stored in
+/// SmallHashMap, which keeps small sets inline. A separate flag tracks presence
+/// of the null value.
 template <
     typename T,
     typename Hash = std::hash<T>,
@@ -36,25 +37,13 @@ template <
 struct SetAccumulator {
   std::optional<vector_size_t> nullIndex;
 
-  folly::F14FastMap<
-      T,
-      int32_t,
-      Hash,
-      EqualTo,
-      AlignedStlAllocator<std::pair<const T, vector_size_t>, 16>>
-      uniqueValues;
+  SmallHashMap<T, int32_t, Hash, EqualTo> uniqueValues;
 
   SetAccumulator(const TypePtr& /*type*/, HashStringAllocator* allocator)
-      : uniqueValues{AlignedStlAllocator<std::pair<const T, vector_size_t>, 16>(
-            allocator)} {}
+      : uniqueValues{allocator} {}
 
   SetAccumulator(Hash hash, EqualTo equalTo, HashStringAllocator* allocator)
-      : uniqueValues{
-            0,
-            hash,
-            equalTo,
-            AlignedStlAllocator<std::pair<const T, vector_size_t>, 16>(
-                allocator)} {}
+      : uniqueValues{allocator, hash, equalTo} {}
 
   /// Adds value if new. No-op if the value was added before.
   void addValue(
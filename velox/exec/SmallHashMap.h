@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/hash/Hash.h>
+#include <type_traits>
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/memory/HashStringAllocator.h"
+
+namespace facebook::velox::aggregate::prestosql {
+
+/// An insert-only hash map for the per-group state of aggregations like
+/// set_agg, map_agg and histogram, where most groups hold few entries.
+///
+/// Entries are stored in a dense array in insertion order. The first
+/// kInlineCapacity entries are stored inside the map and are found by a
+/// linear search, so that small groups allocate no memory. Larger maps move
+/// the entries to an array allocated from HashStringAllocator and index them
+/// with an open-addressing table of 32-bit entry numbers with linear probing.
+/// That table has twice as many slots as the entry array, so it is at most
+/// half full.
+///
+/// Keys and values must be trivially destructible. Iteration yields
+/// std::pair<K, V>. The keys must not be modified through iterators.
+template <
+    typename K,
+    typename V,
+    typename Hash = std::hash<K>,
+    typename EqualTo = std::equal_to<K>>
+class SmallHashMap : private Hash, private EqualTo {
+ public:
+  using value_type = std::pair<K, V>;
+  using iterator = value_type*;
+  using const_iterator = const value_type*;
+
+  static_assert(std::is_trivially_destructible_v<value_type>);
+
+  explicit SmallHashMap(
+      HashStringAllocator* allocator,
+      Hash hash = {},
+      EqualTo equalTo = {})
+      : Hash{hash}, EqualTo{equalTo}, allocator_{allocator} {}
+
+  SmallHashMap(const SmallHashMap&) = delete;
+  SmallHashMap& operator=(const SmallHashMap&) = delete;
+
+  ~SmallHashMap() {
+    freeHeap();
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  iterator begin() {
+    return entries();
+  }
+
+  iterator end() {
+    return entries() + size_;
+  }
+
+  const_iterator begin() const {
+    return entries();
+  }
+
+  const_iterator end() const {
+    return entries() + size_;
+  }
+
+  /// Returns the entry for 'key' or end() if there is none.
+  iterator find(const K& key) {
+    return entries() + findIndex(key);
+  }
+
+  const_iterator find(const K& key) const {
+    return entries() + findIndex(key);
+  }
+
+  bool contains(const K& key) const {
+    return findIndex(key) < size_;
+  }
+
+  /// Adds 'entry' if there is no entry with the same key. Returns the entry
+  /// with the key of 'entry' and true if it was added.
+  std::pair<iterator, bool> insert(const value_type& entry) {
+    if (isInline()) {
+      const auto index = findInline(entry.first);
+      if (index < size_) {
+        return {entries() + index, false};
+      }
+      if (size_ < kInlineCapacity) {
+        auto* newEntry = entries() + size_;
+        new (newEntry) value_type(entry);
+        ++size_;
+        return {newEntry, true};
+      }
+      grow();
+      return {append(entry, findSlot(entry.first)), true};
+    }
+    auto slot = findSlot(entry.first);
+    if (const auto index = heap().slots[slot]; index != 0) {
+      return {heap().entries + index - 1, false};
+    }
+    if (size_ == capacity_) {
+      grow();
+      slot = findSlot(entry.first);
+    }
+    return {append(entry, slot), true};
+  }
+
+  /// Returns the value for 'key'. Adds a value-initialized one if there is no
+  /// entry for 'key'.
+  V& operator[](const K& key) {
+    return insert({key, V{}}).first->second;
+  }
+
+ private:
+  struct Heap {
+    value_type* entries;
+    uint32_t* slots;
+  };
+
+  // Entries are stored inline only if that does not need a stronger alignment
+  // than the pointers in Heap. Accumulators are not guaranteed to be aligned
+  // beyond that.
+  static constexpr size_t kMaxInlineBytes = 32;
+  static constexpr int32_t kInlineCapacity =
+      alignof(value_type) > alignof(Heap)
+      ? 0
+      : std::max<int32_t>(1, kMaxInlineBytes / sizeof(value_type));
+  static constexpr size_t kStorageBytes =
+      std::max(sizeof(Heap), kInlineCapacity * sizeof(value_type));
+
+  using EntryAllocator = AlignedStlAllocator<value_type, 16>;
+  using SlotAllocator = StlAllocator<uint32_t>;
+
+  bool isInline() const {
+    return capacity_ == kInlineCapacity;
+  }
+
+  Heap& heap() {
+    return *reinterpret_cast<Heap*>(storage_);
+  }
+
+  const Heap& heap() const {
+    return *reinterpret_cast<const Heap*>(storage_);
+  }
+
+  value_type* entries() {
+    return isInline() ? reinterpret_cast<value_type*>(storage_)
+                      : heap().entries;
+  }
+
+  const value_type* entries() const {
+    return isInline() ? reinterpret_cast<const value_type*>(storage_)
+                      : heap().entries;
+  }
+
+  uint64_t hashKey(const K& key) const {
+    // The hash may be the identity, e.g. std::hash<int64_t>. Mix it so that
+    // the low bits used as the slot number depend on all bits.
+    return folly::hash::twang_mix64(static_cast<const Hash&>(*this)(key));
+  }
+
+  bool equals(const K& left, const K& right) const {
+    return static_cast<const EqualTo&>(*this)(left, right);
+  }
+
+  // Returns the index of the entry for 'key' or 'size_' if there is none.
+  int32_t findIndex(const K& key) const {
+    if (isInline()) {
+      return findInline(key);
+    }
+    const auto index = heap().slots[findSlot(key)];
+    return index == 0 ? size_ : index - 1;
+  }
+
+  int32_t findInline(const K& key) const {
+    const auto* inlineEntries = entries();
+    for (int32_t i = 0; i < size_; ++i) {
+      if (equals(inlineEntries[i].first, key)) {
+        return i;
+      }
+    }
+    return size_;
+  }
+
+  // Returns the slot with the entry for 'key' or the empty slot where it
+  // would be added.
+  uint32_t findSlot(const K& key) const {
+    const uint32_t mask = 2 * capacity_ - 1;
+    const auto* heapSlots = heap().slots;
+    const auto* heapEntries = heap().entries;
+    for (uint32_t slot = hashKey(key) & mask;; slot = (slot + 1) & mask) {
+      const auto index = heapSlots[slot];
+      if (index == 0 || equals(heapEntries[index - 1].first, key)) {
+        return slot;
+      }
+    }
+  }
+
+  iterator append(const value_type& entry, uint32_t slot) {
+    VELOX_DCHECK_LT(size_, capacity_);
+    auto* newEntry = heap().entries + size_;
+    new (newEntry) value_type(entry);
+    heap().slots[slot] = ++size_;
+    return newEntry;
+  }
+
+  // Moves the entries to a new heap array with twice the capacity and
+  // rebuilds the slot table.
+  void grow() {
+    const int32_t newCapacity =
+        bits::nextPowerOfTwo(std::max<int32_t>(4, 2 * capacity_));
+    VELOX_CHECK_LE(
+        newCapacity, std::numeric_limits<int32_t>::max() / 2, "Too many keys");
+    auto* newEntries = EntryAllocator(allocator_).allocate(newCapacity);
+    auto* oldEntries = entries();
+    for (int32_t i = 0; i < size_; ++i) {
+      new (newEntries + i) value_type(oldEntries[i]);
+    }
+    auto* newSlots = SlotAllocator(allocator_).allocate(2 * newCapacity);
+    std::fill(newSlots, newSlots + 2 * newCapacity, 0);
+
+    freeHeap();
+    capacity_ = newCapacity;
+    heap() = Heap{newEntries, newSlots};
+
+    const uint32_t mask = 2 * capacity_ - 1;
+    for (int32_t i = 0; i < size_; ++i) {
+      auto slot = hashKey(newEntries[i].first) & mask;
+      while (newSlots[slot] != 0) {
+        slot = (slot + 1) & mask;
+      }
+      newSlots[slot] = i + 1;
+    }
+  }
+
+  void freeHeap() {
+    if (isInline()) {
+      return;
+    }
+    EntryAllocator(allocator_).deallocate(heap().entries, capacity_);
+    SlotAllocator(allocator_).deallocate(heap().slots, 2 * capacity_);
+  }
+
+  // Hash and EqualTo are base classes so that they take no space when empty.
+  HashStringAllocator* const allocator_;
+  // Number of entries and the capacity of the entry array.  The capacity is
+  // kInlineCapacity while the entries are inline.
+  int32_t size_{0};
+  int32_t capacity_{kInlineCapacity};
+  // Inline entries or Heap.
+  alignas(Heap) char storage_[kStorageBytes];
+};
+
+} // namespace facebook::velox::aggregate::prestosql
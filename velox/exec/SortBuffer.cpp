@@ -15,10 +15,51 @@
  */
 
 #include "SortBuffer.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/Spiller.h"
+#include "velox/exec/TreeOfLosers.h"
 
 namespace facebook::velox::exec {
+namespace {
+// The minimum number of rows in a run of a parallel sort. Smaller runs do not
+// pay for the merge.
+constexpr uint64_t kMinParallelSortRunRows = 16 << 10;
+
+// A sorted run of rows for merging the runs of a parallel sort.
+class SortedRowsStream : public MergeStream {
+ public:
+  SortedRowsStream(
+      const RowContainer* data,
+      const std::vector<CompareFlags>& compareFlags,
+      const std::vector<char*, memory::StlAllocator<char*>>& rows)
+      : data_(data),
+        compareFlags_(compareFlags),
+        next_(rows.data()),
+        end_(rows.data() + rows.size()) {}
+
+  bool hasData() const override {
+    return next_ < end_;
+  }
+
+  bool operator<(const MergeStream& other) const override {
+    return data_->compareRows(
+               *next_,
+               *static_cast<const SortedRowsStream&>(other).next_,
+               compareFlags_) < 0;
+  }
+
+  char* pop() {
+    return *next_++;
+  }
+
+ private:
+  const RowContainer* const data_;
+  const std::vector<CompareFlags>& compareFlags_;
+  char* const* next_;
+  char* const* const end_;
+};
+} // namespace
 
 SortBuffer::SortBuffer(
     const RowTypePtr& input,
@@ -28,7 +69,9 @@ SortBuffer::SortBuffer(
     tsan_atomic<bool>* nonReclaimableSection,
     common::PrefixSortConfig prefixSortConfig,
     const common::SpillConfig* spillConfig,
-    folly::Synchronized<velox::common::SpillStats>* spillStats)
+    folly::Synchronized<velox::common::SpillStats>* spillStats,
+    folly::Executor* sortExecutor,
+    uint32_t maxParallelSortRuns)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       pool_(pool),
@@ -36,6 +79,8 @@ SortBuffer::SortBuffer(
       prefixSortConfig_(prefixSortConfig),
       spillConfig_(spillConfig),
       spillStats_(spillStats),
+      sortExecutor_(sortExecutor),
+      maxParallelSortRuns_(maxParallelSortRuns),
       sortedRows_(0, memory::StlAllocator<char*>(*pool)) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
@@ -131,8 +176,7 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    PrefixSort::sort(
-        data_.get(), sortCompareFlags_, prefixSortConfig_, pool_, sortedRows_);
+    sortRows();
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -309,9 +353,10 @@ void SortBuffer::ensureSortFits() {
     return;
   }
 
-  // The memory for std::vector sorted rows and prefix sort required buffer.
+  // The memory for std::vector sorted rows and prefix sort required buffer. A
+  // parallel sort keeps a second copy of the row pointers in the sort runs.
   uint64_t sortBufferToReserve =
-      numInputRows_ * sizeof(char*) +
+      numInputRows_ * sizeof(char*) * (numParallelSortRuns() > 1 ? 2 : 1) +
       PrefixSort::maxRequiredBytes(
           data_.get(), sortCompareFlags_, prefixSortConfig_, pool_);
   {
@@ -329,6 +374,73 @@ void SortBuffer::ensureSortFits() {
       succinctBytes(pool_->reservedBytes()));
 }
 
+uint32_t SortBuffer::numParallelSortRuns() const {
+  if (sortExecutor_ == nullptr || maxParallelSortRuns_ <= 1) {
+    return 1;
+  }
+  return std::max<uint64_t>(
+      1,
+      std::min<uint64_t>(
+          maxParallelSortRuns_, numInputRows_ / kMinParallelSortRunRows));
+}
+
+void SortBuffer::sortRows() {
+  const auto numRuns = numParallelSortRuns();
+  if (numRuns == 1) {
+    PrefixSort::sort(
+        data_.get(), sortCompareFlags_, prefixSortConfig_, pool_, sortedRows_);
+    return;
+  }
+
+  std::vector<std::vector<char*, memory::StlAllocator<char*>>> runs;
+  runs.reserve(numRuns);
+  std::vector<std::shared_ptr<AsyncSource<bool>>> sortSteps;
+  sortSteps.reserve(numRuns);
+  for (auto i = 0; i < numRuns; ++i) {
+    const auto begin = sortedRows_.size() * i / numRuns;
+    const auto end = sortedRows_.size() * (i + 1) / numRuns;
+    runs.emplace_back(
+        sortedRows_.begin() + begin,
+        sortedRows_.begin() + end,
+        memory::StlAllocator<char*>(*pool_));
+    sortSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, run = &runs.back()]() {
+          PrefixSort::sort(
+              data_.get(), sortCompareFlags_, prefixSortConfig_, pool_, *run);
+          return std::make_unique<bool>(true);
+        }));
+    sortExecutor_->add([step = sortSteps.back()]() { step->prepare(); });
+  }
+
+  // All the steps must complete before returning, also in case of error, as
+  // they reference 'runs'.
+  std::exception_ptr error;
+  for (auto& step : sortSteps) {
+    try {
+      step->move();
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+
+  std::vector<std::unique_ptr<SortedRowsStream>> streams;
+  streams.reserve(numRuns);
+  for (const auto& run : runs) {
+    streams.push_back(std::make_unique<SortedRowsStream>(
+        data_.get(), sortCompareFlags_, run));
+  }
+  TreeOfLosers<SortedRowsStream> merger(std::move(streams));
+  for (auto& row : sortedRows_) {
+    auto* stream = merger.next();
+    VELOX_CHECK_NOT_NULL(stream);
+    row = stream->pop();
+  }
+  VELOX_CHECK_NULL(merger.next());
+}
+
 void SortBuffer::updateEstimatedOutputRowSize() {
   const auto optionalRowSize = data_->estimateRowSize();
   if (!optionalRowSize.has_value() || optionalRowSize.value() == 0) {
@@ -492,7 +604,11 @@ void SortBuffer::prepareOutputWithSpill() {
 
   VELOX_CHECK_EQ(spillPartitionSet_.size(), 1);
   spillMerger_ = spillPartitionSet_.begin()->second->createOrderedReader(
-      spillConfig_->readBufferSize, pool(), spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      spillStats_,
+      spillConfig_->executor,
+      spillConfig_->numReadAheadBuffers);
   spillPartitionSet_.clear();
 }
 } // namespace facebook::velox::exec
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
@@ -30,6 +32,10 @@ class SortOutputSpiller;
 /// A utility class to accumulate data inside and output the sorted result.
 /// Spilling would be triggered if spilling is enabled and memory usage exceeds
 /// limit.
+///
+/// If 'sortExecutor' is set, the in-memory rows are split into up to
+/// 'maxParallelSortRuns' runs which are sorted in parallel on 'sortExecutor'
+/// and merged into the sorted output.
 class SortBuffer {
  public:
   SortBuffer(
@@ -40,7 +46,9 @@ class SortBuffer {
       tsan_atomic<bool>* nonReclaimableSection,
       common::PrefixSortConfig prefixSortConfig,
       const common::SpillConfig* spillConfig = nullptr,
-      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr);
+      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr,
+      folly::Executor* sortExecutor = nullptr,
+      uint32_t maxParallelSortRuns = 1);
 
   ~SortBuffer();
 
@@ -83,6 +91,15 @@ class SortBuffer {
 
   void updateEstimatedOutputRowSize();
 
+  // Returns the number of runs to split the in-memory rows into for parallel
+  // sort. Returns 1 if the rows are sorted on the calling thread.
+  uint32_t numParallelSortRuns() const;
+
+  // Sorts 'sortedRows_' in place. If there are multiple sort runs, each run is
+  // sorted on 'sortExecutor_' and the sorted runs are merged back into
+  // 'sortedRows_'.
+  void sortRows();
+
   // Invoked to initialize or reset the reusable output buffer to get output.
   void prepareOutput(vector_size_t outputBatchSize);
 
@@ -127,6 +144,10 @@ class SortBuffer {
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
+  folly::Executor* const sortExecutor_;
+
+  const uint32_t maxParallelSortRuns_;
+
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
   std::vector<IdentityProjection> columnMap_;
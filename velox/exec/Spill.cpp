@@ -103,7 +103,9 @@ SpillState::SpillState(
     const std::optional<common::PrefixSortConfig>& prefixSortConfig,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    folly::Executor* writeExecutor,
+    uint32_t compressionDictionarySize)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -116,6 +118,8 @@ SpillState::SpillState(
       compressionKind_(compressionKind),
       prefixSortConfig_(prefixSortConfig),
       fileCreateConfig_(fileCreateConfig),
+      writeExecutor_(writeExecutor),
+      compressionDictionarySize_(compressionDictionarySize),
       pool_(pool),
       stats_(stats),
       partitionWriters_(maxPartitions_) {}
@@ -151,10 +155,6 @@ uint64_t SpillState::appendToPartition(
   TestValue::adjust(
       "facebook::velox::exec::SpillState::appendToPartition", this);
 
-  VELOX_CHECK_NOT_NULL(
-      getSpillDirPathCb_, "Spill directory callback not specified.");
-  auto spillDir = getSpillDirPathCb_();
-  VELOX_CHECK(!spillDir.empty(), "Spill directory does not exist");
   // Ensure that partition exist before writing.
   if (partitionWriters_.at(partition) == nullptr) {
     partitionWriters_[partition] = std::make_unique<SpillWriter>(
@@ -162,13 +162,16 @@ uint64_t SpillState::appendToPartition(
         numSortKeys_,
         sortCompareFlags_,
         compressionKind_,
-        fmt::format("{}/{}-spill-{}", spillDir, fileNamePrefix_, partition),
+        getSpillDirPathCb_,
+        fmt::format("{}-spill-{}", fileNamePrefix_, partition),
         targetFileSize_,
         writeBufferSize_,
         fileCreateConfig_,
         updateAndCheckSpillLimitCb_,
         pool_,
-        stats_);
+        stats_,
+        writeExecutor_,
+        compressionDictionarySize_);
   }
 
   const uint64_t bytes = rows->estimateFlatSize();
@@ -297,12 +300,19 @@ std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* readAheadExecutor,
+    uint32_t numReadAheadBuffers) {
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        fileInfo,
+        bufferSize,
+        pool,
+        spillStats,
+        readAheadExecutor,
+        numReadAheadBuffers)));
   }
   files_.clear();
   // Check if the partition is empty or not.
@@ -316,11 +316,16 @@ class SpillPartition {
   /// 'bufferSize' specifies the read size from the storage. If the file
   /// system supports async read mode, then reader allocates two buffers with
   /// one buffer prefetch ahead. 'spillStats' is provided to collect the spill
-  /// stats when reading data from spilled files.
+  /// stats when reading data from spilled files. If 'numReadAheadBuffers' is
+  /// set, each file reads that many buffers ahead, on 'readAheadExecutor' if
+  /// the file system has no async read. This keeps the merge from waiting on
+  /// the read latency of each file.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* readAheadExecutor = nullptr,
+      uint32_t numReadAheadBuffers = 0);
 
   std::string toString() const;
 
@@ -344,7 +349,9 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'writeExecutor' is set, the partition writers write to disk
+  /// on it asynchronously. 'compressionDictionarySize' is the size of the
+  /// ZSTD dictionary each partition writer trains, 0 for none.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -358,7 +365,9 @@ class SpillState {
       const std::optional<common::PrefixSortConfig>& prefixSortConfig,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      folly::Executor* writeExecutor = nullptr,
+      uint32_t compressionDictionarySize = 0);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -465,6 +474,8 @@ class SpillState {
   const common::CompressionKind compressionKind_;
   const std::optional<common::PrefixSortConfig> prefixSortConfig_;
   const std::string fileCreateConfig_;
+  folly::Executor* const writeExecutor_;
+  const uint32_t compressionDictionarySize_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
@@ -17,6 +17,8 @@
 #include "velox/exec/SpillFile.h"
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/common/process/TraceEvents.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
@@ -27,6 +29,95 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+// The size of the samples the first write buffer is split into to train a
+// compression dictionary. This is the size of a small page, which benefits
+// most from a dictionary.
+constexpr size_t kDictionarySampleSize = 16 << 10;
+
+// ZSTD recommends about 100 times the dictionary size of samples.
+constexpr size_t kDictionarySampleRatio = 100;
+
+serializer::presto::PrestoVectorSerde::PrestoOptions spillSerdeOptions(
+    common::CompressionKind compressionKind,
+    std::shared_ptr<const common::ZstdDictionary> compressionDictionary) {
+  serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+      kDefaultUseLosslessTimestamp,
+      compressionKind,
+      0.8,
+      /*nullsFirst=*/true};
+  options.compressionDictionary = std::move(compressionDictionary);
+  return options;
+}
+
+// Wraps a spill file whose file system has no async read to read on an
+// executor, so that FileInputStream can read ahead. A read that has not
+// started on the executor when waited for runs on the waiting thread.
+class ExecutorReadFile : public ReadFile {
+ public:
+  ExecutorReadFile(std::unique_ptr<ReadFile> file, folly::Executor* executor)
+      : file_(std::move(file)), executor_(executor) {
+    VELOX_CHECK_NOT_NULL(executor_);
+  }
+
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      filesystems::File::IoStats* stats = nullptr) const override {
+    return file_->pread(offset, length, buf, stats);
+  }
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      filesystems::File::IoStats* stats = nullptr) const override {
+    auto source = std::make_shared<AsyncSource<uint64_t>>(
+        [this, offset, buffers, stats]() {
+          return std::make_unique<uint64_t>(
+              file_->preadv(offset, buffers, stats));
+        });
+    executor_->add([source]() { source->prepare(); });
+    return folly::makeSemiFuture().deferValue(
+        [source](folly::Unit) { return *source->move(); });
+  }
+
+  bool hasPreadvAsync() const override {
+    return true;
+  }
+
+  bool shouldCoalesce() const override {
+    return file_->shouldCoalesce();
+  }
+
+  uint64_t size() const override {
+    return file_->size();
+  }
+
+  uint64_t memoryUsage() const override {
+    return file_->memoryUsage();
+  }
+
+  uint64_t bytesRead() const override {
+    return file_->bytesRead();
+  }
+
+  void resetBytesRead() override {
+    file_->resetBytesRead();
+  }
+
+  std::string getName() const override {
+    return file_->getName();
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return file_->getNaturalReadSize();
+  }
+
+ private:
+  const std::unique_ptr<ReadFile> file_;
+  folly::Executor* const executor_;
+};
 } // namespace
 
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
@@ -77,45 +168,67 @@ SpillWriter::SpillWriter(
     const uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
-    const std::string& pathPrefix,
+    const common::GetSpillDirectoryPathCB& getSpillDirPathCb,
+    const std::string& fileNamePrefix,
     uint64_t targetFileSize,
     uint64_t writeBufferSize,
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* writeExecutor,
+    uint32_t compressionDictionarySize)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
-      pathPrefix_(pathPrefix),
+      getSpillDirPathCb_(getSpillDirPathCb),
+      fileNamePrefix_(fileNamePrefix),
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       fileCreateConfig_(fileCreateConfig),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
       serde_(getNamedVectorSerde(VectorSerde::Kind::kPresto)),
-      stats_(stats) {
+      stats_(stats),
+      writeExecutor_(writeExecutor),
+      compressionDictionarySize_(compressionDictionarySize),
+      trainDictionary_(
+          compressionDictionarySize_ > 0 &&
+          compressionKind_ == common::CompressionKind_ZSTD) {
+  VELOX_CHECK_NOT_NULL(
+      getSpillDirPathCb_, "Spill directory callback not specified.");
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortKeys_);
 }
 
+SpillWriter::~SpillWriter() {
+  // Waits for the write in flight as it references 'currentFile_'.
+  if (pendingWrite_ != nullptr) {
+    pendingWrite_->close();
+  }
+}
+
 SpillWriteFile* SpillWriter::ensureFile() {
   if ((currentFile_ != nullptr) && (currentFile_->size() > targetFileSize_)) {
     closeFile();
   }
   if (currentFile_ == nullptr) {
+    const auto spillDir = getSpillDirPathCb_();
+    VELOX_CHECK(!spillDir.empty(), "Spill directory does not exist");
     currentFile_ = SpillWriteFile::create(
         nextFileId_++,
-        fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
+        fmt::format(
+            "{}/{}-{}", spillDir, fileNamePrefix_, finishedFiles_.size()),
         fileCreateConfig_);
   }
   return currentFile_.get();
 }
 
 void SpillWriter::closeFile() {
+  waitForPendingWrite();
   if (currentFile_ == nullptr) {
     return;
   }
@@ -128,7 +241,8 @@ void SpillWriter::closeFile() {
       .size = currentFile_->size(),
       .numSortKeys = numSortKeys_,
       .sortFlags = sortCompareFlags_,
-      .compressionKind = compressionKind_});
+      .compressionKind = compressionKind_,
+      .compressionDictionary = compressionDictionary_});
   currentFile_.reset();
 }
 
@@ -140,9 +254,9 @@ uint64_t SpillWriter::flush() {
   if (batch_ == nullptr) {
     return 0;
   }
-
-  auto* file = ensureFile();
-  VELOX_CHECK_NOT_NULL(file);
+  process::TraceSpan span("spill", "write", [&]() {
+    return fmt::format("{} bytes", batch_->size());
+  });
 
   IOBufOutputStream out(
       *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
@@ -150,21 +264,97 @@ uint64_t SpillWriter::flush() {
   {
     NanosecondTimer timer(&flushTimeNs);
     batch_->flush(&out);
+    if (sampleBatch_ != nullptr) {
+      trainCompressionDictionary();
+    }
   }
   batch_.reset();
-
-  uint64_t writeTimeNs{0};
-  uint64_t writtenBytes{0};
   auto iobuf = out.getIOBuf();
-  {
-    NanosecondTimer timer(&writeTimeNs);
-    writtenBytes = file->write(std::move(iobuf));
+
+  if (writeExecutor_ != nullptr) {
+    // Double buffering: the previous buffer must be written before this one is
+    // scheduled, and the file size is only known after it is written.
+    waitForPendingWrite();
   }
-  updateWriteStats(writtenBytes, flushTimeNs, writeTimeNs);
+  auto* file = ensureFile();
+  VELOX_CHECK_NOT_NULL(file);
+
+  if (writeExecutor_ == nullptr) {
+    uint64_t writeTimeNs{0};
+    uint64_t writtenBytes{0};
+    {
+      NanosecondTimer timer(&writeTimeNs);
+      writtenBytes = file->write(std::move(iobuf));
+    }
+    updateWriteStats(writtenBytes, flushTimeNs, writeTimeNs);
+    updateAndCheckSpillLimitCb_(writtenBytes);
+    return writtenBytes;
+  }
+
+  const auto writtenBytes = iobuf->computeChainDataLength();
   updateAndCheckSpillLimitCb_(writtenBytes);
+  // NOTE: std::function requires a copyable callable, so the buffer is held by
+  // a shared_ptr. The buffer memory stays accounted to 'pool_' until the write
+  // completes.
+  std::shared_ptr<folly::IOBuf> buffer(iobuf.release());
+  pendingWrite_ = memory::createAsyncMemoryReclaimTask<PendingWrite>(
+      [file, buffer = std::move(buffer), flushTimeNs]() mutable {
+        uint64_t writeTimeNs{0};
+        uint64_t bytes{0};
+        {
+          NanosecondTimer timer(&writeTimeNs);
+          bytes = file->write(
+              std::make_unique<folly::IOBuf>(std::move(*buffer)));
+        }
+        return std::make_unique<PendingWrite>(
+            PendingWrite{bytes, flushTimeNs, writeTimeNs});
+      });
+  writeExecutor_->add([source = pendingWrite_]() { source->prepare(); });
   return writtenBytes;
 }
 
+void SpillWriter::trainCompressionDictionary() {
+  IOBufOutputStream out(*pool_, nullptr, sampleBatch_->size());
+  sampleBatch_->flush(&out);
+  sampleBatch_.reset();
+  trainDictionary_ = false;
+  auto iobuf = out.getIOBuf();
+  iobuf->coalesce();
+  const auto* data = reinterpret_cast<const char*>(iobuf->data());
+  const size_t maxSampleBytes =
+      kDictionarySampleRatio * compressionDictionarySize_;
+  std::vector<std::string_view> samples;
+  for (size_t offset = 0;
+       offset < iobuf->length() && offset < maxSampleBytes;
+       offset += kDictionarySampleSize) {
+    samples.emplace_back(
+        data + offset,
+        std::min(kDictionarySampleSize, iobuf->length() - offset));
+  }
+  // Without a dictionary the spill data is compressed as if there were no
+  // 'compressionDictionarySize_'.
+  compressionDictionary_ =
+      common::ZstdDictionary::train(samples, compressionDictionarySize_);
+  if (compressionDictionary_ != nullptr) {
+    addThreadLocalRuntimeStat(
+        "spillCompressionDictionarySize",
+        RuntimeCounter(
+            compressionDictionary_->data().size(),
+            RuntimeCounter::Unit::kBytes));
+  }
+}
+
+void SpillWriter::waitForPendingWrite() {
+  if (pendingWrite_ == nullptr) {
+    return;
+  }
+  auto pendingWrite = std::move(pendingWrite_);
+  auto result = pendingWrite->move();
+  VELOX_CHECK_NOT_NULL(result);
+  updateWriteStats(
+      result->writtenBytes, result->flushTimeNs, result->writeTimeNs);
+}
+
 uint64_t SpillWriter::write(
     const RowVectorPtr& rows,
     const folly::Range<IndexRange*>& indices) {
@@ -174,18 +364,22 @@ uint64_t SpillWriter::write(
   {
     NanosecondTimer timer(&timeNs);
     if (batch_ == nullptr) {
-      serializer::presto::PrestoVectorSerde::PrestoOptions options = {
-          kDefaultUseLosslessTimestamp,
-          compressionKind_,
-          0.8,
-          /*nullsFirst=*/true};
+      const auto type = std::static_pointer_cast<const RowType>(rows->type());
+      auto options =
+          spillSerdeOptions(compressionKind_, compressionDictionary_);
       batch_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
-      batch_->createStreamTree(
-          std::static_pointer_cast<const RowType>(rows->type()),
-          1'000,
-          &options);
+      batch_->createStreamTree(type, 1'000, &options);
+      if (trainDictionary_) {
+        auto sampleOptions =
+            spillSerdeOptions(common::CompressionKind_NONE, nullptr);
+        sampleBatch_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
+        sampleBatch_->createStreamTree(type, 1'000, &sampleOptions);
+      }
     }
     batch_->append(rows, indices);
+    if (sampleBatch_ != nullptr) {
+      sampleBatch_->append(rows, indices);
+    }
   }
   updateAppendStats(rows->size(), timeNs);
   if (batch_->size() < writeBufferSize_) {
@@ -268,7 +462,9 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats) {
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor,
+    uint32_t numReadAheadBuffers) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -278,8 +474,11 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.numSortKeys,
       fileInfo.sortFlags,
       fileInfo.compressionKind,
+      fileInfo.compressionDictionary,
       pool,
-      stats));
+      stats,
+      readAheadExecutor,
+      numReadAheadBuffers));
 }
 
 SpillReadFile::SpillReadFile(
@@ -291,8 +490,11 @@ SpillReadFile::SpillReadFile(
     uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
+    std::shared_ptr<const common::ZstdDictionary> compressionDictionary,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor,
+    uint32_t numReadAheadBuffers)
     : id_(id),
       path_(path),
       size_(size),
@@ -300,18 +502,23 @@ SpillReadFile::SpillReadFile(
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
-      readOptions_{
-          kDefaultUseLosslessTimestamp,
+      readOptions_{spillSerdeOptions(
           compressionKind_,
-          0.8,
-          /*nullsFirst=*/true},
+          std::move(compressionDictionary))},
       pool_(pool),
       serde_(getNamedVectorSerde(VectorSerde::Kind::kPresto)),
       stats_(stats) {
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
+  if (numReadAheadBuffers == 0) {
+    // Only reads ahead one buffer if the file system supports async read.
+    numReadAheadBuffers = 1;
+  } else if (readAheadExecutor != nullptr && !file->hasPreadvAsync()) {
+    file = std::make_unique<ExecutorReadFile>(
+        std::move(file), readAheadExecutor);
+  }
   input_ = std::make_unique<common::FileInputStream>(
-      std::move(file), bufferSize, pool_);
+      std::move(file), bufferSize, pool_, numReadAheadBuffers);
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
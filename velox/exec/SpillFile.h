@@ -18,9 +18,11 @@
 
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileInputStream.h"
 #include "velox/common/file/FileSystems.h"
@@ -90,6 +92,8 @@ struct SpillFileInfo {
   uint32_t numSortKeys;
   std::vector<CompareFlags> sortFlags;
   common::CompressionKind compressionKind;
+  /// The dictionary the pages of the file are compressed with, if any.
+  std::shared_ptr<const common::ZstdDictionary> compressionDictionary;
 };
 
 using SpillFiles = std::vector<SpillFileInfo>;
@@ -100,13 +104,20 @@ using SpillFiles = std::vector<SpillFileInfo>;
 class SpillWriter {
  public:
   /// 'type' is a RowType describing the content. 'numSortKeys' is the number
-  /// of leading columns on which the data is sorted. 'path' is a file path
-  /// prefix. ' 'targetFileSize' is the target byte size of a single file.
+  /// of leading columns on which the data is sorted. 'getSpillDirPathCb'
+  /// returns the directory to create each new file in, so a sequence of files
+  /// can be striped across multiple disks. 'fileNamePrefix' is the file name
+  /// prefix. 'targetFileSize' is the target byte size of a single file.
   /// 'writeBufferSize' specifies the size limit of the buffered data before
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
   /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// the spill write stats. If 'writeExecutor' is set, each full write buffer
+  /// is written to file on 'writeExecutor' while the next one is filled. At
+  /// most one buffer is in flight, so this holds up to two write buffers. If
+  /// 'compressionDictionarySize' is not 0 and 'compressionKind' is ZSTD, a
+  /// ZSTD dictionary of up to this many bytes is trained from the first write
+  /// buffer and the later ones are compressed with it.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -115,13 +126,18 @@ class SpillWriter {
       const uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
-      const std::string& pathPrefix,
+      const common::GetSpillDirectoryPathCB& getSpillDirPathCb,
+      const std::string& fileNamePrefix,
       uint64_t targetFileSize,
       uint64_t writeBufferSize,
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* writeExecutor = nullptr,
+      uint32_t compressionDictionarySize = 0);
+
+  ~SpillWriter();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -163,9 +179,17 @@ class SpillWriter {
   void closeFile();
 
   // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // written size. If 'writeExecutor_' is set, the write is scheduled on it and
+  // completes asynchronously.
   uint64_t flush();
 
+  // Waits for the asynchronous write in flight if any, and updates the write
+  // stats. Rethrows the write error if it fails.
+  void waitForPendingWrite();
+
+  // Trains 'compressionDictionary_' from 'sampleBatch_'.
+  void trainCompressionDictionary();
+
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
@@ -178,11 +202,19 @@ class SpillWriter {
       uint64_t flushTimeUs,
       uint64_t writeTimeUs);
 
+  // The result of an asynchronous write.
+  struct PendingWrite {
+    uint64_t writtenBytes;
+    uint64_t flushTimeNs;
+    uint64_t writeTimeNs;
+  };
+
   const RowTypePtr type_;
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
-  const std::string pathPrefix_;
+  const common::GetSpillDirectoryPathCB getSpillDirPathCb_;
+  const std::string fileNamePrefix_;
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
   const std::string fileCreateConfig_;
@@ -193,11 +225,22 @@ class SpillWriter {
   memory::MemoryPool* const pool_;
   VectorSerde* const serde_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const writeExecutor_;
+  const uint32_t compressionDictionarySize_;
 
   bool finished_{false};
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
+  // The rows of the first 'batch_' serialized without compression, to train
+  // 'compressionDictionary_' from.
+  std::unique_ptr<VectorStreamGroup> sampleBatch_;
+  // True until 'compressionDictionary_' is trained.
+  bool trainDictionary_;
+  std::shared_ptr<const common::ZstdDictionary> compressionDictionary_;
   std::unique_ptr<SpillWriteFile> currentFile_;
+  // The write of the previous buffer to 'currentFile_' which runs on
+  // 'writeExecutor_'.
+  std::shared_ptr<AsyncSource<PendingWrite>> pendingWrite_;
   SpillFiles finishedFiles_;
 };
 
@@ -210,11 +253,17 @@ class SpillWriter {
 /// rmdir() call.
 class SpillReadFile {
  public:
+  /// 'numReadAheadBuffers' is the number of 'bufferSize' buffers to read ahead
+  /// of the current read position. If it is zero, the file reads one buffer
+  /// ahead only if its file system supports async read. Otherwise, if the file
+  /// system has no async read, the reads ahead run on 'readAheadExecutor'.
   static std::unique_ptr<SpillReadFile> create(
       const SpillFileInfo& fileInfo,
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor = nullptr,
+      uint32_t numReadAheadBuffers = 0);
 
   uint32_t id() const {
     return id_;
@@ -249,8 +298,11 @@ class SpillReadFile {
       uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
+      std::shared_ptr<const common::ZstdDictionary> compressionDictionary,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor,
+      uint32_t numReadAheadBuffers);
 
   // Invoked to record spill read stats at the end of read input.
   void recordSpillStats();
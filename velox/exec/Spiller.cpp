@@ -18,6 +18,7 @@
 #include <folly/ScopeGuard.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/common/process/TraceEvents.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/HashJoinBridge.h"
@@ -57,7 +58,9 @@ SpillerBase::SpillerBase(
           spillConfig->prefixSortConfig,
           memory::spillMemoryPool(),
           spillStats,
-          spillConfig->fileCreateConfig) {
+          spillConfig->fileCreateConfig,
+          spillConfig->asyncWriteEnabled ? spillConfig->executor : nullptr,
+          spillConfig->compressionDictionarySize) {
   TestValue::adjust("facebook::velox::exec::SpillerBase", this);
 
   spillRuns_.reserve(state_.maxPartitions());
@@ -84,6 +87,9 @@ NoRowContainerSpiller::NoRowContainerSpiller(
 
 void SpillerBase::spill(const RowContainerIterator* startRowIter) {
   VELOX_CHECK(!finalized_);
+  process::TraceSpan span("spill", "spill", [&]() {
+    return fmt::format("{} rows", container_->numRows());
+  });
 
   markAllPartitionsSpilled();
 
@@ -427,6 +433,8 @@ SortOutputSpiller::SortOutputSpiller(
 void SortOutputSpiller::spill(SpillRows& rows) {
   VELOX_CHECK(!finalized_);
   VELOX_CHECK(!rows.empty());
+  process::TraceSpan span(
+      "spill", "spill", [&]() { return fmt::format("{} rows", rows.size()); });
 
   markAllPartitionsSpilled();
 
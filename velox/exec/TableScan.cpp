@@ -39,6 +39,8 @@ TableScan::TableScan(
       driverCtx_(driverCtx),
       maxSplitPreloadPerDriver_(
           driverCtx_->queryConfig().maxSplitPreloadPerDriver()),
+      maxSplitPreopenPerDriver_(
+          driverCtx_->queryConfig().maxSplitPreopenPerDriver()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
       connectorPool_(driverCtx_->task->addConnectorPoolLocked(
           planNodeId(),
@@ -51,7 +53,13 @@ TableScan::TableScan(
           driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()),
       scaledController_(driverCtx_->task->getScaledScanControllerLocked(
           driverCtx_->splitGroupId,
-          planNodeId())) {
+          planNodeId())),
+      fragmentResultCache_(
+          driverCtx_->fragmentResultCache != nullptr &&
+                  driverCtx_->fragmentResultCache->scanNodeId() ==
+                      planNodeId()
+              ? driverCtx_->fragmentResultCache
+              : nullptr) {
   readBatchSize_ = driverCtx_->queryConfig().preferredOutputBatchRows();
 }
 
@@ -112,10 +120,19 @@ RowVectorPtr TableScan::getOutput() {
     }
 
     if (needNewSplit_) {
+      if (fragmentResultCache_ != nullptr &&
+          fragmentResultCache_->hasPending()) {
+        // Lets the partial aggregation output the results of the last split
+        // before it gets the rows of the next one.
+        return nullptr;
+      }
+
       // A point for test code injection.
       TestValue::adjust("facebook::velox::exec::TableScan::getOutput", this);
 
       exec::Split split;
+      curStatus_ = "getOutput: checkPreopen";
+      checkPreopen();
       curStatus_ = "getOutput: task->getSplitOrFuture";
       blockingReason_ = driverCtx_->task->getSplitOrFuture(
           driverCtx_->splitGroupId,
@@ -123,7 +140,9 @@ RowVectorPtr TableScan::getOutput() {
           split,
           blockingFuture_,
           maxPreloadedSplits_,
-          splitPreloader_);
+          splitPreloader_,
+          maxPreopenedSplits_,
+          splitPreopener_);
       if (blockingReason_ != BlockingReason::kNotBlocked) {
         return nullptr;
       }
@@ -165,6 +184,22 @@ RowVectorPtr TableScan::getOutput() {
           connectorSplit->connectorId,
           "Got splits with different connector IDs");
 
+      if (fragmentResultCache_ != nullptr) {
+        curStatus_ = "getOutput: fragmentResultCache_->startSplit";
+        const auto lookup =
+            fragmentResultCache_->startSplit(*connectorSplit, pool());
+        if (lookup == FragmentResultCache::Lookup::kHit) {
+          addRuntimeStat(kFragmentResultCacheHits, RuntimeCounter(1));
+          ++stats_.wlock()->numSplits;
+          driverCtx_->task->splitFinished(true, currentSplitWeight_);
+          needNewSplit_ = true;
+          continue;
+        }
+        if (lookup == FragmentResultCache::Lookup::kMiss) {
+          addRuntimeStat(kFragmentResultCacheMisses, RuntimeCounter(1));
+        }
+      }
+
       if (dataSource_ == nullptr) {
         curStatus_ = "getOutput: creating dataSource_";
         connectorQueryCtx_ = operatorCtx_->createConnectorQueryCtx(
@@ -205,8 +240,11 @@ RowVectorPtr TableScan::getOutput() {
           return nullptr;
         }
         dataSource_->setFromDataSource(std::move(preparedDataSource));
+        splitStartIoWaitNanos_ = dataSource_->ioWaitNanos();
+        splitReadNanos_ = 0;
       } else {
         curStatus_ = "getOutput: adding split";
+        splitStartIoWaitNanos_ = dataSource_->ioWaitNanos();
         uint64_t addSplitTimeUs{0};
         {
           MicrosecondTimer timer(&addSplitTimeUs);
@@ -216,6 +254,7 @@ RowVectorPtr TableScan::getOutput() {
             "dataSourceAddSplitWallNanos",
             RuntimeCounter(
                 addSplitTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
+        splitReadNanos_ = addSplitTimeUs * 1'000;
       }
       curStatus_ = "getOutput: updating stats_.numSplits";
       ++stats_.wlock()->numSplits;
@@ -242,6 +281,9 @@ RowVectorPtr TableScan::getOutput() {
          &debugString_});
 
     int32_t readBatchSize = readBatchSize_;
+    if (const auto remainingLimit = remainingLimitHint()) {
+      readBatchSize = std::min<int64_t>(readBatchSize, *remainingLimit);
+    }
     if (maxFilteringRatio_ > 0) {
       readBatchSize = std::min(
           maxReadBatchSize_,
@@ -263,6 +305,7 @@ RowVectorPtr TableScan::getOutput() {
       lockedStats->addRuntimeStat(
           "dataSourceReadWallNanos",
           RuntimeCounter(ioTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
+      splitReadNanos_ += ioTimeUs * 1'000;
 
       if (!dataOptional.has_value()) {
         blockingReason_ = BlockingReason::kWaitForConnector;
@@ -282,6 +325,7 @@ RowVectorPtr TableScan::getOutput() {
               {maxFilteringRatio_,
                1.0 * data->size() / readBatchSize,
                1.0 / kMaxSelectiveBatchSizeMultiplier});
+          numOutputRows_ += data->size();
           return data;
         }
         continue;
@@ -303,6 +347,14 @@ RowVectorPtr TableScan::getOutput() {
         numReadyPreloadedSplits_ = 0;
       }
       currNumRawInputRows = lockedStats->rawInputPositions;
+      lockedStats->addRuntimeStat(
+          kSplitReadWallNanos,
+          RuntimeCounter(splitReadNanos_, RuntimeCounter::Unit::kNanos));
+      lockedStats->addRuntimeStat(
+          kSplitIoWaitWallNanos,
+          RuntimeCounter(
+              dataSource_->ioWaitNanos() - splitStartIoWaitNanos_,
+              RuntimeCounter::Unit::kNanos));
     }
     VELOX_CHECK_LE(rawInputRowsSinceLastSplit_, currNumRawInputRows);
     const bool emptySplit = currNumRawInputRows == rawInputRowsSinceLastSplit_;
@@ -311,6 +363,9 @@ RowVectorPtr TableScan::getOutput() {
     curStatus_ = "getOutput: task->splitFinished";
     driverCtx_->task->splitFinished(true, currentSplitWeight_);
     needNewSplit_ = true;
+    if (fragmentResultCache_ != nullptr) {
+      fragmentResultCache_->finishSplit();
+    }
 
     // We only update scaled controller when we have finished a non-empty split.
     // Otherwise, it can lead to the wrong scale up decisions if the first few
@@ -395,6 +450,11 @@ void TableScan::checkPreload() {
       !connector_->supportsSplitPreload()) {
     return;
   }
+  // The rows a downstream Limit needs are expected from the current split.
+  if (const auto remainingLimit = remainingLimitHint();
+      remainingLimit.has_value() && *remainingLimit <= readBatchSize_) {
+    return;
+  }
   if (dataSource_->allPrefetchIssued()) {
     maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
         maxSplitPreloadPerDriver_;
@@ -413,6 +473,21 @@ void TableScan::checkPreload() {
   }
 }
 
+void TableScan::checkPreopen() {
+  auto* executor = connector_->executor();
+  if (maxSplitPreopenPerDriver_ == 0 || !executor || splitPreopener_) {
+    return;
+  }
+  maxPreopenedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
+      maxSplitPreopenPerDriver_;
+  // The preopen may outlive 'this' and captures the connector by value.
+  splitPreopener_ =
+      [executor, connector = connector_](
+          const std::shared_ptr<connector::ConnectorSplit>& split) {
+        executor->add([connector, split]() { connector->preopenSplit(split); });
+      };
+}
+
 bool TableScan::isFinished() {
   return noMoreSplits_;
 }
@@ -424,6 +499,10 @@ void TableScan::addDynamicFilter(
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
   }
+  if (fragmentResultCache_ != nullptr) {
+    // The results of a split now depend on the producer of 'filter'.
+    fragmentResultCache_->disable();
+  }
   auto& currentFilter = dynamicFilters_[outputChannel];
   if (currentFilter) {
     currentFilter = currentFilter->mergeWith(filter.get());
@@ -53,6 +53,10 @@ class TableScan : public SourceOperator {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
+  void addLimitHint(int64_t numRows) override {
+    limitHint_ = numRows;
+  }
+
   /// The name of runtime stats specific to table scan.
   /// The number of running table scan drivers.
   ///
@@ -61,6 +65,25 @@ class TableScan : public SourceOperator {
   static inline const std::string kNumRunningScaleThreads{
       "numRunningScaleThreads"};
 
+  /// The number of splits whose partial aggregation results were found in
+  /// the fragment result cache and were not read.
+  static inline const std::string kFragmentResultCacheHits{
+      "fragmentResultCacheHits"};
+
+  /// The number of cacheable splits whose partial aggregation results were
+  /// not in the fragment result cache.
+  static inline const std::string kFragmentResultCacheMisses{
+      "fragmentResultCacheMisses"};
+
+  /// The wall time spent in reading a split from the data source, reported
+  /// once per split.
+  static inline const std::string kSplitReadWallNanos{"splitReadWallNanos"};
+
+  /// The part of kSplitReadWallNanos spent waiting for IO, reported once per
+  /// split. The rest is decoding and filtering.
+  static inline const std::string kSplitIoWaitWallNanos{
+      "splitIoWaitWallNanos"};
+
   std::shared_ptr<ScaledScanController> testingScaledController() const {
     return scaledController_;
   }
@@ -79,6 +102,12 @@ class TableScan : public SourceOperator {
   // of the Task's split queue for 'this' when getting splits.
   void checkPreload();
 
+  // Sets 'maxPreopenedSplits_' and 'splitPreopener_' if opening the files of
+  // queued splits ahead of time is enabled. The preopener is applied to the
+  // 'maxPreopenedSplits_' splits following the preloaded ones in the Task's
+  // split queue for 'this'.
+  void checkPreopen();
+
   // Sets 'split->dataSource' to be an AsyncSource that makes a DataSource to
   // read 'split'. This source will be prepared in the background on the
   // executor of the connector. If the DataSource is needed before prepare is
@@ -93,12 +122,23 @@ class TableScan : public SourceOperator {
   // processing or not.
   void tryScaleUp();
 
+  // Returns the number of rows still needed by a downstream Limit or
+  // std::nullopt if there is no limit or it has been reached. Rows may still be
+  // needed in the latter case if operators in between dropped rows.
+  std::optional<int64_t> remainingLimitHint() const {
+    if (limitHint_.has_value() && numOutputRows_ < *limitHint_) {
+      return *limitHint_ - numOutputRows_;
+    }
+    return std::nullopt;
+  }
+
   const std::shared_ptr<connector::ConnectorTableHandle> tableHandle_;
   const std::
       unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
           columnHandles_;
   DriverCtx* const driverCtx_;
   const int32_t maxSplitPreloadPerDriver_{0};
+  const int32_t maxSplitPreopenPerDriver_{0};
   const vector_size_t maxReadBatchSize_;
   memory::MemoryPool* const connectorPool_;
   const std::shared_ptr<connector::Connector> connector_;
@@ -110,8 +150,19 @@ class TableScan : public SourceOperator {
   // operators instantiated from the same table scan node.
   const std::shared_ptr<ScaledScanController> scaledController_;
 
+  // If set, caches the partial aggregation results of each split. Shared with
+  // the partial aggregation of the driver.
+  const std::shared_ptr<FragmentResultCache> fragmentResultCache_;
+
   vector_size_t readBatchSize_;
 
+  // Number of rows the downstream Limit needs, if any. Until this many rows
+  // are produced, reads are no larger than the rows still needed and splits
+  // are not preloaded.
+  std::optional<int64_t> limitHint_;
+  // Number of rows produced so far.
+  int64_t numOutputRows_{0};
+
   ContinueFuture blockingFuture_{ContinueFuture::makeEmpty()};
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   int64_t currentSplitWeight_{0};
@@ -132,6 +183,13 @@ class TableScan : public SourceOperator {
   std::function<void(const std::shared_ptr<connector::ConnectorSplit>&)>
       splitPreloader_{nullptr};
 
+  int32_t maxPreopenedSplits_{0};
+
+  // Callback passed to getSplitOrFuture() for opening the files of queued
+  // splits on the connector's executor.
+  std::function<void(const std::shared_ptr<connector::ConnectorSplit>&)>
+      splitPreopener_{nullptr};
+
   // Count of splits that started background preload.
   int32_t numPreloadedSplits_{0};
 
@@ -150,5 +208,11 @@ class TableScan : public SourceOperator {
   // The total number of raw input rows read up till the last finished split.
   // This is used to detect if a finished split is empty or not.
   uint64_t rawInputRowsSinceLastSplit_{0};
+
+  // DataSource::ioWaitNanos() at the start of the current split.
+  uint64_t splitStartIoWaitNanos_{0};
+
+  // The wall time spent in the data source for the current split.
+  uint64_t splitReadNanos_{0};
 };
 } // namespace facebook::velox::exec
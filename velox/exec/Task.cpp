@@ -16,8 +16,10 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <filesystem>
 #include <string>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
@@ -302,6 +304,11 @@ Task::Task(
       queryCtx_(std::move(queryCtx)),
       planFragment_(std::move(planFragment)),
       traceConfig_(maybeMakeTraceConfig()),
+      timeline_(
+          queryCtx_->queryConfig().taskTimelineEnabled()
+              ? std::make_shared<process::TraceEventRecorder>(
+                    queryCtx_->queryConfig().taskTimelineMaxEvents())
+              : nullptr),
       consumerSupplier_(std::move(consumerSupplier)),
       onError_(std::move(onError)),
       splitsStates_(buildSplitStates(planFragment_.planNode)),
@@ -450,21 +457,27 @@ const std::string& Task::getOrCreateSpillDirectory() {
     return spillDirectory_;
   }
 
+  std::string spillDirectory;
   try {
     // If callback is provided, we shall execute the callback instead
     // of calling mkdir on the directory.
     if (spillDirectoryCallback_) {
       spillDirectory_ = spillDirectoryCallback_();
+      spillDirectories_ = {spillDirectory_};
+      spillDirectoryFileCounts_.assign(1, 0);
       spillDirectoryCreated_ = true;
       return spillDirectory_;
     }
 
-    auto fileSystem = filesystems::getFileSystem(spillDirectory_, nullptr);
-    fileSystem->mkdir(spillDirectory_);
+    for (const auto& directory : spillDirectories_) {
+      spillDirectory = directory;
+      auto fileSystem = filesystems::getFileSystem(directory, nullptr);
+      fileSystem->mkdir(directory);
+    }
   } catch (const std::exception& e) {
     VELOX_FAIL(
         "Failed to create spill directory '{}' for Task {}: {}",
-        spillDirectory_,
+        spillDirectory,
         taskId(),
         e.what());
   }
@@ -472,16 +485,108 @@ const std::string& Task::getOrCreateSpillDirectory() {
   return spillDirectory_;
 }
 
+namespace {
+// Returns the free bytes of the local disk of 'directory', or std::nullopt if
+// 'directory' is not on the local file system.
+std::optional<uint64_t> localFreeBytes(const std::string& directory) {
+  auto fileSystem = filesystems::getFileSystem(directory, nullptr);
+  if (fileSystem->name() != "Local FS") {
+    return std::nullopt;
+  }
+  std::error_code ec;
+  const auto space = std::filesystem::space(
+      std::string(fileSystem->extractPath(directory)), ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  return space.available;
+}
+
+// Creates 'directory' unless its file system has no directories, like object
+// storage.
+void createDirectoryIfSupported(const std::string& directory) {
+  auto fileSystem = filesystems::getFileSystem(directory, nullptr);
+  try {
+    fileSystem->mkdir(directory);
+  } catch (const VeloxException& e) {
+    if (e.errorCode() != error_code::kUnsupported) {
+      throw;
+    }
+  }
+}
+} // namespace
+
+const std::string& Task::nextSpillDirectory() {
+  getOrCreateSpillDirectory();
+
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  const auto numDirectories = spillDirectories_.size();
+  auto index = nextSpillDirectoryIndex_ % numDirectories;
+  const auto minFreeBytes =
+      queryCtx_->queryConfig().spillDirectoryMinFreeBytes();
+  const bool hasOverflow = !overflowSpillDirectory_.empty();
+  if ((numDirectories > 1 || hasOverflow) && minFreeBytes > 0) {
+    // Skips the full disks. If all are full, overflows to the overflow spill
+    // directory if any. Otherwise, keeps the round-robin order and lets the
+    // write fail if there is no space left.
+    bool full{true};
+    for (size_t i = 0; i < numDirectories; ++i) {
+      const auto candidate = (index + i) % numDirectories;
+      const auto freeBytes = localFreeBytes(spillDirectories_[candidate]);
+      if (!freeBytes.has_value() || freeBytes.value() >= minFreeBytes) {
+        index = candidate;
+        full = false;
+        break;
+      }
+    }
+    if (full && hasOverflow) {
+      if (!overflowSpillDirectoryCreated_) {
+        try {
+          createDirectoryIfSupported(overflowSpillDirectory_);
+        } catch (const std::exception& e) {
+          VELOX_FAIL(
+              "Failed to create overflow spill directory '{}' for Task {}: {}",
+              overflowSpillDirectory_,
+              taskId(),
+              e.what());
+        }
+        overflowSpillDirectoryCreated_ = true;
+      }
+      ++overflowSpillFileCount_;
+      return overflowSpillDirectory_;
+    }
+  }
+  nextSpillDirectoryIndex_ = index + 1;
+  ++spillDirectoryFileCounts_[index];
+  return spillDirectories_[index];
+}
+
+std::vector<uint64_t> Task::spillDirectoryFileCounts() const {
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  return spillDirectoryFileCounts_;
+}
+
+uint64_t Task::overflowSpillFileCount() const {
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  return overflowSpillFileCount_;
+}
+
 void Task::removeSpillDirectoryIfExists() {
   if (spillDirectory_.empty() || !spillDirectoryCreated_) {
     return;
   }
-  try {
-    auto fs = filesystems::getFileSystem(spillDirectory_, nullptr);
-    fs->rmdir(spillDirectory_);
-  } catch (const std::exception& e) {
-    LOG(ERROR) << "Failed to remove spill directory '" << spillDirectory_
-               << "' for Task " << taskId() << ": " << e.what();
+  auto spillDirectories = spillDirectories_;
+  if (overflowSpillDirectoryCreated_) {
+    spillDirectories.push_back(overflowSpillDirectory_);
+  }
+  for (const auto& spillDirectory : spillDirectories) {
+    try {
+      auto fs = filesystems::getFileSystem(spillDirectory, nullptr);
+      fs->rmdir(spillDirectory);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove spill directory '" << spillDirectory
+                 << "' for Task " << taskId() << ": " << e.what();
+    }
   }
 }
 
@@ -491,6 +596,11 @@ uint64_t Task::driverCpuTimeSliceLimitMs() const {
       : queryCtx_->queryConfig().driverCpuTimeSliceLimitMs();
 }
 
+DriverPriorityClass Task::driverPriorityClass() const {
+  return driverPriorityClassFromName(
+      queryCtx_->queryConfig().driverPriorityClass());
+}
+
 void Task::initTaskPool() {
   VELOX_CHECK_NULL(pool_);
   pool_ = queryCtx_->pool()->addAggregateChild(
@@ -568,6 +678,7 @@ velox::memory::MemoryPool* Task::addOperatorPool(
     int pipelineId,
     uint32_t driverId,
     const std::string& operatorType) {
+  std::lock_guard<std::mutex> l(driverCreationMutex_);
   velox::memory::MemoryPool* nodePool;
   if (isHashJoinOperator(operatorType)) {
     nodePool = getOrAddJoinNodePool(planNodeId, splitGroupId);
@@ -585,6 +696,7 @@ velox::memory::MemoryPool* Task::addConnectorPoolLocked(
     uint32_t driverId,
     const std::string& operatorType,
     const std::string& connectorId) {
+  std::lock_guard<std::mutex> l(driverCreationMutex_);
   auto* nodePool = getOrAddNodePool(planNodeId);
   childPools_.push_back(nodePool->addAggregateChild(fmt::format(
       "op.{}.{}.{}.{}.{}",
@@ -601,6 +713,7 @@ velox::memory::MemoryPool* Task::addMergeSourcePool(
     uint32_t pipelineId,
     uint32_t sourceId) {
   std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<std::mutex> creationLock(driverCreationMutex_);
   auto* nodePool = getOrAddNodePool(planNodeId);
   childPools_.push_back(nodePool->addLeafChild(
       fmt::format(
@@ -613,6 +726,7 @@ velox::memory::MemoryPool* Task::addMergeSourcePool(
 velox::memory::MemoryPool* Task::addExchangeClientPool(
     const core::PlanNodeId& planNodeId,
     uint32_t pipelineId) {
+  std::lock_guard<std::mutex> l(driverCreationMutex_);
   auto* nodePool = getOrAddNodePool(planNodeId);
   childPools_.push_back(nodePool->addLeafChild(
       fmt::format("exchangeClient.{}.{}", planNodeId, pipelineId),
@@ -677,6 +791,7 @@ RowVectorPtr Task::next(ContinueFuture* future) {
       VELOX_CHECK(factory->supportsSerialExecution());
       numDriversUngrouped_ += factory->numDrivers;
       numTotalDrivers_ += factory->numTotalDrivers;
+      maxPipelineDrivers_ = std::max(maxPipelineDrivers_, factory->numDrivers);
       taskStats_.pipelineStats.emplace_back(
           factory->inputDriver, factory->outputDriver);
     }
@@ -850,6 +965,7 @@ void Task::createDriverFactoriesLocked(uint32_t maxDrivers) {
       numDriversUngrouped_ += factory->numDrivers;
     }
     numTotalDrivers_ += factory->numTotalDrivers;
+    maxPipelineDrivers_ = std::max(maxPipelineDrivers_, factory->numDrivers);
     taskStats_.pipelineStats.emplace_back(
         factory->inputDriver, factory->outputDriver);
   }
@@ -1134,6 +1250,17 @@ void Task::createSplitGroupStateLocked(uint32_t splitGroupId) {
       addScaledScanControllerLocked(
           splitGroupId, tableScanNodeId, factory->numDrivers);
     }
+
+    // Only the pipelines reading from a remote exchange are scaled, since all
+    // their drivers pull from the same exchange client. A parked consumer of a
+    // local exchange would leave its partition of the local exchange unread.
+    if (queryCtx_->queryConfig().pipelineScaledProcessingEnabled() &&
+        factory->numDrivers > 1) {
+      if (auto exchangeNodeId = factory->needsExchangeClient()) {
+        addScaledPipelineControllerLocked(
+            splitGroupId, exchangeNodeId.value(), factory->numDrivers);
+      }
+    }
   }
 }
 
@@ -1145,7 +1272,6 @@ std::vector<std::shared_ptr<Driver>> Task::createDriversLocked(
   const auto numPipelines = driverFactories_.size();
 
   std::vector<std::shared_ptr<Driver>> drivers;
-  auto self = shared_from_this();
   for (auto pipeline = 0; pipeline < numPipelines; ++pipeline) {
     auto& factory = driverFactories_[pipeline];
     // We either create drivers for grouped execution or ungrouped.
@@ -1153,27 +1279,8 @@ std::vector<std::shared_ptr<Driver>> Task::createDriversLocked(
       continue;
     }
 
-    // In each pipeline we start drivers id from zero or, in case of grouped
-    // execution, from the split group id.
-    const uint32_t driverIdOffset =
-        factory->numDrivers * (groupedExecutionDrivers ? splitGroupId : 0);
-    for (uint32_t partitionId = 0; partitionId < factory->numDrivers;
-         ++partitionId) {
-      drivers.emplace_back(factory->createDriver(
-          std::make_unique<DriverCtx>(
-              self,
-              driverIdOffset + partitionId,
-              pipeline,
-              splitGroupId,
-              partitionId),
-          getExchangeClientLocked(pipeline),
-          [self](size_t i) {
-            return i < self->driverFactories_.size()
-                ? self->driverFactories_[i]->numTotalDrivers
-                : 0;
-          }));
-      ++splitGroupState.numRunningDrivers;
-    }
+    createPipelineDriversLocked(splitGroupId, pipeline, drivers);
+    splitGroupState.numRunningDrivers += factory->numDrivers;
   }
   noMoreLocalExchangeProducers(splitGroupId);
   if (groupedExecutionDrivers) {
@@ -1209,6 +1316,89 @@ std::vector<std::shared_ptr<Driver>> Task::createDriversLocked(
   return drivers;
 }
 
+void Task::createPipelineDriversLocked(
+    uint32_t splitGroupId,
+    uint32_t pipeline,
+    std::vector<std::shared_ptr<Driver>>& drivers) {
+  auto* factory = driverFactories_[pipeline].get();
+  // In each pipeline we start drivers id from zero or, in case of grouped
+  // execution, from the split group id.
+  const uint32_t driverIdOffset = factory->numDrivers *
+      (splitGroupId != kUngroupedGroupId ? splitGroupId : 0);
+  auto createDriver = [self = shared_from_this(),
+                       factory,
+                       pipeline,
+                       splitGroupId,
+                       driverIdOffset](uint32_t partitionId) {
+    return factory->createDriver(
+        std::make_unique<DriverCtx>(
+            self,
+            driverIdOffset + partitionId,
+            pipeline,
+            splitGroupId,
+            partitionId),
+        self->getExchangeClientLocked(pipeline),
+        [self](size_t i) {
+          return i < self->driverFactories_.size()
+              ? self->driverFactories_[i]->numTotalDrivers
+              : 0;
+        });
+  };
+
+  if (!parallelDriverCreation(*factory)) {
+    for (uint32_t partitionId = 0; partitionId < factory->numDrivers;
+         ++partitionId) {
+      drivers.emplace_back(createDriver(partitionId));
+    }
+    return;
+  }
+
+  // The drivers are made on the executor while this thread holds 'mutex_'.
+  // Operator construction does not acquire 'mutex_' and makes its updates of
+  // the task state under 'driverCreationMutex_'. The pipelines are still made
+  // one after the other since a pipeline may look up the state, e.g. merge
+  // join sources, added by the drivers of a preceding one.
+  auto* executor = queryCtx_->executor();
+  std::vector<std::shared_ptr<AsyncSource<std::shared_ptr<Driver>>>>
+      creations;
+  creations.reserve(factory->numDrivers);
+  for (uint32_t partitionId = 0; partitionId < factory->numDrivers;
+       ++partitionId) {
+    creations.push_back(std::make_shared<AsyncSource<std::shared_ptr<Driver>>>(
+        [createDriver, partitionId]() {
+          return std::make_unique<std::shared_ptr<Driver>>(
+              createDriver(partitionId));
+        }));
+    // The first driver is made on this thread.
+    if (partitionId > 0) {
+      executor->add([source = creations.back()]() { source->prepare(); });
+    }
+  }
+
+  auto syncGuard = folly::makeGuard([&]() {
+    for (auto& creation : creations) {
+      // We consume the result for the pending creations. This is a cleanup in
+      // the guard and must not throw. The first error is already captured
+      // before this runs.
+      try {
+        creation->move();
+      } catch (const std::exception&) {
+      }
+    }
+  });
+
+  for (auto& creation : creations) {
+    drivers.push_back(std::move(*creation->move()));
+  }
+}
+
+bool Task::parallelDriverCreation(const DriverFactory& factory) const {
+  return mode_ == ExecutionMode::kParallel && factory.numDrivers > 1 &&
+      queryCtx_->executor() != nullptr &&
+      queryCtx_->queryConfig().parallelDriverCreationEnabled() &&
+      !(factory.outputDriver && consumerSupplier_ != nullptr);
+}
+
 // static
 void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
   bool foundDriver = false;
@@ -1565,7 +1755,9 @@ BlockingReason Task::getSplitOrFuture(
     exec::Split& split,
     ContinueFuture& future,
     int32_t maxPreloadSplits,
-    const ConnectorSplitPreloadFunc& preload) {
+    const ConnectorSplitPreloadFunc& preload,
+    int32_t maxPreopenSplits,
+    const ConnectorSplitPreloadFunc& preopen) {
   std::lock_guard<std::timed_mutex> l(mutex_);
   auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
   return getSplitOrFutureLocked(
@@ -1574,7 +1766,9 @@ BlockingReason Task::getSplitOrFuture(
       split,
       future,
       maxPreloadSplits,
-      preload);
+      preload,
+      maxPreopenSplits,
+      preopen);
 }
 
 BlockingReason Task::getSplitOrFutureLocked(
@@ -1583,7 +1777,9 @@ BlockingReason Task::getSplitOrFutureLocked(
     exec::Split& split,
     ContinueFuture& future,
     int32_t maxPreloadSplits,
-    const ConnectorSplitPreloadFunc& preload) {
+    const ConnectorSplitPreloadFunc& preload,
+    int32_t maxPreopenSplits,
+    const ConnectorSplitPreloadFunc& preopen) {
   if (splitsStore.splits.empty()) {
     if (splitsStore.noMoreSplits) {
       return BlockingReason::kNotBlocked;
@@ -1595,7 +1791,13 @@ BlockingReason Task::getSplitOrFutureLocked(
     return BlockingReason::kWaitForSplit;
   }
 
-  split = getSplitLocked(forTableScan, splitsStore, maxPreloadSplits, preload);
+  split = getSplitLocked(
+      forTableScan,
+      splitsStore,
+      maxPreloadSplits,
+      preload,
+      maxPreopenSplits,
+      preopen);
   return BlockingReason::kNotBlocked;
 }
 
@@ -1603,8 +1805,21 @@ exec::Split Task::getSplitLocked(
     bool forTableScan,
     SplitsStore& splitsStore,
     int32_t maxPreloadSplits,
-    const ConnectorSplitPreloadFunc& preload) {
+    const ConnectorSplitPreloadFunc& preload,
+    int32_t maxPreopenSplits,
+    const ConnectorSplitPreloadFunc& preopen) {
   int32_t readySplitIndex = -1;
+  if (maxPreopenSplits > 0) {
+    const auto end = std::min<size_t>(
+        splitsStore.splits.size(), maxPreloadSplits + maxPreopenSplits);
+    for (size_t i = std::max(maxPreloadSplits, 0); i < end; ++i) {
+      auto& connectorSplit = splitsStore.splits[i].connectorSplit;
+      if (!connectorSplit->preopenIssued) {
+        connectorSplit->preopenIssued = true;
+        preopen(connectorSplit);
+      }
+    }
+  }
   if (maxPreloadSplits > 0) {
     for (auto i = 0; i < splitsStore.splits.size() && i < maxPreloadSplits;
          ++i) {
@@ -1675,6 +1890,32 @@ void Task::addScaledScanControllerLocked(
           queryCtx_->queryConfig().tableScanScaleUpMemoryUsageRatio()));
 }
 
+std::shared_ptr<ScaledPipelineController>
+Task::getScaledPipelineControllerLocked(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+  auto it = splitGroupState.scaledPipelineControllers.find(planNodeId);
+  if (it == splitGroupState.scaledPipelineControllers.end()) {
+    return nullptr;
+  }
+  VELOX_CHECK(queryCtx_->queryConfig().pipelineScaledProcessingEnabled());
+  return it->second;
+}
+
+void Task::addScaledPipelineControllerLocked(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId,
+    uint32_t numDrivers) {
+  VELOX_CHECK(queryCtx_->queryConfig().pipelineScaledProcessingEnabled());
+
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+  VELOX_CHECK_EQ(
+      splitGroupState.scaledPipelineControllers.count(planNodeId), 0);
+  splitGroupState.scaledPipelineControllers.emplace(
+      planNodeId, std::make_shared<ScaledPipelineController>(numDrivers));
+}
+
 void Task::splitFinished(bool fromTableScan, int64_t splitWeight) {
   std::lock_guard<std::timed_mutex> l(mutex_);
   ++taskStats_.numFinishedSplits;
@@ -1779,6 +2020,24 @@ void Task::setAllOutputConsumed() {
   }
 }
 
+void Task::setOutputNotNeeded() {
+  {
+    std::lock_guard<std::timed_mutex> l(mutex_);
+    partitionedOutputConsumed_ = true;
+    if (!isRunningLocked()) {
+      return;
+    }
+    taskStats_.finishedOnOutputNotNeeded =
+        numFinishedDrivers_ < numTotalDrivers_;
+    if (taskStats_.executionEndTimeMs == 0) {
+      taskStats_.executionEndTimeMs = getCurrentTimeMs();
+    }
+    taskStats_.endTimeMs = getCurrentTimeMs();
+  }
+  VLOG(1) << "Output of task " << taskId() << " is no longer needed";
+  terminate(TaskState::kFinished);
+}
+
 void Task::driverClosedLocked() {
   if (isRunningLocked()) {
     --numRunningDrivers_;
@@ -2140,7 +2399,7 @@ ContinueFuture Task::terminate(TaskState terminalState) {
         for (auto& [groupId, store] : splitState.groupSplitsStores) {
           while (!store.splits.empty()) {
             splits.emplace_back(getSplitLocked(
-                splitState.sourceIsTableScan, store, 0, nullptr));
+                splitState.sourceIsTableScan, store, 0, nullptr, 0, nullptr));
           }
         }
         if (!splits.empty()) {
@@ -2557,6 +2816,7 @@ std::shared_ptr<MergeSource> Task::addLocalMergeSource(
     const core::PlanNodeId& planNodeId,
     const RowTypePtr& rowType) {
   auto source = MergeSource::createLocalMergeSource();
+  std::lock_guard<std::mutex> l(driverCreationMutex_);
   splitGroupStates_[splitGroupId].localMergeSources[planNodeId].push_back(
       source);
   return source;
@@ -2570,30 +2830,37 @@ const std::vector<std::shared_ptr<MergeSource>>& Task::getLocalMergeSources(
 
 void Task::createMergeJoinSource(
     uint32_t splitGroupId,
-    const core::PlanNodeId& planNodeId) {
-  auto& splitGroupState = splitGroupStates_[splitGroupId];
-
-  VELOX_CHECK(
-      splitGroupState.mergeJoinSources.find(planNodeId) ==
-          splitGroupState.mergeJoinSources.end(),
-      "Merge join sources already exist: {}",
-      planNodeId);
-
-  splitGroupState.mergeJoinSources.insert(
-      {planNodeId, std::make_shared<MergeJoinSource>()});
+    const core::PlanNodeId& planNodeId,
+    uint32_t partitionId) {
+  std::lock_guard<std::mutex> l(driverCreationMutex_);
+  auto& sources = splitGroupStates_[splitGroupId].mergeJoinSources[planNodeId];
+  if (sources.size() <= partitionId) {
+    sources.resize(partitionId + 1);
+  }
+  VELOX_CHECK_NULL(
+      sources[partitionId],
+      "Merge join sources already exist: {}, partition {}",
+      planNodeId,
+      partitionId);
+  sources[partitionId] = std::make_shared<MergeJoinSource>();
 }
 
 std::shared_ptr<MergeJoinSource> Task::getMergeJoinSource(
     uint32_t splitGroupId,
-    const core::PlanNodeId& planNodeId) {
+    const core::PlanNodeId& planNodeId,
+    uint32_t partitionId) {
   auto& splitGroupState = splitGroupStates_[splitGroupId];
 
   auto it = splitGroupState.mergeJoinSources.find(planNodeId);
   VELOX_CHECK(
-      it != splitGroupState.mergeJoinSources.end(),
-      "Merge join source for specified plan node doesn't exist: {}",
-      planNodeId);
-  return it->second;
+      it != splitGroupState.mergeJoinSources.end() &&
+          partitionId < it->second.size() &&
+          it->second[partitionId] != nullptr,
+      "Merge join source for specified plan node doesn't exist: {}, "
+      "partition {}",
+      planNodeId,
+      partitionId);
+  return it->second[partitionId];
 }
 
 void Task::createLocalExchangeQueuesLocked(
@@ -17,12 +17,15 @@
 
 #include "velox/common/base/SkewedPartitionBalancer.h"
 #include "velox/common/base/TraceConfig.h"
+#include "velox/common/memory/NumaUtil.h"
+#include "velox/common/process/TraceEvents.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/LocalPartition.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/MergeSource.h"
+#include "velox/exec/ScaledPipelineController.h"
 #include "velox/exec/Split.h"
 #include "velox/exec/TableScan.h"
 #include "velox/exec/TaskStats.h"
@@ -106,10 +109,50 @@ class Task : public std::enable_shared_from_this<Task> {
   void setSpillDirectory(
       const std::string& spillDirectory,
       bool alreadyCreated = true) {
-    spillDirectory_ = spillDirectory;
+    setSpillDirectories({spillDirectory}, alreadyCreated);
+  }
+
+  /// Specifies multiple directories to which data will be spilled, typically
+  /// one on each local disk. The spill files are striped across them, see
+  /// nextSpillDirectory(). The first directory is the one returned by
+  /// spillDirectory().
+  void setSpillDirectories(
+      const std::vector<std::string>& spillDirectories,
+      bool alreadyCreated = true) {
+    VELOX_CHECK(!spillDirectories.empty(), "No spill directory specified");
+    spillDirectories_ = spillDirectories;
+    spillDirectory_ = spillDirectories_[0];
+    spillDirectoryFileCounts_.assign(spillDirectories_.size(), 0);
     spillDirectoryCreated_ = alreadyCreated;
   }
 
+  /// Specifies a directory on any file system, e.g. object storage, to spill to
+  /// once all the local spill directories have less free space than
+  /// 'QueryConfig::spillDirectoryMinFreeBytes()'. The directory is created on
+  /// first use. The host has to clean up the spill files if the file system
+  /// does not support removing directories.
+  void setOverflowSpillDirectory(const std::string& spillDirectory) {
+    VELOX_CHECK(!spillDirectory.empty());
+    overflowSpillDirectory_ = spillDirectory;
+  }
+
+  /// Specifies the NUMA node the threads running the drivers of this task are
+  /// pinned to. While a driver runs, memory from a NUMA aware MmapAllocator is
+  /// allocated on this node. If the executor of the query is a DriverExecutor
+  /// spread over NUMA nodes, the drivers run on the workers of this node,
+  /// unless a pipeline of the task has more drivers than the node has workers.
+  /// Must be called before the task starts.
+  void setPreferredNumaNode(int32_t node) {
+    VELOX_CHECK_GE(node, 0);
+    preferredNumaNode_ = node;
+  }
+
+  /// Returns the NUMA node set by setPreferredNumaNode() or
+  /// memory::kNoNumaNode if none.
+  int32_t preferredNumaNode() const {
+    return preferredNumaNode_;
+  }
+
   void setCreateSpillDirectoryCb(
       std::function<std::string()> spillDirectoryCallback) {
     VELOX_CHECK_NULL(spillDirectoryCallback_);
@@ -151,6 +194,10 @@ class Task : public std::enable_shared_from_this<Task> {
   /// disabled) when task is under serial mode.
   uint64_t driverCpuTimeSliceLimitMs() const;
 
+  /// Priority class of the drivers, from the driver_priority_class query
+  /// config.
+  DriverPriorityClass driverPriorityClass() const;
+
   /// Returns QueryCtx specified in the constructor.
   const std::shared_ptr<core::QueryCtx>& queryCtx() const {
     return queryCtx_;
@@ -167,6 +214,13 @@ class Task : public std::enable_shared_from_this<Task> {
     return traceConfig_;
   }
 
+  /// Returns the recorder of the timed events of the task if the
+  /// task_timeline_enabled query config is set, nullptr otherwise. Its
+  /// toChromeTrace() exports them for the Perfetto UI or chrome://tracing.
+  process::TraceEventRecorder* timeline() const {
+    return timeline_.get();
+  }
+
   /// Returns ConsumerSupplier passed in the constructor.
   ConsumerSupplier consumerSupplier() const {
     return consumerSupplier_;
@@ -372,6 +426,12 @@ class Task : public std::enable_shared_from_this<Task> {
     return numRunningDrivers_;
   }
 
+  /// Returns the max number of drivers of a pipeline of the task in one split
+  /// group. Set when the drivers are created.
+  uint32_t maxPipelineDrivers() const {
+    return maxPipelineDrivers_;
+  }
+
   /// Returns the total number of drivers the task needs to run.
   uint32_t numTotalDrivers() const {
     std::lock_guard<std::timed_mutex> taskLock(mutex_);
@@ -433,14 +493,18 @@ class Task : public std::enable_shared_from_this<Task> {
   /// that will complete when split becomes available or no-more-splits
   /// signal is received. If 'maxPreloadSplits' is given, ensures that
   /// so many of splits at the head of the queue are preloading. If
-  /// they are not, calls preload on them to start preload.
+  /// they are not, calls preload on them to start preload. If
+  /// 'maxPreopenSplits' is given, calls 'preopen' once on each of so many
+  /// splits following the preloading ones.
   BlockingReason getSplitOrFuture(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId,
       exec::Split& split,
       ContinueFuture& future,
       int32_t maxPreloadSplits = 0,
-      const ConnectorSplitPreloadFunc& preload = nullptr);
+      const ConnectorSplitPreloadFunc& preload = nullptr,
+      int32_t maxPreopenSplits = 0,
+      const ConnectorSplitPreloadFunc& preopen = nullptr);
 
   /// Returns the scaled scan controller for a given table scan node if the
   /// query has configured.
@@ -448,6 +512,12 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  /// Returns the scaled pipeline controller for a given exchange node if the
+  /// query has configured, otherwise nullptr.
+  std::shared_ptr<ScaledPipelineController> getScaledPipelineControllerLocked(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId);
+
   void splitFinished(bool fromTableScan, int64_t splitWeight);
 
   void multipleSplitsFinished(
@@ -466,13 +536,17 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  /// Creates the source of right side input for the merge join driver with
+  /// 'partitionId'.
   void createMergeJoinSource(
       uint32_t splitGroupId,
-      const core::PlanNodeId& planNodeId);
+      const core::PlanNodeId& planNodeId,
+      uint32_t partitionId);
 
   std::shared_ptr<MergeJoinSource> getMergeJoinSource(
       uint32_t splitGroupId,
-      const core::PlanNodeId& planNodeId);
+      const core::PlanNodeId& planNodeId,
+      uint32_t partitionId);
 
   void createLocalExchangeQueuesLocked(
       uint32_t splitGroupId,
@@ -581,6 +655,15 @@ class Task : public std::enable_shared_from_this<Task> {
   /// will transition the state.
   void setAllOutputConsumed();
 
+  /// Invoked when all the consumers of the output buffer have gone away before
+  /// the Drivers finished producing the output, e.g. after a downstream Limit
+  /// or EnforceSingleRow got all its input. Transitions this to kFinished
+  /// state without waiting for the Drivers. This closes the Drivers and their
+  /// table scans with any preloading splits, closes the exchange clients so
+  /// that the producers of this Task are no longer needed either, and cancels
+  /// the join bridges.
+  void setOutputNotNeeded();
+
   /// Adds 'stats' to the cumulative total stats for the operator in the Task
   /// stats. Called from Drivers upon their closure.
   void addOperatorStats(OperatorStats& stats);
@@ -696,6 +779,22 @@ class Task : public std::enable_shared_from_this<Task> {
   /// folder could not be created.
   const std::string& getOrCreateSpillDirectory();
 
+  /// Returns the spill directory to create the next spill file in. Ensures
+  /// that the spill directories are created before returning. Is thread safe.
+  /// With multiple spill directories, they are used round-robin, and a
+  /// directory on local disk with less free space than
+  /// 'QueryConfig::spillDirectoryMinFreeBytes()' is skipped unless all are. If
+  /// all are, returns the overflow spill directory if it is set.
+  const std::string& nextSpillDirectory();
+
+  /// Returns the number of spill files that nextSpillDirectory() placed in
+  /// each spill directory, in the order of the spill directories.
+  std::vector<uint64_t> spillDirectoryFileCounts() const;
+
+  /// Returns the number of spill files that nextSpillDirectory() placed in the
+  /// overflow spill directory.
+  uint64_t overflowSpillFileCount() const;
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -776,6 +875,19 @@ class Task : public std::enable_shared_from_this<Task> {
   std::vector<std::shared_ptr<Driver>> createDriversLocked(
       uint32_t splitGroupId);
 
+  // Appends the drivers of 'pipeline' for the given split group to 'drivers'.
+  // Creates them in parallel on the query executor if
+  // parallelDriverCreation() is true for the pipeline.
+  void createPipelineDriversLocked(
+      uint32_t splitGroupId,
+      uint32_t pipeline,
+      std::vector<std::shared_ptr<Driver>>& drivers);
+
+  // Returns true if the drivers of 'factory' are created in parallel. The
+  // results callback of the task may not be safe to call concurrently, so the
+  // output pipeline is created serially if the task has one.
+  bool parallelDriverCreation(const DriverFactory& factory) const;
+
   // Returns time (ms) since the task execution started or zero, if not started.
   uint64_t timeSinceStartMsLocked() const;
 
@@ -803,6 +915,12 @@ class Task : public std::enable_shared_from_this<Task> {
       const core::PlanNodeId& planNodeId,
       uint32_t numDrivers);
 
+  // Creates a scaled pipeline controller for a given exchange node.
+  void addScaledPipelineControllerLocked(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId,
+      uint32_t numDrivers);
+
   // Creates new instance of memory pool for a plan node, stores it in the task
   // to ensure lifetime and returns a raw pointer.
   memory::MemoryPool* getOrAddNodePool(const core::PlanNodeId& planNodeId);
@@ -923,7 +1041,9 @@ class Task : public std::enable_shared_from_this<Task> {
       exec::Split& split,
       ContinueFuture& future,
       int32_t maxPreloadSplits,
-      const ConnectorSplitPreloadFunc& preload);
+      const ConnectorSplitPreloadFunc& preload,
+      int32_t maxPreopenSplits,
+      const ConnectorSplitPreloadFunc& preopen);
 
   /// Returns next split from the store. The caller must ensure the store is not
   /// empty.
@@ -931,7 +1051,9 @@ class Task : public std::enable_shared_from_this<Task> {
       bool forTableScan,
       SplitsStore& splitsStore,
       int32_t maxPreloadSplits,
-      const ConnectorSplitPreloadFunc& preload);
+      const ConnectorSplitPreloadFunc& preload,
+      int32_t maxPreopenSplits,
+      const ConnectorSplitPreloadFunc& preopen);
 
   // Creates for the given split group and fills up the 'SplitGroupState'
   // structure, which stores inter-operator state (local exchange, bridges).
@@ -1068,6 +1190,10 @@ class Task : public std::enable_shared_from_this<Task> {
 
   const std::optional<trace::TraceConfig> traceConfig_;
 
+  // Set if the timeline of the task is recorded. Set as the recorder of the
+  // threads running the drivers of the task.
+  const std::shared_ptr<process::TraceEventRecorder> timeline_;
+
   // Hook in the system wide task list.
   TaskListEntry taskListEntry_;
 
@@ -1085,6 +1211,12 @@ class Task : public std::enable_shared_from_this<Task> {
   // NOTE: 'childPools_' holds the ownerships of node memory pools.
   std::unordered_map<std::string, memory::MemoryPool*> nodePools_;
 
+  // Serializes the updates of 'childPools_', 'nodePools_', local merge sources
+  // and merge join sources made by operator construction, which runs on
+  // several threads if the drivers are created in parallel. Acquired after
+  // 'mutex_' if both are held.
+  std::mutex driverCreationMutex_;
+
   // Set to true by OutputBufferManager when all output is
   // acknowledged. If this happens before Drivers are at end, the last
   // Driver to finish will set state_ to kFinished. If Drivers have
@@ -1178,6 +1310,8 @@ class Task : public std::enable_shared_from_this<Task> {
   // Reflects number of drivers required to run ungrouped execution in the
   // fragment. Zero for a completely grouped execution.
   uint32_t numDriversUngrouped_{0};
+  // The max number of drivers of a pipeline in one split group.
+  uint32_t maxPipelineDrivers_{0};
   // Number of drivers running in the pipeline hosting the Partitioned Output
   // (in a single split group). We use it to recalculate the number of producing
   // drivers at the end during the Grouped Execution mode.
@@ -1263,13 +1397,24 @@ class Task : public std::enable_shared_from_this<Task> {
   std::vector<ContinuePromise> resumePromises_;
   // Base spill directory for this task.
   std::string spillDirectory_;
+  // All the spill directories of this task with 'spillDirectory_' first.
+  std::vector<std::string> spillDirectories_;
+  // The number of spill files placed in each of 'spillDirectories_'.
+  std::vector<uint64_t> spillDirectoryFileCounts_;
+  // The index of the next spill directory to use in 'spillDirectories_'.
+  uint32_t nextSpillDirectoryIndex_{0};
+  // The spill directory to use once all of 'spillDirectories_' are full.
+  std::string overflowSpillDirectory_;
+  bool overflowSpillDirectoryCreated_{false};
+  uint64_t overflowSpillFileCount_{0};
+  int32_t preferredNumaNode_{memory::kNoNumaNode};
   // Spill directory callback for this task. This callback will be used to
   // create the spill directory for this task. This callback returns
   // a path that will be into spillDirectory_
   std::function<std::string()> spillDirectoryCallback_;
 
   // Mutex to ensure only the first caller thread of 'getOrCreateSpillDirectory'
-  // creates the directory.
+  // creates the directory. Also protects the spill directory selection.
   mutable std::mutex spillDirCreateMutex_;
 
   // Indicates whether the spill directory has been created.
@@ -88,6 +88,10 @@ struct TaskStats {
   /// being cancelled or aborted.
   uint64_t terminationTimeMs{0};
 
+  /// True if the task finished before its Drivers because the consumers of
+  /// its output no longer needed it. See Task::setOutputNotNeeded().
+  bool finishedOnOutputNotNeeded{false};
+
   /// Total number of drivers.
   uint64_t numTotalDrivers{0};
   /// Total number of drivers queued on an executor but not on thread.
@@ -110,8 +110,12 @@ struct SplitGroupState {
       unordered_map<core::PlanNodeId, std::vector<std::shared_ptr<MergeSource>>>
           localMergeSources;
 
-  /// Map of merge join sources keyed on MergeJoinNode plan node ID.
-  std::unordered_map<core::PlanNodeId, std::shared_ptr<MergeJoinSource>>
+  /// Map of merge join sources keyed on MergeJoinNode plan node ID. Holds a
+  /// source per driver of a merge join that runs multi-threaded over
+  /// partitioned inputs, indexed by the driver's partition id.
+  std::unordered_map<
+      core::PlanNodeId,
+      std::vector<std::shared_ptr<MergeJoinSource>>>
       mergeJoinSources;
 
   /// Map of local exchanges keyed on LocalPartition plan node ID.
@@ -121,6 +125,12 @@ struct SplitGroupState {
   std::unordered_map<core::PlanNodeId, std::shared_ptr<ScaledScanController>>
       scaledScanControllers;
 
+  /// Map of scaled pipeline controllers keyed on Exchange plan node ID.
+  std::unordered_map<
+      core::PlanNodeId,
+      std::shared_ptr<ScaledPipelineController>>
+      scaledPipelineControllers;
+
   /// Drivers created and still running for this split group.
   /// The split group is finished when this numbers reaches zero.
   uint32_t numRunningDrivers{0};
@@ -38,7 +38,8 @@ TopN::TopN(
           topNNode->sortingOrders(),
           data_.get()),
       topRows_(comparator_),
-      decodedVectors_(outputType_->children().size()) {
+      decodedVectors_(outputType_->children().size()),
+      dynamicFilterChannel_(dynamicFilterChannel(*topNNode)) {
   const auto numColumns{outputType_->children().size()};
   const auto numSortingKeys{topNNode->sortingKeys().size()};
   sortingKeyColumns_.reserve(numSortingKeys);
@@ -55,6 +56,34 @@ TopN::TopN(
       }
     }
   }
+  if (dynamicFilterChannel_.has_value()) {
+    dynamicFilterAscending_ = topNNode->sortingOrders()[0].isAscending();
+  }
+}
+
+std::optional<column_index_t> TopN::dynamicFilterChannel(
+    const core::TopNNode& topNNode) const {
+  if (!operatorCtx_->driverCtx()->queryConfig().topNDynamicFilterEnabled()) {
+    return std::nullopt;
+  }
+  // Rows with null keys may be produced by operators between the scan and
+  // TopN, e.g. the probe side of a right join. With nulls last these rows can
+  // not enter the top rows once there are 'count_' rows with non-null keys.
+  if (topNNode.sortingOrders()[0].isNullsFirst()) {
+    return std::nullopt;
+  }
+  const auto channel =
+      exprToChannel(topNNode.sortingKeys()[0].get(), outputType_);
+  switch (outputType_->childAt(channel)->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::TIMESTAMP:
+      return channel;
+    default:
+      return std::nullopt;
+  }
 }
 
 void TopN::addInput(RowVectorPtr input) {
@@ -104,6 +133,76 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  if (dynamicFilterChannel_.has_value() && topRows_.size() == count_) {
+    maybeUpdateDynamicFilter();
+  }
+}
+
+void TopN::maybeUpdateDynamicFilter() {
+  const auto channel = dynamicFilterChannel_.value();
+  if (!dynamicFilterChecked_) {
+    dynamicFilterChecked_ = true;
+    const auto channels =
+        operatorCtx_->driverCtx()->driver->canPushdownFilters(this, {channel});
+    if (channels.empty()) {
+      dynamicFilterChannel_.reset();
+      return;
+    }
+  }
+
+  const char* topRow = topRows_.top();
+  const auto& rowColumn = data_->columnAt(channel);
+  if (RowContainer::isNullAt(topRow, rowColumn)) {
+    return;
+  }
+  const auto offset = rowColumn.offset();
+  switch (outputType_->childAt(channel)->kind()) {
+    case TypeKind::TINYINT:
+      updateDynamicFilter<int64_t>(
+          RowContainer::valueAt<int8_t>(topRow, offset), lastBigintThreshold_);
+      break;
+    case TypeKind::SMALLINT:
+      updateDynamicFilter<int64_t>(
+          RowContainer::valueAt<int16_t>(topRow, offset), lastBigintThreshold_);
+      break;
+    case TypeKind::INTEGER:
+      updateDynamicFilter<int64_t>(
+          RowContainer::valueAt<int32_t>(topRow, offset), lastBigintThreshold_);
+      break;
+    case TypeKind::BIGINT:
+      updateDynamicFilter<int64_t>(
+          RowContainer::valueAt<int64_t>(topRow, offset), lastBigintThreshold_);
+      break;
+    case TypeKind::TIMESTAMP:
+      updateDynamicFilter<Timestamp>(
+          RowContainer::valueAt<Timestamp>(topRow, offset),
+          lastTimestampThreshold_);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+void TopN::updateDynamicFilter(T threshold, std::optional<T>& lastThreshold) {
+  if (lastThreshold == threshold) {
+    return;
+  }
+  lastThreshold = threshold;
+  // Rows that tie with the worst top row on the first key may still enter the
+  // top rows on the next keys, so the threshold passes the filter.
+  const T lower =
+      dynamicFilterAscending_ ? std::numeric_limits<T>::min() : threshold;
+  const T upper =
+      dynamicFilterAscending_ ? threshold : std::numeric_limits<T>::max();
+  if constexpr (std::is_same_v<T, Timestamp>) {
+    dynamicFilters_[dynamicFilterChannel_.value()] =
+        std::make_shared<common::TimestampRange>(lower, upper, false);
+  } else {
+    dynamicFilters_[dynamicFilterChannel_.value()] =
+        std::make_shared<common::BigintRange>(lower, upper, false);
+  }
 }
 
 RowVectorPtr TopN::getOutput() {
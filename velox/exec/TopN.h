@@ -44,6 +44,19 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Returns the channel of the first sorting key if its threshold can be
+  // pushed down as a dynamic filter.
+  std::optional<column_index_t> dynamicFilterChannel(
+      const core::TopNNode& topNNode) const;
+
+  // Sets a dynamic filter on the first sorting key that passes the rows which
+  // may still enter 'topRows_' if the worst top row has changed since the last
+  // filter. Called when 'topRows_' holds 'count_' rows.
+  void maybeUpdateDynamicFilter();
+
+  template <typename T>
+  void updateDynamicFilter(T threshold, std::optional<T>& lastThreshold);
+
   const int32_t count_;
 
   bool finished_ = false;
@@ -68,5 +81,17 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // The channel of the first sorting key to push down the threshold of the
+  // top rows for. Not set if there is no such pushdown.
+  std::optional<column_index_t> dynamicFilterChannel_;
+  // True if the first sorting key is ascending.
+  bool dynamicFilterAscending_{true};
+  // True if the upstream operators have been checked to accept a filter on
+  // 'dynamicFilterChannel_'.
+  bool dynamicFilterChecked_{false};
+  // The thresholds of the last pushed down filter.
+  std::optional<int64_t> lastBigintThreshold_;
+  std::optional<Timestamp> lastTimestampThreshold_;
 };
 } // namespace facebook::velox::exec
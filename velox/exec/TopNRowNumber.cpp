@@ -113,6 +113,7 @@ TopNRowNumber::TopNRowNumber(
           node->canSpill(driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
+      rankFunction_{node->rankFunction()},
       limit_{node->limit()},
       generateRowNumber_{node->generateRowNumber()},
       numPartitionKeys_{node->partitionKeys().size()},
@@ -250,6 +251,17 @@ void TopNRowNumber::initializeNewPartitions() {
 }
 
 void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
+  switch (rankFunction_) {
+    case core::TopNRowNumberNode::RankFunction::kRank:
+      processInputRowForRank(index, partition);
+      return;
+    case core::TopNRowNumberNode::RankFunction::kDenseRank:
+      processInputRowForDenseRank(index, partition);
+      return;
+    case core::TopNRowNumberNode::RankFunction::kRowNumber:
+      break;
+  }
+
   auto& topRows = partition.rows;
 
   char* newRow = nullptr;
@@ -277,6 +289,131 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
   topRows.push(newRow);
 }
 
+char* TopNRowNumber::storeInputRow(vector_size_t index, char* reuse) {
+  char* newRow = reuse == nullptr
+      ? data_->newRow()
+      : data_->initializeRow(reuse, true /* reuse */);
+  for (auto col = 0; col < decodedVectors_.size(); ++col) {
+    data_->store(decodedVectors_[col], index, newRow, col);
+  }
+  return newRow;
+}
+
+vector_size_t TopNRowNumber::popTopPeers(TopRows& partition, char*& firstRow) {
+  auto& topRows = partition.rows;
+  firstRow = topRows.top();
+  topRows.pop();
+  vector_size_t numPopped = 1;
+  peerRows_.clear();
+  while (!topRows.empty() &&
+         comparator_.compare(topRows.top(), firstRow) == 0) {
+    peerRows_.push_back(topRows.top());
+    topRows.pop();
+    ++numPopped;
+  }
+  if (!peerRows_.empty()) {
+    data_->eraseRows(folly::Range<char**>(peerRows_.data(), peerRows_.size()));
+  }
+  return numPopped;
+}
+
+vector_size_t TopNRowNumber::countTopPeers(TopRows& partition) {
+  auto& topRows = partition.rows;
+  if (topRows.empty()) {
+    return 0;
+  }
+  peerRows_.clear();
+  peerRows_.push_back(topRows.top());
+  topRows.pop();
+  while (!topRows.empty() &&
+         comparator_.compare(topRows.top(), peerRows_[0]) == 0) {
+    peerRows_.push_back(topRows.top());
+    topRows.pop();
+  }
+  for (auto* row : peerRows_) {
+    topRows.push(row);
+  }
+  return peerRows_.size();
+}
+
+void TopNRowNumber::processInputRowForRank(
+    vector_size_t index,
+    TopRows& partition) {
+  // The rank of a row is 1 + the number of rows that sort before it. The
+  // queue holds all rows with rank <= 'limit_'. Only the peers of the top row
+  // may see their rank go above the limit when a new row sorts before them.
+  auto& topRows = partition.rows;
+  if (topRows.empty()) {
+    topRows.push(storeInputRow(index));
+    partition.numTopPeers = 1;
+    return;
+  }
+
+  const auto result =
+      comparator_.compare(decodedVectors_, index, topRows.top());
+  if (result > 0) {
+    // The new row sorts after all rows. Its rank is size() + 1.
+    if (topRows.size() >= limit_) {
+      return;
+    }
+    topRows.push(storeInputRow(index));
+    partition.numTopPeers = 1;
+    return;
+  }
+
+  if (result == 0) {
+    topRows.push(storeInputRow(index));
+    ++partition.numTopPeers;
+    return;
+  }
+
+  // The new row sorts before the top row and its peers. They move to rank
+  // size() - numTopPeers + 2.
+  if (topRows.size() - partition.numTopPeers + 1 < limit_) {
+    topRows.push(storeInputRow(index));
+    return;
+  }
+
+  char* reuse;
+  popTopPeers(partition, reuse);
+  topRows.push(storeInputRow(index, reuse));
+  partition.numTopPeers = countTopPeers(partition);
+}
+
+void TopNRowNumber::processInputRowForDenseRank(
+    vector_size_t index,
+    TopRows& partition) {
+  // The dense rank of a row is the number of distinct sorting key values up
+  // to and including its own. The queue holds all rows whose value is among
+  // the 'limit_' smallest.
+  auto& topRows = partition.rows;
+  auto& distinctRows = partition.distinctRows;
+  if (!topRows.empty()) {
+    const auto result =
+        comparator_.compare(decodedVectors_, index, topRows.top());
+    if (result > 0 && distinctRows.size() >= limit_) {
+      return;
+    }
+    if (result == 0) {
+      topRows.push(storeInputRow(index));
+      return;
+    }
+  }
+
+  char* newRow = storeInputRow(index);
+  topRows.push(newRow);
+  if (!distinctRows.insert(newRow).second ||
+      distinctRows.size() <= limit_) {
+    return;
+  }
+
+  // The new row added a value. Drop the rows with the largest value.
+  distinctRows.erase(std::prev(distinctRows.end()));
+  char* firstRow;
+  popTopPeers(partition, firstRow);
+  data_->eraseRows(folly::Range<char**>(&firstRow, 1));
+}
+
 void TopNRowNumber::noMoreInput() {
   Operator::noMoreInput();
 
@@ -293,7 +430,11 @@ void TopNRowNumber::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        spillConfig_->readBufferSize, pool(), &spillStats_);
+        spillConfig_->readBufferSize,
+        pool(),
+        &spillStats_,
+        spillConfig_->executor,
+        spillConfig_->numReadAheadBuffers);
   } else {
     outputRows_.resize(outputBatchSize_);
   }
@@ -360,22 +501,60 @@ TopNRowNumber::TopRows& TopNRowNumber::currentPartition() {
   return partitionAt(partitions_[currentPartition_.value()]);
 }
 
+int64_t TopNRowNumber::nextRank(
+    int64_t previousRank,
+    int64_t rowNumber,
+    bool isPeer) const {
+  switch (rankFunction_) {
+    case core::TopNRowNumberNode::RankFunction::kRowNumber:
+      return rowNumber;
+    case core::TopNRowNumberNode::RankFunction::kRank:
+      return isPeer ? previousRank : rowNumber;
+    case core::TopNRowNumberNode::RankFunction::kDenseRank:
+      return isPeer ? previousRank : previousRank + 1;
+  }
+  VELOX_UNREACHABLE();
+}
+
+void TopNRowNumber::preparePartitionRows(TopRows& partition) {
+  auto& rows = partition.rows;
+  const auto numRows = rows.size();
+  partitionRows_.resize(numRows);
+  for (auto i = numRows; i > 0; --i) {
+    partitionRows_[i - 1] = rows.top();
+    rows.pop();
+  }
+  nextPartitionRow_ = 0;
+
+  if (!generateRowNumber_) {
+    return;
+  }
+  const bool needPeers =
+      rankFunction_ != core::TopNRowNumberNode::RankFunction::kRowNumber;
+  partitionRanks_.resize(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    if (i == 0) {
+      partitionRanks_[i] = 1;
+      continue;
+    }
+    const bool peer = needPeers &&
+        comparator_.compare(partitionRows_[i - 1], partitionRows_[i]) == 0;
+    partitionRanks_[i] = nextRank(partitionRanks_[i - 1], i + 1, peer);
+  }
+}
+
 void TopNRowNumber::appendPartitionRows(
-    TopRows& partition,
-    vector_size_t start,
     vector_size_t size,
     vector_size_t outputOffset,
     FlatVector<int64_t>* rowNumbers) {
-  // Append 'size' partition rows in reverse order starting from 'start' row.
-  auto rowNumber = partition.rows.size() - start;
   for (auto i = 0; i < size; ++i) {
-    const auto index = outputOffset + size - i - 1;
+    const auto row = nextPartitionRow_ + i;
     if (rowNumbers) {
-      rowNumbers->set(index, rowNumber--);
+      rowNumbers->set(outputOffset + i, partitionRanks_[row]);
     }
-    outputRows_[index] = partition.rows.top();
-    partition.rows.pop();
+    outputRows_[outputOffset + i] = partitionRows_[row];
   }
+  nextPartitionRow_ += size;
 }
 
 RowVectorPtr TopNRowNumber::getOutput() {
@@ -432,37 +611,20 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
   }
 
   vector_size_t offset = 0;
-  if (remainingRowsInPartition_ > 0) {
-    auto& partition = currentPartition();
-    auto start = partition.rows.size() - remainingRowsInPartition_;
-    const auto numRows =
-        std::min<vector_size_t>(outputBatchSize_, remainingRowsInPartition_);
-    appendPartitionRows(partition, start, numRows, offset, rowNumbers);
-    offset += numRows;
-    remainingRowsInPartition_ -= numRows;
-  }
-
   while (offset < outputBatchSize_) {
-    auto* partition = nextPartition();
-    if (!partition) {
-      break;
-    }
-
-    auto numRows = partition->rows.size();
-    if (offset + numRows > outputBatchSize_) {
-      remainingRowsInPartition_ = offset + numRows - outputBatchSize_;
-
-      // Add a subset of partition rows.
-      numRows -= remainingRowsInPartition_;
-      appendPartitionRows(*partition, 0, numRows, offset, rowNumbers);
-      offset += numRows;
-      break;
+    if (nextPartitionRow_ == partitionRows_.size()) {
+      auto* partition = nextPartition();
+      if (!partition) {
+        break;
+      }
+      preparePartitionRows(*partition);
     }
 
-    // Add all partition rows.
-    appendPartitionRows(*partition, 0, numRows, offset, rowNumbers);
+    // Add all or a subset of the remaining partition rows.
+    const auto numRows = std::min<vector_size_t>(
+        outputBatchSize_ - offset, partitionRows_.size() - nextPartitionRow_);
+    appendPartitionRows(numRows, offset, rowNumbers);
     offset += numRows;
-    remainingRowsInPartition_ = 0;
   }
 
   if (offset == 0) {
@@ -505,22 +667,47 @@ bool TopNRowNumber::isNewPartition(
   return false;
 }
 
+bool TopNRowNumber::isPeer(
+    const RowVectorPtr& output,
+    vector_size_t index,
+    SpillMergeStream* next) {
+  VELOX_CHECK_GT(index, 0);
+
+  for (auto i = numPartitionKeys_; i < spillCompareFlags_.size(); ++i) {
+    if (!output->childAt(inputChannels_[i])
+             ->equalValueAt(
+                 next->current().childAt(i).get(),
+                 index - 1,
+                 next->currentIndex())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void TopNRowNumber::setupNextOutput(
     const RowVectorPtr& output,
-    int32_t rowNumber) {
+    int64_t rowNumber,
+    int64_t rank) {
+  nextRowNumber_ = 0;
+  nextRank_ = 1;
+
   auto* lookAhead = merge_->next();
   if (lookAhead == nullptr) {
-    nextRowNumber_ = 0;
     return;
   }
 
   if (isNewPartition(output, output->size(), lookAhead)) {
-    nextRowNumber_ = 0;
     return;
   }
 
-  nextRowNumber_ = rowNumber;
-  if (nextRowNumber_ < limit_) {
+  const bool peer =
+      rankFunction_ != core::TopNRowNumberNode::RankFunction::kRowNumber &&
+      isPeer(output, output->size(), lookAhead);
+  const auto lookAheadRank = nextRank(rank, rowNumber + 1, peer);
+  if (lookAheadRank <= limit_) {
+    nextRowNumber_ = rowNumber;
+    nextRank_ = lookAheadRank;
     return;
   }
 
@@ -528,14 +715,12 @@ void TopNRowNumber::setupNextOutput(
   lookAhead->pop();
   while (auto* next = merge_->next()) {
     if (isNewPartition(output, output->size(), next)) {
-      nextRowNumber_ = 0;
       return;
     }
     next->pop();
   }
 
   // This partition is the last partition.
-  nextRowNumber_ = 0;
 }
 
 RowVectorPtr TopNRowNumber::getOutputFromSpill() {
@@ -545,8 +730,9 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
   // All rows from the same partition will appear together.
   // We'll identify partition boundaries by comparing partition keys of the
   // current row with the previous row. When new partition starts, we'll reset
-  // row number to zero. Once row number reaches the 'limit_', we'll start
-  // dropping rows until the next partition starts.
+  // row number and rank. Peers are identified the same way using the sorting
+  // keys. Once the rank goes above the 'limit_', we'll start dropping rows
+  // until the next partition starts.
   // We'll emit output every time we accumulate 'outputBatchSize_' rows.
 
   auto output =
@@ -559,23 +745,36 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
   // Index of the next row to append to output.
   vector_size_t index = 0;
 
-  // Row number of the next row in the current partition.
-  vector_size_t rowNumber = nextRowNumber_;
-  VELOX_CHECK_LT(rowNumber, limit_);
+  // Number of rows of the current partition added to output so far.
+  int64_t rowNumber = nextRowNumber_;
+
+  // Rank of the current row. The rank of the first row is set up by
+  // setupNextOutput().
+  int64_t rank = nextRank_;
+  VELOX_CHECK_LE(rank, limit_);
+  const bool needPeers =
+      rankFunction_ != core::TopNRowNumberNode::RankFunction::kRowNumber;
   for (;;) {
     auto next = merge_->next();
     if (next == nullptr) {
       break;
     }
 
-    // Check if this row comes from a new partition.
-    if (index > 0 && isNewPartition(output, index, next)) {
-      rowNumber = 0;
+    // Check if this row comes from a new partition. Ranks only grow within a
+    // partition. Once a row is above the limit all other rows of the
+    // partition are too.
+    if (index > 0) {
+      if (isNewPartition(output, index, next)) {
+        rowNumber = 0;
+        rank = 1;
+      } else {
+        const bool peer = needPeers && isPeer(output, index, next);
+        rank = nextRank(rank, rowNumber + 1, peer);
+      }
     }
 
-    // Copy this row to the output buffer if this partition has
-    // < limit_ rows output.
-    if (rowNumber < limit_) {
+    // Copy this row to the output buffer if its rank is within the limit.
+    if (rank <= limit_) {
       for (auto i = 0; i < inputChannels_.size(); ++i) {
         output->childAt(inputChannels_[i])
             ->copy(
@@ -585,8 +784,7 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
                 1);
       }
       if (rowNumbers) {
-        // Row numbers start with 1.
-        rowNumbers->set(index, rowNumber + 1);
+        rowNumbers->set(index, rank);
       }
       ++index;
       ++rowNumber;
@@ -598,10 +796,11 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
     if (index == outputBatchSize_) {
       // This is the last row for this output batch.
       // Prepare the next batch :
-      // i) If 'limit_' is reached for this partition, then skip the rows
-      // until the next partition.
-      // ii) If the next row is from a new partition, then reset rowNumber_.
-      setupNextOutput(output, rowNumber);
+      // i) If the next row is above 'limit_', then skip the rows until the
+      // next partition.
+      // ii) If the next row is from a new partition, then reset the row
+      // number and rank.
+      setupNextOutput(output, rowNumber, rank);
       return output;
     }
   }
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <set>
+
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spiller.h"
@@ -34,8 +36,10 @@ class TopNRowNumberSpiller;
 /// The limit (maximum number of rows to return per partition) must be greater
 /// than zero.
 ///
-/// This is an optimized version of a Window operator with a single row_number
-/// window function followed by a row_number <= N filter.
+/// This is an optimized version of a Window operator with a single row_number,
+/// rank or dense_rank window function followed by a <= N filter on its result.
+/// For rank and dense_rank, a partition keeps all peers of its last row within
+/// the limit, so it may return more than 'limit' rows.
 class TopNRowNumber : public Operator {
  public:
   TopNRowNumber(
@@ -72,11 +76,12 @@ class TopNRowNumber : public Operator {
 
  private:
   // A priority queue to keep track of top 'limit' rows for a given partition.
+  // The top of the queue is the last row in sort order.
   struct TopRows {
     struct Compare {
       RowComparator& comparator;
 
-      bool operator()(const char* lhs, const char* rhs) {
+      bool operator()(const char* lhs, const char* rhs) const {
         return comparator(lhs, rhs);
       }
     };
@@ -84,8 +89,17 @@ class TopNRowNumber : public Operator {
     std::priority_queue<char*, std::vector<char*, StlAllocator<char*>>, Compare>
         rows;
 
+    // Number of rows in 'rows' that are peers of rows.top(). Maintained for
+    // rank only.
+    vector_size_t numTopPeers{0};
+
+    // One row for each distinct value of the sorting keys in 'rows'.
+    // Maintained for dense_rank only.
+    std::set<char*, Compare, StlAllocator<char*>> distinctRows;
+
     TopRows(HashStringAllocator* allocator, RowComparator& comparator)
-        : rows{{comparator}, StlAllocator<char*>(allocator)} {}
+        : rows{{comparator}, StlAllocator<char*>(allocator)},
+          distinctRows{Compare{comparator}, StlAllocator<char*>(allocator)} {}
   };
 
   void initializeNewPartitions();
@@ -100,18 +114,44 @@ class TopNRowNumber : public Operator {
   // Adds input row to a partition or discards the row.
   void processInputRow(vector_size_t index, TopRows& partition);
 
+  // processInputRow() for rank. Keeps the rows with rank <= 'limit_'.
+  void processInputRowForRank(vector_size_t index, TopRows& partition);
+
+  // processInputRow() for dense_rank. Keeps the rows with dense rank <=
+  // 'limit_'.
+  void processInputRowForDenseRank(vector_size_t index, TopRows& partition);
+
+  // Allocates a row, or reuses 'reuse' if not null, and stores input row
+  // 'index' in it.
+  char* storeInputRow(vector_size_t index, char* reuse = nullptr);
+
+  // Pops the peers of partition.rows.top() from the queue. Returns the number
+  // of rows popped. Erases the rows from 'data_' except for the first one,
+  // which is returned in 'firstRow' for reuse.
+  vector_size_t popTopPeers(TopRows& partition, char*& firstRow);
+
+  // Returns the number of peers of partition.rows.top() in the queue.
+  vector_size_t countTopPeers(TopRows& partition);
+
+  // Returns the rank of a row that follows a row with 'previousRank' in the
+  // same partition. 'rowNumber' is the 1-based row number of the row and
+  // 'isPeer' tells whether both rows have equal sorting keys.
+  int64_t nextRank(int64_t previousRank, int64_t rowNumber, bool isPeer) const;
+
   // Returns next partition to add to output or nullptr if there are no
   // partitions left.
   TopRows* nextPartition();
 
-  // Returns partition that was partially added to the previous output batch.
+  // Returns the partition at 'currentPartition_'.
   TopRows& currentPartition();
 
-  // Appends partition rows to outputRows_ and optionally populates row
-  // numbers.
+  // Moves the rows of 'partition' to 'partitionRows_' in sort order and
+  // computes their ranks if needed.
+  void preparePartitionRows(TopRows& partition);
+
+  // Appends the next 'size' rows of 'partitionRows_' to outputRows_ and
+  // optionally populates row numbers.
   void appendPartitionRows(
-      TopRows& partition,
-      vector_size_t start,
       vector_size_t size,
       vector_size_t outputOffset,
       FlatVector<int64_t>* rowNumbers);
@@ -138,15 +178,27 @@ class TopNRowNumber : public Operator {
       vector_size_t index,
       SpillMergeStream* next);
 
-  // Sets nextRowNumber_ to rowNumber. Checks if next row in 'merge_' belongs to
-  // a different partition than last row in 'output' and if so updates
-  // nextRowNumber_ to 0. Also, checks current partition reached the limit on
-  // number of rows and if so advances 'merge_' to the first row on the next
-  // partition and sets nextRowNumber_ to 0.
+  // Returns true if 'next' row has the same sorting keys as index-1 row of
+  // output.
+  bool isPeer(
+      const RowVectorPtr& output,
+      vector_size_t index,
+      SpillMergeStream* next);
+
+  // Sets nextRowNumber_ to rowNumber and nextRank_ to the rank of the next row
+  // in 'merge_' given that the last row in 'output' has 'rank'. Checks if next
+  // row in 'merge_' belongs to a different partition than last row in 'output'
+  // and if so updates nextRowNumber_ to 0 and nextRank_ to 1. Also, checks if
+  // the next row exceeds the limit on rank and if so advances 'merge_' to the
+  // first row on the next partition and sets nextRowNumber_ to 0 and nextRank_
+  // to 1.
   //
   // @post 'merge_->next()' is either at end or points to a row that should be
-  // included in the next output batch using 'nextRowNumber_'.
-  void setupNextOutput(const RowVectorPtr& output, int32_t rowNumber);
+  // included in the next output batch using 'nextRowNumber_' and 'nextRank_'.
+  void setupNextOutput(
+      const RowVectorPtr& output,
+      int64_t rowNumber,
+      int64_t rank);
 
   // Called in noMoreInput() and spill().
   void updateEstimatedOutputRowSize();
@@ -155,6 +207,8 @@ class TopNRowNumber : public Operator {
   // cardinality sufficiently. Returns false if spilling was triggered earlier.
   bool abandonPartialEarly() const;
 
+  const core::TopNRowNumberNode::RankFunction rankFunction_;
+
   const int32_t limit_;
 
   const bool generateRowNumber_;
@@ -234,7 +288,17 @@ class TopNRowNumber : public Operator {
 
   std::optional<int32_t> currentPartition_;
 
-  vector_size_t remainingRowsInPartition_{0};
+  // Rows of the partition being output, in sort order.
+  std::vector<char*> partitionRows_;
+
+  // Ranks of 'partitionRows_'. Set only if 'generateRowNumber_' is true.
+  std::vector<int64_t> partitionRanks_;
+
+  // Index in 'partitionRows_' of the next row to output.
+  vector_size_t nextPartitionRow_{0};
+
+  // Rows popped from a TopRows queue by countTopPeers().
+  std::vector<char*> peerRows_;
 
   // Spiller for contents of the 'data_'.
   std::unique_ptr<SortInputSpiller> spiller_;
@@ -242,7 +306,11 @@ class TopNRowNumber : public Operator {
   // Used to sort-merge spilled data.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 
-  // Row number for the first row in the next output batch.
-  int32_t nextRowNumber_{0};
+  // Number of rows of the current partition returned in previous output
+  // batches.
+  int64_t nextRowNumber_{0};
+
+  // Rank for the first row in the next output batch.
+  int64_t nextRank_{1};
 };
 } // namespace facebook::velox::exec
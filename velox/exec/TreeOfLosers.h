@@ -123,6 +123,32 @@ class TreeOfLosers {
     return lastIndex_ == kEmpty ? nullptr : streams_[lastIndex_].get();
   }
 
+  /// Returns the stream with the lowest first element among the streams other
+  /// than the one returned by the last next(). Returns nullptr if there is no
+  /// other stream with data. The runner-up is one of the losers on the path
+  /// from the last winner to the root, so this takes a logarithmic number of
+  /// comparisons. The caller may use this to take a run of values from the
+  /// last winner without going through next() for each of them: the values
+  /// of the winner that are not greater than the first value of the runner-up
+  /// come before any value of the other streams. Must be called right after
+  /// next().
+  Stream* runnerUp() const {
+    if (lastIndex_ == kEmpty || values_.empty()) {
+      return nullptr;
+    }
+    TIndex best = kEmpty;
+    TIndex node = firstStream_ + lastIndex_;
+    do {
+      node = parent(node);
+      const auto value = values_[node];
+      if (value != kEmpty &&
+          (best == kEmpty || *streams_[value] < *streams_[best])) {
+        best = value;
+      }
+    } while (node != 0);
+    return best == kEmpty ? nullptr : streams_[best].get();
+  }
+
   /// Returns the stream with the lowest first element and a flag that is true
   /// if there is another equal value to come from some other stream. The
   /// streams should have ordered unique values when using this function. This
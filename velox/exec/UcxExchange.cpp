@@ -0,0 +1,1168 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/UcxExchange.h"
+
+#include <glog/logging.h>
+
+#include <cstring>
+
+#include "velox/common/base/Exceptions.h"
+
+#ifdef VELOX_ENABLE_UCX
+#include <arpa/inet.h>
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+#include <folly/io/IOBuf.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <ucp/api/ucp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "velox/exec/OutputBufferManager.h"
+#endif
+
+namespace facebook::velox::exec {
+
+namespace {
+constexpr const char* kUcxPrefix = "ucx://";
+constexpr size_t kUcxPrefixSize = 6;
+
+bool isUcxTaskId(const std::string& taskId) {
+  return strncmp(taskId.c_str(), kUcxPrefix, kUcxPrefixSize) == 0;
+}
+} // namespace
+
+#ifdef VELOX_ENABLE_UCX
+
+namespace {
+
+// Active message ids. kRequest, kAck and kDelete go from the consumer to the
+// producer and have a RequestHeader. kResponse has a ResponseHeader.
+enum MessageId : unsigned { kRequest = 1, kResponse, kAck, kDelete };
+
+// Followed by 'taskIdSize' bytes of the producer task id.
+struct RequestHeader {
+  uint64_t requestId;
+  int64_t sequence;
+  uint64_t maxBytes;
+  int32_t destination;
+  uint32_t taskIdSize;
+};
+
+// Followed by 'numPages' sizes of the pages in the message data and
+// 'numRemaining' sizes of the pages still buffered, all int64_t.
+struct ResponseHeader {
+  uint64_t requestId;
+  int64_t sequence;
+  uint32_t numPages;
+  uint32_t numRemaining;
+  bool atEnd;
+  // Set if the pages have no serialized form.
+  bool error;
+};
+
+constexpr int32_t kPollTimeoutMs = 100;
+
+void checkStatus(ucs_status_t status, const char* what) {
+  VELOX_CHECK(
+      status == UCS_OK, "{} failed: {}", what, ucs_status_string(status));
+}
+
+// The header and data of a message being sent. Freed when the send completes.
+struct SendContext {
+  std::string header;
+  std::vector<std::unique_ptr<folly::IOBuf>> pages;
+  std::vector<ucp_dt_iov_t> iov;
+};
+
+void onSendComplete(void* request, ucs_status_t status, void* userData) {
+  if (status != UCS_OK && status != UCS_ERR_CANCELED) {
+    LOG(WARNING) << "UCX exchange send failed: " << ucs_status_string(status);
+  }
+  delete static_cast<SendContext*>(userData);
+  ucp_request_free(request);
+}
+
+// Sends 'context' as active message 'id' on 'ep'. Returns false if the send
+// fails.
+bool sendMessage(
+    ucp_ep_h ep,
+    MessageId id,
+    std::unique_ptr<SendContext> context,
+    uint32_t flags) {
+  ucp_request_param_t params;
+  params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+      UCP_OP_ATTR_FIELD_USER_DATA | UCP_OP_ATTR_FIELD_FLAGS;
+  params.cb.send = &onSendComplete;
+  params.user_data = context.get();
+  params.flags = flags;
+  const void* data = nullptr;
+  size_t count = 0;
+  if (!context->iov.empty()) {
+    params.op_attr_mask |= UCP_OP_ATTR_FIELD_DATATYPE;
+    params.datatype = ucp_dt_make_iov();
+    data = context->iov.data();
+    count = context->iov.size();
+  }
+  auto* request = ucp_am_send_nbx(
+      ep,
+      id,
+      context->header.data(),
+      context->header.size(),
+      data,
+      count,
+      &params);
+  if (UCS_PTR_IS_ERR(request)) {
+    LOG(WARNING) << "UCX exchange send failed: "
+                 << ucs_status_string(UCS_PTR_STATUS(request));
+    return false;
+  }
+  if (request != nullptr) {
+    // Freed by onSendComplete().
+    context.release();
+  }
+  return true;
+}
+
+void closeEndpoint(ucp_worker_h worker, ucp_ep_h ep, bool wait) {
+  ucp_request_param_t params;
+  params.op_attr_mask = UCP_OP_ATTR_FIELD_FLAGS;
+  params.flags = UCP_EP_CLOSE_FLAG_FORCE;
+  auto* request = ucp_ep_close_nbx(ep, &params);
+  if (request == nullptr || UCS_PTR_IS_ERR(request)) {
+    return;
+  }
+  if (wait) {
+    while (ucp_request_check_status(request) == UCS_INPROGRESS) {
+      ucp_worker_progress(worker);
+    }
+  }
+  ucp_request_free(request);
+}
+
+// A UCP context and worker with a thread that progresses the worker and runs
+// the tasks posted to it. The worker is single threaded, so after start() all
+// calls on it go through post().
+class UcxWorker {
+ public:
+  UcxWorker() {
+    ucp_config_t* config;
+    checkStatus(ucp_config_read(nullptr, nullptr, &config), "ucp_config_read");
+    ucp_params_t params;
+    params.field_mask = UCP_PARAM_FIELD_FEATURES;
+    params.features = UCP_FEATURE_AM | UCP_FEATURE_WAKEUP;
+    auto status = ucp_init(&params, config, &context_);
+    ucp_config_release(config);
+    checkStatus(status, "ucp_init");
+
+    ucp_worker_params_t workerParams;
+    workerParams.field_mask = UCP_WORKER_PARAM_FIELD_THREAD_MODE;
+    workerParams.thread_mode = UCS_THREAD_MODE_SINGLE;
+    status = ucp_worker_create(context_, &workerParams, &worker_);
+    if (status == UCS_OK) {
+      status = ucp_worker_get_efd(worker_, &efd_);
+      if (status != UCS_OK) {
+        ucp_worker_destroy(worker_);
+      }
+    }
+    if (status != UCS_OK) {
+      ucp_cleanup(context_);
+      checkStatus(status, "ucp_worker_create");
+    }
+  }
+
+  ~UcxWorker() {
+    VELOX_CHECK(!thread_.joinable());
+    ucp_worker_destroy(worker_);
+    ucp_cleanup(context_);
+  }
+
+  ucp_worker_h worker() const {
+    return worker_;
+  }
+
+  void setHandler(MessageId id, ucp_am_recv_callback_t callback, void* arg) {
+    ucp_am_handler_param_t params;
+    params.field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID |
+        UCP_AM_HANDLER_PARAM_FIELD_CB | UCP_AM_HANDLER_PARAM_FIELD_ARG |
+        UCP_AM_HANDLER_PARAM_FIELD_FLAGS;
+    params.id = id;
+    params.cb = callback;
+    params.arg = arg;
+    params.flags = UCP_AM_FLAG_WHOLE_MSG;
+    checkStatus(
+        ucp_worker_set_am_recv_handler(worker_, &params),
+        "ucp_worker_set_am_recv_handler");
+  }
+
+  // Starts the progress thread. 'onWakeup' runs on it at least every
+  // kPollTimeoutMs.
+  void start(std::function<void()> onWakeup) {
+    onWakeup_ = std::move(onWakeup);
+    thread_ = std::thread([this]() { run(); });
+  }
+
+  // Runs 'onStop' on the progress thread and joins it.
+  void stop(std::function<void()> onStop) {
+    post([this, onStop = std::move(onStop)]() {
+      onStop();
+      stopped_ = true;
+    });
+    thread_.join();
+    std::deque<std::function<void()>> tasks;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      joined_ = true;
+      tasks.swap(tasks_);
+    }
+  }
+
+  // Runs 'task' on the progress thread. Drops 'task' after stop().
+  void post(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (joined_) {
+        return;
+      }
+      tasks_.push_back(std::move(task));
+    }
+    ucp_worker_signal(worker_);
+  }
+
+ private:
+  void run() {
+    while (!stopped_) {
+      std::deque<std::function<void()>> tasks;
+      {
+        std::lock_guard<std::mutex> l(mutex_);
+        tasks.swap(tasks_);
+      }
+      for (auto& task : tasks) {
+        try {
+          task();
+        } catch (const std::exception& e) {
+          LOG(ERROR) << "UCX exchange task failed: " << e.what();
+        }
+      }
+      if (stopped_) {
+        break;
+      }
+      if (onWakeup_) {
+        onWakeup_();
+      }
+      if (ucp_worker_progress(worker_) != 0) {
+        continue;
+      }
+      // Sleeps until there is network activity or ucp_worker_signal().
+      if (ucp_worker_arm(worker_) == UCS_ERR_BUSY) {
+        continue;
+      }
+      pollfd fd{efd_, POLLIN, 0};
+      ::poll(&fd, 1, kPollTimeoutMs);
+    }
+  }
+
+  ucp_context_h context_;
+  ucp_worker_h worker_;
+  int efd_;
+  std::function<void()> onWakeup_;
+  std::thread thread_;
+  // Set and read on 'thread_'.
+  bool stopped_{false};
+  std::mutex mutex_;
+  // Set after 'thread_' is joined. The tasks posted later would never run.
+  bool joined_{false};
+  std::deque<std::function<void()>> tasks_;
+};
+
+// Returns the header and the producer task id of a kRequest, kAck or kDelete.
+std::pair<RequestHeader, std::string> parseRequest(
+    const void* header,
+    size_t headerLength) {
+  RequestHeader request;
+  VELOX_CHECK_GE(headerLength, sizeof(request));
+  memcpy(&request, header, sizeof(request));
+  VELOX_CHECK_EQ(headerLength, sizeof(request) + request.taskIdSize);
+  return {
+      request,
+      std::string(
+          static_cast<const char*>(header) + sizeof(request),
+          request.taskIdSize)};
+}
+
+} // namespace
+
+class UcxExchangeServer::Impl : public std::enable_shared_from_this<Impl> {
+ public:
+  explicit Impl(uint16_t port) {
+    worker_.setHandler(kRequest, &Impl::onMessage<kRequest>, this);
+    worker_.setHandler(kAck, &Impl::onMessage<kAck>, this);
+    worker_.setHandler(kDelete, &Impl::onMessage<kDelete>, this);
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(port);
+    ucp_listener_params_t params;
+    params.field_mask = UCP_LISTENER_PARAM_FIELD_SOCK_ADDR |
+        UCP_LISTENER_PARAM_FIELD_CONN_HANDLER;
+    params.sockaddr.addr = reinterpret_cast<const sockaddr*>(&address);
+    params.sockaddr.addrlen = sizeof(address);
+    params.conn_handler.cb = &Impl::onConnection;
+    params.conn_handler.arg = this;
+    checkStatus(
+        ucp_listener_create(worker_.worker(), &params, &listener_),
+        "ucp_listener_create");
+
+    ucp_listener_attr_t attr;
+    attr.field_mask = UCP_LISTENER_ATTR_FIELD_SOCKADDR;
+    const auto status = ucp_listener_query(listener_, &attr);
+    if (status != UCS_OK) {
+      ucp_listener_destroy(listener_);
+      checkStatus(status, "ucp_listener_query");
+    }
+    port_ =
+        ntohs(reinterpret_cast<const sockaddr_in*>(&attr.sockaddr)->sin_port);
+    worker_.start(nullptr);
+  }
+
+  // Stops the worker. Called by ~UcxExchangeServer() while the pending
+  // getData() callbacks may still hold 'this'.
+  void stop() {
+    worker_.stop([this]() {
+      ucp_listener_destroy(listener_);
+      for (auto ep : endpoints_) {
+        closeEndpoint(worker_.worker(), ep, true);
+      }
+      endpoints_.clear();
+    });
+  }
+
+  uint16_t port() const {
+    return port_;
+  }
+
+ private:
+  static void onConnection(ucp_conn_request_h request, void* arg) {
+    auto* self = static_cast<Impl*>(arg);
+    ucp_ep_params_t params;
+    params.field_mask = UCP_EP_PARAM_FIELD_CONN_REQUEST |
+        UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE | UCP_EP_PARAM_FIELD_ERR_HANDLER;
+    params.conn_request = request;
+    params.err_mode = UCP_ERR_HANDLING_MODE_PEER;
+    params.err_handler.cb = &Impl::onEndpointError;
+    params.err_handler.arg = self;
+    ucp_ep_h ep;
+    const auto status = ucp_ep_create(self->worker_.worker(), &params, &ep);
+    if (status != UCS_OK) {
+      LOG(WARNING) << "UCX exchange failed to accept a connection: "
+                   << ucs_status_string(status);
+      return;
+    }
+    self->endpoints_.insert(ep);
+  }
+
+  static void onEndpointError(void* arg, ucp_ep_h ep, ucs_status_t status) {
+    auto* self = static_cast<Impl*>(arg);
+    VLOG(1) << "UCX exchange consumer disconnected: "
+            << ucs_status_string(status);
+    if (self->endpoints_.erase(ep) > 0) {
+      closeEndpoint(self->worker_.worker(), ep, false);
+    }
+  }
+
+  template <MessageId kId>
+  static ucs_status_t onMessage(
+      void* arg,
+      const void* header,
+      size_t headerLength,
+      void* /*data*/,
+      size_t /*length*/,
+      const ucp_am_recv_param_t* param) {
+    // Exceptions must not unwind through UCX.
+    try {
+      auto* self = static_cast<Impl*>(arg);
+      auto [request, taskId] = parseRequest(header, headerLength);
+      auto buffers = OutputBufferManager::getInstanceRef();
+      VELOX_CHECK_NOT_NULL(buffers, "invalid OutputBufferManager");
+      switch (kId) {
+        case kRequest:
+          VELOX_CHECK(param->recv_attr & UCP_AM_RECV_ATTR_FIELD_REPLY_EP);
+          self->getData(param->reply_ep, request, taskId, buffers);
+          break;
+        case kAck:
+          buffers->acknowledge(taskId, request.destination, request.sequence);
+          break;
+        case kDelete:
+          buffers->deleteResults(taskId, request.destination);
+          break;
+        default:
+          VELOX_UNREACHABLE();
+      }
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "UCX exchange server failed: " << e.what();
+    }
+    return UCS_OK;
+  }
+
+  void getData(
+      ucp_ep_h ep,
+      const RequestHeader& request,
+      const std::string& taskId,
+      const std::shared_ptr<OutputBufferManager>& buffers) {
+    std::weak_ptr<Impl> weakSelf = shared_from_this();
+    const auto requestId = request.requestId;
+    // If the producer task does not exist yet, the request times out on the
+    // consumer, which asks again.
+    buffers->getData(
+        taskId,
+        request.destination,
+        request.maxBytes,
+        request.sequence,
+        [weakSelf, ep, requestId](
+            std::vector<std::unique_ptr<folly::IOBuf>> pages,
+            int64_t sequence,
+            std::vector<int64_t> remainingBytes) {
+          auto self = weakSelf.lock();
+          if (self == nullptr) {
+            return;
+          }
+          // std::function must be copyable.
+          auto sharedPages =
+              std::make_shared<std::vector<std::unique_ptr<folly::IOBuf>>>(
+                  std::move(pages));
+          self->worker_.post([self,
+                              ep,
+                              requestId,
+                              sharedPages,
+                              sequence,
+                              remainingBytes = std::move(remainingBytes)]() {
+            self->sendResponse(
+                ep,
+                requestId,
+                std::move(*sharedPages),
+                sequence,
+                remainingBytes);
+          });
+        });
+  }
+
+  // Sends the pages from their IOBufs, which stay alive until the send
+  // completes.
+  void sendResponse(
+      ucp_ep_h ep,
+      uint64_t requestId,
+      std::vector<std::unique_ptr<folly::IOBuf>> pages,
+      int64_t sequence,
+      const std::vector<int64_t>& remainingBytes) {
+    if (endpoints_.count(ep) == 0) {
+      // The consumer disconnected.
+      return;
+    }
+    auto context = std::make_unique<SendContext>();
+    ResponseHeader response{requestId, sequence, 0, 0, false, false};
+    std::vector<int64_t> pageSizes;
+    for (auto& page : pages) {
+      if (page == nullptr) {
+        response.atEnd = true;
+        continue;
+      }
+      if (page->empty()) {
+        // An in-process page.
+        response.error = true;
+        break;
+      }
+      pageSizes.push_back(page->computeChainDataLength());
+      for (auto range : *page) {
+        if (!range.empty()) {
+          context->iov.push_back(
+              {const_cast<uint8_t*>(range.data()), range.size()});
+        }
+      }
+      context->pages.push_back(std::move(page));
+    }
+    if (response.error) {
+      pageSizes.clear();
+      context->iov.clear();
+      context->pages.clear();
+    } else {
+      response.numRemaining = remainingBytes.size();
+    }
+    response.numPages = pageSizes.size();
+
+    auto& header = context->header;
+    header.resize(
+        sizeof(response) +
+        (pageSizes.size() + response.numRemaining) * sizeof(int64_t));
+    auto* out = header.data();
+    memcpy(out, &response, sizeof(response));
+    out += sizeof(response);
+    memcpy(out, pageSizes.data(), pageSizes.size() * sizeof(int64_t));
+    out += pageSizes.size() * sizeof(int64_t);
+    memcpy(
+        out, remainingBytes.data(), response.numRemaining * sizeof(int64_t));
+    sendMessage(ep, kResponse, std::move(context), 0);
+  }
+
+  UcxWorker worker_;
+  ucp_listener_h listener_;
+  uint16_t port_;
+  // The endpoints of the connected consumers. Accessed on the worker thread.
+  folly::F14FastSet<ucp_ep_h> endpoints_;
+};
+
+UcxExchangeServer::UcxExchangeServer(uint16_t port)
+    : impl_(std::make_shared<Impl>(port)) {}
+
+UcxExchangeServer::~UcxExchangeServer() {
+  impl_->stop();
+}
+
+uint16_t UcxExchangeServer::port() const {
+  return impl_->port();
+}
+
+bool isUcxExchangeEnabled() {
+  return true;
+}
+
+namespace {
+
+class UcxExchangeSource;
+
+// The consumer side of all UcxExchangeSources in the process: the endpoints
+// to the producers and the outstanding requests.
+class UcxClient {
+ public:
+  static UcxClient& instance() {
+    // Never destroyed, so that the progress thread outlives all sources.
+    static UcxClient* client = new UcxClient();
+    return *client;
+  }
+
+  // Requests the pages from 'sequence' on. 'source' gets the response or an
+  // empty response after 'maxWait'.
+  void request(
+      std::shared_ptr<UcxExchangeSource> source,
+      int64_t sequence,
+      uint64_t maxBytes,
+      std::chrono::microseconds maxWait);
+
+  // Acknowledges the pages before 'sequence'.
+  void acknowledge(const UcxExchangeSource& source, int64_t sequence);
+
+  // Deletes the results of 'source' on the producer.
+  void deleteResults(const UcxExchangeSource& source);
+
+ private:
+  struct PendingRequest {
+    std::shared_ptr<UcxExchangeSource> source;
+    int64_t sequence;
+    std::chrono::steady_clock::time_point deadline;
+    ucp_ep_h ep;
+  };
+
+  // The response being read by rendezvous.
+  struct ReceiveContext {
+    std::shared_ptr<UcxExchangeSource> source;
+    ResponseHeader response;
+    int64_t requestedSequence;
+    std::vector<int64_t> pageSizes;
+    std::vector<int64_t> remainingBytes;
+    std::unique_ptr<folly::IOBuf> data;
+  };
+
+  UcxClient() {
+    worker_.setHandler(kResponse, &UcxClient::onResponse, this);
+    worker_.start([this]() { checkTimeouts(); });
+  }
+
+  // Sends a kAck or kDelete.
+  void post(const UcxExchangeSource& source, int64_t sequence, bool ack);
+
+  // Returns the endpoint to 'address', connecting if needed. Called on the
+  // worker thread.
+  ucp_ep_h endpoint(const std::string& address);
+
+  void checkTimeouts();
+
+  static void onEndpointError(void* arg, ucp_ep_h ep, ucs_status_t status);
+
+  static ucs_status_t onResponse(
+      void* arg,
+      const void* header,
+      size_t headerLength,
+      void* data,
+      size_t length,
+      const ucp_am_recv_param_t* param);
+
+  static void onReceiveComplete(
+      void* request,
+      ucs_status_t status,
+      size_t length,
+      void* userData);
+
+  UcxWorker worker_;
+  std::atomic<uint64_t> nextRequestId_{1};
+  // Accessed on the worker thread.
+  folly::F14FastMap<std::string, ucp_ep_h> endpoints_;
+  folly::F14FastMap<uint64_t, PendingRequest> pending_;
+};
+
+class UcxExchangeSource : public ExchangeSource {
+ public:
+  UcxExchangeSource(
+      const std::string& remoteTaskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool)
+      : ExchangeSource(remoteTaskId, destination, std::move(queue), pool) {
+    // 'remoteTaskId' is ucx://<host>:<port>/<taskId>.
+    const auto slash = remoteTaskId.find('/', kUcxPrefixSize);
+    VELOX_USER_CHECK(
+        slash != std::string::npos && slash > kUcxPrefixSize &&
+            slash + 1 < remoteTaskId.size(),
+        "Invalid UCX exchange task id: {}",
+        remoteTaskId);
+    address_ = remoteTaskId.substr(kUcxPrefixSize, slash - kUcxPrefixSize);
+    producerTaskId_ = remoteTaskId.substr(slash + 1);
+  }
+
+  bool shouldRequestLocked() override {
+    if (atEnd_) {
+      return false;
+    }
+    return !requestPending_.exchange(true);
+  }
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait) override {
+    auto promise = VeloxPromise<Response>("UcxExchangeSource::request");
+    auto future = promise.getSemiFuture();
+    int64_t sequence;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      promise_ = std::move(promise);
+      sequence = sequence_;
+    }
+    UcxClient::instance().request(
+        std::static_pointer_cast<UcxExchangeSource>(shared_from_this()),
+        sequence,
+        maxBytes,
+        maxWait);
+    return future;
+  }
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override {
+    return request(0, maxWait);
+  }
+
+  void pause() override {
+    int64_t ackSequence;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      ackSequence = sequence_;
+    }
+    UcxClient::instance().acknowledge(*this, ackSequence);
+  }
+
+  void close() override {
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      closed_ = true;
+    }
+    checkSetRequestPromise();
+    UcxClient::instance().deleteResults(*this);
+  }
+
+  const std::string& remoteTaskId() const {
+    return remoteTaskId_;
+  }
+
+  const std::string& address() const {
+    return address_;
+  }
+
+  const std::string& producerTaskId() const {
+    return producerTaskId_;
+  }
+
+  int destination() const {
+    return destination_;
+  }
+
+  // Returns a buffer of 'size' bytes allocated from the pool of 'this'.
+  std::unique_ptr<folly::IOBuf> allocate(size_t size) {
+    struct Allocation {
+      std::shared_ptr<memory::MemoryPool> pool;
+      size_t size;
+    };
+    auto* data = pool_->allocate(size);
+    return folly::IOBuf::takeOwnership(
+        data,
+        size,
+        size,
+        [](void* buffer, void* userData) {
+          auto* allocation = static_cast<Allocation*>(userData);
+          allocation->pool->free(buffer, allocation->size);
+          delete allocation;
+        },
+        new Allocation{pool_, size});
+  }
+
+  // Enqueues the pages of a response. 'data' has the pages back to back.
+  // 'requestedSequence' is the sequence of the request and 'sequence' that
+  // of the first page.
+  void deliver(
+      int64_t requestedSequence,
+      int64_t sequence,
+      bool atEnd,
+      const std::vector<int64_t>& pageSizes,
+      std::vector<int64_t> remainingBytes,
+      std::unique_ptr<folly::IOBuf> data) {
+    std::vector<std::unique_ptr<SerializedPage>> pages;
+    int64_t offset = 0;
+    int64_t totalBytes = 0;
+    for (int32_t i = 0; i < static_cast<int32_t>(pageSizes.size()); ++i) {
+      // Skips the pages before the requested sequence, which were received.
+      if (sequence + i >= requestedSequence) {
+        auto page = data->cloneOne();
+        page->trimStart(offset);
+        page->trimEnd(page->length() - pageSizes[i]);
+        totalBytes += pageSizes[i];
+        pages.push_back(std::make_unique<SerializedPage>(std::move(page)));
+      }
+      offset += pageSizes[i];
+    }
+
+    VeloxPromise<Response> requestPromise;
+    bool deleteResults = false;
+    {
+      std::vector<ContinuePromise> queuePromises;
+      {
+        std::lock_guard<std::mutex> l(queue_->mutex());
+        requestPending_ = false;
+        requestPromise = std::move(promise_);
+        if (closed_) {
+          pages.clear();
+          atEnd = false;
+        }
+        for (auto& page : pages) {
+          queue_->enqueueLocked(std::move(page), queuePromises);
+        }
+        if (atEnd && !atEnd_) {
+          queue_->enqueueLocked(nullptr, queuePromises);
+          atEnd_ = true;
+          deleteResults = true;
+        }
+        if (!pages.empty()) {
+          sequence_ = std::max(sequence, requestedSequence) + pages.size();
+        }
+        atEnd = atEnd_;
+      }
+      for (auto& promise : queuePromises) {
+        promise.setValue();
+      }
+    }
+    if (deleteResults) {
+      UcxClient::instance().deleteResults(*this);
+    }
+    if (requestPromise.valid() && !requestPromise.isFulfilled()) {
+      requestPromise.setValue(
+          Response{totalBytes, atEnd, std::move(remainingBytes)});
+    }
+  }
+
+  // Completes the request with no data after a timeout.
+  void timeout() {
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      requestPending_ = false;
+    }
+    checkSetRequestPromise();
+  }
+
+  void setError(const std::string& message) {
+    queue_->setError(message);
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      requestPending_ = false;
+    }
+    checkSetRequestPromise();
+  }
+
+ private:
+  void checkSetRequestPromise() {
+    VeloxPromise<Response> promise;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      promise = std::move(promise_);
+    }
+    if (promise.valid() && !promise.isFulfilled()) {
+      promise.setValue(Response{0, false, {}});
+    }
+  }
+
+  // 'host:port' of the producer's UcxExchangeServer.
+  std::string address_;
+  std::string producerTaskId_;
+  // Set by close() under the queue mutex. Later responses are dropped.
+  bool closed_{false};
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+};
+
+std::string makeRequestHeader(
+    const UcxExchangeSource& source,
+    uint64_t requestId,
+    int64_t sequence,
+    uint64_t maxBytes) {
+  const auto& taskId = source.producerTaskId();
+  RequestHeader request{
+      requestId,
+      sequence,
+      maxBytes,
+      source.destination(),
+      static_cast<uint32_t>(taskId.size())};
+  std::string header(sizeof(request) + taskId.size(), '\0');
+  memcpy(header.data(), &request, sizeof(request));
+  memcpy(header.data() + sizeof(request), taskId.data(), taskId.size());
+  return header;
+}
+
+void UcxClient::request(
+    std::shared_ptr<UcxExchangeSource> source,
+    int64_t sequence,
+    uint64_t maxBytes,
+    std::chrono::microseconds maxWait) {
+  const auto requestId = nextRequestId_++;
+  auto context = std::make_unique<SendContext>();
+  context->header = makeRequestHeader(*source, requestId, sequence, maxBytes);
+  auto sharedContext = std::make_shared<std::unique_ptr<SendContext>>(
+      std::move(context));
+  worker_.post([this,
+                source = std::move(source),
+                requestId,
+                sequence,
+                maxWait,
+                sharedContext]() {
+    ucp_ep_h ep;
+    try {
+      ep = endpoint(source->address());
+    } catch (const std::exception& e) {
+      source->setError(e.what());
+      return;
+    }
+    pending_[requestId] = PendingRequest{
+        source, sequence, std::chrono::steady_clock::now() + maxWait, ep};
+    if (!sendMessage(
+            ep, kRequest, std::move(*sharedContext), UCP_AM_SEND_FLAG_REPLY)) {
+      pending_.erase(requestId);
+      source->setError(
+          fmt::format("UCX exchange request to {} failed", source->address()));
+    }
+  });
+}
+
+void UcxClient::acknowledge(const UcxExchangeSource& source, int64_t sequence) {
+  post(source, sequence, true);
+}
+
+void UcxClient::deleteResults(const UcxExchangeSource& source) {
+  post(source, 0, false);
+}
+
+void UcxClient::post(
+    const UcxExchangeSource& source,
+    int64_t sequence,
+    bool ack) {
+  auto header = makeRequestHeader(source, 0, sequence, 0);
+  worker_.post([this,
+                address = source.address(),
+                header = std::move(header),
+                ack]() {
+    auto context = std::make_unique<SendContext>();
+    context->header = header;
+    sendMessage(endpoint(address), ack ? kAck : kDelete, std::move(context), 0);
+  });
+}
+
+ucp_ep_h UcxClient::endpoint(const std::string& address) {
+  auto it = endpoints_.find(address);
+  if (it != endpoints_.end()) {
+    return it->second;
+  }
+  const auto colon = address.rfind(':');
+  VELOX_USER_CHECK_NE(
+      colon, std::string::npos, "Invalid UCX exchange address: {}", address);
+  const auto host = address.substr(0, colon);
+  const auto port = address.substr(colon + 1);
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* info;
+  const auto error = getaddrinfo(host.c_str(), port.c_str(), &hints, &info);
+  VELOX_CHECK_EQ(
+      error, 0, "Cannot resolve {}: {}", address, gai_strerror(error));
+
+  ucp_ep_params_t params;
+  params.field_mask = UCP_EP_PARAM_FIELD_FLAGS |
+      UCP_EP_PARAM_FIELD_SOCK_ADDR | UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE |
+      UCP_EP_PARAM_FIELD_ERR_HANDLER;
+  params.flags = UCP_EP_PARAMS_FLAGS_CLIENT_SERVER;
+  params.sockaddr.addr = info->ai_addr;
+  params.sockaddr.addrlen = info->ai_addrlen;
+  params.err_mode = UCP_ERR_HANDLING_MODE_PEER;
+  params.err_handler.cb = &UcxClient::onEndpointError;
+  params.err_handler.arg = this;
+  ucp_ep_h ep;
+  const auto status = ucp_ep_create(worker_.worker(), &params, &ep);
+  freeaddrinfo(info);
+  checkStatus(status, "ucp_ep_create");
+  endpoints_[address] = ep;
+  return ep;
+}
+
+void UcxClient::checkTimeouts() {
+  const auto now = std::chrono::steady_clock::now();
+  std::vector<std::shared_ptr<UcxExchangeSource>> timedOut;
+  for (auto it = pending_.begin(); it != pending_.end();) {
+    if (it->second.deadline < now) {
+      timedOut.push_back(std::move(it->second.source));
+      it = pending_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  // A late response finds no pending request and is dropped.
+  for (auto& source : timedOut) {
+    source->timeout();
+  }
+}
+
+// static
+void UcxClient::onEndpointError(void* arg, ucp_ep_h ep, ucs_status_t status) {
+  auto* self = static_cast<UcxClient*>(arg);
+  for (auto it = self->endpoints_.begin(); it != self->endpoints_.end();) {
+    if (it->second == ep) {
+      it = self->endpoints_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  std::vector<std::shared_ptr<UcxExchangeSource>> failed;
+  for (auto it = self->pending_.begin(); it != self->pending_.end();) {
+    if (it->second.ep == ep) {
+      failed.push_back(std::move(it->second.source));
+      it = self->pending_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  closeEndpoint(self->worker_.worker(), ep, false);
+  for (auto& source : failed) {
+    source->setError(fmt::format(
+        "UCX exchange connection to {} failed: {}",
+        source->address(),
+        ucs_status_string(status)));
+  }
+}
+
+// static
+ucs_status_t UcxClient::onResponse(
+    void* arg,
+    const void* header,
+    size_t headerLength,
+    void* data,
+    size_t length,
+    const ucp_am_recv_param_t* param) {
+  auto* self = static_cast<UcxClient*>(arg);
+  // Set once the rendezvous data is received or released.
+  bool dataDone = !(param->recv_attr & UCP_AM_RECV_ATTR_FLAG_RNDV);
+  auto releaseData = [&]() {
+    if (!dataDone) {
+      ucp_am_data_release(self->worker_.worker(), data);
+      dataDone = true;
+    }
+  };
+  ResponseHeader response;
+  if (headerLength < sizeof(response)) {
+    LOG(ERROR) << "UCX exchange response is too short: " << headerLength;
+    releaseData();
+    return UCS_OK;
+  }
+  memcpy(&response, header, sizeof(response));
+  auto it = self->pending_.find(response.requestId);
+  if (it == self->pending_.end()) {
+    // Timed out.
+    releaseData();
+    return UCS_OK;
+  }
+  auto context = std::make_unique<ReceiveContext>();
+  context->source = std::move(it->second.source);
+  context->requestedSequence = it->second.sequence;
+  context->response = response;
+  self->pending_.erase(it);
+  auto source = context->source;
+
+  // Exceptions, e.g. from exceeding the memory limit of the pool, must not
+  // unwind through UCX.
+  try {
+    VELOX_CHECK(
+        !response.error,
+        "UCX exchange cannot send in-process pages of {}",
+        source->remoteTaskId());
+    VELOX_CHECK_EQ(
+        headerLength,
+        sizeof(response) +
+            (response.numPages + response.numRemaining) * sizeof(int64_t));
+    const auto* sizes =
+        reinterpret_cast<const char*>(header) + sizeof(response);
+    context->pageSizes.resize(response.numPages);
+    memcpy(
+        context->pageSizes.data(), sizes, response.numPages * sizeof(int64_t));
+    sizes += response.numPages * sizeof(int64_t);
+    context->remainingBytes.resize(response.numRemaining);
+    memcpy(
+        context->remainingBytes.data(),
+        sizes,
+        response.numRemaining * sizeof(int64_t));
+
+    if (length > 0) {
+      context->data = source->allocate(length);
+      if (!dataDone) {
+        // Reads the pages by RDMA into 'data'.
+        ucp_request_param_t params;
+        params.op_attr_mask =
+            UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
+        params.cb.recv_am = &UcxClient::onReceiveComplete;
+        params.user_data = context.get();
+        auto* request = ucp_am_recv_data_nbx(
+            self->worker_.worker(),
+            data,
+            context->data->writableData(),
+            length,
+            &params);
+        dataDone = true;
+        VELOX_CHECK(
+            !UCS_PTR_IS_ERR(request),
+            "UCX exchange receive failed: {}",
+            ucs_status_string(UCS_PTR_STATUS(request)));
+        if (request != nullptr) {
+          // Delivered by onReceiveComplete().
+          context.release();
+          return UCS_OK;
+        }
+      } else {
+        memcpy(context->data->writableData(), data, length);
+      }
+    }
+    source->deliver(
+        context->requestedSequence,
+        response.sequence,
+        response.atEnd,
+        context->pageSizes,
+        std::move(context->remainingBytes),
+        std::move(context->data));
+  } catch (const std::exception& e) {
+    releaseData();
+    source->setError(e.what());
+  }
+  return UCS_OK;
+}
+
+// static
+void UcxClient::onReceiveComplete(
+    void* request,
+    ucs_status_t status,
+    size_t /*length*/,
+    void* userData) {
+  std::unique_ptr<ReceiveContext> context(
+      static_cast<ReceiveContext*>(userData));
+  ucp_request_free(request);
+  if (status != UCS_OK) {
+    context->source->setError(fmt::format(
+        "UCX exchange receive failed: {}", ucs_status_string(status)));
+    return;
+  }
+  try {
+    context->source->deliver(
+        context->requestedSequence,
+        context->response.sequence,
+        context->response.atEnd,
+        context->pageSizes,
+        std::move(context->remainingBytes),
+        std::move(context->data));
+  } catch (const std::exception& e) {
+    context->source->setError(e.what());
+  }
+}
+
+} // namespace
+
+std::shared_ptr<ExchangeSource> createUcxExchangeSource(
+    const std::string& remoteTaskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  if (!isUcxTaskId(remoteTaskId)) {
+    return nullptr;
+  }
+  return std::make_shared<UcxExchangeSource>(
+      remoteTaskId, destination, std::move(queue), pool);
+}
+
+#else
+
+class UcxExchangeServer::Impl {};
+
+UcxExchangeServer::UcxExchangeServer(uint16_t /*port*/) {
+  VELOX_UNSUPPORTED("Velox is built without UCX");
+}
+
+UcxExchangeServer::~UcxExchangeServer() = default;
+
+uint16_t UcxExchangeServer::port() const {
+  VELOX_UNREACHABLE();
+}
+
+bool isUcxExchangeEnabled() {
+  return false;
+}
+
+std::shared_ptr<ExchangeSource> createUcxExchangeSource(
+    const std::string& remoteTaskId,
+    int /*destination*/,
+    std::shared_ptr<ExchangeQueue> /*queue*/,
+    memory::MemoryPool* /*pool*/) {
+  if (!isUcxTaskId(remoteTaskId)) {
+    return nullptr;
+  }
+  VELOX_UNSUPPORTED("Velox is built without UCX: {}", remoteTaskId);
+}
+
+#endif
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "velox/exec/ExchangeSource.h"
+
+namespace facebook::velox::exec {
+
+/// Exchange over UCX (Unified Communication X), which uses RDMA on
+/// InfiniBand and RoCE networks. A UcxExchangeServer on the producer serves
+/// the pages of the process-wide OutputBufferManager. ExchangeSources made by
+/// createUcxExchangeSource() fetch them for remote task ids of the form
+/// 'ucx://<host>:<port>/<taskId>'.
+///
+/// A request carries the sequence number and the byte budget that
+/// ExchangeClient passes to ExchangeSource::request(). The server answers it
+/// with OutputBufferManager::getData(), sending the page sizes and the sizes
+/// of the pages still buffered in the message header. The pages are sent
+/// from the IOBufs of the output buffer without copying them. Large
+/// responses go by rendezvous, where the consumer reads the pages by RDMA
+/// into one buffer allocated from its memory pool. pause() acknowledges the
+/// received pages and close() and the end marker delete the results, as
+/// with OutputBufferManager::acknowledge() and deleteResults().
+///
+/// In-process shuffle pages have no serialized form and are not supported.
+/// Requires building with VELOX_ENABLE_UCX.
+class UcxExchangeServer {
+ public:
+  /// Starts serving on 'port' of all interfaces. Port 0 picks a free port.
+  /// Throws if Velox is built without UCX.
+  explicit UcxExchangeServer(uint16_t port);
+
+  ~UcxExchangeServer();
+
+  /// Returns the port the server listens on.
+  uint16_t port() const;
+
+ private:
+  class Impl;
+
+  // Shared with the callbacks of pending OutputBufferManager::getData() calls,
+  // which may run after 'this' is destroyed.
+  std::shared_ptr<Impl> impl_;
+};
+
+/// Returns true if Velox is built with UCX.
+bool isUcxExchangeEnabled();
+
+/// ExchangeSource::Factory for 'ucx://' task ids. Returns nullptr for other
+/// task ids. Throws for 'ucx://' task ids if Velox is built without UCX.
+std::shared_ptr<ExchangeSource> createUcxExchangeSource(
+    const std::string& remoteTaskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool);
+
+} // namespace facebook::velox::exec
@@ -19,6 +19,12 @@
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+namespace {
+// The max number of elements referenced by an unnested output column per
+// output row, over which the elements are copied instead of wrapped.
+constexpr vector_size_t kMaxElementsPerOutputRow = 2;
+} // namespace
+
 Unnest::Unnest(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -118,7 +124,8 @@ RowVectorPtr Unnest::getOutput() {
   // 'maxOutputSize_'. When the output size is 'maxOutputSize_', the
   // first and last row might not be processed completely, and their output
   // might be split into multiple batches.
-  auto rowRange = extractRowRange(size);
+  auto rowRange =
+      extractRowRange(size, memoryPressureAdjustedBatchRows(maxOutputSize_));
   if (rowRange.numElements == 0) {
     // All arrays/maps are null or empty.
     input_ = nullptr;
@@ -144,7 +151,9 @@ RowVectorPtr Unnest::getOutput() {
   return output;
 }
 
-Unnest::RowRange Unnest::extractRowRange(vector_size_t size) const {
+Unnest::RowRange Unnest::extractRowRange(
+    vector_size_t size,
+    vector_size_t maxOutputSize) const {
   vector_size_t numInput = 0;
   vector_size_t numElements = 0;
   std::optional<vector_size_t> lastRowEnd;
@@ -153,26 +162,26 @@ Unnest::RowRange Unnest::extractRowRange(vector_size_t size) const {
     const vector_size_t remainingSize =
         isFirstRow ? rawMaxSizes_[row] - firstRowStart_ : rawMaxSizes_[row];
     ++numInput;
-    if (numElements + remainingSize > maxOutputSize_) {
+    if (numElements + remainingSize > maxOutputSize) {
       // A single row's output needs to be split into multiple batches.
       // Determines the range to process the first and last rows partially,
       // rather than processing from 0 to 'rawMaxSizes_[row]'.
       if (isFirstRow) {
-        lastRowEnd = firstRowStart_ + maxOutputSize_ - numElements;
+        lastRowEnd = firstRowStart_ + maxOutputSize - numElements;
       } else {
-        lastRowEnd = maxOutputSize_ - numElements;
+        lastRowEnd = maxOutputSize - numElements;
       }
-      // Process maxOutputSize_ in this getOutput.
-      numElements = maxOutputSize_;
+      // Process maxOutputSize in this getOutput.
+      numElements = maxOutputSize;
       break;
     }
     // Process this row completely.
     numElements += remainingSize;
-    if (numElements == maxOutputSize_) {
+    if (numElements == maxOutputSize) {
       break;
     }
   }
-  VELOX_DCHECK_LE(numElements, maxOutputSize_);
+  VELOX_DCHECK_LE(numElements, maxOutputSize);
   return {nextInputRow_, numInput, lastRowEnd, numElements};
 };
 
@@ -222,6 +231,9 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
   bool identityMapping = true;
+  bool hasNulls = false;
+  vector_size_t minElement = std::numeric_limits<vector_size_t>::max();
+  vector_size_t maxElement = -1;
   VELOX_DCHECK_GT(range.size, 0);
 
   range.forEachRow(
@@ -237,15 +249,21 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
             identityMapping = false;
           }
           auto currentUnnestSize = std::min(end, unnestSize);
+          if (start < currentUnnestSize) {
+            minElement = std::min(minElement, offset + start);
+            maxElement = std::max(maxElement, offset + currentUnnestSize - 1);
+          }
           for (auto i = start; i < currentUnnestSize; i++) {
             rawElementIndices[index++] = offset + i;
           }
 
           for (auto i = std::max(start, currentUnnestSize); i < end; ++i) {
+            hasNulls = true;
             bits::setNull(rawNulls, index++, true);
           }
         } else if (size > 0) {
           identityMapping = false;
+          hasNulls = true;
 
           for (auto i = start; i < end; ++i) {
             bits::setNull(rawNulls, index++, true);
@@ -255,7 +273,28 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
       rawMaxSizes_,
       firstRowStart_);
 
-  return {elementIndices, nulls, identityMapping};
+  UnnestChannelEncoding encoding{
+      elementIndices, hasNulls ? nulls : nullptr, identityMapping};
+  if (identityMapping || maxElement < minElement) {
+    return encoding;
+  }
+  // Wraps a slice of the elements with the referenced range if the range is no
+  // more than a few times the output size, which is the case unless the arrays
+  // or maps are out of order in their base vector. The indices are made
+  // relative to the slice.
+  encoding.baseOffset = minElement;
+  encoding.baseSize = maxElement - minElement + 1;
+  if (encoding.baseSize > kMaxElementsPerOutputRow * range.numElements) {
+    encoding.copy = true;
+  }
+  if (minElement > 0) {
+    for (auto i = 0; i < range.numElements; ++i) {
+      rawElementIndices[i] = hasNulls && bits::isBitNull(rawNulls, i)
+          ? 0
+          : rawElementIndices[i] - minElement;
+    }
+  }
+  return encoding;
 }
 
 VectorPtr Unnest::generateOrdinalityVector(const RowRange& range) {
@@ -326,9 +365,10 @@ VectorPtr Unnest::UnnestChannelEncoding::wrap(
   if (identityMapping) {
     return base;
   }
-
-  const auto result =
-      BaseVector::wrapInDictionary(nulls, indices, wrapSize, base);
+  if (baseSize == 0) {
+    // All the output rows are null.
+    return BaseVector::createNullConstant(base->type(), wrapSize, base->pool());
+  }
 
   // Dictionary vectors whose size is much smaller than the size of the
   // 'alphabet' (base vector) create efficiency problems downstream. For
@@ -339,12 +379,21 @@ VectorPtr Unnest::UnnestChannelEncoding::wrap(
   // causes large number of large allocations and wastes a lot of
   // resources.
   //
-  // Make a flat copy of the necessary rows to avoid inefficient downstream
-  // processing.
+  // Wrap a slice of the base vector with the referenced rows, which shares the
+  // buffers of the base vector. Make a flat copy of the necessary rows if the
+  // referenced rows are spread over a much larger range.
   //
   // TODO A better fix might be to change expression evaluation (and all other
   // operations) to handle dictionaries with large alphabets efficiently.
-  return BaseVector::copy(*result);
+  const auto alphabet = baseOffset == 0 && baseSize == base->size()
+      ? base
+      : base->slice(baseOffset, baseSize);
+  const auto result =
+      BaseVector::wrapInDictionary(nulls, indices, wrapSize, alphabet);
+  if (copy) {
+    return BaseVector::copy(*result);
+  }
+  return result;
 }
 
 bool Unnest::isFinished() {
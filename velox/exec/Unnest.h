@@ -94,7 +94,9 @@ class Unnest : public Operator {
 
   // Extract the range of rows to process.
   // @param size The size of input RowVector.
-  RowRange extractRowRange(vector_size_t size) const;
+  // @param maxOutputSize The maximum number of output rows in the range.
+  RowRange extractRowRange(vector_size_t size, vector_size_t maxOutputSize)
+      const;
 
   // Generate output for 'rowRange' represented rows.
   // @param rowRange Range of rows to process.
@@ -108,9 +110,17 @@ class Unnest : public Operator {
 
   struct UnnestChannelEncoding {
     BufferPtr indices;
+    // Null if no output row is null.
     BufferPtr nulls;
     bool identityMapping;
 
+    // The range of the elements referenced by 'indices', which are relative
+    // to 'baseOffset'. The elements are copied instead if the range is much
+    // larger than the output.
+    vector_size_t baseOffset{0};
+    vector_size_t baseSize{0};
+    bool copy{false};
+
     VectorPtr wrap(const VectorPtr& base, vector_size_t wrapSize) const;
   };
 
@@ -128,7 +138,8 @@ class Unnest : public Operator {
 
   std::vector<DecodedVector> unnestDecoded_;
 
-  // The maximum number of output batch rows.
+  // The maximum number of output batch rows. Each getOutput() may produce
+  // fewer rows under memory pressure.
   const uint32_t maxOutputSize_;
   BufferPtr maxSizes_;
   vector_size_t* rawMaxSizes_{nullptr};
@@ -690,6 +690,33 @@ std::unique_ptr<common::Filter> VectorHasher::getFilter(
   }
 }
 
+std::unique_ptr<common::Filter> VectorHasher::getFilter(
+    const uint64_t* valueIds,
+    int64_t numIds,
+    bool nullAllowed) const {
+  if (!isRange_) {
+    return nullptr;
+  }
+  switch (typeKind_) {
+    case TypeKind::TINYINT:
+      [[fallthrough]];
+    case TypeKind::SMALLINT:
+      [[fallthrough]];
+    case TypeKind::INTEGER:
+      [[fallthrough]];
+    case TypeKind::BIGINT: {
+      // Id 0 is reserved for null and id 'i' is 'min_ + i - 1'.
+      std::vector<int64_t> values;
+      bits::forEachSetBit(valueIds, 1, numIds, [&](auto id) {
+        values.push_back(min_ + id - 1);
+      });
+      return common::createBigintValues(values, nullAllowed);
+    }
+    default:
+      return nullptr;
+  }
+}
+
 namespace {
 template <typename T>
 // Adds 'reserve' to either end of the range between 'min' and 'max' while
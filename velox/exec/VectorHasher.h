@@ -244,6 +244,11 @@ class VectorHasher {
   // Returns null if distinctOverflow_ is true.
   std::unique_ptr<common::Filter> getFilter(bool nullAllowed) const;
 
+  // Returns a filter passing the values whose value ids are set in the first
+  // 'numIds' bits of 'valueIds'. Returns null if 'this' is not in range mode.
+  std::unique_ptr<common::Filter>
+  getFilter(const uint64_t* valueIds, int64_t numIds, bool nullAllowed) const;
+
   void resetStats() {
     uniqueValues_.clear();
     uniqueValuesStorage_.clear();
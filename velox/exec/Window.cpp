@@ -52,16 +52,17 @@ Window::Window(
           windowNode_, pool(), spillConfig, &nonReclaimableSection_);
     } else {
       windowBuild_ = std::make_unique<PartitionStreamingWindowBuild>(
-          windowNode, pool(), spillConfig, &nonReclaimableSection_);
+          windowNode,
+          pool(),
+          spillConfig,
+          &nonReclaimableSection_,
+          &spillStats_);
     }
   } else {
     windowBuild_ = std::make_unique<SortWindowBuild>(
         windowNode,
         pool(),
-        common::PrefixSortConfig{
-            driverCtx->queryConfig().prefixSortNormalizedKeyMaxBytes(),
-            driverCtx->queryConfig().prefixSortMinRows(),
-            driverCtx->queryConfig().prefixSortMaxStringPrefixLength()},
+        driverCtx->prefixSortConfig(),
         spillConfig,
         &nonReclaimableSection_,
         &spillStats_);
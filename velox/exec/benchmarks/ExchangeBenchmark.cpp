@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
 
 #include "velox/core/QueryConfig.h"
@@ -26,7 +27,9 @@
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/parse/TypeResolver.h"
+#include "velox/serializers/CompactRowSerializer.h"
 #include "velox/serializers/PrestoSerializer.h"
+#include "velox/serializers/UnsafeRowSerializer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 DEFINE_int32(width, 16, "Number of parties in shuffle");
@@ -41,6 +44,34 @@ DEFINE_int64(
     "task-wide buffer in local exchange");
 DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
 DEFINE_int32(dict_pct, 0, "Percentage of columns wrapped in dictionary");
+DEFINE_int64(
+    network_latency_us,
+    0,
+    "Simulated network latency of each remote exchange request");
+DEFINE_int64(
+    network_mb_per_sec,
+    0,
+    "Simulated network bandwidth of each remote exchange source in MB/s. 0 "
+    "means unlimited");
+DEFINE_bool(
+    sweep,
+    false,
+    "Runs the remote exchange of flat 10K row batches for all combinations of "
+    "sweep_widths, sweep_page_kb, sweep_compression and sweep_serdes instead "
+    "of the fixed benchmarks");
+DEFINE_string(sweep_widths, "4,16", "Numbers of sources and destinations");
+DEFINE_string(
+    sweep_page_kb,
+    "64,1024",
+    "KB to buffer for each destination before producing a page");
+DEFINE_string(
+    sweep_compression,
+    "none,lz4,zstd",
+    "Shuffle compression kinds, see shuffle_compression_codec");
+DEFINE_string(
+    sweep_serdes,
+    "Presto,CompactRow,UnsafeRow",
+    "Serde kinds of the shuffle");
 // Add the following definitions to allow Clion runs
 DEFINE_bool(gtest_color, false, "");
 DEFINE_string(gtest_filter, "*", "");
@@ -52,6 +83,11 @@ DEFINE_string(gtest_filter, "*", "");
 /// count the rows and send the count to a final single task stage
 /// that returns the sum of the counts. The sum is expected to be n *
 /// number of rows in constant input.
+///
+/// The remote exchanges go through LocalExchangeSource. With
+/// --network_latency_us and --network_mb_per_sec, its responses are delayed
+/// as if sent over a network, which lets --sweep compare the page sizes,
+/// compression and serde kinds of a shuffle under network conditions.
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -88,6 +124,15 @@ void sortByAndPrintMax(
             << "\n Min: " << metrics.back().toString() << std::endl;
 }
 
+// The options of the shuffle from the leaf to the final aggregation tasks.
+struct ExchangeOptions {
+  VectorSerde::Kind serdeKind{VectorSerde::Kind::kPresto};
+  std::string compressionKind{"none"};
+  // Bytes to buffer for each destination before producing a page. 0 means
+  // --exchange_buffer_mb over the number of destinations.
+  int64_t pageBytes{0};
+};
+
 class ExchangeBenchmark : public VectorTestBase {
  public:
   std::vector<RowVectorPtr> makeRows(
@@ -122,7 +167,8 @@ class ExchangeBenchmark : public VectorTestBase {
       int32_t taskWidth,
       int64_t& wallUs,
       PlanNodeStats& partitionedOutputStats,
-      PlanNodeStats& exchangeStats) {
+      PlanNodeStats& exchangeStats,
+      const ExchangeOptions& options = {}) {
     core::PlanNodePtr plan;
     core::PlanNodeId exchangeId;
     core::PlanNodeId leafPartitionedOutputId;
@@ -138,16 +184,23 @@ class ExchangeBenchmark : public VectorTestBase {
     BENCHMARK_SUSPEND {
       assert(!vectors.empty());
       configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
-          fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
+          fmt::format(
+              "{}",
+              options.pageBytes == 0 ? FLAGS_exchange_buffer_mb << 20
+                                     : options.pageBytes * width);
+      configSettings_[core::QueryConfig::kShuffleCompressionKind] =
+          options.compressionKind;
       const auto iteration = ++iteration_;
 
       // leafPlan: PartitionedOutput/kPartitioned(1) <-- Values(0)
       std::vector<std::string> leafTaskIds;
-      auto leafPlan = exec::test::PlanBuilder()
-                          .values(vectors, true)
-                          .partitionedOutput({"c0"}, width)
-                          .capturePlanNodeId(leafPartitionedOutputId)
-                          .planNode();
+      auto leafPlan =
+          exec::test::PlanBuilder()
+              .values(vectors, true)
+              .partitionedOutput(
+                  {"c0"}, width, /*outputLayout=*/{}, options.serdeKind)
+              .capturePlanNodeId(leafPartitionedOutputId)
+              .planNode();
 
       for (int32_t counter = 0; counter < width; ++counter) {
         auto leafTaskId = makeTaskId(iteration, "leaf", counter);
@@ -162,7 +215,7 @@ class ExchangeBenchmark : public VectorTestBase {
       std::vector<std::string> finalAggTaskIds;
       core::PlanNodePtr finalAggPlan =
           exec::test::PlanBuilder()
-              .exchange(leafPlan->outputType(), VectorSerde::Kind::kPresto)
+              .exchange(leafPlan->outputType(), options.serdeKind)
               .capturePlanNodeId(exchangeId)
               .singleAggregation({}, {"count(1)"})
               .partitionedOutput({}, 1)
@@ -192,6 +245,7 @@ class ExchangeBenchmark : public VectorTestBase {
     };
 
     exec::test::AssertQueryBuilder(plan)
+        .configs(configSettings_)
         .splits(finalAggSplits)
         .assertResults(expected);
 
@@ -374,7 +428,7 @@ int32_t ExchangeBenchmark::iteration_;
 
 std::unique_ptr<ExchangeBenchmark> bm;
 
-void runBenchmarks() {
+RowTypePtr makeFlatType() {
   std::vector<std::string> flatNames = {"c0"};
   std::vector<TypePtr> flatTypes = {BIGINT()};
   std::vector<TypePtr> typeSelection = {
@@ -401,7 +455,11 @@ void runBenchmarks() {
       flatSize += 20;
     }
   }
-  auto flatType = ROW(std::move(flatNames), std::move(flatTypes));
+  return ROW(std::move(flatNames), std::move(flatTypes));
+}
+
+void runBenchmarks() {
+  auto flatType = makeFlatType();
 
   auto structType = ROW(
       {{"c0", BIGINT()},
@@ -592,6 +650,90 @@ void runBenchmarks() {
   assert(!localPartitionWaitStats.wallMs.empty());
 }
 
+template <typename T>
+std::vector<T> splitFlag(const std::string& flag) {
+  std::vector<T> values;
+  folly::split(',', flag, values, true);
+  VELOX_CHECK(!values.empty(), "Empty list flag");
+  return values;
+}
+
+void runSweep() {
+  struct SweepCase {
+    std::string name;
+    int32_t width;
+    ExchangeOptions options;
+    int64_t wallUs{0};
+    PlanNodeStats partitionedOutputStats;
+    PlanNodeStats exchangeStats;
+  };
+
+  std::vector<SweepCase> cases;
+  for (auto width : splitFlag<int32_t>(FLAGS_sweep_widths)) {
+    for (auto pageKb : splitFlag<int64_t>(FLAGS_sweep_page_kb)) {
+      for (const auto& compression :
+           splitFlag<std::string>(FLAGS_sweep_compression)) {
+        for (const auto& serde : splitFlag<std::string>(FLAGS_sweep_serdes)) {
+          SweepCase sweepCase;
+          sweepCase.name = fmt::format(
+              "exchangeFlat10k_w{}_{}kb_{}_{}",
+              width,
+              pageKb,
+              compression,
+              serde);
+          sweepCase.width = width;
+          sweepCase.options.serdeKind = VectorSerde::kindByName(serde);
+          sweepCase.options.compressionKind = compression;
+          sweepCase.options.pageBytes = pageKb << 10;
+          cases.push_back(std::move(sweepCase));
+        }
+      }
+    }
+  }
+
+  std::vector<RowVectorPtr> flat10k(
+      bm->makeRows(makeFlatType(), 10, 10000, FLAGS_dict_pct));
+  for (auto& sweepCase : cases) {
+    folly::addBenchmark(__FILE__, sweepCase.name, [&]() {
+      // Keeps the stats of the last run only.
+      sweepCase.partitionedOutputStats = PlanNodeStats();
+      sweepCase.exchangeStats = PlanNodeStats();
+      bm->run(
+          flat10k,
+          sweepCase.width,
+          FLAGS_task_width,
+          sweepCase.wallUs,
+          sweepCase.partitionedOutputStats,
+          sweepCase.exchangeStats,
+          sweepCase.options);
+      return 1;
+    });
+  }
+
+  folly::runBenchmarks();
+
+  std::cout << fmt::format(
+                   "{:<48}{:>12}{:>14}{:>14}{:>14}",
+                   "case",
+                   "wall",
+                   "bytes",
+                   "output CPU",
+                   "exchange CPU")
+            << std::endl;
+  for (const auto& sweepCase : cases) {
+    std::cout << fmt::format(
+                     "{:<48}{:>12}{:>14}{:>14}{:>14}",
+                     sweepCase.name,
+                     succinctMicros(sweepCase.wallUs),
+                     succinctBytes(sweepCase.exchangeStats.rawInputBytes),
+                     succinctNanos(sweepCase.partitionedOutputStats
+                                       .cpuWallTiming.cpuNanos),
+                     succinctNanos(
+                         sweepCase.exchangeStats.cpuWallTiming.cpuNanos))
+              << std::endl;
+  }
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -603,10 +745,24 @@ int main(int argc, char** argv) {
   if (!isRegisteredNamedVectorSerde(VectorSerde::Kind::kPresto)) {
     serializer::presto::PrestoVectorSerde::registerNamedVectorSerde();
   }
+  if (!isRegisteredNamedVectorSerde(VectorSerde::Kind::kCompactRow)) {
+    serializer::CompactRowVectorSerde::registerNamedVectorSerde();
+  }
+  if (!isRegisteredNamedVectorSerde(VectorSerde::Kind::kUnsafeRow)) {
+    serializer::spark::UnsafeRowVectorSerde::registerNamedVectorSerde();
+  }
   exec::ExchangeSource::registerFactory(exec::test::createLocalExchangeSource);
+  exec::test::LocalExchangeNetworkModel networkModel;
+  networkModel.latency = std::chrono::microseconds(FLAGS_network_latency_us);
+  networkModel.bytesPerSecond = FLAGS_network_mb_per_sec << 20;
+  exec::test::testingSetLocalExchangeNetworkModel(networkModel);
 
   bm = std::make_unique<ExchangeBenchmark>();
-  runBenchmarks();
+  if (FLAGS_sweep) {
+    runSweep();
+  } else {
+    runBenchmarks();
+  }
   bm.reset();
 
   return 0;
@@ -36,18 +36,24 @@ struct HashTableBenchmarkParams {
   //  -the build row schema,
   //  -the expected hash table size,
   //  -number of building rows,
-  //  -number of build RowContainers.
+  //  -number of build RowContainers,
+  //  -optionally the radix partition target size and whether to probe the
+  //   table with the build keys after preparing it.
   HashTableBenchmarkParams(
       BaseHashTable::HashMode mode,
       const TypePtr& buildType,
       int64_t hashTableSize,
       int64_t buildSize,
-      int32_t numWays)
+      int32_t numWays,
+      uint64_t radixPartitionTargetBytes = 0,
+      bool probe = false)
       : mode{mode},
         buildType{buildType},
         hashTableSize{hashTableSize},
         buildSize{buildSize},
-        numWays{numWays} {
+        numWays{numWays},
+        radixPartitionTargetBytes{radixPartitionTargetBytes},
+        probe{probe} {
     VELOX_CHECK_LE(hashTableSize, buildSize);
     VELOX_CHECK_GE(numWays, 1);
 
@@ -71,6 +77,9 @@ struct HashTableBenchmarkParams {
         numWays > 1,
         buildSize > hashTableSize,
         BaseHashTable::modeString(mode));
+    if (probe) {
+      title += fmt::format(",probe,radix:{}", radixPartitionTargetBytes);
+    }
   }
 
   // Expected mode.
@@ -88,6 +97,12 @@ struct HashTableBenchmarkParams {
   // Number of build RowContainers.
   int32_t numWays;
 
+  // Target size of a radix partition of the table. 0 means a single table.
+  uint64_t radixPartitionTargetBytes{0};
+
+  // If true, probes the prepared table with all the build batches.
+  bool probe{false};
+
   // Title for reporting
   std::string title;
 
@@ -131,9 +146,29 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
         BaseHashTable::kNoSpillInputStartPartitionBit,
         executor_.get());
     VELOX_CHECK_EQ(topTable_->hashMode(), params_.mode);
+    if (params_.probe) {
+      probe();
+    }
   }
 
  private:
+  // Probes 'topTable_' with the build side batches, so that every probe row
+  // finds a match.
+  void probe() {
+    HashLookup lookup(topTable_->hashers(), pool_.get());
+    int64_t numHits{0};
+    for (const auto& batch : probeBatches_) {
+      SelectivityVector rows(batch->size());
+      lookup.reset(batch->size());
+      topTable_->prepareForJoinProbe(lookup, batch, rows, true);
+      topTable_->joinProbe(lookup);
+      for (auto row : lookup.rows) {
+        numHits += lookup.hits[row] != nullptr;
+      }
+    }
+    folly::doNotOptimizeAway(numHits);
+  }
+
   // Create the row vector for the build side, where the first column is used
   // as the join key, and the remaining columns are dependent fields.
   // If expect mode is array, the key is within the range [0, hashTableSize];
@@ -221,6 +256,7 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
           false,
           1'000,
           pool_.get());
+      table->setRadixPartitionTargetBytes(params_.radixPartitionTargetBytes);
 
       copyVectorsToTable(batches[i], table.get());
       if (i == 0) {
@@ -229,11 +265,15 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
         otherTables_.push_back(std::move(table));
       }
     }
+    if (params_.probe) {
+      probeBatches_ = std::move(batches);
+    }
   }
 
   std::default_random_engine randomEngine_;
   std::unique_ptr<HashTable<true>> topTable_;
   std::vector<std::unique_ptr<BaseHashTable>> otherTables_;
+  std::vector<RowVectorPtr> probeBatches_;
   HashTableBenchmarkParams params_;
 };
 
@@ -296,6 +336,35 @@ void initHashModeBenchmarkParams(
     }
   }
 }
+// Compares build and probe of large tables in single table mode against radix
+// partitioned mode with L2 sized partitions.
+void initRadixPartitionBenchmarkParams(
+    std::vector<HashTableBenchmarkParams>& params) {
+  TypePtr twoKeyType{ROW({"k1", "k2"}, {BIGINT(), BIGINT()})};
+  TypePtr threeKeyType{ROW({"k1", "k2", "k3"}, {BIGINT(), BIGINT(), BIGINT()})};
+  std::vector<int64_t> buildSizeVector = {2L << 23, 2L << 24};
+  std::vector<uint64_t> radixTargetBytesVector = {0, 1 << 20};
+  for (auto buildSize : buildSizeVector) {
+    for (auto radixTargetBytes : radixTargetBytesVector) {
+      params.push_back(HashTableBenchmarkParams(
+          BaseHashTable::HashMode::kNormalizedKey,
+          twoKeyType,
+          buildSize,
+          buildSize,
+          8,
+          radixTargetBytes,
+          true));
+      params.push_back(HashTableBenchmarkParams(
+          BaseHashTable::HashMode::kHash,
+          threeKeyType,
+          buildSize,
+          buildSize,
+          8,
+          radixTargetBytes,
+          true));
+    }
+  }
+}
 } // namespace
 
 int main(int argc, char** argv) {
@@ -312,6 +381,7 @@ int main(int argc, char** argv) {
   // initArrayModeBenchmarkParams(params);
   initNormalizedKeyModeBenchmarkParams(params);
   initHashModeBenchmarkParams(params);
+  initRadixPartitionBenchmarkParams(params);
 
   for (auto& param : params) {
     folly::addBenchmark(__FILE__, param.title, [param, &bm]() {
@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fmt/format.h>
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/Synchronized.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/common/time/Timer.h"
+#include "velox/core/QueryConfig.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/ArbitratorTestUtil.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+DEFINE_int32(duration_sec, 30, "For how long to run the queries");
+DEFINE_int32(num_threads, 8, "Number of concurrently running queries");
+DEFINE_int32(num_drivers, 4, "Number of drivers of each query");
+DEFINE_int64(
+    arbitrator_capacity_mb,
+    1'024,
+    "Capacity of the memory arbitrator shared by all queries");
+DEFINE_int64(
+    query_capacity_mb,
+    512,
+    "Max memory capacity of each query");
+DEFINE_int32(num_batches, 100, "Number of input batches of each driver");
+DEFINE_int32(batch_size, 10'000, "Number of rows of each input batch");
+DEFINE_int32(
+    num_keys,
+    100'000,
+    "Number of distinct grouping, join and partition keys");
+DEFINE_bool(spill_enabled, true, "Enables spilling of all query shapes");
+DEFINE_bool(
+    global_arbitration_enabled,
+    true,
+    "Enables the background global arbitration of the shared arbitrator");
+DEFINE_string(
+    query_shapes,
+    "join,aggregation,orderby,window",
+    "Comma-separated query shapes to run. Each query picks one at random "
+    "from join, aggregation, orderby and window");
+
+/// Stress-tests the memory arbitration with a mix of concurrent memory
+/// intensive queries. Each of 'num_threads' threads runs queries of a random
+/// shape back to back for 'duration_sec' seconds. All queries share one
+/// SharedArbitrator of 'arbitrator_capacity_mb', which is typically set below
+/// what the queries need so that they spill, wait for arbitration or get
+/// aborted. Reports per shape the throughput, spilled bytes, arbitration time
+/// and the number of failed queries, followed by the arbitrator stats. The
+/// input batches are shared by all queries and also count to the capacity of
+/// the arbitrator. This is meant to compare arbitration policies and spill
+/// settings by their impact on the total throughput rather than on single
+/// queries.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::test;
+
+namespace {
+
+struct ShapeStats {
+  uint64_t numQueries{0};
+  uint64_t numSucceeded{0};
+  uint64_t numOoms{0};
+  uint64_t numAborts{0};
+  uint64_t wallNanos{0};
+  uint64_t inputRows{0};
+  uint64_t spilledBytes{0};
+  uint64_t arbitrationWallNanos{0};
+};
+
+class MemoryArbitrationBenchmark : public VectorTestBase {
+ public:
+  MemoryArbitrationBenchmark()
+      : executor_(std::make_unique<folly::CPUThreadPoolExecutor>(
+            std::thread::hardware_concurrency())),
+        spillDirectory_(TempDirectoryPath::create()) {
+    makeData();
+    folly::StringPiece shapes(FLAGS_query_shapes);
+    std::vector<std::string> names;
+    folly::split(',', shapes, names, true);
+    for (const auto& name : names) {
+      shapes_.push_back({name, makePlan(name)});
+    }
+    VELOX_CHECK(!shapes_.empty(), "No query shape to run");
+  }
+
+  void run() {
+    const auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::seconds(FLAGS_duration_sec);
+    std::atomic_int32_t queryCount{0};
+    std::vector<std::thread> threads;
+    threads.reserve(FLAGS_num_threads);
+    for (int32_t i = 0; i < FLAGS_num_threads; ++i) {
+      threads.emplace_back([&, i]() {
+        folly::Random::DefaultGenerator rng(i);
+        while (std::chrono::steady_clock::now() < deadline) {
+          const auto shapeIndex = folly::Random::rand32(shapes_.size(), rng);
+          runQuery(
+              shapeIndex,
+              fmt::format("query_{}", queryCount++),
+              fmt::format("{}/{}", spillDirectory_->getPath(), i));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    printStats();
+  }
+
+ private:
+  struct QueryShape {
+    std::string name;
+    core::PlanNodePtr plan;
+  };
+
+  void makeData() {
+    const auto makeBatches = [&](int32_t numBatches, int32_t seed) {
+      std::vector<RowVectorPtr> batches;
+      for (int32_t i = 0; i < numBatches; ++i) {
+        const auto offset = (i + seed) * FLAGS_batch_size;
+        batches.push_back(makeRowVector(
+            {"k", "v", "s"},
+            {makeFlatVector<int64_t>(
+                 FLAGS_batch_size,
+                 [&](auto row) { return (offset + row) % FLAGS_num_keys; }),
+             makeFlatVector<int64_t>(
+                 FLAGS_batch_size,
+                 [&](auto row) { return (offset + row) * 7'919; }),
+             makeFlatVector<std::string>(FLAGS_batch_size, [&](auto row) {
+               return fmt::format("payload_{:020}", offset + row);
+             })}));
+      }
+      return batches;
+    };
+    input_ = makeBatches(FLAGS_num_batches, 0);
+    // The build side of a join runs in a single driver and has as many rows
+    // as the probe side of each driver.
+    build_ = makeBatches(FLAGS_num_batches, 17);
+  }
+
+  core::PlanNodePtr makePlan(const std::string& name) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    PlanBuilder builder(planNodeIdGenerator);
+    builder.values(input_, true);
+    if (name == "join") {
+      builder.hashJoin(
+          {"k"},
+          {"build_k"},
+          PlanBuilder(planNodeIdGenerator)
+              .values(build_)
+              .project({"k AS build_k", "s AS build_s"})
+              .planNode(),
+          "",
+          {"k", "v", "build_s"});
+    } else if (name == "aggregation") {
+      builder.singleAggregation({"k"}, {"sum(v)", "count(1)", "max(s)"});
+    } else if (name == "orderby") {
+      builder.orderBy({"k", "v DESC"}, false);
+    } else if (name == "window") {
+      builder.window({"row_number() over (partition by k order by v)"});
+    } else {
+      VELOX_USER_FAIL("Unknown query shape: {}", name);
+    }
+    // Counts the result rows to keep the results small. The results would
+    // otherwise be held by the query and count to its memory usage.
+    return builder.singleAggregation({}, {"count(1)"}).planNode();
+  }
+
+  std::unordered_map<std::string, std::string> queryConfigs() const {
+    const auto spillEnabled = FLAGS_spill_enabled ? "true" : "false";
+    return {
+        {core::QueryConfig::kSpillEnabled, spillEnabled},
+        {core::QueryConfig::kJoinSpillEnabled, spillEnabled},
+        {core::QueryConfig::kAggregationSpillEnabled, spillEnabled},
+        {core::QueryConfig::kOrderBySpillEnabled, spillEnabled},
+        {core::QueryConfig::kWindowSpillEnabled, spillEnabled},
+    };
+  }
+
+  void runQuery(
+      size_t shapeIndex,
+      const std::string& queryId,
+      const std::string& spillPath) {
+    const auto& shape = shapes_[shapeIndex];
+    const auto queryCtx = newQueryCtx(
+        memory::memoryManager(),
+        executor_.get(),
+        FLAGS_query_capacity_mb << 20,
+        queryId);
+    ShapeStats queryStats;
+    queryStats.numQueries = 1;
+    const auto startNanos = getCurrentTimeNano();
+    try {
+      std::shared_ptr<Task> task;
+      AssertQueryBuilder(shape.plan)
+          .queryCtx(queryCtx)
+          .configs(queryConfigs())
+          .spillDirectory(spillPath)
+          .maxDrivers(FLAGS_num_drivers)
+          .runWithoutResults(task);
+      queryStats.numSucceeded = 1;
+      for (const auto& [_, nodeStats] : toPlanStats(task->taskStats())) {
+        queryStats.spilledBytes += nodeStats.spilledBytes;
+        const auto it = nodeStats.customStats.find(
+            memory::SharedArbitrator::kMemoryArbitrationWallNanos);
+        if (it != nodeStats.customStats.end()) {
+          queryStats.arbitrationWallNanos += it->second.sum;
+        }
+      }
+      queryStats.inputRows = static_cast<uint64_t>(FLAGS_num_drivers) *
+          FLAGS_num_batches * FLAGS_batch_size;
+    } catch (const VeloxException& e) {
+      if (e.errorCode() == error_code::kMemCapExceeded.c_str()) {
+        queryStats.numOoms = 1;
+      } else if (e.errorCode() == error_code::kMemAborted.c_str()) {
+        queryStats.numAborts = 1;
+      } else {
+        LOG(ERROR) << "Unexpected exception:\n" << e.what();
+        throw;
+      }
+    }
+    queryStats.wallNanos = getCurrentTimeNano() - startNanos;
+
+    auto lockedStats = stats_.wlock();
+    auto& stats = (*lockedStats)[shape.name];
+    stats.numQueries += queryStats.numQueries;
+    stats.numSucceeded += queryStats.numSucceeded;
+    stats.numOoms += queryStats.numOoms;
+    stats.numAborts += queryStats.numAborts;
+    stats.wallNanos += queryStats.wallNanos;
+    stats.inputRows += queryStats.inputRows;
+    stats.spilledBytes += queryStats.spilledBytes;
+    stats.arbitrationWallNanos += queryStats.arbitrationWallNanos;
+  }
+
+  void printStats() {
+    const double durationSec = FLAGS_duration_sec;
+    ShapeStats total;
+    const auto printRow = [&](const std::string& name,
+                              const ShapeStats& stats) {
+      std::cout << fmt::format(
+                       "{:<12}{:>9}{:>9}{:>7}{:>7}{:>10.2f}{:>14.4g}{:>12}"
+                       "{:>12}{:>12}",
+                       name,
+                       stats.numQueries,
+                       stats.numSucceeded,
+                       stats.numOoms,
+                       stats.numAborts,
+                       stats.numSucceeded / durationSec,
+                       stats.inputRows / durationSec,
+                       succinctBytes(stats.spilledBytes),
+                       succinctNanos(stats.arbitrationWallNanos),
+                       succinctNanos(
+                           stats.numQueries == 0
+                               ? 0
+                               : stats.wallNanos / stats.numQueries))
+                << std::endl;
+    };
+    std::cout << fmt::format(
+                     "{:<12}{:>9}{:>9}{:>7}{:>7}{:>10}{:>14}{:>12}{:>12}"
+                     "{:>12}",
+                     "shape",
+                     "queries",
+                     "success",
+                     "ooms",
+                     "aborts",
+                     "queries/s",
+                     "input rows/s",
+                     "spilled",
+                     "arbitration",
+                     "avg wall")
+              << std::endl;
+    for (const auto& [name, stats] : *stats_.rlock()) {
+      printRow(name, stats);
+      total.numQueries += stats.numQueries;
+      total.numSucceeded += stats.numSucceeded;
+      total.numOoms += stats.numOoms;
+      total.numAborts += stats.numAborts;
+      total.wallNanos += stats.wallNanos;
+      total.inputRows += stats.inputRows;
+      total.spilledBytes += stats.spilledBytes;
+      total.arbitrationWallNanos += stats.arbitrationWallNanos;
+    }
+    printRow("total", total);
+    std::cout << memory::memoryManager()->arbitrator()->stats().toString()
+              << std::endl;
+  }
+
+  const std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  const std::shared_ptr<TempDirectoryPath> spillDirectory_;
+  std::vector<RowVectorPtr> input_;
+  std::vector<RowVectorPtr> build_;
+  std::vector<QueryShape> shapes_;
+  folly::Synchronized<std::map<std::string, ShapeStats>> stats_;
+};
+
+void setupMemory() {
+  memory::SharedArbitrator::registerFactory();
+  memory::MemoryManagerOptions options;
+  options.arbitratorCapacity = FLAGS_arbitrator_capacity_mb << 20;
+  options.arbitratorKind = "SHARED";
+  options.extraArbitratorConfigs = {
+      {std::string(
+           memory::SharedArbitrator::ExtraConfig::kGlobalArbitrationEnabled),
+       FLAGS_global_arbitration_enabled ? "true" : "false"}};
+  memory::MemoryManager::initialize(options);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  setupMemory();
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  window::prestosql::registerAllWindowFunctions();
+  parse::registerTypeResolver();
+
+  MemoryArbitrationBenchmark().run();
+  return 0;
+}
@@ -28,6 +28,8 @@ using namespace facebook::velox::exec::test;
 TestData narrow;
 TestData medium;
 TestData wide;
+TestData clustered;
+TestData overlapping;
 
 BENCHMARK(narrowTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(narrow, false);
@@ -45,6 +47,10 @@ BENCHMARK_RELATIVE(mediumArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(medium, false);
 }
 
+BENCHMARK_RELATIVE(mediumTreeRuns) {
+  MergeTestBase::testRuns(medium, false);
+}
+
 BENCHMARK(wideTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(wide, false);
 }
@@ -53,6 +59,24 @@ BENCHMARK_RELATIVE(wideArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(wide, false);
 }
 
+// Inputs where each stream covers its own range of values and overlaps only
+// with its neighbors, so the merge has long runs from a single stream.
+BENCHMARK(clusteredTree) {
+  MergeTestBase::test<TreeOfLosers<TestingStream>>(clustered, false);
+}
+
+BENCHMARK_RELATIVE(clusteredTreeRuns) {
+  MergeTestBase::testRuns(clustered, false);
+}
+
+BENCHMARK(overlappingTree) {
+  MergeTestBase::test<TreeOfLosers<TestingStream>>(overlapping, false);
+}
+
+BENCHMARK_RELATIVE(overlappingTreeRuns) {
+  MergeTestBase::testRuns(overlapping, false);
+}
+
 int main(int argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   gflags::ParseCommandLineFlags(&argc, &argv, true);
@@ -61,6 +85,8 @@ int main(int argc, char* argv[]) {
   narrow = test.makeTestData(100'000'000, 7);
   medium = test.makeTestData(10'000'0000, 37);
   wide = test.makeTestData(10'000'0000, 1029);
+  clustered = test.makeClusteredTestData(10'000'0000, 37, 0);
+  overlapping = test.makeClusteredTestData(10'000'0000, 37, 50);
   folly::runBenchmarks();
   return 0;
 }
@@ -16,6 +16,7 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 #include <iostream>
+#include <thread>
 
 #include "glog/logging.h"
 #include "velox/exec/PlanNodeStats.h"
@@ -43,11 +44,20 @@ class OrderByBenchmark {
       int32_t iterations,
       int numKeys) {
     TestCase testCase = {numRows, rowType, numKeys};
-    {
+    // Sorts on the driver thread, then in up to one run per core merged into
+    // the output.
+    for (const uint32_t parallelSortRuns :
+         {1u, std::max(1u, std::thread::hardware_concurrency())}) {
       folly::addBenchmark(
           __FILE__,
-          "OrderBy_" + benchmarkName,
-          [test = testCase, iterations = std::max(1, iterations / 10), this]() {
+          fmt::format(
+              "OrderBy{}_{}",
+              parallelSortRuns > 1 ? "Parallel" : "",
+              benchmarkName),
+          [test = testCase,
+           iterations = std::max(1, iterations / 10),
+           parallelSortRuns,
+           this]() {
             core::PlanNodeId orderByNodeId;
             const auto plan = makeOrderByPlan(test, orderByNodeId);
             uint64_t inputNs = 0;
@@ -56,7 +66,11 @@ class OrderByBenchmark {
             const auto start = getCurrentTimeMicro();
             for (auto i = 0; i < iterations; ++i) {
               std::shared_ptr<Task> task;
-              test::AssertQueryBuilder(plan).runWithoutResults(task);
+              test::AssertQueryBuilder(plan)
+                  .config(
+                      core::QueryConfig::kOrderByParallelSortRuns,
+                      std::to_string(parallelSortRuns))
+                  .runWithoutResults(task);
               auto taskStats = exec::toPlanStats(task->taskStats());
               auto& stats = taskStats.at(orderByNodeId);
               inputNs += stats.addInputTiming.wallNanos;
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <folly/Benchmark.h>
+#include <folly/Random.h>
 #include <folly/init/Init.h>
 
 #include "glog/logging.h"
@@ -33,8 +34,23 @@ class TestCase {
       size_t numRows,
       const RowTypePtr& rowType,
       int numKeys)
-      : testName_(testName), numRows_(numRows), pool_(pool), rowType_(rowType) {
-    // Initialize a RowContainer that holds fuzzed rows to be sorted.
+      : TestCase(
+            pool,
+            testName,
+            OrderByBenchmarkUtil::fuzzRows(rowType, numRows, pool),
+            numKeys) {}
+
+  TestCase(
+      memory::MemoryPool* pool,
+      const std::string& testName,
+      const RowVectorPtr& data,
+      int numKeys)
+      : testName_(testName),
+        numRows_(data->size()),
+        pool_(pool),
+        rowType_(asRowType(data->type())) {
+    // Initialize a RowContainer that holds the rows to be sorted.
+    const auto& rowType = rowType_;
     std::vector<TypePtr> keyTypes;
     std::vector<TypePtr> dependentTypes;
     for (auto i = 0; i < rowType->size(); ++i) {
@@ -45,9 +61,7 @@ class TestCase {
       }
     }
     data_ = std::make_unique<RowContainer>(keyTypes, dependentTypes, pool);
-    RowVectorPtr sortedRows =
-        OrderByBenchmarkUtil::fuzzRows(rowType, numRows, pool_);
-    storeRows(numRows, sortedRows);
+    storeRows(numRows_, data);
 
     // Initialize CompareFlags, it could be same for each key in benchmark.
     for (int i = 0; i < numKeys; ++i) {
@@ -111,6 +125,11 @@ static const common::PrefixSortConfig kDefaultSortConfig(1024, 100, 50);
 static const common::PrefixSortConfig
     kStdSortConfig(1024, std::numeric_limits<int>::max(), 50);
 
+// Same as 'kDefaultSortConfig' but extends the prefix of string keys that
+// tie on the first 50 bytes.
+static const common::PrefixSortConfig
+    kAdaptiveStringPrefixSortConfig(1024, 100, 50, 256);
+
 class PrefixSortBenchmark {
  public:
   PrefixSortBenchmark(memory::MemoryPool* pool) : pool_(pool) {}
@@ -118,12 +137,12 @@ class PrefixSortBenchmark {
   void runPrefixSort(
       const std::vector<char*>& rows,
       RowContainer* rowContainer,
-      const std::vector<CompareFlags>& compareFlags) {
+      const std::vector<CompareFlags>& compareFlags,
+      const common::PrefixSortConfig& config = kDefaultSortConfig) {
     // Copy rows to avoid sort rows already sorted.
     auto sortedRows = std::vector<char*, memory::StlAllocator<char*>>(
         rows.begin(), rows.end(), *pool_);
-    PrefixSort::sort(
-        rowContainer, compareFlags, kDefaultSortConfig, pool_, sortedRows);
+    PrefixSort::sort(rowContainer, compareFlags, config, pool_, sortedRows);
   }
 
   void runStdSort(
@@ -177,7 +196,86 @@ class PrefixSortBenchmark {
     testCases_.push_back(std::move(testCase));
   }
 
+  // Adds benchmarks for string keys that share long prefixes, such as URLs,
+  // paths and tenant qualified ids. These tie on a fixed size string prefix.
+  void addStringBenchmarks() {
+    for (const auto numRows : {1'000, 100'000}) {
+      const auto iterations = numRows == 1'000 ? 1'000 : 10;
+      for (const auto numKeys : {1, 2}) {
+        auto data = makeStringKeys(numRows);
+        auto testCase = std::make_unique<TestCase>(
+            pool_,
+            fmt::format("string-prefix_{}_{}", numRows, numKeys),
+            data,
+            numKeys);
+        addStringBenchmark(*testCase, iterations);
+        testCases_.push_back(std::move(testCase));
+      }
+    }
+  }
+
  private:
+  RowVectorPtr makeStringKeys(vector_size_t numRows) {
+    auto urls = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), numRows, pool_);
+    auto tenants = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), numRows, pool_);
+    auto ids = BaseVector::create<FlatVector<int64_t>>(
+        BIGINT(), numRows, pool_);
+    folly::Random::DefaultGenerator rng(123);
+    for (auto row = 0; row < numRows; ++row) {
+      const auto tenant = folly::Random::rand32(100, rng);
+      const auto url = fmt::format(
+          "https://storage.example.com/tenant-{:06}/warehouse/tables/{}/{}",
+          tenant,
+          folly::Random::rand32(1'000, rng),
+          folly::Random::rand64(rng));
+      urls->set(row, StringView(url));
+      tenants->set(row, StringView(fmt::format("tenant-{:06}", tenant)));
+      ids->set(row, row);
+    }
+    return std::make_shared<RowVector>(
+        pool_,
+        ROW({"c0", "c1", "c2"}, {VARCHAR(), VARCHAR(), BIGINT()}),
+        nullptr,
+        numRows,
+        std::vector<VectorPtr>{tenants, urls, ids});
+  }
+
+  void addStringBenchmark(const TestCase& testCase, int iterations) {
+    folly::addBenchmark(
+        __FILE__,
+        "StdSort_" + testCase.testName(),
+        [rows = testCase.rows(),
+         container = testCase.rowContainer(),
+         sortFlags = testCase.compareFlags(),
+         iterations,
+         this]() {
+          for (auto i = 0; i < iterations; ++i) {
+            runStdSort(rows, container, sortFlags);
+          }
+          return rows.size() * iterations;
+        });
+    for (const auto* config :
+         {&kDefaultSortConfig, &kAdaptiveStringPrefixSortConfig}) {
+      folly::addBenchmark(
+          __FILE__,
+          config == &kDefaultSortConfig ? "%PrefixSort"
+                                        : "%AdaptiveStringPrefixSort",
+          [rows = testCase.rows(),
+           container = testCase.rowContainer(),
+           sortFlags = testCase.compareFlags(),
+           iterations,
+           config,
+           this]() {
+            for (auto i = 0; i < iterations; ++i) {
+              runPrefixSort(rows, container, sortFlags, *config);
+            }
+            return rows.size() * iterations;
+          });
+    }
+  }
+
   std::vector<std::unique_ptr<TestCase>> testCases_;
   memory::MemoryPool* pool_;
 };
@@ -199,6 +297,7 @@ int main(int argc, char** argv) {
                                           int numKeys) {
     bm.addBenchmark(testName, numRows, rowType, iterations, numKeys);
   });
+  bm.addStringBenchmarks();
 
   folly::runBenchmarks();
   return 0;
@@ -28,7 +28,8 @@ using namespace facebook::velox::exec;
 namespace {
 
 // Adds 10M mostly unique values to a single SetAccumulator, then extracts
-// unique values from it.
+// unique values from it. Also adds the same values to many small
+// accumulators, as a group by with few values per group does.
 class SetAccumulatorBenchmark : public velox::test::VectorTestBase {
  public:
   void setup() {
@@ -91,6 +92,38 @@ class SetAccumulatorBenchmark : public velox::test::VectorTestBase {
     folly::doNotOptimizeAway(result);
   }
 
+  // Adds the values of column "a" round robin to 'numGroups' accumulators,
+  // each ending up with 10M / 'numGroups' values.
+  void runSmallGroups(int32_t numGroups) {
+    using Accumulator = aggregate::prestosql::SetAccumulator<int64_t>;
+    folly::BenchmarkSuspender suspender;
+    HashStringAllocator allocator(pool());
+    std::vector<std::unique_ptr<Accumulator>> accumulators;
+    accumulators.reserve(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      accumulators.push_back(
+          std::make_unique<Accumulator>(BIGINT(), &allocator));
+    }
+    suspender.dismiss();
+
+    int32_t group = 0;
+    for (const auto& rowVector : rowVectors_) {
+      DecodedVector decoded(*rowVector->childAt("a"));
+      for (auto i = 0; i < rowVector->size(); ++i) {
+        accumulators[group]->addValue(decoded, i, &allocator);
+        if (++group == numGroups) {
+          group = 0;
+        }
+      }
+    }
+
+    suspender.rehire();
+    LOG(INFO) << numGroups
+              << " groups: " << allocator.currentBytes() / numGroups
+              << " bytes per group in HashStringAllocator, "
+              << sizeof(Accumulator) << " bytes in the accumulator";
+  }
+
   std::vector<RowVectorPtr> rowVectors_;
 };
 
@@ -108,6 +141,14 @@ BENCHMARK(twoBigints) {
   bm->runTwoBigints();
 }
 
+BENCHMARK(bigintTwoValuesPerGroup) {
+  bm->runSmallGroups(5'000'000);
+}
+
+BENCHMARK(bigintTenValuesPerGroup) {
+  bm->runSmallGroups(1'000'000);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
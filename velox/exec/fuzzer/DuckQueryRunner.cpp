@@ -394,7 +394,10 @@ std::optional<std::string> DuckQueryRunner::toSql(
     sql << inputType->nameOf(i);
   }
 
-  sql << ", row_number() OVER (";
+  sql << ", "
+      << core::TopNRowNumberNode::rankFunctionName(
+             topNRowNumberNode->rankFunction())
+      << "() OVER (";
 
   const auto& partitionKeys = topNRowNumberNode->partitionKeys();
   if (!partitionKeys.empty()) {
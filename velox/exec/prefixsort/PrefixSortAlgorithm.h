@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -159,6 +160,30 @@ class PrefixSortRunner {
         compare);
   }
 
+  // Within radixSort, buckets with fewer entries than kMinRadixSortBucket, or
+  // buckets more than kMaxRadixSortDepth byte splits deep, are sorted with
+  // quick-sort.
+  static const int kMinRadixSortBucket = 64;
+  static const int kMaxRadixSortDepth = 16;
+
+  /// Sorts prefix data in range [start, end) with an in-place most
+  /// significant digit radix sort on the first 'keySize' bytes of the
+  /// normalized keys. The entries that tie on all 'keySize' bytes are then
+  /// sorted with 'compare'. The keys are stored as words of 8 bytes in
+  /// reverse byte order for fast long compare, see
+  /// PrefixSort::extractRowAndEncodePrefixKeys.
+  template <typename TCompare>
+  void radixSort(char* start, char* end, uint32_t keySize, TCompare compare)
+      const {
+    radixSort(
+        detail::PrefixSortIterator(start, entrySize_),
+        detail::PrefixSortIterator(end, entrySize_),
+        0,
+        keySize,
+        0,
+        compare);
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
@@ -347,6 +372,83 @@ class PrefixSortRunner {
     }
   }
 
+  // Returns the offset in an entry of the 'index'-th most significant byte of
+  // the normalized keys.
+  FOLLY_ALWAYS_INLINE static uint32_t radixByteOffset(uint32_t index) {
+    return (index & ~7u) + 7 - (index & 7u);
+  }
+
+  // Sorts prefix data in range [start, end) whose normalized keys are equal in
+  // the bytes before 'keyByte'. Each pass counts the entries per value of
+  // 'keyByte', moves them in place to their buckets (American flag sort) and
+  // sorts the buckets on the next byte. Bytes that are the same in all the
+  // entries are skipped without moving any entry.
+  template <typename TCompare>
+  void radixSort(
+      const detail::PrefixSortIterator& start,
+      const detail::PrefixSortIterator& end,
+      uint32_t keyByte,
+      uint32_t keySize,
+      uint32_t depth,
+      TCompare compare) const {
+    const uint64_t len = end - start;
+    if (len < kMinRadixSortBucket || depth > kMaxRadixSortDepth) {
+      quickSort(start, end, compare);
+      return;
+    }
+    std::array<uint64_t, 256> bucketEnds;
+    uint32_t offset;
+    while (true) {
+      if (keyByte == keySize) {
+        // All the normalized keys are equal, 'compare' breaks the ties.
+        quickSort(start, end, compare);
+        return;
+      }
+      offset = radixByteOffset(keyByte);
+      bucketEnds.fill(0);
+      for (auto it = start; it < end; ++it) {
+        ++bucketEnds[static_cast<uint8_t>((*it)[offset])];
+      }
+      if (bucketEnds[static_cast<uint8_t>((*start)[offset])] != len) {
+        break;
+      }
+      ++keyByte;
+    }
+
+    std::array<uint64_t, 256> nexts;
+    uint64_t bucketEnd = 0;
+    for (auto bucket = 0; bucket < 256; ++bucket) {
+      nexts[bucket] = bucketEnd;
+      bucketEnd += bucketEnds[bucket];
+      bucketEnds[bucket] = bucketEnd;
+    }
+    for (auto bucket = 0; bucket < 256; ++bucket) {
+      while (nexts[bucket] < bucketEnds[bucket]) {
+        const auto it = start + nexts[bucket];
+        const auto digit = static_cast<uint8_t>((*it)[offset]);
+        if (digit == bucket) {
+          ++nexts[bucket];
+        } else {
+          swap(it, start + nexts[digit]++);
+        }
+      }
+    }
+
+    uint64_t bucketStart = 0;
+    for (auto bucket = 0; bucket < 256; ++bucket) {
+      if (bucketEnds[bucket] - bucketStart > 1) {
+        radixSort(
+            start + bucketStart,
+            start + bucketEnds[bucket],
+            keyByte + 1,
+            keySize,
+            depth + 1,
+            compare);
+      }
+      bucketStart = bucketEnds[bucket];
+    }
+  }
+
   const uint64_t entrySize_;
   char* const swapBuffer_;
 };
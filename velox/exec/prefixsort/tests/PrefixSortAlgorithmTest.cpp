@@ -55,6 +55,43 @@ class PrefixSortAlgorithmTest : public testing::Test,
     ASSERT_EQ(data1, data2);
   }
 
+  // Sorts 'size' random values which have at most 'numDistinctValues'
+  // distinct values if it is not 0.
+  void testRadixSort(size_t size, uint64_t numDistinctValues = 0) {
+    std::vector<int64_t> data1(size);
+    std::generate(data1.begin(), data1.end(), [&]() {
+      const auto value = folly::Random::rand64();
+      return numDistinctValues == 0 ? value : value % numDistinctValues;
+    });
+    std::vector<int64_t> data2 = data1;
+
+    // Sort data1 with radix-sort. The prefix-sort buffer stores the encoded
+    // keys in reverse byte order per word.
+    {
+      char* start = (char*)data1.data();
+      char* end = start + sizeof(int64_t) * data1.size();
+      uint32_t entrySize = sizeof(int64_t);
+      auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool());
+      PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
+      encodeInPlace(data1);
+      for (auto& value : data1) {
+        value = __builtin_bswap64(value);
+      }
+      sortRunner.radixSort(start, end, entrySize, [&](char* a, char* b) {
+        const auto left = *reinterpret_cast<uint64_t*>(a);
+        const auto right = *reinterpret_cast<uint64_t*>(b);
+        return left < right ? -1 : (left == right ? 0 : 1);
+      });
+      for (auto& value : data1) {
+        value = __builtin_bswap64(value);
+      }
+    }
+
+    std::sort(data2.begin(), data2.end());
+    decodeInPlace(data1);
+    ASSERT_EQ(data1, data2);
+  }
+
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
@@ -70,6 +107,16 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  testRadixSort(PrefixSortRunner::kMinRadixSortBucket - 1);
+  testRadixSort(PrefixSortRunner::kMinRadixSortBucket);
+  testRadixSort(100'000);
+  // Values that share their high bytes and have many duplicates.
+  testRadixSort(100'000, 1);
+  testRadixSort(100'000, 300);
+  testRadixSort(100'000, 70'000);
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
@@ -16,6 +16,7 @@
 
 #include <fmt/format.h>
 #include <folly/Math.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <re2/re2.h>
 
 #include "folly/experimental/EventCount.h"
@@ -783,6 +784,64 @@ TEST_F(AggregationTest, hashmodes) {
 #endif
 }
 
+TEST_F(AggregationTest, columnarAccumulators) {
+  // A small range of keys puts the hash table in kArray mode, where sum, count,
+  // min and max add raw input through dense arrays indexed by group. Covers
+  // nulls, constant and dictionary inputs, a group with only null values and
+  // a masked aggregate, which adds input to the group rows directly.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 17; }),
+        makeFlatVector<int64_t>(
+            1'000, [i](auto row) { return i * 1'000 + row; }, nullEvery(7)),
+        makeFlatVector<double>(
+            1'000, [](auto row) { return row * 0.1; }, nullEvery(11)),
+        makeConstant<int32_t>(i, 1'000),
+        wrapInDictionary(
+            makeIndicesInReverse(1'000),
+            makeFlatVector<int16_t>(
+                1'000, [](auto row) { return row % 100; }, nullEvery(5))),
+        makeFlatVector<int64_t>(
+            1'000,
+            [](auto row) { return row; },
+            [](auto row) { return row % 17 == 16; }),
+        makeFlatVector<bool>(1'000, [](auto row) { return row % 3 == 0; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::string> aggregates = {
+      "sum(c1)",
+      "count(c1)",
+      "count(1)",
+      "min(c1)",
+      "max(c1)",
+      "sum(c2)",
+      "min(c2)",
+      "max(c2)",
+      "sum(c3)",
+      "count(c3)",
+      "sum(c4)",
+      "min(c4)",
+      "max(c4)",
+      "sum(c5)",
+      "max(c5)",
+      "sum(c1)"};
+  std::vector<std::string> masks(aggregates.size());
+  masks.back() = "c6";
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c0"}, aggregates, masks)
+                  .planNode();
+  assertQuery(
+      plan,
+      "SELECT c0, sum(c1), count(c1), count(1), min(c1), max(c1), "
+      "sum(c2), min(c2), max(c2), sum(c3), count(c3), "
+      "sum(c4), min(c4), max(c4), sum(c5), max(c5), "
+      "sum(CASE WHEN c6 THEN c1 END) FROM tmp GROUP BY c0");
+}
+
 TEST_F(AggregationTest, rangeToDistinct) {
   rng_.seed(1);
   auto rowType =
@@ -962,6 +1021,131 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationCardinalityEstimate) {
+  const auto makeVectors = [&](int32_t numDistinct) {
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < 10; ++i) {
+      vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+          1'000, [&](auto row) { return (i * 1'000 + row) % numDistinct; })}));
+    }
+    return vectors;
+  };
+  const auto runQuery = [&](const std::vector<RowVectorPtr>& vectors,
+                            int32_t sampleRows) {
+    core::PlanNodeId aggNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(
+                QueryConfig::kPartialAggregationCardinalitySampleRows,
+                sampleRows)
+            .maxDrivers(1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"sum(c0)"})
+                      .capturePlanNodeId(aggNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults("SELECT c0, sum(c0) FROM tmp GROUP BY c0");
+    return toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+  };
+
+  // Unique keys abandon the partial aggregation on the first batch, before
+  // anything is added to the hash table.
+  auto vectors = makeVectors(1'000'000);
+  createDuckDbTable(vectors);
+  auto stats = runQuery(vectors, 1'000);
+  ASSERT_EQ(stats.at("abandonedPartialAggregation").sum, 1);
+  ASSERT_EQ(stats.count("flushRowCount"), 0);
+  ASSERT_NEAR(stats.at("estimatedNumGroups").sum, 1'000, 50);
+
+  // If the sample spans batches, the batches added to the hash table are
+  // flushed before the partial aggregation is abandoned.
+  stats = runQuery(vectors, 2'500);
+  ASSERT_EQ(stats.at("abandonedPartialAggregation").sum, 1);
+  ASSERT_EQ(stats.at("flushTimes").sum, 1);
+  ASSERT_NEAR(stats.at("estimatedNumGroups").sum, 2'500, 125);
+
+  // Low cardinality keys keep the partial aggregation.
+  vectors = makeVectors(100);
+  createDuckDbTable(vectors);
+  stats = runQuery(vectors, 2'500);
+  ASSERT_EQ(stats.count("abandonedPartialAggregation"), 0);
+  ASSERT_NEAR(stats.at("estimatedNumGroups").sum, 100, 10);
+
+  // No estimate is made unless enabled.
+  stats = runQuery(vectors, 0);
+  ASSERT_EQ(stats.count("estimatedNumGroups"), 0);
+}
+
+TEST_F(AggregationTest, partialAggregationClusteredInput) {
+  // 'c0' either comes in runs of 7 rows or cycles through 100 values. 'c1'
+  // depends on 'c0' only.
+  const auto makeVectors = [&](bool clustered) {
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < 10; ++i) {
+      const auto key = [&](auto row) {
+        const auto n = i * 1'000 + row;
+        return clustered ? n / 7 : n % 100;
+      };
+      vectors.push_back(makeRowVector({
+          makeFlatVector<int64_t>(1'000, key),
+          makeFlatVector<int32_t>(
+              1'000, [&](auto row) { return key(row) % 3; }),
+          makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+      }));
+    }
+    return vectors;
+  };
+  const auto runQuery = [&](const std::vector<RowVectorPtr>& vectors,
+                            int32_t checkBatches) {
+    core::PlanNodeId aggNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(
+                QueryConfig::kPartialAggregationClusteredInputCheckBatches,
+                checkBatches)
+            .maxDrivers(1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0", "c1"}, {"sum(c2)", "max(c2)"})
+                      .capturePlanNodeId(aggNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults(
+                "SELECT c0, c1, sum(c2), max(c2) FROM tmp GROUP BY 1, 2");
+    return toPlanStats(task->taskStats()).at(aggNodeId);
+  };
+
+  auto vectors = makeVectors(true);
+  createDuckDbTable(vectors);
+  const auto streamingStats = runQuery(vectors, 2);
+  ASSERT_EQ(streamingStats.customStats.at("streamingOnGroupingKeys").sum, 1);
+
+  // No switch unless enabled. All groups are then held until the end of the
+  // input instead of being flushed with every input after the switch.
+  const auto hashStats = runQuery(vectors, 0);
+  ASSERT_EQ(hashStats.customStats.count("streamingOnGroupingKeys"), 0);
+  ASSERT_GE(streamingStats.outputVectors, 9);
+  ASSERT_GT(streamingStats.outputVectors, hashStats.outputVectors);
+
+  // Input with groups spread over many runs is not clustered.
+  vectors = makeVectors(false);
+  createDuckDbTable(vectors);
+  const auto stats = runQuery(vectors, 2);
+  ASSERT_EQ(stats.customStats.count("streamingOnGroupingKeys"), 0);
+
+  // A, B, A with new A and B has one run more than new groups, but the first
+  // run does not continue a group of an earlier input.
+  vectors = {makeRowVector({
+      makeFlatVector<int64_t>({1, 1, 2, 2, 1, 1}),
+      makeFlatVector<int32_t>({1, 1, 2, 2, 1, 1}),
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6}),
+  })};
+  createDuckDbTable(vectors);
+  const auto abaStats = runQuery(vectors, 1);
+  ASSERT_EQ(abaStats.customStats.count("streamingOnGroupingKeys"), 0);
+}
+
 TEST_F(AggregationTest, distinctWithGroupingKeysReordered) {
   rowType_ =
       ROW({"c0", "c1", "c2", "c3", "c4"},
@@ -1220,6 +1404,42 @@ TEST_F(AggregationTest, spillAll) {
   }
 }
 
+TEST_F(AggregationTest, spillPartitionPrefetch) {
+  auto inputs = makeVectors(rowType_, 100, 10);
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .singleAggregation({"c0"}, {"sum(c1)", "array_agg(c2)"})
+                  .planNode();
+  auto results = AssertQueryBuilder(plan).copyResults(pool_.get());
+
+  // Opens the spill files of the next partition on the spill executor while
+  // the current one is merged. The results must match the serial restore.
+  auto spillExecutor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  for (bool withSpillExecutor : {false, true}) {
+    SCOPED_TRACE(fmt::format("withSpillExecutor {}", withSpillExecutor));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    auto queryCtx = core::QueryCtx::create(
+        executor_.get(),
+        QueryConfig{{}},
+        {},
+        cache::AsyncDataCache::getInstance(),
+        nullptr,
+        withSpillExecutor ? spillExecutor.get() : nullptr);
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task = AssertQueryBuilder(plan)
+                    .queryCtx(queryCtx)
+                    .spillDirectory(tempDirectory->getPath())
+                    .config(QueryConfig::kSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillEnabled, true)
+                    .config(QueryConfig::kSpillNumPartitionBits, "3")
+                    .assertResults(results);
+
+    auto stats = task->taskStats().pipelineStats;
+    ASSERT_EQ(stats[0].operatorStats[1].spilledPartitions, 8);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
 // Verify number of memory allocations in the HashAggregation operator.
 TEST_F(AggregationTest, memoryAllocations) {
   vector_size_t size = 1'024;
@@ -1960,6 +2180,102 @@ TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, twoLevelDistinct) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+
+  auto plan = [&](const std::vector<std::string>& aggregates,
+                  core::PlanNodeId& aggrNodeId) {
+    return PlanBuilder()
+        .values(vectors)
+        .singleAggregation({"c1"}, aggregates, {})
+        .capturePlanNodeId(aggrNodeId)
+        .planNode();
+  };
+
+  // Aggregations that are not all distinct over the same inputs keep the
+  // per-group distinct sets.
+  core::PlanNodeId aggrNodeId;
+  auto mixed = plan({"count(DISTINCT c0)", "sum(c0)"}, aggrNodeId);
+  ASSERT_FALSE(std::dynamic_pointer_cast<const core::AggregationNode>(mixed)
+                   ->supportsTwoLevelDistinct());
+
+  const std::vector<std::string> aggregates{
+      "count(DISTINCT c0)", "sum(DISTINCT c0)", "max(DISTINCT c0)"};
+  const std::string sql =
+      "SELECT c1, count(DISTINCT c0), sum(DISTINCT c0), max(DISTINCT c0) "
+      "FROM tmp GROUP BY c1";
+
+  AssertQueryBuilder(plan(aggregates, aggrNodeId), duckDbQueryRunner_)
+      .config(QueryConfig::kTwoLevelDistinctAggregationEnabled, true)
+      .assertResults(sql);
+
+  for (const auto spillPct : {0, 100}) {
+    SCOPED_TRACE(fmt::format("spillPct: {}", spillPct));
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(spillPct);
+    auto task =
+        AssertQueryBuilder(plan(aggregates, aggrNodeId), duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(QueryConfig::kSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillEnabled, true)
+            .config(QueryConfig::kTwoLevelDistinctAggregationEnabled, true)
+            .assertResults(sql);
+    const auto& stats = toPlanStats(task->taskStats()).at(aggrNodeId);
+    if (spillPct == 0) {
+      ASSERT_EQ(stats.spilledBytes, 0);
+    } else {
+      ASSERT_GT(stats.spilledBytes, 0);
+    }
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
+TEST_F(AggregationTest, twoLevelDistinctSpill) {
+  // 'c1' takes all of its 13 values in each of the 7 groups on 'c0', and each
+  // (c0, c1) pair repeats in many batches.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            100, [&](auto row) { return (i * 100 + row) % 7; }),
+        makeFlatVector<int64_t>(
+            100, [&](auto row) { return (i * 100 + row) % 13; }),
+    }));
+  }
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>({0, 1, 2, 3, 4, 5, 6}),
+      makeConstant<int64_t>(13, 7),
+      makeConstant<int64_t>(78, 7),
+  });
+
+  core::PlanNodeId aggrNodeId;
+  const auto plan =
+      PlanBuilder()
+          .values(vectors)
+          .singleAggregation(
+              {"c0"}, {"count(DISTINCT c1)", "sum(DISTINCT c1)"}, {})
+          .capturePlanNodeId(aggrNodeId)
+          .planNode();
+  ASSERT_TRUE(std::dynamic_pointer_cast<const core::AggregationNode>(plan)
+                  ->supportsTwoLevelDistinct());
+
+  // Rows that are new before the de-duplicating grouping set spills are
+  // aggregated right away. They must not be aggregated again when the
+  // spilled unique rows are read back.
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task =
+      AssertQueryBuilder(plan)
+          .spillDirectory(spillDirectory->getPath())
+          .config(QueryConfig::kSpillEnabled, true)
+          .config(QueryConfig::kAggregationSpillEnabled, true)
+          .config(QueryConfig::kTwoLevelDistinctAggregationEnabled, true)
+          .assertResults(expected);
+  ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 TEST_F(AggregationTest, spillingForAggrsWithSorting) {
   auto vectors = makeVectors(rowType_, 100, 10);
   createDuckDbTable(vectors);
@@ -19,6 +19,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
@@ -232,3 +233,52 @@ TEST_F(ArrowStreamTest, error) {
       AssertQueryBuilder(plan).copyResults(pool_.get()),
       "Failed to call get_schema on ArrowStream: get_schema failed.");
 }
+
+TEST_F(ArrowStreamTest, multipleStreams) {
+  const vector_size_t size = 1'000;
+  const int32_t numStreams = 5;
+  std::vector<std::vector<RowVectorPtr>> streamVectors(numStreams);
+  std::vector<RowVectorPtr> allVectors;
+  for (int32_t stream = 0; stream < numStreams; ++stream) {
+    for (int32_t i = 0; i < 3; ++i) {
+      const auto start = (stream * 3 + i) * size;
+      streamVectors[stream].push_back(makeRowVector(
+          {makeFlatVector<int64_t>(
+               size, [&](auto row) { return start + row; }, nullEvery(7)),
+           makeFlatVector<std::string>(size, [](auto row) {
+             return fmt::format("a string longer than inline {}", row % 17);
+           })}));
+      allVectors.push_back(streamVectors[stream].back());
+    }
+  }
+  createDuckDbTable(allVectors);
+
+  auto type = asRowType(allVectors[0]->type());
+  std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams;
+  for (const auto& vectors : streamVectors) {
+    auto arrowStream = std::make_shared<ArrowArrayStream>();
+    exportArrowStream(
+        std::make_shared<ArrowReader>(pool_, vectors, type),
+        arrowStream.get());
+    arrowStreams.push_back(std::move(arrowStream));
+  }
+  core::PlanNodeId arrowStreamId;
+  auto plan = PlanBuilder()
+                  .addNode([&](const auto& id, const auto& /*source*/) {
+                    return std::make_shared<core::ArrowStreamNode>(
+                        id, type, arrowStreams);
+                  })
+                  .capturePlanNodeId(arrowStreamId)
+                  .planNode();
+
+  // Fewer drivers than streams. The first driver reads two streams.
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .maxDrivers(3)
+                  .assertResults("SELECT * FROM tmp");
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(planStats.at(arrowStreamId).numDrivers, 3);
+  ASSERT_EQ(planStats.at(arrowStreamId).outputRows, numStreams * 3 * size);
+  for (const auto& arrowStream : arrowStreams) {
+    ASSERT_EQ(arrowStream->release, nullptr);
+  }
+}
@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/DriverExecutor.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+class DriverExecutorTest : public test::OperatorTestBase {};
+
+TEST_F(DriverExecutorTest, runsAll) {
+  std::atomic_int32_t numRuns{0};
+  {
+    DriverExecutor executor(4);
+    for (auto i = 0; i < 1'000; ++i) {
+      executor.add([&]() {
+        ++numRuns;
+        // Funcs added from a worker run before the executor is destroyed.
+        executor.add(
+            [&]() { ++numRuns; },
+            DriverExecutor::kNoWorker,
+            /*lifo=*/true);
+      });
+    }
+  }
+  ASSERT_EQ(numRuns, 2'000);
+}
+
+TEST_F(DriverExecutorTest, lifo) {
+  std::vector<int32_t> order;
+  folly::Baton<> done;
+  DriverExecutor executor(1);
+  executor.add([&]() {
+    ASSERT_EQ(executor.currentWorker(), 0);
+    executor.add([&]() { order.push_back(1); }, 0, /*lifo=*/false);
+    executor.add([&]() { order.push_back(2); }, 0, /*lifo=*/true);
+    // Displaces the func in the LIFO slot to the back of the queue.
+    executor.add([&]() { order.push_back(3); }, 0, /*lifo=*/true);
+    executor.add([&]() { done.post(); }, 0, /*lifo=*/false);
+  });
+  done.wait();
+  ASSERT_EQ(order, std::vector<int32_t>({3, 1, 2}));
+  ASSERT_EQ(executor.currentWorker(), DriverExecutor::kNoWorker);
+}
+
+TEST_F(DriverExecutorTest, maxLifoRuns) {
+  // Funcs resuming each other through the LIFO slot do not starve the queue.
+  std::vector<int32_t> order;
+  folly::Baton<> done;
+  std::function<void(int32_t)> resume;
+  // Destroyed first, so that the funcs still queued run before the state
+  // they capture is destroyed.
+  DriverExecutor executor(1);
+  resume = [&](int32_t n) {
+    order.push_back(n);
+    if (n < 2 * DriverExecutor::kMaxLifoRuns) {
+      executor.add([&, n]() { resume(n + 1); }, 0, /*lifo=*/true);
+    }
+  };
+  executor.add([&]() {
+    executor.add([&]() { order.push_back(-1); }, 0, /*lifo=*/false);
+    executor.add([&]() { resume(0); }, 0, /*lifo=*/true);
+    executor.add([&]() { done.post(); }, 0, /*lifo=*/false);
+  });
+  done.wait();
+  const auto queued = std::find(order.begin(), order.end(), -1);
+  ASSERT_NE(queued, order.end());
+  ASSERT_EQ(queued - order.begin(), DriverExecutor::kMaxLifoRuns);
+}
+
+TEST_F(DriverExecutorTest, steal) {
+  folly::Baton<> blocked;
+  folly::Baton<> unblock;
+  std::atomic_int32_t numRuns{0};
+  folly::Baton<> done;
+  DriverExecutor executor(2);
+  executor.add(
+      [&]() {
+        blocked.post();
+        unblock.wait();
+      },
+      0,
+      /*lifo=*/false);
+  blocked.wait();
+
+  // The funcs added to the blocked worker run on the other worker.
+  for (auto i = 0; i < 10; ++i) {
+    executor.add(
+        [&]() {
+          EXPECT_EQ(executor.currentWorker(), 1);
+          if (++numRuns == 10) {
+            done.post();
+          }
+        },
+        0,
+        /*lifo=*/false);
+  }
+  done.wait();
+  unblock.post();
+  ASSERT_GT(executor.stats().numStolenRuns, 0);
+}
+
+TEST_F(DriverExecutorTest, priorityClassName) {
+  for (auto priorityClass :
+       {DriverPriorityClass::kBatch,
+        DriverPriorityClass::kDefault,
+        DriverPriorityClass::kInteractive}) {
+    ASSERT_EQ(
+        driverPriorityClassFromName(
+            std::string(driverPriorityClassName(priorityClass))),
+        priorityClass);
+  }
+  VELOX_ASSERT_THROW(
+      driverPriorityClassFromName("urgent"),
+      "Unknown driver priority class: urgent");
+}
+
+TEST_F(DriverExecutorTest, weightedShare) {
+  // Queues as many batch as interactive funcs on one worker while it is
+  // blocked. The interactive class gets 16 times the time of the batch class.
+  constexpr int32_t kNumFuncs = 100;
+  folly::Baton<> blocked;
+  folly::Baton<> unblock;
+  folly::Baton<> done;
+  std::mutex mutex;
+  std::vector<DriverPriorityClass> order;
+  DriverExecutor executor(1);
+  executor.add(
+      [&]() {
+        blocked.post();
+        unblock.wait();
+      },
+      0,
+      /*lifo=*/false);
+  blocked.wait();
+  ASSERT_FALSE(executor.hasQueuedHigherPriority(DriverPriorityClass::kBatch));
+
+  auto makeFunc = [&](DriverPriorityClass priorityClass) {
+    return [&, priorityClass]() {
+      const auto start = std::chrono::steady_clock::now();
+      while (std::chrono::steady_clock::now() - start <
+             std::chrono::microseconds(100)) {
+      }
+      std::lock_guard<std::mutex> l(mutex);
+      order.push_back(priorityClass);
+      if (order.size() == 2 * kNumFuncs) {
+        done.post();
+      }
+    };
+  };
+  for (auto i = 0; i < kNumFuncs; ++i) {
+    executor.add(
+        makeFunc(DriverPriorityClass::kBatch),
+        0,
+        /*lifo=*/false,
+        DriverPriorityClass::kBatch);
+    executor.add(
+        makeFunc(DriverPriorityClass::kInteractive),
+        0,
+        /*lifo=*/false,
+        DriverPriorityClass::kInteractive);
+  }
+  ASSERT_TRUE(executor.hasQueuedHigherPriority(DriverPriorityClass::kBatch));
+  ASSERT_TRUE(executor.hasQueuedHigherPriority(DriverPriorityClass::kDefault));
+  ASSERT_FALSE(
+      executor.hasQueuedHigherPriority(DriverPriorityClass::kInteractive));
+  unblock.post();
+  done.wait();
+
+  // Batch funcs still run while interactive funcs are queued, but less often.
+  const auto numBatch = std::count(
+      order.begin(), order.begin() + 34, DriverPriorityClass::kBatch);
+  ASSERT_GE(numBatch, 1);
+  ASSERT_LE(numBatch, 6);
+  ASSERT_FALSE(executor.hasQueuedHigherPriority(DriverPriorityClass::kBatch));
+}
+
+TEST_F(DriverExecutorTest, numaNodes) {
+  // Worker threads fail to pin to nodes the host does not have, but funcs
+  // still run only on the workers of their node.
+  std::atomic_int32_t numRuns{0};
+  folly::Baton<> done;
+  DriverExecutor executor(4, "DriverExecutor", 2);
+  ASSERT_EQ(executor.numNumaNodes(), 2);
+  for (auto worker = 0; worker < 4; ++worker) {
+    ASSERT_EQ(executor.numaNode(worker), worker / 2);
+  }
+  ASSERT_EQ(executor.numWorkers(0), 2);
+  ASSERT_EQ(executor.numWorkers(1), 2);
+  VELOX_ASSERT_THROW(DriverExecutor(1, "DriverExecutor", 2), "");
+
+  for (auto i = 0; i < 100; ++i) {
+    // The hint to a worker on another node is ignored.
+    executor.add(
+        [&]() {
+          EXPECT_EQ(executor.numaNode(executor.currentWorker()), 1);
+          if (++numRuns == 100) {
+            done.post();
+          }
+        },
+        0,
+        /*lifo=*/false,
+        DriverPriorityClass::kDefault,
+        1);
+  }
+  done.wait();
+}
+
+TEST_F(DriverExecutorTest, numaNodeSteal) {
+  folly::Baton<> blocked[2];
+  folly::Baton<> unblock;
+  std::atomic_int32_t numNodeRuns{0};
+  std::atomic_int32_t numRuns{0};
+  folly::Baton<> done;
+  // Destroyed first, so that the funcs still queued run before the state
+  // they capture is destroyed.
+  DriverExecutor executor(4, "DriverExecutor", 2);
+  // Blocks both workers of node 1.
+  for (auto i = 0; i < 2; ++i) {
+    executor.add(
+        [&, i]() {
+          blocked[i].post();
+          unblock.wait();
+        },
+        2 + i,
+        /*lifo=*/false,
+        DriverPriorityClass::kDefault,
+        1);
+  }
+  blocked[0].wait();
+  blocked[1].wait();
+
+  // The funcs of node 1 are not stolen by the idle workers of node 0 while
+  // the workers of node 1 are busy. The funcs without a node are.
+  for (auto i = 0; i < 10; ++i) {
+    executor.add(
+        [&]() {
+          EXPECT_EQ(executor.numaNode(executor.currentWorker()), 1);
+          ++numNodeRuns;
+        },
+        2,
+        /*lifo=*/false,
+        DriverPriorityClass::kDefault,
+        1);
+    executor.add(
+        [&]() {
+          if (++numRuns == 10) {
+            done.post();
+          }
+        },
+        2,
+        /*lifo=*/false);
+  }
+  done.wait();
+  ASSERT_EQ(numNodeRuns, 0);
+  unblock.post();
+}
+
+TEST_F(DriverExecutorTest, query) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  auto plan = test::PlanBuilder()
+                  .values({data}, true)
+                  .localPartition({"c0"})
+                  .singleAggregation({"c0"}, {"count(1)"})
+                  .planNode();
+
+  auto executor = std::make_unique<DriverExecutor>(4);
+  auto queryCtx = core::QueryCtx::create(executor.get());
+  test::AssertQueryBuilder(plan)
+      .queryCtx(queryCtx)
+      .maxDrivers(4)
+      .assertResults(makeRowVector({
+          makeFlatVector<int64_t>(10, [](auto row) { return row; }),
+          makeConstant<int64_t>(400, 10),
+      }));
+  test::waitForAllTasksToBeDeleted();
+  const auto stats = executor->stats();
+  ASSERT_GT(stats.numLifoRuns + stats.numLocalRuns + stats.numStolenRuns, 0);
+}
+
+} // namespace
+} // namespace facebook::velox::exec
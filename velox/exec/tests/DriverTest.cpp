@@ -1056,6 +1056,82 @@ class BlockedNoFutureNodeFactory : public Operator::PlanNodeTranslator {
     return 1;
   }
 };
+
+class ReadyFutureNode : public core::PlanNode {
+ public:
+  ReadyFutureNode(const core::PlanNodeId& id, const core::PlanNodePtr& input)
+      : PlanNode(id), sources_{input} {}
+
+  const RowTypePtr& outputType() const override {
+    return sources_[0]->outputType();
+  }
+
+  const std::vector<std::shared_ptr<const PlanNode>>& sources() const override {
+    return sources_;
+  }
+
+  std::string_view name() const override {
+    return "ReadyFuture";
+  }
+
+ private:
+  void addDetails(std::stringstream& /* stream */) const override {}
+  std::vector<core::PlanNodePtr> sources_;
+};
+
+// Reports being blocked on a realized future after each input, like an
+// operator whose I/O completed before it was checked.
+class ReadyFutureOperator : public Operator {
+ public:
+  ReadyFutureOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const std::shared_ptr<const ReadyFutureNode>& node)
+      : Operator(ctx, node->outputType(), id, node->id(), "ReadyFuture") {}
+
+  bool needsInput() const override {
+    return !noMoreInput_ && !input_;
+  }
+
+  void addInput(RowVectorPtr input) override {
+    input_ = std::move(input);
+    blocked_ = true;
+  }
+
+  RowVectorPtr getOutput() override {
+    return std::move(input_);
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr;
+  }
+
+  BlockingReason isBlocked(ContinueFuture* future) override {
+    if (!blocked_) {
+      return BlockingReason::kNotBlocked;
+    }
+    blocked_ = false;
+    *future = folly::makeSemiFuture();
+    return BlockingReason::kWaitForConnector;
+  }
+
+ private:
+  bool blocked_{false};
+};
+
+class ReadyFutureNodeFactory : public Operator::PlanNodeTranslator {
+ public:
+  std::unique_ptr<Operator> toOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const core::PlanNodePtr& node) override {
+    if (auto readyFutureNode =
+            std::dynamic_pointer_cast<const ReadyFutureNode>(node)) {
+      return std::make_unique<ReadyFutureOperator>(ctx, id, readyFutureNode);
+    }
+    return nullptr;
+  }
+};
 } // namespace
 
 // Use a node for which driver factory would throw on any driver beyond id 0.
@@ -1084,6 +1160,47 @@ TEST_F(DriverTest, driverCreationThrow) {
   EXPECT_EQ(TaskState::kFailed, task->state());
 }
 
+TEST_F(DriverTest, asyncCursor) {
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [i](auto row) { return i * 1'000 + row; })}));
+  }
+
+  for (const bool serialExecution : {false, true}) {
+    SCOPED_TRACE(fmt::format("serialExecution: {}", serialExecution));
+    CursorParameters params;
+    params.planNode = PlanBuilder().values(batches).planNode();
+    params.serialExecution = serialExecution;
+    params.copyResult = false;
+    // Less than a batch, so that the producer blocks after each batch.
+    params.bufferedBytes = 100;
+    auto cursor = TaskCursor::create(params);
+
+    std::vector<RowVectorPtr> results;
+    for (;;) {
+      ContinueFuture future = ContinueFuture::makeEmpty();
+      auto result = cursor->next(&future);
+      if (result != nullptr) {
+        ASSERT_EQ(result, cursor->current());
+        results.push_back(std::move(result));
+        continue;
+      }
+      if (!future.valid()) {
+        break;
+      }
+      std::move(future).wait();
+    }
+
+    // The batches are handed over without a copy.
+    ASSERT_EQ(results.size(), batches.size());
+    for (auto i = 0; i < batches.size(); ++i) {
+      ASSERT_EQ(results[i].get(), batches[i].get());
+    }
+    results.clear();
+  }
+}
+
 TEST_F(DriverTest, blockedNoFuture) {
   Operator::registerOperator(std::make_unique<BlockedNoFutureNodeFactory>());
 
@@ -1102,6 +1219,35 @@ TEST_F(DriverTest, blockedNoFuture) {
       "The operator BlockedNoFuture is blocked but blocking future is not valid");
 }
 
+TEST_F(DriverTest, resumeOnThreadOnReadyFuture) {
+  Operator::registerOperator(std::make_unique<ReadyFutureNodeFactory>());
+
+  const int32_t numBatches = 10;
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < numBatches; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}));
+  }
+  core::PlanNodeId readyFutureId;
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .addNode([](const core::PlanNodeId& id,
+                              const core::PlanNodePtr& input) {
+                    return std::make_shared<ReadyFutureNode>(id, input);
+                  })
+                  .capturePlanNodeId(readyFutureId)
+                  .planNode();
+  std::shared_ptr<Task> task;
+  auto result = AssertQueryBuilder(plan).copyResults(pool(), task);
+  ASSERT_EQ(result->size(), numBatches * 3);
+
+  // The Driver continued on thread after each realized future, up to
+  // kMaxOnThreadResumes per run, without being blocked.
+  static_assert(numBatches <= Driver::kMaxOnThreadResumes);
+  auto stats = toPlanStats(task->taskStats()).at(readyFutureId);
+  ASSERT_EQ(stats.customStats.at(Driver::kOnThreadResumes).sum, numBatches);
+  ASSERT_EQ(stats.blockedWallNanos, 0);
+}
+
 TEST_F(DriverTest, nonVeloxOperatorException) {
   Operator::registerOperator(
       std::make_unique<ThrowNodeFactory>(std::numeric_limits<uint32_t>::max()));
@@ -18,8 +18,10 @@
 #include <atomic>
 #include <thread>
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
+#include "velox/exec/UcxExchange.h"
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/QueryAssertions.h"
@@ -227,6 +229,52 @@ TEST_P(ExchangeClientTest, stats) {
   ASSERT_GE(totalBytes, stats.at("peakBytes").sum);
   ASSERT_EQ(data.size(), stats.at("numReceivedPages").sum);
   ASSERT_EQ(totalBytes / data.size(), stats.at("averageReceivedPageBytes").sum);
+  ASSERT_EQ(1, stats.at("sourceResponseWallNanos").count);
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+
+  client->close();
+}
+
+TEST_P(ExchangeClientTest, networkModel) {
+  test::LocalExchangeNetworkModel model;
+  model.latency = std::chrono::milliseconds(200);
+  model.bytesPerSecond = 1 << 20;
+  ASSERT_EQ(model.delay(0), std::chrono::milliseconds(200));
+  ASSERT_EQ(model.delay(1 << 19), std::chrono::milliseconds(700));
+  ASSERT_EQ(
+      test::LocalExchangeNetworkModel{}.delay(1 << 30),
+      std::chrono::microseconds(0));
+
+  test::testingSetLocalExchangeNetworkModel(model);
+  SCOPE_EXIT {
+    test::testingSetLocalExchangeNetworkModel({});
+  };
+
+  auto taskId = "local://t1";
+  auto task = makeTask(taskId);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+
+  auto client = std::make_shared<ExchangeClient>(
+      "t",
+      17,
+      ExchangeClient::kDefaultMaxQueuedBytes,
+      1,
+      kDefaultMinExchangeOutputBatchBytes,
+      pool(),
+      executor());
+  const auto startUs = getCurrentTimeMicro();
+  client->addRemoteTaskId(taskId);
+  const auto pageSize =
+      enqueue(taskId, 17, makeRowVector({makeFlatVector<int32_t>({1, 2})}));
+
+  const auto pages = fetchPages(1, *client, 1);
+  ASSERT_EQ(pages[0]->size(), pageSize);
+  ASSERT_GE(
+      getCurrentTimeMicro() - startUs,
+      static_cast<uint64_t>(model.delay(pageSize).count()));
 
   task->requestCancel();
   bufferManager_->removeTask(taskId);
@@ -287,6 +335,58 @@ TEST_P(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+TEST_P(ExchangeClientTest, requestShares) {
+  ASSERT_TRUE(ExchangeClient::requestShares(1'000, {}).empty());
+  ASSERT_EQ(
+      std::vector<int64_t>({1'000}), ExchangeClient::requestShares(1'000, {5}));
+  ASSERT_EQ(
+      std::vector<int64_t>({500, 500}),
+      ExchangeClient::requestShares(1'000, {2, 2}));
+  // A source 3x as fast as the other gets 3x the space.
+  ASSERT_EQ(
+      std::vector<int64_t>({750, 250}),
+      ExchangeClient::requestShares(1'000, {300, 100}));
+  VELOX_ASSERT_THROW(ExchangeClient::requestShares(1'000, {1, 0}), "");
+}
+
+TEST_P(ExchangeClientTest, requestOrder) {
+  ASSERT_TRUE(ExchangeClient::requestOrder({}, {}).empty());
+  // Fastest first, ties in arrival order.
+  ASSERT_EQ(
+      std::vector<int32_t>({1, 2, 0, 3}),
+      ExchangeClient::requestOrder({1, 5, 3, 1}, {0, 0, 0, 0}));
+  // The slowest source has been skipped, so it goes first and the rest stay
+  // fastest first.
+  ASSERT_EQ(
+      std::vector<int32_t>({3, 1, 2, 0}),
+      ExchangeClient::requestOrder({2, 5, 3, 1}, {0, 0, 0, 1}));
+  // Of the skipped sources, the one skipped the most goes first.
+  ASSERT_EQ(
+      std::vector<int32_t>({0, 1, 2, 3}),
+      ExchangeClient::requestOrder({1, 5, 3, 2}, {4, 0, 1, 1}));
+
+  // Simulate rounds where only the first source in order gets a request. A
+  // slow source keeps being passed over by faster ones until it has waited
+  // the longest.
+  const std::vector<double> throughputs = {100, 50, 10, 1};
+  std::vector<int32_t> numSkipped(throughputs.size(), 0);
+  std::vector<int32_t> numRequests(throughputs.size(), 0);
+  for (int round = 0; round < 100; ++round) {
+    const auto order = ExchangeClient::requestOrder(throughputs, numSkipped);
+    ++numRequests[order[0]];
+    numSkipped[order[0]] = 0;
+    for (size_t i = 1; i < order.size(); ++i) {
+      ++numSkipped[order[i]];
+    }
+    for (auto skipped : numSkipped) {
+      ASSERT_LT(skipped, static_cast<int32_t>(throughputs.size()));
+    }
+  }
+  for (auto requests : numRequests) {
+    ASSERT_GT(requests, 0);
+  }
+}
+
 TEST_P(ExchangeClientTest, largeSinglePage) {
   auto data = {
       makeRowVector({makeFlatVector<int64_t>(10000, folly::identity)}),
@@ -319,6 +419,68 @@ TEST_P(ExchangeClientTest, largeSinglePage) {
   client->close();
 }
 
+TEST_P(ExchangeClientTest, ucxExchange) {
+#ifndef VELOX_ENABLE_UCX
+  ASSERT_FALSE(isUcxExchangeEnabled());
+  VELOX_ASSERT_THROW(UcxExchangeServer(0), "Velox is built without UCX");
+  auto queue = std::make_shared<ExchangeQueue>(1, 0);
+  VELOX_ASSERT_THROW(
+      createUcxExchangeSource(
+          "ucx://localhost:1234/producer", 0, queue, pool()),
+      "Velox is built without UCX");
+  ASSERT_EQ(
+      createUcxExchangeSource("local://producer", 0, queue, pool()), nullptr);
+#else
+  ASSERT_TRUE(isUcxExchangeEnabled());
+  UcxExchangeServer server(0);
+  exec::ExchangeSource::registerFactory(createUcxExchangeSource);
+
+  auto data = {
+      makeRowVector({makeFlatVector<int64_t>(10000, folly::identity)}),
+      makeRowVector({makeFlatVector<int64_t>(150, folly::identity)}),
+      makeRowVector({makeFlatVector<int64_t>(3000, folly::identity)}),
+  };
+  auto client = std::make_shared<ExchangeClient>(
+      "test",
+      1,
+      1 << 20,
+      1,
+      kDefaultMinExchangeOutputBatchBytes,
+      pool(),
+      executor());
+  auto task = makeTask("local://ucx-producer");
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 1, 1);
+  std::vector<int32_t> pageSizes;
+  for (auto& batch : data) {
+    pageSizes.push_back(enqueue(task->taskId(), 0, batch));
+  }
+  bufferManager_->noMoreData(task->taskId());
+
+  client->addRemoteTaskId(
+      fmt::format("ucx://127.0.0.1:{}/{}", server.port(), task->taskId()));
+  client->noMoreRemoteTasks();
+  auto pages = fetchPages(1, *client, pageSizes.size());
+  for (auto i = 0; i < pageSizes.size(); ++i) {
+    ASSERT_EQ(pages[i]->size(), pageSizes[i]);
+  }
+
+  bool atEnd = false;
+  ContinueFuture future;
+  pages = client->next(1, 1, &atEnd, &future);
+  while (!atEnd) {
+    ASSERT_TRUE(pages.empty());
+    auto& exec = folly::QueuedImmediateExecutor::instance();
+    std::move(future).via(&exec).wait();
+    pages = client->next(1, 1, &atEnd, &future);
+  }
+  ASSERT_TRUE(pages.empty());
+  task->requestCancel();
+  bufferManager_->removeTask(task->taskId());
+  client->close();
+#endif
+}
+
 TEST_P(ExchangeClientTest, multiPageFetch) {
   auto client = std::make_shared<ExchangeClient>(
       "test",
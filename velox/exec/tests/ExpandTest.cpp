@@ -117,6 +117,38 @@ TEST_F(ExpandTest, rollup) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(ExpandTest, sharedOutputColumns) {
+  // The output of all projections shares the input columns, and the constant
+  // columns are reused for inputs of the same size.
+  auto data = makeRowVectorData(100);
+  auto plan = PlanBuilder()
+                  .values({data, data})
+                  .expand({
+                      {"k1", "k2", "a", "0 as gid"},
+                      {"k1", "null", "a", "1"},
+                      {"null", "null", "a", "2"},
+                  })
+                  .planNode();
+
+  CursorParameters params;
+  params.planNode = plan;
+  auto [cursor, results] = readCursor(params, [](Task*) {});
+  ASSERT_EQ(results.size(), 6);
+  for (const auto& result : results) {
+    ASSERT_EQ(result->childAt(2).get(), data->childAt(2).get());
+  }
+  ASSERT_EQ(results[0]->childAt(0).get(), data->childAt(0).get());
+  ASSERT_EQ(results[1]->childAt(0).get(), data->childAt(0).get());
+  for (auto i = 0; i < 3; ++i) {
+    ASSERT_TRUE(results[i]->childAt(3)->isConstantEncoding());
+    ASSERT_EQ(results[i]->childAt(3).get(), results[i + 3]->childAt(3).get());
+  }
+  ASSERT_TRUE(results[1]->childAt(1)->isConstantEncoding());
+  ASSERT_TRUE(results[1]->childAt(1)->isNullAt(0));
+  ASSERT_EQ(results[1]->childAt(1).get(), results[4]->childAt(1).get());
+  ASSERT_EQ(results[2]->childAt(0).get(), results[5]->childAt(0).get());
+}
+
 TEST_F(ExpandTest, countDistinct) {
   auto data = makeRowVectorData(1'000);
 
@@ -363,3 +363,55 @@ TEST_F(FilterProjectTest, numSilentThrow) {
   auto planStats = toPlanStats(task->taskStats());
   ASSERT_EQ(100, planStats.at(filterId).customStats.at("numSilentThrow").sum);
 }
+
+TEST_F(FilterProjectTest, exprProfiling) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 3; ++i) {
+    // A new dictionary base in each batch to avoid memoized results.
+    auto base = makeFlatVector<int64_t>(100, [&](auto row) { return row + i; });
+    vectors.push_back(makeRowVector({
+        wrapInDictionary(
+            makeIndices(1'000, [](auto row) { return row % 100; }),
+            1'000,
+            base),
+        makeFlatVector<int64_t>(
+            1'000, [](auto row) { return row; }, nullEvery(10)),
+    }));
+  }
+
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0 * 2", "c1 + 1"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kExprProfilingEnabled, true)
+      .copyResults(pool(), task);
+  const auto& stats = toPlanStats(task->taskStats()).at(projectId).customStats;
+
+  // The nodes are numbered in pre-order: multiply(c0, 2) is #1 and
+  // plus(c1, 1) is #4.
+  // c0 is peeled and the function sees a flat and a constant input.
+  ASSERT_EQ(stats.at("expr.1.multiply.batches").sum, 3);
+  ASSERT_EQ(stats.at("expr.1.multiply.rows").sum, 300);
+  ASSERT_EQ(stats.at("expr.1.multiply.peels").sum, 3);
+  ASSERT_EQ(stats.at("expr.1.multiply.flatInputs").sum, 3);
+  ASSERT_EQ(stats.at("expr.1.multiply.constantInputs").sum, 3);
+  ASSERT_EQ(stats.count("expr.1.multiply.dictionaryInputs"), 0);
+  ASSERT_GT(stats.at("expr.1.multiply.cpuNanos").count, 0);
+
+  // The nulls of c1 are skipped.
+  ASSERT_EQ(stats.at("expr.4.plus.rows").sum, 2'700);
+  ASSERT_EQ(stats.at("expr.4.plus.defaultNullSkips").sum, 3);
+  ASSERT_EQ(stats.count("expr.4.plus.peels"), 0);
+
+  // No stats without the config.
+  AssertQueryBuilder(plan).copyResults(pool(), task);
+  for (const auto& [name, _] :
+       toPlanStats(task->taskStats()).at(projectId).customStats) {
+    ASSERT_NE(name.rfind("expr.", 0), 0) << name;
+  }
+}
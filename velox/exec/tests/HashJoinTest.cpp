@@ -24,6 +24,7 @@
 #include "velox/exec/Cursor.h"
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/ArbitratorTestUtil.h"
@@ -3374,6 +3375,248 @@ TEST_F(HashJoinTest, lazyVectors) {
   }
 }
 
+TEST_F(HashJoinTest, hashTableCache) {
+  auto* cache = HashTableCache::create(1LL << 30);
+  SCOPE_EXIT {
+    HashTableCache::testingClear();
+  };
+
+  auto probe = makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(100, [](auto row) { return row * 10; })});
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(50, [](auto row) { return row * 2; }),
+       makeFlatVector<int64_t>(50, [](auto row) { return row; })});
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>(50, [](auto row) { return row * 20; }),
+       makeFlatVector<int64_t>(50, [](auto row) { return row; })});
+
+  auto makePlan = [&](core::JoinType joinType, core::PlanNodeId& joinId) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values({probe})
+        .hashJoin(
+            {"t0"},
+            {"u0"},
+            PlanBuilder(planNodeIdGenerator).values({build}).planNode(),
+            "",
+            {"t1", "u1"},
+            joinType)
+        .capturePlanNodeId(joinId)
+        .planNode();
+  };
+
+  // Returns the number of cache hits of the join.
+  auto run = [&](const std::string& inputsKey) {
+    core::PlanNodeId joinId;
+    std::shared_ptr<Task> task;
+    auto result = AssertQueryBuilder(makePlan(core::JoinType::kInner, joinId))
+                      .config(core::QueryConfig::kHashTableCacheKey, inputsKey)
+                      .copyResults(pool(), task);
+    test::assertEqualVectors(expected, result);
+    const auto& stats = toPlanStats(task->taskStats()).at(joinId).customStats;
+    auto it = stats.find(HashTableCache::kCacheHits);
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  ASSERT_EQ(run("v1"), 0);
+  ASSERT_EQ(cache->stats().numEntries, 1);
+  ASSERT_GT(cache->stats().usedBytes, 0);
+  ASSERT_EQ(run("v1"), 1);
+  ASSERT_EQ(run("v1"), 1);
+  // Another version of the inputs misses.
+  ASSERT_EQ(run("v2"), 0);
+  ASSERT_EQ(cache->stats().numEntries, 2);
+  ASSERT_EQ(cache->stats().numHits, 2);
+
+  // The probe of a right join updates the table, so it is not shared.
+  core::PlanNodeId joinId;
+  auto rightJoin = makePlan(core::JoinType::kRight, joinId);
+  ASSERT_TRUE(hashTableCacheKey(
+                  *std::dynamic_pointer_cast<const core::HashJoinNode>(
+                      rightJoin),
+                  core::QueryConfig({{core::QueryConfig::kHashTableCacheKey,
+                                      "v1"}}))
+                  .empty());
+
+  // Unused tables are evicted.
+  waitForAllTasksToBeDeleted();
+  ASSERT_GT(cache->evict(0), 0);
+  ASSERT_EQ(cache->stats().numEntries, 0);
+  ASSERT_EQ(cache->pool()->usedBytes(), 0);
+}
+
+TEST_F(HashJoinTest, lazyPayloadAcrossChainedJoins) {
+  // A probe payload column that is only output stays lazy through two
+  // chained joins and is loaded only for the rows that match both.
+  const vector_size_t size = 1'000;
+  auto probe = makeRowVector(
+      {"c0", "c1", "c2"},
+      {makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+       makeLazyFlatVector<int64_t>(
+           size,
+           [](auto row) { return row * 2; },
+           [](auto /*row*/) { return false; },
+           size / 20,
+           [](auto i) { return i * 20; })});
+  auto tensBuild = makeRowVector(
+      {"u0"},
+      {makeFlatVector<int64_t>(100, [](auto row) { return row * 10; })});
+  auto twentiesBuild = makeRowVector(
+      {"w0"},
+      {makeFlatVector<int64_t>(50, [](auto row) { return row * 20; })});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe})
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({tensBuild})
+                          .planNode(),
+                      "",
+                      {"c1", "c2"})
+                  .hashJoin(
+                      {"c1"},
+                      {"w0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({twentiesBuild})
+                          .planNode(),
+                      "",
+                      {"c2"})
+                  .planNode();
+
+  auto result = AssertQueryBuilder(plan).copyResults(pool());
+  test::assertEqualVectors(
+      makeRowVector({makeFlatVector<int64_t>(
+          size / 20, [](auto row) { return row * 40; })}),
+      result);
+}
+
+TEST_F(HashJoinTest, semiAndAntiJoinBitmap) {
+  // More distinct build keys than kept for a values filter, over a range that
+  // fits an array mode table. Semi and anti joins without filter probe a bit
+  // per key instead of a row pointer.
+  auto build = makeRowVector(
+      {"u0"}, {makeFlatVector<int64_t>(300'000, [](auto row) {
+        return row * 3;
+      })});
+  auto probe = makeRowVector(
+      {"t0"}, {makeFlatVector<int64_t>(10'000, [](auto row) {
+        return row * 7 % 1'000'000;
+      })});
+  std::vector<int64_t> matches;
+  std::vector<int64_t> misses;
+  for (auto i = 0; i < 10'000; ++i) {
+    const int64_t key = i * 7 % 1'000'000;
+    (key % 3 == 0 && key < 900'000 ? matches : misses).push_back(key);
+  }
+
+  for (auto joinType :
+       {core::JoinType::kLeftSemiFilter, core::JoinType::kAnti}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    core::PlanNodeId joinId;
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values({probe})
+                    .hashJoin(
+                        {"t0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values({build})
+                            .planNode(),
+                        "",
+                        {"t0"},
+                        joinType)
+                    .capturePlanNodeId(joinId)
+                    .planNode();
+    std::shared_ptr<Task> task;
+    auto result = AssertQueryBuilder(plan).copyResults(pool(), task);
+    test::assertEqualVectors(
+        makeRowVector({makeFlatVector<int64_t>(
+            joinType == core::JoinType::kAnti ? misses : matches)}),
+        result);
+    const auto& stats = toPlanStats(task->taskStats()).at(joinId).customStats;
+    ASSERT_EQ(stats.count(BaseHashTable::kJoinBitmap), 1);
+  }
+}
+
+TEST_F(HashJoinTest, adaptiveSwapJoinSides) {
+  // A probe side much smaller than the build side is built into the table
+  // and the build side input is probed with it instead.
+  auto probe = makeRowVector(
+      {"t0", "t1", "t2"},
+      {makeFlatVector<int64_t>(100, [](auto row) { return row % 40; }),
+       makeFlatVector<int32_t>(100, [](auto row) { return row; }),
+       makeNullableFlatVector<int64_t>(
+           100,
+           [](auto row) { return row * 3; },
+           nullEvery(7))});
+  std::vector<RowVectorPtr> build;
+  for (auto i = 0; i < 20; ++i) {
+    build.push_back(makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(
+             1'000, [i](auto row) { return (i * 1'000 + row) % 3'000; }),
+         makeFlatVector<std::string>(1'000, [](auto row) {
+           return fmt::format("{}", row);
+         })}));
+  }
+
+  // Returns the number of drivers that swapped the join sides.
+  auto run = [&](const std::vector<RowVectorPtr>& buildInput,
+                 int32_t numDrivers,
+                 const std::string& maxProbeRows) {
+    core::PlanNodeId joinId;
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values({probe})
+                    .hashJoin(
+                        {"t0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildInput)
+                            .planNode(),
+                        "",
+                        {"u1", "t2", "u0", "t1"},
+                        core::JoinType::kInner)
+                    .capturePlanNodeId(joinId)
+                    .planNode();
+    auto expected =
+        AssertQueryBuilder(plan).maxDrivers(numDrivers).copyResults(pool());
+    std::shared_ptr<Task> task;
+    auto result =
+        AssertQueryBuilder(plan)
+            .maxDrivers(numDrivers)
+            .config(
+                core::QueryConfig::kHashJoinAdaptiveSwapMaxProbeRows,
+                maxProbeRows)
+            .copyResults(pool(), task);
+    EXPECT_GT(result->size(), 0);
+    EXPECT_TRUE(assertEqualResults({expected}, {result}));
+    const auto& stats = toPlanStats(task->taskStats()).at(joinId).customStats;
+    auto it = stats.find("swappedJoinSides");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  for (auto numDrivers : {1, 3}) {
+    SCOPED_TRACE(fmt::format("numDrivers: {}", numDrivers));
+    ASSERT_EQ(run(build, numDrivers, "1000"), numDrivers);
+    // The probe side has more rows than buffered for a swap.
+    ASSERT_EQ(run(build, numDrivers, "10"), 0);
+    // The build side is not large enough relative to the probe side.
+    ASSERT_EQ(
+        run({std::dynamic_pointer_cast<RowVector>(build[0]->slice(0, 500))},
+            numDrivers,
+            "1000"),
+        0);
+  }
+}
+
 TEST_F(HashJoinTest, lazyVectorNotLoadedInFilter) {
   // Ensure that if lazy vectors are temporarily wrapped during a filter's
   // execution and remain unloaded, the temporary wrap is promptly
@@ -4609,6 +4852,106 @@ TEST_F(HashJoinTest, dynamicFiltersPushDownThroughAgg) {
       .run();
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilters) {
+  const int32_t numSplits = 5;
+  const int32_t numRowsProbe = 2'000;
+  // Enough distinct keys over the full bigint range to make a kHash mode
+  // table, for which no exact value list filter is made.
+  const int32_t numRowsBuild = 20'000;
+  const auto buildKey = [](auto row) {
+    return static_cast<int64_t>(row * 0x9E3779B97F4A7C15ULL);
+  };
+
+  // Every other probe row matches a build row.
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({
+        makeFlatVector<int64_t>(
+            numRowsProbe,
+            [&](auto row) {
+              const auto key = buildKey(i * numRowsProbe + row);
+              return row % 2 == 0 ? key : key + 1;
+            }),
+        makeFlatVector<int64_t>(numRowsProbe, folly::identity),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->getPath(), rowVector);
+  }
+  std::vector<RowVectorPtr> buildVectors{makeRowVector(
+      {"u0"}, {makeFlatVector<int64_t>(numRowsBuild, buildKey)})};
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto probeType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide =
+      PlanBuilder(planNodeIdGenerator).values(buildVectors).planNode();
+  core::PlanNodeId scanNodeId;
+  core::PlanNodeId joinNodeId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(probeType)
+                .capturePlanNodeId(scanNodeId)
+                .hashJoin(
+                    {"c0"},
+                    {"u0"},
+                    buildSide,
+                    "",
+                    {"c0", "c1"},
+                    core::JoinType::kInner)
+                .capturePlanNodeId(joinNodeId)
+                .planNode();
+
+  SplitInput splitInput;
+  for (const auto& file : tempFiles) {
+    splitInput[scanNodeId].push_back(
+        Split(makeHiveConnectorSplit(file->getPath())));
+  }
+  const int32_t numProbeRows = numSplits * numRowsProbe;
+  for (const bool bloomFilterEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("bloomFilterEnabled: {}", bloomFilterEnabled));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(op)
+        .inputSplits(splitInput)
+        .injectSpill(false)
+        .checkSpillStats(false)
+        .config(
+            core::QueryConfig::kHashJoinBloomFilterMaxBytes,
+            bloomFilterEnabled ? std::to_string(1 << 20) : "0")
+        .referenceQuery("SELECT c0, c1 FROM t, u WHERE c0 = u0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+          auto planStats = toPlanStats(task->taskStats());
+          const auto& dynamicFilterStats =
+              planStats.at(scanNodeId).dynamicFilterStats;
+          const auto joinInputRows =
+              getInputPositions(task, getOperatorIndex(joinNodeId));
+          if (!bloomFilterEnabled) {
+            ASSERT_EQ(
+                0, getFiltersProduced(task, getOperatorIndex(joinNodeId)).sum);
+            ASSERT_EQ(
+                0, getFiltersAccepted(task, getOperatorIndex(scanNodeId)).sum);
+            ASSERT_TRUE(dynamicFilterStats.empty());
+            ASSERT_EQ(joinInputRows, numProbeRows);
+            return;
+          }
+          ASSERT_EQ(
+              1, getFiltersProduced(task, getOperatorIndex(joinNodeId)).sum);
+          ASSERT_EQ(
+              1, getFiltersAccepted(task, getOperatorIndex(scanNodeId)).sum);
+          ASSERT_EQ(
+              dynamicFilterStats.producerNodeIds,
+              std::unordered_set({joinNodeId}));
+          // The scan drops the non-matching rows but for the few false
+          // positives of the Bloom filter.
+          ASSERT_GE(joinInputRows, numProbeRows / 2);
+          ASSERT_LT(joinInputRows, numProbeRows * 6 / 10);
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, noDynamicFiltersPushDownThroughRightJoin) {
   std::vector<RowVectorPtr> innerBuild = {makeRowVector(
       {"a"},
@@ -138,6 +138,7 @@ class HashTableTest : public testing::TestWithParam<bool>,
       }
       auto table = HashTable<true>::createForJoin(
           std::move(keyHashers), dependentTypes, true, false, 1'000, pool());
+      table->setRadixPartitionTargetBytes(radixPartitionTargetBytes_);
 
       makeRows(size, 1, sequence, buildType, batches);
       copyVectorsToTable(batches, startOffset, table.get());
@@ -164,6 +165,16 @@ class HashTableTest : public testing::TestWithParam<bool>,
         estimatedTableSize,
         topTable_->rows()->pool()->usedBytes() - usedMemoryBytes);
     ASSERT_EQ(topTable_->hashMode(), mode);
+    if (radixPartitionTargetBytes_ > 0 &&
+        mode != BaseHashTable::HashMode::kArray) {
+      ASSERT_GT(topTable_->radixPartitionBits().numBits(), 0);
+      ASSERT_LE(
+          topTable_->capacity() * sizeof(char*) /
+              topTable_->radixPartitionBits().numPartitions(),
+          radixPartitionTargetBytes_);
+    } else {
+      ASSERT_EQ(topTable_->radixPartitionBits().numBits(), 0);
+    }
     ASSERT_EQ(topTable_->allRows().size(), numWays);
     uint64_t rowCount{0};
     for (auto* rowContainer : topTable_->allRows()) {
@@ -588,6 +599,9 @@ class HashTableTest : public testing::TestWithParam<bool>,
   int64_t keySpacing_ = 1;
   // Base string for varchar fields when making string vector.
   std::string baseString_;
+  // Target radix partition size of the join tables. 0 disables radix
+  // partitioning.
+  uint64_t radixPartitionTargetBytes_{0};
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -640,6 +654,29 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, radixPartitionedHash) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  radixPartitionTargetBytes_ = 64 << 10;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 3, type, 6);
+}
+
+TEST_P(HashTableTest, radixPartitionedNormalizedKey) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  radixPartitionTargetBytes_ = 16 << 10;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, radixPartitionedArray) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  radixPartitionTargetBytes_ = 1 << 10;
+  testCycle(BaseHashTable::HashMode::kArray, 500, 2, type, 2);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clearBeforeInsert) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -855,6 +892,41 @@ TEST_P(HashTableTest, regularHashingTableSize) {
   }
 }
 
+TEST_P(HashTableTest, joinKeyBloomFilters) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), VARCHAR()});
+  std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+  for (auto channel = 0; channel < type->size(); ++channel) {
+    keyHashers.emplace_back(
+        std::make_unique<VectorHasher>(type->childAt(channel), channel));
+  }
+  auto table = HashTable<true>::createForJoin(
+      std::move(keyHashers), {}, true, false, 1'000, pool());
+  std::vector<RowVectorPtr> batches;
+  makeRows(10'000, 1, 0, type, batches);
+  copyVectorsToTable(batches, 0, table.get());
+  table->prepareJoinTable(
+      {}, BaseHashTable::kNoSpillInputStartPartitionBit, executor_.get());
+  ASSERT_EQ(table->joinKeyBloomFilter(0), nullptr);
+  ASSERT_FALSE(table->hasJoinKeyBloomFilters());
+
+  // Too small a size limit makes no filters.
+  table->buildJoinKeyBloomFilters(1'000);
+  ASSERT_FALSE(table->hasJoinKeyBloomFilters());
+
+  table->buildJoinKeyBloomFilters(1 << 20);
+  ASSERT_TRUE(table->hasJoinKeyBloomFilters());
+  // Only integral keys get a Bloom filter.
+  ASSERT_EQ(table->joinKeyBloomFilter(1), nullptr);
+  const auto* filter = table->joinKeyBloomFilter(0);
+  ASSERT_NE(filter, nullptr);
+  ASSERT_EQ(filter->kind(), common::FilterKind::kBigintValuesUsingBloomFilter);
+  ASSERT_FALSE(filter->testNull());
+  const auto* keys = batches[0]->childAt(0)->asFlatVector<int64_t>();
+  for (auto i = 0; i < keys->size(); ++i) {
+    ASSERT_TRUE(filter->testInt64(keys->valueAt(i)));
+  }
+}
+
 TEST_P(HashTableTest, listJoinResultsSize) {
   baseString_ =
       "If you count carefully, you will notice there are exactly 105 characters"
@@ -996,6 +1068,163 @@ TEST_P(HashTableTest, checkSizeValidation) {
   ASSERT_EQ(table->capacity(), 512 << 10);
 }
 
+TEST_P(HashTableTest, incrementalRehash) {
+  constexpr int32_t kBatchSize = 1'000;
+  constexpr int32_t kNumBatches = 40;
+  auto rowType = ROW({"a"}, {BIGINT()});
+  auto table = createHashTableForAggregation(rowType, 1);
+  table->setIncrementalRehashMinEntries(1);
+  auto lookup = std::make_unique<HashLookup>(table->hashers(), pool());
+  auto testHelper = HashTableTestHelper<false>::create(table.get());
+  testHelper.setHashMode(BaseHashTable::HashMode::kHash, kBatchSize);
+
+  std::vector<RowVectorPtr> batches;
+  std::vector<std::vector<char*>> groups;
+  bool sawRehash = false;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<int64_t>(
+        kBatchSize, [&](auto row) { return i * kBatchSize + row; })}));
+    insertGroups(*batches.back(), *lookup, *table);
+    ASSERT_EQ(lookup->newGroups.size(), kBatchSize);
+    groups.emplace_back(
+        lookup->hits.data(), lookup->hits.data() + kBatchSize);
+    sawRehash |= table->testingIncrementalRehashInProgress();
+
+    // All groups inserted so far are found, whether they were moved to the
+    // new table or not.
+    for (auto j = 0; j <= i; ++j) {
+      insertGroups(*batches[j], *lookup, *table);
+      ASSERT_TRUE(lookup->newGroups.empty());
+      for (auto row = 0; row < kBatchSize; ++row) {
+        ASSERT_EQ(lookup->hits[row], groups[j][row]);
+      }
+    }
+  }
+  ASSERT_TRUE(sawRehash);
+  ASSERT_EQ(table->numDistinct(), kBatchSize * kNumBatches);
+  ASSERT_FALSE(table->testingIncrementalRehashInProgress());
+  table->checkConsistency();
+}
+
+TEST_P(HashTableTest, wideNormalizedKeys) {
+  constexpr int32_t kBatchSize = 4'000;
+  constexpr int32_t kNumBatches = 3;
+  constexpr int32_t kNumKeys = 5;
+  auto rowType = ROW(
+      {"k0", "k1", "k2", "k3", "k4"},
+      {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT()});
+  auto table = createHashTableForAggregation(rowType, kNumKeys);
+  table->enableWideNormalizedKeys();
+  ASSERT_TRUE(table->rows()->hasWideNormalizedKeys());
+  auto lookup = std::make_unique<HashLookup>(table->hashers(), pool());
+
+  // Sparse keys with a few thousand distinct values each. The value ids of
+  // the first batch fit in 64 bits. The later batches need two words.
+  auto makeBatch = [&](int32_t batch) {
+    std::vector<VectorPtr> children;
+    for (auto k = 0; k < kNumKeys; ++k) {
+      children.push_back(makeFlatVector<int64_t>(kBatchSize, [&](auto row) {
+        return (batch * kBatchSize + row) * 1'000'003L + k;
+      }));
+    }
+    return makeRowVector(children);
+  };
+  auto probe = [&](const RowVectorPtr& input) {
+    SelectivityVector rows(input->size());
+    table->prepareForGroupProbe(
+        *lookup, input, rows, BaseHashTable::kNoSpillInputStartPartitionBit);
+    table->groupProbe(*lookup, BaseHashTable::kNoSpillInputStartPartitionBit);
+  };
+
+  std::vector<RowVectorPtr> batches;
+  std::vector<std::vector<char*>> groups;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    batches.push_back(makeBatch(i));
+    probe(batches.back());
+    ASSERT_EQ(lookup->newGroups.size(), kBatchSize);
+    groups.emplace_back(
+        lookup->hits.data(), lookup->hits.data() + kBatchSize);
+  }
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kNormalizedKey);
+  ASSERT_TRUE(table->wideNormalizedKeys());
+  ASSERT_EQ(table->numDistinct(), kBatchSize * kNumBatches);
+
+  for (auto i = 0; i < kNumBatches; ++i) {
+    probe(batches[i]);
+    ASSERT_TRUE(lookup->newGroups.empty());
+    for (auto row = 0; row < kBatchSize; ++row) {
+      ASSERT_EQ(lookup->hits[row], groups[i][row]);
+    }
+  }
+
+  // Erased groups are inserted again.
+  table->erase(folly::Range<char**>(groups[0].data(), groups[0].size()));
+  probe(batches[0]);
+  ASSERT_EQ(lookup->newGroups.size(), kBatchSize);
+  ASSERT_EQ(table->numDistinct(), kBatchSize * kNumBatches);
+  table->checkConsistency();
+}
+
+TEST_P(HashTableTest, bigintIdMap) {
+  constexpr int32_t kBatchSize = 10'000;
+  constexpr int32_t kNumBatches = 15;
+  auto rowType = ROW({"a"}, {BIGINT()});
+  auto table = createHashTableForAggregation(rowType, 1);
+  table->enableBigintIdMap();
+  auto lookup = std::make_unique<HashLookup>(table->hashers(), pool());
+  auto probe = [&](const RowVectorPtr& input) {
+    SelectivityVector rows(input->size());
+    table->prepareForGroupProbe(
+        *lookup, input, rows, BaseHashTable::kNoSpillInputStartPartitionBit);
+    table->groupProbe(*lookup, BaseHashTable::kNoSpillInputStartPartitionBit);
+  };
+
+  // Sparse keys with nulls. One key is 0, which the id map handles apart. The
+  // first batches fit kArray mode with value ids, the later ones do not.
+  auto makeBatch = [&](int32_t batch) {
+    return makeRowVector({makeFlatVector<int64_t>(
+        kBatchSize,
+        [&](auto row) { return (batch * kBatchSize + row - 5) * 1'000'003L; },
+        nullEvery(97))});
+  };
+  constexpr int32_t kNumNulls = (kBatchSize + 96) / 97;
+
+  std::vector<RowVectorPtr> batches;
+  std::vector<std::vector<char*>> groups;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    batches.push_back(makeBatch(i));
+    probe(batches.back());
+    ASSERT_EQ(
+        lookup->newGroups.size(), kBatchSize - kNumNulls + (i == 0 ? 1 : 0));
+    groups.emplace_back(
+        lookup->hits.data(), lookup->hits.data() + kBatchSize);
+  }
+  ASSERT_TRUE(table->usesBigintIdMap());
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kHash);
+  ASSERT_EQ(table->numDistinct(), kNumBatches * (kBatchSize - kNumNulls) + 1);
+  table->checkConsistency();
+
+  // Groups made before and after the switch to the id map are found.
+  for (auto i = 0; i < kNumBatches; ++i) {
+    probe(batches[i]);
+    ASSERT_TRUE(lookup->newGroups.empty());
+    for (auto row = 0; row < kBatchSize; ++row) {
+      ASSERT_EQ(lookup->hits[row], groups[i][row]);
+    }
+  }
+
+  for (const bool freeTable : {false, true}) {
+    table->clear(freeTable);
+    ASSERT_EQ(table->numDistinct(), 0);
+    probe(batches[0]);
+    ASSERT_EQ(lookup->newGroups.size(), kBatchSize - kNumNulls + 1);
+    probe(batches[0]);
+    ASSERT_TRUE(lookup->newGroups.empty());
+    ASSERT_TRUE(table->usesBigintIdMap());
+    table->checkConsistency();
+  }
+}
+
 TEST_P(HashTableTest, listNullKeyRows) {
   VectorPtr keys = makeFlatVector<int64_t>(500, folly::identity);
   testListNullKeyRows(keys, BaseHashTable::HashMode::kArray);
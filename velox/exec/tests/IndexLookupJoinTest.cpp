@@ -18,6 +18,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/Connector.h"
 #include "velox/core/PlanNode.h"
+#include "velox/exec/IndexLookupJoin.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -1644,6 +1645,115 @@ TEST_P(IndexLookupJoinTest, outputBatchSize) {
   }
 }
 
+TEST_P(IndexLookupJoinTest, batchedLookup) {
+  SequenceTableData tableData;
+  generateIndexTableData({100, 1, 1}, tableData, pool_);
+  const auto probeVectors = generateProbeInput(
+      10,
+      100,
+      tableData,
+      pool_,
+      {"t0", "t1", "t2"},
+      {},
+      {},
+      /*equalMatchPct=*/80);
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", {tableData.tableData});
+
+  struct {
+    uint32_t maxBatchedInputs;
+    uint32_t cacheMaxKeys;
+    core::JoinType joinType;
+
+    std::string debugString() const {
+      return fmt::format(
+          "maxBatchedInputs: {}, cacheMaxKeys: {}, joinType: {}",
+          maxBatchedInputs,
+          cacheMaxKeys,
+          core::joinTypeName(joinType));
+    }
+  } testSettings[] = {
+      {0, 0, core::JoinType::kInner},
+      {1, 0, core::JoinType::kInner},
+      {2, 0, core::JoinType::kInner},
+      {4, 0, core::JoinType::kLeft},
+      {20, 0, core::JoinType::kLeft},
+      {2, 10, core::JoinType::kInner},
+      {2, 10'000, core::JoinType::kInner},
+      {3, 10'000, core::JoinType::kLeft}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+
+    const auto indexTable = createIndexTable(
+        /*numEqualJoinKeys=*/3, tableData.keyData, tableData.valueData);
+    const auto indexTableHandle = makeIndexTableHandle(indexTable, GetParam());
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId indexScanNodeId;
+    std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+        columnHandles;
+    const auto indexScanNode = makeIndexScanNode(
+        planNodeIdGenerator,
+        indexTableHandle,
+        makeScanOutputType({"u0", "u1", "u2", "u3", "u5"}),
+        indexScanNodeId,
+        columnHandles);
+
+    core::PlanNodeId joinNodeId;
+    auto plan = makeLookupPlan(
+        planNodeIdGenerator,
+        indexScanNode,
+        probeVectors,
+        {"t0", "t1", "t2"},
+        {"u0", "u1", "u2"},
+        {},
+        testData.joinType,
+        {"t0", "t4", "u3", "u5"},
+        joinNodeId);
+    const auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .plan(plan)
+            .config(
+                core::QueryConfig::kIndexLookupJoinMaxBatchedInputs,
+                std::to_string(testData.maxBatchedInputs))
+            .config(
+                core::QueryConfig::kIndexLookupJoinCacheMaxKeys,
+                std::to_string(testData.cacheMaxKeys))
+            .assertResults(fmt::format(
+                "SELECT t.c0, t.c4, u.c3, u.c5 FROM t {} JOIN u ON t.c0 = u.c0 AND t.c1 = u.c1 AND t.c2 = u.c2",
+                testData.joinType == core::JoinType::kLeft ? "LEFT" : ""));
+
+    const auto& customStats =
+        toPlanStats(task->taskStats()).at(joinNodeId).customStats;
+    if (testData.maxBatchedInputs == 0) {
+      ASSERT_EQ(customStats.count(IndexLookupJoin::kLookupKeys), 0);
+      continue;
+    }
+    const auto numLookupKeys =
+        customStats.at(IndexLookupJoin::kLookupKeys).sum;
+    const auto numCacheHits =
+        customStats.count(IndexLookupJoin::kLookupCacheHits) == 0
+        ? 0
+        : customStats.at(IndexLookupJoin::kLookupCacheHits).sum;
+    const auto numDuplicateKeys =
+        customStats.count(IndexLookupJoin::kLookupDuplicateKeys) == 0
+        ? 0
+        : customStats.at(IndexLookupJoin::kLookupDuplicateKeys).sum;
+    // Each probe row is either looked up, served from the cache or a
+    // duplicate of a looked up key.
+    ASSERT_EQ(numLookupKeys + numCacheHits + numDuplicateKeys, 1'000);
+    if (testData.maxBatchedInputs > 1) {
+      ASSERT_GT(numDuplicateKeys, 0);
+    }
+    if (testData.cacheMaxKeys >= 1'000) {
+      ASSERT_GT(numCacheHits, 0);
+    } else if (testData.cacheMaxKeys == 0) {
+      ASSERT_EQ(numCacheHits, 0);
+    }
+  }
+}
+
 TEST_P(IndexLookupJoinTest, joinFuzzer) {
   SequenceTableData tableData;
   generateIndexTableData({1024, 1, 1}, tableData, pool_);
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -109,6 +111,39 @@ TEST_F(LimitTest, limitOverLocalExchange) {
   ASSERT_TRUE(waitForTaskCompletion(cursor->task().get()));
 }
 
+TEST_F(LimitTest, limitHintToTableScan) {
+  auto data = makeRowVector(
+      {makeFlatVector<int32_t>(10'000, [](auto row) { return row; })});
+  auto file = TempFilePath::create();
+  writeToFile(file->getPath(), {data});
+  createDuckDbTable({data});
+
+  auto test = [&](const std::string& filter, int64_t maxRowsRead) {
+    SCOPED_TRACE(fmt::format("filter: {}", filter));
+    core::PlanNodeId scanNodeId;
+    auto builder = PlanBuilder()
+                       .tableScan(asRowType(data->type()))
+                       .capturePlanNodeId(scanNodeId);
+    if (!filter.empty()) {
+      builder.filter(filter);
+    }
+    auto plan =
+        builder.project({"c0 + 1 AS c0"}).limit(5, 10, false).planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .split(scanNodeId, makeHiveConnectorSplit(file->getPath()))
+                    .assertResults(fmt::format(
+                        "SELECT c0 + 1 FROM tmp {} OFFSET 5 LIMIT 10",
+                        filter.empty() ? "" : "WHERE " + filter));
+    const auto planStats = toPlanStats(task->taskStats());
+    ASSERT_LE(planStats.at(scanNodeId).rawInputRows, maxRowsRead);
+  };
+
+  // The scan reads only the 15 rows the limit needs.
+  test("", 15);
+  // A filter in between may drop rows. The scan reads more batches then.
+  test("c0 % 2 = 0", 10'000);
+}
+
 TEST_F(LimitTest, partialLimitEagerFlush) {
   std::vector<RowVectorPtr> batches(
       10, makeRowVector({makeFlatVector(std::vector<int64_t>(1, 0))}));
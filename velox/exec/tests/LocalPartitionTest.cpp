@@ -527,6 +527,66 @@ TEST_F(LocalPartitionTest, earlyCompletion) {
   assertTaskReferenceCount(task, 1);
 }
 
+TEST_F(LocalPartitionTest, producersFinishOnClosedQueues) {
+  // The Limit on the build side of the join is satisfied by the first rows of
+  // the local exchange. Its producer stops instead of producing the rest of
+  // its input while the probe side waits for splits.
+  constexpr int32_t kRepeatTimes = 10'000;
+  auto data = makeRowVector({makeFlatSequence<int64_t>(0, 100)});
+  auto probeFiles = writeToFiles({data});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanId;
+  core::PlanNodeId valuesId;
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .tableScan(asRowType(data->type()))
+          .capturePlanNodeId(probeScanId)
+          .hashJoin(
+              {"c0"},
+              {"u0"},
+              PlanBuilder(planNodeIdGenerator)
+                  .localPartition(
+                      {},
+                      {PlanBuilder(planNodeIdGenerator)
+                           .values({data}, false, kRepeatTimes)
+                           .capturePlanNodeId(valuesId)
+                           .planNode()})
+                  .limit(0, 10, false)
+                  .project({"c0 AS u0"})
+                  .planNode(),
+              "",
+              {"c0"})
+          .planNode();
+
+  CursorParameters params;
+  params.planNode = plan;
+  params.queryConfigs[core::QueryConfig::kMaxLocalExchangeBufferSize] = "1024";
+  auto cursor = TaskCursor::create(params);
+  cursor->start();
+  const auto& task = cursor->task();
+
+  // Wait for the values and the build pipelines to finish.
+  for (auto i = 0; i < 1'000 && task->numFinishedDrivers() < 2; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  ASSERT_EQ(task->numFinishedDrivers(), 2);
+
+  task->addSplit(
+      probeScanId,
+      exec::Split(makeHiveConnectorSplit(probeFiles[0]->getPath())));
+  task->noMoreSplits(probeScanId);
+  vector_size_t numRows = 0;
+  while (cursor->moveNext()) {
+    numRows += cursor->current()->size();
+  }
+  ASSERT_EQ(numRows, 10);
+  waitForTaskCompletion(task, exec::TaskState::kFinished);
+
+  const auto valuesStats = toPlanStats(task->taskStats()).at(valuesId);
+  ASSERT_LT(valuesStats.outputRows, kRepeatTimes * data->size());
+}
+
 TEST_F(LocalPartitionTest, earlyCancelation) {
   std::vector<RowVectorPtr> data = {
       makeRowVector({makeFlatSequence(3, 100)}),
@@ -951,5 +1011,56 @@ TEST_F(LocalPartitionTest, vectorPool) {
   ASSERT_FALSE(vectorPool.pop());
 }
 
+TEST_F(LocalPartitionTest, concurrentQueue) {
+  constexpr int kNumProducers = 4;
+  constexpr int kNumConsumers = 3;
+  constexpr int kNumBatches = 1'000;
+  auto memoryManager = std::make_shared<LocalExchangeMemoryManager>(100);
+  auto vectorPool = std::make_shared<LocalExchangeVectorPool>(0);
+  LocalExchangeQueue queue(memoryManager, vectorPool, 0);
+  for (auto i = 0; i < kNumProducers; ++i) {
+    queue.addProducer();
+  }
+  queue.noMoreProducers();
+
+  auto data = makeRowVector({makeFlatSequence<int64_t>(0, 10)});
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumProducers; ++i) {
+    threads.emplace_back([&] {
+      for (auto j = 0; j < kNumBatches; ++j) {
+        ContinueFuture future;
+        if (queue.enqueue(data, 10, &future) != BlockingReason::kNotBlocked) {
+          future.wait();
+        }
+      }
+      queue.noMoreData();
+    });
+  }
+  std::atomic_int64_t numRows{0};
+  for (auto i = 0; i < kNumConsumers; ++i) {
+    threads.emplace_back([&] {
+      for (;;) {
+        ContinueFuture future;
+        RowVectorPtr batch;
+        if (queue.next(&future, pool(), &batch) !=
+            BlockingReason::kNotBlocked) {
+          future.wait();
+          continue;
+        }
+        if (batch == nullptr) {
+          break;
+        }
+        numRows += batch->size();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_TRUE(queue.isFinished());
+  ASSERT_EQ(numRows, kNumProducers * kNumBatches * data->size());
+  ASSERT_EQ(memoryManager->bufferedBytes(), 0);
+}
+
 } // namespace
 } // namespace facebook::velox::exec::test
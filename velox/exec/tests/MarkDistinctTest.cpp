@@ -14,9 +14,12 @@
  * limitations under the License.
  */
 
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::test;
@@ -24,6 +27,10 @@ using namespace facebook::velox::exec::test;
 
 class MarkDistinctTest : public OperatorTestBase {
  public:
+  MarkDistinctTest() {
+    filesystems::registerLocalFileSystem();
+  }
+
   void runBasicTest(const VectorPtr& base) {
     const vector_size_t size = base->size() * 2;
     auto indices = makeIndices(size, [](auto row) { return row / 2; });
@@ -141,3 +148,55 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, spill) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [&](auto row) { return row % 17; }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row) % 3'001; }),
+        makeFlatVector<StringView>(
+            1'000,
+            [&](auto row) {
+              return StringView::makeInline(
+                  fmt::format("{}", (i + row) % 1'003));
+            }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto numPartitionBits : {1, 3}) {
+    SCOPED_TRACE(fmt::format("numPartitionBits {}", numPartitionBits));
+    const auto spillDirectory = TempDirectoryPath::create();
+    exec::TestScopedSpillInjection scopedSpillInjection(100);
+
+    core::PlanNodeId markDistinctId;
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .markDistinct("c1_distinct", {"c0", "c1"})
+                    .capturePlanNodeId(markDistinctId)
+                    .markDistinct("c2_distinct", {"c0", "c2"})
+                    .singleAggregation(
+                        {"c0"},
+                        {"sum(c1)", "count(c2)"},
+                        {"c1_distinct", "c2_distinct"})
+                    .planNode();
+
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(core::QueryConfig::kSpillEnabled, true)
+            .config(core::QueryConfig::kMarkDistinctSpillEnabled, true)
+            .config(core::QueryConfig::kSpillNumPartitionBits, numPartitionBits)
+            .assertResults(
+                "SELECT c0, sum(distinct c1), count(distinct c2) "
+                "FROM tmp GROUP BY 1");
+
+    auto planStats = exec::toPlanStats(task->taskStats());
+    const auto& stats = planStats.at(markDistinctId);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_GT(stats.spilledFiles, 0);
+  }
+}
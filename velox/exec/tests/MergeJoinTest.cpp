@@ -678,6 +678,62 @@ TEST_F(MergeJoinTest, numDrivers) {
   EXPECT_EQ(2, task->numFinishedDrivers());
 }
 
+// Verify that a merge join whose inputs are hash partitioned on the join keys
+// runs a driver per partition, while the pipelines producing the partitions
+// run single-threaded to keep each partition sorted.
+TEST_F(MergeJoinTest, partitionedInputs) {
+  std::vector<RowVectorPtr> left;
+  for (auto i = 0; i < 3; ++i) {
+    left.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int32_t>(
+             100, [i](auto row) { return (i * 100 + row) / 3; }),
+         makeFlatVector<int64_t>(
+             100, [i](auto row) { return i * 100 + row; })}));
+  }
+  std::vector<RowVectorPtr> right;
+  for (auto i = 0; i < 2; ++i) {
+    right.push_back(makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int32_t>(
+             100, [i](auto row) { return (i * 100 + row) * 2 / 3; }),
+         makeFlatVector<int64_t>(
+             100, [i](auto row) { return i * 100 + row; })}));
+  }
+  createDuckDbTable("t", left);
+  createDuckDbTable("u", right);
+
+  for (auto joinType : {core::JoinType::kInner, core::JoinType::kFull}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(left, true)
+                    .localPartition({"t0"})
+                    .mergeJoin(
+                        {"t0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(right, true)
+                            .localPartition({"u0"})
+                            .planNode(),
+                        "t1 % 5 <> u1 % 5",
+                        {"t0", "t1", "u0", "u1"},
+                        joinType)
+                    .planNode();
+
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .maxDrivers(4)
+            .assertResults(fmt::format(
+                "SELECT t0, t1, u0, u1 FROM t {} JOIN u ON t0 = u0 "
+                "AND t1 % 5 <> u1 % 5",
+                joinType == core::JoinType::kFull ? "FULL OUTER" : "INNER"));
+
+    // A driver for each producer and 4 for each side of the join.
+    EXPECT_EQ(10, task->numTotalDrivers());
+  }
+}
+
 TEST_F(MergeJoinTest, lazyVectors) {
   // A dataset of multiple row groups with multiple columns. We create
   // different dictionary wrappings for different columns and load the
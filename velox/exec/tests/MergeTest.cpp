@@ -183,3 +183,50 @@ TEST_F(MergeTest, offByOne) {
       {{core::QueryConfig::kPreferredOutputBatchRows, "6"}});
   assertQueryOrdered(params, "VALUES (0), (1), (2), (3), (4), (5), (10)", {0});
 }
+
+/// Verifies the merge of sources with long runs of rows that come before the
+/// rows of other sources. The merge outputs these runs at once.
+TEST_F(MergeTest, runs) {
+  const vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    // Each source overlaps with the next one on 10% of its range.
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](auto row) { return i * 900 + row; },
+        nullEvery(97));
+    auto c1 = makeFlatVector<StringView>(batchSize, [&](auto row) {
+      return StringView::makeInline(fmt::format("{}-{}", i, row));
+    });
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto* outputBatchRows : {"7", "100", "1024"}) {
+    SCOPED_TRACE(fmt::format("outputBatchRows: {}", outputBatchRows));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    std::vector<core::PlanNodePtr> sources;
+    for (const auto& input : vectors) {
+      // Split each source in several batches.
+      std::vector<RowVectorPtr> batches;
+      for (auto offset = 0; offset < batchSize; offset += 300) {
+        batches.push_back(std::dynamic_pointer_cast<RowVector>(input->slice(
+            offset, std::min<vector_size_t>(300, batchSize - offset))));
+      }
+      sources.push_back(PlanBuilder(planNodeIdGenerator)
+                            .values(batches)
+                            .orderBy({"c0 NULLS FIRST"}, true)
+                            .planNode());
+    }
+
+    CursorParameters params;
+    params.planNode = PlanBuilder(planNodeIdGenerator)
+                          .localMerge({"c0 NULLS FIRST"}, std::move(sources))
+                          .planNode();
+    params.queryCtx = core::QueryCtx::create(executor_.get());
+    params.queryCtx->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kPreferredOutputBatchRows, outputBatchRows}});
+    assertQueryOrdered(
+        params, "SELECT * FROM tmp ORDER BY c0 NULLS FIRST", {0});
+  }
+}
@@ -399,6 +399,76 @@ TEST_P(MultiFragmentTest, aggregationMultiKey) {
   }
 }
 
+TEST_P(MultiFragmentTest, inProcessShuffle) {
+  setupSources(10, 1'000);
+  configSettings_[core::QueryConfig::kInProcessShuffleEnabled] = "true";
+  std::vector<std::shared_ptr<Task>> tasks;
+  auto leafTaskId = makeTaskId("leaf", 0);
+  core::PlanNodePtr partialAggPlan;
+  {
+    partialAggPlan =
+        PlanBuilder()
+            .tableScan(rowType_)
+            .project({"c0 % 10 AS c0", "c1 % 2 AS c1", "c2", "c5"})
+            .partialAggregation({"c0", "c1"}, {"sum(c2)", "max(c5)"})
+            .partitionedOutput(
+                {"c0", "c1"}, 3, /*outputLayout=*/{}, GetParam().serdeKind)
+            .planNode();
+
+    auto leafTask = makeTask(leafTaskId, partialAggPlan, 0);
+    tasks.push_back(leafTask);
+    leafTask->start(4);
+    addHiveSplits(leafTask, filePaths_);
+  }
+
+  core::PlanNodePtr finalAggPlan;
+  core::PlanNodeId exchangeId;
+  std::vector<std::string> finalAggTaskIds;
+  for (int i = 0; i < 3; i++) {
+    finalAggPlan =
+        PlanBuilder()
+            .exchange(partialAggPlan->outputType(), GetParam().serdeKind)
+            .capturePlanNodeId(exchangeId)
+            .finalAggregation(
+                {"c0", "c1"}, {"sum(a0)", "max(a1)"}, {{BIGINT()}, {VARCHAR()}})
+            .partitionedOutput({}, 1, /*outputLayout=*/{}, GetParam().serdeKind)
+            .planNode();
+
+    finalAggTaskIds.push_back(makeTaskId("final-agg", i));
+    auto task = makeTask(finalAggTaskIds.back(), finalAggPlan, i);
+    tasks.push_back(task);
+    task->start(1);
+    addRemoteSplits(task, {leafTaskId});
+  }
+
+  auto op = PlanBuilder()
+                .exchange(finalAggPlan->outputType(), GetParam().serdeKind)
+                .planNode();
+
+  std::vector<Split> finalAggTaskSplits;
+  for (auto finalAggTaskId : finalAggTaskIds) {
+    finalAggTaskSplits.emplace_back(remoteSplit(finalAggTaskId));
+  }
+  test::AssertQueryBuilder(op, duckDbQueryRunner_)
+      .splits(std::move(finalAggTaskSplits))
+      .config(core::QueryConfig::kInProcessShuffleEnabled, "true")
+      .assertResults(
+          "SELECT c0 % 10, c1 % 2, sum(c2), max(c5) FROM tmp GROUP BY 1, 2");
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+
+  int64_t numInputRows{0};
+  for (auto i = 1; i < tasks.size(); ++i) {
+    const auto& exchangeStats =
+        toPlanStats(tasks[i]->taskStats()).at(exchangeId);
+    ASSERT_GT(exchangeStats.rawInputBytes, 0);
+    numInputRows += exchangeStats.outputRows;
+  }
+  ASSERT_GT(numInputRows, 0);
+}
+
 TEST_P(MultiFragmentTest, distributedTableScan) {
   setupSources(10, 1000);
   // Run the table scan several times to test the caching.
@@ -1513,6 +1583,48 @@ TEST_P(MultiFragmentTest, earlyCompletion) {
   }
 }
 
+TEST_P(MultiFragmentTest, outputNotNeeded) {
+  // The Limit in the consumer task is satisfied by the first pages of the leaf
+  // task. The leaf task then finishes without producing the rest of its output
+  // once the consumer has gone away.
+  configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] = "100";
+  constexpr int32_t kRepeatTimes = 10'000;
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+
+  auto leafTaskId = makeTaskId("leaf", 0);
+  core::PlanNodeId valuesId;
+  auto leafPlan = PlanBuilder()
+                      .values({data}, false, kRepeatTimes)
+                      .capturePlanNodeId(valuesId)
+                      .partitionedOutput(
+                          {}, 1, /*outputLayout=*/{}, GetParam().serdeKind)
+                      .planNode();
+  auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+  leafTask->start(1);
+
+  auto plan = PlanBuilder()
+                  .exchange(leafPlan->outputType(), GetParam().serdeKind)
+                  .limit(0, 10, false)
+                  .planNode();
+  auto result =
+      test::AssertQueryBuilder(plan)
+          .split(remoteSplit(leafTaskId))
+          .config(
+              core::QueryConfig::kShuffleCompressionKind,
+              common::compressionKindToString(GetParam().compressionKind))
+          .copyResults(pool());
+  ASSERT_EQ(result->size(), 10);
+
+  ASSERT_TRUE(waitForTaskCompletion(leafTask.get())) << leafTask->taskId();
+  ASSERT_EQ(leafTask->state(), TaskState::kFinished);
+  const auto taskStats = leafTask->taskStats();
+  ASSERT_TRUE(taskStats.finishedOnOutputNotNeeded);
+  ASSERT_LT(
+      toPlanStats(taskStats).at(valuesId).outputRows,
+      kRepeatTimes * data->size());
+}
+
 TEST_P(MultiFragmentTest, earlyCompletionBroadcast) {
   // Same as 'earlyCompletion' test, but broadcasts leaf task results to all
   // intermediate tasks.
@@ -2870,6 +2982,69 @@ TEST_P(MultiFragmentTest, scaledTableScan) {
   }
 }
 
+TEST_P(MultiFragmentTest, scaledExchangePipeline) {
+  setupSources(10, 1'000);
+  const auto leafPlan =
+      PlanBuilder()
+          .tableScan(rowType_)
+          .partitionedOutput({}, 1, /*outputLayout=*/{}, GetParam().serdeKind)
+          .planNode();
+
+  for (const bool scaleEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("scaleEnabled {}", scaleEnabled));
+    configSettings_[core::QueryConfig::kPipelineScaledProcessingEnabled] =
+        scaleEnabled ? "true" : "false";
+
+    const auto leafTaskId =
+        makeTaskId(fmt::format("leaf-{}", scaleEnabled), 0);
+    auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+    leafTask->start(4);
+    addHiveSplits(leafTask, filePaths_);
+
+    core::PlanNodeId exchangeId;
+    const auto filterPlan =
+        PlanBuilder()
+            .exchange(leafPlan->outputType(), GetParam().serdeKind)
+            .capturePlanNodeId(exchangeId)
+            .filter("c0 % 3 = 0")
+            .project({"c0", "c1"})
+            .partitionedOutput({}, 1, /*outputLayout=*/{}, GetParam().serdeKind)
+            .planNode();
+    const auto filterTaskId =
+        makeTaskId(fmt::format("filter-{}", scaleEnabled), 0);
+    auto filterTask = makeTask(filterTaskId, filterPlan, 0);
+    const auto numFilterDrivers{4};
+    filterTask->start(numFilterDrivers);
+    addRemoteSplits(filterTask, {leafTaskId});
+
+    auto op = PlanBuilder()
+                  .exchange(filterPlan->outputType(), GetParam().serdeKind)
+                  .planNode();
+    test::AssertQueryBuilder(op, duckDbQueryRunner_)
+        .split(remoteSplit(filterTaskId))
+        .assertResults("SELECT c0, c1 FROM tmp WHERE c0 % 3 = 0");
+    ASSERT_TRUE(waitForTaskCompletion(leafTask.get())) << leafTask->taskId();
+    ASSERT_TRUE(waitForTaskCompletion(filterTask.get()))
+        << filterTask->taskId();
+
+    auto planStats = toPlanStats(filterTask->taskStats());
+    const auto& exchangeStats = planStats.at(exchangeId);
+    if (scaleEnabled) {
+      ASSERT_EQ(
+          exchangeStats.customStats.count(Exchange::kPeakRunningScaleThreads),
+          1);
+      const auto peak =
+          exchangeStats.customStats.at(Exchange::kPeakRunningScaleThreads).sum;
+      ASSERT_GE(peak, 1);
+      ASSERT_LE(peak, numFilterDrivers);
+    } else {
+      ASSERT_EQ(
+          exchangeStats.customStats.count(Exchange::kPeakRunningScaleThreads),
+          0);
+    }
+  }
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     MultiFragmentTest,
     MultiFragmentTest,
@@ -622,5 +622,50 @@ TEST_F(NestedLoopJoinTest, mergeBuildVectors) {
   ASSERT_TRUE(waitForTaskCompletion(cursor->task().get()));
 }
 
+TEST_F(NestedLoopJoinTest, rangeJoin) {
+  // Probe columns compared to build columns of the same integer type are
+  // evaluated with SIMD before the rest of the join condition. Covers nulls,
+  // build columns that are not flat and build vectors longer than a word.
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 3; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int64_t>(
+             100,
+             [i](auto row) { return (row * 17 + i) % 500; },
+             [](auto row) { return row % 23 == 0; }),
+         makeFlatVector<int32_t>(100, [](auto row) { return row % 7; })}));
+    auto start = makeFlatVector<int64_t>(
+        150,
+        [i](auto row) { return row * 3 + i; },
+        [](auto row) { return row % 31 == 0; });
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1", "u2"},
+        {start,
+         wrapInDictionary(
+             makeIndicesInReverse(150),
+             makeFlatVector<int64_t>(
+                 150, [i](auto row) { return (149 - row) * 3 + i + 20; })),
+         makeFlatVector<int32_t>(150, [](auto row) { return row % 5; })}));
+  }
+
+  setProbeType(asRowType(probeVectors[0]->type()));
+  setBuildType(asRowType(buildVectors[0]->type()));
+  setOutputLayout({"t0", "t1", "u0", "u1"});
+  setComparisons({""});
+  for (const auto& condition :
+       {"t0 BETWEEN u0 AND u1",
+        "u0 <= t0 AND u1 > t0",
+        "t0 BETWEEN u0 AND u1 AND t1 <> u2",
+        "t0 >= u0 AND t0 + 10 <= u1"}) {
+    SCOPED_TRACE(condition);
+    setJoinConditionStr(condition);
+    setQueryStr(fmt::format(
+        "SELECT t0, t1, u0, u1 FROM t {{}} JOIN u ON {}{{}}", condition));
+    runSingleAndMultiDriverTest(probeVectors, buildVectors);
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::exec::test
@@ -201,6 +201,67 @@ TEST_F(OperatorUtilsTest, processFilterResults) {
       0);
 }
 
+TEST_F(OperatorUtilsTest, processFlatFilterResults) {
+  // Compares the selected rows of a flat filter result, found with
+  // simd::indicesOfSetBits, with the same result wrapped in a dictionary,
+  // which visits the rows one at a time, and with a plain loop.
+  auto test = [&](vector_size_t size,
+                  std::function<bool(vector_size_t)> valueAt,
+                  std::function<bool(vector_size_t)> isNullAt,
+                  std::function<bool(vector_size_t)> isSelected) {
+    SCOPED_TRACE(fmt::format("size {}", size));
+    VectorPtr flat = makeFlatVector<bool>(size, valueAt, isNullAt);
+    auto encoded = wrapInDictionary(
+        makeIndices(size, [](auto row) { return row; }), flat);
+    ASSERT_EQ(VectorEncoding::Simple::FLAT, flat->encoding());
+    ASSERT_EQ(VectorEncoding::Simple::DICTIONARY, encoded->encoding());
+    SelectivityVector rows(size);
+    for (auto row = 0; row < size; ++row) {
+      rows.setValid(row, isSelected(row));
+    }
+    rows.updateBounds();
+
+    std::vector<vector_size_t> expected;
+    for (auto row = 0; row < size; ++row) {
+      if (isSelected(row) && !isNullAt(row) && valueAt(row)) {
+        expected.push_back(row);
+      }
+    }
+
+    for (const auto& filterResult : {flat, encoded}) {
+      exec::FilterEvalCtx filterEvalCtx;
+      const auto numPassed = exec::processFilterResults(
+          filterResult, rows, filterEvalCtx, pool_.get());
+      ASSERT_EQ(expected.size(), static_cast<size_t>(numPassed));
+      const auto* selected =
+          filterEvalCtx.selectedIndices->as<vector_size_t>();
+      ASSERT_EQ(
+          expected, std::vector<vector_size_t>(selected, selected + numPassed));
+    }
+  };
+
+  auto all = [](auto /*row*/) { return true; };
+  auto none = [](auto /*row*/) { return false; };
+  for (auto size : {1, 63, 64, 65, 127, 128, 129, 1'000, 1'024}) {
+    test(size, all, none, all);
+    test(size, none, none, all);
+    test(size, all, all, all);
+    test(size, all, none, none);
+    // First and last rows of each 64-bit word.
+    test(
+        size,
+        [](auto row) { return row % 64 == 0 || row % 64 == 63; },
+        none,
+        all);
+    test(
+        size,
+        [](auto row) { return row % 3 != 0; },
+        nullEvery(5),
+        [](auto row) { return row % 7 != 0; });
+    test(size, all, nullEvery(64), [](auto row) { return row % 64 != 63; });
+  }
+}
+
 TEST_F(OperatorUtilsTest, wrapChildConstant) {
   auto constant = makeConstant(11, 1'000);
 
@@ -21,6 +21,7 @@
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/SerializedPageUtil.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/CompactRowSerializer.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/serializers/UnsafeRowSerializer.h"
@@ -1613,6 +1614,68 @@ TEST_P(AllOutputBufferManagerTest, multiFetchers) {
   }
 }
 
+TEST_P(AllOutputBufferManagerTest, spill) {
+  const std::string taskId = "t0";
+  bufferManager_->removeTask(taskId);
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto planFragment = exec::test::PlanBuilder()
+                          .values({std::dynamic_pointer_cast<RowVector>(
+                              BatchMaker::createBatch(rowType_, 100, *pool_))})
+                          .planFragment();
+  // Any page exceeds the memory limit and is spilled.
+  auto queryCtx = core::QueryCtx::create(
+      executor_.get(),
+      core::QueryConfig(
+          {{core::QueryConfig::kMaxOutputBufferSize, "1"},
+           {core::QueryConfig::kMaxOutputBufferSpillSize, "1000000000"}}));
+  auto task = Task::create(
+      taskId,
+      std::move(planFragment),
+      0,
+      std::move(queryCtx),
+      Task::ExecutionMode::kParallel);
+  task->setSpillDirectory(spillDirectory->getPath());
+  bufferManager_->initializeTask(task, outputKind_, 1, 1);
+  if (outputKind_ == PartitionedOutputNode::Kind::kBroadcast) {
+    bufferManager_->updateOutputBuffers(taskId, 0, true);
+  }
+
+  const int numPages = 10;
+  std::vector<std::string> expected;
+  for (auto i = 0; i < numPages; ++i) {
+    auto page = makeSerializedPage(rowType_, 100);
+    auto iobuf = page->getIOBuf();
+    expected.push_back(iobuf->moveToFbString().toStdString());
+    ContinueFuture future;
+    ASSERT_FALSE(bufferManager_->enqueue(taskId, 0, std::move(page), &future));
+  }
+  ASSERT_EQ(getStats(taskId).bufferedBytes, 0);
+  ASSERT_EQ(getStats(taskId).bufferedPages, numPages);
+
+  // The spilled pages are read back when fetched.
+  std::vector<std::string> fetched;
+  ASSERT_TRUE(bufferManager_->getData(
+      taskId,
+      0,
+      std::numeric_limits<uint64_t>::max(),
+      0,
+      [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+          int64_t /*sequence*/,
+          std::vector<int64_t> /*remainingBytes*/) {
+        for (auto& page : pages) {
+          ASSERT_NE(page, nullptr);
+          fetched.push_back(page->moveToFbString().toStdString());
+        }
+      }));
+  ASSERT_EQ(fetched, expected);
+
+  acknowledge(taskId, 0, numPages);
+  ASSERT_EQ(getStats(taskId).bufferedPages, 0);
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, numPages);
+  bufferManager_->removeTask(taskId);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     AllOutputBufferManagerTestSuite,
     AllOutputBufferManagerTest,
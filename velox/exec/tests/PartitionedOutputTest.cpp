@@ -206,6 +206,235 @@ TEST_P(PartitionedOutputTest, keyChannelNotAtBeginningWithNulls) {
           .count()));
 }
 
+TEST_P(PartitionedOutputTest, preserveEncodings) {
+  if (GetParam() != VectorSerde::Kind::kPresto) {
+    GTEST_SKIP() << "Only the Presto serde preserves encodings";
+  }
+
+  const vector_size_t size = 1'000;
+  auto input = makeRowVector(
+      {"p1", "v1"},
+      {makeFlatVector<int32_t>(size, [](auto row) { return row % 2; }),
+       wrapInDictionary(
+           makeIndices(size, [](auto row) { return row % 3; }),
+           makeFlatVector<std::string>(
+               {std::string(100, 'a'),
+                std::string(100, 'b'),
+                std::string(100, 'c')}))});
+
+  auto plan = PlanBuilder()
+                  .values({input}, false, 10)
+                  .partitionedOutput(
+                      {"p1"}, 2, std::vector<std::string>{"v1"}, GetParam())
+                  .planNode();
+
+  const auto outputType = ROW({"v1"}, {VARCHAR()});
+  auto runAndGetBytes = [&](const std::string& taskId, bool preserve) {
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        createQueryContext(
+            {{core::QueryConfig::kShufflePreserveEncodings,
+              preserve ? "true" : "false"}}),
+        Task::ExecutionMode::kParallel);
+    task->start(1);
+
+    int64_t numBytes = 0;
+    int64_t numRows = 0;
+    for (auto destination = 0; destination < 2; ++destination) {
+      for (auto& iobuf : getAllData(taskId, destination)) {
+        numBytes += iobuf->computeChainDataLength();
+        SerializedPage page(std::move(iobuf));
+        auto stream = page.prepareStreamForDeserialize();
+        while (!stream->atEnd()) {
+          RowVectorPtr result;
+          getNamedVectorSerde(GetParam())
+              ->deserialize(stream.get(), pool(), outputType, &result);
+          auto* values = result->childAt(0)->as<SimpleVector<StringView>>();
+          for (auto row = 0; row < result->size(); ++row) {
+            const auto value = values->valueAt(row).str();
+            EXPECT_EQ(value.size(), 100);
+            EXPECT_EQ(value, std::string(100, value[0]));
+          }
+          numRows += result->size();
+        }
+      }
+    }
+    EXPECT_EQ(numRows, size * 10);
+
+    EXPECT_TRUE(waitForTaskCompletion(
+        task.get(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::seconds(10))
+            .count()));
+    return numBytes;
+  };
+
+  const auto flatBytes =
+      runAndGetBytes("local://test-partitioned-output-flat-0", false);
+  const auto preservedBytes =
+      runAndGetBytes("local://test-partitioned-output-preserved-0", true);
+  ASSERT_LT(preservedBytes * 10, flatBytes);
+}
+
+TEST_P(PartitionedOutputTest, skewedPartitions) {
+  // All rows have the same key, so they all fall into one hash partition.
+  const vector_size_t size = 1'000;
+  const int numBatches = 10;
+  const int numPartitions = 4;
+  auto input = makeRowVector(
+      {"p1", "v1"},
+      {makeConstant<int32_t>(7, size),
+       makeFlatVector<int64_t>(size, [](auto row) { return row; })});
+  const std::vector<uint32_t> allPartitions{0, 1, 2, 3};
+  const auto outputType = ROW({"v1"}, {BIGINT()});
+
+  auto countRows = [&](const std::string& taskId,
+                       core::PartitionedOutputNode::SkewedPartitionMode mode) {
+    auto plan = PlanBuilder()
+                    .values({input}, false, numBatches)
+                    .skewedPartitionedOutput(
+                        {"p1"},
+                        numPartitions,
+                        mode,
+                        allPartitions,
+                        std::vector<std::string>{"v1"},
+                        GetParam())
+                    .planNode();
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        createQueryContext(
+            {{core::QueryConfig::
+                  kShuffleSkewedPartitionMinProcessedBytesRebalanceThreshold,
+              "1"},
+             {core::QueryConfig::kShuffleMinProcessedBytesRebalanceThreshold,
+              "1"}}),
+        Task::ExecutionMode::kParallel);
+    task->start(1);
+
+    std::vector<int64_t> numRows(numPartitions, 0);
+    for (auto destination = 0; destination < numPartitions; ++destination) {
+      for (auto& iobuf : getAllData(taskId, destination)) {
+        SerializedPage page(std::move(iobuf));
+        auto stream = page.prepareStreamForDeserialize();
+        while (!stream->atEnd()) {
+          RowVectorPtr result;
+          getNamedVectorSerde(GetParam())
+              ->deserialize(stream.get(), pool(), outputType, &result);
+          numRows[destination] += result->size();
+        }
+      }
+    }
+    EXPECT_TRUE(waitForTaskCompletion(
+        task.get(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::seconds(10))
+            .count()));
+    return numRows;
+  };
+
+  // The build side sends the rows of skewed partitions to all destinations.
+  const auto replicated = countRows(
+      "local://test-partitioned-output-replicate-0",
+      core::PartitionedOutputNode::SkewedPartitionMode::kReplicate);
+  for (auto destination = 0; destination < numPartitions; ++destination) {
+    ASSERT_EQ(replicated[destination], size * numBatches);
+  }
+
+  // The probe side spreads the hot partition over more destinations once it
+  // is detected as overloaded. Each row is sent once.
+  const auto spread = countRows(
+      "local://test-partitioned-output-spread-0",
+      core::PartitionedOutputNode::SkewedPartitionMode::kSpread);
+  int64_t totalRows = 0;
+  int numUsedDestinations = 0;
+  for (auto destination = 0; destination < numPartitions; ++destination) {
+    totalRows += spread[destination];
+    numUsedDestinations += spread[destination] > 0;
+  }
+  ASSERT_EQ(totalRows, size * numBatches);
+  ASSERT_GT(numUsedDestinations, 1);
+}
+
+TEST_P(PartitionedOutputTest, manyDestinations) {
+  // With this many destinations, the Presto serde scatters the rows of each
+  // input to all the destinations in one pass per column.
+  const int numDestinations = 2 * PartitionedOutput::kMinScatterDestinations;
+  const vector_size_t size = 1'000;
+  const int numBatches = 5;
+  auto input = makeRowVector(
+      {"p1", "v1", "v2"},
+      {makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+       makeFlatVector<double>(
+           size, [](auto row) { return row * 0.5; }, nullEvery(7)),
+       makeFlatVector<std::string>(
+           size, [](auto row) { return std::to_string(row); })});
+
+  auto plan = PlanBuilder()
+                  .values({input}, false, numBatches)
+                  .partitionedOutput(
+                      {"p1"},
+                      numDestinations,
+                      std::vector<std::string>{"p1", "v1", "v2"},
+                      GetParam())
+                  .planNode();
+
+  const auto taskId = "local://test-partitioned-output-many-0";
+  auto task = Task::create(
+      taskId,
+      core::PlanFragment{plan},
+      0,
+      createQueryContext({}),
+      Task::ExecutionMode::kParallel);
+  task->start(1);
+
+  const auto outputType = asRowType(input->type());
+  std::vector<int32_t> counts(size, 0);
+  std::vector<int32_t> rowDestinations(size, -1);
+  for (auto destination = 0; destination < numDestinations; ++destination) {
+    for (auto& iobuf : getAllData(taskId, destination)) {
+      SerializedPage page(std::move(iobuf));
+      auto stream = page.prepareStreamForDeserialize();
+      while (!stream->atEnd()) {
+        RowVectorPtr result;
+        getNamedVectorSerde(GetParam())
+            ->deserialize(stream.get(), pool(), outputType, &result);
+        auto* keys = result->childAt(0)->as<SimpleVector<int64_t>>();
+        auto* doubles = result->childAt(1)->as<SimpleVector<double>>();
+        auto* strings = result->childAt(2)->as<SimpleVector<StringView>>();
+        for (auto i = 0; i < result->size(); ++i) {
+          const auto key = keys->valueAt(i);
+          ASSERT_GE(key, 0);
+          ASSERT_LT(key, size);
+          ++counts[key];
+          // Rows with the same key go to the same destination.
+          if (rowDestinations[key] == -1) {
+            rowDestinations[key] = destination;
+          }
+          ASSERT_EQ(rowDestinations[key], destination);
+          ASSERT_EQ(doubles->isNullAt(i), key % 7 == 0);
+          if (!doubles->isNullAt(i)) {
+            ASSERT_EQ(doubles->valueAt(i), key * 0.5);
+          }
+          ASSERT_EQ(strings->valueAt(i).str(), std::to_string(key));
+        }
+      }
+    }
+  }
+  for (auto key = 0; key < size; ++key) {
+    ASSERT_EQ(counts[key], numBatches);
+  }
+
+  ASSERT_TRUE(waitForTaskCompletion(
+      task.get(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::seconds(10))
+          .count()));
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     PartitionedOutputTest,
     PartitionedOutputTest,
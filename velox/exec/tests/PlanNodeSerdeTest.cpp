@@ -388,6 +388,18 @@ TEST_F(PlanNodeSerdeTest, partitionedOutput) {
                .partitionedOutput({"c0"}, 50, {"c1", {"c2"}, "c0"}, serdeKind)
                .planNode();
     testSerde(plan);
+
+    plan = PlanBuilder()
+               .values({data_})
+               .skewedPartitionedOutput(
+                   {"c0"},
+                   50,
+                   core::PartitionedOutputNode::SkewedPartitionMode::kSpread,
+                   {3, 17},
+                   /*outputLayout=*/{},
+                   serdeKind)
+               .planNode();
+    testSerde(plan);
   }
 }
 
@@ -588,6 +600,14 @@ TEST_F(PlanNodeSerdeTest, topNRowNumber) {
              .topNRowNumber({"c0"}, {"c1", "c2"}, 10, false)
              .planNode();
   testSerde(plan);
+
+  for (const auto& function : {"rank", "dense_rank"}) {
+    plan = PlanBuilder()
+               .values({data_})
+               .topNRank(function, {"c0"}, {"c1", "c2"}, 10, true)
+               .planNode();
+    testSerde(plan);
+  }
 }
 
 TEST_F(PlanNodeSerdeTest, write) {
@@ -645,6 +645,23 @@ TEST_F(PlanNodeToStringTest, partitionedOutput) {
             serdeKind),
         plan->toString(true, false));
 
+    plan = PlanBuilder()
+               .values({data_})
+               .skewedPartitionedOutput(
+                   {"c0"},
+                   4,
+                   core::PartitionedOutputNode::SkewedPartitionMode::kReplicate,
+                   {1, 3},
+                   /*outputLayout=*/{},
+                   serdeKind)
+               .planNode();
+
+    ASSERT_EQ(
+        fmt::format(
+            "-- PartitionedOutput[1][partitionFunction: HASH(c0) with 4 partitions REPLICATE skewed partitions [1, 3] {}] -> c0:SMALLINT, c1:INTEGER, c2:BIGINT\n",
+            serdeKind),
+        plan->toString(true, false));
+
     auto hiveSpec =
         std::make_shared<connector::hive::HivePartitionFunctionSpec>(
             4,
@@ -958,6 +975,16 @@ TEST_F(PlanNodeToStringTest, topNRowNumber) {
   ASSERT_EQ(
       "-- TopNRowNumber[1][partition by (a) order by (b ASC NULLS LAST) limit 10] -> a:BIGINT, b:VARCHAR\n",
       plan->toString(true, false));
+
+  plan = PlanBuilder()
+             .tableScan(rowType)
+             .topNRank("dense_rank", {"a"}, {"b"}, 10, true)
+             .planNode();
+
+  ASSERT_EQ("-- TopNRowNumber[1]\n", plan->toString());
+  ASSERT_EQ(
+      "-- TopNRowNumber[1][dense_rank partition by (a) order by (b ASC NULLS LAST) limit 10] -> a:BIGINT, b:VARCHAR, dense_rank:BIGINT\n",
+      plan->toString(true, false));
 }
 
 TEST_F(PlanNodeToStringTest, markDistinct) {
@@ -39,9 +39,13 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
       false,
       CompareFlags::NullHandlingMode::kNullAsValue};
 
+  // Sets the prefix-sort threshold to 0 to enable prefix-sort in small
+  // datasets.
   void testPrefixSort(
       const std::vector<CompareFlags>& compareFlags,
-      const RowVectorPtr& data) {
+      const RowVectorPtr& data,
+      const common::PrefixSortConfig& config =
+          common::PrefixSortConfig{1024, 0, 12}) {
     const auto numRows = data->size();
     const auto expectedResult =
         generateExpectedResult(compareFlags, numRows, data);
@@ -61,27 +65,11 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
     const std::shared_ptr<memory::MemoryPool> sortPool =
         rootPool_->addLeafChild("prefixsort");
     const auto maxBytes = PrefixSort::maxRequiredBytes(
-        &rowContainer,
-        compareFlags,
-        common::PrefixSortConfig{
-            1024,
-            // Set threshold to 0 to enable prefix-sort in small dataset.
-            0,
-            12},
-        sortPool.get());
+        &rowContainer, compareFlags, config, sortPool.get());
     const auto beforeBytes = sortPool->peakBytes();
     ASSERT_EQ(sortPool->peakBytes(), 0);
     // Use PrefixSort to sort rows.
-    PrefixSort::sort(
-        &rowContainer,
-        compareFlags,
-        common::PrefixSortConfig{
-            1024,
-            // Set threshold to 0 to enable prefix-sort in small dataset.
-            0,
-            12},
-        sortPool.get(),
-        rows);
+    PrefixSort::sort(&rowContainer, compareFlags, config, sortPool.get(), rows);
     ASSERT_GE(maxBytes, sortPool->peakBytes() - beforeBytes);
 
     // Extract data from the RowContainer in order.
@@ -330,6 +318,50 @@ TEST_F(PrefixSortTest, fuzzMulti) {
   runFuzzTest(0.0);
 }
 
+TEST_F(PrefixSortTest, radixSort) {
+  // Sets the radix sort threshold to 1 to sort all the rows with radix sort.
+  const common::PrefixSortConfig config{1024, 0, 12, 0, 1};
+  const std::vector<TypePtr> keyTypes = {
+      INTEGER(),
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      BIGINT(),
+      DECIMAL(12, 2),
+      DECIMAL(25, 6),
+      REAL(),
+      DOUBLE(),
+      TIMESTAMP()};
+  auto runFuzzTest = [&](double nullRatio) {
+    VectorFuzzer fuzzer({.vectorSize = 10'240, .nullRatio = nullRatio}, pool());
+    for (const auto& type : keyTypes) {
+      SCOPED_TRACE(fmt::format("{}", type->toString()));
+      const auto data = fuzzer.fuzzRow(ROW({type}));
+      testPrefixSort({kAsc}, data, config);
+      testPrefixSort({kDesc}, data, config);
+    }
+    for (auto i = 0; i < 20; ++i) {
+      const auto type1 = fuzzer.randType(keyTypes, 0);
+      const auto type2 = fuzzer.randType(keyTypes, 0);
+      SCOPED_TRACE(fmt::format("{}, {}", type1->toString(), type2->toString()));
+      const auto data = fuzzer.fuzzRow(ROW({type1, type2, VARCHAR()}));
+      testPrefixSort({kAsc, kDesc}, data, config);
+      testPrefixSort({kDesc, kAsc}, data, config);
+    }
+  };
+  runFuzzTest(0.1);
+  runFuzzTest(0.0);
+
+  // Keys with few distinct values make buckets which tie on all the bytes.
+  const auto data = makeRowVector({
+      makeFlatVector<int32_t>(
+          50'000, [](auto row) { return row % 13; }, nullEvery(101)),
+      makeFlatVector<int64_t>(50'000, [](auto row) { return row % 1'000; }),
+  });
+  testPrefixSort({kAsc, kAsc}, data, config);
+  testPrefixSort({kDesc, kAsc}, data, config);
+}
+
 TEST_F(PrefixSortTest, checkMaxNormalizedKeySizeForMultipleKeys) {
   // Test the normalizedKeySize doesn't exceed the MaxNormalizedKeySize.
   // The normalizedKeySize for BIGINT should be 8 + 1.
@@ -470,5 +502,83 @@ TEST_F(PrefixSortTest, makeSortLayoutForString) {
   ASSERT_EQ(sortLayoutTwoKeys.encodeSizes[1], 9);
 }
 
+TEST_F(PrefixSortTest, makeSortLayoutForLongStringPrefix) {
+  std::vector<TypePtr> keyTypes = {VARCHAR(), BIGINT()};
+  std::vector<CompareFlags> compareFlags = {kAsc, kDesc};
+  std::vector<bool> columnHasNulls = {true, true};
+  std::vector<std::optional<uint32_t>> maxStringLengths = {
+      std::nullopt, std::nullopt};
+
+  auto sortLayout = PrefixSortLayout::generate(
+      keyTypes,
+      columnHasNulls,
+      compareFlags,
+      64,
+      8,
+      maxStringLengths,
+      {30, std::nullopt});
+  ASSERT_EQ(sortLayout.encodeSizes.size(), 1);
+  ASSERT_EQ(sortLayout.encodeSizes[0], 31);
+  ASSERT_LT(sortLayout.nonPrefixSortStartIndex, sortLayout.numNormalizedKeys);
+
+  // The longer prefix is cut to the normalized key size.
+  sortLayout = PrefixSortLayout::generate(
+      keyTypes,
+      columnHasNulls,
+      compareFlags,
+      24,
+      8,
+      maxStringLengths,
+      {30, std::nullopt});
+  ASSERT_EQ(sortLayout.encodeSizes.size(), 1);
+  ASSERT_EQ(sortLayout.encodeSizes[0], 24);
+
+  // A string key stored whole is followed by the next key.
+  maxStringLengths = {20, std::nullopt};
+  sortLayout = PrefixSortLayout::generate(
+      keyTypes,
+      columnHasNulls,
+      compareFlags,
+      64,
+      8,
+      maxStringLengths,
+      {20, std::nullopt});
+  ASSERT_FALSE(sortLayout.hasNonNormalizedKey);
+  ASSERT_EQ(sortLayout.nonPrefixSortStartIndex, sortLayout.numNormalizedKeys);
+  ASSERT_EQ(sortLayout.encodeSizes.size(), 2);
+  ASSERT_EQ(sortLayout.encodeSizes[0], 21);
+  ASSERT_EQ(sortLayout.encodeSizes[1], 9);
+}
+
+TEST_F(PrefixSortTest, longStringPrefix) {
+  // Keys share a 24 byte prefix, so they all tie on a short string prefix.
+  // One long key makes the prefix length be picked from a sample unless the
+  // longer prefix can hold all of the key.
+  const auto makeKey = [](auto row) {
+    if (row == 500) {
+      return std::string(200, 'x');
+    }
+    return fmt::format("https://www.example.com/{:08}/{}", row % 37, row);
+  };
+  const auto data = makeRowVector({
+      makeFlatVector<std::string>(1'000, makeKey, nullEvery(17)),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 11; }),
+      makeFlatVector<std::string>(
+          1'000, [](auto row) { return fmt::format("t{}", row % 5); }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+
+  for (const uint32_t maxAdaptiveStringPrefixLength : {0, 48, 1024}) {
+    SCOPED_TRACE(fmt::format(
+        "maxAdaptiveStringPrefixLength {}", maxAdaptiveStringPrefixLength));
+    const common::PrefixSortConfig config{
+        1024, 0, 12, maxAdaptiveStringPrefixLength};
+    testPrefixSort({kAsc, kDesc}, data, config);
+    testPrefixSort({kDesc, kAsc}, data, config);
+    testPrefixSort({kAsc, kAsc, kDesc}, data, config);
+    testPrefixSort({kDesc, kAsc, kAsc}, data, config);
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::exec::prefixsort::test
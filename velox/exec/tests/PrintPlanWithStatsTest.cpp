@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -414,3 +415,34 @@ TEST_F(PrintPlanWithStatsTest, taskAPI) {
   ASSERT_TRUE(waitForTaskAborted(task.get()));
   checkOutput(task.get());
 }
+
+TEST_F(PrintPlanWithStatsTest, perfCounters) {
+  if (!process::readThreadPerfCounters().has_value()) {
+    GTEST_SKIP() << "Hardware performance counters are not available";
+  }
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, folly::identity),
+  });
+  core::PlanNodeId projectId;
+  const auto plan = PlanBuilder()
+                        .values({data})
+                        .project({"c0 * 2 + 1"})
+                        .capturePlanNodeId(projectId)
+                        .planNode();
+
+  std::shared_ptr<exec::Task> task;
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kOperatorTrackPerfCounters, "true")
+      .copyResults(pool(), task);
+  const auto stats = exec::toPlanStats(task->taskStats()).at(projectId);
+  ASSERT_GT(stats.perfCounters.cycles, 0);
+  ASSERT_GT(stats.perfCounters.instructions, 0);
+  ASSERT_NE(
+      printPlanWithStats(*plan, task->taskStats()).find("Hardware counters: "),
+      std::string::npos);
+
+  // Not collected by default.
+  AssertQueryBuilder(plan).copyResults(pool(), task);
+  ASSERT_TRUE(
+      exec::toPlanStats(task->taskStats()).at(projectId).perfCounters.empty());
+}
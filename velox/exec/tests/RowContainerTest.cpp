@@ -1028,6 +1028,56 @@ TEST_F(RowContainerTest, extractWithNullsAndTargetOffset) {
   }
 }
 
+TEST_F(RowContainerTest, extractFixedWidthWithMissingRows) {
+  // Not a multiple of the SIMD width so that the tail is covered too.
+  constexpr int32_t kNumRows = 37;
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return row * 3; }, nullEvery(5)),
+      makeFlatVector<double>(kNumRows, [](auto row) { return row * 1.5; }),
+  });
+  auto data = makeRowContainer({}, {BIGINT(), DOUBLE()});
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+  }
+  SelectivityVector allRows(kNumRows);
+  for (auto column = 0; column < batch->childrenSize(); ++column) {
+    DecodedVector decoded(*batch->childAt(column), allRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      data->store(decoded, i, rows[i], column);
+    }
+  }
+
+  // Null row pointers, as for join misses, extract as nulls.
+  auto withMisses = rows;
+  for (auto i = 0; i < kNumRows; i += 7) {
+    withMisses[i] = nullptr;
+  }
+
+  constexpr int32_t kResultOffset = 3;
+  for (auto column = 0; column < batch->childrenSize(); ++column) {
+    auto result = BaseVector::create(
+        batch->childAt(column)->type(), kNumRows + kResultOffset, pool());
+    RowContainer::extractColumn(
+        withMisses.data(),
+        kNumRows,
+        data->columnAt(column),
+        data->columnHasNulls(column),
+        kResultOffset,
+        result);
+    for (auto i = 0; i < kNumRows; ++i) {
+      if (withMisses[i] == nullptr) {
+        ASSERT_TRUE(result->isNullAt(i + kResultOffset)) << i;
+      } else {
+        ASSERT_TRUE(result->equalValueAt(
+            batch->childAt(column).get(), i + kResultOffset, i))
+            << i;
+      }
+    }
+  }
+}
+
 TEST_F(RowContainerTest, storeExtractArrayOfVarchar) {
   // Make a string vector with two rows each having 2 elements.
   // Here it is important, that one of the 1st row's elements has more than 12
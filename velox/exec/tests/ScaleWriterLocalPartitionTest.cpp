@@ -909,6 +909,90 @@ TEST_F(ScaleWriterLocalPartitionTest, partitionBasic) {
   }
 }
 
+TEST_F(ScaleWriterLocalPartitionTest, partitionMinWriterBytes) {
+  const uint32_t maxDrivers = 32;
+  const uint32_t maxExchanegBufferSize = 2 << 20;
+  const std::vector<int32_t> partitionKeys{1, 2, 3, 4, 5, 6, 7, 8};
+
+  for (const uint32_t numProducers : {1, 4}) {
+    SCOPED_TRACE(fmt::format("numProducers {}", numProducers));
+    Operator::unregisterAllOperators();
+
+    const std::vector<RowVectorPtr> inputVectors =
+        makeVectors(32, 2048, partitionKeys);
+
+    auto testController = std::make_shared<TestExchangeController>(
+        numProducers,
+        32,
+        0,
+        0.8,
+        0.6,
+        std::nullopt,
+        std::nullopt,
+        inputVectors);
+    Operator::registerOperator(
+        std::make_unique<FakeWriteNodeFactory>(testController));
+    Operator::registerOperator(
+        std::make_unique<FakeSourceNodeFactory>(testController));
+
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId exchnangeNodeId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .addNode([&](const core::PlanNodeId& id,
+                                 const core::PlanNodePtr& input) {
+                      return std::make_shared<FakeSourceNode>(id, rowType_);
+                    })
+                    .scaleWriterlocalPartition({partitionColumnName()})
+                    .capturePlanNodeId(exchnangeNodeId)
+                    .addNode([](const core::PlanNodeId& id,
+                                const core::PlanNodePtr& input) {
+                      return std::make_shared<FakeWriteNode>(id, input);
+                    })
+                    .planNode();
+    testController->setExchangeNodeId(exchnangeNodeId);
+
+    AssertQueryBuilder queryBuilder(plan);
+    std::shared_ptr<Task> task;
+    const auto result =
+        queryBuilder.maxDrivers(maxDrivers)
+            .config(
+                core::QueryConfig::kMaxLocalExchangeBufferSize,
+                std::to_string(maxExchanegBufferSize))
+            .config(
+                core::QueryConfig::kScaleWriterMaxPartitionsPerWriter, "128")
+            .config(
+                core::QueryConfig::kScaleWriterRebalanceMaxMemoryUsageRatio,
+                "1.0")
+            .config(
+                core::QueryConfig::
+                    kScaleWriterMinProcessedBytesRebalanceThreshold,
+                "0")
+            .config(
+                core::QueryConfig::
+                    kScaleWriterMinPartitionProcessedBytesRebalanceThreshold,
+                "0")
+            .config(
+                core::QueryConfig::kScaleWriterMinPartitionWriterBytes,
+                std::to_string(1ULL << 30))
+            .copyResults(pool_.get(), task);
+    // The partitions are scaled but none of them receives enough data to
+    // move on from its first writer.
+    auto planStats = toPlanStats(task->taskStats());
+    ASSERT_GT(
+        planStats.at(exchnangeNodeId)
+            .customStats
+            .at(ScaleWriterPartitioningLocalPartition::kScaledPartitions)
+            .sum,
+        0);
+    verifyDisjointPartitionKeys(testController.get());
+    testController->clear();
+    task.reset();
+
+    verifyResults(inputVectors, {result});
+    waitForAllTasksToBeDeleted();
+  }
+}
+
 TEST_F(ScaleWriterLocalPartitionTest, partitionFuzzer) {
   const std::vector<RowVectorPtr> inputVectors =
       makeVectors(1024, 256, {1, 2, 3, 4, 5, 6, 7, 8});
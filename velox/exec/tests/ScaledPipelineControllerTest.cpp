@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/ScaledPipelineController.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+using DriverSignals = ScaledPipelineController::DriverSignals;
+
+// Signals of a driver that produced 'rows' rows in one second.
+DriverSignals cpuBound(uint64_t rows = 1'000) {
+  return {
+      .cpuNanos = 900'000'000,
+      .inputBlockedNanos = 100'000'000,
+      .outputBlockedNanos = 0,
+      .outputRows = rows,
+      .wallNanos = 1'000'000'000};
+}
+
+DriverSignals inputBound() {
+  return {
+      .cpuNanos = 100'000'000,
+      .inputBlockedNanos = 900'000'000,
+      .outputBlockedNanos = 0,
+      .outputRows = 100,
+      .wallNanos = 1'000'000'000};
+}
+
+DriverSignals outputBound() {
+  return {
+      .cpuNanos = 200'000'000,
+      .inputBlockedNanos = 0,
+      .outputBlockedNanos = 800'000'000,
+      .outputRows = 200,
+      .wallNanos = 1'000'000'000};
+}
+
+TEST(ScaledPipelineControllerTest, startsWithOneDriver) {
+  ScaledPipelineController controller(4);
+  ContinueFuture future;
+  ASSERT_FALSE(controller.shouldStop(0, &future));
+  ASSERT_FALSE(future.valid());
+  for (auto i = 1; i < 4; ++i) {
+    ContinueFuture parked;
+    ASSERT_TRUE(controller.shouldStop(i, &parked));
+    ASSERT_TRUE(parked.valid());
+    ASSERT_FALSE(parked.isReady());
+  }
+  ASSERT_EQ(controller.stats().numRunningDrivers, 1);
+  VELOX_ASSERT_THROW(controller.shouldStop(4, &future), "");
+
+  // Closing starts all the parked drivers.
+  ASSERT_TRUE(controller.close());
+  ASSERT_FALSE(controller.close());
+  ASSERT_FALSE(controller.shouldStop(3, &future));
+}
+
+TEST(ScaledPipelineControllerTest, scaleUpWhenCpuBound) {
+  ScaledPipelineController controller(3);
+  ContinueFuture parked;
+  ASSERT_TRUE(controller.shouldStop(1, &parked));
+
+  // An input bound driver does not scale up.
+  controller.updateAndTryScale(0, inputBound());
+  ASSERT_EQ(controller.stats().numRunningDrivers, 1);
+  ASSERT_FALSE(parked.isReady());
+
+  controller.updateAndTryScale(0, cpuBound());
+  ASSERT_EQ(controller.stats().numRunningDrivers, 2);
+  ASSERT_TRUE(parked.isReady());
+
+  // Decides again only once all the running drivers have reported.
+  controller.updateAndTryScale(0, cpuBound());
+  ASSERT_EQ(controller.stats().numRunningDrivers, 2);
+  controller.updateAndTryScale(1, cpuBound());
+  ASSERT_EQ(controller.stats().numRunningDrivers, 3);
+
+  controller.updateAndTryScale(0, cpuBound());
+  controller.updateAndTryScale(1, cpuBound());
+  controller.updateAndTryScale(2, cpuBound());
+  const auto stats = controller.stats();
+  ASSERT_EQ(stats.numRunningDrivers, 3);
+  ASSERT_EQ(stats.peakRunningDrivers, 3);
+  ASSERT_EQ(stats.numScaleDowns, 0);
+}
+
+TEST(ScaledPipelineControllerTest, stopScaleUpWithoutThroughputGain) {
+  ScaledPipelineController controller(4);
+  controller.updateAndTryScale(0, cpuBound(1'000));
+  ASSERT_EQ(controller.stats().numRunningDrivers, 2);
+
+  // The two drivers produce as many rows as one before the scale up.
+  controller.updateAndTryScale(0, cpuBound(500));
+  controller.updateAndTryScale(1, cpuBound(500));
+  ASSERT_EQ(controller.stats().numRunningDrivers, 2);
+
+  controller.updateAndTryScale(0, cpuBound(2'000));
+  controller.updateAndTryScale(1, cpuBound(2'000));
+  ASSERT_EQ(controller.stats().numRunningDrivers, 2);
+  ASSERT_EQ(controller.stats().peakRunningDrivers, 2);
+}
+
+TEST(ScaledPipelineControllerTest, scaleDownWhenOutputBound) {
+  ScaledPipelineController controller(2);
+  controller.updateAndTryScale(0, cpuBound(1'000));
+  ASSERT_EQ(controller.stats().numRunningDrivers, 2);
+
+  controller.updateAndTryScale(0, outputBound());
+  controller.updateAndTryScale(1, outputBound());
+  ASSERT_EQ(controller.stats().numRunningDrivers, 1);
+  ASSERT_EQ(controller.stats().numScaleDowns, 1);
+
+  // The scaled down driver parks at its next request for input and its
+  // reports are ignored.
+  controller.updateAndTryScale(1, cpuBound());
+  ASSERT_EQ(controller.stats().numRunningDrivers, 1);
+  ContinueFuture parked;
+  ASSERT_TRUE(controller.shouldStop(1, &parked));
+
+  // The last running driver is never parked.
+  controller.updateAndTryScale(0, outputBound());
+  ASSERT_EQ(controller.stats().numRunningDrivers, 1);
+
+  controller.updateAndTryScale(0, cpuBound());
+  ASSERT_EQ(controller.stats().numRunningDrivers, 2);
+  ASSERT_TRUE(parked.isReady());
+  ASSERT_EQ(controller.stats().peakRunningDrivers, 2);
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SmallHashMap.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+
+namespace facebook::velox::aggregate::prestosql {
+namespace {
+
+class SmallHashMapTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Inserts 'numInserts' random keys out of 'numKeys' and compares the map
+  // with std::unordered_map after each insert.
+  template <typename K>
+  void testRandom(int32_t numInserts, int32_t numKeys) {
+    SCOPED_TRACE(fmt::format("{} inserts of {} keys", numInserts, numKeys));
+    SmallHashMap<K, int32_t> map(allocator_.get());
+    std::unordered_map<K, int32_t> expected;
+    std::vector<K> insertionOrder;
+    std::mt19937 rng(numInserts);
+    for (auto i = 0; i < numInserts; ++i) {
+      // Multiples of 1024 collide in the low bits without hash mixing.
+      const K key = static_cast<K>(rng() % numKeys) * 1024;
+      const auto [it, inserted] = map.insert({key, (int32_t)expected.size()});
+      ASSERT_EQ(
+          inserted, expected.emplace(key, (int32_t)expected.size()).second);
+      if (inserted) {
+        insertionOrder.push_back(key);
+      }
+      ASSERT_EQ(key, it->first);
+      ASSERT_EQ(expected[key], it->second);
+      ASSERT_EQ(expected.size(), map.size());
+    }
+
+    int32_t index = 0;
+    for (const auto& [key, value] : map) {
+      ASSERT_EQ(insertionOrder[index], key);
+      ASSERT_EQ(index, value);
+      ++index;
+    }
+    ASSERT_EQ(expected.size(), index);
+
+    for (auto i = 0; i < numKeys; ++i) {
+      const K key = static_cast<K>(i) * 1024;
+      ASSERT_EQ(expected.count(key) > 0, map.contains(key));
+    }
+    ASSERT_FALSE(map.contains(-1));
+    ASSERT_TRUE(map.find(-1) == map.end());
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+  std::unique_ptr<HashStringAllocator> allocator_{
+      std::make_unique<HashStringAllocator>(pool_.get())};
+};
+
+TEST_F(SmallHashMapTest, random) {
+  for (auto numInserts : {0, 1, 2, 3, 5, 17, 1'000, 100'000}) {
+    for (auto numKeys : {1, 3, 8, 100, 1'000'000}) {
+      testRandom<int64_t>(numInserts, numKeys);
+      testRandom<int32_t>(numInserts, numKeys);
+      testRandom<int16_t>(numInserts, std::min(numKeys, 32));
+    }
+  }
+  ASSERT_EQ(0, allocator_->currentBytes());
+}
+
+TEST_F(SmallHashMapTest, inlineEntries) {
+  // A few small entries fit in the map and allocate no memory.
+  SmallHashMap<int32_t, int32_t> map(allocator_.get());
+  map[1] = 10;
+  map[2] = 20;
+  ASSERT_EQ(2, map.size());
+  ASSERT_EQ(0, allocator_->currentBytes());
+
+  for (auto i = 3; i <= 100; ++i) {
+    map[i] = i * 10;
+  }
+  ASSERT_GT(allocator_->currentBytes(), 0);
+  for (auto i = 1; i <= 100; ++i) {
+    ASSERT_EQ(i * 10, map[i]);
+  }
+  ASSERT_EQ(100, map.size());
+}
+
+TEST_F(SmallHashMapTest, customHash) {
+  struct Mod10Hash {
+    size_t operator()(int64_t value) const {
+      return value % 10;
+    }
+  };
+  struct Mod10EqualTo {
+    bool operator()(int64_t left, int64_t right) const {
+      return left % 10 == right % 10;
+    }
+  };
+  SmallHashMap<int64_t, int64_t, Mod10Hash, Mod10EqualTo> map(
+      allocator_.get(), Mod10Hash{}, Mod10EqualTo{});
+  for (auto i = 0; i < 1'000; ++i) {
+    ++map[i];
+  }
+  ASSERT_EQ(10, map.size());
+  for (const auto& [key, count] : map) {
+    ASSERT_LT(key, 10);
+    ASSERT_EQ(100, count);
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::aggregate::prestosql
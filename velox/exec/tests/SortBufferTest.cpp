@@ -275,6 +275,64 @@ TEST_P(SortBufferTest, multipleKeys) {
 }
 
 // TODO: enable it later with test utility to compare the sorted result.
+TEST_P(SortBufferTest, parallelSort) {
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < 4; ++i) {
+    inputs.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(16 << 10, [](auto row) { return row; }),
+         makeFlatVector<int32_t>(
+             16 << 10,
+             [&](auto /*row*/) { return folly::Random::rand32(rng_); }),
+         makeFlatVector<int16_t>(16 << 10, [](auto row) { return row; }),
+         makeFlatVector<float>(16 << 10, [](auto row) { return row; }),
+         makeFlatVector<double>(
+             16 << 10,
+             [&](auto /*row*/) { return folly::Random::rand32(rng_) % 100; },
+             nullEvery(11)),
+         makeFlatVector<std::string>(
+             16 << 10, [](auto row) { return std::to_string(row); })}));
+  }
+
+  const auto sort = [&](uint32_t maxParallelSortRuns) {
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_,
+        prefixSortConfig_,
+        nullptr,
+        nullptr,
+        executor_.get(),
+        maxParallelSortRuns);
+    for (const auto& input : inputs) {
+      sortBuffer->addInput(input);
+    }
+    sortBuffer->noMoreInput();
+    std::vector<RowVectorPtr> outputs;
+    while (auto output = sortBuffer->getOutput(10'000)) {
+      outputs.push_back(std::static_pointer_cast<RowVector>(
+          BaseVector::copy(*output, pool_.get())));
+    }
+    return outputs;
+  };
+
+  // Rows with equal keys may come out in a different order, so only the sort
+  // keys are compared.
+  const auto expected = sort(1);
+  for (uint32_t maxParallelSortRuns : {2, 3, 4, 16}) {
+    SCOPED_TRACE(fmt::format("maxParallelSortRuns {}", maxParallelSortRuns));
+    const auto actual = sort(maxParallelSortRuns);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (auto i = 0; i < expected.size(); ++i) {
+      for (auto channel : sortColumnIndices_) {
+        assertEqualVectors(
+            expected[i]->childAt(channel), actual[i]->childAt(channel));
+      }
+    }
+  }
+}
+
 TEST_P(SortBufferTest, DISABLED_randomData) {
   struct {
     RowTypePtr inputType;
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -233,7 +234,10 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
         compressionKind_,
         prefixSortConfig,
         pool(),
-        &spillStats_);
+        &spillStats_,
+        /*fileCreateConfig=*/{},
+        writeExecutor_,
+        compressionDictionarySize_);
     ASSERT_EQ(targetFileSize, state_->targetFileSize());
     ASSERT_EQ(numPartitions, state_->maxPartitions());
     ASSERT_EQ(spillStats_.rlock()->spilledPartitions, 0);
@@ -421,8 +425,12 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
       ASSERT_EQ(state_->numFinishedFiles(partition), 0);
       auto spillPartition =
           SpillPartition(SpillPartitionId{0, partition}, std::move(spillFiles));
-      auto merge =
-          spillPartition.createOrderedReader(1 << 20, pool(), &spillStats_);
+      auto merge = spillPartition.createOrderedReader(
+          readBufferSize_,
+          pool(),
+          &spillStats_,
+          readAheadExecutor_,
+          numReadAheadBuffers_);
       int numReadBatches = 0;
       // We expect all the rows in dense increasing order.
       for (auto i = 0; i < numBatches * numRowsPerBatch; ++i) {
@@ -500,6 +508,11 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
 
   folly::Random::DefaultGenerator rng_;
   std::shared_ptr<TempDirectoryPath> tempDir_;
+  folly::Executor* writeExecutor_{nullptr};
+  uint32_t compressionDictionarySize_{0};
+  uint64_t readBufferSize_{1 << 20};
+  folly::Executor* readAheadExecutor_{nullptr};
+  uint32_t numReadAheadBuffers_{0};
   memory::MemoryAllocator* allocator_;
   common::CompressionKind compressionKind_;
   bool enablePrefixSort_;
@@ -611,6 +624,55 @@ TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   spillStateTest(1, 2, 8, 8, {}, 8 * 2);
 }
 
+TEST_P(SpillTest, asyncWrite) {
+  folly::CPUThreadPoolExecutor executor(4);
+  writeExecutor_ = &executor;
+  SCOPE_EXIT {
+    writeExecutor_ = nullptr;
+  };
+  // A zero write buffer size flushes on every append, so the writes of each
+  // batch overlap with serializing the next one.
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+  spillStateTest(kGB, 2, 8, 8, {}, 8);
+  // A new file on each batch write waits for the write in flight first.
+  spillStateTest(1, 2, 8, 1, {CompareFlags{false, true}}, 8 * 2);
+  spillStateTest(1, 2, 8, 8, {}, 8 * 2);
+}
+
+TEST_P(SpillTest, compressionDictionary) {
+  compressionDictionarySize_ = 16 << 10;
+  SCOPE_EXIT {
+    compressionDictionarySize_ = 0;
+  };
+  // Each partition writer trains a dictionary on its first flush and the
+  // readers decompress both the pages compressed before and after it.
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+  spillStateTest(1, 2, 8, 8, {}, 8 * 2);
+}
+
+TEST_P(SpillTest, readAhead) {
+  folly::CPUThreadPoolExecutor executor(4);
+  // A small read buffer size to read each spill file in many reads.
+  readBufferSize_ = 256;
+  SCOPE_EXIT {
+    readBufferSize_ = 1 << 20;
+    readAheadExecutor_ = nullptr;
+    numReadAheadBuffers_ = 0;
+  };
+  for (const auto numReadAheadBuffers : {0, 1, 4, 1'000}) {
+    for (const bool hasExecutor : {false, true}) {
+      SCOPED_TRACE(fmt::format(
+          "numReadAheadBuffers: {}, hasExecutor: {}",
+          numReadAheadBuffers,
+          hasExecutor));
+      numReadAheadBuffers_ = numReadAheadBuffers;
+      readAheadExecutor_ = hasExecutor ? &executor : nullptr;
+      spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+      spillStateTest(1, 2, 8, 8, {}, 8 * 2);
+    }
+  }
+}
+
 TEST_P(SpillTest, spillPartitionId) {
   SpillPartitionId partitionId1_2(1, 2);
   ASSERT_EQ(partitionId1_2.partitionBitOffset(), 1);
@@ -376,6 +376,158 @@ TEST_F(TableScanTest, connectorStats) {
   verifyCacheStats(hiveConnector->fileHandleCacheStats(), 49, 49, 98);
 }
 
+TEST_F(TableScanTest, preopenSplits) {
+  auto hiveConnector =
+      std::dynamic_pointer_cast<connector::hive::HiveConnector>(
+          connector::getConnector(kHiveConnectorId));
+  const auto startStats = hiveConnector->fileHandleCacheStats();
+
+  constexpr int32_t kNumFiles = 10;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < kNumFiles; ++i) {
+    auto data = makeVectors(1, 10);
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), data);
+    vectors.push_back(data[0]);
+  }
+  createDuckDbTable(vectors);
+
+  AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+      .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "0")
+      .config(core::QueryConfig::kMaxSplitPreopenPerDriver, "4")
+      .splits(makeHiveConnectorSplits(filePaths))
+      .assertResults("SELECT * FROM tmp");
+
+  // Each file is opened once by the preopen and looked up once more by the
+  // scan. The preopens run in the background and may finish after the query.
+  uint64_t numLookups{0};
+  for (auto i = 0; i < 1'000; ++i) {
+    numLookups = hiveConnector->fileHandleCacheStats().numLookups -
+        startStats.numLookups;
+    if (numLookups == 2 * kNumFiles) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  ASSERT_EQ(numLookups, 2 * kNumFiles);
+  ASSERT_EQ(
+      hiveConnector->fileHandleCacheStats().curSize - startStats.curSize,
+      kNumFiles);
+}
+
+TEST_F(TableScanTest, fragmentResultCache) {
+  constexpr int32_t kNumFiles = 4;
+  auto filePaths = makeFilePaths(kNumFiles);
+  auto vectors = makeVectors(kNumFiles, 1'000);
+  for (auto i = 0; i < kNumFiles; ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto makeSplits = [&](std::optional<int64_t> modificationTime) {
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      splits.push_back(
+          HiveConnectorSplitBuilder(filePath->getPath())
+              .fileProperties({.modificationTime = modificationTime})
+              .build());
+    }
+    return splits;
+  };
+
+  core::PlanNodeId scanNodeId;
+  const auto plan = PlanBuilder()
+                        .tableScan(rowType_)
+                        .capturePlanNodeId(scanNodeId)
+                        .filter("c0 % 3 <> 0")
+                        .partialAggregation({"c5"}, {"sum(c1)", "count(1)"})
+                        .finalAggregation()
+                        .planNode();
+  auto runQuery = [&](std::optional<int64_t> modificationTime) {
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kFragmentResultCacheEnabled, true)
+            .splits(makeSplits(modificationTime))
+            .assertResults(
+                "SELECT c5, sum(c1), count(1) FROM tmp WHERE c0 % 3 <> 0 GROUP BY c5");
+    return toPlanStats(task->taskStats()).at(scanNodeId).customStats;
+  };
+
+  auto stats = runQuery(1);
+  ASSERT_EQ(stats.count(TableScan::kFragmentResultCacheHits), 0);
+  ASSERT_EQ(stats.at(TableScan::kFragmentResultCacheMisses).sum, kNumFiles);
+
+  // The same fragment over the unchanged files reads none of them.
+  stats = runQuery(1);
+  ASSERT_EQ(stats.at(TableScan::kFragmentResultCacheHits).sum, kNumFiles);
+  ASSERT_EQ(stats.count(TableScan::kFragmentResultCacheMisses), 0);
+
+  // A file modified since is read again.
+  stats = runQuery(2);
+  ASSERT_EQ(stats.count(TableScan::kFragmentResultCacheHits), 0);
+  ASSERT_EQ(stats.at(TableScan::kFragmentResultCacheMisses).sum, kNumFiles);
+
+  // The results of splits without a modification time are not cached.
+  stats = runQuery(std::nullopt);
+  ASSERT_EQ(stats.count(TableScan::kFragmentResultCacheHits), 0);
+  ASSERT_EQ(stats.count(TableScan::kFragmentResultCacheMisses), 0);
+}
+
+TEST_F(TableScanTest, fragmentResultCacheMixedSplits) {
+  constexpr int32_t kNumFiles = 4;
+  auto filePaths = makeFilePaths(kNumFiles);
+  auto vectors = makeVectors(kNumFiles, 1'000);
+  for (auto i = 0; i < kNumFiles; ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId scanNodeId;
+  const auto plan = PlanBuilder()
+                        .tableScan(rowType_)
+                        .capturePlanNodeId(scanNodeId)
+                        .partialAggregation({"c5"}, {"sum(c1)", "count(1)"})
+                        .finalAggregation()
+                        .planNode();
+  // Splits without a modification time cannot be cached.
+  auto runQuery =
+      [&](const std::vector<std::optional<int64_t>>& modificationTimes) {
+        std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+        for (auto i = 0; i < kNumFiles; ++i) {
+          splits.push_back(
+              HiveConnectorSplitBuilder(filePaths[i]->getPath())
+                  .fileProperties({.modificationTime = modificationTimes[i]})
+                  .build());
+        }
+        auto task =
+            AssertQueryBuilder(plan, duckDbQueryRunner_)
+                .config(core::QueryConfig::kFragmentResultCacheEnabled, true)
+                .maxDrivers(1)
+                .splits(std::move(splits))
+                .assertResults(
+                    "SELECT c5, sum(c1), count(1) FROM tmp GROUP BY c5");
+        return toPlanStats(task->taskStats()).at(scanNodeId).customStats;
+      };
+
+  // The groups of the first split stay in the aggregation after the split
+  // ends. Caching stops, so that they do not go into the results of the next
+  // split and are not counted again by a later hit on it.
+  for (auto i = 0; i < 2; ++i) {
+    auto stats = runQuery({std::nullopt, 1, 1, 1});
+    ASSERT_EQ(stats.count(TableScan::kFragmentResultCacheHits), 0);
+    ASSERT_EQ(stats.count(TableScan::kFragmentResultCacheMisses), 0);
+  }
+
+  // Splits before the first one that cannot be cached are still cached.
+  auto stats = runQuery({1, 1, std::nullopt, 1});
+  ASSERT_EQ(stats.count(TableScan::kFragmentResultCacheHits), 0);
+  ASSERT_EQ(stats.at(TableScan::kFragmentResultCacheMisses).sum, 2);
+  stats = runQuery({1, 1, std::nullopt, 1});
+  ASSERT_EQ(stats.at(TableScan::kFragmentResultCacheHits).sum, 2);
+  ASSERT_EQ(stats.count(TableScan::kFragmentResultCacheMisses), 0);
+}
+
 TEST_F(TableScanTest, columnAliases) {
   auto vectors = makeVectors(1, 1'000);
   auto filePath = TempFilePath::create();
@@ -1412,6 +1564,37 @@ TEST_F(TableScanTest, count) {
   EXPECT_EQ(numRead, 10'000);
 }
 
+TEST_F(TableScanTest, countFromMetadata) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  // No columns are read and there are no filters, so the rows of each split
+  // are counted from the stripe metadata.
+  auto plan = PlanBuilder()
+                  .tableScan(ROW({}, {}))
+                  .singleAggregation({}, {"count(1)"})
+                  .planNode();
+  for (auto numSplits : {1, 3}) {
+    SCOPED_TRACE(fmt::format("numSplits: {}", numSplits));
+    auto splits = makeHiveConnectorSplits(
+        filePath->getPath(), numSplits, dwio::common::FileFormat::DWRF);
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .splits(std::vector<std::shared_ptr<connector::ConnectorSplit>>(
+            splits.begin(), splits.end()))
+        .assertResults("SELECT count(*) FROM tmp");
+  }
+
+  // A filter on a column that is not projected drops rows, so the rows are
+  // read.
+  plan = PlanBuilder()
+             .tableScan(ROW({}, {}), {"c0 > 0"}, "", rowType_)
+             .singleAggregation({}, {"count(1)"})
+             .planNode();
+  assertQuery(plan, {filePath}, "SELECT count(*) FROM tmp WHERE c0 > 0");
+}
+
 TEST_F(TableScanTest, batchSize) {
   // Make a wide row of many BIGINT columns to ensure that row size is
   // larger than 1KB.
@@ -3595,6 +3778,60 @@ TEST_F(TableScanTest, remainingFilterSkippedStrides) {
   EXPECT_EQ(skippedStrides.sum, 1);
 }
 
+TEST_F(TableScanTest, topNDynamicFilter) {
+  for (const bool ascending : {true, false}) {
+    SCOPED_TRACE(fmt::format("ascending {}", ascending));
+    // The first file has the best keys, so once TopN holds the top rows of
+    // the first file the keys in the other files do not pass the filter.
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < 10; ++i) {
+      const auto base = (ascending ? i : 9 - i) * 1'000;
+      vectors.push_back(makeRowVector({
+          makeFlatVector<int64_t>(1'000, [&](auto row) { return base + row; }),
+          makeFlatVector<Timestamp>(
+              1'000, [&](auto row) { return Timestamp(base + row, 0); }),
+      }));
+    }
+    auto filePaths = makeFilePaths(vectors.size());
+    for (auto i = 0; i < vectors.size(); ++i) {
+      writeToFile(filePaths[i]->getPath(), vectors[i]);
+    }
+    createDuckDbTable(vectors);
+
+    for (const auto& key : {"c0", "c1"}) {
+      SCOPED_TRACE(key);
+      const auto order = fmt::format("{} {}", key, ascending ? "ASC" : "DESC");
+      core::PlanNodeId scanNodeId;
+      core::PlanNodeId topNNodeId;
+      const auto plan = PlanBuilder()
+                            .tableScan(asRowType(vectors[0]->type()))
+                            .capturePlanNodeId(scanNodeId)
+                            .topN({order}, 100, false)
+                            .capturePlanNodeId(topNNodeId)
+                            .planNode();
+      const auto sql =
+          fmt::format("SELECT * FROM tmp ORDER BY {} LIMIT 100", order);
+
+      auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                      .splits(makeHiveConnectorSplits(filePaths))
+                      .assertResults(sql);
+      auto scanStats = toPlanStats(task->taskStats()).at(scanNodeId);
+      ASSERT_EQ(scanStats.outputRows, 1'000);
+      ASSERT_EQ(
+          scanStats.dynamicFilterStats.producerNodeIds,
+          std::unordered_set<core::PlanNodeId>({topNNodeId}));
+
+      task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                 .config(core::QueryConfig::kTopNDynamicFilterEnabled, false)
+                 .splits(makeHiveConnectorSplits(filePaths))
+                 .assertResults(sql);
+      scanStats = toPlanStats(task->taskStats()).at(scanNodeId);
+      ASSERT_EQ(scanStats.outputRows, 10'000);
+      ASSERT_TRUE(scanStats.dynamicFilterStats.empty());
+    }
+  }
+}
+
 TEST_F(TableScanTest, skipStridesForParentNulls) {
   auto b = makeFlatVector<int64_t>(10'000, folly::identity);
   auto a = makeRowVector({"b"}, {b}, [](auto i) { return i % 2 == 0; });
@@ -3825,6 +4062,56 @@ TEST_F(TableScanTest, aggregationPushdown) {
   EXPECT_EQ(0, loadedToValueHook(task));
 }
 
+TEST_F(TableScanTest, globalAggregationPushdown) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  auto loadedToValueHook = [](const std::shared_ptr<Task> task) {
+    auto stats =
+        task->taskStats().pipelineStats[0].operatorStats[1].runtimeStats;
+    auto it = stats.find("loadedToValueHook");
+    return it != stats.end() ? it->second.sum : 0;
+  };
+
+  auto op = PlanBuilder()
+                .tableScan(rowType_)
+                .singleAggregation(
+                    {},
+                    {"max(c0)",
+                     "sum(c1)",
+                     "min(c3)",
+                     "sum(c4)",
+                     "count(c5)",
+                     "count(c6)"})
+                .planNode();
+  auto task = assertQuery(
+      op,
+      {filePath},
+      "SELECT max(c0), sum(c1), min(c3), sum(c4), count(c5), count(c6) "
+      "FROM tmp");
+  // 6 aggregates processing 10K rows each via pushdown.
+  EXPECT_EQ(6 * 10'000, loadedToValueHook(task));
+
+  auto data = makeRowVector({
+      makeFlatVector<bool>(1'000, [](auto row) { return row % 7 != 0; }),
+      makeFlatVector<bool>(
+          1'000, [](auto row) { return row % 11 == 0; }, nullEvery(5)),
+  });
+  auto boolFilePath = TempFilePath::create();
+  writeToFile(boolFilePath->getPath(), {data});
+  createDuckDbTable({data});
+
+  op = PlanBuilder()
+           .tableScan(asRowType(data->type()))
+           .singleAggregation({}, {"bool_and(c0)", "bool_or(c1)"})
+           .planNode();
+  task = assertQuery(
+      op, {boolFilePath}, "SELECT bool_and(c0), bool_or(c1) FROM tmp");
+  EXPECT_EQ(2 * 1'000, loadedToValueHook(task));
+}
+
 TEST_F(TableScanTest, decimalDisableAggregationPushdown) {
   vector_size_t size = 1'000;
   auto rowVector = makeRowVector({
@@ -4921,6 +5208,94 @@ TEST_F(TableScanTest, partitionKeyNotMatchPartitionKeysHandle) {
   assertQuery(op, split, "SELECT c0 FROM tmp");
 }
 
+TEST_F(TableScanTest, partitionValueSplitPruning) {
+  auto vectors = makeVectors(1, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  // The file of the pruned split does not exist, so the query fails if the
+  // split is opened.
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits = {
+      exec::test::HiveConnectorSplitBuilder(filePath->getPath())
+          .partitionKey("ds", "2021-12-02")
+          .build(),
+      exec::test::HiveConnectorSplitBuilder("/path/to/nowhere")
+          .partitionKey("ds", "2021-12-03")
+          .build(),
+  };
+
+  ColumnHandleMap assignments = {
+      {"c0", regularColumn("c0", BIGINT())},
+      {"ds", partitionKey("ds", VARCHAR())}};
+  auto plan = PlanBuilder()
+                  .startTableScan()
+                  .outputType(ROW({"c0"}, {BIGINT()}))
+                  .assignments(assignments)
+                  .subfieldFilter("ds = '2021-12-02'")
+                  .endTableScan()
+                  .planNode();
+
+  auto task = OperatorTestBase::assertQuery(plan, splits, "SELECT c0 FROM tmp");
+  EXPECT_EQ(getSkippedSplitsStat(task), 1);
+  EXPECT_EQ(getTableScanRuntimeStats(task).at("prunedSplits").sum, 1);
+}
+
+TEST_F(TableScanTest, cachedStatsSplitPruning) {
+  resetHiveConnector(std::make_shared<config::ConfigBase>(
+      std::unordered_map<std::string, std::string>{
+          {connector::hive::HiveConfig::kFileStatsCacheEntries, "10"}}));
+  auto filePath = TempFilePath::create();
+  auto vector =
+      makeRowVector({makeFlatVector<int64_t>(1'000, folly::identity)});
+  writeToFile(filePath->getPath(), vector);
+  createDuckDbTable({vector});
+
+  auto makeSplit = [&](std::optional<int64_t> modificationTime) {
+    return exec::test::HiveConnectorSplitBuilder(filePath->getPath())
+        .fileProperties(
+            {.fileSize = static_cast<int64_t>(
+                 fs::file_size(filePath->getPath())),
+             .modificationTime = modificationTime})
+        .build();
+  };
+  auto assertQuery = [&](const std::string& filter,
+                         std::optional<int64_t> modificationTime) {
+    return TableScanTest::assertQuery(
+        PlanBuilder().tableScan(asRowType(vector->type()), {filter}).planNode(),
+        makeSplit(modificationTime),
+        "SELECT * FROM tmp WHERE " + filter);
+  };
+
+  // The first split of the file is skipped after opening the file.
+  auto task = assertQuery("c0 > 1000", 1);
+  EXPECT_EQ(getSkippedSplitsStat(task), 1);
+  EXPECT_EQ(getTableScanRuntimeStats(task).count("prunedSplits"), 0);
+
+  // The next splits of the file are skipped on the cached stats, also for
+  // other filters.
+  task = assertQuery("c0 > 1000", 1);
+  EXPECT_EQ(getSkippedSplitsStat(task), 1);
+  EXPECT_EQ(getTableScanRuntimeStats(task).at("prunedSplits").sum, 1);
+  task = assertQuery("c0 < 0", 1);
+  EXPECT_EQ(getTableScanRuntimeStats(task).at("prunedSplits").sum, 1);
+
+  // A split that may have matching rows is read.
+  task = assertQuery("c0 < 10", 1);
+  EXPECT_EQ(getTableScanRuntimeStats(task).count("skippedSplits"), 0);
+  EXPECT_EQ(getTableScanStats(task).outputRows, 10);
+
+  // A different version of the file does not use the cached stats.
+  task = assertQuery("c0 > 1000", 2);
+  EXPECT_EQ(getSkippedSplitsStat(task), 1);
+  EXPECT_EQ(getTableScanRuntimeStats(task).count("prunedSplits"), 0);
+
+  auto hiveConnector =
+      std::dynamic_pointer_cast<connector::hive::HiveConnector>(
+          connector::getConnector(kHiveConnectorId));
+  EXPECT_EQ(hiveConnector->fileStatsCacheStats().curSize, 2);
+}
+
 TEST_F(TableScanTest, readFlatMapAsStruct) {
   constexpr int kSize = 10;
   std::vector<std::string> keys = {"1", "2", "3"};
@@ -15,6 +15,8 @@
  */
 
 #include "velox/exec/Task.h"
+#include <folly/json.h>
+#include <numeric>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
@@ -1842,6 +1844,133 @@ TEST_F(TaskTest, spillDirectoryLifecycleManagement) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(TaskTest, multipleSpillDirectories) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 300; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  core::PlanNodeId aggrNodeId;
+  const auto plan = PlanBuilder()
+                        .values({data})
+                        .singleAggregation({"c0"}, {"sum(c1)"}, {})
+                        .capturePlanNodeId(aggrNodeId)
+                        .planNode();
+  for (const bool skipFullDisks : {false, true}) {
+    SCOPED_TRACE(fmt::format("skipFullDisks: {}", skipFullDisks));
+    CursorParameters params;
+    params.planNode = plan;
+    params.queryCtx = core::QueryCtx::create(driverExecutor_.get());
+    // If 'skipFullDisks', no disk has the min free space, so all are full
+    // and the directories are still used round-robin.
+    params.queryCtx->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kSpillEnabled, "true"},
+         {core::QueryConfig::kAggregationSpillEnabled, "true"},
+         {core::QueryConfig::kSpillDirectoryMinFreeBytes,
+          skipFullDisks ? std::to_string(std::numeric_limits<int64_t>::max())
+                        : "0"}});
+    params.maxDrivers = 1;
+
+    auto cursor = TaskCursor::create(params);
+    std::shared_ptr<Task> task = cursor->task();
+    auto rootTempDir = exec::test::TempDirectoryPath::create();
+    const std::vector<std::string> spillDirectories = {
+        rootTempDir->getPath() + "/disk0",
+        rootTempDir->getPath() + "/disk1",
+        rootTempDir->getPath() + "/disk2"};
+    task->setSpillDirectories(spillDirectories, false);
+    ASSERT_EQ(task->spillDirectory(), spillDirectories[0]);
+
+    TestScopedSpillInjection scopedSpillInjection(100);
+    while (cursor->moveNext()) {
+    }
+    ASSERT_TRUE(waitForTaskCompletion(task.get(), 5'000'000));
+    EXPECT_EQ(exec::TaskState::kFinished, task->state());
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    auto& stats = taskStats.at(aggrNodeId);
+    ASSERT_GT(stats.spilledRows, 0);
+
+    // The spill files are spread evenly across the directories.
+    const auto fileCounts = task->spillDirectoryFileCounts();
+    ASSERT_EQ(fileCounts.size(), spillDirectories.size());
+    const auto totalFiles =
+        std::accumulate(fileCounts.begin(), fileCounts.end(), 0UL);
+    ASSERT_EQ(totalFiles, stats.spilledFiles);
+    for (auto fileCount : fileCounts) {
+      ASSERT_GE(fileCount, totalFiles / spillDirectories.size());
+      ASSERT_LE(fileCount, totalFiles / spillDirectories.size() + 1);
+    }
+
+    cursor.reset(); // ensure 'task' has no other shared pointer.
+    task.reset();
+    waitForAllTasksToBeDeleted();
+    auto fs = filesystems::getFileSystem(rootTempDir->getPath(), nullptr);
+    for (const auto& spillDirectory : spillDirectories) {
+      ASSERT_FALSE(fs->exists(spillDirectory));
+    }
+  }
+}
+
+TEST_F(TaskTest, overflowSpillDirectory) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 300; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  core::PlanNodeId aggrNodeId;
+  const auto plan = PlanBuilder()
+                        .values({data})
+                        .singleAggregation({"c0"}, {"sum(c1)"}, {})
+                        .capturePlanNodeId(aggrNodeId)
+                        .planNode();
+  for (const bool localDiskFull : {false, true}) {
+    SCOPED_TRACE(fmt::format("localDiskFull: {}", localDiskFull));
+    CursorParameters params;
+    params.planNode = plan;
+    params.queryCtx = core::QueryCtx::create(driverExecutor_.get());
+    params.queryCtx->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kSpillEnabled, "true"},
+         {core::QueryConfig::kAggregationSpillEnabled, "true"},
+         {core::QueryConfig::kSpillDirectoryMinFreeBytes,
+          localDiskFull ? std::to_string(std::numeric_limits<int64_t>::max())
+                        : "1"}});
+    params.maxDrivers = 1;
+
+    auto cursor = TaskCursor::create(params);
+    std::shared_ptr<Task> task = cursor->task();
+    auto rootTempDir = exec::test::TempDirectoryPath::create();
+    const auto localDirectory = rootTempDir->getPath() + "/local";
+    // A local directory stands in for object storage.
+    const auto overflowDirectory = rootTempDir->getPath() + "/overflow";
+    task->setSpillDirectory(localDirectory, false);
+    task->setOverflowSpillDirectory(overflowDirectory);
+
+    TestScopedSpillInjection scopedSpillInjection(100);
+    while (cursor->moveNext()) {
+    }
+    ASSERT_TRUE(waitForTaskCompletion(task.get(), 5'000'000));
+    EXPECT_EQ(exec::TaskState::kFinished, task->state());
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    auto& stats = taskStats.at(aggrNodeId);
+    ASSERT_GT(stats.spilledRows, 0);
+
+    auto fs = filesystems::getFileSystem(rootTempDir->getPath(), nullptr);
+    if (localDiskFull) {
+      ASSERT_EQ(task->spillDirectoryFileCounts()[0], 0);
+      ASSERT_EQ(task->overflowSpillFileCount(), stats.spilledFiles);
+      ASSERT_TRUE(fs->exists(overflowDirectory));
+    } else {
+      ASSERT_EQ(task->spillDirectoryFileCounts()[0], stats.spilledFiles);
+      ASSERT_EQ(task->overflowSpillFileCount(), 0);
+      ASSERT_FALSE(fs->exists(overflowDirectory));
+    }
+
+    cursor.reset(); // ensure 'task' has no other shared pointer.
+    task.reset();
+    waitForAllTasksToBeDeleted();
+    ASSERT_FALSE(fs->exists(localDirectory));
+    ASSERT_FALSE(fs->exists(overflowDirectory));
+  }
+}
+
 TEST_F(TaskTest, spillDirNotCreated) {
   // Verify that no spill directory is created if spilling is not engaged.
   const std::vector<RowVectorPtr> probeVectors = {makeRowVector(
@@ -2442,4 +2571,96 @@ TEST_F(TaskTest, finishTiming) {
   ASSERT_GT(
       orderByStats.finishTiming.wallNanos, projectStats.finishTiming.wallNanos);
 }
+
+TEST_F(TaskTest, timeline) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  const auto plan =
+      PlanBuilder().values({data, data}).project({"c0 + 1 AS c1"}).planNode();
+
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan).copyResults(pool(), task);
+  ASSERT_EQ(task->timeline(), nullptr);
+
+  AssertQueryBuilder(plan)
+      .maxDrivers(2)
+      .config(core::QueryConfig::kTaskTimelineEnabled, true)
+      .copyResults(pool(), task);
+  const auto* timeline = task->timeline();
+  ASSERT_NE(timeline, nullptr);
+  ASSERT_EQ(timeline->numDropped(), 0);
+  const auto events = timeline->events();
+  std::unordered_map<std::string, int32_t> numEvents;
+  for (const auto& event : events) {
+    ++numEvents[fmt::format("{}.{}", event.category, event.name)];
+    if (std::string(event.category) == "operator") {
+      ASSERT_TRUE(event.durationUs.has_value());
+      ASSERT_NE(event.detail.find("FilterProject"), std::string::npos);
+    }
+  }
+  ASSERT_GE(numEvents["driver.enqueue"], 2);
+  ASSERT_GE(numEvents["driver.run"], 2);
+  ASSERT_GE(numEvents["operator.addInput"], 4);
+  ASSERT_GE(numEvents["operator.getOutput"], 4);
+
+  const auto trace =
+      folly::parseJson(timeline->toChromeTrace(task->taskId()));
+  ASSERT_EQ(trace["traceEvents"].size(), events.size() + 1);
+
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kTaskTimelineEnabled, true)
+      .config(core::QueryConfig::kTaskTimelineMaxEvents, 3)
+      .copyResults(pool(), task);
+  ASSERT_EQ(task->timeline()->events().size(), 3);
+  ASSERT_GT(task->timeline()->numDropped(), 0);
+}
+
+TEST_F(TaskTest, parallelDriverCreation) {
+  auto probe = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 100; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  auto build = makeRowVector(
+      {"u0"}, {makeFlatVector<int64_t>(50, [](auto row) { return row * 2; })});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinId;
+  core::PlanNodeId partitionId;
+  const auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values({probe}, true)
+          .filter("c1 % 3 <> 0")
+          .hashJoin(
+              {"c0"},
+              {"u0"},
+              PlanBuilder(planNodeIdGenerator)
+                  .values({build}, true)
+                  .planNode(),
+              "",
+              {"c0", "c1"})
+          .capturePlanNodeId(joinId)
+          .localPartition({"c0"})
+          .capturePlanNodeId(partitionId)
+          .singleAggregation({"c0"}, {"sum(c1)"})
+          .planNode();
+
+  std::shared_ptr<Task> task;
+  const auto expected =
+      AssertQueryBuilder(plan).maxDrivers(4).copyResults(pool(), task);
+  ASSERT_GT(expected->size(), 0);
+
+  const auto result =
+      AssertQueryBuilder(plan)
+          .maxDrivers(4)
+          .config(core::QueryConfig::kParallelDriverCreationEnabled, true)
+          .copyResults(pool(), task);
+  assertEqualResults({expected}, {result});
+
+  // The build and probe, and the producers and consumers of the local
+  // partition, each run on 4 drivers.
+  const auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(planStats.at(joinId).numDrivers, 8);
+  ASSERT_EQ(planStats.at(partitionId).numDrivers, 8);
+}
 } // namespace facebook::velox::exec::test
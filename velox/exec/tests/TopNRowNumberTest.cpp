@@ -172,6 +172,97 @@ TEST_F(TopNRowNumberTest, largeOutput) {
   testLimit(2000);
 }
 
+TEST_F(TopNRowNumberTest, rankAndDenseRank) {
+  // Sorting keys with many ties, so that peers of the last row within the
+  // limit span output batches and spill runs.
+  const vector_size_t size = 10'000;
+  auto data = split(
+      makeRowVector(
+          {"d", "p", "s"},
+          {
+              // Data.
+              makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+              // Partitioning key.
+              makeFlatVector<int16_t>(size, [](auto row) { return row % 7; }),
+              // Sorting key.
+              makeFlatVector<int32_t>(
+                  size,
+                  [](auto row) { return (row * 7) % 31; },
+                  nullEvery(97)),
+          }),
+      10);
+
+  createDuckDbTable(data);
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+
+  auto testLimit = [&](const std::string& function, auto limit) {
+    SCOPED_TRACE(fmt::format("{} <= {}", function, limit));
+    core::PlanNodeId topNRowNumberId;
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .topNRank(function, {"p"}, {"s"}, limit, true)
+                    .capturePlanNodeId(topNRowNumberId)
+                    .planNode();
+
+    auto sql = fmt::format(
+        "SELECT * FROM (SELECT *, {0}() over (partition by p order by s) as {0} FROM tmp) "
+        " WHERE {0} <= {1}",
+        function,
+        limit);
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+        .assertResults(sql);
+
+    // Spilling.
+    {
+      TestScopedSpillInjection scopedSpillInjection(100);
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+              .config(core::QueryConfig::kSpillEnabled, "true")
+              .config(core::QueryConfig::kTopNRowNumberSpillEnabled, "true")
+              .spillDirectory(spillDirectory->getPath())
+              .assertResults(sql);
+
+      auto taskStats = exec::toPlanStats(task->taskStats());
+      ASSERT_GT(taskStats.at(topNRowNumberId).spilledRows, 0);
+    }
+
+    // Do not emit ranks.
+    plan = PlanBuilder()
+               .values(data)
+               .topNRank(function, {"p"}, {"s"}, limit, false)
+               .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .assertResults(fmt::format(
+            "SELECT d, p, s FROM (SELECT *, {0}() over (partition by p order by s) as {0} FROM tmp) "
+            " WHERE {0} <= {1}",
+            function,
+            limit));
+
+    // No partitioning keys.
+    plan = PlanBuilder()
+               .values(data)
+               .topNRank(function, {}, {"s desc"}, limit, true)
+               .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+        .assertResults(fmt::format(
+            "SELECT * FROM (SELECT *, {0}() over (order by s desc) as {0} FROM tmp) "
+            " WHERE {0} <= {1}",
+            function,
+            limit));
+  };
+
+  for (const auto& function : {"rank", "dense_rank"}) {
+    testLimit(function, 1);
+    testLimit(function, 5);
+    testLimit(function, 50);
+    testLimit(function, 2000);
+  }
+}
+
 TEST_F(TopNRowNumberTest, manyPartitions) {
   const vector_size_t size = 10'000;
   auto data = split(
@@ -40,6 +40,19 @@ TEST_F(TreeOfLosersTest, merge) {
   testBoth(500, 1);
 }
 
+TEST_F(TreeOfLosersTest, runnerUp) {
+  for (const auto numStreams : {1, 2, 7, 16, 37}) {
+    SCOPED_TRACE(fmt::format("numStreams: {}", numStreams));
+    testRuns(makeTestData(100'000, numStreams), true);
+    for (const auto overlapPct : {0, 10, 100}) {
+      testRuns(
+          makeClusteredTestData(100'000, numStreams, overlapPct), true);
+      test<TreeOfLosers<TestingStream>>(
+          makeClusteredTestData(10'000, numStreams, overlapPct), true);
+    }
+  }
+}
+
 TEST_F(TreeOfLosersTest, nextWithEquals) {
   constexpr int32_t kNumStreams = 17;
   std::vector<std::vector<uint32_t>> streams(kNumStreams);
@@ -475,6 +475,75 @@ TEST_P(UnnestTest, batchSize) {
   ASSERT_EQ(expectedNumVectors, stats.at(unnestId).outputVectors);
 }
 
+TEST_P(UnnestTest, dictionaryOutput) {
+  // The unnested elements are wrapped in a dictionary over a slice of the
+  // elements instead of being copied.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .project({"c0", "sequence(c0, c0 + 2) as s"})
+                  .unnest({"c0"}, {"s"})
+                  .planNode();
+
+  auto [cursor, results] =
+      readCursor(makeCursorParameters(plan), [](Task*) {});
+  ASSERT_GT(results.size(), 1);
+  for (const auto& result : results) {
+    const auto& elements = result->childAt(1);
+    ASSERT_EQ(elements->encoding(), VectorEncoding::Simple::DICTIONARY);
+    ASSERT_LE(elements->valueVector()->size(), result->size());
+  }
+  assertEqualResults(
+      {makeRowVector({
+          makeFlatVector<int64_t>(3'000, [](auto row) { return row / 3; }),
+          makeFlatVector<int64_t>(
+              3'000, [](auto row) { return row / 3 + row % 3; }),
+      })},
+      results);
+}
+
+TEST_P(UnnestTest, memoryPressureBatchSize) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .project({"sequence(1, 3) as s"})
+                  .unnest({}, {"s"})
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(1'000 * 3, [](auto row) { return 1 + row % 3; }),
+  });
+
+  // Any reservation of the query pool is above the threshold, so the output
+  // batches are smaller than 'batchSize_'.
+  constexpr int64_t kQueryCapacity = 4 << 20;
+  auto queryCtx = core::QueryCtx::create(
+      executor_.get(),
+      core::QueryConfig(std::unordered_map<std::string, std::string>{
+          {core::QueryConfig::kPreferredOutputBatchRows,
+           std::to_string(batchSize_)},
+          {core::QueryConfig::kMemoryPressureBatchSizingThreshold,
+           "0.000001"}}));
+  queryCtx->testingOverrideMemoryPool(memory::memoryManager()->addRootPool(
+      queryCtx->queryId(), kQueryCapacity));
+
+  auto task =
+      AssertQueryBuilder(plan).queryCtx(queryCtx).assertResults({expected});
+  auto stats = exec::toPlanStats(task->taskStats());
+
+  ASSERT_EQ(3'000, stats.at(unnestId).outputRows);
+  const int32_t numVectorsWithoutPressure =
+      bits::divRoundUp(3'000, batchSize_);
+  ASSERT_GT(stats.at(unnestId).outputVectors, numVectorsWithoutPressure);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     UnnestTest,
     UnnestTest,
@@ -14,12 +14,25 @@
  * limitations under the License.
  */
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
+#include <folly/Synchronized.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/InlineExecutor.h>
+#include <folly/futures/Future.h>
 #include <atomic>
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OutputBufferManager.h"
 
 namespace facebook::velox::exec::test {
+
+std::chrono::microseconds LocalExchangeNetworkModel::delay(
+    uint64_t bytes) const {
+  auto delay = latency;
+  if (bytesPerSecond != 0) {
+    delay += std::chrono::microseconds(bytes * 1'000'000 / bytesPerSecond);
+  }
+  return delay;
+}
+
 namespace {
 
 class LocalExchangeSource : public exec::ExchangeSource {
@@ -29,7 +42,8 @@ class LocalExchangeSource : public exec::ExchangeSource {
       int destination,
       std::shared_ptr<exec::ExchangeQueue> queue,
       memory::MemoryPool* pool)
-      : ExchangeSource(taskId, destination, queue, pool) {}
+      : ExchangeSource(taskId, destination, queue, pool),
+        networkModel_(*globalNetworkModel_.rlock()) {}
 
   bool supportsMetrics() const override {
     return true;
@@ -88,14 +102,37 @@ class LocalExchangeSource : public exec::ExchangeSource {
         sequence = requestedSequence;
       }
       std::vector<std::unique_ptr<SerializedPage>> pages;
+      // The unacknowledged pages in the producer's buffer, fetched on the first
+      // in-process page. In-process pages are returned as empty IOBufs.
+      std::vector<std::shared_ptr<SerializedPage>> bufferedPages;
       bool atEnd = false;
       int64_t totalBytes = 0;
-      for (auto& inputPage : data) {
+      for (auto i = 0; i < data.size(); ++i) {
+        auto& inputPage = data[i];
         if (!inputPage) {
           atEnd = true;
           // Keep looping, there could be extra end markers.
           continue;
         }
+        if (inputPage->empty()) {
+          if (bufferedPages.empty()) {
+            bufferedPages = buffers->getPages(
+                remoteTaskId_, destination_, sequence, data.size());
+          }
+          if (i < bufferedPages.size() &&
+              bufferedPages[i]->vector() != nullptr) {
+            // Pass the vector by reference. The new page holds the producer's
+            // page, which keeps the producer's memory alive.
+            auto bufferedPage = bufferedPages[i];
+            totalBytes += bufferedPage->size();
+            pages.push_back(std::make_unique<SerializedPage>(
+                bufferedPage->vector(),
+                bufferedPage->size(),
+                [bufferedPage]() {}));
+            inputPage = nullptr;
+            continue;
+          }
+        }
         totalBytes += inputPage->length();
         inputPage->unshare();
         pages.push_back(std::make_unique<SerializedPage>(std::move(inputPage)));
@@ -108,45 +145,41 @@ class LocalExchangeSource : public exec::ExchangeSource {
             "facebook::velox::exec::test::LocalExchangeSource::timeout", this);
       }
 
-      try {
-        common::testutil::TestValue::adjust(
-            "facebook::velox::exec::test::LocalExchangeSource", this);
-      } catch (const std::exception& e) {
-        queue_->setError(e.what());
-        checkSetRequestPromise();
+      // A timeout is not a response from the producer and is not delayed.
+      const auto delay = data.empty() && remainingBytes.empty()
+          ? std::chrono::microseconds(0)
+          : networkModel_.delay(totalBytes);
+      if (delay.count() == 0) {
+        deliver(
+            std::move(pages),
+            atEnd,
+            !data.empty(),
+            sequence,
+            totalBytes,
+            std::move(remainingBytes),
+            buffers);
         return;
       }
-
-      VeloxPromise<Response> requestPromise;
-      {
-        std::vector<ContinuePromise> queuePromises;
-        {
-          std::lock_guard<std::mutex> l(queue_->mutex());
-          requestPending_ = false;
-          requestPromise = std::move(promise_);
-          for (auto& page : pages) {
-            queue_->enqueueLocked(std::move(page), queuePromises);
-          }
-          if (atEnd) {
-            queue_->enqueueLocked(nullptr, queuePromises);
-            atEnd_ = true;
-          }
-          if (!data.empty()) {
-            sequence_ = sequence + pages.size();
-          }
-        }
-        for (auto& promise : queuePromises) {
-          promise.setValue();
-        }
-      }
-      // Outside of queue mutex.
-      if (atEnd_) {
-        buffers->deleteResults(remoteTaskId_, destination_);
-      }
-
-      if (!requestPromise.isFulfilled()) {
-        requestPromise.setValue(Response{totalBytes, atEnd_, remainingBytes});
-      }
+      folly::futures::sleep(delay)
+          .via(&folly::InlineExecutor::instance())
+          .thenValue([self,
+                      this,
+                      pages = std::move(pages),
+                      atEnd,
+                      hasData = !data.empty(),
+                      sequence,
+                      totalBytes,
+                      remainingBytes = std::move(remainingBytes),
+                      buffers](auto&& /*unused*/) mutable {
+            deliver(
+                std::move(pages),
+                atEnd,
+                hasData,
+                sequence,
+                totalBytes,
+                std::move(remainingBytes),
+                buffers);
+          });
     };
 
     registerTimeout(self, resultCallback, maxWait);
@@ -205,6 +238,10 @@ class LocalExchangeSource : public exec::ExchangeSource {
   // Invoked to stop the exchange source. It sets 'stop_', clears the current
   // pending request 'timeouts_' and join/destroy 'timeoutCheckExecutor_' if
   // created.
+  static void setNetworkModel(LocalExchangeNetworkModel model) {
+    *globalNetworkModel_.wlock() = model;
+  }
+
   static void stop() {
     {
       std::lock_guard<std::mutex> l(mutex_);
@@ -229,6 +266,56 @@ class LocalExchangeSource : public exec::ExchangeSource {
       int64_t sequence,
       std::vector<int64_t> remainingBytes)>;
 
+  // Enqueues the pages of a response and fulfills the request promise.
+  void deliver(
+      std::vector<std::unique_ptr<SerializedPage>> pages,
+      bool atEnd,
+      bool hasData,
+      int64_t sequence,
+      int64_t totalBytes,
+      std::vector<int64_t> remainingBytes,
+      const std::shared_ptr<OutputBufferManager>& buffers) {
+    try {
+      common::testutil::TestValue::adjust(
+          "facebook::velox::exec::test::LocalExchangeSource", this);
+    } catch (const std::exception& e) {
+      queue_->setError(e.what());
+      checkSetRequestPromise();
+      return;
+    }
+
+    VeloxPromise<Response> requestPromise;
+    {
+      std::vector<ContinuePromise> queuePromises;
+      {
+        std::lock_guard<std::mutex> l(queue_->mutex());
+        requestPending_ = false;
+        requestPromise = std::move(promise_);
+        for (auto& page : pages) {
+          queue_->enqueueLocked(std::move(page), queuePromises);
+        }
+        if (atEnd) {
+          queue_->enqueueLocked(nullptr, queuePromises);
+          atEnd_ = true;
+        }
+        if (hasData) {
+          sequence_ = sequence + pages.size();
+        }
+      }
+      for (auto& promise : queuePromises) {
+        promise.setValue();
+      }
+    }
+    // Outside of queue mutex.
+    if (atEnd_) {
+      buffers->deleteResults(remoteTaskId_, destination_);
+    }
+
+    if (!requestPromise.isFulfilled()) {
+      requestPromise.setValue(Response{totalBytes, atEnd_, remainingBytes});
+    }
+  }
+
   static void registerTimeout(
       const std::shared_ptr<ExchangeSource>& self,
       ResultCallback callback,
@@ -289,6 +376,11 @@ class LocalExchangeSource : public exec::ExchangeSource {
   static inline std::unique_ptr<std::thread> timerThread_;
   static inline std::atomic_bool stop_{false};
   static inline bool exitInitialized_{false};
+  static inline folly::Synchronized<LocalExchangeNetworkModel>
+      globalNetworkModel_;
+
+  // The network model at the creation of 'this'.
+  const LocalExchangeNetworkModel networkModel_;
 
   // Records the total number of pages fetched from sources.
   std::atomic<int64_t> numPages_{0};
@@ -320,4 +412,8 @@ void testingShutdownLocalExchangeSource() {
   LocalExchangeSource::stop();
 }
 
+void testingSetLocalExchangeNetworkModel(LocalExchangeNetworkModel model) {
+  LocalExchangeSource::setNetworkModel(model);
+}
+
 } // namespace facebook::velox::exec::test
@@ -14,10 +14,26 @@
  * limitations under the License.
  */
 #pragma once
+#include <chrono>
 #include "velox/exec/Exchange.h"
 
 namespace facebook::velox::exec::test {
 
+/// Simulates the network between a local exchange source and its producer to
+/// benchmark and test exchanges under network conditions. A response of the
+/// producer reaches the consumer after 'latency' plus its transfer time at
+/// 'bytesPerSecond'. A source has at most one request in flight, so the
+/// bandwidth is per source and the latency is paid once per request.
+struct LocalExchangeNetworkModel {
+  std::chrono::microseconds latency{0};
+
+  /// 0 means unlimited.
+  uint64_t bytesPerSecond{0};
+
+  /// Returns the delay of a response of 'bytes'.
+  std::chrono::microseconds delay(uint64_t bytes) const;
+};
+
 /// Given taskId that starts with local:// returns an instance of ExchangeSource
 /// that fetches data from local OutputBufferManager.
 std::unique_ptr<exec::ExchangeSource> createLocalExchangeSource(
@@ -36,4 +52,8 @@ void testingStartLocalExchangeSource();
 /// tests to ensure no ASAN errors at exit.
 void testingShutdownLocalExchangeSource();
 
+/// Sets the network model of the local exchange sources created after this
+/// call. The default model has no latency and unlimited bandwidth.
+void testingSetLocalExchangeNetworkModel(LocalExchangeNetworkModel model);
+
 } // namespace facebook::velox::exec::test
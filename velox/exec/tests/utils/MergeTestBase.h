@@ -146,6 +146,40 @@ class MergeTestBase {
     return data;
   }
 
+  // Makes 'numRuns' sorted streams totalling 'numValues' entries where each
+  // stream covers a range of values and overlaps only with its neighbors on
+  // 'overlapPct' percent of its range. Models clustered inputs with long runs
+  // from a single stream.
+  TestData makeClusteredTestData(
+      int32_t numValues,
+      int32_t numRuns,
+      int32_t overlapPct) {
+    TestData data;
+    data.data.reserve(numValues);
+    const uint32_t runSize = std::max<int32_t>(1, numValues / numRuns);
+    const uint32_t spread = runSize + runSize * overlapPct / 100;
+    std::vector<std::vector<uint32_t>> runs(numRuns);
+    for (auto i = 0; i < numValues; ++i) {
+      const auto run = std::min<int32_t>(i / runSize, numRuns - 1);
+      const uint32_t value =
+          run * runSize + folly::Random::rand32(spread, rng_);
+      runs[run].push_back(value);
+      data.data.push_back(value);
+    }
+    for (auto& run : runs) {
+      std::sort(
+          run.begin(), run.end(), [](uint32_t left, uint32_t right) {
+            return left > right;
+          });
+    }
+    std::sort(data.data.begin(), data.data.end());
+
+    for (auto& run : runs) {
+      data.sources.push_back(std::make_unique<TestingStream>(std::move(run)));
+    }
+    return data;
+  }
+
   // Reads the data in 'testData.runs' using the merging class MergeType. Checks
   // that the results match the globally sorted data in 'testData' if check is
   // true.
@@ -175,6 +209,32 @@ class MergeTestBase {
     }
   }
 
+  // Same as test() but takes runs of values from the winning stream that are
+  // not greater than the first value of TreeOfLosers::runnerUp().
+  static void testRuns(const TestData& testData, bool check) {
+    std::vector<std::unique_ptr<TestingStream>> sources;
+    for (auto& source : testData.sources) {
+      sources.push_back(std::make_unique<TestingStream>(*source));
+    }
+    TreeOfLosers<TestingStream> merge(std::move(sources));
+    size_t numValues = 0;
+    TestingStream* source;
+    while ((source = merge.next())) {
+      const auto* runnerUp = merge.runnerUp();
+      do {
+        if (check) {
+          ASSERT_LT(numValues, testData.data.size());
+          ASSERT_EQ(source->current()->value(), testData.data[numValues]);
+        }
+        ++numValues;
+        source->pop();
+      } while (source->hasData() && (!runnerUp || !(*runnerUp < *source)));
+    }
+    if (check) {
+      ASSERT_EQ(numValues, testData.data.size());
+    }
+  }
+
  protected:
   folly::Random::DefaultGenerator rng_;
 };
@@ -1295,6 +1295,36 @@ PlanBuilder& PlanBuilder::partitionedOutput(
       std::move(partitionFunctionSpec),
       outputType,
       serdeKind,
+      core::PartitionedOutputNode::SkewedPartitionMode::kNone,
+      std::vector<uint32_t>{},
+      planNode_);
+  return *this;
+}
+
+PlanBuilder& PlanBuilder::skewedPartitionedOutput(
+    const std::vector<std::string>& keys,
+    int numPartitions,
+    core::PartitionedOutputNode::SkewedPartitionMode skewedPartitionMode,
+    std::vector<uint32_t> skewedPartitions,
+    const std::vector<std::string>& outputLayout,
+    VectorSerde::Kind serdeKind) {
+  VELOX_CHECK_NOT_NULL(
+      planNode_, "PartitionedOutput cannot be the source node");
+  auto keyExprs = exprs(keys, planNode_->outputType());
+  auto outputType = outputLayout.empty()
+      ? planNode_->outputType()
+      : extract(planNode_->outputType(), outputLayout);
+  planNode_ = std::make_shared<core::PartitionedOutputNode>(
+      nextPlanNodeId(),
+      core::PartitionedOutputNode::Kind::kPartitioned,
+      keyExprs,
+      numPartitions,
+      /*replicateNullsAndAny=*/false,
+      createPartitionFunctionSpec(planNode_->outputType(), keyExprs, pool_),
+      outputType,
+      serdeKind,
+      skewedPartitionMode,
+      std::move(skewedPartitions),
       planNode_);
   return *this;
 }
@@ -2002,15 +2032,26 @@ PlanBuilder& PlanBuilder::topNRowNumber(
     const std::vector<std::string>& sortingKeys,
     int32_t limit,
     bool generateRowNumber) {
+  return topNRank(
+      "row_number", partitionKeys, sortingKeys, limit, generateRowNumber);
+}
+
+PlanBuilder& PlanBuilder::topNRank(
+    std::string_view function,
+    const std::vector<std::string>& partitionKeys,
+    const std::vector<std::string>& sortingKeys,
+    int32_t limit,
+    bool generateRowNumber) {
   VELOX_CHECK_NOT_NULL(planNode_, "TopNRowNumber cannot be the source node");
   auto [sortingFields, sortingOrders] =
       parseOrderByClauses(sortingKeys, planNode_->outputType(), pool_);
   std::optional<std::string> rowNumberColumnName;
   if (generateRowNumber) {
-    rowNumberColumnName = "row_number";
+    rowNumberColumnName = function;
   }
   planNode_ = std::make_shared<core::TopNRowNumberNode>(
       nextPlanNodeId(),
+      core::TopNRowNumberNode::rankFunctionFromName(std::string(function)),
       fields(partitionKeys),
       sortingFields,
       sortingOrders,
@@ -976,6 +976,17 @@ class PlanBuilder {
       const std::vector<std::string>& outputLayout = {},
       VectorSerde::Kind serdeKind = VectorSerde::Kind::kPresto);
 
+  /// Same as partitionedOutput(), but treats 'skewedPartitions' as skewed
+  /// partitions handled as specified by 'skewedPartitionMode'. Used to spread
+  /// hot join keys of a shuffle join.
+  PlanBuilder& skewedPartitionedOutput(
+      const std::vector<std::string>& keys,
+      int numPartitions,
+      core::PartitionedOutputNode::SkewedPartitionMode skewedPartitionMode,
+      std::vector<uint32_t> skewedPartitions,
+      const std::vector<std::string>& outputLayout = {},
+      VectorSerde::Kind serdeKind = VectorSerde::Kind::kPresto);
+
   /// Adds a PartitionedOutputNode to broadcast the input data.
   ///
   /// @param outputLayout Optional output layout in case it is different then
@@ -1207,6 +1218,16 @@ class PlanBuilder {
       int32_t limit,
       bool generateRowNumber);
 
+  /// Add a TopNRowNumberNode to compute single row_number, rank or dense_rank
+  /// window function with a limit applied to sorted partitions. The optional
+  /// output column is named after the function.
+  PlanBuilder& topNRank(
+      std::string_view function,
+      const std::vector<std::string>& partitionKeys,
+      const std::vector<std::string>& sortingKeys,
+      int32_t limit,
+      bool generateRowNumber);
+
   /// Add a MarkDistinctNode to compute aggregate mask channel
   /// @param markerKey Name of output mask channel
   /// @param distinctKeys List of columns to be marked distinct.
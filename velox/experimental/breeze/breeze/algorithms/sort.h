@@ -22,7 +22,11 @@
 
 #pragma once
 
+#include "breeze/functions/load.h"
+#include "breeze/functions/reduce.h"
+#include "breeze/functions/scan.h"
 #include "breeze/functions/sort.h"
+#include "breeze/functions/store.h"
 #include "breeze/platforms/platform.h"
 #include "breeze/utils/block_details.h"
 #include "breeze/utils/types.h"
@@ -123,6 +127,86 @@ struct DeviceRadixSortHistogram {
   }
 };
 
+// Converts the histogram of all passes built by DeviceRadixSortHistogram
+// into the exclusive prefix sums that DeviceRadixSort uses as initial global
+// offsets. Each thread block handles one pass, so the kernel is launched
+// with NUM_PASSES blocks of BLOCK_THREADS * BINS_PER_THREAD == NUM_BINS.
+//
+// A pass where all items fall in the same bin does not change the order of
+// items and can be skipped. `buffer_advancements` is set to 0 for such a
+// pass and to 1 otherwise, which tells the host side sort loop whether the
+// pass swaps the input and output buffers.
+template <typename PlatformT, int BINS_PER_THREAD, int RADIX_BITS,
+          typename U>
+struct DeviceRadixSortHistogramScan {
+  enum {
+    BLOCK_THREADS = PlatformT::BLOCK_THREADS,
+    NUM_BINS = 1 << RADIX_BITS,
+  };
+  static_assert(BLOCK_THREADS * BINS_PER_THREAD == NUM_BINS,
+                "BLOCK_THREADS * BINS_PER_THREAD must be NUM_BINS");
+
+  using BlockReduceT = functions::BlockReduce<PlatformT, U>;
+  using BlockScanT = functions::BlockScan<PlatformT, U, BINS_PER_THREAD>;
+
+  struct Scratch {
+    typename BlockReduceT::Scratch reduce_sum;
+    typename BlockReduceT::Scratch reduce_max;
+    typename BlockScanT::Scratch scan;
+  };
+
+  template <typename HistogramSlice, typename OffsetSlice,
+            typename AdvancementSlice, typename ScratchSlice>
+  static ATTR void Scan(PlatformT p, const HistogramSlice histogram,
+                        OffsetSlice out_offsets,
+                        AdvancementSlice buffer_advancements,
+                        ScratchSlice scratch) {
+    using namespace functions;
+    using namespace utils;
+
+    static_assert(IsSame<typename ScratchSlice::data_type, Scratch>::VALUE,
+                  "incorrect scratch type");
+
+    // load counts of the pass of this block
+    U items[BINS_PER_THREAD];
+    const HistogramSlice it = histogram.subslice(p.block_idx() * NUM_BINS);
+    BlockLoad<BLOCK_THREADS, BINS_PER_THREAD>(p, it, make_slice(items),
+                                              NUM_BINS);
+
+    // reductions to determine if all items are in the same bin
+    U sum = BlockReduceT::template Reduce<ReduceOpAdd, BINS_PER_THREAD>(
+        p, make_slice(items), make_slice<SHARED>(&scratch->reduce_sum),
+        NUM_BINS);
+    U max = BlockReduceT::template Reduce<ReduceOpMax, BINS_PER_THREAD>(
+        p, make_slice(items), make_slice<SHARED>(&scratch->reduce_max),
+        NUM_BINS);
+
+    // advance buffer unless all items are in the same bin (sum == max) and
+    // the pass can be skipped
+    if (p.thread_idx() == 0) {
+      buffer_advancements[p.block_idx()] = sum == max ? 0 : 1;
+    }
+
+    // inclusive scan
+    U offsets[BINS_PER_THREAD];
+    BlockScanT::template Scan<ScanOpAdd>(p, make_slice(items),
+                                         make_slice(offsets),
+                                         make_slice<SHARED>(&scratch->scan),
+                                         NUM_BINS);
+
+    // convert inclusive scan to exclusive scan
+#pragma unroll
+    for (int i = 0; i < BINS_PER_THREAD; ++i) {
+      offsets[i] -= items[i];
+    }
+
+    // store results
+    OffsetSlice out_it = out_offsets.subslice(p.block_idx() * NUM_BINS);
+    BlockStore<BLOCK_THREADS, BINS_PER_THREAD>(p, make_slice(offsets), out_it,
+                                               NUM_BINS);
+  }
+};
+
 template <typename T>
 struct SortBlockType {
   static T from(T, functions::SortBlockStatus);
@@ -22,6 +22,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <climits>
 #include <vector>
 
@@ -93,6 +94,20 @@ __global__ __launch_bounds__(BLOCK_THREADS) void RadixSortHistogram(
       make_slice(&scratch).template reinterpret<SHARED>(), num_items);
 }
 
+template <int BLOCK_THREADS, int BINS_PER_THREAD, int RADIX_BITS, typename U>
+__global__ __launch_bounds__(BLOCK_THREADS) void RadixSortHistogramScan(
+    const U* histogram, U* offsets, int* buffer_advancements) {
+  CudaPlatform<BLOCK_THREADS, CUDA_WARP_THREADS> p;
+  using DeviceRadixSortHistogramScanT =
+      DeviceRadixSortHistogramScan<decltype(p), BINS_PER_THREAD, RADIX_BITS,
+                                   U>;
+  __shared__ typename DeviceRadixSortHistogramScanT::Scratch scratch;
+  DeviceRadixSortHistogramScanT::Scan(
+      p, make_slice<GLOBAL>(histogram), make_slice<GLOBAL>(offsets),
+      make_slice<GLOBAL>(buffer_advancements),
+      make_slice(&scratch).template reinterpret<SHARED>());
+}
+
 }  // namespace kernels
 
 template <typename T>
@@ -403,6 +418,114 @@ TYPED_TEST(SortPerfTest, RadixSortKeyValues) {
   }
 }
 
+// Device-wide sort of all key bits: histogram of all passes, one scan
+// block per pass, followed by one onesweep pass per RADIX_BITS digit.
+TYPED_TEST(SortPerfTest, RadixSortAllPasses) {
+  using item_type = typename TypeParam::item_type::type;
+  using size_type = unsigned;
+  using block_type = unsigned;
+
+  auto input = this->template GetConfigColumn<item_type>("key");
+  ASSERT_NE(input.size(), 0u);
+
+  auto check_result = this->GetConfigValue("check_result", true);
+
+  constexpr int kBlockThreads = TypeParam::launch_params::BLOCK_THREADS;
+  constexpr int kItemsPerThread = TypeParam::launch_params::ITEMS_PER_THREAD;
+  constexpr int kBlockItems = kBlockThreads * kItemsPerThread;
+  constexpr int kRadixBits = TypeParam::RADIX_BITS;
+  constexpr int kEndBit = sizeof(item_type) * /*BITS_PER_BYTE=*/8;
+  constexpr int kNumPasses = DivideAndRoundUp<kEndBit, kRadixBits>::VALUE;
+  constexpr int kNumBins = 1 << kRadixBits;
+  constexpr int kHistogramSize = kNumBins * kNumPasses;
+  constexpr int kHistogramItemsPerThread = 8;
+  constexpr int kHistogramTileSize = 16;
+  constexpr int kHistogramTileItems =
+      kBlockThreads * kHistogramItemsPerThread * kHistogramTileSize;
+  static_assert(kNumBins % kBlockThreads == 0,
+                "number of bins must be a multiple of block threads");
+
+  constexpr int kRadixSortSharedMemorySize =
+      sizeof(typename DeviceRadixSort<
+             CudaPlatform<kBlockThreads, kernels::CUDA_WARP_THREADS>,
+             kItemsPerThread, kRadixBits, item_type, NullType>::Scratch);
+  if (kRadixSortSharedMemorySize > this->MaxSharedMemory() &&
+      !getenv("GTEST_ALSO_RUN_SKIPPED_TESTS")) {
+    GTEST_SKIP() << "skipping test that requires too much shared memory: "
+                 << kRadixSortSharedMemorySize << " > "
+                 << this->MaxSharedMemory();
+  }
+
+  int num_blocks = (input.size() + kBlockItems - 1) / kBlockItems;
+  int num_histogram_blocks =
+      (input.size() + kHistogramTileItems - 1) / kHistogramTileItems;
+
+  device_vector<item_type> items[2] = {device_vector<item_type>(input.size()),
+                                       device_vector<item_type>(input.size())};
+  device_vector<size_type> histogram(kHistogramSize);
+  device_vector<size_type> offsets(kHistogramSize);
+  device_vector<int> buffer_advancements(kNumPasses);
+  device_vector<int> next_block_idx(kNumPasses);
+  device_vector<block_type> blocks(kNumPasses * num_blocks * kNumBins);
+
+  // provide throughput information
+  this->set_element_count(input.size());
+  this->set_element_size(sizeof(item_type));
+  this->set_elements_per_thread(kItemsPerThread);
+  this->template set_global_memory_loads<item_type>(input.size() *
+                                                    (kNumPasses + 1));
+  this->template set_global_memory_stores<item_type>(input.size() *
+                                                     kNumPasses);
+
+  cudaFuncSetAttribute(
+      &kernels::RadixSort<kBlockThreads, kItemsPerThread, kRadixBits, item_type,
+                          size_type, block_type>,
+      cudaFuncAttributeMaxDynamicSharedMemorySize, kRadixSortSharedMemorySize);
+
+  this->MeasureWithSetup(
+      kConfig,
+      [&]() {
+        items[0].copy_from_host(input.data(), input.size());
+        cudaMemsetAsync(histogram.data(), 0,
+                        sizeof(size_type) * kHistogramSize);
+        cudaMemsetAsync(next_block_idx.data(), 0, sizeof(int) * kNumPasses);
+        cudaMemsetAsync(blocks.data(), 0,
+                        sizeof(block_type) * kNumPasses * num_blocks *
+                            kNumBins);
+      },
+      [&]() {
+        kernels::RadixSortHistogram<kBlockThreads, kHistogramItemsPerThread,
+                                    kHistogramTileSize, kRadixBits>
+            <<<num_histogram_blocks, kBlockThreads>>>(
+                items[0].data(), histogram.data(), items[0].size());
+        kernels::RadixSortHistogramScan<kBlockThreads,
+                                        kNumBins / kBlockThreads, kRadixBits>
+            <<<kNumPasses, kBlockThreads>>>(histogram.data(), offsets.data(),
+                                            buffer_advancements.data());
+        // every pass is run as skipping a pass requires the advancements
+        // to be read back on the host
+        for (int pass = 0; pass < kNumPasses; ++pass) {
+          int start_bit = pass * kRadixBits;
+          int num_pass_bits = std::min(kRadixBits, kEndBit - start_bit);
+          kernels::RadixSort<kBlockThreads, kItemsPerThread, kRadixBits>
+              <<<num_blocks, kBlockThreads, kRadixSortSharedMemorySize>>>(
+                  items[pass & 1].data(), offsets.data() + pass * kNumBins,
+                  start_bit, num_pass_bits, items[(pass + 1) & 1].data(),
+                  next_block_idx.data() + pass,
+                  blocks.data() + pass * num_blocks * kNumBins, input.size());
+        }
+      });
+
+  if (check_result) {
+    std::vector<item_type> actual_result(input.size());
+    items[kNumPasses & 1].copy_to_host(actual_result.data(),
+                                       actual_result.size());
+    std::vector<item_type> expected_result = input;
+    std::sort(expected_result.begin(), expected_result.end());
+    EXPECT_EQ(expected_result, actual_result);
+  }
+}
+
 using SortHistogramConfig = PerfTestArrayConfig<11>;
 
 const SortHistogramConfig kHistogramConfig = {
@@ -67,57 +67,17 @@ template <int BLOCK_THREADS, int ITEMS_PER_THREAD, int RADIX_BITS, typename U>
 __global__
 __launch_bounds__(BLOCK_THREADS) void RadixSortHistogramExclusiveScan(
     const U* in, U* out, int* buffer_advancement) {
-  using namespace functions;
+  using namespace algorithms;
   using namespace utils;
 
-  enum {
-    NUM_BINS = 1 << RADIX_BITS,
-  };
-
   CudaPlatform<BLOCK_THREADS, CUDA_WARP_THREADS> p;
-  using BlockReduceT = BlockReduce<decltype(p), U>;
-  using BlockScanT = BlockScan<decltype(p), U, ITEMS_PER_THREAD>;
-  __shared__ struct {
-    typename BlockReduceT::Scratch reduce_sum;
-    typename BlockReduceT::Scratch reduce_max;
-    typename BlockScanT::Scratch scan;
-  } scratch;
-
-  U items[ITEMS_PER_THREAD];
-
-  // load counts
-  const U* it = in + p.block_idx() * NUM_BINS;
-  BlockLoad<BLOCK_THREADS, ITEMS_PER_THREAD>(p, make_slice<GLOBAL>(it),
-                                             make_slice(items), NUM_BINS);
-
-  // reductions to determine if all items are in the same bin
-  U sum = BlockReduceT::template Reduce<ReduceOpAdd, ITEMS_PER_THREAD>(
-      p, make_slice(items), make_slice<SHARED>(&scratch.reduce_sum), NUM_BINS);
-  U max = BlockReduceT::template Reduce<ReduceOpMax, ITEMS_PER_THREAD>(
-      p, make_slice(items), make_slice<SHARED>(&scratch.reduce_max), NUM_BINS);
-
-  // advance buffer unless all items are in the same bin (sum == max) and
-  // pass can be skipped
-  if (p.thread_idx() == 0) {
-    buffer_advancement[p.block_idx()] = sum == max ? 0 : 1;
-  }
-
-  // inclusive scan
-  U offsets[ITEMS_PER_THREAD];
-  BlockScanT::template Scan<ScanOpAdd>(
-      p, make_slice(items), make_slice(offsets),
-      make_slice<SHARED>(&scratch.scan), NUM_BINS);
-
-  // convert inclusive scan to exclusive scan
-#pragma unroll
-  for (int i = 0; i < ITEMS_PER_THREAD; ++i) {
-    offsets[i] -= items[i];
-  }
-
-  // store results
-  U* out_it = out + p.block_idx() * NUM_BINS;
-  BlockStore<BLOCK_THREADS, ITEMS_PER_THREAD>(
-      p, make_slice(offsets), make_slice<GLOBAL>(out_it), NUM_BINS);
+  using HistogramScanT =
+      DeviceRadixSortHistogramScan<decltype(p), ITEMS_PER_THREAD, RADIX_BITS,
+                                   U>;
+  __shared__ typename HistogramScanT::Scratch scratch;
+  HistogramScanT::Scan(p, make_slice<GLOBAL>(in), make_slice<GLOBAL>(out),
+                       make_slice<GLOBAL>(buffer_advancement),
+                       make_slice(&scratch).template reinterpret<SHARED>());
 }
 
 template <int BLOCK_THREADS, int ITEMS_PER_THREAD>
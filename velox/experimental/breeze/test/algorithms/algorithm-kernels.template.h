@@ -89,6 +89,23 @@ void RadixSortHistogram(const T* in, unsigned* out, int num_items) {
       breeze::utils::make_slice<breeze::utils::SHARED>(scratch), num_items);
 }
 
+template <int BLOCK_THREADS, int BINS_PER_THREAD, int RADIX_BITS>
+PLATFORM("p")
+SHARED_MEM(
+    "typename breeze::algorithms::DeviceRadixSortHistogramScan<PlatformT, BINS_PER_THREAD, RADIX_BITS, unsigned>::Scratch",
+    "scratch")
+void RadixSortHistogramScan(const unsigned* in, unsigned* out,
+                            int* buffer_advancements) {
+  breeze::algorithms::DeviceRadixSortHistogramScan<
+      PlatformT, BINS_PER_THREAD, RADIX_BITS, unsigned>::
+      Scan(
+          p, breeze::utils::make_slice<breeze::utils::GLOBAL>(in),
+          breeze::utils::make_slice<breeze::utils::GLOBAL>(out),
+          breeze::utils::make_slice<breeze::utils::GLOBAL>(
+              buffer_advancements),
+          breeze::utils::make_slice<breeze::utils::SHARED>(scratch));
+}
+
 template <int BLOCK_THREADS, int ITEMS_PER_THREAD, int RADIX_BITS, typename T,
           typename U>
 PLATFORM("p")
@@ -63,6 +63,13 @@ class AlgorithmTest : public ::testing::Test {
   void RadixSortHistogram(USE_AS_SIZE const std::vector<T>& in,
                           std::vector<unsigned>& out,
                           BLOCK_COUNT int num_blocks);
+  template <int BLOCK_THREADS, int BINS_PER_THREAD, int RADIX_BITS>
+  UNTYPED SHARED_MEM_TYPE(
+      "typename breeze::algorithms::DeviceRadixSortHistogramScan<PlatformT, BINS_PER_THREAD, RADIX_BITS, unsigned>::Scratch")
+  void RadixSortHistogramScan(const std::vector<unsigned>& in,
+                              std::vector<unsigned>& out,
+                              std::vector<int>& buffer_advancements,
+                              BLOCK_COUNT int num_blocks);
   template <int BLOCK_THREADS, int ITEMS_PER_THREAD, int RADIX_BITS, typename U>
   SHARED_MEM_TYPE(
       "typename breeze::algorithms::DeviceRadixSort<PlatformT, ITEMS_PER_THREAD, RADIX_BITS, T, U>::Scratch")
@@ -99,6 +99,21 @@ GEN_SCAN(add)
 GEN_RADIX_SORT_HISTOGRAM(int)
 GEN_RADIX_SORT_HISTOGRAM(uint)
 
+#define GEN_RADIX_SORT_HISTOGRAM_SCAN(BT, BPT, RB)                        \
+  kernel void C(, radix_sort_histogram_scan_##BT##x##BPT##x##RB)(        \
+      const device uint *in [[buffer(0)]], device uint *out [[buffer(1)]], \
+      device int *buffer_advancements [[buffer(2)]],                     \
+      uint thread_idx [[thread_index_in_threadgroup]],                   \
+      uint block_idx [[threadgroup_position_in_grid]]) {                 \
+    MetalPlatform<BT, WARP_THREADS> p{thread_idx, block_idx};            \
+    threadgroup DeviceRadixSortHistogramScan<decltype(p), BPT, RB,       \
+                                             uint>::Scratch scratch;     \
+    radix_sort_histogram_scan<BT, BPT, RB>(p, in, out, buffer_advancements, \
+                                           &scratch);                    \
+  }
+
+GEN_RADIX_SORT_HISTOGRAM_SCAN(64, 1, 6)
+
 #define null_value_type NullType
 #define uint_value_type uint
 
@@ -131,6 +131,45 @@ TYPED_TEST(AlgorithmTest, RadixSortHistogramLargeTiles) {
   EXPECT_EQ(expected_result, out);
 }
 
+TYPED_TEST(AlgorithmTest, RadixSortHistogramScan) {
+  constexpr int kRadixBits = 6;
+  constexpr int kNumBins = 1 << kRadixBits;
+  constexpr int kNumPasses = 3;
+
+  // Pass 1 has all items in a single bin and can be skipped.
+  std::vector<unsigned> in(kNumPasses * kNumBins, 0);
+  static std::minstd_rand rng;
+  for (int i = 0; i < kNumBins; ++i) {
+    in[i] = rng() % 16;
+    in[2 * kNumBins + i] = i;
+  }
+  in[kNumBins + 5] = 400;
+
+  std::vector<unsigned> out(in.size(), 0);
+  std::vector<int> buffer_advancements(kNumPasses, -1);
+
+  this->template RadixSortHistogramScan<kBlockThreads,
+                                        kNumBins / kBlockThreads, kRadixBits>(
+      in, out, buffer_advancements, kNumPasses);
+
+  std::vector<unsigned> expected_out(in.size());
+  std::vector<int> expected_buffer_advancements(kNumPasses);
+  for (int pass = 0; pass < kNumPasses; ++pass) {
+    unsigned sum = 0;
+    unsigned max = 0;
+    for (int i = 0; i < kNumBins; ++i) {
+      unsigned count = in[pass * kNumBins + i];
+      expected_out[pass * kNumBins + i] = sum;
+      sum += count;
+      max = std::max(max, count);
+    }
+    expected_buffer_advancements[pass] = sum == max ? 0 : 1;
+  }
+  EXPECT_EQ(expected_out, out);
+  EXPECT_EQ(expected_buffer_advancements, buffer_advancements);
+  EXPECT_EQ(buffer_advancements[1], 0);
+}
+
 TYPED_TEST(AlgorithmTest, RadixSort) {
   constexpr int kBlockItems = kBlockThreads * kItemsPerThread;
   constexpr int kRadixBits = 6;
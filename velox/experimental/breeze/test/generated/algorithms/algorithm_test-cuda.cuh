@@ -71,6 +71,18 @@ class AlgorithmTest : public ::testing::Test {
         in, out, in.size());
   }
 
+  template <int BLOCK_THREADS, int BINS_PER_THREAD, int RADIX_BITS>
+  void RadixSortHistogramScan(const std::vector<unsigned>& in,
+                              std::vector<unsigned>& out,
+                              std::vector<int>& buffer_advancements,
+                              int num_blocks) {
+    CudaTestLaunch<BLOCK_THREADS>(
+        num_blocks,
+        &kernels::RadixSortHistogramScan<BLOCK_THREADS, BINS_PER_THREAD,
+                                         RADIX_BITS>,
+        in, out, buffer_advancements);
+  }
+
   template <int BLOCK_THREADS, int ITEMS_PER_THREAD, int RADIX_BITS, typename U>
   void RadixSort(const std::vector<T>& in_keys, const std::vector<U>& in_values,
                  const std::vector<unsigned>& in_offsets, int start_bit,
@@ -82,6 +82,23 @@ class AlgorithmTest : public ::testing::Test {
         in.data(), out.data(), in.size());
   }
 
+  template <int BLOCK_THREADS, int BINS_PER_THREAD, int RADIX_BITS>
+  void RadixSortHistogramScan(const std::vector<unsigned>& in,
+                              std::vector<unsigned>& out,
+                              std::vector<int>& buffer_advancements,
+                              int num_blocks) {
+    using PlatformT =
+        OpenMPPlatform<BLOCK_THREADS, /*WARP_THREADS=*/BLOCK_THREADS>;
+    using SharedMemType =
+        typename breeze::algorithms::DeviceRadixSortHistogramScan<
+            PlatformT, BINS_PER_THREAD, RADIX_BITS, unsigned>::Scratch;
+    OpenMPTestLaunch<BLOCK_THREADS, SharedMemType>(
+        num_blocks,
+        &kernels::RadixSortHistogramScan<BLOCK_THREADS, BINS_PER_THREAD,
+                                         RADIX_BITS, SharedMemType>,
+        in.data(), out.data(), buffer_advancements.data());
+  }
+
   template <int BLOCK_THREADS, int ITEMS_PER_THREAD, int RADIX_BITS, typename U>
   void RadixSort(const std::vector<T>& in_keys, const std::vector<U>& in_values,
                  const std::vector<unsigned>& in_offsets, int start_bit,
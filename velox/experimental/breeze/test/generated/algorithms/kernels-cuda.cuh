@@ -92,6 +92,27 @@ __global__ void RadixSortHistogram(const T* in, unsigned* out, int num_items) {
       breeze::utils::make_slice<breeze::utils::SHARED>(scratch), num_items);
 }
 
+template <int BLOCK_THREADS, int BINS_PER_THREAD, int RADIX_BITS>
+__global__ void RadixSortHistogramScan(const unsigned* in, unsigned* out,
+                                       int* buffer_advancements) {
+  using PlatformT = CudaPlatform<BLOCK_THREADS, WARP_THREADS>;
+  PlatformT p;
+  __shared__ typename breeze::algorithms::DeviceRadixSortHistogramScan<
+      PlatformT, BINS_PER_THREAD, RADIX_BITS, unsigned>::Scratch scratch_;
+  auto scratch = (typename breeze::algorithms::DeviceRadixSortHistogramScan<
+                  PlatformT, BINS_PER_THREAD, RADIX_BITS,
+                  unsigned>::Scratch*)&scratch_;
+
+  breeze::algorithms::DeviceRadixSortHistogramScan<
+      PlatformT, BINS_PER_THREAD, RADIX_BITS, unsigned>::
+      Scan(
+          p, breeze::utils::make_slice<breeze::utils::GLOBAL>(in),
+          breeze::utils::make_slice<breeze::utils::GLOBAL>(out),
+          breeze::utils::make_slice<breeze::utils::GLOBAL>(
+              buffer_advancements),
+          breeze::utils::make_slice<breeze::utils::SHARED>(scratch));
+}
+
 template <int BLOCK_THREADS, int ITEMS_PER_THREAD, int RADIX_BITS, typename T,
           typename U>
 __global__ void RadixSort(const T* in_keys, const U* in_values,
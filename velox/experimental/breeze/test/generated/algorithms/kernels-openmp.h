@@ -74,6 +74,22 @@ void RadixSortHistogram(PlatformT p, SharedMemType* scratch, const T* in,
       breeze::utils::make_slice<breeze::utils::SHARED>(scratch), num_items);
 }
 
+template <int BLOCK_THREADS, int BINS_PER_THREAD, int RADIX_BITS,
+          typename SharedMemType,
+          typename PlatformT = OpenMPPlatform<BLOCK_THREADS, BLOCK_THREADS>>
+void RadixSortHistogramScan(PlatformT p, SharedMemType* scratch,
+                            const unsigned* in, unsigned* out,
+                            int* buffer_advancements) {
+  breeze::algorithms::DeviceRadixSortHistogramScan<
+      PlatformT, BINS_PER_THREAD, RADIX_BITS, unsigned>::
+      Scan(
+          p, breeze::utils::make_slice<breeze::utils::GLOBAL>(in),
+          breeze::utils::make_slice<breeze::utils::GLOBAL>(out),
+          breeze::utils::make_slice<breeze::utils::GLOBAL>(
+              buffer_advancements),
+          breeze::utils::make_slice<breeze::utils::SHARED>(scratch));
+}
+
 template <int BLOCK_THREADS, int ITEMS_PER_THREAD, int RADIX_BITS, typename T,
           typename U, typename SharedMemType,
           typename PlatformT = OpenMPPlatform<BLOCK_THREADS, BLOCK_THREADS>>
@@ -211,6 +211,34 @@ class GpuHashTable : public GpuHashTableBase {
     }
   }
 
+  /// Returns the row for which 'compare' is true among the rows with hash
+  /// number 'h' or nullptr if none. For a table that is not concurrently
+  /// updated, e.g. a hash join build side. Each lane looks up independently.
+  template <typename RowType, typename Compare>
+  RowType* __device__ find(uint64_t h, Compare compare) const {
+    uint32_t tagWord = hashTag(h);
+    tagWord |= tagWord << 8;
+    tagWord = tagWord | tagWord << 16;
+    auto bucketIdx = h & sizeMask;
+    for (;;) {
+      GpuBucket* bucket = buckets + bucketIdx;
+      auto tags = bucket->tags;
+      auto hits = __vcmpeq4(tags, tagWord) & 0x01010101;
+      while (hits) {
+        auto hitIdx = (__ffs(hits) - 1) / 8;
+        auto* hit = bucket->load<RowType>(hitIdx);
+        if (compare(hit)) {
+          return hit;
+        }
+        hits = hits & (hits - 1);
+      }
+      if (__vcmpeq4(tags, 0)) {
+        return nullptr;
+      }
+      bucketIdx = (bucketIdx + 1) & sizeMask;
+    }
+  }
+
   template <typename RowType, typename Ops>
   void __device__
   updatingProbe(int32_t i, int32_t lane, bool isLaneActive, Ops& ops) {
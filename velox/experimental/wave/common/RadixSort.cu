@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define PLATFORM_CUDA
+
+// clang-format off
+#define CUDA_PLATFORM_SPECIALIZATION_HEADER \
+  breeze/platforms/specialization/cuda-ptx.cuh
+// clang-format on
+
+#include <breeze/algorithms/sort.h>
+#include <breeze/platforms/platform.h>
+#include <breeze/platforms/cuda.cuh>
+
+#include <type_traits>
+
+#include "velox/experimental/wave/common/BitUtil.cuh"
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/RadixSort.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace breeze::algorithms;
+using namespace breeze::utils;
+
+constexpr int32_t kSortThreads = 256;
+constexpr int32_t kItemsPerThread = 8;
+constexpr int32_t kSortItems = kSortThreads * kItemsPerThread;
+constexpr int32_t kRadixBits = 8;
+constexpr int32_t kNumBins = 1 << kRadixBits;
+constexpr int32_t kBinsPerThread = kNumBins / kSortThreads;
+constexpr int32_t kHistogramItemsPerThread = 8;
+constexpr int32_t kHistogramTileSize = 16;
+constexpr int32_t kHistogramTileItems =
+    kSortThreads * kHistogramItemsPerThread * kHistogramTileSize;
+
+using SortPlatform = CudaPlatform<kSortThreads, kWarpThreads>;
+
+// Breeze has radix sort traits for the C integer types, which are not all the
+// same as the fixed width types, e.g. int64_t is long.
+template <typename T>
+using BreezeKey = std::conditional_t<
+    sizeof(T) == 8,
+    std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>,
+    std::conditional_t<std::is_signed_v<T>, int, unsigned>>;
+
+template <typename K>
+using DeviceSort =
+    DeviceRadixSort<SortPlatform, kItemsPerThread, kRadixBits, K, int32_t>;
+
+// The keys and values being sorted and their alternate buffers. Each pass
+// moves them from one to the other.
+template <typename K>
+struct SortBuffers {
+  K* keys[2];
+  int32_t* values[2];
+};
+
+// Reverses the order of 'keys'. ~x orders opposite to x for both signed and
+// unsigned keys.
+template <typename K>
+void __global__ __launch_bounds__(kSortThreads)
+    flipKeys(K* keys, int32_t numRows) {
+  auto row = blockIdx.x * blockDim.x + threadIdx.x;
+  if (row < numRows) {
+    keys[row] = ~keys[row];
+  }
+}
+
+template <typename K>
+void __global__ __launch_bounds__(kSortThreads)
+    buildHistogram(const K* keys, unsigned* histogram, int32_t numRows) {
+  SortPlatform p;
+  using HistogramT = DeviceRadixSortHistogram<kRadixBits, K>;
+  __shared__ typename HistogramT::Scratch scratch;
+  HistogramT::template Build<kHistogramItemsPerThread, kHistogramTileSize>(
+      p,
+      make_slice<GLOBAL>(keys),
+      make_slice<GLOBAL>(histogram),
+      make_slice(&scratch).template reinterpret<SHARED>(),
+      numRows);
+}
+
+void __global__ __launch_bounds__(kSortThreads) scanHistogram(
+    const unsigned* histogram,
+    unsigned* offsets,
+    int* advancements) {
+  SortPlatform p;
+  using ScanT = DeviceRadixSortHistogramScan<
+      SortPlatform,
+      kBinsPerThread,
+      kRadixBits,
+      unsigned>;
+  __shared__ typename ScanT::Scratch scratch;
+  ScanT::Scan(
+      p,
+      make_slice<GLOBAL>(histogram),
+      make_slice<GLOBAL>(offsets),
+      make_slice<GLOBAL>(advancements),
+      make_slice(&scratch).template reinterpret<SHARED>());
+}
+
+// Sets the input and output buffer of each pass. A pass that does not change
+// the order has the same input and output and is skipped. The last element is
+// the buffer with the result.
+void __global__
+selectBuffers(const int* advancements, int32_t numPasses, int* selectors) {
+  int current = 0;
+  for (auto i = 0; i < numPasses; ++i) {
+    selectors[i * 2] = current;
+    current = (current + advancements[i]) % 2;
+    selectors[i * 2 + 1] = current;
+  }
+  selectors[numPasses * 2] = current;
+}
+
+template <typename K>
+void __global__ __launch_bounds__(kSortThreads) sortPass(
+    const int* selectors,
+    const unsigned* offsets,
+    int32_t startBit,
+    int32_t numPassBits,
+    SortBuffers<K> buffers,
+    int* nextBlockIdx,
+    unsigned* blocks,
+    int32_t numRows) {
+  SortPlatform p;
+  extern __shared__ __align__(16) char sortScratch[];
+  auto scratch =
+      reinterpret_cast<typename DeviceSort<K>::Scratch*>(sortScratch);
+  int from = selectors[0];
+  int to = selectors[1];
+  if (from == to) {
+    return;
+  }
+  DeviceSort<K>::template Sort<unsigned>(
+      p,
+      make_slice<GLOBAL>(static_cast<const K*>(buffers.keys[from])),
+      make_slice<GLOBAL>(static_cast<const int32_t*>(buffers.values[from])),
+      make_slice<GLOBAL>(offsets),
+      startBit,
+      numPassBits,
+      make_slice<GLOBAL>(buffers.keys[to]),
+      make_slice<GLOBAL>(buffers.values[to]),
+      make_slice<GLOBAL>(nextBlockIdx),
+      make_slice<GLOBAL>(blocks),
+      make_slice(scratch).template reinterpret<SHARED>(),
+      numRows);
+}
+
+// Moves the result to the caller's buffers if the last pass left it in the
+// alternate buffers.
+template <typename K>
+void __global__ __launch_bounds__(kSortThreads) copyResult(
+    const int* selectors,
+    int32_t numPasses,
+    SortBuffers<K> buffers,
+    int32_t numRows) {
+  if (selectors[numPasses * 2] == 0) {
+    return;
+  }
+  auto row = blockIdx.x * blockDim.x + threadIdx.x;
+  if (row < numRows) {
+    buffers.keys[0][row] = buffers.keys[1][row];
+    buffers.values[0][row] = buffers.values[1][row];
+  }
+}
+
+// Returns the offset of an area of 'bytes' at the end of 'size' bytes and adds
+// 'bytes' to 'size'.
+int64_t addArea(int64_t& size, int64_t bytes) {
+  auto offset = size;
+  size = roundUp(size + bytes, 16);
+  return offset;
+}
+
+} // namespace
+
+template <typename T>
+void radixSort(
+    T* keys,
+    int32_t* values,
+    int32_t numRows,
+    bool descending,
+    GpuArena& arena,
+    Stream& stream,
+    WaveBufferPtr& temp) {
+  using K = BreezeKey<T>;
+  static_assert(sizeof(K) == sizeof(T));
+  constexpr int32_t kEndBit = sizeof(K) * 8;
+  constexpr int32_t kNumPasses = (kEndBit + kRadixBits - 1) / kRadixBits;
+  constexpr int32_t kHistogramSize = kNumBins * kNumPasses;
+  constexpr int32_t kScratchSize = sizeof(typename DeviceSort<K>::Scratch);
+  if (numRows == 0) {
+    return;
+  }
+  const int32_t numBlocks = roundUp(numRows, kSortItems) / kSortItems;
+  const int32_t numHistogramBlocks =
+      roundUp(numRows, kHistogramTileItems) / kHistogramTileItems;
+  const int32_t numRowBlocks = roundUp(numRows, kSortThreads) / kSortThreads;
+
+  // The histogram, block indices and lookback blocks must start at zero and
+  // are first in 'temp'.
+  int64_t size = 0;
+  auto histogramOffset = addArea(size, kHistogramSize * sizeof(unsigned));
+  auto nextBlockIdxOffset = addArea(size, kNumPasses * sizeof(int));
+  auto blocksOffset =
+      addArea(size, int64_t(kNumPasses) * numBlocks * kNumBins * 4);
+  auto zeroSize = size;
+  auto offsetsOffset = addArea(size, kHistogramSize * sizeof(unsigned));
+  auto advancementsOffset = addArea(size, kNumPasses * sizeof(int));
+  auto selectorsOffset = addArea(size, (2 * kNumPasses + 1) * sizeof(int));
+  auto keysOffset = addArea(size, int64_t(numRows) * sizeof(K));
+  auto valuesOffset = addArea(size, int64_t(numRows) * sizeof(int32_t));
+  temp = arena.allocate<char>(size);
+  auto base = temp->as<char>();
+  auto histogram = reinterpret_cast<unsigned*>(base + histogramOffset);
+  auto nextBlockIdx = reinterpret_cast<int*>(base + nextBlockIdxOffset);
+  auto blocks = reinterpret_cast<unsigned*>(base + blocksOffset);
+  auto offsets = reinterpret_cast<unsigned*>(base + offsetsOffset);
+  auto advancements = reinterpret_cast<int*>(base + advancementsOffset);
+  auto selectors = reinterpret_cast<int*>(base + selectorsOffset);
+  SortBuffers<K> buffers;
+  buffers.keys[0] = reinterpret_cast<K*>(keys);
+  buffers.keys[1] = reinterpret_cast<K*>(base + keysOffset);
+  buffers.values[0] = values;
+  buffers.values[1] = reinterpret_cast<int32_t*>(base + valuesOffset);
+
+  auto cudaStream = stream.stream()->stream;
+  stream.memset(base, 0, zeroSize);
+  if (descending) {
+    flipKeys<K><<<numRowBlocks, kSortThreads, 0, cudaStream>>>(
+        buffers.keys[0], numRows);
+  }
+  buildHistogram<K><<<numHistogramBlocks, kSortThreads, 0, cudaStream>>>(
+      buffers.keys[0], histogram, numRows);
+  scanHistogram<<<kNumPasses, kSortThreads, 0, cudaStream>>>(
+      histogram, offsets, advancements);
+  selectBuffers<<<1, 1, 0, cudaStream>>>(advancements, kNumPasses, selectors);
+  CUDA_CHECK(cudaFuncSetAttribute(
+      sortPass<K>, cudaFuncAttributeMaxDynamicSharedMemorySize, kScratchSize));
+  for (auto pass = 0; pass < kNumPasses; ++pass) {
+    auto startBit = pass * kRadixBits;
+    sortPass<K><<<numBlocks, kSortThreads, kScratchSize, cudaStream>>>(
+        selectors + pass * 2,
+        offsets + pass * kNumBins,
+        startBit,
+        std::min(kRadixBits, kEndBit - startBit),
+        buffers,
+        nextBlockIdx + pass,
+        blocks + int64_t(pass) * numBlocks * kNumBins,
+        numRows);
+  }
+  copyResult<K><<<numRowBlocks, kSortThreads, 0, cudaStream>>>(
+      selectors, kNumPasses, buffers, numRows);
+  if (descending) {
+    flipKeys<K><<<numRowBlocks, kSortThreads, 0, cudaStream>>>(
+        buffers.keys[0], numRows);
+  }
+  CUDA_CHECK(cudaGetLastError());
+}
+
+template void radixSort<int32_t>(
+    int32_t*,
+    int32_t*,
+    int32_t,
+    bool,
+    GpuArena&,
+    Stream&,
+    WaveBufferPtr&);
+template void radixSort<uint32_t>(
+    uint32_t*,
+    int32_t*,
+    int32_t,
+    bool,
+    GpuArena&,
+    Stream&,
+    WaveBufferPtr&);
+template void radixSort<int64_t>(
+    int64_t*,
+    int32_t*,
+    int32_t,
+    bool,
+    GpuArena&,
+    Stream&,
+    WaveBufferPtr&);
+template void radixSort<uint64_t>(
+    uint64_t*,
+    int32_t*,
+    int32_t,
+    bool,
+    GpuArena&,
+    Stream&,
+    WaveBufferPtr&);
+
+} // namespace facebook::velox::wave
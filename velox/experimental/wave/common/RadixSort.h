@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/GpuArena.h"
+
+namespace facebook::velox::wave {
+
+/// Sorts 'numRows' 'keys' on device with a device-wide LSD radix sort built
+/// on Breeze. 'values', e.g. row numbers to gather the sorted rows with, are
+/// permuted together with the keys. The sort is stable. T is int32_t,
+/// uint32_t, int64_t or uint64_t. 'keys' and 'values' are device or unified
+/// memory and get the sorted result. The work is enqueued on 'stream' without
+/// waiting for the device. The alternate buffers and histograms are allocated
+/// from 'arena' and returned in 'temp', which the caller must keep alive until
+/// 'stream' is done.
+template <typename T>
+void radixSort(
+    T* keys,
+    int32_t* values,
+    int32_t numRows,
+    bool descending,
+    GpuArena& arena,
+    Stream& stream,
+    WaveBufferPtr& temp);
+
+} // namespace facebook::velox::wave
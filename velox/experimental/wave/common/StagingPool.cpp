@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/experimental/wave/common/StagingPool.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/experimental/wave/common/GpuArena.h"
+
+namespace facebook::velox::wave {
+
+StagingPool::StagingPool(GpuArena& hostArena, int32_t maxSlots)
+    : hostArena_(hostArena), maxSlots_(maxSlots) {
+  VELOX_CHECK_GT(maxSlots_, 0);
+}
+
+StagingPool::~StagingPool() {
+  for (auto& slot : slots_) {
+    VELOX_CHECK(!slot->leased, "Staging slot not returned before destruction");
+    if (slot->inFlight) {
+      slot->event->wait();
+    }
+  }
+}
+
+StagingPool::Slot* StagingPool::acquire(int64_t bytes) {
+  Slot* slot = nullptr;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    Slot* oldest = nullptr;
+    for (auto& candidate : slots_) {
+      if (candidate->leased) {
+        continue;
+      }
+      if (!candidate->inFlight || candidate->event->query()) {
+        candidate->inFlight = false;
+        slot = candidate.get();
+        break;
+      }
+      if (!oldest || candidate->sequence < oldest->sequence) {
+        oldest = candidate.get();
+      }
+    }
+    if (!slot &&
+        (!oldest || slots_.size() < static_cast<size_t>(maxSlots_))) {
+      // All slots are leased or there is room for one more. Leased slots are
+      // not waited for since the same thread may hold them.
+      slots_.push_back(std::make_unique<Slot>());
+      slot = slots_.back().get();
+      slot->stream = std::make_unique<Stream>();
+      slot->event = std::make_unique<Event>();
+    }
+    if (!slot) {
+      slot = oldest;
+    }
+    slot->leased = true;
+  }
+  if (slot->inFlight) {
+    slot->event->wait();
+    slot->inFlight = false;
+  }
+  if (slot->capacity() < bytes) {
+    slot->buffer.reset();
+    slot->buffer = hostArena_.allocate<char>(bytes);
+  }
+  return slot;
+}
+
+void StagingPool::transfer(
+    Slot* slot,
+    void* deviceAddress,
+    int64_t bytes,
+    Stream& consumer) {
+  VELOX_CHECK(slot->leased);
+  VELOX_CHECK_LE(bytes, slot->capacity());
+  slot->stream->hostToDeviceAsync(deviceAddress, slot->data(), bytes);
+  slot->event->record(*slot->stream);
+  slot->event->wait(consumer);
+  std::lock_guard<std::mutex> l(mutex_);
+  slot->inFlight = true;
+  slot->sequence = ++sequence_;
+  slot->leased = false;
+}
+
+void StagingPool::release(Slot* slot) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(slot->leased);
+  slot->leased = false;
+}
+
+} // namespace facebook::velox::wave
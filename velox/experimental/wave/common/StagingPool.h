@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "velox/experimental/wave/common/Buffer.h"
+#include "velox/experimental/wave/common/Cuda.h"
+
+namespace facebook::velox::wave {
+
+class GpuArena;
+
+/// Pool of pinned host buffers for host to device transfers. Each
+/// buffer has its own copy stream, so that filling and copying the
+/// next batch overlaps with the kernels consuming the previous
+/// one. A consumer stream waits for the copy with an event instead
+/// of having the copy enqueued in front of its kernels.
+class StagingPool {
+ public:
+  struct Slot {
+    char* data() const {
+      return buffer->as<char>();
+    }
+
+    int64_t capacity() const {
+      return buffer ? buffer->capacity() : 0;
+    }
+
+    // Pinned host memory.
+    WaveBufferPtr buffer;
+
+    // Stream on which the copy from 'buffer' is enqueued.
+    std::unique_ptr<Stream> stream;
+
+    // Recorded on 'stream' after the copy.
+    std::unique_ptr<Event> event;
+
+    // True between acquire() and transfer().
+    bool leased{false};
+
+    // True if a copy from 'buffer' may be in progress.
+    bool inFlight{false};
+
+    // Serial number of the last transfer. The slot with the lowest one is
+    // waited for first.
+    int64_t sequence{0};
+  };
+
+  /// Makes a pool with up to 'maxSlots' buffers allocated from 'hostArena'.
+  /// 'hostArena' must produce pinned host memory.
+  StagingPool(GpuArena& hostArena, int32_t maxSlots);
+
+  ~StagingPool();
+
+  /// Returns a slot with at least 'bytes' of pinned host memory. Blocks until
+  /// a previous transfer from the slot is complete if all slots are in flight.
+  Slot* acquire(int64_t bytes);
+
+  /// Enqueues a copy of 'bytes' from the host buffer of 'slot' to
+  /// 'deviceAddress' on the copy stream of 'slot'. Work enqueued on
+  /// 'consumer' after this waits for the copy. 'slot' returns to the pool.
+  void transfer(
+      Slot* slot,
+      void* deviceAddress,
+      int64_t bytes,
+      Stream& consumer);
+
+  /// Returns 'slot' to the pool without a transfer.
+  void release(Slot* slot);
+
+  int32_t numSlots() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return slots_.size();
+  }
+
+ private:
+  GpuArena& hostArena_;
+  const int32_t maxSlots_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Slot>> slots_;
+  int64_t sequence_{0};
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/common/RadixSort.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace facebook::velox;
+using namespace facebook::velox::wave;
+
+class RadixSortTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    device_ = getDevice();
+    setDevice(device_);
+    arena_ = std::make_unique<GpuArena>(1 << 28, getAllocator(device_));
+  }
+
+  // Sorts 'numRows' random keys with row numbers as values and checks the
+  // result against std::stable_sort. Keys are drawn from 'numDistinct'
+  // values to have duplicates.
+  template <typename T>
+  void testSort(int32_t numRows, uint64_t numDistinct, bool descending) {
+    std::mt19937_64 rng(numRows);
+    std::vector<T> expectedKeys(numRows);
+    for (auto& key : expectedKeys) {
+      key = static_cast<T>(
+          rng() % numDistinct - (std::is_signed_v<T> ? numDistinct / 2 : 0));
+    }
+    auto keysBuffer = arena_->allocate<T>(numRows);
+    auto valuesBuffer = arena_->allocate<int32_t>(numRows);
+    auto keys = keysBuffer->template as<T>();
+    auto values = valuesBuffer->as<int32_t>();
+    std::copy(expectedKeys.begin(), expectedKeys.end(), keys);
+    std::iota(values, values + numRows, 0);
+
+    std::vector<int32_t> expectedValues(numRows);
+    std::iota(expectedValues.begin(), expectedValues.end(), 0);
+    std::stable_sort(
+        expectedValues.begin(),
+        expectedValues.end(),
+        [&](auto left, auto right) {
+          return descending ? expectedKeys[left] > expectedKeys[right]
+                            : expectedKeys[left] < expectedKeys[right];
+        });
+
+    Stream stream;
+    WaveBufferPtr temp;
+    radixSort(keys, values, numRows, descending, *arena_, stream, temp);
+    stream.wait();
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(expectedValues[i], values[i]) << i;
+      ASSERT_EQ(expectedKeys[expectedValues[i]], keys[i]) << i;
+    }
+  }
+
+  Device* device_;
+  std::unique_ptr<GpuArena> arena_;
+};
+
+TEST_F(RadixSortTest, int32) {
+  testSort<int32_t>(1, 10, false);
+  testSort<int32_t>(1'000, 100, false);
+  testSort<int32_t>(1'000'003, 1ULL << 32, false);
+  testSort<int32_t>(1'000'003, 1'000, true);
+}
+
+TEST_F(RadixSortTest, uint32) {
+  testSort<uint32_t>(100'003, 1ULL << 32, false);
+  testSort<uint32_t>(100'003, 1ULL << 32, true);
+}
+
+TEST_F(RadixSortTest, int64) {
+  testSort<int64_t>(1'000'003, ~0ULL, false);
+  testSort<int64_t>(1'000'003, 10'000, true);
+}
+
+TEST_F(RadixSortTest, uint64) {
+  testSort<uint64_t>(100'003, ~0ULL, false);
+  // All keys equal. Every pass is skipped and the input order stays.
+  testSort<uint64_t>(100'003, 1, true);
+}
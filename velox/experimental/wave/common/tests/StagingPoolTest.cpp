@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/experimental/wave/common/StagingPool.h"
+#include <gtest/gtest.h>
+#include "velox/experimental/wave/common/GpuArena.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::wave;
+
+class StagingPoolTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    device_ = getDevice();
+    setDevice(device_);
+    hostArena_ = std::make_unique<GpuArena>(
+        1 << 20, getHostAllocator(device_), 16 << 20);
+    deviceArena_ = std::make_unique<GpuArena>(
+        1 << 20, getDeviceAllocator(device_), 16 << 20);
+  }
+
+  Device* device_;
+  std::unique_ptr<GpuArena> hostArena_;
+  std::unique_ptr<GpuArena> deviceArena_;
+};
+
+TEST_F(StagingPoolTest, overlappedTransfers) {
+  constexpr int32_t kNumBatches = 10;
+  StagingPool pool(*hostArena_, 2);
+  Stream consumer;
+  std::vector<WaveBufferPtr> deviceBuffers;
+  std::vector<WaveBufferPtr> results;
+  for (auto batch = 0; batch < kNumBatches; ++batch) {
+    // Batches grow so that slots get reallocated.
+    int32_t numInts = 1000 * (batch + 1);
+    auto* slot = pool.acquire(numInts * sizeof(int32_t));
+    auto* ints = reinterpret_cast<int32_t*>(slot->data());
+    for (auto i = 0; i < numInts; ++i) {
+      ints[i] = batch * 100000 + i;
+    }
+    deviceBuffers.push_back(deviceArena_->allocate<int32_t>(numInts));
+    pool.transfer(
+        slot,
+        deviceBuffers.back()->as<char>(),
+        numInts * sizeof(int32_t),
+        consumer);
+    results.push_back(hostArena_->allocate<int32_t>(numInts));
+    consumer.deviceToHostAsync(
+        results.back()->as<char>(),
+        deviceBuffers.back()->as<char>(),
+        numInts * sizeof(int32_t));
+  }
+  consumer.wait();
+  EXPECT_EQ(2, pool.numSlots());
+  for (auto batch = 0; batch < kNumBatches; ++batch) {
+    auto* ints = results[batch]->as<int32_t>();
+    int32_t numInts = 1000 * (batch + 1);
+    for (auto i = 0; i < numInts; ++i) {
+      ASSERT_EQ(batch * 100000 + i, ints[i]);
+    }
+  }
+}
+
+TEST_F(StagingPoolTest, leasedSlotsAreNotShared) {
+  StagingPool pool(*hostArena_, 1);
+  auto* first = pool.acquire(100);
+  // The only slot is leased. A new one is made instead of waiting.
+  auto* second = pool.acquire(100);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(2, pool.numSlots());
+  pool.release(first);
+  pool.release(second);
+  EXPECT_EQ(first, pool.acquire(100));
+  pool.release(first);
+}
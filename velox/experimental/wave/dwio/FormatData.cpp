@@ -25,6 +25,25 @@ DEFINE_int32(
     300000,
     "Make a parallel memcpy shard per this many bytes");
 
+DEFINE_bool(
+    wave_overlap_transfer,
+    true,
+    "Copy decode inputs to device on a separate stream from a pool of "
+    "pinned buffers so that the copy overlaps with running kernels. "
+    "Transfer wait time is then not measured by wave_transfer_timing");
+
+DEFINE_int32(
+    wave_staging_slots,
+    4,
+    "Number of pinned host buffers with their own copy stream used for "
+    "overlapped host to device transfer");
+
+DEFINE_int64(
+    wave_staging_slot_bytes,
+    64 << 20,
+    "Max size of a host to device transfer that goes through the pinned "
+    "buffer pool. Larger transfers use a dedicated pinned buffer");
+
 namespace facebook::velox::wave {
 
 BufferId SplitStaging::add(Staging& staging) {
@@ -74,6 +93,24 @@ GpuArena& getTransferArena() {
   return *arena;
 }
 
+// Pinned buffers with their copy streams for transfers of at most
+// FLAGS_wave_staging_slot_bytes. Shared by all WaveStreams.
+StagingPool& getStagingPool() {
+  static std::unique_ptr<StagingPool> pool = std::make_unique<StagingPool>(
+      getTransferArena(), FLAGS_wave_staging_slots);
+  return *pool;
+}
+
+void SplitStaging::enqueueCopy(Stream& stream) {
+  if (slot_) {
+    getStagingPool().transfer(slot_, deviceBuffer_->as<char>(), fill_, stream);
+    slot_ = nullptr;
+    return;
+  }
+  stream.hostToDeviceAsync(
+      deviceBuffer_->as<char>(), hostBuffer_->as<char>(), fill_);
+}
+
 // Starts the transfers registered with add(). 'stream' is set to a stream
 // where operations depending on the transfer may be queued.
 void SplitStaging::transfer(
@@ -93,8 +130,14 @@ void SplitStaging::transfer(
   }
   WaveTime startTime = WaveTime::now();
   deviceBuffer_ = waveStream.deviceArena().allocate<char>(fill_);
-  hostBuffer_ = getTransferArena().allocate<char>(fill_);
-  auto transferBuffer = hostBuffer_->as<char>();
+  char* transferBuffer;
+  if (FLAGS_wave_overlap_transfer && fill_ <= FLAGS_wave_staging_slot_bytes) {
+    slot_ = getStagingPool().acquire(fill_);
+    transferBuffer = slot_->data();
+  } else {
+    hostBuffer_ = getTransferArena().allocate<char>(fill_);
+    transferBuffer = hostBuffer_->as<char>();
+  }
   int firstToCopy = 0;
   int64_t copySize = 0;
   auto targetCopySize = FLAGS_staging_bytes_per_thread;
@@ -134,8 +177,7 @@ void SplitStaging::transfer(
       for (auto i = 0; i < numThreads; ++i) {
         sem_.acquire();
       }
-      stream.hostToDeviceAsync(
-          deviceBuffer_->as<char>(), hostBuffer_->as<char>(), fill_);
+      enqueueCopy(stream);
       waveStream.stats().stagingTime += WaveTime::now() - startTime;
       if (recordEvent) {
         event_ = std::make_unique<Event>();
@@ -151,8 +193,7 @@ void SplitStaging::transfer(
     for (auto i = 0; i < numThreads; ++i) {
       sem_.acquire();
     }
-    stream.hostToDeviceAsync(
-        deviceBuffer_->as<char>(), hostBuffer_->as<char>(), fill_);
+    enqueueCopy(stream);
     waveStream.stats().stagingTime += WaveTime::now() - startTime;
     if (recordEvent) {
       event_ = std::make_unique<Event>();
@@ -23,6 +23,7 @@
 #include "velox/dwio/common/ScanSpec.h"
 #include "velox/dwio/common/Statistics.h"
 #include "velox/dwio/common/TypeWithId.h"
+#include "velox/experimental/wave/common/StagingPool.h"
 #include "velox/experimental/wave/dwio/decode/DecodeStep.h"
 #include "velox/experimental/wave/exec/OperandSet.h"
 #include "velox/experimental/wave/vector/WaveVector.h"
@@ -129,12 +130,20 @@ class SplitStaging {
 
   void copyColumns(int32_t begin, int32_t end, char* destination, bool release);
 
+  // Enqueues the copy of the staged data to 'deviceBuffer_'. Goes through
+  // 'slot_' on its own stream if set, otherwise on 'stream'.
+  void enqueueCopy(Stream& stream);
+
   const int32_t id_;
 
   // Pinned host memory for transfer to device. May be nullptr if using unified
   // memory.
   WaveBufferPtr hostBuffer_;
 
+  // Pooled pinned buffer and copy stream for the transfer. Returned to the
+  // pool when the copy is enqueued. nullptr if using 'hostBuffer_'.
+  StagingPool::Slot* slot_{nullptr};
+
   // Device accessible memory (device or unified) with the data to read.
   WaveBufferPtr deviceBuffer_;
 
@@ -95,6 +95,8 @@ enum class DecodeStep {
   kFlatMapNode,
   kRowCountNoFilter,
   kCountBits,
+  kParquetRleBp,
+  kParquetDeltaBinaryPacked,
   kUnsupported,
 };
 
@@ -113,6 +115,28 @@ enum class DictMode {
 
 class ColumnReader;
 
+/// A run of a Parquet RLE/bit-packed hybrid stream. The run headers are
+/// scanned on host, the run bodies are decoded on device.
+struct ParquetRun {
+  // Position of the first value of the run in the stream.
+  int32_t firstRow;
+  // Repeated value of an RLE run. 0 for a bit-packed run.
+  uint32_t value;
+  // Start of the values of a bit-packed run. nullptr for an RLE run.
+  const uint8_t* packed;
+};
+
+/// A miniblock of a Parquet DELTA_BINARY_PACKED stream. The block headers are
+/// parsed on host.
+struct ParquetMiniblock {
+  // Start of the bit-packed deltas.
+  const uint8_t* packed;
+  // Minimum delta of the containing block. Added to each delta.
+  int64_t minDelta;
+  // Bit width of each delta.
+  int32_t bitWidth;
+};
+
 /// Describes a decoding loop's input and result disposition.
 struct alignas(16) GpuDecode {
   /// Constant in 'numRows' to signify the number comes from 'blockstatus'.
@@ -380,6 +404,45 @@ struct alignas(16) GpuDecode {
     uint8_t* sourceNull;
   };
 
+  struct ParquetRleBp {
+    // Type of the alphabet and result. INTEGER if 'alphabet' is nullptr.
+    WaveTypeKind dataType;
+    // Dictionary alphabet, e.g. the PLAIN encoded dictionary page. If nullptr,
+    // the decoded indices are the result, e.g. for definition levels.
+    const void* alphabet;
+    // Runs of the stream in order of 'firstRow'. The first starts at 0.
+    const ParquetRun* runs;
+    // Number of runs.
+    int32_t numRuns;
+    // Bit width of each index.
+    int32_t bitWidth;
+    // Begin position for indices, scatter and result.
+    int begin;
+    // End position (exclusive) for indices, scatter and result.
+    int end;
+    // If not null, contains the output position relative to result pointer.
+    const int32_t* scatter;
+    // Starting address of the result.
+    void* result;
+  };
+
+  struct ParquetDeltaBinaryPacked {
+    // Type of the result. INTEGER or BIGINT.
+    WaveTypeKind dataType;
+    // The first value. The deltas apply from the second value on.
+    int64_t firstValue;
+    // Miniblocks of the stream in order.
+    const ParquetMiniblock* miniblocks;
+    // Number of deltas in each miniblock.
+    int32_t valuesPerMiniblock;
+    // Number of values, including the first value.
+    int32_t numValues;
+    // If not null, contains the output position relative to result pointer.
+    const int32_t* scatter;
+    // Starting address of the result.
+    void* result;
+  };
+
   union {
     Trivial trivial;
     MainlyConstant mainlyConstant;
@@ -392,6 +455,8 @@ struct alignas(16) GpuDecode {
     RowCountNoFilter rowCountNoFilter;
     CountBits countBits;
     CompactValues compact;
+    ParquetRleBp parquetRleBp;
+    ParquetDeltaBinaryPacked parquetDelta;
   } data;
 
   /// Returns the amount of int aligned global memory per TB needed in 'temp'
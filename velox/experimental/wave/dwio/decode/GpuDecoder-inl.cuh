@@ -602,6 +602,140 @@ __device__ void makeScatterIndices(GpuDecode::MakeScatterIndices& op) {
   }
 }
 
+// Returns 'bitWidth' bits starting 'bitIndex' bits after 'data'. Reads bytes to
+// not touch memory past the end of a Parquet page.
+__device__ inline uint64_t
+loadBits(const uint8_t* data, int64_t bitIndex, int32_t bitWidth) {
+  if (bitWidth == 0) {
+    return 0;
+  }
+  auto bytes = data + (bitIndex >> 3);
+  int32_t shift = bitIndex & 7;
+  int32_t numBytes = (shift + bitWidth + 7) >> 3;
+  uint64_t value = 0;
+  for (auto i = 0; i < min(numBytes, 8); ++i) {
+    value |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+  }
+  value >>= shift;
+  if (numBytes > 8) {
+    value |= static_cast<uint64_t>(bytes[8]) << (64 - shift);
+  }
+  return bitWidth == 64 ? value : value & ((1UL << bitWidth) - 1);
+}
+
+template <typename T>
+__device__ void decodeParquetRleBp(GpuDecode::ParquetRleBp& op) {
+  const T* dict = reinterpret_cast<const T*>(op.alphabet);
+  auto runs = op.runs;
+  auto numRuns = op.numRuns;
+  auto bitWidth = op.bitWidth;
+  auto scatter = op.scatter;
+  auto result = reinterpret_cast<T*>(op.result);
+  for (auto i = op.begin + threadIdx.x; i < op.end; i += blockDim.x) {
+    // The last run that starts at or before 'i'.
+    int32_t lo = 0;
+    int32_t hi = numRuns;
+    while (hi - lo > 1) {
+      auto mid = (lo + hi) / 2;
+      if (runs[mid].firstRow <= i) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+    auto& run = runs[lo];
+    uint64_t index = run.packed
+        ? loadBits(run.packed, int64_t(i - run.firstRow) * bitWidth, bitWidth)
+        : run.value;
+    T value = dict ? dict[index] : static_cast<T>(index);
+    if (scatter) {
+      result[scatter[i]] = value;
+    } else {
+      result[i] = value;
+    }
+  }
+}
+
+__device__ inline void decodeParquetRleBp(GpuDecode& plan) {
+  auto& op = plan.data.parquetRleBp;
+  switch (op.dataType) {
+    case WaveTypeKind::TINYINT:
+      decodeParquetRleBp<uint8_t>(op);
+      break;
+    case WaveTypeKind::SMALLINT:
+      decodeParquetRleBp<uint16_t>(op);
+      break;
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::REAL:
+      decodeParquetRleBp<uint32_t>(op);
+      break;
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::DOUBLE:
+      decodeParquetRleBp<uint64_t>(op);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported data type for ParquetRleBp\n");
+      }
+  }
+}
+
+// Decodes the deltas of a whole page in one thread block. Each value is the
+// prefix sum of the deltas, so the block scans kBlockSize deltas at a time and
+// carries the total to the next.
+template <int kBlockSize, typename T>
+__device__ void decodeParquetDelta(GpuDecode::ParquetDeltaBinaryPacked& op) {
+  using BlockScan = cub::BlockScan<uint64_t, kBlockSize>;
+  extern __shared__ char smem[];
+  auto* scanStorage = reinterpret_cast<typename BlockScan::TempStorage*>(smem);
+  auto numValues = op.numValues;
+  auto valuesPerMiniblock = op.valuesPerMiniblock;
+  auto scatter = op.scatter;
+  auto result = reinterpret_cast<T*>(op.result);
+  // Parquet defines overflow as wrapping around, so the sums are unsigned.
+  uint64_t carry = 0;
+  for (int32_t base = 0; base < numValues; base += kBlockSize) {
+    auto row = base + threadIdx.x;
+    uint64_t delta = 0;
+    if (row == 0) {
+      delta = op.firstValue;
+    } else if (row < numValues) {
+      auto nth = row - 1;
+      auto& miniblock = op.miniblocks[nth / valuesPerMiniblock];
+      delta = miniblock.minDelta +
+          loadBits(
+                  miniblock.packed,
+                  int64_t(nth % valuesPerMiniblock) * miniblock.bitWidth,
+                  miniblock.bitWidth);
+    }
+    uint64_t value;
+    uint64_t total;
+    __syncthreads();
+    BlockScan(*scanStorage).InclusiveSum(delta, value, total);
+    if (row < numValues) {
+      result[scatter ? scatter[row] : row] = static_cast<T>(carry + value);
+    }
+    carry += total;
+  }
+}
+
+template <int kBlockSize>
+__device__ void decodeParquetDelta(GpuDecode& plan) {
+  auto& op = plan.data.parquetDelta;
+  switch (op.dataType) {
+    case WaveTypeKind::INTEGER:
+      decodeParquetDelta<kBlockSize, int32_t>(op);
+      break;
+    case WaveTypeKind::BIGINT:
+      decodeParquetDelta<kBlockSize, int64_t>(op);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported data type for ParquetDeltaBinaryPacked\n");
+      }
+  }
+}
+
 template <typename T, DecodeStep kEncoding>
 inline __device__ T randomAccessDecode(const GpuDecode* op, int32_t idx) {
   switch (kEncoding) {
@@ -1185,6 +1319,12 @@ __device__ void decodeSwitch(GpuDecode& op) {
     case DecodeStep::kRowCountNoFilter:
       detail::setRowCountNoFilter<kBlockSize>(op.data.rowCountNoFilter);
       break;
+    case DecodeStep::kParquetRleBp:
+      detail::decodeParquetRleBp(op);
+      break;
+    case DecodeStep::kParquetDeltaBinaryPacked:
+      detail::decodeParquetDelta<kBlockSize>(op);
+      break;
     default:
       if (threadIdx.x == 0) {
         printf(
@@ -1225,6 +1365,7 @@ template <int32_t kBlockSize>
 int32_t sharedMemorySizeForDecode(DecodeStep step) {
   using Reduce32 = cub::BlockReduce<int32_t, kBlockSize>;
   using BlockScan32 = cub::BlockScan<int32_t, kBlockSize>;
+  using BlockScan64 = cub::BlockScan<uint64_t, kBlockSize>;
   switch (step) {
     case DecodeStep::kSelective32:
     case DecodeStep::kSelective64:
@@ -1234,6 +1375,7 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kCountBits:
     case DecodeStep::kSparseBool:
     case DecodeStep::kRowCountNoFilter:
+    case DecodeStep::kParquetRleBp:
       return 0;
       break;
 
@@ -1246,6 +1388,8 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kMakeScatterIndices:
     case DecodeStep::kLengthToOffset:
       return sizeof(typename BlockScan32::TempStorage);
+    case DecodeStep::kParquetDeltaBinaryPacked:
+      return sizeof(typename BlockScan64::TempStorage);
     default:
       assert(false); // Undefined.
       return 0;
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/decode/ParquetDecode.h"
+
+#include <cstring>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+uint64_t readVarint(const uint8_t*& pos, const uint8_t* end) {
+  uint64_t value = 0;
+  for (auto shift = 0; shift < 64; shift += 7) {
+    VELOX_CHECK_LT(pos, end, "Truncated varint in Parquet page");
+    auto byte = *pos++;
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  VELOX_FAIL("Varint longer than 64 bits in Parquet page");
+}
+
+int64_t readZigZag(const uint8_t*& pos, const uint8_t* end) {
+  auto value = readVarint(pos, end);
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Returns the bytes needed for the first 'numValues' of 'bitWidth' bits.
+int64_t packedBytes(int64_t numValues, int32_t bitWidth) {
+  return (numValues * bitWidth + 7) / 8;
+}
+
+template <typename T>
+T* copyToArena(
+    const std::vector<T>& items,
+    GpuArena& arena,
+    WaveBufferPtr& buffer) {
+  buffer = arena.allocate<T>(std::max<size_t>(items.size(), 1));
+  auto* data = buffer->as<T>();
+  if (!items.empty()) {
+    memcpy(data, items.data(), items.size() * sizeof(T));
+  }
+  return data;
+}
+
+// Returns the byte width of a PLAIN value of 'type' or 0 if 'type' is not a
+// fixed width Parquet physical type.
+int32_t plainWidth(WaveTypeKind type) {
+  switch (type) {
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::REAL:
+      return 4;
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::DOUBLE:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+void setPlain(
+    const ParquetPage& page,
+    void* result,
+    const int32_t* scatter,
+    GpuDecode& op) {
+  VELOX_CHECK_GE(
+      page.size,
+      static_cast<int64_t>(page.numValues) * plainWidth(page.dataType),
+      "Truncated PLAIN Parquet page");
+  op.step = DecodeStep::kTrivial;
+  auto& trivial = op.data.trivial;
+  trivial.dataType = page.dataType;
+  trivial.input = page.deviceData;
+  trivial.begin = 0;
+  trivial.end = page.numValues;
+  trivial.scatter = scatter;
+  trivial.result = result;
+}
+
+void setRleDictionary(
+    const ParquetPage& page,
+    void* result,
+    const int32_t* scatter,
+    GpuArena& arena,
+    WaveBufferPtr& buffer,
+    GpuDecode& op) {
+  VELOX_CHECK_NOT_NULL(
+      page.dictionary, "RLE_DICTIONARY Parquet page needs a dictionary");
+  VELOX_CHECK_GT(page.size, 0, "Missing bit width in Parquet page");
+  // The indices are preceded by their bit width in one byte.
+  int32_t bitWidth = page.hostData[0];
+  VELOX_CHECK_LE(bitWidth, 32, "Bad dictionary index bit width");
+  auto runs = parquetRleBpRuns(
+      page.hostData + 1,
+      page.deviceData + 1,
+      page.size - 1,
+      bitWidth,
+      page.numValues);
+  op.step = DecodeStep::kParquetRleBp;
+  auto& rle = op.data.parquetRleBp;
+  rle.dataType = page.dataType;
+  rle.alphabet = page.dictionary;
+  rle.runs = copyToArena(runs, arena, buffer);
+  rle.numRuns = runs.size();
+  rle.bitWidth = bitWidth;
+  rle.begin = 0;
+  rle.end = page.numValues;
+  rle.scatter = scatter;
+  rle.result = result;
+}
+
+void setDeltaBinaryPacked(
+    const ParquetPage& page,
+    void* result,
+    const int32_t* scatter,
+    GpuArena& arena,
+    WaveBufferPtr& buffer,
+    GpuDecode& op) {
+  VELOX_CHECK(
+      page.dataType == WaveTypeKind::INTEGER ||
+          page.dataType == WaveTypeKind::BIGINT,
+      "DELTA_BINARY_PACKED Parquet page must be INT32 or INT64");
+  const uint8_t* pos = page.hostData;
+  const uint8_t* end = page.hostData + page.size;
+  const int64_t blockSize = readVarint(pos, end);
+  const int64_t miniblocksPerBlock = readVarint(pos, end);
+  const int64_t numValues = readVarint(pos, end);
+  auto firstValue = readZigZag(pos, end);
+  VELOX_CHECK(
+      blockSize > 0 && blockSize % 128 == 0 && miniblocksPerBlock > 0 &&
+          blockSize % miniblocksPerBlock == 0 &&
+          (blockSize / miniblocksPerBlock) % 32 == 0,
+      "Bad DELTA_BINARY_PACKED block size {} with {} miniblocks",
+      blockSize,
+      miniblocksPerBlock);
+  VELOX_CHECK_EQ(
+      numValues,
+      page.numValues,
+      "DELTA_BINARY_PACKED value count does not match the page header");
+  const int32_t valuesPerMiniblock = blockSize / miniblocksPerBlock;
+  std::vector<ParquetMiniblock> miniblocks;
+  int64_t numDeltas = numValues > 0 ? numValues - 1 : 0;
+  for (int64_t delta = 0; delta < numDeltas;) {
+    auto minDelta = readZigZag(pos, end);
+    VELOX_CHECK_LE(
+        miniblocksPerBlock, end - pos, "Truncated DELTA_BINARY_PACKED block");
+    const uint8_t* bitWidths = pos;
+    pos += miniblocksPerBlock;
+    // The bit widths of the miniblocks past the last value are present but
+    // their data is not.
+    for (auto i = 0; i < miniblocksPerBlock && delta < numDeltas; ++i) {
+      int32_t bitWidth = bitWidths[i];
+      VELOX_CHECK_LE(bitWidth, 64, "Bad DELTA_BINARY_PACKED bit width");
+      auto numUsed = std::min<int64_t>(valuesPerMiniblock, numDeltas - delta);
+      VELOX_CHECK_LE(
+          packedBytes(numUsed, bitWidth),
+          end - pos,
+          "Truncated DELTA_BINARY_PACKED miniblock");
+      miniblocks.push_back(
+          {page.deviceData + (pos - page.hostData), minDelta, bitWidth});
+      pos += std::min<int64_t>(
+          packedBytes(valuesPerMiniblock, bitWidth), end - pos);
+      delta += valuesPerMiniblock;
+    }
+  }
+  op.step = DecodeStep::kParquetDeltaBinaryPacked;
+  auto& delta = op.data.parquetDelta;
+  delta.dataType = page.dataType;
+  delta.firstValue = firstValue;
+  delta.miniblocks = copyToArena(miniblocks, arena, buffer);
+  delta.valuesPerMiniblock = valuesPerMiniblock;
+  delta.numValues = numValues;
+  delta.scatter = scatter;
+  delta.result = result;
+}
+
+} // namespace
+
+std::vector<ParquetRun> parquetRleBpRuns(
+    const uint8_t* data,
+    const uint8_t* deviceData,
+    int32_t size,
+    int32_t bitWidth,
+    int32_t numValues) {
+  VELOX_CHECK_LE(bitWidth, 32);
+  std::vector<ParquetRun> runs;
+  const uint8_t* pos = data;
+  const uint8_t* end = data + size;
+  const int32_t valueBytes = (bitWidth + 7) / 8;
+  for (int32_t row = 0; row < numValues;) {
+    auto header = readVarint(pos, end);
+    if (header & 1) {
+      // A bit-packed run of groups of 8 values.
+      int64_t count = (header >> 1) * 8;
+      VELOX_CHECK_GT(count, 0, "Empty bit-packed run in Parquet page");
+      auto numUsed = std::min<int64_t>(count, numValues - row);
+      VELOX_CHECK_LE(
+          packedBytes(numUsed, bitWidth),
+          end - pos,
+          "Truncated bit-packed run in Parquet page");
+      runs.push_back({row, 0, deviceData + (pos - data)});
+      pos += std::min<int64_t>(packedBytes(count, bitWidth), end - pos);
+      row += numUsed;
+    } else {
+      int64_t count = header >> 1;
+      VELOX_CHECK_LE(
+          valueBytes, end - pos, "Truncated RLE run in Parquet page");
+      uint32_t value = 0;
+      memcpy(&value, pos, valueBytes);
+      pos += valueBytes;
+      if (count == 0) {
+        continue;
+      }
+      runs.push_back({row, value, nullptr});
+      row += std::min<int64_t>(count, numValues - row);
+    }
+  }
+  return runs;
+}
+
+void setParquetDecode(
+    const ParquetPage& page,
+    void* result,
+    const int32_t* scatter,
+    GpuArena& arena,
+    WaveBufferPtr& buffer,
+    GpuDecode& op) {
+  switch (page.encoding) {
+    case ParquetEncoding::kPlain:
+      VELOX_CHECK(
+          plainWidth(page.dataType) > 0,
+          "No GPU decoder for PLAIN Parquet page of {}",
+          static_cast<int32_t>(page.dataType));
+      setPlain(page, result, scatter, op);
+      break;
+    case ParquetEncoding::kRleDictionary:
+      VELOX_CHECK(
+          plainWidth(page.dataType) > 0,
+          "No GPU decoder for RLE_DICTIONARY Parquet page of {}",
+          static_cast<int32_t>(page.dataType));
+      setRleDictionary(page, result, scatter, arena, buffer, op);
+      break;
+    case ParquetEncoding::kDeltaBinaryPacked:
+      setDeltaBinaryPacked(page, result, scatter, arena, buffer, op);
+      break;
+  }
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/dwio/decode/DecodeStep.h"
+
+namespace facebook::velox::wave {
+
+/// Encodings of Parquet data page values that have a GPU decoder.
+enum class ParquetEncoding { kPlain, kRleDictionary, kDeltaBinaryPacked };
+
+/// Describes the encoded values of a Parquet data page. The page header and
+/// the repetition and definition levels are parsed on host by the caller. The
+/// headers inside the values, i.e. the run headers of RLE/bit-packed hybrid
+/// indices and the block headers of DELTA_BINARY_PACKED, are scanned on host
+/// by setParquetDecode(). The values themselves are decoded on device.
+struct ParquetPage {
+  ParquetEncoding encoding;
+
+  /// Type of the values. PLAIN and RLE_DICTIONARY return the type of the
+  /// Parquet physical type, i.e. INTEGER, BIGINT, REAL or DOUBLE.
+  /// DELTA_BINARY_PACKED returns INTEGER or BIGINT.
+  WaveTypeKind dataType;
+
+  /// The encoded values in host readable memory.
+  const uint8_t* hostData{nullptr};
+
+  /// The same bytes as 'hostData' in device memory. May be the same as
+  /// 'hostData' for unified memory.
+  const uint8_t* deviceData{nullptr};
+
+  /// Byte size of the encoded values.
+  int32_t size{0};
+
+  /// Number of non-null values in the page.
+  int32_t numValues{0};
+
+  /// Device side values of the dictionary page for kRleDictionary. The
+  /// dictionary page is PLAIN encoded, so this can be its body as is.
+  const void* dictionary{nullptr};
+};
+
+/// Returns the runs of the RLE/bit-packed hybrid stream of 'numValues'
+/// 'bitWidth' bit values in the 'size' bytes at 'data'. The 'packed' pointers
+/// are relative to 'deviceData', which has the same bytes as 'data'. The stream
+/// has no length prefix.
+std::vector<ParquetRun> parquetRleBpRuns(
+    const uint8_t* data,
+    const uint8_t* deviceData,
+    int32_t size,
+    int32_t bitWidth,
+    int32_t numValues);
+
+/// Sets 'op' to decode 'page' into 'result'. If 'scatter' is not nullptr, the
+/// nth value goes to result[scatter[n]], e.g. to leave gaps for nulls. The run
+/// and miniblock tables are allocated from 'arena', which must give host
+/// writable memory, and are owned by 'buffer'. Throws if the page is malformed
+/// or the encoding and type have no GPU decoder.
+void setParquetDecode(
+    const ParquetPage& page,
+    void* result,
+    const int32_t* scatter,
+    GpuArena& arena,
+    WaveBufferPtr& buffer,
+    GpuDecode& op);
+
+} // namespace facebook::velox::wave
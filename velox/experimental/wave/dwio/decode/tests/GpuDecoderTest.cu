@@ -20,6 +20,7 @@
 #include <gtest/gtest.h>
 #include "velox/experimental/gpu/Common.h"
 #include "velox/experimental/wave/dwio/decode/GpuDecoder.cuh"
+#include "velox/experimental/wave/dwio/decode/ParquetDecode.h"
 
 DEFINE_int32(device_id, 0, "");
 DEFINE_bool(benchmark, false, "");
@@ -152,6 +153,139 @@ void makeBitpackDict(
       memory, dictBytes + bitBytes + scatterBytes + resultBytes + statusBytes);
 }
 
+void appendVarint(uint64_t value, std::string& out) {
+  char buffer[10];
+  char* pos = buffer;
+  writeVarint(value, &pos);
+  out.append(buffer, pos - buffer);
+}
+
+uint64_t zigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ (value >> 63);
+}
+
+// Appends 'values' bit-packed LSB first with 'bitWidth' bits each.
+void appendPacked(
+    const uint64_t* values,
+    int32_t numValues,
+    int32_t bitWidth,
+    std::string& out) {
+  uint64_t mask = bitWidth == 64 ? ~0UL : (1UL << bitWidth) - 1;
+  uint64_t word = 0;
+  int32_t numBits = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    auto value = values[i] & mask;
+    word |= value << numBits;
+    auto numLow = std::min(bitWidth, 64 - numBits);
+    numBits += numLow;
+    while (numBits >= 8) {
+      out.push_back(static_cast<char>(word));
+      word >>= 8;
+      numBits -= 8;
+    }
+    if (numLow < bitWidth) {
+      word |= value >> numLow << numBits;
+      numBits += bitWidth - numLow;
+      while (numBits >= 8) {
+        out.push_back(static_cast<char>(word));
+        word >>= 8;
+        numBits -= 8;
+      }
+    }
+  }
+  if (numBits > 0) {
+    out.push_back(static_cast<char>(word));
+  }
+}
+
+// Makes 'numValues' random 'bitWidth' bit values and their Parquet
+// RLE/bit-packed hybrid encoding with alternating RLE and bit-packed runs.
+void makeRleBp(
+    int32_t numValues,
+    int32_t bitWidth,
+    std::vector<uint32_t>& values,
+    std::string& encoded) {
+  uint64_t seed = 0x5de1f6b3c3a1LU + numValues;
+  auto next = [&]() {
+    seed = (seed * 0x5def1) ^ (seed >> 21);
+    return seed;
+  };
+  uint32_t mask = bitWidth == 32 ? ~0U : (1U << bitWidth) - 1;
+  int32_t valueBytes = (bitWidth + 7) / 8;
+  bool rle = true;
+  while (values.size() < numValues) {
+    if (rle) {
+      uint32_t count = 1 + next() % 100;
+      uint32_t value = next() & mask;
+      appendVarint(count << 1, encoded);
+      encoded.append(reinterpret_cast<const char*>(&value), valueBytes);
+      for (uint32_t i = 0; i < count && values.size() < numValues; ++i) {
+        values.push_back(value);
+      }
+    } else {
+      int32_t numGroups = 1 + next() % 8;
+      std::vector<uint64_t> packed(numGroups * 8);
+      for (auto& value : packed) {
+        value = next() & mask;
+      }
+      appendVarint((numGroups << 1) | 1, encoded);
+      appendPacked(packed.data(), packed.size(), bitWidth, encoded);
+      for (auto i = 0; i < packed.size() && values.size() < numValues; ++i) {
+        values.push_back(packed[i]);
+      }
+    }
+    rle = !rle;
+  }
+}
+
+// Returns the Parquet DELTA_BINARY_PACKED encoding of 'values' with 128 value
+// blocks of 4 miniblocks.
+std::string encodeDeltaBinaryPacked(const std::vector<int64_t>& values) {
+  constexpr int32_t kBlockSize = 128;
+  constexpr int32_t kMiniblocks = 4;
+  constexpr int32_t kMiniblockSize = kBlockSize / kMiniblocks;
+  std::string out;
+  appendVarint(kBlockSize, out);
+  appendVarint(kMiniblocks, out);
+  appendVarint(values.size(), out);
+  appendVarint(zigZag(values.empty() ? 0 : values[0]), out);
+  for (int64_t first = 1; first < values.size(); first += kBlockSize) {
+    int64_t numDeltas = std::min<int64_t>(kBlockSize, values.size() - first);
+    std::vector<uint64_t> deltas(kBlockSize, 0);
+    int64_t minDelta = std::numeric_limits<int64_t>::max();
+    for (auto i = 0; i < numDeltas; ++i) {
+      deltas[i] = static_cast<uint64_t>(values[first + i]) -
+          static_cast<uint64_t>(values[first + i - 1]);
+      minDelta = std::min<int64_t>(minDelta, deltas[i]);
+    }
+    appendVarint(zigZag(minDelta), out);
+    uint8_t bitWidths[kMiniblocks] = {};
+    for (auto i = 0; i < numDeltas; ++i) {
+      deltas[i] -= minDelta;
+      auto& width = bitWidths[i / kMiniblockSize];
+      width = std::max<uint8_t>(width, 64 - __builtin_clzll(deltas[i] | 1));
+    }
+    out.append(reinterpret_cast<const char*>(bitWidths), kMiniblocks);
+    // The deltas past the last value are 0 padding. The miniblocks with no
+    // values are left out.
+    for (auto i = 0; i * kMiniblockSize < numDeltas; ++i) {
+      appendPacked(
+          deltas.data() + i * kMiniblockSize,
+          kMiniblockSize,
+          bitWidths[i],
+          out);
+    }
+  }
+  return out;
+}
+
+template <typename T>
+T* copyToDevice(const void* data, int32_t size, gpu::CudaPtr<T[]>& holder) {
+  holder = allocate<T>(size / sizeof(T) + 1);
+  memcpy(holder.get(), data, size);
+  return holder.get();
+}
+
 class GpuDecoderTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -654,6 +788,141 @@ class GpuDecoderTest : public ::testing::Test {
     }
   }
 
+  template <int kBlockSize>
+  void testParquetRleDictionary(int32_t bitWidth, int32_t numValues) {
+    std::vector<uint32_t> indices;
+    std::string encoded(1, static_cast<char>(bitWidth));
+    makeRleBp(numValues, bitWidth, indices, encoded);
+    gpu::CudaPtr<char[]> data;
+    copyToDevice(encoded.data(), encoded.size(), data);
+    auto dict = allocate<int64_t>(1 << bitWidth);
+    for (auto i = 0; i < 1 << bitWidth; ++i) {
+      dict[i] = i * 1'000'000'007LL;
+    }
+    auto result = allocate<int64_t>(numValues);
+    ParquetPage page;
+    page.encoding = ParquetEncoding::kRleDictionary;
+    page.dataType = WaveTypeKind::BIGINT;
+    page.hostData = reinterpret_cast<const uint8_t*>(data.get());
+    page.deviceData = page.hostData;
+    page.size = encoded.size();
+    page.numValues = numValues;
+    page.dictionary = dict.get();
+    auto ops = allocate<GpuDecode>(1);
+    WaveBufferPtr runs;
+    setParquetDecode(page, result.get(), nullptr, *arena_, runs, ops[0]);
+    ASSERT_EQ(DecodeStep::kParquetRleBp, ops[0].step);
+    testCase(
+        "",
+        [&] { decodeGlobal<kBlockSize>(ops.get(), 1); },
+        numValues * sizeof(int64_t),
+        3);
+    for (auto i = 0; i < numValues; ++i) {
+      ASSERT_EQ(dict[indices[i]], result[i]) << i;
+    }
+  }
+
+  template <int kBlockSize>
+  void testParquetLevels(int32_t numValues) {
+    std::vector<uint32_t> levels;
+    std::string encoded;
+    makeRleBp(numValues, 1, levels, encoded);
+    gpu::CudaPtr<char[]> data;
+    auto deviceData = reinterpret_cast<const uint8_t*>(
+        copyToDevice(encoded.data(), encoded.size(), data));
+    auto runs = parquetRleBpRuns(
+        deviceData, deviceData, encoded.size(), 1, numValues);
+    gpu::CudaPtr<ParquetRun[]> deviceRuns;
+    copyToDevice(runs.data(), runs.size() * sizeof(ParquetRun), deviceRuns);
+    auto result = allocate<int32_t>(numValues);
+    auto ops = allocate<GpuDecode>(1);
+    ops[0].step = DecodeStep::kParquetRleBp;
+    auto& op = ops[0].data.parquetRleBp;
+    op.dataType = WaveTypeKind::INTEGER;
+    op.alphabet = nullptr;
+    op.runs = deviceRuns.get();
+    op.numRuns = runs.size();
+    op.bitWidth = 1;
+    op.begin = 0;
+    op.end = numValues;
+    op.scatter = nullptr;
+    op.result = result.get();
+    decodeGlobal<kBlockSize>(ops.get(), 1);
+    CUDA_CHECK_FATAL(cudaGetLastError());
+    CUDA_CHECK_FATAL(cudaDeviceSynchronize());
+    for (auto i = 0; i < numValues; ++i) {
+      ASSERT_EQ(levels[i], result[i]) << i;
+    }
+  }
+
+  template <int kBlockSize>
+  void testParquetPlain(int32_t numValues) {
+    auto values = allocate<int64_t>(numValues);
+    fillRandom(values.get(), numValues);
+    // Leaves a gap for a null after every third value.
+    auto scatter = allocate<int32_t>(numValues);
+    for (auto i = 0; i < numValues; ++i) {
+      scatter[i] = i + i / 3;
+    }
+    auto result = allocate<int64_t>(numValues + numValues / 3);
+    ParquetPage page;
+    page.encoding = ParquetEncoding::kPlain;
+    page.dataType = WaveTypeKind::BIGINT;
+    page.hostData = reinterpret_cast<const uint8_t*>(values.get());
+    page.deviceData = page.hostData;
+    page.size = numValues * sizeof(int64_t);
+    page.numValues = numValues;
+    auto ops = allocate<GpuDecode>(1);
+    WaveBufferPtr unused;
+    setParquetDecode(
+        page, result.get(), scatter.get(), *arena_, unused, ops[0]);
+    decodeGlobal<kBlockSize>(ops.get(), 1);
+    CUDA_CHECK_FATAL(cudaGetLastError());
+    CUDA_CHECK_FATAL(cudaDeviceSynchronize());
+    for (auto i = 0; i < numValues; ++i) {
+      ASSERT_EQ(values[i], result[scatter[i]]) << i;
+    }
+  }
+
+  template <typename T, int kBlockSize>
+  void testParquetDelta(int32_t numValues, int64_t maxStep) {
+    std::vector<int64_t> values(numValues);
+    uint64_t seed = 0x3e7a1f5d9b2cLU;
+    T value = 0;
+    for (auto i = 0; i < numValues; ++i) {
+      seed = (seed * 0x5def1) ^ (seed >> 21);
+      // Mostly small steps with an occasional wide jump.
+      auto step = i % 97 == 0 ? static_cast<int64_t>(seed)
+                              : static_cast<int64_t>(seed % maxStep) -
+              maxStep / 2;
+      value = static_cast<T>(static_cast<uint64_t>(value) + step);
+      values[i] = value;
+    }
+    auto encoded = encodeDeltaBinaryPacked(values);
+    gpu::CudaPtr<char[]> data;
+    copyToDevice(encoded.data(), encoded.size(), data);
+    auto result = allocate<T>(numValues);
+    ParquetPage page;
+    page.encoding = ParquetEncoding::kDeltaBinaryPacked;
+    page.dataType = WaveTypeTrait<T>::typeKind;
+    page.hostData = reinterpret_cast<const uint8_t*>(data.get());
+    page.deviceData = page.hostData;
+    page.size = encoded.size();
+    page.numValues = numValues;
+    auto ops = allocate<GpuDecode>(1);
+    WaveBufferPtr miniblocks;
+    setParquetDecode(page, result.get(), nullptr, *arena_, miniblocks, ops[0]);
+    ASSERT_EQ(DecodeStep::kParquetDeltaBinaryPacked, ops[0].step);
+    testCase(
+        "",
+        [&] { decodeGlobal<kBlockSize>(ops.get(), 1); },
+        numValues * sizeof(T),
+        3);
+    for (auto i = 0; i < numValues; ++i) {
+      ASSERT_EQ(static_cast<T>(values[i]), result[i]) << i;
+    }
+  }
+
   void callViaPrograms(GpuDecode* ops, int32_t numOps) {
     auto stream = std::make_unique<Stream>();
     LaunchParams params(*arena_);
@@ -806,6 +1075,27 @@ TEST_F(GpuDecoderTest, countBits) {
   testCountBits(100000, 2048);
 }
 
+TEST_F(GpuDecoderTest, parquetRleDictionary) {
+  testParquetRleDictionary<256>(1, 1000);
+  testParquetRleDictionary<256>(7, 100'003);
+  testParquetRleDictionary<256>(12, 1'000'003);
+}
+
+TEST_F(GpuDecoderTest, parquetLevels) {
+  testParquetLevels<256>(100'003);
+}
+
+TEST_F(GpuDecoderTest, parquetPlain) {
+  testParquetPlain<256>(100'003);
+}
+
+TEST_F(GpuDecoderTest, parquetDeltaBinaryPacked) {
+  testParquetDelta<int64_t, 256>(1, 10);
+  testParquetDelta<int64_t, 256>(129, 10);
+  testParquetDelta<int64_t, 256>(100'003, 1000);
+  testParquetDelta<int32_t, 256>(100'003, 1 << 20);
+}
+
 TEST_F(GpuDecoderTest, streamApi) {
   //  One call with few blocks, another with many, to cover inlined and out of
   //  line params.
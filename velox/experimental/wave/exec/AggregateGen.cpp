@@ -151,28 +151,24 @@ const char* aggregateOpsBoilerPlate =
     "  void __device__ writeDone(HashRow$I$* row) {}\n"
     "\n";
 
-void makeAggregateOps(
+void makeHashTableOps(
     CompileState& state,
-    const AggregateProbe& probe,
+    int32_t id,
+    const OpVector& keys,
+    bool nullableKeys,
     bool forRead) {
-  state.addInclude("velox/experimental/wave/common/Hash.h");
-  state.addInclude("velox/experimental/wave/common/BitUtil.cuh");
-  state.addInclude("velox/experimental/wave/common/HashTable.cuh");
   auto& out = state.inlines();
-  out << makeAggregateRow(state, probe);
-
-  out << "struct AggregateOps" << probe.id << " {\n"
-      << "  AggregateOps" << probe.id << "() = default;\n"
-      << "  __device__ AggregateOps" << probe.id
+  out << "struct AggregateOps" << id << " {\n"
+      << "  AggregateOps" << id << "() = default;\n"
+      << "  __device__ AggregateOps" << id
       << "(uint64_t hash, WaveShared* shared) : hashNumber(hash), shared(shared){}\n"
       << "  uint64_t hashNumber;\n"
       << "  WaveShared* shared;\n";
   if (forRead) {
   } else {
     out << "  uint64_t __device__ hash(int32_t /*i*/) const { return hashNumber; }\n";
-    makeRowHash(state, probe.keys, true, probe.id);
-    out << replaceAll(
-        aggregateOpsBoilerPlate, "$I$", fmt::format("{}", probe.id));
+    makeRowHash(state, keys, nullableKeys, id);
+    out << replaceAll(aggregateOpsBoilerPlate, "$I$", fmt::format("{}", id));
   }
   out << "};\n\n";
 
@@ -184,12 +180,12 @@ void makeAggregateOps(
          "  if (op.oldBuckets) {\n"
          "    auto table = op.head->table;\n"
          "    reinterpret_cast<GpuHashTable*>(table)->rehash<HashRow"
-      << probe.id
+      << id
       << ">(\n"
          "        reinterpret_cast<GpuBucket*>(op.oldBuckets),\n"
          "        op.numOldBuckets,\n"
          "        AggregateOps"
-      << probe.id
+      << id
       << "(0, nullptr));\n"
          "    return;\n"
          "  }\n"
@@ -200,6 +196,17 @@ void makeAggregateOps(
          "}\n";
 }
 
+void makeAggregateOps(
+    CompileState& state,
+    const AggregateProbe& probe,
+    bool forRead) {
+  state.addInclude("velox/experimental/wave/common/Hash.h");
+  state.addInclude("velox/experimental/wave/common/BitUtil.cuh");
+  state.addInclude("velox/experimental/wave/common/HashTable.cuh");
+  state.inlines() << makeAggregateRow(state, probe);
+  makeHashTableOps(state, probe.id, probe.keys, true, forRead);
+}
+
 /// Emits a lambda that performs the inlined aggregate update.
 void makeUpdateLambda(
     CompileState& state,
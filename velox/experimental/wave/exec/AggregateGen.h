@@ -21,6 +21,16 @@
 
 namespace facebook::velox::wave {
 
+/// Emits the struct of device side hash table operations for the rows of
+/// 'id' and, unless 'forRead', the kernel for initializing and rehashing the
+/// table. Shared between group by and hash join build.
+void makeHashTableOps(
+    CompileState& state,
+    int32_t id,
+    const OpVector& keys,
+    bool nullableKeys,
+    bool forRead);
+
 void makeAggregateOps(
     CompileState& state,
     const AggregateProbe& probe,
@@ -53,6 +53,10 @@ struct DeviceAggregation {
   /// Pointers to group by result row arrays. Subscripts is
   /// '[streamIdx][row + 1]'. Element 0 is the row count.
   uintptr_t** resultRowPointers{nullptr};
+
+  /// Number of rows inserted into a hash join build side. Compared to the
+  /// distinct count of 'table' to check that the build keys are unique.
+  int64_t numBuildRows{0};
 };
 
 /// Parameters for creating/updating a group by.
@@ -43,30 +43,37 @@ void makeHash(
     CompileState& state,
     const std::vector<AbstractOperand*>& keys,
     bool nullableKeys,
-    std::string nullCode) {
+    std::string nullCode,
+    int32_t id) {
   auto& out = state.generated();
   out << "  hash = 1;\n";
   for (auto i = 0; i < keys.size(); ++i) {
     auto* op = keys[i];
     state.ensureOperand(op);
-    if (!nullableKeys && !op->notNull) {
-      out << "  if (" << state.isNull(op) << ") { goto nullKey; }\n";
-    } else {
-      if (!keys[i]->notNull) {
+    if (!keys[i]->notNull) {
+      if (!nullableKeys) {
+        out << "  if (" << state.isNull(op) << ") { goto nullKey" << id
+            << "; }\n";
+      } else {
         out << fmt::format(
             "  if ({}) {{ hash = hashMix(hash, 13); }} else {{ hash = hashMix(hash, hashValue({})); }}\n",
             state.isNull(op),
             state.operandValue(op));
-      } else {
-        out << fmt::format(
-            "  hash = hashMix(hash, hashValue({}));\n", state.operandValue(op));
+        continue;
       }
     }
+    out << fmt::format(
+        "  hash = hashMix(hash, hashValue({}));\n", state.operandValue(op));
   }
   if (!nullableKeys) {
-    out << " goto hashDone;\n"
-        << " nullKey: laneStatus = ErrorCode::kInactive;\n"
-        << nullCode << "  hashDone: ;\n";
+    out << fmt::format(
+        " goto hashDone{};\n"
+        " nullKey{}: laneStatus = ErrorCode::kInactive;\n"
+        "{}  hashDone{}: ;\n",
+        id,
+        id,
+        nullCode,
+        id);
   }
 }
 
@@ -26,13 +26,15 @@ void makeKeyMembers(
     std::stringstream& out);
 /// Emits code for loading hash lookup operands and computing a hash
 /// number. 'nullableKeys' is true for group by and false for join. If
-/// 'nullableKeys' is true, 'anyNullCode' is emitted for the case of
-/// at least one null in the keys.
+/// 'nullableKeys' is false, 'anyNullCode' is emitted for the case of
+/// at least one null in the keys. 'id' makes the labels unique when
+/// there are many hash lookups in one kernel.
 void makeHash(
     CompileState& state,
     const std::vector<AbstractOperand*>& keys,
     bool nullableKeys,
-    std::string anyNullCode = "");
+    std::string anyNullCode = "",
+    int32_t id = 0);
 
 /// Emits a lambda for comparing hash table row with probe keys. 'nullableKeys'
 /// is true for group by. Te signature is [&](HashRow* row) -> bool.
@@ -209,6 +209,99 @@ AdvanceResult AbstractAggregation::canAdvance(
   return {};
 }
 
+std::mutex WaveJoinBridge::bridgesMutex_;
+std::unordered_map<std::string, std::weak_ptr<WaveJoinBridge>>
+    WaveJoinBridge::bridges_;
+
+// static
+std::shared_ptr<WaveJoinBridge> WaveJoinBridge::get(
+    const std::string& taskId,
+    const core::PlanNodeId& planNodeId) {
+  auto id = fmt::format("{}:{}", taskId, planNodeId);
+  std::lock_guard<std::mutex> l(bridgesMutex_);
+  auto it = bridges_.find(id);
+  if (it != bridges_.end()) {
+    auto ptr = it->second.lock();
+    if (ptr) {
+      return ptr;
+    }
+  }
+  auto bridge = std::make_shared<WaveJoinBridge>(id);
+  bridges_[id] = bridge;
+  return bridge;
+}
+
+WaveJoinBridge::~WaveJoinBridge() {
+  std::lock_guard<std::mutex> l(bridgesMutex_);
+  auto it = bridges_.find(idString_);
+  // A new bridge with the same id may have been made after the last reference
+  // to 'this' was dropped.
+  if (it != bridges_.end() && it->second.expired()) {
+    bridges_.erase(it);
+  }
+}
+
+void WaveJoinBridge::setTable(std::shared_ptr<OperatorState> table) {
+  VELOX_CHECK_NOT_NULL(table);
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK_NULL(table_, "Hash join build side set twice");
+    table_ = std::move(table);
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+std::shared_ptr<OperatorState> WaveJoinBridge::table(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!table_ && future) {
+    auto [promise, semiFuture] =
+        makeVeloxContinuePromiseContract("WaveJoinBridge::table");
+    promises_.push_back(std::move(promise));
+    *future = std::move(semiFuture);
+  }
+  return table_;
+}
+
+void AbstractHashBuild::allPeersFinished(
+    const std::shared_ptr<OperatorState>& state) const {
+  // The state is made before this also if the build side had no input.
+  VELOX_CHECK_NOT_NULL(state, "Hash join build side has no table");
+  auto* aggState = state->as<AggregateOperatorState>();
+  auto* head = aggState->alignedHead;
+  auto deviceStream = WaveStream::streamFromReserve();
+  deviceStream->prefetch(
+      nullptr, aggState->alignedHead, aggState->alignedHeadSize);
+  deviceStream->wait();
+  if (uniqueKeys) {
+    auto* hashTable = reinterpret_cast<GpuHashTableBase*>(head->table);
+    if (head->numBuildRows != hashTable->numDistinct) {
+      WaveStream::releaseStream(std::move(deviceStream));
+      VELOX_UNSUPPORTED(
+          "Wave inner hash join requires unique build keys: "
+          "{} rows, {} distinct keys",
+          head->numBuildRows,
+          hashTable->numDistinct);
+    }
+  }
+  deviceStream->prefetch(
+      getDevice(), aggState->alignedHead, aggState->alignedHeadSize);
+  deviceStream->wait();
+  WaveStream::releaseStream(std::move(deviceStream));
+  bridge->setTable(state);
+}
+
+exec::BlockingReason AbstractHashProbe::isBlocked(
+    ContinueFuture* future) const {
+  if (!bridge->table(future)) {
+    return exec::BlockingReason::kWaitForJoinBuild;
+  }
+  return exec::BlockingReason::kNotBlocked;
+}
+
 std::pair<int64_t, int64_t> countResultRows(
     std::vector<AllocationRange>& ranges,
     int32_t rowSize) {
@@ -205,7 +205,7 @@ struct AdvanceResult {
 };
 /// Opcodes for abstract instructions that have a host side representation and
 /// status.
-enum class OpCode { kAggregate, kReadAggregate };
+enum class OpCode { kAggregate, kReadAggregate, kHashBuild, kHashProbe };
 
 struct AbstractInstruction {
   AbstractInstruction(OpCode opCode, int32_t serial = -1)
@@ -218,15 +218,20 @@ struct AbstractInstruction {
     return *reinterpret_cast<T*>(this);
   }
 
-  /// Checks blocking for external reasons for a source instruction in a source
-  /// executable. Applies to e.g. exchange.
-  virtual exec::BlockingReason isBlocked(
-      WaveStream& stream,
-      OperatorState* state,
-      ContinueFuture* future) const {
+  /// Checks blocking for external reasons before launching a Program with
+  /// 'this'. Applies to e.g. exchange or a hash join probe waiting for the
+  /// build side. If blocked, sets 'future' to be realized when unblocked.
+  virtual exec::BlockingReason isBlocked(ContinueFuture* future) const {
     return exec::BlockingReason::kNotBlocked;
   }
 
+  /// Called on the last WaveDriver of a Task pipeline to finish after all
+  /// WaveDrivers of the pipeline have finished. 'state' is the state of
+  /// 'this' or nullptr if none. Publishes the result of a sink, e.g. a hash
+  /// join build side.
+  virtual void allPeersFinished(
+      const std::shared_ptr<OperatorState>& state) const {}
+
   /// Prepares the source instruction of a Program that begins with a
   /// source instruction, like reading an aggregation or an
   /// exchange. 'state' is a handle to the state on device. The
@@ -279,7 +284,7 @@ struct AbstractInstruction {
   int32_t serial{-1};
 };
 
-enum class StateKind : uint8_t { kGroupBy };
+enum class StateKind : uint8_t { kGroupBy, kHashJoin };
 
 /// Represents a shared state operated on by instructions. For example, a
 /// join/group by table, destination buffers for repartition etc. Device side
@@ -414,6 +419,84 @@ struct AbstractReadAggregation : public AbstractOperator {
   int32_t continueLabel{-1};
 };
 
+/// Hands the device side hash table of a hash join from the WaveDrivers of
+/// the build pipeline to the WaveDrivers of the probe pipeline. There is one
+/// for each Task and join plan node.
+class WaveJoinBridge {
+ public:
+  explicit WaveJoinBridge(std::string idString)
+      : idString_(std::move(idString)) {}
+
+  ~WaveJoinBridge();
+
+  /// Publishes the build side and unblocks the waiting probes. The build side
+  /// is read-only afterwards.
+  void setTable(std::shared_ptr<OperatorState> table);
+
+  /// Returns the build side or nullptr if it is not yet published. If nullptr
+  /// and 'future' is given, sets 'future' to be realized on setTable().
+  std::shared_ptr<OperatorState> table(ContinueFuture* future);
+
+  static std::shared_ptr<WaveJoinBridge> get(
+      const std::string& taskId,
+      const core::PlanNodeId& planNodeId);
+
+ private:
+  // Concatenation of task id and plan node id.
+  const std::string idString_;
+
+  std::mutex mutex_;
+  std::shared_ptr<OperatorState> table_;
+  std::vector<ContinuePromise> promises_;
+
+  static std::mutex bridgesMutex_;
+  static std::unordered_map<std::string, std::weak_ptr<WaveJoinBridge>>
+      bridges_;
+};
+
+/// Inserts the build side rows of a hash join into a device side hash
+/// table. The table is the same as for a group by with no accumulators, so
+/// running out of rows or buckets is retried like for a group by. The table is
+/// published to the probe side after all WaveDrivers of the build pipeline
+/// have finished.
+struct AbstractHashBuild : public AbstractAggregation {
+  AbstractHashBuild(
+      int32_t serial,
+      std::vector<AbstractOperand*> keys,
+      AbstractState* state,
+      std::shared_ptr<WaveJoinBridge> bridge,
+      bool uniqueKeys)
+      : AbstractAggregation(serial, std::move(keys), {}, state, nullptr),
+        bridge(std::move(bridge)),
+        uniqueKeys(uniqueKeys) {
+    opCode = OpCode::kHashBuild;
+  }
+
+  void allPeersFinished(
+      const std::shared_ptr<OperatorState>& state) const override;
+
+  std::shared_ptr<WaveJoinBridge> bridge;
+
+  // True if the build keys must be unique, e.g. for an inner join that
+  // produces at most one row per probe row.
+  bool uniqueKeys;
+};
+
+/// Looks up the probe rows of a hash join in the table made by an
+/// AbstractHashBuild. Blocks until the build side is published.
+struct AbstractHashProbe : public AbstractOperator {
+  AbstractHashProbe(
+      int32_t serial,
+      AbstractState* state,
+      std::shared_ptr<WaveJoinBridge> bridge)
+      : AbstractOperator(OpCode::kHashProbe, serial, state, nullptr),
+        bridge(std::move(bridge)) {}
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) const override;
+
+  std::shared_ptr<WaveJoinBridge> bridge;
+};
+
 /// Serializes 'row' to characters interpretable on device.
 std::string rowTypeString(const RowTypePtr& row);
 
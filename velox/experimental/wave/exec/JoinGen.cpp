@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/JoinGen.h"
+#include "velox/experimental/wave/exec/AggregateGen.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+// Makes the row of the hash table. The null flags have a bit for each key and
+// dependent column, set if the value is not null. Keys come first. The row is
+// the same for the build and the probe.
+std::string makeJoinRow(
+    int32_t id,
+    const OpVector& keys,
+    const OpVector& dependent) {
+  std::stringstream out;
+  out << "struct HashRow" << id
+      << " {\n"
+         "  int32_t flags;\n";
+  int32_t numNullable = keys.size() + dependent.size();
+  for (auto n = 0; n < numNullable; n += 32) {
+    out << fmt::format("  uint32_t nulls{};\n", n / 32);
+  }
+  makeKeyMembers(keys, out);
+  for (auto i = 0; i < dependent.size(); ++i) {
+    out << cudaTypeName(*dependent[i]->type) << " dependent" << i << ";\n";
+  }
+  out << "};\n\n";
+  return out.str();
+}
+
+// Returns the expression for the null flags word 'nthWord' of a build
+// row. Keys are not null since rows with null keys are not inserted.
+std::string
+joinRowNulls(CompileState& state, const JoinBuild& build, int32_t nthWord) {
+  int32_t numKeys = build.keys.size();
+  uint32_t keyBits = 0;
+  for (auto i = nthWord * 32; i < std::min(numKeys, (nthWord + 1) * 32); ++i) {
+    keyBits |= 1U << (i & 31);
+  }
+  std::stringstream out;
+  out << keyBits << "U";
+  for (auto i = 0; i < build.dependent.size(); ++i) {
+    auto bit = numKeys + i;
+    if (bit / 32 != nthWord) {
+      continue;
+    }
+    out << fmt::format(
+        " | ({} ? 0 : {}U)",
+        state.isNull(build.dependent[i]),
+        1U << (bit & 31));
+  }
+  return out.str();
+}
+
+// Emits a lambda that initializes a new build row. The signature is
+// [&](HashRow* row).
+void makeInitJoinRow(CompileState& state, const JoinBuild& build) {
+  auto& out = state.generated();
+  out << "  [&](HashRow" << build.id << "* row) {\n";
+  for (auto i = 0; i < build.keys.size(); ++i) {
+    out << fmt::format(
+        "   row->key{} = {};\n", i, state.operandValue(build.keys[i]));
+  }
+  for (auto i = 0; i < build.dependent.size(); ++i) {
+    auto* op = build.dependent[i];
+    if (op->notNull) {
+      out << fmt::format(
+          "   row->dependent{} = {};\n", i, state.operandValue(op));
+    } else {
+      out << fmt::format(
+          "   if (!{}) {{ row->dependent{} = {}; }}\n",
+          state.isNull(op),
+          i,
+          state.operandValue(op));
+    }
+  }
+  int32_t numNullable = build.keys.size() + build.dependent.size();
+  for (auto i = 32; i < numNullable; i += 32) {
+    out << fmt::format(
+        "   row->nulls{} = {};\n", i / 32, joinRowNulls(state, build, i / 32));
+  }
+  // The release store of the first flags word publishes the row.
+  out << fmt::format(
+      "  asDeviceAtomic<uint32_t>(&row->nulls0)->store({}, cuda::memory_order_release);\n",
+      joinRowNulls(state, build, 0));
+  out << "}\n";
+}
+
+void addHashIncludes(CompileState& state) {
+  state.addInclude("velox/experimental/wave/common/Hash.h");
+  state.addInclude("velox/experimental/wave/common/BitUtil.cuh");
+  state.addInclude("velox/experimental/wave/common/HashTable.cuh");
+}
+} // namespace
+
+void makeJoinBuild(
+    CompileState& state,
+    const JoinBuild& build,
+    int32_t syncLabel) {
+  addHashIncludes(state);
+  state.addInclude("velox/experimental/wave/exec/Accumulators.cuh");
+  auto id = build.id;
+  state.inlines() << makeJoinRow(id, build.keys, build.dependent);
+  makeHashTableOps(state, id, build.keys, false, false);
+
+  auto stateOrd = state.stateOrdinal(*build.state);
+  auto& out = state.generated();
+  for (auto* op : build.dependent) {
+    state.ensureOperand(op);
+  }
+  state.declareNamed("uint64_t hash;");
+  // A row with a null key is inactive and is not inserted.
+  makeHash(state, build.keys, false, "", id);
+  state.declareNamed(fmt::format("AggregateOps{} ops;", id));
+  out << "  ops = AggregateOps" << id << "(hash, shared);\n";
+  state.declareNamed("DeviceAggregation* state;");
+  out << fmt::format(
+      "  state =\n"
+      "    reinterpret_cast<DeviceAggregation*>(shared->states[{}]);\n",
+      stateOrd);
+  state.declareNamed("GpuHashTable* table;");
+  out << "  table = reinterpret_cast<GpuHashTable*>(state->table);\n";
+  out << fmt::format(" sync{}:\n", syncLabel);
+  out << "  shared->status->errors[threadIdx.x] = laneStatus;\n";
+  out << "  table->updatingProbe<HashRow" << id
+      << ">(threadIdx.x, LaneId(), laneStatus == ErrorCode::kOk, ops, \n";
+  makeCompareLambda(state, build.keys, false, id);
+  out << ",\n";
+  makeInitJoinRow(state, build);
+  out << ",\n";
+  // There is nothing to update in an existing row. Counts the inserted rows
+  // for checking that the keys are unique.
+  out << "  [&](GpuHashTable* table, HashRow" << id
+      << "* row, uint32_t peers, int32_t leader, int32_t laneId) {\n"
+         "    if (laneId == leader) {\n"
+         "      atomicInc(&state->numBuildRows, static_cast<int64_t>(__popc(peers)));\n"
+         "    }\n"
+         "  });\n";
+  out << "      __syncthreads();\n"
+         "  laneStatus = shared->status->errors[threadIdx.x];\n";
+  out << "  if (threadIdx.x == 0 && shared->hasContinue) {\n"
+         "    auto ret = gridStatus<AggregateReturn>(shared, "
+      << build.abstractHashBuild->mutableInstructionStatus()->gridState
+      << ");\n"
+      // Thread 0 may have been inactive and have 'state' and 'table' uninited.
+      << fmt::format(
+             "  state =\n"
+             "    reinterpret_cast<DeviceAggregation*>(shared->states[{}]);\n",
+             stateOrd)
+      << "  table = reinterpret_cast<GpuHashTable*>(state->table);\n"
+         "    ret->numDistinct = table->numDistinct;\n"
+         "  }\n";
+  out << "  __syncthreads();\n";
+}
+
+void makeJoinProbe(CompileState& state, const JoinProbe& probe) {
+  addHashIncludes(state);
+  auto id = probe.id;
+  state.inlines() << makeJoinRow(id, probe.keys, probe.dependent);
+  auto& out = state.generated();
+  auto flagOrd = state.declareVariable(*probe.flag);
+  out << fmt::format("  r{} = false;\n", flagOrd);
+  probe.flag->inRegister = true;
+  out << fmt::format(
+      "  if (laneStatus != ErrorCode::kOk) {{ goto probeDone{}; }}\n", id);
+  state.declareNamed("uint64_t hash;");
+  // A row with a null key has no hit.
+  makeHash(
+      state, probe.keys, false, fmt::format("  goto probeDone{};\n", id), id);
+  state.declareNamed("DeviceAggregation* state;");
+  out << fmt::format(
+      "  state =\n"
+      "    reinterpret_cast<DeviceAggregation*>(shared->states[{}]);\n",
+      state.stateOrdinal(*probe.state));
+  state.declareNamed("GpuHashTable* table;");
+  out << "  table = reinterpret_cast<GpuHashTable*>(state->table);\n";
+  state.declareNamed(fmt::format("HashRow{}* hit{};", id, id));
+  out << fmt::format("  hit{} = table->find<HashRow{}>(hash,\n", id, id);
+  makeCompareLambda(state, probe.keys, false, id);
+  out << ");\n";
+  out << fmt::format("  if (hit{}) {{\n    r{} = true;\n", id, flagOrd);
+  for (auto i = 0; i < probe.dependent.size(); ++i) {
+    auto* op = probe.dependent[i];
+    out << extractColumn(
+        fmt::format("hit{}", id),
+        fmt::format("dependent{}", i),
+        probe.keys.size() + i,
+        state.ordinal(*op),
+        *op);
+    op->isStored = true;
+  }
+  out << "  }\n";
+  out << fmt::format("  probeDone{}: ;\n", id);
+}
+
+} // namespace facebook::velox::wave
@@ -63,6 +63,26 @@ std::vector<AdvanceResult> Project::canAdvance(WaveStream& stream) {
   return {};
 }
 
+exec::BlockingReason Project::isBlocked(ContinueFuture* future) {
+  for (auto& level : levels_) {
+    for (auto& program : level) {
+      auto reason = program->isBlocked(future);
+      if (reason != exec::BlockingReason::kNotBlocked) {
+        return reason;
+      }
+    }
+  }
+  return exec::BlockingReason::kNotBlocked;
+}
+
+void Project::allPeersFinished(WaveStream& stream) {
+  if (!levels_.empty()) {
+    for (auto& program : levels_.back()) {
+      program->allPeersFinished(stream);
+    }
+  }
+}
+
 void Project::callUpdateStatus(WaveStream& stream, AdvanceResult& advance) {
   if (advance.updateStatus) {
     levels_[advance.nthLaunch][advance.programIdx]->callUpdateStatus(
@@ -517,27 +517,99 @@ struct ReadAggregation : public KernelStep {
   int32_t continueLabelN;
 };
 
+/// Inserts the keys and dependent columns of the build side of a hash join
+/// into the hash table in 'state'. Ends the build pipeline.
 struct JoinBuild : public KernelStep {
   StepKind kind() const override {
     return StepKind::kJoinBuild;
   }
+
+  std::optional<int32_t> continueLabel() const override {
+    return continueLabelN;
+  }
+
+  bool isBarrier() const override {
+    return true;
+  }
+
+  bool isSink() const override {
+    return true;
+  }
+
+  int32_t sharedMemorySize() const {
+    return sizeof(WaveShared);
+  }
+
+  void visitReferences(
+      std::function<void(AbstractOperand*)> visitor) const override;
+
+  void visitStates(std::function<void(AbstractState*)> visitor) const override {
+    visitor(state);
+  }
+
+  void generateMain(CompileState& state, int32_t syncLabel) override;
+
+  std::string preContinueCode(CompileState& state) override;
+
+  std::unique_ptr<AbstractInstruction> addInstruction(
+      CompileState& state) override;
+
+  std::string toString() const override;
+
   AbstractState* state;
   std::vector<AbstractOperand*> keys;
   std::vector<AbstractOperand*> dependent;
+
+  /// True if a build key may occur once, e.g. for an inner join.
+  bool uniqueKeys{false};
+
+  /// The join node. Identifies the WaveJoinBridge shared with the probe.
+  core::PlanNodeId planNodeId;
+
+  /// Serial number for the names of the row and ops structs. Unique with the
+  /// aggregation ids of the kernel.
+  int32_t id{0};
+
+  int32_t continueLabelN{-1};
 };
 
+/// Looks up the probe side keys in the table made by a JoinBuild with the same
+/// 'planNodeId'. Sets 'flag' to true for probe rows with a hit and extracts
+/// 'dependent' from the hit. Followed by a Filter on 'flag'.
 struct JoinProbe : public KernelStep {
   StepKind kind() const override {
     return StepKind::kJoinProbe;
   }
-  int32_t isWrap() const override {
-    return nthWrap;
+
+  void visitReferences(
+      std::function<void(AbstractOperand*)> visitor) const override;
+
+  void visitResults(
+      std::function<void(AbstractOperand*)> visitor) const override;
+
+  void visitStates(std::function<void(AbstractState*)> visitor) const override {
+    visitor(state);
   }
 
+  void generateMain(CompileState& state, int32_t syncLabel) override;
+
+  std::unique_ptr<AbstractInstruction> addInstruction(
+      CompileState& state) override;
+
+  std::string toString() const override;
+
   AbstractState* state;
   std::vector<AbstractOperand*> keys;
-  AbstractOperand* hits;
-  int32_t nthWrap{-1};
+
+  /// True for the probe rows with a hit.
+  AbstractOperand* flag;
+
+  /// Build side columns extracted from the hits, in the order of the
+  /// dependent columns of the JoinBuild.
+  std::vector<AbstractOperand*> dependent;
+
+  core::PlanNodeId planNodeId;
+  int32_t id{0};
 };
 
 struct JoinExpand : public KernelStep {
@@ -689,7 +761,9 @@ enum class BoundaryType {
 
   // Filter associated to non-inner join.
   kJoinFilter,
-  kAggregation
+  kAggregation,
+  // Hash join build side. Ends a pipeline.
+  kJoinBuild
 };
 
 /// Describes the space between cardinality changes in an operator pipeline.
@@ -1177,7 +1177,38 @@ void Program::getOperatorStates(WaveStream& stream, std::vector<void*>& ptrs) {
 
 bool Program::isSink() const {
   int32_t size = instructions_.size();
-  return instructions_[size - 1]->isSink();
+  return size > 0 && instructions_[size - 1]->isSink();
+}
+
+exec::BlockingReason Program::isBlocked(ContinueFuture* future) const {
+  for (auto& instruction : instructions_) {
+    auto reason = instruction->isBlocked(future);
+    if (reason != exec::BlockingReason::kNotBlocked) {
+      return reason;
+    }
+  }
+  return exec::BlockingReason::kNotBlocked;
+}
+
+void Program::allPeersFinished(WaveStream& stream) {
+  if (!isSink()) {
+    return;
+  }
+  std::vector<void*> ignore;
+  getOperatorStates(stream, ignore);
+  auto* taskStates = stream.taskStateMap();
+  for (auto& instruction : instructions_) {
+    std::shared_ptr<OperatorState> state;
+    auto stateId = instruction->stateId();
+    if (stateId.has_value()) {
+      std::lock_guard<std::mutex> l(taskStates->mutex);
+      auto it = taskStates->states.find(stateId.value());
+      if (it != taskStates->states.end()) {
+        state = it->second;
+      }
+    }
+    instruction->allPeersFinished(state);
+  }
 }
 
 AdvanceResult Program::canAdvance(
@@ -595,6 +595,15 @@ class Program : public std::enable_shared_from_this<Program> {
   /// output vectors, synced on 'hostReturnEvent_'.
   bool isSink() const;
 
+  /// Returns the first blocking reason from an instruction of 'this'. Sets
+  /// 'future' to be realized when unblocked.
+  exec::BlockingReason isBlocked(ContinueFuture* future) const;
+
+  /// Called on the last Driver of the Task pipeline to finish after all have
+  /// finished. Publishes the states of a sink, e.g. a hash join build side.
+  /// Makes the states that do not exist because 'stream' had no input.
+  void allPeersFinished(WaveStream& stream);
+
   /// Records instruction return status. The status is accessed by canAdvance().
   void interpretReturn(
       WaveStream& stream,
@@ -39,9 +39,9 @@ WaveBarrier::WaveBarrier(std::string idString)
 
 std::shared_ptr<WaveBarrier> WaveBarrier::get(
     const std::string& taskId,
-    int32_t driverId,
+    int32_t pipelineId,
     int32_t operatorId) {
-  auto id = fmt::format("{}:{}:{}", taskId, driverId, operatorId);
+  auto id = fmt::format("{}:{}:{}", taskId, pipelineId, operatorId);
   std::lock_guard<std::mutex> l(barriersMutex_);
   auto it = barriers_.find(id);
   if (it != barriers_.end()) {
@@ -284,7 +284,10 @@ WaveDriver::WaveDriver(
           operatorId,
           planNodeId,
           "Wave"),
-      barrier_(WaveBarrier::get(driverCtx->task->taskId(), 0, operatorId)),
+      barrier_(WaveBarrier::get(
+          driverCtx->task->taskId(),
+          driverCtx->pipelineId,
+          operatorId)),
       arena_(std::move(arena)),
       resultOrder_(std::move(resultOrder)),
       runtime_(std::move(runtime)),
@@ -303,8 +306,9 @@ WaveDriver::WaveDriver(
     pipelines_.back().operators.push_back(std::move(op));
   }
   pipelines_.back().needStatus = true;
-  // True unless ends with repartitioning.
-  pipelines_.back().makesHostResult = true;
+  // True unless ends with a sink, e.g. hash join build or repartitioning.
+  pipelines_.back().makesHostResult =
+      !pipelines_.back().operators.back()->isSink();
   pipelines_.front().canAdvance = true;
 }
 
@@ -362,6 +366,9 @@ RowVectorPtr WaveDriver::getOutput() {
               break;
             } else {
               // Last finished.
+              if (maybePublishSink()) {
+                return nullptr;
+              }
               finished_ = true;
               updateStats();
               return nullptr;
@@ -411,6 +418,33 @@ bool WaveDriver::maybeWaitForPeers() {
   return false;
 }
 
+bool WaveDriver::maybePublishSink() {
+  auto& pipeline = pipelines_.back();
+  auto& op = *pipeline.operators.back();
+  if (!op.isSink()) {
+    return false;
+  }
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<exec::Driver>> peers;
+  if (operatorCtx_->task()->numDrivers(operatorCtx_->driver()) > 1 &&
+      !operatorCtx_->task()->allPeersFinished(
+          planNodeId(),
+          operatorCtx_->driver(),
+          &blockingFuture_,
+          promises,
+          peers)) {
+    // The last WaveDriver to finish publishes the sink.
+    blockingReason_ = exec::BlockingReason::kYield;
+    return true;
+  }
+  op.allPeersFinished(*pipeline.finished.front());
+  peers.clear();
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  return false;
+}
+
 void WaveDriver::flush(int32_t pipelineIdx) {
   //
   ;
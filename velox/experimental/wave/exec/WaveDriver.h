@@ -65,7 +65,7 @@ class WaveBarrier {
   void mayYield(std::function<void()> preWait);
 
   static std::shared_ptr<WaveBarrier>
-  get(const std::string& taskId, int32_t driverId, int32_t operatorId);
+  get(const std::string& taskId, int32_t pipelineId, int32_t operatorId);
 
   /// Returns a map of states shared between WaveDrivers of a Velox pipeline.
   OperatorStateMap& stateMap() {
@@ -244,6 +244,12 @@ class WaveDriver : public exec::SourceOperator {
   /// have to be at end before the aggregation is read.
   bool maybeWaitForPeers();
 
+  /// Publishes the result of a sink at the end of the last pipeline, e.g. a
+  /// hash join build side, after all Drivers of the Task pipeline have
+  /// finished. Returns true if 'this' must yield for the other Drivers to
+  /// finish. The last Driver to finish publishes.
+  bool maybePublishSink();
+
   // Carries out advance actions like rehashing tables or getting more memory.
   // Synchronizes with 'barrier_' if needed.
   void prepareAdvance(
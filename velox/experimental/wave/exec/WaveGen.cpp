@@ -15,6 +15,7 @@
  */
 
 #include "velox/experimental/wave/exec/AggregateGen.h"
+#include "velox/experimental/wave/exec/JoinGen.h"
 #include "velox/experimental/wave/exec/Project.h"
 #include "velox/experimental/wave/exec/TableScan.h"
 #include "velox/experimental/wave/exec/ToWave.h"
@@ -395,7 +396,7 @@ std::string CompileState::generateIsTrue(const AbstractOperand& op) {
   if (op.inRegister) {
     if (op.notNull) {
       declareNamed(fmt::format("bool flag{};\n", ord));
-      generated_ << fmt::format("flag{} = r{}", ord, ord);
+      generated_ << fmt::format("flag{} = r{};\n", ord, ord);
     } else {
       generated_ << fmt::format(
           "bool flag{} = r{} && !isRegisterNull(nulls{}, {});\n",
@@ -618,6 +619,77 @@ std::unique_ptr<AbstractInstruction> ReadAggregation::addInstruction(
       state.nextSerial(), probe->abstractAggregation, continueLabelN);
 }
 
+void JoinBuild::generateMain(CompileState& state, int32_t syncLabel) {
+  makeJoinBuild(state, *this, syncLabel);
+}
+
+std::string JoinBuild::preContinueCode(CompileState& state) {
+  return "    laneStatus = laneStatus == ErrorCode::kInsufficientMemory\n"
+         "      ? ErrorCode::kOk : ErrorCode::kInactive;\n";
+}
+
+std::unique_ptr<AbstractInstruction> JoinBuild::addInstruction(
+    CompileState& state) {
+  auto build = std::make_unique<AbstractHashBuild>(
+      state.nextSerial(),
+      keys,
+      this->state,
+      WaveJoinBridge::get(state.driver().task()->taskId(), planNodeId),
+      uniqueKeys);
+  int32_t offset =
+      sizeof(int32_t) + bits::roundUp(keys.size() + dependent.size(), 32) / 8;
+  for (auto& key : keys) {
+    int32_t align = cudaTypeAlign(*key->type);
+    int32_t width = cudaTypeSize(*key->type);
+    offset = bits::roundUp(offset, align) + width;
+  }
+  for (auto& column : dependent) {
+    int32_t align = cudaTypeAlign(*column->type);
+    int32_t width = cudaTypeSize(*column->type);
+    offset = bits::roundUp(offset, align) + width;
+  }
+  build->roundedRowSize = bits::roundUp(offset, 8);
+  build->continueLabel = continueLabelN;
+  abstractHashBuild = build.get();
+  return build;
+}
+
+std::string JoinBuild::toString() const {
+  std::stringstream out;
+  out << "joinBuild {";
+  for (auto& key : keys) {
+    out << key->toString() << " ";
+  }
+  out << "} dependent {";
+  for (auto& column : dependent) {
+    out << column->toString() << " ";
+  }
+  out << "}\n";
+  return out.str();
+}
+
+void JoinProbe::generateMain(CompileState& state, int32_t /*syncLabel*/) {
+  makeJoinProbe(state, *this);
+}
+
+std::unique_ptr<AbstractInstruction> JoinProbe::addInstruction(
+    CompileState& state) {
+  return std::make_unique<AbstractHashProbe>(
+      state.nextSerial(),
+      this->state,
+      WaveJoinBridge::get(state.driver().task()->taskId(), planNodeId));
+}
+
+std::string JoinProbe::toString() const {
+  std::stringstream out;
+  out << "joinProbe {";
+  for (auto& key : keys) {
+    out << key->toString() << " ";
+  }
+  out << "} -> " << flag->toString() << "\n";
+  return out.str();
+}
+
 void writeDebugFile(const KernelSpec& spec) {
   try {
     std::ofstream out(spec.filePath, std::ios_base::out | std::ios_base::trunc);
@@ -899,9 +971,22 @@ void CompileState::makeLevelKernel(std::vector<KernelBox>& level) {
     auto* abstractState = operatorStates_[id].get();
     auto programState = std::make_unique<ProgramState>();
     programState->stateId = abstractState->id;
+    programState->isGlobal = true;
+    if (abstractState->instruction->opCode == OpCode::kHashProbe) {
+      // The probe side reads the table published by the build side.
+      programState->create =
+          [bridge =
+               abstractState->instruction->as<AbstractHashProbe>().bridge](
+              WaveStream& stream) -> std::shared_ptr<OperatorState> {
+        auto table = bridge->table(nullptr);
+        VELOX_CHECK_NOT_NULL(table, "Hash join probed before build");
+        return table;
+      };
+      states.push_back(std::move(programState));
+      return;
+    }
     auto* abstractInst =
         reinterpret_cast<AbstractAggregation*>(abstractState->instruction);
-    programState->isGlobal = true;
     programState->create =
         [inst = abstractInst](
             WaveStream& stream) -> std::shared_ptr<OperatorState> {
@@ -39,6 +39,11 @@ class WaveOperator {
     return exec::BlockingReason::kNotBlocked;
   }
 
+  /// Called on the last WaveDriver of the Task pipeline to finish after all
+  /// WaveDrivers of the pipeline have finished. 'stream' is a finished stream
+  /// of 'this'. A sink publishes its result here.
+  virtual void allPeersFinished(WaveStream& stream) {}
+
   const RowTypePtr& outputType() const {
     return outputType_;
   }
@@ -82,6 +82,31 @@ void AggregateProbe::visitReferences(
   }
 }
 
+void JoinBuild::visitReferences(
+    std::function<void(AbstractOperand*)> visitor) const {
+  for (auto& key : keys) {
+    visitor(key);
+  }
+  for (auto& column : dependent) {
+    visitor(column);
+  }
+}
+
+void JoinProbe::visitReferences(
+    std::function<void(AbstractOperand*)> visitor) const {
+  for (auto& key : keys) {
+    visitor(key);
+  }
+}
+
+void JoinProbe::visitResults(
+    std::function<void(AbstractOperand*)> visitor) const {
+  visitor(flag);
+  for (auto& column : dependent) {
+    visitor(column);
+  }
+}
+
 void AggregateUpdate::visitReferences(
     std::function<void(AbstractOperand*)> visitor) const {
   for (auto& arg : args) {
@@ -370,6 +395,50 @@ void CompileState::tryFilterProject(
   topScopes_.push_back(std::move(topScope_));
 }
 
+namespace {
+// Returns the names of the build side columns of 'join' that are in its
+// output.
+std::vector<std::string> dependentColumns(const core::HashJoinNode& join) {
+  std::vector<std::string> names;
+  auto& buildType = join.sources()[1]->outputType();
+  for (auto i = 0; i < buildType->size(); ++i) {
+    auto& name = buildType->nameOf(i);
+    if (join.outputType()->getChildIdxIfExists(name).has_value()) {
+      names.push_back(name);
+    }
+  }
+  return names;
+}
+
+bool allBigint(const std::vector<core::FieldAccessTypedExprPtr>& keys) {
+  for (auto& key : keys) {
+    if (key->type()->kind() != TypeKind::BIGINT) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// True if 'node' is a hash join that runs on Wave. Both the build and the
+// probe pipeline decide with this so that both sides run on Wave or neither
+// does.
+bool isWaveHashJoin(const core::PlanNode* node) {
+  auto* join = dynamic_cast<const core::HashJoinNode*>(node);
+  if (!join || !(join->isInnerJoin() || join->isLeftSemiFilterJoin()) ||
+      join->isNullAware() || join->filter() || !allBigint(join->leftKeys()) ||
+      !allBigint(join->rightKeys())) {
+    return false;
+  }
+  auto& buildType = join->sources()[1]->outputType();
+  for (auto& name : dependentColumns(*join)) {
+    if (buildType->findChild(name)->kind() != TypeKind::BIGINT) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 bool CompileState::tryPlanOperator(
     exec::Operator* op,
     int32_t& nodeIndex,
@@ -458,6 +527,63 @@ bool CompileState::tryPlanOperator(
           *toSubfield(output->nameOf(i + read->keys.size())), &topScope_);
     }
     segments_.back().steps.push_back(read);
+  } else if (name == "HashBuild") {
+    // The join node is not in the plan nodes of the build pipeline.
+    auto* node = driverFactory_.consumerNode.get();
+    if (!isWaveHashJoin(node)) {
+      return false;
+    }
+    auto* join = reinterpret_cast<const core::HashJoinNode*>(node);
+    auto& segment = addSegment(BoundaryType::kJoinBuild, node, ROW({}, {}));
+    auto step = makeStep<JoinBuild>();
+    step->state = newState(StateKind::kHashJoin, node->id(), "");
+    step->id = ++aggCounter_;
+    step->continueLabelN = ++nextContinueLabel_;
+    step->uniqueKeys = join->isInnerJoin();
+    step->planNodeId = node->id();
+    for (auto& key : join->rightKeys()) {
+      step->keys.push_back(fieldToOperand(*key, &topScope_));
+    }
+    for (auto& column : dependentColumns(*join)) {
+      step->dependent.push_back(
+          fieldToOperand(*toSubfield(column), &topScope_));
+    }
+    segment.steps.push_back(step);
+    outputType = segment.outputType;
+  } else if (name == "HashProbe") {
+    auto node = driverFactory_.planNodes[nodeIndex];
+    if (!isWaveHashJoin(node.get())) {
+      return false;
+    }
+    auto* join = reinterpret_cast<const core::HashJoinNode*>(node.get());
+    auto& segment = addSegment(BoundaryType::kJoin, node.get(), nullptr);
+    auto step = makeStep<JoinProbe>();
+    step->state = newState(StateKind::kHashJoin, node->id(), "");
+    step->id = ++aggCounter_;
+    step->planNodeId = node->id();
+    for (auto& key : join->leftKeys()) {
+      step->keys.push_back(fieldToOperand(*key, &topScope_));
+    }
+    step->flag = newOperand(BOOLEAN(), "hit");
+    step->flag->notNull = true;
+    auto& buildType = join->sources()[1]->outputType();
+    for (auto& column : dependentColumns(*join)) {
+      auto* op = newOperand(buildType->findChild(column), column);
+      topScope_.operandMap[Value(toSubfield(column))] = op;
+      step->dependent.push_back(op);
+    }
+    // The probe is followed by a filter on the hit flag, like for a
+    // FilterProject.
+    auto filterStep = makeStep<Filter>();
+    filterStep->flag = step->flag;
+    filterStep->nthWrap = wrapId_++;
+    filterStep->indices = newOperand(INTEGER(), "indices");
+    filterStep->indices->notNull = true;
+    segment.steps.push_back(step);
+    segment.steps.push_back(filterStep);
+    segment.topLevelDefined = step->dependent;
+    outputType = node->outputType();
+    segment.outputType = outputType;
   } else {
     return false;
   }
@@ -475,6 +601,28 @@ bool CompileState::makeSegments(int32_t& operatorIndex) {
     }
     ++nodeIndex;
   }
+  // A hash join with one side on Wave and the other side on CPU would never
+  // finish since the sides do not share a join bridge.
+  for (auto i = operatorIndex; i < operators.size(); ++i) {
+    auto& name = operators[i]->operatorType();
+    if (name != "HashBuild" && name != "HashProbe") {
+      continue;
+    }
+    const core::PlanNode* node = driverFactory_.consumerNode.get();
+    if (name == "HashProbe") {
+      for (auto& planNode : driverFactory_.planNodes) {
+        if (planNode->id() == operators[i]->planNodeId()) {
+          node = planNode.get();
+        }
+      }
+    }
+    if (isWaveHashJoin(node)) {
+      VELOX_UNSUPPORTED(
+          "Hash join {} runs on Wave but its {} side does not",
+          operators[i]->planNodeId(),
+          name == "HashBuild" ? "build" : "probe");
+    }
+  }
   if (!segments_.back().outputType) {
     segments_.back().outputType = outputType;
   }
@@ -745,7 +893,8 @@ void CompileState::placeAggregation(
 bool CompileState::hasSink(int32_t idx) {
   for (auto i = idx; i < segments_.size(); ++i) {
     auto bound = segments_[i].boundary;
-    if (bound == BoundaryType::kAggregation) {
+    if (bound == BoundaryType::kAggregation ||
+        bound == BoundaryType::kJoinBuild) {
       return true;
     }
   }
@@ -820,6 +969,45 @@ void CompileState::planSegment(
       placeAggregation(candidate, segment);
       break;
     }
+    case BoundaryType::kJoinBuild: {
+      if (candidate.steps.back().size() > 1) {
+        newKernel(candidate);
+      }
+      auto& build = segment.steps[0]->as<JoinBuild>();
+      for (auto* key : build.keys) {
+        placeExpr(candidate, key, false);
+      }
+      for (auto* column : build.dependent) {
+        placeExpr(candidate, column, false);
+      }
+      candidate.currentBox->steps.push_back(&build);
+      break;
+    }
+    case BoundaryType::kJoin: {
+      if (candidate.steps.back().size() > 1) {
+        newKernel(candidate);
+      }
+      auto& probe = segment.steps[0]->as<JoinProbe>();
+      for (auto* key : probe.keys) {
+        placeExpr(candidate, key, false);
+      }
+      candidate.currentBox->steps.push_back(&probe);
+      // The hit flag and the build side columns are defined by the probe.
+      auto pos = CodePosition(
+          candidate.steps.size() - 1,
+          candidate.boxIdx,
+          candidate.currentBox->steps.size() - 1);
+      probe.visitResults(
+          [&](AbstractOperand* op) { candidate.flags(op).definedIn = pos; });
+      auto& filter = segment.steps[1]->as<Filter>();
+      placeExpr(candidate, filter.flag, false);
+      candidate.currentBox->steps.push_back(&filter);
+      bool mayDelay = hasSink(segmentIdx);
+      for (auto i = 0; i < segment.topLevelDefined.size(); ++i) {
+        placeExpr(candidate, segment.topLevelDefined[i], mayDelay);
+      }
+      break;
+    }
     default:
       VELOX_NYI();
   }
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+// The build side uses the device side group by hash table. Disabled together
+// with AggregationTest until aggregation remodeling is complete.
+class HashJoinTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+  }
+
+  void TearDown() override {}
+
+  // Returns probe rows with c0 in [0, 100) and build rows with u0 in [0,
+  // 'numBuild'), each key repeated 'repeat' times.
+  std::pair<RowVectorPtr, RowVectorPtr> makeInput(
+      int32_t numBuild,
+      int32_t repeat) {
+    auto probe = makeRowVector({
+        makeFlatVector<int64_t>(100, folly::identity),
+        makeFlatVector<int64_t>(100, [](auto row) { return row * 2; }),
+    });
+    auto build = makeRowVector(
+        {"u0", "u1"},
+        {
+            makeFlatVector<int64_t>(
+                numBuild * repeat, [&](auto row) { return row / repeat; }),
+            makeFlatVector<int64_t>(
+                numBuild * repeat, [](auto row) { return row * 10; }),
+        });
+    return {probe, build};
+  }
+};
+
+TEST_F(HashJoinTest, DISABLED_inner) {
+  auto [probe, build] = makeInput(50, 1);
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe})
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build})
+                          .planNode(),
+                      "",
+                      {"c0", "c1", "u1"})
+                  .planNode();
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(50, folly::identity),
+      makeFlatVector<int64_t>(50, [](auto row) { return row * 2; }),
+      makeFlatVector<int64_t>(50, [](auto row) { return row * 10; }),
+  });
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
+TEST_F(HashJoinTest, DISABLED_leftSemiFilter) {
+  auto [probe, build] = makeInput(30, 3);
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe})
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build})
+                          .planNode(),
+                      "",
+                      {"c0", "c1"},
+                      core::JoinType::kLeftSemiFilter)
+                  .planNode();
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(30, folly::identity),
+      makeFlatVector<int64_t>(30, [](auto row) { return row * 2; }),
+  });
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
+TEST_F(HashJoinTest, DISABLED_innerDuplicateBuildKeys) {
+  auto [probe, build] = makeInput(30, 2);
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe})
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build})
+                          .planNode(),
+                      "",
+                      {"c0", "u1"})
+                  .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan).copyResults(pool()), "unique build keys");
+}
+
+} // namespace
+} // namespace facebook::velox::wave
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/Conv.h>
+
 #include "velox/common/base/CountBits.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/core/CoreTypeSystem.h"
@@ -49,6 +51,84 @@ inline std::exception_ptr makeBadCastException(
       false));
 }
 
+// True if all 8 bytes of 'chunk' are ASCII digits.
+FOLLY_ALWAYS_INLINE bool isEightDigits(uint64_t chunk) {
+  return (((chunk & 0xF0F0F0F0F0F0F0F0) |
+           (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+          0x3333333333333333);
+}
+
+// Returns the value of 8 ASCII digits loaded little endian into 'chunk'.
+FOLLY_ALWAYS_INLINE uint64_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  constexpr uint64_t kMul1 = 100 + (1'000'000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10'000ULL << 32);
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  return (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >>
+      32;
+}
+
+// Parses 'size' bytes at 'data' consisting of an optional '-' followed by at
+// most 18 decimal digits into 'result'. Validates and converts 8 digits at a
+// time without branching on each character. Returns false for any other input
+// or a value out of range for T. These are left to the general conversion,
+// which accepts the remaining valid forms and produces the error message.
+template <typename T>
+FOLLY_ALWAYS_INLINE bool
+tryParseSimpleInteger(const char* data, int32_t size, T& result) {
+  const bool negative = size > 0 && data[0] == '-';
+  const char* digits = data + negative;
+  const int32_t numDigits = size - negative;
+  if (numDigits <= 0 || numDigits > 18) {
+    return false;
+  }
+  uint64_t value = 0;
+  int32_t i = 0;
+  for (; i + 8 <= numDigits; i += 8) {
+    uint64_t chunk;
+    memcpy(&chunk, digits + i, sizeof(chunk));
+    if (!isEightDigits(chunk)) {
+      return false;
+    }
+    value = value * 100'000'000 + parseEightDigits(chunk);
+  }
+  bool valid = true;
+  for (; i < numDigits; ++i) {
+    const uint8_t digit = digits[i] - '0';
+    valid &= digit < 10;
+    value = value * 10 + digit;
+  }
+  if (!valid) {
+    return false;
+  }
+  // At most 18 digits do not overflow int64_t.
+  const int64_t signedValue = negative ? -static_cast<int64_t>(value)
+                                       : static_cast<int64_t>(value);
+  if (signedValue < std::numeric_limits<T>::min() ||
+      signedValue > std::numeric_limits<T>::max()) {
+    return false;
+  }
+  result = signedValue;
+  return true;
+}
+
+// Writes the decimal representation of 'value' to 'out' and returns its
+// length. 'out' must have space for std::numeric_limits<T>::digits10 + 2
+// bytes.
+template <typename T>
+FOLLY_ALWAYS_INLINE int32_t formatInteger(T value, char* out) {
+  if (value < 0) {
+    *out = '-';
+    // Negating in unsigned arithmetic is defined for the min value.
+    return 1 +
+        folly::uint64ToBufferUnsafe(
+               0 - static_cast<uint64_t>(static_cast<int64_t>(value)),
+               out + 1);
+  }
+  return folly::uint64ToBufferUnsafe(value, out);
+}
+
 } // namespace
 
 namespace detail {
@@ -677,6 +757,62 @@ VectorPtr CastExpr::applyDecimalToPrimitiveCast(
   }
 }
 
+template <TypeKind ToKind, typename TPolicy>
+void CastExpr::applyVarcharToIntegerCast(
+    const SelectivityVector& rows,
+    exec::EvalCtx& context,
+    const SimpleVector<StringView>* input,
+    FlatVector<typename TypeTraits<ToKind>::NativeType>* result,
+    VectorPtr& resultPtr) {
+  using To = typename TypeTraits<ToKind>::NativeType;
+  applyToSelectedNoThrowLocal(context, rows, resultPtr, [&](vector_size_t row) {
+    const auto value = input->valueAt(row);
+    To parsed;
+    if (FOLLY_LIKELY(
+            tryParseSimpleInteger(value.data(), value.size(), parsed))) {
+      result->set(row, parsed);
+      return;
+    }
+    applyCastKernel<ToKind, TypeKind::VARCHAR, TPolicy>(
+        row, context, input, result);
+  });
+}
+
+template <typename TInput>
+VectorPtr CastExpr::applyIntToVarcharCast(
+    const SelectivityVector& rows,
+    exec::EvalCtx& context,
+    const BaseVector& input) {
+  VectorPtr result;
+  context.ensureWritable(rows, VARCHAR(), result);
+  (*result).clearNulls(rows);
+  const auto simpleInput = input.as<SimpleVector<TInput>>();
+  auto flatResult = result->asFlatVector<StringView>();
+  constexpr int32_t kMaxSize = std::numeric_limits<TInput>::digits10 + 2;
+  if constexpr (StringView::isInline(kMaxSize)) {
+    char inlined[StringView::kInlineSize];
+    rows.applyToSelected([&](vector_size_t row) {
+      const auto size = formatInteger(simpleInput->valueAt(row), inlined);
+      flatResult->setNoCopy(row, StringView(inlined, size));
+    });
+    return result;
+  }
+
+  // All values are formatted into one buffer.
+  Buffer* buffer =
+      flatResult->getBufferWithSpace(rows.countSelected() * kMaxSize);
+  char* rawBuffer = buffer->asMutable<char>() + buffer->size();
+  rows.applyToSelected([&](vector_size_t row) {
+    const auto size = formatInteger(simpleInput->valueAt(row), rawBuffer);
+    flatResult->setNoCopy(row, StringView(rawBuffer, size));
+    if (!StringView::isInline(size)) {
+      rawBuffer += size;
+    }
+  });
+  buffer->setSize(rawBuffer - buffer->asMutable<char>());
+  return result;
+}
+
 template <TypeKind ToKind, TypeKind FromKind>
 void CastExpr::applyCastPrimitives(
     const SelectivityVector& rows,
@@ -688,6 +824,25 @@ void CastExpr::applyCastPrimitives(
   auto* resultFlatVector = result->as<FlatVector<To>>();
   auto* inputSimpleVector = input.as<SimpleVector<From>>();
 
+  if constexpr (
+      FromKind == TypeKind::VARCHAR &&
+      (ToKind == TypeKind::TINYINT || ToKind == TypeKind::SMALLINT ||
+       ToKind == TypeKind::INTEGER || ToKind == TypeKind::BIGINT)) {
+    switch (hooks_->getPolicy()) {
+      case LegacyCastPolicy:
+        applyVarcharToIntegerCast<ToKind, util::LegacyCastPolicy>(
+            rows, context, inputSimpleVector, resultFlatVector, result);
+        return;
+      case PrestoCastPolicy:
+        applyVarcharToIntegerCast<ToKind, util::PrestoCastPolicy>(
+            rows, context, inputSimpleVector, resultFlatVector, result);
+        return;
+      default:
+        // Spark truncates fractions and is left to the per row kernel.
+        break;
+    }
+  }
+
   switch (hooks_->getPolicy()) {
     case LegacyCastPolicy:
       applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
@@ -790,6 +790,26 @@ void CastExpr::applyPeeled(
       (toType->kind() == TypeKind::VARCHAR ||
        toType->kind() == TypeKind::VARBINARY)) {
     result = applyTimestampToVarcharCast(toType, rows, context, input);
+  } else if (toType->kind() == TypeKind::VARCHAR) {
+    switch (fromType->kind()) {
+      case TypeKind::TINYINT:
+        result = applyIntToVarcharCast<int8_t>(rows, context, input);
+        break;
+      case TypeKind::SMALLINT:
+        result = applyIntToVarcharCast<int16_t>(rows, context, input);
+        break;
+      case TypeKind::INTEGER:
+        result = applyIntToVarcharCast<int32_t>(rows, context, input);
+        break;
+      case TypeKind::BIGINT:
+        result = applyIntToVarcharCast<int64_t>(rows, context, input);
+        break;
+      default:
+        // Handle primitive type conversions.
+        applyCastPrimitivesDispatch<TypeKind::VARCHAR>(
+            fromType, toType, rows, context, input, result);
+        break;
+    }
   } else if (toType->kind() == TypeKind::VARBINARY) {
     switch (fromType->kind()) {
       case TypeKind::TINYINT:
@@ -274,6 +274,23 @@ class CastExpr : public SpecialForm {
       const TypePtr& fromType,
       const TypePtr& toType);
 
+  /// Casts VARCHAR to an integer type. Plain decimal strings are parsed
+  /// several digits at a time. Other inputs go through applyCastKernel().
+  template <TypeKind ToKind, typename TPolicy>
+  void applyVarcharToIntegerCast(
+      const SelectivityVector& rows,
+      exec::EvalCtx& context,
+      const SimpleVector<StringView>* input,
+      FlatVector<typename TypeTraits<ToKind>::NativeType>* result,
+      VectorPtr& resultPtr);
+
+  /// Formats integers into one string buffer for the result.
+  template <typename TInput>
+  VectorPtr applyIntToVarcharCast(
+      const SelectivityVector& rows,
+      exec::EvalCtx& context,
+      const BaseVector& input);
+
   template <TypeKind ToKind, TypeKind FromKind>
   void applyCastPrimitives(
       const SelectivityVector& rows,
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/ConstantFoldingCache.h"
+
+#include <map>
+
+namespace facebook::velox::exec {
+
+ConstantFoldingCache::ConstantFoldingCache()
+    : pool_(memory::memoryManager()->addLeafPool(
+          "__constant_folding_cache__")),
+      cache_(kMaxBytes) {}
+
+// static
+ConstantFoldingCache& ConstantFoldingCache::instance() {
+  static ConstantFoldingCache* cache = new ConstantFoldingCache();
+  return *cache;
+}
+
+// static
+uint64_t ConstantFoldingCache::configHash(const core::QueryConfig& config) {
+  // Ordered so that equal configs hash the same.
+  std::map<std::string, std::string> sorted;
+  for (auto& [key, value] : config.rawConfigsCopy()) {
+    sorted.emplace(key, value);
+  }
+  uint64_t hash = 0;
+  for (const auto& [key, value] : sorted) {
+    hash = bits::hashMix(hash, std::hash<std::string>()(key));
+    hash = bits::hashMix(hash, std::hash<std::string>()(value));
+  }
+  return hash;
+}
+
+// static
+bool ConstantFoldingCache::isCacheable(const core::TypedExprPtr& expr) {
+  if (auto constant =
+          dynamic_cast<const core::ConstantTypedExpr*>(expr.get())) {
+    return !constant->hasValueVector();
+  }
+  if (dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+    return false;
+  }
+  for (const auto& input : expr->inputs()) {
+    if (!isCacheable(input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::optional<ConstantFoldingCache::Value> ConstantFoldingCache::find(
+    const core::TypedExprPtr& expr,
+    uint64_t configHash,
+    memory::MemoryPool* pool) {
+  Key key{expr, configHash};
+  Value value;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto* cached = cache_.get(key);
+    if (!cached) {
+      return std::nullopt;
+    }
+    value = *cached;
+    cache_.release(key);
+  }
+  value.constant = BaseVector::wrapInConstant(
+      1, 0, BaseVector::copy(*value.constant, pool));
+  return value;
+}
+
+void ConstantFoldingCache::insert(
+    const core::TypedExprPtr& expr,
+    uint64_t configHash,
+    const Value& value) {
+  auto copy = std::make_unique<Value>();
+  copy->constant = BaseVector::copy(*value.constant, pool_.get());
+  copy->defaultNullRowsSkipped = value.defaultNullRowsSkipped;
+  auto size = copy->constant->retainedSize() + sizeof(Value);
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(Key{expr, configHash}, copy.get(), size)) {
+    copy.release();
+  }
+}
+
+SimpleLRUCacheStats ConstantFoldingCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
+
+void ConstantFoldingCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.free(cache_.maxSize());
+}
+
+} // namespace facebook::velox::exec
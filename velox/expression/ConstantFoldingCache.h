@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <mutex>
+#include <optional>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/core/Expressions.h"
+#include "velox/core/QueryConfig.h"
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::exec {
+
+/// Process-wide cache of constant folding results. Maps a typed expression
+/// together with a fingerprint of the query config to the constant it folds
+/// to. Lets ExprSets of different drivers and queries skip function
+/// resolution and evaluation of constant subexpressions that were folded
+/// before. The values are copies owned by the cache's own memory pool.
+/// Thread-safe.
+class ConstantFoldingCache {
+ public:
+  struct Value {
+    VectorPtr constant;
+
+    /// True if folding skipped null rows of an input with default null
+    /// behavior. Carried over to the ConstantExpr.
+    bool defaultNullRowsSkipped{false};
+  };
+
+  /// Max bytes of constants kept.
+  static constexpr size_t kMaxBytes = 64 << 20;
+
+  static ConstantFoldingCache& instance();
+
+  /// Returns a fingerprint of the settings in 'config'. Part of the key since
+  /// folding may depend on session properties.
+  static uint64_t configHash(const core::QueryConfig& config);
+
+  /// True if 'expr' may be a key, i.e. does not reference memory of a query,
+  /// like complex constants do.
+  static bool isCacheable(const core::TypedExprPtr& expr);
+
+  /// Returns the folded constant for 'expr' or std::nullopt. The constant is
+  /// copied to 'pool'.
+  std::optional<Value> find(
+      const core::TypedExprPtr& expr,
+      uint64_t configHash,
+      memory::MemoryPool* pool);
+
+  /// Records that 'expr' folds into 'value'.
+  void insert(
+      const core::TypedExprPtr& expr,
+      uint64_t configHash,
+      const Value& value);
+
+  SimpleLRUCacheStats stats() const;
+
+  void clear();
+
+ private:
+  struct Key {
+    core::TypedExprPtr expr;
+    uint64_t configHash;
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      return bits::hashMix(key.expr->hash(), key.configHash);
+    }
+  };
+
+  struct KeyComparer {
+    bool operator()(const Key& lhs, const Key& rhs) const {
+      return lhs.configHash == rhs.configHash && *lhs.expr == *rhs.expr;
+    }
+  };
+
+  ConstantFoldingCache();
+
+  mutable std::mutex mutex_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+  SimpleLRUCache<Key, Value, KeyComparer, KeyHasher> cache_;
+};
+
+} // namespace facebook::velox::exec
@@ -36,20 +36,28 @@ class DecodedArgs {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       exec::EvalCtx& context) {
+    decoded_.reserve(args.size());
     for (auto& arg : args) {
+      // The input columns are decoded once per batch and shared.
+      if (auto* decoded = context.decodedInput(arg, rows)) {
+        decoded_.push_back(decoded);
+        continue;
+      }
       holders_.emplace_back(context, *arg, rows);
+      decoded_.push_back(holders_.back().get());
     }
   }
 
   DecodedVector* at(int i) const {
-    return const_cast<exec::LocalDecodedVector*>(&holders_[i])->get();
+    return decoded_[i];
   }
 
   size_t size() const {
-    return holders_.size();
+    return decoded_.size();
   }
 
  private:
   std::vector<exec::LocalDecodedVector> holders_;
+  std::vector<DecodedVector*> decoded_;
 };
 } // namespace facebook::velox::exec
@@ -49,6 +49,13 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx)
   inputFlatNoNulls_ = false;
 }
 
+EvalCtx::~EvalCtx() {
+  for (auto& [_, input] : decodedInputs_) {
+    execCtx_->releaseDecodedVector(std::move(input.decoded));
+  }
+  execCtx_->maybeTrimScratch(kMaxRetainedScratchBytes);
+}
+
 void EvalCtx::saveAndReset(ContextSaver& saver, const SelectivityVector& rows) {
   if (saver.context) {
     return;
@@ -291,6 +298,48 @@ const VectorPtr& EvalCtx::getField(int32_t index) const {
   return *field;
 }
 
+bool EvalCtx::isInputColumn(const BaseVector* vector) const {
+  for (const auto& child : row_->children()) {
+    if (child.get() == vector) {
+      return true;
+    }
+    if (child->isLazy() && child->asUnchecked<LazyVector>()->isLoaded() &&
+        child->asUnchecked<LazyVector>()->loadedVectorShared().get() ==
+            vector) {
+      return true;
+    }
+  }
+  return false;
+}
+
+DecodedVector* EvalCtx::decodedInput(
+    const VectorPtr& vector,
+    const SelectivityVector& rows) {
+  // Decoding a flat vector is cheaper than a lookup.
+  if (row_ == nullptr || vector->isFlatEncoding()) {
+    return nullptr;
+  }
+  auto it = decodedInputs_.find(vector.get());
+  if (it == decodedInputs_.end()) {
+    // Only the input columns are known not to change while 'this' is alive.
+    if (!isInputColumn(vector.get())) {
+      return nullptr;
+    }
+    it = decodedInputs_.emplace(vector.get(), DecodedInput{}).first;
+    it->second.holder = vector;
+    it->second.decoded = execCtx_->getDecodedVector();
+  } else if (rows.isSubset(it->second.rows)) {
+    return it->second.decoded.get();
+  }
+  auto& input = it->second;
+  input.rows = rows;
+  input.decoded->decode(*vector, rows);
+  // Computes the nulls for all of 'rows' now. DecodedVector::nulls() keeps the
+  // nulls of the rows of its first call.
+  input.decoded->nulls(&rows);
+  return input.decoded.get();
+}
+
 VectorPtr EvalCtx::ensureFieldLoaded(
     int32_t index,
     const SelectivityVector& rows) {
@@ -20,6 +20,8 @@
 #include <functional>
 #include <memory>
 
+#include <folly/container/F14Map.h>
+
 #include "velox/common/base/Portability.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/vector/ComplexVector.h"
@@ -224,6 +226,11 @@ class EvalCtx {
   /// For testing only.
   explicit EvalCtx(core::ExecCtx* execCtx);
 
+  ~EvalCtx();
+
+  /// Max bytes of scratch areas kept by 'execCtx_' for the next batch.
+  static constexpr int64_t kMaxRetainedScratchBytes = 1 << 20;
+
   const RowVector* row() const {
     return row_;
   }
@@ -238,6 +245,12 @@ class EvalCtx {
     return execCtx_->pool();
   }
 
+  /// Returns the scratch areas for transient buffers that do not outlive the
+  /// evaluation of the current batch. See core::ExecCtx::scratch().
+  Scratch& scratch() const {
+    return execCtx_->scratch();
+  }
+
   // Returns the index-th column of the base row. If we have peeled off
   // wrappers like dictionaries, then this provides access only to the
   // peeled off fields.
@@ -532,6 +545,12 @@ class EvalCtx {
     return execCtx_->optimizationParams().maxSharedSubexprResultsCached;
   }
 
+  /// Returns the maximum number of dictionary bases per ExprSet to keep
+  /// memoized results for after the input moves on to another base.
+  uint32_t maxMemoizedDictionaries() const {
+    return execCtx_->optimizationParams().maxMemoizedDictionaries;
+  }
+
   /// Returns true if peeling is enabled.
   bool peelingEnabled() const {
     return execCtx_->optimizationParams().peelingEnabled;
@@ -548,7 +567,66 @@ class EvalCtx {
     return execCtx_->optimizationParams().deferredLazyLoadingEnabled;
   }
 
+  /// Returns true if maps subscripted by multiple expressions may get a hash
+  /// index over their keys that is shared by these expressions.
+  bool mapSubscriptKeyIndexEnabled() const {
+    return execCtx_->optimizationParams().mapSubscriptKeyIndexEnabled;
+  }
+
+  /// State derived from an input vector that expressions of the same
+  /// evaluation can share, e.g. a hash index over the keys of a map.
+  struct DerivedVectorState {
+    // References the vector the state is derived from, so that the vector is
+    // not freed or reused while the state is cached.
+    VectorPtr holder;
+
+    // Number of times the state was requested. Lets the user build the state
+    // only once it is seen to be reused.
+    int32_t numRequests{0};
+
+    std::shared_ptr<void> state;
+  };
+
+  /// Returns the entry for state derived from 'vector'. 'holder' must
+  /// reference 'vector', e.g. be 'vector' or a wrapper around it. The entries
+  /// live as long as 'this'.
+  DerivedVectorState& derivedVectorState(
+      const BaseVector* vector,
+      const VectorPtr& holder) {
+    auto& entry = derivedVectorStates_[vector];
+    if (!entry.holder) {
+      entry.holder = holder;
+    }
+    return entry;
+  }
+
+  /// Returns a decoding of 'vector' over 'rows' that is shared by all the
+  /// expressions evaluated on 'this' if 'vector' is a non-flat column of
+  /// 'row_'. Returns nullptr otherwise, in which case the caller decodes
+  /// 'vector' itself. A decoding is reused while the requested rows are a
+  /// subset of the rows it was made for and is remade otherwise. The caller
+  /// must not modify the returned vector.
+  DecodedVector* decodedInput(
+      const VectorPtr& vector,
+      const SelectivityVector& rows);
+
  private:
+  // A decoding of a column of 'row_'. See decodedInput().
+  struct DecodedInput {
+    // References the decoded vector so that it is not freed or reused while
+    // cached.
+    VectorPtr holder;
+
+    // The rows 'decoded' was made for.
+    SelectivityVector rows;
+
+    std::unique_ptr<DecodedVector> decoded;
+  };
+
+  // Returns true if 'vector' is a column of 'row_' or the loaded vector of a
+  // lazy column of 'row_'.
+  bool isInputColumn(const BaseVector* vector) const;
+
   void ensureErrorsVectorSize(EvalErrorsPtr& errors, vector_size_t size) const;
 
   // Updates 'errorPtr' to clear null at 'index' to indicate an error has
@@ -596,6 +674,15 @@ class EvalCtx {
   // If 'captureErrorDetails()' is false, stores flags indicating which rows had
   // errors without storing actual exceptions.
   EvalErrorsPtr errors_;
+
+  // State derived from input vectors, keyed on the vector. See
+  // derivedVectorState().
+  folly::F14FastMap<const BaseVector*, DerivedVectorState>
+      derivedVectorStates_;
+
+  // Decodings of the columns of 'row_', keyed on the decoded vector. See
+  // decodedInput().
+  folly::F14FastMap<const BaseVector*, DecodedInput> decodedInputs_;
 };
 
 /// Utility wrapper struct that is used to temporarily reset the value of the
@@ -364,8 +364,12 @@ bool Expr::evalArgsDefaultNulls(
       const uint64_t* flatNulls = nullptr;
       auto& arg = inputValues_[i];
       if (arg->mayHaveNulls()) {
-        decoded.get()->decode(*arg, rows.rows());
-        flatNulls = decoded.get()->nulls(&rows.rows());
+        auto* argDecoded = context.decodedInput(arg, rows.rows());
+        if (argDecoded == nullptr) {
+          argDecoded = decoded.get();
+          argDecoded->decode(*arg, rows.rows());
+        }
+        flatNulls = argDecoded->nulls(&rows.rows());
       }
       // A null with no error deselects the row.
       // An error adds itself to argument errors.
@@ -399,7 +403,10 @@ bool Expr::evalArgsDefaultNulls(
   }
 
   // Default-null behavior has taken place if rows has changed.
-  stats_.defaultNullRowsSkipped |= rows.hasChanged();
+  if (rows.hasChanged()) {
+    stats_.defaultNullRowsSkipped = true;
+    ++stats_.numDefaultNullSkips;
+  }
 
   mergeOrThrowArgumentErrors(
       rows.rows(), originalErrors, argumentErrors, context);
@@ -1068,6 +1075,7 @@ void Expr::evalEncodings(
             finalRowsHolder);
         auto* newRows = peelEncodingsResult.newRows;
         if (newRows) {
+          ++stats_.numPeels;
           VectorPtr peeledResult;
           // peelEncodings() can potentially produce an empty selectivity
           // vector if all selected values we are waiting for are nulls. So,
@@ -1123,6 +1131,7 @@ bool Expr::removeSureNulls(
     // removed from rows.
     if (result->countSelected() < rows.countSelected()) {
       stats_.defaultNullRowsSkipped = true;
+      ++stats_.numDefaultNullSkips;
       return true;
     }
   }
@@ -1182,6 +1191,10 @@ void Expr::evalWithNulls(
 // it can be memory intensive. Therefore in order to reduce this consumption
 // and ensure it is only employed for cases where it can be useful, it only
 // starts caching result after it encounters the same base at least twice.
+// If QueryConfig::kMaxMemoizedDictionaries is set, the results for a base are
+// kept in the DictionaryMemoCache of the ExprSet when the base changes and
+// caching starts at the first batch, since bases may alternate or come back
+// in a later split.
 void Expr::evalWithMemo(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1191,17 +1204,32 @@ void Expr::evalWithMemo(
 
   if (base.get() != baseOfDictionaryRawPtr_ ||
       baseOfDictionaryWeakPtr_.expired()) {
+    const bool memoAcrossBatches = context.maxMemoizedDictionaries() > 0;
+    if (memoAcrossBatches) {
+      saveDictionaryMemo(context);
+    }
     baseOfDictionaryRepeats_ = 0;
     baseOfDictionaryWeakPtr_ = base;
     baseOfDictionaryRawPtr_ = base.get();
+    baseOfDictionaryHash_.reset();
     context.releaseVector(baseOfDictionary_);
     context.releaseVector(dictionaryCache_);
-    evalWithNulls(rows, context, result);
-    return;
+    // The vectors are left in place if they are not reusable.
+    baseOfDictionary_ = nullptr;
+    dictionaryCache_ = nullptr;
+    if (!memoAcrossBatches) {
+      evalWithNulls(rows, context, result);
+      return;
+    }
+    if (loadDictionaryMemo(base, context)) {
+      ++stats_.numDictionaryMemoHits;
+    } else {
+      ++stats_.numDictionaryMemoMisses;
+    }
   }
   ++baseOfDictionaryRepeats_;
 
-  if (baseOfDictionaryRepeats_ == 1) {
+  if (dictionaryCache_ == nullptr) {
     evalWithNulls(rows, context, result);
     baseOfDictionary_ = base;
     dictionaryCache_ = result;
@@ -1268,6 +1296,89 @@ void Expr::evalWithMemo(
   context.releaseVector(base);
 }
 
+void Expr::saveDictionaryMemo(EvalCtx& context) {
+  if (baseOfDictionary_ == nullptr || dictionaryCache_ == nullptr ||
+      cachedDictionaryIndices_ == nullptr) {
+    return;
+  }
+  const auto hash = baseOfDictionaryHash_.has_value()
+      ? baseOfDictionaryHash_.value()
+      : DictionaryMemoCache::hashValues(*baseOfDictionary_);
+  context.exprSet()->dictionaryMemoCache().add(
+      this,
+      {std::move(baseOfDictionary_),
+       hash,
+       std::move(dictionaryCache_),
+       std::move(cachedDictionaryIndices_)},
+      context.maxMemoizedDictionaries());
+  context.exprSet()->addToMemo(this);
+}
+
+bool Expr::loadDictionaryMemo(const VectorPtr& base, EvalCtx& context) {
+  auto entry = context.exprSet()->dictionaryMemoCache().take(
+      this, base, baseOfDictionaryHash_);
+  if (!entry.has_value()) {
+    return false;
+  }
+  baseOfDictionary_ = base;
+  dictionaryCache_ = std::move(entry->results);
+  cachedDictionaryIndices_ = std::move(entry->rows);
+  return true;
+}
+
+void DictionaryMemoCache::add(
+    const Expr* expr,
+    Entry entry,
+    uint32_t maxEntries) {
+  entries_.emplace_back(expr, std::move(entry));
+  while (entries_.size() > maxEntries) {
+    entries_.pop_front();
+  }
+}
+
+std::optional<DictionaryMemoCache::Entry> DictionaryMemoCache::take(
+    const Expr* expr,
+    const VectorPtr& base,
+    std::optional<uint64_t>& hash) {
+  auto it = std::find_if(entries_.begin(), entries_.end(), [&](auto& pair) {
+    return pair.first == expr && pair.second.base.get() == base.get();
+  });
+  if (it == entries_.end()) {
+    if (!hash.has_value()) {
+      hash = hashValues(*base);
+    }
+    it = std::find_if(entries_.begin(), entries_.end(), [&](auto& pair) {
+      const auto& other = pair.second.base;
+      if (pair.first != expr || pair.second.hash != hash.value() ||
+          other->size() != base->size() ||
+          !other->type()->equivalent(*base->type())) {
+        return false;
+      }
+      for (auto i = 0; i < base->size(); ++i) {
+        if (!base->equalValueAt(other.get(), i, i)) {
+          return false;
+        }
+      }
+      return true;
+    });
+    if (it == entries_.end()) {
+      return std::nullopt;
+    }
+  }
+  auto entry = std::move(it->second);
+  entries_.erase(it);
+  return entry;
+}
+
+// static
+uint64_t DictionaryMemoCache::hashValues(const BaseVector& vector) {
+  uint64_t hash = vector.size();
+  for (auto i = 0; i < vector.size(); ++i) {
+    hash = bits::hashMix(hash, vector.hashValueAt(i));
+  }
+  return hash;
+}
+
 void Expr::setAllNulls(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1482,6 +1593,7 @@ bool Expr::applyFunctionWithPeeling(
   }
   inputValues_ = std::move(peeledVectors);
   peeledVectors.clear();
+  ++stats_.numPeels;
 
   // Translate the relevant rows.
   // Note: We do not need to translate final selection since at this stage
@@ -1516,6 +1628,15 @@ void Expr::applyFunction(
     VectorPtr& result) {
   stats_.numProcessedVectors += 1;
   stats_.numProcessedRows += rows.countSelected();
+  for (const auto& input : inputValues_) {
+    if (input->isConstantEncoding()) {
+      ++stats_.numConstantInputs;
+    } else if (input->encoding() == VectorEncoding::Simple::DICTIONARY) {
+      ++stats_.numDictionaryInputs;
+    } else if (isFlat(*input)) {
+      ++stats_.numFlatInputs;
+    }
+  }
   auto timer = cpuWallTimer();
 
   computeIsAsciiForInputs(vectorFunction_.get(), inputValues_, rows);
@@ -1789,6 +1910,19 @@ void addStats(
   }
 }
 
+void addDistinctExprs(
+    const exec::Expr& expr,
+    std::vector<const exec::Expr*>& distinctExprs,
+    std::unordered_set<const exec::Expr*>& uniqueExprs) {
+  if (!uniqueExprs.insert(&expr).second) {
+    return;
+  }
+  distinctExprs.push_back(&expr);
+  for (const auto& input : expr.inputs()) {
+    addDistinctExprs(*input, distinctExprs, uniqueExprs);
+  }
+}
+
 std::string makeUuid() {
   return boost::lexical_cast<std::string>(boost::uuids::random_generator()());
 }
@@ -1804,6 +1938,15 @@ std::unordered_map<std::string, exec::ExprStats> ExprSet::stats() const {
   return stats;
 }
 
+std::vector<const Expr*> ExprSet::distinctExprs() const {
+  std::vector<const Expr*> distinctExprs;
+  std::unordered_set<const exec::Expr*> uniqueExprs;
+  for (const auto& expr : exprs()) {
+    addDistinctExprs(*expr, distinctExprs, uniqueExprs);
+  }
+  return distinctExprs;
+}
+
 ExprSet::~ExprSet() {
   exprSetListeners().withRLock([&](auto& listeners) {
     if (!listeners.empty()) {
@@ -1949,6 +2092,7 @@ void ExprSet::clear() {
   for (auto* memo : memoizingExprs_) {
     memo->clearMemo();
   }
+  dictionaryMemoCache_.clear();
   distinctFields_.clear();
   multiplyReferencedFields_.clear();
 }
@@ -1957,6 +2101,7 @@ void ExprSet::clearCache() {
   for (auto& expr : exprs_) {
     expr->clearCache();
   }
+  dictionaryMemoCache_.clear();
 }
 
 void ExprSetSimplified::eval(
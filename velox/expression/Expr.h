@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <deque>
 #include <vector>
 
 #include <folly/container/F14Map.h>
@@ -31,12 +32,15 @@
 
 namespace facebook::velox::exec {
 
+class Expr;
 class ExprSet;
 class FieldReference;
 class VectorFunction;
 
 struct ExprStats {
-  /// Requires QueryConfig.exprTrackCpuUsage() to be 'true'.
+  /// Requires QueryConfig.exprTrackCpuUsage() or
+  /// QueryConfig.exprProfilingEnabled() to be 'true'. Excludes the evaluation
+  /// of the inputs of a function call.
   CpuWallTiming timing;
 
   /// Number of processed rows.
@@ -50,20 +54,56 @@ struct ExprStats {
   /// evaluation of rows.
   bool defaultNullRowsSkipped{false};
 
+  /// Number of batches in which default-null behavior skipped the evaluation
+  /// of some rows.
+  uint64_t numDefaultNullSkips{0};
+
+  /// Number of flat, dictionary and constant encoded inputs passed to the
+  /// function. Inputs are counted after peeling.
+  uint64_t numFlatInputs{0};
+  uint64_t numDictionaryInputs{0};
+  uint64_t numConstantInputs{0};
+
+  /// Number of batches evaluated on peeled inputs.
+  uint64_t numPeels{0};
+
+  /// Number of times a new dictionary base reused results memoized for an
+  /// earlier batch, and number of times no results were memoized for it.
+  /// Requires QueryConfig.maxMemoizedDictionaries() > 0.
+  uint64_t numDictionaryMemoHits{0};
+  uint64_t numDictionaryMemoMisses{0};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
     defaultNullRowsSkipped |= other.defaultNullRowsSkipped;
+    numDefaultNullSkips += other.numDefaultNullSkips;
+    numFlatInputs += other.numFlatInputs;
+    numDictionaryInputs += other.numDictionaryInputs;
+    numConstantInputs += other.numConstantInputs;
+    numPeels += other.numPeels;
+    numDictionaryMemoHits += other.numDictionaryMemoHits;
+    numDictionaryMemoMisses += other.numDictionaryMemoMisses;
   }
 
   std::string toString() const {
     return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, defaultNullRowsSkipped: {}",
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, defaultNullRowsSkipped: {}"
+        ", numDefaultNullSkips: {}, numFlatInputs: {}, numDictionaryInputs: {}"
+        ", numConstantInputs: {}, numPeels: {}"
+        ", numDictionaryMemoHits: {}, numDictionaryMemoMisses: {}",
         timing.toString(),
         numProcessedRows,
         numProcessedVectors,
-        defaultNullRowsSkipped ? "true" : "false");
+        defaultNullRowsSkipped ? "true" : "false",
+        numDefaultNullSkips,
+        numFlatInputs,
+        numDictionaryInputs,
+        numConstantInputs,
+        numPeels,
+        numDictionaryMemoHits,
+        numDictionaryMemoMisses);
   }
 };
 
@@ -137,6 +177,52 @@ class MutableRemainingRows {
   LocalSelectivityVector mutableRowsHolder_;
 };
 
+/// Holds the results memoizing Exprs computed for dictionary bases that are no
+/// longer the current input, so that a base seen again in a later batch
+/// reuses them. A base matches if it is the same vector, e.g. a build side
+/// vector re-wrapped by a join, or a vector with the same values, e.g. the
+/// dictionary of a column read again for another stripe or split. Holds at
+/// most a given number of entries per ExprSet and evicts the least recently
+/// added first.
+class DictionaryMemoCache {
+ public:
+  struct Entry {
+    // Strong reference that keeps the base from being reused in place.
+    VectorPtr base;
+    uint64_t hash;
+    VectorPtr results;
+    // The positions of 'base' that 'results' are valid for.
+    std::unique_ptr<SelectivityVector> rows;
+  };
+
+  /// Adds the results of 'expr' for 'entry.base'. Evicts entries beyond
+  /// 'maxEntries'.
+  void add(const Expr* expr, Entry entry, uint32_t maxEntries);
+
+  /// Removes and returns the entry of 'expr' for a base equal to 'base', or
+  /// std::nullopt if there is none. 'hash' is the hash of the values of 'base'
+  /// and is computed if not set.
+  std::optional<Entry> take(
+      const Expr* expr,
+      const VectorPtr& base,
+      std::optional<uint64_t>& hash);
+
+  /// Returns a hash of the values of 'vector'.
+  static uint64_t hashValues(const BaseVector& vector);
+
+  size_t size() const {
+    return entries_.size();
+  }
+
+  void clear() {
+    entries_.clear();
+  }
+
+ private:
+  // Oldest first.
+  std::deque<std::pair<const Expr*, Entry>> entries_;
+};
+
 // An executable expression.
 class Expr {
  public:
@@ -250,6 +336,7 @@ class Expr {
     baseOfDictionaryRawPtr_ = nullptr;
     dictionaryCache_ = nullptr;
     cachedDictionaryIndices_ = nullptr;
+    baseOfDictionaryHash_.reset();
   }
 
   virtual void clearCache() {
@@ -443,6 +530,14 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Moves the results memoized for the current dictionary base to the
+  // DictionaryMemoCache of the ExprSet.
+  void saveDictionaryMemo(EvalCtx& context);
+
+  // Sets the memoized results for 'base' from the DictionaryMemoCache of the
+  // ExprSet. Returns false if there are none.
+  bool loadDictionaryMemo(const VectorPtr& base, EvalCtx& context);
+
   void evalWithNulls(
       const SelectivityVector& rows,
       EvalCtx& context,
@@ -675,6 +770,10 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  // Hash of the values of 'baseOfDictionary_' if computed for looking it up
+  // in the DictionaryMemoCache.
+  std::optional<uint64_t> baseOfDictionaryHash_;
+
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
@@ -766,6 +865,10 @@ class ExprSet {
     memoizingExprs_.insert(expr);
   }
 
+  DictionaryMemoCache& dictionaryMemoCache() {
+    return dictionaryMemoCache_;
+  }
+
   /// Returns text representation of the expression set.
   /// @param compact If true, uses one-line representation for each expression.
   /// Otherwise, prints a tree of expressions one node per line.
@@ -778,6 +881,11 @@ class ExprSet {
   /// evaluated.
   std::unordered_map<std::string, exec::ExprStats> stats() const;
 
+  /// Returns the distinct nodes of the expression trees in pre-order. Common
+  /// subexpressions are returned once. The 1-based position of a node matches
+  /// its '#' id in printExprWithStats().
+  std::vector<const Expr*> distinctExprs() const;
+
  protected:
   void clearSharedSubexprs();
 
@@ -795,6 +903,9 @@ class ExprSet {
 
   // Exprs which retain memoized state, e.g. from running over dictionaries.
   std::unordered_set<Expr*> memoizingExprs_;
+
+  // Results of 'memoizingExprs_' for dictionaries of earlier batches.
+  DictionaryMemoCache dictionaryMemoCache_;
   core::ExecCtx* const execCtx_;
 };
 
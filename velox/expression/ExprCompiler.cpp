@@ -19,8 +19,10 @@
 #include "velox/expression/CoalesceExpr.h"
 #include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/ConstantExpr.h"
+#include "velox/expression/ConstantFoldingCache.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -85,8 +87,16 @@ struct Scope {
 
   std::vector<TypedExprPtr> rewrittenExpressions;
 
+  // Fingerprint of the query config if results of constant folding are looked
+  // up in and added to ConstantFoldingCache.
+  std::optional<uint64_t> foldingCacheConfigHash;
+
   Scope(std::vector<std::string>&& _locals, Scope* _parent, ExprSet* _exprSet)
-      : locals(_locals), parent(_parent), exprSet(_exprSet) {}
+      : locals(_locals),
+        parent(_parent),
+        exprSet(_exprSet),
+        foldingCacheConfigHash(
+            _parent ? _parent->foldingCacheConfigHash : std::nullopt) {}
 
   void addCapture(FieldReference* reference, const ITypedExpr* fieldAccess) {
     capture.emplace_back(reference->field());
@@ -296,7 +306,7 @@ std::shared_ptr<Expr> compileLambda(
       std::move(signature),
       std::move(captureReferences),
       std::move(body),
-      config.exprTrackCpuUsage());
+      config.exprTrackCpuUsage() || config.exprProfilingEnabled());
 }
 
 ExprPtr tryFoldIfConstant(const ExprPtr& expr, Scope* scope) {
@@ -341,6 +351,60 @@ ExprPtr tryFoldIfConstant(const ExprPtr& expr, Scope* scope) {
   return expr;
 }
 
+// Returns the cached result of folding 'expr' if 'compiledInputs' are all
+// constant and the fold was recorded before. Returns nullptr otherwise.
+ExprPtr findFolded(
+    const TypedExprPtr& expr,
+    const std::vector<ExprPtr>& compiledInputs,
+    Scope* scope) {
+  if (!scope->foldingCacheConfigHash.has_value() ||
+      !scope->exprSet->execCtx()) {
+    return nullptr;
+  }
+  if (!dynamic_cast<const core::CallTypedExpr*>(expr.get()) &&
+      !dynamic_cast<const core::CastTypedExpr*>(expr.get()) &&
+      !dynamic_cast<const core::ConcatTypedExpr*>(expr.get())) {
+    return nullptr;
+  }
+  for (const auto& input : compiledInputs) {
+    if (!std::dynamic_pointer_cast<ConstantExpr>(input)) {
+      return nullptr;
+    }
+  }
+  if (!ConstantFoldingCache::isCacheable(expr)) {
+    return nullptr;
+  }
+  auto value = ConstantFoldingCache::instance().find(
+      expr,
+      scope->foldingCacheConfigHash.value(),
+      scope->exprSet->execCtx()->pool());
+  if (!value.has_value()) {
+    return nullptr;
+  }
+  auto result = std::make_shared<ConstantExpr>(value->constant);
+  if (value->defaultNullRowsSkipped) {
+    result->setDefaultNullRowsSkipped(true);
+  }
+  return result;
+}
+
+// Records that 'expr' folded into 'folded' for later compilations.
+void recordFolded(
+    const TypedExprPtr& expr,
+    const ExprPtr& folded,
+    Scope* scope) {
+  if (!scope->foldingCacheConfigHash.has_value() ||
+      !ConstantFoldingCache::isCacheable(expr)) {
+    return;
+  }
+  auto constant = std::dynamic_pointer_cast<ConstantExpr>(folded);
+  VELOX_CHECK_NOT_NULL(constant);
+  ConstantFoldingCache::instance().insert(
+      expr,
+      scope->foldingCacheConfigHash.value(),
+      {constant->value(), constant->stats().defaultNullRowsSkipped});
+}
+
 /// Returns a vector aligned with exprs vector where elements that correspond to
 /// constant expressions are set to constant values of these expressions.
 /// Elements that correspond to non-constant expressions are set to null.
@@ -386,12 +450,19 @@ ExprPtr compileRewrittenExpression(
     return alreadyCompiled;
   }
 
-  const bool trackCpuUsage = config.exprTrackCpuUsage();
+  const bool trackCpuUsage =
+      config.exprTrackCpuUsage() || config.exprProfilingEnabled();
 
   ExprPtr result;
   auto resultType = expr->type();
   auto compiledInputs = compileInputs(
       expr, scope, config, pool, flatteningCandidates, enableConstantFolding);
+  if (enableConstantFolding) {
+    if (auto cached = findFolded(expr, compiledInputs, scope)) {
+      scope->visited[expr.get()] = cached;
+      return cached;
+    }
+  }
   auto inputTypes = getTypes(compiledInputs);
   bool isConstantExpr = false;
   if (dynamic_cast<const core::ConcatTypedExpr*>(expr.get())) {
@@ -524,6 +595,15 @@ ExprPtr compileRewrittenExpression(
   auto folded = enableConstantFolding && !isConstantExpr
       ? tryFoldIfConstant(result, scope)
       : result;
+  if (folded != result) {
+    recordFolded(expr, folded, scope);
+  }
+  if (config.exprFusedEvaluationEnabled()) {
+    // Fusing bottom up lets a parent absorb a fused child into its program.
+    if (auto fused = FusedExpr::tryFuse(folded)) {
+      folded = fused;
+    }
+  }
   scope->visited[expr.get()] = folded;
   return folded;
 }
@@ -587,13 +667,23 @@ std::unordered_set<std::string> collectFlatteningCandidates(
 } // namespace
 
 std::vector<std::shared_ptr<Expr>> compileExpressions(
-    const std::vector<TypedExprPtr>& sources,
+    const std::vector<TypedExprPtr>& inputSources,
     core::ExecCtx* execCtx,
     ExprSet* exprSet,
     bool enableConstantFolding) {
   Scope scope({}, nullptr, exprSet);
+  if (enableConstantFolding &&
+      execCtx->queryCtx()->queryConfig().exprConstantFoldingCacheEnabled()) {
+    scope.foldingCacheConfigHash = ConstantFoldingCache::configHash(
+        execCtx->queryCtx()->queryConfig());
+  }
   std::vector<std::shared_ptr<Expr>> exprs;
-  exprs.reserve(sources.size());
+  exprs.reserve(inputSources.size());
+
+  auto sources = inputSources;
+  for (auto& rewrite : expressionSetRewrites()) {
+    sources = rewrite(sources);
+  }
 
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
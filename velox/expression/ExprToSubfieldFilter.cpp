@@ -17,6 +17,8 @@
 #include "velox/expression/ExprToSubfieldFilter.h"
 
 #include "velox/expression/Expr.h"
+#include "velox/expression/FieldReference.h"
+#include "velox/vector/DecodedVector.h"
 
 using namespace facebook::velox;
 
@@ -112,6 +114,158 @@ toInt64List(const VectorPtr& vector, vector_size_t start, vector_size_t size) {
   return values;
 }
 
+// Maps the C++ type of the values of a column of type T to the type in which
+// the readers pass them to common::FunctionFilter::Function.
+template <typename T>
+using FilterValueType = std::conditional_t<
+    std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8,
+    int64_t,
+    T>;
+
+template <TypeKind kind, typename V>
+void copyFilterValues(const V* values, int32_t size, BaseVector& vector) {
+  using T = typename TypeTraits<kind>::NativeType;
+  auto* flat = vector.asUnchecked<FlatVector<T>>();
+  if constexpr (std::is_same_v<V, StringView> && std::is_same_v<T, V>) {
+    for (auto i = 0; i < size; ++i) {
+      flat->setNoCopy(i, values[i]);
+    }
+  } else if constexpr (
+      std::is_same_v<V, FilterValueType<T>> ||
+      (std::is_arithmetic_v<V> && std::is_arithmetic_v<T>)) {
+    for (auto i = 0; i < size; ++i) {
+      flat->set(i, static_cast<T>(values[i]));
+    }
+  } else {
+    VELOX_FAIL(
+        "Unexpected filter values for {} column", TypeTraits<kind>::name);
+  }
+}
+
+// Evaluates a single column boolean expression on the values given by a
+// reader. The values are copied into a reused flat vector so that a batch
+// of values takes one evaluation.
+class ExprFunction : public common::FunctionFilter::Function {
+ public:
+  ExprFunction(
+      core::TypedExprPtr expr,
+      RowTypePtr rowType,
+      core::ExpressionEvaluator* evaluator)
+      : expr_(std::move(expr)),
+        rowType_(std::move(rowType)),
+        evaluator_(evaluator) {}
+
+  std::unique_ptr<Function> clone() const override {
+    return std::make_unique<ExprFunction>(expr_, rowType_, evaluator_);
+  }
+
+  void test(const int64_t* values, int32_t size, bool* passed) override {
+    testValues(values, size, passed);
+  }
+
+  void test(const int128_t* values, int32_t size, bool* passed) override {
+    testValues(values, size, passed);
+  }
+
+  void test(const float* values, int32_t size, bool* passed) override {
+    testValues(values, size, passed);
+  }
+
+  void test(const double* values, int32_t size, bool* passed) override {
+    testValues(values, size, passed);
+  }
+
+  void test(const bool* values, int32_t size, bool* passed) override {
+    testValues(values, size, passed);
+  }
+
+  void test(const StringView* values, int32_t size, bool* passed) override {
+    testValues(values, size, passed);
+  }
+
+  void test(const Timestamp* values, int32_t size, bool* passed) override {
+    testValues(values, size, passed);
+  }
+
+  std::string toString() const override {
+    return expr_->toString();
+  }
+
+  // Returns true if a null value passes 'expr_'.
+  bool testNull() {
+    auto nulls = BaseVector::createNullConstant(
+        rowType_->childAt(0), 1, evaluator_->pool());
+    bool passed;
+    evaluate(nulls, 1, &passed);
+    return passed;
+  }
+
+ private:
+  template <typename V>
+  void testValues(const V* values, int32_t size, bool* passed) {
+    if (values_ == nullptr) {
+      values_ = BaseVector::create(
+          rowType_->childAt(0), size, evaluator_->pool());
+    } else {
+      BaseVector::prepareForReuse(values_, size);
+    }
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        copyFilterValues, rowType_->childAt(0)->kind(), values, size, *values_);
+    evaluate(values_, size, passed);
+  }
+
+  // Sets 'passed' for the 'size' first rows of 'values'. Rows for which the
+  // evaluation fails pass.
+  void evaluate(const VectorPtr& values, int32_t size, bool* passed) {
+    if (exprSet_ == nullptr) {
+      exprSet_ = evaluator_->compile(expr_);
+    }
+    RowVector input(
+        evaluator_->pool(),
+        rowType_,
+        nullptr,
+        size,
+        std::vector<VectorPtr>{values});
+    SelectivityVector rows(size);
+    try {
+      evaluator_->evaluate(exprSet_.get(), rows, input, result_);
+      readResult(rows, passed);
+      return;
+    } catch (const VeloxUserError&) {
+    }
+    // Evaluates the rows one by one to find the ones that fail.
+    SelectivityVector row(size, false);
+    for (auto i = 0; i < size; ++i) {
+      row.setValid(i, true);
+      row.updateBounds();
+      try {
+        result_ = nullptr;
+        evaluator_->evaluate(exprSet_.get(), row, input, result_);
+        readResult(row, passed);
+      } catch (const VeloxUserError&) {
+        passed[i] = true;
+      }
+      row.setValid(i, false);
+    }
+    result_ = nullptr;
+  }
+
+  void readResult(const SelectivityVector& rows, bool* passed) {
+    decoded_.decode(*result_, rows);
+    rows.applyToSelected([&](auto row) {
+      passed[row] = !decoded_.isNullAt(row) && decoded_.valueAt<bool>(row);
+    });
+  }
+
+  const core::TypedExprPtr expr_;
+  const RowTypePtr rowType_;
+  core::ExpressionEvaluator* const evaluator_;
+  std::unique_ptr<ExprSet> exprSet_;
+  VectorPtr values_;
+  VectorPtr result_;
+  DecodedVector decoded_;
+};
+
 static std::shared_ptr<ExprToSubfieldFilterParser> defaultParser =
     std::make_shared<PrestoExprToSubfieldFilterParser>();
 
@@ -561,4 +715,42 @@ std::pair<common::Subfield, std::unique_ptr<common::Filter>> toSubfieldFilter(
       "Unsupported expression for range filter: {}", expr->toString());
 }
 
+std::unique_ptr<common::Filter> makeFunctionFilter(
+    const core::TypedExprPtr& expr,
+    core::ExpressionEvaluator* evaluator,
+    common::Subfield& subfield) {
+  if (asCall(expr.get()) == nullptr ||
+      expr->type()->kind() != TypeKind::BOOLEAN) {
+    return nullptr;
+  }
+  auto exprSet = evaluator->compile(expr);
+  const auto& compiled = exprSet->expr(0);
+  if (!compiled->isDeterministic() || compiled->distinctFields().size() != 1) {
+    return nullptr;
+  }
+  const auto* field = compiled->distinctFields()[0];
+  switch (field->type()->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      break;
+    default:
+      return nullptr;
+  }
+  auto function = std::make_unique<ExprFunction>(
+      expr, ROW({field->field()}, {field->type()}), evaluator);
+  const bool nullAllowed = function->testNull();
+  subfield = common::Subfield(field->field());
+  return std::make_unique<common::FunctionFilter>(
+      std::move(function), nullAllowed);
+}
+
 } // namespace facebook::velox::exec
@@ -371,6 +371,17 @@ std::pair<common::Subfield, std::unique_ptr<common::Filter>> toSubfieldFilter(
     const core::TypedExprPtr& expr,
     core::ExpressionEvaluator*);
 
+/// Makes a common::FunctionFilter that evaluates 'expr' on the values of the
+/// only column it references. Returns nullptr if 'expr' is not a
+/// deterministic boolean call over exactly one top-level column of a
+/// primitive type. Sets 'subfield' to the column on success. Values for which
+/// 'expr' fails pass the filter, so that the error is raised when 'expr' is
+/// evaluated on the rows of the scan. 'evaluator' must outlive the filter.
+std::unique_ptr<common::Filter> makeFunctionFilter(
+    const core::TypedExprPtr& expr,
+    core::ExpressionEvaluator* evaluator,
+    common::Subfield& subfield);
+
 inline std::unique_ptr<common::TimestampRange> equal(
     const Timestamp& value,
     bool nullAllowed = false) {
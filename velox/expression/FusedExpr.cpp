@@ -0,0 +1,694 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedExpr.h"
+
+#include <cmath>
+
+#include <folly/ScopeGuard.h>
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/expression/ConjunctExpr.h"
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FieldReference.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+using Op = FusedProgram::Op;
+using Slot = FusedProgram::Slot;
+using Source = FusedProgram::Source;
+
+// Fusing fewer operations saves little over the interpreter.
+constexpr int32_t kMinInstructions = 2;
+
+// Bounds the scratch memory of a FusedExpr.
+constexpr int32_t kMaxInstructions = 32;
+
+constexpr int32_t kMaxCachedPrograms = 1'000;
+
+std::optional<Op> toOp(const std::string& name) {
+  static const folly::F14FastMap<std::string, Op> kOps = {
+      {"plus", Op::kPlus},
+      {"minus", Op::kMinus},
+      {"multiply", Op::kMultiply},
+      {"divide", Op::kDivide},
+      {"eq", Op::kEq},
+      {"neq", Op::kNeq},
+      {"lt", Op::kLt},
+      {"lte", Op::kLte},
+      {"gt", Op::kGt},
+      {"gte", Op::kGte},
+      {"and", Op::kAnd},
+      {"or", Op::kOr},
+  };
+  auto it = kOps.find(name);
+  if (it == kOps.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+bool isComparison(Op op) {
+  return op >= Op::kEq && op <= Op::kGte;
+}
+
+bool isLogical(Op op) {
+  return op == Op::kAnd || op == Op::kOr;
+}
+
+// Returns the kind of 'type' if values of 'type' can be inputs of a
+// FusedProgram. Excludes logical types that share a physical type with a
+// supported one, e.g. DATE or DECIMAL.
+std::optional<TypeKind> valueKind(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BIGINT:
+    case TypeKind::INTEGER:
+    case TypeKind::DOUBLE:
+    case TypeKind::REAL:
+      if (type->name() == mapTypeKindToName(type->kind())) {
+        return type->kind();
+      }
+      return std::nullopt;
+    default:
+      return std::nullopt;
+  }
+}
+
+bool isBoolean(const TypePtr& type) {
+  return type->kind() == TypeKind::BOOLEAN && type->name() == "BOOLEAN";
+}
+
+int32_t valueWidth(TypeKind kind) {
+  return kind == TypeKind::BIGINT || kind == TypeKind::DOUBLE ? 8 : 4;
+}
+
+template <typename F>
+auto dispatchKind(TypeKind kind, F&& func) {
+  switch (kind) {
+    case TypeKind::BIGINT:
+      return func(int64_t{});
+    case TypeKind::INTEGER:
+      return func(int32_t{});
+    case TypeKind::DOUBLE:
+      return func(double{});
+    case TypeKind::REAL:
+      return func(float{});
+    default:
+      VELOX_UNREACHABLE("Unsupported kind: {}", mapTypeKindToName(kind));
+  }
+}
+
+template <typename T>
+T fromBits(int64_t bits) {
+  T value;
+  memcpy(&value, &bits, sizeof(T));
+  return value;
+}
+
+template <typename T>
+int64_t toBits(T value) {
+  int64_t bits = 0;
+  memcpy(&bits, &value, sizeof(T));
+  return bits;
+}
+
+// Returns false on integer overflow, where the interpreter throws, and on
+// division by zero.
+template <typename T>
+bool arithmetic(Op op, const T* left, const T* right, T* out, int32_t size) {
+  if constexpr (std::is_integral_v<T>) {
+    bool overflow = false;
+    switch (op) {
+      case Op::kPlus:
+        for (auto i = 0; i < size; ++i) {
+          overflow |= __builtin_add_overflow(left[i], right[i], &out[i]);
+        }
+        break;
+      case Op::kMinus:
+        for (auto i = 0; i < size; ++i) {
+          overflow |= __builtin_sub_overflow(left[i], right[i], &out[i]);
+        }
+        break;
+      case Op::kMultiply:
+        for (auto i = 0; i < size; ++i) {
+          overflow |= __builtin_mul_overflow(left[i], right[i], &out[i]);
+        }
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    return !overflow;
+  } else {
+    switch (op) {
+      case Op::kPlus:
+        for (auto i = 0; i < size; ++i) {
+          out[i] = left[i] + right[i];
+        }
+        break;
+      case Op::kMinus:
+        for (auto i = 0; i < size; ++i) {
+          out[i] = left[i] - right[i];
+        }
+        break;
+      case Op::kMultiply:
+        for (auto i = 0; i < size; ++i) {
+          out[i] = left[i] * right[i];
+        }
+        break;
+      case Op::kDivide: {
+        // Division by zero is Infinity or NaN in Presto but null in Spark.
+        bool zeroDivisor = false;
+        for (auto i = 0; i < size; ++i) {
+          zeroDivisor |= right[i] == 0;
+          out[i] = left[i] / right[i];
+        }
+        if (zeroDivisor) {
+          return false;
+        }
+        break;
+      }
+      default:
+        VELOX_UNREACHABLE();
+    }
+    return true;
+  }
+}
+
+template <typename T, typename Compare>
+void compareLoop(
+    const T* left,
+    const T* right,
+    uint8_t* out,
+    int32_t size,
+    Compare compare) {
+  for (auto i = 0; i < size; ++i) {
+    out[i] = compare(left[i], right[i]);
+  }
+}
+
+// Returns false if an input is NaN. The Presto comparisons order NaN above
+// all other values and equal to itself, unlike the CPU.
+template <typename T>
+bool compare(Op op, const T* left, const T* right, uint8_t* out, int32_t size) {
+  if constexpr (std::is_floating_point_v<T>) {
+    bool hasNaN = false;
+    for (auto i = 0; i < size; ++i) {
+      hasNaN |= std::isnan(left[i]) | std::isnan(right[i]);
+    }
+    if (hasNaN) {
+      return false;
+    }
+  }
+  switch (op) {
+    case Op::kEq:
+      compareLoop(left, right, out, size, std::equal_to<T>());
+      break;
+    case Op::kNeq:
+      compareLoop(left, right, out, size, std::not_equal_to<T>());
+      break;
+    case Op::kLt:
+      compareLoop(left, right, out, size, std::less<T>());
+      break;
+    case Op::kLte:
+      compareLoop(left, right, out, size, std::less_equal<T>());
+      break;
+    case Op::kGt:
+      compareLoop(left, right, out, size, std::greater<T>());
+      break;
+    case Op::kGte:
+      compareLoop(left, right, out, size, std::greater_equal<T>());
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  return true;
+}
+
+void logical(
+    Op op,
+    const uint8_t* left,
+    const uint8_t* right,
+    uint8_t* out,
+    int32_t size) {
+  if (op == Op::kAnd) {
+    for (auto i = 0; i < size; ++i) {
+      out[i] = left[i] & right[i];
+    }
+  } else {
+    for (auto i = 0; i < size; ++i) {
+      out[i] = left[i] | right[i];
+    }
+  }
+}
+
+std::string opName(Op op) {
+  static const char* kNames[] = {
+      "plus",
+      "minus",
+      "multiply",
+      "divide",
+      "eq",
+      "neq",
+      "lt",
+      "lte",
+      "gt",
+      "gte",
+      "and",
+      "or"};
+  return kNames[static_cast<int32_t>(op)];
+}
+
+// Translates an Expr tree into the slots and instructions of a FusedProgram.
+class ProgramBuilder {
+ public:
+  // Adds the computation of 'expr' and returns the slot with its result or
+  // std::nullopt if 'expr' cannot be fused.
+  std::optional<int32_t> add(const ExprPtr& expr);
+
+  std::shared_ptr<const FusedProgram> build() {
+    return std::make_shared<FusedProgram>(
+        std::move(slots_),
+        std::move(instructions_),
+        std::move(constants_),
+        numTemps_);
+  }
+
+  int32_t numInstructions() const {
+    return instructions_.size();
+  }
+
+  std::vector<ExprPtr>& fields() {
+    return fields_;
+  }
+
+ private:
+  int32_t addSlot(Source source, TypeKind kind, int32_t index) {
+    slots_.push_back({source, kind, index});
+    return slots_.size() - 1;
+  }
+
+  std::optional<int32_t> addInstruction(
+      Op op,
+      TypeKind resultKind,
+      int32_t left,
+      int32_t right) {
+    if (instructions_.size() >= kMaxInstructions) {
+      return std::nullopt;
+    }
+    const auto result = addSlot(Source::kTemp, resultKind, numTemps_++);
+    instructions_.push_back({op, result, left, right});
+    return result;
+  }
+
+  std::optional<int32_t> addField(const ExprPtr& expr);
+
+  std::optional<int32_t> addConstant(const ConstantExpr& constant);
+
+  std::optional<int32_t> addCall(const ExprPtr& expr, Op op);
+
+  std::vector<Slot> slots_;
+  std::vector<FusedProgram::Instruction> instructions_;
+  std::vector<std::pair<TypeKind, int64_t>> constants_;
+  int32_t numTemps_{0};
+  std::vector<ExprPtr> fields_;
+  std::vector<int32_t> fieldSlots_;
+};
+
+std::optional<int32_t> ProgramBuilder::add(const ExprPtr& expr) {
+  if (auto* fused = expr->as<FusedExpr>()) {
+    return add(fused->fallback());
+  }
+  if (expr->is<FieldReference>()) {
+    return addField(expr);
+  }
+  if (auto* constant = expr->as<ConstantExpr>()) {
+    return addConstant(*constant);
+  }
+  auto op = toOp(expr->name());
+  if (!op.has_value()) {
+    return std::nullopt;
+  }
+  // 'and' and 'or' are special forms, the other operations are functions.
+  if (isLogical(op.value()) != expr->is<ConjunctExpr>() ||
+      (!isLogical(op.value()) && expr->isSpecialForm())) {
+    return std::nullopt;
+  }
+  return addCall(expr, op.value());
+}
+
+std::optional<int32_t> ProgramBuilder::addField(const ExprPtr& expr) {
+  // A field of a struct, not of the input row.
+  if (!expr->inputs().empty()) {
+    return std::nullopt;
+  }
+  auto kind = valueKind(expr->type());
+  if (!kind.has_value()) {
+    return std::nullopt;
+  }
+  for (auto i = 0; i < fields_.size(); ++i) {
+    if (fields_[i].get() == expr.get()) {
+      return fieldSlots_[i];
+    }
+  }
+  fields_.push_back(expr);
+  fieldSlots_.push_back(
+      addSlot(Source::kField, kind.value(), fields_.size() - 1));
+  return fieldSlots_.back();
+}
+
+std::optional<int32_t> ProgramBuilder::addConstant(
+    const ConstantExpr& constant) {
+  auto kind = valueKind(constant.type());
+  const auto& value = constant.value();
+  if (!kind.has_value() || value->isNullAt(0)) {
+    return std::nullopt;
+  }
+  const auto bits = dispatchKind(kind.value(), [&](auto dummy) {
+    using T = decltype(dummy);
+    return toBits(value->as<SimpleVector<T>>()->valueAt(0));
+  });
+  constants_.emplace_back(kind.value(), bits);
+  return addSlot(Source::kConstant, kind.value(), constants_.size() - 1);
+}
+
+std::optional<int32_t> ProgramBuilder::addCall(const ExprPtr& expr, Op op) {
+  const auto& inputs = expr->inputs();
+  if (isLogical(op)) {
+    // Conjuncts are flattened into a list of two or more inputs.
+    if (inputs.size() < 2 || !isBoolean(expr->type())) {
+      return std::nullopt;
+    }
+    std::optional<int32_t> result;
+    for (const auto& input : inputs) {
+      auto slot = add(input);
+      if (!slot.has_value() ||
+          slots_[slot.value()].kind != TypeKind::BOOLEAN) {
+        return std::nullopt;
+      }
+      result = result.has_value()
+          ? addInstruction(op, TypeKind::BOOLEAN, result.value(), slot.value())
+          : slot;
+      if (!result.has_value()) {
+        return std::nullopt;
+      }
+    }
+    return result;
+  }
+
+  if (inputs.size() != 2) {
+    return std::nullopt;
+  }
+  auto left = add(inputs[0]);
+  if (!left.has_value()) {
+    return std::nullopt;
+  }
+  auto right = add(inputs[1]);
+  if (!right.has_value()) {
+    return std::nullopt;
+  }
+  const auto kind = slots_[left.value()].kind;
+  if (kind == TypeKind::BOOLEAN || slots_[right.value()].kind != kind) {
+    return std::nullopt;
+  }
+  if (isComparison(op)) {
+    if (!isBoolean(expr->type())) {
+      return std::nullopt;
+    }
+    return addInstruction(op, TypeKind::BOOLEAN, left.value(), right.value());
+  }
+  // Integer division differs from the interpreter on division by zero.
+  if ((op == Op::kDivide &&
+       (kind == TypeKind::BIGINT || kind == TypeKind::INTEGER)) ||
+      valueKind(expr->type()) != kind) {
+    return std::nullopt;
+  }
+  return addInstruction(op, kind, left.value(), right.value());
+}
+
+using ProgramCache = folly::F14FastMap<
+    std::string,
+    std::shared_ptr<const FusedProgram>>;
+
+folly::Synchronized<ProgramCache>& programCache() {
+  static folly::Synchronized<ProgramCache> cache;
+  return cache;
+}
+
+} // namespace
+
+FusedProgram::FusedProgram(
+    std::vector<Slot> slots,
+    std::vector<Instruction> instructions,
+    std::vector<std::pair<TypeKind, int64_t>> constants,
+    int32_t numTemps)
+    : slots_(std::move(slots)),
+      instructions_(std::move(instructions)),
+      numTemps_(numTemps) {
+  VELOX_CHECK(!instructions_.empty());
+  for (const auto& [kind, bits] : constants) {
+    auto& tile = constantTiles_.emplace_back(kTileSize);
+    dispatchKind(kind, [&](auto dummy) {
+      using T = decltype(dummy);
+      std::fill_n(
+          reinterpret_cast<T*>(tile.data()), kTileSize, fromBits<T>(bits));
+    });
+  }
+
+  // The constants are part of the fingerprint since they are in the program.
+  for (const auto& slot : slots_) {
+    switch (slot.source) {
+      case Source::kField:
+        fingerprint_ += fmt::format("f{}", slot.index);
+        break;
+      case Source::kConstant:
+        fingerprint_ += fmt::format("c{}", constants[slot.index].second);
+        break;
+      case Source::kTemp:
+        fingerprint_ += fmt::format("t{}", slot.index);
+        break;
+    }
+    fingerprint_ += fmt::format(":{},", mapTypeKindToName(slot.kind));
+  }
+  for (const auto& instruction : instructions_) {
+    fingerprint_ += fmt::format(
+        "{}({},{},{});",
+        opName(instruction.op),
+        instruction.result,
+        instruction.left,
+        instruction.right);
+  }
+}
+
+// static
+std::shared_ptr<const FusedProgram> FusedProgram::getOrAdd(
+    std::shared_ptr<const FusedProgram> program) {
+  return programCache().withWLock([&](auto& cache) {
+    auto it = cache.find(program->fingerprint());
+    if (it != cache.end()) {
+      return it->second;
+    }
+    if (cache.size() >= kMaxCachedPrograms) {
+      cache.clear();
+    }
+    cache[program->fingerprint()] = program;
+    return program;
+  });
+}
+
+// static
+size_t FusedProgram::testingCacheSize() {
+  return programCache().rlock()->size();
+}
+
+// static
+void FusedProgram::testingClearCache() {
+  programCache().wlock()->clear();
+}
+
+const void* FusedProgram::slotValues(
+    int32_t slot,
+    const void* const* fields,
+    vector_size_t begin,
+    char* scratch) const {
+  const auto& info = slots_[slot];
+  switch (info.source) {
+    case Source::kField:
+      return static_cast<const char*>(fields[info.index]) +
+          static_cast<int64_t>(begin) * valueWidth(info.kind);
+    case Source::kConstant:
+      return constantTiles_[info.index].data();
+    case Source::kTemp:
+      return scratch + info.index * kTileSize * sizeof(int64_t);
+  }
+  VELOX_UNREACHABLE();
+}
+
+const void* FusedProgram::run(
+    const void* const* fields,
+    vector_size_t begin,
+    int32_t size,
+    char* scratch) const {
+  VELOX_DCHECK_LE(size, kTileSize);
+  for (const auto& instruction : instructions_) {
+    const auto* left = slotValues(instruction.left, fields, begin, scratch);
+    const auto* right = slotValues(instruction.right, fields, begin, scratch);
+    auto* out = const_cast<void*>(
+        slotValues(instruction.result, fields, begin, scratch));
+    const auto op = instruction.op;
+    bool ok = true;
+    if (isLogical(op)) {
+      logical(
+          op,
+          static_cast<const uint8_t*>(left),
+          static_cast<const uint8_t*>(right),
+          static_cast<uint8_t*>(out),
+          size);
+    } else if (isComparison(op)) {
+      ok = dispatchKind(slots_[instruction.left].kind, [&](auto dummy) {
+        using T = decltype(dummy);
+        return compare<T>(
+            op,
+            static_cast<const T*>(left),
+            static_cast<const T*>(right),
+            static_cast<uint8_t*>(out),
+            size);
+      });
+    } else {
+      ok = dispatchKind(slots_[instruction.left].kind, [&](auto dummy) {
+        using T = decltype(dummy);
+        return arithmetic<T>(
+            op,
+            static_cast<const T*>(left),
+            static_cast<const T*>(right),
+            static_cast<T*>(out),
+            size);
+      });
+    }
+    if (!ok) {
+      return nullptr;
+    }
+  }
+  return slotValues(instructions_.back().result, fields, begin, scratch);
+}
+
+FusedExpr::FusedExpr(
+    ExprPtr fallback,
+    std::vector<ExprPtr> fields,
+    std::shared_ptr<const FusedProgram> program)
+    : SpecialForm(
+          fallback->type(),
+          std::move(fields),
+          "fused",
+          false /* supportsFlatNoNullsFastPath */,
+          false /* trackCpuUsage */),
+      fallback_(std::move(fallback)),
+      program_(std::move(program)),
+      fieldValues_(inputs_.size()),
+      fieldData_(inputs_.size()),
+      scratch_(program_->scratchBytes()) {}
+
+// static
+ExprPtr FusedExpr::tryFuse(const ExprPtr& expr) {
+  if (expr->is<FieldReference>() || expr->is<ConstantExpr>() ||
+      !expr->isDeterministic()) {
+    return nullptr;
+  }
+  ProgramBuilder builder;
+  if (!builder.add(expr).has_value() ||
+      builder.numInstructions() < kMinInstructions ||
+      builder.fields().empty()) {
+    return nullptr;
+  }
+  auto fields = std::move(builder.fields());
+  auto fused = std::make_shared<FusedExpr>(
+      expr, std::move(fields), FusedProgram::getOrAdd(builder.build()));
+  fused->computeMetadata();
+  return fused;
+}
+
+void FusedExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  auto clearFields = folly::makeGuard([&]() {
+    for (auto& value : fieldValues_) {
+      value.reset();
+    }
+  });
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputs_[i]->eval(rows, context, fieldValues_[i]);
+    const auto& value = fieldValues_[i];
+    if (value->encoding() != VectorEncoding::Simple::FLAT ||
+        value->mayHaveNulls()) {
+      fallback_->eval(rows, context, result);
+      return;
+    }
+    fieldData_[i] = value->valuesAsVoid();
+  }
+
+  context.ensureWritable(rows, type(), result);
+  result->clearNulls(rows);
+  const auto* selected = rows.asRange().bits();
+  for (auto begin = rows.begin(); begin < rows.end();
+       begin += FusedProgram::kTileSize) {
+    const auto size = std::min(FusedProgram::kTileSize, rows.end() - begin);
+    if (bits::findFirstBit(selected, begin, begin + size) < 0) {
+      continue;
+    }
+    const auto* values =
+        program_->run(fieldData_.data(), begin, size, scratch_.data());
+    if (values == nullptr) {
+      fallback_->eval(rows, context, result);
+      return;
+    }
+    copyTile(values, rows, begin, size, *result);
+  }
+}
+
+void FusedExpr::copyTile(
+    const void* values,
+    const SelectivityVector& rows,
+    vector_size_t begin,
+    int32_t size,
+    BaseVector& result) const {
+  const auto* selected = rows.asRange().bits();
+  if (type()->kind() == TypeKind::BOOLEAN) {
+    auto* rawBits =
+        result.asUnchecked<FlatVector<bool>>()->mutableRawValues<uint64_t>();
+    const auto* bytes = static_cast<const uint8_t*>(values);
+    bits::forEachSetBit(selected, begin, begin + size, [&](auto row) {
+      bits::setBit(rawBits, row, bytes[row - begin]);
+    });
+    return;
+  }
+  dispatchKind(type()->kind(), [&](auto dummy) {
+    using T = decltype(dummy);
+    auto* target = result.asUnchecked<FlatVector<T>>()->mutableRawValues();
+    const auto* source = static_cast<const T*>(values);
+    if (rows.isAllSelected()) {
+      memcpy(target + begin, source, size * sizeof(T));
+      return;
+    }
+    bits::forEachSetBit(selected, begin, begin + size, [&](auto row) {
+      target[row] = source[row - begin];
+    });
+  });
+}
+
+} // namespace facebook::velox::exec
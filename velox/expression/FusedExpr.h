@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+/// A tree of arithmetic, comparison and logical operations over fixed-width
+/// values, translated into a sequence of typed loops over tiles of rows. The
+/// intermediate results are kept in tile-sized scratch buffers that stay in
+/// the CPU cache instead of being materialized as vectors. Programs are
+/// immutable and shared by all FusedExprs with the same fingerprint.
+class FusedProgram {
+ public:
+  enum class Op : uint8_t {
+    kPlus,
+    kMinus,
+    kMultiply,
+    kDivide,
+    kEq,
+    kNeq,
+    kLt,
+    kLte,
+    kGt,
+    kGte,
+    kAnd,
+    kOr,
+  };
+
+  /// Where the values of an operand come from.
+  enum class Source : uint8_t {
+    // The flat values of the field at 'index' in the inputs of the FusedExpr.
+    kField,
+    // The constant at 'index' in 'constants_'.
+    kConstant,
+    // The scratch buffer at 'index'.
+    kTemp,
+  };
+
+  struct Slot {
+    Source source;
+    // BIGINT, INTEGER, DOUBLE or REAL, or BOOLEAN for temps that hold one byte
+    // per row.
+    TypeKind kind;
+    int32_t index;
+  };
+
+  /// Sets slot 'result' to 'op' applied to slots 'left' and 'right'.
+  struct Instruction {
+    Op op;
+    int32_t result;
+    int32_t left;
+    int32_t right;
+  };
+
+  static constexpr int32_t kTileSize = 1'024;
+
+  FusedProgram(
+      std::vector<Slot> slots,
+      std::vector<Instruction> instructions,
+      std::vector<std::pair<TypeKind, int64_t>> constants,
+      int32_t numTemps);
+
+  /// Returns the program equal to 'program' from the process-wide cache,
+  /// adding 'program' if there is none.
+  static std::shared_ptr<const FusedProgram> getOrAdd(
+      std::shared_ptr<const FusedProgram> program);
+
+  static size_t testingCacheSize();
+
+  static void testingClearCache();
+
+  /// Runs the program for rows [begin, begin + size) where 'size' is at most
+  /// kTileSize. 'fields' are the raw values of the flat inputs. 'scratch' has
+  /// space for scratchBytes(). Returns the values of the result or nullptr if
+  /// the result differs from the interpreted one, e.g. on integer overflow,
+  /// which the caller then evaluates with the interpreter.
+  const void* run(
+      const void* const* fields,
+      vector_size_t begin,
+      int32_t size,
+      char* scratch) const;
+
+  size_t scratchBytes() const {
+    return numTemps_ * kTileSize * sizeof(int64_t);
+  }
+
+  /// Identifies the computation of the program, e.g. "f0:BIGINT,..."
+  const std::string& fingerprint() const {
+    return fingerprint_;
+  }
+
+ private:
+  const void* slotValues(
+      int32_t slot,
+      const void* const* fields,
+      vector_size_t begin,
+      char* scratch) const;
+
+  const std::vector<Slot> slots_;
+  const std::vector<Instruction> instructions_;
+  const int32_t numTemps_;
+  // A tile of kTileSize copies of each constant.
+  std::vector<std::vector<int64_t>> constantTiles_;
+  std::string fingerprint_;
+};
+
+/// Evaluates an expression tree of the functions supported by FusedProgram
+/// with a FusedProgram if the input columns are flat and free of nulls. Falls
+/// back to evaluating the original tree otherwise and for batches where the
+/// fused result could differ from the interpreted one, e.g. for integer
+/// overflow or NaN in comparisons. Enabled with
+/// QueryConfig::kExprFusedEvaluationEnabled.
+class FusedExpr : public SpecialForm {
+ public:
+  FusedExpr(
+      ExprPtr fallback,
+      std::vector<ExprPtr> fields,
+      std::shared_ptr<const FusedProgram> program);
+
+  /// Returns a FusedExpr evaluating 'expr' or nullptr if 'expr' contains an
+  /// operation FusedProgram doesn't support or has too few operations to
+  /// benefit from fusing. The functions are identified by the names of the
+  /// Presto functions with the same semantics: plus, minus, multiply,
+  /// divide (floating point only), eq, neq, lt, lte, gt, gte, and, or.
+  static ExprPtr tryFuse(const ExprPtr& expr);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  std::string toString(bool recursive = true) const override {
+    return fallback_->toString(recursive);
+  }
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override {
+    return fallback_->toSql(complexConstants);
+  }
+
+  const ExprPtr& fallback() const {
+    return fallback_;
+  }
+
+  const FusedProgram& program() const {
+    return *program_;
+  }
+
+ private:
+  void computePropagatesNulls() override {
+    fallback_->computeMetadata();
+    propagatesNulls_ = fallback_->propagatesNulls();
+  }
+
+  // Copies the values of the selected rows of the tile starting at 'begin'
+  // to 'result'.
+  void copyTile(
+      const void* values,
+      const SelectivityVector& rows,
+      vector_size_t begin,
+      int32_t size,
+      BaseVector& result) const;
+
+  const ExprPtr fallback_;
+  const std::shared_ptr<const FusedProgram> program_;
+  std::vector<VectorPtr> fieldValues_;
+  std::vector<const void*> fieldData_;
+  std::vector<char> scratch_;
+};
+
+} // namespace facebook::velox::exec
@@ -43,6 +43,15 @@ class ExprCallable : public Callable {
     return capture_->childrenSize() > signature_->size();
   }
 
+  bool hasNonConstantCapture() const override {
+    for (auto i = signature_->size(); i < capture_->childrenSize(); ++i) {
+      if (!capture_->childAt(i)->isConstantEncoding()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   void apply(
       const SelectivityVector& rows,
       const SelectivityVector* validRowsInReusedResult,
@@ -120,7 +129,13 @@ class ExprCallable : public Callable {
     for (auto index = args.size(); index < capture_->childrenSize(); ++index) {
       auto values = capture_->childAt(index);
       VELOX_DCHECK(!isLazyNotLoaded(*values));
-      if (wrapCapture) {
+      if (values->isConstantEncoding()) {
+        // A constant is the same for all rows. Resizing keeps it constant for
+        // the body, which a dictionary wrap would hide.
+        if (values->size() != size) {
+          values = BaseVector::wrapInConstant(size, 0, values);
+        }
+      } else if (wrapCapture) {
         values = BaseVector::wrapInDictionary(
             BufferPtr(nullptr), wrapCapture, size, values);
       }
@@ -156,6 +156,28 @@ class SimpleFunctionAdapter : public VectorFunction {
   /// primitivies.
   static constexpr bool specializeForAllEncodings = FUNC::num_args <= 3;
 
+  template <size_t... Is>
+  constexpr bool static allArgsBatchEligibleImpl(std::index_sequence<Is...>) {
+    return ([&]() {
+      if constexpr (isVariadicType<arg_at<Is>>::value) {
+        return false;
+      } else {
+        return SimpleTypeTrait<arg_at<Is>>::isPrimitiveType &&
+            SimpleTypeTrait<arg_at<Is>>::isFixedWidth &&
+            SimpleTypeTrait<arg_at<Is>>::typeKind != TypeKind::BOOLEAN &&
+            !providesCustomComparison<arg_at<Is>>::value;
+      }
+    }() && ...);
+  }
+
+  // True if the function's callBatch() can be called with the raw values of
+  // flat inputs and result.
+  constexpr bool static batchCallEligible() {
+    return FUNC::udf_has_callBatch && fastPathIteration &&
+        return_type_traits::typeKind != TypeKind::BOOLEAN &&
+        allArgsBatchEligibleImpl(std::make_index_sequence<FUNC::num_args>());
+  }
+
   /// If the initialize() method provided by functions throw, we don't (can't)
   /// throw immediately; rather, we capture the exception using this member
   /// variable and set that as error for every single active row. This is
@@ -369,6 +391,20 @@ class SimpleFunctionAdapter : public VectorFunction {
       }
     }
 
+    static_assert(
+        !FUNC::udf_has_callBatch || batchCallEligible(),
+        "callBatch() requires fixed-width, non-boolean primitive types for "
+        "the result and all arguments.");
+    if constexpr (batchCallEligible()) {
+      if (tryApplyBatch(applyContext, args)) {
+        if (isResultReused) {
+          (*reusableResult)->clearNulls(rows);
+          result = std::move(*reusableResult);
+        }
+        return;
+      }
+    }
+
     std::vector<std::optional<LocalDecodedVector>> decoded;
     if (allPrimitiveArgsFlatConstant(args)) {
       if constexpr (
@@ -476,6 +512,37 @@ class SimpleFunctionAdapter : public VectorFunction {
   }
 
  private:
+  // Calls callBatch() once for all rows if all rows are selected and all
+  // arguments are flat without nulls. Returns false otherwise.
+  bool tryApplyBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args) const {
+    if (!applyContext.rows->isAllSelected()) {
+      return false;
+    }
+    for (const auto& arg : args) {
+      if (!arg->isFlatEncoding() || arg->mayHaveNulls()) {
+        return false;
+      }
+    }
+    callBatch(applyContext, args, std::make_index_sequence<FUNC::num_args>());
+    return true;
+  }
+
+  template <size_t... Is>
+  void callBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    const auto numRows = applyContext.rows->end();
+    (*fn_).callBatch(
+        folly::Range<T*>(applyContext.result->mutableRawValues(), numRows),
+        folly::Range<const exec_arg_at<Is>*>(
+            args[Is]->template asUnchecked<FlatVector<exec_arg_at<Is>>>()
+                ->rawValues(),
+            numRows)...);
+  }
+
   // This is called only when we know that all args are flat or constant and are
   // eligible for the optimization and the optimization is enabled.
   template <int32_t POSITION, typename... TReader>
@@ -548,10 +615,14 @@ class SimpleFunctionAdapter : public VectorFunction {
         unpack<POSITION + 1, allPrimitiveArgsFlatConstant>(
             applyContext, decodedArgs, rawArgs, readers..., reader);
       } else {
-        decodedArgs[POSITION] = LocalDecodedVector(
-            applyContext.context, *rawArgs[POSITION], *applyContext.rows);
-
-        auto* oneUnpacked = decodedArgs.at(POSITION).value().get();
+        // The input columns are decoded once per batch and shared.
+        const DecodedVector* oneUnpacked = applyContext.context.decodedInput(
+            rawArgs[POSITION], *applyContext.rows);
+        if (oneUnpacked == nullptr) {
+          decodedArgs[POSITION] = LocalDecodedVector(
+              applyContext.context, *rawArgs[POSITION], *applyContext.rows);
+          oneUnpacked = decodedArgs.at(POSITION).value().get();
+        }
         auto reader = VectorReader<arg_at<POSITION>>(oneUnpacked);
         unpack<POSITION + 1, allPrimitiveArgsFlatConstant>(
             applyContext, decodedArgs, rawArgs, readers..., reader);
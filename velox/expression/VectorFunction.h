@@ -290,6 +290,22 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// A re-writer that takes all the expressions of an ExprSet and returns
+/// equivalent expressions. Unlike ExpressionRewrite, it can combine parts of
+/// different expressions, e.g. to compute them together in a shared
+/// subexpression. Returns the input if re-write is not possible.
+using ExpressionSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
+/// Returns a list of registered expression set re-writes.
+std::vector<ExpressionSetRewrite>& expressionSetRewrites();
+
+/// Appends a 'rewrite' to 'expressionSetRewrites'. The re-writes are applied
+/// in the order they were registered before the expressions of an ExprSet are
+/// compiled and before the re-writes registered with
+/// registerExpressionRewrite.
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
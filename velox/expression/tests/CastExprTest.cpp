@@ -1819,6 +1819,53 @@ TEST_F(CastExprTest, decimalToDecimal) {
       "Cannot cast DECIMAL '-99999999999999999999999999999999999999' to DECIMAL(38, 1)");
 }
 
+TEST_F(CastExprTest, integerToAndFromVarchar) {
+  testCast<std::string, int8_t>(
+      "tinyint",
+      {"127", "-128", "007", "-0", "+1"},
+      {127, -128, 7, 0, 1});
+  testTryCast<std::string, int16_t>(
+      "smallint",
+      {"32767", "-32768", "12345678"},
+      {32767, -32768, std::nullopt});
+  testTryCast<std::string, int64_t>(
+      "bigint",
+      {"123456789012345678",
+       "-123456789012345678",
+       "12345678",
+       "9223372036854775807",
+       "-9223372036854775808",
+       "1234567a"},
+      {123456789012345678,
+       -123456789012345678,
+       12345678,
+       std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min(),
+       std::nullopt});
+  testInvalidCast<std::string>(
+      "tinyint", {"128"}, "Overflow during conversion");
+
+  testCast<int8_t, std::string>(
+      "varchar", {0, 127, -128}, {"0", "127", "-128"});
+  testCast<int32_t, std::string>(
+      "varchar",
+      {std::numeric_limits<int32_t>::max(),
+       std::numeric_limits<int32_t>::min()},
+      {"2147483647", "-2147483648"});
+  testCast<int64_t, std::string>(
+      "varchar",
+      {0,
+       -7,
+       123456789012,
+       std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min()},
+      {"0",
+       "-7",
+       "123456789012",
+       "9223372036854775807",
+       "-9223372036854775808"});
+}
+
 TEST_F(CastExprTest, integerToBinary) {
   testInvalidCast<int8_t>(
       "varbinary", {12}, "Cannot cast TINYINT to VARBINARY.");
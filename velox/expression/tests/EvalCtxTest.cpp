@@ -19,6 +19,7 @@
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/EvalCtx.h"
+#include "velox/expression/Expr.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 using namespace facebook::velox;
@@ -84,6 +85,30 @@ TEST_F(EvalCtxTest, vectorPool) {
   ASSERT_EQ(anotherVector.get(), vectorPtr);
 }
 
+TEST_F(EvalCtxTest, scratch) {
+  char* data;
+  {
+    EvalCtx context(&execCtx_);
+    ScratchPtr<int32_t> holder(context.scratch());
+    data = reinterpret_cast<char*>(holder.get(1'000));
+  }
+  {
+    // The area released by the previous batch is reused.
+    EvalCtx context(&execCtx_);
+    ScratchPtr<int32_t> holder(context.scratch());
+    ASSERT_EQ(reinterpret_cast<char*>(holder.get(500)), data);
+  }
+  ASSERT_GT(execCtx_.scratch().retainedSize(), 0);
+
+  // An area larger than the retained limit is freed at the end of the batch.
+  {
+    EvalCtx context(&execCtx_);
+    ScratchPtr<char> holder(context.scratch());
+    holder.get(EvalCtx::kMaxRetainedScratchBytes + 1);
+  }
+  ASSERT_EQ(execCtx_.scratch().retainedSize(), 0);
+}
+
 TEST_F(EvalCtxTest, vectorRecycler) {
   EvalCtx context(&execCtx_);
   VectorPtr vector;
@@ -233,3 +258,56 @@ TEST_F(EvalCtxTest, inputFlatNoNulls) {
   EvalCtx context(&execCtx_);
   ASSERT_FALSE(context.inputFlatNoNulls());
 }
+
+TEST_F(EvalCtxTest, decodedInput) {
+  constexpr vector_size_t kSize = 100;
+  auto flat = makeFlatVector<int64_t>(kSize, [](auto row) { return row; });
+  auto dictionary = BaseVector::wrapInDictionary(
+      makeNulls(kSize, [](auto row) { return row % 7 == 0; }),
+      makeIndicesInReverse(kSize),
+      kSize,
+      flat);
+  auto row = makeRowVector({dictionary, flat});
+  auto queryCtx = core::QueryCtx::create();
+  core::ExecCtx execCtx{pool_.get(), queryCtx.get()};
+  ExprSet exprSet({}, &execCtx);
+  EvalCtx context(&execCtx, &exprSet, row.get());
+
+  const auto checkDecoded = [&](const DecodedVector& decoded,
+                                const SelectivityVector& rows) {
+    rows.applyToSelected([&](auto i) {
+      ASSERT_EQ(decoded.isNullAt(i), i % 7 == 0);
+      if (!decoded.isNullAt(i)) {
+        ASSERT_EQ(decoded.valueAt<int64_t>(i), kSize - 1 - i);
+      }
+    });
+  };
+
+  SelectivityVector allRows(kSize);
+  // Flat vectors and vectors that are not input columns are not shared.
+  ASSERT_EQ(context.decodedInput(flat, allRows), nullptr);
+  ASSERT_EQ(
+      context.decodedInput(
+          wrapInDictionary(makeIndicesInReverse(kSize), flat), allRows),
+      nullptr);
+
+  SelectivityVector someRows(kSize, false);
+  someRows.setValidRange(10, 50, true);
+  someRows.updateBounds();
+  auto* decoded = context.decodedInput(dictionary, someRows);
+  ASSERT_NE(decoded, nullptr);
+  checkDecoded(*decoded, someRows);
+
+  // A subset of the decoded rows reuses the decoding.
+  SelectivityVector fewerRows(kSize, false);
+  fewerRows.setValidRange(20, 30, true);
+  fewerRows.updateBounds();
+  ASSERT_EQ(context.decodedInput(dictionary, fewerRows), decoded);
+  checkDecoded(*decoded, fewerRows);
+
+  // More rows are decoded again.
+  decoded = context.decodedInput(dictionary, allRows);
+  ASSERT_NE(decoded, nullptr);
+  checkDecoded(*decoded, allRows);
+  ASSERT_EQ(context.decodedInput(dictionary, someRows), decoded);
+}
@@ -15,6 +15,7 @@
  */
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/expression/ConstantFoldingCache.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
@@ -123,6 +124,33 @@ TEST_F(ExprCompilerTest, constantFolding) {
       "plus(plus(a, 1:BIGINT), 5:BIGINT)", compile(expression)->toString());
 }
 
+TEST_F(ExprCompilerTest, constantFoldingCache) {
+  queryCtx_->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kExprConstantFoldingCacheEnabled, "true"}});
+  auto& cache = ConstantFoldingCache::instance();
+  cache.clear();
+
+  auto rowType = ROW({"a"}, {BIGINT()});
+  auto field = makeField(rowType);
+  auto expression =
+      call("plus", {field("a"), call("plus", {bigint(1), bigint(5)})});
+
+  ASSERT_EQ("plus(a, 6:BIGINT)", compile(expression)->toString());
+  const auto numHits = cache.stats().numHits;
+
+  // The second compilation takes 1 + 5 from the cache.
+  ASSERT_EQ("plus(a, 6:BIGINT)", compile(expression)->toString());
+  ASSERT_EQ(numHits + 1, cache.stats().numHits);
+
+  // A different config does not see the cached result.
+  queryCtx_->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kExprConstantFoldingCacheEnabled, "true"},
+       {core::QueryConfig::kSessionTimezone, "America/Los_Angeles"}});
+  ASSERT_EQ("plus(a, 6:BIGINT)", compile(expression)->toString());
+  ASSERT_EQ(numHits + 1, cache.stats().numHits);
+  cache.clear();
+}
+
 TEST_F(ExprCompilerTest, andFlattening) {
   auto rowType =
       ROW({"a", "b", "c", "d"}, {BOOLEAN(), BOOLEAN(), BOOLEAN(), BOOLEAN()});
@@ -4944,6 +4944,66 @@ TEST_F(ExprTest, disableMemoization) {
   ASSERT_EQ(stats["plus"].numProcessedRows, 3 * flatSize);
 }
 
+TEST_F(ExprTest, memoAcrossBatches) {
+  // Verify that results for a dictionary base are kept when the input moves
+  // on to another base and are reused for the same base or an equal one.
+  auto first = makeFlatVector<int64_t>(100, [](auto row) { return row % 7; });
+  auto second = makeFlatVector<int64_t>(100, [](auto row) { return row % 11; });
+  auto equalToFirst =
+      makeFlatVector<int64_t>(100, [](auto row) { return row % 7; });
+  auto indices = makeIndices(50, [](auto row) { return row * 2; });
+
+  auto queryCtx = velox::core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig(std::unordered_map<std::string, std::string>{
+          {core::QueryConfig::kMaxMemoizedDictionaries, "2"}}));
+  auto execCtx = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx.get());
+  auto exprSet = compileExpression("c0 + 1", ROW({"c0"}, {BIGINT()}));
+
+  auto evaluate = [&](const FlatVectorPtr<int64_t>& base) {
+    auto [result, stats] = evaluateWithStats(
+        exprSet.get(),
+        makeRowVector({wrapInDictionary(indices, 50, base)}),
+        execCtx.get());
+    assertEqualVectors(
+        makeFlatVector<int64_t>(
+            50, [&](auto row) { return base->valueAt(row * 2) + 1; }),
+        result);
+    return stats["plus"];
+  };
+
+  // Caching starts at the first batch of a base.
+  auto stats = evaluate(first);
+  ASSERT_EQ(50, stats.numProcessedRows);
+  ASSERT_EQ(0, stats.numDictionaryMemoHits);
+  ASSERT_EQ(1, stats.numDictionaryMemoMisses);
+
+  stats = evaluate(second);
+  ASSERT_EQ(100, stats.numProcessedRows);
+  ASSERT_EQ(2, stats.numDictionaryMemoMisses);
+
+  // The same base.
+  stats = evaluate(first);
+  ASSERT_EQ(100, stats.numProcessedRows);
+  ASSERT_EQ(1, stats.numDictionaryMemoHits);
+
+  // A different base with the same values.
+  stats = evaluate(equalToFirst);
+  ASSERT_EQ(100, stats.numProcessedRows);
+  ASSERT_EQ(2, stats.numDictionaryMemoHits);
+
+  stats = evaluate(second);
+  ASSERT_EQ(100, stats.numProcessedRows);
+  ASSERT_EQ(3, stats.numDictionaryMemoHits);
+  ASSERT_EQ(2, stats.numDictionaryMemoMisses);
+
+  // Memoized results are dropped with the cached state of the ExprSet.
+  exprSet->clearCache();
+  stats = evaluate(first);
+  ASSERT_EQ(150, stats.numProcessedRows);
+  ASSERT_EQ(3, stats.numDictionaryMemoMisses);
+}
+
 TEST_F(ExprTest, disabledeferredLazyLoading) {
   // Verify that deferred lazy loading is disabled when the config is set by
   // confirming that all rows are loaded even when only a subset is required.
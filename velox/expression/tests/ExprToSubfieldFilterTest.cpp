@@ -282,6 +282,70 @@ TEST_F(ExprToSubfieldFilterTest, dereferenceWithEmptyField) {
   ASSERT_FALSE(filter);
 }
 
+TEST_F(ExprToSubfieldFilterTest, makeFunctionFilter) {
+  auto rowType = ROW(
+      {"a", "b", "c", "d", "e"},
+      {BIGINT(), BIGINT(), VARCHAR(), DOUBLE(), ROW({{"f", BIGINT()}})});
+  Subfield subfield;
+  auto filter = makeFunctionFilter(
+      parseExpr("a % 3 = 1", rowType), evaluator(), subfield);
+  ASSERT_TRUE(filter);
+  ASSERT_EQ(filter->kind(), FilterKind::kFunction);
+  validateSubfield(subfield, {"a"});
+  ASSERT_TRUE(filter->testInt64(4));
+  ASSERT_FALSE(filter->testInt64(3));
+  ASSERT_FALSE(filter->testNull());
+
+  filter = makeFunctionFilter(
+      parseExpr("coalesce(b, 0) % 2 = 0", rowType), evaluator(), subfield);
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"b"});
+  ASSERT_TRUE(filter->testInt64(2));
+  ASSERT_FALSE(filter->testInt64(3));
+  ASSERT_TRUE(filter->testNull());
+
+  filter = makeFunctionFilter(
+      parseExpr("substr(c, 2, 2) = 'bc'", rowType), evaluator(), subfield);
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"c"});
+  ASSERT_TRUE(filter->testBytes("abcd", 4));
+  ASSERT_FALSE(filter->testBytes("bcde", 4));
+
+  filter = makeFunctionFilter(
+      parseExpr("sqrt(d) > 2.0", rowType), evaluator(), subfield);
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testDouble(9));
+  ASSERT_FALSE(filter->testDouble(1));
+
+  // Values for which the expression fails pass, so that the error is raised
+  // on the rows of the scan. The other values of a batch are still filtered.
+  filter = makeFunctionFilter(
+      parseExpr("100 / a > 10", rowType), evaluator(), subfield);
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testInt64(0));
+  ASSERT_TRUE(filter->testInt64(5));
+  ASSERT_FALSE(filter->testInt64(20));
+  int64_t values[] = {0, 5, 20, 1, 0, 5, 20, 1};
+  auto batch = xsimd::load_unaligned(values);
+  auto bits = simd::toBitMask(filter->testValues(batch));
+  for (auto i = 0; i < decltype(batch)::size; ++i) {
+    ASSERT_EQ(bits::isBitSet(&bits, i), values[i] != 20) << i;
+  }
+
+  // More than one column, no column, nondeterministic or non-primitive
+  // columns are not supported.
+  ASSERT_FALSE(makeFunctionFilter(
+      parseExpr("a + b > 0", rowType), evaluator(), subfield));
+  ASSERT_FALSE(makeFunctionFilter(
+      parseExpr("rand() < 0.5", rowType), evaluator(), subfield));
+  ASSERT_FALSE(makeFunctionFilter(
+      parseExpr("rand() < d", rowType), evaluator(), subfield));
+  ASSERT_FALSE(makeFunctionFilter(
+      parseExpr("e.f > 0", rowType), evaluator(), subfield));
+  ASSERT_FALSE(
+      makeFunctionFilter(parseExpr("a + 1", rowType), evaluator(), subfield));
+}
+
 class CustomExprToSubfieldFilterParser : public ExprToSubfieldFilterParser {
  public:
   std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
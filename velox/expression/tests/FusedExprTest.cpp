@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedExpr.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/Expressions.h"
+#include "velox/parse/ExpressionsParser.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class FusedExprTest : public testing::Test,
+                      public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    parse::registerTypeResolver();
+    functions::prestosql::registerAllScalarFunctions();
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    FusedProgram::testingClearCache();
+  }
+
+  std::unique_ptr<ExprSet> compile(
+      const std::string& text,
+      const RowTypePtr& rowType,
+      bool fused = true) {
+    auto typed = core::Expressions::inferTypes(
+        parse::parseExpr(text, {}), rowType, pool());
+    auto& execCtx = fused ? fusedExecCtx_ : execCtx_;
+    return std::make_unique<ExprSet>(
+        std::vector<core::TypedExprPtr>{typed}, execCtx.get());
+  }
+
+  VectorPtr evaluate(
+      ExprSet& exprSet,
+      const RowVectorPtr& data,
+      const SelectivityVector& rows) {
+    EvalCtx context(exprSet.execCtx(), &exprSet, data.get());
+    std::vector<VectorPtr> results(1);
+    exprSet.eval(rows, context, results);
+    return results[0];
+  }
+
+  // Evaluates 'text' with and without fusing and checks that the results
+  // match on 'rows'. Returns true if the fused tree was a FusedExpr.
+  bool testFused(
+      const std::string& text,
+      const RowVectorPtr& data,
+      const SelectivityVector& rows) {
+    const auto rowType = asRowType(data->type());
+    auto fused = compile(text, rowType);
+    auto expected = evaluate(*compile(text, rowType, false), data, rows);
+    auto actual = evaluate(*fused, data, rows);
+    rows.applyToSelected([&](auto row) {
+      ASSERT_TRUE(actual->equalValueAt(expected.get(), row, row))
+          << "at " << row << ": " << actual->toString(row) << " vs "
+          << expected->toString(row);
+    });
+    return fused->expr(0)->is<FusedExpr>();
+  }
+
+  bool testFused(const std::string& text, const RowVectorPtr& data) {
+    return testFused(text, data, SelectivityVector(data->size()));
+  }
+
+  std::shared_ptr<core::QueryCtx> queryCtx_{core::QueryCtx::create()};
+  std::shared_ptr<core::QueryCtx> fusedQueryCtx_{core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig(std::unordered_map<std::string, std::string>{
+          {core::QueryConfig::kExprFusedEvaluationEnabled, "true"}}))};
+  std::unique_ptr<core::ExecCtx> execCtx_{
+      std::make_unique<core::ExecCtx>(pool_.get(), queryCtx_.get())};
+  std::unique_ptr<core::ExecCtx> fusedExecCtx_{
+      std::make_unique<core::ExecCtx>(pool_.get(), fusedQueryCtx_.get())};
+};
+
+TEST_F(FusedExprTest, basic) {
+  // Spans several tiles with a partial last tile.
+  constexpr vector_size_t kSize = 2'500;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 17; }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 5 - 2; }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 11; }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 23; }),
+      makeFlatVector<double>(kSize, [](auto row) { return row * 0.1; }),
+      makeFlatVector<double>(kSize, [](auto row) { return row % 100; }),
+      makeFlatVector<int32_t>(kSize, [](auto row) { return row % 7; }),
+  });
+
+  EXPECT_TRUE(testFused("c0 * c1 + c2 > c3 AND c4 < c5", data));
+  EXPECT_TRUE(testFused("c0 * c1 + c2 > c3 OR c4 < c5 OR c0 = 3", data));
+  EXPECT_TRUE(testFused("c0 * 3 - c1", data));
+  EXPECT_TRUE(testFused("c4 / c5 * 2.0", data));
+  EXPECT_TRUE(testFused("c6 * c6 <> c6", data));
+
+  SelectivityVector rows(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    rows.setValid(i, i % 3 == 0 || (i > 1'100 && i < 2'100));
+  }
+  rows.setValid(1, true);
+  rows.updateBounds();
+  EXPECT_TRUE(testFused("c0 * c1 + c2 > c3 AND c4 < c5", data, rows));
+  EXPECT_TRUE(testFused("c0 * 3 - c1", data, rows));
+}
+
+TEST_F(FusedExprTest, notFused) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3}),
+      makeFlatVector<int64_t>({4, 5, 6}),
+      makeFlatVector<std::string>({"a", "b", "c"}),
+  });
+
+  // A single operation.
+  EXPECT_FALSE(testFused("c0 + c1", data));
+  // Integer division.
+  EXPECT_FALSE(testFused("c0 / c1 + 1", data));
+  // Unsupported function.
+  EXPECT_FALSE(testFused("abs(c0 + c1) > 2", data));
+  EXPECT_FALSE(testFused("c0 + c1 > 2 AND c2 = 'a'", data));
+
+  auto exprSet = compile("c0 + c1 > 2", asRowType(data->type()), false);
+  EXPECT_FALSE(exprSet->expr(0)->is<FusedExpr>());
+
+  // The fusable subtree is fused when its parent is not.
+  exprSet = compile("abs(c0 * c1 + 1)", asRowType(data->type()));
+  EXPECT_TRUE(exprSet->expr(0)->inputs()[0]->is<FusedExpr>());
+}
+
+TEST_F(FusedExprTest, fallback) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<int64_t>({1, std::nullopt, 3, 4}),
+      makeFlatVector<int64_t>({4, 5, 6, 7}),
+      makeFlatVector<double>({1.0, std::nan(""), 3.0, 4.0}),
+      makeFlatVector<double>({1.0, 2.0, 0.0, 4.0}),
+  });
+
+  // Nulls.
+  EXPECT_TRUE(testFused("c0 * c1 + 1", data));
+  // NaN in a comparison.
+  EXPECT_TRUE(testFused("c2 * 2.0 >= c3", data));
+  // Division by zero.
+  EXPECT_TRUE(testFused("c2 / c3 + 1.0", data));
+
+  // Dictionary encoded input.
+  auto dictionary = makeRowVector({
+      wrapInDictionary(
+          makeIndicesInReverse(4), makeFlatVector<int64_t>({1, 2, 3, 4})),
+      makeFlatVector<int64_t>({4, 5, 6, 7}),
+  });
+  EXPECT_TRUE(testFused("c0 * c1 + c0 > 10", dictionary));
+
+  // Overflow raises the error of the interpreter.
+  auto overflow = makeRowVector({
+      makeFlatVector<int64_t>({1, std::numeric_limits<int64_t>::max()}),
+      makeFlatVector<int64_t>({2, 2}),
+  });
+  auto exprSet = compile("c0 * c1 + 1", asRowType(overflow->type()));
+  ASSERT_TRUE(exprSet->expr(0)->is<FusedExpr>());
+  VELOX_ASSERT_THROW(
+      evaluate(*exprSet, overflow, SelectivityVector(2)),
+      "integer overflow");
+}
+
+TEST_F(FusedExprTest, programCache) {
+  const auto rowType = ROW({"a", "b", "c"}, {BIGINT(), BIGINT(), BIGINT()});
+  auto first = compile("a * b + c", rowType);
+  auto second = compile("b * a + c", rowType);
+  EXPECT_EQ(1, FusedProgram::testingCacheSize());
+  EXPECT_EQ(
+      &first->expr(0)->as<FusedExpr>()->program(),
+      &second->expr(0)->as<FusedExpr>()->program());
+
+  compile("a * b + 2", rowType);
+  compile("a * b + 3", rowType);
+  EXPECT_EQ(3, FusedProgram::testingCacheSize());
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
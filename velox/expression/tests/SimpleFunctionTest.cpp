@@ -578,6 +578,68 @@ TEST_F(SimpleFunctionTest, defaultNullBehavior) {
       "default_null_behavior(c0)", makeRowVector({flatVector})));
 }
 
+// Adds two numbers. Counts the calls to callBatch().
+template <typename T>
+struct BatchPlusFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  static inline int32_t numBatchCalls{0};
+
+  FOLLY_ALWAYS_INLINE void
+  call(int64_t& out, const int64_t& a, const int64_t& b) {
+    out = a + b;
+  }
+
+  void callBatch(
+      folly::Range<int64_t*> out,
+      folly::Range<const int64_t*> a,
+      folly::Range<const int64_t*> b) {
+    ++numBatchCalls;
+    for (auto i = 0; i < out.size(); ++i) {
+      out[i] = a[i] + b[i];
+    }
+  }
+};
+
+TEST_F(SimpleFunctionTest, callBatch) {
+  registerFunction<BatchPlusFunction, int64_t, int64_t, int64_t>(
+      {"batch_plus"});
+  auto& numBatchCalls = BatchPlusFunction<exec::VectorExec>::numBatchCalls;
+  numBatchCalls = 0;
+
+  const vector_size_t size = 1'000;
+  auto a = makeFlatVector<int64_t>(size, [](auto row) { return row; });
+  auto b = makeFlatVector<int64_t>(size, [](auto row) { return row * 10; });
+  auto expected =
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 11; });
+
+  // Flat inputs without nulls use callBatch().
+  auto result = evaluate("batch_plus(c0, c1)", makeRowVector({a, b}));
+  assertEqualVectors(expected, result);
+  ASSERT_EQ(numBatchCalls, 1);
+
+  // Inputs with nulls, non-flat inputs and partially selected rows use call().
+  auto withNulls = makeFlatVector<int64_t>(
+      size, [](auto row) { return row * 10; }, nullEvery(7));
+  result = evaluate("batch_plus(c0, c1)", makeRowVector({a, withNulls}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 11; }, nullEvery(7)),
+      result);
+
+  result = evaluate("batch_plus(c0, 1)", makeRowVector({a}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(size, [](auto row) { return row + 1; }), result);
+
+  result = evaluate(
+      "if(c0 % 2 = 0, batch_plus(c0, c1), 0)", makeRowVector({a, b}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row % 2 == 0 ? row * 11 : 0; }),
+      result);
+  ASSERT_EQ(numBatchCalls, 1);
+}
+
 // Test that function with non-default null behavior receives parameters as
 // nulls. Returns whether the received parameter was null.
 template <typename T>
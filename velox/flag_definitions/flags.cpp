@@ -127,6 +127,18 @@ DEFINE_int32(
 
 DEFINE_bool(velox_ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 
+DEFINE_int32(
+    velox_io_uring_queue_depth,
+    256,
+    "Submission queue depth of the io_uring used for asynchronous local file "
+    "reads if Velox is built with VELOX_ENABLE_IO_URING. 0 disables io_uring");
+
+DEFINE_int32(
+    velox_qpl_job_pool_size,
+    32,
+    "Number of Intel IAA jobs for decompressing deflate streams if Velox is "
+    "built with VELOX_ENABLE_QPL. 0 disables IAA");
+
 DEFINE_bool(
     velox_ssd_verify_write,
     false,
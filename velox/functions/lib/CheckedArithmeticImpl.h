@@ -52,4 +52,11 @@ T checkedNegate(const T& a) {
   return facebook::velox::checkedNegate(a);
 }
 
+using facebook::velox::tryCheckedDivide;
+using facebook::velox::tryCheckedMinus;
+using facebook::velox::tryCheckedModulus;
+using facebook::velox::tryCheckedMultiply;
+using facebook::velox::tryCheckedNegate;
+using facebook::velox::tryCheckedPlus;
+
 } // namespace facebook::velox::functions
@@ -1162,8 +1162,183 @@ int32_t parseFromPattern(
   return 0;
 }
 
+// The two-digit strings "00" to "99", for formatting two digits at a time.
+struct DigitPairs {
+  constexpr DigitPairs() : chars() {
+    for (int i = 0; i < 100; ++i) {
+      chars[2 * i] = '0' + i / 10;
+      chars[2 * i + 1] = '0' + i % 10;
+    }
+  }
+
+  char chars[200];
+};
+
+constexpr DigitPairs kDigitPairs;
+
+// Writes 'value' zero padded to 'width' digits to 'result'. 'value' must have
+// at most 'width' digits.
+void writeFixedWidth(uint32_t value, uint32_t width, char* result) {
+  char* cur = result + width;
+  while (cur - result >= 2) {
+    cur -= 2;
+    std::memcpy(cur, &kDigitPairs.chars[2 * (value % 100)], 2);
+    value /= 100;
+  }
+  if (cur > result) {
+    *--cur = '0' + value;
+  }
+}
+
 } // namespace
 
+// static
+std::optional<FixedWidthLayout> DateTimeFormatter::makeFixedWidthLayout(
+    const std::vector<DateTimeToken>& tokens) {
+  FixedWidthLayout layout;
+  uint32_t specifiers = 0;
+  for (auto i = 0; i < tokens.size(); ++i) {
+    const auto& token = tokens[i];
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      // The field before a literal ends at the first non-digit.
+      if (token.literal.empty() || characterIsDigit(token.literal[0])) {
+        return std::nullopt;
+      }
+      layout.literals.push_back({layout.size, token.literal});
+      layout.size += token.literal.size();
+      continue;
+    }
+    // Consecutive fields are parsed with different widths.
+    if (i + 1 < tokens.size() &&
+        tokens[i + 1].type == DateTimeToken::Type::kPattern) {
+      return std::nullopt;
+    }
+    const auto minDigits = token.pattern.minRepresentDigits;
+    uint32_t width;
+    switch (token.pattern.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+      case DateTimeFormatSpecifier::YEAR_OF_ERA:
+        // Two digit years are mapped to a century when parsed.
+        if (minDigits == 2) {
+          return std::nullopt;
+        }
+        width = 4;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        if (minDigits > 2) {
+          return std::nullopt;
+        }
+        width = 2;
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        if (minDigits != 3) {
+          return std::nullopt;
+        }
+        width = 3;
+        break;
+      default:
+        return std::nullopt;
+    }
+    const auto bit = 1u << static_cast<uint8_t>(token.pattern.specifier);
+    if (specifiers & bit) {
+      return std::nullopt;
+    }
+    specifiers |= bit;
+    layout.formattable &= minDigits == width;
+    layout.fields.push_back({token.pattern.specifier, layout.size, width});
+    layout.size += width;
+  }
+
+  auto has = [&](DateTimeFormatSpecifier specifier) {
+    return (specifiers & (1u << static_cast<uint8_t>(specifier))) != 0;
+  };
+  if (has(DateTimeFormatSpecifier::YEAR) ==
+          has(DateTimeFormatSpecifier::YEAR_OF_ERA) ||
+      !has(DateTimeFormatSpecifier::MONTH_OF_YEAR) ||
+      !has(DateTimeFormatSpecifier::DAY_OF_MONTH)) {
+    return std::nullopt;
+  }
+  return layout;
+}
+
+std::optional<DateTimeResult> DateTimeFormatter::parseFixedWidth(
+    const std::string_view& input) const {
+  const auto& layout = fixedWidthLayout_.value();
+  if (input.size() != layout.size) {
+    return std::nullopt;
+  }
+  for (const auto& literal : layout.literals) {
+    if (std::memcmp(
+            input.data() + literal.offset,
+            literal.text.data(),
+            literal.text.size()) != 0) {
+      return std::nullopt;
+    }
+  }
+
+  int32_t year = 0;
+  int32_t month = 0;
+  int32_t day = 0;
+  int32_t hour = 0;
+  int32_t minute = 0;
+  int32_t second = 0;
+  int32_t millis = 0;
+  for (const auto& field : layout.fields) {
+    int32_t value = 0;
+    for (auto i = 0; i < field.width; ++i) {
+      const uint8_t digit = input[field.offset + i] - '0';
+      if (digit > 9) {
+        return std::nullopt;
+      }
+      value = value * 10 + digit;
+    }
+    switch (field.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+      case DateTimeFormatSpecifier::YEAR_OF_ERA:
+        year = value;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        month = value;
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        day = value;
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        hour = value;
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        minute = value;
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        second = value;
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        millis = value;
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
+  if (year < 1 || month < 1 || month > 12 || hour > 23 || minute > 59 ||
+      second > 59 || !util::isValidDate(year, month, day)) {
+    return std::nullopt;
+  }
+  const auto daysSinceEpoch = util::daysSinceEpochFromDate(year, month, day);
+  if (daysSinceEpoch.hasError()) {
+    return std::nullopt;
+  }
+  return DateTimeResult{
+      util::fromDatetime(
+          daysSinceEpoch.value(),
+          util::fromTime(hour, minute, second, millis * util::kMicrosPerMsec)),
+      nullptr};
+}
+
 uint32_t DateTimeFormatter::maxResultSize(const tz::TimeZone* timezone) const {
   uint32_t size = 0;
   for (const auto& token : tokens_) {
@@ -1279,6 +1454,50 @@ int32_t DateTimeFormatter::format(
   const date::year_month_day calDate(daysTimePoint);
   const date::weekday weekday(daysTimePoint);
 
+  if (fixedWidthLayout_.has_value() && fixedWidthLayout_->formattable) {
+    const auto year = static_cast<signed>(calDate.year());
+    if (year >= 1 && year <= 9999) {
+      const auto& layout = fixedWidthLayout_.value();
+      VELOX_CHECK_LE(
+          layout.size, maxResultSize, "Bad allocation size for result.");
+      for (const auto& literal : layout.literals) {
+        std::memcpy(
+            result + literal.offset, literal.text.data(), literal.text.size());
+      }
+      for (const auto& field : layout.fields) {
+        uint32_t value;
+        switch (field.specifier) {
+          case DateTimeFormatSpecifier::YEAR:
+          case DateTimeFormatSpecifier::YEAR_OF_ERA:
+            value = year;
+            break;
+          case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+            value = static_cast<unsigned>(calDate.month());
+            break;
+          case DateTimeFormatSpecifier::DAY_OF_MONTH:
+            value = static_cast<unsigned>(calDate.day());
+            break;
+          case DateTimeFormatSpecifier::HOUR_OF_DAY:
+            value = durationInTheDay.hours().count();
+            break;
+          case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+            value = durationInTheDay.minutes().count() % 60;
+            break;
+          case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+            value = durationInTheDay.seconds().count() % 60;
+            break;
+          case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+            value = durationInTheDay.subseconds().count();
+            break;
+          default:
+            VELOX_UNREACHABLE();
+        }
+        writeFixedWidth(value, field.width, result + field.offset);
+      }
+      return layout.size;
+    }
+  }
+
   const char* resultStart = result;
   char* maxResultEnd = result + maxResultSize;
   for (auto& token : tokens_) {
@@ -1564,6 +1783,12 @@ int32_t DateTimeFormatter::format(
 
 Expected<DateTimeResult> DateTimeFormatter::parse(
     const std::string_view& input) const {
+  if (fixedWidthLayout_.has_value()) {
+    if (auto result = parseFixedWidth(input)) {
+      return result.value();
+    }
+  }
+
   Date date;
   const char* cur = input.data();
   const char* end = cur + input.size();
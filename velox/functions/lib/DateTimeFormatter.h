@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <optional>
 #include <string>
 #include <vector>
 #include "velox/common/base/Exceptions.h"
@@ -155,6 +156,34 @@ struct DateTimeToken {
   }
 };
 
+/// Describes a format made only of fixed-width numeric fields separated by
+/// literals, e.g. 'yyyy-MM-dd HH:mm:ss.SSS' or '%Y-%m-%d %H:%i:%s'. Values in
+/// such formats are parsed and formatted at precomputed offsets instead of
+/// interpreting the tokens for each value.
+struct FixedWidthLayout {
+  struct Field {
+    DateTimeFormatSpecifier specifier;
+    uint32_t offset;
+    uint32_t width;
+  };
+
+  struct Literal {
+    uint32_t offset;
+    std::string_view text;
+  };
+
+  std::vector<Field> fields;
+  std::vector<Literal> literals;
+
+  /// Size of a value in this layout.
+  uint32_t size{0};
+
+  /// True if formatting with the tokens pads each field to its width, so that
+  /// values can also be formatted at the precomputed offsets. Otherwise only
+  /// parsing uses the layout.
+  bool formattable{true};
+};
+
 struct DateTimeResult {
   Timestamp timestamp;
   const tz::TimeZone* timezone = nullptr;
@@ -175,7 +204,8 @@ class DateTimeFormatter {
       : literalBuf_(std::move(literalBuf)),
         bufSize_(bufSize),
         tokens_(std::move(tokens)),
-        type_(type) {}
+        type_(type),
+        fixedWidthLayout_(makeFixedWidthLayout(tokens_)) {}
 
   const std::unique_ptr<char[]>& literalBuf() const {
     return literalBuf_;
@@ -189,6 +219,12 @@ class DateTimeFormatter {
     return tokens_;
   }
 
+  /// Returns the fixed-width layout of the format or std::nullopt if the
+  /// format has variable width fields.
+  const std::optional<FixedWidthLayout>& fixedWidthLayout() const {
+    return fixedWidthLayout_;
+  }
+
   // Returns an Expected<DateTimeResult> object containing the parsed
   // Timestamp and timezone information if parsing succeeded. Otherwise,
   // Returns Unexpected with UserError status if parsing failed.
@@ -216,10 +252,20 @@ class DateTimeFormatter {
       const std::optional<std::string>& zeroOffsetText = std::nullopt) const;
 
  private:
+  static std::optional<FixedWidthLayout> makeFixedWidthLayout(
+      const std::vector<DateTimeToken>& tokens);
+
+  // Parses 'input' using 'fixedWidthLayout_'. Returns std::nullopt if 'input'
+  // does not fit the layout or has out of range values, in which case the
+  // tokens are used to parse it or to report the error.
+  std::optional<DateTimeResult> parseFixedWidth(
+      const std::string_view& input) const;
+
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
   std::vector<DateTimeToken> tokens_;
   DateTimeFormatterType type_;
+  std::optional<FixedWidthLayout> fixedWidthLayout_;
 };
 
 Expected<std::shared_ptr<DateTimeFormatter>> buildMysqlDateTimeFormatter(
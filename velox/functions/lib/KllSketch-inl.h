@@ -307,6 +307,49 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(const folly::Range<const T*>& values) {
+  if (values.empty()) {
+    return;
+  }
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  size_t i = 0;
+  if (n_ == 0) {
+    minValue_ = maxValue_ = values[0];
+    i = 1;
+  }
+  for (; i < values.size(); ++i) {
+    minValue_ = std::min(minValue_, values[i], C());
+    maxValue_ = std::max(maxValue_, values[i], C());
+  }
+  size_t offset = 0;
+  if (items_.size() < k_ && numLevels() == 1) {
+    const size_t numToAppend =
+        std::min<size_t>(k_ - items_.size(), values.size());
+    items_.insert(
+        items_.end(), values.begin(), values.begin() + numToAppend);
+    levels_[1] += numToAppend;
+    offset = numToAppend;
+  }
+  while (offset < values.size()) {
+    // insertPosition() compacts if level zero is full and returns the highest
+    // free slot below level zero.  All the slots below it are free as well.
+    const uint32_t position = insertPosition();
+    const size_t numToCopy =
+        std::min<size_t>(position + 1, values.size() - offset);
+    // Fill the slots downwards in the order insert(T) would, so that the
+    // compactions that follow pick the same items.
+    for (size_t j = 0; j < numToCopy; ++j) {
+      items_[position - j] = values[offset + j];
+    }
+    levels_[0] = position + 1 - numToCopy;
+    offset += numToCopy;
+  }
+  n_ += values.size();
+  isLevelZeroSorted_ = false;
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
@@ -82,6 +82,12 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add a batch of values to the sketch.  Produces the same sketch as calling
+  /// insert(T) on each value in order, but copies the values into level zero
+  /// in blocks as large as its free space, and compacts only when level zero
+  /// is full.
+  void insert(const folly::Range<const T*>& values);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
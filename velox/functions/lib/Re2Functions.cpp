@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+#include <re2/set.h>
 #include "velox/functions/lib/string/StringImpl.h"
 #include "velox/vector/FunctionVector.h"
 
@@ -2431,4 +2432,226 @@ regexpReplaceWithLambdaSignatures() {
               .argumentType("function(array(varchar), varchar)")
               .build()};
 }
+
+namespace {
+
+// Matches all patterns in one pass over the input. Falls back to matching the
+// patterns one at a time if the RE2::Set runs out of memory for an input.
+class Re2SearchSet final : public exec::VectorFunction {
+ public:
+  Re2SearchSet(const std::vector<std::string>& patterns, bool matchAll)
+      : set_(RE2::Options(RE2::Quiet), RE2::UNANCHORED), matchAll_(matchAll) {
+    for (const auto& pattern : patterns) {
+      auto& re = regexes_.emplace_back(
+          std::make_unique<RE2>(toStringPiece(pattern), RE2::Quiet));
+      checkForBadPattern(*re);
+      std::string error;
+      VELOX_USER_CHECK_GE(
+          set_.Add(toStringPiece(pattern), &error),
+          0,
+          "invalid regular expression:{}",
+          error);
+    }
+    VELOX_USER_CHECK(
+        set_.Compile(), "Failed to compile the set of regular expressions");
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::LocalDecodedVector toSearch(context, *args[0], rows);
+    std::vector<int> matches;
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
+      result.set(row, search(toSearch->valueAt<StringView>(row), matches));
+    });
+  }
+
+ private:
+  bool search(StringView input, std::vector<int>& matches) const {
+    const auto text = toStringPiece(input);
+    RE2::Set::ErrorInfo error{RE2::Set::kNoError};
+    const bool matched =
+        set_.Match(text, matchAll_ ? &matches : nullptr, &error);
+    if (error.kind == RE2::Set::kNoError) {
+      return matched && (!matchAll_ || matches.size() == regexes_.size());
+    }
+    const auto matchOne = [&](const auto& re) {
+      return RE2::PartialMatch(text, *re);
+    };
+    return matchAll_ ? std::all_of(regexes_.begin(), regexes_.end(), matchOne)
+                     : std::any_of(regexes_.begin(), regexes_.end(), matchOne);
+  }
+
+  RE2::Set set_;
+  std::vector<std::unique_ptr<RE2>> regexes_;
+  const bool matchAll_;
+};
+
+// Fewer patterns are matched about as fast one at a time, in particular LIKE
+// patterns that have fast paths without regular expressions.
+constexpr size_t kMinSearchSetPatterns = 3;
+
+void collectTerms(
+    const core::TypedExprPtr& expr,
+    const std::string& conjunct,
+    std::vector<core::TypedExprPtr>& terms) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == conjunct) {
+    for (const auto& input : call->inputs()) {
+      collectTerms(input, conjunct, terms);
+    }
+    return;
+  }
+  terms.push_back(expr);
+}
+
+// Returns the RE2 pattern that matches the same strings as 'call' if 'call'
+// is a regexp_like or like of a varchar against a constant pattern.
+std::optional<std::string> toSearchPattern(
+    const std::string& prefix,
+    const core::CallTypedExpr& call) {
+  if (call.inputs().size() != 2 ||
+      call.inputs()[0]->type()->kind() != TypeKind::VARCHAR) {
+    return std::nullopt;
+  }
+  auto* constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(call.inputs()[1].get());
+  if (constant == nullptr || constant->hasValueVector() ||
+      constant->value().isNull() ||
+      constant->type()->kind() != TypeKind::VARCHAR) {
+    return std::nullopt;
+  }
+  const auto& pattern = constant->value().value<TypeKind::VARCHAR>();
+  if (call.name() == prefix + "regexp_like") {
+    if (!RE2(pattern, RE2::Quiet).ok()) {
+      return std::nullopt;
+    }
+    return pattern;
+  }
+  if (call.name() == prefix + "like") {
+    bool validPattern;
+    auto regex =
+        likePatternToRe2(StringView(pattern), std::nullopt, validPattern);
+    if (!validPattern) {
+      return std::nullopt;
+    }
+    // LIKE wildcards match new lines.
+    return fmt::format("(?s:{})", regex);
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+std::shared_ptr<exec::VectorFunction> makeRe2SearchSet(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_USER_CHECK_GE(
+      inputArgs.size(), 3, "{} requires at least one pattern", name);
+  auto* matchAll = inputArgs[1].constantValue.get();
+  VELOX_USER_CHECK(
+      matchAll != nullptr && !matchAll->isNullAt(0),
+      "{} requires a constant matchAll argument",
+      name);
+  std::vector<std::string> patterns;
+  for (auto i = 2; i < inputArgs.size(); ++i) {
+    auto* pattern = inputArgs[i].constantValue.get();
+    VELOX_USER_CHECK(
+        pattern != nullptr && !pattern->isNullAt(0),
+        "{} requires constant patterns",
+        name);
+    patterns.emplace_back(
+        pattern->as<ConstantVector<StringView>>()->valueAt(0));
+  }
+  return std::make_shared<Re2SearchSet>(
+      patterns, matchAll->as<ConstantVector<bool>>()->valueAt(0));
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSetSignatures() {
+  // varchar, boolean, varchar... -> boolean
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varchar")
+              .constantArgumentType("boolean")
+              .constantArgumentType("varchar")
+              .variableArity()
+              .build()};
+}
+
+core::TypedExprPtr rewriteToRe2SearchSet(
+    const std::string& prefix,
+    const std::string& searchSetName,
+    const core::TypedExprPtr& expr) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || (call->name() != "or" && call->name() != "and")) {
+    return nullptr;
+  }
+  std::vector<core::TypedExprPtr> terms;
+  collectTerms(expr, call->name(), terms);
+
+  // The patterns to match against each distinct input, in order of first
+  // appearance.
+  struct Group {
+    core::TypedExprPtr input;
+    std::vector<std::string> patterns;
+    std::vector<size_t> terms;
+  };
+  std::vector<Group> groups;
+  for (auto i = 0; i < terms.size(); ++i) {
+    auto* term = dynamic_cast<const core::CallTypedExpr*>(terms[i].get());
+    if (term == nullptr) {
+      continue;
+    }
+    auto pattern = toSearchPattern(prefix, *term);
+    if (!pattern.has_value()) {
+      continue;
+    }
+    const auto& input = term->inputs()[0];
+    auto it = std::find_if(groups.begin(), groups.end(), [&](auto& group) {
+      return *group.input == *input;
+    });
+    if (it == groups.end()) {
+      it = groups.insert(groups.end(), Group{input, {}, {}});
+    }
+    it->patterns.push_back(std::move(pattern.value()));
+    it->terms.push_back(i);
+  }
+
+  bool rewritten = false;
+  std::vector<core::TypedExprPtr> newTerms = terms;
+  for (auto& group : groups) {
+    if (group.patterns.size() < kMinSearchSetPatterns) {
+      continue;
+    }
+    std::vector<core::TypedExprPtr> args{
+        group.input,
+        std::make_shared<core::ConstantTypedExpr>(
+            BOOLEAN(), variant(call->name() == "and"))};
+    for (auto& pattern : group.patterns) {
+      args.push_back(std::make_shared<core::ConstantTypedExpr>(
+          VARCHAR(), variant(pattern)));
+    }
+    newTerms[group.terms[0]] = std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(), std::move(args), searchSetName);
+    for (auto i = 1; i < group.terms.size(); ++i) {
+      newTerms[group.terms[i]] = nullptr;
+    }
+    rewritten = true;
+  }
+  if (!rewritten) {
+    return nullptr;
+  }
+  newTerms.erase(
+      std::remove(newTerms.begin(), newTerms.end(), nullptr), newTerms.end());
+  if (newTerms.size() == 1) {
+    return newTerms[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(newTerms), call->name());
+}
 } // namespace facebook::velox::functions
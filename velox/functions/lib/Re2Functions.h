@@ -447,6 +447,28 @@ std::shared_ptr<exec::VectorFunction> makeRegexpReplaceWithLambda(
 std::vector<std::shared_ptr<exec::FunctionSignature>>
 regexpReplaceWithLambdaSignatures();
 
+/// re2SearchSet(string, matchAll, pattern, ...) → bool
+///
+/// Returns whether str has a substr that matches any of (matchAll false) or
+/// all of (matchAll true) the constant regex patterns, matching all patterns
+/// in one pass over str with an RE2::Set instead of one pass per pattern.
+std::shared_ptr<exec::VectorFunction> makeRe2SearchSet(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSetSignatures();
+
+/// Rewrites an OR (AND) with several terms that match the same input against
+/// a constant pattern with '<prefix>regexp_like' or a 2-argument
+/// '<prefix>like', into a call to 'searchSetName', a function made by
+/// makeRe2SearchSet, for these terms. Returns nullptr if 'expr' has no such
+/// terms.
+core::TypedExprPtr rewriteToRe2SearchSet(
+    const std::string& prefix,
+    const std::string& searchSetName,
+    const core::TypedExprPtr& expr);
+
 /// This function preprocesses an input pattern string to follow RE2 syntax.
 /// Java Pattern supports named capturing groups in the format
 /// (?<name>regex), but in RE2, this is written as (?P<name>regex), so we need
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/SharedInputCallRewriter.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+// Returns true if the rewrite looks into the inputs of 'expr'. Lambda bodies
+// are not rewritten since they may refer to the lambda arguments.
+bool isRewritable(const core::ITypedExpr& expr) {
+  return dynamic_cast<const core::CallTypedExpr*>(&expr) ||
+      dynamic_cast<const core::CastTypedExpr*>(&expr) ||
+      dynamic_cast<const core::FieldAccessTypedExpr*>(&expr) ||
+      dynamic_cast<const core::DereferenceTypedExpr*>(&expr) ||
+      dynamic_cast<const core::ConcatTypedExpr*>(&expr);
+}
+
+// Returns a copy of 'expr' with 'inputs'. 'expr' must be rewritable.
+core::TypedExprPtr withInputs(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr> inputs) {
+  if (auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CallTypedExpr>(
+        expr->type(), std::move(inputs), call->name());
+  }
+  if (auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CastTypedExpr>(
+        expr->type(), inputs, cast->nullOnFailure());
+  }
+  if (auto* field =
+          dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+    return std::make_shared<core::FieldAccessTypedExpr>(
+        expr->type(), inputs[0], field->name());
+  }
+  if (auto* dereference =
+          dynamic_cast<const core::DereferenceTypedExpr*>(expr.get())) {
+    return std::make_shared<core::DereferenceTypedExpr>(
+        expr->type(), inputs[0], dereference->index());
+  }
+  VELOX_CHECK_NOT_NULL(dynamic_cast<const core::ConcatTypedExpr*>(expr.get()));
+  return std::make_shared<core::ConcatTypedExpr>(
+      expr->type()->asRow().names(), inputs);
+}
+
+} // namespace
+
+std::vector<core::TypedExprPtr> SharedInputCallRewriter::rewrite(
+    const std::vector<core::TypedExprPtr>& exprs) {
+  for (const auto& expr : exprs) {
+    collect(expr);
+  }
+  bool needsRewrite = false;
+  for (auto& group : groups_) {
+    if (group.keys.size() < 2) {
+      continue;
+    }
+    std::vector<core::TypedExprPtr> args{group.input};
+    for (const auto& key : group.keys) {
+      args.push_back(
+          std::make_shared<core::ConstantTypedExpr>(VARCHAR(), variant(key)));
+    }
+    group.multi = std::make_shared<core::CallTypedExpr>(
+        ROW(std::vector<TypePtr>(group.types)),
+        std::move(args),
+        group.multiName);
+    needsRewrite = true;
+  }
+  if (!needsRewrite) {
+    return exprs;
+  }
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(rewriteExpr(expr));
+  }
+  return rewritten;
+}
+
+std::optional<SharedInputCallRewriter::Part> SharedInputCallRewriter::partOf(
+    const core::ITypedExpr& expr) const {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(&expr);
+  // Calls on a constant input are left to constant folding.
+  if (call == nullptr || call->inputs().empty() ||
+      dynamic_cast<const core::ConstantTypedExpr*>(call->inputs()[0].get())) {
+    return std::nullopt;
+  }
+  return partOf_(*call);
+}
+
+SharedInputCallRewriter::Group* SharedInputCallRewriter::findGroup(
+    const Part& part,
+    const core::ITypedExpr& input) {
+  for (auto& group : groups_) {
+    if (group.multiName == part.multiName && *group.input == input) {
+      return &group;
+    }
+  }
+  return nullptr;
+}
+
+void SharedInputCallRewriter::collect(const core::TypedExprPtr& expr) {
+  if (auto part = partOf(*expr)) {
+    const auto& input = expr->inputs()[0];
+    auto* group = findGroup(part.value(), *input);
+    if (group == nullptr) {
+      group = &groups_.emplace_back(Group{part->multiName, input, {}, {}, {}});
+    }
+    if (std::find(group->keys.begin(), group->keys.end(), part->key) ==
+        group->keys.end()) {
+      group->keys.push_back(std::move(part->key));
+      group->types.push_back(expr->type());
+    }
+    return;
+  }
+  if (!isRewritable(*expr)) {
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    collect(input);
+  }
+}
+
+core::TypedExprPtr SharedInputCallRewriter::rewriteExpr(
+    const core::TypedExprPtr& expr) {
+  if (auto part = partOf(*expr)) {
+    auto* group = findGroup(part.value(), *expr->inputs()[0]);
+    if (group->multi == nullptr) {
+      return expr;
+    }
+    const auto index =
+        std::find(group->keys.begin(), group->keys.end(), part->key) -
+        group->keys.begin();
+    return std::make_shared<core::DereferenceTypedExpr>(
+        expr->type(), group->multi, index);
+  }
+  if (!isRewritable(*expr)) {
+    return expr;
+  }
+  bool changed = false;
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(rewriteExpr(input));
+    changed |= inputs.back() != input;
+  }
+  return changed ? withInputs(expr, std::move(inputs)) : expr;
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <deque>
+
+#include "velox/core/Expressions.h"
+
+namespace facebook::velox::functions {
+
+/// Rewrites function calls that compute different parts of the same input,
+/// e.g. json_extract with different paths or url_extract_host and
+/// url_extract_path on the same column, so that the input is parsed once for
+/// all of them. Calls in a group with at least two distinct parts are replaced
+/// by field accesses into one call of a 'multi' function. The multi function
+/// takes the input followed by one constant VARCHAR key per part and returns
+/// a ROW with one field per key. The multi call is evaluated once per batch
+/// as a common subexpression. Lambda bodies are not rewritten since they may
+/// refer to the lambda arguments.
+class SharedInputCallRewriter {
+ public:
+  /// Identifies the part of its input that a call computes.
+  struct Part {
+    /// Name of the multi function that computes this part together with
+    /// others. Calls are grouped by this name and by their first input.
+    std::string multiName;
+
+    /// Constant argument of the multi function for this part. Calls with the
+    /// same key share the field of the multi call.
+    std::string key;
+  };
+
+  /// Returns the Part of 'call', or std::nullopt if 'call' is not to be
+  /// rewritten.
+  using PartFunction =
+      std::function<std::optional<Part>(const core::CallTypedExpr& call)>;
+
+  explicit SharedInputCallRewriter(PartFunction partOf)
+      : partOf_(std::move(partOf)) {}
+
+  /// Returns 'exprs' with the calls rewritten. Returns 'exprs' if no calls
+  /// share an input.
+  std::vector<core::TypedExprPtr> rewrite(
+      const std::vector<core::TypedExprPtr>& exprs);
+
+ private:
+  // The calls on one input.
+  struct Group {
+    std::string multiName;
+    core::TypedExprPtr input;
+    // Distinct keys of the calls in order of first appearance.
+    std::vector<std::string> keys;
+    // Result types of the calls for each of 'keys'.
+    std::vector<TypePtr> types;
+    // Computes all 'keys' at once. Set if there is more than one key.
+    core::TypedExprPtr multi;
+  };
+
+  // Returns the Part of 'expr' if it is a call to be rewritten.
+  std::optional<Part> partOf(const core::ITypedExpr& expr) const;
+
+  Group* findGroup(const Part& part, const core::ITypedExpr& input);
+
+  void collect(const core::TypedExprPtr& expr);
+
+  core::TypedExprPtr rewriteExpr(const core::TypedExprPtr& expr);
+
+  const PartFunction partOf_;
+  std::deque<Group> groups_;
+};
+
+} // namespace facebook::velox::functions
@@ -52,6 +52,37 @@ struct SimpleType<TypeKind::VARCHAR> {
   using type = Varchar;
 };
 
+/// Returns the key index of 'baseMap' shared by the subscripts in this
+/// evaluation. The index is built on the second request for the same map and
+/// only if the maps are large enough for lookups to beat a linear scan.
+/// Returns nullptr if there is no index.
+template <typename TKey>
+const detail::MapKeyIndex<TKey>* sharedMapKeyIndex(
+    const MapVector& baseMap,
+    const VectorPtr& mapArg,
+    const DecodedVector& decodedMapKeys,
+    exec::EvalCtx& context) {
+  static constexpr vector_size_t kMinAverageMapSize = 16;
+  if constexpr (!detail::MapKeyIndex<TKey>::supportsKey()) {
+    return nullptr;
+  } else {
+    if (!context.mapSubscriptKeyIndexEnabled() || baseMap.size() == 0) {
+      return nullptr;
+    }
+    auto& entry = context.derivedVectorState(&baseMap, mapArg);
+    if (!entry.state) {
+      if (++entry.numRequests < 2 ||
+          baseMap.mapKeys()->size() <
+              static_cast<int64_t>(kMinAverageMapSize) * baseMap.size()) {
+        return nullptr;
+      }
+      entry.state = std::make_shared<detail::MapKeyIndex<TKey>>(
+          baseMap, decodedMapKeys, *context.pool());
+    }
+    return static_cast<const detail::MapKeyIndex<TKey>*>(entry.state.get());
+  }
+}
+
 /// Decode arguments and transform result into a dictionaryVector where the
 /// dictionary maintains a mapping from a given row to the index of the input
 /// map value vector. This allows us to ensure that element_at is zero-copy.
@@ -104,6 +135,12 @@ VectorPtr applyMapTyped(
   auto rawSizes = baseMap->rawSizes();
   auto rawOffsets = baseMap->rawOffsets();
 
+  // A cached lookup table is specific to this expression and takes precedence
+  // over the key index shared with other expressions.
+  const detail::MapKeyIndex<TKey>* keyIndex = triggerCaching
+      ? nullptr
+      : sharedMapKeyIndex<TKey>(*baseMap, mapArg, *decodedMapKeys, context);
+
   // Lambda that does the search for a key, for each row.
   auto processRow = [&](vector_size_t row, TKey searchKey) {
     size_t mapIndex = mapIndices[row];
@@ -134,6 +171,12 @@ VectorPtr applyMapTyped(
         found = true;
       }
 
+    } else if (keyIndex) {
+      auto offset = keyIndex->find(mapIndex, searchKey);
+      if (offset >= 0) {
+        rawIndices[row] = offset;
+        found = true;
+      }
     } else {
       // Search map without caching.
       for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
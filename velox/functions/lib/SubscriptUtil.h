@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <folly/hash/Hash.h>
 #include "velox/expression/ComplexViewTypes.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
@@ -143,6 +144,73 @@ class LookupTable : public LookupTableBase {
   std::unique_ptr<outer_map_t> map_;
 };
 
+/// Hash index over the keys of all maps of a MapVector. Maps a pair of the
+/// map's index and a key to the offset of the first entry with that key. Built
+/// once for a map that is subscripted by multiple expressions in the same
+/// evaluation and shared by these through EvalCtx::derivedVectorState().
+///
+/// NativeType should be TypeTraits<TypeKind>::NativeType for the key's
+/// TypeKind. Only integer and string keys are supported, see supportsKey().
+template <typename NativeType>
+class MapKeyIndex {
+ public:
+  template <typename T = NativeType>
+  static constexpr bool supportsKey() {
+    return std::is_same_v<T, StringView> ||
+        (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8);
+  }
+
+  /// Indexes the keys of all non-null maps in 'map'. 'keys' are the decoded
+  /// map keys.
+  MapKeyIndex(
+      const MapVector& map,
+      const DecodedVector& keys,
+      memory::MemoryPool& pool)
+      : table_(allocator_t(pool)) {
+    auto rawOffsets = map.rawOffsets();
+    auto rawSizes = map.rawSizes();
+    table_.reserve(keys.size());
+    for (vector_size_t i = 0; i < map.size(); ++i) {
+      if (map.isNullAt(i)) {
+        continue;
+      }
+      const auto end = rawOffsets[i] + rawSizes[i];
+      for (auto offset = rawOffsets[i]; offset < end; ++offset) {
+        // Keeps the first offset for duplicate keys, like a linear scan does.
+        table_.emplace(
+            std::make_pair(i, keys.valueAt<NativeType>(offset)), offset);
+      }
+    }
+  }
+
+  /// Returns the offset of 'key' in the map at 'mapIndex' or -1 if not found.
+  vector_size_t find(vector_size_t mapIndex, const NativeType& key) const {
+    auto it = table_.find(std::make_pair(mapIndex, key));
+    return it == table_.end() ? -1 : it->second;
+  }
+
+ private:
+  using key_t = std::pair<vector_size_t, NativeType>;
+
+  struct Hasher {
+    size_t operator()(const key_t& key) const {
+      return folly::hash::hash_128_to_64(
+          folly::hasher<NativeType>()(key.second), key.first);
+    }
+  };
+
+  using allocator_t =
+      memory::StlAllocator<std::pair<const key_t, vector_size_t>>;
+
+  folly::F14FastMap<
+      key_t,
+      vector_size_t,
+      Hasher,
+      folly::f14::DefaultKeyEqual<key_t>,
+      allocator_t>
+      table_;
+};
+
 class MapSubscript {
  public:
   explicit MapSubscript(bool allowCaching) : allowCaching_(allowCaching) {}
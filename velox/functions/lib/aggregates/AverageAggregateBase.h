@@ -83,6 +83,10 @@ class AverageAggregateBase : public exec::Aggregate {
     return sizeof(SumCount<TAccumulator>);
   }
 
+  bool supportsSegmentTree() const override {
+    return true;
+  }
+
   void extractValues(char** groups, int32_t numGroups, VectorPtr* result)
       override {
     auto vector = (*result)->as<FlatVector<TResult>>();
@@ -182,12 +186,17 @@ class AverageAggregateBase : public exec::Aggregate {
         updateNonNullValue(group, numRows, TAccumulator(value) * numRows);
       }
     } else if (decodedRaw_.mayHaveNulls()) {
+      TAccumulator totalSum(0);
+      int64_t count = 0;
       rows.applyToSelected([&](vector_size_t i) {
         if (!decodedRaw_.isNullAt(i)) {
-          updateNonNullValue(
-              group, TAccumulator(decodedRaw_.valueAt<TInput>(i)));
+          totalSum += decodedRaw_.valueAt<TInput>(i);
+          ++count;
         }
       });
+      if (count > 0) {
+        updateNonNullValue(group, count, totalSum);
+      }
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInput* data = decodedRaw_.data<TInput>();
       TAccumulator totalSum(0);
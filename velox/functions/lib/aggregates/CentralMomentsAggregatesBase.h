@@ -262,15 +262,23 @@ class CentralMomentsAggregatesBase : public exec::Aggregate {
     if (decodedRaw_.isConstantMapping()) {
       if (!decodedRaw_.isNullAt(0)) {
         auto value = decodedRaw_.valueAt<T>(0);
+        CentralMomentsAccumulator accData;
         rows.applyToSelected(
-            [&](vector_size_t i) { updateNonNullValue(group, value); });
+            [&](vector_size_t /*i*/) { accData.update(value); });
+        if (accData.count() > 0) {
+          updateNonNullValue(group, accData);
+        }
       }
     } else if (decodedRaw_.mayHaveNulls()) {
+      CentralMomentsAccumulator accData;
       rows.applyToSelected([&](vector_size_t i) {
         if (!decodedRaw_.isNullAt(i)) {
-          updateNonNullValue(group, decodedRaw_.valueAt<T>(i));
+          accData.update(decodedRaw_.valueAt<T>(i));
         }
       });
+      if (accData.count() > 0) {
+        updateNonNullValue(group, accData);
+      }
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       auto data = decodedRaw_.data<T>();
       CentralMomentsAccumulator accData;
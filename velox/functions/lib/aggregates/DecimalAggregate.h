@@ -68,6 +68,53 @@ struct LongDecimalWithOverflowState {
   int64_t overflow{0};
 };
 
+/// Sums a batch of decimals into a 192 bit total with two additions and no
+/// overflow check per value. flush() then folds the total into the sum and
+/// overflow count of a LongDecimalWithOverflowState, so overflow is detected
+/// once per batch. Exact for fewer than 2^63 values.
+class LongDecimalBatchSum {
+ public:
+  template <typename T>
+  void add(T value) {
+    const int128_t wide = value;
+    low_ += static_cast<uint64_t>(wide);
+    high_ += static_cast<int64_t>(wide >> 64);
+  }
+
+  /// Adds the batch total to 'sum' and 'overflow' and resets the batch. Leaves
+  /// 'overflow' at 0 if the result fits in int128_t.
+  void flush(int128_t& sum, int64_t& overflow) {
+    // The total is high_ * 2^64 + low_. Splits both terms into multiples of
+    // 2^127, which go to 'overflow', and remainders that fit in int128_t.
+    constexpr int128_t kLow63Bits = (static_cast<int128_t>(1) << 63) - 1;
+    overflow += static_cast<int64_t>(high_ >> 63);
+    overflow += static_cast<int64_t>(low_ >> 127);
+    overflow += DecimalUtil::addWithOverflow(
+        sum, sum, static_cast<int128_t>((high_ & kLow63Bits) << 64));
+    overflow += DecimalUtil::addWithOverflow(
+        sum,
+        sum,
+        static_cast<int128_t>(low_ & ~DecimalUtil::kOverflowMultiplier));
+    if (overflow == 1 && sum < 0) {
+      sum = static_cast<int128_t>(
+          static_cast<__uint128_t>(sum) + DecimalUtil::kOverflowMultiplier);
+      overflow = 0;
+    } else if (overflow == -1 && sum > 0) {
+      sum = static_cast<int128_t>(
+          static_cast<__uint128_t>(sum) - DecimalUtil::kOverflowMultiplier);
+      overflow = 0;
+    }
+    low_ = 0;
+    high_ = 0;
+  }
+
+ private:
+  // Sum of the low 64 bits of the values, as unsigned.
+  __uint128_t low_{0};
+  // Sum of the high 64 bits of the values, as signed.
+  int128_t high_{0};
+};
+
 template <typename TResultType, typename TInputType = TResultType>
 class DecimalAggregate : public exec::Aggregate {
  public:
@@ -138,10 +185,9 @@ class DecimalAggregate : public exec::Aggregate {
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInputType* data = decodedRaw_.data<TInputType>();
       LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
+      LongDecimalBatchSum batchSum;
+      rows.applyToSelected([&](vector_size_t i) { batchSum.add(data[i]); });
+      batchSum.flush(accumulator.sum, accumulator.overflow);
       accumulator.count = rows.countSelected();
       char rawData[LongDecimalWithOverflowState::serializedSize()];
       StringView serialized(
@@ -150,12 +196,11 @@ class DecimalAggregate : public exec::Aggregate {
       mergeAccumulators<false>(group, serialized);
     } else {
       LongDecimalWithOverflowState accumulator;
+      LongDecimalBatchSum batchSum;
       rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum,
-            decodedRaw_.valueAt<TInputType>(i),
-            accumulator.sum);
+        batchSum.add(decodedRaw_.valueAt<TInputType>(i));
       });
+      batchSum.flush(accumulator.sum, accumulator.overflow);
       accumulator.count = rows.countSelected();
       char rawData[LongDecimalWithOverflowState::serializedSize()];
       StringView serialized(
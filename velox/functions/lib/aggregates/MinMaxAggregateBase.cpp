@@ -60,6 +60,10 @@ class SimpleNumericMinMaxAggregate : public SimpleNumericAggregate<T, T, T> {
     return true;
   }
 
+  bool supportsSegmentTree() const override {
+    return true;
+  }
+
   void toIntermediate(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -129,6 +133,25 @@ class SimpleNumericMaxAggregate : public SimpleNumericMinMaxAggregate<T> {
         groups, rows, args[0], updateGroup, mayPushdown);
   }
 
+  bool supportsColumnarAccumulators() const override {
+    return BaseAggregate::kSupportsColumnar;
+  }
+
+  void addRawInputColumnar(
+      char** groups,
+      const uint64_t* slots,
+      int32_t numSlots,
+      folly::Range<const vector_size_t*> firstRows,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    if constexpr (BaseAggregate::kSupportsColumnar) {
+      BaseAggregate::updateGroupsColumnar(
+          groups, slots, numSlots, firstRows, rows, args[0], updateGroup);
+    } else {
+      VELOX_UNSUPPORTED("addRawInputColumnar not supported");
+    }
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -142,6 +165,14 @@ class SimpleNumericMaxAggregate : public SimpleNumericMinMaxAggregate<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if constexpr (BaseAggregate::template kMayPushdown<T>) {
+      if (mayPushdown && args[0]->isLazy() &&
+          !args[0]->type()->isDecimal()) {
+        BaseAggregate::template pushdownOneGroup<
+            velox::aggregate::MinMaxHook<T, false>>(group, rows, args[0]);
+        return;
+      }
+    }
     BaseAggregate::updateOneGroup(
         group,
         rows,
@@ -230,6 +261,25 @@ class SimpleNumericMinAggregate : public SimpleNumericMinMaxAggregate<T> {
         groups, rows, args[0], updateGroup, mayPushdown);
   }
 
+  bool supportsColumnarAccumulators() const override {
+    return BaseAggregate::kSupportsColumnar;
+  }
+
+  void addRawInputColumnar(
+      char** groups,
+      const uint64_t* slots,
+      int32_t numSlots,
+      folly::Range<const vector_size_t*> firstRows,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    if constexpr (BaseAggregate::kSupportsColumnar) {
+      BaseAggregate::updateGroupsColumnar(
+          groups, slots, numSlots, firstRows, rows, args[0], updateGroup);
+    } else {
+      VELOX_UNSUPPORTED("addRawInputColumnar not supported");
+    }
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -243,6 +293,14 @@ class SimpleNumericMinAggregate : public SimpleNumericMinMaxAggregate<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if constexpr (BaseAggregate::template kMayPushdown<T>) {
+      if (mayPushdown && args[0]->isLazy() &&
+          !args[0]->type()->isDecimal()) {
+        BaseAggregate::template pushdownOneGroup<
+            velox::aggregate::MinMaxHook<T, true>>(group, rows, args[0]);
+        return;
+      }
+    }
     BaseAggregate::updateOneGroup(
         group,
         rows,
@@ -314,6 +372,10 @@ class MinMaxAggregateBase : public exec::Aggregate {
     return true;
   }
 
+  bool supportsSegmentTree() const override {
+    return true;
+  }
+
   void toIntermediate(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
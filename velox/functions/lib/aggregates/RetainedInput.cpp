@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/aggregates/RetainedInput.h"
+
+namespace facebook::velox::aggregate {
+
+int32_t RetainedInput::retain(const VectorPtr& vector) {
+  if (!enabled()) {
+    return -1;
+  }
+  if (!vectors_.empty() && vectors_.back().get() == vector.get()) {
+    return vectors_.size() - 1;
+  }
+  const auto bytes = vector->retainedSize();
+  if (retainedBytes_ + bytes > maxBytes_) {
+    exhausted_ = true;
+    return -1;
+  }
+  retainedBytes_ += bytes;
+  vectors_.push_back(vector);
+  return vectors_.size() - 1;
+}
+
+void RetainedInput::free(RetainedRowRefs& refs) {
+  numRefs_ -= refs.size();
+  VELOX_DCHECK_GE(numRefs_, 0);
+  std::destroy_at(&refs);
+  if (numRefs_ == 0 && !vectors_.empty()) {
+    vectors_.clear();
+    copyRanges_.clear();
+    retainedBytes_ = 0;
+  }
+}
+
+void RetainedInput::addCopy(const RetainedRowRef& ref, vector_size_t index) {
+  VELOX_DCHECK_LT(ref.vector, vectors_.size());
+  if (copyRanges_.size() < vectors_.size()) {
+    copyRanges_.resize(vectors_.size());
+  }
+  auto& ranges = copyRanges_[ref.vector];
+  if (!ranges.empty()) {
+    auto& last = ranges.back();
+    if (last.sourceIndex + last.count == ref.row &&
+        last.targetIndex + last.count == index) {
+      ++last.count;
+      return;
+    }
+  }
+  ranges.push_back({ref.row, index, 1});
+}
+
+void RetainedInput::gather(BaseVector& target) {
+  for (auto i = 0; i < copyRanges_.size(); ++i) {
+    auto& ranges = copyRanges_[i];
+    if (!ranges.empty()) {
+      target.copyRanges(vectors_[i].get(), ranges);
+      ranges.clear();
+    }
+  }
+}
+
+} // namespace facebook::velox::aggregate
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/memory/HashStringAllocator.h"
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::aggregate {
+
+/// Reference to a row of an input vector retained by RetainedInput.
+struct RetainedRowRef {
+  int32_t vector;
+  vector_size_t row;
+};
+
+/// Row references of one accumulator in the order they were added. Lives in
+/// the memory of the HashStringAllocator of the accumulators.
+using RetainedRowRefs =
+    std::vector<RetainedRowRef, StlAllocator<RetainedRowRef>>;
+
+/// Keeps the raw input vectors of an aggregate function alive so that
+/// accumulators can reference their rows instead of copying the values into
+/// HashStringAllocator memory. The values are copied once, when the result is
+/// extracted. Retention stops for good once the retained vectors would take
+/// more than the configured number of bytes, after which the function copies
+/// the values as usual. The vectors are released when no accumulator
+/// references them anymore, e.g. after the groups are spilled or extracted.
+///
+/// Used by aggregate functions after Aggregate::enableInputRetention().
+class RetainedInput {
+ public:
+  void enable(uint64_t maxBytes) {
+    maxBytes_ = maxBytes;
+  }
+
+  bool enabled() const {
+    return maxBytes_ > 0 && !exhausted_;
+  }
+
+  /// Returns the index of 'vector' among the retained vectors, retaining it
+  /// first if needed. Returns -1 if retention is disabled or the vector does
+  /// not fit in the limit. In this case the caller copies the values.
+  int32_t retain(const VectorPtr& vector);
+
+  /// Appends a reference to 'row' of retained vector 'vector' to 'refs'.
+  void addRef(int32_t vector, vector_size_t row, RetainedRowRefs& refs) {
+    refs.push_back({vector, row});
+    ++numRefs_;
+  }
+
+  /// Destroys 'refs'. Releases the retained vectors once no references to
+  /// them remain.
+  void free(RetainedRowRefs& refs);
+
+  /// Schedules a copy of the value referenced by 'ref' to position 'index' of
+  /// the target of the next gather(). Consecutive rows of a vector that go to
+  /// consecutive positions are copied as one range.
+  void addCopy(const RetainedRowRef& ref, vector_size_t index);
+
+  /// Copies the values scheduled by addCopy() into 'target'.
+  void gather(BaseVector& target);
+
+  /// Returns the total retained size of the retained vectors.
+  uint64_t retainedBytes() const {
+    return retainedBytes_;
+  }
+
+ private:
+  uint64_t maxBytes_{0};
+
+  // True once a vector did not fit in 'maxBytes_'.
+  bool exhausted_{false};
+
+  uint64_t retainedBytes_{0};
+
+  // Number of live references into 'vectors_'.
+  int64_t numRefs_{0};
+
+  std::vector<VectorPtr> vectors_;
+
+  // Copy ranges scheduled by addCopy(), one list per retained vector.
+  std::vector<std::vector<BaseVector::CopyRange>> copyRanges_;
+};
+
+} // namespace facebook::velox::aggregate
@@ -39,6 +39,12 @@ class SimpleNumericAggregate : public exec::Aggregate {
   static constexpr bool kMayPushdown = !std::is_same_v<T, int128_t> &&
       !std::is_same_v<T, Timestamp> && !std::is_same_v<T, UnknownValue>;
 
+  // True if the accumulators can be kept in a dense array for
+  // addRawInputColumnar().
+  static constexpr bool kSupportsColumnar =
+      !std::is_same_v<TAccumulator, bool> &&
+      !std::is_same_v<TAccumulator, UnknownValue>;
+
   // TData is either TAccumulator or TResult, which in most cases are the same,
   // but for sum(real) can differ.
   template <typename TData = TResult, typename ExtractOneValue>
@@ -147,6 +153,97 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Same as updateGroups() for the raw input of exec::Aggregate::
+  // addRawInputColumnar(). The accumulators of the groups are gathered into
+  // 'columnarValues_', updated there in row order and scattered back.
+  template <typename TValue = TInput, typename UpdateSingleValue>
+  void updateGroupsColumnar(
+      char** groups,
+      const uint64_t* slots,
+      int32_t numSlots,
+      folly::Range<const vector_size_t*> firstRows,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      UpdateSingleValue updateSingleValue) {
+    auto* values = gatherColumnar(groups, slots, numSlots, firstRows);
+    auto* nonNull = columnarNonNull_.data();
+    DecodedVector decoded(*arg, rows);
+    if (decoded.isConstantMapping()) {
+      if (decoded.isNullAt(0)) {
+        return;
+      }
+      const auto value = TAccumulator(decoded.valueAt<TValue>(0));
+      rows.applyToSelected([&](vector_size_t i) {
+        updateSingleValue(values[slots[i]], value);
+      });
+      for (auto row : firstRows) {
+        nonNull[slots[row]] = 1;
+      }
+    } else if (decoded.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (decoded.isNullAt(i)) {
+          return;
+        }
+        const auto slot = slots[i];
+        updateSingleValue(
+            values[slot], TAccumulator(decoded.valueAt<TValue>(i)));
+        nonNull[slot] = 1;
+      });
+    } else {
+      if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
+        auto data = decoded.data<TValue>();
+        rows.applyToSelected([&](vector_size_t i) {
+          updateSingleValue(values[slots[i]], TAccumulator(data[i]));
+        });
+      } else {
+        rows.applyToSelected([&](vector_size_t i) {
+          updateSingleValue(
+              values[slots[i]], TAccumulator(decoded.valueAt<TValue>(i)));
+        });
+      }
+      for (auto row : firstRows) {
+        nonNull[slots[row]] = 1;
+      }
+    }
+    scatterColumnar(groups, slots, firstRows);
+  }
+
+  // Copies the accumulators of the groups of 'firstRows' to their slots in
+  // 'columnarValues_' and returns the values.
+  TAccumulator* gatherColumnar(
+      char** groups,
+      const uint64_t* slots,
+      int32_t numSlots,
+      folly::Range<const vector_size_t*> firstRows) {
+    if (columnarValues_.size() < static_cast<size_t>(numSlots)) {
+      columnarValues_.resize(numSlots);
+      columnarNonNull_.resize(numSlots);
+    }
+    auto* values = columnarValues_.data();
+    for (auto row : firstRows) {
+      values[slots[row]] = *exec::Aggregate::value<TAccumulator>(groups[row]);
+    }
+    return values;
+  }
+
+  // Copies the values in 'columnarValues_' back to the groups of
+  // 'firstRows'. Clears the null flag of the groups whose slot is set in
+  // 'columnarNonNull_' and resets the slot.
+  void scatterColumnar(
+      char** groups,
+      const uint64_t* slots,
+      folly::Range<const vector_size_t*> firstRows) {
+    for (auto row : firstRows) {
+      auto* group = groups[row];
+      const auto slot = slots[row];
+      *exec::Aggregate::value<TAccumulator>(group) = columnarValues_[slot];
+      if (columnarNonNull_[slot]) {
+        exec::Aggregate::clearNull(group);
+        columnarNonNull_[slot] = 0;
+      }
+    }
+  }
+
   // TData is used to store the updated group state. It can be either
   // TAccumulator or TResult, which in most cases are the same, but for
   // sum(real) can differ. TValue is used to decode the update input 'args'.
@@ -163,11 +260,19 @@ class SimpleNumericAggregate : public exec::Aggregate {
       const VectorPtr& arg,
       UpdateSingle updateSingleValue,
       UpdateDuplicate updateDuplicateValues,
-      bool /*mayPushdown*/,
+      bool mayPushdown,
       TData initialValue) {
+    if constexpr (kMayPushdown<TData>) {
+      if (mayPushdown && arg->isLazy() && !arg->type()->isDecimal()) {
+        pushdownOneGroup<
+            velox::aggregate::SimpleCallableHook<TData, UpdateSingle>>(
+            group, rows, arg, updateSingleValue);
+        return;
+      }
+    }
+
     DecodedVector decoded(*arg, rows);
 
-    // Do row by row if not all rows are selected.
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
         updateDuplicateValues(
@@ -176,31 +281,54 @@ class SimpleNumericAggregate : public exec::Aggregate {
             rows.countSelected());
         updateNonNullValue<true, TData>(group, initialValue, updateSingleValue);
       }
-    } else if (decoded.mayHaveNulls()) {
+      return;
+    }
+
+    // The values are folded into a local copy of the accumulator, which the
+    // compiler can keep in a register, and stored back once. The order of
+    // updates is the same as updating the group in place.
+    auto* accumulator = exec::Aggregate::value<TData>(group);
+    TData localValue = *accumulator;
+    bool hasValue = false;
+    if (decoded.mayHaveNulls()) {
       rows.applyToSelected([&](vector_size_t i) {
         if (decoded.isNullAt(i)) {
           return;
         }
-        updateNonNullValue<true, TData>(
-            group, TData(decoded.valueAt<TValue>(i)), updateSingleValue);
+        hasValue = true;
+        updateSingleValue(localValue, TData(decoded.valueAt<TValue>(i)));
       });
     } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
       auto data = decoded.data<TValue>();
-      rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<true, TData>(
-            group, TData(data[i]), updateSingleValue);
-      });
+      hasValue = rows.hasSelections();
+      if (rows.isAllSelected()) {
+        // A plain loop over the rows without testing the selection bits.
+        for (auto i = rows.begin(); i < rows.end(); ++i) {
+          updateSingleValue(localValue, TData(data[i]));
+        }
+      } else {
+        rows.applyToSelected([&](vector_size_t i) {
+          updateSingleValue(localValue, TData(data[i]));
+        });
+      }
     } else {
+      hasValue = rows.hasSelections();
       rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<true, TData>(
-            group, TData(decoded.valueAt<TValue>(i)), updateSingleValue);
+        updateSingleValue(localValue, TData(decoded.valueAt<TValue>(i)));
       });
     }
+    if (hasValue) {
+      exec::Aggregate::clearNull(group);
+      *accumulator = localValue;
+    }
   }
 
-  template <typename THook>
-  void
-  pushdown(char** groups, const SelectivityVector& rows, const VectorPtr& arg) {
+  template <typename THook, typename... HookArgs>
+  void pushdown(
+      char** groups,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      HookArgs&&... hookArgs) {
     DecodedVector decoded(*arg, rows, false);
     const vector_size_t* indices = decoded.indices();
     THook hook(
@@ -208,7 +336,8 @@ class SimpleNumericAggregate : public exec::Aggregate {
         exec::Aggregate::nullByte_,
         exec::Aggregate::nullMask_,
         groups,
-        &this->exec::Aggregate::numNulls_);
+        &this->exec::Aggregate::numNulls_,
+        std::forward<HookArgs>(hookArgs)...);
     // The decoded vector does not really keep the info from the 'rows', except
     // for the 'upper bound' of it. In case not all rows are selected we need to
     // generate proper indices, which we 'indirect' through the ones we got from
@@ -231,6 +360,22 @@ class SimpleNumericAggregate : public exec::Aggregate {
         RowSet(indices, numIndices), &hook);
   }
 
+  // Pushes down the update of the single 'group' of a global aggregation into
+  // the loading of the lazy 'arg', so that the values of a column are added to
+  // the group as they are decoded instead of being materialized first.
+  template <typename THook, typename... HookArgs>
+  void pushdownOneGroup(
+      char* group,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      HookArgs&&... hookArgs) {
+    auto& groups = exec::Aggregate::pushdownGroups_;
+    groups.resize(arg->size());
+    std::fill(groups.begin(), groups.end(), group);
+    pushdown<THook>(
+        groups.data(), rows, arg, std::forward<HookArgs>(hookArgs)...);
+  }
+
  private:
   // TData is either TAccumulator or TResult, which in most cases are the same,
   // but for sum(real) can differ.
@@ -245,6 +390,12 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
     updateValue(*exec::Aggregate::value<TDataType>(group), value);
   }
+
+  // Dense accumulators indexed by slot for addRawInputColumnar(). Hold valid
+  // values only during an update.
+  std::vector<TAccumulator> columnarValues_;
+  // 1 for the slots that received a non-null value in the current update.
+  std::vector<uint8_t> columnarNonNull_;
 };
 
 } // namespace facebook::velox::functions::aggregate
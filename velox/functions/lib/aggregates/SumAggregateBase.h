@@ -45,6 +45,12 @@ class SumAggregateBase
     return 1;
   }
 
+  /// Integer sums that check for overflow may overflow on a partial sum even
+  /// if the total sum does not. Overflow is true for sums that wrap around.
+  bool supportsSegmentTree() const override {
+    return Overflow || std::is_floating_point_v<TAccumulator>;
+  }
+
   void extractValues(char** groups, int32_t numGroups, VectorPtr* result)
       override {
     BaseAggregate::template doExtractValues<ResultType>(
@@ -72,6 +78,27 @@ class SumAggregateBase
     updateInternal<TAccumulator>(groups, rows, args, mayPushdown);
   }
 
+  bool supportsColumnarAccumulators() const override {
+    return true;
+  }
+
+  void addRawInputColumnar(
+      char** groups,
+      const uint64_t* slots,
+      int32_t numSlots,
+      folly::Range<const vector_size_t*> firstRows,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    BaseAggregate::template updateGroupsColumnar<TInput>(
+        groups,
+        slots,
+        numSlots,
+        firstRows,
+        rows,
+        args[0],
+        &updateSingleValue<TAccumulator>);
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -85,6 +112,12 @@ class SumAggregateBase
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if (mayPushdown && args[0]->isLazy()) {
+      BaseAggregate::template pushdownOneGroup<
+          facebook::velox::aggregate::SumHook<TAccumulator, Overflow>>(
+          group, rows, args[0]);
+      return;
+    }
     BaseAggregate::template updateOneGroup<TAccumulator>(
         group,
         rows,
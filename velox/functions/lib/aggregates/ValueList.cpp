@@ -50,6 +50,21 @@ void ValueList::writeLastNulls(HashStringAllocator* allocator) {
   nullsCurrent_ = allocator->finishWrite(stream, kInitialSize).second;
 }
 
+void ValueList::relocate(const HashStringAllocator::RelocateFunc& relocate) {
+  const auto relocateAllocation = [&](HashStringAllocator::Header*& begin,
+                                      HashStringAllocator::Position& current) {
+    if (begin == nullptr) {
+      return;
+    }
+    const auto offset = HashStringAllocator::offset(begin, current);
+    VELOX_CHECK_GE(offset, 0);
+    begin = relocate(begin);
+    current = HashStringAllocator::seek(begin, offset);
+  };
+  relocateAllocation(nullsBegin_, nullsCurrent_);
+  relocateAllocation(dataBegin_, dataCurrent_);
+}
+
 void ValueList::appendNull(HashStringAllocator* allocator) {
   prepareAppend(allocator);
   lastNulls_ |= 1UL << (size_ % 64);
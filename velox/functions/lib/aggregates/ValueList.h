@@ -78,6 +78,10 @@ class ValueList {
     }
   }
 
+  // Moves the 'nulls' and 'data' allocations using 'relocate'. Called from the
+  // callback of HashStringAllocator::compact().
+  void relocate(const HashStringAllocator::RelocateFunc& relocate);
+
  private:
   // An array_agg or related begins with an allocation of 5 words and
   // 4 bytes for header. This is compact for small arrays (up to 5
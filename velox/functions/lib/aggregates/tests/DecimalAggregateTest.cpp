@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/aggregates/DecimalAggregate.h"
+#include <gtest/gtest.h>
+#include <folly/Random.h>
+
+namespace facebook::velox::functions::aggregate {
+namespace {
+
+// Returns (sum, overflow) from adding 'values' one at a time.
+std::pair<int128_t, int64_t> sumOneByOne(const std::vector<int128_t>& values) {
+  int128_t sum = 0;
+  int64_t overflow = 0;
+  for (auto value : values) {
+    overflow += DecimalUtil::addWithOverflow(sum, value, sum);
+  }
+  return {sum, overflow};
+}
+
+std::pair<int128_t, int64_t> sumBatch(const std::vector<int128_t>& values) {
+  int128_t sum = 0;
+  int64_t overflow = 0;
+  LongDecimalBatchSum batchSum;
+  for (auto value : values) {
+    batchSum.add(value);
+  }
+  batchSum.flush(sum, overflow);
+  return {sum, overflow};
+}
+
+TEST(DecimalAggregateTest, batchSum) {
+  folly::Random::DefaultGenerator rng(1);
+  const int128_t kMax = DecimalUtil::kLongDecimalMax;
+  auto randomDecimal = [&](bool large) {
+    const auto value =
+        HugeInt::build(folly::Random::rand64(rng), folly::Random::rand64(rng));
+    return (value % (large ? kMax : 1'000'000)) *
+        (folly::Random::oneIn(2, rng) ? 1 : -1);
+  };
+
+  for (auto iteration = 0; iteration < 1'000; ++iteration) {
+    std::vector<int128_t> values(folly::Random::rand32(1, 100, rng));
+    const bool large = folly::Random::oneIn(2, rng);
+    for (auto& value : values) {
+      value = randomDecimal(large);
+    }
+    const auto [expectedSum, expectedOverflow] = sumOneByOne(values);
+    const auto [sum, overflow] = sumBatch(values);
+    const auto expected =
+        DecimalUtil::adjustSumForOverflow(expectedSum, expectedOverflow);
+    const auto actual = DecimalUtil::adjustSumForOverflow(sum, overflow);
+    ASSERT_EQ(expected.has_value(), actual.has_value());
+    if (expected.has_value()) {
+      ASSERT_EQ(expected.value(), actual.value());
+      // A total that fits in int128_t is returned without overflow.
+      ASSERT_EQ(overflow, 0);
+    }
+  }
+
+  // Totals past the int128_t range.
+  std::vector<int128_t> values(10, kMax);
+  ASSERT_FALSE(DecimalUtil::adjustSumForOverflow(
+                   sumBatch(values).first, sumBatch(values).second)
+                   .has_value());
+  values.push_back(-kMax);
+  values.push_back(-kMax);
+  auto [sum, overflow] = sumBatch(values);
+  ASSERT_GT(overflow, 0);
+
+  // Totals that leave and re-enter the int128_t range.
+  values = {kMax, kMax, -kMax, -kMax, -1};
+  std::tie(sum, overflow) = sumBatch(values);
+  ASSERT_EQ(sum, -1);
+  ASSERT_EQ(overflow, 0);
+
+  // Flushing into a non-zero sum adds to it and resets the batch.
+  LongDecimalBatchSum batchSum;
+  sum = kMax;
+  overflow = 0;
+  batchSum.add(kMax);
+  batchSum.add(int64_t{-5});
+  batchSum.flush(sum, overflow);
+  ASSERT_EQ(DecimalUtil::adjustSumForOverflow(sum, overflow), std::nullopt);
+  batchSum.add(-kMax);
+  batchSum.flush(sum, overflow);
+  ASSERT_EQ(DecimalUtil::adjustSumForOverflow(sum, overflow), kMax - 5);
+  ASSERT_EQ(overflow, 0);
+}
+
+} // namespace
+} // namespace facebook::velox::functions::aggregate
@@ -141,3 +141,41 @@ TEST_F(ValueListTest, arrays) {
     }
   }
 }
+
+TEST_F(ValueListTest, compact) {
+  constexpr vector_size_t kSize = 1'000;
+  constexpr int32_t kNumLists = 8;
+  auto data = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row; }, test::VectorMaker::nullEvery(7));
+  DecodedVector decoded(*data);
+
+  // Interleave the appends so that the lists are split into many parts.
+  std::vector<aggregate::ValueList> values(kNumLists);
+  for (auto i = 0; i < kSize / 2; ++i) {
+    for (auto& list : values) {
+      list.appendValue(decoded, i, allocator());
+    }
+  }
+  for (auto i = 1; i < kNumLists; i += 2) {
+    values[i].free(allocator());
+  }
+
+  allocator()->compact(
+      [&](const HashStringAllocator::RelocateFunc& relocate) {
+        for (auto i = 0; i < kNumLists; i += 2) {
+          values[i].relocate(relocate);
+        }
+      });
+  allocator()->checkConsistency();
+
+  // Appends continue at the relocated positions.
+  for (auto i = 0; i < kNumLists; i += 2) {
+    for (auto row = kSize / 2; row < kSize; ++row) {
+      values[i].appendValue(decoded, row, allocator());
+    }
+    ASSERT_EQ(kSize, values[i].size());
+    assertEqualVectors(data, read(values[i], data->type(), kSize));
+    values[i].free(allocator());
+  }
+  ASSERT_TRUE(allocator()->isEmpty());
+}
@@ -85,6 +85,21 @@ int insertKllSketch(int iters) {
   return iters;
 }
 
+template <typename T>
+int insertKllSketchBatch(int iters) {
+  constexpr int kBatchSize = 1024;
+  std::vector<T> values;
+  BENCHMARK_SUSPEND {
+    populateValues(iters, values);
+  }
+  KllSketch<T> kll;
+  for (int i = 0; i < iters; i += kBatchSize) {
+    const int size = std::min(iters - i, kBatchSize);
+    kll.insert(folly::Range<const T*>(values.data() + i, size));
+  }
+  return iters;
+}
+
 void mergeTDigest(int iters, int maxSize, int count) {
   std::vector<folly::TDigest> digests;
   BENCHMARK_SUSPEND {
@@ -130,23 +145,31 @@ DEFINE_WITH_TYPE(insertTDigest, int64_t);
 DEFINE_WITH_TYPE(insertTDigest, double);
 DEFINE_WITH_TYPE(insertKllSketch, int64_t);
 DEFINE_WITH_TYPE(insertKllSketch, double);
+DEFINE_WITH_TYPE(insertKllSketchBatch, int64_t);
+DEFINE_WITH_TYPE(insertKllSketchBatch, double);
 
 #undef DEFINE_WITH_TYPE
 
 BENCHMARK_PARAM_MULTI(insertTDigest_int64_t, 1e5);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_int64_t, 1e5);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_int64_t, 1e5);
 BENCHMARK_PARAM_MULTI(insertTDigest_double, 1e5);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_double, 1e5);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_double, 1e5);
 BENCHMARK_DRAW_LINE();
 BENCHMARK_PARAM_MULTI(insertTDigest_int64_t, 1e6);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_int64_t, 1e6);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_int64_t, 1e6);
 BENCHMARK_PARAM_MULTI(insertTDigest_double, 1e6);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_double, 1e6);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_double, 1e6);
 BENCHMARK_DRAW_LINE();
 BENCHMARK_PARAM_MULTI(insertTDigest_int64_t, 1e7);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_int64_t, 1e7);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_int64_t, 1e7);
 BENCHMARK_PARAM_MULTI(insertTDigest_double, 1e7);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_double, 1e7);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_double, 1e7);
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM(mergeTDigest, 1e6x2, 1e6, 2);
 BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e6x2, 1e6, 2);
@@ -414,6 +414,84 @@ inline int64_t findNthInstanceByteIndexFromEnd(
   return index;
 }
 
+/// Calls 'onMatch(offset)' with the byte offset of each non-overlapping
+/// occurrence of the non-empty 'delimiter' in 'input', left to right, until
+/// 'onMatch' returns false. Candidates are found a SIMD batch at a time: a
+/// single byte delimiter is compared against every byte of the batch and the
+/// matches are read off the movemask. Longer delimiters must match on their
+/// first two bytes before the remaining bytes are compared.
+template <typename TOnMatch>
+FOLLY_ALWAYS_INLINE void forEachDelimiter(
+    std::string_view input,
+    std::string_view delimiter,
+    TOnMatch onMatch) {
+  using Batch = xsimd::batch<int8_t>;
+  VELOX_DCHECK(!delimiter.empty());
+  const size_t size = input.size();
+  const size_t delimSize = delimiter.size();
+  if (size < delimSize) {
+    return;
+  }
+  const auto* data = reinterpret_cast<const int8_t*>(input.data());
+  const auto first = Batch::broadcast(delimiter[0]);
+  size_t i = 0;
+  if (delimSize == 1) {
+    for (; i + Batch::size <= size; i += Batch::size) {
+      uint32_t bits =
+          simd::toBitMask(first == Batch::load_unaligned(data + i));
+      while (bits) {
+        if (!onMatch(i + __builtin_ctz(bits))) {
+          return;
+        }
+        bits &= bits - 1;
+      }
+    }
+    for (; i < size; ++i) {
+      if (input[i] == delimiter[0] && !onMatch(i)) {
+        return;
+      }
+    }
+    return;
+  }
+
+  const auto second = Batch::broadcast(delimiter[1]);
+  const size_t lastStart = size - delimSize;
+  // Lowest offset at which the next match may start.
+  size_t next = 0;
+  // The second load reads one byte past the batch.
+  for (; i + Batch::size < size; i += Batch::size) {
+    uint32_t bits = simd::toBitMask(
+        (first == Batch::load_unaligned(data + i)) &&
+        (second == Batch::load_unaligned(data + i + 1)));
+    while (bits) {
+      const size_t offset = i + __builtin_ctz(bits);
+      bits &= bits - 1;
+      if (offset > lastStart) {
+        return;
+      }
+      if (offset < next ||
+          memcmp(
+              input.data() + offset + 2,
+              delimiter.data() + 2,
+              delimSize - 2) != 0) {
+        continue;
+      }
+      if (!onMatch(offset)) {
+        return;
+      }
+      next = offset + delimSize;
+    }
+  }
+  for (i = std::max(i, next); i <= lastStart; ++i) {
+    if (memcmp(input.data() + i, delimiter.data(), delimSize) == 0) {
+      if (!onMatch(i)) {
+        return;
+      }
+      i += delimSize - 1;
+    }
+  }
+}
+
 /// Replace replaced with replacement in inputString and write results in
 /// outputString. If inPlace=true inputString and outputString are assumed to
 /// be the same. When replaced is empty and ignoreEmptyReplaced is false,
@@ -460,25 +460,22 @@ FOLLY_ALWAYS_INLINE bool splitPart(
     }
   }
 
-  while (curPos <= inputSv.size()) {
-    size_t start = curPos;
-    curPos = inputSv.find(delim, curPos);
+  size_t start = 0;
+  size_t end = inputSv.size();
+  forEachDelimiter(inputSv, delim, [&](size_t offset) {
     if (iteration == index) {
-      size_t end = curPos;
-      if (end == std::string_view::npos) {
-        end = inputSv.size();
-      }
-      output.setNoCopy(StringView(input.data() + start, end - start));
-      return true;
-    }
-
-    if (curPos == std::string_view::npos) {
+      end = offset;
       return false;
     }
-    curPos += delim.size();
-    iteration++;
+    start = offset + delim.size();
+    ++iteration;
+    return true;
+  });
+  if (iteration < index) {
+    return false;
   }
-  return false;
+  output.setNoCopy(StringView(input.data() + start, end - start));
+  return true;
 }
 
 template <
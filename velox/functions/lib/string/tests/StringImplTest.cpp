@@ -839,3 +839,49 @@ TEST_F(StringImplTest, isAscii) {
   ASSERT_FALSE(isAscii(s.data(), strlen(alpha)));
   ASSERT_FALSE(isAscii(s.data(), s.size()));
 }
+
+TEST_F(StringImplTest, forEachDelimiter) {
+  auto findAll = [](std::string_view input, std::string_view delimiter) {
+    std::vector<size_t> offsets;
+    forEachDelimiter(input, delimiter, [&](size_t offset) {
+      offsets.push_back(offset);
+      return true;
+    });
+    return offsets;
+  };
+  auto expectedOffsets = [](std::string_view input,
+                            std::string_view delimiter) {
+    std::vector<size_t> offsets;
+    for (auto pos = input.find(delimiter); pos != std::string_view::npos;
+         pos = input.find(delimiter, pos + delimiter.size())) {
+      offsets.push_back(pos);
+    }
+    return offsets;
+  };
+
+  // Inputs that cross SIMD batch boundaries, with overlapping candidates and
+  // delimiters that only match on their leading bytes.
+  std::string input;
+  for (auto i = 0; i < 100; ++i) {
+    input += i % 7 == 0 ? "ab" : (i % 5 == 0 ? "aa\xe0" : "xa");
+  }
+  for (auto delimiter : {"a", "\xe0", "aa", "ab", "aaa", "xaxa", "xaab"}) {
+    for (auto size = 0; size <= input.size(); size += 13) {
+      std::string_view prefix(input.data(), size);
+      ASSERT_EQ(findAll(prefix, delimiter), expectedOffsets(prefix, delimiter))
+          << delimiter << " " << size;
+    }
+  }
+  ASSERT_EQ(
+      findAll(std::string(70, 'a'), "aa"),
+      expectedOffsets(std::string(70, 'a'), "aa"));
+  ASSERT_TRUE(findAll("a", "aa").empty());
+
+  // Stops when the callback returns false.
+  std::vector<size_t> offsets;
+  forEachDelimiter(std::string(100, ','), ",", [&](size_t offset) {
+    offsets.push_back(offset);
+    return offsets.size() < 3;
+  });
+  ASSERT_EQ(offsets, (std::vector<size_t>{0, 1, 2}));
+}
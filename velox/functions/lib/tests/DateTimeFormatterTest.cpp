@@ -1357,6 +1357,85 @@ TEST_F(JodaDateTimeFormatterTest, betterErrorMessaging) {
       "Value 429 for dayOfMonth must be in the range [1,365] for year 2057 and month 2.");
 }
 
+TEST_F(JodaDateTimeFormatterTest, fixedWidthLayout) {
+  auto hasLayout = [&](const std::string_view& format) {
+    return getJodaDateTimeFormatter(format)->fixedWidthLayout().has_value();
+  };
+  EXPECT_TRUE(hasLayout("yyyy-MM-dd"));
+  EXPECT_TRUE(hasLayout("yyyy-MM-dd HH:mm:ss"));
+  EXPECT_TRUE(hasLayout("yyyy-MM-dd'T'HH:mm:ss.SSS"));
+  EXPECT_TRUE(hasLayout("dd/MM/yyyy"));
+  EXPECT_FALSE(hasLayout("yy-MM-dd"));
+  EXPECT_FALSE(hasLayout("yyyyMMdd"));
+  EXPECT_FALSE(hasLayout("yyyy-MM"));
+  EXPECT_FALSE(hasLayout("yyyy-MM-dd HH:mm:ss.SSSSSS"));
+  EXPECT_FALSE(hasLayout("yyyy-MM-dd HH:mm:ss ZZ"));
+  EXPECT_FALSE(hasLayout("yyyy-MM-dd-yyyy"));
+  EXPECT_FALSE(
+      getJodaDateTimeFormatter("yyyy-M-d")->fixedWidthLayout()->formattable);
+
+  // Values that fit the layout.
+  EXPECT_EQ(
+      fromTimestampString("2024-03-15 10:20:30.456"),
+      parseJoda("2024-03-15 10:20:30.456", "yyyy-MM-dd HH:mm:ss.SSS")
+          .timestamp);
+  EXPECT_EQ(
+      fromTimestampString("2024-03-15"),
+      parseJoda("15/03/2024", "dd/MM/yyyy").timestamp);
+  EXPECT_EQ(
+      fromTimestampString("2024-03-05 01:02:03"),
+      parseJoda("2024-03-05T01:02:03", "yyyy-M-d'T'H:m:s").timestamp);
+
+  // Values that do not fit the layout are parsed with the tokens.
+  EXPECT_EQ(
+      fromTimestampString("2024-03-05"),
+      parseJoda("2024-3-5", "yyyy-MM-dd").timestamp);
+  EXPECT_EQ(
+      fromTimestampString("0001-01-01"),
+      parseJoda("1-01-01", "yyyy-MM-dd").timestamp);
+  VELOX_ASSERT_THROW(
+      parseJoda("2024-13-01", "yyyy-MM-dd"),
+      "Invalid date format: '2024-13-01'");
+  VELOX_ASSERT_THROW(
+      parseJoda("2024-02-30", "yyyy-MM-dd"),
+      "Value 30 for dayOfMonth must be in the range [1,29] for year 2024 and month 2.");
+  VELOX_ASSERT_THROW(
+      parseJoda("2024-01-01 24:00:00", "yyyy-MM-dd HH:mm:ss"),
+      "Invalid date format: '2024-01-01 24:00:00'");
+  VELOX_ASSERT_THROW(
+      parseJoda("2024-01-01 00:00", "yyyy-MM-dd HH:mm:ss"),
+      "Invalid date format: '2024-01-01 00:00'");
+
+  auto format = [&](const std::string_view& pattern,
+                    const Timestamp& timestamp,
+                    const tz::TimeZone* timezone) {
+    auto formatter = getJodaDateTimeFormatter(pattern);
+    const auto maxSize = formatter->maxResultSize(timezone);
+    std::string result(maxSize, '\0');
+    result.resize(
+        formatter->format(timestamp, timezone, maxSize, result.data()));
+    return result;
+  };
+  const auto* utc = tz::locateZone("UTC");
+  EXPECT_EQ(
+      format(
+          "yyyy-MM-dd HH:mm:ss.SSS",
+          fromTimestampString("2024-03-05 01:02:03.004"),
+          utc),
+      "2024-03-05 01:02:03.004");
+  EXPECT_EQ(
+      format(
+          "yyyy-MM-dd HH:mm:ss",
+          Timestamp(0, 0),
+          tz::locateZone("America/Los_Angeles")),
+      "1969-12-31 16:00:00");
+  // Years past 9999 are formatted with the tokens.
+  EXPECT_EQ(
+      format("yyyy-MM-dd", Timestamp(253402300800, 0), utc), "10000-01-01");
+  EXPECT_EQ(
+      format("yyyy-M-d", fromTimestampString("2024-03-05"), utc), "2024-3-5");
+}
+
 class MysqlDateTimeTest : public DateTimeFormatterTest {};
 
 TEST_F(MysqlDateTimeTest, validBuild) {
@@ -1786,6 +1865,20 @@ TEST_F(MysqlDateTimeTest, formatCompositeTime) {
 }
 
 // Same semantic as YEAR_OF_ERA, except that it accepts zero and negative years.
+TEST_F(MysqlDateTimeTest, fixedWidthLayout) {
+  const auto formatter = getMysqlDateTimeFormatter("%Y-%m-%d %H:%i:%s");
+  ASSERT_TRUE(formatter->fixedWidthLayout().has_value());
+  EXPECT_EQ(
+      fromTimestampString("2024-03-05 01:02:03"),
+      parseMysql("2024-03-05 01:02:03", "%Y-%m-%d %H:%i:%s"));
+  EXPECT_EQ(
+      formatMysqlDateTime(
+          "%Y-%m-%d %H:%i:%s",
+          fromTimestampString("2024-03-05 01:02:03"),
+          tz::locateZone("UTC")),
+      "2024-03-05 01:02:03");
+}
+
 TEST_F(MysqlDateTimeTest, parseFourDigitYear) {
   EXPECT_EQ(fromTimestampString("123-01-01"), parseMysql("123", "%Y"));
   EXPECT_EQ(fromTimestampString("321-01-01"), parseMysql("321", "%Y"));
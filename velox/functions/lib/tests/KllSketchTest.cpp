@@ -225,6 +225,35 @@ TEST_F(KllSketchTest, kFromEpsilon) {
   EXPECT_EQ(kFromEpsilon(kEpsilon), kDefaultK);
 }
 
+TEST_F(KllSketchTest, insertBatch) {
+  std::default_random_engine gen(0);
+  std::normal_distribution<> dist;
+  std::vector<double> values(1e5);
+  for (auto& v : values) {
+    v = dist(gen);
+  }
+  auto serialize = [](const KllSketch<double>& kll) {
+    std::string data(kll.serializedByteSize(), '\0');
+    kll.serialize(data.data());
+    return data;
+  };
+  for (int batchSize : {1, 7, 200, 1000, 100'000}) {
+    SCOPED_TRACE(batchSize);
+    KllSketch<double> expected(kDefaultK, {}, 0);
+    KllSketch<double> kll(kDefaultK, {}, 0);
+    for (int i = 0; i < values.size(); i += batchSize) {
+      const int size = std::min<int>(batchSize, values.size() - i);
+      for (int j = 0; j < size; ++j) {
+        expected.insert(values[i + j]);
+      }
+      kll.insert(folly::Range<const double*>(values.data() + i, size));
+      ASSERT_EQ(expected.totalCount(), kll.totalCount());
+    }
+    kll.insert(folly::Range<const double*>());
+    ASSERT_EQ(serialize(expected), serialize(kll));
+  }
+}
+
 TEST_F(KllSketchTest, serialize) {
   constexpr int N = 1e5;
   constexpr int M = 1001;
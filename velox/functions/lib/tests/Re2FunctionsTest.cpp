@@ -68,6 +68,8 @@ class Re2FunctionsTest : public test::FunctionBaseTest {
     exec::registerStatefulVectorFunction(
         "re2_extract_all", re2ExtractAllSignatures(), makeRe2ExtractAll);
     exec::registerStatefulVectorFunction("like", likeSignatures(), makeLike);
+    exec::registerStatefulVectorFunction(
+        "re2_search_set", re2SearchSetSignatures(), makeRe2SearchSet);
   }
 
  protected:
@@ -1579,5 +1581,82 @@ TEST_F(Re2FunctionsTest, parseSubstrings) {
   test("%aa%bb%%", {"aa", "bb"});
   test("%aa%bb%%%cc%", {"aa", "bb", "cc"});
 }
+
+TEST_F(Re2FunctionsTest, searchSet) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>(
+      {"abc", "xyz", std::nullopt, "", "zzk", "bab", "cba"})});
+  assertEqualVectors(
+      evaluate(
+          "re2_search(c0, 'a+b') or re2_search(c0, '^x') or "
+          "re2_search(c0, 'k$')",
+          data),
+      evaluate("re2_search_set(c0, false, 'a+b', '^x', 'k$')", data));
+  assertEqualVectors(
+      evaluate(
+          "re2_search(c0, 'a') and re2_search(c0, 'b') and "
+          "re2_search(c0, 'c')",
+          data),
+      evaluate("re2_search_set(c0, true, 'a', 'b', 'c')", data));
+
+  VELOX_ASSERT_THROW(
+      evaluate("re2_search_set(c0, false, 'a', '(')", data),
+      "invalid regular expression");
+}
+
+TEST_F(Re2FunctionsTest, rewriteToSearchSet) {
+  auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          {"abc", "line\nend", "xyz", "zzz", "b", "a line", "bac"}),
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6, 7}),
+  });
+  const auto rowType = asRowType(data->type());
+  auto rewrite = [&](const std::string& text) {
+    return rewriteToRe2SearchSet(
+        "", "re2_search_set", makeTypedExpr(text, rowType));
+  };
+  auto asCall = [](const core::TypedExprPtr& expr) {
+    return dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  };
+
+  // The pattern matches are combined, other terms remain.
+  auto disjunct = rewrite(
+      "regexp_like(c0, 'b.') or c0 like 'line%' or c1 = 3 or "
+      "regexp_like(c0, '^z')");
+  ASSERT_NE(disjunct, nullptr);
+  ASSERT_EQ("or", asCall(disjunct)->name());
+  ASSERT_EQ(2, disjunct->inputs().size());
+  ASSERT_EQ("re2_search_set", asCall(disjunct->inputs()[0])->name());
+  ASSERT_EQ(5, disjunct->inputs()[0]->inputs().size());
+  assertEqualVectors(
+      makeFlatVector<bool>({true, true, true, true, false, false, true}),
+      evaluate(disjunct, data));
+
+  auto conjunct = rewrite(
+      "regexp_like(c0, 'a') and regexp_like(c0, 'b') and c0 like '%c'");
+  ASSERT_NE(conjunct, nullptr);
+  ASSERT_EQ("re2_search_set", asCall(conjunct)->name());
+  assertEqualVectors(
+      makeFlatVector<bool>({true, false, false, false, false, false, true}),
+      evaluate(conjunct, data));
+
+  // Too few patterns, different inputs or invalid patterns.
+  ASSERT_EQ(rewrite("regexp_like(c0, 'a') or c0 like 'b%'"), nullptr);
+  ASSERT_EQ(
+      rewrite(
+          "regexp_like(c0, 'a') or regexp_like(c0, '(') or c0 like 'b%'"),
+      nullptr);
+  ASSERT_EQ(
+      rewrite(
+          "regexp_like(c0, 'a') or regexp_like(c0, 'b') or "
+          "regexp_like(cast(c1 as varchar), 'c')"),
+      nullptr);
+
+  // The rewrite is registered with the Presto functions.
+  auto exprSet = compileExpression(
+      "regexp_like(c0, 'a') or regexp_like(c0, 'b') or c0 like '%c'",
+      rowType);
+  ASSERT_THAT(
+      exprSet->toString(), ::testing::HasSubstr("$internal$regexp_like_set"));
+}
 } // namespace
 } // namespace facebook::velox::functions
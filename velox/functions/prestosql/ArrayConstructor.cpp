@@ -52,16 +52,18 @@ class ArrayConstructor : public exec::VectorFunction {
       elementsResult->resize(baseOffset + numArgs * rows.countSelected());
 
       if (shouldCopyRanges(elementsResult->type())) {
-        std::vector<BaseVector::CopyRange> ranges;
-        ranges.reserve(rows.end());
+        ScratchPtr<BaseVector::CopyRange> rangesHolder(context.scratch());
+        auto* rawRanges = rangesHolder.get(rows.countSelected());
+        vector_size_t numRanges = 0;
 
         vector_size_t offset = baseOffset;
         rows.applyToSelected([&](vector_size_t row) {
           rawSizes[row] = numArgs;
           rawOffsets[row] = offset;
-          ranges.push_back({row, offset, 1});
+          rawRanges[numRanges++] = {row, offset, 1};
           offset += numArgs;
         });
+        const folly::Range<BaseVector::CopyRange*> ranges(rawRanges, numRanges);
 
         elementsResult->copyRanges(args[0].get(), ranges);
 
@@ -73,7 +75,9 @@ class ArrayConstructor : public exec::VectorFunction {
         }
       } else {
         SelectivityVector targetRows(elementsResult->size(), false);
-        std::vector<vector_size_t> toSourceRow(elementsResult->size());
+        // Only the entries for 'targetRows' are read.
+        ScratchPtr<vector_size_t> toSourceRowHolder(context.scratch());
+        auto* toSourceRow = toSourceRowHolder.get(elementsResult->size());
 
         vector_size_t offset = baseOffset;
         rows.applyToSelected([&](vector_size_t row) {
@@ -86,7 +90,7 @@ class ArrayConstructor : public exec::VectorFunction {
           offset += numArgs;
         });
         targetRows.updateBounds();
-        elementsResult->copy(args[0].get(), targetRows, toSourceRow.data());
+        elementsResult->copy(args[0].get(), targetRows, toSourceRow);
 
         for (int i = 1; i < numArgs; i++) {
           targetRows.clearAll();
@@ -99,7 +103,7 @@ class ArrayConstructor : public exec::VectorFunction {
           });
 
           targetRows.updateBounds();
-          elementsResult->copy(args[i].get(), targetRows, toSourceRow.data());
+          elementsResult->copy(args[i].get(), targetRows, toSourceRow);
         }
       }
     }
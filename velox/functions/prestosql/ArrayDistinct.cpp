@@ -36,6 +36,39 @@ struct ValueSet {
   }
 };
 
+// Set of a few values that is searched linearly. Cheaper than hashing for the
+// short arrays array_distinct typically sees.
+template <typename T>
+struct SmallValueSet {
+  static constexpr int32_t kCapacity = 16;
+
+  bool insert(T value) {
+    for (auto i = 0; i < size; ++i) {
+      if (equals(values[i], value)) {
+        return false;
+      }
+    }
+    VELOX_DCHECK_LT(size, kCapacity);
+    values[size++] = value;
+    return true;
+  }
+
+  void reset() {
+    size = 0;
+  }
+
+  static bool equals(T left, T right) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return util::floating_point::NaNAwareEquals<T>()(left, right);
+    } else {
+      return left == right;
+    }
+  }
+
+  T values[kCapacity];
+  int32_t size{0};
+};
+
 template <>
 struct ValueSet<ComplexType> {
   struct Key {
@@ -127,6 +160,13 @@ class ArrayDistinctFunction : public exec::VectorFunction {
   using ValueSetT = std::
       conditional_t<useCustomComparison, ValueSet<ComplexType>, ValueSet<T>>;
 
+  // Arrays of arithmetic values with at most SmallValueSet::kCapacity
+  // elements are deduplicated with a linear search instead of a hash set.
+  static constexpr bool kUseSmallValueSet =
+      !useCustomComparison && std::is_arithmetic_v<T>;
+  using SmallValueSetT = SmallValueSet<
+      std::conditional_t<kUseSmallValueSet, T, int64_t>>;
+
   VectorPtr applyFlat(
       const SelectivityVector& rows,
       const VectorPtr& arg,
@@ -156,10 +196,13 @@ class ArrayDistinctFunction : public exec::VectorFunction {
 
     // Process the rows: store unique values in the hash table.
     ValueSetT uniqueSet;
+    SmallValueSetT smallUniqueSet;
 
     rows.applyToSelected([&](vector_size_t row) {
       auto size = arrayVector->sizeAt(row);
       auto offset = arrayVector->offsetAt(row);
+      const bool isSmall =
+          kUseSmallValueSet && size <= SmallValueSetT::kCapacity;
 
       rawNewOffsets[row] = indicesCursor;
       bool hasNulls = false;
@@ -175,7 +218,12 @@ class ArrayDistinctFunction : public exec::VectorFunction {
             unique = uniqueSet.insert(elements->base(), elements->index(i));
           } else {
             auto value = elements->valueAt<T>(i);
-            unique = uniqueSet.insert(value);
+            if constexpr (kUseSmallValueSet) {
+              unique = isSmall ? smallUniqueSet.insert(value)
+                               : uniqueSet.insert(value);
+            } else {
+              unique = uniqueSet.insert(value);
+            }
           }
 
           if (unique) {
@@ -184,7 +232,11 @@ class ArrayDistinctFunction : public exec::VectorFunction {
         }
       }
 
-      uniqueSet.reset();
+      if (isSmall) {
+        smallUniqueSet.reset();
+      } else {
+        uniqueSet.reset();
+      }
       rawNewSizes[row] = indicesCursor - rawNewOffsets[row];
     });
 
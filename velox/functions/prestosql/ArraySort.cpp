@@ -16,6 +16,7 @@
 
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/SortingNetwork.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
@@ -176,25 +177,24 @@ void applyScalarType(
     } else if constexpr (kind == TypeKind::REAL || kind == TypeKind::DOUBLE) {
       T* resultRawValues = flatResults->mutableRawValues();
       if (ascending) {
-        std::sort(
+        sortSmallWithNetwork(
             resultRawValues + startRow,
-            resultRawValues + endRow,
+            endRow - startRow,
             util::floating_point::NaNAwareLessThan<T>());
       } else {
-        std::sort(
+        sortSmallWithNetwork(
             resultRawValues + startRow,
-            resultRawValues + endRow,
+            endRow - startRow,
             util::floating_point::NaNAwareGreaterThan<T>());
       }
     } else {
       T* resultRawValues = flatResults->mutableRawValues();
       if (ascending) {
-        std::sort(resultRawValues + startRow, resultRawValues + endRow);
+        sortSmallWithNetwork(
+            resultRawValues + startRow, endRow - startRow, std::less<T>());
       } else {
-        std::sort(
-            resultRawValues + startRow,
-            resultRawValues + endRow,
-            std::greater<T>());
+        sortSmallWithNetwork(
+            resultRawValues + startRow, endRow - startRow, std::greater<T>());
       }
     }
   };
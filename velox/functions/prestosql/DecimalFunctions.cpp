@@ -50,12 +50,16 @@ struct DecimalPlusFunction {
 #endif
 #endif
   {
-    int128_t aRescaled;
-    int128_t bRescaled;
-    if (__builtin_mul_overflow(
-            a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled) ||
-        __builtin_mul_overflow(
-            b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled)) {
+    // At most one side is rescaled. Skips the 128 bit multiplication with
+    // overflow check, which is a library call, for the other side.
+    int128_t aRescaled = a;
+    int128_t bRescaled = b;
+    if ((aRescale_ > 0 &&
+         __builtin_mul_overflow(
+             a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled)) ||
+        (bRescale_ > 0 &&
+         __builtin_mul_overflow(
+             b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled))) {
       VELOX_ARITHMETIC_ERROR("Decimal overflow: {} + {}", a, b);
     }
     out = checkedPlus<R>(R(aRescaled), R(bRescaled));
@@ -99,12 +103,16 @@ struct DecimalMinusFunction {
 #endif
 #endif
   {
-    int128_t aRescaled;
-    int128_t bRescaled;
-    if (__builtin_mul_overflow(
-            a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled) ||
-        __builtin_mul_overflow(
-            b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled)) {
+    // At most one side is rescaled. Skips the 128 bit multiplication with
+    // overflow check, which is a library call, for the other side.
+    int128_t aRescaled = a;
+    int128_t bRescaled = b;
+    if ((aRescale_ > 0 &&
+         __builtin_mul_overflow(
+             a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled)) ||
+        (bRescale_ > 0 &&
+         __builtin_mul_overflow(
+             b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled))) {
       VELOX_ARITHMETIC_ERROR("Decimal overflow: {} - {}", a, b);
     }
     out = checkedMinus<R>(R(aRescaled), R(bRescaled));
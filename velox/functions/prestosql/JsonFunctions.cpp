@@ -18,6 +18,7 @@
 #include "velox/common/base/SortingNetwork.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/expression/VectorWriters.h"
+#include "velox/functions/lib/SharedInputCallRewriter.h"
 #include "velox/functions/lib/string/StringImpl.h"
 #include "velox/functions/prestosql/json/JsonStringUtil.h"
 #include "velox/functions/prestosql/json/SIMDJsonExtractor.h"
@@ -539,6 +540,127 @@ class JsonParseFunction : public exec::VectorFunction {
   JsonParseImpl parser;
 };
 
+// Extracts 'jsonPath' from 'jsonDoc' as json_extract does.
+simdjson::error_code extractJson(
+    simdjson::ondemand::document& jsonDoc,
+    const StringView& jsonPath,
+    std::string& output) {
+  static constexpr std::string_view kNullString{"null"};
+  static constexpr std::string_view emptyArrayString{"[]"};
+  std::vector<std::string_view> results;
+  auto consumer = [&results](auto& v) {
+    // We could just convert v to a string using to_json_string directly, but
+    // in that case the JSON wouldn't be parsed (it would just return the
+    // contents directly) and we might miss invalid JSON.
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::object: {
+        SIMDJSON_ASSIGN_OR_RAISE(
+            auto jsonStr, simdjson::to_json_string(v.get_object()));
+        results.push_back(std::move(jsonStr));
+        break;
+      }
+      case simdjson::ondemand::json_type::array: {
+        SIMDJSON_ASSIGN_OR_RAISE(
+            auto jsonStr, simdjson::to_json_string(v.get_array()));
+        results.push_back(std::move(jsonStr));
+        break;
+      }
+      case simdjson::ondemand::json_type::string:
+      case simdjson::ondemand::json_type::number:
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(auto jsonStr, simdjson::to_json_string(v));
+        results.push_back(std::move(jsonStr));
+        break;
+      }
+      case simdjson::ondemand::json_type::null:
+        results.push_back(kNullString);
+        break;
+    }
+    return simdjson::SUCCESS;
+  };
+
+  auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
+  bool isDefinitePath = true;
+  SIMDJSON_TRY(extractor.extract(jsonDoc, consumer, isDefinitePath));
+
+  if (results.size() == 0) {
+    if (isDefinitePath) {
+      // If the path didn't map to anything in the JSON object, return null.
+      return simdjson::NO_SUCH_FIELD;
+    }
+    output = emptyArrayString;
+    return simdjson::SUCCESS;
+  }
+  std::stringstream ss;
+  if (!isDefinitePath) {
+    ss << "[";
+  }
+  for (int i = 0; i < results.size(); i++) {
+    if (i > 0) {
+      ss << ",";
+    }
+    ss << results[i];
+  }
+  if (!isDefinitePath) {
+    ss << "]";
+  }
+  output = ss.str();
+  return simdjson::SUCCESS;
+}
+
+// Extracts 'jsonPath' from 'jsonDoc' as json_extract_scalar does.
+simdjson::error_code extractJsonScalar(
+    simdjson::ondemand::document& jsonDoc,
+    const StringView& jsonPath,
+    std::string& output) {
+  bool resultPopulated = false;
+  std::optional<std::string> resultStr;
+  auto consumer = [&resultStr, &resultPopulated](auto& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      resultStr = std::nullopt;
+      return simdjson::SUCCESS;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        resultStr = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
+      }
+    }
+    return simdjson::SUCCESS;
+  };
+
+  auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
+  bool isDefinitePath = true;
+  SIMDJSON_TRY(extractor.extract(jsonDoc, consumer, isDefinitePath));
+
+  if (resultStr.has_value()) {
+    output = std::move(resultStr.value());
+    return simdjson::SUCCESS;
+  } else {
+    return simdjson::NO_SUCH_FIELD;
+  }
+}
+
 class JsonExtractFunction : public exec::VectorFunction {
  public:
   JsonExtractFunction(bool extractScalarOnly)
@@ -685,124 +807,141 @@ class JsonExtractFunction : public exec::VectorFunction {
       const StringView& json,
       const StringView& jsonPath,
       std::string& output) const {
-    static constexpr std::string_view kNullString{"null"};
-    static constexpr std::string_view emptyArrayString{"[]"};
-    std::vector<std::string_view> results;
-    auto consumer = [&results](auto& v) {
-      // We could just convert v to a string using to_json_string directly, but
-      // in that case the JSON wouldn't be parsed (it would just return the
-      // contents directly) and we might miss invalid JSON.
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::object: {
-          SIMDJSON_ASSIGN_OR_RAISE(
-              auto jsonStr, simdjson::to_json_string(v.get_object()));
-          results.push_back(std::move(jsonStr));
-          break;
-        }
-        case simdjson::ondemand::json_type::array: {
-          SIMDJSON_ASSIGN_OR_RAISE(
-              auto jsonStr, simdjson::to_json_string(v.get_array()));
-          results.push_back(std::move(jsonStr));
-          break;
-        }
-        case simdjson::ondemand::json_type::string:
-        case simdjson::ondemand::json_type::number:
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(auto jsonStr, simdjson::to_json_string(v));
-          results.push_back(std::move(jsonStr));
-          break;
-        }
-        case simdjson::ondemand::json_type::null:
-          results.push_back(kNullString);
-          break;
-      }
-      return simdjson::SUCCESS;
-    };
-
-    auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
-    bool isDefinitePath = true;
     simdjson::padded_string paddedJson(json.data(), json.size());
-    SIMDJSON_TRY(extractor.extract(paddedJson, consumer, isDefinitePath));
-
-    if (results.size() == 0) {
-      if (isDefinitePath) {
-        // If the path didn't map to anything in the JSON object, return null.
-        return simdjson::NO_SUCH_FIELD;
-      }
-      output = emptyArrayString;
-      return simdjson::SUCCESS;
-    }
-    std::stringstream ss;
-    if (!isDefinitePath) {
-      ss << "[";
-    }
-    for (int i = 0; i < results.size(); i++) {
-      if (i > 0) {
-        ss << ",";
-      }
-      ss << results[i];
-    }
-    if (!isDefinitePath) {
-      ss << "]";
-    }
-    output = ss.str();
-    return simdjson::SUCCESS;
+    SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
+    return extractJson(jsonDoc, jsonPath, output);
   }
 
   FOLLY_ALWAYS_INLINE simdjson::error_code processJsonExtractScalar(
       const StringView& json,
       const StringView& jsonPath,
       std::string& output) const {
-    bool resultPopulated = false;
-    std::optional<std::string> resultStr;
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return simdjson::SUCCESS;
-      }
+    simdjson::padded_string paddedJson(json.data(), json.size());
+    SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
+    return extractJsonScalar(jsonDoc, jsonPath, output);
+  }
 
-      resultPopulated = true;
+  bool extractScalarOnly_{false};
+  JsonParseImpl parser_;
+};
 
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
+// Evaluates $internal$json_extract_multi(json, path1, path2, ...) and
+// $internal$json_extract_scalar_multi(json, path1, path2, ...). Returns a ROW
+// with one field per path, holding the result of json_extract or
+// json_extract_scalar for that path. These are not called by users. The
+// rewrite registered with registerJsonFunctions replaces json_extract and
+// json_extract_scalar calls on a common input with field accesses into one of
+// these, so that each document is parsed once for all its paths.
+class JsonExtractMultiFunction : public exec::VectorFunction {
+ public:
+  JsonExtractMultiFunction(
+      bool extractScalarOnly,
+      std::vector<std::string> paths)
+      : extractScalarOnly_(extractScalarOnly), paths_(std::move(paths)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    VELOX_CHECK_EQ(args.size(), paths_.size() + 1);
+    VELOX_CHECK_EQ(outputType->size(), paths_.size());
+    VectorPtr jsonInput = args[0];
+    if (jsonInput->type() != JSON()) {
+      VELOX_CHECK_EQ(args[0]->type(), VARCHAR());
+      VectorPtr parsedJson;
+      parser_.apply(
+          rows, jsonInput, JSON(), context, parsedJson, true /* nullOnError */);
+      jsonInput = parsedJson;
+    }
+
+    std::vector<VectorPtr> fields(paths_.size());
+    std::vector<FlatVector<StringView>*> flatFields(paths_.size());
+    for (auto i = 0; i < paths_.size(); ++i) {
+      fields[i] = BaseVector::create(
+          outputType->childAt(i), rows.end(), context.pool());
+      flatFields[i] = fields[i]->asFlatVector<StringView>();
+    }
+
+    exec::LocalDecodedVector decodedJson(context, *jsonInput, rows);
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      if (decodedJson->isNullAt(row)) {
+        for (auto* field : flatFields) {
+          field->setNull(row, true);
         }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
+        return;
+      }
+      const auto json = decodedJson->valueAt<StringView>(row);
+      simdjson::padded_string paddedJson(json.data(), json.size());
+      simdjson::ondemand::document jsonDoc;
+      bool needsParse = true;
+      std::string output;
+      for (auto i = 0; i < paths_.size(); ++i) {
+        if (needsParse) {
+          if (simdjsonParse(paddedJson).get(jsonDoc)) {
+            for (auto j = i; j < paths_.size(); ++j) {
+              flatFields[j]->setNull(row, true);
+            }
+            return;
+          }
+          needsParse = false;
+        } else {
+          jsonDoc.rewind();
         }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
+        const auto error = extractScalarOnly_
+            ? extractJsonScalar(jsonDoc, StringView(paths_[i]), output)
+            : extractJson(jsonDoc, StringView(paths_[i]), output);
+        if (error == simdjson::SUCCESS) {
+          flatFields[i]->set(row, StringView(output));
+        } else {
+          flatFields[i]->setNull(row, true);
+          // A failed walk may leave the document in an error state that
+          // rewind() does not clear. Parse again for the next path.
+          needsParse = error != simdjson::NO_SUCH_FIELD;
         }
       }
-      return simdjson::SUCCESS;
-    };
+    });
 
-    auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
-    bool isDefinitePath = true;
-    simdjson::padded_string paddedJson(json.data(), json.size());
-    SIMDJSON_TRY(extractor.extract(paddedJson, consumer, isDefinitePath));
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(fields));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
 
-    if (resultStr.has_value()) {
-      output = std::move(resultStr.value());
-      return simdjson::SUCCESS;
-    } else {
-      return simdjson::NO_SUCH_FIELD;
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    return {
+        exec::FunctionSignatureBuilder()
+            .returnType("row(unknown)")
+            .argumentType("json")
+            .constantArgumentType("varchar")
+            .variableArity()
+            .build(),
+        exec::FunctionSignatureBuilder()
+            .returnType("row(unknown)")
+            .argumentType("varchar")
+            .constantArgumentType("varchar")
+            .variableArity()
+            .build()};
+  }
+
+  static std::shared_ptr<exec::VectorFunction> create(
+      bool extractScalarOnly,
+      const std::vector<exec::VectorFunctionArg>& inputArgs) {
+    std::vector<std::string> paths;
+    for (auto i = 1; i < inputArgs.size(); ++i) {
+      const auto& path = inputArgs[i].constantValue;
+      VELOX_CHECK_NOT_NULL(path);
+      VELOX_CHECK(!path->isNullAt(0));
+      paths.push_back(
+          path->as<ConstantVector<StringView>>()->valueAt(0).str());
     }
+    return std::make_shared<JsonExtractMultiFunction>(
+        extractScalarOnly, std::move(paths));
   }
 
-  bool extractScalarOnly_{false};
+ private:
+  const bool extractScalarOnly_;
+  const std::vector<std::string> paths_;
   JsonParseImpl parser_;
 };
 
@@ -849,6 +988,37 @@ class JsonInternalCastFunction : public exec::VectorFunction {
   mutable JsonCastOperator jsonCastOperator_;
 };
 
+// Returns the part for 'call' if it is a json_extract or json_extract_scalar
+// call with a valid constant path. The key of the part is the path.
+std::optional<SharedInputCallRewriter::Part> jsonExtractPart(
+    const std::string& prefix,
+    const core::CallTypedExpr& call) {
+  const bool isExtract = call.name() == prefix + "json_extract";
+  if ((!isExtract && call.name() != prefix + "json_extract_scalar") ||
+      call.inputs().size() != 2) {
+    return std::nullopt;
+  }
+  auto* path =
+      dynamic_cast<const core::ConstantTypedExpr*>(call.inputs()[1].get());
+  if (path == nullptr || path->type()->kind() != TypeKind::VARCHAR ||
+      path->hasValueVector() || path->value().isNull()) {
+    return std::nullopt;
+  }
+  auto pathValue = path->value().value<TypeKind::VARCHAR>();
+  // An invalid path fails the rows of its own call only. Keep it out of the
+  // shared call so that it does not fail the other paths.
+  try {
+    SIMDJsonExtractor::getInstance(pathValue);
+  } catch (const VeloxUserError&) {
+    return std::nullopt;
+  }
+  return SharedInputCallRewriter::Part{
+      prefix +
+          (isExtract ? "$internal$json_extract_multi"
+                     : "$internal$json_extract_scalar_multi"),
+      std::move(pathValue)};
+}
+
 } // namespace
 
 VELOX_DECLARE_VECTOR_FUNCTION(
@@ -913,4 +1083,31 @@ VELOX_DECLARE_VECTOR_FUNCTION(
     JsonInternalCastFunction::signaturesRow(),
     std::make_unique<JsonInternalCastFunction>());
 
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_$internal$_json_extract_multi,
+    JsonExtractMultiFunction::signatures(),
+    [](const std::string& /*name*/,
+       const std::vector<exec::VectorFunctionArg>& inputArgs,
+       const velox::core::QueryConfig&) {
+      return JsonExtractMultiFunction::create(false, inputArgs);
+    });
+
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_$internal$_json_extract_scalar_multi,
+    JsonExtractMultiFunction::signatures(),
+    [](const std::string& /*name*/,
+       const std::vector<exec::VectorFunctionArg>& inputArgs,
+       const velox::core::QueryConfig&) {
+      return JsonExtractMultiFunction::create(true, inputArgs);
+    });
+
+std::vector<core::TypedExprPtr> rewriteJsonExtracts(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  return SharedInputCallRewriter([&](const core::CallTypedExpr& call) {
+           return jsonExtractPart(prefix, call);
+         })
+      .rewrite(exprs);
+}
+
 } // namespace facebook::velox::functions
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/core/Expressions.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/UDFOutputString.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
@@ -276,4 +277,16 @@ struct JsonArrayLengthFunction {
   }
 };
 
+/// Rewrites 'exprs' so that json_extract or json_extract_scalar calls with
+/// different constant paths on the same input share one parse of each
+/// document. Such calls are replaced by field accesses into one call of
+/// $internal$json_extract_multi or $internal$json_extract_scalar_multi, which
+/// parses each document once and extracts all the paths from it. The shared
+/// call is evaluated once per batch as a common subexpression. Returns 'exprs'
+/// if no calls share an input. 'prefix' is the prefix the JSON functions are
+/// registered with.
+std::vector<core::TypedExprPtr> rewriteJsonExtracts(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
 } // namespace facebook::velox::functions
@@ -343,6 +343,78 @@ core::TypedExprPtr toArraySum(
   return plus;
 }
 
+// Rewrites reduce with 'call' being greatest(s, f(x)) or least(s, f(x)):
+// if(cardinality(array) = 0, initial,
+//    greatest(initial, array_max(transform(array, x -> f(x)))))
+// Like the reduce, array_max and array_min return null if any element is null.
+// Limited to integers since array_max and greatest differ for NaN.
+core::TypedExprPtr toArrayMinMax(
+    const std::string& prefix,
+    const core::CallTypedExpr& reduce,
+    const RowTypePtr& inputArgs,
+    const core::CallTypedExpr& call) {
+  if (call.inputs().size() != 2) {
+    return nullptr;
+  }
+  auto& s = inputArgs->nameOf(0);
+  core::TypedExprPtr fx;
+  if (isVariableReference(call.inputs()[0], s)) {
+    fx = call.inputs()[1];
+  } else if (isVariableReference(call.inputs()[1], s)) {
+    fx = call.inputs()[0];
+  } else {
+    return nullptr;
+  }
+  if (containsVariableReference(fx, s)) {
+    return nullptr;
+  }
+  auto& initial = reduce.inputs()[1];
+  switch (initial->type()->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      break;
+    default:
+      return nullptr;
+  }
+  auto& array = reduce.inputs()[0];
+  auto lambda = std::make_shared<core::LambdaTypedExpr>(
+      ROW({inputArgs->nameOf(1)}, {inputArgs->childAt(1)}), fx);
+  auto transform = std::make_shared<core::CallTypedExpr>(
+      ARRAY(fx->type()),
+      std::vector<core::TypedExprPtr>({array, lambda}),
+      prefix + "transform");
+  const bool isMax = call.name() == prefix + "greatest";
+  auto extreme = std::make_shared<core::CallTypedExpr>(
+      fx->type(),
+      std::vector<core::TypedExprPtr>({transform}),
+      prefix + (isMax ? "array_max" : "array_min"));
+  auto combined = std::make_shared<core::CallTypedExpr>(
+      initial->type(),
+      std::vector<core::TypedExprPtr>({initial, extreme}),
+      call.name());
+  auto cardinality = std::make_shared<core::CallTypedExpr>(
+      BIGINT(),
+      std::vector<core::TypedExprPtr>({array}),
+      prefix + "cardinality");
+  auto isEmpty = std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(),
+      std::vector<core::TypedExprPtr>(
+          {cardinality,
+           std::make_shared<core::ConstantTypedExpr>(
+               BIGINT(), variant::create<int64_t>(0))}),
+      prefix + "eq");
+  auto result = std::make_shared<core::CallTypedExpr>(
+      initial->type(),
+      std::vector<core::TypedExprPtr>({isEmpty, initial, combined}),
+      "if");
+  VLOG(1) << "Rewrite expression: " << reduce.toString() << " => "
+          << result->toString();
+  addThreadLocalRuntimeStat("numReduceRewrite", RuntimeCounter(1));
+  return result;
+}
+
 core::TypedExprPtr rewriteReduce(
     const std::string& prefix,
     const core::TypedExprPtr& expr) {
@@ -412,6 +484,11 @@ core::TypedExprPtr rewriteReduce(
         std::vector<core::TypedExprPtr>({inputBody->inputs()[0], fx, gx}),
         "if");
     return toArraySum(prefix, *reduce, inputArgs, ifExpr);
+  } else if (
+      inputBody->name() == prefix + "greatest" ||
+      inputBody->name() == prefix + "least") {
+    // greatest(s, f(x)) => greatest(s, array_max(transform(array, x -> f(x))))
+    return toArrayMinMax(prefix, *reduce, inputArgs, *inputBody);
   }
   return nullptr;
 }
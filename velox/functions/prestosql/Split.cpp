@@ -19,6 +19,7 @@
 #include "velox/expression/StringWriter.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/expression/VectorWriters.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::functions {
 
@@ -212,37 +213,36 @@ class SplitFunction : public exec::VectorFunction {
     int32_t addedElements{0};
     std::string_view sinput(input.data(), input.size());
     const std::string_view sdelim(delim.data(), delim.size());
-    while (true) {
-      // Find the byte of the 1st delimiter.
-      auto byteIndex = sinput.find(sdelim, 0);
-
-      // Special case for empty delimiters. Split character by character with an
-      // empty string at the end.
-      if (sdelim.empty()) {
-        byteIndex++;
-      }
-
-      // Delimiter is not found, leave the loop.
-      if (byteIndex > sinput.size()) {
-        break;
-      }
-
-      // Add the new element, we've split
-      arrayWriter.add_item().setNoCopy(StringView(sinput.data(), byteIndex));
-
-      // Advance input by the size of the element + delimiter.
-      // Note: should we add 'advance' method?
-      const auto advanceBytes = byteIndex + sdelim.size();
-      sinput = std::string_view(
-          sinput.data() + advanceBytes, sinput.size() - advanceBytes);
-
-      if (hasLimit) {
-        ++addedElements;
-        // If the next element should be the last, leave the loop.
-        if (addedElements + 1 == limit) {
-          break;
+    if (sdelim.empty()) {
+      // Special case for empty delimiters. Split character by character with
+      // an empty string at the end.
+      while (!sinput.empty()) {
+        arrayWriter.add_item().setNoCopy(StringView(sinput.data(), 1));
+        sinput.remove_prefix(1);
+        if (hasLimit) {
+          ++addedElements;
+          // If the next element should be the last, leave the loop.
+          if (addedElements + 1 == limit) {
+            break;
+          }
         }
       }
+    } else {
+      // All delimiter offsets are found in one SIMD scan over the input. The
+      // elements point into the input string.
+      size_t pos = 0;
+      stringCore::forEachDelimiter(sinput, sdelim, [&](size_t offset) {
+        arrayWriter.add_item().setNoCopy(
+            StringView(sinput.data() + pos, offset - pos));
+        pos = offset + sdelim.size();
+        if (hasLimit) {
+          ++addedElements;
+          // If the next element should be the last, leave the loop.
+          return addedElements + 1 != limit;
+        }
+        return true;
+      });
+      sinput.remove_prefix(pos);
     }
 
     // Add the rest of the string and we are done.
@@ -18,6 +18,7 @@
 #include "folly/container/F14Set.h"
 #include "velox/common/base/Status.h"
 #include "velox/functions/Udf.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::functions {
 
@@ -97,17 +98,17 @@ struct SplitToMapFunction {
 
     folly::F14FastMap<std::string_view, std::string_view> keyValuePairs;
 
-    auto nextEntryPos = input.find(entryDelimiter, pos);
-    while (nextEntryPos != std::string::npos) {
-      VELOX_RETURN_NOT_OK(processEntry(
-          std::string_view(input.data() + pos, nextEntryPos - pos),
+    Status status;
+    stringCore::forEachDelimiter(input, entryDelimiter, [&](size_t offset) {
+      status = processEntry(
+          std::string_view(input.data() + pos, offset - pos),
           keyValueDelimiter,
           onDuplicateKey,
-          keyValuePairs));
-
-      pos = nextEntryPos + entryDelimiter.size();
-      nextEntryPos = input.find(entryDelimiter, pos);
-    }
+          keyValuePairs);
+      pos = offset + entryDelimiter.size();
+      return status.ok();
+    });
+    VELOX_RETURN_NOT_OK(status);
 
     // Entry delimiter can be the last character in the input. In this case
     // there is no last entry to process.
@@ -15,6 +15,7 @@
  */
 
 #include "velox/functions/prestosql/URIParser.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
 #include "velox/functions/lib/Utf8Utils.h"
 
@@ -152,9 +153,32 @@ bool tryConsumePercentEncoded(const char* str, const size_t len, int32_t& pos) {
   return true;
 }
 
+// Returns the position of the first character at or after `pos` that is not
+// unreserved, checking a batch of characters at a time. Stops before the last
+// partial batch, whose characters the caller checks one at a time.
+int32_t skipUnreserved(const char* str, const size_t len, int32_t pos) {
+  using Batch = xsimd::batch<int8_t>;
+  while (pos + Batch::size <= len) {
+    const auto chars =
+        Batch::load_unaligned(reinterpret_cast<const int8_t*>(str + pos));
+    // Setting the 0x20 bit maps upper case letters to lower case and no other
+    // character to a letter.
+    const auto lower = chars | Batch(0x20);
+    const auto unreserved = (lower >= Batch('a') & lower <= Batch('z')) |
+        (chars >= Batch('0') & chars <= Batch('9')) | (chars == Batch('-')) |
+        (chars == Batch('.')) | (chars == Batch('_')) | (chars == Batch('~'));
+    const auto bits = simd::toBitMask(unreserved);
+    if (bits != simd::allSetBitMask<int8_t>()) {
+      return pos + __builtin_ctz(~bits);
+    }
+    pos += Batch::size;
+  }
+  return pos;
+}
+
 // Helper function that consumes as much of `str` from `pos` as possible where a
 // character passes mask, is part of a percent encoded character, or is an
-// allowed UTF-8 character.
+// allowed UTF-8 character. `mask` must include all unreserved characters.
 //
 // `pos` is updated to the first character in `str` that was not consumed and
 // `hasEncoded` is set to true if any percent encoded characters were
@@ -166,6 +190,12 @@ void consume(
     int32_t& pos,
     bool& hasEncoded) {
   while (pos < len) {
+    // Most URLs consist of long runs of unreserved characters. Skip these a
+    // batch at a time.
+    pos = skipUnreserved(str, len, pos);
+    if (pos == len) {
+      break;
+    }
     if (test(mask, str[pos])) {
       pos++;
       continue;
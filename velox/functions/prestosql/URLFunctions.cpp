@@ -16,6 +16,9 @@
 
 #include "URLFunctions.h"
 #include <optional>
+#include <folly/container/F14Map.h>
+#include "velox/expression/VectorFunction.h"
+#include "velox/functions/lib/SharedInputCallRewriter.h"
 #include "velox/type/Type.h"
 
 namespace facebook::velox::functions::detail {
@@ -55,3 +58,260 @@ std::optional<StringView> matchAuthorityAndPath(
 }
 
 } // namespace facebook::velox::functions::detail
+
+namespace facebook::velox::functions {
+namespace {
+
+constexpr std::string_view kParameterPrefix{"parameter="};
+
+// A part of a URI computed by one of the url_extract functions.
+enum class UrlPart {
+  kProtocol,
+  kHost,
+  kPort,
+  kPath,
+  kQuery,
+  kFragment,
+  kParameter,
+};
+
+// Evaluates $internal$url_extract_multi(url, key1, key2, ...). Returns a ROW
+// with one field per key, holding the result of the url_extract function
+// named by the key. The keys are 'protocol', 'host', 'port', 'path', 'query',
+// 'fragment' and 'parameter=<name>' for url_extract_parameter(url, <name>).
+// This is not called by users. The rewrite registered with
+// registerURLFunctions replaces url_extract calls on a common input with field
+// accesses into this, so that each URL is parsed once for all its parts.
+class UrlExtractMultiFunction : public exec::VectorFunction {
+ public:
+  UrlExtractMultiFunction(
+      std::vector<UrlPart> parts,
+      std::vector<std::string> parameters)
+      : parts_(std::move(parts)), parameters_(std::move(parameters)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    VELOX_CHECK_EQ(args.size(), parts_.size() + 1);
+    VELOX_CHECK_EQ(outputType->size(), parts_.size());
+
+    exec::LocalDecodedVector decodedUrls(context, *args[0], rows);
+    std::vector<VectorPtr> fields(parts_.size());
+    for (auto i = 0; i < parts_.size(); ++i) {
+      fields[i] = BaseVector::create(
+          outputType->childAt(i), rows.end(), context.pool());
+      if (parts_[i] != UrlPart::kPort) {
+        // Parts without escapes refer to the strings of the input.
+        fields[i]->asFlatVector<StringView>()->acquireSharedStringBuffers(
+            decodedUrls->base());
+      }
+    }
+
+    std::string unescaped;
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      URI uri;
+      if (decodedUrls->isNullAt(row) ||
+          !parseUri(decodedUrls->valueAt<StringView>(row), uri)) {
+        for (auto& field : fields) {
+          field->setNull(row, true);
+        }
+        return;
+      }
+      for (auto i = 0; i < parts_.size(); ++i) {
+        switch (parts_[i]) {
+          case UrlPart::kProtocol:
+            setPart(*fields[i], row, uri.scheme, false, unescaped);
+            break;
+          case UrlPart::kHost:
+            setPart(*fields[i], row, uri.host, uri.hostHasEncoded, unescaped);
+            break;
+          case UrlPart::kPath:
+            setPart(*fields[i], row, uri.path, uri.pathHasEncoded, unescaped);
+            break;
+          case UrlPart::kQuery:
+            setPart(
+                *fields[i], row, uri.query, uri.queryHasEncoded, unescaped);
+            break;
+          case UrlPart::kFragment:
+            setPart(
+                *fields[i],
+                row,
+                uri.fragment,
+                uri.fragmentHasEncoded,
+                unescaped);
+            break;
+          case UrlPart::kPort:
+            setPort(*fields[i], row, uri.port);
+            break;
+          case UrlPart::kParameter:
+            setParameter(*fields[i], row, uri, parameters_[i], unescaped);
+            break;
+        }
+      }
+    });
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(fields));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    return {exec::FunctionSignatureBuilder()
+                .returnType("row(unknown)")
+                .argumentType("varchar")
+                .constantArgumentType("varchar")
+                .variableArity()
+                .build()};
+  }
+
+  static std::shared_ptr<exec::VectorFunction> create(
+      const std::vector<exec::VectorFunctionArg>& inputArgs) {
+    std::vector<UrlPart> parts;
+    std::vector<std::string> parameters;
+    for (auto i = 1; i < inputArgs.size(); ++i) {
+      const auto& key = inputArgs[i].constantValue;
+      VELOX_CHECK_NOT_NULL(key);
+      VELOX_CHECK(!key->isNullAt(0));
+      const auto keyValue =
+          key->as<ConstantVector<StringView>>()->valueAt(0).str();
+      parameters.emplace_back();
+      if (keyValue.compare(0, kParameterPrefix.size(), kParameterPrefix) == 0) {
+        parts.push_back(UrlPart::kParameter);
+        parameters.back() = keyValue.substr(kParameterPrefix.size());
+      } else {
+        parts.push_back(toUrlPart(keyValue));
+      }
+    }
+    return std::make_shared<UrlExtractMultiFunction>(
+        std::move(parts), std::move(parameters));
+  }
+
+ private:
+  static UrlPart toUrlPart(const std::string& key) {
+    static const folly::F14FastMap<std::string, UrlPart> kParts = {
+        {"protocol", UrlPart::kProtocol},
+        {"host", UrlPart::kHost},
+        {"port", UrlPart::kPort},
+        {"path", UrlPart::kPath},
+        {"query", UrlPart::kQuery},
+        {"fragment", UrlPart::kFragment},
+    };
+    auto it = kParts.find(key);
+    VELOX_CHECK(it != kParts.end(), "Unknown URL part: {}", key);
+    return it->second;
+  }
+
+  // Sets 'field' at 'row' to 'part', unescaped if 'hasEncoded'.
+  static void setPart(
+      BaseVector& field,
+      vector_size_t row,
+      StringView part,
+      bool hasEncoded,
+      std::string& unescaped) {
+    auto* flat = field.asUnchecked<FlatVector<StringView>>();
+    if (hasEncoded) {
+      detail::urlUnescape(unescaped, part);
+      flat->set(row, StringView(unescaped));
+    } else {
+      flat->setNoCopy(row, part);
+    }
+  }
+
+  static void setPort(BaseVector& field, vector_size_t row, StringView port) {
+    auto* flat = field.asUnchecked<FlatVector<int64_t>>();
+    if (!port.empty()) {
+      if (auto value = folly::tryTo<int64_t>(
+              folly::StringPiece(port.data(), port.size()))) {
+        flat->set(row, value.value());
+        return;
+      }
+    }
+    flat->setNull(row, true);
+  }
+
+  static void setParameter(
+      BaseVector& field,
+      vector_size_t row,
+      const URI& uri,
+      const std::string& name,
+      std::string& unescaped) {
+    auto* flat = field.asUnchecked<FlatVector<StringView>>();
+    if (!uri.query.empty()) {
+      StringView query = uri.query;
+      if (uri.queryHasEncoded) {
+        detail::urlUnescape(unescaped, uri.query);
+        query = StringView(unescaped);
+      }
+      if (const auto value = extractParameter(query, name)) {
+        flat->set(row, value.value());
+        return;
+      }
+    }
+    flat->setNull(row, true);
+  }
+
+  const std::vector<UrlPart> parts_;
+  // The parameter names for the kParameter entries of 'parts_'.
+  const std::vector<std::string> parameters_;
+};
+
+// Returns the part for 'call' if it is a url_extract call on a URL. The key
+// of the part names the url_extract function and, for url_extract_parameter,
+// its constant parameter name.
+std::optional<SharedInputCallRewriter::Part> urlExtractPart(
+    const std::string& prefix,
+    const core::CallTypedExpr& call) {
+  static const std::vector<std::string> kParts = {
+      "protocol", "host", "port", "path", "query", "fragment"};
+  const auto multiName = prefix + "$internal$url_extract_multi";
+  if (call.inputs()[0]->type()->kind() != TypeKind::VARCHAR) {
+    return std::nullopt;
+  }
+  if (call.inputs().size() == 1) {
+    for (const auto& part : kParts) {
+      if (call.name() == prefix + "url_extract_" + part) {
+        return SharedInputCallRewriter::Part{multiName, part};
+      }
+    }
+    return std::nullopt;
+  }
+  if (call.inputs().size() != 2 ||
+      call.name() != prefix + "url_extract_parameter") {
+    return std::nullopt;
+  }
+  auto* name =
+      dynamic_cast<const core::ConstantTypedExpr*>(call.inputs()[1].get());
+  if (name == nullptr || name->type()->kind() != TypeKind::VARCHAR ||
+      name->hasValueVector() || name->value().isNull()) {
+    return std::nullopt;
+  }
+  return SharedInputCallRewriter::Part{
+      multiName,
+      fmt::format(
+          "{}{}", kParameterPrefix, name->value().value<TypeKind::VARCHAR>())};
+}
+
+} // namespace
+
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_$internal$_url_extract_multi,
+    UrlExtractMultiFunction::signatures(),
+    [](const std::string& /*name*/,
+       const std::vector<exec::VectorFunctionArg>& inputArgs,
+       const velox::core::QueryConfig&) {
+      return UrlExtractMultiFunction::create(inputArgs);
+    });
+
+std::vector<core::TypedExprPtr> rewriteUrlExtracts(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  return SharedInputCallRewriter([&](const core::CallTypedExpr& call) {
+           return urlExtractPart(prefix, call);
+         })
+      .rewrite(exprs);
+}
+
+} // namespace facebook::velox::functions
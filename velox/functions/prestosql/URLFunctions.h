@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/core/Expressions.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/lib/Utf8Utils.h"
@@ -447,4 +448,15 @@ struct UrlDecodeFunction {
   }
 };
 
+/// Rewrites 'exprs' so that the url_extract functions on the same input share
+/// one parse of each URL. Calls of url_extract_protocol, url_extract_host,
+/// url_extract_port, url_extract_path, url_extract_query, url_extract_fragment
+/// and url_extract_parameter with a constant parameter name are replaced by
+/// field accesses into one call of $internal$url_extract_multi. Returns
+/// 'exprs' if no calls share an input. 'prefix' is the prefix the URL
+/// functions are registered with.
+std::vector<core::TypedExprPtr> rewriteUrlExtracts(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
 } // namespace facebook::velox::functions
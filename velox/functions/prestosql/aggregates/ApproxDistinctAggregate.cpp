@@ -95,6 +95,19 @@ struct HllAccumulator {
     }
   }
 
+  /// Same as append() for values with 'numHashes' 'hashes'.
+  void appendHashes(const uint64_t* hashes, int32_t numHashes) {
+    int32_t i = 0;
+    for (; isSparse_ && i < numHashes; ++i) {
+      if (sparseHll_.insertHash(hashes[i])) {
+        toDense();
+      }
+    }
+    if (i < numHashes) {
+      denseHll_.insertHashes(hashes + i, numHashes - i);
+    }
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -341,17 +354,42 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
-      rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
+      auto accumulator = value<HllAccumulator<T, HllAsFinalResult>>(group);
+      if constexpr (std::is_same_v<T, bool> && !HllAsFinalResult) {
+        rows.applyToSelected([&](auto row) {
+          if (decodedValue_.isNullAt(row)) {
+            return;
+          }
+          clearNull(group);
+          accumulator->setIndexBitLength(indexBitLength_);
+          accumulator->append(decodedValue_.valueAt<T>(row));
+        });
+      } else {
+        // Hashes the values in batches and inserts each batch at once.
+        constexpr int32_t kBatchSize = 64;
+        uint64_t hashes[kBatchSize];
+        int32_t numHashes = 0;
+        bool hasValues = false;
+        rows.applyToSelected([&](auto row) {
+          if (decodedValue_.isNullAt(row)) {
+            return;
+          }
+          if (!hasValues) {
+            hasValues = true;
+            clearNull(group);
+            accumulator->setIndexBitLength(indexBitLength_);
+          }
+          hashes[numHashes++] =
+              hashOne<T, HllAsFinalResult>(decodedValue_.valueAt<T>(row));
+          if (numHashes == kBatchSize) {
+            accumulator->appendHashes(hashes, numHashes);
+            numHashes = 0;
+          }
+        });
+        if (numHashes > 0) {
+          accumulator->appendHashes(hashes, numHashes);
         }
-
-        auto accumulator = value<HllAccumulator<T, HllAsFinalResult>>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-
-        accumulator->append(decodedValue_.valueAt<T>(row));
-      });
+      }
     }
   }
 
@@ -115,6 +115,10 @@ struct KllSketchAccumulator {
     }
   }
 
+  void append(const folly::Range<const T*>& values) {
+    sketch_.insert(values);
+  }
+
   void append(const KllView<T>& view) {
     sketch_.mergeViews(folly::Range(&view, 1));
   }
@@ -457,20 +461,22 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         checkWeight(weight);
         accumulator->append(value, weight, allocator_, fixedRandomSeed_);
       });
+    } else if (
+        decodedValue_.isIdentityMapping() && !decodedValue_.mayHaveNulls() &&
+        rows.isAllSelected()) {
+      accumulator->append(
+          folly::Range<const T*>(decodedValue_.data<T>(), rows.size()));
     } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      }
+      // Gathers the values so that the sketch inserts them as one batch.
+      rawValues_.clear();
+      rawValues_.reserve(rows.countSelected());
+      rows.applyToSelected([&](auto row) {
+        if (!decodedValue_.isNullAt(row)) {
+          rawValues_.push_back(decodedValue_.valueAt<T>(row));
+        }
+      });
+      accumulator->append(
+          folly::Range<const T*>(rawValues_.data(), rawValues_.size()));
     }
   }
 
@@ -696,6 +702,8 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedWeight_;
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
+  // Values of the selected non-null rows in addSingleGroupRawInput.
+  std::vector<T> rawValues_;
 
  private:
   template <bool kSingleGroup, bool checkIntermediateInputs>
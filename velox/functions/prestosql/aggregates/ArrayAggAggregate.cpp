@@ -16,6 +16,7 @@
 #include "velox/functions/prestosql/aggregates/ArrayAggAggregate.h"
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/expression/FunctionSignature.h"
+#include "velox/functions/lib/aggregates/RetainedInput.h"
 #include "velox/functions/lib/aggregates/ValueList.h"
 #include "velox/functions/prestosql/aggregates/AggregateNames.h"
 
@@ -23,6 +24,16 @@ namespace facebook::velox::aggregate::prestosql {
 namespace {
 
 struct ArrayAccumulator {
+  explicit ArrayAccumulator(HashStringAllocator* allocator)
+      : inputRefs(StlAllocator<RetainedRowRef>(allocator)) {}
+
+  vector_size_t size() const {
+    return inputRefs.size() + elements.size();
+  }
+
+  // References to retained input rows. These precede 'elements' since input
+  // is copied only once retention stops.
+  RetainedRowRefs inputRefs;
   ValueList elements;
 };
 
@@ -43,6 +54,14 @@ class ArrayAggAggregate : public exec::Aggregate {
     return true;
   }
 
+  bool supportsInputRetention() const override {
+    return true;
+  }
+
+  void enableInputRetention(uint64_t maxBytes) override {
+    retainedInput_.enable(maxBytes);
+  }
+
   void toIntermediate(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -104,21 +123,25 @@ class ArrayAggAggregate : public exec::Aggregate {
     uint64_t* rawNulls = getRawNulls(vector);
     vector_size_t offset = 0;
     for (int32_t i = 0; i < numGroups; ++i) {
-      auto& values = value<ArrayAccumulator>(groups[i])->elements;
-      auto arraySize = values.size();
+      auto* accumulator = value<ArrayAccumulator>(groups[i]);
+      auto arraySize = accumulator->size();
       if (arraySize) {
         clearNull(rawNulls, i);
 
+        for (const auto& ref : accumulator->inputRefs) {
+          retainedInput_.addCopy(ref, offset++);
+        }
+        auto& values = accumulator->elements;
         ValueListReader reader(values);
-        for (auto index = 0; index < arraySize; ++index) {
-          reader.next(*elements, offset + index);
+        for (auto index = 0; index < values.size(); ++index) {
+          reader.next(*elements, offset++);
         }
-        vector->setOffsetAndSize(i, offset, arraySize);
-        offset += arraySize;
+        vector->setOffsetAndSize(i, offset - arraySize, arraySize);
       } else {
         vector->setNull(i, true);
       }
     }
+    retainedInput_.gather(*elements);
   }
 
   void extractAccumulators(char** groups, int32_t numGroups, VectorPtr* result)
@@ -132,14 +155,19 @@ class ArrayAggAggregate : public exec::Aggregate {
       const std::vector<VectorPtr>& args,
       bool /*mayPushdown*/) override {
     decodedElements_.decode(*args[0], rows);
+    const auto retained = retain(args[0]);
     rows.applyToSelected([&](vector_size_t row) {
       if (ignoreNulls_ && decodedElements_.isNullAt(row)) {
         return;
       }
       auto group = groups[row];
       auto tracker = trackRowSize(group);
-      value<ArrayAccumulator>(group)->elements.appendValue(
-          decodedElements_, row, allocator_);
+      auto* accumulator = value<ArrayAccumulator>(group);
+      if (retained >= 0) {
+        retainedInput_.addRef(retained, row, accumulator->inputRefs);
+      } else {
+        accumulator->elements.appendValue(decodedElements_, row, allocator_);
+      }
     });
   }
 
@@ -171,15 +199,20 @@ class ArrayAggAggregate : public exec::Aggregate {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool /* mayPushdown */) override {
-    auto& values = value<ArrayAccumulator>(group)->elements;
+    auto* accumulator = value<ArrayAccumulator>(group);
 
     decodedElements_.decode(*args[0], rows);
+    const auto retained = retain(args[0]);
     auto tracker = trackRowSize(group);
     rows.applyToSelected([&](vector_size_t row) {
       if (ignoreNulls_ && decodedElements_.isNullAt(row)) {
         return;
       }
-      values.appendValue(decodedElements_, row, allocator_);
+      if (retained >= 0) {
+        retainedInput_.addRef(retained, row, accumulator->inputRefs);
+      } else {
+        accumulator->elements.appendValue(decodedElements_, row, allocator_);
+      }
     });
   }
 
@@ -210,14 +243,16 @@ class ArrayAggAggregate : public exec::Aggregate {
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
     for (auto index : indices) {
-      new (groups[index] + offset_) ArrayAccumulator();
+      new (groups[index] + offset_) ArrayAccumulator(allocator_);
     }
   }
 
   void destroyInternal(folly::Range<char**> groups) override {
     for (auto group : groups) {
       if (isInitialized(group)) {
-        value<ArrayAccumulator>(group)->elements.free(allocator_);
+        auto* accumulator = value<ArrayAccumulator>(group);
+        retainedInput_.free(accumulator->inputRefs);
+        accumulator->elements.free(allocator_);
       }
     }
   }
@@ -226,13 +261,24 @@ class ArrayAggAggregate : public exec::Aggregate {
   vector_size_t countElements(char** groups, int32_t numGroups) const {
     vector_size_t size = 0;
     for (int32_t i = 0; i < numGroups; ++i) {
-      size += value<ArrayAccumulator>(groups[i])->elements.size();
+      size += value<ArrayAccumulator>(groups[i])->size();
     }
     return size;
   }
 
+  // Returns the index of the retained 'input' or -1 if the values of 'input'
+  // must be copied.
+  int32_t retain(const VectorPtr& input) {
+    if (!retainedInput_.enabled()) {
+      return -1;
+    }
+    return retainedInput_.retain(BaseVector::loadedVectorShared(input));
+  }
+
   // A boolean representing whether to ignore nulls when aggregating inputs.
   const bool ignoreNulls_;
+  // Raw input vectors referenced from the accumulators.
+  RetainedInput retainedInput_;
   // Reusable instance of DecodedVector for decoding input vectors.
   DecodedVector decodedElements_;
   DecodedVector decodedIntermediate_;
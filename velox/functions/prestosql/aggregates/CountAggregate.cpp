@@ -15,6 +15,7 @@
  */
 #include "velox/functions/prestosql/aggregates/CountAggregate.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/Nulls.h"
 #include "velox/expression/FunctionSignature.h"
 #include "velox/functions/lib/aggregates/SumAggregateBase.h"
 #include "velox/functions/prestosql/aggregates/AggregateNames.h"
@@ -35,6 +36,10 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     return sizeof(int64_t);
   }
 
+  bool supportsSegmentTree() const override {
+    return true;
+  }
+
   void extractValues(char** groups, int32_t numGroups, VectorPtr* result)
       override {
     BaseAggregate::doExtractValues(groups, numGroups, result, [&](char* group) {
@@ -46,12 +51,19 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       char** groups,
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
-      bool /*mayPushdown*/) override {
+      bool mayPushdown) override {
     if (args.empty()) {
       rows.applyToSelected([&](vector_size_t i) { addToGroup(groups[i], 1); });
       return;
     }
 
+    if (mayPushdown && args[0]->isLazy() &&
+        supportsPushdown(args[0]->type())) {
+      BaseAggregate::pushdown<velox::aggregate::CountHook>(
+          groups, rows, args[0]);
+      return;
+    }
+
     DecodedVector decoded(*args[0], rows);
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
@@ -70,6 +82,40 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     }
   }
 
+  bool supportsColumnarAccumulators() const override {
+    return true;
+  }
+
+  void addRawInputColumnar(
+      char** groups,
+      const uint64_t* slots,
+      int32_t numSlots,
+      folly::Range<const vector_size_t*> firstRows,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    auto* counts = gatherColumnar(groups, slots, numSlots, firstRows);
+    if (args.empty()) {
+      rows.applyToSelected([&](vector_size_t i) { ++counts[slots[i]]; });
+    } else {
+      DecodedVector decoded(*args[0], rows);
+      if (decoded.isConstantMapping()) {
+        if (!decoded.isNullAt(0)) {
+          rows.applyToSelected([&](vector_size_t i) { ++counts[slots[i]]; });
+        }
+      } else if (decoded.mayHaveNulls()) {
+        rows.applyToSelected([&](vector_size_t i) {
+          if (!decoded.isNullAt(i)) {
+            ++counts[slots[i]];
+          }
+        });
+      } else {
+        rows.applyToSelected([&](vector_size_t i) { ++counts[slots[i]]; });
+      }
+    }
+    // Counts are never null, so this only stores them back.
+    scatterColumnar(groups, slots, firstRows);
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -85,12 +131,19 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       char* group,
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
-      bool /*mayPushdown*/) override {
+      bool mayPushdown) override {
     if (args.empty()) {
       addToGroup(group, rows.countSelected());
       return;
     }
 
+    if (mayPushdown && args[0]->isLazy() &&
+        supportsPushdown(args[0]->type())) {
+      BaseAggregate::pushdownOneGroup<velox::aggregate::CountHook>(
+          group, rows, args[0]);
+      return;
+    }
+
     DecodedVector decoded(*args[0], rows);
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
@@ -98,11 +151,17 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       }
     } else if (decoded.mayHaveNulls()) {
       int64_t nonNullCount = 0;
-      rows.applyToSelected([&](vector_size_t i) {
-        if (!decoded.isNullAt(i)) {
-          ++nonNullCount;
-        }
-      });
+      if (rows.isAllSelected()) {
+        // Counts the set bits of the nulls a word at a time.
+        nonNullCount = bits::countNonNulls(
+            decoded.nulls(&rows), rows.begin(), rows.end());
+      } else {
+        rows.applyToSelected([&](vector_size_t i) {
+          if (!decoded.isNullAt(i)) {
+            ++nonNullCount;
+          }
+        });
+      }
       addToGroup(group, nonNullCount);
     } else {
       addToGroup(group, rows.countSelected());
@@ -143,6 +202,25 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
   }
 
  private:
+  // Returns true if the column readers call value hooks for 'type'. They do
+  // not for timestamps, decimals and complex types.
+  static bool supportsPushdown(const TypePtr& type) {
+    switch (type->kind()) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        return !type->isDecimal();
+      default:
+        return false;
+    }
+  }
+
   inline void addToGroup(char* group, int64_t count) {
     *value<int64_t>(group) += count;
   }
@@ -13,12 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include "folly/container/F14Map.h"
-
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/AddressableNonNullValueList.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/exec/SmallHashMap.h"
 #include "velox/exec/Strings.h"
 #include "velox/functions/prestosql/aggregates/AggregateNames.h"
 #include "velox/functions/prestosql/aggregates/HistogramAggregate.h"
@@ -33,25 +32,15 @@ template <
     typename Hash = std::hash<T>,
     typename EqualTo = std::equal_to<T>>
 struct Accumulator {
-  using ValueMap = folly::F14FastMap<
-      T,
-      int64_t,
-      Hash,
-      EqualTo,
-      AlignedStlAllocator<std::pair<const T, int64_t>, 16>>;
+  using ValueMap = SmallHashMap<T, int64_t, Hash, EqualTo>;
 
   ValueMap values;
 
   Accumulator(const TypePtr& /*type*/, HashStringAllocator* allocator)
-      : values{
-            AlignedStlAllocator<std::pair<const T, int64_t>, 16>(allocator)} {}
+      : values{allocator} {}
 
   Accumulator(Hash hash, EqualTo equalTo, HashStringAllocator* allocator)
-      : values{
-            0,
-            hash,
-            equalTo,
-            AlignedStlAllocator<std::pair<const T, int64_t>, 16>(allocator)} {}
+      : values{allocator, hash, equalTo} {}
 
   size_t size() const {
     return values.size();
@@ -18,7 +18,9 @@
 #include <folly/container/F14Map.h>
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/AddressableNonNullValueList.h"
+#include "velox/exec/SmallHashMap.h"
 #include "velox/exec/Strings.h"
+#include "velox/functions/lib/aggregates/RetainedInput.h"
 #include "velox/functions/lib/aggregates/ValueList.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DecodedVector.h"
@@ -33,25 +35,20 @@ template <
     typename Hash = std::hash<T>,
     typename EqualTo = std::equal_to<T>>
 struct MapAccumulator {
-  // Value is the index of the corresponding entry in 'values'.
-  folly::F14FastMap<
-      T,
-      int32_t,
-      Hash,
-      EqualTo,
-      AlignedStlAllocator<std::pair<const T, int32_t>, 16>>
-      keys;
+  // Value is the index of the corresponding value. The first values are
+  // referenced from 'valueRefs', the rest are in 'values'.
+  SmallHashMap<T, int32_t, Hash, EqualTo> keys;
+  // References to values in retained input. See insertRef().
+  RetainedRowRefs valueRefs;
   ValueList values;
 
   MapAccumulator(const TypePtr& /*type*/, HashStringAllocator* allocator)
-      : keys{AlignedStlAllocator<std::pair<const T, int32_t>, 16>(allocator)} {}
+      : keys{allocator},
+        valueRefs{StlAllocator<RetainedRowRef>(allocator)} {}
 
   MapAccumulator(Hash hash, EqualTo equalTo, HashStringAllocator* allocator)
-      : keys{
-            0,
-            hash,
-            equalTo,
-            AlignedStlAllocator<std::pair<const T, int32_t>, 16>(allocator)} {}
+      : keys{allocator, hash, equalTo},
+        valueRefs{StlAllocator<RetainedRowRef>(allocator)} {}
 
   /// Adds key-value pair if entry with that key doesn't exist yet.
   void insert(
@@ -66,15 +63,34 @@ struct MapAccumulator {
     }
   }
 
+  /// Like insert() but references the value at 'index' of retained input
+  /// vector 'vector' instead of copying it. Must not be called after insert().
+  void insertRef(
+      const DecodedVector& decodedKeys,
+      vector_size_t index,
+      int32_t vector,
+      RetainedInput& retainedInput,
+      HashStringAllocator& /*allocator*/) {
+    VELOX_DCHECK_EQ(values.size(), 0);
+    auto cnt = keys.size();
+    if (keys.insert({decodedKeys.valueAt<T>(index), cnt}).second) {
+      retainedInput.addRef(vector, index, valueRefs);
+    }
+  }
+
   /// Returns number of key-value pairs.
   size_t size() const {
     return keys.size();
   }
 
+  /// Extracts the keys and values to 'mapKeys' and 'mapValues' starting at
+  /// 'offset'. Referenced values are scheduled for copy in 'retainedInput' and
+  /// arrive at the next RetainedInput::gather().
   void extract(
       const VectorPtr& mapKeys,
       const VectorPtr& mapValues,
-      vector_size_t offset) {
+      vector_size_t offset,
+      RetainedInput* retainedInput = nullptr) {
     const auto mapSize = keys.size();
 
     // Align keys and values as the order of keys in 'keys' may not match the
@@ -90,22 +106,35 @@ struct MapAccumulator {
       ++index;
     }
 
-    extractValues(mapValues, offset, mapSize, indices);
+    extractValues(mapValues, offset, mapSize, indices, retainedInput);
   }
 
   void extractValues(
       const VectorPtr& mapValues,
       vector_size_t offset,
       int32_t mapSize,
-      const folly::F14FastMap<int32_t, int32_t>& indices) {
+      const folly::F14FastMap<int32_t, int32_t>& indices,
+      RetainedInput* retainedInput = nullptr) {
+    const int32_t numRefs = valueRefs.size();
+    VELOX_DCHECK(numRefs == 0 || retainedInput != nullptr);
+    for (auto index = 0; index < numRefs; ++index) {
+      retainedInput->addCopy(valueRefs[index], offset + indices.at(index));
+    }
     ValueListReader valuesReader(values);
-    for (auto index = 0; index < mapSize; ++index) {
+    for (auto index = numRefs; index < mapSize; ++index) {
       valuesReader.next(*mapValues, offset + indices.at(index));
     }
   }
 
-  void free(HashStringAllocator& allocator) {
+  void free(
+      HashStringAllocator& allocator,
+      RetainedInput* retainedInput = nullptr) {
     std::destroy_at(&keys);
+    if (retainedInput) {
+      retainedInput->free(valueRefs);
+    } else {
+      std::destroy_at(&valueRefs);
+    }
     values.free(&allocator);
   }
 };
@@ -140,6 +169,26 @@ struct StringViewMapAccumulator {
     }
   }
 
+  void insertRef(
+      const DecodedVector& decodedKeys,
+      vector_size_t index,
+      int32_t vector,
+      RetainedInput& retainedInput,
+      HashStringAllocator& allocator) {
+    auto key = decodedKeys.valueAt<StringView>(index);
+    if (!key.isInline()) {
+      if (base.keys.contains(key)) {
+        return;
+      }
+      key = strings.append(key, allocator);
+    }
+
+    auto cnt = base.keys.size();
+    if (base.keys.insert({key, cnt}).second) {
+      retainedInput.addRef(vector, index, base.valueRefs);
+    }
+  }
+
   size_t size() const {
     return base.size();
   }
@@ -147,13 +196,16 @@ struct StringViewMapAccumulator {
   void extract(
       const VectorPtr& mapKeys,
       const VectorPtr& mapValues,
-      vector_size_t offset) {
-    base.extract(mapKeys, mapValues, offset);
+      vector_size_t offset,
+      RetainedInput* retainedInput = nullptr) {
+    base.extract(mapKeys, mapValues, offset, retainedInput);
   }
 
-  void free(HashStringAllocator& allocator) {
+  void free(
+      HashStringAllocator& allocator,
+      RetainedInput* retainedInput = nullptr) {
     strings.free(allocator);
-    base.free(allocator);
+    base.free(allocator, retainedInput);
   }
 };
 
@@ -191,6 +243,23 @@ struct ComplexTypeMapAccumulator {
     base.values.appendValue(decodedValues, index, &allocator);
   }
 
+  void insertRef(
+      const DecodedVector& decodedKeys,
+      vector_size_t index,
+      int32_t vector,
+      RetainedInput& retainedInput,
+      HashStringAllocator& allocator) {
+    auto entry = serializedKeys.append(decodedKeys, index, &allocator);
+
+    auto cnt = base.keys.size();
+    if (!base.keys.insert({entry, cnt}).second) {
+      serializedKeys.removeLast(entry);
+      return;
+    }
+
+    retainedInput.addRef(vector, index, base.valueRefs);
+  }
+
   size_t size() const {
     return base.size();
   }
@@ -198,7 +267,8 @@ struct ComplexTypeMapAccumulator {
   void extract(
       const VectorPtr& mapKeys,
       const VectorPtr& mapValues,
-      vector_size_t offset) {
+      vector_size_t offset,
+      RetainedInput* retainedInput = nullptr) {
     const auto mapSize = base.keys.size();
 
     folly::F14FastMap<int32_t, int32_t> indices;
@@ -211,12 +281,14 @@ struct ComplexTypeMapAccumulator {
       ++index;
     }
 
-    base.extractValues(mapValues, offset, mapSize, indices);
+    base.extractValues(mapValues, offset, mapSize, indices, retainedInput);
   }
 
-  void free(HashStringAllocator& allocator) {
+  void free(
+      HashStringAllocator& allocator,
+      RetainedInput* retainedInput = nullptr) {
     serializedKeys.free(allocator);
-    base.free(allocator);
+    base.free(allocator, retainedInput);
   }
 };
 
@@ -303,6 +375,15 @@ struct CustomComparisonMapAccumulator {
     return base.insert(decodedKeys, decodedValues, index, allocator);
   }
 
+  void insertRef(
+      const DecodedVector& decodedKeys,
+      vector_size_t index,
+      int32_t vector,
+      RetainedInput& retainedInput,
+      HashStringAllocator& allocator) {
+    base.insertRef(decodedKeys, index, vector, retainedInput, allocator);
+  }
+
   /// Returns number of key-value pairs.
   size_t size() const {
     return base.size();
@@ -311,20 +392,24 @@ struct CustomComparisonMapAccumulator {
   void extract(
       const VectorPtr& mapKeys,
       const VectorPtr& mapValues,
-      vector_size_t offset) {
-    base.extract(mapKeys, mapValues, offset);
+      vector_size_t offset,
+      RetainedInput* retainedInput = nullptr) {
+    base.extract(mapKeys, mapValues, offset, retainedInput);
   }
 
   void extractValues(
       const VectorPtr& mapValues,
       vector_size_t offset,
       int32_t mapSize,
-      const folly::F14FastMap<int32_t, int32_t>& indices) {
-    base.extractValues(mapValues, offset, mapSize, indices);
+      const folly::F14FastMap<int32_t, int32_t>& indices,
+      RetainedInput* retainedInput = nullptr) {
+    base.extractValues(mapValues, offset, mapSize, indices, retainedInput);
   }
 
-  void free(HashStringAllocator& allocator) {
-    base.free(allocator);
+  void free(
+      HashStringAllocator& allocator,
+      RetainedInput* retainedInput = nullptr) {
+    base.free(allocator, retainedInput);
   }
 };
 
@@ -35,6 +35,14 @@ class MapAggAggregate : public MapAggregateBase<K, AccumulatorType> {
     return true;
   }
 
+  bool supportsInputRetention() const override {
+    return true;
+  }
+
+  void enableInputRetention(uint64_t maxBytes) override {
+    Base::retainedInput_.enable(maxBytes);
+  }
+
   void toIntermediate(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -102,6 +110,7 @@ class MapAggAggregate : public MapAggregateBase<K, AccumulatorType> {
     Base::decodedKeys_.decode(*args[0], rows);
     Base::decodedValues_.decode(*args[1], rows);
     const auto* indices = Base::decodedKeys_.indices();
+    const auto retained = retainValues(args[1]);
 
     rows.applyToSelected([&](vector_size_t row) {
       if (velox::functions::checkNestedNulls(
@@ -112,8 +121,7 @@ class MapAggAggregate : public MapAggregateBase<K, AccumulatorType> {
       auto group = groups[row];
       Base::clearNull(group);
       auto tracker = Base::trackRowSize(group);
-      Base::accumulator(group)->insert(
-          Base::decodedKeys_, Base::decodedValues_, row, *Base::allocator_);
+      insert(Base::accumulator(group), row, retained);
     });
   }
 
@@ -127,6 +135,7 @@ class MapAggAggregate : public MapAggregateBase<K, AccumulatorType> {
     Base::decodedKeys_.decode(*args[0], rows);
     Base::decodedValues_.decode(*args[1], rows);
     auto indices = Base::decodedKeys_.indices();
+    const auto retained = retainValues(args[1]);
 
     auto tracker = Base::trackRowSize(group);
     rows.applyToSelected([&](vector_size_t row) {
@@ -136,12 +145,37 @@ class MapAggAggregate : public MapAggregateBase<K, AccumulatorType> {
       }
 
       Base::clearNull(group);
-      singleAccumulator->insert(
-          Base::decodedKeys_, Base::decodedValues_, row, *Base::allocator_);
+      insert(singleAccumulator, row, retained);
     });
   }
 
  private:
+  // Returns the index of the retained 'values' or -1 if the values must be
+  // copied.
+  int32_t retainValues(const VectorPtr& values) {
+    if (!Base::retainedInput_.enabled()) {
+      return -1;
+    }
+    return Base::retainedInput_.retain(BaseVector::loadedVectorShared(values));
+  }
+
+  // Adds the entry at 'row' to 'accumulator', referencing the value in
+  // retained vector 'retained' unless this is -1.
+  void
+  insert(AccumulatorType* accumulator, vector_size_t row, int32_t retained) {
+    if (retained >= 0) {
+      accumulator->insertRef(
+          Base::decodedKeys_,
+          row,
+          retained,
+          Base::retainedInput_,
+          *Base::allocator_);
+    } else {
+      accumulator->insert(
+          Base::decodedKeys_, Base::decodedValues_, row, *Base::allocator_);
+    }
+  }
+
   const bool throwOnNestedNulls_;
 };
 
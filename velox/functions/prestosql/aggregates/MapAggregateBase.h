@@ -63,13 +63,14 @@ class MapAggregateBase : public exec::Aggregate {
       auto accumulator = value<AccumulatorType>(group);
       auto mapSize = accumulator->size();
       if (mapSize) {
-        accumulator->extract(mapKeys, mapValues, offset);
+        accumulator->extract(mapKeys, mapValues, offset, &retainedInput_);
         mapVector->setOffsetAndSize(i, offset, mapSize);
         offset += mapSize;
       } else {
         mapVector->setOffsetAndSize(i, 0, 0);
       }
     }
+    retainedInput_.gather(*mapValues);
   }
 
   void extractAccumulators(char** groups, int32_t numGroups, VectorPtr* result)
@@ -106,7 +107,7 @@ class MapAggregateBase : public exec::Aggregate {
     for (auto group : groups) {
       if (isInitialized(group)) {
         auto accumulator = value<AccumulatorType>(group);
-        accumulator->free(*allocator_);
+        accumulator->free(*allocator_, &retainedInput_);
       }
     }
   }
@@ -198,6 +199,10 @@ class MapAggregateBase : public exec::Aggregate {
   DecodedVector decodedKeys_;
   DecodedVector decodedValues_;
   DecodedVector decodedMaps_;
+
+  // Raw input values referenced from the accumulators. Used by subclasses
+  // that support Aggregate::enableInputRetention().
+  RetainedInput retainedInput_;
 };
 
 template <template <typename K, typename Accumulator = MapAccumulator<K>>
@@ -224,11 +224,15 @@ class VarianceAggregate : public exec::Aggregate {
         updateNonNullValue(group, accData);
       }
     } else if (decodedRaw_.mayHaveNulls()) {
+      VarianceAccumulator accData;
       rows.applyToSelected([&](vector_size_t i) {
         if (!decodedRaw_.isNullAt(i)) {
-          updateNonNullValue(group, decodedRaw_.valueAt<T>(i));
+          accData.update(decodedRaw_.valueAt<T>(i));
         }
       });
+      if (accData.count() > 0) {
+        updateNonNullValue(group, accData);
+      }
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const T* data = decodedRaw_.data<T>();
       VarianceAccumulator accData;
@@ -130,6 +130,57 @@ TEST_F(ArrayAggTest, groupBy) {
   testFunction("simple_array_agg", false);
 }
 
+TEST_F(ArrayAggTest, inputRetention) {
+  // Strings are not inlined, so that retained and copied values differ in
+  // where the bytes live.
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 4; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int32_t>(100, [](auto row) { return row % 7; }),
+        makeFlatVector<std::string>(
+            100,
+            [i](auto row) {
+              return fmt::format("batch {} row {} with a long value", i, row);
+            },
+            [](auto row) { return row % 11 == 0; }),
+        makeArrayVectorFromJson<int64_t>(
+            std::vector<std::string>(100, "[1, null, 3]")),
+    }));
+  }
+
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .singleAggregation({"c0"}, {"array_agg(c1)", "array_agg(c2)"})
+                  .orderBy({"c0"}, false)
+                  .planNode();
+  auto runWithLimit = [&](uint64_t maxBytes) {
+    return AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kAggregationInputRetentionMaxBytes,
+            std::to_string(maxBytes))
+        .copyResults(pool());
+  };
+
+  // The result, including the order of elements, does not depend on whether
+  // all, some or none of the input is retained.
+  auto expected = runWithLimit(0);
+  const auto batchBytes = batches[0]->childAt(1)->retainedSize();
+  for (uint64_t maxBytes :
+       {uint64_t{1}, 2 * batchBytes + 1, uint64_t{1} << 30}) {
+    SCOPED_TRACE(fmt::format("maxBytes: {}", maxBytes));
+    test::assertEqualVectors(expected, runWithLimit(maxBytes));
+  }
+
+  createDuckDbTable(batches);
+  testAggregations(
+      batches,
+      {"c0"},
+      {"array_agg(c1)"},
+      {"c0", "array_sort(a0)"},
+      "SELECT c0, array_sort(array_agg(c1)) FROM tmp GROUP BY c0",
+      {{core::QueryConfig::kAggregationInputRetentionMaxBytes, "1000000"}});
+}
+
 TEST_F(ArrayAggTest, sortGroupByWithAllNullsByMask) {
   auto data = makeRowVector(
       {makeNullableFlatVector<int16_t>(
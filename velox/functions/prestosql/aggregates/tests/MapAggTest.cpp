@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/functions/lib/aggregates/tests/utils/AggregationTestBase.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 
@@ -147,6 +148,45 @@ TEST_F(MapAggTest, groupByWithDuplicates) {
   testAggregations(vectors, {"c0"}, {"map_agg(c1, c2)"}, {expectedResult});
 }
 
+TEST_F(MapAggTest, inputRetention) {
+  // Keys repeat within and across batches. The first value for each key wins
+  // whether values are retained or copied.
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 4; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int32_t>(100, [](auto row) { return row % 7; }),
+        makeFlatVector<int32_t>(100, [i](auto row) { return (row + i) % 13; }),
+        makeFlatVector<std::string>(
+            100,
+            [i](auto row) {
+              return fmt::format("batch {} row {} with a long value", i, row);
+            },
+            [](auto row) { return row % 11 == 0; }),
+    }));
+  }
+
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .singleAggregation({"c0"}, {"map_agg(c1, c2)"})
+                  .orderBy({"c0"}, false)
+                  .planNode();
+  auto runWithLimit = [&](uint64_t maxBytes) {
+    return AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kAggregationInputRetentionMaxBytes,
+            std::to_string(maxBytes))
+        .copyResults(pool());
+  };
+
+  auto expected = runWithLimit(0);
+  const auto batchBytes = batches[0]->childAt(2)->retainedSize();
+  for (uint64_t maxBytes :
+       {uint64_t{1}, 2 * batchBytes + 1, uint64_t{1} << 30}) {
+    SCOPED_TRACE(fmt::format("maxBytes: {}", maxBytes));
+    test::assertEqualVectors(expected, runWithLimit(maxBytes));
+  }
+}
+
 TEST_F(MapAggTest, groupByNoData) {
   auto data = makeRowVector(
       {makeFlatVector<int32_t>({}),
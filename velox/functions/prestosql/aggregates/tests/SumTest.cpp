@@ -417,6 +417,79 @@ TEST_F(SumTest, nulls) {
       "SELECT c0, sum(c1) as sum_c1 FROM tmp GROUP BY 1");
 }
 
+/// Test global aggregations over inputs with and without nulls, with and
+/// without masks, which fold the rows into a local accumulator before
+/// updating the single group.
+TEST_F(SumTest, globalNulls) {
+  vector_size_t size = 1'000;
+
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+         makeFlatVector<int64_t>(
+             size, [](auto row) { return row % 101; }, nullEvery(7)),
+         makeFlatVector<bool>(size, [](auto row) { return row % 3 == 0; })}));
+  }
+
+  createDuckDbTable(vectors);
+
+  testAggregations(
+      vectors,
+      {},
+      {"sum(c0)",
+       "sum(c1)",
+       "min(c1)",
+       "max(c1)",
+       "count(c1)",
+       "avg(c1)",
+       "var_samp(c1)"},
+      "SELECT sum(c0), sum(c1), min(c1), max(c1), count(c1), avg(c1), "
+      "var_samp(c1) FROM tmp");
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation(
+                      {},
+                      {"sum(c0)", "sum(c1)", "max(c1)", "count(c1)"},
+                      {"c2", "c2", "c2", "c2"})
+                  .finalAggregation()
+                  .planNode();
+  assertQuery(
+      plan,
+      "SELECT sum(c0) filter (where c2), sum(c1) filter (where c2), "
+      "max(c1) filter (where c2), count(c1) filter (where c2) FROM tmp");
+}
+
+/// Test input clustered on the grouping key, where consecutive rows update the
+/// same group, with runs of a group interrupted by other groups.
+TEST_F(SumTest, clusteredKeys) {
+  vector_size_t size = 10'000;
+
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int32_t>(size, [](auto row) { return row / 100; }),
+         makeFlatVector<int32_t>(size, [](auto row) { return row / 10 % 7; }),
+         makeFlatVector<int64_t>(
+             size, [&](auto row) { return row * (i + 1); }, nullEvery(7)),
+         makeConstant<int64_t>(i, size)}));
+  }
+
+  createDuckDbTable(vectors);
+
+  testAggregations(
+      vectors,
+      {"c0"},
+      {"sum(c2)", "min(c2)", "max(c2)", "sum(c3)"},
+      "SELECT c0, sum(c2), min(c2), max(c2), sum(c3) FROM tmp GROUP BY 1");
+  testAggregations(
+      vectors,
+      {"c1"},
+      {"sum(c2)", "min(c2)", "max(c2)", "sum(c3)"},
+      "SELECT c1, sum(c2), min(c2), max(c2), sum(c3) FROM tmp GROUP BY 1");
+}
+
 TEST_F(SumTest, hook) {
   SumRow<int64_t> sumRow;
   sumRow.nulls = 1;
@@ -68,6 +68,15 @@ class SIMDJsonExtractor {
       TConsumer& consumer,
       bool& isDefinitePath);
 
+  /// Same as above but extracts from an already parsed 'jsonDoc'. The document
+  /// is walked from its current position, so callers extracting several paths
+  /// from one document must rewind() it between calls.
+  template <typename TConsumer>
+  simdjson::error_code extract(
+      simdjson::ondemand::document& jsonDoc,
+      TConsumer& consumer,
+      bool& isDefinitePath);
+
   /// Returns true if this extractor was initialized with the trivial path "$".
   bool isRootOnlyPath() {
     return tokens_.empty();
@@ -127,6 +136,14 @@ simdjson::error_code SIMDJsonExtractor::extract(
     TConsumer& consumer,
     bool& isDefinitePath) {
   SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
+  return extract(jsonDoc, consumer, isDefinitePath);
+}
+
+template <typename TConsumer>
+simdjson::error_code SIMDJsonExtractor::extract(
+    simdjson::ondemand::document& jsonDoc,
+    TConsumer& consumer,
+    bool& isDefinitePath) {
   SIMDJSON_ASSIGN_OR_RAISE(auto isScalar, jsonDoc.is_scalar());
   if (isScalar) {
     // Note, we cannot convert this to a value as this is not supported if the
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/expression/VectorFunction.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/types/JsonRegistration.h"
@@ -64,6 +65,19 @@ void registerJsonFunctions(const std::string& prefix) {
   VELOX_REGISTER_VECTOR_FUNCTION(
       udf_json_extract_scalar, prefix + "json_extract_scalar");
 
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_$internal$_json_extract_multi,
+      prefix + "$internal$json_extract_multi");
+
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_$internal$_json_extract_scalar_multi,
+      prefix + "$internal$json_extract_scalar_multi");
+
+  exec::registerExpressionSetRewrite(
+      [prefix](const std::vector<core::TypedExprPtr>& exprs) {
+        return rewriteJsonExtracts(prefix, exprs);
+      });
+
   VELOX_REGISTER_VECTOR_FUNCTION(udf_json_format, prefix + "json_format");
 
   VELOX_REGISTER_VECTOR_FUNCTION(udf_json_parse, prefix + "json_parse");
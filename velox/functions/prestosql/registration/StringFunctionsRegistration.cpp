@@ -170,6 +170,11 @@ void registerStringFunctions(const std::string& prefix) {
       makeRe2ExtractAll);
   exec::registerStatefulVectorFunction(
       prefix + "regexp_like", re2SearchSignatures(), makeRe2Search);
+  exec::registerStatefulVectorFunction(
+      "$internal$regexp_like_set", re2SearchSetSignatures(), makeRe2SearchSet);
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteToRe2SearchSet(prefix, "$internal$regexp_like_set", expr);
+  });
 
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar>(
       {prefix + "strpos"});
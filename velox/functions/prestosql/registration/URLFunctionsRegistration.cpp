@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/expression/VectorFunction.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/prestosql/StringFunctions.h"
 #include "velox/functions/prestosql/URLFunctions.h"
@@ -35,6 +36,16 @@ void registerURLFunctions(const std::string& prefix) {
       {prefix + "url_extract_port"});
   registerFunction<UrlExtractQueryFunction, Varchar, Varchar>(
       {prefix + "url_extract_query"});
+
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_$internal$_url_extract_multi,
+      prefix + "$internal$url_extract_multi");
+
+  exec::registerExpressionSetRewrite(
+      [prefix](const std::vector<core::TypedExprPtr>& exprs) {
+        return rewriteUrlExtracts(prefix, exprs);
+      });
+
   registerFunction<UrlEncodeFunction, Varchar, Varchar>(
       {prefix + "url_encode"});
   registerFunction<UrlDecodeFunction, Varchar, Varchar>(
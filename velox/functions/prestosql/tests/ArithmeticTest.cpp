@@ -260,6 +260,43 @@ TEST_F(ArithmeticTest, modInt) {
   assertError<int64_t>("mod(c0, c1)", {10}, {0}, "Cannot divide by 0");
 }
 
+TEST_F(ArithmeticTest, tryCheckedArithmetic) {
+  // Checked integer arithmetic reports errors through Status. Under TRY the
+  // failing rows become null and the other rows are unaffected.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, kLongMax, kLongMin, 10, kLongMin}),
+      makeFlatVector<int64_t>({2, 1, 1, 0, -1}),
+  });
+
+  auto expected = makeNullableFlatVector<int64_t>(
+      {3, std::nullopt, kLongMin + 1, 10, std::nullopt});
+  test::assertEqualVectors(expected, evaluate("try(c0 + c1)", data));
+
+  expected = makeNullableFlatVector<int64_t>(
+      {-1, kLongMax - 1, std::nullopt, 10, kLongMin + 1});
+  test::assertEqualVectors(expected, evaluate("try(c0 - c1)", data));
+
+  expected = makeNullableFlatVector<int64_t>(
+      {2, kLongMax, kLongMin, 0, std::nullopt});
+  test::assertEqualVectors(expected, evaluate("try(c0 * c1)", data));
+
+  expected = makeNullableFlatVector<int64_t>(
+      {0, kLongMax, kLongMin, std::nullopt, std::nullopt});
+  test::assertEqualVectors(expected, evaluate("try(c0 / c1)", data));
+
+  expected = makeNullableFlatVector<int64_t>(
+      {-1, -kLongMax, std::nullopt, -10, std::nullopt});
+  test::assertEqualVectors(expected, evaluate("try(negate(c0))", data));
+
+  // Without TRY the error is raised with the same message as before.
+  VELOX_ASSERT_THROW(
+      evaluate("c0 + c1", data),
+      "integer overflow: 9223372036854775807 + 1");
+  VELOX_ASSERT_THROW(evaluate("c0 / c1", data), "division by zero");
+  VELOX_ASSERT_THROW(
+      evaluate("negate(c0)", data), "Cannot negate minimum value");
+}
+
 TEST_F(ArithmeticTest, power) {
   std::vector<double> baseDouble = {
       0, 0, 0, -1, -1, -1, -9, 9.1, 10.1, 11.1, -11.1};
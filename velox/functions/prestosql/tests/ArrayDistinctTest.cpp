@@ -207,6 +207,52 @@ TEST_F(ArrayDistinctTest, floatArrays) {
   testFloatingPoint<double>();
 }
 
+TEST_F(ArrayDistinctTest, arraySizes) {
+  // Arrays of up to 16 elements are deduplicated with a linear search, longer
+  // ones with a hash set.
+  std::vector<std::vector<std::optional<double>>> data;
+  std::vector<std::vector<std::optional<double>>> expected;
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  for (auto size = 0; size <= 40; ++size) {
+    std::vector<std::optional<double>> row;
+    std::vector<std::optional<double>> distinct;
+    bool hasNull = false;
+    bool hasNaN = false;
+    for (auto i = 0; i < size; ++i) {
+      std::optional<double> value;
+      if (i % 9 == 4) {
+        value = std::nullopt;
+      } else if (i % 6 == 5) {
+        value = nan;
+      } else {
+        value = (i * 7) % 11;
+      }
+      row.push_back(value);
+      if (!value.has_value()) {
+        if (!hasNull) {
+          distinct.push_back(value);
+        }
+        hasNull = true;
+      } else if (std::isnan(*value)) {
+        if (!hasNaN) {
+          distinct.push_back(value);
+        }
+        hasNaN = true;
+      } else if (
+          std::find(distinct.begin(), distinct.end(), value) ==
+          distinct.end()) {
+        distinct.push_back(value);
+      }
+    }
+    data.push_back(row);
+    expected.push_back(distinct);
+  }
+  testExpr(
+      makeNullableArrayVector(expected),
+      "array_distinct(C0)",
+      {makeNullableArrayVector(data)});
+}
+
 // Test inline (short) strings.
 TEST_F(ArrayDistinctTest, inlineStringArrays) {
   using S = StringView;
@@ -395,6 +395,41 @@ TEST_F(ArraySortTest, unknown) {
   assertEqualVectors(input, result);
 }
 
+TEST_F(ArraySortTest, arraySizes) {
+  // Arrays of up to 16 elements are sorted with a sorting network, longer
+  // ones with std::sort.
+  std::vector<std::vector<std::optional<int64_t>>> data;
+  std::vector<std::vector<std::optional<int64_t>>> expected;
+  for (auto size = 0; size <= 40; ++size) {
+    std::vector<int64_t> values;
+    std::vector<std::optional<int64_t>> row;
+    for (auto i = 0; i < size; ++i) {
+      if (i % 5 == 3) {
+        row.push_back(std::nullopt);
+      } else {
+        values.push_back((i * 7919) % 23 - 11);
+        row.push_back(values.back());
+      }
+    }
+    data.push_back(row);
+    std::sort(values.begin(), values.end());
+    std::vector<std::optional<int64_t>> sorted(values.begin(), values.end());
+    sorted.resize(size, std::nullopt);
+    expected.push_back(sorted);
+  }
+  auto input = makeRowVector({makeNullableArrayVector(data)});
+  assertEqualVectors(
+      makeNullableArrayVector(expected), evaluate("array_sort(c0)", input));
+
+  for (auto& row : expected) {
+    auto numNulls = std::count(row.begin(), row.end(), std::nullopt);
+    std::reverse(row.begin(), row.end() - numNulls);
+  }
+  assertEqualVectors(
+      makeNullableArrayVector(expected),
+      evaluate("array_sort_desc(c0)", input));
+}
+
 TEST_F(ArraySortTest, constant) {
   vector_size_t size = 1'000;
   auto data =
@@ -1428,6 +1428,69 @@ TEST_F(ElementAtTest, timestampWithTimeZoneWithCaching) {
   testCaching({mapOfRowKeys, lookup}, makeConstant<int32_t>(5, 1));
 }
 
+TEST_F(ElementAtTest, sharedMapKeyIndex) {
+  // Each row has keys row, row + 3, ..., row + 117 and values 10 * key + row.
+  static constexpr vector_size_t kNumKeys = 40;
+  auto map = makeMapVector<int64_t, int64_t>(
+      100,
+      [](auto /*row*/) { return kNumKeys; },
+      [](auto idx) { return idx / kNumKeys + 3 * (idx % kNumKeys); },
+      [](auto idx) {
+        auto row = idx / kNumKeys;
+        return 10 * (row + 3 * (idx % kNumKeys)) + row;
+      });
+  auto data = makeRowVector({map});
+
+  const std::vector<int64_t> keys = {0, 3, 5, 30, 60, 120, 200};
+  std::vector<std::string> expressions;
+  for (auto key : keys) {
+    expressions.push_back(fmt::format("element_at(c0, {})", key));
+    expressions.push_back(fmt::format("c0[{}]", key));
+  }
+
+  auto verify = [&](core::ExecCtx* execCtx, bool expectIndex) {
+    exec::ExprSet exprSet(
+        [&]() {
+          std::vector<core::TypedExprPtr> typedExprs;
+          for (const auto& expression : expressions) {
+            typedExprs.push_back(
+                parseExpression(expression, asRowType(data->type())));
+          }
+          return typedExprs;
+        }(),
+        execCtx);
+    exec::EvalCtx context(execCtx, &exprSet, data.get());
+    SelectivityVector rows(data->size());
+    std::vector<VectorPtr> results(expressions.size());
+    exprSet.eval(rows, context, results);
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+      auto key = keys[i];
+      auto expected = makeFlatVector<int64_t>(
+          data->size(),
+          [&](auto row) { return 10 * key + row; },
+          [&](auto row) {
+            return key < row || (key - row) % 3 != 0 ||
+                (key - row) / 3 >= kNumKeys;
+          });
+      test::assertEqualVectors(expected, results[2 * i]);
+      test::assertEqualVectors(expected, results[2 * i + 1]);
+    }
+    EXPECT_EQ(
+        expectIndex,
+        context.derivedVectorState(map.get(), map).state != nullptr);
+  };
+
+  verify(&execCtx_, true);
+
+  auto queryCtx = core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig(
+          {{core::QueryConfig::kMapSubscriptKeyIndexEnabled, "false"}}));
+  core::ExecCtx execCtx(pool(), queryCtx.get());
+  verify(&execCtx, false);
+}
+
 TEST_F(ElementAtTest, highlySelective) {
   // Verify that selecting a single element from a large array/map will ensure
   // the underlying elements vector is flattened before generating the result
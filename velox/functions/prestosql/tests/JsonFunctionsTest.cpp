@@ -1117,6 +1117,98 @@ TEST_F(JsonFunctionsTest, jsonExtractVarcharInput) {
 // $internal$json_string_to_array/map/row_cast can be invoked without issues
 // from Prestissimo. The actual functionality is tested in JsonCastTest.
 
+TEST_F(JsonFunctionsTest, jsonExtractSharedParse) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>(
+      {R"({"a":1,"b":"x","c":[1,2]})",
+       std::nullopt,
+       R"({"b":true})",
+       "invalid",
+       "[1,2]"})});
+  const std::vector<std::string> exprs = {
+      "json_extract_scalar(c0, '$.a')",
+      "json_extract_scalar(c0, '$.b')",
+      "json_extract(c0, '$.c')",
+      "json_extract(c0, '$.c[0]')",
+      "concat(json_extract_scalar(c0, '$.a'), "
+      "json_extract_scalar(c0, '$.c[1]'))",
+  };
+  auto exprSet = compileExpressions(exprs, asRowType(data->type()));
+  ASSERT_NE(
+      exprSet->toString().find("$internal$json_extract_scalar_multi"),
+      std::string::npos);
+  ASSERT_NE(
+      exprSet->toString().find("$internal$json_extract_multi"),
+      std::string::npos);
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  std::vector<VectorPtr> results(exprs.size());
+  exprSet->eval(SelectivityVector(data->size()), context, results);
+
+  const std::vector<VectorPtr> expected = {
+      makeNullableFlatVector<std::string>(
+          {"1", std::nullopt, std::nullopt, std::nullopt, std::nullopt}),
+      makeNullableFlatVector<std::string>(
+          {"x", std::nullopt, "true", std::nullopt, std::nullopt}),
+      makeNullableFlatVector<std::string>(
+          {"[1,2]", std::nullopt, std::nullopt, std::nullopt, std::nullopt},
+          JSON()),
+      makeNullableFlatVector<std::string>(
+          {"1", std::nullopt, std::nullopt, std::nullopt, std::nullopt},
+          JSON()),
+      makeNullableFlatVector<std::string>(
+          {"12", std::nullopt, std::nullopt, std::nullopt, std::nullopt}),
+  };
+  for (auto i = 0; i < exprs.size(); ++i) {
+    SCOPED_TRACE(exprs[i]);
+    velox::test::assertEqualVectors(expected[i], results[i]);
+    velox::test::assertEqualVectors(results[i], evaluate(exprs[i], data));
+  }
+}
+
+TEST_F(JsonFunctionsTest, rewriteJsonExtracts) {
+  const auto rowType = ROW({"c0", "c1"}, {VARCHAR(), VARCHAR()});
+  auto parse = [&](const std::vector<std::string>& exprs) {
+    std::vector<core::TypedExprPtr> typedExprs;
+    for (const auto& expr : exprs) {
+      typedExprs.push_back(parseExpression(expr, rowType));
+    }
+    return typedExprs;
+  };
+
+  // A single path per input does not need a shared parse.
+  auto exprs = parse(
+      {"json_extract_scalar(c0, '$.a')",
+       "json_extract_scalar(c1, '$.b')",
+       "json_extract(c0, '$.b')"});
+  ASSERT_EQ(rewriteJsonExtracts("", exprs), exprs);
+
+  // Repeated paths map to the same field. Invalid paths are left alone so
+  // that they fail only their own call.
+  exprs = parse(
+      {"json_extract_scalar(c0, '$.a')",
+       "json_extract_scalar(c0, '$.b')",
+       "json_extract_scalar(c0, '$.a')",
+       "json_extract_scalar(c0, '$.a]')"});
+  auto rewritten = rewriteJsonExtracts("", exprs);
+  ASSERT_EQ(rewritten.size(), 4);
+  std::vector<uint32_t> indices;
+  for (auto i = 0; i < 3; ++i) {
+    auto dereference =
+        std::dynamic_pointer_cast<const core::DereferenceTypedExpr>(
+            rewritten[i]);
+    ASSERT_NE(dereference, nullptr);
+    auto multi = std::dynamic_pointer_cast<const core::CallTypedExpr>(
+        dereference->inputs()[0]);
+    ASSERT_NE(multi, nullptr);
+    EXPECT_EQ(multi->name(), "$internal$json_extract_scalar_multi");
+    EXPECT_EQ(multi->inputs().size(), 3);
+    EXPECT_EQ(*multi->type(), *ROW({VARCHAR(), VARCHAR()}));
+    indices.push_back(dereference->index());
+  }
+  EXPECT_EQ(indices, std::vector<uint32_t>({0, 1, 0}));
+  EXPECT_EQ(rewritten[3], exprs[3]);
+}
+
 TEST_F(JsonFunctionsTest, jsonStringToArrayCast) {
   // Array of strings.
   auto data = makeRowVector({makeNullableFlatVector<std::string>(
@@ -322,6 +322,14 @@ TEST_F(ReduceTest, rewrites) {
     SCOPED_TRACE("if");
     testReduceRewrite(input, "if(x % 2 = 0, s + 1, s)");
   }
+  {
+    SCOPED_TRACE("greatest");
+    testReduceRewrite(input, "greatest(s, x * 2)");
+  }
+  {
+    SCOPED_TRACE("least");
+    testReduceRewrite(input, "least(x + 5, s)");
+  }
 }
 
 } // namespace
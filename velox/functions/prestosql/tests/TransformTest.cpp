@@ -35,6 +35,37 @@ TEST_F(TransformTest, basic) {
   assertEqualVectors(expectedResult, result);
 }
 
+TEST_F(TransformTest, constantCapture) {
+  // Constant captures are passed to the lambda body as constants instead of
+  // being wrapped in a dictionary per element.
+  vector_size_t size = 1'000;
+  auto input = makeRowVector({
+      makeArrayVector<int64_t>(size, modN(5), modN(7), nullEvery(11)),
+      makeConstant<int64_t>(3, size),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+  });
+
+  auto expected = makeArrayVector<int64_t>(
+      size,
+      modN(5),
+      [](vector_size_t row) { return row % 7 * 3; },
+      nullEvery(11));
+  assertEqualVectors(
+      expected, evaluate<ArrayVector>("transform(c0, x -> x * c1)", input));
+  assertEqualVectors(
+      expected, evaluate<ArrayVector>("transform(c0, x -> x * 3)", input));
+
+  // A constant and a non-constant capture.
+  auto result =
+      evaluate<ArrayVector>("transform(c0, x -> x * c1 + c2)", input);
+  expected = evaluate<ArrayVector>("transform(c0, x -> x * 3 + c2)", input);
+  assertEqualVectors(expected, result);
+
+  result = evaluate<ArrayVector>("filter(c0, x -> x > c1)", input);
+  expected = evaluate<ArrayVector>("filter(c0, x -> x > 3)", input);
+  assertEqualVectors(expected, result);
+}
+
 TEST_F(TransformTest, evaluateSubsetOfRows) {
   // Test to verify that output complex vector of valid internal state is
   // generated when only a subset of the rows are evaluated. To simulate this,
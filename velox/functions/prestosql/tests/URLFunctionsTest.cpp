@@ -555,6 +555,47 @@ TEST_F(URLFunctionsTest, extractParameter) {
           "k3"));
 }
 
+TEST_F(URLFunctionsTest, sharedParse) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>({
+      "http://example.com:8080/path/to/a/ResourceWithALongName.html?a=1&b=2#f",
+      std::nullopt,
+      "https://www.Example-Site.com/Some_Long/Path.With~Unreserved-Chars"
+      "/And/More/Segments/index.html?name=%E4%BD%A0&a=x%20y#%66rag",
+      "http://example.com/path with space",
+      "http://host/p%C3%A4th/%E4%BD%A0%E5%A5%BD?q=\u4f60#frag",
+      "/relative/path/that/is/long/enough/for/several/batches?a=b",
+      "",
+  })});
+  const std::vector<std::string> exprs = {
+      "url_extract_protocol(c0)",
+      "url_extract_host(c0)",
+      "url_extract_port(c0)",
+      "url_extract_path(c0)",
+      "url_extract_query(c0)",
+      "url_extract_fragment(c0)",
+      "url_extract_parameter(c0, 'a')",
+      "url_extract_parameter(c0, 'name')",
+      "concat(url_extract_host(c0), url_extract_path(c0))",
+  };
+  auto exprSet = compileExpressions(exprs, asRowType(data->type()));
+  ASSERT_NE(
+      exprSet->toString().find("$internal$url_extract_multi"),
+      std::string::npos);
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  std::vector<VectorPtr> results(exprs.size());
+  exprSet->eval(SelectivityVector(data->size()), context, results);
+
+  // Each result is the same as evaluating the call on its own.
+  for (auto i = 0; i < exprs.size(); ++i) {
+    SCOPED_TRACE(exprs[i]);
+    velox::test::assertEqualVectors(evaluate(exprs[i], data), results[i]);
+  }
+  EXPECT_EQ(
+      results[7]->as<SimpleVector<StringView>>()->valueAt(2).str(),
+      "\xE4\xBD\xA0");
+}
+
 TEST_F(URLFunctionsTest, urlEncode) {
   const auto urlEncode = [&](std::optional<std::string> value) {
     return evaluateOnce<std::string>("url_encode(c0)", value);
@@ -422,6 +422,47 @@ TEST_F(AggregateWindowTest, zeroRangeFrame) {
   test("range between k following and unbounded following", expected);
 }
 
+// Tests sliding frames of many rows, which are computed with a segment tree
+// for the aggregates that support it.
+TEST_F(AggregateWindowTest, slidingFrames) {
+  const auto size = 5'000;
+  const auto input = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return (row * 7919) % 1'000; }, nullEvery(7)),
+      makeFlatVector<double>(
+          size, [](auto row) { return (row * 31) % 97 / 4.0; }, nullEvery(11)),
+      makeFlatVector<std::string>(
+          size, [](auto row) { return fmt::format("s{}", (row * 13) % 251); }),
+  });
+  const std::vector<std::string> frameClauses = {
+      "rows between 100 preceding and current row",
+      "rows between 50 preceding and 50 following",
+      "rows between 300 preceding and 10 preceding",
+      "rows between current row and 1000 following",
+      "rows between c1 preceding and 20 following",
+  };
+  const std::vector<std::string> functions = {
+      "min(c2)",
+      "max(c3)",
+      "count(c2)",
+      "avg(c2)",
+      "sum(c3)",
+      "count(1)",
+      "max(c4)"};
+  bool createTable = true;
+  for (const auto& function : functions) {
+    WindowTestBase::testWindowFunction(
+        {input},
+        function,
+        {"partition by c0 order by c1", "order by c1 desc"},
+        frameClauses,
+        createTable);
+    createTable = false;
+  }
+}
+
 TEST_F(AggregateWindowTest, singlePartitionColumnForPrefixSort) {
   auto size = 100;
   auto input = makeRowVector(
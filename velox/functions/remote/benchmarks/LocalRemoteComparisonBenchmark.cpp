@@ -30,6 +30,14 @@ using namespace facebook::velox;
 using namespace facebook::velox::functions;
 
 DEFINE_int32(batch_size, 1000, "Batch size for benchmarks");
+DEFINE_int32(
+    max_rows_per_request,
+    100,
+    "Rows per request for the remote functions with split requests");
+DEFINE_int32(
+    max_requests_in_flight,
+    4,
+    "Requests in flight for the remote functions with split requests");
 
 int main(int argc, char** argv) {
   folly::Init init(&argc, &argv);
@@ -46,6 +54,13 @@ int main(int argc, char** argv) {
                              .argumentType("bigint")
                              .build()};
   registerRemoteFunction("remote_plus", plusSignatures, metadata);
+  // Same with the input split into requests sent at the same time.
+  RemoteVectorFunctionMetadata splitMetadata = metadata;
+  splitMetadata.maxRowsPerRequest = FLAGS_max_rows_per_request;
+  splitMetadata.maxRequestsInFlight = FLAGS_max_requests_in_flight;
+  registerRemoteFunction("remote_plus_split", plusSignatures, splitMetadata);
+  registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+      {param.functionPrefix + ".remote_plus_split"});
   // Registers the actual function under a different prefix. This is only
   // needed when thrift service runs in the same process.
   registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
@@ -94,6 +109,7 @@ int main(int argc, char** argv) {
               {fuzzer.fuzzFlat(BIGINT()), fuzzer.fuzzFlat(BIGINT())}))
       .addExpression("local_plus", "plus(c0, c1) ")
       .addExpression("remote_plus", "remote_plus(c0, c1) ")
+      .addExpression("remote_plus_split", "remote_plus_split(c0, c1) ")
       .withIterations(1000);
 
   // benchmark comparaing SubstrFunction running locally (same thread)
@@ -16,6 +16,8 @@
 
 #include "velox/functions/remote/client/Remote.h"
 
+#include <deque>
+
 #include <folly/io/async/EventBase.h>
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
@@ -43,7 +45,11 @@ class RemoteFunction : public exec::VectorFunction {
         location_(metadata.location),
         thriftClient_(getThriftClient(location_, &eventBase_)),
         serdeFormat_(metadata.serdeFormat),
-        serde_(getSerde(serdeFormat_)) {
+        serde_(getSerde(serdeFormat_)),
+        maxRowsPerRequest_(metadata.maxRowsPerRequest),
+        maxRequestsInFlight_(metadata.maxRequestsInFlight) {
+    VELOX_CHECK_GE(maxRowsPerRequest_, 0);
+    VELOX_CHECK_GT(maxRequestsInFlight_, 0);
     std::vector<TypePtr> types;
     types.reserve(inputArgs.size());
     serializedInputTypes_.reserve(inputArgs.size());
@@ -85,8 +91,69 @@ class RemoteFunction : public exec::VectorFunction {
         rows.end(),
         std::move(args));
 
-    // Send to remote server.
-    remote::RemoteFunctionResponse remoteResponse;
+    const auto maxRows = maxRowsPerRequest_;
+    if (maxRows == 0 || rows.end() <= maxRows) {
+      // TODO: serialize only active rows.
+      auto request =
+          makeRequest(remoteRowVector, rows.end(), outputType, context);
+      remote::RemoteFunctionResponse remoteResponse;
+      try {
+        thriftClient_->sync_invokeFunction(remoteResponse, request);
+      } catch (const std::exception& e) {
+        throwRemoteError(e);
+      }
+      result = processResponse(remoteResponse, 0, outputType, context);
+      return;
+    }
+
+    // Splits the rows into ranges of 'maxRows' and keeps up to
+    // 'maxRequestsInFlight_' requests outstanding. The responses are copied
+    // into 'result' in the order of the ranges.
+    BaseVector::ensureWritable(rows, outputType, context.pool(), result);
+    std::deque<std::pair<
+        vector_size_t,
+        folly::SemiFuture<remote::RemoteFunctionResponse>>>
+        inFlight;
+    auto receive = [&]() {
+      auto [offset, future] = std::move(inFlight.front());
+      inFlight.pop_front();
+      remote::RemoteFunctionResponse remoteResponse;
+      try {
+        remoteResponse =
+            std::move(future).via(&eventBase_).getVia(&eventBase_);
+      } catch (const std::exception& e) {
+        throwRemoteError(e);
+      }
+      auto rangeResult =
+          processResponse(remoteResponse, offset, outputType, context);
+      result->copy(rangeResult.get(), offset, 0, rangeResult->size());
+    };
+
+    for (vector_size_t offset = 0; offset < rows.end(); offset += maxRows) {
+      const auto size = std::min(maxRows, rows.end() - offset);
+      if (bits::findFirstBit(rows.asRange().bits(), offset, offset + size) <
+          0) {
+        continue;
+      }
+      auto rangeRowVector = std::dynamic_pointer_cast<RowVector>(
+          remoteRowVector->slice(offset, size));
+      auto request = makeRequest(rangeRowVector, size, outputType, context);
+      if (inFlight.size() >= maxRequestsInFlight_) {
+        receive();
+      }
+      inFlight.emplace_back(
+          offset, thriftClient_->semifuture_invokeFunction(request));
+    }
+    while (!inFlight.empty()) {
+      receive();
+    }
+  }
+
+  remote::RemoteFunctionRequest makeRequest(
+      const RowVectorPtr& input,
+      vector_size_t size,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     remote::RemoteFunctionRequest request;
     request.throwOnError_ref() = context.throwOnError();
 
@@ -96,29 +163,33 @@ class RemoteFunction : public exec::VectorFunction {
     functionHandle->argumentTypes_ref() = serializedInputTypes_;
 
     auto requestInputs = request.inputs_ref();
-    requestInputs->rowCount_ref() = remoteRowVector->size();
+    requestInputs->rowCount_ref() = size;
     requestInputs->pageFormat_ref() = serdeFormat_;
+    requestInputs->payload_ref() =
+        rowVectorToIOBuf(input, size, *context.pool(), serde_.get());
+    return request;
+  }
 
-    // TODO: serialize only active rows.
-    requestInputs->payload_ref() = rowVectorToIOBuf(
-        remoteRowVector, rows.end(), *context.pool(), serde_.get());
-
-    try {
-      thriftClient_->sync_invokeFunction(remoteResponse, request);
-    } catch (const std::exception& e) {
-      VELOX_FAIL(
-          "Error while executing remote function '{}' at '{}': {}",
-          functionName_,
-          location_.describe(),
-          e.what());
-    }
+  [[noreturn]] void throwRemoteError(const std::exception& e) const {
+    VELOX_FAIL(
+        "Error while executing remote function '{}' at '{}': {}",
+        functionName_,
+        location_.describe(),
+        e.what());
+  }
 
+  // Returns the results in 'remoteResponse' and sets the errors in it in
+  // 'context'. The response is for the rows starting at 'offset'.
+  VectorPtr processResponse(
+      const remote::RemoteFunctionResponse& remoteResponse,
+      vector_size_t offset,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     auto outputRowVector = IOBufToRowVector(
         remoteResponse.result().value().payload().value(),
         ROW({outputType}),
         *context.pool(),
         serde_.get());
-    result = outputRowVector->childAt(0);
 
     if (auto errorPayload = remoteResponse.result().value().errorPayload()) {
       auto errorsRowVector = IOBufToRowVector(
@@ -135,19 +206,23 @@ class RemoteFunction : public exec::VectorFunction {
         try {
           throw std::runtime_error(errorsVector->valueAt(i));
         } catch (const std::exception& ex) {
-          context.setError(i, std::current_exception());
+          context.setError(offset + i, std::current_exception());
         }
       });
     }
+    return outputRowVector->childAt(0);
   }
 
   const std::string functionName_;
   folly::SocketAddress location_;
 
-  folly::EventBase eventBase_;
+  // Drives the responses of the client. Mutable since apply() is const.
+  mutable folly::EventBase eventBase_;
   std::unique_ptr<RemoteFunctionClient> thriftClient_;
   remote::PageFormat serdeFormat_;
   std::unique_ptr<VectorSerde> serde_;
+  const vector_size_t maxRowsPerRequest_;
+  const int32_t maxRequestsInFlight_;
 
   // Structures we construct once to cache:
   RowTypePtr remoteInputType_;
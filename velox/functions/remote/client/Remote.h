@@ -30,6 +30,16 @@ struct RemoteVectorFunctionMetadata : public exec::VectorFunctionMetadata {
 
   /// The serialization format to be used
   remote::PageFormat serdeFormat{remote::PageFormat::PRESTO_PAGE};
+
+  /// Maximum number of rows sent in one request. Larger inputs are split into
+  /// several requests that are in flight at the same time, so that the
+  /// latency of the server is paid once per batch and not once per request.
+  /// 0 sends all rows in one request.
+  vector_size_t maxRowsPerRequest{0};
+
+  /// Maximum number of requests in flight when an input is split into several
+  /// requests.
+  int32_t maxRequestsInFlight{4};
 };
 
 /// Registers a new remote function. It will use the meatadata defined in
@@ -114,6 +114,14 @@ class RemoteFunctionTest
                               .build()};
     registerRemoteFunction("remote_divide", divSignatures, metadata);
 
+    // Splits inputs into requests of 2 rows with up to 2 in flight.
+    RemoteVectorFunctionMetadata splitMetadata = metadata;
+    splitMetadata.maxRowsPerRequest = 2;
+    splitMetadata.maxRequestsInFlight = 2;
+    registerRemoteFunction("remote_plus_split", plusSignatures, splitMetadata);
+    registerRemoteFunction(
+        "remote_divide_split", divSignatures, splitMetadata);
+
     auto substrSignatures = {exec::FunctionSignatureBuilder()
                                  .returnType("varchar")
                                  .argumentType("varchar")
@@ -135,6 +143,10 @@ class RemoteFunctionTest
         {params.functionPrefix + ".remote_fail"});
     registerFunction<CheckedDivideFunction, double, double, double>(
         {params.functionPrefix + ".remote_divide"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {params.functionPrefix + ".remote_plus_split"});
+    registerFunction<CheckedDivideFunction, double, double, double>(
+        {params.functionPrefix + ".remote_divide_split"});
     registerFunction<SubstrFunction, Varchar, Varchar, int32_t>(
         {params.functionPrefix + ".remote_substr"});
     registerFunction<OpaqueTypeFunction, int64_t, std::shared_ptr<Foo>>(
@@ -155,6 +167,31 @@ TEST_P(RemoteFunctionTest, simple) {
   assertEqualVectors(expected, results);
 }
 
+TEST_P(RemoteFunctionTest, splitRequests) {
+  auto inputVector = makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6, 7});
+  auto results = evaluate<SimpleVector<int64_t>>(
+      "remote_plus_split(c0, c0)", makeRowVector({inputVector}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>({2, 4, 6, 8, 10, 12, 14}), results);
+
+  // Rows not selected, including whole requests, are not sent.
+  results = evaluate<SimpleVector<int64_t>>(
+      "if(c0 < 2 or c0 > 4, remote_plus_split(c0, c0), 0)",
+      makeRowVector({inputVector}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>({2, 0, 0, 0, 10, 12, 14}), results);
+
+  // Errors are set on the rows of the input, not of the request.
+  auto data = makeRowVector({
+      makeFlatVector<double>({1, 4, 9, 16, 25}),
+      makeFlatVector<double>({1, 2, 3, 0, 5}),
+  });
+  results = evaluate<SimpleVector<double>>(
+      "TRY(remote_divide_split(c0, c1))", data);
+  auto expected = makeNullableFlatVector<double>({1, 2, 3, std::nullopt, 5});
+  assertEqualVectors(expected, results);
+}
+
 TEST_P(RemoteFunctionTest, string) {
   auto inputVector =
       makeFlatVector<StringView>({"hello", "my", "remote", "world"});
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SortingNetwork.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
@@ -144,11 +145,11 @@ void applyTyped(
       bits::fillBits(rawBits, mid, rowEnd, !smallerValue);
     } else {
       if (ascending) {
-        std::sort(
-            resultRawValues + rowBegin, resultRawValues + rowEnd, Less<T>());
+        sortSmallWithNetwork(
+            resultRawValues + rowBegin, rowEnd - rowBegin, Less<T>());
       } else {
-        std::sort(
-            resultRawValues + rowBegin, resultRawValues + rowEnd, Greater<T>());
+        sortSmallWithNetwork(
+            resultRawValues + rowBegin, rowEnd - rowBegin, Greater<T>());
       }
     }
   };
@@ -292,47 +292,94 @@ class RowVectorHasher : public SparkVectorHasher<HashClass> {
   std::vector<std::shared_ptr<SparkVectorHasher<HashClass>>> hashers_;
 };
 
-template <typename HashClass, typename ReturnType, typename ArgType>
-void hashSimdTyped(
-    const SelectivityVector* rows,
-    std::vector<VectorPtr>& args,
-    FlatVector<ReturnType>& result,
-    const int32_t hashIdx) {
-  const ArgType* __restrict rawA =
-      args[hashIdx]->asUnchecked<FlatVector<ArgType>>()->rawValues();
-  auto* __restrict rawResult = result.template mutableRawValues<ReturnType>();
-  rows->applyToSelected([&](auto row) {
-    rawResult[row] = hashOne<HashClass>(rawA[row], rawResult[row]);
+// Hashes the values of a scalar column into 'hashes', using the hash of each
+// row so far as the seed. Null rows keep their hash. Flat columns are hashed
+// with a tight loop over the raw values that the compiler can vectorize for
+// numeric types. The loop also hashes the values of null rows and keeps the
+// previous hash for these, which is cheaper than skipping them.
+template <typename HashClass, TypeKind kind>
+void hashScalar(
+    const SelectivityVector& rows,
+    DecodedVector& decoded,
+    SelectivityVector& nonNullRows,
+    typename HashClass::ReturnType* __restrict hashes) {
+  using T = typename TypeTraits<kind>::NativeType;
+  const uint64_t* nulls = decoded.nulls(&rows);
+  if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+    if (decoded.isIdentityMapping() && rows.isAllSelected()) {
+      const T* __restrict rawValues = decoded.data<T>();
+      const auto end = rows.end();
+      if (nulls == nullptr) {
+        for (auto row = 0; row < end; ++row) {
+          hashes[row] = hashOne<HashClass>(rawValues[row], hashes[row]);
+        }
+      } else {
+        for (auto row = 0; row < end; ++row) {
+          const auto hash = hashOne<HashClass>(rawValues[row], hashes[row]);
+          hashes[row] = bits::isBitNull(nulls, row) ? hashes[row] : hash;
+        }
+      }
+      return;
+    }
+  }
+
+  const SelectivityVector* selected = &rows;
+  if (nulls != nullptr) {
+    nonNullRows = rows;
+    nonNullRows.deselectNulls(nulls, rows.begin(), rows.end());
+    selected = &nonNullRows;
+  }
+  if constexpr (kind != TypeKind::BOOLEAN) {
+    if (decoded.isIdentityMapping()) {
+      const T* rawValues = decoded.data<T>();
+      selected->applyToSelected([&](auto row) {
+        hashes[row] = hashOne<HashClass>(rawValues[row], hashes[row]);
+      });
+      return;
+    }
+  }
+  selected->applyToSelected([&](auto row) {
+    hashes[row] = hashOne<HashClass>(
+        decoded.template valueAt<T>(row), hashes[row]);
   });
 }
 
-template <typename HashClass, typename ReturnType>
-void hashSimd(
-    const SelectivityVector* rows,
-    std::vector<VectorPtr>& args,
-    FlatVector<ReturnType>& result,
-    const int32_t hashIdx) {
-  switch (args[hashIdx]->typeKind()) {
-#define SCALAR_CASE(kind) \
-  case TypeKind::kind:    \
-    return hashSimdTyped< \
-        HashClass,        \
-        ReturnType,       \
-        TypeTraits<TypeKind::kind>::NativeType>(rows, args, result, hashIdx);
-    SCALAR_CASE(TINYINT)
-    SCALAR_CASE(SMALLINT)
-    SCALAR_CASE(INTEGER)
-    SCALAR_CASE(BIGINT)
-    SCALAR_CASE(HUGEINT)
-    SCALAR_CASE(REAL)
-    SCALAR_CASE(DOUBLE)
-    SCALAR_CASE(VARCHAR)
-    SCALAR_CASE(VARBINARY)
-    SCALAR_CASE(TIMESTAMP)
-    SCALAR_CASE(UNKNOWN)
-#undef SCALAR_CASE
-    default:
-      VELOX_UNREACHABLE();
+// Computes the hashes of 'columns' for 'rows' into 'hashes' one column at a
+// time. The hash of each column is the seed for hashing the next one. Nulls
+// leave the hash unchanged. 'nonNullRows' is scratch memory.
+template <typename HashClass>
+void hashColumns(
+    const SelectivityVector& rows,
+    const std::vector<DecodedVector*>& columns,
+    typename HashClass::SeedType seed,
+    SelectivityVector& nonNullRows,
+    typename HashClass::ReturnType* hashes) {
+  rows.applyToSelected([&](auto row) { hashes[row] = seed; });
+
+  for (auto* decoded : columns) {
+    const auto kind = decoded->base()->typeKind();
+    if (kind == TypeKind::UNKNOWN) {
+      // Values of unknown type are always null and keep the hash.
+      continue;
+    }
+    if (kind != TypeKind::ARRAY && kind != TypeKind::MAP &&
+        kind != TypeKind::ROW) {
+      VELOX_DYNAMIC_SCALAR_TEMPLATE_TYPE_DISPATCH(
+          hashScalar, HashClass, kind, rows, *decoded, nonNullRows, hashes);
+      continue;
+    }
+
+    const SelectivityVector* selected = &rows;
+    if (decoded->mayHaveNulls()) {
+      nonNullRows = rows;
+      nonNullRows.deselectNulls(
+          decoded->nulls(&rows), rows.begin(), rows.end());
+      selected = &nonNullRows;
+    }
+    auto hasher = createVectorHasher<HashClass>(*decoded);
+    selected->applyToSelected([&](auto row) {
+      hashes[row] = hasher->hashNotNullAt(row, hashes[row]);
+    });
   }
 }
 
@@ -351,38 +398,23 @@ void applyWithType(
   size_t hashIdx = seed ? 1 : 0;
   SeedType hashSeed = seed ? *seed : kDefaultSeed;
 
-  auto& result = *resultRef->as<FlatVector<ReturnType>>();
-  rows.applyToSelected([&](auto row) { result.set(row, hashSeed); });
-
-  exec::LocalSelectivityVector selectedMinusNulls(context);
-
   exec::DecodedArgs decodedArgs(rows, args, context);
+  std::vector<DecodedVector*> columns;
+  columns.reserve(args.size() - hashIdx);
   for (auto i = hashIdx; i < args.size(); i++) {
-    auto decoded = decodedArgs.at(i);
-    const SelectivityVector* selected = &rows;
-    if (args[i]->mayHaveNulls()) {
-      *selectedMinusNulls.get(rows.end()) = rows;
-      selectedMinusNulls->deselectNulls(
-          decoded->nulls(&rows), rows.begin(), rows.end());
-      selected = selectedMinusNulls.get();
-    }
-
-    auto kind = args[i]->typeKind();
-    if ((kind == TypeKind::TINYINT || kind == TypeKind::SMALLINT ||
-         kind == TypeKind::INTEGER || kind == TypeKind::BIGINT ||
-         kind == TypeKind::REAL || kind == TypeKind::DOUBLE ||
-         kind == TypeKind::TIMESTAMP || kind == TypeKind::VARCHAR ||
-         kind == TypeKind::VARBINARY || kind == TypeKind::HUGEINT ||
-         kind == TypeKind::UNKNOWN) &&
-        args[i]->isFlatEncoding()) {
-      hashSimd<HashClass, ReturnType>(selected, args, result, i);
-      continue;
-    }
+    columns.push_back(decodedArgs.at(i));
+  }
 
-    auto hasher = createVectorHasher<HashClass>(*decoded);
-    selected->applyToSelected([&](auto row) {
-      result.set(row, hasher->hashNotNullAt(row, result.valueAt(row)));
-    });
+  auto* result = resultRef->asUnchecked<FlatVector<ReturnType>>();
+  exec::LocalSelectivityVector nonNullRows(context, rows.end());
+  hashColumns<HashClass>(
+      rows,
+      columns,
+      hashSeed,
+      *nonNullRows.get(),
+      result->mutableRawValues());
+  if (result->mayHaveNulls()) {
+    result->clearNulls(rows);
   }
 }
 
@@ -710,6 +742,23 @@ void checkArgTypes(const std::vector<exec::VectorFunctionArg>& args) {
   }
 }
 
+template <typename HashClass>
+void hashVectors(
+    const SelectivityVector& rows,
+    const std::vector<VectorPtr>& columns,
+    typename HashClass::SeedType seed,
+    typename HashClass::ReturnType* hashes) {
+  std::vector<DecodedVector> decoded(columns.size());
+  std::vector<DecodedVector*> decodedColumns;
+  decodedColumns.reserve(columns.size());
+  for (auto i = 0; i < columns.size(); ++i) {
+    decoded[i].decode(*columns[i], rows);
+    decodedColumns.push_back(&decoded[i]);
+  }
+  SelectivityVector nonNullRows(rows.end());
+  hashColumns<HashClass>(rows, decodedColumns, seed, nonNullRows, hashes);
+}
+
 } // namespace
 
 // Not all types are supported by now. Check types when making hash function.
@@ -788,6 +837,22 @@ std::shared_ptr<exec::VectorFunction> makeXxHash64WithSeed(
   return std::make_shared<XxHash64Function>(seed);
 }
 
+void murmur3Hash(
+    const SelectivityVector& rows,
+    const std::vector<VectorPtr>& columns,
+    int32_t seed,
+    int32_t* hashes) {
+  hashVectors<Murmur3Hash>(rows, columns, seed, hashes);
+}
+
+void xxHash64(
+    const SelectivityVector& rows,
+    const std::vector<VectorPtr>& columns,
+    int64_t seed,
+    int64_t* hashes) {
+  hashVectors<XxHash64>(rows, columns, seed, hashes);
+}
+
 exec::VectorFunctionMetadata hashMetadata() {
   return exec::VectorFunctionMetadataBuilder()
       .defaultNullBehavior(false)
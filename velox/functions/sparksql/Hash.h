@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#pragma once
+
 #include "velox/expression/VectorFunction.h"
 
 namespace facebook::velox::functions::sparksql {
@@ -76,4 +78,22 @@ std::shared_ptr<exec::VectorFunction> makeXxHash64WithSeed(
 
 exec::VectorFunctionMetadata hashMetadata();
 
+/// Computes hash(columns...) with 'seed' for 'rows' into 'hashes', same as the
+/// Spark hash function. The columns are hashed one at a time and the hash of
+/// each column is the seed for the next one. Nulls leave the hash unchanged.
+/// 'hashes' must have room for rows.end() values. Used by both the function
+/// and by Spark hash partitioning.
+void murmur3Hash(
+    const SelectivityVector& rows,
+    const std::vector<VectorPtr>& columns,
+    int32_t seed,
+    int32_t* hashes);
+
+/// Same as murmur3Hash but computes xxhash64(columns...).
+void xxHash64(
+    const SelectivityVector& rows,
+    const std::vector<VectorPtr>& columns,
+    int64_t seed,
+    int64_t* hashes);
+
 } // namespace facebook::velox::functions::sparksql
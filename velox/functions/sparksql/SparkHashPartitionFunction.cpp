@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/sparksql/SparkHashPartitionFunction.h"
+
+#include "velox/functions/sparksql/Hash.h"
+
+namespace facebook::velox::functions::sparksql {
+namespace {
+// Seed of the murmur3 hash in Spark HashPartitioning.
+constexpr int32_t kSeed = 42;
+} // namespace
+
+SparkHashPartitionFunction::SparkHashPartitionFunction(
+    int numPartitions,
+    std::vector<column_index_t> keyChannels)
+    : numPartitions_{numPartitions}, keyChannels_{std::move(keyChannels)} {
+  VELOX_CHECK_GT(numPartitions_, 0);
+  VELOX_CHECK(!keyChannels_.empty());
+  keys_.resize(keyChannels_.size());
+}
+
+std::optional<uint32_t> SparkHashPartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  const auto size = input.size();
+  rows_.resize(size);
+  rows_.setAll();
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    keys_[i] = input.childAt(keyChannels_[i]);
+  }
+
+  hashes_.resize(size);
+  murmur3Hash(rows_, keys_, kSeed, hashes_.data());
+  for (auto& key : keys_) {
+    key.reset();
+  }
+
+  partitions.resize(size);
+  for (auto i = 0; i < size; ++i) {
+    const int32_t mod = hashes_[i] % numPartitions_;
+    partitions[i] = mod < 0 ? mod + numPartitions_ : mod;
+  }
+  return std::nullopt;
+}
+
+std::unique_ptr<core::PartitionFunction> SparkHashPartitionFunctionSpec::create(
+    int numPartitions,
+    bool /*localExchange*/) const {
+  return std::make_unique<SparkHashPartitionFunction>(
+      numPartitions, keyChannels_);
+}
+
+std::string SparkHashPartitionFunctionSpec::toString() const {
+  std::ostringstream keys;
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    if (i > 0) {
+      keys << ", ";
+    }
+    keys << inputType_->nameOf(keyChannels_[i]);
+  }
+  return fmt::format("SPARK_HASH({})", keys.str());
+}
+
+folly::dynamic SparkHashPartitionFunctionSpec::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "SparkHashPartitionFunctionSpec";
+  obj["inputType"] = inputType_->serialize();
+  obj["keyChannels"] = ISerializable::serialize(keyChannels_);
+  return obj;
+}
+
+// static
+core::PartitionFunctionSpecPtr SparkHashPartitionFunctionSpec::deserialize(
+    const folly::dynamic& obj,
+    void* context) {
+  return std::make_shared<SparkHashPartitionFunctionSpec>(
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      ISerializable::deserialize<std::vector<column_index_t>>(
+          obj["keyChannels"], context));
+}
+
+// static
+void SparkHashPartitionFunctionSpec::registerSerDe() {
+  DeserializationWithContextRegistryForSharedPtr().Register(
+      "SparkHashPartitionFunctionSpec",
+      SparkHashPartitionFunctionSpec::deserialize);
+}
+
+} // namespace facebook::velox::functions::sparksql
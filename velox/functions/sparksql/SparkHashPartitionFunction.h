@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::functions::sparksql {
+
+/// Assigns rows to partitions the way Spark HashPartitioning does:
+/// pmod(hash(keys...), numPartitions), where hash is the Spark murmur3 hash
+/// with seed 42. Rows with the same keys go to the same partition as in a
+/// Spark shuffle, so that Velox and Spark tasks can exchange data.
+class SparkHashPartitionFunction : public core::PartitionFunction {
+ public:
+  SparkHashPartitionFunction(
+      int numPartitions,
+      std::vector<column_index_t> keyChannels);
+
+  std::optional<uint32_t> partition(
+      const RowVector& input,
+      std::vector<uint32_t>& partitions) override;
+
+ private:
+  const int numPartitions_;
+  const std::vector<column_index_t> keyChannels_;
+
+  // Reusable memory.
+  SelectivityVector rows_;
+  std::vector<VectorPtr> keys_;
+  std::vector<int32_t> hashes_;
+};
+
+/// Factory for SparkHashPartitionFunction. 'keyChannels' are the indices of
+/// the partitioning keys in 'inputType'.
+class SparkHashPartitionFunctionSpec : public core::PartitionFunctionSpec {
+ public:
+  SparkHashPartitionFunctionSpec(
+      RowTypePtr inputType,
+      std::vector<column_index_t> keyChannels)
+      : inputType_{std::move(inputType)},
+        keyChannels_{std::move(keyChannels)} {}
+
+  std::unique_ptr<core::PartitionFunction> create(
+      int numPartitions,
+      bool localExchange) const override;
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static core::PartitionFunctionSpecPtr deserialize(
+      const folly::dynamic& obj,
+      void* context);
+
+  static void registerSerDe();
+
+ private:
+  const RowTypePtr inputType_;
+  const std::vector<column_index_t> keyChannels_;
+};
+
+} // namespace facebook::velox::functions::sparksql
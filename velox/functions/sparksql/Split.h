@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/functions/lib/Utf8Utils.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::functions::sparksql {
 
@@ -131,6 +132,11 @@ struct Split {
       return;
     }
 
+    if (isLiteral(delimiter)) {
+      splitLiteral(result, input, delimiter, limit);
+      return;
+    }
+
     // Splits input string using the delimiter and adds the cutting-off pieces
     // to elements vector until the string's end or the limit is reached.
     int32_t addedElements{0};
@@ -188,6 +194,35 @@ struct Split {
     result.add_item().setNoCopy(StringView(start + pos, end - pos));
   }
 
+  // Returns true if 'delimiter' has no regular expression metacharacters, so
+  // that its matches are exactly its occurrences in the input.
+  static bool isLiteral(const arg_type<Varchar>& delimiter) {
+    static constexpr std::string_view kMetacharacters = "\\^$.|?*+()[]{}";
+    return std::string_view(delimiter.data(), delimiter.size())
+               .find_first_of(kMetacharacters) == std::string_view::npos;
+  }
+
+  // Same as split() for a literal delimiter. Finds the delimiter offsets with
+  // a SIMD scan instead of running the regular expression.
+  void splitLiteral(
+      out_type<Array<Varchar>>& result,
+      const arg_type<Varchar>& input,
+      const arg_type<Varchar>& delimiter,
+      int32_t limit) const {
+    const char* start = input.data();
+    const std::string_view delim(delimiter.data(), delimiter.size());
+    int32_t addedElements{0};
+    size_t pos = 0;
+    stringCore::forEachDelimiter(
+        std::string_view(start, input.size()), delim, [&](size_t offset) {
+          result.add_item().setNoCopy(StringView(start + pos, offset - pos));
+          pos = offset + delim.size();
+          // If the next element should be the last, leave the loop.
+          return ++addedElements + 1 != limit;
+        });
+    result.add_item().setNoCopy(StringView(start + pos, input.size() - pos));
+  }
+
   mutable facebook::velox::functions::detail::ReCache cache_;
 };
 } // namespace facebook::velox::functions::sparksql
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/functions/sparksql/Hash.h"
 #include "velox/functions/sparksql/tests/SparkFunctionBaseTest.h"
 
 #include <stdint.h>
@@ -303,5 +304,49 @@ TEST_F(HashTest, simd) {
   runSIMDHashAndAssert<UnknownValue>(UnknownValue(), 42, 10);
 }
 
+TEST_F(HashTest, encodings) {
+  // Nulls in flat, dictionary and constant columns keep the hash of the
+  // preceding columns. Hashing the columns gives the same result as hashing
+  // a struct of them.
+  auto ints = makeNullableFlatVector<int64_t>(
+      {1, std::nullopt, 3, 4, std::nullopt, 6, 7, 8});
+  auto doubles = makeNullableFlatVector<double>(
+      {1.5, 2.5, std::nullopt, -0.0, 0.0, 6.5, 7.5, std::nullopt});
+  auto bools = makeNullableFlatVector<bool>(
+      {true, false, std::nullopt, true, true, false, false, true});
+  auto strings = makeNullableFlatVector<std::string>(
+      {"a", std::nullopt, "", "a string that is not inlined", "b", "c", "d",
+       std::nullopt});
+  const auto size = ints->size();
+
+  auto testColumns = [&](const std::vector<VectorPtr>& columns) {
+    auto expected = hash(makeRowVector(columns));
+    auto data = makeRowVector(columns);
+    assertEqualVectors(expected, evaluate("hash(c0, c1, c2, c3)", data));
+
+    SelectivityVector rows(size);
+    std::vector<int32_t> hashes(size);
+    murmur3Hash(rows, columns, 42, hashes.data());
+    assertEqualVectors(expected, makeFlatVector<int32_t>(hashes));
+  };
+
+  testColumns({ints, doubles, bools, strings});
+
+  auto indices = makeIndicesInReverse(size);
+  testColumns({
+      wrapInDictionary(indices, ints),
+      wrapInDictionary(indices, doubles),
+      wrapInDictionary(indices, bools),
+      wrapInDictionary(indices, strings),
+  });
+
+  testColumns({
+      ints,
+      BaseVector::wrapInConstant(size, 2, doubles),
+      BaseVector::wrapInConstant(size, 0, bools),
+      BaseVector::wrapInConstant(size, 3, strings),
+  });
+}
+
 } // namespace
 } // namespace facebook::velox::functions::sparksql::test
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/sparksql/SparkHashPartitionFunction.h"
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/sparksql/tests/SparkFunctionBaseTest.h"
+
+namespace facebook::velox::functions::sparksql::test {
+namespace {
+
+class SparkHashPartitionFunctionTest : public SparkFunctionBaseTest {
+ protected:
+  std::vector<uint32_t> partition(
+      const RowVectorPtr& input,
+      const std::vector<column_index_t>& keyChannels,
+      int numPartitions) {
+    SparkHashPartitionFunctionSpec spec(asRowType(input->type()), keyChannels);
+    auto function = spec.create(numPartitions, false);
+    std::vector<uint32_t> partitions;
+    EXPECT_FALSE(function->partition(*input, partitions).has_value());
+    EXPECT_EQ(partitions.size(), input->size());
+    return partitions;
+  }
+};
+
+TEST_F(SparkHashPartitionFunctionTest, partition) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<int32_t>(
+          {1, std::nullopt, -3, 4, 5, -6, std::nullopt, 8, 9, 10}),
+      makeFlatVector<std::string>(
+          {"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"}),
+      makeFlatVector<int64_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}),
+  });
+
+  // Same as pmod(hash(keys...), numPartitions) in Spark.
+  for (auto numPartitions : {1, 7, 100}) {
+    auto expected = evaluate(
+        fmt::format(
+            "pmod(hash(c0, c1), cast({} as integer))", numPartitions),
+        data);
+    auto partitions = partition(data, {0, 1}, numPartitions);
+    for (auto i = 0; i < data->size(); ++i) {
+      ASSERT_EQ(
+          partitions[i], expected->as<SimpleVector<int32_t>>()->valueAt(i));
+    }
+  }
+
+  auto partitions = partition(data, {2}, 4);
+  auto expected = evaluate("pmod(hash(c2), cast(4 as integer))", data);
+  for (auto i = 0; i < data->size(); ++i) {
+    ASSERT_EQ(partitions[i], expected->as<SimpleVector<int32_t>>()->valueAt(i));
+  }
+}
+
+TEST_F(SparkHashPartitionFunctionTest, spec) {
+  auto type = ROW({"a", "b", "c"}, {INTEGER(), VARCHAR(), BIGINT()});
+  SparkHashPartitionFunctionSpec spec(type, {2, 0});
+  ASSERT_EQ(spec.toString(), "SPARK_HASH(c, a)");
+
+  SparkHashPartitionFunctionSpec::registerSerDe();
+  auto copy = ISerializable::deserialize<core::PartitionFunctionSpec>(
+      spec.serialize(), pool());
+  ASSERT_EQ(copy->toString(), spec.toString());
+
+  VELOX_ASSERT_THROW(spec.create(0, false), "(0 vs. 0)");
+}
+
+} // namespace
+} // namespace facebook::velox::functions::sparksql::test
@@ -77,16 +77,26 @@ PYBIND11_MODULE(arrow, m) {
   });
 
   /// Converts a velox.py.vector.Vector to a pyarrow.Array using Velox's arrow
-  /// bridge.
-  m.def("to_arrow", [](velox::py::PyVector& vector) {
-    ArrowSchema schema;
-    ArrowArray data;
+  /// bridge. Flat fixed-width buffers are shared rather than copied. With
+  /// 'string_view' set, strings are exported in the Arrow string view layout,
+  /// which shares Velox's StringView buffers instead of building an offsets
+  /// buffer and copying the characters.
+  m.def(
+      "to_arrow",
+      [](velox::py::PyVector& vector, bool stringView) {
+        ArrowSchema schema;
+        ArrowArray data;
+        ArrowOptions options;
+        options.exportToStringView = stringView;
 
-    velox::exportToArrow(vector.vector(), schema);
-    velox::exportToArrow(vector.vector(), data, leafPool.get());
+        velox::exportToArrow(vector.vector(), schema, options);
+        velox::exportToArrow(vector.vector(), data, leafPool.get(), options);
 
-    auto arrowType = *arrow::ImportType(&schema);
-    auto arrowArray = *arrow::ImportArray(&data, arrowType);
-    return py::reinterpret_steal<py::object>(arrow::py::wrap_array(arrowArray));
-  });
+        auto arrowType = *arrow::ImportType(&schema);
+        auto arrowArray = *arrow::ImportArray(&data, arrowType);
+        return py::reinterpret_steal<py::object>(
+            arrow::py::wrap_array(arrowArray));
+      },
+      py::arg("vector"),
+      py::arg("string_view") = false);
 }
@@ -22,4 +22,4 @@ from velox.py.vector import Vector
 from pyarrow import Array
 
 def to_velox(array: Array) -> Vector: ...
-def to_arrow(vector: Vector) -> Array: ...
+def to_arrow(vector: Vector, string_view: bool = False) -> Array: ...
@@ -47,17 +47,25 @@ PyVector PyTaskIterator::Iterator::operator*() const {
 }
 
 void PyTaskIterator::Iterator::advance() {
-  if (cursor_ && cursor_->moveNext()) {
-    vector_ = cursor_->current();
-  } else {
+  if (!cursor_) {
     vector_ = nullptr;
+    return;
   }
+  bool hasNext;
+  {
+    // Drivers run on the executor and do not need the GIL. Holding it while
+    // blocked on the next batch would stall every other Python thread.
+    py::gil_scoped_release release;
+    hasNext = cursor_->moveNext();
+  }
+  vector_ = hasNext ? cursor_->current() : nullptr;
 }
 
 PyLocalRunner::PyLocalRunner(
     const PyPlanNode& pyPlanNode,
     const std::shared_ptr<memory::MemoryPool>& pool,
-    const std::shared_ptr<folly::CPUThreadPoolExecutor>& executor)
+    const std::shared_ptr<folly::CPUThreadPoolExecutor>& executor,
+    int32_t maxDrivers)
     : rootPool_(pool),
       outputPool_(memory::memoryManager()->addLeafPool()),
       executor_(executor),
@@ -76,6 +84,7 @@ PyLocalRunner::PyLocalRunner(
 
   cursor_ = exec::TaskCursor::create({
       .planNode = planNode_,
+      .maxDrivers = maxDrivers,
       .queryCtx = queryCtx,
       .outputPool = outputPool_,
   });
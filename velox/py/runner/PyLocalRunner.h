@@ -34,12 +34,14 @@ class PyTaskIterator;
 /// velox.py.plan_builder).
 /// @param pool The memory pool to pass to the task.
 /// @param executor The executor that will be used by drivers.
+/// @param maxDrivers The number of drivers to run each pipeline with.
 class PyLocalRunner {
  public:
   explicit PyLocalRunner(
       const PyPlanNode& pyPlanNode,
       const std::shared_ptr<memory::MemoryPool>& pool,
-      const std::shared_ptr<folly::CPUThreadPoolExecutor>& executor);
+      const std::shared_ptr<folly::CPUThreadPoolExecutor>& executor,
+      int32_t maxDrivers = 1);
 
   /// Add a split to scan an entire file.
   ///
@@ -51,7 +53,9 @@ class PyLocalRunner {
       const std::string& planId,
       const std::string& connectorId);
 
-  /// Execute the task and returns an iterable to the output vectors.
+  /// Execute the task and returns an iterable to the output vectors. Batches
+  /// are produced while the client iterates, and the GIL is released while
+  /// waiting for the next one, so other Python threads keep running.
   pybind11::iterator execute();
 
   /// Prints a descriptive debug message containing plan and execution stats.
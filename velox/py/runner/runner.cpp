@@ -39,9 +39,14 @@ PYBIND11_MODULE(runner, m) {
 
   py::class_<velox::py::PyLocalRunner>(m, "LocalRunner")
       // Only expose the plan node through the Python API.
-      .def(py::init([](const velox::py::PyPlanNode& planNode) {
-        return velox::py::PyLocalRunner{planNode, rootPool, executor};
-      }))
+      .def(
+          py::init([](const velox::py::PyPlanNode& planNode,
+                      int32_t maxDrivers) {
+            return velox::py::PyLocalRunner{
+                planNode, rootPool, executor, maxDrivers};
+          }),
+          py::arg("plan_node"),
+          py::arg("max_drivers") = 1)
       .def("execute", &velox::py::PyLocalRunner::execute)
       .def(
           "print_plan_with_stats",
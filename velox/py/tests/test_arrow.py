@@ -40,6 +40,25 @@ class TestPyVeloxArrow(unittest.TestCase):
         self.assertTrue(isinstance(array2, pyarrow.Array))
         self.assertEqual(array, array2)
 
+    def test_roundtrip_string_view(self):
+        array = pyarrow.array(["a", "a somewhat longer string", None, ""])
+        array2 = to_arrow(to_velox(array), string_view=True)
+
+        self.assertEqual(array2.type, pyarrow.string_view())
+        self.assertEqual(array.to_pylist(), array2.to_pylist())
+
+    def test_buffer_protocol(self):
+        vector = to_velox(pyarrow.array([1, 2, 3, 4], type=pyarrow.int64()))
+        view = memoryview(vector)
+
+        self.assertTrue(view.readonly)
+        self.assertEqual(view.format, "q")
+        self.assertEqual(view.tolist(), [1, 2, 3, 4])
+
+        strings = to_velox(pyarrow.array(["a", "b"]))
+        with self.assertRaises(RuntimeError):
+            memoryview(strings)
+
     def test_empty(self):
         # TODO: Velox's arrow bridge does not allow missing buffers (even if
         # there are no rows):
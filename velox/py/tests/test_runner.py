@@ -64,6 +64,20 @@ class TestPyVeloxRunner(unittest.TestCase):
             total_size += vector.size()
         self.assertEqual(total_size, 100)
 
+    def test_runner_max_drivers(self):
+        array = pyarrow.array(list(range(100)))
+        vector = to_velox(pyarrow.record_batch([array], names=["c0"]))
+
+        # Values is not parallelizable, so the extra drivers must not
+        # duplicate its output.
+        plan_builder = PlanBuilder().values([vector])
+        runner = LocalRunner(plan_builder.get_plan_node(), max_drivers=4)
+        total_size = 0
+
+        for vector in runner.execute():
+            total_size += vector.size()
+        self.assertEqual(total_size, 100)
+
     def test_runner_with_values_order_limit(self):
         vectors = []
         batch_size = 10
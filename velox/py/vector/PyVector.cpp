@@ -16,9 +16,26 @@
 
 #include "velox/py/vector/PyVector.h"
 #include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
 #include "velox/vector/VectorPrinter.h"
 
 namespace facebook::velox::py {
+namespace {
+
+template <typename T>
+pybind11::buffer_info flatBufferInfo(const BaseVector& vector) {
+  auto* flat = vector.asUnchecked<FlatVector<T>>();
+  return pybind11::buffer_info(
+      const_cast<T*>(flat->rawValues()),
+      sizeof(T),
+      pybind11::format_descriptor<T>::format(),
+      1,
+      {static_cast<pybind11::ssize_t>(flat->size())},
+      {static_cast<pybind11::ssize_t>(sizeof(T))},
+      true /*readonly*/);
+}
+
+} // namespace
 
 std::string PyVector::summarizeToText() const {
   return velox::VectorPrinter::summarizeToText(*vector_);
@@ -28,6 +45,32 @@ std::string PyVector::printDetailed() const {
   return velox::printVector(*vector_);
 }
 
+pybind11::buffer_info PyVector::bufferInfo() const {
+  if (vector_->encoding() != VectorEncoding::Simple::FLAT) {
+    throw std::runtime_error(fmt::format(
+        "Buffer protocol is only supported for flat vectors, but got '{}'",
+        toString()));
+  }
+  switch (vector_->typeKind()) {
+    case TypeKind::TINYINT:
+      return flatBufferInfo<int8_t>(*vector_);
+    case TypeKind::SMALLINT:
+      return flatBufferInfo<int16_t>(*vector_);
+    case TypeKind::INTEGER:
+      return flatBufferInfo<int32_t>(*vector_);
+    case TypeKind::BIGINT:
+      return flatBufferInfo<int64_t>(*vector_);
+    case TypeKind::REAL:
+      return flatBufferInfo<float>(*vector_);
+    case TypeKind::DOUBLE:
+      return flatBufferInfo<double>(*vector_);
+    default:
+      throw std::runtime_error(fmt::format(
+          "Buffer protocol is not supported for type '{}'",
+          vector_->type()->toString()));
+  }
+}
+
 PyVector PyVector::childAt(vector_size_t idx) const {
   if (auto rowVector = std::dynamic_pointer_cast<RowVector>(vector_)) {
     return PyVector{rowVector->childAt(idx), pool_};
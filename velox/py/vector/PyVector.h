@@ -110,6 +110,12 @@ class PyVector {
     return vector_;
   }
 
+  /// Describes the values of a flat vector of a fixed-width numeric type so
+  /// they can be exposed through the Python buffer protocol (e.g. to
+  /// numpy.asarray()) without copying. Values at null positions are
+  /// undefined. Throws for other encodings and types.
+  pybind11::buffer_info bufferInfo() const;
+
  private:
   std::shared_ptr<memory::MemoryPool> pool_;
   VectorPtr vector_;
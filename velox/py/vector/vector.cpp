@@ -24,7 +24,8 @@ namespace py = pybind11;
 PYBIND11_MODULE(vector, m) {
   using namespace facebook;
 
-  py::class_<velox::py::PyVector>(m, "Vector")
+  py::class_<velox::py::PyVector>(m, "Vector", py::buffer_protocol())
+      .def_buffer(&velox::py::PyVector::bufferInfo)
       .def("__str__", &velox::py::PyVector::toString, py::doc(R"(
         Returns a summarized description of the Vector and its type.
       )"))
@@ -33,14 +33,16 @@ int32_t readInt32(const char* buffer) {
   return n;
 }
 
+// The value size is known at compile time, so that the copy compiles to a
+// single load and store.
+template <typename T>
 FOLLY_ALWAYS_INLINE void writeFixedWidth(
-    const char* rawData,
+    const T* rawData,
     vector_size_t index,
-    size_t valueBytes,
     char* buffer,
     size_t& offset) {
-  ::memcpy(buffer + offset, rawData + index * valueBytes, valueBytes);
-  offset += valueBytes;
+  ::memcpy(buffer + offset, rawData + index, sizeof(T));
+  offset += sizeof(T);
 }
 
 FOLLY_ALWAYS_INLINE void
@@ -60,37 +62,59 @@ writeString(const StringView& value, char* buffer, size_t& offset) {
   offset += kSizeBytes + value.size();
 }
 
-// Serialize the child vector of a row type within a range of consecutive rows.
-// Write the serialized data at offsets of buffer row by row.
-// Update offsets with the actual serialized size.
-template <TypeKind kind>
-void serializeTyped(
+template <typename T>
+void serializeFixedWidthTyped(
     const raw_vector<vector_size_t>& rows,
     uint32_t childIdx,
     const DecodedVector& decoded,
-    size_t valueBytes,
     const raw_vector<uint8_t*>& nulls,
     char* buffer,
     std::vector<size_t>& offsets) {
-  const auto* rawData = decoded.data<char>();
+  const auto* rawData = decoded.data<T>();
   if (!decoded.mayHaveNulls()) {
-    for (auto i = 0; i < rows.size(); ++i) {
-      writeFixedWidth(
-          rawData, decoded.index(rows[i]), valueBytes, buffer, offsets[i]);
+    if (decoded.isIdentityMapping()) {
+      for (auto i = 0; i < rows.size(); ++i) {
+        writeFixedWidth(rawData, rows[i], buffer, offsets[i]);
+      }
+    } else {
+      for (auto i = 0; i < rows.size(); ++i) {
+        writeFixedWidth(rawData, decoded.index(rows[i]), buffer, offsets[i]);
+      }
     }
   } else {
     for (auto i = 0; i < rows.size(); ++i) {
       if (decoded.isNullAt(rows[i])) {
         bits::setBit(nulls[i], childIdx, true);
-        offsets[i] += valueBytes;
+        offsets[i] += sizeof(T);
       } else {
-        writeFixedWidth(
-            rawData, decoded.index(rows[i]), valueBytes, buffer, offsets[i]);
+        writeFixedWidth(rawData, decoded.index(rows[i]), buffer, offsets[i]);
       }
     }
   }
 }
 
+// Serialize the child vector of a row type within a range of consecutive rows.
+// Write the serialized data at offsets of buffer row by row.
+// Update offsets with the actual serialized size.
+template <TypeKind kind>
+void serializeTyped(
+    const raw_vector<vector_size_t>& rows,
+    uint32_t childIdx,
+    const DecodedVector& decoded,
+    size_t valueBytes,
+    const raw_vector<uint8_t*>& nulls,
+    char* buffer,
+    std::vector<size_t>& offsets) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    VELOX_DCHECK_EQ(sizeof(T), valueBytes);
+    serializeFixedWidthTyped<T>(
+        rows, childIdx, decoded, nulls, buffer, offsets);
+  } else {
+    VELOX_UNREACHABLE("Unexpected type kind: {}", mapTypeKindToName(kind));
+  }
+}
+
 template <>
 void serializeTyped<TypeKind::UNKNOWN>(
     const raw_vector<vector_size_t>& rows,
@@ -339,8 +363,54 @@ void CompactRow::serializedRowSizes(
     return;
   }
 
-  for (const auto& row : rows) {
-    *sizes[row] = rowSize(row) + sizeof(TRowSize);
+  // Null flags and fixed-width fields take the same space in every row. Add
+  // the variable-width fields column by column.
+  int32_t fixedSize = rowNullBytes_ + sizeof(TRowSize);
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      fixedSize += children_[i].valueBytes_;
+    }
+  }
+  for (const auto row : rows) {
+    *sizes[row] = fixedSize;
+  }
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    const auto& child = children_[i];
+    if (child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      child.addStringSizes(decoded_, rows, sizes);
+      continue;
+    }
+    for (const auto row : rows) {
+      const auto childIndex = decoded_.index(row);
+      if (!child.isNullAt(childIndex)) {
+        *sizes[row] += child.variableWidthRowSize(childIndex);
+      }
+    }
+  }
+}
+
+void CompactRow::addStringSizes(
+    const DecodedVector& parent,
+    const folly::Range<const vector_size_t*>& rows,
+    vector_size_t** sizes) const {
+  if (parent.isIdentityMapping() && decoded_.isIdentityMapping() &&
+      !decoded_.mayHaveNulls()) {
+    const auto* rawValues = decoded_.data<StringView>();
+    for (const auto row : rows) {
+      *sizes[row] += kSizeBytes + rawValues[row].size();
+    }
+    return;
+  }
+  for (const auto row : rows) {
+    const auto index = parent.index(row);
+    if (!decoded_.isNullAt(index)) {
+      *sizes[row] += kSizeBytes + decoded_.valueAt<StringView>(index).size();
+    }
   }
 }
 
@@ -769,14 +839,46 @@ VectorPtr deserializeFixedWidth(
   using T = typename TypeTraits<Kind>::NativeType;
 
   const auto numRows = data.size();
-  auto flatVector = BaseVector::create<FlatVector<T>>(type, numRows, pool);
-
   auto* rawNulls = nulls->as<uint64_t>();
+  const bool hasNulls = !bits::isAllSet(rawNulls, 0, numRows);
 
-  for (auto i = 0; i < numRows; ++i) {
-    const bool isNull = bits::isBitNull(rawNulls, i);
-    readFixedWidthValue<T>(
-        isNull, data[i].data() + offsets[i], flatVector.get(), i);
+  // Write the values directly and share 'nulls' instead of setting values and
+  // null flags one by one.
+  auto flatVector = std::make_shared<FlatVector<T>>(
+      pool,
+      type,
+      hasNulls ? nulls : nullptr,
+      numRows,
+      AlignedBuffer::allocate<T>(numRows, pool),
+      std::vector<BufferPtr>{});
+  auto* rawValues = flatVector->mutableRawValues();
+  const auto readValue = [&](vector_size_t row) {
+    const auto* buffer = data[row].data() + offsets[row];
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      int64_t micros;
+      ::memcpy(&micros, buffer, sizeof(int64_t));
+      rawValues[row] = Timestamp::fromMicros(micros);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      bits::setBit(rawValues, row, *buffer != 0);
+    } else {
+      ::memcpy(&rawValues[row], buffer, sizeof(T));
+    }
+  };
+  if (!hasNulls) {
+    for (auto i = 0; i < numRows; ++i) {
+      readValue(i);
+    }
+  } else {
+    // The value of a null struct is not serialized, so null rows must not be
+    // read.
+    if constexpr (std::is_same_v<T, bool>) {
+      ::memset(rawValues, 0, bits::nbytes(numRows));
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      if (!bits::isBitNull(rawNulls, i)) {
+        readValue(i);
+      }
+    }
   }
 
   return flatVector;
@@ -844,13 +946,20 @@ VectorPtr deserializeFixedWidthArrays(
   return flatVector;
 }
 
+// Copies the string unless 'noCopy' is true, in which case 'buffer' must be
+// kept alive by the string buffers of 'flatVector'.
 int32_t readString(
     const char* buffer,
     FlatVector<StringView>* flatVector,
-    vector_size_t index) {
+    vector_size_t index,
+    bool noCopy) {
   int32_t size = readInt32(buffer);
   StringView value(buffer + kSizeBytes, size);
-  flatVector->set(index, value);
+  if (noCopy) {
+    flatVector->setNoCopy(index, value);
+  } else {
+    flatVector->set(index, value);
+  }
   return kSizeBytes + size;
 }
 
@@ -872,10 +981,12 @@ VectorPtr deserializeStrings(
     const std::vector<std::string_view>& data,
     const BufferPtr& nulls,
     std::vector<size_t>& offsets,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const std::vector<BufferPtr>& stringBuffers) {
   const auto numRows = data.size();
   auto flatVector =
       BaseVector::create<FlatVector<StringView>>(type, numRows, pool);
+  const bool noCopy = !stringBuffers.empty();
 
   auto* rawNulls = nulls->as<uint64_t>();
 
@@ -883,10 +994,13 @@ VectorPtr deserializeStrings(
     if (bits::isBitNull(rawNulls, i)) {
       flatVector->setNull(i, true);
     } else {
-      offsets[i] +=
-          readString(data[i].data() + offsets[i], flatVector.get(), i);
+      offsets[i] += readString(
+          data[i].data() + offsets[i], flatVector.get(), i, noCopy);
     }
   }
+  if (noCopy) {
+    flatVector->setStringBuffers(stringBuffers);
+  }
 
   return flatVector;
 }
@@ -915,7 +1029,8 @@ VectorPtr deserializeStringArrays(
     const std::vector<std::string_view>& data,
     const BufferPtr& sizes,
     std::vector<size_t>& offsets,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const std::vector<BufferPtr>& stringBuffers) {
   const auto numRows = data.size();
   auto* rawSizes = sizes->as<vector_size_t>();
 
@@ -923,6 +1038,7 @@ VectorPtr deserializeStringArrays(
 
   auto flatVector =
       BaseVector::create<FlatVector<StringView>>(type, total, pool);
+  const bool noCopy = !stringBuffers.empty();
 
   vector_size_t index = 0;
   for (auto i = 0; i < numRows; ++i) {
@@ -938,13 +1054,16 @@ VectorPtr deserializeStringArrays(
         if (bits::isBitSet(rawElementNulls, j)) {
           flatVector->setNull(index++, true);
         } else {
-          offsets[i] +=
-              readString(data[i].data() + offsets[i], flatVector.get(), index);
+          offsets[i] += readString(
+              data[i].data() + offsets[i], flatVector.get(), index, noCopy);
           ++index;
         }
       }
     }
   }
+  if (noCopy) {
+    flatVector->setStringBuffers(stringBuffers);
+  }
 
   return flatVector;
 }
@@ -954,7 +1073,8 @@ VectorPtr deserialize(
     const std::vector<std::string_view>& data,
     const BufferPtr& nulls,
     std::vector<size_t>& offsets,
-    memory::MemoryPool* pool);
+    memory::MemoryPool* pool,
+    const std::vector<BufferPtr>& stringBuffers);
 
 // Deserializes multiple arrays from each 'row' in 'data'.
 // Each set of arrays starts at data[row].data() + offsets[row] and contains
@@ -969,7 +1089,8 @@ VectorPtr deserializeComplexArrays(
     const std::vector<std::string_view>& data,
     const BufferPtr& sizes,
     std::vector<size_t>& offsets,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const std::vector<BufferPtr>& stringBuffers) {
   const auto numRows = data.size();
   auto* rawSizes = sizes->as<vector_size_t>();
 
@@ -1010,7 +1131,8 @@ VectorPtr deserializeComplexArrays(
     }
   }
 
-  return deserialize(type, nestedData, nulls, nestedOffsets, pool);
+  return deserialize(
+      type, nestedData, nulls, nestedOffsets, pool, stringBuffers);
 }
 
 // Deserializes one array from each 'row' in 'data'.
@@ -1024,7 +1146,8 @@ ArrayVectorPtr deserializeArrays(
     const std::vector<std::string_view>& data,
     const BufferPtr& nulls,
     std::vector<size_t>& offsets,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const std::vector<BufferPtr>& stringBuffers) {
   const auto numRows = data.size();
 
   auto* rawNulls = nulls->as<uint64_t>();
@@ -1068,13 +1191,13 @@ ArrayVectorPtr deserializeArrays(
       case TypeKind::VARCHAR:
       case TypeKind::VARBINARY:
         elements = deserializeStringArrays(
-            elementType, data, arraySizes, offsets, pool);
+            elementType, data, arraySizes, offsets, pool, stringBuffers);
         break;
       case TypeKind::ARRAY:
       case TypeKind::MAP:
       case TypeKind::ROW:
         elements = deserializeComplexArrays(
-            elementType, data, arraySizes, offsets, pool);
+            elementType, data, arraySizes, offsets, pool, stringBuffers);
         break;
       default:
         VELOX_UNREACHABLE("{}", elementType->toString());
@@ -1094,13 +1217,14 @@ VectorPtr deserializeMaps(
     const std::vector<std::string_view>& data,
     const BufferPtr& nulls,
     std::vector<size_t>& offsets,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const std::vector<BufferPtr>& stringBuffers) {
   auto arrayOfKeysType = ARRAY(type->childAt(0));
   auto arrayOfValuesType = ARRAY(type->childAt(1));
-  auto arrayOfKeys =
-      deserializeArrays(arrayOfKeysType, data, nulls, offsets, pool);
-  auto arrayOfValues =
-      deserializeArrays(arrayOfValuesType, data, nulls, offsets, pool);
+  auto arrayOfKeys = deserializeArrays(
+      arrayOfKeysType, data, nulls, offsets, pool, stringBuffers);
+  auto arrayOfValues = deserializeArrays(
+      arrayOfValuesType, data, nulls, offsets, pool, stringBuffers);
 
   return std::make_shared<MapVector>(
       pool,
@@ -1118,7 +1242,8 @@ RowVectorPtr deserializeRows(
     const std::vector<std::string_view>& data,
     const BufferPtr& nulls,
     std::vector<size_t>& offsets,
-    memory::MemoryPool* pool);
+    memory::MemoryPool* pool,
+    const std::vector<BufferPtr>& stringBuffers);
 
 // Switches on 'type' and calls type-specific deserialize method to deserialize
 // one value from each 'row' in 'data' starting at the specified offset.
@@ -1130,7 +1255,8 @@ VectorPtr deserialize(
     const std::vector<std::string_view>& data,
     const BufferPtr& nulls,
     std::vector<size_t>& offsets,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const std::vector<BufferPtr>& stringBuffers) {
   const auto typeKind = type->kind();
 
   if (typeKind == TypeKind::UNKNOWN) {
@@ -1144,16 +1270,17 @@ VectorPtr deserialize(
   switch (typeKind) {
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
-      return deserializeStrings(type, data, nulls, offsets, pool);
+      return deserializeStrings(
+          type, data, nulls, offsets, pool, stringBuffers);
       break;
     case TypeKind::ARRAY:
-      return deserializeArrays(type, data, nulls, offsets, pool);
+      return deserializeArrays(type, data, nulls, offsets, pool, stringBuffers);
       break;
     case TypeKind::MAP:
-      return deserializeMaps(type, data, nulls, offsets, pool);
+      return deserializeMaps(type, data, nulls, offsets, pool, stringBuffers);
       break;
     case TypeKind::ROW:
-      return deserializeRows(type, data, nulls, offsets, pool);
+      return deserializeRows(type, data, nulls, offsets, pool, stringBuffers);
       break;
     default:
       VELOX_UNREACHABLE("{}", type->toString());
@@ -1167,7 +1294,8 @@ RowVectorPtr deserializeRows(
     const std::vector<std::string_view>& data,
     const BufferPtr& nulls,
     std::vector<size_t>& offsets,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const std::vector<BufferPtr>& stringBuffers) {
   const auto numRows = data.size();
   const size_t numFields = type->size();
 
@@ -1176,16 +1304,28 @@ RowVectorPtr deserializeRows(
   auto* rawNulls = nulls != nullptr ? nulls->as<uint64_t>() : nullptr;
 
   std::vector<BufferPtr> fieldNulls;
+  std::vector<uint64_t*> rawFieldNulls;
   fieldNulls.reserve(numFields);
+  rawFieldNulls.reserve(numFields);
   for (auto i = 0; i < numFields; ++i) {
     fieldNulls.emplace_back(allocateNulls(numRows, pool));
-    auto* rawFieldNulls = fieldNulls.back()->asMutable<uint8_t>();
-    for (auto row = 0; row < numRows; ++row) {
-      auto* serializedNulls = readNulls(data[row].data() + offsets[row]);
-      const auto isNull =
-          (rawNulls != nullptr && bits::isBitNull(rawNulls, row)) ||
-          bits::isBitSet(serializedNulls, i);
-      bits::setBit(rawFieldNulls, row, !isNull);
+    rawFieldNulls.push_back(fieldNulls.back()->asMutable<uint64_t>());
+  }
+
+  // Gather the null flags of all fields row by row, so that the serialized
+  // flags of each row are read once.
+  for (auto row = 0; row < numRows; ++row) {
+    if (rawNulls != nullptr && bits::isBitNull(rawNulls, row)) {
+      for (auto i = 0; i < numFields; ++i) {
+        bits::setNull(rawFieldNulls[i], row, true);
+      }
+      continue;
+    }
+    const auto* serializedNulls = readNulls(data[row].data() + offsets[row]);
+    for (auto i = 0; i < numFields; ++i) {
+      if (bits::isBitSet(serializedNulls, i)) {
+        bits::setNull(rawFieldNulls[i], row, true);
+      }
     }
   }
 
@@ -1199,7 +1339,8 @@ RowVectorPtr deserializeRows(
 
   for (auto i = 0; i < numFields; ++i) {
     const auto& child = type->childAt(i);
-    auto field = deserialize(child, data, fieldNulls[i], offsets, pool);
+    auto field = deserialize(
+        child, data, fieldNulls[i], offsets, pool, stringBuffers);
     // If 'field' is fixed-width, advance offsets for rows where top-level
     // struct is not null.
     if (auto numBytes = fixedValueSize(child)) {
@@ -1224,11 +1365,12 @@ RowVectorPtr deserializeRows(
 RowVectorPtr CompactRow::deserialize(
     const std::vector<std::string_view>& data,
     const RowTypePtr& rowType,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const std::vector<BufferPtr>& stringBuffers) {
   const auto numRows = data.size();
   std::vector<size_t> offsets(numRows, 0);
 
-  return deserializeRows(rowType, data, nullptr, offsets, pool);
+  return deserializeRows(rowType, data, nullptr, offsets, pool, stringBuffers);
 }
 
 } // namespace facebook::velox::row
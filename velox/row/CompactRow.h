@@ -24,9 +24,8 @@ class CompactRow {
  public:
   explicit CompactRow(const RowVectorPtr& vector);
 
-  /// Returns the serialized sizes of the rows at specified indexes.
-  ///
-  /// TODO: optimizes using columnar serialization size calculation.
+  /// Returns the serialized sizes of the rows at specified indexes. The sizes
+  /// are computed column by column.
   void serializedRowSizes(
       const folly::Range<const vector_size_t*>& rows,
       vector_size_t** sizes) const;
@@ -56,11 +55,15 @@ class CompactRow {
       char* buffer) const;
 
   /// Deserializes multiple rows into a RowVector of specified type. The type
-  /// must match the contents of the serialized rows.
+  /// must match the contents of the serialized rows. If 'stringBuffers' is not
+  /// empty, 'data' must point into these buffers. Strings then reference 'data'
+  /// instead of being copied and the string vectors hold on to
+  /// 'stringBuffers'.
   static RowVectorPtr deserialize(
       const std::vector<std::string_view>& data,
       const RowTypePtr& rowType,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      const std::vector<BufferPtr>& stringBuffers = {});
 
  private:
   explicit CompactRow(const VectorPtr& vector);
@@ -88,6 +91,14 @@ class CompactRow {
   /// Returns serialized size of variable-width row.
   int32_t variableWidthRowSize(vector_size_t index) const;
 
+  /// VARCHAR and VARBINARY only. Adds the serialized size of the value of each
+  /// of 'rows' of the parent struct to '*sizes[row]'. 'parent' maps the rows
+  /// to the indices of this vector.
+  void addStringSizes(
+      const DecodedVector& parent,
+      const folly::Range<const vector_size_t*>& rows,
+      vector_size_t** sizes) const;
+
   /// Writes variable-width value at specified index into 'buffer'. Value must
   /// not be null. Returns number of bytes written to 'buffer'.
   int32_t serializeVariableWidth(vector_size_t index, char* buffer) const;
@@ -617,7 +617,8 @@ struct UnsafeRowDeserializer {
    */
   static VectorPtr convertMapIteratorsToVectors(
       const DataBatchIteratorPtr& dataIterator,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      const std::vector<BufferPtr>& stringBuffers) {
     const TypePtr& type = dataIterator->type();
     assert(type->isMap());
 
@@ -637,8 +638,16 @@ struct UnsafeRowDeserializer {
         numMaps,
         offsets,
         lengths,
-        deserialize(keysIterator->nextColumnBatch(), type->childAt(0), pool),
-        deserialize(valuesIterator->nextColumnBatch(), type->childAt(1), pool),
+        deserialize(
+            keysIterator->nextColumnBatch(),
+            type->childAt(0),
+            pool,
+            stringBuffers),
+        deserialize(
+            valuesIterator->nextColumnBatch(),
+            type->childAt(1),
+            pool,
+            stringBuffers),
         nullCount);
   }
 
@@ -651,7 +660,8 @@ struct UnsafeRowDeserializer {
    */
   static VectorPtr convertArrayIteratorsToVectors(
       const DataBatchIteratorPtr& dataIterator,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      const std::vector<BufferPtr>& stringBuffers) {
     const TypePtr& type = dataIterator->type();
     assert(type->isArray());
 
@@ -678,7 +688,8 @@ struct UnsafeRowDeserializer {
         numArrays,
         offsets,
         lengths,
-        deserialize(iteratorPtr->nextColumnBatch(), elementType, pool),
+        deserialize(
+            iteratorPtr->nextColumnBatch(), elementType, pool, stringBuffers),
         nullCount);
   }
 
@@ -690,7 +701,8 @@ struct UnsafeRowDeserializer {
    */
   static VectorPtr convertStructIteratorsToVectors(
       const DataBatchIteratorPtr& dataIterator,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      const std::vector<BufferPtr>& stringBuffers) {
     const TypePtr& type = dataIterator->type();
     assert(type->isRow());
     auto* StructBatchIteratorPtr =
@@ -704,7 +716,10 @@ struct UnsafeRowDeserializer {
     std::vector<VectorPtr> columnVectors(numFields);
     for (size_t i = 0; i < numFields; ++i) {
       columnVectors[i] = deserialize(
-          StructBatchIteratorPtr->nextColumnBatch(), rowType.childAt(i), pool);
+          StructBatchIteratorPtr->nextColumnBatch(),
+          rowType.childAt(i),
+          pool,
+          stringBuffers);
     }
 
     return std::make_shared<RowVector>(
@@ -724,7 +739,8 @@ struct UnsafeRowDeserializer {
   static VectorPtr createFlatVector(
       const DataBatchIteratorPtr& dataIterator,
       const TypePtr& type,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      const std::vector<BufferPtr>& stringBuffers) {
     auto iterator =
         std::dynamic_pointer_cast<PrimitiveBatchIterator>(dataIterator);
     size_t size = iterator->numRows();
@@ -745,7 +761,11 @@ struct UnsafeRowDeserializer {
           StringView val =
               UnsafeRowPrimitiveBatchDeserializer::deserializeStringView(
                   iterator->next().value());
-          TypeTraits::set(flatResult, i, val);
+          if (stringBuffers.empty()) {
+            TypeTraits::set(flatResult, i, val);
+          } else {
+            flatResult->setNoCopy(i, val);
+          }
         } else if constexpr (std::is_same_v<T, int128_t>) {
           int128_t val =
               UnsafeRowPrimitiveBatchDeserializer::deserializeLongDecimal(
@@ -760,6 +780,11 @@ struct UnsafeRowDeserializer {
         }
       }
     }
+    if constexpr (std::is_same_v<T, StringView>) {
+      if (!stringBuffers.empty()) {
+        flatResult->setStringBuffers(stringBuffers);
+      }
+    }
     return vector;
   }
 
@@ -794,7 +819,8 @@ struct UnsafeRowDeserializer {
    */
   static VectorPtr convertPrimitiveIteratorsToVectors(
       const DataBatchIteratorPtr& dataIterator,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      const std::vector<BufferPtr>& stringBuffers) {
     const TypePtr& type = dataIterator->type();
     assert(type->isPrimitiveType());
 
@@ -803,22 +829,29 @@ struct UnsafeRowDeserializer {
     }
 
     return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
-        createFlatVector, type->kind(), dataIterator, type, pool);
+        createFlatVector,
+        type->kind(),
+        dataIterator,
+        type,
+        pool,
+        stringBuffers);
   }
 
   static VectorPtr convertToVectors(
       const DataBatchIteratorPtr& dataIterator,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      const std::vector<BufferPtr>& stringBuffers) {
     const TypePtr& type = dataIterator->type();
 
     if (type->isPrimitiveType()) {
-      return convertPrimitiveIteratorsToVectors(dataIterator, pool);
+      return convertPrimitiveIteratorsToVectors(
+          dataIterator, pool, stringBuffers);
     } else if (type->isRow()) {
-      return convertStructIteratorsToVectors(dataIterator, pool);
+      return convertStructIteratorsToVectors(dataIterator, pool, stringBuffers);
     } else if (type->isArray()) {
-      return convertArrayIteratorsToVectors(dataIterator, pool);
+      return convertArrayIteratorsToVectors(dataIterator, pool, stringBuffers);
     } else if (type->isMap()) {
-      return convertMapIteratorsToVectors(dataIterator, pool);
+      return convertMapIteratorsToVectors(dataIterator, pool, stringBuffers);
     } else {
       VELOX_NYI("Unsupported data iterators type");
     }
@@ -847,13 +880,17 @@ struct UnsafeRowDeserializer {
    * @param type the element type.
    * @param pool the memory pool to allocate Vectors from
    *data to a array.
+   * @param stringBuffers if not empty, the buffers 'data' points into. Strings
+   * then reference 'data' instead of being copied.
    * @return a VectorPtr
    */
   static VectorPtr deserialize(
       const std::vector<std::optional<std::string_view>>& data,
       const TypePtr& type,
-      memory::MemoryPool* pool) {
-    return convertToVectors(getBatchIteratorPtr(data, type), pool);
+      memory::MemoryPool* pool,
+      const std::vector<BufferPtr>& stringBuffers = {}) {
+    return convertToVectors(
+        getBatchIteratorPtr(data, type), pool, stringBuffers);
   }
 };
 
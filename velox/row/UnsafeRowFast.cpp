@@ -133,8 +133,50 @@ void UnsafeRowFast::serializedRowSizes(
     return;
   }
 
-  for (const auto& row : rows) {
-    *sizes[row] = rowSize(row) + sizeof(TRowSize);
+  // Null flags and the 8 byte field slots take the same space in every row.
+  // Add the variable-width fields column by column.
+  const int32_t fixedSize =
+      rowNullBytes_ + children_.size() * kFieldWidth + sizeof(TRowSize);
+  for (const auto row : rows) {
+    *sizes[row] = fixedSize;
+  }
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    const auto& child = children_[i];
+    if (child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      child.addStringSizes(decoded_, rows, sizes);
+      continue;
+    }
+    for (const auto row : rows) {
+      const auto childIndex = decoded_.index(row);
+      if (!child.isNullAt(childIndex)) {
+        *sizes[row] += alignBytes(child.variableWidthRowSize(childIndex));
+      }
+    }
+  }
+}
+
+void UnsafeRowFast::addStringSizes(
+    const DecodedVector& parent,
+    const folly::Range<const vector_size_t*>& rows,
+    vector_size_t** sizes) const {
+  if (parent.isIdentityMapping() && decoded_.isIdentityMapping() &&
+      !decoded_.mayHaveNulls()) {
+    const auto* rawValues = decoded_.data<StringView>();
+    for (const auto row : rows) {
+      *sizes[row] += alignBytes(rawValues[row].size());
+    }
+    return;
+  }
+  for (const auto row : rows) {
+    const auto index = parent.index(row);
+    if (!decoded_.isNullAt(index)) {
+      *sizes[row] += alignBytes(decoded_.valueAt<StringView>(index).size());
+    }
   }
 }
 
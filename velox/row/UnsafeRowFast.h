@@ -24,9 +24,8 @@ class UnsafeRowFast {
  public:
   explicit UnsafeRowFast(const RowVectorPtr& vector);
 
-  /// Returns the serialized sizes of the rows at specified row indexes.
-  ///
-  /// TODO: optimizes using columnar serialization size calculation.
+  /// Returns the serialized sizes of the rows at specified row indexes. The
+  /// sizes are computed column by column.
   void serializedRowSizes(
       const folly::Range<const vector_size_t*>& rows,
       vector_size_t** sizes) const;
@@ -69,6 +68,14 @@ class UnsafeRowFast {
   /// Returns serialized size of variable-width row.
   int32_t variableWidthRowSize(vector_size_t index) const;
 
+  /// VARCHAR and VARBINARY only. Adds the serialized size of the value of each
+  /// of 'rows' of the parent struct to '*sizes[row]'. 'parent' maps the rows
+  /// to the indices of this vector.
+  void addStringSizes(
+      const DecodedVector& parent,
+      const folly::Range<const vector_size_t*>& rows,
+      vector_size_t** sizes) const;
+
   /// Writes variable-width value at specified index into 'buffer'. Value must
   /// not be null. Returns number of bytes written to 'buffer'.
   int32_t serializeVariableWidth(vector_size_t index, char* buffer) const;
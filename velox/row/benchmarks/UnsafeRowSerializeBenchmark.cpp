@@ -15,6 +15,7 @@
  */
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
+#include <numeric>
 
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/ContainerRowSerde.h"
@@ -89,6 +90,24 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(copy->size(), data->size());
   }
 
+  void rowSizesUnsafe(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    UnsafeRowFast fast(data);
+    computeRowSizes(fast, data->size());
+  }
+
+  void rowSizesCompact(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    CompactRow compact(data);
+    computeRowSizes(compact, data->size());
+  }
+
   void serializeContainer(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -129,6 +148,20 @@ class SerializeBenchmark {
     return fuzzer.fuzzInputRow(rowType);
   }
 
+  template <typename T>
+  void computeRowSizes(T& row, vector_size_t numRows) {
+    std::vector<vector_size_t> rows(numRows);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::vector<vector_size_t> sizes(numRows);
+    std::vector<vector_size_t*> sizePtrs(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      sizePtrs[i] = &sizes[i];
+    }
+    row.serializedRowSizes(
+        folly::Range(rows.data(), numRows), sizePtrs.data());
+    folly::doNotOptimizeAway(sizes);
+  }
+
   size_t computeTotalSize(
       UnsafeRowFast& unsafeRow,
       const RowTypePtr& rowType,
@@ -235,6 +268,16 @@ class SerializeBenchmark {
     benchmark.serializeCompact(rowType);     \
   }                                          \
                                              \
+  BENCHMARK(unsafe_row_sizes_##name) {       \
+    SerializeBenchmark benchmark;            \
+    benchmark.rowSizesUnsafe(rowType);       \
+  }                                          \
+                                             \
+  BENCHMARK(compact_row_sizes_##name) {      \
+    SerializeBenchmark benchmark;            \
+    benchmark.rowSizesCompact(rowType);      \
+  }                                          \
+                                             \
   BENCHMARK(container_serialize_##name) {    \
     SerializeBenchmark benchmark;            \
     benchmark.serializeContainer(rowType);   \
@@ -523,6 +523,90 @@ TEST_F(CompactRowTest, row) {
   testRoundTrip(data);
 }
 
+TEST_F(CompactRowTest, columnarPaths) {
+  // Sizing, serializing and deserializing go column by column, with separate
+  // paths for flat fields without nulls. Compare them with the row by row
+  // results for flat and dictionary encoded fields, with no, some and only
+  // nulls, at sizes around a 64 bit word of null flags.
+  static const std::vector<std::string> kStrings = {
+      "", "a", "Abc", "Longer test string", "Another string over 12 bytes"};
+  for (const vector_size_t size : {1, 63, 64, 65, 200}) {
+    for (const auto nullEveryN : {0, 3, 1}) {
+      for (const auto wrap : {false, true}) {
+        SCOPED_TRACE(fmt::format(
+            "size {}, nullEvery {}, wrap {}", size, nullEveryN, wrap));
+        const auto isNullAt =
+            nullEveryN == 0 ? nullptr : nullEvery(nullEveryN);
+        std::vector<VectorPtr> children = {
+            makeFlatVector<bool>(
+                size, [](auto row) { return row % 3 == 1; }, isNullAt),
+            makeFlatVector<int32_t>(
+                size, [](auto row) { return row * 7; }, isNullAt),
+            makeFlatVector<int64_t>(
+                size, [](auto row) { return row * 1'000'003; }, isNullAt),
+            makeFlatVector<Timestamp>(
+                size, [](auto row) { return ts(row * 1'001); }, isNullAt),
+            makeFlatVector<StringView>(
+                size,
+                [](auto row) {
+                  return StringView(kStrings[row % kStrings.size()]);
+                },
+                isNullAt),
+            makeArrayVector<int64_t>(
+                size,
+                [](auto row) { return row % 4; },
+                [](auto row, auto index) { return row + index; },
+                isNullAt),
+        };
+        if (wrap) {
+          for (auto& child : children) {
+            child = wrapInDictionary(makeIndicesInReverse(size), child);
+          }
+        }
+        const auto data = makeRowVector(children);
+        testRoundTrip(data);
+
+        CompactRow row(data);
+        // Sizes of every other row.
+        std::vector<vector_size_t> rows;
+        for (auto i = 0; i < size; i += 2) {
+          rows.push_back(i);
+        }
+        std::vector<vector_size_t> sizes(size, -1);
+        std::vector<vector_size_t*> sizePointers(size);
+        for (auto i = 0; i < size; ++i) {
+          sizePointers[i] = &sizes[i];
+        }
+        row.serializedRowSizes(
+            folly::Range(rows.data(), rows.size()), sizePointers.data());
+        for (auto i = 0; i < size; ++i) {
+          if (i % 2 == 0) {
+            ASSERT_EQ(sizes[i], row.rowSize(i) + sizeof(uint32_t)) << i;
+          } else {
+            ASSERT_EQ(sizes[i], -1) << i;
+          }
+        }
+
+        // Serializing all rows at once writes the same bytes as serializing
+        // them one by one.
+        std::vector<size_t> offsets(size);
+        size_t totalSize = 0;
+        for (auto i = 0; i < size; ++i) {
+          offsets[i] = totalSize;
+          totalSize += row.rowSize(i);
+        }
+        std::string byRow(totalSize, '\0');
+        std::string byRange(totalSize, '\0');
+        for (auto i = 0; i < size; ++i) {
+          row.serialize(i, byRow.data() + offsets[i]);
+        }
+        row.serialize(0, size, offsets.data(), byRange.data());
+        ASSERT_EQ(byRow, byRange);
+      }
+    }
+  }
+}
+
 TEST_F(CompactRowTest, fuzz) {
   auto rowType = ROW({
       ROW({BIGINT(), VARCHAR(), DOUBLE()}),
@@ -195,5 +195,72 @@ TEST_F(UnsafeRowFuzzTests, fast) {
   });
 }
 
+class UnsafeRowFastTest : public ::testing::Test, public VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+};
+
+TEST_F(UnsafeRowFastTest, serializedRowSizes) {
+  // The sizes are computed column by column, with a separate path for flat
+  // strings without nulls. Compare them with the sizes of single rows for
+  // flat and dictionary encoded fields, with no, some and only nulls.
+  static const std::vector<std::string> kStrings = {
+      "", "a", "Abc", "Longer test string", "Another string over 12 bytes"};
+  for (const vector_size_t size : {1, 63, 64, 65, 200}) {
+    for (const auto nullEveryN : {0, 3, 1}) {
+      for (const auto wrap : {false, true}) {
+        SCOPED_TRACE(fmt::format(
+            "size {}, nullEvery {}, wrap {}", size, nullEveryN, wrap));
+        const auto isNullAt =
+            nullEveryN == 0 ? nullptr : nullEvery(nullEveryN);
+        std::vector<VectorPtr> children = {
+            makeFlatVector<int64_t>(
+                size, [](auto row) { return row * 1'000'003; }, isNullAt),
+            makeFlatVector<StringView>(
+                size,
+                [](auto row) {
+                  return StringView(kStrings[row % kStrings.size()]);
+                },
+                isNullAt),
+            makeArrayVector<int64_t>(
+                size,
+                [](auto row) { return row % 4; },
+                [](auto row, auto index) { return row + index; },
+                isNullAt),
+        };
+        if (wrap) {
+          for (auto& child : children) {
+            child = wrapInDictionary(makeIndicesInReverse(size), child);
+          }
+        }
+        const auto data = makeRowVector(children);
+        UnsafeRowFast fast(data);
+
+        // Sizes of every other row.
+        std::vector<vector_size_t> rows;
+        for (auto i = 0; i < size; i += 2) {
+          rows.push_back(i);
+        }
+        std::vector<vector_size_t> sizes(size, -1);
+        std::vector<vector_size_t*> sizePointers(size);
+        for (auto i = 0; i < size; ++i) {
+          sizePointers[i] = &sizes[i];
+        }
+        fast.serializedRowSizes(
+            folly::Range(rows.data(), rows.size()), sizePointers.data());
+        for (auto i = 0; i < size; ++i) {
+          if (i % 2 == 0) {
+            ASSERT_EQ(sizes[i], fast.rowSize(i) + sizeof(uint32_t)) << i;
+          } else {
+            ASSERT_EQ(sizes[i], -1) << i;
+          }
+        }
+      }
+    }
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::row
@@ -15,6 +15,11 @@
  */
 
 #include "velox/runner/LocalRunner.h"
+
+#include <folly/futures/Future.h>
+
+#include <thread>
+
 #include "velox/common/time/Timer.h"
 
 #include "velox/connectors/hive/HiveConnectorSplit.h"
@@ -39,37 +44,16 @@ RowVectorPtr LocalRunner::next() {
   return cursor_->current();
 }
 
-namespace {
-std::vector<exec::Split> listAllSplits(std::shared_ptr<SplitSource> source) {
-  std::vector<exec::Split> result;
-  for (;;) {
-    auto splits = source->getSplits(std::numeric_limits<uint64_t>::max());
-    VELOX_CHECK(!splits.empty());
-    for (auto& split : splits) {
-      if (split.split == nullptr) {
-        return result;
-        break;
-      }
-      result.push_back(exec::Split(std::move(split.split)));
-    }
-  }
-  VELOX_UNREACHABLE();
-}
-} // namespace
-
 void LocalRunner::start() {
   VELOX_CHECK_EQ(state_, State::kInitialized);
+  enableInProcessShuffle();
   auto lastStage = makeStages();
   params_.planNode = plan_->fragments().back().fragment.planNode;
   auto cursor = exec::TaskCursor::create(params_);
   stages_.push_back({cursor->task()});
   // Add table scan splits to the final gathere stage.
   for (auto& scan : fragments_.back().scans) {
-    auto splits = listAllSplits(splitSourceForScan(*scan));
-    for (auto& split : splits) {
-      cursor->task()->addSplit(scan->id(), std::move(split));
-    }
-    cursor->task()->noMoreSplits(scan->id());
+    addSplitsAsync(*scan, {cursor->task()});
   }
   // If the plan only has the final gather stage, there are no shuffles between
   // the last
@@ -96,11 +80,87 @@ void LocalRunner::start() {
   }
 }
 
+void LocalRunner::enableInProcessShuffle() {
+  auto configs = params_.queryCtx->queryConfig().rawConfigsCopy();
+  if (configs.count(core::QueryConfig::kInProcessShuffleEnabled) > 0) {
+    return;
+  }
+  // No Task of the query exists yet, so the config can be replaced.
+  configs[core::QueryConfig::kInProcessShuffleEnabled] = "true";
+  params_.queryCtx->testingOverrideConfigUnsafe(std::move(configs));
+}
+
+int32_t LocalRunner::driversPerTask(const ExecutableFragment& fragment) const {
+  if (options_.numDrivers > 0) {
+    return options_.numDrivers;
+  }
+  const int32_t numCores =
+      std::max<int32_t>(1, std::thread::hardware_concurrency());
+  return std::max<int32_t>(1, numCores / std::max<int32_t>(1, fragment.width));
+}
+
 std::shared_ptr<SplitSource> LocalRunner::splitSourceForScan(
     const core::TableScanNode& scan) {
   return splitSourceFactory_->splitSourceForScan(scan);
 }
 
+void LocalRunner::addSplitsAsync(
+    const core::TableScanNode& scan,
+    std::vector<std::shared_ptr<exec::Task>> tasks) {
+  VELOX_CHECK_NOT_NULL(
+      splitExecutor_, "LocalRunner needs an executor to add splits");
+  auto future =
+      folly::via(
+          splitExecutor_,
+          [self = shared_from_this(),
+           this,
+           scanId = scan.id(),
+           source = splitSourceForScan(scan),
+           tasks = std::move(tasks)]() {
+            try {
+              int32_t taskIdx = 0;
+              for (;;) {
+                if (hasError()) {
+                  // The tasks are aborted and do not need more splits.
+                  return;
+                }
+                auto splits = source->getSplits(kSplitBatchBytes);
+                VELOX_CHECK(!splits.empty());
+                for (auto& split : splits) {
+                  if (split.split == nullptr) {
+                    for (auto& task : tasks) {
+                      task->noMoreSplits(scanId);
+                    }
+                    return;
+                  }
+                  tasks[taskIdx]->addSplit(
+                      scanId, exec::Split(std::move(split.split)));
+                  taskIdx = (taskIdx + 1) % tasks.size();
+                }
+              }
+            } catch (const std::exception&) {
+              setError(std::current_exception());
+            }
+          })
+          .semi();
+  std::lock_guard<std::mutex> l(mutex_);
+  splitFutures_.push_back(std::move(future));
+}
+
+void LocalRunner::setError(std::exception_ptr error) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (error_) {
+      return;
+    }
+    state_ = State::kError;
+    error_ = error;
+  }
+  if (cursor_) {
+    abort();
+  }
+}
+
 void LocalRunner::abort() {
   // If called without previous error, we set the error to be cancellation.
   if (!error_) {
@@ -129,6 +189,9 @@ void LocalRunner::waitForCompletion(int32_t maxWaitUs) {
   std::vector<ContinueFuture> futures;
   {
     std::lock_guard<std::mutex> l(mutex_);
+    // The split sources reference the tasks, so wait for them first.
+    futures = std::move(splitFutures_);
+    splitFutures_.clear();
     for (auto& stage : stages_) {
       for (auto& task : stage) {
         futures.push_back(task->taskDeletionFuture());
@@ -154,17 +217,7 @@ LocalRunner::makeStages() {
   std::unordered_map<std::string, int32_t> stageMap;
   auto sharedRunner = shared_from_this();
   auto onError = [self = sharedRunner, this](std::exception_ptr error) {
-    {
-      std::lock_guard<std::mutex> l(mutex_);
-      if (error_) {
-        return;
-      }
-      state_ = State::kError;
-      error_ = error;
-    }
-    if (cursor_) {
-      abort();
-    }
+    setError(std::move(error));
   };
 
   for (auto fragmentIndex = 0; fragmentIndex < fragments_.size() - 1;
@@ -190,7 +243,7 @@ LocalRunner::makeStages() {
       stages_.back().push_back(task);
       // Output buffers are created during Task::start(), so we must start the
       // task before calling updateOutputBuffers().
-      task->start(options_.numDrivers);
+      task->start(driversPerTask(fragment));
       if (fragment.numBroadcastDestinations) {
         // TODO: Add support for Arbitrary partition type.
         task->updateOutputBuffers(fragment.numBroadcastDestinations, true);
@@ -202,34 +255,7 @@ LocalRunner::makeStages() {
        ++fragmentIndex) {
     auto& fragment = fragments_[fragmentIndex];
     for (auto& scan : fragment.scans) {
-      auto source = splitSourceForScan(*scan);
-      std::vector<SplitSource::SplitAndGroup> splits;
-      int32_t splitIdx = 0;
-      auto getNextSplit = [&]() {
-        if (splitIdx < splits.size()) {
-          return exec::Split(std::move(splits[splitIdx++].split));
-        }
-        splits = source->getSplits(std::numeric_limits<int64_t>::max());
-        splitIdx = 1;
-        return exec::Split(std::move(splits[0].split));
-      };
-
-      bool allDone = false;
-      do {
-        for (auto i = 0; i < stages_[fragmentIndex].size(); ++i) {
-          auto split = getNextSplit();
-          if (!split.hasConnectorSplit()) {
-            allDone = true;
-            break;
-          }
-          stages_[fragmentIndex][i]->addSplit(scan->id(), std::move(split));
-        }
-      } while (!allDone);
-    }
-    for (auto& scan : fragment.scans) {
-      for (auto i = 0; i < stages_[fragmentIndex].size(); ++i) {
-        stages_[fragmentIndex][i]->noMoreSplits(scan->id());
-      }
+      addSplitsAsync(*scan, stages_[fragmentIndex]);
     }
 
     for (auto& input : fragment.inputStages) {
@@ -58,18 +58,32 @@ class SimpleSplitSourceFactory : public SplitSourceFactory {
       nodeSplitMap_;
 };
 
-/// Runner for in-process execution of a distributed plan.
+/// Runner for in-process execution of a distributed plan. All the fragments
+/// run concurrently, each in 'width' Tasks. The Tasks pass vectors instead of
+/// serialized pages to the Tasks consuming their output, see
+/// QueryConfig::kInProcessShuffleEnabled, which the runner sets in the
+/// QueryCtx unless the QueryCtx sets it explicitly. The splits of each table
+/// scan are fetched from its SplitSource and added to the Tasks of the scan on
+/// 'splitExecutor' while the Tasks run.
 class LocalRunner : public Runner,
                     public std::enable_shared_from_this<LocalRunner> {
  public:
+  /// The number of bytes of splits to request from a SplitSource at a time.
+  static constexpr uint64_t kSplitBatchBytes = 256 << 20;
+
+  /// 'splitExecutor' runs the calls to SplitSource::getSplits(), which may
+  /// block. Defaults to the executor of 'queryCtx'. Must outlive the runner.
   LocalRunner(
       MultiFragmentPlanPtr plan,
       std::shared_ptr<core::QueryCtx> queryCtx,
-      std::shared_ptr<SplitSourceFactory> splitSourceFactory)
+      std::shared_ptr<SplitSourceFactory> splitSourceFactory,
+      folly::Executor* splitExecutor = nullptr)
       : plan_(std::move(plan)),
         fragments_(plan_->fragments()),
         options_(plan_->options()),
-        splitSourceFactory_(std::move(splitSourceFactory)) {
+        splitSourceFactory_(std::move(splitSourceFactory)),
+        splitExecutor_(
+            splitExecutor != nullptr ? splitExecutor : queryCtx->executor()) {
     params_.queryCtx = std::move(queryCtx);
   }
 
@@ -88,12 +102,36 @@ class LocalRunner : public Runner,
  private:
   void start();
 
+  // Sets QueryConfig::kInProcessShuffleEnabled in the QueryCtx unless it is
+  // already set.
+  void enableInProcessShuffle();
+
+  // Returns the number of Drivers to run in each Task of 'fragment', which is
+  // not the final fragment. Divides the cores of the host between the Tasks
+  // of 'fragment' if Options::numDrivers is 0.
+  int32_t driversPerTask(const ExecutableFragment& fragment) const;
+
   // Creates all stages except for the single worker final consumer stage.
   std::vector<std::shared_ptr<exec::RemoteConnectorSplit>> makeStages();
   std::shared_ptr<SplitSource> splitSourceForScan(
       const core::TableScanNode& scan);
 
-  // Serializes 'cursor_' and 'error_'.
+  // Adds the splits of 'scan' to 'tasks' in round robin order on
+  // 'splitExecutor_', followed by noMoreSplits().
+  void addSplitsAsync(
+      const core::TableScanNode& scan,
+      std::vector<std::shared_ptr<exec::Task>> tasks);
+
+  // Records the first error of the execution and aborts the Tasks if the
+  // execution has started.
+  void setError(std::exception_ptr error);
+
+  bool hasError() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return error_ != nullptr;
+  }
+
+  // Serializes 'cursor_', 'error_' and 'splitFutures_'.
   mutable std::mutex mutex_;
 
   const MultiFragmentPlanPtr plan_;
@@ -108,6 +146,10 @@ class LocalRunner : public Runner,
   std::vector<std::vector<std::shared_ptr<exec::Task>>> stages_;
   std::exception_ptr error_;
   std::shared_ptr<SplitSourceFactory> splitSourceFactory_;
+  folly::Executor* const splitExecutor_;
+
+  // Fulfilled when the splits of a table scan have all been added.
+  std::vector<ContinueFuture> splitFutures_;
 };
 
 } // namespace facebook::velox::runner
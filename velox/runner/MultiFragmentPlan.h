@@ -71,7 +71,9 @@ class MultiFragmentPlan {
     int32_t numWorkers;
 
     /// Number of threads in a fragment in a worker. If 1, there are no local
-    /// exchanges.
+    /// exchanges. If 0, the fragments except the last must be correct with
+    /// any number of threads and the Runner sizes their threads to the host.
+    /// The last fragment then runs in one thread.
     int32_t numDrivers;
   };
 
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <thread>
+
 #include "velox/exec/tests/utils/DistributedPlanBuilder.h"
 #include "velox/exec/tests/utils/LocalRunnerTestBase.h"
 #include "velox/exec/tests/utils/QueryAssertions.h"
@@ -95,9 +97,10 @@ class LocalRunnerTest : public LocalRunnerTestBase {
 
   MultiFragmentPlanPtr makeJoinPlan(
       std::string project = "c0",
-      bool broadcastBuild = false) {
+      bool broadcastBuild = false,
+      int32_t numDrivers = 2) {
     MultiFragmentPlan::Options options = {
-        .queryId = "test.", .numWorkers = 4, .numDrivers = 2};
+        .queryId = "test.", .numWorkers = 4, .numDrivers = numDrivers};
     const int32_t width = 3;
 
     DistributedPlanBuilder rootBuilder(options, idGenerator_, pool_.get());
@@ -217,5 +220,34 @@ TEST_F(LocalRunnerTest, broadcast) {
   localRunner->waitForCompletion(kWaitTimeoutUs);
 }
 
+TEST_F(LocalRunnerTest, hostSizedDrivers) {
+  auto plan = makeJoinPlan("c0", false, /*numDrivers=*/0);
+  const auto fragments = plan->fragments();
+  const std::string id = "q1";
+  auto rootPool = makeRootPool(id);
+  auto queryCtx = makeQueryCtx(id, rootPool.get());
+  auto splitSourceFactory = makeSimpleSplitSourceFactory(plan);
+  auto localRunner = std::make_shared<LocalRunner>(
+      std::move(plan), queryCtx, splitSourceFactory, schemaExecutor_.get());
+  auto results = readCursor(localRunner);
+  EXPECT_EQ(1, results.size());
+  EXPECT_EQ(
+      kNumRows, results[0]->childAt(0)->as<FlatVector<int64_t>>()->valueAt(0));
+  results.clear();
+  EXPECT_TRUE(queryCtx->queryConfig().inProcessShuffleEnabled());
+
+  // The cores of the host are divided between the tasks of each fragment.
+  const int32_t numCores =
+      std::max<int32_t>(1, std::thread::hardware_concurrency());
+  auto stats = localRunner->stats();
+  ASSERT_EQ(fragments.size(), stats.size());
+  for (auto i = 0; i < fragments.size() - 1; ++i) {
+    const auto numDrivers = std::max<int32_t>(1, numCores / fragments[i].width);
+    EXPECT_EQ(
+        stats[i].pipelineStats.size() * numDrivers, stats[i].numTotalDrivers);
+  }
+  localRunner->waitForCompletion(kWaitTimeoutUs);
+}
+
 } // namespace
 } // namespace facebook::velox::runner
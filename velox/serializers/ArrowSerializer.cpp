@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ArrowSerializer.h"
+
+#include <arrow/buffer.h>
+#include <arrow/c/bridge.h>
+#include <arrow/io/interfaces.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/util/compression.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+using TStreamSize = int32_t;
+
+// Fixed size of the schema, record batch and end of stream messages, on top of
+// the column buffers.
+constexpr int64_t kStreamOverhead = 1 << 10;
+constexpr int64_t kColumnOverhead = 256;
+
+void checkArrowStatus(const arrow::Status& status, const char* action) {
+  VELOX_CHECK(
+      status.ok(), "Arrow IPC failed to {}: {}", action, status.ToString());
+}
+
+template <typename T>
+T checkArrowResult(arrow::Result<T> result, const char* action) {
+  checkArrowStatus(result.status(), action);
+  return std::move(result).ValueUnsafe();
+}
+
+std::shared_ptr<arrow::util::Codec> toArrowCodec(
+    common::CompressionKind kind) {
+  switch (kind) {
+    case common::CompressionKind::CompressionKind_NONE:
+      return nullptr;
+    case common::CompressionKind::CompressionKind_LZ4:
+      return checkArrowResult(
+          arrow::util::Codec::Create(arrow::Compression::LZ4_FRAME),
+          "create LZ4 codec");
+    case common::CompressionKind::CompressionKind_ZSTD:
+      return checkArrowResult(
+          arrow::util::Codec::Create(arrow::Compression::ZSTD),
+          "create ZSTD codec");
+    default:
+      VELOX_UNSUPPORTED(
+          "Arrow IPC supports only LZ4 and ZSTD compression: {}",
+          common::compressionKindToString(kind));
+  }
+}
+
+// Adapts a Velox OutputStream for the Arrow IPC writer. Positions are relative
+// to the start of the IPC stream.
+class ArrowOutputStream : public arrow::io::OutputStream {
+ public:
+  explicit ArrowOutputStream(velox::OutputStream* out) : out_(out) {}
+
+  arrow::Status Close() override {
+    closed_ = true;
+    return arrow::Status::OK();
+  }
+
+  bool closed() const override {
+    return closed_;
+  }
+
+  arrow::Result<int64_t> Tell() const override {
+    return position_;
+  }
+
+  arrow::Status Write(const void* data, int64_t nbytes) override {
+    out_->write(static_cast<const char*>(data), nbytes);
+    position_ += nbytes;
+    return arrow::Status::OK();
+  }
+
+  using arrow::io::OutputStream::Write;
+
+ private:
+  velox::OutputStream* const out_;
+  int64_t position_{0};
+  bool closed_{false};
+};
+
+// Arrow buffer over memory of a Velox buffer, so that the IPC reader can slice
+// the uncompressed columns out of memory that is tracked by a Velox pool.
+class VeloxArrowBuffer : public arrow::Buffer {
+ public:
+  explicit VeloxArrowBuffer(BufferPtr buffer)
+      : arrow::Buffer(buffer->as<uint8_t>(), buffer->size()),
+        buffer_(std::move(buffer)) {}
+
+ private:
+  const BufferPtr buffer_;
+};
+
+// Returns true if the columns of 'vector' can be exported without copying.
+// Arrow has no constant encoding for complex types.
+bool canExportDirectly(const RowVector& vector) {
+  for (const auto& child : vector.children()) {
+    if (child->isConstantEncoding() && !child->type()->isPrimitiveType()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+class ArrowVectorSerializer : public IterativeVectorSerializer {
+ public:
+  ArrowVectorSerializer(
+      RowTypePtr type,
+      memory::MemoryPool* pool,
+      const VectorSerde::Options* options)
+      : type_(std::move(type)), pool_(pool) {
+    const auto* arrowOptions =
+        dynamic_cast<const ArrowVectorSerde::ArrowSerdeOptions*>(options);
+    exportOptions_.flattenDictionary = true;
+    exportOptions_.flattenConstant = true;
+    exportOptions_.exportToStringView =
+        arrowOptions == nullptr || arrowOptions->exportToStringView;
+    writeOptions_ = arrow::ipc::IpcWriteOptions::Defaults();
+    if (options != nullptr) {
+      writeOptions_.codec = toArrowCodec(options->compressionKind);
+    }
+  }
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      Scratch& /*scratch*/) override {
+    if (ranges.empty()) {
+      return;
+    }
+    if (ranges.size() == 1 && canExportDirectly(*vector)) {
+      // Keep a reference to the input buffers instead of copying them.
+      if (ranges[0].size > 0) {
+        batches_.push_back(
+            {std::static_pointer_cast<RowVector>(
+                 vector->slice(ranges[0].begin, ranges[0].size)),
+             false});
+      }
+      return;
+    }
+    auto& target = copyTarget();
+    std::vector<BaseVector::CopyRange> copyRanges;
+    copyRanges.reserve(ranges.size());
+    vector_size_t targetIndex = target->size();
+    for (const auto& range : ranges) {
+      copyRanges.push_back({range.begin, targetIndex, range.size});
+      targetIndex += range.size;
+    }
+    target->resize(targetIndex);
+    target->copyRanges(vector.get(), copyRanges);
+  }
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const vector_size_t*>& rows,
+      Scratch& scratch) override {
+    std::vector<IndexRange> ranges;
+    for (auto row : rows) {
+      if (!ranges.empty() && ranges.back().begin + ranges.back().size == row) {
+        ++ranges.back().size;
+      } else {
+        ranges.push_back({row, 1});
+      }
+    }
+    append(vector, folly::Range(ranges.data(), ranges.size()), scratch);
+  }
+
+  bool supportsAppendRows() const override {
+    return true;
+  }
+
+  size_t maxSerializedSize() const override {
+    size_t size =
+        sizeof(TStreamSize) + kStreamOverhead + kColumnOverhead * type_->size();
+    for (const auto& batch : batches_) {
+      size += kStreamOverhead + batch.vector->estimateFlatSize();
+    }
+    return size;
+  }
+
+  void flush(OutputStream* out) override {
+    const auto offset = out->tellp();
+    TStreamSize size{0};
+    out->write(reinterpret_cast<const char*>(&size), sizeof(size));
+
+    ArrowOutputStream arrowOut(out);
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+    if (batches_.empty()) {
+      writer = makeWriter(
+          &arrowOut,
+          toRecordBatch(BaseVector::create<RowVector>(type_, 0, pool_))
+              ->schema());
+    }
+    for (const auto& batch : batches_) {
+      auto recordBatch = toRecordBatch(batch.vector);
+      if (writer == nullptr) {
+        writer = makeWriter(&arrowOut, recordBatch->schema());
+      }
+      checkArrowStatus(
+          writer->WriteRecordBatch(*recordBatch), "write record batch");
+    }
+    checkArrowStatus(writer->Close(), "close stream");
+
+    const int64_t streamSize = checkArrowResult(arrowOut.Tell(), "tell");
+    VELOX_CHECK_LE(streamSize, std::numeric_limits<TStreamSize>::max());
+    size = streamSize;
+    out->seekp(offset);
+    out->write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out->seekp(offset + static_cast<std::streamoff>(sizeof(size) + size));
+    batches_.clear();
+  }
+
+  void clear() override {
+    batches_.clear();
+  }
+
+ private:
+  struct Batch {
+    RowVectorPtr vector;
+    // True if 'vector' is owned by 'this' and more rows can be copied into it.
+    bool copied;
+  };
+
+  // Returns the batch to copy rows of non-contiguous appends into.
+  RowVectorPtr& copyTarget() {
+    if (batches_.empty() || !batches_.back().copied) {
+      batches_.push_back(
+          {BaseVector::create<RowVector>(type_, 0, pool_), true});
+    }
+    return batches_.back().vector;
+  }
+
+  std::shared_ptr<arrow::RecordBatch> toRecordBatch(
+      const RowVectorPtr& vector) {
+    ArrowSchema arrowSchema;
+    ArrowArray arrowArray;
+    exportToArrow(vector, arrowSchema, exportOptions_);
+    exportToArrow(vector, arrowArray, pool_, exportOptions_);
+    return checkArrowResult(
+        arrow::ImportRecordBatch(&arrowArray, &arrowSchema),
+        "import record batch");
+  }
+
+  std::shared_ptr<arrow::ipc::RecordBatchWriter> makeWriter(
+      arrow::io::OutputStream* out,
+      const std::shared_ptr<arrow::Schema>& schema) {
+    return checkArrowResult(
+        arrow::ipc::MakeStreamWriter(out, schema, writeOptions_),
+        "create stream writer");
+  }
+
+  const RowTypePtr type_;
+  memory::MemoryPool* const pool_;
+  ::ArrowOptions exportOptions_;
+  arrow::ipc::IpcWriteOptions writeOptions_;
+  std::vector<Batch> batches_;
+};
+
+} // namespace
+
+void ArrowVectorSerde::estimateSerializedSize(
+    const BaseVector* vector,
+    const folly::Range<const vector_size_t*>& rows,
+    vector_size_t** sizes,
+    Scratch& /*scratch*/) {
+  // The Arrow layout has no per row overhead, so every row is charged the
+  // average flat size.
+  const auto rowSize =
+      vector->estimateFlatSize() / std::max<vector_size_t>(1, vector->size());
+  for (auto i = 0; i < rows.size(); ++i) {
+    *sizes[i] += rowSize;
+  }
+}
+
+void ArrowVectorSerde::estimateSerializedSize(
+    const BaseVector* vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes,
+    Scratch& /*scratch*/) {
+  const auto rowSize =
+      vector->estimateFlatSize() / std::max<vector_size_t>(1, vector->size());
+  for (auto i = 0; i < ranges.size(); ++i) {
+    *sizes[i] += rowSize * ranges[i].size;
+  }
+}
+
+std::unique_ptr<IterativeVectorSerializer>
+ArrowVectorSerde::createIterativeSerializer(
+    RowTypePtr type,
+    int32_t /*numRows*/,
+    StreamArena* streamArena,
+    const Options* options) {
+  return std::make_unique<ArrowVectorSerializer>(
+      std::move(type), streamArena->pool(), options);
+}
+
+void ArrowVectorSerde::deserialize(
+    ByteInputStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    vector_size_t resultOffset,
+    const Options* /*options*/) {
+  VELOX_CHECK_GE(resultOffset, 0);
+  const auto size = source->read<TStreamSize>();
+  VELOX_CHECK_GE(size, 0);
+  auto buffer = AlignedBuffer::allocate<uint8_t>(size, pool);
+  source->readBytes(buffer->asMutable<uint8_t>(), size);
+
+  auto reader = checkArrowResult(
+      arrow::ipc::RecordBatchStreamReader::Open(
+          std::make_shared<arrow::io::BufferReader>(
+              std::make_shared<VeloxArrowBuffer>(std::move(buffer)))),
+      "open stream reader");
+
+  std::vector<RowVectorPtr> batches;
+  vector_size_t numRows = 0;
+  for (;;) {
+    auto recordBatch = checkArrowResult(reader->Next(), "read record batch");
+    if (recordBatch == nullptr) {
+      break;
+    }
+    ArrowSchema arrowSchema;
+    ArrowArray arrowArray;
+    checkArrowStatus(
+        arrow::ExportSchema(*recordBatch->schema(), &arrowSchema),
+        "export schema");
+    checkArrowStatus(
+        arrow::ExportRecordBatch(*recordBatch, &arrowArray),
+        "export record batch");
+    auto batch = std::static_pointer_cast<RowVector>(
+        importFromArrowAsOwner(arrowSchema, arrowArray, pool));
+    VELOX_CHECK(
+        batch->type()->equivalent(*type),
+        "Arrow IPC stream type {} does not match {}",
+        batch->type()->toString(),
+        type->toString());
+    numRows += batch->size();
+    batches.push_back(std::move(batch));
+  }
+
+  if (resultOffset == 0 && batches.size() == 1) {
+    // Use the imported columns as is, with the names of 'type'.
+    *result = std::make_shared<RowVector>(
+        pool, type, nullptr, numRows, batches[0]->children());
+    return;
+  }
+  if (*result == nullptr || resultOffset == 0) {
+    *result = BaseVector::create<RowVector>(type, numRows, pool);
+  } else {
+    VELOX_CHECK_LE(resultOffset, (*result)->size());
+    if (BaseVector::isVectorWritable(*result)) {
+      (*result)->resize(resultOffset + numRows);
+    } else {
+      // 'result' references imported Arrow memory. Copy it once into vectors
+      // that can grow.
+      auto copy =
+          BaseVector::create<RowVector>(type, resultOffset + numRows, pool);
+      copy->copy(result->get(), 0, 0, resultOffset);
+      *result = std::move(copy);
+    }
+  }
+  auto offset = resultOffset;
+  for (const auto& batch : batches) {
+    (*result)->copy(batch.get(), offset, 0, batch->size());
+    offset += batch->size();
+  }
+}
+
+// static
+void ArrowVectorSerde::registerVectorSerde() {
+  velox::registerVectorSerde(std::make_unique<ArrowVectorSerde>());
+}
+
+// static
+void ArrowVectorSerde::registerNamedVectorSerde() {
+  velox::registerNamedVectorSerde(
+      VectorSerde::Kind::kArrow, std::make_unique<ArrowVectorSerde>());
+}
+
+} // namespace facebook::velox::serializer
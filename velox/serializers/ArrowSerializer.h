@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::serializer {
+
+/// Serializes vectors as Arrow IPC streams, for exchanging data with Arrow
+/// consumers. Each flush writes a 4 byte length followed by one IPC stream with
+/// a schema message and one record batch per appended batch. The columns are
+/// exported through the Arrow bridge, so flat Velox buffers are written to the
+/// stream without converting them row by row. Only LZ4 and ZSTD compression
+/// are supported, as these are the codecs of the Arrow IPC format.
+class ArrowVectorSerde : public VectorSerde {
+ public:
+  struct ArrowSerdeOptions : public VectorSerde::Options {
+    ArrowSerdeOptions() = default;
+
+    ArrowSerdeOptions(
+        common::CompressionKind _compressionKind,
+        bool _exportToStringView)
+        : VectorSerde::Options(_compressionKind, 0.8),
+          exportToStringView(_exportToStringView) {}
+
+    /// Writes VARCHAR and VARBINARY columns in the Arrow "utf8_view" and
+    /// "binary_view" layouts, which share the layout of Velox StringViews.
+    /// Consumers that predate Arrow 15 need this off.
+    bool exportToStringView{true};
+  };
+
+  ArrowVectorSerde() : VectorSerde(VectorSerde::Kind::kArrow) {}
+
+  void estimateSerializedSize(
+      const BaseVector* vector,
+      const folly::Range<const vector_size_t*>& rows,
+      vector_size_t** sizes,
+      Scratch& scratch) override;
+
+  void estimateSerializedSize(
+      const BaseVector* vector,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t** sizes,
+      Scratch& scratch) override;
+
+  std::unique_ptr<IterativeVectorSerializer> createIterativeSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const Options* options) override;
+
+  bool supportsAppendInDeserialize() const override {
+    return true;
+  }
+
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override {
+    deserialize(source, pool, type, result, 0, options);
+  }
+
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      vector_size_t resultOffset,
+      const Options* options) override;
+
+  static void registerVectorSerde();
+  static void registerNamedVectorSerde();
+};
+
+} // namespace facebook::velox::serializer
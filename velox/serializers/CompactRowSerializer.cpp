@@ -89,16 +89,17 @@ void CompactRowVectorSerde::deserialize(
     RowVectorPtr* result,
     const Options* options) {
   std::vector<std::string_view> serializedRows;
-  std::vector<std::unique_ptr<std::string>> serializedBuffers;
-  RowDeserializer<std::string_view>::deserialize<RowIteratorImpl>(
-      source, serializedRows, serializedBuffers, options);
+  std::vector<BufferPtr> serializedBuffers;
+  RowDeserializer<std::string_view>::deserialize(
+      source, pool, serializedRows, serializedBuffers, options);
 
   if (serializedRows.empty()) {
     *result = BaseVector::create<RowVector>(type, 0, pool);
     return;
   }
 
-  *result = row::CompactRow::deserialize(serializedRows, type, pool);
+  *result = row::CompactRow::deserialize(
+      serializedRows, type, pool, serializedBuffers);
 }
 
 // static
@@ -25,7 +25,8 @@ class PrestoBatchVectorSerializer : public BatchVectorSerializer {
       memory::MemoryPool* pool,
       const PrestoVectorSerde::PrestoOptions& opts)
       : pool_(pool),
-        codec_(common::compressionKindToCodec(opts.compressionKind)),
+        codec_(common::compressionKindToCodec(
+            opts.compressionKind, opts.compressionDictionary.get())),
         opts_(opts) {}
 
   void serialize(
@@ -18,6 +18,89 @@
 #include "velox/serializers/PrestoSerializerSerializationUtils.h"
 
 namespace facebook::velox::serializer::presto::detail {
+namespace {
+template <typename T>
+void scatterFlatValues(
+    const FlatVector<T>* vector,
+    vector_size_t numRows,
+    const uint32_t* destinations,
+    const std::vector<VectorStream*>& streams) {
+  const auto* rawValues = vector->rawValues();
+  const auto* rawNulls = vector->rawNulls();
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    auto* stream = streams[destinations[row]];
+    if (stream == nullptr) {
+      continue;
+    }
+    if (rawNulls != nullptr && bits::isBitNull(rawNulls, row)) {
+      stream->appendNull();
+      continue;
+    }
+    stream->appendNonNull();
+    stream->appendOne(rawValues[row]);
+  }
+}
+
+// Appends each of the first 'numRows' of 'vector' to the stream of its
+// destination. Returns false if 'vector' is not a flat vector of a fixed width
+// type that is serialized as is.
+bool scatterFlatColumn(
+    const VectorPtr& vector,
+    vector_size_t numRows,
+    const uint32_t* destinations,
+    const std::vector<VectorStream*>& streams) {
+  if (vector->encoding() != VectorEncoding::Simple::FLAT) {
+    return false;
+  }
+  switch (vector->typeKind()) {
+    case TypeKind::TINYINT:
+      scatterFlatValues(
+          vector->asUnchecked<FlatVector<int8_t>>(),
+          numRows,
+          destinations,
+          streams);
+      return true;
+    case TypeKind::SMALLINT:
+      scatterFlatValues(
+          vector->asUnchecked<FlatVector<int16_t>>(),
+          numRows,
+          destinations,
+          streams);
+      return true;
+    case TypeKind::INTEGER:
+      scatterFlatValues(
+          vector->asUnchecked<FlatVector<int32_t>>(),
+          numRows,
+          destinations,
+          streams);
+      return true;
+    case TypeKind::BIGINT:
+      scatterFlatValues(
+          vector->asUnchecked<FlatVector<int64_t>>(),
+          numRows,
+          destinations,
+          streams);
+      return true;
+    case TypeKind::REAL:
+      scatterFlatValues(
+          vector->asUnchecked<FlatVector<float>>(),
+          numRows,
+          destinations,
+          streams);
+      return true;
+    case TypeKind::DOUBLE:
+      scatterFlatValues(
+          vector->asUnchecked<FlatVector<double>>(),
+          numRows,
+          destinations,
+          streams);
+      return true;
+    default:
+      return false;
+  }
+}
+} // namespace
+
 PrestoIterativeVectorSerializer::PrestoIterativeVectorSerializer(
     const RowTypePtr& rowType,
     int32_t numRows,
@@ -25,7 +108,8 @@ PrestoIterativeVectorSerializer::PrestoIterativeVectorSerializer(
     const PrestoVectorSerde::PrestoOptions& opts)
     : opts_(opts),
       streamArena_(streamArena),
-      codec_(common::compressionKindToCodec(opts.compressionKind)),
+      codec_(common::compressionKindToCodec(
+          opts.compressionKind, opts.compressionDictionary.get())),
       streams_(memory::StlAllocator<VectorStream>(*streamArena->pool())) {
   const auto types = rowType->children();
   const auto numTypes = types.size();
@@ -65,6 +149,41 @@ void PrestoIterativeVectorSerializer::append(
   }
 }
 
+void PrestoIterativeVectorSerializer::scatter(
+    const RowVectorPtr& vector,
+    const uint32_t* destinations,
+    const std::vector<folly::Range<const vector_size_t*>>& rows,
+    const std::vector<IterativeVectorSerializer*>& serializers,
+    Scratch& scratch) {
+  const auto numDestinations = serializers.size();
+  VELOX_CHECK_EQ(rows.size(), numDestinations);
+  std::vector<PrestoIterativeVectorSerializer*> targets(numDestinations);
+  for (auto i = 0; i < numDestinations; ++i) {
+    if (serializers[i] != nullptr && !rows[i].empty()) {
+      targets[i] =
+          static_cast<PrestoIterativeVectorSerializer*>(serializers[i]);
+      targets[i]->numRows_ += rows[i].size();
+    }
+  }
+
+  std::vector<VectorStream*> streams(numDestinations);
+  for (int32_t column = 0; column < vector->childrenSize(); ++column) {
+    for (auto i = 0; i < numDestinations; ++i) {
+      streams[i] =
+          targets[i] == nullptr ? nullptr : &targets[i]->streams_[column];
+    }
+    const auto& child = vector->childAt(column);
+    if (scatterFlatColumn(child, vector->size(), destinations, streams)) {
+      continue;
+    }
+    for (auto i = 0; i < numDestinations; ++i) {
+      if (streams[i] != nullptr) {
+        serializeColumn(child, rows[i], streams[i], scratch);
+      }
+    }
+  }
+}
+
 size_t PrestoIterativeVectorSerializer::maxSerializedSize() const {
   size_t dataSize = 4; // streams_.size()
   for (auto& stream : streams_) {
@@ -94,22 +213,29 @@ void PrestoIterativeVectorSerializer::flush(OutputStream* out) {
     if (numCompressionToSkip_ > 0) {
       const auto noCompressionCodec = common::compressionKindToCodec(
           common::CompressionKind::CompressionKind_NONE);
-      auto [size, ignore] = flushStreams(
+      const auto sizes = flushStreams(
           streams_, numRows_, *streamArena_, *noCompressionCodec, 1, out);
-      stats_.compressionSkippedBytes += size;
+      stats_.compressionSkippedBytes += sizes.uncompressedSize;
       --numCompressionToSkip_;
       ++stats_.numCompressionSkipped;
     } else {
-      auto [size, compressedSize] = flushStreams(
+      const auto sizes = flushStreams(
           streams_,
           numRows_,
           *streamArena_,
           *codec_,
           opts_.minCompressionRatio,
           out);
+      const auto size = sizes.uncompressedSize;
+      const auto compressedSize = sizes.compressedSize;
       stats_.compressionInputBytes += size;
       stats_.compressedBytes += compressedSize;
-      if (compressedSize > size * opts_.minCompressionRatio) {
+      if (compressedSize > size * opts_.minCompressionRatio ||
+          !compressionPaysOff(
+              size,
+              compressedSize,
+              sizes.compressionNanos,
+              opts_.compressionBandwidthBytesPerSec)) {
         numCompressionToSkip_ = std::min<int64_t>(
             kMaxCompressionAttemptsToSkip, 1 + stats_.numCompressionSkipped);
       }
@@ -39,6 +39,16 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       const folly::Range<const vector_size_t*>& rows,
       Scratch& scratch) override;
 
+  /// Writes the flat fixed width columns to the streams of all the
+  /// destinations in a single pass over 'vector'. Other columns are appended
+  /// per destination.
+  void scatter(
+      const RowVectorPtr& vector,
+      const uint32_t* destinations,
+      const std::vector<folly::Range<const vector_size_t*>>& rows,
+      const std::vector<IterativeVectorSerializer*>& serializers,
+      Scratch& scratch) override;
+
   size_t maxSerializedSize() const override;
 
   // The SerializedPage layout is:
@@ -137,8 +137,9 @@ void PrestoVectorSerde::deserialize(
     vector_size_t resultOffset,
     const Options* options) {
   const auto prestoOptions = toPrestoOptions(options);
-  const auto codec =
-      common::compressionKindToCodec(prestoOptions.compressionKind);
+  const auto codec = common::compressionKindToCodec(
+      prestoOptions.compressionKind,
+      prestoOptions.compressionDictionary.get());
   auto maybeHeader = detail::PrestoHeader::read(source);
   VELOX_CHECK(
       maybeHeader.hasValue(),
@@ -17,6 +17,7 @@
 #include <folly/IPAddressV6.h>
 
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/time/Timer.h"
 #include "velox/functions/prestosql/types/IPPrefixType.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/serializers/VectorStream.h"
@@ -157,6 +158,9 @@ vector_size_t computeSelectedIndices(
 struct FlushSizes {
   int64_t uncompressedSize;
   int64_t compressedSize;
+  // Time spent in the codec compressing the serialized data. 0 if no
+  // compression was tried.
+  uint64_t compressionNanos{0};
 };
 
 FOLLY_ALWAYS_INLINE bool needCompression(
@@ -309,7 +313,12 @@ inline FlushSizes flushCompressed(
       codec.maxUncompressedLength(),
       "UncompressedSize exceeds limit");
   auto iobuf = out.getIOBuf();
-  const auto compressedBuffer = codec.compress(iobuf.get());
+  uint64_t compressionNanos{0};
+  std::unique_ptr<folly::IOBuf> compressedBuffer;
+  {
+    NanosecondTimer timer(&compressionNanos);
+    compressedBuffer = codec.compress(iobuf.get());
+  }
   const int32_t compressedSize = compressedBuffer->length();
   if (compressedSize > uncompressedSize * minCompressionRatio) {
     flushSerialization(
@@ -320,7 +329,7 @@ inline FlushSizes flushCompressed(
         iobuf,
         output,
         listener);
-    return {uncompressedSize, uncompressedSize};
+    return {uncompressedSize, uncompressedSize, compressionNanos};
   }
   flushSerialization(
       numRows,
@@ -330,7 +339,7 @@ inline FlushSizes flushCompressed(
       compressedBuffer,
       output,
       listener);
-  return {uncompressedSize, compressedSize};
+  return {uncompressedSize, compressedSize, compressionNanos};
 }
 
 template <typename Allocator>
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/time/Timer.h"
 #include "velox/serializers/CompactRowSerializer.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/VectorStream.h"
@@ -180,11 +181,21 @@ class RowSerializer : public IterativeVectorSerializer {
     } else {
       // Compress the buffer if satisfied condition.
       const auto toCompress = toIOBuf(buffers_);
-      const auto compressedBuffer = codec_->compress(toCompress.get());
+      uint64_t compressNanos{0};
+      std::unique_ptr<folly::IOBuf> compressedBuffer;
+      {
+        NanosecondTimer timer(&compressNanos);
+        compressedBuffer = codec_->compress(toCompress.get());
+      }
       const int32_t compressedSize = compressedBuffer->length();
       stats_.compressionInputBytes += size;
       stats_.compressedBytes += compressedSize;
-      if (compressedSize > options_.minCompressionRatio * size) {
+      if (compressedSize > options_.minCompressionRatio * size ||
+          !compressionPaysOff(
+              size,
+              compressedSize,
+              compressNanos,
+              options_.compressionBandwidthBytesPerSec)) {
         // Skip this compression.
         numCompressionToSkip_ = std::min<int64_t>(
             kMaxCompressionAttemptsToSkip, 1 + stats_.numCompressionSkipped);
@@ -284,101 +295,31 @@ class RowSerializer : public IterativeVectorSerializer {
   CompressionStats stats_;
 };
 
-/*
- * RowIterator is an iterator to read deserialize rows from an uncompressed
- * input source. It provides the ability to iterate over the stream by
- * retrieving a serialized buffer containing one row in each iteration.
- *
- * Usage:
- * RowIterator iterator(source, endOffset);
- * while (iterator.hasNext()) {
- *   auto next = iterator.next();
- *   // Process the data in next
- * }
- */
-class RowIterator {
- public:
-  virtual ~RowIterator() = default;
-
-  virtual bool hasNext() const = 0;
-
-  virtual std::unique_ptr<std::string> next() = 0;
-
- protected:
-  RowIterator(ByteInputStream* source, size_t endOffset)
-      : source_(source), endOffset_(endOffset) {}
-
-  ByteInputStream* const source_;
-  const size_t endOffset_;
-};
-
-class RowIteratorImpl : public RowIterator {
- public:
-  RowIteratorImpl(ByteInputStream* source, size_t endOffset)
-      : RowIterator(source, endOffset) {
-    VELOX_CHECK_NOT_NULL(source, "Source cannot be null");
-  }
-
-  bool hasNext() const override {
-    return source_->tellp() < endOffset_;
-  }
-
-  std::unique_ptr<std::string> next() override {
-    const auto rowSize = readRowSize();
-    auto serializedBuffer = std::make_unique<std::string>();
-    serializedBuffer->reserve(rowSize);
-
-    const auto row = source_->nextView(rowSize);
-    serializedBuffer->append(row.data(), row.size());
-    // If we couldn't read the entire row at once, we need to concatenate it
-    // in a different buffer.
-    if (serializedBuffer->size() < rowSize) {
-      concatenatePartialRow(source_, rowSize, *serializedBuffer);
-    }
-
-    VELOX_CHECK_EQ(serializedBuffer->size(), rowSize);
-    return serializedBuffer;
-  }
-
- private:
-  TRowSize readRowSize() {
-    return folly::Endian::big(source_->read<TRowSize>());
-  }
-
-  // Read from the stream until the full row is concatenated.
-  static void concatenatePartialRow(
-      ByteInputStream* source,
-      TRowSize rowSize,
-      std::string& rowBuffer) {
-    while (rowBuffer.size() < rowSize) {
-      const std::string_view rowFragment =
-          source->nextView(rowSize - rowBuffer.size());
-      VELOX_CHECK_GT(
-          rowFragment.size(),
-          0,
-          "Unable to read full serialized row. Needed {} but read {} bytes.",
-          rowSize - rowBuffer.size(),
-          rowFragment.size());
-      rowBuffer.append(rowFragment.data(), rowFragment.size());
-    }
-  }
-};
-
 template <typename SerializeView>
 class RowDeserializer {
  public:
-  template <typename RowIterator>
+  /// Reads all row groups of 'source' and appends a view over each serialized
+  /// row to 'serializedRows'. Each row group is copied once into a buffer
+  /// allocated from 'pool', which is appended to 'serializedBuffers'. The views
+  /// point into these buffers, so deserialized strings can reference them
+  /// instead of being copied again.
   static void deserialize(
       ByteInputStream* source,
+      memory::MemoryPool* pool,
       std::vector<SerializeView>& serializedRows,
-      std::vector<std::unique_ptr<std::string>>& serializedBuffers,
+      std::vector<BufferPtr>& serializedBuffers,
       const VectorSerde::Options* options) {
     const auto compressionKind = options == nullptr
         ? VectorSerde::Options().compressionKind
         : options->compressionKind;
     while (!source->atEnd()) {
-      std::unique_ptr<folly::IOBuf> uncompressedBuf;
       const auto header = detail::RowGroupHeader::read(source);
+      if (header.uncompressedSize == 0) {
+        continue;
+      }
+      auto buffer =
+          AlignedBuffer::allocate<char>(header.uncompressedSize, pool);
+      auto* rawBuffer = buffer->asMutable<char>();
       if (header.compressed) {
         VELOX_DCHECK_NE(
             compressionKind, common::CompressionKind::CompressionKind_NONE);
@@ -386,30 +327,49 @@ class RowDeserializer {
         source->readBytes(compressBuf->writableData(), header.compressedSize);
         compressBuf->append(header.compressedSize);
 
-        // Process chained uncompressed results IOBufs.
         const auto codec = common::compressionKindToCodec(compressionKind);
-        uncompressedBuf =
+        const auto uncompressedBuf =
             codec->uncompress(compressBuf.get(), header.uncompressedSize);
-      }
-
-      std::unique_ptr<ByteInputStream> uncompressedStream;
-      ByteInputStream* uncompressedSource{nullptr};
-      if (uncompressedBuf == nullptr) {
-        uncompressedSource = source;
+        VELOX_CHECK_EQ(
+            uncompressedBuf->computeChainDataLength(), header.uncompressedSize);
+        size_t offset = 0;
+        for (const auto range : *uncompressedBuf) {
+          ::memcpy(rawBuffer + offset, range.data(), range.size());
+          offset += range.size();
+        }
       } else {
-        uncompressedStream = std::make_unique<BufferInputStream>(
-            byteRangesFromIOBuf(uncompressedBuf.get()));
-        uncompressedSource = uncompressedStream.get();
-      }
-      const std::streampos initialSize = uncompressedSource->tellp();
-      RowIterator rowIterator(
-          uncompressedSource, header.uncompressedSize + initialSize);
-      while (rowIterator.hasNext()) {
-        serializedBuffers.emplace_back(std::move(rowIterator.next()));
-        serializedRows.push_back(std::string_view(
-            serializedBuffers.back()->data(),
-            serializedBuffers.back()->size()));
+        source->readBytes(rawBuffer, header.uncompressedSize);
       }
+      splitRows(rawBuffer, header.uncompressedSize, serializedRows);
+      serializedBuffers.push_back(std::move(buffer));
+    }
+  }
+
+ private:
+  // Appends a view over each row of a row group. Each row is preceded by its
+  // size in big endian.
+  static void splitRows(
+      const char* rowGroup,
+      size_t size,
+      std::vector<SerializeView>& serializedRows) {
+    size_t offset = 0;
+    while (offset < size) {
+      VELOX_CHECK_LE(
+          offset + sizeof(TRowSize),
+          size,
+          "Unable to read full serialized row size.");
+      TRowSize rowSize;
+      ::memcpy(&rowSize, rowGroup + offset, sizeof(TRowSize));
+      rowSize = folly::Endian::big(rowSize);
+      offset += sizeof(TRowSize);
+      VELOX_CHECK_LE(
+          offset + rowSize,
+          size,
+          "Unable to read full serialized row. Needed {} but read {} bytes.",
+          rowSize,
+          size - offset);
+      serializedRows.push_back(std::string_view(rowGroup + offset, rowSize));
+      offset += rowSize;
     }
   }
 };
@@ -45,9 +45,9 @@ void UnsafeRowVectorSerde::deserialize(
     RowVectorPtr* result,
     const Options* options) {
   std::vector<std::optional<std::string_view>> serializedRows;
-  std::vector<std::unique_ptr<std::string>> serializedBuffers;
-  RowDeserializer<std::optional<std::string_view>>::deserialize<
-      RowIteratorImpl>(source, serializedRows, serializedBuffers, options);
+  std::vector<BufferPtr> serializedBuffers;
+  RowDeserializer<std::optional<std::string_view>>::deserialize(
+      source, pool, serializedRows, serializedBuffers, options);
 
   if (serializedRows.empty()) {
     *result = BaseVector::create<RowVector>(type, 0, pool);
@@ -56,7 +56,7 @@ void UnsafeRowVectorSerde::deserialize(
 
   *result = std::dynamic_pointer_cast<RowVector>(
       velox::row::UnsafeRowDeserializer::deserialize(
-          serializedRows, type, pool));
+          serializedRows, type, pool, serializedBuffers));
 }
 
 // static
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ArrowSerializer.h"
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+struct TestParam {
+  common::CompressionKind compressionKind;
+  bool exportToStringView;
+};
+
+class ArrowSerializerTest : public ::testing::Test,
+                            public velox::test::VectorTestBase,
+                            public testing::WithParamInterface<TestParam> {
+ public:
+  static std::vector<TestParam> getTestParams() {
+    return {
+        {common::CompressionKind::CompressionKind_NONE, true},
+        {common::CompressionKind::CompressionKind_NONE, false},
+        {common::CompressionKind::CompressionKind_LZ4, true},
+        {common::CompressionKind::CompressionKind_ZSTD, false}};
+  }
+
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    deregisterNamedVectorSerde(VectorSerde::Kind::kArrow);
+    ArrowVectorSerde::registerNamedVectorSerde();
+    serde_ = getNamedVectorSerde(VectorSerde::Kind::kArrow);
+    ASSERT_EQ(serde_->kind(), VectorSerde::Kind::kArrow);
+    options_ = std::make_unique<ArrowVectorSerde::ArrowSerdeOptions>(
+        GetParam().compressionKind, GetParam().exportToStringView);
+  }
+
+  void TearDown() override {
+    deregisterNamedVectorSerde(VectorSerde::Kind::kArrow);
+  }
+
+  std::string serialize(
+      const RowVectorPtr& vector,
+      const std::vector<IndexRange>& ranges) {
+    auto arena = std::make_unique<StreamArena>(pool());
+    auto serializer = serde_->createIterativeSerializer(
+        asRowType(vector->type()), vector->size(), arena.get(), options_.get());
+    serializer->append(vector, folly::Range(ranges.data(), ranges.size()));
+    const auto maxSize = serializer->maxSerializedSize();
+
+    std::ostringstream output;
+    OStreamOutputStream out(&output);
+    serializer->flush(&out);
+    if (GetParam().compressionKind ==
+        common::CompressionKind::CompressionKind_NONE) {
+      EXPECT_GE(maxSize, output.tellp());
+    }
+    return output.str();
+  }
+
+  std::unique_ptr<ByteInputStream> toByteStream(
+      const std::string_view& input,
+      size_t pageSize = 32) {
+    auto rawBytes = reinterpret_cast<uint8_t*>(const_cast<char*>(input.data()));
+    size_t offset = 0;
+    std::vector<ByteRange> ranges;
+
+    // Split the input buffer into many different pages.
+    while (offset < input.length()) {
+      ranges.push_back({
+          rawBytes + offset,
+          std::min<int32_t>(pageSize, input.length() - offset),
+          0,
+      });
+      offset += pageSize;
+    }
+    return std::make_unique<BufferInputStream>(std::move(ranges));
+  }
+
+  RowVectorPtr deserialize(
+      const RowTypePtr& rowType,
+      const std::string_view& input) {
+    auto byteStream = toByteStream(input);
+    RowVectorPtr result;
+    serde_->deserialize(
+        byteStream.get(), pool(), rowType, &result, options_.get());
+    EXPECT_TRUE(byteStream->atEnd());
+    return result;
+  }
+
+  void testRoundTrip(const RowVectorPtr& vector) {
+    const auto rowType = asRowType(vector->type());
+    {
+      SCOPED_TRACE("single range");
+      auto deserialized =
+          deserialize(rowType, serialize(vector, {{0, vector->size()}}));
+      test::assertEqualVectors(vector, deserialized);
+    }
+    {
+      SCOPED_TRACE("multiple ranges");
+      std::vector<IndexRange> ranges;
+      for (auto i = 0; i < vector->size(); i += 2) {
+        ranges.push_back({i, 1});
+      }
+      auto deserialized = deserialize(rowType, serialize(vector, ranges));
+      ASSERT_EQ(ranges.size(), deserialized->size());
+      for (auto i = 0; i < ranges.size(); ++i) {
+        ASSERT_TRUE(deserialized->equalValueAt(vector.get(), i, i * 2));
+      }
+    }
+  }
+
+  VectorSerde* serde_;
+  std::unique_ptr<VectorSerde::Options> options_;
+};
+
+TEST_P(ArrowSerializerTest, roundTrip) {
+  auto data = makeRowVector(
+      {"i", "d", "s", "t", "a", "m", "r"},
+      {
+          makeNullableFlatVector<int64_t>({1, std::nullopt, 3, 4, 5, 6}),
+          makeFlatVector<double>({1.5, 2.5, 3.5, 4.5, 5.5, 6.5}),
+          makeNullableFlatVector<std::string>(
+              {"a",
+               std::nullopt,
+               "a string that is too long to be inlined",
+               "",
+               "another string that is too long to be inlined",
+               "f"}),
+          makeFlatVector<Timestamp>(
+              {Timestamp(0, 0),
+               Timestamp(1, 1'000),
+               Timestamp(2, 0),
+               Timestamp(3, 0),
+               Timestamp(4, 0),
+               Timestamp(5, 0)}),
+          makeArrayVector<int32_t>({{1, 2}, {}, {3}, {4, 5, 6}, {}, {7}}),
+          makeMapVector<int32_t, int64_t>(
+              {{{1, 10}}, {}, {{2, 20}, {3, 30}}, {}, {{4, 40}}, {}}),
+          makeRowVector({makeFlatVector<int32_t>({1, 2, 3, 4, 5, 6})}),
+      });
+  testRoundTrip(data);
+}
+
+TEST_P(ArrowSerializerTest, encodings) {
+  auto flat = makeFlatVector<std::string>(
+      {"one string that is too long to be inlined", "two", "three"});
+  auto data = makeRowVector({
+      wrapInDictionary(makeIndices({2, 1, 0, 2, 1, 0}), 6, flat),
+      makeConstant<int32_t>(7, 6),
+  });
+  auto deserialized =
+      deserialize(asRowType(data->type()), serialize(data, {{0, 6}}));
+  test::assertEqualVectors(data, deserialized);
+}
+
+TEST_P(ArrowSerializerTest, appendInDeserialize) {
+  ASSERT_TRUE(serde_->supportsAppendInDeserialize());
+  auto first = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  auto second = makeRowVector({makeFlatVector<int64_t>({4, 5})});
+  const auto rowType = asRowType(first->type());
+  const auto input =
+      serialize(first, {{0, 3}}) + serialize(second, {{0, 2}});
+
+  auto byteStream = toByteStream(input);
+  RowVectorPtr result;
+  while (!byteStream->atEnd()) {
+    serde_->deserialize(
+        byteStream.get(),
+        pool(),
+        rowType,
+        &result,
+        result == nullptr ? 0 : result->size(),
+        options_.get());
+  }
+  test::assertEqualVectors(
+      makeRowVector({makeFlatVector<int64_t>({1, 2, 3, 4, 5})}), result);
+}
+
+TEST_P(ArrowSerializerTest, empty) {
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  auto deserialized = deserialize(asRowType(data->type()), serialize(data, {}));
+  ASSERT_EQ(0, deserialized->size());
+}
+
+TEST_P(ArrowSerializerTest, unsupportedCompression) {
+  auto arena = std::make_unique<StreamArena>(pool());
+  VectorSerde::Options options(
+      common::CompressionKind::CompressionKind_SNAPPY, 0.8);
+  VELOX_ASSERT_THROW(
+      serde_->createIterativeSerializer(
+          ROW({BIGINT()}), 1, arena.get(), &options),
+      "Arrow IPC supports only LZ4 and ZSTD compression");
+}
+
+VELOX_INSTANTIATE_TEST_SUITE_P(
+    ArrowSerializerTest,
+    ArrowSerializerTest,
+    testing::ValuesIn(ArrowSerializerTest::getTestParams()));
+} // namespace
+} // namespace facebook::velox::serializer
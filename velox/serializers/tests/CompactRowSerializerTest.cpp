@@ -220,6 +220,44 @@ TEST_P(CompactRowSerializerTest, fuzz) {
   testRoundTrip(data);
 }
 
+TEST_P(CompactRowSerializerTest, stringsReferenceSerializedRows) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"a string that is too long to be inlined",
+           std::nullopt,
+           "short",
+           "another string that is too long to be inlined"}),
+      makeArrayVector<std::string>(
+          {{"an array element that is too long to be inlined"}, {}, {}, {}}),
+  });
+
+  std::ostringstream out;
+  serialize(data, &out);
+  auto deserialized = deserialize(asRowType(data->type()), out.str());
+  test::assertEqualVectors(data, deserialized);
+
+  // Strings point into the buffers that hold the serialized rows.
+  const auto isInStringBuffers = [](const FlatVector<StringView>* strings,
+                                    vector_size_t index) {
+    const auto* value = strings->valueAt(index).data();
+    for (const auto& buffer : strings->stringBuffers()) {
+      if (value >= buffer->as<char>() &&
+          value < buffer->as<char>() + buffer->size()) {
+        return true;
+      }
+    }
+    return false;
+  };
+  auto* strings = deserialized->childAt(0)->asFlatVector<StringView>();
+  ASSERT_TRUE(isInStringBuffers(strings, 0));
+  ASSERT_TRUE(isInStringBuffers(strings, 3));
+  auto* elements = deserialized->childAt(1)
+                       ->as<ArrayVector>()
+                       ->elements()
+                       ->asFlatVector<StringView>();
+  ASSERT_TRUE(isInStringBuffers(elements, 0));
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     CompactRowSerializerTest,
     CompactRowSerializerTest,
@@ -383,7 +383,7 @@ TEST_P(UnsafeRowSerializerTest, incompleteRow) {
   buffers = {{rawData, 2}};
   VELOX_ASSERT_RUNTIME_THROW(
       testDeserialize(buffers, expected),
-      "(2 vs. 2) Reading past end of BufferInputStream");
+      "Unable to read full serialized row size");
 }
 
 TEST_P(UnsafeRowSerializerTest, types) {
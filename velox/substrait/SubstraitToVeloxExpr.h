@@ -64,7 +64,21 @@ class SubstraitVeloxExprConverter {
       const ::substrait::Expression::IfThen& substraitIfThen,
       const RowTypePtr& inputType);
 
+  /// If 'recorder' is not nullptr, each Literal converted by toVeloxExpr() is
+  /// added to it with the resulting constant. Used for rebinding literals of
+  /// cached plans.
+  void setLiteralRecorder(
+      std::unordered_map<
+          const ::substrait::Expression::Literal*,
+          core::TypedExprPtr>* recorder) {
+    literalRecorder_ = recorder;
+  }
+
  private:
+  /// Convert Substrait Literal into Velox ConstantTypedExpr.
+  std::shared_ptr<const core::ConstantTypedExpr> literalToVeloxExpr(
+      const ::substrait::Expression::Literal& substraitLit);
+
   /// Convert list literal to ArrayVector.
   ArrayVectorPtr literalsToArrayVector(
       const ::substrait::Expression::Literal& listLiteral);
@@ -79,6 +93,11 @@ class SubstraitVeloxExprConverter {
   /// The map storing the relations between the function id and the function
   /// name.
   std::unordered_map<uint64_t, std::string> functionMap_;
+
+  /// Optional map from converted literals to their constants.
+  std::unordered_map<
+      const ::substrait::Expression::Literal*,
+      core::TypedExprPtr>* literalRecorder_{nullptr};
 };
 
 } // namespace facebook::velox::substrait
@@ -15,6 +15,10 @@
  */
 
 #include "velox/substrait/SubstraitToVeloxPlan.h"
+
+#include <folly/ScopeGuard.h>
+
+#include "velox/substrait/SubstraitToVeloxPlanCache.h"
 #include "velox/substrait/TypeUtils.h"
 #include "velox/substrait/VariantToVectorConverter.h"
 #include "velox/type/Type.h"
@@ -554,6 +558,14 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 
 core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     const ::substrait::Plan& substraitPlan) {
+  if (planCache_) {
+    return planCache_->toVeloxPlan(substraitPlan, *this);
+  }
+  return convertPlan(substraitPlan);
+}
+
+void SubstraitVeloxPlanConverter::initialize(
+    const ::substrait::Plan& substraitPlan) {
   VELOX_CHECK(
       checkTypeExtension(substraitPlan),
       "The type extension only have unknown type.");
@@ -563,6 +575,18 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   // Construct the expression converter.
   exprConverter_ =
       std::make_shared<SubstraitVeloxExprConverter>(pool_, functionMap_);
+}
+
+core::PlanNodePtr SubstraitVeloxPlanConverter::convertPlan(
+    const ::substrait::Plan& substraitPlan,
+    std::unordered_map<
+        const ::substrait::Expression::Literal*,
+        core::TypedExprPtr>* literalRecorder) {
+  initialize(substraitPlan);
+  exprConverter_->setLiteralRecorder(literalRecorder);
+  SCOPE_EXIT {
+    exprConverter_->setLiteralRecorder(nullptr);
+  };
 
   // In fact, only one RelRoot or Rel is expected here.
   VELOX_CHECK_EQ(substraitPlan.relations_size(), 1);
@@ -24,11 +24,17 @@
 
 namespace facebook::velox::substrait {
 
+class SubstraitToVeloxPlanCache;
+
 /// This class is used to convert the Substrait plan into Velox plan.
 class SubstraitVeloxPlanConverter {
  public:
-  explicit SubstraitVeloxPlanConverter(memory::MemoryPool* pool)
-      : pool_(pool) {}
+  /// If 'planCache' is given, toVeloxPlan(const ::substrait::Plan&) reuses
+  /// conversions of plans with the same structure from the cache.
+  explicit SubstraitVeloxPlanConverter(
+      memory::MemoryPool* pool,
+      std::shared_ptr<SubstraitToVeloxPlanCache> planCache = nullptr)
+      : pool_(pool), planCache_(std::move(planCache)) {}
   struct SplitInfo {
     /// The Partition index.
     u_int32_t partitionIndex;
@@ -119,6 +125,21 @@ class SubstraitVeloxPlanConverter {
       const core::PlanNodePtr& noEmitNode);
 
  private:
+  friend class SubstraitToVeloxPlanCache;
+
+  /// Makes the function map and the expression converter for
+  /// 'substraitPlan'.
+  void initialize(const ::substrait::Plan& substraitPlan);
+
+  /// Converts 'substraitPlan' without consulting 'planCache_'. If
+  /// 'literalRecorder' is given, it receives the constant made from each
+  /// converted literal.
+  core::PlanNodePtr convertPlan(
+      const ::substrait::Plan& substraitPlan,
+      std::unordered_map<
+          const ::substrait::Expression::Literal*,
+          core::TypedExprPtr>* literalRecorder = nullptr);
+
   /// Returns unique ID to use for plan node. Produces sequential numbers
   /// starting from zero.
   std::string nextPlanNodeId();
@@ -171,6 +192,9 @@ class SubstraitVeloxPlanConverter {
   /// Memory pool.
   memory::MemoryPool* pool_;
 
+  /// Optional cache of conversions shared between converters.
+  std::shared_ptr<SubstraitToVeloxPlanCache> planCache_;
+
   /// Helper function to convert the input of Substrait Rel to Velox Node.
   template <typename T>
   core::PlanNodePtr convertSingleInput(T rel) {
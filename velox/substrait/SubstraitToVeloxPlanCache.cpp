@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/substrait/SubstraitToVeloxPlanCache.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <unordered_set>
+
+namespace facebook::velox::substrait {
+namespace {
+
+using Literal = ::substrait::Expression::Literal;
+using Bindings =
+    std::unordered_map<const core::ITypedExpr*, core::TypedExprPtr>;
+
+// True for literals that become a scalar constant whose value can be swapped
+// without changing the plan. Null, list and other literals are part of the
+// plan structure.
+bool isLiteralSlot(const Literal& literal) {
+  switch (literal.literal_type_case()) {
+    case Literal::LiteralTypeCase::kBoolean:
+    case Literal::LiteralTypeCase::kI8:
+    case Literal::LiteralTypeCase::kI16:
+    case Literal::LiteralTypeCase::kI32:
+    case Literal::LiteralTypeCase::kI64:
+    case Literal::LiteralTypeCase::kFp32:
+    case Literal::LiteralTypeCase::kFp64:
+    case Literal::LiteralTypeCase::kString:
+    case Literal::LiteralTypeCase::kVarChar:
+    case Literal::LiteralTypeCase::kDate:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Appends the literal slots of 'message' to 'literals' in depth first order
+// of field numbers. Does not descend into literals. The rows of virtual tables
+// are data, not parameters, and stay part of the structure.
+void collectLiterals(
+    const google::protobuf::Message& message,
+    std::vector<const Literal*>& literals) {
+  const auto* descriptor = message.GetDescriptor();
+  if (descriptor == ::substrait::ReadRel::VirtualTable::descriptor()) {
+    return;
+  }
+  if (descriptor == Literal::descriptor()) {
+    const auto& literal = static_cast<const Literal&>(message);
+    if (isLiteralSlot(literal)) {
+      literals.push_back(&literal);
+    }
+    return;
+  }
+  const auto* reflection = message.GetReflection();
+  std::vector<const google::protobuf::FieldDescriptor*> fields;
+  reflection->ListFields(message, &fields);
+  for (const auto* field : fields) {
+    if (field->cpp_type() !=
+        google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+      continue;
+    }
+    if (field->is_repeated()) {
+      auto size = reflection->FieldSize(message, field);
+      for (auto i = 0; i < size; ++i) {
+        collectLiterals(
+            reflection->GetRepeatedMessage(message, field, i), literals);
+      }
+    } else {
+      collectLiterals(reflection->GetMessage(message, field), literals);
+    }
+  }
+}
+
+// Returns 'plan' serialized with the values of its literal slots replaced by
+// a placeholder that keeps the literal type.
+std::string structureKey(const ::substrait::Plan& plan) {
+  ::substrait::Plan masked = plan;
+  std::vector<const Literal*> literals;
+  collectLiterals(masked, literals);
+  for (const auto* constLiteral : literals) {
+    // 'masked' is a local copy, so its literals may be modified.
+    auto* literal = const_cast<Literal*>(constLiteral);
+    auto typeKey = fmt::format("{}", literal->literal_type_case());
+    if (literal->has_var_char()) {
+      typeKey += fmt::format(":{}", literal->var_char().length());
+    }
+    auto nullable = literal->nullable();
+    auto variation = literal->type_variation_reference();
+    literal->Clear();
+    literal->set_nullable(nullable);
+    literal->set_type_variation_reference(variation);
+    literal->set_string(typeKey);
+  }
+  std::string key;
+  {
+    google::protobuf::io::StringOutputStream output(&key);
+    google::protobuf::io::CodedOutputStream coded(&output);
+    coded.SetSerializationDeterministic(true);
+    masked.SerializeToCodedStream(&coded);
+  }
+  return key;
+}
+
+// Copies plans replacing the constants in 'bindings'. Only the expression and
+// plan node kinds made by SubstraitVeloxPlanConverter are supported.
+class Rebinder {
+ public:
+  explicit Rebinder(const Bindings& bindings) : bindings_(bindings) {}
+
+  core::TypedExprPtr rebind(const core::TypedExprPtr& expr) {
+    if (!expr) {
+      return expr;
+    }
+    auto it = bindings_.find(expr.get());
+    if (it != bindings_.end()) {
+      bound_.insert(expr.get());
+      return it->second;
+    }
+    if (expr->inputs().empty()) {
+      return expr;
+    }
+    std::vector<core::TypedExprPtr> inputs;
+    inputs.reserve(expr->inputs().size());
+    bool changed = false;
+    for (const auto& input : expr->inputs()) {
+      inputs.push_back(rebind(input));
+      changed |= inputs.back() != input;
+    }
+    if (!changed) {
+      return expr;
+    }
+    if (auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+      return std::make_shared<core::CallTypedExpr>(
+          call->type(), std::move(inputs), call->name());
+    }
+    if (auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+      return std::make_shared<core::CastTypedExpr>(
+          cast->type(), inputs, cast->nullOnFailure());
+    }
+    if (auto* field =
+            dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+      return std::make_shared<core::FieldAccessTypedExpr>(
+          field->type(), inputs[0], field->name());
+    }
+    supported_ = false;
+    return expr;
+  }
+
+  core::PlanNodePtr rebind(const core::PlanNodePtr& node) {
+    if (auto* project = dynamic_cast<const core::ProjectNode*>(node.get())) {
+      std::vector<core::TypedExprPtr> projections;
+      for (const auto& projection : project->projections()) {
+        projections.push_back(rebind(projection));
+      }
+      return std::make_shared<core::ProjectNode>(
+          project->id(),
+          project->names(),
+          projections,
+          rebind(project->sources()[0]));
+    }
+    if (auto* filter = dynamic_cast<const core::FilterNode*>(node.get())) {
+      return std::make_shared<core::FilterNode>(
+          filter->id(),
+          rebind(filter->filter()),
+          rebind(filter->sources()[0]));
+    }
+    if (auto* aggregation =
+            dynamic_cast<const core::AggregationNode*>(node.get())) {
+      auto aggregates = aggregation->aggregates();
+      for (auto& aggregate : aggregates) {
+        aggregate.call = std::dynamic_pointer_cast<const core::CallTypedExpr>(
+            rebind(aggregate.call));
+      }
+      return std::make_shared<core::AggregationNode>(
+          aggregation->id(),
+          aggregation->step(),
+          aggregation->groupingKeys(),
+          aggregation->preGroupedKeys(),
+          aggregation->aggregateNames(),
+          aggregates,
+          aggregation->globalGroupingSets(),
+          aggregation->groupId(),
+          aggregation->ignoreNullKeys(),
+          rebind(aggregation->sources()[0]));
+    }
+    if (auto* orderBy = dynamic_cast<const core::OrderByNode*>(node.get())) {
+      return std::make_shared<core::OrderByNode>(
+          orderBy->id(),
+          orderBy->sortingKeys(),
+          orderBy->sortingOrders(),
+          orderBy->isPartial(),
+          rebind(orderBy->sources()[0]));
+    }
+    if (auto* topN = dynamic_cast<const core::TopNNode*>(node.get())) {
+      return std::make_shared<core::TopNNode>(
+          topN->id(),
+          topN->sortingKeys(),
+          topN->sortingOrders(),
+          topN->count(),
+          topN->isPartial(),
+          rebind(topN->sources()[0]));
+    }
+    if (auto* limit = dynamic_cast<const core::LimitNode*>(node.get())) {
+      return std::make_shared<core::LimitNode>(
+          limit->id(),
+          limit->offset(),
+          limit->count(),
+          limit->isPartial(),
+          rebind(limit->sources()[0]));
+    }
+    // Leaves are shared with the cached plan. Constants in them, e.g. pushed
+    // down filters, are not rebound and make the entry non-rebindable.
+    if (!dynamic_cast<const core::TableScanNode*>(node.get()) &&
+        !dynamic_cast<const core::ValuesNode*>(node.get())) {
+      supported_ = false;
+    }
+    return node;
+  }
+
+  // True if all constants in bindings were found in supported positions.
+  bool ok() const {
+    return supported_ && bound_.size() == bindings_.size();
+  }
+
+ private:
+  const Bindings& bindings_;
+  std::unordered_set<const core::ITypedExpr*> bound_;
+  bool supported_{true};
+};
+
+std::unordered_map<
+    core::PlanNodeId,
+    std::shared_ptr<SubstraitVeloxPlanConverter::SplitInfo>>
+copySplitInfos(
+    const std::unordered_map<
+        core::PlanNodeId,
+        std::shared_ptr<SubstraitVeloxPlanConverter::SplitInfo>>& splitInfos) {
+  std::unordered_map<
+      core::PlanNodeId,
+      std::shared_ptr<SubstraitVeloxPlanConverter::SplitInfo>>
+      copy;
+  for (const auto& [id, info] : splitInfos) {
+    copy[id] = std::make_shared<SubstraitVeloxPlanConverter::SplitInfo>(*info);
+  }
+  return copy;
+}
+
+} // namespace
+
+core::PlanNodePtr SubstraitToVeloxPlanCache::toVeloxPlan(
+    const ::substrait::Plan& substraitPlan,
+    SubstraitVeloxPlanConverter& converter) {
+  std::vector<const Literal*> literals;
+  collectLiterals(substraitPlan, literals);
+  std::vector<std::string> values;
+  values.reserve(literals.size());
+  for (const auto* literal : literals) {
+    values.push_back(literal->SerializeAsString());
+  }
+  auto key = structureKey(substraitPlan);
+
+  if (auto entry = find(key)) {
+    if (entry->literals == values) {
+      converter.splitInfoMap_ = copySplitInfos(entry->splitInfos);
+      std::lock_guard<std::mutex> l(mutex_);
+      ++stats_.numHits;
+      return entry->plan;
+    }
+    if (!entry->constants.empty()) {
+      converter.initialize(substraitPlan);
+      Bindings bindings;
+      bool sameTypes = true;
+      for (size_t i = 0; i < literals.size(); ++i) {
+        auto constant = converter.exprConverter_->toVeloxExpr(*literals[i]);
+        const auto& old = entry->constants[i];
+        if (!constant->type()->equivalent(*old->type())) {
+          sameTypes = false;
+          break;
+        }
+        bindings[old.get()] = constant;
+      }
+      if (sameTypes) {
+        Rebinder rebinder(bindings);
+        auto plan = rebinder.rebind(entry->plan);
+        if (rebinder.ok()) {
+          converter.splitInfoMap_ = copySplitInfos(entry->splitInfos);
+          std::lock_guard<std::mutex> l(mutex_);
+          ++stats_.numRebinds;
+          return plan;
+        }
+      }
+    }
+  }
+
+  std::unordered_map<const Literal*, core::TypedExprPtr> recorded;
+  auto plan = converter.convertPlan(substraitPlan, &recorded);
+
+  auto entry = std::make_shared<Entry>();
+  entry->plan = plan;
+  entry->splitInfos = copySplitInfos(converter.splitInfoMap_);
+  entry->literals = std::move(values);
+
+  // The entry is rebindable if each literal became a distinct constant and
+  // the rebinder finds all of them.
+  Bindings identity;
+  std::vector<core::TypedExprPtr> constants;
+  for (const auto* literal : literals) {
+    auto it = recorded.find(literal);
+    if (it == recorded.end() || identity.count(it->second.get())) {
+      constants.clear();
+      break;
+    }
+    identity[it->second.get()] = it->second;
+    constants.push_back(it->second);
+  }
+  if (!constants.empty()) {
+    Rebinder rebinder(identity);
+    rebinder.rebind(plan);
+    if (rebinder.ok()) {
+      entry->constants = std::move(constants);
+    }
+  }
+  insert(key, std::move(entry));
+  return plan;
+}
+
+std::shared_ptr<const SubstraitToVeloxPlanCache::Entry>
+SubstraitToVeloxPlanCache::find(const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+  return it->second.entry;
+}
+
+void SubstraitToVeloxPlanCache::insert(
+    const std::string& key,
+    std::shared_ptr<const Entry> entry) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++stats_.numMisses;
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    it->second.entry = std::move(entry);
+    lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+    return;
+  }
+  it = entries_.emplace(key, Slot{std::move(entry), {}}).first;
+  lru_.push_front(&it->first);
+  it->second.lruPosition = lru_.begin();
+  while (entries_.size() > static_cast<size_t>(maxEntries_)) {
+    auto* oldest = lru_.back();
+    lru_.pop_back();
+    entries_.erase(*oldest);
+  }
+}
+
+SubstraitToVeloxPlanCache::Stats SubstraitToVeloxPlanCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+int32_t SubstraitToVeloxPlanCache::size() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return entries_.size();
+}
+
+void SubstraitToVeloxPlanCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+}
+
+} // namespace facebook::velox::substrait
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <list>
+#include <mutex>
+
+#include "velox/substrait/SubstraitToVeloxPlan.h"
+
+namespace facebook::velox::substrait {
+
+/// Caches Substrait to Velox plan conversions by plan structure. Plans that
+/// differ only in the values of scalar literals map to the same entry. A
+/// repeated submission with the same literals returns the cached Velox plan.
+/// One with different literals gets the cached plan with the constants
+/// replaced, without converting the Substrait plan again. An entry is
+/// rebindable only if all its literals end up as constants in expressions of
+/// plan nodes the cache can rebuild. Otherwise it matches only the same
+/// literal values. Shared between SubstraitVeloxPlanConverters. Thread-safe.
+class SubstraitToVeloxPlanCache {
+ public:
+  struct Stats {
+    /// Lookups that returned a cached plan as is.
+    int64_t numHits{0};
+
+    /// Lookups that returned a cached plan with new literal values.
+    int64_t numRebinds{0};
+
+    /// Lookups that converted the plan.
+    int64_t numMisses{0};
+  };
+
+  explicit SubstraitToVeloxPlanCache(int32_t maxEntries = 1'000)
+      : maxEntries_(maxEntries) {
+    VELOX_CHECK_GT(maxEntries_, 0);
+  }
+
+  /// Returns the Velox plan for 'substraitPlan'. Converts with 'converter' if
+  /// there is no usable entry. Sets the split infos of 'converter' as if it
+  /// had converted 'substraitPlan'.
+  core::PlanNodePtr toVeloxPlan(
+      const ::substrait::Plan& substraitPlan,
+      SubstraitVeloxPlanConverter& converter);
+
+  Stats stats() const;
+
+  int32_t size() const;
+
+  void clear();
+
+ private:
+  using SplitInfoMap = std::unordered_map<
+      core::PlanNodeId,
+      std::shared_ptr<SubstraitVeloxPlanConverter::SplitInfo>>;
+
+  struct Entry {
+    core::PlanNodePtr plan;
+
+    SplitInfoMap splitInfos;
+
+    // Serialized literals 'plan' was converted from, in the order of
+    // collectLiterals().
+    std::vector<std::string> literals;
+
+    // The constant for each of 'literals' in 'plan'. Empty if not
+    // rebindable.
+    std::vector<core::TypedExprPtr> constants;
+  };
+
+  struct Slot {
+    std::shared_ptr<const Entry> entry;
+    std::list<const std::string*>::iterator lruPosition;
+  };
+
+  std::shared_ptr<const Entry> find(const std::string& key);
+
+  void insert(const std::string& key, std::shared_ptr<const Entry> entry);
+
+  const int32_t maxEntries_;
+
+  mutable std::mutex mutex_;
+
+  std::unordered_map<std::string, Slot> entries_;
+
+  // Keys of 'entries_', most recently used first.
+  std::list<const std::string*> lru_;
+
+  Stats stats_;
+};
+
+} // namespace facebook::velox::substrait
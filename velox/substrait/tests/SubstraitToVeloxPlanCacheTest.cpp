@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/substrait/SubstraitToVeloxPlanCache.h"
+
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/substrait/VeloxToSubstraitPlan.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::substrait;
+
+class SubstraitToVeloxPlanCacheTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    vectors_ = {makeRowVector({
+        makeFlatVector<int32_t>(100, [](auto row) { return row; }),
+        makeFlatVector<int32_t>(100, [](auto row) { return row % 7; }),
+    })};
+    createDuckDbTable(vectors_);
+  }
+
+  // Converts 'plan' to Substrait and back through 'cache'.
+  core::PlanNodePtr roundTrip(
+      const core::PlanNodePtr& plan,
+      const std::shared_ptr<SubstraitToVeloxPlanCache>& cache) {
+    google::protobuf::Arena arena;
+    auto& substraitPlan = veloxConvertor_.toSubstrait(arena, plan);
+    SubstraitVeloxPlanConverter converter(pool_.get(), cache);
+    return converter.toVeloxPlan(substraitPlan);
+  }
+
+  core::PlanNodePtr filterProject(
+      const std::string& filter,
+      const std::string& projection) {
+    return PlanBuilder()
+        .values(vectors_)
+        .filter(filter)
+        .project({projection})
+        .planNode();
+  }
+
+  VeloxToSubstraitPlanConvertor veloxConvertor_;
+  std::vector<RowVectorPtr> vectors_;
+};
+
+TEST_F(SubstraitToVeloxPlanCacheTest, hit) {
+  auto cache = std::make_shared<SubstraitToVeloxPlanCache>();
+  auto plan = filterProject("c0 < 50", "c1 + 10");
+  auto first = roundTrip(plan, cache);
+  auto second = roundTrip(plan, cache);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(1, cache->stats().numMisses);
+  EXPECT_EQ(1, cache->stats().numHits);
+  EXPECT_EQ(1, cache->size());
+  assertQuery(second, "SELECT c1 + 10 FROM tmp WHERE c0 < 50");
+}
+
+TEST_F(SubstraitToVeloxPlanCacheTest, rebind) {
+  auto cache = std::make_shared<SubstraitToVeloxPlanCache>();
+  roundTrip(filterProject("c0 < 50", "c1 + 10"), cache);
+  auto rebound = roundTrip(filterProject("c0 < 20", "c1 + 3"), cache);
+  EXPECT_EQ(1, cache->stats().numMisses);
+  EXPECT_EQ(1, cache->stats().numRebinds);
+  EXPECT_EQ(1, cache->size());
+  assertQuery(rebound, "SELECT c1 + 3 FROM tmp WHERE c0 < 20");
+
+  // The entry keeps the literals it was converted from.
+  auto original = roundTrip(filterProject("c0 < 50", "c1 + 10"), cache);
+  EXPECT_EQ(1, cache->stats().numHits);
+  assertQuery(original, "SELECT c1 + 10 FROM tmp WHERE c0 < 50");
+}
+
+TEST_F(SubstraitToVeloxPlanCacheTest, differentStructure) {
+  auto cache = std::make_shared<SubstraitToVeloxPlanCache>();
+  roundTrip(filterProject("c0 < 50", "c1 + 10"), cache);
+  auto plan = roundTrip(filterProject("c1 < 50", "c0 * 10"), cache);
+  EXPECT_EQ(2, cache->stats().numMisses);
+  EXPECT_EQ(0, cache->stats().numRebinds);
+  assertQuery(plan, "SELECT c0 * 10 FROM tmp WHERE c1 < 50");
+}
+
+TEST_F(SubstraitToVeloxPlanCacheTest, eviction) {
+  auto cache = std::make_shared<SubstraitToVeloxPlanCache>(1);
+  roundTrip(filterProject("c0 < 50", "c1 + 10"), cache);
+  roundTrip(filterProject("c1 < 50", "c0 * 10"), cache);
+  EXPECT_EQ(1, cache->size());
+  roundTrip(filterProject("c0 < 50", "c1 + 10"), cache);
+  EXPECT_EQ(3, cache->stats().numMisses);
+  EXPECT_EQ(0, cache->stats().numHits);
+}
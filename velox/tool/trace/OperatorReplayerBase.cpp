@@ -14,10 +14,12 @@
  * limitations under the License.
  */
 
+#include <folly/ScopeGuard.h>
 #include <folly/json.h>
 
 #include <utility>
 
+#include "velox/common/time/Timer.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/TaskTraceReader.h"
@@ -56,7 +58,8 @@ OperatorReplayerBase::OperatorReplayerBase(
                                   fs_)
                             : exec::trace::extractDriverIds(driverIds)),
       queryCapacity_(queryCapacity == 0 ? memory::kMaxMemory : queryCapacity),
-      executor_(executor) {
+      executor_(executor),
+      numDrivers_(driverIds_.size()) {
   VELOX_USER_CHECK(!taskTraceDir_.empty());
   VELOX_USER_CHECK(!taskId_.empty());
   VELOX_USER_CHECK(!nodeId_.empty());
@@ -82,13 +85,56 @@ RowVectorPtr OperatorReplayerBase::run(bool copyResults) {
 
   TraceReplayTaskRunner traceTaskRunner(createPlan(), std::move(queryCtx));
   auto [task, result] =
-      traceTaskRunner.maxDrivers(driverIds_.size())
+      traceTaskRunner.maxDrivers(numDrivers_)
           .spillDirectory(spillDirectory ? spillDirectory->getPath() : "")
           .run(copyResults);
   printStats(task);
   return result;
 }
 
+ReplayPerfStats OperatorReplayerBase::runPerf(
+    int32_t numRuns,
+    int32_t numWarmupRuns) {
+  VELOX_USER_CHECK_GT(numRuns, 0);
+  VELOX_USER_CHECK_GE(numWarmupRuns, 0);
+  perfMode_ = true;
+  SCOPE_EXIT {
+    perfMode_ = false;
+    lastRunStats_.reset();
+  };
+  ReplayPerfStats perfStats(fmt::format(
+      "{} node {} of task {} with {} drivers",
+      operatorType_,
+      nodeId_,
+      taskId_,
+      numDrivers_));
+  for (auto i = 0; i < numWarmupRuns + numRuns; ++i) {
+    lastRunStats_.reset();
+    const auto startNanos = getCurrentTimeNano();
+    run(/*copyResults=*/false);
+    const auto wallNanos = getCurrentTimeNano() - startNanos;
+    VELOX_CHECK(lastRunStats_.has_value());
+    if (i < numWarmupRuns) {
+      continue;
+    }
+    lastRunStats_->wallNanos = wallNanos;
+    perfStats.add(std::move(lastRunStats_.value()));
+  }
+  return perfStats;
+}
+
+void OperatorReplayerBase::setNumDrivers(int32_t numDrivers) {
+  VELOX_USER_CHECK_GT(numDrivers, 0);
+  VELOX_USER_CHECK(
+      operatorType_ == "TableScan" ||
+          static_cast<size_t>(numDrivers) == driverIds_.size(),
+      "Only a TableScan can be replayed with another number of drivers than "
+      "the {} traced drivers to replay, select the traced drivers with "
+      "--driver_ids instead",
+      driverIds_.size());
+  numDrivers_ = numDrivers;
+}
+
 core::PlanNodePtr OperatorReplayerBase::createPlan() {
   const auto* replayNode = core::PlanNode::findFirstNode(
       planFragment_.get(),
@@ -141,9 +187,13 @@ OperatorReplayerBase::replayNodeFactory(const core::PlanNode* node) const {
 }
 
 void OperatorReplayerBase::printStats(
-    const std::shared_ptr<exec::Task>& task) const {
+    const std::shared_ptr<exec::Task>& task) {
   const auto planStats = exec::toPlanStats(task->taskStats());
   const auto& stats = planStats.at(replayPlanNodeId_);
+  if (perfMode_) {
+    lastRunStats_ = ReplayRunStats::fromPlanNodeStats(stats);
+    return;
+  }
   for (const auto& [name, operatorStats] : stats.operatorStats) {
     LOG(INFO) << "Stats of replaying operator " << name << " : "
               << operatorStats->toString();
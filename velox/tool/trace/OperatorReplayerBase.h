@@ -16,10 +16,13 @@
 
 #pragma once
 
+#include <optional>
+
 #include "velox/common/file/FileSystems.h"
 #include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/parse/PlanNodeIdGenerator.h"
+#include "velox/tool/trace/ReplayPerfStats.h"
 
 namespace facebook::velox::exec {
 class Task;
@@ -47,6 +50,16 @@ class OperatorReplayerBase {
 
   virtual RowVectorPtr run(bool copyResults = true);
 
+  /// Replays the traced plan node 'numWarmupRuns' + 'numRuns' times without
+  /// copying the results and returns the stats of the last 'numRuns' replays.
+  ReplayPerfStats runPerf(int32_t numRuns, int32_t numWarmupRuns = 1);
+
+  /// Sets the number of drivers of the replays. Defaults to the number of
+  /// traced drivers to replay. Only a TableScan replay can run with another
+  /// number of drivers since each driver of other replays reads the traced
+  /// input of one traced driver.
+  void setNumDrivers(int32_t numDrivers);
+
  protected:
   virtual core::PlanNodePtr createPlanNode(
       const core::PlanNode* node,
@@ -77,10 +90,19 @@ class OperatorReplayerBase {
   core::PlanNodePtr planFragment_;
   core::PlanNodeId replayPlanNodeId_;
 
-  void printStats(const std::shared_ptr<exec::Task>& task) const;
+  // The number of drivers of the replays.
+  int32_t numDrivers_;
+
+  // Logs the stats of the replayed plan node of 'task' or, in runPerf(), saves
+  // them to 'lastRunStats_'.
+  void printStats(const std::shared_ptr<exec::Task>& task);
 
  private:
   std::function<core::PlanNodePtr(std::string, core::PlanNodePtr)>
   replayNodeFactory(const core::PlanNode* node) const;
+
+  // True while in runPerf().
+  bool perfMode_{false};
+  std::optional<ReplayRunStats> lastRunStats_;
 };
 } // namespace facebook::velox::tool::trace
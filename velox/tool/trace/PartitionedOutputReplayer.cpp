@@ -145,7 +145,7 @@ RowVectorPtr PartitionedOutputReplayer::run(bool /*unused*/) {
       0,
       createQueryContext(queryConfigs_, executor_.get()),
       Task::ExecutionMode::kParallel);
-  task->start(driverIds_.size());
+  task->start(numDrivers_);
 
   consumeAllData(
       bufferManager_,
@@ -173,6 +173,8 @@ core::PlanNodePtr PartitionedOutputReplayer::createPlanNode(
       originalNode->partitionFunctionSpecPtr(),
       originalNode->outputType(),
       serdeKind_,
+      originalNode->skewedPartitionMode(),
+      originalNode->skewedPartitions(),
       source);
 }
 
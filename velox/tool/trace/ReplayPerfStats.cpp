@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/tool/trace/ReplayPerfStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include <fmt/format.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/exec/PlanNodeStats.h"
+
+namespace facebook::velox::tool::trace {
+namespace {
+
+constexpr double kPercentiles[] = {50, 90, 99, 100};
+
+// Returns the 'percentile' of 'values' by the nearest rank method.
+template <typename T>
+T percentileOf(std::vector<T> values, double percentile) {
+  VELOX_CHECK(!values.empty());
+  VELOX_CHECK_GE(percentile, 0);
+  VELOX_CHECK_LE(percentile, 100);
+  std::sort(values.begin(), values.end());
+  const auto rank = static_cast<size_t>(
+      std::ceil(percentile / 100 * static_cast<double>(values.size())));
+  return values[std::max<size_t>(rank, 1) - 1];
+}
+
+std::string percentileName(double percentile) {
+  return percentile == 100 ? "max" : fmt::format("p{}", percentile);
+}
+
+// Returns the change from 'baseline' to 'value' in percent.
+double changePct(double baseline, double value) {
+  return baseline == 0 ? 0 : (value - baseline) * 100 / baseline;
+}
+
+} // namespace
+
+folly::dynamic ReplayOperatorStats::toJson() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["inputRows"] = static_cast<int64_t>(inputRows);
+  obj["rawInputRows"] = static_cast<int64_t>(rawInputRows);
+  obj["inputBytes"] = static_cast<int64_t>(inputBytes);
+  obj["outputRows"] = static_cast<int64_t>(outputRows);
+  obj["cpuNanos"] = static_cast<int64_t>(cpuNanos);
+  obj["wallNanos"] = static_cast<int64_t>(wallNanos);
+  obj["peakMemoryBytes"] = static_cast<int64_t>(peakMemoryBytes);
+  obj["spilledBytes"] = static_cast<int64_t>(spilledBytes);
+  return obj;
+}
+
+// static
+ReplayOperatorStats ReplayOperatorStats::fromJson(const folly::dynamic& obj) {
+  ReplayOperatorStats stats;
+  stats.inputRows = obj["inputRows"].asInt();
+  stats.rawInputRows = obj["rawInputRows"].asInt();
+  stats.inputBytes = obj["inputBytes"].asInt();
+  stats.outputRows = obj["outputRows"].asInt();
+  stats.cpuNanos = obj["cpuNanos"].asInt();
+  stats.wallNanos = obj["wallNanos"].asInt();
+  stats.peakMemoryBytes = obj["peakMemoryBytes"].asInt();
+  stats.spilledBytes = obj["spilledBytes"].asInt();
+  return stats;
+}
+
+// static
+ReplayRunStats ReplayRunStats::fromPlanNodeStats(
+    const exec::PlanNodeStats& stats) {
+  ReplayRunStats run;
+  for (const auto& [operatorType, operatorStats] : stats.operatorStats) {
+    auto& replayStats = run.operators[operatorType];
+    replayStats.inputRows = operatorStats->inputRows;
+    replayStats.rawInputRows = operatorStats->rawInputRows;
+    replayStats.inputBytes = operatorStats->inputBytes;
+    replayStats.outputRows = operatorStats->outputRows;
+    replayStats.cpuNanos = operatorStats->cpuWallTiming.cpuNanos;
+    replayStats.wallNanos = operatorStats->cpuWallTiming.wallNanos;
+    replayStats.peakMemoryBytes = operatorStats->peakMemoryBytes;
+    replayStats.spilledBytes = operatorStats->spilledBytes;
+  }
+  return run;
+}
+
+folly::dynamic ReplayRunStats::toJson() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["wallNanos"] = static_cast<int64_t>(wallNanos);
+  folly::dynamic operatorsObj = folly::dynamic::object;
+  for (const auto& [operatorType, stats] : operators) {
+    operatorsObj[operatorType] = stats.toJson();
+  }
+  obj["operators"] = std::move(operatorsObj);
+  return obj;
+}
+
+// static
+ReplayRunStats ReplayRunStats::fromJson(const folly::dynamic& obj) {
+  ReplayRunStats run;
+  run.wallNanos = obj["wallNanos"].asInt();
+  for (const auto& [operatorType, stats] : obj["operators"].items()) {
+    run.operators[operatorType.asString()] =
+        ReplayOperatorStats::fromJson(stats);
+  }
+  return run;
+}
+
+uint64_t ReplayPerfStats::wallNanosPercentile(double percentile) const {
+  std::vector<uint64_t> wallNanos;
+  wallNanos.reserve(runs_.size());
+  for (const auto& run : runs_) {
+    wallNanos.push_back(run.wallNanos);
+  }
+  return percentileOf(std::move(wallNanos), percentile);
+}
+
+double ReplayPerfStats::inputRowsPerCpuSecond(
+    const std::string& operatorType) const {
+  std::vector<double> throughputs;
+  for (const auto& run : runs_) {
+    const auto it = run.operators.find(operatorType);
+    if (it == run.operators.end() || it->second.cpuNanos == 0) {
+      continue;
+    }
+    const auto& stats = it->second;
+    const auto rows =
+        stats.inputRows != 0 ? stats.inputRows : stats.rawInputRows;
+    throughputs.push_back(rows * 1e9 / stats.cpuNanos);
+  }
+  return throughputs.empty() ? 0 : percentileOf(std::move(throughputs), 50);
+}
+
+std::string ReplayPerfStats::toString() const {
+  VELOX_CHECK(!runs_.empty());
+  std::stringstream out;
+  out << "Replay performance of " << label_ << " over " << runs_.size()
+      << " runs\n  Wall time:";
+  for (auto percentile : kPercentiles) {
+    out << " " << percentileName(percentile) << " "
+        << succinctNanos(wallNanosPercentile(percentile));
+  }
+  const auto& lastRun = runs_.back();
+  for (const auto& [operatorType, stats] : lastRun.operators) {
+    out << "\n  " << operatorType << ": "
+        << fmt::format("{:.4g}", inputRowsPerCpuSecond(operatorType))
+        << " input rows/CPU s, input " << stats.inputRows << " rows ("
+        << succinctBytes(stats.inputBytes) << "), output " << stats.outputRows
+        << " rows, CPU " << succinctNanos(stats.cpuNanos) << ", peak memory "
+        << succinctBytes(stats.peakMemoryBytes) << ", spilled "
+        << succinctBytes(stats.spilledBytes);
+  }
+  return out.str();
+}
+
+std::string ReplayPerfStats::compare(const ReplayPerfStats& baseline) const {
+  VELOX_CHECK(!runs_.empty());
+  VELOX_CHECK(!baseline.runs_.empty());
+  std::stringstream out;
+  out << "Replay performance of " << label_ << " compared to "
+      << baseline.label_ << "\n  Wall time:";
+  for (auto percentile : kPercentiles) {
+    const auto value = wallNanosPercentile(percentile);
+    const auto baselineValue = baseline.wallNanosPercentile(percentile);
+    out << fmt::format(
+        " {} {} vs {} ({:+.1f}%)",
+        percentileName(percentile),
+        succinctNanos(value),
+        succinctNanos(baselineValue),
+        changePct(baselineValue, value));
+  }
+  for (const auto& [operatorType, _] : runs_.back().operators) {
+    const auto throughput = inputRowsPerCpuSecond(operatorType);
+    const auto baselineThroughput =
+        baseline.inputRowsPerCpuSecond(operatorType);
+    out << fmt::format(
+        "\n  {}: {:.4g} vs {:.4g} input rows/CPU s ({:+.1f}%)",
+        operatorType,
+        throughput,
+        baselineThroughput,
+        changePct(baselineThroughput, throughput));
+  }
+  return out.str();
+}
+
+folly::dynamic ReplayPerfStats::toJson() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["label"] = label_;
+  folly::dynamic runsObj = folly::dynamic::array;
+  for (const auto& run : runs_) {
+    runsObj.push_back(run.toJson());
+  }
+  obj["runs"] = std::move(runsObj);
+  return obj;
+}
+
+// static
+ReplayPerfStats ReplayPerfStats::fromJson(const folly::dynamic& obj) {
+  ReplayPerfStats stats(obj["label"].asString());
+  for (const auto& run : obj["runs"]) {
+    stats.add(ReplayRunStats::fromJson(run));
+  }
+  return stats;
+}
+
+} // namespace facebook::velox::tool::trace
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <folly/json.h>
+
+namespace facebook::velox::exec {
+struct PlanNodeStats;
+}
+
+namespace facebook::velox::tool::trace {
+
+/// The stats of an operator type of the replayed plan node in one replay,
+/// summed over its drivers.
+struct ReplayOperatorStats {
+  uint64_t inputRows{0};
+  uint64_t rawInputRows{0};
+  uint64_t inputBytes{0};
+  uint64_t outputRows{0};
+  uint64_t cpuNanos{0};
+  uint64_t wallNanos{0};
+  uint64_t peakMemoryBytes{0};
+  uint64_t spilledBytes{0};
+
+  folly::dynamic toJson() const;
+
+  static ReplayOperatorStats fromJson(const folly::dynamic& obj);
+};
+
+/// The stats of one replay of a traced plan node.
+struct ReplayRunStats {
+  /// The wall time of the replay, from the creation to the end of its task.
+  uint64_t wallNanos{0};
+
+  /// Keyed on operator type, e.g. HashBuild and HashProbe for a HashJoin.
+  std::map<std::string, ReplayOperatorStats> operators;
+
+  /// Returns the stats of the operators in 'stats', the stats of the replayed
+  /// plan node.
+  static ReplayRunStats fromPlanNodeStats(const exec::PlanNodeStats& stats);
+
+  folly::dynamic toJson() const;
+
+  static ReplayRunStats fromJson(const folly::dynamic& obj);
+};
+
+/// The stats of the replays of a traced plan node in the performance mode of
+/// the replayer. Reports the percentiles of the replay wall time and the
+/// per-operator throughput, and compares them with the stats of other replays
+/// of the same trace, e.g. by another build or with another configuration.
+class ReplayPerfStats {
+ public:
+  /// 'label' describes the replays, e.g. the node id and number of drivers.
+  explicit ReplayPerfStats(std::string label = "") : label_(std::move(label)) {}
+
+  void add(ReplayRunStats run) {
+    runs_.push_back(std::move(run));
+  }
+
+  const std::vector<ReplayRunStats>& runs() const {
+    return runs_;
+  }
+
+  const std::string& label() const {
+    return label_;
+  }
+
+  /// Returns the 'percentile' (0 to 100) of the replay wall times.
+  uint64_t wallNanosPercentile(double percentile) const;
+
+  /// Returns the median over the replays of the input rows of 'operatorType'
+  /// per CPU second, or 0 if it used no CPU time. The raw input rows are used
+  /// for an operator without input rows, e.g. a TableScan.
+  double inputRowsPerCpuSecond(const std::string& operatorType) const;
+
+  /// Returns the wall time percentiles and a line per operator type.
+  std::string toString() const;
+
+  /// Returns the changes of the wall time percentiles and the per-operator
+  /// throughput from 'baseline'.
+  std::string compare(const ReplayPerfStats& baseline) const;
+
+  folly::dynamic toJson() const;
+
+  static ReplayPerfStats fromJson(const folly::dynamic& obj);
+
+ private:
+  std::string label_;
+  std::vector<ReplayRunStats> runs_;
+};
+
+} // namespace facebook::velox::tool::trace
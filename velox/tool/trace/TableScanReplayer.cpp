@@ -31,7 +31,7 @@ namespace facebook::velox::tool::trace {
 
 RowVectorPtr TableScanReplayer::run(bool copyResults) {
   TraceReplayTaskRunner traceTaskRunner(createPlan(), createQueryCtx());
-  auto [task, result] = traceTaskRunner.maxDrivers(driverIds_.size())
+  auto [task, result] = traceTaskRunner.maxDrivers(numDrivers_)
                             .splits(replayPlanNodeId_, getSplits())
                             .run(copyResults);
   printStats(task);
@@ -16,6 +16,8 @@
 
 #include "velox/tool/trace/TraceReplayRunner.h"
 
+#include <fstream>
+
 #include <gflags/gflags.h>
 
 #include "velox/common/file/FileSystems.h"
@@ -99,6 +101,30 @@ DEFINE_uint64(
     0,
     "Specify the query memory capacity limit in GB. If it is zero, then there is no limit.");
 DEFINE_bool(copy_results, false, "Copy the replaying results.");
+DEFINE_int32(
+    num_drivers,
+    0,
+    "Specify the number of drivers of a TableScan replay. If it is zero, the "
+    "number of traced drivers to replay is used.");
+DEFINE_int32(
+    perf_runs,
+    0,
+    "Replay the node this many times after the warmup replays and report the "
+    "percentiles of the replay wall time and the per-operator throughput. If "
+    "it is zero, the node is replayed once.");
+DEFINE_int32(
+    perf_warmup_runs,
+    1,
+    "Number of replays before the measured replays when --perf_runs is set.");
+DEFINE_string(
+    perf_output,
+    "",
+    "Path of a file to write the stats of the measured replays to in JSON.");
+DEFINE_string(
+    perf_baseline,
+    "",
+    "Path of a file written by --perf_output, e.g. by another build or with "
+    "another configuration, to compare the stats of the measured replays to.");
 
 namespace facebook::velox::tool::trace {
 namespace {
@@ -411,6 +437,32 @@ void TraceReplayRunner::run() {
     return;
   }
   VELOX_USER_CHECK(!FLAGS_task_id.empty(), "--task_id must be provided");
-  createReplayer()->run(FLAGS_copy_results);
+  const auto replayer = createReplayer();
+  if (FLAGS_num_drivers > 0) {
+    replayer->setNumDrivers(FLAGS_num_drivers);
+  }
+  if (FLAGS_perf_runs == 0) {
+    replayer->run(FLAGS_copy_results);
+    return;
+  }
+
+  const auto perfStats =
+      replayer->runPerf(FLAGS_perf_runs, FLAGS_perf_warmup_runs);
+  LOG(INFO) << perfStats.toString();
+  if (!FLAGS_perf_output.empty()) {
+    std::ofstream out(FLAGS_perf_output);
+    VELOX_USER_CHECK(
+        out.good(), "Failed to open perf output file {}", FLAGS_perf_output);
+    out << folly::toPrettyJson(perfStats.toJson());
+  }
+  if (!FLAGS_perf_baseline.empty()) {
+    std::ifstream in(FLAGS_perf_baseline);
+    VELOX_USER_CHECK(
+        in.good(), "Failed to open perf baseline file {}", FLAGS_perf_baseline);
+    const std::string json(
+        (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    LOG(INFO) << perfStats.compare(
+        ReplayPerfStats::fromJson(folly::parseJson(json)));
+  }
 }
 } // namespace facebook::velox::tool::trace
@@ -37,6 +37,11 @@ DECLARE_uint64(query_memory_capacity_mb);
 DECLARE_double(driver_cpu_executor_hw_multiplier);
 DECLARE_string(memory_arbitrator_type);
 DECLARE_bool(copy_results);
+DECLARE_int32(num_drivers);
+DECLARE_int32(perf_runs);
+DECLARE_int32(perf_warmup_runs);
+DECLARE_string(perf_output);
+DECLARE_string(perf_baseline);
 
 namespace facebook::velox::tool::trace {
 
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/tool/trace/ReplayPerfStats.h"
+
+namespace facebook::velox::tool::trace::test {
+namespace {
+
+ReplayRunStats makeRun(uint64_t wallNanos, uint64_t inputRows) {
+  ReplayRunStats run;
+  run.wallNanos = wallNanos;
+  auto& stats = run.operators["HashProbe"];
+  stats.inputRows = inputRows;
+  stats.outputRows = inputRows / 2;
+  stats.cpuNanos = 1'000'000'000;
+  stats.peakMemoryBytes = 1 << 20;
+  return run;
+}
+
+ReplayPerfStats makeStats(const std::string& label, uint64_t scale) {
+  ReplayPerfStats stats(label);
+  for (auto i = 1; i <= 100; ++i) {
+    stats.add(makeRun(i * scale, i * 1'000));
+  }
+  return stats;
+}
+
+TEST(ReplayPerfStatsTest, percentiles) {
+  const auto stats = makeStats("current", 1'000);
+  ASSERT_EQ(stats.runs().size(), 100);
+  ASSERT_EQ(stats.wallNanosPercentile(0), 1'000);
+  ASSERT_EQ(stats.wallNanosPercentile(50), 50'000);
+  ASSERT_EQ(stats.wallNanosPercentile(90), 90'000);
+  ASSERT_EQ(stats.wallNanosPercentile(99), 99'000);
+  ASSERT_EQ(stats.wallNanosPercentile(100), 100'000);
+  VELOX_ASSERT_THROW(stats.wallNanosPercentile(101), "");
+  VELOX_ASSERT_THROW(ReplayPerfStats().wallNanosPercentile(50), "");
+
+  ASSERT_EQ(stats.inputRowsPerCpuSecond("HashProbe"), 50'000);
+  ASSERT_EQ(stats.inputRowsPerCpuSecond("HashBuild"), 0);
+
+  ReplayPerfStats single;
+  single.add(makeRun(7, 1));
+  ASSERT_EQ(single.wallNanosPercentile(1), 7);
+  ASSERT_EQ(single.wallNanosPercentile(100), 7);
+}
+
+TEST(ReplayPerfStatsTest, json) {
+  const auto stats = makeStats("current", 1'000);
+  const auto copy = ReplayPerfStats::fromJson(
+      folly::parseJson(folly::toJson(stats.toJson())));
+  ASSERT_EQ(copy.label(), "current");
+  ASSERT_EQ(copy.runs().size(), stats.runs().size());
+  ASSERT_EQ(copy.toString(), stats.toString());
+  const auto& run = copy.runs()[9];
+  ASSERT_EQ(run.wallNanos, 10'000);
+  const auto& probeStats = run.operators.at("HashProbe");
+  ASSERT_EQ(probeStats.inputRows, 10'000);
+  ASSERT_EQ(probeStats.outputRows, 5'000);
+  ASSERT_EQ(probeStats.peakMemoryBytes, 1 << 20);
+}
+
+TEST(ReplayPerfStatsTest, compare) {
+  const auto baseline = makeStats("baseline", 2'000);
+  const auto stats = makeStats("current", 1'000);
+  const auto comparison = stats.compare(baseline);
+  ASSERT_NE(comparison.find("compared to baseline"), std::string::npos)
+      << comparison;
+  ASSERT_NE(comparison.find("(-50.0%)"), std::string::npos) << comparison;
+  ASSERT_NE(comparison.find("HashProbe"), std::string::npos) << comparison;
+  ASSERT_NE(comparison.find("(+0.0%)"), std::string::npos) << comparison;
+}
+
+} // namespace
+} // namespace facebook::velox::tool::trace::test
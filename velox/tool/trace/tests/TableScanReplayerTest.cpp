@@ -239,6 +239,59 @@ TEST_F(TableScanReplayerTest, basic) {
   assertEqualResults({results}, {replayingResult1, replayingResult2});
 }
 
+TEST_F(TableScanReplayerTest, perf) {
+  const auto vectors = makeVectors(10, 100);
+  const auto testDir = TempDirectoryPath::create();
+  const auto traceRoot = fmt::format("{}/{}", testDir->getPath(), "traceRoot");
+  std::vector<std::shared_ptr<TempFilePath>> splitFiles;
+  for (int i = 0; i < 5; ++i) {
+    auto filePath = TempFilePath::create();
+    writeToFile(filePath->getPath(), vectors);
+    splitFiles.push_back(std::move(filePath));
+  }
+
+  const auto plan = tableScanNode();
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan)
+      .maxDrivers(2)
+      .config(core::QueryConfig::kQueryTraceEnabled, true)
+      .config(core::QueryConfig::kQueryTraceDir, traceRoot)
+      .config(core::QueryConfig::kQueryTraceMaxBytes, 100UL << 30)
+      .config(core::QueryConfig::kQueryTraceTaskRegExp, ".*")
+      .config(core::QueryConfig::kQueryTraceNodeIds, traceNodeId_)
+      .splits(makeHiveConnectorSplits(splitFiles))
+      .copyResults(pool(), task);
+
+  for (const auto numDrivers : {1, 4}) {
+    SCOPED_TRACE(fmt::format("numDrivers: {}", numDrivers));
+    TableScanReplayer replayer(
+        traceRoot,
+        task->queryCtx()->queryId(),
+        task->taskId(),
+        traceNodeId_,
+        "TableScan",
+        "",
+        0,
+        executor_.get());
+    replayer.setNumDrivers(numDrivers);
+    const auto perfStats = replayer.runPerf(3, 1);
+    ASSERT_EQ(perfStats.runs().size(), 3);
+    for (const auto& run : perfStats.runs()) {
+      ASSERT_GT(run.wallNanos, 0);
+      const auto& scanStats = run.operators.at("TableScan");
+      ASSERT_EQ(scanStats.outputRows, 5 * 10 * 100);
+      ASSERT_GT(scanStats.cpuNanos, 0);
+    }
+    ASSERT_LE(
+        perfStats.wallNanosPercentile(50), perfStats.wallNanosPercentile(100));
+    ASSERT_GT(perfStats.inputRowsPerCpuSecond("TableScan"), 0);
+    ASSERT_EQ(perfStats.inputRowsPerCpuSecond("HashBuild"), 0);
+
+    // Replays run normally after runPerf().
+    ASSERT_EQ(replayer.run()->size(), 5 * 10 * 100);
+  }
+}
+
 TEST_F(TableScanReplayerTest, columnPrunning) {
   const auto vectors = makeVectors(10, 100);
   const auto testDir = TempDirectoryPath::create();
@@ -17,6 +17,7 @@
 #include "velox/tpch/gen/TpchGen.h"
 #include <velox/tpch/gen/dbgen/include/tpch_constants.hpp>
 #include "velox/tpch/gen/DBGenIterator.h"
+#include "velox/type/TimestampConversion.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::tpch {
@@ -81,8 +82,19 @@ double decimalToDouble(int64_t value) {
   return static_cast<double>(value) * 0.01;
 }
 
-int32_t toDate(std::string_view stringDate) {
-  return DATE()->toDays(stringDate);
+// Converts the 'YYYY-MM-DD' dates made by dbgen. Lineitem has three dates per
+// row, so this skips the general date parser.
+int32_t toDate(const char* date) {
+  auto toInt = [&](int32_t begin, int32_t end) {
+    int32_t result = 0;
+    for (auto i = begin; i < end; ++i) {
+      result = result * 10 + (date[i] - '0');
+    }
+    return result;
+  };
+  VELOX_DCHECK_EQ(strlen(date), 10);
+  return util::daysSinceEpochFromDate(toInt(0, 4), toInt(5, 7), toInt(8, 10))
+      .value();
 }
 
 } // namespace
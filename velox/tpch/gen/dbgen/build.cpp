@@ -35,6 +35,7 @@
 #include "dbgen/dsstypes.h" // @manual
 
 #include <math.h>
+#include <string>
 #include "dbgen/rng64.h" // @manual
 
 namespace facebook::velox::tpch::dbgen {
@@ -67,6 +68,17 @@ namespace facebook::velox::tpch::dbgen {
       seed)
 static void gen_phone PROTO((DSS_HUGE ind, char* target, seed_t* seed));
 
+/*
+ * make_format() -- the printf format of a name made of a tag and a zero padded
+ * number. The formats are kept in function local statics, which are
+ * initialized once also when rows are generated on several threads.
+ */
+static std::string make_format(const char* format, int width) {
+  char result[100];
+  snprintf(result, sizeof(result), format, width, &HUGE_FORMAT[1]);
+  return result;
+}
+
 DSS_HUGE
 rpb_routine(DSS_HUGE p) {
   DSS_HUGE price;
@@ -96,15 +108,10 @@ static void gen_phone(DSS_HUGE ind, char* target, seed_t* seed) {
 
 long mk_cust(DSS_HUGE n_cust, customer_t* c, DBGenContext* ctx) {
   DSS_HUGE i;
-  static int bInit = 0;
-  static char szFormat[100];
+  static const std::string szFormat = make_format(C_NAME_FMT, 9);
 
-  if (!bInit) {
-    sprintf(szFormat, C_NAME_FMT, 9, &HUGE_FORMAT[1]);
-    bInit = 1;
-  }
   c->custkey = n_cust;
-  sprintf(c->name, szFormat, C_NAME_TAG, n_cust);
+  sprintf(c->name, szFormat.c_str(), C_NAME_TAG, n_cust);
   V_STR(C_ADDR_LEN, &ctx->Seed[C_ADDR_SD], c->address);
   c->alen = static_cast<int>(strlen(c->address));
   RANDOM(i, 0, (nations.count - 1), &ctx->Seed[C_NTRG_SD]);
@@ -145,19 +152,12 @@ long mk_order(DSS_HUGE index, order_t* o, DBGenContext* ctx, long upd_num) {
   DSS_HUGE c_date;
   DSS_HUGE clk_num;
   DSS_HUGE supp_num;
-  static char** asc_date = NULL;
   char tmp_str[2];
   char** mk_ascdate PROTO((void));
+  static char** const asc_date = mk_ascdate();
   int delta = 1;
-  static int bInit = 0;
-  static char szFormat[100];
+  static const std::string szFormat = make_format(O_CLRK_FMT, 9);
 
-  if (!bInit) {
-    sprintf(szFormat, O_CLRK_FMT, 9, &HUGE_FORMAT[1]);
-    bInit = 1;
-  }
-  if (asc_date == NULL)
-    asc_date = mk_ascdate();
   mk_sparse(
       index, &o->okey, (upd_num == 0) ? 0 : 1 + upd_num / (10000 / UPD_PCT));
   if (ctx->scale_factor >= 30000)
@@ -179,7 +179,7 @@ long mk_order(DSS_HUGE index, order_t* o, DBGenContext* ctx, long upd_num) {
       1,
       MAX((ctx->scale_factor * O_CLRK_SCL), O_CLRK_SCL),
       &ctx->Seed[O_CLRK_SD]);
-  sprintf(o->clerk, szFormat, O_CLRK_TAG, clk_num);
+  sprintf(o->clerk, szFormat.c_str(), O_CLRK_TAG, clk_num);
   TEXT(O_CMNT_LEN, &ctx->Seed[O_CMNT_SD], o->comment);
   o->clen = static_cast<int>(strlen(o->comment));
 #ifdef DEBUG
@@ -255,22 +255,20 @@ long mk_part(DSS_HUGE index, part_t* p, DBGenContext* ctx) {
   DSS_HUGE temp;
   long snum;
   DSS_HUGE brnd;
-  static int bInit = 0;
-  static char szFormat[100];
-  static char szBrandFormat[100];
-
-  if (!bInit) {
-    sprintf(szFormat, P_MFG_FMT, 1, &HUGE_FORMAT[1]);
-    sprintf(szBrandFormat, P_BRND_FMT, 2, &HUGE_FORMAT[1]);
-    bInit = 1;
-  }
+  static const std::string szFormat = make_format(P_MFG_FMT, 1);
+  static const std::string szBrandFormat = make_format(P_BRND_FMT, 2);
+
   p->partkey = index;
   agg_str(
-      &colors, static_cast<long>(P_NAME_SCL), &ctx->Seed[P_NAME_SD], p->name);
+      &colors,
+      static_cast<long>(P_NAME_SCL),
+      &ctx->Seed[P_NAME_SD],
+      p->name,
+      ctx);
   RANDOM(temp, P_MFG_MIN, P_MFG_MAX, &ctx->Seed[P_MFG_SD]);
-  sprintf(p->mfgr, szFormat, P_MFG_TAG, temp);
+  sprintf(p->mfgr, szFormat.c_str(), P_MFG_TAG, temp);
   RANDOM(brnd, P_BRND_MIN, P_BRND_MAX, &ctx->Seed[P_BRND_SD]);
-  sprintf(p->brand, szBrandFormat, P_BRND_TAG, (temp * 10 + brnd));
+  sprintf(p->brand, szBrandFormat.c_str(), P_BRND_TAG, (temp * 10 + brnd));
   p->tlen = pick_str(&p_types_set, &ctx->Seed[P_TYPE_SD], p->type);
   p->tlen = static_cast<int>(strlen(p_types_set.list[p->tlen].text));
   RANDOM(p->size, P_SIZE_MIN, P_SIZE_MAX, &ctx->Seed[P_SIZE_SD]);
@@ -292,15 +290,10 @@ long mk_part(DSS_HUGE index, part_t* p, DBGenContext* ctx) {
 
 long mk_supp(DSS_HUGE index, supplier_t* s, DBGenContext* ctx) {
   DSS_HUGE i, bad_press, noise, offset, type;
-  static int bInit = 0;
-  static char szFormat[100];
+  static const std::string szFormat = make_format(S_NAME_FMT, 9);
 
-  if (!bInit) {
-    sprintf(szFormat, S_NAME_FMT, 9, &HUGE_FORMAT[1]);
-    bInit = 1;
-  }
   s->suppkey = index;
-  sprintf(s->name, szFormat, S_NAME_TAG, index);
+  sprintf(s->name, szFormat.c_str(), S_NAME_TAG, index);
   V_STR(S_ADDR_LEN, &ctx->Seed[S_ADDR_SD], s->address);
   s->alen = static_cast<int>(strlen(s->address));
   RANDOM(i, 0, nations.count - 1, &ctx->Seed[S_NTRG_SD]);
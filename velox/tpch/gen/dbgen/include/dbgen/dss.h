@@ -50,6 +50,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <vector>
+
 // some defines to avoid r warnings
 #define exit(status)
 #define printf(...)
@@ -129,14 +131,12 @@ typedef struct {
   int count;
   int max;
   set_member* list;
-  long* permute;
 } distribution;
 /*
  * some handy access functions
  */
 #define DIST_SIZE(d) d->count
 #define DIST_MEMBER(d, i) (reinterpret_cast<set_member*>((d)->list + i))->text
-#define DIST_PERMUTE(d, i) (d->permute[i])
 
 typedef struct {
   const char* name;
@@ -171,7 +171,12 @@ long unjulian PROTO((long date));
 long dssncasecmp PROTO((const char* s1, const char* s2, int n));
 long dsscasecmp PROTO((const char* s1, const char* s2));
 int pick_str PROTO((distribution * s, seed_t* seed, char* target));
-void agg_str PROTO((distribution * set, long count, seed_t* seed, char* dest));
+void agg_str PROTO(
+    (distribution * set,
+     long count,
+     seed_t* seed,
+     char* dest,
+     DBGenContext* ctx));
 void read_dist
     PROTO((const char* path, const char* name, distribution* target));
 void embed_str
@@ -578,6 +583,10 @@ struct DBGenContext {
   };
 
   long scale_factor = 1;
+
+  // Permutation of a distribution made by agg_str(). Kept here instead of in
+  // the shared distribution so that generators can run concurrently.
+  std::vector<long> permute;
 };
 
 } // namespace facebook::velox::tpch::dbgen
@@ -34,7 +34,7 @@ namespace facebook::velox::tpch::dbgen {
 
 DSS_HUGE NextRand(DSS_HUGE seed);
 void permute(long* set, int cnt, seed_t* seed);
-void permute_dist(distribution* d, seed_t* seed);
+void permute_dist(distribution* d, seed_t* seed, DBGenContext* ctx);
 long seed;
 char* eol[2] = {" ", "},"};
 
@@ -44,8 +44,8 @@ char* eol[2] = {" ", "},"};
 
 void permute(long* a, int c, seed_t* seed) {
   int i;
-  static DSS_HUGE source;
-  static long temp;
+  DSS_HUGE source;
+  long temp;
 
   if (a != reinterpret_cast<long*>(NULL)) {
     for (i = 0; i < c; i++) {
@@ -59,17 +59,14 @@ void permute(long* a, int c, seed_t* seed) {
   return;
 }
 
-void permute_dist(distribution* d, seed_t* seed) {
+void permute_dist(distribution* d, seed_t* seed, DBGenContext* ctx) {
   int i;
 
   if (d != NULL) {
-    if (d->permute == reinterpret_cast<long*>(NULL)) {
-      d->permute = reinterpret_cast<long*>(malloc(sizeof(long) * DIST_SIZE(d)));
-      MALLOC_CHECK(d->permute);
-    }
+    ctx->permute.resize(DIST_SIZE(d));
     for (i = 0; i < DIST_SIZE(d); i++)
-      *(d->permute + i) = i;
-    permute(d->permute, DIST_SIZE(d), seed);
+      ctx->permute[i] = i;
+    permute(ctx->permute.data(), DIST_SIZE(d), seed);
   } else
     INTERNAL_ERROR("Bad call to permute_dist");
 
@@ -16,10 +16,14 @@
 
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <set>
 #include <string>
 
+#include <folly/String.h>
+#include <folly/lang/Bits.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/type/Filter.h"
 
@@ -94,6 +98,12 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
+    case FilterKind::kFunction:
+      strKind = "Function";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +141,9 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
+      {FilterKind::kFunction, "kFunction"},
   };
 }
 
@@ -190,6 +203,8 @@ void Filter::registerSerDe() {
       NegatedBigintValuesUsingBitmask::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register("FloatRange", AbstractRange::create);
   registry.Register("DoubleRange", AbstractRange::create);
   registry.Register("BytesRange", BytesRange::create);
@@ -618,6 +633,155 @@ FilterPtr BytesValues::create(const folly::dynamic& obj) {
   return std::make_unique<BytesValues>(values, nullAllowed);
 }
 
+void BytesValues::buildLengthBits() {
+  maxLength_ = 0;
+  for (auto length : lengths_) {
+    maxLength_ = std::max<int32_t>(maxLength_, length);
+  }
+  lengthBits_.assign(bits::nwords(numLengthBits()), 0);
+  for (auto length : lengths_) {
+    if (length < numLengthBits()) {
+      bits::setBit(lengthBits_.data(), length);
+    }
+  }
+}
+
+namespace {
+// The bit for each position in a 32 bit word.
+alignas(64) const int32_t kWordBits[32] = {
+    1 << 0,  1 << 1,  1 << 2,  1 << 3,  1 << 4,  1 << 5,  1 << 6,
+    1 << 7,  1 << 8,  1 << 9,  1 << 10, 1 << 11, 1 << 12, 1 << 13,
+    1 << 14, 1 << 15, 1 << 16, 1 << 17, 1 << 18, 1 << 19, 1 << 20,
+    1 << 21, 1 << 22, 1 << 23, 1 << 24, 1 << 25, 1 << 26, 1 << 27,
+    1 << 28, 1 << 29, 1 << 30, static_cast<int32_t>(1U << 31)};
+
+// Returns the first 4 bytes of 'value', zero padded.
+inline int32_t loadPrefix(const char* value, int32_t length) {
+  int32_t prefix = 0;
+  if (length > 0) {
+    memcpy(&prefix, value, std::min(length, 4));
+  }
+  return prefix;
+}
+} // namespace
+
+xsimd::batch_bool<int32_t> BytesValues::testLengths(
+    xsimd::batch<int32_t> lengths) const {
+  const auto inBitmap = lengths < xsimd::broadcast<int32_t>(numLengthBits());
+  if (maxLength_ >= numLengthBits() &&
+      simd::toBitMask(inBitmap) != simd::allSetBitMask<int32_t>()) {
+    // Some lengths are above the bitmap but may match.
+    return Filter::testLengths(lengths);
+  }
+  // The lanes above the bitmap are longer than any value and get no bits.
+  const auto words = simd::maskGather<int32_t, int32_t, 4>(
+      xsimd::broadcast<int32_t>(0),
+      inBitmap,
+      reinterpret_cast<const int32_t*>(lengthBits_.data()),
+      lengths >> 5);
+  const auto wordBits = simd::gather<int32_t, int32_t, 4>(
+      kWordBits, lengths & xsimd::broadcast<int32_t>(31));
+  return (words & wordBits) != xsimd::broadcast<int32_t>(0);
+}
+
+void BytesValues::buildFingerprints() {
+  fingerprintValues_.clear();
+  fingerprintPrefixes_.clear();
+  fingerprintLengths_.clear();
+  if (values_.size() > kMaxFingerprintValues) {
+    return;
+  }
+  constexpr int32_t kBatchSize = xsimd::batch<int32_t>::size;
+  for (const auto& value : values_) {
+    fingerprintValues_.push_back(value);
+    fingerprintPrefixes_.push_back(loadPrefix(value.data(), value.size()));
+    fingerprintLengths_.push_back(value.size());
+  }
+  const auto paddedSize = bits::roundUp(values_.size(), kBatchSize);
+  fingerprintPrefixes_.resize(paddedSize, 0);
+  fingerprintLengths_.resize(paddedSize, -1);
+}
+
+bool BytesValues::testFingerprints(const char* value, int32_t length) const {
+  constexpr int32_t kBatchSize = xsimd::batch<int32_t>::size;
+  const auto prefix = xsimd::broadcast<int32_t>(loadPrefix(value, length));
+  const auto lengths = xsimd::broadcast<int32_t>(length);
+  for (auto i = 0; i < fingerprintLengths_.size(); i += kBatchSize) {
+    uint16_t candidates = simd::toBitMask(
+        (xsimd::load_unaligned(fingerprintPrefixes_.data() + i) == prefix) &
+        (xsimd::load_unaligned(fingerprintLengths_.data() + i) == lengths));
+    while (candidates) {
+      const auto& candidate =
+          fingerprintValues_[i + bits::getAndClearLastSetBit(candidates)];
+      if (length <= 4 ||
+          memcmp(candidate.data() + 4, value + 4, length - 4) == 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void BytesValues::buildPerfectHash() {
+  // Around 3 values per bucket and 20% free slots let most buckets find a
+  // seed in a few attempts.
+  constexpr uint32_t kMaxSeed = 1 << 16;
+  const auto numValues = values_.size();
+  hashedValues_.assign(values_.begin(), values_.end());
+  seeds_.assign(std::max<size_t>(1, numValues / 3), 0);
+  slots_.assign(numValues + numValues / 4 + 1, 0);
+
+  std::vector<uint64_t> hashes(numValues);
+  std::vector<std::vector<uint32_t>> buckets(seeds_.size());
+  for (auto i = 0; i < numValues; ++i) {
+    hashes[i] = hashBytes(hashedValues_[i].data(), hashedValues_[i].size());
+    buckets[bucketIndex(hashes[i])].push_back(i);
+  }
+  std::vector<uint32_t> order(buckets.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](auto left, auto right) {
+    return buckets[left].size() > buckets[right].size();
+  });
+
+  // Places the largest buckets first, while most slots are free.
+  std::vector<bool> usedSlots(slots_.size());
+  std::vector<uint32_t> bucketSlots;
+  for (auto bucket : order) {
+    const auto& indices = buckets[bucket];
+    if (indices.empty()) {
+      break;
+    }
+    bool placed = false;
+    for (uint32_t seed = 0; seed < kMaxSeed && !placed; ++seed) {
+      bucketSlots.clear();
+      for (auto index : indices) {
+        const auto slot = slotIndex(hashes[index], seed);
+        if (usedSlots[slot] ||
+            std::find(bucketSlots.begin(), bucketSlots.end(), slot) !=
+                bucketSlots.end()) {
+          break;
+        }
+        bucketSlots.push_back(slot);
+      }
+      if (bucketSlots.size() == indices.size()) {
+        for (auto i = 0; i < indices.size(); ++i) {
+          usedSlots[bucketSlots[i]] = true;
+          slots_[bucketSlots[i]] = indices[i];
+        }
+        seeds_[bucket] = seed;
+        placed = true;
+      }
+    }
+    if (!placed) {
+      // Values with equal hashes never get separate slots.
+      hashedValues_.clear();
+      seeds_.clear();
+      slots_.clear();
+      return;
+    }
+  }
+}
+
 bool BytesValues::testingEquals(const Filter& other) const {
   auto otherBytesValues = dynamic_cast<const BytesValues*>(&other);
   auto res = otherBytesValues != nullptr && Filter::testingBaseEquals(other) &&
@@ -961,6 +1125,48 @@ bool BigintValuesUsingHashTable::testInt64Range(
   return max >= *it;
 }
 
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  std::string bits(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bits.data());
+  obj["bloomFilter"] = folly::hexlify(bits);
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  std::string bits;
+  VELOX_CHECK(folly::unhexlify(obj["bloomFilter"].asString(), bits));
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(bits.data());
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed);
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloom = dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  if (otherBloom == nullptr || !Filter::testingBaseEquals(other) ||
+      min_ != otherBloom->min_ || max_ != otherBloom->max_) {
+    return false;
+  }
+  if (bloomFilter_ == otherBloom->bloomFilter_) {
+    return true;
+  }
+  const auto size = bloomFilter_->serializedSize();
+  if (size != otherBloom->bloomFilter_->serializedSize()) {
+    return false;
+  }
+  std::string bits(size, '\0');
+  std::string otherBits(size, '\0');
+  bloomFilter_->serialize(bits.data());
+  otherBloom->bloomFilter_->serialize(otherBits.data());
+  return bits == otherBits;
+}
+
 folly::dynamic HugeintValuesUsingHashTable::serialize() const {
   auto obj = Filter::serializeBase("HugeintValuesUsingHashTable");
   obj["min_lower"] = HugeInt::lower(min_);
@@ -1245,19 +1451,38 @@ bool BytesRange::testBytes(const char* value, int32_t length) const {
     }
     return memcmp(value, lower_.data(), length) == 0;
   }
+  const auto prefix = orderedPrefix(value, length);
   if (!lowerUnbounded_) {
-    int compare = compareRanges(value, length, lower_);
-    if (compare < 0 || (lowerExclusive_ && compare == 0)) {
+    if (prefix < lowerPrefix_) {
       return false;
     }
+    if (prefix == lowerPrefix_) {
+      int compare = compareRanges(value, length, lower_);
+      if (compare < 0 || (lowerExclusive_ && compare == 0)) {
+        return false;
+      }
+    }
   }
   if (!upperUnbounded_) {
+    if (prefix != upperPrefix_) {
+      return prefix < upperPrefix_;
+    }
     int compare = compareRanges(value, length, upper_);
     return compare < 0 || (!upperExclusive_ && compare == 0);
   }
   return true;
 }
 
+// static
+uint32_t BytesRange::orderedPrefix(const char* value, int32_t length) {
+  uint32_t prefix = 0;
+  if (length > 0) {
+    memcpy(&prefix, value, std::min(length, 4));
+  }
+  // The first byte is the most significant.
+  return folly::Endian::big(prefix);
+}
+
 bool BytesRange::testBytesRange(
     std::optional<std::string_view> min,
     std::optional<std::string_view> max,
@@ -1605,6 +1830,8 @@ std::unique_ptr<Filter> MultiRange::mergeWith(const Filter* other) const {
         return std::make_unique<MultiRange>(std::move(merged), bothNullAllowed);
       }
     }
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -1649,6 +1876,8 @@ std::unique_ptr<Filter> BoolValue::mergeWith(const Filter* other) const {
 
       return nullOrFalse(bothNullAllowed);
     }
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -1864,6 +2093,10 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
           std::make_unique<common::BigintRange>(lower_, upper_, false));
       return combineRangesAndNegatedValues(rangeList, vals, bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -1890,6 +2123,8 @@ std::unique_ptr<Filter> TimestampRange::mergeWith(const Filter* other) const {
 
       return nullOrFalse(bothNullAllowed);
     }
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -1983,6 +2218,10 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
           negatedValuesToRanges(rejectedValues),
           bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2041,6 +2280,10 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
       return mergeWith(min_, max_, other);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2134,6 +2377,10 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
       return mergeWith(min_, max_, other);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2188,6 +2435,10 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingBitmask: {
       return other->mergeWith(this);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2232,6 +2483,10 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
       return combineNegatedBigintLists(
           values(), otherBitmask->values(), bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2305,11 +2560,104 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
       bool bothNullAllowed = nullAllowed_ && other->testNull();
       return combineRangesAndNegatedValues(ranges_, rejects, bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
 }
 
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  const bool bothNullAllowed = nullAllowed_ && other->testNull();
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return this->clone(false);
+    case FilterKind::kBigintRange: {
+      auto otherRange = static_cast<const BigintRange*>(other);
+      const auto min = std::max(min_, otherRange->lower());
+      const auto max = std::min(max_, otherRange->upper());
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      // Two Bloom filters can not be intersected without the values they were
+      // made from. Keeps the Bloom filter of 'this' with the narrower range.
+      auto otherBloom = static_cast<const BigintValuesUsingBloomFilter*>(other);
+      const auto min = std::max(min_, otherBloom->min_);
+      const auto max = std::min(max_, otherBloom->max_);
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask: {
+      // The intersection with an exact IN-list is the subset of its values
+      // that may be in 'this'.
+      std::vector<int64_t> values;
+      if (other->kind() == FilterKind::kBigintValuesUsingHashTable) {
+        values = static_cast<const BigintValuesUsingHashTable*>(other)->values();
+      } else {
+        values = static_cast<const BigintValuesUsingBitmask*>(other)->values();
+      }
+      std::vector<int64_t> valuesToKeep;
+      valuesToKeep.reserve(values.size());
+      for (auto value : values) {
+        if (testInt64(value)) {
+          valuesToKeep.push_back(value);
+        }
+      }
+      return createBigintValues(valuesToKeep, bothNullAllowed);
+    }
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
+    default:
+      // The other filter is exact and can not absorb 'this'. Dropping 'this'
+      // gives a filter that passes a superset of the intersection, which is
+      // admissible since 'this' is itself only a superset of its values.
+      return other->clone(bothNullAllowed);
+  }
+}
+
+std::unique_ptr<Filter> FunctionFilter::mergeWith(const Filter* other) const {
+  return std::make_unique<FunctionFilter>(
+      function_->clone(),
+      functionNullAllowed_,
+      base_ == nullptr ? other->clone() : base_->mergeWith(other));
+}
+
+std::string FunctionFilter::toString() const {
+  return fmt::format(
+      "FunctionFilter: {}{} {}",
+      function_->toString(),
+      base_ == nullptr ? "" : fmt::format(" AND {}", base_->toString()),
+      functionNullAllowed_ ? "with nulls" : "no nulls");
+}
+
+bool FunctionFilter::testingEquals(const Filter& other) const {
+  auto otherFunction = dynamic_cast<const FunctionFilter*>(&other);
+  if (otherFunction == nullptr || !Filter::testingBaseEquals(other) ||
+      functionNullAllowed_ != otherFunction->functionNullAllowed_ ||
+      function_->toString() != otherFunction->function_->toString()) {
+    return false;
+  }
+  if (base_ == nullptr || otherFunction->base_ == nullptr) {
+    return base_ == otherFunction->base_;
+  }
+  return base_->testingEquals(*otherFunction->base_);
+}
+
 namespace {
 // compareResult = left < right for upper, right < left for lower
 bool mergeExclusive(int compareResult, bool left, bool right) {
@@ -2391,6 +2739,8 @@ std::unique_ptr<Filter> BytesRange::mergeWith(const Filter* other) const {
           bothNullAllowed);
     }
 
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2414,6 +2764,8 @@ std::unique_ptr<Filter> NegatedBytesRange::mergeWith(
       // these cases are likely to end up as a MultiRange anyway
       return other->mergeWith(toMultiRange().get());
     }
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2525,6 +2877,8 @@ std::unique_ptr<Filter> BytesValues::mergeWith(const Filter* other) const {
       return std::make_unique<BytesValues>(
           std::move(newValues), bothNullAllowed);
     }
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2626,6 +2980,8 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
           false));
       return std::make_unique<MultiRange>(std::move(ranges), bothNullAllowed);
     }
+    case FilterKind::kFunction:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
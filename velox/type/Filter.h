@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -24,7 +25,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -57,6 +60,8 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
+  kFunction,
 };
 
 class Filter;
@@ -1037,6 +1042,109 @@ class BigintValuesUsingHashTable final : public Filter {
   int32_t sizeMask_;
 };
 
+/// Probabilistic IN-list filter for integral data types, implemented as a
+/// Bloom filter. Used as a dynamic filter made from the keys of a hash join
+/// build side that has too many distinct keys for an exact IN-list. Values
+/// outside of [min, max] are rejected exactly. Other values not in the list
+/// pass with the false positive rate of the Bloom filter. The Bloom filter is
+/// immutable and shared between copies of 'this'.
+///
+/// Since the filter is a superset of the values it was made from, merging it
+/// with a filter that can not be intersected with a Bloom filter returns the
+/// other filter, which admits all values that pass both.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Bloom filter over hash(value) of all values passing the
+  /// filter.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(min),
+        max_(max),
+        bloomFilter_(std::move(bloomFilter)) {
+    VELOX_CHECK_LE(min_, max_);
+    VELOX_CHECK_NOT_NULL(bloomFilter_);
+  }
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, other.kind()),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_) {}
+
+  /// Returns the hash of 'value' to insert into or test against the Bloom
+  /// filter.
+  static uint64_t hash(int64_t value) {
+    return folly::hash::twang_mix64(value);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  bool testInt64(int64_t value) const final {
+    return value >= min_ && value <= max_ &&
+        bloomFilter_->mayContain(hash(value));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final {
+    if (hasNull && nullAllowed_) {
+      return true;
+    }
+    if (min == max) {
+      return testInt64(min);
+    }
+    return !(min > max_ || max < min_);
+  }
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  const std::shared_ptr<const BloomFilter<>>& bloomFilter() const {
+    return bloomFilter_;
+  }
+
+  std::string toString() const override {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {}",
+        min_,
+        max_,
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const int64_t min_;
+  const int64_t max_;
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+};
+
 /// IN-list filter for int128_t data type, implemented as a hash table.
 class HugeintValuesUsingHashTable final : public Filter {
  public:
@@ -1469,6 +1577,8 @@ class FloatingPointRange final : public AbstractRange {
             upperExclusive,
             bothNullAllowed);
       }
+      case FilterKind::kFunction:
+        return other->mergeWith(this);
       default:
         VELOX_UNREACHABLE();
     }
@@ -1632,7 +1742,9 @@ class BytesRange final : public AbstractRange {
         upper_(upper),
         singleValue_(
             !lowerExclusive_ && !upperExclusive_ && !lowerUnbounded_ &&
-            !upperUnbounded_ && lower_ == upper_) {
+            !upperUnbounded_ && lower_ == upper_),
+        lowerPrefix_(orderedPrefix(lower_.data(), lower_.size())),
+        upperPrefix_(orderedPrefix(upper_.data(), upper_.size())) {
     // Always-true filters should be specified using AlwaysTrue.
     VELOX_CHECK(!lowerUnbounded_ || !upperUnbounded_);
   }
@@ -1647,7 +1759,9 @@ class BytesRange final : public AbstractRange {
             FilterKind::kBytesRange),
         lower_(other.lower_),
         upper_(other.upper_),
-        singleValue_(other.singleValue_) {}
+        singleValue_(other.singleValue_),
+        lowerPrefix_(other.lowerPrefix_),
+        upperPrefix_(other.upperPrefix_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1718,9 +1832,19 @@ class BytesRange final : public AbstractRange {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Returns the first 4 bytes of 'value', zero padded, as a number that
+  // compares like the bytes. If the numbers of two strings are not equal, the
+  // strings compare the same way.
+  static uint32_t orderedPrefix(const char* value, int32_t length);
+
   const std::string lower_;
   const std::string upper_;
   const bool singleValue_;
+
+  // orderedPrefix() of 'lower_' and 'upper_'. Decide most testBytes() without
+  // a full compare.
+  const uint32_t lowerPrefix_;
+  const uint32_t upperPrefix_;
 };
 
 // Negated range filter for strings
@@ -1924,6 +2048,9 @@ class BytesValues final : public Filter {
 
     lower_ = *std::min_element(values_.begin(), values_.end());
     upper_ = *std::max_element(values_.begin(), values_.end());
+    buildLengthBits();
+    buildFingerprints();
+    buildPerfectHash();
   }
 
   BytesValues(const BytesValues& other, bool nullAllowed)
@@ -1931,7 +2058,15 @@ class BytesValues final : public Filter {
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_),
+        maxLength_(other.maxLength_),
+        lengthBits_(other.lengthBits_),
+        fingerprintValues_(other.fingerprintValues_),
+        fingerprintPrefixes_(other.fingerprintPrefixes_),
+        fingerprintLengths_(other.fingerprintLengths_),
+        hashedValues_(other.hashedValues_),
+        seeds_(other.seeds_),
+        slots_(other.slots_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1947,12 +2082,27 @@ class BytesValues final : public Filter {
   }
 
   bool testLength(int32_t length) const final {
-    return lengths_.contains(length);
+    if (length < numLengthBits()) {
+      return bits::isBitSet(lengthBits_.data(), length);
+    }
+    return length <= maxLength_ && lengths_.contains(length);
   }
 
+  xsimd::batch_bool<int32_t> testLengths(
+      xsimd::batch<int32_t> lengths) const final;
+
   bool testBytes(const char* value, int32_t length) const final {
-    return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+    if (!fingerprintLengths_.empty()) {
+      return testFingerprints(value, length);
+    }
+    if (!slots_.empty()) {
+      const auto hash = hashBytes(value, length);
+      const auto& candidate =
+          hashedValues_[slots_[slotIndex(hash, seeds_[bucketIndex(hash)])]];
+      return candidate.size() == length &&
+          (length == 0 || memcmp(candidate.data(), value, length) == 0);
+    }
+    return testLength(length) && values_.contains(std::string(value, length));
   }
 
   bool testBytesRange(
@@ -1966,13 +2116,92 @@ class BytesValues final : public Filter {
     return values_;
   }
 
+  /// True if testBytes() looks up values in a perfect hash table.
+  bool testingHasPerfectHash() const {
+    return !slots_.empty();
+  }
+
+  /// True if testBytes() compares with the fingerprints of all values.
+  bool testingHasFingerprints() const {
+    return !fingerprintLengths_.empty();
+  }
+
+  /// Max number of values for which testBytes() compares fingerprints instead
+  /// of probing a hash table.
+  static constexpr int32_t kMaxFingerprintValues = 32;
+
+  /// Lengths below this are looked up in a bitmap.
+  static constexpr int32_t kMaxLengthBits = 1 << 16;
+
   bool testingEquals(const Filter& other) const final;
 
  private:
+  static uint64_t hashBytes(const char* value, int32_t length) {
+    return folly::hasher<std::string_view>()(std::string_view(value, length));
+  }
+
+  // Maps 'x' to [0, 'n') without a division.
+  static uint32_t fastRange(uint32_t x, size_t n) {
+    return (static_cast<uint64_t>(x) * n) >> 32;
+  }
+
+  uint32_t bucketIndex(uint64_t hash) const {
+    return fastRange(hash >> 32, seeds_.size());
+  }
+
+  uint32_t slotIndex(uint64_t hash, uint32_t seed) const {
+    return fastRange(
+        folly::hash::twang_mix64(hash + seed * 0x9E3779B97F4A7C15ULL),
+        slots_.size());
+  }
+
+  int32_t numLengthBits() const {
+    return std::min(maxLength_ + 1, kMaxLengthBits);
+  }
+
+  // Sets 'maxLength_' and the bits of the lengths below numLengthBits() in
+  // 'lengthBits_'.
+  void buildLengthBits();
+
+  // Fills the fingerprint arrays if there are at most kMaxFingerprintValues
+  // values.
+  void buildFingerprints();
+
+  // Compares the length and the first 4 bytes of 'value' with those of all
+  // values at once and compares the rest of the bytes only for the equal
+  // ones.
+  bool testFingerprints(const char* value, int32_t length) const;
+
+  // Builds 'seeds_' and 'slots_' so that each value in 'values_' has its own
+  // slot, found with one hash and no probing. Leaves them empty if no such
+  // table is found, in which case 'values_' is probed instead.
+  void buildPerfectHash();
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+
+  // Length of the longest value.
+  int32_t maxLength_{0};
+
+  // Bit 'i' is set if a value has length 'i'. Covers numLengthBits() bits.
+  std::vector<uint64_t> lengthBits_;
+
+  // The values of a short list, with their first 4 bytes, zero padded, and
+  // lengths at the same index. The prefix and length arrays are padded to a
+  // multiple of the SIMD width with lengths that match no value.
+  std::vector<std::string> fingerprintValues_;
+  std::vector<int32_t> fingerprintPrefixes_;
+  std::vector<int32_t> fingerprintLengths_;
+
+  // Perfect hash over 'values_'. A hash selects a bucket, the seed of the
+  // bucket and the hash select a slot and the slot has the index of the only
+  // value in 'hashedValues_' that can be equal. Unused slots refer to an
+  // arbitrary value, so that a probe always compares with some value.
+  std::vector<std::string> hashedValues_;
+  std::vector<uint32_t> seeds_;
+  std::vector<uint32_t> slots_;
 };
 
 /// Represents a combination of two of more range filters on integral types with
@@ -2130,6 +2359,215 @@ class MultiRange final : public Filter {
   const std::vector<std::unique_ptr<Filter>> filters_;
 };
 
+/// Tests the values of a column with a predicate that has no filter kind of
+/// its own, e.g. an expression like length(c) > 5 over the column. This lets
+/// the selective readers evaluate such predicates while decoding: once per
+/// distinct value of dictionary encoded data, and before the later columns of
+/// the scan are read. The predicate is given as a Function that is implemented
+/// outside of this library, e.g. by a compiled expression.
+///
+/// 'base' is an optional filter on the same column that the values must pass
+/// as well. Merges with other filters go into 'base'. The range tests used for
+/// pruning with statistics consult only 'base' since a function can not be
+/// tested against a range of values.
+class FunctionFilter final : public Filter {
+ public:
+  /// Evaluates a predicate on batches of values of one column. The values are
+  /// given as int64_t for integers and dates, as int128_t for long decimals,
+  /// as StringView for strings and binaries, and in their own type otherwise.
+  /// An instance is used by one thread at a time.
+  class Function {
+   public:
+    virtual ~Function() = default;
+
+    /// Returns a copy with its own evaluation state.
+    virtual std::unique_ptr<Function> clone() const = 0;
+
+    /// Sets 'passed[i]' to true if 'values[i]' passes, for i in [0, size).
+    virtual void test(const int64_t* values, int32_t size, bool* passed) = 0;
+
+    virtual void test(const int128_t* values, int32_t size, bool* passed) = 0;
+
+    virtual void test(const float* values, int32_t size, bool* passed) = 0;
+
+    virtual void test(const double* values, int32_t size, bool* passed) = 0;
+
+    virtual void test(const bool* values, int32_t size, bool* passed) = 0;
+
+    virtual void test(const StringView* values, int32_t size, bool* passed) = 0;
+
+    virtual void test(const Timestamp* values, int32_t size, bool* passed) = 0;
+
+    virtual std::string toString() const = 0;
+  };
+
+  /// @param function The predicate.
+  /// @param nullAllowed Null values pass the predicate if true.
+  /// @param base Optional filter that the values must pass as well.
+  FunctionFilter(
+      std::unique_ptr<Function> function,
+      bool nullAllowed,
+      std::unique_ptr<Filter> base = nullptr)
+      : Filter(
+            base == nullptr || base->isDeterministic(),
+            nullAllowed && (base == nullptr || base->testNull()),
+            FilterKind::kFunction),
+        function_(std::move(function)),
+        functionNullAllowed_(nullAllowed),
+        base_(std::move(base)) {
+    VELOX_CHECK_NOT_NULL(function_);
+  }
+
+  folly::dynamic serialize() const override {
+    VELOX_UNSUPPORTED("{} can not be serialized", toString());
+  }
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    return std::make_unique<FunctionFilter>(
+        function_->clone(),
+        nullAllowed.value_or(functionNullAllowed_),
+        base_ == nullptr ? nullptr : base_->clone(nullAllowed));
+  }
+
+  bool testInt64(int64_t value) const final {
+    return (base_ == nullptr || base_->testInt64(value)) && testValue(value);
+  }
+
+  bool testInt128(const int128_t& value) const final {
+    return (base_ == nullptr || base_->testInt128(value)) && testValue(value);
+  }
+
+  bool testDouble(double value) const final {
+    return (base_ == nullptr || base_->testDouble(value)) && testValue(value);
+  }
+
+  bool testFloat(float value) const final {
+    return (base_ == nullptr || base_->testFloat(value)) && testValue(value);
+  }
+
+  bool testBool(bool value) const final {
+    return (base_ == nullptr || base_->testBool(value)) && testValue(value);
+  }
+
+  bool testBytes(const char* value, int32_t length) const final {
+    return (base_ == nullptr || base_->testBytes(value, length)) &&
+        testValue(StringView(value, length));
+  }
+
+  bool testTimestamp(const Timestamp& value) const final {
+    return (base_ == nullptr || base_->testTimestamp(value)) &&
+        testValue(value);
+  }
+
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t> x) const final {
+    return testBatch<int64_t>(x);
+  }
+
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t> x) const final {
+    return testBatch<int64_t>(x);
+  }
+
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
+    return testBatch<int64_t>(x);
+  }
+
+  xsimd::batch_bool<double> testValues(xsimd::batch<double> x) const final {
+    return testBatch<double>(x);
+  }
+
+  xsimd::batch_bool<float> testValues(xsimd::batch<float> x) const final {
+    return testBatch<float>(x);
+  }
+
+  bool hasTestLength() const final {
+    return base_ != nullptr && base_->hasTestLength();
+  }
+
+  bool testLength(int32_t length) const final {
+    return base_ == nullptr || base_->testLength(length);
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final {
+    return base_ == nullptr || base_->testInt64Range(min, max, hasNull);
+  }
+
+  bool testInt128Range(
+      const int128_t& min,
+      const int128_t& max,
+      bool hasNull) const final {
+    return base_ == nullptr || base_->testInt128Range(min, max, hasNull);
+  }
+
+  bool testDoubleRange(double min, double max, bool hasNull) const final {
+    return base_ == nullptr || base_->testDoubleRange(min, max, hasNull);
+  }
+
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const final {
+    return base_ == nullptr || base_->testBytesRange(min, max, hasNull);
+  }
+
+  bool testTimestampRange(
+      const Timestamp& min,
+      const Timestamp& max,
+      bool hasNull) const final {
+    return base_ == nullptr || base_->testTimestampRange(min, max, hasNull);
+  }
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  const Function& function() const {
+    return *function_;
+  }
+
+  const Filter* base() const {
+    return base_.get();
+  }
+
+  std::string toString() const override;
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  template <typename T>
+  bool testValue(T value) const {
+    bool passed;
+    function_->test(&value, 1, &passed);
+    return passed;
+  }
+
+  // Tests the lanes of 'batch' with one call of 'function_'. The values are
+  // given to 'function_' as 'V'.
+  template <typename V, typename T>
+  xsimd::batch_bool<T> testBatch(xsimd::batch<T> batch) const {
+    constexpr int N = decltype(batch)::size;
+    constexpr int kAlign = decltype(batch)::arch_type::alignment();
+    alignas(kAlign) T data[N];
+    batch.store_aligned(data);
+    V values[N];
+    std::copy(data, data + N, values);
+    bool passed[N];
+    function_->test(values, N, passed);
+    alignas(kAlign) T result[N];
+    for (int i = 0; i < N; ++i) {
+      result[i] = passed[i];
+    }
+    const auto functionResult =
+        xsimd::broadcast<T>(0) != xsimd::load_aligned(result);
+    if (base_ == nullptr) {
+      return functionResult;
+    }
+    return functionResult & base_->testValues(batch);
+  }
+
+  const std::unique_ptr<Function> function_;
+  const bool functionNullAllowed_;
+  const std::unique_ptr<Filter> base_;
+};
+
 // Helper for applying filters to different types
 template <typename TFilter, typename T>
 static inline bool applyFilter(TFilter& filter, T value) {
@@ -91,6 +91,22 @@ void Timestamp::toTimezone(const tz::TimeZone& zone) {
   }
 }
 
+// static
+void Timestamp::toTimezone(
+    const tz::TimeZone& zone,
+    Timestamp* timestamps,
+    size_t size) {
+  const auto& table = zone.transitionTable();
+  for (size_t i = 0; i < size; ++i) {
+    auto& timestamp = timestamps[i];
+    if (table.contains(timestamp.seconds_)) {
+      timestamp.seconds_ += table.offsetAt(timestamp.seconds_);
+    } else {
+      timestamp.toTimezone(zone);
+    }
+  }
+}
+
 const tz::TimeZone& Timestamp::defaultTimezone() {
   static const tz::TimeZone* kDefault = ({
     // TODO: We are hard-coding PST/PDT here to be aligned with the current
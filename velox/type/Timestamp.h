@@ -374,6 +374,13 @@ struct Timestamp {
   ///  ts.toString(); // returns December 31, 1969 16:00:00
   void toTimezone(const tz::TimeZone& zone);
 
+  /// Converts 'size' GMT timestamps starting at 'timestamps' to the time at
+  /// the same moment at zone, e.g. the values of a FlatVector<Timestamp>.
+  /// Same as calling toTimezone() on each of them, but looks up the zone
+  /// offsets once for the batch.
+  static void
+  toTimezone(const tz::TimeZone& zone, Timestamp* timestamps, size_t size);
+
   /// A default time zone that is same across the process.
   static const tz::TimeZone& defaultTimezone();
 
@@ -278,6 +278,102 @@ TEST(FilterTest, bigintValuesUsingHashTable) {
   EXPECT_TRUE(filter->testInt64Range(0, 1, false));
 }
 
+namespace {
+std::unique_ptr<BigintValuesUsingBloomFilter> makeBloomFilter(
+    const std::vector<int64_t>& values,
+    bool nullAllowed) {
+  auto bloomFilter = std::make_shared<facebook::velox::BloomFilter<>>();
+  bloomFilter->reset(values.size());
+  for (auto value : values) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hash(value));
+  }
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      *std::min_element(values.begin(), values.end()),
+      *std::max_element(values.begin(), values.end()),
+      std::move(bloomFilter),
+      nullAllowed);
+}
+} // namespace
+
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 10'000; ++i) {
+    values.push_back(i * 7);
+  }
+  auto filter = makeBloomFilter(values, false);
+  for (auto value : values) {
+    ASSERT_TRUE(filter->testInt64(value));
+  }
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_FALSE(filter->testInt64(-1));
+  EXPECT_FALSE(filter->testInt64(70'000));
+  EXPECT_FALSE(filter->testInt64(INT64_MAX));
+
+  // Values not in the list mostly fail.
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < 10'000; ++i) {
+    numFalsePositives += filter->testInt64(i * 7 + 3);
+  }
+  EXPECT_LT(numFalsePositives, 500);
+
+  EXPECT_TRUE(filter->testInt64Range(0, 100, false));
+  EXPECT_FALSE(filter->testInt64Range(-10, -5, false));
+  EXPECT_FALSE(filter->testInt64Range(70'000, 80'000, false));
+  EXPECT_FALSE(filter->testInt64Range(-10, -5, true));
+  EXPECT_TRUE(makeBloomFilter(values, true)->testInt64Range(-10, -5, true));
+
+  // The clone shares the Bloom filter.
+  auto clone = filter->clone(true);
+  EXPECT_TRUE(clone->testNull());
+  EXPECT_EQ(
+      static_cast<BigintValuesUsingBloomFilter*>(clone.get())->bloomFilter(),
+      filter->bloomFilter());
+}
+
+TEST(FilterTest, mergeWithBloomFilter) {
+  auto bloomFilter = makeBloomFilter({1, 10, 100, 1'000, 10'000}, false);
+
+  // Range narrows the range of the Bloom filter.
+  BigintRange range(5, 500, false);
+  auto testRange = [](const std::unique_ptr<Filter>& merged) {
+    ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+    EXPECT_FALSE(merged->testInt64(1));
+    EXPECT_TRUE(merged->testInt64(10));
+    EXPECT_TRUE(merged->testInt64(100));
+    EXPECT_FALSE(merged->testInt64(1'000));
+  };
+  testRange(bloomFilter->mergeWith(&range));
+  testRange(range.mergeWith(bloomFilter.get()));
+
+  // Disjoint range gives always false.
+  BigintRange disjoint(20'000, 30'000, false);
+  EXPECT_EQ(
+      bloomFilter->mergeWith(&disjoint)->kind(), FilterKind::kAlwaysFalse);
+
+  // Exact values keep the subset passing the Bloom filter.
+  auto values = createBigintValues({1, 2, 3, 10, 10'000, 20'000}, false);
+  auto testValues = [](const std::unique_ptr<Filter>& merged) {
+    EXPECT_TRUE(merged->testInt64(1));
+    EXPECT_TRUE(merged->testInt64(10));
+    EXPECT_TRUE(merged->testInt64(10'000));
+    EXPECT_FALSE(merged->testInt64(20'000));
+    EXPECT_FALSE(merged->testInt64(100));
+  };
+  testValues(bloomFilter->mergeWith(values.get()));
+  testValues(values->mergeWith(bloomFilter.get()));
+
+  // Filters that can not be intersected with a Bloom filter are kept as is.
+  auto negated = createNegatedBigintValues({10, 100}, false);
+  EXPECT_TRUE(bloomFilter->mergeWith(negated.get())->testingEquals(*negated));
+  EXPECT_TRUE(negated->mergeWith(bloomFilter.get())->testingEquals(*negated));
+
+  IsNotNull isNotNull;
+  auto nullAllowed = makeBloomFilter({1, 10}, true);
+  auto merged = nullAllowed->mergeWith(&isNotNull);
+  EXPECT_FALSE(merged->testNull());
+  EXPECT_TRUE(merged->testInt64(10));
+}
+
 TEST(FilterTest, negatedBigintValuesUsingHashTable) {
   auto filter = createNegatedBigintValues({1, 6, 10'000, 8, 9, 100, 10}, false);
   auto castedFilter =
@@ -974,6 +1070,156 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bytesValuesPerfectHash) {
+  // A list the size of ids pasted into a query, including the empty string
+  // and values that differ only in the last byte.
+  std::vector<std::string> values;
+  for (auto i = 0; i < 10'000; ++i) {
+    values.push_back(fmt::format("id-{}-{}", i, std::string(i % 20, 'x')));
+  }
+  values.push_back("");
+  BytesValues filter(values, false);
+  ASSERT_TRUE(filter.testingHasPerfectHash());
+  for (const auto& value : values) {
+    ASSERT_TRUE(filter.testBytes(value.data(), value.size())) << value;
+  }
+  for (auto i = 0; i < 10'000; ++i) {
+    auto value = fmt::format("id-{}-{}", i, std::string(i % 20 + 1, 'x'));
+    ASSERT_FALSE(filter.testBytes(value.data(), value.size())) << value;
+    value = fmt::format("id-{}-{}y", i, std::string(i % 20, 'x'));
+    ASSERT_FALSE(filter.testBytes(value.data(), value.size())) << value;
+  }
+
+  // Copies and clones keep probing the table.
+  auto clone = filter.clone(true);
+  ASSERT_TRUE(clone->testBytes(values[123].data(), values[123].size()));
+  ASSERT_FALSE(clone->testBytes("idd", 3));
+  ASSERT_TRUE(clone->testNull());
+
+  // An empty string is not found unless in the list.
+  BytesValues single({"a"}, false);
+  ASSERT_TRUE(single.testingHasPerfectHash());
+  ASSERT_TRUE(single.testBytes("a", 1));
+  ASSERT_FALSE(single.testBytes("", 0));
+  ASSERT_FALSE(single.testBytes("b", 1));
+}
+
+TEST(FilterTest, bytesValuesFingerprints) {
+  // Values that share the first 4 bytes and the length, and values shorter
+  // than 4 bytes, including one with a zero byte.
+  std::vector<std::string> values{
+      "", "a", "ab", std::string("a\0", 2), "abcdX", "abcdY", "abcdXY"};
+  BytesValues filter(values, false);
+  ASSERT_TRUE(filter.testingHasFingerprints());
+  for (const auto& value : values) {
+    ASSERT_TRUE(filter.testBytes(value.data(), value.size())) << value;
+  }
+  for (const std::string value :
+       {"b", "abc", "abcd", "abcdZ", "abcdYX", "abcdXZ", "bbcdX"}) {
+    ASSERT_FALSE(filter.testBytes(value.data(), value.size())) << value;
+  }
+  ASSERT_FALSE(filter.testBytes(std::string("a\0\0", 3).data(), 3));
+
+  // A longer list probes the hash table.
+  values.clear();
+  for (auto i = 0; i <= BytesValues::kMaxFingerprintValues; ++i) {
+    values.push_back(fmt::format("value-{}", i));
+  }
+  BytesValues longList(values, false);
+  ASSERT_FALSE(longList.testingHasFingerprints());
+  ASSERT_TRUE(longList.testBytes(values.back().data(), values.back().size()));
+  ASSERT_FALSE(longList.testBytes("value-", 6));
+}
+
+TEST(FilterTest, bytesValuesLengths) {
+  constexpr int32_t kBatchSize = xsimd::batch<int32_t>::size;
+  const auto checkLengths = [](const BytesValues& filter,
+                               const std::vector<int32_t>& lengths) {
+    for (auto i = 0; i + kBatchSize <= lengths.size(); i += kBatchSize) {
+      uint64_t expected = 0;
+      for (auto j = 0; j < kBatchSize; ++j) {
+        if (filter.testLength(lengths[i + j])) {
+          expected |= 1 << j;
+        }
+      }
+      ASSERT_EQ(
+          expected,
+          static_cast<uint64_t>(simd::toBitMask(
+              filter.testLengths(xsimd::load_unaligned(lengths.data() + i)))));
+    }
+  };
+
+  BytesValues filter(
+      {"",
+       "a",
+       std::string(31, 'a'),
+       std::string(32, 'a'),
+       std::string(200, 'a')},
+      false);
+  for (auto length : {0, 1, 31, 32, 200}) {
+    ASSERT_TRUE(filter.testLength(length));
+  }
+  for (auto length : {2, 30, 33, 64, 199, 201, 1'000'000}) {
+    ASSERT_FALSE(filter.testLength(length));
+  }
+  std::vector<int32_t> lengths;
+  for (auto i = 0; i < 256; ++i) {
+    lengths.push_back(i);
+  }
+  lengths.insert(lengths.end(), {1'000'000, 200, 0, 5, 32, 33, 2, 1});
+  checkLengths(filter, lengths);
+
+  // Lengths past the bitmap.
+  const auto longLength = BytesValues::kMaxLengthBits + 10;
+  BytesValues longFilter({"abc", std::string(longLength, 'a')}, false);
+  ASSERT_TRUE(longFilter.testLength(3));
+  ASSERT_TRUE(longFilter.testLength(longLength));
+  ASSERT_FALSE(longFilter.testLength(longLength - 1));
+  ASSERT_FALSE(longFilter.testLength(longLength + 1));
+  lengths.insert(
+      lengths.end(),
+      {3, longLength, longLength + 1, 4, longLength - 1, 0, 3, longLength});
+  checkLengths(longFilter, lengths);
+}
+
+TEST(FilterTest, bytesRangePrefix) {
+  // Strings that differ in and after the first 4 bytes, including zero bytes
+  // and bytes above 127.
+  std::vector<std::string> strings{"a", "ab", "abc", "abcd", "abcde"};
+  strings.push_back(std::string("a\0", 2));
+  strings.push_back(std::string("abcd\0", 5));
+  strings.push_back(std::string("ab\0\0\0", 5));
+  strings.push_back("\xff");
+  strings.push_back("ab\xff");
+  strings.push_back("abcd\xff");
+  strings.push_back("b");
+  for (const auto& lower : strings) {
+    for (const auto& upper : strings) {
+      if (upper < lower) {
+        continue;
+      }
+      for (auto exclusive : {false, true}) {
+        BytesRange range(
+            lower, false, exclusive, upper, false, exclusive, false);
+        BytesRange lowerOnly(lower, false, exclusive, "", true, false, false);
+        BytesRange upperOnly("", true, false, upper, false, exclusive, false);
+        for (const auto& value : strings) {
+          const bool aboveLower = exclusive ? value > lower : value >= lower;
+          const bool belowUpper = exclusive ? value < upper : value <= upper;
+          ASSERT_EQ(
+              range.testBytes(value.data(), value.size()),
+              aboveLower && belowUpper)
+              << lower << " " << upper << " " << value;
+          ASSERT_EQ(
+              lowerOnly.testBytes(value.data(), value.size()), aboveLower);
+          ASSERT_EQ(
+              upperOnly.testBytes(value.data(), value.size()), belowUpper);
+        }
+      }
+    }
+  }
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(
@@ -1889,3 +2135,164 @@ TEST(FilterTest, timestampRange) {
   EXPECT_TRUE(filter->testTimestampRange(
       Timestamp(5, 123000000), Timestamp(30, 123000000), true));
 }
+
+namespace {
+// Passes multiples of 'divisor' and strings beginning with 'prefix'. Counts
+// the calls to test().
+class TestFunction : public FunctionFilter::Function {
+ public:
+  TestFunction(int64_t divisor, std::string prefix, int32_t& numCalls)
+      : divisor_(divisor), prefix_(std::move(prefix)), numCalls_(numCalls) {}
+
+  std::unique_ptr<Function> clone() const override {
+    return std::make_unique<TestFunction>(divisor_, prefix_, numCalls_);
+  }
+
+  void test(const int64_t* values, int32_t size, bool* passed) override {
+    testNumbers(values, size, passed);
+  }
+
+  void test(const int128_t* values, int32_t size, bool* passed) override {
+    testNumbers(values, size, passed);
+  }
+
+  void test(const float* values, int32_t size, bool* passed) override {
+    testNumbers(values, size, passed);
+  }
+
+  void test(const double* values, int32_t size, bool* passed) override {
+    testNumbers(values, size, passed);
+  }
+
+  void test(const bool* values, int32_t size, bool* passed) override {
+    testNumbers(values, size, passed);
+  }
+
+  void test(const StringView* values, int32_t size, bool* passed) override {
+    ++numCalls_;
+    for (auto i = 0; i < size; ++i) {
+      passed[i] = std::string_view(values[i]).substr(0, prefix_.size()) ==
+          prefix_;
+    }
+  }
+
+  void test(const Timestamp* values, int32_t size, bool* passed) override {
+    ++numCalls_;
+    for (auto i = 0; i < size; ++i) {
+      passed[i] = values[i].getSeconds() % divisor_ == 0;
+    }
+  }
+
+  std::string toString() const override {
+    return fmt::format("test({}, {})", divisor_, prefix_);
+  }
+
+ private:
+  template <typename T>
+  void testNumbers(const T* values, int32_t size, bool* passed) {
+    ++numCalls_;
+    for (auto i = 0; i < size; ++i) {
+      passed[i] = static_cast<int64_t>(values[i]) % divisor_ == 0;
+    }
+  }
+
+  const int64_t divisor_;
+  const std::string prefix_;
+  int32_t& numCalls_;
+};
+} // namespace
+
+TEST(FilterTest, functionFilter) {
+  int32_t numCalls = 0;
+  FunctionFilter filter(
+      std::make_unique<TestFunction>(3, "ab", numCalls), false);
+  EXPECT_EQ(filter.kind(), FilterKind::kFunction);
+  EXPECT_TRUE(filter.isDeterministic());
+  EXPECT_FALSE(filter.testNull());
+  EXPECT_TRUE(filter.testInt64(9));
+  EXPECT_FALSE(filter.testInt64(10));
+  EXPECT_TRUE(filter.testDouble(6));
+  EXPECT_FALSE(filter.testFloat(7));
+  EXPECT_TRUE(filter.testInt128(HugeInt::build(0, 12)));
+  EXPECT_TRUE(filter.testTimestamp(Timestamp(30, 0)));
+  EXPECT_FALSE(filter.testTimestamp(Timestamp(31, 0)));
+  EXPECT_TRUE(filter.testBytes("abc", 3));
+  EXPECT_FALSE(filter.testBytes("bac", 3));
+  EXPECT_FALSE(filter.testBytes("a", 1));
+  EXPECT_EQ(numCalls, 10);
+
+  // Nothing is known about ranges and lengths, so these pass.
+  EXPECT_TRUE(filter.testInt64Range(1, 2, false));
+  EXPECT_TRUE(filter.testDoubleRange(1, 2, false));
+  EXPECT_TRUE(filter.testBytesRange("x", "y", false));
+  EXPECT_FALSE(filter.hasTestLength());
+  EXPECT_EQ(filter.toString(), "FunctionFilter: test(3, ab) no nulls");
+
+  // A batch of values takes one call.
+  numCalls = 0;
+  std::vector<int64_t> numbers(1'000);
+  std::iota(numbers.begin(), numbers.end(), 0);
+  auto verify = [](int64_t x) { return x % 3 == 0; };
+  applySimdTestToVector(numbers, filter, verify);
+  EXPECT_EQ(numCalls, (numbers.size() - 1) / xsimd::batch<int64_t>::size);
+  std::vector<int32_t> numbers32(numbers.begin(), numbers.end());
+  applySimdTestToVector(numbers32, filter, verify);
+  std::vector<double> doubles(numbers.begin(), numbers.end());
+  applySimdTestToVector(doubles, filter, [](double x) {
+    return static_cast<int64_t>(x) % 3 == 0;
+  });
+
+  auto clone = filter.clone(true);
+  EXPECT_TRUE(clone->testNull());
+  EXPECT_TRUE(clone->testInt64(3));
+  EXPECT_TRUE(clone->testingEquals(*clone->clone()));
+  EXPECT_FALSE(clone->testingEquals(filter));
+}
+
+TEST(FilterTest, mergeWithFunctionFilter) {
+  int32_t numCalls = 0;
+  auto function = std::make_unique<FunctionFilter>(
+      std::make_unique<TestFunction>(2, "a", numCalls), true);
+
+  // The other filter becomes the base of the function filter.
+  BigintRange range(10, 20, false);
+  auto testRange = [&](const std::unique_ptr<Filter>& merged) {
+    ASSERT_EQ(merged->kind(), FilterKind::kFunction);
+    EXPECT_FALSE(merged->testNull());
+    EXPECT_FALSE(merged->testInt64(8));
+    EXPECT_FALSE(merged->testInt64(11));
+    EXPECT_TRUE(merged->testInt64(12));
+    EXPECT_TRUE(merged->testInt64Range(0, 10, false));
+    EXPECT_FALSE(merged->testInt64Range(0, 5, false));
+    // The base is tested first.
+    numCalls = 0;
+    EXPECT_FALSE(merged->testInt64(30));
+    EXPECT_EQ(numCalls, 0);
+  };
+  testRange(function->mergeWith(&range));
+  testRange(range.mergeWith(function.get()));
+
+  BytesValues strings({"ab", "b", "ac"}, true);
+  auto merged = strings.mergeWith(function.get());
+  EXPECT_TRUE(merged->testNull());
+  EXPECT_TRUE(merged->testBytes("ab", 2));
+  EXPECT_FALSE(merged->testBytes("b", 1));
+  EXPECT_FALSE(merged->testBytes("abc", 3));
+  EXPECT_FALSE(merged->testLength(3));
+
+  // Merging two function filters tests both functions.
+  merged = function->mergeWith(
+      FunctionFilter(std::make_unique<TestFunction>(3, "ab", numCalls), false)
+          .mergeWith(&range)
+          .get());
+  EXPECT_FALSE(merged->testNull());
+  EXPECT_TRUE(merged->testInt64(12));
+  EXPECT_FALSE(merged->testInt64(14));
+  EXPECT_FALSE(merged->testInt64(15));
+  EXPECT_FALSE(merged->testInt64(24));
+
+  IsNotNull isNotNull;
+  EXPECT_FALSE(function->mergeWith(&isNotNull)->testNull());
+  EXPECT_TRUE(function->mergeWith(&isNotNull)->testInt64(2));
+  EXPECT_FALSE(isNotNull.mergeWith(function.get())->testInt64(3));
+}
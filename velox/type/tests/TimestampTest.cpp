@@ -382,6 +382,27 @@ TEST(TimestampTest, decreaseOperator) {
   VELOX_ASSERT_THROW(--kMin, "Timestamp nanos out of range");
 }
 
+TEST(TimestampTest, toTimezoneBatch) {
+  const auto* timezone = tz::locateZone("America/Los_Angeles");
+  // Includes values before and after the range of the zone's transition
+  // table, which are converted one at a time.
+  std::vector<Timestamp> timestamps = {
+      Timestamp(0, 0),
+      Timestamp(1710064799, 1),
+      Timestamp(1710064800, 2),
+      Timestamp(-1, 999'999'999),
+      Timestamp(-2'208'988'801, 0),
+      Timestamp(4'102'444'800, 0),
+      Timestamp(253402300799, 0),
+  };
+  auto expected = timestamps;
+  for (auto& timestamp : expected) {
+    timestamp.toTimezone(*timezone);
+  }
+  Timestamp::toTimezone(*timezone, timestamps.data(), timestamps.size());
+  EXPECT_EQ(timestamps, expected);
+}
+
 TEST(TimestampTest, outOfRange) {
   // external/date cannot handle years larger than 32k (date::year::max()).
   // Any conversions exceeding that threshold will fail right away.
@@ -453,14 +453,49 @@ TimeZone::milliseconds TimeZone::to_sys(
 }
 
 TimeZone::seconds TimeZone::to_local(TimeZone::seconds timestamp) const {
+  const auto& table = transitionTable();
+  if (table.contains(timestamp.count())) {
+    return timestamp + seconds(table.offsetAt(timestamp.count()));
+  }
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
 TimeZone::milliseconds TimeZone::to_local(
     TimeZone::milliseconds timestamp) const {
+  const auto& table = transitionTable();
+  const auto sysSeconds = date::floor<seconds>(timestamp).count();
+  if (table.contains(sysSeconds)) {
+    return timestamp + seconds(table.offsetAt(sysSeconds));
+  }
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
+const TransitionTable& TimeZone::transitionTable() const {
+  std::call_once(transitionTableOnce_, [&]() {
+    // 1900-01-01 and 2100-01-01 00:00:00 GMT.
+    static constexpr int64_t kBegin = -2'208'988'800;
+    static constexpr int64_t kEnd = 4'102'444'800;
+    std::vector<int64_t> starts;
+    std::vector<int64_t> offsets;
+    if (tz_ == nullptr) {
+      starts.push_back(kBegin);
+      offsets.push_back(seconds(offset_).count());
+    } else {
+      date::sys_seconds time{seconds(kBegin)};
+      while (time.time_since_epoch().count() < kEnd) {
+        const auto info = tz_->get_info(time);
+        VELOX_CHECK_GT(info.end, time);
+        starts.push_back(time.time_since_epoch().count());
+        offsets.push_back(info.offset.count());
+        time = info.end;
+      }
+    }
+    transitionTable_ = std::make_unique<TransitionTable>(
+        std::move(starts), std::move(offsets), kEnd);
+  });
+  return *transitionTable_;
+}
+
 TimeZone::seconds TimeZone::correct_nonexistent_time(
     TimeZone::seconds timestamp) const {
   // If this is an offset time zone.
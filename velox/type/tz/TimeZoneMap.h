@@ -17,6 +17,8 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -75,6 +77,48 @@ using time_point = std::chrono::time_point<std::chrono::system_clock, T>;
 void validateRange(time_point<std::chrono::seconds> timePoint);
 void validateRange(time_point<std::chrono::milliseconds> timePoint);
 
+/// The offsets of a time zone from GMT over a range of system times, as the
+/// sorted system times at which the offset changes. Converting a system time
+/// to local time in the range is a binary search in this table instead of a
+/// lookup in the time zone database.
+class TransitionTable {
+ public:
+  /// 'starts' are the system times in seconds at which the offsets in
+  /// 'offsets' start to apply. The last offset applies until 'end'.
+  TransitionTable(
+      std::vector<int64_t> starts,
+      std::vector<int64_t> offsets,
+      int64_t end)
+      : starts_(std::move(starts)), offsets_(std::move(offsets)), end_(end) {}
+
+  bool contains(int64_t sysSeconds) const {
+    return sysSeconds >= starts_.front() && sysSeconds < end_;
+  }
+
+  /// Returns the offset in seconds at 'sysSeconds', which must be contained.
+  /// The search does not branch on the comparisons, so that the time does not
+  /// depend on mispredicting them.
+  int64_t offsetAt(int64_t sysSeconds) const {
+    const int64_t* base = starts_.data();
+    auto size = starts_.size();
+    while (size > 1) {
+      const auto half = size / 2;
+      base = base[half] <= sysSeconds ? base + half : base;
+      size -= half;
+    }
+    return offsets_[base - starts_.data()];
+  }
+
+  size_t size() const {
+    return starts_.size();
+  }
+
+ private:
+  const std::vector<int64_t> starts_;
+  const std::vector<int64_t> offsets_;
+  const int64_t end_;
+};
+
 /// TimeZone is the proxy object for time zone management. It provides access to
 /// time zone names, their IDs (as defined in TimeZoneDatabase.cpp and
 /// consistent with Presto), and utilities for timestamp conversion across
@@ -144,9 +188,16 @@ class TimeZone {
   /// GMT), convert to the same instant in time as observed in the user local
   /// time represented by this object). Note that this conversion is not
   /// susceptible to the error above.
+  ///
+  /// System times in the years 1900 to 2099 are converted using
+  /// transitionTable().
   seconds to_local(seconds timestamp) const;
   milliseconds to_local(milliseconds timestamp) const;
 
+  /// Returns the offsets of this time zone for system times in the years 1900
+  /// to 2099. Built on first use.
+  const TransitionTable& transitionTable() const;
+
   /// If a local time is nonexistent, i.e. refers to a time that exists in the
   /// gap during a time zone conversion, this returns the time adjusted by
   /// the difference between the two time zones, so that it lies in the later
@@ -188,6 +239,9 @@ class TimeZone {
   const std::chrono::minutes offset_{0};
   const std::string timeZoneName_;
   const int16_t timeZoneID_;
+
+  mutable std::once_flag transitionTableOnce_;
+  mutable std::unique_ptr<TransitionTable> transitionTable_;
 };
 
 } // namespace facebook::velox::tz
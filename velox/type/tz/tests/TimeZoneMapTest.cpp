@@ -19,6 +19,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/external/date/date.h"
+#include "velox/external/tzdb/zoned_time.h"
 #include "velox/type/tz/TimeZoneMap.h"
 
 namespace facebook::velox::tz {
@@ -152,6 +153,62 @@ TEST(TimeZoneMapTest, timePointBoundary) {
   VELOX_ASSERT_THROW(tz->to_sys(seconds{-1096193779200l - 86400l}), expected);
 }
 
+TEST(TimeZoneMapTest, transitionTable) {
+  // Converts using the time zone database, without the transition table.
+  auto toLocal = [](const TimeZone* tz, int64_t sysSeconds) {
+    date::sys_seconds timePoint{seconds(sysSeconds)};
+    if (tz->tz() == nullptr) {
+      // Only "+05:30" and possibly "UTC" are offset zones below.
+      return sysSeconds + (tz->name() == "+05:30" ? 19'800 : 0);
+    }
+    return tzdb::zoned_time{tz->tz(), timePoint}
+        .get_local_time()
+        .time_since_epoch()
+        .count();
+  };
+
+  // 1900-01-01 and 2100-01-01.
+  const int64_t kBegin = -2'208'988'800;
+  const int64_t kEnd = 4'102'444'800;
+  for (const auto* name :
+       {"America/Los_Angeles",
+        "Europe/London",
+        "Asia/Kolkata",
+        "Australia/Lord_Howe",
+        "UTC",
+        "+05:30"}) {
+    SCOPED_TRACE(name);
+    const auto* tz = locateZone(name);
+    const auto& table = tz->transitionTable();
+    EXPECT_TRUE(table.contains(kBegin));
+    EXPECT_FALSE(table.contains(kBegin - 1));
+    EXPECT_TRUE(table.contains(kEnd - 1));
+    EXPECT_FALSE(table.contains(kEnd));
+
+    // Around 2 values per week over the whole range, hitting different
+    // times of day.
+    for (auto sysSeconds = kBegin; sysSeconds < kEnd;
+         sysSeconds += 312'007) {
+      ASSERT_EQ(
+          tz->to_local(seconds(sysSeconds)).count(), toLocal(tz, sysSeconds))
+          << sysSeconds;
+    }
+  }
+
+  // Each side of the daylight saving time transitions in 2024.
+  const auto* tz = locateZone("America/Los_Angeles");
+  EXPECT_GT(tz->transitionTable().size(), 200);
+  for (const int64_t transition : {1710064800, 1730624400}) {
+    for (auto sysSeconds : {transition - 1, transition}) {
+      EXPECT_EQ(
+          tz->to_local(seconds(sysSeconds)).count(), toLocal(tz, sysSeconds));
+      EXPECT_EQ(
+          tz->to_local(milliseconds(sysSeconds * 1'000 + 999)).count(),
+          toLocal(tz, sysSeconds) * 1'000 + 999);
+    }
+  }
+}
+
 TEST(TimeZoneMapTest, getTimeZoneName) {
   EXPECT_EQ("America/Los_Angeles", getTimeZoneName(1825));
   EXPECT_EQ("Europe/Moscow", getTimeZoneName(2079));
@@ -348,6 +348,11 @@ class DecodedVector {
       const BaseVector& dictionaryVector,
       const SelectivityVector* rows);
 
+  // Maps the indices into a SequenceVector to indices into its values.
+  void applySequenceWrapper(
+      const BaseVector& sequenceVector,
+      const SelectivityVector* rows);
+
   void copyNulls(vector_size_t size);
 
   void fillInIndices() const;
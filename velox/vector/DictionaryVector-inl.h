@@ -51,6 +51,12 @@ void DictionaryVector<T>::setInternalState() {
           reinterpret_cast<FlatVector<T>*>(scalarDictionaryValues_)
               ->rawValues();
     }
+    // All rows of 'this' are ASCII if all dictionary values are.
+    if constexpr (std::is_same_v<T, StringView>) {
+      if (scalarDictionaryValues_->isKnownAllAscii()) {
+        SimpleVector<T>::setAllIsAscii(true);
+      }
+    }
   }
   initialized_ = true;
 
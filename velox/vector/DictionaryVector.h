@@ -207,6 +207,9 @@ class DictionaryVector : public SimpleVector<T> {
     dictionaryValues_->clearContainingLazyAndWrapped();
     dictionaryValues_ = dictionaryValues;
     initialized_ = false;
+    if constexpr (std::is_same_v<T, StringView>) {
+      SimpleVector<T>::invalidateIsAscii();
+    }
     setInternalState();
   }
 
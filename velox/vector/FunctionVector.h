@@ -34,6 +34,13 @@ class Callable {
 
   virtual bool hasCapture() const = 0;
 
+  /// Returns true if a capture may differ between rows. Captures that are
+  /// constant do not need a 'wrapCapture' mapping in apply(), which sizes them
+  /// to 'rows' instead.
+  virtual bool hasNonConstantCapture() const {
+    return hasCapture();
+  }
+
   /// Applies 'this' to 'args' for 'rows' and returns the result in
   /// '*result'.
   /// @param rows The rows that this callable applies to. It is the element rows
@@ -302,6 +302,19 @@ class SimpleVector : public BaseVector {
     return std::nullopt;
   }
 
+  /// Returns true if all rows are known to be ASCII. Does not compute
+  /// asciiness.
+  template <typename U = T>
+  typename std::enable_if_t<std::is_same_v<U, StringView>, bool>
+  isKnownAllAscii() const {
+    if (asciiInfo.asciiComputedRowsEmpty() || !asciiInfo.isAllAscii()) {
+      return false;
+    }
+    auto rlockedAsciiComputedRows{asciiInfo.readLockedAsciiComputedRows()};
+    return rlockedAsciiComputedRows->size() >= length_ &&
+        rlockedAsciiComputedRows->isAllSelected();
+  }
+
   /// This function takes an index and returns:
   /// 1. True if the string at that index is ASCII
   /// 2. False if the string at that index is not ASCII
@@ -47,6 +47,17 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+FOLLY_ALWAYS_INLINE bool isComplexType(const TypePtr& type) {
+  return type->kind() == TypeKind::ARRAY || type->kind() == TypeKind::MAP ||
+      type->kind() == TypeKind::ROW;
+}
+
+FOLLY_ALWAYS_INLINE bool isComplexEncoding(VectorEncoding::Simple encoding) {
+  return encoding == VectorEncoding::Simple::ARRAY ||
+      encoding == VectorEncoding::Simple::MAP ||
+      encoding == VectorEncoding::Simple::ROW;
+}
 } // namespace
 
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
@@ -54,9 +65,29 @@ VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
   if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
     return vectors_[cacheIndex].pop(type, size, *pool_);
   }
+  if (isComplexType(type) && size <= kMaxRecycleSize) {
+    if (auto* typePool = complexTypePool(type, false)) {
+      return typePool->pop(type, size, *pool_);
+    }
+  }
   return BaseVector::create(type, size, pool_);
 }
 
+VectorPool::TypePool* VectorPool::complexTypePool(
+    const TypePtr& type,
+    bool add) {
+  for (auto& [cachedType, typePool] : complexVectors_) {
+    if (cachedType == type || *cachedType == *type) {
+      return &typePool;
+    }
+  }
+  if (!add || complexVectors_.size() >= kNumComplexTypes) {
+    return nullptr;
+  }
+  complexVectors_.emplace_back(type, TypePool{});
+  return &complexVectors_.back().second;
+}
+
 bool VectorPool::release(VectorPtr& vector) {
   if (FOLLY_UNLIKELY(vector == nullptr)) {
     return false;
@@ -66,10 +97,16 @@ bool VectorPool::release(VectorPtr& vector) {
   }
 
   auto cacheIndex = toCacheIndex(vector->type());
-  if (cacheIndex < 0) {
+  if (cacheIndex >= 0) {
+    return vectors_[cacheIndex].maybePushBack(vector);
+  }
+  if (!isComplexType(vector->type()) ||
+      !isComplexEncoding(vector->encoding()) ||
+      vector->retainedSize() > kMaxRecycleComplexBytes) {
     return false;
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  auto* typePool = complexTypePool(vector->type(), true);
+  return typePool != nullptr && typePool->maybePushBack(vector);
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -88,12 +125,18 @@ void VectorPool::clear() {
   for (auto& vectorPool : vectors_) {
     vectorPool.clear();
   }
+  complexVectors_.clear();
 }
 
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
-  // values Buffer and an uninitialized or unique and mutable nulls Buffer.
-  if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
+  // values Buffer and an uninitialized or unique and mutable nulls Buffer, or a
+  // complex vector with unique and mutable buffers and children.
+  if (!vector->isWritable()) {
+    return false;
+  }
+  if (vector->isFlatEncoding() ? !vector->values()
+                               : !isComplexEncoding(vector->encoding())) {
     return false;
   }
   if (size >= kNumPerType) {
@@ -126,6 +169,11 @@ VectorPtr VectorPool::TypePool::pop(
           0,
           std::min<int32_t>(vectorSize, result->size()) * sizeof(StringView));
     }
+    if (result->encoding() == VectorEncoding::Simple::ROW) {
+      // The children of a recycled row vector are empty. Grow them with the
+      // row vector.
+      result->resize(0);
+    }
     if (result->size() != vectorSize) {
       result->resize(vectorSize);
     }
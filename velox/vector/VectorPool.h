@@ -20,24 +20,30 @@
 
 namespace facebook::velox {
 
-/// A thread-level cache of pre-allocated flat vectors of different types.
-/// Keeps up to 10 recyclable vectors of each type. A vector is
-/// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// A thread-level cache of pre-allocated vectors of different types.
+/// Keeps up to 10 recyclable vectors of each type. A vector is recyclable if it
+/// is flat, array, map or row encoded and recursively singly-referenced. The
+/// singleton built-in scalar types and up to 8 distinct array, map and row
+/// types are supported. Decimal types, fixed-size array type and custom scalar
+/// types are not supported. Calling 'get' for an unsupported type already
+/// returns a newly allocated vector. Calling 'release' for an unsupported type
+/// is a no-op.
+///
+/// A recycled complex vector keeps its offsets, sizes and nulls buffers and
+/// its children, which are recycled recursively the same way. A recycled
+/// string vector keeps at most one string buffer.
 class VectorPool {
  public:
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
-  /// 'pool_' if no pre-allocated vector or type is a complex type.
+  /// 'pool_' if no pre-allocated vector or type is not supported.
   VectorPtr get(const TypePtr& type, vector_size_t size);
 
-  /// Moves vector into 'this' if it is flat, recursively singly referenced and
-  /// there is space. The function returns true if 'vector' is not null and has
-  /// been returned back to this pool, otherwise returns false.
+  /// Moves vector into 'this' if it is flat or complex, recursively singly
+  /// referenced and there is space. The function returns true if 'vector' is
+  /// not null and has been returned back to this pool, otherwise returns
+  /// false.
   bool release(VectorPtr& vector);
 
   size_t release(std::vector<VectorPtr>& vectors);
@@ -51,6 +57,14 @@ class VectorPool {
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
 
+  /// Max number of distinct complex types to cache vectors for.
+  static constexpr int32_t kNumComplexTypes = 8;
+
+  /// Max retained size of a complex vector, including its children, to be
+  /// recyclable. This bounds the memory held by elements of large arrays and
+  /// maps.
+  static constexpr uint64_t kMaxRecycleComplexBytes = 8 << 20;
+
   struct TypePool {
     int32_t size{0};
     std::array<VectorPtr, kNumPerType> vectors;
@@ -73,6 +87,14 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Returns the cache of vectors of the array, map or row 'type'. Adds a new
+  /// one if there is none and 'add' is true and 'complexVectors_' is not full.
+  /// Returns nullptr otherwise.
+  TypePool* complexTypePool(const TypePtr& type, bool add);
+
+  /// Caches of pre-allocated array, map and row vectors with their types.
+  std::vector<std::pair<TypePtr, TypePool>> complexVectors_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -102,6 +102,8 @@ std::string VectorSerde::kindName(Kind kind) {
       return "CompactRow";
     case Kind::kUnsafeRow:
       return "UnsafeRow";
+    case Kind::kArrow:
+      return "Arrow";
   }
   VELOX_UNREACHABLE(
       fmt::format("Unknown vector serde kind: {}", static_cast<int32_t>(kind)));
@@ -111,7 +113,8 @@ VectorSerde::Kind VectorSerde::kindByName(const std::string& kindName) {
   static const std::unordered_map<std::string, Kind> kNameToKind = {
       {"Presto", Kind::kPresto},
       {"CompactRow", Kind::kCompactRow},
-      {"UnsafeRow", Kind::kUnsafeRow}};
+      {"UnsafeRow", Kind::kUnsafeRow},
+      {"Arrow", Kind::kArrow}};
   const auto it = kNameToKind.find(kindName);
   VELOX_CHECK(
       it != kNameToKind.end(), "Unknown vector serde kind: {}", kindName);
@@ -202,6 +205,31 @@ void VectorStreamGroup::append(const RowVectorPtr& vector) {
   serializer_->append(vector);
 }
 
+// static
+void VectorStreamGroup::scatter(
+    const RowVectorPtr& vector,
+    const uint32_t* destinations,
+    const std::vector<folly::Range<const vector_size_t*>>& rows,
+    const std::vector<VectorStreamGroup*>& groups,
+    Scratch& scratch) {
+  VELOX_CHECK_EQ(rows.size(), groups.size());
+  std::vector<IterativeVectorSerializer*> serializers(groups.size());
+  IterativeVectorSerializer* first = nullptr;
+  for (auto i = 0; i < groups.size(); ++i) {
+    if (groups[i] == nullptr) {
+      VELOX_CHECK(rows[i].empty());
+      continue;
+    }
+    serializers[i] = groups[i]->serializer_.get();
+    if (first == nullptr) {
+      first = serializers[i];
+    }
+  }
+  if (first != nullptr) {
+    first->scatter(vector, destinations, rows, serializers, scratch);
+  }
+}
+
 void VectorStreamGroup::append(
     const row::CompactRow& compactRow,
     const folly::Range<const vector_size_t*>& rows,
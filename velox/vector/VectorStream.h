@@ -19,6 +19,7 @@
 
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 #include "velox/common/memory/ByteStream.h"
 #include "velox/common/memory/Scratch.h"
 #include "velox/common/memory/StreamArena.h"
@@ -53,6 +54,26 @@ struct CompressionStats {
   int64_t compressionSkippedBytes{0};
 };
 
+/// Returns true if sending 'compressedBytes' instead of 'uncompressedBytes'
+/// over a link of 'bandwidthBytesPerSec' saves more time than the
+/// 'compressNanos' spent compressing. Always true if 'bandwidthBytesPerSec' is
+/// 0, i.e. the bandwidth is unknown.
+inline bool compressionPaysOff(
+    uint64_t uncompressedBytes,
+    uint64_t compressedBytes,
+    uint64_t compressNanos,
+    uint64_t bandwidthBytesPerSec) {
+  if (bandwidthBytesPerSec == 0) {
+    return true;
+  }
+  if (compressedBytes >= uncompressedBytes) {
+    return false;
+  }
+  const double savedNanos = (uncompressedBytes - compressedBytes) * 1.0e9 /
+      bandwidthBytesPerSec;
+  return savedNanos > compressNanos;
+}
+
 /// Serializer that can iteratively build up a buffer of serialized rows from
 /// one or more RowVectors.
 ///
@@ -105,6 +126,25 @@ class IterativeVectorSerializer {
     return false;
   }
 
+  /// Appends each row of 'vector' to one of 'serializers', which are all of
+  /// the same kind as 'this'. 'rows[i]' are the rows going to 'serializers[i]'
+  /// in increasing order and 'destinations[row]' is the index of the
+  /// serializer of each such row. A serializer may be null if it gets no rows.
+  /// The default appends the rows of each serializer separately. Subclasses
+  /// may instead write each column to all the serializers in one pass.
+  virtual void scatter(
+      const RowVectorPtr& vector,
+      const uint32_t* destinations,
+      const std::vector<folly::Range<const vector_size_t*>>& rows,
+      const std::vector<IterativeVectorSerializer*>& serializers,
+      Scratch& scratch) {
+    for (auto i = 0; i < serializers.size(); ++i) {
+      if (!rows[i].empty()) {
+        serializers[i]->append(vector, rows[i], scratch);
+      }
+    }
+  }
+
   /// Returns the maximum serialized size of the data previously added via
   /// 'append' methods. Can be used to allocate buffer of exact or maximum size
   /// before calling 'flush'.
@@ -173,6 +213,7 @@ class VectorSerde {
     kPresto,
     kCompactRow,
     kUnsafeRow,
+    kArrow,
   };
 
   static std::string kindName(Kind type);
@@ -200,6 +241,19 @@ class VectorSerde {
     /// than this causes subsequent compression attempts to be skipped. The more
     /// times compression misses the target the less frequently it is tried.
     float minCompressionRatio{0.8};
+
+    /// If not 0, the network bandwidth in bytes per second the output is sent
+    /// over. Compression is then also skipped, with the same back-off as for
+    /// 'minCompressionRatio', when the time spent compressing a page exceeds
+    /// the transfer time it saves. This adapts the compression to whether the
+    /// query is network or CPU bound. See compressionPaysOff().
+    uint64_t compressionBandwidthBytesPerSec{0};
+
+    /// If set, the Presto serde compresses pages with this dictionary, which
+    /// requires CompressionKind_ZSTD. The deserializer must be given the same
+    /// dictionary. Small pages of similar content compress much better with a
+    /// dictionary trained from earlier pages.
+    std::shared_ptr<const common::ZstdDictionary> compressionDictionary;
   };
 
   Kind kind() const {
@@ -399,6 +453,16 @@ class VectorStreamGroup : public StreamArena {
 
   void append(const RowVectorPtr& vector);
 
+  /// Appends the rows of 'vector' to 'groups'. See
+  /// IterativeVectorSerializer::scatter() for the meaning of the arguments.
+  /// All the non-null 'groups' must use the same serde.
+  static void scatter(
+      const RowVectorPtr& vector,
+      const uint32_t* destinations,
+      const std::vector<folly::Range<const vector_size_t*>>& rows,
+      const std::vector<VectorStreamGroup*>& groups,
+      Scratch& scratch);
+
   void append(
       const row::CompactRow& compactRow,
       const folly::Range<const vector_size_t*>& rows,
@@ -594,6 +594,49 @@ TEST_F(DecodedVectorTest, dictionary) {
       1000, [](vector_size_t i) { return std::make_shared<int>(i % 5); });
 }
 
+TEST_F(DecodedVectorTest, sequence) {
+  std::vector<std::optional<int64_t>> data;
+  for (auto i = 0; i < 1000; ++i) {
+    data.push_back(i % 100 == 7 ? std::nullopt : std::optional(i / 30));
+  }
+  auto sequence = vectorMaker_.sequenceVector<int64_t>(data);
+  ASSERT_EQ(sequence->encoding(), VectorEncoding::Simple::SEQUENCE);
+
+  auto check = [&](DecodedVector& decoded,
+                   const SelectivityVector& rows,
+                   const std::function<vector_size_t(vector_size_t)>& index) {
+    ASSERT_FALSE(decoded.isIdentityMapping());
+    ASSERT_FALSE(decoded.isConstantMapping());
+    rows.applyToSelected([&](auto row) {
+      const auto& expected = data[index(row)];
+      ASSERT_EQ(decoded.isNullAt(row), !expected.has_value()) << row;
+      if (expected.has_value()) {
+        ASSERT_EQ(decoded.valueAt<int64_t>(row), expected.value()) << row;
+      }
+    });
+  };
+
+  SelectivityVector allRows(data.size());
+  DecodedVector decoded(*sequence, allRows);
+  check(decoded, allRows, [](auto row) { return row; });
+
+  SelectivityVector someRows(data.size(), false);
+  for (auto i = 3; i < data.size(); i += 7) {
+    someRows.setValid(i, true);
+  }
+  someRows.updateBounds();
+  decoded.decode(*sequence, someRows);
+  check(decoded, someRows, [](auto row) { return row; });
+
+  // A dictionary over the sequence.
+  auto indices = makeIndicesInReverse(data.size());
+  auto dictionary = BaseVector::wrapInDictionary(
+      nullptr, indices, data.size(), sequence);
+  decoded.decode(*dictionary, allRows);
+  const auto size = data.size();
+  check(decoded, allRows, [&](auto row) { return size - 1 - row; });
+}
+
 TEST_F(DecodedVectorTest, dictionaryOverLazy) {
   constexpr vector_size_t size = 1000;
   auto lazyVector = vectorMaker_.lazyFlatVector<int32_t>(
@@ -153,6 +153,62 @@ TEST_F(VectorPoolTest, customTypes) {
   ASSERT_TRUE(isJsonType(vector->type()));
 }
 
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+
+  auto arrayVector = makeArrayVector<int64_t>({{1, 2, 3}, {}, {4, 5}});
+  auto* arrayPtr = arrayVector.get();
+  auto* elementsPtr = arrayVector->as<ArrayVector>()->elements().get();
+  ASSERT_TRUE(vectorPool.release(arrayVector));
+  ASSERT_EQ(arrayVector, nullptr);
+
+  // The recycled vector and its elements are reset.
+  auto recycled = vectorPool.get(ARRAY(BIGINT()), 10);
+  ASSERT_EQ(recycled.get(), arrayPtr);
+  ASSERT_EQ(recycled->size(), 10);
+  auto* recycledArray = recycled->as<ArrayVector>();
+  ASSERT_EQ(recycledArray->elements().get(), elementsPtr);
+  ASSERT_EQ(recycledArray->elements()->size(), 0);
+  for (auto i = 0; i < 10; ++i) {
+    ASSERT_FALSE(recycled->isNullAt(i));
+    ASSERT_EQ(recycledArray->sizeAt(i), 0);
+    ASSERT_EQ(recycledArray->offsetAt(i), 0);
+  }
+
+  // An equal type created separately shares the cache.
+  auto mapVector = makeMapVector<int32_t, std::string>(
+      {{{1, "a string that is not inlined"}}, {}});
+  auto* mapPtr = mapVector.get();
+  ASSERT_TRUE(vectorPool.release(mapVector));
+  ASSERT_EQ(vectorPool.get(MAP(INTEGER(), VARCHAR()), 5).get(), mapPtr);
+
+  // The children of a recycled row vector have the size of the row vector.
+  auto rowVector = makeRowVector(
+      {makeFlatVector<int64_t>({1, 2}), makeArrayVector<int32_t>({{1}, {2}})});
+  auto* rowPtr = rowVector.get();
+  const auto rowType = rowVector->type();
+  ASSERT_TRUE(vectorPool.release(rowVector));
+  auto recycledRow = vectorPool.get(rowType, 7);
+  ASSERT_EQ(recycledRow.get(), rowPtr);
+  for (const auto& child : recycledRow->as<RowVector>()->children()) {
+    ASSERT_EQ(child->size(), 7);
+  }
+  recycledRow->validate();
+
+  // A vector with a shared child is not recycled.
+  auto elements = makeFlatVector<int64_t>({1, 2});
+  arrayVector = makeArrayVector({0, 1}, elements);
+  ASSERT_FALSE(vectorPool.release(arrayVector));
+  ASSERT_NE(arrayVector, nullptr);
+
+  // Only a limited number of distinct complex types is cached.
+  for (auto i = 0; i < 10; ++i) {
+    std::vector<TypePtr> types(i + 1, BIGINT());
+    auto vector = BaseVector::create(ROW(std::move(types)), 10, pool());
+    ASSERT_EQ(vectorPool.release(vector), i < 5) << i;
+  }
+}
+
 TEST_F(VectorPoolTest, clear) {
   const auto statsBefore = pool()->stats();
 
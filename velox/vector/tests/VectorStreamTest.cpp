@@ -107,4 +107,18 @@ TEST(VectorStreamTest, namedSerdeRegistration) {
   deregisterNamedVectorSerde(otherKind);
   EXPECT_FALSE(isRegisteredNamedVectorSerde(otherKind));
 }
+
+TEST(VectorStreamTest, compressionPaysOff) {
+  // Unknown bandwidth.
+  EXPECT_TRUE(compressionPaysOff(1'000, 100, 1'000'000'000, 0));
+  // No size reduction.
+  EXPECT_FALSE(compressionPaysOff(1'000, 1'000, 0, 1'000));
+  // 1MB saved at 1GB/s is 1ms.
+  EXPECT_TRUE(compressionPaysOff(2'000'000, 1'000'000, 999'000, 1'000'000'000));
+  EXPECT_FALSE(
+      compressionPaysOff(2'000'000, 1'000'000, 1'001'000, 1'000'000'000));
+  // The same compression pays off on a 10x slower link.
+  EXPECT_TRUE(
+      compressionPaysOff(2'000'000, 1'000'000, 1'001'000, 100'000'000));
+}
 } // namespace facebook::velox::test
@@ -1836,6 +1836,42 @@ TEST_F(VectorTest, copyAscii) {
   ASSERT_FALSE(ascii.value());
 }
 
+TEST_F(VectorTest, dictionaryAscii) {
+  auto base = makeFlatVector<std::string>({"a", "b", "c"});
+  auto indices = makeIndices({2, 0, 1, 0});
+  SelectivityVector all(4);
+
+  // Asciiness is not known for the base.
+  auto dictionary = wrapInDictionary(indices, base);
+  ASSERT_FALSE(dictionary->as<SimpleVector<StringView>>()
+                   ->isAscii(all)
+                   .has_value());
+
+  // Asciiness is known for only some rows of the base.
+  SelectivityVector some(3);
+  some.setValid(2, false);
+  some.updateBounds();
+  base->computeAndSetIsAscii(some);
+  dictionary = wrapInDictionary(indices, base);
+  ASSERT_FALSE(dictionary->as<SimpleVector<StringView>>()
+                   ->isAscii(all)
+                   .has_value());
+
+  base->setAllIsAscii(true);
+  dictionary = wrapInDictionary(indices, base);
+  auto ascii = dictionary->as<SimpleVector<StringView>>()->isAscii(all);
+  ASSERT_TRUE(ascii.has_value());
+  ASSERT_TRUE(ascii.value());
+
+  // A base that is not all ASCII does not make the dictionary non-ASCII,
+  // since the indices may not refer to the non-ASCII values.
+  base->setAllIsAscii(false);
+  dictionary = wrapInDictionary(indices, base);
+  ASSERT_FALSE(dictionary->as<SimpleVector<StringView>>()
+                   ->isAscii(all)
+                   .has_value());
+}
+
 TEST_F(VectorTest, compareNan) {
   // Double input.
   {